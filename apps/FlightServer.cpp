@@ -0,0 +1,65 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FlightServer.h"
+
+#include "Shared/ArrowUtil.h"
+
+#include <boost/program_options.hpp>
+
+#include <csignal>
+#include <iostream>
+
+int main(int argc, char* argv[]) {
+  namespace po = boost::program_options;
+
+  std::string host;
+  int port;
+  size_t max_batch_rows;
+
+  po::options_description desc("Options");
+  desc.add_options()("help,h", "Print help messages");
+  desc.add_options()(
+      "host", po::value<std::string>(&host)->default_value("0.0.0.0"), "Listen address");
+  desc.add_options()("port", po::value<int>(&port)->default_value(8815), "Listen port");
+  desc.add_options()("max-batch-rows",
+                     po::value<size_t>(&max_batch_rows)->default_value(size_t(1) << 20),
+                     "Maximum number of rows in streamed result batches");
+
+  po::variables_map vm;
+  try {
+    po::store(po::command_line_parser(argc, argv).options(desc).run(), vm);
+    po::notify(vm);
+  } catch (po::error& e) {
+    std::cerr << "Usage Error: " << e.what() << std::endl;
+    std::cout << desc;
+    return 1;
+  }
+  if (vm.count("help")) {
+    std::cout << desc;
+    return 0;
+  }
+
+  HDK hdk;
+  HDKFlightServer server(hdk, max_batch_rows);
+
+  arrow::flight::Location location;
+  ARROW_ASSIGN_OR_THROW(location, arrow::flight::Location::ForGrpcTcp(host, port));
+  arrow::flight::FlightServerOptions options(location);
+  ARROW_THROW_NOT_OK(server.Init(options));
+  ARROW_THROW_NOT_OK(server.SetShutdownOnSignals({SIGTERM, SIGINT}));
+  std::cout << "Listening on " << host << ":" << server.port() << std::endl;
+  ARROW_THROW_NOT_OK(server.Serve());
+  return 0;
+}
@@ -25,8 +25,10 @@
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
 #endif
 
+#include <arrow/compute/api.h>
 #include <arrow/csv/reader.h>
 #include <arrow/io/api.h>
+#include <arrow/ipc/api.h>
 #include <arrow/json/reader.h>
 #include <arrow/util/decimal.h>
 #include <arrow/util/value_parsing.h>
@@ -37,10 +39,73 @@
 #pragma GCC diagnostic pop
 #endif
 
+#include <algorithm>
+#include <filesystem>
+#include <iterator>
+#include <tuple>
+
 using namespace std::string_literals;
 
 namespace {
 
+// Return row positions where all columns of the table have a chunk boundary. The
+// last position is equal to the number of rows.
+std::vector<size_t> getCommonChunkBoundaries(std::shared_ptr<arrow::Table> at) {
+  std::vector<size_t> res;
+  for (int col_idx = 0; col_idx < at->num_columns(); ++col_idx) {
+    std::vector<size_t> boundaries;
+    size_t offset = 0;
+    for (auto& chunk : at->column(col_idx)->chunks()) {
+      if (chunk->length()) {
+        offset += chunk->length();
+        boundaries.push_back(offset);
+      }
+    }
+    if (col_idx) {
+      std::vector<size_t> common;
+      std::set_intersection(res.begin(),
+                            res.end(),
+                            boundaries.begin(),
+                            boundaries.end(),
+                            std::back_inserter(common));
+      res = std::move(common);
+    } else {
+      res = std::move(boundaries);
+    }
+  }
+  return res;
+}
+
+std::vector<size_t> computeChunkAlignedFragmentSizes(std::shared_ptr<arrow::Table> at,
+                                                     size_t fragment_size,
+                                                     size_t min_fragment_size) {
+  std::vector<size_t> res;
+  // Split big chunks into equal parts to keep fragments balanced.
+  auto add_fragments = [&](size_t rows) {
+    size_t parts = (rows + fragment_size - 1) / fragment_size;
+    for (size_t i = 0; i < parts; ++i) {
+      res.push_back(rows / parts + (i < rows % parts ? 1 : 0));
+    }
+  };
+
+  size_t prev_boundary = 0;
+  size_t pending_rows = 0;
+  for (auto boundary : getCommonChunkBoundaries(at)) {
+    pending_rows += boundary - prev_boundary;
+    prev_boundary = boundary;
+    // Small chunks are merged to avoid too many tiny fragments. Such fragments don't
+    // support zero-copy fetch.
+    if (pending_rows >= min_fragment_size) {
+      add_fragments(pending_rows);
+      pending_rows = 0;
+    }
+  }
+  if (pending_rows || res.empty()) {
+    res.push_back(pending_rows);
+  }
+  return res;
+}
+
 size_t computeTotalStringsLength(std::shared_ptr<arrow::ChunkedArray> arr,
                                  size_t offset,
                                  size_t rows) {
@@ -67,6 +132,112 @@ size_t computeTotalStringsLength(std::shared_ptr<arrow::ChunkedArray> arr,
   return total_bytes;
 }
 
+template <typename T>
+void addDictIdsToFilter(DictIdFilter& filter,
+                        std::shared_ptr<arrow::ChunkedArray> arr,
+                        int64_t null_val) {
+  for (auto& chunk : arr->chunks()) {
+    auto vals = chunk->data()->GetValues<T>(1);
+    for (int64_t i = 0; i < chunk->length(); ++i) {
+      if (static_cast<int64_t>(vals[i]) != null_val) {
+        filter.add(static_cast<int32_t>(vals[i]));
+      }
+    }
+  }
+}
+
+std::shared_ptr<const DictIdFilter> computeDictIdFilter(
+    std::shared_ptr<arrow::ChunkedArray> arr,
+    const hdk::ir::Type* type) {
+  auto filter = std::make_shared<DictIdFilter>();
+  auto null_val = inline_fixed_encoding_null_value(type);
+  switch (type->size()) {
+    case 1:
+      addDictIdsToFilter<uint8_t>(*filter, arr, null_val);
+      break;
+    case 2:
+      addDictIdsToFilter<uint16_t>(*filter, arr, null_val);
+      break;
+    case 4:
+      addDictIdsToFilter<int32_t>(*filter, arr, null_val);
+      break;
+    default:
+      return nullptr;
+  }
+  return filter->isSaturated() ? nullptr : filter;
+}
+
+template <typename T>
+void addValuesToColumnStats(ColumnStats& stats,
+                            std::shared_ptr<arrow::ChunkedArray> arr,
+                            int64_t null_val) {
+  for (auto& chunk : arr->chunks()) {
+    auto vals = chunk->data()->GetValues<T>(1);
+    size_t nulls = 0;
+    for (int64_t i = 0; i < chunk->length(); ++i) {
+      if (static_cast<int64_t>(vals[i]) == null_val) {
+        ++nulls;
+      } else {
+        stats.addValue(static_cast<int64_t>(vals[i]));
+      }
+    }
+    stats.addNulls(nulls);
+  }
+}
+
+// Statistics are collected for fixed length scalar columns except floating point ones.
+std::shared_ptr<const ColumnStats> computeColumnStats(
+    std::shared_ptr<arrow::ChunkedArray> arr,
+    const hdk::ir::Type* type) {
+  if (!type->isBoolean() && !type->isInteger() && !type->isDecimal() &&
+      !type->isDateTime() && !type->isExtDictionary()) {
+    return nullptr;
+  }
+  auto stats = std::make_shared<ColumnStats>();
+  auto null_val = inline_fixed_encoding_null_value(type);
+  switch (type->size()) {
+    case 1:
+      if (type->isExtDictionary()) {
+        addValuesToColumnStats<uint8_t>(*stats, arr, null_val);
+      } else {
+        addValuesToColumnStats<int8_t>(*stats, arr, null_val);
+      }
+      break;
+    case 2:
+      if (type->isExtDictionary()) {
+        addValuesToColumnStats<uint16_t>(*stats, arr, null_val);
+      } else {
+        addValuesToColumnStats<int16_t>(*stats, arr, null_val);
+      }
+      break;
+    case 4:
+      addValuesToColumnStats<int32_t>(*stats, arr, null_val);
+      break;
+    case 8:
+      addValuesToColumnStats<int64_t>(*stats, arr, null_val);
+      break;
+    default:
+      return nullptr;
+  }
+  return stats;
+}
+
+std::shared_ptr<arrow::Table> sortByClusterKeys(
+    std::shared_ptr<arrow::Table> at,
+    const std::vector<std::string>& cluster_keys) {
+  std::vector<arrow::compute::SortKey> sort_keys;
+  for (auto& key : cluster_keys) {
+    sort_keys.emplace_back(key);
+  }
+  ARROW_ASSIGN_OR_THROW(
+      auto indices,
+      arrow::compute::SortIndices(arrow::Datum(at),
+                                  arrow::compute::SortOptions(std::move(sort_keys))));
+  ARROW_ASSIGN_OR_THROW(auto sorted,
+                        arrow::compute::Take(arrow::Datum(at), arrow::Datum(indices)));
+  return sorted.table();
+}
+
 /**
  * Get column ID by its 0-based index (position) in the table.
  */
@@ -81,6 +252,124 @@ size_t columnIndex(int col_id) {
   return static_cast<size_t>(col_id - 1000);
 }
 
+std::tuple<arrow::csv::ReadOptions, arrow::csv::ParseOptions, arrow::csv::ConvertOptions>
+getArrowCsvOptions(hdk::ir::Context& ctx,
+                   const ArrowStorage::CsvParseOptions& parse_options,
+                   const ColumnInfoList& col_infos) {
+  auto arrow_parse_options = arrow::csv::ParseOptions::Defaults();
+  arrow_parse_options.quoting = false;
+  arrow_parse_options.escaping = false;
+  arrow_parse_options.newlines_in_values = false;
+  arrow_parse_options.delimiter = parse_options.delimiter;
+
+  auto arrow_read_options = arrow::csv::ReadOptions::Defaults();
+  arrow_read_options.use_threads = true;
+  arrow_read_options.block_size = parse_options.block_size;
+  arrow_read_options.autogenerate_column_names =
+      !parse_options.header && col_infos.empty();
+  arrow_read_options.skip_rows = parse_options.skip_rows;
+
+  auto arrow_convert_options = arrow::csv::ConvertOptions::Defaults();
+  arrow_convert_options.check_utf8 = false;
+  arrow_convert_options.include_columns = arrow_read_options.column_names;
+  arrow_convert_options.strings_can_be_null = true;
+  if (!parse_options.timestamp_formats.empty()) {
+    // The fixed-format ISO-8601 parser goes first, it is the fast one.
+    arrow_convert_options.timestamp_parsers.push_back(
+        arrow::TimestampParser::MakeISO8601());
+    for (auto& format : parse_options.timestamp_formats) {
+      arrow_convert_options.timestamp_parsers.push_back(
+          arrow::TimestampParser::MakeStrptime(format));
+    }
+  }
+
+  for (auto& col_info : col_infos) {
+    if (!col_info->is_rowid) {
+      if (!parse_options.header) {
+        arrow_read_options.column_names.push_back(col_info->name);
+      }
+      if (col_info->type) {
+        arrow_convert_options.column_types.emplace(
+            col_info->name, getArrowImportType(ctx, col_info->type));
+      }
+    }
+  }
+
+  return {arrow_read_options, arrow_parse_options, arrow_convert_options};
+}
+
+std::pair<arrow::json::ReadOptions, arrow::json::ParseOptions> getArrowJsonOptions(
+    hdk::ir::Context& ctx,
+    const ArrowStorage::JsonParseOptions& parse_options,
+    const ColumnInfoList& col_infos) {
+  // Columns with no type are not in the explicit schema, their types are inferred
+  // from the first block.
+  arrow::FieldVector fields;
+  fields.reserve(col_infos.size());
+  for (auto& col_info : col_infos) {
+    if (!col_info->is_rowid && col_info->type) {
+      fields.emplace_back(
+          std::make_shared<arrow::Field>(col_info->name,
+                                         getArrowImportType(ctx, col_info->type),
+                                         col_info->type->nullable()));
+    }
+  }
+
+  auto arrow_parse_options = arrow::json::ParseOptions::Defaults();
+  arrow_parse_options.newlines_in_values = false;
+  if (!fields.empty()) {
+    arrow_parse_options.explicit_schema =
+        std::make_shared<arrow::Schema>(std::move(fields));
+  }
+
+  auto arrow_read_options = arrow::json::ReadOptions::Defaults();
+  arrow_read_options.use_threads = true;
+  arrow_read_options.block_size = parse_options.block_size;
+
+  return {arrow_read_options, arrow_parse_options};
+}
+
+/**
+ * Complete a partial schema specification of an imported file. Missing columns and
+ * column types are taken from the parsed schema.
+ */
+std::vector<ArrowStorage::ColumnDescription> getImportColumns(
+    hdk::ir::Context& ctx,
+    const arrow::Schema& schema,
+    const std::vector<ArrowStorage::ColumnDescription>& columns) {
+  std::unordered_map<std::string, const hdk::ir::Type*> col_types;
+  for (auto& col : columns) {
+    if (col.type) {
+      col_types.emplace(col.name, col.type);
+    }
+  }
+
+  std::vector<ArrowStorage::ColumnDescription> res;
+  res.reserve(schema.num_fields());
+  for (int i = 0; i < schema.num_fields(); ++i) {
+    ArrowStorage::ColumnDescription col_desc;
+    col_desc.name = schema.field(i)->name();
+    if (col_types.count(col_desc.name)) {
+      col_desc.type = col_types.at(col_desc.name);
+    } else {
+      col_desc.type = getTargetImportType(ctx, *schema.field(i)->type());
+    }
+    res.emplace_back(std::move(col_desc));
+  }
+  return res;
+}
+
+ColumnInfoList getImportColumnInfos(
+    const std::vector<ArrowStorage::ColumnDescription>& columns) {
+  ColumnInfoList col_infos;
+  col_infos.reserve(columns.size());
+  for (auto& col : columns) {
+    col_infos.emplace_back(
+        std::make_shared<ColumnInfo>(-1, -1, -1, col.name, col.type, false));
+  }
+  return col_infos;
+}
+
 }  // anonymous namespace
 
 void ArrowStorage::fetchBuffer(const ChunkKey& key,
@@ -96,17 +385,35 @@ void ArrowStorage::fetchBuffer(const ChunkKey& key,
   size_t col_idx = columnIndex(key[CHUNK_KEY_COLUMN_IDX]);
   size_t frag_idx = static_cast<size_t>(key[CHUNK_KEY_FRAGMENT_IDX] - 1);
   CHECK_LT(frag_idx, table.fragments.size());
-  CHECK_LT(col_idx, table.col_data.size());
 
   auto col_type =
       getColumnInfo(
           key[CHUNK_KEY_DB_IDX], key[CHUNK_KEY_TABLE_IDX], key[CHUNK_KEY_COLUMN_IDX])
           ->type;
+
+  std::shared_ptr<arrow::ChunkedArray> col_arr;
+  size_t frag_offset;
+  size_t frag_rows = table.fragments[frag_idx].row_count;
+  if (!table.parquet_file.empty()) {
+    // Each fragment of Parquet-backed table is a row group that we read on demand.
+    CHECK_LT(col_idx, static_cast<size_t>(table.schema->num_fields()));
+    auto file_name = table.parquet_file;
+    table_lock.unlock();
+    col_arr = readParquetColumn(file_name, frag_idx, col_idx, col_type);
+    frag_offset = 0;
+  } else {
+    CHECK_LT(col_idx, table.col_data.size());
+    // Published fragments and column data are immutable, so we can release the table
+    // lock and not block appends while copying data.
+    col_arr = table.col_data[col_idx];
+    frag_offset = table.fragments[frag_idx].offset;
+    table_lock.unlock();
+  }
   dest->reserve(num_bytes);
   if (!col_type->isVarLen()) {
     CHECK_EQ(key.size(), (size_t)4);
     size_t elem_size = col_type->size();
-    fetchFixedLenData(table, frag_idx, col_idx, dest, num_bytes, elem_size);
+    fetchFixedLenData(col_arr, frag_offset, frag_rows, dest, num_bytes, elem_size);
   } else {
     CHECK_EQ(key.size(), (size_t)5);
     if (key[CHUNK_KEY_VARLEN_IDX] == 1) {
@@ -114,19 +421,19 @@ void ArrowStorage::fetchBuffer(const ChunkKey& key,
         dest->initEncoder(col_type);
       }
       if (col_type->isString()) {
-        fetchVarLenData(table, frag_idx, col_idx, dest, num_bytes);
+        fetchVarLenData(col_arr, frag_offset, frag_rows, dest, num_bytes);
       } else {
         CHECK(col_type->isVarLenArray());
-        fetchVarLenArrayData(table,
-                             frag_idx,
-                             col_idx,
+        fetchVarLenArrayData(col_arr,
+                             frag_offset,
+                             frag_rows,
                              dest,
                              col_type->as<hdk::ir::ArrayBaseType>()->elemType()->size(),
                              num_bytes);
       }
     } else {
       CHECK_EQ(key[CHUNK_KEY_VARLEN_IDX], 2);
-      fetchVarLenOffsets(table, frag_idx, col_idx, dest, num_bytes);
+      fetchVarLenOffsets(col_arr, frag_offset, frag_rows, dest, num_bytes);
     }
   }
   dest->setSize(num_bytes);
@@ -147,7 +454,7 @@ std::unique_ptr<AbstractDataToken> ArrowStorage::getZeroCopyBufferMemory(
           key[CHUNK_KEY_DB_IDX], key[CHUNK_KEY_TABLE_IDX], key[CHUNK_KEY_COLUMN_IDX])
           ->type;
 
-  if (!col_type->isVarLen()) {
+  if (!col_type->isVarLen() && table.parquet_file.empty()) {
     size_t col_idx = columnIndex(key[CHUNK_KEY_COLUMN_IDX]);
     size_t frag_idx = static_cast<size_t>(key[CHUNK_KEY_FRAGMENT_IDX] - 1);
     CHECK_EQ(key.size(), (size_t)4);
@@ -178,25 +485,23 @@ std::unique_ptr<AbstractDataToken> ArrowStorage::getZeroCopyBufferMemory(
   return nullptr;
 }
 
-void ArrowStorage::fetchFixedLenData(const TableData& table,
-                                     size_t frag_idx,
-                                     size_t col_idx,
+void ArrowStorage::fetchFixedLenData(std::shared_ptr<arrow::ChunkedArray> col_arr,
+                                     size_t frag_offset,
+                                     size_t frag_rows,
                                      Data_Namespace::AbstractBuffer* dest,
                                      size_t num_bytes,
                                      size_t elem_size) const {
-  auto& frag = table.fragments[frag_idx];
-  size_t rows_to_fetch = num_bytes ? num_bytes / elem_size : frag.row_count;
+  size_t rows_to_fetch = num_bytes ? num_bytes / elem_size : frag_rows;
   const auto* fixed_type =
-      dynamic_cast<const arrow::FixedWidthType*>(table.col_data[col_idx]->type().get());
+      dynamic_cast<const arrow::FixedWidthType*>(col_arr->type().get());
   CHECK(fixed_type);
   size_t arrow_elem_size = fixed_type->bit_width() / 8;
   // For fixed size arrays we simply use elem type in arrow and therefore have to scale
   // to get a proper slice.
   size_t elems = elem_size / arrow_elem_size;
   CHECK_GT(elems, (size_t)0);
-  auto data_to_fetch =
-      table.col_data[col_idx]->Slice(static_cast<int64_t>(frag.offset * elems),
-                                     static_cast<int64_t>(rows_to_fetch * elems));
+  auto data_to_fetch = col_arr->Slice(static_cast<int64_t>(frag_offset * elems),
+                                      static_cast<int64_t>(rows_to_fetch * elems));
   int8_t* dst_ptr = dest->getMemoryPtr();
   for (auto& chunk : data_to_fetch->chunks()) {
     size_t chunk_size = chunk->length() * arrow_elem_size;
@@ -207,17 +512,16 @@ void ArrowStorage::fetchFixedLenData(const TableData& table,
   }
 }
 
-void ArrowStorage::fetchVarLenOffsets(const TableData& table,
-                                      size_t frag_idx,
-                                      size_t col_idx,
+void ArrowStorage::fetchVarLenOffsets(std::shared_ptr<arrow::ChunkedArray> col_arr,
+                                      size_t frag_offset,
+                                      size_t frag_rows,
                                       Data_Namespace::AbstractBuffer* dest,
                                       size_t num_bytes) const {
-  auto& frag = table.fragments[frag_idx];
-  CHECK_EQ(num_bytes, (frag.row_count + 1) * sizeof(uint32_t));
+  CHECK_EQ(num_bytes, (frag_rows + 1) * sizeof(uint32_t));
   // Number of fetched offsets is 1 greater than number of fetched rows.
-  size_t rows_to_fetch = num_bytes ? num_bytes / sizeof(uint32_t) - 1 : frag.row_count;
-  auto data_to_fetch = table.col_data[col_idx]->Slice(
-      static_cast<int64_t>(frag.offset), static_cast<int64_t>(rows_to_fetch));
+  size_t rows_to_fetch = num_bytes ? num_bytes / sizeof(uint32_t) - 1 : frag_rows;
+  auto data_to_fetch = col_arr->Slice(static_cast<int64_t>(frag_offset),
+                                      static_cast<int64_t>(rows_to_fetch));
   uint32_t* dst_ptr = reinterpret_cast<uint32_t*>(dest->getMemoryPtr());
   uint32_t delta = 0;
   for (auto& chunk : data_to_fetch->chunks()) {
@@ -232,14 +536,12 @@ void ArrowStorage::fetchVarLenOffsets(const TableData& table,
   *dst_ptr = delta;
 }
 
-void ArrowStorage::fetchVarLenData(const TableData& table,
-                                   size_t frag_idx,
-                                   size_t col_idx,
+void ArrowStorage::fetchVarLenData(std::shared_ptr<arrow::ChunkedArray> col_arr,
+                                   size_t frag_offset,
+                                   size_t frag_rows,
                                    Data_Namespace::AbstractBuffer* dest,
                                    size_t num_bytes) const {
-  auto& frag = table.fragments[frag_idx];
-  auto data_to_fetch =
-      table.col_data[col_idx]->Slice(static_cast<int64_t>(frag.offset), frag.row_count);
+  auto data_to_fetch = col_arr->Slice(static_cast<int64_t>(frag_offset), frag_rows);
   int8_t* dst_ptr = dest->getMemoryPtr();
   size_t remained = num_bytes;
   for (auto& chunk : data_to_fetch->chunks()) {
@@ -256,15 +558,13 @@ void ArrowStorage::fetchVarLenData(const TableData& table,
   }
 }
 
-void ArrowStorage::fetchVarLenArrayData(const TableData& table,
-                                        size_t frag_idx,
-                                        size_t col_idx,
+void ArrowStorage::fetchVarLenArrayData(std::shared_ptr<arrow::ChunkedArray> col_arr,
+                                        size_t frag_offset,
+                                        size_t frag_rows,
                                         Data_Namespace::AbstractBuffer* dest,
                                         size_t elem_size,
                                         size_t num_bytes) const {
-  auto& frag = table.fragments[frag_idx];
-  auto data_to_fetch =
-      table.col_data[col_idx]->Slice(static_cast<int64_t>(frag.offset), frag.row_count);
+  auto data_to_fetch = col_arr->Slice(static_cast<int64_t>(frag_offset), frag_rows);
   int8_t* dst_ptr = dest->getMemoryPtr();
   size_t remained = num_bytes;
   for (auto& chunk : data_to_fetch->chunks()) {
@@ -291,6 +591,18 @@ TableFragmentsInfo ArrowStorage::getTableMetadata(int db_id, int table_id) const
   mapd_shared_lock<mapd_shared_mutex> table_lock(table.mutex);
   data_lock.unlock();
 
+  // Fragment infos of the copy share chunk metadata maps with the snapshot.
+  std::lock_guard<std::mutex> metadata_lock(table.metadata_mutex);
+  if (!table.metadata || table.metadata_generation != table.generation) {
+    table.metadata =
+        std::make_shared<const TableFragmentsInfo>(buildTableMetadata(table_id, table));
+    table.metadata_generation = table.generation;
+  }
+  return *table.metadata;
+}
+
+TableFragmentsInfo ArrowStorage::buildTableMetadata(int table_id,
+                                                    const TableData& table) const {
   if (table.fragments.empty()) {
     return getEmptyTableMetadata(table_id);
   }
@@ -310,6 +622,11 @@ TableFragmentsInfo ArrowStorage::getTableMetadata(int db_id, int table_id) const
       frag_info.setChunkMetadata(columnId(col_idx), frag.metadata[col_idx]);
     }
   }
+  for (size_t col_idx = 0; col_idx < table.col_stats.size(); ++col_idx) {
+    if (table.col_stats[col_idx]) {
+      res.columnStats.emplace(columnId(col_idx), table.col_stats[col_idx]);
+    }
+  }
   return res;
 }
 
@@ -339,6 +656,33 @@ const DictDescriptor* ArrowStorage::getDictMetadata(int dict_id, bool /*load_dic
   return nullptr;
 }
 
+int ArrowStorage::importDictionary(const std::string& file_name,
+                                   const std::string& name) {
+  mapd_unique_lock<mapd_shared_mutex> data_lock(data_mutex_);
+  mapd_unique_lock<mapd_shared_mutex> dict_lock(dict_mutex_);
+  if (next_dict_id_ > MAX_DB_ID) {
+    throw std::runtime_error("Dictionary count limit exceeded.");
+  }
+  int dict_id = addSchemaIdChecked(next_dict_id_, schema_id_);
+  auto string_dict = StringDictionary::loadFromFile(DictRef{db_id_, dict_id}, file_name);
+  ++next_dict_id_;
+  auto dict_desc =
+      std::make_unique<DictDescriptor>(db_id_, dict_id, name, 32, true, 1, "", true);
+  dict_desc->stringDict = std::move(string_dict);
+  dicts_.emplace(dict_id, std::move(dict_desc));
+  return dict_id;
+}
+
+void ArrowStorage::exportDictionary(int dict_id,
+                                    const std::string& file_name,
+                                    bool front_coded) {
+  auto dict_desc = getDictMetadata(dict_id);
+  if (!dict_desc) {
+    throw std::runtime_error("Unknown dictionary: "s + std::to_string(dict_id));
+  }
+  dict_desc->stringDict->saveToFile(file_name, front_coded);
+}
+
 TableInfoPtr ArrowStorage::createTable(const std::string& table_name,
                                        const std::vector<ColumnDescription>& columns,
                                        const TableOptions& options) {
@@ -351,7 +695,7 @@ TableInfoPtr ArrowStorage::createTable(const std::string& table_name,
     mapd_unique_lock<mapd_shared_mutex> schema_lock(schema_mutex_);
     table_id = next_table_id_++;
     checkNewTableParams(table_name, columns, options);
-    res = addTableInfo(db_id_, table_id, table_name, false, 0, 0);
+    res = addTableInfo(db_id_, table_id, table_name, false, 0, 0, options.is_stream);
     std::unordered_map<int, int> dict_ids;
     for (auto& col : columns) {
       auto type = col.type;
@@ -416,6 +760,10 @@ TableInfoPtr ArrowStorage::createTable(const std::string& table_name,
     CHECK(inserted);
     auto& table = *iter->second;
     table.fragment_size = options.fragment_size;
+    table.streaming_append = options.streaming_append || options.is_stream;
+    table.align_fragments_to_chunks = options.align_fragments_to_chunks;
+    table.min_fragment_size = std::min(options.min_fragment_size, options.fragment_size);
+    table.cluster_keys = options.cluster_keys;
     table.schema = schema;
   }
 
@@ -458,149 +806,97 @@ void ArrowStorage::appendArrowTable(std::shared_ptr<arrow::Table> at, int table_
   }
 
   auto& table = *tables_.at(table_id);
+  if (!table.parquet_file.empty()) {
+    throw std::runtime_error("Cannot append to Parquet-backed table: "s +
+                             std::to_string(table_id));
+  }
   compareSchemas(table.schema, at->schema());
 
-  mapd_unique_lock<mapd_shared_mutex> table_lock(table.mutex);
+  // Appends to the same table are serialized. New data is prepared without holding
+  // the table lock, so readers are blocked only while new fragments are published.
+  std::lock_guard<std::mutex> append_lock(table.append_mutex);
   data_lock.unlock();
 
+  if (!table.cluster_keys.empty() && at->num_rows() > 1) {
+    at = sortByClusterKeys(at, table.cluster_keys);
+  }
+
   std::vector<std::shared_ptr<arrow::ChunkedArray>> col_data;
   col_data.resize(at->columns().size());
-
-  std::vector<DataFragment> fragments;
-  // Compute size of the fragment. If the last existing fragment is not full, then it will
-  // be merged with the first new fragment.
-  size_t first_frag_size =
-      std::min(table.fragment_size, static_cast<size_t>(at->num_rows()));
-  if (!table.fragments.empty()) {
-    auto& last_frag = table.fragments.back();
-    if (last_frag.row_count < table.fragment_size) {
-      first_frag_size =
-          std::min(first_frag_size, table.fragment_size - last_frag.row_count);
+  std::vector<std::shared_ptr<const ColumnStats>> col_stats;
+  col_stats.resize(at->columns().size());
+
+  std::vector<size_t> frag_sizes;
+  bool merge_last_frag = false;
+  if (table.align_fragments_to_chunks) {
+    frag_sizes = computeChunkAlignedFragmentSizes(
+        at, table.fragment_size, table.min_fragment_size);
+  } else {
+    // Compute size of the fragment. If the last existing fragment is not full, then it
+    // will be merged with the first new fragment.
+    size_t first_frag_size =
+        std::min(table.fragment_size, static_cast<size_t>(at->num_rows()));
+    if (!table.fragments.empty() && !table.streaming_append) {
+      auto& last_frag = table.fragments.back();
+      if (last_frag.row_count < table.fragment_size) {
+        first_frag_size =
+            std::min(first_frag_size, table.fragment_size - last_frag.row_count);
+        merge_last_frag = true;
+      }
+    }
+    frag_sizes.push_back(first_frag_size);
+    for (size_t offset = first_frag_size; offset < static_cast<size_t>(at->num_rows());
+         offset += table.fragment_size) {
+      frag_sizes.push_back(
+          std::min(table.fragment_size, static_cast<size_t>(at->num_rows()) - offset));
     }
   }
-  // Now we can compute number of fragments to create.
-  size_t frag_count =
-      (static_cast<size_t>(at->num_rows()) + table.fragment_size - 1 - first_frag_size) /
-          table.fragment_size +
-      1;
-  fragments.resize(frag_count);
-  for (auto& frag : fragments) {
+
+  size_t frag_count = frag_sizes.size();
+  std::vector<DataFragment> fragments(frag_count);
+  size_t frag_offset = 0;
+  for (size_t frag_idx = 0; frag_idx < frag_count; ++frag_idx) {
+    auto& frag = fragments[frag_idx];
+    frag.offset = frag_offset;
+    frag.row_count = frag_sizes[frag_idx];
     frag.metadata.resize(at->columns().size());
+    frag_offset += frag.row_count;
   }
+  CHECK_EQ(frag_offset, static_cast<size_t>(at->num_rows()));
 
+  const size_t col_count = at->columns().size();
+  std::vector<const hdk::ir::Type*> col_types(col_count);
   mapd_shared_lock<mapd_shared_mutex> dict_lock(dict_mutex_);
   threading::parallel_for(
-      threading::blocked_range(0, (int)at->columns().size()), [&](auto range) {
+      threading::blocked_range(size_t(0), col_count), [&](auto range) {
         for (auto col_idx = range.begin(); col_idx != range.end(); col_idx++) {
-          auto col_info = getColumnInfo(db_id_, table_id, columnId(col_idx));
-          auto col_type = col_info->type;
-          auto col_arr = at->column(col_idx);
-
-          // Conversion of empty string to Nulls and further processing handled
-          // separately.
-          if (!col_type->nullable() && col_arr->null_count() != 0 &&
-              col_arr->type()->id() != arrow::Type::STRING) {
-            throw std::runtime_error("Null values used in non-nullable type: "s +
-                                     col_type->toString());
-          }
-
-          StringDictionary* dict = nullptr;
-          auto elem_type =
-              col_type->isArray()
-                  ? dynamic_cast<const hdk::ir::ArrayBaseType*>(col_type)->elemType()
-                  : col_type;
-          if (elem_type->isExtDictionary()) {
-            dict = dicts_
-                       .at(dynamic_cast<const hdk::ir::ExtDictionaryType*>(elem_type)
-                               ->dictId())
-                       ->stringDict.get();
-          }
-
-          if (col_type->isDecimal()) {
-            col_arr = convertDecimalToInteger(col_arr, col_type);
-          } else if (col_type->isExtDictionary()) {
-            switch (col_arr->type()->id()) {
-              case arrow::Type::STRING:
-                col_arr = createDictionaryEncodedColumn(dict, col_arr, col_type);
-                break;
-              case arrow::Type::DICTIONARY:
-                col_arr = convertArrowDictionary(dict, col_arr, col_type);
-                break;
-              default:
-                CHECK(false);
-            }
-          } else if (col_type->isString()) {
-          } else {
-            col_arr = replaceNullValues(col_arr, col_type, dict);
-          }
-
-          col_data[col_idx] = col_arr;
-
-          bool compute_stats = !col_type->isString();
-          if (compute_stats) {
-            size_t elems_count = 1;
-            if (col_type->isFixedLenArray()) {
-              elems_count = col_type->size() / elem_type->size();
-            }
-            // Compute stats for each fragment.
-            threading::parallel_for(
-                threading::blocked_range(size_t(0), frag_count), [&](auto frag_range) {
-                  for (size_t frag_idx = frag_range.begin(); frag_idx != frag_range.end();
-                       ++frag_idx) {
-                    auto& frag = fragments[frag_idx];
-
-                    frag.offset =
-                        frag_idx
-                            ? ((frag_idx - 1) * table.fragment_size + first_frag_size)
-                            : 0;
-                    frag.row_count =
-                        frag_idx
-                            ? std::min(table.fragment_size,
-                                       static_cast<size_t>(at->num_rows()) - frag.offset)
-                            : first_frag_size;
-
-                    size_t num_bytes;
-                    if (col_type->isFixedLenArray()) {
-                      num_bytes = frag.row_count * col_type->size();
-                    } else if (col_type->isVarLenArray()) {
-                      num_bytes =
-                          computeTotalStringsLength(col_arr, frag.offset, frag.row_count);
-                    } else {
-                      num_bytes = frag.row_count * col_type->size();
-                    }
-                    auto meta = std::make_shared<ChunkMetadata>(
-                        col_info->type, num_bytes, frag.row_count);
-
-                    meta->fillChunkStats(computeStats(
-                        col_arr->Slice(frag.offset, frag.row_count * elems_count),
-                        col_type));
-                    frag.metadata[col_idx] = meta;
-                  }
-                });  // each fragment
+          col_types[col_idx] = getColumnInfo(db_id_, table_id, columnId(col_idx))->type;
+          col_data[col_idx] = convertArrowColumn(at->column(col_idx), col_types[col_idx]);
+        }
+      });  // each column
+  // Chunk metadata is computed for (column, fragment) pairs in a single parallel loop,
+  // so wide tables with few fragments and narrow tables with many fragments both load
+  // all threads. Column stats are computed as an additional pseudo fragment.
+  const size_t tasks_per_col = frag_count + 1;
+  threading::parallel_for(
+      threading::blocked_range(size_t(0), col_count * tasks_per_col), [&](auto range) {
+        for (auto task_idx = range.begin(); task_idx != range.end(); task_idx++) {
+          const size_t col_idx = task_idx / tasks_per_col;
+          const size_t frag_idx = task_idx % tasks_per_col;
+          auto col_type = col_types[col_idx];
+          auto& col_arr = col_data[col_idx];
+          if (frag_idx == frag_count) {
+            col_stats[col_idx] = computeColumnStats(col_arr, col_type);
           } else {
-            for (size_t frag_idx = 0; frag_idx < frag_count; ++frag_idx) {
-              auto& frag = fragments[frag_idx];
-              frag.offset =
-                  frag_idx ? ((frag_idx - 1) * table.fragment_size + first_frag_size) : 0;
-              frag.row_count =
-                  frag_idx ? std::min(table.fragment_size,
-                                      static_cast<size_t>(at->num_rows()) - frag.offset)
-                           : first_frag_size;
-              CHECK(col_type->isText());
-              auto meta = std::make_shared<ChunkMetadata>(
-                  col_info->type,
-                  computeTotalStringsLength(col_arr, frag.offset, frag.row_count),
-                  frag.row_count);
-              meta->fillStringChunkStats(
-                  col_arr->Slice(frag.offset, frag.row_count)->null_count());
-
-              frag.metadata[col_idx] = meta;
-            }
+            auto& frag = fragments[frag_idx];
+            frag.metadata[col_idx] =
+                computeChunkMetadata(col_arr, col_type, frag.offset, frag.row_count);
           }
         }
-      });  // each column
+      });  // each column and fragment
   dict_lock.unlock();
 
+  mapd_unique_lock<mapd_shared_mutex> table_lock(table.mutex);
   if (table.row_count) {
     // If table is not empty then we have to merge chunked arrays.
     CHECK_EQ(table.col_data.size(), col_data.size());
@@ -611,10 +907,21 @@ void ArrowStorage::appendArrowTable(std::shared_ptr<arrow::Table> at, int table_
       table.col_data[i] = arrow::ChunkedArray::Make(std::move(lhs)).ValueOrDie();
     }
 
+    // Published statistics are shared with table metadata snapshots, so merged stats
+    // are stored in new objects.
+    CHECK_EQ(table.col_stats.size(), col_stats.size());
+    for (size_t i = 0; i < table.col_stats.size(); ++i) {
+      if (table.col_stats[i] && col_stats[i]) {
+        auto merged_stats = std::make_shared<ColumnStats>(*table.col_stats[i]);
+        merged_stats->merge(*col_stats[i]);
+        table.col_stats[i] = std::move(merged_stats);
+      }
+    }
+
     // Probably need to merge the last existing fragment with the first new one.
     size_t start_frag = 0;
     auto& last_frag = table.fragments.back();
-    if (last_frag.row_count < table.fragment_size) {
+    if (merge_last_frag) {
       auto& first_frag = fragments.front();
       last_frag.row_count += first_frag.row_count;
       for (size_t col_idx = 0; col_idx < last_frag.metadata.size(); ++col_idx) {
@@ -625,8 +932,18 @@ void ArrowStorage::appendArrowTable(std::shared_ptr<arrow::Table> at, int table_
                            first_frag.metadata[col_idx]->numBytes();
         auto stats = last_frag.metadata[col_idx]->chunkStats();
         mergeStats(stats, first_frag.metadata[col_idx]->chunkStats(), col_type);
+        auto last_filter = last_frag.metadata[col_idx]->dictIdFilter();
+        auto first_filter = first_frag.metadata[col_idx]->dictIdFilter();
+        std::shared_ptr<DictIdFilter> filter;
+        if (last_filter && first_filter) {
+          filter = std::make_shared<DictIdFilter>(*last_filter);
+          filter->merge(*first_filter);
+        }
         last_frag.metadata[col_idx] =
             std::make_shared<ChunkMetadata>(col_type, num_bytes, num_elems, stats);
+        if (filter && !filter->isSaturated()) {
+          last_frag.metadata[col_idx]->setDictIdFilter(filter);
+        }
       }
       start_frag = 1;
     }
@@ -642,9 +959,11 @@ void ArrowStorage::appendArrowTable(std::shared_ptr<arrow::Table> at, int table_
   } else {
     CHECK_EQ(table.row_count, (size_t)0);
     table.col_data = std::move(col_data);
+    table.col_stats = std::move(col_stats);
     table.fragments = std::move(fragments);
     table.row_count = at->num_rows();
   }
+  ++table.generation;
 
   auto table_info = getTableInfo(db_id_, table_id);
   table_info->fragments = table.fragments.size();
@@ -656,35 +975,28 @@ TableInfoPtr ArrowStorage::importCsvFile(const std::string& file_name,
                                          const std::vector<ColumnDescription>& columns,
                                          const TableOptions& options,
                                          const CsvParseOptions parse_options) {
-  std::unordered_map<std::string, const hdk::ir::Type*> col_types;
-  ColumnInfoList col_infos;
-  col_infos.reserve(columns.size());
-  for (auto& col : columns) {
-    col_infos.emplace_back(
-        std::make_shared<ColumnInfo>(-1, -1, -1, col.name, col.type, false));
-    if (col.type) {
-      col_types.emplace(col.name, col.type);
-    }
+  auto col_infos = getImportColumnInfos(columns);
+  std::shared_ptr<arrow::Table> at;
+  std::shared_ptr<arrow::RecordBatchReader> reader;
+  std::shared_ptr<arrow::Schema> schema;
+  if (parse_options.streaming) {
+    reader = openCsvFileStream(file_name, parse_options, col_infos);
+    schema = reader->schema();
+  } else {
+    at = parseCsvFile(file_name, parse_options, col_infos);
+    schema = at->schema();
   }
-  auto at = parseCsvFile(file_name, parse_options, col_infos);
   // We allow partial schema specification in columns arg which
   // means missing columns and/or column types. Fill missing
   // info using parsed table schema.
-  std::vector<ColumnDescription> updated_columns;
-  updated_columns.reserve(at->columns().size());
-  for (size_t i = 0; i < at->columns().size(); ++i) {
-    ColumnDescription col_desc;
-    col_desc.name = at->schema()->field(i)->name();
-    if (col_types.count(col_desc.name)) {
-      col_desc.type = col_types.at(col_desc.name);
-    } else {
-      col_desc.type = getTargetImportType(ctx_, *at->schema()->field(i)->type());
-    }
-    updated_columns.emplace_back(std::move(col_desc));
-  }
+  auto updated_columns = getImportColumns(ctx_, *schema, columns);
 
   auto res = createTable(table_name, updated_columns, options);
-  appendArrowTable(at, res->table_id);
+  if (reader) {
+    appendRecordBatches(reader, res->table_id);
+  } else {
+    appendArrowTable(at, res->table_id);
+  }
   return res;
 }
 
@@ -692,6 +1004,9 @@ TableInfoPtr ArrowStorage::importCsvFile(const std::string& file_name,
                                          const std::string& table_name,
                                          const TableOptions& options,
                                          const CsvParseOptions parse_options) {
+  if (parse_options.streaming) {
+    return importCsvFile(file_name, table_name, {}, options, parse_options);
+  }
   auto at = parseCsvFile(file_name, parse_options);
   return importArrowTable(at, table_name, options);
 }
@@ -714,6 +1029,11 @@ void ArrowStorage::appendCsvFile(const std::string& file_name,
   }
 
   auto col_infos = listColumns(db_id_, table_id);
+  if (parse_options.streaming) {
+    appendRecordBatches(openCsvFileStream(file_name, parse_options, col_infos),
+                        table_id);
+    return;
+  }
   auto at = parseCsvFile(file_name, parse_options, col_infos);
   appendArrowTable(at, table_id);
 }
@@ -762,6 +1082,48 @@ void ArrowStorage::appendJsonData(const std::string& json_data,
   appendArrowTable(at, table_id);
 }
 
+TableInfoPtr ArrowStorage::importJsonFile(const std::string& file_name,
+                                          const std::string& table_name,
+                                          const std::vector<ColumnDescription>& columns,
+                                          const TableOptions& options,
+                                          const JsonParseOptions parse_options) {
+  auto reader =
+      openJsonFileStream(file_name, parse_options, getImportColumnInfos(columns));
+  auto res = createTable(
+      table_name, getImportColumns(ctx_, *reader->schema(), columns), options);
+  appendRecordBatches(reader, res->table_id);
+  return res;
+}
+
+TableInfoPtr ArrowStorage::importJsonFile(const std::string& file_name,
+                                          const std::string& table_name,
+                                          const TableOptions& options,
+                                          const JsonParseOptions parse_options) {
+  return importJsonFile(file_name, table_name, {}, options, parse_options);
+}
+
+void ArrowStorage::appendJsonFile(const std::string& file_name,
+                                  const std::string& table_name,
+                                  const JsonParseOptions parse_options) {
+  auto tinfo = getTableInfo(db_id_, table_name);
+  if (!tinfo) {
+    throw std::runtime_error("Unknown table: "s + table_name);
+  }
+  appendJsonFile(file_name, tinfo->table_id, parse_options);
+}
+
+void ArrowStorage::appendJsonFile(const std::string& file_name,
+                                  int table_id,
+                                  const JsonParseOptions parse_options) {
+  if (!getTableInfo(db_id_, table_id)) {
+    throw std::runtime_error("Invalid table id: "s + std::to_string(table_id));
+  }
+
+  auto col_infos = listColumns(db_id_, table_id);
+  appendRecordBatches(openJsonFileStream(file_name, parse_options, col_infos),
+                      table_id);
+}
+
 TableInfoPtr ArrowStorage::importParquetFile(const std::string& file_name,
                                              const std::string& table_name,
                                              const TableOptions& options) {
@@ -787,6 +1149,190 @@ void ArrowStorage::appendParquetFile(const std::string& file_name, int table_id)
   appendArrowTable(at, table_id);
 }
 
+TableInfoPtr ArrowStorage::importArrowIpcFile(const std::string& file_name,
+                                              const std::string& table_name,
+                                              const TableOptions& options) {
+  auto at = readArrowIpcFile(file_name);
+  return importArrowTable(at, table_name, options);
+}
+
+void ArrowStorage::appendArrowIpcFile(const std::string& file_name,
+                                      const std::string& table_name) {
+  auto tinfo = getTableInfo(db_id_, table_name);
+  if (!tinfo) {
+    throw std::runtime_error("Unknown table: "s + table_name);
+  }
+  appendArrowIpcFile(file_name, tinfo->table_id);
+}
+
+void ArrowStorage::appendArrowIpcFile(const std::string& file_name, int table_id) {
+  if (!getTableInfo(db_id_, table_id)) {
+    throw std::runtime_error("Invalid table id: "s + std::to_string(table_id));
+  }
+
+  auto at = readArrowIpcFile(file_name);
+  appendArrowTable(at, table_id);
+}
+
+namespace {
+
+std::string sharedGenerationFile(const std::string& segment_dir, size_t generation) {
+  return (std::filesystem::path(segment_dir) /
+          ("gen_" + std::to_string(generation) + ".arrow"))
+      .string();
+}
+
+}  // namespace
+
+size_t ArrowStorage::publishSharedGeneration(const std::string& segment_dir,
+                                             std::shared_ptr<arrow::Table> at) {
+  std::filesystem::create_directories(segment_dir);
+  size_t generation = 0;
+  while (std::filesystem::exists(sharedGenerationFile(segment_dir, generation))) {
+    ++generation;
+  }
+
+  // Readers never see a partially written generation because the file gets its
+  // name after it is complete.
+  auto file_name = sharedGenerationFile(segment_dir, generation);
+  auto tmp_file_name = file_name + ".tmp";
+  std::shared_ptr<arrow::io::FileOutputStream> file;
+  ARROW_ASSIGN_OR_THROW(file, arrow::io::FileOutputStream::Open(tmp_file_name));
+  std::shared_ptr<arrow::ipc::RecordBatchWriter> writer;
+  ARROW_ASSIGN_OR_THROW(writer, arrow::ipc::MakeFileWriter(file, at->schema()));
+  ARROW_THROW_NOT_OK(writer->WriteTable(*at));
+  ARROW_THROW_NOT_OK(writer->Close());
+  ARROW_THROW_NOT_OK(file->Close());
+  std::filesystem::rename(tmp_file_name, file_name);
+  return generation;
+}
+
+TableInfoPtr ArrowStorage::attachSharedTable(const std::string& segment_dir,
+                                             const std::string& table_name,
+                                             const TableOptions& options) {
+  auto first_file = sharedGenerationFile(segment_dir, 0);
+  if (!std::filesystem::exists(first_file)) {
+    throw std::runtime_error("No data is published in shared segment: "s +
+                             segment_dir);
+  }
+  std::lock_guard<std::mutex> refresh_lock(shared_refresh_mutex_);
+  auto res = importArrowIpcFile(first_file, table_name, options);
+  {
+    mapd_shared_lock<mapd_shared_mutex> data_lock(data_mutex_);
+    auto& table = *tables_.at(res->table_id);
+    table.shared_segment = segment_dir;
+    table.shared_generations = 1;
+  }
+  refreshSharedTableNoLock(res->table_id);
+  return getTableInfo(db_id_, res->table_id);
+}
+
+size_t ArrowStorage::refreshSharedTable(const std::string& table_name) {
+  auto tinfo = getTableInfo(db_id_, table_name);
+  if (!tinfo) {
+    throw std::runtime_error("Unknown table: "s + table_name);
+  }
+  std::lock_guard<std::mutex> refresh_lock(shared_refresh_mutex_);
+  return refreshSharedTableNoLock(tinfo->table_id);
+}
+
+size_t ArrowStorage::refreshSharedTableNoLock(int table_id) {
+  size_t appended = 0;
+  while (true) {
+    std::string file_name;
+    {
+      mapd_shared_lock<mapd_shared_mutex> data_lock(data_mutex_);
+      if (!tables_.count(table_id)) {
+        throw std::runtime_error("Invalid table id: "s + std::to_string(table_id));
+      }
+      auto& table = *tables_.at(table_id);
+      if (table.shared_segment.empty()) {
+        throw std::runtime_error("Table is not attached to a shared segment.");
+      }
+      file_name = sharedGenerationFile(table.shared_segment, table.shared_generations);
+    }
+    if (!std::filesystem::exists(file_name)) {
+      break;
+    }
+    appendArrowIpcFile(file_name, table_id);
+    {
+      mapd_shared_lock<mapd_shared_mutex> data_lock(data_mutex_);
+      if (tables_.count(table_id)) {
+        ++tables_.at(table_id)->shared_generations;
+      }
+    }
+    ++appended;
+  }
+  return appended;
+}
+
+TableInfoPtr ArrowStorage::registerParquetFile(const std::string& file_name,
+                                               const std::string& table_name) {
+  auto arrow_reader = openParquetFile(file_name);
+  std::shared_ptr<arrow::Schema> schema;
+  ARROW_THROW_NOT_OK(arrow_reader->GetSchema(&schema));
+
+  std::vector<ColumnDescription> columns;
+  for (auto& field : schema->fields()) {
+    columns.push_back({field->name(), getTargetImportType(ctx_, *field->type())});
+  }
+  auto res = createTable(table_name, columns);
+
+  std::vector<const hdk::ir::Type*> col_types;
+  for (int col_idx = 0; col_idx < schema->num_fields(); ++col_idx) {
+    col_types.push_back(getColumnInfo(db_id_, res->table_id, columnId(col_idx))->type);
+  }
+
+  auto file_meta = arrow_reader->parquet_reader()->metadata();
+  // Row group statistics are mapped to columns only for flat schemas.
+  bool use_parquet_stats = file_meta->num_columns() == schema->num_fields();
+  std::vector<DataFragment> fragments(file_meta->num_row_groups());
+  size_t row_count = 0;
+  threading::parallel_for(
+      threading::blocked_range(0, file_meta->num_row_groups()), [&](auto range) {
+        for (auto rg_idx = range.begin(); rg_idx != range.end(); ++rg_idx) {
+          auto rg_meta = file_meta->RowGroup(rg_idx);
+          auto& frag = fragments[rg_idx];
+          frag.row_count = static_cast<size_t>(rg_meta->num_rows());
+          frag.metadata.resize(schema->num_fields());
+          for (int col_idx = 0; col_idx < schema->num_fields(); ++col_idx) {
+            auto col_type = col_types[col_idx];
+            if (use_parquet_stats) {
+              frag.metadata[col_idx] =
+                  getParquetChunkMetadata(*rg_meta->ColumnChunk(col_idx),
+                                          *schema->field(col_idx)->type(),
+                                          col_type,
+                                          frag.row_count);
+            }
+            // Data is read to compute metadata when there are no usable stats in the
+            // file.
+            if (!frag.metadata[col_idx]) {
+              auto col_arr = readParquetColumn(file_name, rg_idx, col_idx, col_type);
+              frag.metadata[col_idx] =
+                  computeChunkMetadata(col_arr, col_type, 0, frag.row_count);
+            }
+          }
+        }
+      });
+  for (auto& frag : fragments) {
+    frag.offset = row_count;
+    row_count += frag.row_count;
+  }
+
+  mapd_shared_lock<mapd_shared_mutex> data_lock(data_mutex_);
+  auto& table = *tables_.at(res->table_id);
+  mapd_unique_lock<mapd_shared_mutex> table_lock(table.mutex);
+  data_lock.unlock();
+  table.parquet_file = file_name;
+  table.fragments = std::move(fragments);
+  table.row_count = row_count;
+  ++table.generation;
+  res->fragments = table.fragments.size();
+  res->row_count = table.row_count;
+
+  return res;
+}
+
 void ArrowStorage::dropTable(const std::string& table_name, bool throw_if_not_exist) {
   auto tinfo = getTableInfo(db_id_, table_name);
   if (!tinfo) {
@@ -800,8 +1346,6 @@ void ArrowStorage::dropTable(const std::string& table_name, bool throw_if_not_ex
 
 void ArrowStorage::dropTable(int table_id, bool throw_if_not_exist) {
   mapd_unique_lock<mapd_shared_mutex> data_lock(data_mutex_);
-  mapd_unique_lock<mapd_shared_mutex> dict_lock(dict_mutex_);
-  mapd_unique_lock<mapd_shared_mutex> schema_lock(schema_mutex_);
 
   if (!tables_.count(table_id)) {
     if (throw_if_not_exist) {
@@ -810,8 +1354,15 @@ void ArrowStorage::dropTable(int table_id, bool throw_if_not_exist) {
     }
   }
 
+  // In-progress append takes the dictionary lock, so wait for it to finish before
+  // locking dictionaries. No new appends can start while we hold the data lock.
+  std::unique_lock<std::mutex> append_lock(tables_.at(table_id)->append_mutex);
+  mapd_unique_lock<mapd_shared_mutex> dict_lock(dict_mutex_);
+  mapd_unique_lock<mapd_shared_mutex> schema_lock(schema_mutex_);
+
   std::unique_ptr<TableData> table = std::move(tables_.at(table_id));
   mapd_unique_lock<mapd_shared_mutex> table_lock(table->mutex);
+  append_lock.unlock();
   tables_.erase(table_id);
 
   std::unordered_set<int> dicts_to_remove;
@@ -894,6 +1445,22 @@ void ArrowStorage::checkNewTableParams(const std::string& table_name,
 
     col_names.insert(col.name);
   }
+
+  std::unordered_set<std::string> cluster_keys;
+  for (auto& key : options.cluster_keys) {
+    auto col_it = std::find_if(columns.begin(), columns.end(), [&key](auto& col) {
+      return col.name == key;
+    });
+    if (col_it == columns.end()) {
+      throw std::runtime_error("Unknown cluster key column: "s + key);
+    }
+    if (col_it->type->isArray()) {
+      throw std::runtime_error("Cannot cluster by array column: "s + key);
+    }
+    if (!cluster_keys.insert(key).second) {
+      throw std::runtime_error("Duplicated cluster key column: "s + key);
+    }
+  }
 }
 
 void ArrowStorage::compareSchemas(std::shared_ptr<arrow::Schema> lhs,
@@ -920,6 +1487,83 @@ void ArrowStorage::compareSchemas(std::shared_ptr<arrow::Schema> lhs,
   }
 }
 
+std::shared_ptr<arrow::ChunkedArray> ArrowStorage::convertArrowColumn(
+    std::shared_ptr<arrow::ChunkedArray> col_arr,
+    const hdk::ir::Type* col_type) const {
+  // Conversion of empty string to Nulls and further processing handled
+  // separately.
+  if (!col_type->nullable() && col_arr->null_count() != 0 &&
+      col_arr->type()->id() != arrow::Type::STRING) {
+    throw std::runtime_error("Null values used in non-nullable type: "s +
+                             col_type->toString());
+  }
+
+  StringDictionary* dict = nullptr;
+  auto elem_type =
+      col_type->isArray()
+          ? dynamic_cast<const hdk::ir::ArrayBaseType*>(col_type)->elemType()
+          : col_type;
+  if (elem_type->isExtDictionary()) {
+    dict = dicts_
+               .at(dynamic_cast<const hdk::ir::ExtDictionaryType*>(elem_type)->dictId())
+               ->stringDict.get();
+  }
+
+  if (col_type->isDecimal()) {
+    col_arr = convertDecimalToInteger(col_arr, col_type);
+  } else if (col_type->isExtDictionary()) {
+    switch (col_arr->type()->id()) {
+      case arrow::Type::STRING:
+        col_arr = createDictionaryEncodedColumn(dict, col_arr, col_type);
+        break;
+      case arrow::Type::DICTIONARY:
+        col_arr = convertArrowDictionary(dict, col_arr, col_type);
+        break;
+      default:
+        CHECK(false);
+    }
+  } else if (col_type->isString()) {
+  } else {
+    col_arr = replaceNullValues(col_arr, col_type, dict);
+  }
+
+  return col_arr;
+}
+
+std::shared_ptr<ChunkMetadata> ArrowStorage::computeChunkMetadata(
+    std::shared_ptr<arrow::ChunkedArray> col_arr,
+    const hdk::ir::Type* col_type,
+    size_t offset,
+    size_t row_count) {
+  if (col_type->isString()) {
+    CHECK(col_type->isText());
+    auto meta = std::make_shared<ChunkMetadata>(
+        col_type, computeTotalStringsLength(col_arr, offset, row_count), row_count);
+    meta->fillStringChunkStats(col_arr->Slice(offset, row_count)->null_count());
+    return meta;
+  }
+
+  size_t elems_count = 1;
+  size_t num_bytes;
+  if (col_type->isFixedLenArray()) {
+    elems_count =
+        col_type->size() / col_type->as<hdk::ir::ArrayBaseType>()->elemType()->size();
+    num_bytes = row_count * col_type->size();
+  } else if (col_type->isVarLenArray()) {
+    num_bytes = computeTotalStringsLength(col_arr, offset, row_count);
+  } else {
+    num_bytes = row_count * col_type->size();
+  }
+  auto meta = std::make_shared<ChunkMetadata>(col_type, num_bytes, row_count);
+  meta->fillChunkStats(
+      computeStats(col_arr->Slice(offset, row_count * elems_count), col_type));
+  if (col_type->isExtDictionary()) {
+    meta->setDictIdFilter(
+        computeDictIdFilter(col_arr->Slice(offset, row_count), col_type));
+  }
+  return meta;
+}
+
 ChunkStats ArrowStorage::computeStats(std::shared_ptr<arrow::ChunkedArray> arr,
                                       const hdk::ir::Type* type) {
   auto elem_type =
@@ -976,36 +1620,8 @@ std::shared_ptr<arrow::Table> ArrowStorage::parseCsv(
     const CsvParseOptions parse_options,
     const ColumnInfoList& col_infos) {
   auto io_context = arrow::io::default_io_context();
-
-  auto arrow_parse_options = arrow::csv::ParseOptions::Defaults();
-  arrow_parse_options.quoting = false;
-  arrow_parse_options.escaping = false;
-  arrow_parse_options.newlines_in_values = false;
-  arrow_parse_options.delimiter = parse_options.delimiter;
-
-  auto arrow_read_options = arrow::csv::ReadOptions::Defaults();
-  arrow_read_options.use_threads = true;
-  arrow_read_options.block_size = parse_options.block_size;
-  arrow_read_options.autogenerate_column_names =
-      !parse_options.header && col_infos.empty();
-  arrow_read_options.skip_rows = parse_options.skip_rows;
-
-  auto arrow_convert_options = arrow::csv::ConvertOptions::Defaults();
-  arrow_convert_options.check_utf8 = false;
-  arrow_convert_options.include_columns = arrow_read_options.column_names;
-  arrow_convert_options.strings_can_be_null = true;
-
-  for (auto& col_info : col_infos) {
-    if (!col_info->is_rowid) {
-      if (!parse_options.header) {
-        arrow_read_options.column_names.push_back(col_info->name);
-      }
-      if (col_info->type) {
-        arrow_convert_options.column_types.emplace(
-            col_info->name, getArrowImportType(ctx_, col_info->type));
-      }
-    }
-  }
+  auto [arrow_read_options, arrow_parse_options, arrow_convert_options] =
+      getArrowCsvOptions(ctx_, parse_options, col_infos);
 
   auto table_reader_result = arrow::csv::TableReader::Make(
       io_context, input, arrow_read_options, arrow_parse_options, arrow_convert_options);
@@ -1024,6 +1640,95 @@ std::shared_ptr<arrow::Table> ArrowStorage::parseCsv(
   return at;
 }
 
+std::shared_ptr<arrow::RecordBatchReader> ArrowStorage::openCsvFileStream(
+    const std::string& file_name,
+    const CsvParseOptions parse_options,
+    const ColumnInfoList& col_infos) {
+  auto file_result = arrow::io::ReadableFile::Open(file_name.c_str());
+  ARROW_THROW_NOT_OK(file_result.status());
+  auto [arrow_read_options, arrow_parse_options, arrow_convert_options] =
+      getArrowCsvOptions(ctx_, parse_options, col_infos);
+  // Reader parses blocks ahead on multiple threads when use_threads is enabled.
+  auto reader_result = arrow::csv::StreamingReader::Make(arrow::io::default_io_context(),
+                                                         file_result.ValueOrDie(),
+                                                         arrow_read_options,
+                                                         arrow_parse_options,
+                                                         arrow_convert_options);
+  ARROW_THROW_NOT_OK(reader_result.status());
+  return reader_result.ValueOrDie();
+}
+
+std::shared_ptr<arrow::RecordBatchReader> ArrowStorage::openJsonFileStream(
+    const std::string& file_name,
+    const JsonParseOptions parse_options,
+    const ColumnInfoList& col_infos) {
+  auto file_result = arrow::io::ReadableFile::Open(file_name.c_str());
+  ARROW_THROW_NOT_OK(file_result.status());
+  auto [arrow_read_options, arrow_parse_options] =
+      getArrowJsonOptions(ctx_, parse_options, col_infos);
+  // Types of columns missing in the explicit schema are inferred from the first
+  // block and fixed for the rest of the file. Following blocks are parsed ahead on
+  // multiple threads when use_threads is enabled.
+  auto reader_result = arrow::json::StreamingReader::Make(
+      file_result.ValueOrDie(), arrow_read_options, arrow_parse_options);
+  ARROW_THROW_NOT_OK(reader_result.status());
+  return reader_result.ValueOrDie();
+}
+
+void ArrowStorage::appendRecordBatches(std::shared_ptr<arrow::RecordBatchReader> reader,
+                                       const std::string& table_name) {
+  auto tinfo = getTableInfo(db_id_, table_name);
+  if (!tinfo) {
+    throw std::runtime_error("Unknown table: "s + table_name);
+  }
+  appendRecordBatches(reader, tinfo->table_id);
+}
+
+void ArrowStorage::appendRecordBatches(std::shared_ptr<arrow::RecordBatchReader> reader,
+                                       int table_id) {
+  size_t fragment_size;
+  {
+    mapd_shared_lock<mapd_shared_mutex> data_lock(data_mutex_);
+    if (!tables_.count(table_id)) {
+      throw std::runtime_error("Invalid table id: "s + std::to_string(table_id));
+    }
+    fragment_size = tables_.at(table_id)->fragment_size;
+  }
+
+  // Batches are accumulated up to the fragment size, so that each append creates
+  // full fragments and computes their stats while the rest of the input is not
+  // read yet.
+  arrow::RecordBatchVector batches;
+  size_t rows = 0;
+  auto flush = [&]() {
+    auto table_result = arrow::Table::FromRecordBatches(reader->schema(), batches);
+    ARROW_THROW_NOT_OK(table_result.status());
+    appendArrowTable(table_result.ValueOrDie(), table_id);
+    batches.clear();
+    rows = 0;
+  };
+
+  auto time = measure<>::execution([&]() {
+    while (true) {
+      std::shared_ptr<arrow::RecordBatch> batch;
+      ARROW_THROW_NOT_OK(reader->ReadNext(&batch));
+      if (!batch) {
+        break;
+      }
+      rows += batch->num_rows();
+      batches.emplace_back(std::move(batch));
+      if (rows >= fragment_size) {
+        flush();
+      }
+    }
+    if (!batches.empty()) {
+      flush();
+    }
+  });
+
+  VLOG(1) << "Imported Arrow record batch stream in " << time << "ms";
+}
+
 std::shared_ptr<arrow::Table> ArrowStorage::parseJsonData(
     const std::string& json_data,
     const JsonParseOptions parse_options,
@@ -1036,25 +1741,8 @@ std::shared_ptr<arrow::Table> ArrowStorage::parseJson(
     std::shared_ptr<arrow::io::InputStream> input,
     const JsonParseOptions parse_options,
     const ColumnInfoList& col_infos) {
-  arrow::FieldVector fields;
-  fields.reserve(col_infos.size());
-  for (auto& col_info : col_infos) {
-    if (!col_info->is_rowid) {
-      fields.emplace_back(
-          std::make_shared<arrow::Field>(col_info->name,
-                                         getArrowImportType(ctx_, col_info->type),
-                                         col_info->type->nullable()));
-    }
-  }
-  auto schema = std::make_shared<arrow::Schema>(std::move(fields));
-
-  auto arrow_parse_options = arrow::json::ParseOptions::Defaults();
-  arrow_parse_options.newlines_in_values = false;
-  arrow_parse_options.explicit_schema = schema;
-
-  auto arrow_read_options = arrow::json::ReadOptions::Defaults();
-  arrow_read_options.use_threads = true;
-  arrow_read_options.block_size = parse_options.block_size;
+  auto [arrow_read_options, arrow_parse_options] =
+      getArrowJsonOptions(ctx_, parse_options, col_infos);
 
   auto table_reader_result = arrow::json::TableReader::Make(
       arrow::default_memory_pool(), input, arrow_read_options, arrow_parse_options);
@@ -1073,6 +1761,126 @@ std::shared_ptr<arrow::Table> ArrowStorage::parseJson(
   return at;
 }
 
+std::shared_ptr<arrow::Table> ArrowStorage::readArrowIpcFile(
+    const std::string& file_name) {
+  std::shared_ptr<arrow::io::MemoryMappedFile> file;
+  ARROW_ASSIGN_OR_THROW(
+      file, arrow::io::MemoryMappedFile::Open(file_name, arrow::io::FileMode::READ));
+  std::shared_ptr<arrow::ipc::RecordBatchFileReader> reader;
+  ARROW_ASSIGN_OR_THROW(reader, arrow::ipc::RecordBatchFileReader::Open(file));
+
+  // Buffers of uncompressed batches are slices of the mapped file. The mapping is
+  // kept alive until all of them are released.
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+  batches.reserve(reader->num_record_batches());
+  for (int i = 0; i < reader->num_record_batches(); ++i) {
+    std::shared_ptr<arrow::RecordBatch> batch;
+    ARROW_ASSIGN_OR_THROW(batch, reader->ReadRecordBatch(i));
+    batches.emplace_back(std::move(batch));
+  }
+
+  std::shared_ptr<arrow::Table> table;
+  ARROW_ASSIGN_OR_THROW(table,
+                        arrow::Table::FromRecordBatches(reader->schema(), batches));
+  return table;
+}
+
+std::unique_ptr<parquet::arrow::FileReader> ArrowStorage::openParquetFile(
+    const std::string& file_name) const {
+  auto file_result = arrow::io::ReadableFile::Open(file_name.c_str());
+  ARROW_THROW_NOT_OK(file_result.status());
+  auto parquet_reader = parquet::ParquetFileReader::Open(file_result.ValueOrDie());
+
+  std::unique_ptr<parquet::arrow::FileReader> arrow_reader;
+  parquet::ArrowReaderProperties prop(true);
+  auto st = parquet::arrow::FileReader::Make(
+      arrow::default_memory_pool(), std::move(parquet_reader), prop, &arrow_reader);
+  if (!st.ok()) {
+    throw std::runtime_error(st.ToString());
+  }
+  return arrow_reader;
+}
+
+std::shared_ptr<arrow::ChunkedArray> ArrowStorage::readParquetColumn(
+    const std::string& file_name,
+    int row_group,
+    int col_idx,
+    const hdk::ir::Type* col_type) const {
+  auto arrow_reader = openParquetFile(file_name);
+  std::shared_ptr<arrow::Table> at;
+  auto st = arrow_reader->ReadRowGroup(row_group, {col_idx}, &at);
+  if (!st.ok()) {
+    throw std::runtime_error(st.ToString());
+  }
+  CHECK_EQ(at->num_columns(), 1);
+  mapd_shared_lock<mapd_shared_mutex> dict_lock(dict_mutex_);
+  return convertArrowColumn(at->column(0), col_type);
+}
+
+std::shared_ptr<ChunkMetadata> ArrowStorage::getParquetChunkMetadata(
+    const parquet::ColumnChunkMetaData& col_meta,
+    const arrow::DataType& arrow_type,
+    const hdk::ir::Type* col_type,
+    size_t row_count) const {
+  if (!col_meta.is_stats_set()) {
+    return nullptr;
+  }
+  auto stats = col_meta.statistics();
+  if (!stats || !stats->HasMinMax() || !stats->HasNullCount()) {
+    return nullptr;
+  }
+  bool has_nulls = stats->null_count() > 0;
+
+  ChunkStats chunk_stats;
+  // Only integer and floating point columns are supported. Stored values of other
+  // types don't match the internal representation.
+  switch (arrow_type.id()) {
+    case arrow::Type::INT8:
+    case arrow::Type::INT16:
+    case arrow::Type::INT32: {
+      if (stats->physical_type() != parquet::Type::INT32 || !col_type->isInteger()) {
+        return nullptr;
+      }
+      auto typed_stats = static_cast<parquet::Int32Statistics*>(stats.get());
+      fillChunkStats(
+          chunk_stats, col_type, typed_stats->min(), typed_stats->max(), has_nulls);
+      break;
+    }
+    case arrow::Type::INT64: {
+      if (stats->physical_type() != parquet::Type::INT64 || !col_type->isInteger()) {
+        return nullptr;
+      }
+      auto typed_stats = static_cast<parquet::Int64Statistics*>(stats.get());
+      fillChunkStats(
+          chunk_stats, col_type, typed_stats->min(), typed_stats->max(), has_nulls);
+      break;
+    }
+    case arrow::Type::FLOAT: {
+      if (stats->physical_type() != parquet::Type::FLOAT) {
+        return nullptr;
+      }
+      auto typed_stats = static_cast<parquet::FloatStatistics*>(stats.get());
+      fillChunkStats(
+          chunk_stats, col_type, typed_stats->min(), typed_stats->max(), has_nulls);
+      break;
+    }
+    case arrow::Type::DOUBLE: {
+      if (stats->physical_type() != parquet::Type::DOUBLE) {
+        return nullptr;
+      }
+      auto typed_stats = static_cast<parquet::DoubleStatistics*>(stats.get());
+      fillChunkStats(
+          chunk_stats, col_type, typed_stats->min(), typed_stats->max(), has_nulls);
+      break;
+    }
+    default:
+      return nullptr;
+  }
+
+  return std::make_shared<ChunkMetadata>(
+      col_type, row_count * col_type->size(), row_count, chunk_stats);
+}
+
 std::shared_ptr<arrow::Table> ArrowStorage::parseParquetFile(
     const std::string& file_name) {
   auto file_result = arrow::io::ReadableFile::Open(file_name.c_str());
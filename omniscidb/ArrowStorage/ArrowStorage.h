@@ -15,16 +15,28 @@
 #pragma once
 
 #include "DataMgr/AbstractDataProvider.h"
+#include "DataMgr/ColumnStats.h"
 #include "DataProvider/DictDescriptor.h"
 #include "SchemaMgr/SimpleSchemaProvider.h"
 #include "Shared/mapd_shared_mutex.h"
 
 #include <arrow/api.h>
 
+#include <mutex>
+
 namespace hdk::ir {
 class Type;
 }
 
+namespace parquet {
+class ColumnChunkMetaData;
+namespace arrow {
+class FileReader;
+}
+}  // namespace parquet
+
+// Tables can be imported, appended, dropped and fetched concurrently from multiple
+// threads. Schema and data changes are guarded by internal locks.
 class ArrowStorage : public SimpleSchemaProvider, public AbstractDataProvider {
  public:
   struct ColumnDescription {
@@ -37,6 +49,23 @@ class ArrowStorage : public SimpleSchemaProvider, public AbstractDataProvider {
     TableOptions(size_t fragment_size_) : fragment_size(fragment_size_){};
 
     size_t fragment_size = 32'000'000;
+    // Build fragments from chunks of imported Arrow data instead of using fixed size
+    // fragments. It allows zero-copy fetch for fixed length columns. Chunks bigger than
+    // fragment_size are split and consecutive chunks smaller than min_fragment_size are
+    // merged.
+    bool align_fragments_to_chunks = false;
+    size_t min_fragment_size = 1'000'000;
+    // Never merge appended rows into existing fragments. Published fragments are
+    // immutable then, so each query works with a consistent snapshot of the table
+    // taken by getTableMetadata while appends run concurrently.
+    bool streaming_append = false;
+    // Columns to cluster rows by. Each appended batch is sorted by these columns
+    // before it is split into fragments, so fragments get tight min/max ranges for
+    // them and filters on the keys skip most fragments.
+    std::vector<std::string> cluster_keys;
+    // Table receives batches processed by continuous queries. Appends never touch
+    // existing fragments of stream tables.
+    bool is_stream = false;
   };
 
   struct CsvParseOptions {
@@ -46,6 +75,13 @@ class ArrowStorage : public SimpleSchemaProvider, public AbstractDataProvider {
     bool header = true;
     size_t skip_rows = 0;
     size_t block_size = 20 << 20;  // Default block size is 20MB
+    // Read and import file by blocks instead of parsing the whole file first. It
+    // reduces peak memory consumption. Column types missing in the schema are
+    // inferred from the first block.
+    bool streaming = false;
+    // strptime formats of timestamp columns, tried in order after ISO-8601 when
+    // a value is not an ISO-8601 timestamp.
+    std::vector<std::string> timestamp_formats;
   };
 
   struct JsonParseOptions {
@@ -72,6 +108,16 @@ class ArrowStorage : public SimpleSchemaProvider, public AbstractDataProvider {
 
   const DictDescriptor* getDictMetadata(int dict_id, bool load_dict = true) override;
 
+  // Add a dictionary loaded from a file written by exportDictionary and return its id.
+  // The dictionary is memory-mapped, so storages and processes importing the same
+  // file share its strings. It can be used in column types to import data encoded
+  // with the same string ids. Front-coded files are smaller but are decoded into
+  // private memory of the importing storage.
+  int importDictionary(const std::string& file_name, const std::string& name);
+  void exportDictionary(int dict_id,
+                        const std::string& file_name,
+                        bool front_coded = false);
+
   TableInfoPtr createTable(const std::string& table_name,
                            const std::vector<ColumnDescription>& columns,
                            const TableOptions& options = TableOptions());
@@ -87,6 +133,13 @@ class ArrowStorage : public SimpleSchemaProvider, public AbstractDataProvider {
   void appendArrowTable(std::shared_ptr<arrow::Table> at, const std::string& table_name);
   void appendArrowTable(std::shared_ptr<arrow::Table> at, int table_id);
 
+  // Append batches while they are read. Fragments are created and their stats are
+  // computed as soon as enough rows are read to fill them.
+  void appendRecordBatches(std::shared_ptr<arrow::RecordBatchReader> reader,
+                           const std::string& table_name);
+  void appendRecordBatches(std::shared_ptr<arrow::RecordBatchReader> reader,
+                           int table_id);
+
   TableInfoPtr importCsvFile(const std::string& file_name,
                              const std::string& table_name,
                              const std::vector<ColumnDescription>& columns,
@@ -118,6 +171,26 @@ class ArrowStorage : public SimpleSchemaProvider, public AbstractDataProvider {
                       int table_id,
                       const JsonParseOptions parse_options = JsonParseOptions());
 
+  // JSON files are newline-delimited and imported by blocks, so the whole file is
+  // never materialized. Column types missing in the schema are inferred from the
+  // first block.
+  TableInfoPtr importJsonFile(const std::string& file_name,
+                              const std::string& table_name,
+                              const std::vector<ColumnDescription>& columns,
+                              const TableOptions& options = TableOptions(),
+                              const JsonParseOptions parse_options = JsonParseOptions());
+  TableInfoPtr importJsonFile(const std::string& file_name,
+                              const std::string& table_name,
+                              const TableOptions& options = TableOptions(),
+                              const JsonParseOptions parse_options = JsonParseOptions());
+
+  void appendJsonFile(const std::string& file_name,
+                      const std::string& table_name,
+                      const JsonParseOptions parse_options = JsonParseOptions());
+  void appendJsonFile(const std::string& file_name,
+                      int table_id,
+                      const JsonParseOptions parse_options = JsonParseOptions());
+
   TableInfoPtr importParquetFile(const std::string& file_name,
                                  const std::string& table_name,
                                  const TableOptions& options = TableOptions());
@@ -125,6 +198,45 @@ class ArrowStorage : public SimpleSchemaProvider, public AbstractDataProvider {
   void appendParquetFile(const std::string& file_name, const std::string& table_name);
   void appendParquetFile(const std::string& file_name, int table_id);
 
+  // Import Arrow IPC file (Feather V2). The file is memory-mapped and columns which
+  // don't require conversion keep referencing mapped memory, so import doesn't copy
+  // data and the page cache is shared by all processes using the same file. Set
+  // TableOptions::align_fragments_to_chunks to get all fragments of such columns
+  // accessible through getZeroCopyBufferMemory.
+  TableInfoPtr importArrowIpcFile(const std::string& file_name,
+                                  const std::string& table_name,
+                                  const TableOptions& options = TableOptions());
+
+  void appendArrowIpcFile(const std::string& file_name, const std::string& table_name);
+  void appendArrowIpcFile(const std::string& file_name, int table_id);
+
+  // Tables shared by processes. A loader process publishes data as generations of
+  // Arrow IPC files in a segment directory, which is usually placed on a shared
+  // memory file system like /dev/shm. Other processes attach to the segment and map
+  // its files read-only, so column data imported with align_fragments_to_chunks is
+  // served from the shared pages without copies. Each generation holds rows
+  // appended by one publication and becomes visible atomically.
+  //
+  // Return the number of the published generation.
+  static size_t publishSharedGeneration(const std::string& segment_dir,
+                                        std::shared_ptr<arrow::Table> at);
+  // Create a table from all generations published in the segment so far.
+  TableInfoPtr attachSharedTable(const std::string& segment_dir,
+                                 const std::string& table_name,
+                                 const TableOptions& options = TableOptions());
+  // Append generations published since the last attach or refresh. Return the number
+  // of appended generations.
+  size_t refreshSharedTable(const std::string& table_name);
+
+  // Create a table backed by a Parquet file. Fragments of the table are row groups
+  // of the file and data is read on demand for requested columns and row groups only.
+  // Row group statistics from the file are used as fragment metadata when possible,
+  // so fragments can be skipped without reading data. Columns with no usable
+  // statistics are read once on registration to compute metadata. Such tables don't
+  // support appends.
+  TableInfoPtr registerParquetFile(const std::string& file_name,
+                                   const std::string& table_name);
+
   void dropTable(const std::string& table_name, bool throw_if_not_exist = false);
   void dropTable(int table_id, bool throw_if_not_exist = false);
 
@@ -139,11 +251,30 @@ class ArrowStorage : public SimpleSchemaProvider, public AbstractDataProvider {
 
   struct TableData {
     mapd_shared_mutex mutex;
+    std::mutex append_mutex;
     size_t fragment_size = 32'000'000;
+    bool streaming_append = false;
+    bool align_fragments_to_chunks = false;
+    size_t min_fragment_size = 1'000'000;
+    std::vector<std::string> cluster_keys;
     std::shared_ptr<arrow::Schema> schema;
     std::vector<std::shared_ptr<arrow::ChunkedArray>> col_data;
+    // Statistics of the whole columns, nullptr for columns with no statistics support.
+    std::vector<std::shared_ptr<const ColumnStats>> col_stats;
     std::vector<DataFragment> fragments;
     size_t row_count = 0;
+    // Non-empty for Parquet-backed tables. col_data is empty for such tables.
+    std::string parquet_file;
+    // Non-empty for tables attached to a shared segment.
+    std::string shared_segment;
+    size_t shared_generations = 0;
+    // Incremented on every change of fragments or statistics.
+    uint64_t generation = 0;
+    // Metadata snapshot built for metadata_generation. Snapshots are immutable and
+    // shared by getTableMetadata calls until the table changes.
+    std::shared_ptr<const TableFragmentsInfo> metadata;
+    uint64_t metadata_generation = 0;
+    std::mutex metadata_mutex;
   };
 
   class ArrowChunkDataToken : public Data_Namespace::AbstractDataToken {
@@ -170,6 +301,16 @@ class ArrowStorage : public SimpleSchemaProvider, public AbstractDataProvider {
                            const TableOptions& options) const;
   void compareSchemas(std::shared_ptr<arrow::Schema> lhs,
                       std::shared_ptr<arrow::Schema> rhs);
+  // Convert imported column data to the internal format. Requires dict_mutex_ to be
+  // locked by the caller.
+  std::shared_ptr<arrow::ChunkedArray> convertArrowColumn(
+      std::shared_ptr<arrow::ChunkedArray> col_arr,
+      const hdk::ir::Type* col_type) const;
+  std::shared_ptr<ChunkMetadata> computeChunkMetadata(
+      std::shared_ptr<arrow::ChunkedArray> col_arr,
+      const hdk::ir::Type* col_type,
+      size_t offset,
+      size_t row_count);
   ChunkStats computeStats(std::shared_ptr<arrow::ChunkedArray> arr,
                           const hdk::ir::Type* type);
   std::shared_ptr<arrow::Table> parseCsvFile(const std::string& file_name,
@@ -181,33 +322,57 @@ class ArrowStorage : public SimpleSchemaProvider, public AbstractDataProvider {
   std::shared_ptr<arrow::Table> parseCsv(std::shared_ptr<arrow::io::InputStream> input,
                                          const CsvParseOptions parse_options,
                                          const ColumnInfoList& col_infos = {});
+  std::shared_ptr<arrow::RecordBatchReader> openCsvFileStream(
+      const std::string& file_name,
+      const CsvParseOptions parse_options,
+      const ColumnInfoList& col_infos = {});
   std::shared_ptr<arrow::Table> parseJsonData(const std::string& json_data,
                                               const JsonParseOptions parse_options,
                                               const ColumnInfoList& col_infos = {});
   std::shared_ptr<arrow::Table> parseJson(std::shared_ptr<arrow::io::InputStream> input,
                                           const JsonParseOptions parse_options,
                                           const ColumnInfoList& col_infos = {});
+  std::shared_ptr<arrow::RecordBatchReader> openJsonFileStream(
+      const std::string& file_name,
+      const JsonParseOptions parse_options,
+      const ColumnInfoList& col_infos = {});
   std::shared_ptr<arrow::Table> parseParquetFile(const std::string& file_name);
+  std::shared_ptr<arrow::Table> readArrowIpcFile(const std::string& file_name);
+  std::unique_ptr<parquet::arrow::FileReader> openParquetFile(
+      const std::string& file_name) const;
+  std::shared_ptr<arrow::ChunkedArray> readParquetColumn(
+      const std::string& file_name,
+      int row_group,
+      int col_idx,
+      const hdk::ir::Type* col_type) const;
+  std::shared_ptr<ChunkMetadata> getParquetChunkMetadata(
+      const parquet::ColumnChunkMetaData& col_meta,
+      const arrow::DataType& arrow_type,
+      const hdk::ir::Type* col_type,
+      size_t row_count) const;
+  size_t refreshSharedTableNoLock(int table_id);
   TableFragmentsInfo getEmptyTableMetadata(int table_id) const;
-  void fetchFixedLenData(const TableData& table,
-                         size_t frag_idx,
-                         size_t col_idx,
+  // Requires a lock on the table mutex.
+  TableFragmentsInfo buildTableMetadata(int table_id, const TableData& table) const;
+  void fetchFixedLenData(std::shared_ptr<arrow::ChunkedArray> col_arr,
+                         size_t frag_offset,
+                         size_t frag_rows,
                          Data_Namespace::AbstractBuffer* dest,
                          size_t num_bytes,
                          size_t elem_size) const;
-  void fetchVarLenOffsets(const TableData& table,
-                          size_t frag_idx,
-                          size_t col_idx,
+  void fetchVarLenOffsets(std::shared_ptr<arrow::ChunkedArray> col_arr,
+                          size_t frag_offset,
+                          size_t frag_rows,
                           Data_Namespace::AbstractBuffer* dest,
                           size_t num_bytes) const;
-  void fetchVarLenData(const TableData& table,
-                       size_t frag_idx,
-                       size_t col_idx,
+  void fetchVarLenData(std::shared_ptr<arrow::ChunkedArray> col_arr,
+                       size_t frag_offset,
+                       size_t frag_rows,
                        Data_Namespace::AbstractBuffer* dest,
                        size_t num_bytes) const;
-  void fetchVarLenArrayData(const TableData& table,
-                            size_t frag_idx,
-                            size_t col_idx,
+  void fetchVarLenArrayData(std::shared_ptr<arrow::ChunkedArray> col_arr,
+                            size_t frag_offset,
+                            size_t frag_rows,
                             Data_Namespace::AbstractBuffer* dest,
                             size_t elem_size,
                             size_t num_bytes) const;
@@ -220,4 +385,6 @@ class ArrowStorage : public SimpleSchemaProvider, public AbstractDataProvider {
   std::unordered_map<int, std::unique_ptr<DictDescriptor>> dicts_;
   mutable mapd_shared_mutex data_mutex_;
   mutable mapd_shared_mutex dict_mutex_;
+  // Serializes refreshes of shared tables, so that a generation is appended once.
+  std::mutex shared_refresh_mutex_;
 };
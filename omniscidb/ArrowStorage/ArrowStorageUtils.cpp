@@ -1164,6 +1164,58 @@ std::shared_ptr<arrow::ChunkedArray> createDictionaryEncodedColumn(
   }
 }
 
+template <typename IndexArrowType>
+void remapDictionaryIndices(int32_t* dst,
+                            const arrow::Array& indices,
+                            const std::vector<int>& mapping) {
+  using ArrayType = typename arrow::TypeTraits<IndexArrowType>::ArrayType;
+  const auto& typed_indices = static_cast<const ArrayType&>(indices);
+  if (typed_indices.null_count() == 0) {
+    for (int64_t i = 0; i < typed_indices.length(); ++i) {
+      dst[i] = mapping[typed_indices.Value(i)];
+    }
+  } else {
+    auto null_value = inline_null_value<int32_t>();
+    for (int64_t i = 0; i < typed_indices.length(); ++i) {
+      dst[i] = typed_indices.IsNull(i) ? null_value : mapping[typed_indices.Value(i)];
+    }
+  }
+}
+
+void remapDictionaryIndices(int32_t* dst,
+                            const arrow::Array& indices,
+                            const std::vector<int>& mapping) {
+  switch (indices.type_id()) {
+    case arrow::Type::INT8:
+      remapDictionaryIndices<arrow::Int8Type>(dst, indices, mapping);
+      break;
+    case arrow::Type::INT16:
+      remapDictionaryIndices<arrow::Int16Type>(dst, indices, mapping);
+      break;
+    case arrow::Type::INT32:
+      remapDictionaryIndices<arrow::Int32Type>(dst, indices, mapping);
+      break;
+    case arrow::Type::INT64:
+      remapDictionaryIndices<arrow::Int64Type>(dst, indices, mapping);
+      break;
+    case arrow::Type::UINT8:
+      remapDictionaryIndices<arrow::UInt8Type>(dst, indices, mapping);
+      break;
+    case arrow::Type::UINT16:
+      remapDictionaryIndices<arrow::UInt16Type>(dst, indices, mapping);
+      break;
+    case arrow::Type::UINT32:
+      remapDictionaryIndices<arrow::UInt32Type>(dst, indices, mapping);
+      break;
+    case arrow::Type::UINT64:
+      remapDictionaryIndices<arrow::UInt64Type>(dst, indices, mapping);
+      break;
+    default:
+      throw std::runtime_error("Unsupported Arrow dictionary index type: "s +
+                               indices.type()->ToString());
+  }
+}
+
 }  // anonymous namespace
 
 std::shared_ptr<arrow::ChunkedArray> createDictionaryEncodedColumn(
@@ -1193,35 +1245,56 @@ std::shared_ptr<arrow::ChunkedArray> convertArrowDictionary(
     throw std::runtime_error("Unsupported HDK dictionary for Arrow dictionary import: "s +
                              type->toString());
   }
-  // TODO: allocate one big array and split it by fragments as it is done in
-  // createDictionaryEncodedColumn
-  std::vector<std::shared_ptr<arrow::Array>> converted_chunks;
-  for (auto& chunk : arr->chunks()) {
-    auto dict_array = std::static_pointer_cast<arrow::DictionaryArray>(chunk);
-    auto values = std::static_pointer_cast<arrow::StringArray>(dict_array->dictionary());
+
+  // Chunks usually share the same dictionary (e.g. batches of an IPC stream or a
+  // Parquet column) so only unique dictionaries are added to the string dictionary.
+  // All chunks then just remap their indices through a translation table.
+  std::vector<std::shared_ptr<arrow::Array>> unique_dicts;
+  std::vector<size_t> chunk_dict(arr->num_chunks());
+  std::vector<size_t> offsets(arr->num_chunks());
+  size_t bulk_size = 0;
+  for (int i = 0; i < arr->num_chunks(); ++i) {
+    auto dict_array = std::static_pointer_cast<arrow::DictionaryArray>(arr->chunk(i));
+    auto& values = dict_array->dictionary();
+    if (unique_dicts.empty() || (values != unique_dicts.back() &&
+                                 !values->Equals(*unique_dicts.back()))) {
+      unique_dicts.push_back(values);
+    }
+    chunk_dict[i] = unique_dicts.size() - 1;
+    offsets[i] = bulk_size;
+    bulk_size += dict_array->length();
+  }
+
+  std::vector<std::vector<int>> mappings(unique_dicts.size());
+  for (size_t dict_idx = 0; dict_idx < unique_dicts.size(); ++dict_idx) {
+    auto values = std::static_pointer_cast<arrow::StringArray>(unique_dicts[dict_idx]);
     std::vector<std::string_view> strings(values->length());
     for (int i = 0; i < values->length(); i++) {
       auto view = values->GetView(i);
       strings[i] = std::string_view(view.data(), view.length());
     }
-    auto arrow_indices =
-        std::static_pointer_cast<arrow::Int32Array>(dict_array->indices());
-    std::vector<int> indices_mapping(values->length());
-    dict->getOrAddBulk(strings, indices_mapping.data());
-
-    // create new arrow chunk with remapped indices
-    std::shared_ptr<arrow::Buffer> dict_indices_buf;
-    auto res = arrow::AllocateBuffer(arrow_indices->length() * sizeof(int32_t));
-    CHECK(res.ok());
-    dict_indices_buf = std::move(res).ValueOrDie();
-    auto raw_data = reinterpret_cast<int32_t*>(dict_indices_buf->mutable_data());
-
-    for (int i = 0; i < arrow_indices->length(); i++) {
-      raw_data[i] = indices_mapping[arrow_indices->Value(i)];
-    }
-
-    converted_chunks.push_back(
-        std::make_shared<arrow::Int32Array>(arrow_indices->length(), dict_indices_buf));
+    mappings[dict_idx].resize(values->length());
+    dict->getOrAddBulk(strings, mappings[dict_idx].data());
   }
-  return std::make_shared<arrow::ChunkedArray>(converted_chunks);
+
+  std::shared_ptr<arrow::Buffer> indices_buf;
+  auto res = arrow::AllocateBuffer(bulk_size * sizeof(int32_t));
+  CHECK(res.ok());
+  indices_buf = std::move(res).ValueOrDie();
+  auto raw_data = reinterpret_cast<int32_t*>(indices_buf->mutable_data());
+
+  tbb::parallel_for(tbb::blocked_range<int>(0, arr->num_chunks()),
+                    [&](const tbb::blocked_range<int>& r) {
+                      for (int i = r.begin(); i < r.end(); i++) {
+                        auto dict_array =
+                            std::static_pointer_cast<arrow::DictionaryArray>(
+                                arr->chunk(i));
+                        remapDictionaryIndices(raw_data + offsets[i],
+                                               *dict_array->indices(),
+                                               mappings[chunk_dict[i]]);
+                      }
+                    });
+
+  auto array = std::make_shared<arrow::Int32Array>(bulk_size, indices_buf);
+  return std::make_shared<arrow::ChunkedArray>(array);
 }
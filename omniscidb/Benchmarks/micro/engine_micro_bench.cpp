@@ -0,0 +1,297 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    engine_micro_bench.cpp
+ * @brief   Benchmarks of individual engine hot paths on synthetic data.
+ *
+ * Data is generated with fixed seeds, so runs on the same build and machine are
+ * comparable. Paths which have no standalone entry point (hash joins, reductions)
+ * are measured with small queries which spend most of their time in that path.
+ **/
+
+#include <benchmark/benchmark.h>
+
+#include "QueryEngine/ArrowResultSet.h"
+#include "ResultSetRegistry/ColumnarResults.h"
+#include "Shared/ArrowUtil.h"
+#include "Shared/scope.h"
+#include "Tests/ArrowSQLRunner/ArrowSQLRunner.h"
+
+#include <arrow/api.h>
+#include <boost/program_options.hpp>
+
+#include <random>
+
+size_t g_fact_rows = 1 << 22;
+size_t g_dim_rows = 1 << 16;
+size_t g_fragment_size = 1 << 18;
+
+using namespace TestHelpers::ArrowSQLRunner;
+
+namespace {
+
+template <typename BuilderType, typename Generator>
+std::shared_ptr<arrow::Array> generateColumn(size_t rows, Generator gen) {
+  BuilderType builder;
+  ARROW_THROW_NOT_OK(builder.Reserve(rows));
+  for (size_t i = 0; i < rows; ++i) {
+    builder.UnsafeAppend(gen(i));
+  }
+  std::shared_ptr<arrow::Array> res;
+  ARROW_THROW_NOT_OK(builder.Finish(&res));
+  return res;
+}
+
+// Fact table with join keys uniformly distributed over dimension keys, a key with a
+// small range for perfect hash group-by and a key with a wide range for baseline
+// hash group-by.
+void createFactTable(const std::string& name, size_t rows, uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  std::uniform_int_distribution<int32_t> fk_dist(0, g_dim_rows - 1);
+  std::uniform_int_distribution<int32_t> small_dist(0, 99);
+  std::uniform_int_distribution<int64_t> wide_dist(0, int64_t(1) << 40);
+  std::uniform_real_distribution<double> x_dist(0.0, 1.0);
+  auto schema = arrow::schema({arrow::field("id", arrow::int64()),
+                               arrow::field("fk", arrow::int32()),
+                               arrow::field("k_small", arrow::int32()),
+                               arrow::field("k_wide", arrow::int64()),
+                               arrow::field("x", arrow::float64())});
+  auto table = arrow::Table::Make(
+      schema,
+      {generateColumn<arrow::Int64Builder>(rows, [](size_t i) { return int64_t(i); }),
+       generateColumn<arrow::Int32Builder>(rows, [&](size_t) { return fk_dist(rng); }),
+       generateColumn<arrow::Int32Builder>(rows,
+                                           [&](size_t) { return small_dist(rng); }),
+       generateColumn<arrow::Int64Builder>(rows, [&](size_t) { return wide_dist(rng); }),
+       generateColumn<arrow::DoubleBuilder>(rows, [&](size_t) { return x_dist(rng); })});
+  getStorage()->dropTable(name);
+  getStorage()->importArrowTable(
+      table, name, ArrowStorage::TableOptions{g_fragment_size});
+}
+
+// Dimension table with keys_per_value rows for each key value.
+void createDimTable(const std::string& name,
+                    size_t rows,
+                    size_t keys_per_value,
+                    uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  std::uniform_int_distribution<int32_t> small_dist(0, 99);
+  std::uniform_real_distribution<double> v_dist(0.0, 1.0);
+  auto schema = arrow::schema({arrow::field("id", arrow::int32()),
+                               arrow::field("k_small", arrow::int32()),
+                               arrow::field("v", arrow::float64())});
+  auto table = arrow::Table::Make(
+      schema,
+      {generateColumn<arrow::Int32Builder>(
+           rows, [&](size_t i) { return int32_t(i / keys_per_value); }),
+       generateColumn<arrow::Int32Builder>(rows,
+                                           [&](size_t) { return small_dist(rng); }),
+       generateColumn<arrow::DoubleBuilder>(rows, [&](size_t) { return v_dist(rng); })});
+  getStorage()->dropTable(name);
+  getStorage()->importArrowTable(table, name);
+}
+
+void createTables() {
+  createFactTable("fact", g_fact_rows, 1);
+  createDimTable("dim_unique", g_dim_rows, 1, 2);
+  createDimTable("dim_dup", g_dim_rows * 4, 4, 3);
+  createFactTable("tiny", 1'000, 4);
+  createDimTable("tiny_dim", 100, 1, 5);
+}
+
+}  // namespace
+
+// Hash join per hash table type. Build runs with the hash table cache disabled, so
+// each iteration builds and probes the table. Probe runs with the cache enabled, so
+// iterations after the first one only probe.
+static void hash_join(benchmark::State& state, const std::string& query, bool build) {
+  auto use_hashtable_cache = config().cache.use_hashtable_cache;
+  ScopeGuard restore_cache = [use_hashtable_cache] {
+    config().cache.use_hashtable_cache = use_hashtable_cache;
+  };
+  config().cache.use_hashtable_cache = !build;
+  run_multiple_agg(query, ExecutorDeviceType::CPU);
+  for (auto _ : state) {
+    run_multiple_agg(query, ExecutorDeviceType::CPU);
+  }
+}
+
+const std::string kOneToOneJoin =
+    "SELECT COUNT(*), SUM(d.v) FROM fact f JOIN dim_unique d ON f.fk = d.id;";
+const std::string kOneToManyJoin =
+    "SELECT COUNT(*), SUM(d.v) FROM fact f JOIN dim_dup d ON f.fk = d.id;";
+const std::string kCompositeKeyJoin =
+    "SELECT COUNT(*), SUM(d.v) FROM fact f JOIN dim_dup d ON f.fk = d.id AND "
+    "f.k_small = d.k_small;";
+
+BENCHMARK_CAPTURE(hash_join, one_to_one_build, kOneToOneJoin, true);
+BENCHMARK_CAPTURE(hash_join, one_to_one_probe, kOneToOneJoin, false);
+BENCHMARK_CAPTURE(hash_join, one_to_many_build, kOneToManyJoin, true);
+BENCHMARK_CAPTURE(hash_join, one_to_many_probe, kOneToManyJoin, false);
+BENCHMARK_CAPTURE(hash_join, baseline_build, kCompositeKeyJoin, true);
+BENCHMARK_CAPTURE(hash_join, baseline_probe, kCompositeKeyJoin, false);
+
+// Aggregations of a table with many fragments, so results of many kernels are
+// reduced. Each query picks a different reduction strategy.
+static void reduction(benchmark::State& state, const std::string& query) {
+  for (auto _ : state) {
+    run_multiple_agg(query, ExecutorDeviceType::CPU);
+  }
+}
+
+BENCHMARK_CAPTURE(reduction,
+                  non_grouped,
+                  std::string("SELECT COUNT(*), SUM(x), MIN(k_wide) FROM fact;"));
+BENCHMARK_CAPTURE(
+    reduction,
+    perfect_hash,
+    std::string("SELECT k_small, COUNT(*), SUM(x) FROM fact GROUP BY k_small;"));
+BENCHMARK_CAPTURE(
+    reduction,
+    baseline_hash,
+    std::string("SELECT k_small, fk, COUNT(*), SUM(x) FROM fact GROUP BY k_small, fk;"));
+
+// Conversion of a row-wise group-by result into columns fetched by the next query
+// step.
+static void columnar_results(benchmark::State& state) {
+  auto rows = run_multiple_agg("SELECT fk, COUNT(*), SUM(x) FROM fact GROUP BY fk;",
+                               ExecutorDeviceType::CPU);
+  std::vector<const hdk::ir::Type*> col_types;
+  for (size_t i = 0; i < rows->colCount(); ++i) {
+    col_types.push_back(rows->colType(i));
+  }
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto row_set_mem_owner =
+        std::make_shared<RowSetMemoryOwner>(nullptr, Executor::getArenaBlockSize());
+    state.ResumeTiming();
+    ColumnarResults columnar(
+        row_set_mem_owner, *rows, col_types.size(), col_types, 0, config());
+    benchmark::DoNotOptimize(columnar.getColumnBuffers());
+  }
+  state.SetItemsProcessed(state.iterations() * rows->rowCount());
+}
+
+BENCHMARK(columnar_results);
+
+static void arrow_conversion(benchmark::State& state, const std::string& query) {
+  auto rows = run_multiple_agg(query, ExecutorDeviceType::CPU);
+  std::vector<std::string> col_names;
+  for (size_t i = 0; i < rows->colCount(); ++i) {
+    col_names.push_back("col" + std::to_string(i));
+  }
+  for (auto _ : state) {
+    ArrowResultSetConverter converter(rows, col_names, -1);
+    benchmark::DoNotOptimize(converter.convertToArrowTable());
+  }
+  state.SetItemsProcessed(state.iterations() * rows->rowCount());
+}
+
+BENCHMARK_CAPTURE(arrow_conversion,
+                  projection,
+                  std::string("SELECT id, fk, x FROM fact WHERE k_small < 50;"));
+BENCHMARK_CAPTURE(arrow_conversion,
+                  group_by,
+                  std::string("SELECT fk, COUNT(*), SUM(x) FROM fact GROUP BY fk;"));
+
+// Allocation and release of a CPU buffer pool buffer.
+static void buffer_alloc_free(benchmark::State& state) {
+  const size_t num_bytes = state.range(0);
+  for (auto _ : state) {
+    auto buffer = getDataMgr()->alloc(Data_Namespace::CPU_LEVEL, 0, num_bytes);
+    getDataMgr()->free(buffer);
+  }
+}
+
+BENCHMARK(buffer_alloc_free)->RangeMultiplier(16)->Range(4 << 10, 64 << 20);
+
+// Scan of a table evicted from the buffer pool before each iteration.
+static void cold_fetch(benchmark::State& state) {
+  for (auto _ : state) {
+    state.PauseTiming();
+    clearCpuMemory();
+    state.ResumeTiming();
+    run_multiple_agg("SELECT SUM(x), MAX(k_wide) FROM fact;", ExecutorDeviceType::CPU);
+  }
+}
+
+BENCHMARK(cold_fetch);
+
+// Code generation and compilation of a query shape. The code cache is reset before
+// each iteration and the input table is tiny, so compilation dominates.
+static void compilation(benchmark::State& state, const std::string& query) {
+  for (auto _ : state) {
+    state.PauseTiming();
+    Executor::resetCodeCache();
+    state.ResumeTiming();
+    run_multiple_agg(query, ExecutorDeviceType::CPU);
+  }
+}
+
+BENCHMARK_CAPTURE(compilation,
+                  projection,
+                  std::string("SELECT id + 1, x * 2.0 FROM tiny WHERE k_small > 10;"));
+BENCHMARK_CAPTURE(
+    compilation,
+    group_by,
+    std::string("SELECT k_small, COUNT(*), SUM(x), AVG(k_wide) FROM tiny GROUP BY "
+                "k_small;"));
+BENCHMARK_CAPTURE(compilation,
+                  join,
+                  std::string("SELECT COUNT(*), SUM(d.v) FROM tiny f JOIN tiny_dim d ON "
+                              "f.fk = d.id;"));
+
+int main(int argc, char* argv[]) {
+  ::benchmark::Initialize(&argc, argv);
+
+  namespace po = boost::program_options;
+
+  po::options_description desc("Options");
+  desc.add_options()("fact-rows",
+                     po::value<size_t>(&g_fact_rows)->default_value(g_fact_rows),
+                     "Number of rows in the fact table.");
+  desc.add_options()("dim-rows",
+                     po::value<size_t>(&g_dim_rows)->default_value(g_dim_rows),
+                     "Number of distinct join keys in dimension tables.");
+  desc.add_options()("fragment-size",
+                     po::value<size_t>(&g_fragment_size)->default_value(g_fragment_size),
+                     "Fragment size of the fact table.");
+
+  logger::LogOptions log_options(argv[0]);
+  log_options.severity_ = logger::Severity::FATAL;
+  log_options.set_options();  // update default values
+  desc.add(log_options.get_options());
+
+  po::variables_map vm;
+  po::store(po::command_line_parser(argc, argv).options(desc).run(), vm);
+  po::notify(vm);
+
+  if (vm.count("help")) {
+    std::cout << "Usage:" << std::endl << desc << std::endl;
+  }
+
+  logger::init(log_options);
+  init();
+
+  try {
+    createTables();
+    ::benchmark::RunSpecifiedBenchmarks();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+    return -1;
+  }
+
+  reset();
+}
@@ -0,0 +1,354 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    workload_replay.cpp
+ * @brief   Replay of a workload recorded with --workload-capture-file.
+ *
+ * Queries of each captured thread are issued from a separate thread in their
+ * original order and, unless --time-scale is zero, at their original start offsets,
+ * so the replay reproduces the concurrency of the captured run. Latency percentiles
+ * of every query and phase are reported next to the baseline, which is the captured
+ * run itself unless another capture or replay output is given with --baseline.
+ * Tables referenced by the queries are imported from CSV or Parquet files.
+ **/
+
+#include "ConfigBuilder/ConfigBuilder.h"
+#include "Logger/Logger.h"
+#include "QueryEngine/RelAlgExecutor.h"
+#include "Shared/measure.h"
+#include "Tests/ArrowSQLRunner/ArrowSQLRunner.h"
+#include "Tests/ArrowSQLRunner/WorkloadCapture.h"
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/program_options.hpp>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <thread>
+#include <unordered_map>
+
+using namespace TestHelpers::ArrowSQLRunner;
+
+namespace {
+
+struct Phase {
+  const char* name;
+  int64_t WorkloadQuery::*time;
+};
+
+const std::vector<Phase> kPhases = {
+    {"total", &WorkloadQuery::total_time},
+    {"parse", &WorkloadQuery::parse_time},
+    {"compilation", &WorkloadQuery::compilation_time},
+    {"hash_table_build", &WorkloadQuery::hash_table_build_time},
+    {"reduction", &WorkloadQuery::reduction_time},
+    {"fetch", &WorkloadQuery::fetch_time},
+    {"kernel", &WorkloadQuery::kernel_time},
+};
+
+void importTable(const std::string& spec, size_t fragment_size) {
+  auto pos = spec.find('=');
+  if (pos == std::string::npos || pos == 0 || pos + 1 == spec.size()) {
+    throw std::runtime_error("Table should be specified as <name>=<file>: " + spec);
+  }
+  auto table_name = spec.substr(0, pos);
+  auto file_name = spec.substr(pos + 1);
+
+  ArrowStorage::TableOptions options{fragment_size};
+  if (boost::algorithm::iends_with(file_name, ".parquet")) {
+    getStorage()->importParquetFile(file_name, table_name, options);
+  } else {
+    getStorage()->importCsvFile(file_name, table_name, options);
+  }
+}
+
+WorkloadQuery runQuery(const WorkloadQuery& captured,
+                       std::chrono::steady_clock::time_point replay_start,
+                       bool force_cpu) {
+  WorkloadQuery res;
+  res.sql = captured.sql;
+  res.device_type = captured.device_type;
+  res.thread_idx = captured.thread_idx;
+
+  auto device_type = ExecutorDeviceType::CPU;
+  if (captured.device_type == "GPU" && !force_cpu) {
+    device_type = ExecutorDeviceType::GPU;
+  } else {
+    res.device_type = "CPU";
+  }
+  auto co = getCompilationOptions(device_type);
+  auto eo = getExecutionOptions(true);
+  eo.with_profile = true;
+
+  auto start = std::chrono::steady_clock::now();
+  res.start_offset =
+      std::chrono::duration_cast<std::chrono::microseconds>(start - replay_start)
+          .count();
+  try {
+    std::unique_ptr<RelAlgExecutor> ra_executor;
+    res.parse_time = measure<std::chrono::microseconds>::execution(
+        [&]() { ra_executor = makeRelAlgExecutor(captured.sql); });
+    auto exec_res = ra_executor->executeRelAlgQuery(co, eo, false);
+    if (exec_res.getProfile()) {
+      addProfileTimes(res, *exec_res.getProfile());
+    }
+  } catch (const std::exception& e) {
+    LOG(ERROR) << "Query failed: " << captured.sql << std::endl << e.what();
+    res.succeeded = false;
+  }
+  res.total_time = std::chrono::duration_cast<std::chrono::microseconds>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+  return res;
+}
+
+// Each captured thread gets its own replay thread. Results are stored by the index
+// of the captured query, so threads never write the same element.
+std::vector<WorkloadQuery> replay(const std::vector<WorkloadQuery>& workload,
+                                  double time_scale,
+                                  bool force_cpu) {
+  std::map<size_t, std::vector<size_t>> thread_queries;
+  for (size_t i = 0; i < workload.size(); ++i) {
+    thread_queries[workload[i].thread_idx].push_back(i);
+  }
+  for (auto& [thread_idx, indices] : thread_queries) {
+    std::stable_sort(indices.begin(), indices.end(), [&](size_t lhs, size_t rhs) {
+      return workload[lhs].start_offset < workload[rhs].start_offset;
+    });
+  }
+
+  std::vector<WorkloadQuery> res(workload.size());
+  std::vector<std::thread> threads;
+  auto replay_start = std::chrono::steady_clock::now();
+  for (auto& [thread_idx, indices] : thread_queries) {
+    threads.emplace_back([&, indices = &indices]() {
+      for (auto idx : *indices) {
+        if (time_scale > 0) {
+          auto offset = std::chrono::microseconds(
+              static_cast<int64_t>(workload[idx].start_offset * time_scale));
+          std::this_thread::sleep_until(replay_start + offset);
+        }
+        res[idx] = runQuery(workload[idx], replay_start, force_cpu);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return res;
+}
+
+double percentile(std::vector<int64_t> vals, double p) {
+  if (vals.empty()) {
+    return 0.0;
+  }
+  std::sort(vals.begin(), vals.end());
+  auto pos = static_cast<size_t>(p * (vals.size() - 1) + 0.5);
+  return vals[pos] / 1000.0;
+}
+
+// Times of successful runs for every query text, in order of first appearance.
+using QueryTimes = std::vector<std::pair<std::string, std::vector<const WorkloadQuery*>>>;
+
+QueryTimes groupByQuery(const std::vector<WorkloadQuery>& runs) {
+  QueryTimes res;
+  std::unordered_map<std::string, size_t> ids;
+  for (auto& run : runs) {
+    auto it = ids.emplace(run.sql, res.size()).first;
+    if (it->second == res.size()) {
+      res.emplace_back(run.sql, std::vector<const WorkloadQuery*>());
+    }
+    if (run.succeeded) {
+      res[it->second].second.push_back(&run);
+    }
+  }
+  return res;
+}
+
+std::vector<int64_t> phaseTimes(const std::vector<const WorkloadQuery*>& runs,
+                                const Phase& phase) {
+  std::vector<int64_t> res;
+  res.reserve(runs.size());
+  for (auto run : runs) {
+    res.push_back(run->*phase.time);
+  }
+  return res;
+}
+
+void printPhases(const std::vector<const WorkloadQuery*>& runs,
+                 const std::vector<const WorkloadQuery*>* baseline_runs) {
+  for (auto& phase : kPhases) {
+    auto times = phaseTimes(runs, phase);
+    auto p50 = percentile(times, 0.5);
+    std::cout << "  " << std::left << std::setw(18) << phase.name << std::right
+              << std::fixed << std::setprecision(2) << " p50=" << std::setw(10) << p50
+              << " p90=" << std::setw(10) << percentile(times, 0.9)
+              << " p99=" << std::setw(10) << percentile(times, 0.99)
+              << " max=" << std::setw(10) << percentile(times, 1.0);
+    if (baseline_runs && !baseline_runs->empty()) {
+      auto base_p50 = percentile(phaseTimes(*baseline_runs, phase), 0.5);
+      std::cout << " base_p50=" << std::setw(10) << base_p50;
+      if (base_p50 > 0) {
+        std::cout << " ratio=" << std::setprecision(3) << (p50 / base_p50);
+      }
+    }
+    std::cout << std::endl;
+  }
+}
+
+void printReport(const std::vector<WorkloadQuery>& runs,
+                 const std::vector<WorkloadQuery>& baseline) {
+  auto queries = groupByQuery(runs);
+  auto baseline_queries = groupByQuery(baseline);
+  std::unordered_map<std::string, const std::vector<const WorkloadQuery*>*>
+      baseline_by_sql;
+  for (auto& [sql, query_runs] : baseline_queries) {
+    baseline_by_sql[sql] = &query_runs;
+  }
+
+  std::cout << "Latencies in ms, base_p50 is the median of the baseline." << std::endl;
+  std::vector<const WorkloadQuery*> all_runs;
+  std::vector<const WorkloadQuery*> all_baseline_runs;
+  for (size_t i = 0; i < queries.size(); ++i) {
+    auto& [sql, query_runs] = queries[i];
+    auto base_it = baseline_by_sql.find(sql);
+    auto base_runs = base_it == baseline_by_sql.end() ? nullptr : base_it->second;
+    std::cout << "Q" << i << " (" << query_runs.size() << " runs): " << sql
+              << std::endl;
+    printPhases(query_runs, base_runs);
+
+    all_runs.insert(all_runs.end(), query_runs.begin(), query_runs.end());
+    if (base_runs) {
+      all_baseline_runs.insert(
+          all_baseline_runs.end(), base_runs->begin(), base_runs->end());
+    }
+  }
+  std::cout << "All queries (" << all_runs.size() << " runs):" << std::endl;
+  printPhases(all_runs, &all_baseline_runs);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+
+  namespace po = boost::program_options;
+
+  std::string workload_file;
+  std::string baseline_file;
+  std::string output_file;
+  std::vector<std::string> tables;
+  std::string hdk_options;
+  size_t fragment_size = 32'000'000;
+  size_t iterations = 1;
+  double time_scale = 1.0;
+  bool force_cpu = false;
+
+  po::options_description desc("Options");
+  desc.add_options()("help,h", "Print help messages.");
+  desc.add_options()("workload",
+                     po::value<std::string>(&workload_file)->required(),
+                     "Workload file recorded with --workload-capture-file.");
+  desc.add_options()("baseline",
+                     po::value<std::string>(&baseline_file),
+                     "Workload or replay output file to compare with. The replayed "
+                     "workload is used by default.");
+  desc.add_options()("output",
+                     po::value<std::string>(&output_file),
+                     "File to store replayed queries in the workload format, so it "
+                     "can be used as a baseline of another replay.");
+  desc.add_options()("table",
+                     po::value<std::vector<std::string>>(&tables)->composing(),
+                     "Table to import before the replay as <name>=<file>. Files "
+                     "with .parquet extension are imported as Parquet, other files "
+                     "as CSV with a header.");
+  desc.add_options()("fragment-size",
+                     po::value<size_t>(&fragment_size)->default_value(fragment_size),
+                     "Fragment size of the imported tables.");
+  desc.add_options()("iterations",
+                     po::value<size_t>(&iterations)->default_value(iterations),
+                     "Number of replays of the whole workload.");
+  desc.add_options()("time-scale",
+                     po::value<double>(&time_scale)->default_value(time_scale),
+                     "Multiplier of the captured start offsets. Zero issues queries "
+                     "of each thread back to back.");
+  desc.add_options()("cpu-only",
+                     po::bool_switch(&force_cpu)->default_value(force_cpu),
+                     "Run queries captured on GPU on CPU.");
+  desc.add_options()("hdk-options",
+                     po::value<std::string>(&hdk_options),
+                     "HDK configuration options as a single string, e.g. "
+                     "\"--enable-lazy-fetch=false\".");
+
+  logger::LogOptions log_options(argv[0]);
+  log_options.severity_ = logger::Severity::ERROR;
+  log_options.set_options();  // update default values
+  desc.add(log_options.get_options());
+
+  po::variables_map vm;
+  po::store(po::command_line_parser(argc, argv).options(desc).run(), vm);
+
+  if (vm.count("help")) {
+    std::cout << "Usage:" << std::endl << desc << std::endl;
+    return 0;
+  }
+  po::notify(vm);
+
+  logger::init(log_options);
+
+  ConfigBuilder builder;
+  if (!hdk_options.empty() &&
+      !builder.parseCommandLineArgs(argv[0], hdk_options, false)) {
+    return -1;
+  }
+  auto config = builder.config();
+  // Replay results are collected here rather than captured again.
+  config->debug.workload_capture_file = "";
+  init(config);
+
+  try {
+    auto workload = loadWorkload(workload_file);
+    auto baseline = baseline_file.empty() ? workload : loadWorkload(baseline_file);
+    if (!force_cpu && !gpusPresent()) {
+      force_cpu = true;
+    }
+
+    for (auto& table : tables) {
+      importTable(table, fragment_size);
+    }
+
+    std::vector<WorkloadQuery> runs;
+    for (size_t i = 0; i < iterations; ++i) {
+      auto iter_runs = replay(workload, time_scale, force_cpu);
+      runs.insert(runs.end(), iter_runs.begin(), iter_runs.end());
+    }
+
+    printReport(runs, baseline);
+    if (!output_file.empty()) {
+      storeWorkload(output_file, runs);
+    }
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+    reset();
+    return -1;
+  }
+
+  reset();
+  return 0;
+}
@@ -0,0 +1,457 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TpchData.h"
+
+#include "Logger/Logger.h"
+#include "Shared/ArrowUtil.h"
+#include "Tests/ArrowSQLRunner/ArrowSQLRunner.h"
+
+#include <arrow/api.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+using namespace TestHelpers::ArrowSQLRunner;
+
+namespace tpch {
+
+namespace {
+
+// Days since epoch for a proleptic Gregorian date.
+int32_t daysFromCivil(int y, unsigned m, unsigned d) {
+  y -= m <= 2;
+  const int era = (y >= 0 ? y : y - 399) / 400;
+  const unsigned yoe = static_cast<unsigned>(y - era * 400);
+  const unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+  const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + static_cast<int>(doe) - 719468;
+}
+
+std::string dateToString(int32_t days) {
+  days += 719468;
+  const int era = (days >= 0 ? days : days - 146096) / 146097;
+  const unsigned doe = static_cast<unsigned>(days - era * 146097);
+  const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  const unsigned mp = (5 * doy + 2) / 153;
+  const unsigned d = doy - (153 * mp + 2) / 5 + 1;
+  const unsigned m = mp < 10 ? mp + 3 : mp - 9;
+  const int y = static_cast<int>(yoe) + era * 400 + (m <= 2);
+  char buf[16];
+  snprintf(buf, sizeof(buf), "%04d-%02u-%02u", y, m, d);
+  return buf;
+}
+
+// Decimal values are generated as whole cents, so the text sent to SQLite is exact.
+std::string centsToString(int64_t cents) {
+  char buf[32];
+  snprintf(buf, sizeof(buf), "%s%lld.%02lld", cents < 0 ? "-" : "",
+           static_cast<long long>(std::llabs(cents) / 100),
+           static_cast<long long>(std::llabs(cents) % 100));
+  return buf;
+}
+
+enum class ColType { kInt, kDecimal, kText, kDate };
+
+// Accumulates rows of a table in Arrow builders and, optionally, as text rows for
+// SQLite.
+class TableBuilder {
+ public:
+  TableBuilder(std::string name,
+               std::vector<std::pair<std::string, ColType>> columns,
+               bool with_sqlite)
+      : name_(std::move(name)), columns_(std::move(columns)), with_sqlite_(with_sqlite) {
+    for (auto& [col_name, type] : columns_) {
+      switch (type) {
+        case ColType::kInt:
+          builders_.emplace_back(std::make_unique<arrow::Int32Builder>());
+          break;
+        case ColType::kDecimal:
+          builders_.emplace_back(std::make_unique<arrow::DoubleBuilder>());
+          break;
+        case ColType::kText:
+          builders_.emplace_back(std::make_unique<arrow::StringBuilder>());
+          break;
+        case ColType::kDate:
+          builders_.emplace_back(std::make_unique<arrow::Date32Builder>());
+          break;
+      }
+    }
+  }
+
+  void beginRow() {
+    CHECK_EQ(col_idx_, size_t(0));
+    if (with_sqlite_) {
+      sqlite_rows_.emplace_back();
+      sqlite_rows_.back().reserve(columns_.size());
+    }
+  }
+
+  void addInt(int32_t val) {
+    CHECK(columns_[col_idx_].second == ColType::kInt);
+    ARROW_THROW_NOT_OK(
+        static_cast<arrow::Int32Builder*>(builders_[col_idx_].get())->Append(val));
+    addSqliteValue(std::to_string(val));
+  }
+
+  void addDecimal(int64_t cents) {
+    CHECK(columns_[col_idx_].second == ColType::kDecimal);
+    ARROW_THROW_NOT_OK(static_cast<arrow::DoubleBuilder*>(builders_[col_idx_].get())
+                           ->Append(static_cast<double>(cents) / 100));
+    addSqliteValue(centsToString(cents));
+  }
+
+  void addText(const std::string& val) {
+    CHECK(columns_[col_idx_].second == ColType::kText);
+    ARROW_THROW_NOT_OK(
+        static_cast<arrow::StringBuilder*>(builders_[col_idx_].get())->Append(val));
+    addSqliteValue(val);
+  }
+
+  void addDate(int32_t days) {
+    CHECK(columns_[col_idx_].second == ColType::kDate);
+    ARROW_THROW_NOT_OK(
+        static_cast<arrow::Date32Builder*>(builders_[col_idx_].get())->Append(days));
+    addSqliteValue(dateToString(days));
+  }
+
+  void endRow() {
+    CHECK_EQ(col_idx_, columns_.size());
+    col_idx_ = 0;
+    ++rows_;
+  }
+
+  void load(size_t fragment_size) {
+    std::vector<std::shared_ptr<arrow::Field>> fields;
+    std::vector<std::shared_ptr<arrow::Array>> arrays;
+    for (size_t i = 0; i < columns_.size(); ++i) {
+      std::shared_ptr<arrow::Array> arr;
+      ARROW_THROW_NOT_OK(builders_[i]->Finish(&arr));
+      fields.push_back(arrow::field(columns_[i].first, arr->type()));
+      arrays.push_back(arr);
+    }
+    auto table = arrow::Table::Make(arrow::schema(fields), arrays);
+    getStorage()->dropTable(name_);
+    getStorage()->importArrowTable(
+        table, name_, ArrowStorage::TableOptions{fragment_size});
+
+    if (with_sqlite_) {
+      std::string ddl = "CREATE TABLE " + name_ + " (";
+      for (size_t i = 0; i < columns_.size(); ++i) {
+        ddl += (i ? ", " : "") + columns_[i].first + " " +
+               sqliteType(columns_[i].second);
+      }
+      ddl += ");";
+      run_sqlite_query("DROP TABLE IF EXISTS " + name_ + ";");
+      run_sqlite_query(ddl);
+      sqlite_batch_insert(name_, sqlite_rows_);
+      sqlite_rows_.clear();
+    }
+    LOG(INFO) << "Generated TPC-H table " << name_ << " with " << rows_ << " rows.";
+  }
+
+ private:
+  void addSqliteValue(std::string val) {
+    if (with_sqlite_) {
+      sqlite_rows_.back().emplace_back(std::move(val));
+    }
+    ++col_idx_;
+  }
+
+  static const char* sqliteType(ColType type) {
+    switch (type) {
+      case ColType::kInt:
+        return "INT";
+      case ColType::kDecimal:
+        return "DOUBLE";
+      case ColType::kText:
+      case ColType::kDate:
+        return "TEXT";
+    }
+    return "TEXT";
+  }
+
+  std::string name_;
+  std::vector<std::pair<std::string, ColType>> columns_;
+  bool with_sqlite_;
+  std::vector<std::unique_ptr<arrow::ArrayBuilder>> builders_;
+  std::vector<std::vector<std::string>> sqlite_rows_;
+  size_t col_idx_ = 0;
+  size_t rows_ = 0;
+};
+
+const char* kRegions[] = {"AFRICA", "AMERICA", "ASIA", "EUROPE", "MIDDLE EAST"};
+
+const std::pair<const char*, int32_t> kNations[] = {
+    {"ALGERIA", 0},    {"ARGENTINA", 1},      {"BRAZIL", 1},     {"CANADA", 1},
+    {"EGYPT", 4},      {"ETHIOPIA", 0},       {"FRANCE", 3},     {"GERMANY", 3},
+    {"INDIA", 2},      {"INDONESIA", 2},      {"IRAN", 4},       {"IRAQ", 4},
+    {"JAPAN", 2},      {"JORDAN", 4},         {"KENYA", 0},      {"MOROCCO", 0},
+    {"MOZAMBIQUE", 0}, {"PERU", 1},           {"CHINA", 2},      {"ROMANIA", 3},
+    {"SAUDI ARABIA", 4}, {"VIETNAM", 2},      {"RUSSIA", 3},     {"UNITED KINGDOM", 3},
+    {"UNITED STATES", 1}};
+
+const char* kSegments[] = {"AUTOMOBILE", "BUILDING", "FURNITURE", "MACHINERY",
+                           "HOUSEHOLD"};
+const char* kPriorities[] = {"1-URGENT", "2-HIGH", "3-MEDIUM", "4-NOT SPECIFIED",
+                             "5-LOW"};
+const char* kInstructions[] = {"DELIVER IN PERSON", "COLLECT COD", "NONE",
+                               "TAKE BACK RETURN"};
+const char* kShipModes[] = {"REG AIR", "AIR", "RAIL", "SHIP", "TRUCK", "MAIL", "FOB"};
+const char* kTypeSyllable1[] = {"STANDARD", "SMALL", "MEDIUM", "LARGE", "ECONOMY",
+                                "PROMO"};
+const char* kTypeSyllable2[] = {"ANODIZED", "BURNISHED", "PLATED", "POLISHED",
+                                "BRUSHED"};
+const char* kTypeSyllable3[] = {"TIN", "NICKEL", "BRASS", "STEEL", "COPPER"};
+const char* kContainerSyllable1[] = {"SM", "LG", "MED", "JUMBO", "WRAP"};
+const char* kContainerSyllable2[] = {"CASE", "BOX", "BAG", "JAR", "PKG", "PACK", "CAN",
+                                     "DRUM"};
+
+template <typename T, size_t N>
+const T& pick(const T (&values)[N], std::mt19937_64& rng) {
+  return values[std::uniform_int_distribution<size_t>(0, N - 1)(rng)];
+}
+
+int64_t uniform(std::mt19937_64& rng, int64_t lo, int64_t hi) {
+  return std::uniform_int_distribution<int64_t>(lo, hi)(rng);
+}
+
+std::string numberedName(const char* prefix, int64_t key) {
+  char buf[32];
+  snprintf(buf, sizeof(buf), "%s#%09lld", prefix, static_cast<long long>(key));
+  return buf;
+}
+
+// Retail price of a part as defined by the specification, in cents.
+int64_t partRetailPrice(int64_t partkey) {
+  return 90000 + (partkey / 10) % 20001 + 100 * (partkey % 1000);
+}
+
+}  // namespace
+
+void generateTables(double scale_factor,
+                    size_t fragment_size,
+                    bool with_sqlite,
+                    uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  const int64_t supplier_count = std::max<int64_t>(std::llround(10000 * scale_factor), 1);
+  const int64_t customer_count =
+      std::max<int64_t>(std::llround(150000 * scale_factor), 1);
+  const int64_t part_count = std::max<int64_t>(std::llround(200000 * scale_factor), 1);
+  const int64_t order_count = std::max<int64_t>(std::llround(1500000 * scale_factor), 1);
+
+  {
+    TableBuilder region("region", {{"r_regionkey", ColType::kInt},
+                                   {"r_name", ColType::kText}},
+                        with_sqlite);
+    for (int32_t i = 0; i < 5; ++i) {
+      region.beginRow();
+      region.addInt(i);
+      region.addText(kRegions[i]);
+      region.endRow();
+    }
+    region.load(fragment_size);
+  }
+
+  {
+    TableBuilder nation("nation", {{"n_nationkey", ColType::kInt},
+                                   {"n_name", ColType::kText},
+                                   {"n_regionkey", ColType::kInt}},
+                        with_sqlite);
+    for (int32_t i = 0; i < 25; ++i) {
+      nation.beginRow();
+      nation.addInt(i);
+      nation.addText(kNations[i].first);
+      nation.addInt(kNations[i].second);
+      nation.endRow();
+    }
+    nation.load(fragment_size);
+  }
+
+  {
+    TableBuilder supplier("supplier", {{"s_suppkey", ColType::kInt},
+                                       {"s_name", ColType::kText},
+                                       {"s_nationkey", ColType::kInt},
+                                       {"s_acctbal", ColType::kDecimal}},
+                          with_sqlite);
+    for (int64_t key = 1; key <= supplier_count; ++key) {
+      supplier.beginRow();
+      supplier.addInt(key);
+      supplier.addText(numberedName("Supplier", key));
+      supplier.addInt(uniform(rng, 0, 24));
+      supplier.addDecimal(uniform(rng, -99999, 999999));
+      supplier.endRow();
+    }
+    supplier.load(fragment_size);
+  }
+
+  {
+    TableBuilder customer("customer", {{"c_custkey", ColType::kInt},
+                                       {"c_name", ColType::kText},
+                                       {"c_nationkey", ColType::kInt},
+                                       {"c_acctbal", ColType::kDecimal},
+                                       {"c_mktsegment", ColType::kText}},
+                          with_sqlite);
+    for (int64_t key = 1; key <= customer_count; ++key) {
+      customer.beginRow();
+      customer.addInt(key);
+      customer.addText(numberedName("Customer", key));
+      customer.addInt(uniform(rng, 0, 24));
+      customer.addDecimal(uniform(rng, -99999, 999999));
+      customer.addText(pick(kSegments, rng));
+      customer.endRow();
+    }
+    customer.load(fragment_size);
+  }
+
+  {
+    TableBuilder part("part", {{"p_partkey", ColType::kInt},
+                               {"p_brand", ColType::kText},
+                               {"p_type", ColType::kText},
+                               {"p_size", ColType::kInt},
+                               {"p_container", ColType::kText},
+                               {"p_retailprice", ColType::kDecimal}},
+                      with_sqlite);
+    TableBuilder partsupp("partsupp", {{"ps_partkey", ColType::kInt},
+                                       {"ps_suppkey", ColType::kInt},
+                                       {"ps_availqty", ColType::kInt},
+                                       {"ps_supplycost", ColType::kDecimal}},
+                          with_sqlite);
+    for (int64_t key = 1; key <= part_count; ++key) {
+      const auto manufacturer = uniform(rng, 1, 5);
+      part.beginRow();
+      part.addInt(key);
+      part.addText("Brand#" + std::to_string(manufacturer) +
+                   std::to_string(uniform(rng, 1, 5)));
+      part.addText(std::string(pick(kTypeSyllable1, rng)) + " " +
+                   pick(kTypeSyllable2, rng) + " " + pick(kTypeSyllable3, rng));
+      part.addInt(uniform(rng, 1, 50));
+      part.addText(std::string(pick(kContainerSyllable1, rng)) + " " +
+                   pick(kContainerSyllable2, rng));
+      part.addDecimal(partRetailPrice(key));
+      part.endRow();
+
+      for (int64_t i = 0; i < 4; ++i) {
+        partsupp.beginRow();
+        partsupp.addInt(key);
+        partsupp.addInt(
+            (key + i * (supplier_count / 4 + (key - 1) / supplier_count)) %
+                supplier_count +
+            1);
+        partsupp.addInt(uniform(rng, 1, 9999));
+        partsupp.addDecimal(uniform(rng, 100, 100000));
+        partsupp.endRow();
+      }
+    }
+    part.load(fragment_size);
+    partsupp.load(fragment_size);
+  }
+
+  {
+    const int32_t start_date = daysFromCivil(1992, 1, 1);
+    const int32_t end_date = daysFromCivil(1998, 12, 31);
+    const int32_t current_date = daysFromCivil(1995, 6, 17);
+    TableBuilder orders("orders", {{"o_orderkey", ColType::kInt},
+                                   {"o_custkey", ColType::kInt},
+                                   {"o_orderstatus", ColType::kText},
+                                   {"o_totalprice", ColType::kDecimal},
+                                   {"o_orderdate", ColType::kDate},
+                                   {"o_orderpriority", ColType::kText},
+                                   {"o_shippriority", ColType::kInt}},
+                        with_sqlite);
+    TableBuilder lineitem("lineitem", {{"l_orderkey", ColType::kInt},
+                                       {"l_partkey", ColType::kInt},
+                                       {"l_suppkey", ColType::kInt},
+                                       {"l_linenumber", ColType::kInt},
+                                       {"l_quantity", ColType::kDecimal},
+                                       {"l_extendedprice", ColType::kDecimal},
+                                       {"l_discount", ColType::kDecimal},
+                                       {"l_tax", ColType::kDecimal},
+                                       {"l_returnflag", ColType::kText},
+                                       {"l_linestatus", ColType::kText},
+                                       {"l_shipdate", ColType::kDate},
+                                       {"l_commitdate", ColType::kDate},
+                                       {"l_receiptdate", ColType::kDate},
+                                       {"l_shipinstruct", ColType::kText},
+                                       {"l_shipmode", ColType::kText}},
+                          with_sqlite);
+    for (int64_t i = 0; i < order_count; ++i) {
+      // Order keys are sparse in the specification: 8 keys used out of each 32.
+      const int64_t orderkey = (i / 8) * 32 + i % 8 + 1;
+      // Every third customer places no orders.
+      int64_t custkey = uniform(rng, 1, customer_count);
+      if (customer_count > 2 && custkey % 3 == 0) {
+        custkey = custkey == customer_count ? custkey - 1 : custkey + 1;
+      }
+      const int32_t orderdate = uniform(rng, start_date, end_date - 151);
+      const auto line_count = uniform(rng, 1, 7);
+      int64_t total_cents = 0;
+      size_t shipped_lines = 0;
+      for (int64_t line = 1; line <= line_count; ++line) {
+        const int64_t partkey = uniform(rng, 1, part_count);
+        const int64_t suppkey = (partkey + uniform(rng, 0, 3) * (supplier_count / 4)) %
+                                    supplier_count +
+                                1;
+        const int64_t quantity = uniform(rng, 1, 50);
+        const int64_t extended_cents = quantity * partRetailPrice(partkey);
+        const int64_t discount = uniform(rng, 0, 10);
+        const int64_t tax = uniform(rng, 0, 8);
+        const int32_t shipdate = orderdate + uniform(rng, 1, 121);
+        const int32_t commitdate = orderdate + uniform(rng, 30, 90);
+        const int32_t receiptdate = shipdate + uniform(rng, 1, 30);
+        const char* returnflag =
+            receiptdate <= current_date ? (uniform(rng, 0, 1) ? "R" : "A") : "N";
+        const bool shipped = shipdate <= current_date;
+        shipped_lines += shipped;
+        total_cents += extended_cents * (100 - discount) / 100 * (100 + tax) / 100;
+
+        lineitem.beginRow();
+        lineitem.addInt(orderkey);
+        lineitem.addInt(partkey);
+        lineitem.addInt(suppkey);
+        lineitem.addInt(line);
+        lineitem.addDecimal(quantity * 100);
+        lineitem.addDecimal(extended_cents);
+        lineitem.addDecimal(discount);
+        lineitem.addDecimal(tax);
+        lineitem.addText(returnflag);
+        lineitem.addText(shipped ? "F" : "O");
+        lineitem.addDate(shipdate);
+        lineitem.addDate(commitdate);
+        lineitem.addDate(receiptdate);
+        lineitem.addText(pick(kInstructions, rng));
+        lineitem.addText(pick(kShipModes, rng));
+        lineitem.endRow();
+      }
+      const char* status = shipped_lines == static_cast<size_t>(line_count) ? "F"
+                           : shipped_lines == 0                              ? "O"
+                                                                             : "P";
+      orders.beginRow();
+      orders.addInt(orderkey);
+      orders.addInt(custkey);
+      orders.addText(status);
+      orders.addDecimal(total_cents);
+      orders.addDate(orderdate);
+      orders.addText(pick(kPriorities, rng));
+      orders.addInt(0);
+      orders.endRow();
+    }
+    orders.load(fragment_size);
+    lineitem.load(fragment_size);
+  }
+}
+
+}  // namespace tpch
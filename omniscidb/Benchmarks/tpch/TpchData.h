@@ -0,0 +1,40 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    TpchData.h
+ * @brief   Generator of TPC-H tables imported straight into ArrowStorage.
+ *
+ * Table cardinalities, keys and value distributions follow the TPC-H specification
+ * closely enough for the benchmark queries, but the data is not identical to dbgen
+ * output. Comment and address columns are not generated, decimals are stored as
+ * doubles holding whole cents.
+ **/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace tpch {
+
+// Generate and import all tables of the scale factor into the ArrowSQLRunner storage.
+// With with_sqlite, the same rows are inserted into its SQLite database to validate
+// query results. The data depends only on the scale factor and the seed.
+void generateTables(double scale_factor,
+                    size_t fragment_size,
+                    bool with_sqlite,
+                    uint64_t seed = 19920101);
+
+}  // namespace tpch
@@ -0,0 +1,366 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    tpch_bench.cpp
+ * @brief   TPC-H query benchmark on ArrowStorage with optional result validation.
+ *
+ * Tables are generated in memory for the requested scale factor and each query is
+ * run in every requested execution mode. With --validate, the first run of each
+ * query is compared with SQLite on the same data. Timings are written in the JSON
+ * format read by analyze_benchmark.py, one file per mode, so two runs can be
+ * compared with it directly.
+ **/
+
+#include "TpchData.h"
+
+#include "Logger/Logger.h"
+#include "Shared/scope.h"
+#include "Tests/ArrowSQLRunner/ArrowSQLRunner.h"
+
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/replace.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+#include <gtest/gtest.h>
+#include <rapidjson/document.h>
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace TestHelpers::ArrowSQLRunner;
+
+namespace {
+
+struct TpchQuery {
+  std::string id;
+  std::string sql;
+};
+
+// Date arithmetic of the reference queries is folded into literals, so the same
+// text runs on SQLite once DATE prefixes are removed. Queries with correlated
+// subqueries are not included.
+const std::vector<TpchQuery> kQueries = {
+    {"q1",
+     "SELECT l_returnflag, l_linestatus, SUM(l_quantity) AS sum_qty, "
+     "SUM(l_extendedprice) AS sum_base_price, "
+     "SUM(l_extendedprice * (1 - l_discount)) AS sum_disc_price, "
+     "SUM(l_extendedprice * (1 - l_discount) * (1 + l_tax)) AS sum_charge, "
+     "AVG(l_quantity) AS avg_qty, AVG(l_extendedprice) AS avg_price, "
+     "AVG(l_discount) AS avg_disc, COUNT(*) AS count_order FROM lineitem "
+     "WHERE l_shipdate <= DATE '1998-09-02' GROUP BY l_returnflag, l_linestatus "
+     "ORDER BY l_returnflag, l_linestatus;"},
+    {"q3",
+     "SELECT l_orderkey, SUM(l_extendedprice * (1 - l_discount)) AS revenue, "
+     "o_orderdate, o_shippriority FROM customer, orders, lineitem "
+     "WHERE c_mktsegment = 'BUILDING' AND c_custkey = o_custkey "
+     "AND l_orderkey = o_orderkey AND o_orderdate < DATE '1995-03-15' "
+     "AND l_shipdate > DATE '1995-03-15' "
+     "GROUP BY l_orderkey, o_orderdate, o_shippriority "
+     "ORDER BY revenue DESC, o_orderdate, l_orderkey LIMIT 10;"},
+    {"q5",
+     "SELECT n_name, SUM(l_extendedprice * (1 - l_discount)) AS revenue "
+     "FROM customer, orders, lineitem, supplier, nation, region "
+     "WHERE c_custkey = o_custkey AND l_orderkey = o_orderkey "
+     "AND l_suppkey = s_suppkey AND c_nationkey = s_nationkey "
+     "AND s_nationkey = n_nationkey AND n_regionkey = r_regionkey "
+     "AND r_name = 'ASIA' AND o_orderdate >= DATE '1994-01-01' "
+     "AND o_orderdate < DATE '1995-01-01' GROUP BY n_name ORDER BY revenue DESC;"},
+    {"q6",
+     "SELECT SUM(l_extendedprice * l_discount) AS revenue FROM lineitem "
+     "WHERE l_shipdate >= DATE '1994-01-01' AND l_shipdate < DATE '1995-01-01' "
+     "AND l_discount BETWEEN 0.05 AND 0.07 AND l_quantity < 24;"},
+    {"q10",
+     "SELECT c_custkey, c_name, SUM(l_extendedprice * (1 - l_discount)) AS revenue, "
+     "c_acctbal, n_name FROM customer, orders, lineitem, nation "
+     "WHERE c_custkey = o_custkey AND l_orderkey = o_orderkey "
+     "AND o_orderdate >= DATE '1993-10-01' AND o_orderdate < DATE '1994-01-01' "
+     "AND l_returnflag = 'R' AND c_nationkey = n_nationkey "
+     "GROUP BY c_custkey, c_name, c_acctbal, n_name "
+     "ORDER BY revenue DESC, c_custkey LIMIT 20;"},
+    {"q12",
+     "SELECT l_shipmode, SUM(CASE WHEN o_orderpriority = '1-URGENT' "
+     "OR o_orderpriority = '2-HIGH' THEN 1 ELSE 0 END) AS high_line_count, "
+     "SUM(CASE WHEN o_orderpriority <> '1-URGENT' AND o_orderpriority <> '2-HIGH' "
+     "THEN 1 ELSE 0 END) AS low_line_count FROM orders, lineitem "
+     "WHERE o_orderkey = l_orderkey AND l_shipmode IN ('MAIL', 'SHIP') "
+     "AND l_commitdate < l_receiptdate AND l_shipdate < l_commitdate "
+     "AND l_receiptdate >= DATE '1994-01-01' AND l_receiptdate < DATE '1995-01-01' "
+     "GROUP BY l_shipmode ORDER BY l_shipmode;"},
+    {"q14",
+     "SELECT 100.00 * SUM(CASE WHEN p_type LIKE 'PROMO%' "
+     "THEN l_extendedprice * (1 - l_discount) ELSE 0 END) / "
+     "SUM(l_extendedprice * (1 - l_discount)) AS promo_revenue "
+     "FROM lineitem, part WHERE l_partkey = p_partkey "
+     "AND l_shipdate >= DATE '1995-09-01' AND l_shipdate < DATE '1995-10-01';"},
+    {"q19",
+     "SELECT SUM(l_extendedprice * (1 - l_discount)) AS revenue FROM lineitem "
+     "JOIN part ON p_partkey = l_partkey WHERE "
+     "(p_brand = 'Brand#12' AND p_container IN ('SM CASE', 'SM BOX', 'SM PACK', "
+     "'SM PKG') AND l_quantity >= 1 AND l_quantity <= 11 AND p_size BETWEEN 1 AND 5 "
+     "AND l_shipmode IN ('AIR', 'REG AIR') "
+     "AND l_shipinstruct = 'DELIVER IN PERSON') OR "
+     "(p_brand = 'Brand#23' AND p_container IN ('MED BAG', 'MED BOX', 'MED PKG', "
+     "'MED PACK') AND l_quantity >= 10 AND l_quantity <= 20 "
+     "AND p_size BETWEEN 1 AND 10 AND l_shipmode IN ('AIR', 'REG AIR') "
+     "AND l_shipinstruct = 'DELIVER IN PERSON') OR "
+     "(p_brand = 'Brand#34' AND p_container IN ('LG CASE', 'LG BOX', 'LG PACK', "
+     "'LG PKG') AND l_quantity >= 20 AND l_quantity <= 30 "
+     "AND p_size BETWEEN 1 AND 15 AND l_shipmode IN ('AIR', 'REG AIR') "
+     "AND l_shipinstruct = 'DELIVER IN PERSON');"}};
+
+std::string toSqliteQuery(const std::string& query) {
+  return boost::replace_all_copy(query, "DATE '", "'");
+}
+
+struct ExecMode {
+  std::string name;
+  ExecutorDeviceType device_type;
+  bool heterogeneous;
+};
+
+// Number of failed gtest assertions made by the SQLite comparator so far.
+size_t validationFailures() {
+  const auto& res = testing::UnitTest::GetInstance()->ad_hoc_test_result();
+  size_t failures = 0;
+  for (int i = 0; i < res.total_part_count(); ++i) {
+    failures += res.GetTestPartResult(i).failed();
+  }
+  return failures;
+}
+
+struct QueryTimings {
+  std::string query_id;
+  std::string sql;
+  bool succeeded = true;
+  bool validated = false;
+  std::vector<double> times_ms;
+};
+
+void addStats(rapidjson::Value& results,
+              const std::vector<double>& times_ms,
+              rapidjson::Document::AllocatorType& alloc) {
+  auto sorted = times_ms;
+  std::sort(sorted.begin(), sorted.end());
+  const double first = times_ms.empty() ? 0.0 : times_ms.front();
+  double avg = 0.0;
+  for (auto t : sorted) {
+    avg += t;
+  }
+  avg = sorted.empty() ? 0.0 : avg / sorted.size();
+  // Drop 15% of the fastest and the slowest runs.
+  const size_t trim = sorted.size() * 15 / 100;
+  double trimmed_avg = 0.0;
+  for (size_t i = trim; i < sorted.size() - trim; ++i) {
+    trimmed_avg += sorted[i];
+  }
+  trimmed_avg = sorted.empty() ? 0.0 : trimmed_avg / (sorted.size() - 2 * trim);
+
+  results.AddMember("query_exec_first", first, alloc);
+  results.AddMember("query_exec_avg", avg, alloc);
+  results.AddMember("query_exec_min", sorted.empty() ? 0.0 : sorted.front(), alloc);
+  results.AddMember("query_exec_max", sorted.empty() ? 0.0 : sorted.back(), alloc);
+  results.AddMember("query_exec_trimmed_avg", trimmed_avg, alloc);
+  results.AddMember("query_total_avg", avg, alloc);
+}
+
+void writeResults(const std::string& path,
+                  const std::vector<QueryTimings>& timings,
+                  const std::string& label,
+                  const std::string& mode,
+                  const std::string& table) {
+  rapidjson::Document doc(rapidjson::kArrayType);
+  auto& alloc = doc.GetAllocator();
+  for (auto& query : timings) {
+    rapidjson::Value results(rapidjson::kObjectType);
+    results.AddMember("query_id", rapidjson::Value(query.query_id.c_str(), alloc), alloc);
+    results.AddMember("query_group", "tpch", alloc);
+    results.AddMember("run_label", rapidjson::Value(label.c_str(), alloc), alloc);
+    results.AddMember("run_version", rapidjson::Value(label.c_str(), alloc), alloc);
+    results.AddMember("run_gpu_name", rapidjson::Value(mode.c_str(), alloc), alloc);
+    results.AddMember("run_table", rapidjson::Value(table.c_str(), alloc), alloc);
+    results.AddMember("iterations", static_cast<uint64_t>(query.times_ms.size()), alloc);
+    results.AddMember("validated", query.validated, alloc);
+    addStats(results, query.times_ms, alloc);
+
+    rapidjson::Value entry(rapidjson::kObjectType);
+    entry.AddMember("name", rapidjson::Value(query.query_id.c_str(), alloc), alloc);
+    entry.AddMember("mapdql", rapidjson::Value(query.sql.c_str(), alloc), alloc);
+    entry.AddMember("succeeded", query.succeeded, alloc);
+    entry.AddMember("results", results, alloc);
+    doc.PushBack(entry, alloc);
+  }
+
+  rapidjson::StringBuffer buf;
+  rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buf);
+  doc.Accept(writer);
+  std::ofstream out(path);
+  out << buf.GetString() << std::endl;
+}
+
+std::vector<QueryTimings> runQueries(const ExecMode& mode,
+                                     size_t iterations,
+                                     bool validate,
+                                     size_t& failures) {
+  auto& het_config = config().exec.heterogeneous;
+  const auto prev_het = het_config.enable_heterogeneous_execution;
+  ScopeGuard restore_het = [&het_config, prev_het] {
+    het_config.enable_heterogeneous_execution = prev_het;
+  };
+  het_config.enable_heterogeneous_execution = mode.heterogeneous;
+
+  std::vector<QueryTimings> res;
+  for (auto& query : kQueries) {
+    QueryTimings timings{query.id, query.sql};
+    try {
+      if (validate) {
+        const auto failures_before = validationFailures();
+        c(query.sql, toSqliteQuery(query.sql), mode.device_type);
+        timings.validated = true;
+        if (validationFailures() != failures_before) {
+          LOG(ERROR) << "Validation failed for TPC-H " << query.id << " in " << mode.name
+                     << " mode.";
+          timings.succeeded = false;
+          ++failures;
+        }
+      }
+      for (size_t i = 0; i < iterations; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        run_multiple_agg(query.sql, mode.device_type);
+        auto end = std::chrono::steady_clock::now();
+        timings.times_ms.push_back(
+            std::chrono::duration<double, std::milli>(end - start).count());
+      }
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "TPC-H " << query.id << " failed in " << mode.name
+                 << " mode: " << e.what();
+      timings.succeeded = false;
+      ++failures;
+    }
+    std::cout << mode.name << " " << query.id << ": "
+              << (timings.times_ms.empty() ? 0.0 : timings.times_ms.back()) << " ms"
+              << (timings.succeeded ? "" : " (FAILED)") << std::endl;
+    res.push_back(std::move(timings));
+  }
+  return res;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+
+  namespace po = boost::program_options;
+
+  double scale_factor = 0.01;
+  size_t fragment_size = 1 << 20;
+  size_t iterations = 5;
+  std::string modes_str = "cpu,gpu";
+  bool validate = false;
+  std::string output_dir = ".";
+  std::string label = "hdk";
+
+  po::options_description desc("Options");
+  desc.add_options()("help,h", "Print help messages.");
+  desc.add_options()("scale-factor",
+                     po::value<double>(&scale_factor)->default_value(scale_factor),
+                     "TPC-H scale factor of the generated data.");
+  desc.add_options()("fragment-size",
+                     po::value<size_t>(&fragment_size)->default_value(fragment_size),
+                     "Fragment size of the generated tables.");
+  desc.add_options()("iterations",
+                     po::value<size_t>(&iterations)->default_value(iterations),
+                     "Number of timed runs of each query.");
+  desc.add_options()("modes",
+                     po::value<std::string>(&modes_str)->default_value(modes_str),
+                     "Comma separated execution modes: cpu, gpu, het. GPU modes are "
+                     "skipped when no GPU is available.");
+  desc.add_options()("validate",
+                     po::bool_switch(&validate)->default_value(validate),
+                     "Compare query results with SQLite on the same data.");
+  desc.add_options()("output-dir",
+                     po::value<std::string>(&output_dir)->default_value(output_dir),
+                     "Directory for JSON results, one file per execution mode.");
+  desc.add_options()("label",
+                     po::value<std::string>(&label)->default_value(label),
+                     "Run label stored in the results and used in file names.");
+
+  logger::LogOptions log_options(argv[0]);
+  log_options.severity_ = logger::Severity::ERROR;
+  log_options.set_options();  // update default values
+  desc.add(log_options.get_options());
+
+  po::variables_map vm;
+  po::store(po::command_line_parser(argc, argv).options(desc).run(), vm);
+  po::notify(vm);
+
+  if (vm.count("help")) {
+    std::cout << "Usage:" << std::endl << desc << std::endl;
+    return 0;
+  }
+
+  logger::init(log_options);
+  init();
+
+  std::vector<ExecMode> modes;
+  std::vector<std::string> mode_names;
+  boost::split(mode_names, modes_str, boost::is_any_of(","));
+  for (auto& name : mode_names) {
+    if (name == "cpu") {
+      modes.push_back({name, ExecutorDeviceType::CPU, false});
+    } else if (name == "gpu" || name == "het") {
+      if (!gpusPresent()) {
+        std::cout << "Skipping " << name << " mode: no GPU available." << std::endl;
+        continue;
+      }
+      modes.push_back({name, ExecutorDeviceType::GPU, name == "het"});
+    } else {
+      std::cerr << "Unknown execution mode: " << name << std::endl;
+      return -1;
+    }
+  }
+
+  size_t failures = 0;
+  try {
+    auto start = std::chrono::steady_clock::now();
+    tpch::generateTables(scale_factor, fragment_size, validate);
+    auto end = std::chrono::steady_clock::now();
+    std::cout << "Generated TPC-H SF " << scale_factor << " in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(end - start)
+                     .count()
+              << " ms" << std::endl;
+
+    std::ostringstream table_name;
+    table_name << "tpch_sf" << scale_factor;
+    boost::filesystem::create_directories(output_dir);
+    for (auto& mode : modes) {
+      auto timings = runQueries(mode, iterations, validate, failures);
+      auto path =
+          boost::filesystem::path(output_dir) / (label + "_" + mode.name + ".json");
+      writeResults(path.string(), timings, label, mode.name, table_name.str());
+    }
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+    reset();
+    return -1;
+  }
+
+  reset();
+  return failures ? 1 : 0;
+}
@@ -20,6 +20,8 @@
 
 using namespace Data_Namespace;
 
+class ThrustScratchPool;
+
 class BufferProvider {
  public:
   virtual ~BufferProvider() = default;
@@ -50,4 +52,6 @@ class BufferProvider {
   // parameter `device_num` into every BufferProvider's method, maybe we should remove
   // `setContext()`?
   virtual void setContext(const int device_id) = 0;
+  // Cache of GPU scratch buffers shared by Thrust allocators, nullptr if disabled.
+  virtual ThrustScratchPool* getThrustScratchPool() const { return nullptr; }
 };
@@ -0,0 +1,74 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    CalciteDisabled.cpp
+ * @brief   CalciteMgr for builds with ENABLE_CALCITE=OFF.
+ *
+ * The manager cannot be created, so SQL queries fail with an error, while queries
+ * built with QueryBuilder work as usual.
+ **/
+
+#include "CalciteJNI.h"
+
+#include <stdexcept>
+
+namespace {
+
+[[noreturn]] void throw_calcite_disabled() {
+  throw std::runtime_error(
+      "SQL queries are not supported: HDK is built with ENABLE_CALCITE=OFF.");
+}
+
+}  // namespace
+
+CalciteMgr::~CalciteMgr() {}
+
+CalciteMgr* CalciteMgr::get(const std::string& udf_filename,
+                            size_t calcite_max_mem_mb,
+                            size_t num_workers) {
+  throw_calcite_disabled();
+}
+
+std::string CalciteMgr::process(
+    const std::string& db_name,
+    const std::string& sql_string,
+    SchemaProvider* schema_provider,
+    Config* config,
+    const std::vector<FilterPushDownInfo>& filter_push_down_info,
+    const bool legacy_syntax,
+    const bool is_explain,
+    const bool is_view_optimize) {
+  throw_calcite_disabled();
+}
+
+std::string CalciteMgr::getExtensionFunctionWhitelist() {
+  throw_calcite_disabled();
+}
+
+std::string CalciteMgr::getUserDefinedFunctionWhitelist() {
+  throw_calcite_disabled();
+}
+
+std::string CalciteMgr::getRuntimeExtensionFunctionWhitelist() {
+  throw_calcite_disabled();
+}
+
+void CalciteMgr::setRuntimeExtensionFunctions(const std::vector<ExtensionFunction>& udfs,
+                                              bool is_runtime) {
+  throw_calcite_disabled();
+}
+
+std::once_flag CalciteMgr::instance_init_flag_;
+std::unique_ptr<CalciteMgr> CalciteMgr::instance_;
@@ -20,8 +20,12 @@
 
 #include "Logger/Logger.h"
 #include "OSDependent/omnisci_path.h"
+#include "Shared/Metrics.h"
+
+#include <boost/functional/hash.hpp>
 
 #include <jni.h>
+#include <cctype>
 #include <filesystem>
 
 using namespace std::string_literals;
@@ -86,7 +90,11 @@ class JVM {
     return instance_;
   }
 
-  static void destroyInstance() { instance_ = nullptr; }
+  // Called by each Calcite worker on exit, JVM is destroyed with the last reference.
+  static void destroyInstance() {
+    std::lock_guard<std::mutex> lock(instance_mutex_);
+    instance_ = nullptr;
+  }
 
   // Get JNI environment for the current thread.
   // You souldn't pass this obect between threads. It should be deallocated
@@ -161,12 +169,60 @@ class JVM {
   JavaVM* jvm_;
 
   static std::once_flag instance_init_flag_;
+  static std::mutex instance_mutex_;
   static std::shared_ptr<JVM> instance_;
 };
 
 std::once_flag JVM::instance_init_flag_;
+std::mutex JVM::instance_mutex_;
 std::shared_ptr<JVM> JVM::instance_;
 
+// Collapse whitespace outside of quoted literals, identifiers and line comments and
+// drop trailing semicolons, so formatting differences don't cause RelAlg cache misses.
+std::string normalize_sql(const std::string& sql) {
+  std::string res;
+  res.reserve(sql.size());
+  char quote = 0;
+  bool pending_space = false;
+  for (size_t i = 0; i < sql.size(); ++i) {
+    auto ch = sql[i];
+    if (quote) {
+      res.push_back(ch);
+      if (ch == quote) {
+        quote = 0;
+      }
+      continue;
+    }
+    if (std::isspace(static_cast<unsigned char>(ch))) {
+      pending_space = !res.empty();
+      continue;
+    }
+    if (pending_space) {
+      res.push_back(' ');
+      pending_space = false;
+    }
+    if (ch == '\'' || ch == '"') {
+      quote = ch;
+    }
+    // Line comments are kept with the newline ending them, which is significant.
+    if (ch == '-' && i + 1 < sql.size() && sql[i + 1] == '-') {
+      auto end = sql.find('\n', i);
+      if (end == std::string::npos) {
+        res.append(sql, i, std::string::npos);
+        break;
+      }
+      res.append(sql, i, end - i + 1);
+      i = end;
+      continue;
+    }
+    res.push_back(ch);
+  }
+  while (!quote && !res.empty() && (res.back() == ';' || res.back() == ' ')) {
+    res.pop_back();
+  }
+  return res;
+}
+
 }  // namespace
 
 class CalciteJNI {
@@ -569,13 +625,17 @@ CalciteMgr::~CalciteMgr() {
     should_exit_ = true;
   }
   worker_cv_.notify_all();
-  worker_.join();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
 }
 
-CalciteMgr* CalciteMgr::get(const std::string& udf_filename, size_t calcite_max_mem_mb) {
+CalciteMgr* CalciteMgr::get(const std::string& udf_filename,
+                            size_t calcite_max_mem_mb,
+                            size_t num_workers) {
   std::call_once(instance_init_flag_, [=] {
-    instance_ =
-        std::unique_ptr<CalciteMgr>(new CalciteMgr(udf_filename, calcite_max_mem_mb));
+    instance_ = std::unique_ptr<CalciteMgr>(
+        new CalciteMgr(udf_filename, calcite_max_mem_mb, num_workers));
   });
   return instance_.get();
 }
@@ -589,6 +649,27 @@ std::string CalciteMgr::process(
     const bool legacy_syntax,
     const bool is_explain,
     const bool is_view_optimize) {
+  // The schema version is taken before Calcite reads the schema, so a concurrent
+  // schema change can only make the new entry unreachable.
+  const bool use_cache = config && config->cache.enable_rel_alg_cache &&
+                         filter_push_down_info.empty() && schema_provider &&
+                         schema_provider->getVersion();
+  RelAlgCacheKey cache_key;
+  if (use_cache) {
+    cache_key = {normalize_sql(sql_string),
+                 db_name,
+                 schema_provider,
+                 schema_provider->getVersion(),
+                 legacy_syntax,
+                 is_explain,
+                 is_view_optimize,
+                 config->exec.watchdog.enable};
+    auto cached_ra = getCachedRelAlg(cache_key);
+    if (cached_ra) {
+      return *cached_ra;
+    }
+  }
+
   auto task = Task([&db_name,
                     &sql_string,
                     &filter_push_down_info,
@@ -611,7 +692,11 @@ std::string CalciteMgr::process(
   submitTaskToQueue(std::move(task));
 
   result.wait();
-  return result.get();
+  auto ra = result.get();
+  if (use_cache) {
+    putCachedRelAlg(std::move(cache_key), ra, config->cache.rel_alg_cache_size);
+  }
+  return ra;
 }
 
 std::string CalciteMgr::getExtensionFunctionWhitelist() {
@@ -655,52 +740,134 @@ std::string CalciteMgr::getRuntimeExtensionFunctionWhitelist() {
 
 void CalciteMgr::setRuntimeExtensionFunctions(const std::vector<ExtensionFunction>& udfs,
                                               bool is_runtime) {
-  auto task = Task([&udfs, is_runtime](CalciteJNI* calcite_jni) {
+  // Cached queries might use previous definitions of the functions.
+  clearRelAlgCache();
+
+  runOnAllWorkers([&udfs, is_runtime](CalciteJNI* calcite_jni) {
     CHECK(calcite_jni);
     calcite_jni->setRuntimeExtensionFunctions(udfs, is_runtime);
     return "";  // all tasks return strings
   });
+}
 
-  auto result = task.get_future();
-  submitTaskToQueue(std::move(task));
+bool CalciteMgr::RelAlgCacheKey::operator==(const RelAlgCacheKey& other) const {
+  return sql == other.sql && db_name == other.db_name &&
+         schema_provider == other.schema_provider &&
+         schema_version == other.schema_version &&
+         legacy_syntax == other.legacy_syntax && is_explain == other.is_explain &&
+         is_view_optimize == other.is_view_optimize &&
+         watchdog_enabled == other.watchdog_enabled;
+}
 
-  result.wait();
+size_t CalciteMgr::RelAlgCacheKeyHash::operator()(const RelAlgCacheKey& key) const {
+  return boost::hash_value(std::tie(key.sql,
+                                    key.db_name,
+                                    key.schema_provider,
+                                    key.schema_version,
+                                    key.legacy_syntax,
+                                    key.is_explain,
+                                    key.is_view_optimize,
+                                    key.watchdog_enabled));
+}
+
+std::optional<std::string> CalciteMgr::getCachedRelAlg(const RelAlgCacheKey& key) {
+  std::lock_guard<std::mutex> lock(rel_alg_cache_mutex_);
+  auto it = rel_alg_cache_.find(key);
+  if (it == rel_alg_cache_.end()) {
+    return std::nullopt;
+  }
+  rel_alg_cache_lru_.splice(rel_alg_cache_lru_.begin(), rel_alg_cache_lru_, it->second);
+  return it->second->second;
+}
+
+void CalciteMgr::putCachedRelAlg(RelAlgCacheKey key,
+                                 const std::string& ra,
+                                 size_t max_size) {
+  std::lock_guard<std::mutex> lock(rel_alg_cache_mutex_);
+  if (!max_size || rel_alg_cache_.count(key)) {
+    return;
+  }
+  // Entries for outdated schema versions are never hit again and are evicted first
+  // as the least recently used ones.
+  while (rel_alg_cache_.size() >= max_size) {
+    rel_alg_cache_.erase(rel_alg_cache_lru_.back().first);
+    rel_alg_cache_lru_.pop_back();
+  }
+  rel_alg_cache_lru_.emplace_front(std::move(key), ra);
+  rel_alg_cache_.emplace(rel_alg_cache_lru_.front().first, rel_alg_cache_lru_.begin());
+}
+
+void CalciteMgr::clearRelAlgCache() {
+  std::lock_guard<std::mutex> lock(rel_alg_cache_mutex_);
+  rel_alg_cache_.clear();
+  rel_alg_cache_lru_.clear();
 }
 
-CalciteMgr::CalciteMgr(const std::string& udf_filename, size_t calcite_max_mem_mb) {
+CalciteMgr::CalciteMgr(const std::string& udf_filename,
+                       size_t calcite_max_mem_mb,
+                       size_t num_workers)
+    : worker_queues_(std::max(num_workers, size_t(1))) {
   // todo: should register an exit handler for ctrl + c
-  worker_ = std::thread(&CalciteMgr::worker, this, udf_filename, calcite_max_mem_mb);
+  for (size_t worker_idx = 0; worker_idx < worker_queues_.size(); ++worker_idx) {
+    workers_.emplace_back(
+        &CalciteMgr::worker, this, udf_filename, calcite_max_mem_mb, worker_idx);
+  }
 }
 
-void CalciteMgr::worker(const std::string& udf_filename, size_t calcite_max_mem_mb) {
+void CalciteMgr::worker(const std::string& udf_filename,
+                        size_t calcite_max_mem_mb,
+                        size_t worker_idx) {
   auto calcite_jni = std::make_unique<CalciteJNI>(udf_filename, calcite_max_mem_mb);
+  auto& queue_wait_metric = metrics::Registry::get().histogram(
+      "hdk_calcite_queue_wait_seconds", "Time Calcite tasks wait for a worker.");
 
   std::unique_lock<std::mutex> lock(queue_mutex_);
+  auto& own_queue = worker_queues_[worker_idx];
   while (true) {
-    worker_cv_.wait(lock, [this] { return !queue_.empty() || should_exit_; });
+    worker_cv_.wait(lock, [this, &own_queue] {
+      return !own_queue.empty() || !queue_.empty() || should_exit_;
+    });
     if (should_exit_) {
       return;
     }
 
-    if (!queue_.empty()) {
-      auto task = std::move(queue_.front());
-      queue_.pop();
+    auto& queue = own_queue.empty() ? queue_ : own_queue;
+    auto task = std::move(queue.front().task);
+    const auto wait_time = std::chrono::steady_clock::now() - queue.front().enqueue_time;
+    queue.pop();
 
-      lock.unlock();
-      task(calcite_jni.get());
+    lock.unlock();
+    queue_wait_metric.observe(std::chrono::duration<double>(wait_time).count());
+    task(calcite_jni.get());
 
-      lock.lock();
-    }
+    lock.lock();
   }
 }
 
 void CalciteMgr::submitTaskToQueue(Task&& task) {
   std::unique_lock<decltype(queue_mutex_)> lock(queue_mutex_);
 
-  queue_.push(std::move(task));
+  queue_.push({std::move(task), std::chrono::steady_clock::now()});
+
+  lock.unlock();
+  worker_cv_.notify_one();
+}
+
+void CalciteMgr::runOnAllWorkers(const std::function<std::string(CalciteJNI*)>& fn) {
+  std::vector<std::future<std::string>> results;
+  std::unique_lock<decltype(queue_mutex_)> lock(queue_mutex_);
+  for (auto& queue : worker_queues_) {
+    auto task = Task(fn);
+    results.push_back(task.get_future());
+    queue.push({std::move(task), std::chrono::steady_clock::now()});
+  }
 
   lock.unlock();
   worker_cv_.notify_all();
+
+  for (auto& result : results) {
+    result.wait();
+  }
 }
 
 std::once_flag CalciteMgr::instance_init_flag_;
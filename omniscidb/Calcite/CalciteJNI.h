@@ -16,8 +16,13 @@
 
 #pragma once
 
+#include <chrono>
+#include <functional>
 #include <future>
+#include <list>
+#include <optional>
 #include <queue>
+#include <unordered_map>
 
 #include "QueryEngine/ExtensionFunctionsWhitelist.h"
 #include "SchemaMgr/SchemaProvider.h"
@@ -32,7 +37,8 @@ struct FilterPushDownInfo {
 class CalciteJNI;
 
 /**
- * Run CalciteJNI on a single thread.
+ * Run CalciteJNI on a pool of worker threads. Each worker has its own Calcite
+ * planner, queries are processed by the first available worker.
  */
 class CalciteMgr {
  public:
@@ -42,8 +48,10 @@ class CalciteMgr {
 
   ~CalciteMgr();
 
+  // The number of workers is defined by the first call.
   static CalciteMgr* get(const std::string& udf_filename = "",
-                         size_t calcite_max_mem_mb = 1024);
+                         size_t calcite_max_mem_mb = 1024,
+                         size_t num_workers = 1);
 
   std::string process(const std::string& db_name,
                       const std::string& sql_string,
@@ -61,17 +69,63 @@ class CalciteMgr {
                                     bool is_runtime = true);
 
  private:
-  explicit CalciteMgr(const std::string& udf_filename, size_t calcite_max_mem_mb);
+  CalciteMgr(const std::string& udf_filename,
+             size_t calcite_max_mem_mb,
+             size_t num_workers);
 
-  void worker(const std::string& udf_filename, size_t calcite_max_mem_mb);
+  void worker(const std::string& udf_filename,
+              size_t calcite_max_mem_mb,
+              size_t worker_idx);
 
   void submitTaskToQueue(Task&& task);
+  // Run the task on each worker to keep states of all planners in sync.
+  void runOnAllWorkers(const std::function<std::string(CalciteJNI*)>& fn);
+
+  // Calcite output depends on the query text, on the schema and on a few options
+  // only, so it is cached to skip parsing and optimization of repeated queries.
+  // The schema is identified by its provider and the provider's version.
+  struct RelAlgCacheKey {
+    std::string sql;
+    std::string db_name;
+    const SchemaProvider* schema_provider;
+    uint64_t schema_version;
+    bool legacy_syntax;
+    bool is_explain;
+    bool is_view_optimize;
+    bool watchdog_enabled;
+
+    bool operator==(const RelAlgCacheKey& other) const;
+  };
+
+  struct RelAlgCacheKeyHash {
+    size_t operator()(const RelAlgCacheKey& key) const;
+  };
+
+  using RelAlgCacheList = std::list<std::pair<RelAlgCacheKey, std::string>>;
+
+  std::optional<std::string> getCachedRelAlg(const RelAlgCacheKey& key);
+  void putCachedRelAlg(RelAlgCacheKey key, const std::string& ra, size_t max_size);
+  void clearRelAlgCache();
+
+  std::mutex rel_alg_cache_mutex_;
+  // Most recently used entries go first.
+  RelAlgCacheList rel_alg_cache_lru_;
+  std::unordered_map<RelAlgCacheKey, RelAlgCacheList::iterator, RelAlgCacheKeyHash>
+      rel_alg_cache_;
 
   std::mutex queue_mutex_;
   std::condition_variable worker_cv_;
-  std::thread worker_;
+  std::vector<std::thread> workers_;
 
-  std::queue<Task> queue_;
+  struct QueuedTask {
+    Task task;
+    // Used to report the queue wait time.
+    std::chrono::steady_clock::time_point enqueue_time;
+  };
+
+  std::queue<QueuedTask> queue_;
+  // Tasks for specific workers, processed before the shared queue.
+  std::vector<std::queue<QueuedTask>> worker_queues_;
 
   bool should_exit_{false};
   static std::once_flag instance_init_flag_;
@@ -326,8 +326,16 @@ public final class MapDParser {
       return false;
     }
 
+    public boolean hasCorrelation() {
+      if (subqueryRexVisitor != null) {
+        return subqueryRexVisitor.hasCorrelation;
+      }
+      return false;
+    }
+
     private static class SubqueryExpansionRexVisitor extends RexShuttle {
       private boolean requiresSubqueryExpansion = false;
+      private boolean hasCorrelation = false;
       private final SubqueryExpansionRelVisitor shuttle;
 
       SubqueryExpansionRexVisitor(SubqueryExpansionRelVisitor shuttle) {
@@ -337,6 +345,7 @@ public final class MapDParser {
       @Override
       public RexNode visitCorrelVariable(RexCorrelVariable variable) {
         requiresSubqueryExpansion = true;
+        hasCorrelation = true;
         return variable;
       }
 
@@ -406,7 +415,10 @@ public final class MapDParser {
     final boolean requiresSubqueryExpansion = visitor.requiresSubqueryExpansion();
     final boolean hasSort = visitor.containsSort;
 
-    if (expandOverride && requiresSubqueryExpansion) {
+    // NOT IN sub-queries are kept as IN value lists unless the query has correlated
+    // sub-queries. Those can't be executed as is and have to be decorrelated into joins
+    // and aggregations, which requires the expansion of all sub-queries.
+    if ((expandOverride || visitor.hasCorrelation()) && requiresSubqueryExpansion) {
       planner.close(); // replace planner
       allowCorrelatedSubQueryExpansion = true;
       planner = getPlanner(
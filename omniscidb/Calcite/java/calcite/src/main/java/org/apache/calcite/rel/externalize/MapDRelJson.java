@@ -42,6 +42,7 @@ import org.apache.calcite.rel.type.RelDataTypeField;
 import org.apache.calcite.rex.RexBuilder;
 import org.apache.calcite.rex.RexCall;
 import org.apache.calcite.rex.RexCorrelVariable;
+import org.apache.calcite.rex.RexDynamicParam;
 import org.apache.calcite.rex.RexFieldAccess;
 import org.apache.calcite.rex.RexFieldCollation;
 import org.apache.calcite.rex.RexInputRef;
@@ -369,6 +370,11 @@ public class MapDRelJson {
         map.put("correl", ((RexCorrelVariable) node).getName());
         map.put("type", toJson(node.getType()));
         return map;
+      case DYNAMIC_PARAM:
+        map = jsonBuilder.map();
+        map.put("dynamic_param", ((RexDynamicParam) node).getIndex());
+        map.put("type", toJson(node.getType()));
+        return map;
       default:
         if (node instanceof RexCall) {
           final RexCall call = (RexCall) node;
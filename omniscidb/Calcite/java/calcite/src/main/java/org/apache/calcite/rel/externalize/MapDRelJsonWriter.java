@@ -49,7 +49,7 @@ public class MapDRelJsonWriter implements RelWriter {
   // ~ Constructors -------------------------------------------------------------
 
   public MapDRelJsonWriter() {
-    jsonBuilder = new EscapedStringJsonBuilder();
+    jsonBuilder = new EscapedStringJsonBuilder(true);
     relList = jsonBuilder.list();
     relJson = new MapDRelJson(jsonBuilder);
   }
@@ -19,11 +19,47 @@ package org.apache.calcite.util;
 import org.apache.calcite.util.JsonBuilder;
 import org.apache.commons.text.StringEscapeUtils;
 
+import java.util.List;
+import java.util.Map;
+
 public class EscapedStringJsonBuilder extends JsonBuilder {
+  private final boolean compact;
+
+  public EscapedStringJsonBuilder() {
+    this(false);
+  }
+
+  // Compact builder writes maps and lists without line breaks and indentation.
+  // Indentation grows with the nesting depth and makes plans of queries with
+  // many expressions several times bigger.
+  public EscapedStringJsonBuilder(boolean compact) {
+    this.compact = compact;
+  }
+
   @Override
   public void append(StringBuilder buf, int indent, Object o) {
     if (o instanceof String) {
       buf.append('"').append(StringEscapeUtils.escapeJson((String) o)).append('"');
+    } else if (compact && o instanceof Map) {
+      buf.append('{');
+      String sep = "";
+      for (Map.Entry<?, ?> entry : ((Map<?, ?>) o).entrySet()) {
+        buf.append(sep);
+        append(buf, indent, entry.getKey().toString());
+        buf.append(':');
+        append(buf, indent, entry.getValue());
+        sep = ",";
+      }
+      buf.append('}');
+    } else if (compact && o instanceof List) {
+      buf.append('[');
+      String sep = "";
+      for (Object item : (List<?>) o) {
+        buf.append(sep);
+        append(buf, indent, item);
+        sep = ",";
+      }
+      buf.append(']');
     } else {
       super.append(buf, indent, o);
     }
@@ -13,12 +13,14 @@
  */
 
 #include "ConfigBuilder.h"
+#include "HardwareInfo.h"
 
 #include "Logger/Logger.h"
 
 #include <boost/crc.hpp>
 #include <boost/program_options.hpp>
 
+#include <algorithm>
 #include <iostream>
 
 namespace po = boost::program_options;
@@ -35,6 +37,69 @@ auto get_range_checker(T min, T max, const char* opt) {
   };
 }
 
+// Derives settings from the host hardware. Options set explicitly are kept as is.
+void apply_auto_config(Config& config,
+                       const HardwareInfo& hw,
+                       const po::variables_map& vm) {
+  auto is_set = [&vm](const char* opt) { return vm.count(opt) && !vm[opt].defaulted(); };
+
+  // Size sub-tasks so that a 4-byte column of a sub-task fits into L2 cache.
+  if (!is_set("cpu-sub-task-size")) {
+    config.exec.sub_tasks.sub_task_size =
+        std::clamp(hw.l2_cache_size / sizeof(int32_t),
+                   config.exec.sub_tasks.min_sub_task_size,
+                   size_t(4'000'000));
+  }
+
+  if (hw.numa_nodes > 1 && !is_set("enable-numa-aware-slabs")) {
+    config.mem.cpu.enable_numa_aware_slabs = true;
+  }
+
+  if (hw.total_memory) {
+    // The CPU buffer pool takes 80% of memory unless its size is given. Slabs are
+    // sized so that each NUMA node gets several of them.
+    const size_t pool_size =
+        config.mem.cpu.max_size ? config.mem.cpu.max_size : hw.total_memory / 5 * 4;
+    const size_t max_slab_size =
+        std::clamp(pool_size / (8 * hw.numa_nodes), size_t(64) << 20, size_t(4) << 30);
+    if (!is_set("max-cpu-slab-size")) {
+      config.mem.cpu.max_slab_size = max_slab_size;
+    }
+    if (!is_set("min-cpu-slab-size")) {
+      config.mem.cpu.min_slab_size =
+          std::min(config.mem.cpu.min_slab_size, config.mem.cpu.max_slab_size);
+    }
+
+    // Hash table and result set caches get 1/16 of memory each.
+    const size_t cache_size =
+        std::clamp(hw.total_memory / 16, size_t(256) << 20, size_t(32) << 30);
+    if (!is_set("hashtable-cache-total-bytes")) {
+      config.cache.hashtable_cache_total_bytes = cache_size;
+    }
+    if (!is_set("max-cacheable-hashtable-size-bytes")) {
+      config.cache.max_cacheable_hashtable_size_bytes =
+          config.cache.hashtable_cache_total_bytes / 2;
+    }
+    if (!is_set("result-set-cache-total-bytes")) {
+      config.cache.result_set_cache_total_bytes = cache_size;
+    }
+    if (!is_set("max-cacheable-result-set-size-bytes")) {
+      config.cache.max_cacheable_result_set_size_bytes =
+          config.cache.result_set_cache_total_bytes / 2;
+    }
+  }
+
+  LOG(INFO) << "Configured for " << hw.toString()
+            << ": cpu-sub-task-size=" << config.exec.sub_tasks.sub_task_size
+            << " enable-numa-aware-slabs=" << config.mem.cpu.enable_numa_aware_slabs
+            << " min-cpu-slab-size=" << config.mem.cpu.min_slab_size
+            << " max-cpu-slab-size=" << config.mem.cpu.max_slab_size
+            << " hashtable-cache-total-bytes="
+            << config.cache.hashtable_cache_total_bytes
+            << " result-set-cache-total-bytes="
+            << config.cache.result_set_cache_total_bytes;
+}
+
 }  // namespace
 
 ConfigBuilder::ConfigBuilder() {
@@ -49,6 +114,13 @@ bool ConfigBuilder::parseCommandLineArgs(int argc,
   po::options_description opt_desc;
 
   opt_desc.add_options()("help,h", "Show available options.");
+  opt_desc.add_options()(
+      "enable-auto-config",
+      po::value<bool>(&config_->enable_auto_config)
+          ->default_value(config_->enable_auto_config)
+          ->implicit_value(true),
+      "Derive CPU sub-task size, CPU slab sizes, NUMA-aware slabs and cache budgets "
+      "from the detected host hardware. Options given explicitly take precedence.");
 
   // exec.watchdog
   opt_desc.add_options()("enable-watchdog",
@@ -88,6 +160,13 @@ bool ConfigBuilder::parseCommandLineArgs(int argc,
                          po::value<size_t>(&config_->exec.sub_tasks.sub_task_size)
                              ->default_value(config_->exec.sub_tasks.sub_task_size),
                          "Set CPU sub-task size in rows.");
+  opt_desc.add_options()(
+      "min-cpu-sub-task-size",
+      po::value<size_t>(&config_->exec.sub_tasks.min_sub_task_size)
+          ->default_value(config_->exec.sub_tasks.min_sub_task_size),
+      "Set minimal CPU sub-task size in rows. Sub-tasks are made smaller than "
+      "cpu-sub-task-size, but not smaller than this value, when there are not enough "
+      "rows to give each CPU thread several sub-tasks.");
 
   // exec.join
   opt_desc.add_options()("enable-loop-join",
@@ -110,6 +189,67 @@ bool ConfigBuilder::parseCommandLineArgs(int argc,
       po::value<size_t>(&config_->exec.join.huge_join_hash_min_load)
           ->default_value(config_->exec.join.huge_join_hash_min_load),
       "A minimal predicted load level for huge perfect hash tables in percent.");
+  opt_desc.add_options()(
+      "enable-join-hash-ndv-load",
+      po::value<bool>(&config_->exec.join.enable_join_hash_ndv_load)
+          ->default_value(config_->exec.join.enable_join_hash_ndv_load)
+          ->implicit_value(true),
+      "Predict the load of huge perfect join hash tables from the number of distinct "
+      "inner keys in column statistics instead of the number of inner rows.");
+  opt_desc.add_options()(
+      "partitioned-hash-build-threshold",
+      po::value<size_t>(&config_->exec.join.partitioned_hash_build_threshold)
+          ->default_value(config_->exec.join.partitioned_hash_build_threshold),
+      "Minimal number of inner table rows to build one-to-many perfect and baseline "
+      "join hash tables on CPU by partitions of cache-friendly size.");
+  opt_desc.add_options()(
+      "enable-sort-join",
+      po::value<bool>(&config_->exec.join.enable_sort_join)
+          ->default_value(config_->exec.join.enable_sort_join)
+          ->implicit_value(true),
+      "Enable/disable joins on CPU by a binary search over the sorted inner keys when "
+      "a perfect hash table for the join would be too big or too sparse.");
+  opt_desc.add_options()(
+      "enable-string-join",
+      po::value<bool>(&config_->exec.join.enable_string_join)
+          ->default_value(config_->exec.join.enable_string_join)
+          ->implicit_value(true),
+      "Enable/disable joins on none-encoded strings on CPU through sorted join tables "
+      "keyed on string hashes, instead of loop joins.");
+  opt_desc.add_options()(
+      "enable-range-join",
+      po::value<bool>(&config_->exec.join.enable_range_join)
+          ->default_value(config_->exec.join.enable_range_join)
+          ->implicit_value(true),
+      "Enable/disable joins on CPU by a binary search over the sorted inner keys for "
+      "join conditions with inequalities, e.g. BETWEEN, instead of loop joins.");
+  opt_desc.add_options()(
+      "enable-loop-join-scan",
+      po::value<bool>(&config_->exec.join.enable_loop_join_scan)
+          ->default_value(config_->exec.join.enable_loop_join_scan)
+          ->implicit_value(true),
+      "Enable/disable blocked scans of inner columns in CPU loop joins to select inner "
+      "rows matching a comparison with the outer row.");
+  opt_desc.add_options()(
+      "enable-crc32-key-hash",
+      po::value<bool>(&config_->exec.join.enable_crc32_key_hash)
+          ->default_value(config_->exec.join.enable_crc32_key_hash)
+          ->implicit_value(true),
+      "Enable/disable hashing of baseline join hash table keys on CPU with hardware "
+      "CRC32C instructions instead of MurmurHash when the CPU supports them.");
+  opt_desc.add_options()(
+      "hash-table-prefetch-threshold",
+      po::value<size_t>(&config_->exec.join.hash_table_prefetch_threshold)
+          ->default_value(config_->exec.join.hash_table_prefetch_threshold),
+      "Minimal size in bytes of a baseline join hash table to prefetch its slots while "
+      "building it on CPU. Should be about the size of the last level CPU cache.");
+  opt_desc.add_options()(
+      "enable-compact-join-keys",
+      po::value<bool>(&config_->exec.join.enable_compact_join_keys)
+          ->default_value(config_->exec.join.enable_compact_join_keys)
+          ->implicit_value(true),
+      "Enable/disable 32-bit key components in baseline join hash tables for 64-bit "
+      "inner columns whose value ranges fit into 32 bits.");
 
   // exec.group_by
   opt_desc.add_options()("bigint-count",
@@ -168,6 +308,26 @@ bool ConfigBuilder::parseCommandLineArgs(int argc,
       po::value<size_t>(&config_->exec.group_by.baseline_threshold)
           ->default_value(config_->exec.group_by.baseline_threshold),
       "Prefer baseline hash if number of entries exceeds this threshold.");
+  opt_desc.add_options()(
+      "enable-cost-based-hash-layout",
+      po::value<bool>(&config_->exec.group_by.enable_cost_based_hash_layout)
+          ->default_value(config_->exec.group_by.enable_cost_based_hash_layout)
+          ->implicit_value(true),
+      "Choose between perfect and baseline hash group by by comparing their costs "
+      "when column statistics provide the number of groups.");
+  opt_desc.add_options()(
+      "baseline-hash-row-cost",
+      po::value<double>(&config_->exec.group_by.baseline_hash_row_cost)
+          ->default_value(config_->exec.group_by.baseline_hash_row_cost),
+      "Cost of aggregating an input row with baseline hash group by relative to "
+      "perfect hash, used by the cost-based hash layout choice.");
+  opt_desc.add_options()(
+      "enable-range-based-slot-compaction",
+      po::value<bool>(&config_->exec.group_by.enable_range_based_slot_compaction)
+          ->default_value(config_->exec.group_by.enable_range_based_slot_compaction)
+          ->implicit_value(true),
+      "Use 4-byte group-by output slots for MIN and MAX aggregates over integers with "
+      "a value range fitting into 32 bits.");
   opt_desc.add_options()("large-ndv-threshold",
                          po::value<int64_t>(&config_->exec.group_by.large_ndv_threshold)
                              ->default_value(config_->exec.group_by.large_ndv_threshold),
@@ -177,6 +337,81 @@ bool ConfigBuilder::parseCommandLineArgs(int argc,
       po::value<size_t>(&config_->exec.group_by.large_ndv_multiplier)
           ->default_value(config_->exec.group_by.large_ndv_multiplier),
       "A multiplier applied to NDV estimator buffer size for large ranges.");
+  opt_desc.add_options()(
+      "enable-column-stats-ndv",
+      po::value<bool>(&config_->exec.group_by.enable_column_stats_ndv)
+          ->default_value(config_->exec.group_by.enable_column_stats_ndv)
+          ->implicit_value(true),
+      "Use column statistics collected by storage to estimate the number of groups "
+      "instead of running the NDV estimator query when possible.");
+  opt_desc.add_options()(
+      "enable-partitioned-reduction",
+      po::value<bool>(&config_->exec.group_by.enable_partitioned_reduction)
+          ->default_value(config_->exec.group_by.enable_partitioned_reduction)
+          ->implicit_value(true),
+      "Reduce perfect hash group by results in parallel by entry range partitions.");
+  opt_desc.add_options()(
+      "partitioned-reduction-threshold",
+      po::value<size_t>(&config_->exec.group_by.partitioned_reduction_threshold)
+          ->default_value(config_->exec.group_by.partitioned_reduction_threshold),
+      "Minimal number of group by entries to use partitioned reduction.");
+  opt_desc.add_options()(
+      "enable-streaming-reduction",
+      po::value<bool>(&config_->exec.group_by.enable_streaming_reduction)
+          ->default_value(config_->exec.group_by.enable_streaming_reduction)
+          ->implicit_value(true),
+      "Reduce perfect hash group by results of kernels as soon as they finish, "
+      "overlapping the reduction with the execution of other kernels.");
+  opt_desc.add_options()(
+      "enable-partitioned-aggregation",
+      po::value<bool>(&config_->exec.group_by.enable_partitioned_aggregation)
+          ->default_value(config_->exec.group_by.enable_partitioned_aggregation)
+          ->implicit_value(true),
+      "Execute high cardinality aggregations in multiple passes, each pass "
+      "aggregating a disjoint partition of groups.");
+  opt_desc.add_options()(
+      "partitioned-aggregation-max-groups",
+      po::value<size_t>(&config_->exec.group_by.partitioned_aggregation_max_groups)
+          ->default_value(config_->exec.group_by.partitioned_aggregation_max_groups),
+      "Maximum number of estimated groups aggregated in a single pass by the "
+      "partitioned aggregation.");
+  opt_desc.add_options()(
+      "enable-roaring-count-distinct",
+      po::value<bool>(&config_->exec.group_by.enable_roaring_count_distinct)
+          ->default_value(config_->exec.group_by.enable_roaring_count_distinct)
+          ->implicit_value(true),
+      "Use compressed bitmaps for exact COUNT(DISTINCT) on integer values instead of "
+      "hash sets and very big dense bitmaps.");
+  opt_desc.add_options()(
+      "roaring-count-distinct-bitmap-bits-threshold",
+      po::value<int64_t>(
+          &config_->exec.group_by.roaring_count_distinct_bitmap_bits_threshold)
+          ->default_value(
+              config_->exec.group_by.roaring_count_distinct_bitmap_bits_threshold),
+      "Size of a dense COUNT(DISTINCT) bitmap (in bits) above which a compressed "
+      "bitmap is used instead.");
+  opt_desc.add_options()(
+      "enable-sparse-hll",
+      po::value<bool>(&config_->exec.group_by.enable_sparse_hll)
+          ->default_value(config_->exec.group_by.enable_sparse_hll)
+          ->implicit_value(true),
+      "Use sparse HyperLogLog registers for APPROX_COUNT_DISTINCT in group by queries "
+      "executed on CPU.");
+  opt_desc.add_options()(
+      "gpu-groupby-buffer-max-growths",
+      po::value<size_t>(&config_->exec.group_by.gpu_groupby_buffer_max_growths)
+          ->default_value(config_->exec.group_by.gpu_groupby_buffer_max_growths),
+      "Number of times a GPU group by which ran out of output slots is re-run on GPU "
+      "with a twice bigger buffer before falling back to CPU execution. Zero disables "
+      "buffer growth.");
+  opt_desc.add_options()(
+      "enable-group-count-history",
+      po::value<bool>(&config_->exec.group_by.enable_group_count_history)
+          ->default_value(config_->exec.group_by.enable_group_count_history)
+          ->implicit_value(true),
+      "Size group-by buffers by the number of groups produced by previous executions "
+      "of the same query step over the same input sizes. Requires "
+      "use-estimator-result-cache.");
 
   // exec.window
   opt_desc.add_options()("enable-window-functions",
@@ -210,6 +445,24 @@ bool ConfigBuilder::parseCommandLineArgs(int argc,
           ->default_value(
               config_->exec.window_func.parallel_window_partition_sort_threshold),
       "Parallel window function partition sorting threshold (in rows).");
+  opt_desc.add_options()(
+      "enable-gpu-window-partition-sort",
+      po::value<bool>(&config_->exec.window_func.gpu_partition_sort)
+          ->default_value(config_->exec.window_func.gpu_partition_sort)
+          ->implicit_value(true),
+      "Sort window function partitions on GPU when it is available.");
+  opt_desc.add_options()(
+      "gpu-window-partition-sort-threshold",
+      po::value<size_t>(&config_->exec.window_func.gpu_partition_sort_threshold)
+          ->default_value(config_->exec.window_func.gpu_partition_sort_threshold),
+      "Min number of rows to sort window function partitions on GPU.");
+  opt_desc.add_options()(
+      "enable-window-partition-limits",
+      po::value<bool>(&config_->exec.window_func.enable_partition_limits)
+          ->default_value(config_->exec.window_func.enable_partition_limits)
+          ->implicit_value(true),
+      "Order only the top rows of window function partitions for ROW_NUMBER and RANK "
+      "filtered by top-N-per-group conditions.");
 
   // exec.heterogeneous
   opt_desc.add_options()(
@@ -226,6 +479,13 @@ bool ConfigBuilder::parseCommandLineArgs(int argc,
               config_->exec.heterogeneous.enable_multifrag_heterogeneous_execution)
           ->implicit_value(true),
       "Allow mutifragment heterogeneous kernels.");
+  opt_desc.add_options()(
+      "enable-heterogeneous-work-stealing",
+      po::value<bool>(&config_->exec.heterogeneous.enable_work_stealing)
+          ->default_value(config_->exec.heterogeneous.enable_work_stealing)
+          ->implicit_value(true),
+      "Let CPU and GPU pull fragments assigned to another device when they are done "
+      "with their own fragments in heterogeneous execution.");
   opt_desc.add_options()(
       "force-heterogeneous-distribution",
       po::value<bool>(&config_->exec.heterogeneous.forced_heterogeneous_distribution)
@@ -254,6 +514,13 @@ bool ConfigBuilder::parseCommandLineArgs(int argc,
           ->default_value(config_->exec.heterogeneous.allow_query_step_cpu_retry)
           ->implicit_value(true),
       "Allow certain query steps to retry on CPU, even when allow-cpu-retry is disabled");
+  opt_desc.add_options()(
+      "allow-kernel-cpu-retry",
+      po::value<bool>(&config_->exec.heterogeneous.allow_kernel_cpu_retry)
+          ->default_value(config_->exec.heterogeneous.allow_kernel_cpu_retry)
+          ->implicit_value(true),
+      "Retry only GPU kernels which ran out of memory on CPU and keep results of other "
+      "GPU kernels, instead of retrying the whole query step on CPU.");
 
   // exec.interrupt
   opt_desc.add_options()(
@@ -274,6 +541,59 @@ bool ConfigBuilder::parseCommandLineArgs(int argc,
           ->default_value(config_->exec.interrupt.running_query_interrupt_freq),
       "A frequency of checking the request of running query "
       "interrupt from user (0.0 (less frequent) ~ (more frequent) 1.0).");
+  opt_desc.add_options()(
+      "cpu-interrupt-check-interval",
+      po::value<size_t>(&config_->exec.interrupt.cpu_check_interval)
+          ->default_value(config_->exec.interrupt.cpu_check_interval),
+      "Number of rows processed by CPU kernels between runtime interrupt and dynamic "
+      "watchdog checks (rounded down to a power of two).");
+
+  // exec.scheduler
+  opt_desc.add_options()(
+      "max-concurrent-cpu-queries",
+      po::value<size_t>(&config_->exec.scheduler.max_cpu_queries)
+          ->default_value(config_->exec.scheduler.max_cpu_queries),
+      "Max number of queries executing kernels on CPU at the same time. Other queries "
+      "wait for admission. Zero means no limit.");
+  opt_desc.add_options()(
+      "max-concurrent-gpu-queries",
+      po::value<size_t>(&config_->exec.scheduler.max_gpu_queries)
+          ->default_value(config_->exec.scheduler.max_gpu_queries),
+      "Max number of queries executing kernels on a single GPU at the same time. Other "
+      "queries wait for admission. Zero means no limit.");
+  opt_desc.add_options()(
+      "scheduler-cpu-memory-budget",
+      po::value<size_t>(&config_->exec.scheduler.cpu_memory_budget)
+          ->default_value(config_->exec.scheduler.cpu_memory_budget),
+      "Max total size of output buffers (in bytes) estimated for queries concurrently "
+      "executing on CPU. Zero means no limit.");
+  opt_desc.add_options()(
+      "scheduler-gpu-memory-budget",
+      po::value<size_t>(&config_->exec.scheduler.gpu_memory_budget)
+          ->default_value(config_->exec.scheduler.gpu_memory_budget),
+      "Max total size of output buffers (in bytes) estimated for queries concurrently "
+      "executing on a single GPU. Zero means no limit.");
+  opt_desc.add_options()(
+      "enable-shared-scans",
+      po::value<bool>(&config_->exec.scheduler.enable_shared_scans)
+          ->default_value(config_->exec.scheduler.enable_shared_scans)
+          ->implicit_value(true),
+      "Make concurrent queries over the same table scan its fragments in the same "
+      "order, so fetched chunks are shared while they are hot.");
+  opt_desc.add_options()(
+      "shared-scan-window-ms",
+      po::value<size_t>(&config_->exec.scheduler.shared_scan_window_ms)
+          ->default_value(config_->exec.scheduler.shared_scan_window_ms),
+      "Time (in ms) a query waits for other queries over the same table to start a "
+      "shared scan together. Zero means no waiting.");
+  opt_desc.add_options()(
+      "enable-query-preemption",
+      po::value<bool>(&config_->exec.scheduler.enable_preemption)
+          ->default_value(config_->exec.scheduler.enable_preemption)
+          ->implicit_value(true),
+      "Let queries waiting for a device slot preempt running queries of lower priority "
+      "between kernels and sub-tasks. Preempted queries resume later from their "
+      "partial results.");
 
   // exec.codegen
   opt_desc.add_options()(
@@ -307,12 +627,111 @@ bool ConfigBuilder::parseCommandLineArgs(int argc,
           ->implicit_value(true),
       "Enable the filter function protection feature for the SQL JIT compiler. "
       "Normally should be on but techs might want to disable for troubleshooting.");
+  opt_desc.add_options()(
+      "enable-async-reduction-compilation",
+      po::value<bool>(&config_->exec.codegen.enable_async_reduction_compilation)
+          ->default_value(config_->exec.codegen.enable_async_reduction_compilation)
+          ->implicit_value(true),
+      "Compile result set reduction code in background and use the interpreter until "
+      "compiled code is available.");
+  opt_desc.add_options()(
+      "enable-tiered-compilation",
+      po::value<bool>(&config_->exec.codegen.enable_tiered_compilation)
+          ->default_value(config_->exec.codegen.enable_tiered_compilation)
+          ->implicit_value(true),
+      "Compile CPU kernels with minimal optimizations first and recompile them with "
+      "full optimizations when they are reused from the code cache.");
+  opt_desc.add_options()(
+      "tiered-compilation-hot-threshold",
+      po::value<size_t>(&config_->exec.codegen.tiered_compilation_hot_threshold)
+          ->default_value(config_->exec.codegen.tiered_compilation_hot_threshold),
+      "Number of code cache hits after which a kernel compiled with minimal "
+      "optimizations is recompiled in background with full optimizations.");
+  opt_desc.add_options()(
+      "enable-parallel-step-compilation",
+      po::value<bool>(&config_->exec.codegen.enable_parallel_step_compilation)
+          ->default_value(config_->exec.codegen.enable_parallel_step_compilation)
+          ->implicit_value(true),
+      "Compile kernels for query steps independent from results of other steps in "
+      "background while earlier steps are executed.");
+  opt_desc.add_options()(
+      "enable-loop-vectorization",
+      po::value<bool>(&config_->exec.codegen.enable_loop_vectorization)
+          ->default_value(config_->exec.codegen.enable_loop_vectorization)
+          ->implicit_value(true),
+      "Run LLVM loop and SLP vectorizers over CPU kernels compiled with full "
+      "optimizations.");
+  opt_desc.add_options()(
+      "enable-common-subexpr-elimination",
+      po::value<bool>(&config_->exec.codegen.enable_common_subexpr_elimination)
+          ->default_value(config_->exec.codegen.enable_common_subexpr_elimination)
+          ->implicit_value(true),
+      "Generate code for repeated expressions of a query step once per row.");
+  opt_desc.add_options()(
+      "enable-branchless-case",
+      po::value<bool>(&config_->exec.codegen.enable_branchless_case)
+          ->default_value(config_->exec.codegen.enable_branchless_case)
+          ->implicit_value(true),
+      "Generate CASE expressions with cheap branches without control flow.");
+  opt_desc.add_options()(
+      "enable-precompiled-regexp",
+      po::value<bool>(&config_->exec.codegen.enable_precompiled_regexp)
+          ->default_value(config_->exec.codegen.enable_precompiled_regexp)
+          ->implicit_value(true),
+      "Compile REGEXP patterns once per query instead of once per row.");
+  opt_desc.add_options()(
+      "enable-stats-null-check-elimination",
+      po::value<bool>(&config_->exec.codegen.enable_stats_null_check_elimination)
+          ->default_value(config_->exec.codegen.enable_stats_null_check_elimination)
+          ->implicit_value(true),
+      "Generate filter conditions without null checks for columns which have no nulls "
+      "according to chunk statistics.");
+  opt_desc.add_options()(
+      "enable-jit-profiling",
+      po::value<bool>(&config_->exec.codegen.enable_jit_profiling)
+          ->default_value(config_->exec.codegen.enable_jit_profiling)
+          ->implicit_value(true),
+      "Register generated CPU code with perf and VTune through LLVM JIT event "
+      "listeners. Listeners missing in the LLVM build are skipped.");
+  opt_desc.add_options()(
+      "enable-expression-counters",
+      po::value<bool>(&config_->exec.codegen.enable_expression_counters)
+          ->default_value(config_->exec.codegen.enable_expression_counters)
+          ->implicit_value(true),
+      "Count rows evaluated by each filter and target expression in generated CPU "
+      "code. Counters are reported by the hdk_expression_evaluations_total metric.");
+  opt_desc.add_options()(
+      "date-lookup-table-max-days",
+      po::value<size_t>(&config_->exec.codegen.date_lookup_table_max_days)
+          ->default_value(config_->exec.codegen.date_lookup_table_max_days),
+      "Max number of days in the value range of a date for which calendar EXTRACT and "
+      "DATE_TRUNC are computed through a lookup table built for a query. Zero "
+      "disables lookup tables.");
+  opt_desc.add_options()(
+      "lower-translation-max-dict-size",
+      po::value<size_t>(&config_->exec.codegen.lower_translation_max_dict_size)
+          ->default_value(config_->exec.codegen.lower_translation_max_dict_size),
+      "Max number of dictionary entries for which LOWER over dictionary-encoded "
+      "strings is computed for all entries when a CPU kernel is compiled. Bigger "
+      "dictionaries are processed per row.");
+  opt_desc.add_options()(
+      "enable-batch-ext-funcs",
+      po::value<bool>(&config_->exec.codegen.enable_batch_ext_funcs)
+          ->default_value(config_->exec.codegen.enable_batch_ext_funcs)
+          ->implicit_value(true),
+      "Call extension functions with a registered batch implementation once per batch "
+      "of rows in CPU kernels.");
 
   // exec
   opt_desc.add_options()("streaming-top-n-max",
                          po::value<size_t>(&config_->exec.streaming_topn_max)
                              ->default_value(config_->exec.streaming_topn_max),
                          "The maximum number of rows allowing streaming top-N sorting.");
+  opt_desc.add_options()(
+      "cpu-streaming-top-n-max",
+      po::value<size_t>(&config_->exec.cpu_streaming_topn_max)
+          ->default_value(config_->exec.cpu_streaming_topn_max),
+      "The maximum number of rows allowing streaming top-N sorting in CPU kernels.");
   opt_desc.add_options()(
       "parallel-top-min",
       po::value<size_t>(&config_->exec.parallel_top_min)
@@ -336,12 +755,19 @@ bool ConfigBuilder::parseCommandLineArgs(int argc,
       po::value<size_t>(&config_->exec.parallel_linearization_threshold)
           ->default_value(config_->exec.parallel_linearization_threshold),
       "Threshold for parallel varlen col linearization");
+  opt_desc.add_options()(
+      "enable-linearized-column-cache",
+      po::value<bool>(&config_->exec.enable_linearized_column_cache)
+          ->default_value(config_->exec.enable_linearized_column_cache)
+          ->implicit_value(true),
+      "Keep linearized multi-fragment columns in the buffer pool for reuse by "
+      "following queries.");
   opt_desc.add_options()(
       "enable-multifrag-results",
       po::value<bool>(&config_->exec.enable_multifrag_rs)
           ->default_value(config_->exec.enable_multifrag_rs)
           ->implicit_value(true),
-      "Enable multi-fragment intermediate results to improve execution parallelism for "
+      "Keep multi-fragment intermediate results to improve execution parallelism for "
       "queries with multiple execution steps");
   opt_desc.add_options()("gpu-block-size",
                          po::value<size_t>(&config_->exec.override_gpu_block_size)
@@ -361,11 +787,102 @@ bool ConfigBuilder::parseCommandLineArgs(int argc,
                              ->default_value(config_->exec.initialize_with_gpu_vendor),
                          "GPU vendor to use for Data Manager initialization. Valid "
                          "values are \"intel\" and \"nvidia\".");
+  opt_desc.add_options()(
+      "enable-gpu-transfer-overlap",
+      po::value<bool>(&config_->exec.enable_gpu_transfer_overlap)
+          ->default_value(config_->exec.enable_gpu_transfer_overlap)
+          ->implicit_value(true),
+      "Overlap fetching of GPU kernel inputs with execution of other kernels on the "
+      "same device.");
+  opt_desc.add_options()(
+      "enable-l0-sub-devices",
+      po::value<bool>(&config_->exec.enable_l0_sub_devices)
+          ->default_value(config_->exec.enable_l0_sub_devices)
+          ->implicit_value(true),
+      "Use tiles of multi-tile Intel GPUs as separate devices.");
+  opt_desc.add_options()(
+      "enable-gpu-compressed-transfer",
+      po::value<bool>(&config_->exec.enable_gpu_compressed_transfer)
+          ->default_value(config_->exec.enable_gpu_compressed_transfer)
+          ->implicit_value(true),
+      "Transfer narrow-range integer columns to GPU in a compressed "
+      "frame-of-reference encoding and decode them on the device.");
+  opt_desc.add_options()(
+      "enable-cpu-compressed-columns",
+      po::value<bool>(&config_->exec.enable_cpu_compressed_columns)
+          ->default_value(config_->exec.enable_cpu_compressed_columns)
+          ->implicit_value(true),
+      "Keep narrow-range integer columns frame-of-reference encoded in the CPU buffer "
+      "pool and decode them in CPU kernels.");
+  opt_desc.add_options()(
+      "enable-gpu-fragment-affinity",
+      po::value<bool>(&config_->exec.enable_gpu_fragment_affinity)
+          ->default_value(config_->exec.enable_gpu_fragment_affinity)
+          ->implicit_value(true),
+      "Distribute table fragments over GPUs by fragment id, so a fragment is always "
+      "processed and cached on the same device.");
+  opt_desc.add_options()(
+      "enable-gpu-launch-autotuning",
+      po::value<bool>(&config_->exec.enable_gpu_launch_autotuning)
+          ->default_value(config_->exec.enable_gpu_launch_autotuning)
+          ->implicit_value(true),
+      "Pick the grid size of non-grouped aggregate GPU kernels by timing a few "
+      "candidate sizes on first launches of the cached code.");
+  opt_desc.add_options()(
+      "enable-fragment-qual-elimination",
+      po::value<bool>(&config_->exec.enable_fragment_qual_elimination)
+          ->default_value(config_->exec.enable_fragment_qual_elimination)
+          ->implicit_value(true),
+      "Execute fragments whose chunk statistics prove some filter conditions true for "
+      "all rows with a kernel compiled without those conditions.");
 
   opt_desc.add_options()(
       "use-cost-model",
       po::value<bool>(&config_->exec.enable_cost_model)->default_value(false),
       "Use Cost Model for query execution when it is possible.");
+  opt_desc.add_options()(
+      "enable-cost-model-runtime-measurements",
+      po::value<bool>(&config_->exec.enable_cost_model_runtime_measurements)
+          ->default_value(config_->exec.enable_cost_model_runtime_measurements)
+          ->implicit_value(true),
+      "Calibrate Cost Model using execution times of query kernels instead of "
+      "micro-benchmarks.");
+  opt_desc.add_options()(
+      "cpu-threads-per-query",
+      po::value<unsigned>(&config_->exec.cpu_threads_per_query)
+          ->default_value(config_->exec.cpu_threads_per_query),
+      "Max number of CPU threads used by a single query. Limiting it keeps cores "
+      "available for concurrent queries. Zero means no limit.");
+  opt_desc.add_options()(
+      "enable-limit-early-termination",
+      po::value<bool>(&config_->exec.enable_limit_early_termination)
+          ->default_value(config_->exec.enable_limit_early_termination)
+          ->implicit_value(true),
+      "Don't execute remaining fragments of a projection with LIMIT and no ORDER BY "
+      "when preceding fragments already produced enough rows.");
+  opt_desc.add_options()("calcite-workers",
+                         po::value<size_t>(&config_->exec.calcite_workers)
+                             ->default_value(config_->exec.calcite_workers),
+                         "Number of threads parsing SQL queries in Calcite. Applied "
+                         "when Calcite is initialized for the first time.");
+  opt_desc.add_options()("enable-native-sql-parser",
+                         po::value<bool>(&config_->exec.enable_native_sql_parser)
+                             ->default_value(config_->exec.enable_native_sql_parser)
+                             ->implicit_value(true),
+                         "Parse simple single table queries natively, use Calcite "
+                         "for other queries only.");
+  opt_desc.add_options()("enable-calcite",
+                         po::value<bool>(&config_->exec.enable_calcite)
+                             ->default_value(config_->exec.enable_calcite)
+                             ->implicit_value(true),
+                         "Allow starting Calcite (and JVM) to parse SQL queries. "
+                         "Calcite is started on the first SQL query.");
+  opt_desc.add_options()("enable-query-profile",
+                         po::value<bool>(&config_->exec.enable_query_profile)
+                             ->default_value(config_->exec.enable_query_profile)
+                             ->implicit_value(true),
+                         "Collect per-step and per-kernel timings of each query and "
+                         "return them with the query result.");
 
   // opts.filter_pushdown
   opt_desc.add_options()("enable-filter-push-down",
@@ -400,6 +917,20 @@ bool ConfigBuilder::parseCommandLineArgs(int argc,
                              ->default_value(config_->opts.from_table_reordering)
                              ->implicit_value(true),
                          "Enable automatic table reordering in FROM clause.");
+  opt_desc.add_options()(
+      "enable-join-selectivity-reordering",
+      po::value<bool>(&config_->opts.enable_join_selectivity_reordering)
+          ->default_value(config_->opts.enable_join_selectivity_reordering)
+          ->implicit_value(true),
+      "Use join key ranges from the fragment metadata to schedule joins which filter "
+      "out more rows earlier when reordering tables in FROM clause.");
+  opt_desc.add_options()(
+      "enable-filter-reordering",
+      po::value<bool>(&config_->opts.enable_filter_reordering)
+          ->default_value(config_->opts.enable_filter_reordering)
+          ->implicit_value(true),
+      "Evaluate expensive filter conditions in the order of estimated cost and "
+      "selectivity, skipping them for rows filtered out by cheaper conditions.");
   opt_desc.add_options()("constrained-by-in-threshold",
                          po::value<size_t>(&config_->opts.constrained_by_in_threshold)
                              ->default_value(config_->opts.constrained_by_in_threshold),
@@ -410,6 +941,20 @@ bool ConfigBuilder::parseCommandLineArgs(int argc,
           ->default_value(config_->opts.enable_left_join_filter_hoisting)
           ->implicit_value(true),
       "Enable hoisting left hand side filters through left joins.");
+  opt_desc.add_options()(
+      "skip-fragments-by-join-key-range",
+      po::value<bool>(&config_->opts.skip_fragments_by_join_key_range)
+          ->default_value(config_->opts.skip_fragments_by_join_key_range)
+          ->implicit_value(true),
+      "Skip outer table fragments with no keys in the inner table key range for "
+      "inner equi-joins.");
+  opt_desc.add_options()(
+      "skip-fragments-by-dict-string-stats",
+      po::value<bool>(&config_->opts.skip_fragments_by_dict_string_stats)
+          ->default_value(config_->opts.skip_fragments_by_dict_string_stats)
+          ->implicit_value(true),
+      "Skip fragments using dictionary id stats of string columns for string equality "
+      "and LIKE filters.");
 
   // rs
   opt_desc.add_options()("enable-columnar-output",
@@ -417,22 +962,82 @@ bool ConfigBuilder::parseCommandLineArgs(int argc,
                              ->default_value(config_->rs.enable_columnar_output)
                              ->implicit_value(true),
                          "Enable columnar output for intermediate/final query steps.");
+  opt_desc.add_options()(
+      "enable-columnar-intermediate-results",
+      po::value<bool>(&config_->rs.enable_columnar_intermediate_results)
+          ->default_value(config_->rs.enable_columnar_intermediate_results)
+          ->implicit_value(true),
+      "Enable columnar output for projections consumed by following query steps to "
+      "allow zero-copy fetch of their results.");
   opt_desc.add_options()("optimize-row-init",
                          po::value<bool>(&config_->rs.optimize_row_initialization)
                              ->default_value(config_->rs.optimize_row_initialization)
                              ->implicit_value(true),
                          "Optimize row initialization.");
+  opt_desc.add_options()("enable-lazy-group-init",
+                         po::value<bool>(&config_->rs.enable_lazy_group_init)
+                             ->default_value(config_->rs.enable_lazy_group_init)
+                             ->implicit_value(true),
+                         "Initialize rows of large perfect hash group by buffers on "
+                         "the first touch.");
+  opt_desc.add_options()(
+      "lazy-group-init-threshold",
+      po::value<size_t>(&config_->rs.lazy_group_init_threshold)
+          ->default_value(config_->rs.lazy_group_init_threshold),
+      "Min number of entries in a perfect hash group by buffer to initialize its rows "
+      "on the first touch.");
   opt_desc.add_options()("enable-direct-columnarization",
                          po::value<bool>(&config_->rs.enable_direct_columnarization)
                              ->default_value(config_->rs.enable_direct_columnarization)
                              ->implicit_value(true),
                          "Enables/disables a more optimized columnarization method "
                          "for intermediate steps in multi-step queries.");
+  opt_desc.add_options()(
+      "enable-lazy-columnarization",
+      po::value<bool>(&config_->rs.enable_lazy_columnarization)
+          ->default_value(config_->rs.enable_lazy_columnarization)
+          ->implicit_value(true),
+      "Columnarize intermediate results column by column on demand instead of "
+      "converting all columns on the first fetch.");
   opt_desc.add_options()("enable-lazy-fetch",
                          po::value<bool>(&config_->rs.enable_lazy_fetch)
                              ->default_value(config_->rs.enable_lazy_fetch)
                              ->implicit_value(true),
                          "Enable lazy fetch columns in query results.");
+  opt_desc.add_options()("enable-radix-sort",
+                         po::value<bool>(&config_->rs.enable_radix_sort)
+                             ->default_value(config_->rs.enable_radix_sort)
+                             ->implicit_value(true),
+                         "Use radix sort for ORDER BY on integer, date/time and "
+                         "dictionary-encoded string keys.");
+  opt_desc.add_options()(
+      "external-sort-threshold",
+      po::value<size_t>(&config_->rs.external_sort_threshold)
+          ->default_value(config_->rs.external_sort_threshold),
+      "Max working memory in bytes of a radix sort of results. Larger sorts spill "
+      "sorted runs to local storage and merge them. Zero means no limit.");
+  opt_desc.add_options()("external-sort-dir",
+                         po::value<std::string>(&config_->rs.external_sort_dir)
+                             ->default_value(config_->rs.external_sort_dir),
+                         "Directory for sorted runs spilled by external sort. The "
+                         "system temporary directory is used by default.");
+  opt_desc.add_options()("keep-gpu-results",
+                         po::value<bool>(&config_->rs.keep_gpu_results)
+                             ->default_value(config_->rs.keep_gpu_results)
+                             ->implicit_value(true),
+                         "Keep columnar projection results of GPU queries in device "
+                         "memory for export to GPU libraries.");
+  opt_desc.add_options()(
+      "registry-memory-limit",
+      po::value<size_t>(&config_->rs.registry_memory_limit)
+          ->default_value(config_->rs.registry_memory_limit),
+      "Max memory in bytes of results held by the result set registry. Least recently "
+      "used results are spilled to local storage. Zero means no limit.");
+  opt_desc.add_options()("registry-spill-dir",
+                         po::value<std::string>(&config_->rs.registry_spill_dir)
+                             ->default_value(config_->rs.registry_spill_dir),
+                         "Directory for results spilled by the result set registry. "
+                         "The system temporary directory is used by default.");
 
   // mem.cpu
   opt_desc.add_options()("enable-tiered-cpu-mem",
@@ -440,10 +1045,47 @@ bool ConfigBuilder::parseCommandLineArgs(int argc,
                              ->default_value(config_->mem.cpu.enable_tiered_cpu_mem)
                              ->implicit_value(true),
                          "Enable additional tiers of CPU memory (PMEM, etc...)");
+  opt_desc.add_options()(
+      "enable-numa-aware-slabs",
+      po::value<bool>(&config_->mem.cpu.enable_numa_aware_slabs)
+          ->default_value(config_->mem.cpu.enable_numa_aware_slabs)
+          ->implicit_value(true),
+      "Bind CPU buffer pool slabs to NUMA nodes in a round-robin fashion to balance "
+      "memory traffic between sockets.");
+  opt_desc.add_options()(
+      "cpu-pinned-slabs-size",
+      po::value<size_t>(&config_->mem.cpu.pinned_slabs_size)
+          ->default_value(config_->mem.cpu.pinned_slabs_size),
+      "An amount of CPU buffer pool memory to allocate as pinned (page-locked) "
+      "memory for faster GPU transfers. Ignored if GPU is not used.");
+  opt_desc.add_options()(
+      "enable-cpu-huge-pages",
+      po::value<bool>(&config_->mem.cpu.enable_huge_pages)
+          ->default_value(config_->mem.cpu.enable_huge_pages)
+          ->implicit_value(true),
+      "Back CPU buffer pool slabs with transparent huge pages to reduce TLB misses "
+      "on scans.");
+  opt_desc.add_options()("cpu-prefault-size",
+                         po::value<size_t>(&config_->mem.cpu.prefault_size)
+                             ->default_value(config_->mem.cpu.prefault_size),
+                         "An amount of CPU buffer pool memory to allocate and "
+                         "pre-fault at startup.");
   opt_desc.add_options()("pmem-size",
                          po::value<size_t>(&config_->mem.cpu.pmem_size)
                              ->default_value(config_->mem.cpu.pmem_size),
                          "An amount of PMEM memory to use.");
+  opt_desc.add_options()(
+      "tier-migration-interval-ms",
+      po::value<size_t>(&config_->mem.cpu.tier_migration_interval_ms)
+          ->default_value(config_->mem.cpu.tier_migration_interval_ms),
+      "Period of the background promotion of frequently accessed chunks from PMEM to "
+      "DRAM in tiered CPU memory. Zero disables migration.");
+  opt_desc.add_options()(
+      "tier-migration-max-bytes",
+      po::value<size_t>(&config_->mem.cpu.tier_migration_max_bytes)
+          ->default_value(config_->mem.cpu.tier_migration_max_bytes),
+      "Maximum amount of data moved between CPU memory tiers in a single migration "
+      "round.");
   opt_desc.add_options()("cpu-buffer-mem-bytes",
                          po::value<size_t>(&config_->mem.cpu.max_size)
                              ->default_value(config_->mem.cpu.max_size),
@@ -511,6 +1153,33 @@ bool ConfigBuilder::parseCommandLineArgs(int argc,
       "there is not enough free memory to accomodate the target slab size, smaller "
       "slabs will be allocated, down to the minimum size speified by "
       "min-gpu-slab-size.");
+  opt_desc.add_options()(
+      "enable-gpu-cost-aware-eviction",
+      po::value<bool>(&config_->mem.gpu.enable_cost_aware_eviction)
+          ->default_value(config_->mem.gpu.enable_cost_aware_eviction)
+          ->implicit_value(true),
+      "Evict GPU buffers by access frequency and transfer cost instead of recency.");
+  opt_desc.add_options()(
+      "gpu-resident-tables",
+      po::value<std::string>(&config_->mem.gpu.resident_tables)
+          ->default_value(config_->mem.gpu.resident_tables),
+      "Comma-separated names of tables to keep in GPU memory. Buffers of these tables "
+      "are evicted only if there is no other choice. Requires "
+      "enable-gpu-cost-aware-eviction.");
+  opt_desc.add_options()(
+      "enable-gpu-unified-memory-zero-copy",
+      po::value<bool>(&config_->mem.gpu.enable_unified_memory_zero_copy)
+          ->default_value(config_->mem.gpu.enable_unified_memory_zero_copy)
+          ->implicit_value(true),
+      "Read input buffers directly from host memory on GPUs sharing physical memory "
+      "with the host (integrated GPUs, Grace Hopper) instead of copying them.");
+  opt_desc.add_options()(
+      "gpu-thrust-scratch-pool-size",
+      po::value<size_t>(&config_->mem.gpu.thrust_scratch_pool_size)
+          ->default_value(config_->mem.gpu.thrust_scratch_pool_size),
+      "Amount of GPU memory per device kept for reuse by GPU sorts after they "
+      "complete. Cached buffers are dropped when a sort runs out of GPU memory or GPU "
+      "memory is cleared. Zero disables caching.");
 
   // cache
   opt_desc.add_options()("use-estimator-result-cache",
@@ -537,12 +1206,52 @@ bool ConfigBuilder::parseCommandLineArgs(int argc,
       po::value<size_t>(&config_->cache.max_cacheable_hashtable_size_bytes)
           ->default_value(config_->cache.max_cacheable_hashtable_size_bytes),
       "The maximum size of hashtable that is available to cache, in bytes");
+  opt_desc.add_options()("use-result-set-cache",
+                         po::value<bool>(&config_->cache.use_result_set_cache)
+                             ->default_value(config_->cache.use_result_set_cache)
+                             ->implicit_value(true),
+                         "Reuse results of query steps with the same plan DAG while "
+                         "their input tables are not modified.");
+  opt_desc.add_options()(
+      "use-incremental-result-set-cache",
+      po::value<bool>(&config_->cache.use_incremental_result_set_cache)
+          ->default_value(config_->cache.use_incremental_result_set_cache)
+          ->implicit_value(true),
+      "Update cached group-by results by aggregating only fragments appended to their "
+      "input table.");
+  opt_desc.add_options()("reuse-node-results",
+                         po::value<bool>(&config_->cache.reuse_node_results)
+                             ->default_value(config_->cache.reuse_node_results)
+                             ->implicit_value(true),
+                         "Reuse results of query nodes computed by previous queries "
+                         "while their input tables are not modified.");
+  opt_desc.add_options()("reuse-col-ranges",
+                         po::value<bool>(&config_->cache.reuse_col_ranges)
+                             ->default_value(config_->cache.reuse_col_ranges)
+                             ->implicit_value(true),
+                         "Reuse column ranges computed by previous queries and update "
+                         "them incrementally on appends.");
+  opt_desc.add_options()("result-set-cache-total-bytes",
+                         po::value<size_t>(&config_->cache.result_set_cache_total_bytes)
+                             ->default_value(config_->cache.result_set_cache_total_bytes),
+                         "Size of total memory space for result set cache, in bytes.");
+  opt_desc.add_options()(
+      "max-cacheable-result-set-size-bytes",
+      po::value<size_t>(&config_->cache.max_cacheable_result_set_size_bytes)
+          ->default_value(config_->cache.max_cacheable_result_set_size_bytes),
+      "The maximum size of result set that is available to cache, in bytes");
   opt_desc.add_options()(
       "gpu-code-cache-eviction-percent",
       po::value<double>(&config_->cache.gpu_fraction_code_cache_to_evict)
           ->default_value(config_->cache.gpu_fraction_code_cache_to_evict),
       "Percentage of the GPU code cache to evict if an out of memory error is "
       "encountered while attempting to place generated code on the GPU.");
+  opt_desc.add_options()(
+      "gpu-code-cache-max-bytes",
+      po::value<size_t>(&config_->cache.gpu_code_cache_max_bytes)
+          ->default_value(config_->cache.gpu_code_cache_max_bytes),
+      "Maximum size of device code kept in the GPU code cache per device, in bytes. "
+      "Zero means only the number of entries is limited.");
   opt_desc.add_options()("dag-cache-size",
                          po::value<size_t>(&config_->cache.dag_cache_size)
                              ->default_value(config_->cache.dag_cache_size),
@@ -551,6 +1260,28 @@ bool ConfigBuilder::parseCommandLineArgs(int argc,
                          po::value<size_t>(&config_->cache.code_cache_size)
                              ->default_value(config_->cache.code_cache_size),
                          "Maximum number of entries in a code cache");
+  opt_desc.add_options()("enable-rel-alg-cache",
+                         po::value<bool>(&config_->cache.enable_rel_alg_cache)
+                             ->default_value(config_->cache.enable_rel_alg_cache)
+                             ->implicit_value(true),
+                         "Reuse Calcite output for repeated SQL queries until the "
+                         "schema changes.");
+  opt_desc.add_options()("rel-alg-cache-size",
+                         po::value<size_t>(&config_->cache.rel_alg_cache_size)
+                             ->default_value(config_->cache.rel_alg_cache_size),
+                         "Maximum number of entries in a RelAlg cache");
+  opt_desc.add_options()(
+      "persistent-code-cache-dir",
+      po::value<std::string>(&config_->cache.persistent_code_cache_dir)
+          ->default_value(config_->cache.persistent_code_cache_dir),
+      "Directory to store compiled CPU code and L0 device binaries across process "
+      "restarts. Persistent code cache is disabled if empty.");
+  opt_desc.add_options()(
+      "cost-model-calibration-file",
+      po::value<std::string>(&config_->cache.cost_model_calibration_file)
+          ->default_value(config_->cache.cost_model_calibration_file),
+      "File to store Cost Model calibration across process restarts. Stored "
+      "calibration is invalidated when hardware changes. Not stored if empty.");
 
   // debug
   opt_desc.add_options()("build-rel-alg-cache",
@@ -563,6 +1294,13 @@ bool ConfigBuilder::parseCommandLineArgs(int argc,
                              ->default_value(config_->debug.use_ra_cache),
                          "Used in tests to load pre-generated cache of parsed SQL "
                          "queries from the specified file to avoid Calcite usage.");
+  opt_desc.add_options()(
+      "workload-capture-file",
+      po::value<std::string>(&config_->debug.workload_capture_file)
+          ->default_value(config_->debug.workload_capture_file),
+      "Used in tests and benchmarks to record executed SQL queries with their "
+      "start times, issuing threads and phase timings to the specified file. The "
+      "file can be replayed with the workload_replay tool.");
   opt_desc.add_options()("enable-automatic-ir-metadata",
                          po::value<bool>(&config_->debug.enable_automatic_ir_metadata)
                              ->default_value(config_->debug.enable_automatic_ir_metadata)
@@ -591,6 +1329,10 @@ bool ConfigBuilder::parseCommandLineArgs(int argc,
     return true;
   }
 
+  if (config_->enable_auto_config) {
+    apply_auto_config(*config_, HardwareInfo::detect(), vm);
+  }
+
   return false;
 }
 
@@ -0,0 +1,114 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "HardwareInfo.h"
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+namespace {
+
+#ifdef __linux__
+
+// Parses cache sizes from sysfs, e.g. "1024K".
+size_t read_sysfs_size(const std::filesystem::path& path) {
+  std::ifstream f(path);
+  size_t val = 0;
+  std::string suffix;
+  if (!(f >> val)) {
+    return 0;
+  }
+  f >> suffix;
+  if (suffix == "K") {
+    val <<= 10;
+  } else if (suffix == "M") {
+    val <<= 20;
+  }
+  return val;
+}
+
+size_t sysfs_cache_size(const int level) {
+  std::error_code ec;
+  const std::filesystem::path cache_dir("/sys/devices/system/cpu/cpu0/cache");
+  for (const auto& entry : std::filesystem::directory_iterator(cache_dir, ec)) {
+    std::ifstream level_file(entry.path() / "level");
+    std::ifstream type_file(entry.path() / "type");
+    int cache_level = 0;
+    std::string type;
+    if (level_file >> cache_level && type_file >> type && cache_level == level &&
+        type != "Instruction") {
+      return read_sysfs_size(entry.path() / "size");
+    }
+  }
+  return 0;
+}
+
+size_t cache_size(const int level, const int sysconf_name) {
+  const auto size = sysconf(sysconf_name);
+  return size > 0 ? static_cast<size_t>(size) : sysfs_cache_size(level);
+}
+
+size_t numa_node_count() {
+  std::error_code ec;
+  size_t count = 0;
+  for (const auto& entry :
+       std::filesystem::directory_iterator("/sys/devices/system/node", ec)) {
+    const auto name = entry.path().filename().string();
+    if (name.rfind("node", 0) == 0 && name.size() > 4 &&
+        std::isdigit(static_cast<unsigned char>(name[4]))) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+#endif
+
+}  // namespace
+
+HardwareInfo HardwareInfo::detect() {
+  HardwareInfo info;
+  info.cpu_cores = std::max(std::thread::hardware_concurrency(), 1U);
+#ifdef __linux__
+  if (const auto l2 = cache_size(2, _SC_LEVEL2_CACHE_SIZE)) {
+    info.l2_cache_size = l2;
+  }
+  info.l3_cache_size = cache_size(3, _SC_LEVEL3_CACHE_SIZE);
+  if (const auto nodes = numa_node_count()) {
+    info.numa_nodes = nodes;
+  }
+  const auto pages = sysconf(_SC_PHYS_PAGES);
+  const auto page_size = sysconf(_SC_PAGE_SIZE);
+  if (pages > 0 && page_size > 0) {
+    info.total_memory = static_cast<size_t>(pages) * static_cast<size_t>(page_size);
+  }
+#endif
+  return info;
+}
+
+std::string HardwareInfo::toString() const {
+  std::stringstream ss;
+  ss << "HardwareInfo(cpu_cores=" << cpu_cores << ", numa_nodes=" << numa_nodes
+     << ", l2_cache_size=" << l2_cache_size << ", l3_cache_size=" << l3_cache_size
+     << ", total_memory=" << total_memory << ")";
+  return ss.str();
+}
@@ -0,0 +1,38 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file    HardwareInfo.h
+ * @brief   Host hardware properties used to derive default configuration values.
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+struct HardwareInfo {
+  size_t cpu_cores = 1;
+  size_t numa_nodes = 1;
+  // Per-core L2 and shared L3 cache sizes in bytes.
+  size_t l2_cache_size = 1ULL << 20;
+  size_t l3_cache_size = 0;
+  size_t total_memory = 0;
+
+  // Probes the host. Properties which cannot be detected keep their defaults.
+  static HardwareInfo detect();
+
+  std::string toString() const;
+};
@@ -45,7 +45,7 @@ std::string errorMessage(CUresult const status) {
              : "CUDA Driver API error code " + std::to_string(status);
 }
 
-CudaMgr::CudaMgr(const int num_gpus, const int start_gpu)
+CudaMgr::CudaMgr(const int num_gpus, const int start_gpu, const bool use_transfer_streams)
     : start_gpu_(start_gpu)
     , min_shared_memory_per_block_for_all_devices(0)
     , min_num_mps_for_all_devices(0) {
@@ -61,6 +61,9 @@ CudaMgr::CudaMgr(const int num_gpus, const int start_gpu)
   fillDeviceProperties();
   initDeviceGroup();
   createDeviceContexts();
+  if (use_transfer_streams) {
+    createTransferStreams();
+  }
   printDeviceProperties();
 }
 
@@ -78,6 +81,10 @@ CudaMgr::~CudaMgr() {
     std::lock_guard<std::mutex> gpu_lock(device_cleanup_mutex_);
 
     synchronizeDevices();
+    for (size_t d = 0; d < transfer_streams_.size(); ++d) {
+      setContext(d);
+      checkError(cuStreamDestroy(transfer_streams_[d]));
+    }
     for (int d = 0; d < device_count_; ++d) {
       checkError(cuCtxDestroy(device_contexts_[d]));
     }
@@ -104,6 +111,15 @@ void CudaMgr::copyHostToDevice(int8_t* device_ptr,
                                const size_t num_bytes,
                                const int device_num) {
   setContext(device_num);
+  if (!transfer_streams_.empty()) {
+    // The transfer stream doesn't synchronize with the default stream, so the copy
+    // can overlap with a kernel running on the device.
+    auto stream = transfer_streams_[device_num];
+    checkError(cuMemcpyHtoDAsync(
+        reinterpret_cast<CUdeviceptr>(device_ptr), host_ptr, num_bytes, stream));
+    checkError(cuStreamSynchronize(stream));
+    return;
+  }
   checkError(
       cuMemcpyHtoD(reinterpret_cast<CUdeviceptr>(device_ptr), host_ptr, num_bytes));
 }
@@ -227,6 +243,16 @@ void CudaMgr::fillDeviceProperties() {
     checkError(cuDeviceGetAttribute(&device_properties_[device_num].memoryBusWidth,
                                     CU_DEVICE_ATTRIBUTE_GLOBAL_MEMORY_BUS_WIDTH,
                                     device_properties_[device_num].device));
+    checkError(cuDeviceGetAttribute(&device_properties_[device_num].integrated,
+                                    CU_DEVICE_ATTRIBUTE_INTEGRATED,
+                                    device_properties_[device_num].device));
+    checkError(cuDeviceGetAttribute(&device_properties_[device_num].pageableMemoryAccess,
+                                    CU_DEVICE_ATTRIBUTE_PAGEABLE_MEMORY_ACCESS,
+                                    device_properties_[device_num].device));
+    checkError(cuDeviceGetAttribute(
+        &device_properties_[device_num].pageableMemoryAccessUsesHostPageTables,
+        CU_DEVICE_ATTRIBUTE_PAGEABLE_MEMORY_ACCESS_USES_HOST_PAGE_TABLES,
+        device_properties_[device_num].device));
     device_properties_[device_num].memoryBandwidthGBs =
         device_properties_[device_num].memoryClockKhz / 1000000.0 / 8.0 *
         device_properties_[device_num].memoryBusWidth;
@@ -300,6 +326,23 @@ bool CudaMgr::isArchVoltaOrGreaterForAll() const {
   return true;
 }
 
+/**
+ * Returns true if all devices can access pageable host memory and do it without
+ * going through a PCIe bus, i.e. devices are integrated or use host page tables
+ * (e.g. Grace Hopper). Discrete GPUs with HMM support also report pageable memory
+ * access but are excluded, because reading host memory from kernels is slow there.
+ */
+bool CudaMgr::hasUnifiedMemory() const {
+  for (int i = 0; i < device_count_; i++) {
+    const auto& props = device_properties_[i];
+    if (!props.pageableMemoryAccess ||
+        !(props.integrated || props.pageableMemoryAccessUsesHostPageTables)) {
+      return false;
+    }
+  }
+  return device_count_ > 0;
+}
+
 /**
  * This function returns the minimum available dynamic shared memory that is available per
  * block for all GPU devices.
@@ -352,6 +395,15 @@ void CudaMgr::createDeviceContexts() {
   }
 }
 
+void CudaMgr::createTransferStreams() {
+  CHECK(transfer_streams_.empty());
+  transfer_streams_.resize(device_count_);
+  for (int d = 0; d < device_count_; ++d) {
+    setContext(d);
+    checkError(cuStreamCreate(&transfer_streams_[d], CU_STREAM_NON_BLOCKING));
+  }
+}
+
 void CudaMgr::setContext(const int device_num) const {
   // deviceNum is the device number relative to startGpu (realDeviceNum - startGpu_)
   CHECK_LT(device_num, device_count_);
@@ -78,11 +78,18 @@ struct DeviceProperties {
   float memoryBandwidthGBs;
   int clockKhz;
   int numCore;
+  int integrated;
+  int pageableMemoryAccess;
+  int pageableMemoryAccessUsesHostPageTables;
 };
 
 class CudaMgr : public GpuMgr {
  public:
-  CudaMgr(const int num_gpus, const int start_gpu = 0);
+  // If use_transfer_streams is set, host-to-device copies are executed on
+  // dedicated streams and don't wait for kernels running on the device.
+  CudaMgr(const int num_gpus,
+          const int start_gpu = 0,
+          const bool use_transfer_streams = false);
   ~CudaMgr();
 
   void synchronizeDevices() const override;
@@ -105,9 +112,9 @@ class CudaMgr : public GpuMgr {
                           const int dest_device_num,
                           const int src_device_num) override;
 
-  int8_t* allocatePinnedHostMem(const size_t num_bytes);
+  int8_t* allocatePinnedHostMem(const size_t num_bytes) override;
   int8_t* allocateDeviceMem(const size_t num_bytes, const int device_num) override;
-  void freePinnedHostMem(int8_t* host_ptr);
+  void freePinnedHostMem(int8_t* host_ptr) override;
   void freeDeviceMem(int8_t* device_ptr) override;
   void zeroDeviceMem(int8_t* device_ptr,
                      const size_t num_bytes,
@@ -150,6 +157,7 @@ class CudaMgr : public GpuMgr {
   }
   bool isArchMaxwellOrLaterForAll() const;
   bool isArchVoltaOrGreaterForAll() const;
+  bool hasUnifiedMemory() const override;
 
   uint32_t getMaxBlockSize() const override {
     return getAllDeviceProperties().front().maxThreadsPerBlock;
@@ -261,6 +269,7 @@ class CudaMgr : public GpuMgr {
   void fillDeviceProperties();
   void initDeviceGroup();
   void createDeviceContexts();
+  void createTransferStreams();
   size_t computeMinSharedMemoryPerBlockForAllDevices() const;
   size_t computeMinNumMPsForAllDevices() const;
   void checkError(CUresult cu_result) const;
@@ -275,6 +284,8 @@ class CudaMgr : public GpuMgr {
   std::vector<DeviceProperties> device_properties_;
   omnisci::DeviceGroup device_group_;
   std::vector<CUcontext> device_contexts_;
+  // Non-blocking streams used for host-to-device copies, empty if disabled.
+  std::vector<CUstream> transfer_streams_;
 
   mutable std::mutex device_cleanup_mutex_;
 };
@@ -19,7 +19,7 @@
 
 namespace CudaMgr_Namespace {
 
-CudaMgr::CudaMgr(const int, const int) : device_count_(-1), start_gpu_(-1) {
+CudaMgr::CudaMgr(const int, const int, const bool) : device_count_(-1), start_gpu_(-1) {
   CHECK(false);
 }
 
@@ -83,6 +83,10 @@ bool CudaMgr::isArchVoltaOrGreaterForAll() const {
   CHECK(false);
   return false;
 }
+bool CudaMgr::hasUnifiedMemory() const {
+  CHECK(false);
+  return false;
+}
 
 void CudaMgr::setContext(const int) const {
   CHECK(false);
@@ -19,6 +19,8 @@
 #include "Logger/Logger.h"
 #include "Shared/types.h"
 
+#include <algorithm>
+
 GpuAllocator::GpuAllocator(BufferProvider* buffer_provider, const int device_id)
     : buffer_provider_(buffer_provider), device_id_(device_id) {
   CHECK(buffer_provider_);
@@ -32,6 +34,9 @@ GpuAllocator::GpuAllocator(BufferProvider* buffer_provider, const int device_id)
 GpuAllocator::~GpuAllocator() {
   CHECK(buffer_provider_);
   for (auto& buffer_ptr : owned_buffers_) {
+    if (memory_tracker_) {
+      memory_tracker_->freed(Data_Namespace::GPU_LEVEL, buffer_ptr->reservedSize());
+    }
     buffer_provider_->free(buffer_ptr);
   }
 }
@@ -50,9 +55,28 @@ int8_t* GpuAllocator::alloc(const size_t num_bytes) {
   CHECK(buffer_provider_);
   owned_buffers_.emplace_back(
       GpuAllocator::allocGpuAbstractBuffer(buffer_provider_, num_bytes, device_id_));
+  if (memory_tracker_) {
+    memory_tracker_->allocated(Data_Namespace::GPU_LEVEL,
+                               owned_buffers_.back()->reservedSize());
+  }
   return owned_buffers_.back()->getMemoryPtr();
 }
 
+Data_Namespace::AbstractBuffer* GpuAllocator::releaseBuffer(const int8_t* device_ptr) {
+  auto it = std::find_if(
+      owned_buffers_.begin(), owned_buffers_.end(), [device_ptr](const auto buffer) {
+        return device_ptr >= buffer->getMemoryPtr() &&
+               device_ptr < buffer->getMemoryPtr() + buffer->reservedSize();
+      });
+  CHECK(it != owned_buffers_.end());
+  auto buffer = *it;
+  owned_buffers_.erase(it);
+  if (memory_tracker_) {
+    memory_tracker_->freed(Data_Namespace::GPU_LEVEL, buffer->reservedSize());
+  }
+  return buffer;
+}
+
 void GpuAllocator::free(Data_Namespace::AbstractBuffer* ab) const {
   buffer_provider_->free(ab);
 }
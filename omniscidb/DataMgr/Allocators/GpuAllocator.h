@@ -27,6 +27,9 @@
 
 #include "BufferProvider/BufferProvider.h"
 #include "DataMgr/Allocators/DeviceAllocator.h"
+#include "DataMgr/MemoryAccounting.h"
+
+#include <memory>
 
 class GpuAllocator : public DeviceAllocator {
  public:
@@ -57,8 +60,18 @@ class GpuAllocator : public DeviceAllocator {
                     unsigned char uc,
                     const size_t num_bytes) const override;
 
+  // Stop owning the buffer holding the device pointer and return it. The caller is
+  // responsible for freeing the buffer.
+  Data_Namespace::AbstractBuffer* releaseBuffer(const int8_t* device_ptr);
+
+  // Account owned buffers to the query.
+  void setMemoryTracker(std::shared_ptr<Data_Namespace::QueryMemoryTracker> tracker) {
+    memory_tracker_ = std::move(tracker);
+  }
+
  private:
   std::vector<Data_Namespace::AbstractBuffer*> owned_buffers_;
+  std::shared_ptr<Data_Namespace::QueryMemoryTracker> memory_tracker_;
 
   BufferProvider* buffer_provider_;
   int device_id_;
@@ -22,6 +22,7 @@
 
 #include "CudaMgr/CudaMgr.h"
 #include "DataMgr/Allocators/GpuAllocator.h"
+#include "DataMgr/Allocators/ThrustScratchPool.h"
 #include "DataMgr/DataMgr.h"
 #include "Logger/Logger.h"
 #include "Shared/boost_stacktrace.hpp"
@@ -36,13 +37,8 @@ int8_t* ThrustAllocator::allocate(std::ptrdiff_t num_bytes) {
     CHECK_EQ(CUDA_SUCCESS, err);
     return reinterpret_cast<int8_t*>(ptr);
   }
-  Data_Namespace::AbstractBuffer* ab =
-      GpuAllocator::allocGpuAbstractBuffer(buffer_provider_, num_bytes, device_id_);
-#else
-  Data_Namespace::AbstractBuffer* ab =
-      buffer_provider_->alloc(MemoryLevel::CPU_LEVEL, device_id_, num_bytes);
-  CHECK_EQ(ab->getPinCount(), 1);
 #endif  // HAVE_CUDA
+  Data_Namespace::AbstractBuffer* ab = allocBuffer(num_bytes);
   int8_t* raw_ptr = reinterpret_cast<int8_t*>(ab->getMemoryPtr());
   CHECK(!raw_to_ab_ptr_.count(raw_ptr));
   raw_to_ab_ptr_.insert(std::make_pair(raw_ptr, ab));
@@ -59,7 +55,7 @@ void ThrustAllocator::deallocate(int8_t* ptr, size_t num_bytes) {
 #endif  // HAVE_CUDA
   PtrMapperType::iterator ab_it = raw_to_ab_ptr_.find(ptr);
   CHECK(ab_it != raw_to_ab_ptr_.end());
-  buffer_provider_->free(ab_it->second);
+  freeBuffer(ab_it->second);
   raw_to_ab_ptr_.erase(ab_it);
 }
 
@@ -72,20 +68,39 @@ int8_t* ThrustAllocator::allocateScopedBuffer(std::ptrdiff_t num_bytes) {
     default_alloc_scoped_buffers_.push_back(reinterpret_cast<int8_t*>(ptr));
     return reinterpret_cast<int8_t*>(ptr);
   }
-  Data_Namespace::AbstractBuffer* ab =
-      GpuAllocator::allocGpuAbstractBuffer(buffer_provider_, num_bytes, device_id_);
+#endif  // HAVE_CUDA
+  Data_Namespace::AbstractBuffer* ab = allocBuffer(num_bytes);
+  scoped_buffers_.push_back(ab);
+  return reinterpret_cast<int8_t*>(ab->getMemoryPtr());
+}
+
+Data_Namespace::AbstractBuffer* ThrustAllocator::allocBuffer(const size_t num_bytes) {
+#ifdef HAVE_CUDA
+  if (auto scratch_pool = buffer_provider_->getThrustScratchPool()) {
+    return scratch_pool->acquire(device_id_, num_bytes);
+  }
+  return GpuAllocator::allocGpuAbstractBuffer(buffer_provider_, num_bytes, device_id_);
 #else
   Data_Namespace::AbstractBuffer* ab =
       buffer_provider_->alloc(MemoryLevel::CPU_LEVEL, device_id_, num_bytes);
   CHECK_EQ(ab->getPinCount(), 1);
+  return ab;
 #endif  // HAVE_CUDA
-  scoped_buffers_.push_back(ab);
-  return reinterpret_cast<int8_t*>(ab->getMemoryPtr());
+}
+
+void ThrustAllocator::freeBuffer(Data_Namespace::AbstractBuffer* ab) {
+#ifdef HAVE_CUDA
+  if (auto scratch_pool = buffer_provider_->getThrustScratchPool()) {
+    scratch_pool->release(ab);
+    return;
+  }
+#endif  // HAVE_CUDA
+  buffer_provider_->free(ab);
 }
 
 ThrustAllocator::~ThrustAllocator() {
   for (auto ab : scoped_buffers_) {
-    buffer_provider_->free(ab);
+    freeBuffer(ab);
   }
 #ifdef HAVE_CUDA
   for (auto ptr : default_alloc_scoped_buffers_) {
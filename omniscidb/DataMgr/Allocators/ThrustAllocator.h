@@ -49,6 +49,11 @@ class ThrustAllocator {
   int getDeviceId() const { return device_id_; }
 
  private:
+  // Scratch buffers come from the device scratch pool of the buffer provider when
+  // it has one.
+  Data_Namespace::AbstractBuffer* allocBuffer(const size_t num_bytes);
+  void freeBuffer(Data_Namespace::AbstractBuffer* ab);
+
   BufferProvider* buffer_provider_;
   const int device_id_;
   using PtrMapperType = std::unordered_map<int8_t*, Data_Namespace::AbstractBuffer*>;
@@ -0,0 +1,117 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DataMgr/Allocators/ThrustScratchPool.h"
+
+#include "BufferProvider/BufferProvider.h"
+#include "DataMgr/Allocators/GpuAllocator.h"
+#include "DataMgr/BufferMgr/BufferMgr.h"
+#include "Logger/Logger.h"
+
+namespace {
+
+constexpr size_t kMinScratchBufferSize = 64 * 1024;
+
+size_t scratch_buffer_size(const size_t num_bytes) {
+  size_t res = kMinScratchBufferSize;
+  while (res < num_bytes) {
+    res <<= 1;
+  }
+  return res;
+}
+
+}  // namespace
+
+ThrustScratchPool::~ThrustScratchPool() {
+  clear();
+}
+
+Data_Namespace::AbstractBuffer* ThrustScratchPool::acquire(const int device_id,
+                                                           const size_t num_bytes) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& cache = caches_[device_id];
+    // Don't hand out buffers more than twice as big as requested, they would be
+    // wasted on small allocations.
+    auto it = cache.buffers.lower_bound(num_bytes);
+    if (it != cache.buffers.end() && it->first <= scratch_buffer_size(num_bytes) * 2) {
+      auto buffer = it->second;
+      cache.cached_bytes -= it->first;
+      cache.buffers.erase(it);
+      return buffer;
+    }
+  }
+  return allocate(device_id, scratch_buffer_size(num_bytes));
+}
+
+void ThrustScratchPool::release(Data_Namespace::AbstractBuffer* buffer) {
+  CHECK(buffer);
+  const auto size = buffer->reservedSize();
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& cache = caches_[buffer->getDeviceId()];
+  // Make room by dropping smaller buffers first, big ones are more expensive to get.
+  while (!cache.buffers.empty() && cache.cached_bytes + size > max_cached_bytes_) {
+    auto it = cache.buffers.begin();
+    if (it->first > size) {
+      break;
+    }
+    cache.cached_bytes -= it->first;
+    buffer_provider_->free(it->second);
+    cache.buffers.erase(it);
+  }
+  if (cache.cached_bytes + size > max_cached_bytes_) {
+    buffer_provider_->free(buffer);
+    return;
+  }
+  cache.buffers.emplace(size, buffer);
+  cache.cached_bytes += size;
+}
+
+void ThrustScratchPool::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& [device_id, cache] : caches_) {
+    clearDevice(device_id);
+  }
+}
+
+size_t ThrustScratchPool::cachedBytes(const int device_id) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = caches_.find(device_id);
+  return it == caches_.end() ? 0 : it->second.cached_bytes;
+}
+
+Data_Namespace::AbstractBuffer* ThrustScratchPool::allocate(const int device_id,
+                                                            const size_t num_bytes) {
+  try {
+    return GpuAllocator::allocGpuAbstractBuffer(buffer_provider_, num_bytes, device_id);
+  } catch (const Buffer_Namespace::OutOfMemory& e) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!caches_[device_id].cached_bytes) {
+      throw;
+    }
+    VLOG(1) << "Dropping cached Thrust scratch buffers on device " << device_id
+            << " to allocate " << num_bytes << " bytes: " << e.what();
+    clearDevice(device_id);
+  }
+  return GpuAllocator::allocGpuAbstractBuffer(buffer_provider_, num_bytes, device_id);
+}
+
+void ThrustScratchPool::clearDevice(const int device_id) {
+  auto& cache = caches_[device_id];
+  for (auto& [size, buffer] : cache.buffers) {
+    buffer_provider_->free(buffer);
+  }
+  cache.buffers.clear();
+  cache.cached_bytes = 0;
+}
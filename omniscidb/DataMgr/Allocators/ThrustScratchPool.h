@@ -0,0 +1,74 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file    ThrustScratchPool.h
+ * @brief   Per-device cache of GPU scratch buffers reused by Thrust allocators across
+ * sorts and queries.
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+#include "DataMgr/AbstractBuffer.h"
+
+class BufferProvider;
+
+/**
+ * Keeps GPU buffers released by ThrustAllocator pinned and hands them out to the next
+ * allocation of a similar size on the same device, so sorts don't allocate and free
+ * DataMgr buffers on every call. Requested sizes are rounded up to a power of two to
+ * make the cached buffers interchangeable.
+ *
+ * All Thrust work is issued on the default stream, so a buffer released after a Thrust
+ * call can be handed out right away: any later use is ordered after the work which
+ * released it.
+ *
+ * Cached buffers stay pinned and can't be evicted by the buffer manager. The amount of
+ * cached memory is limited per device, and the whole cache is dropped on allocation
+ * failures and when GPU memory is cleared.
+ */
+class ThrustScratchPool {
+ public:
+  ThrustScratchPool(BufferProvider* buffer_provider, size_t max_cached_bytes)
+      : buffer_provider_(buffer_provider), max_cached_bytes_(max_cached_bytes) {}
+  ~ThrustScratchPool();
+
+  Data_Namespace::AbstractBuffer* acquire(const int device_id, const size_t num_bytes);
+  void release(Data_Namespace::AbstractBuffer* buffer);
+
+  // Frees all cached buffers.
+  void clear();
+
+  size_t cachedBytes(const int device_id) const;
+
+ private:
+  Data_Namespace::AbstractBuffer* allocate(const int device_id, const size_t num_bytes);
+  void clearDevice(const int device_id);
+
+  struct DeviceCache {
+    std::multimap<size_t, Data_Namespace::AbstractBuffer*> buffers;
+    size_t cached_bytes{0};
+  };
+
+  BufferProvider* buffer_provider_;
+  const size_t max_cached_bytes_;
+  std::unordered_map<int, DeviceCache> caches_;
+  mutable std::mutex mutex_;
+};
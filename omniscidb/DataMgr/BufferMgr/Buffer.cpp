@@ -21,6 +21,7 @@
 
 #include "DataMgr/BufferMgr/BufferMgr.h"
 #include "Logger/Logger.h"
+#include "Shared/Metrics.h"
 
 namespace Buffer_Namespace {
 
@@ -166,4 +167,12 @@ int8_t* Buffer::getMemoryPtr() {
 void Buffer::setMemoryPtr(int8_t* new_ptr) {
   mem_ = new_ptr;
 }
+
+void Buffer::addTransferMetric(const char* direction, int device_id, size_t num_bytes) {
+  metrics::Registry::get()
+      .counter("hdk_transfer_bytes_total",
+               "Bytes copied between host and GPU memory.",
+               {{"direction", direction}, {"device", std::to_string(device_id)}})
+      .inc(num_bytes);
+}
 }  // namespace Buffer_Namespace
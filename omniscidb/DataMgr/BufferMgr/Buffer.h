@@ -161,6 +161,10 @@ class Buffer : public AbstractBuffer {
   int32_t getSlabNum() const { return seg_it_->slab_num; }
 
  protected:
+  // Adds bytes copied to, from or between GPUs to the transfer metrics. Direction is
+  // one of "h2d", "d2h" and "d2d", the device is the GPU side of the copy.
+  static void addTransferMetric(const char* direction, int device_id, size_t num_bytes);
+
   int8_t* mem_;  /// pointer to beginning of buffer's memory
 
  private:
@@ -24,9 +24,11 @@
 #include <algorithm>
 #include <iomanip>
 #include <limits>
+#include <optional>
 
 #include "DataMgr/BufferMgr/Buffer.h"
 #include "Logger/Logger.h"
+#include "Shared/Metrics.h"
 #include "Shared/measure.h"
 #include "Shared/scope.h"
 
@@ -111,6 +113,7 @@ void BufferMgr::clear() {
   chunk_index_.clear();
   slabs_.clear();
   slab_segments_.clear();
+  slab_max_free_pages_.clear();
   unsized_segs_.clear();
   buffer_epoch_ = 0;
 }
@@ -165,6 +168,30 @@ AbstractBuffer* BufferMgr::createZeroCopyBuffer(
   return allocateZeroCopyBuffer(page_size_, std::move(token));
 }
 
+uint64_t BufferMgr::getEvictionScore(const BufferSeg& seg) {
+  if (eviction_policy_ == EvictionPolicy::kLru) {
+    return seg.last_touched;
+  }
+  // Order by the access preceding the last one, then by the last access. Highest
+  // bit is reserved for resident tables.
+  uint64_t prev_touched = std::min(seg.prev_touched, (1U << 31) - 1);
+  uint64_t score = (prev_touched << 32) | seg.last_touched;
+  if (seg.chunk_key.size() >= 2 && isResidentTable(seg.chunk_key[0], seg.chunk_key[1])) {
+    score |= uint64_t(1) << 63;
+  }
+  return score;
+}
+
+void BufferMgr::addResidentTable(int db_id, int table_id) {
+  std::lock_guard<std::mutex> lock(resident_tables_mutex_);
+  resident_tables_.emplace(db_id, table_id);
+}
+
+bool BufferMgr::isResidentTable(int db_id, int table_id) {
+  std::lock_guard<std::mutex> lock(resident_tables_mutex_);
+  return resident_tables_.count({db_id, table_id});
+}
+
 BufferList::iterator BufferMgr::evict(BufferList::iterator& evict_start,
                                       const size_t num_pages_requested,
                                       const int slab_num) {
@@ -172,6 +199,17 @@ BufferList::iterator BufferMgr::evict(BufferList::iterator& evict_start,
   // We can assume here that buffer for evictStart either doesn't exist
   // (evictStart is first buffer) or was not free, so don't need ot merge
   // it
+  if (!evictions_metric_) {
+    const metrics::Labels labels{
+        {"device",
+         getMgrType() == GPU_MGR ? "gpu" + std::to_string(getDeviceId())
+                                 : std::string("cpu")}};
+    evictions_metric_ = &metrics::Registry::get().counter(
+        "hdk_buffer_evictions_total", "Chunks evicted from buffer pools.", labels);
+    evicted_bytes_metric_ = &metrics::Registry::get().counter(
+        "hdk_buffer_evicted_bytes_total", "Bytes of chunks evicted from buffer pools.",
+        labels);
+  }
   auto evict_it = evict_start;
   size_t num_pages = 0;
   size_t start_page = evict_start->start_page;
@@ -182,6 +220,8 @@ BufferList::iterator BufferMgr::evict(BufferList::iterator& evict_start,
     num_pages += evict_it->num_pages;
     if (evict_it->mem_status == USED && evict_it->chunk_key.size() > 0) {
       chunk_index_.erase(evict_it->chunk_key);
+      evictions_metric_->inc();
+      evicted_bytes_metric_->inc(evict_it->num_pages * page_size_);
     }
     if (evict_it->buffer != nullptr) {
       // If we don't delete buffers here then we lose reference to them later and cause
@@ -204,9 +244,11 @@ BufferList::iterator BufferMgr::evict(BufferList::iterator& evict_start,
         evict_it->mem_status == FREE) {  // need to merge with current page
       evict_it->start_page = start_page + num_pages_requested;
       evict_it->num_pages += excess_pages;
+      addFreePages(slab_num, evict_it->num_pages);
     } else {  // need to insert a free seg before evict_it for excess_pages
       BufferSeg free_seg(start_page + num_pages_requested, excess_pages, FREE);
       slab_segments_[slab_num].insert(evict_it, free_seg);
+      addFreePages(slab_num, excess_pages);
     }
   }
   return data_seg_it;
@@ -245,6 +287,7 @@ BufferList::iterator BufferMgr::reserveBuffer(
   // Below should be in copy constructor for BufferSeg?
   new_seg_it->buffer = seg_it->buffer;
   new_seg_it->chunk_key = seg_it->chunk_key;
+  new_seg_it->prev_touched = seg_it->prev_touched;
   int8_t* old_mem = new_seg_it->buffer->mem_;
   new_seg_it->buffer->mem_ =
       slabs_[new_seg_it->slab_num] + new_seg_it->start_page * page_size_;
@@ -271,9 +314,17 @@ BufferList::iterator BufferMgr::reserveBuffer(
 BufferList::iterator BufferMgr::findFreeBufferInSlab(const size_t slab_num,
                                                      const size_t num_pages_requested) {
   // It is assumed that caller holds a lock on sized_segs_mutex_.
+  if (slab_num < slab_max_free_pages_.size() &&
+      slab_max_free_pages_[slab_num] < num_pages_requested) {
+    return slab_segments_[slab_num].end();
+  }
+  size_t max_free_pages = 0;
   for (auto buffer_it = slab_segments_[slab_num].begin();
        buffer_it != slab_segments_[slab_num].end();
        ++buffer_it) {
+    if (buffer_it->mem_status == FREE) {
+      max_free_pages = std::max(max_free_pages, buffer_it->num_pages);
+    }
     if (buffer_it->mem_status == FREE && buffer_it->num_pages >= num_pages_requested) {
       // startPage doesn't change
       size_t excess_pages = buffer_it->num_pages - num_pages_requested;
@@ -293,10 +344,143 @@ BufferList::iterator BufferMgr::findFreeBufferInSlab(const size_t slab_num,
     }
   }
   // If here then we did not find a free buffer of sufficient size in this slab,
-  // return the end iterator
+  // remember the largest free segment we saw and return the end iterator
+  if (slab_max_free_pages_.size() <= slab_num) {
+    slab_max_free_pages_.resize(slab_num + 1, std::numeric_limits<size_t>::max());
+  }
+  slab_max_free_pages_[slab_num] = max_free_pages;
   return slab_segments_[slab_num].end();
 }
 
+void BufferMgr::addFreePages(const size_t slab_num, const size_t num_pages) {
+  // It is assumed that caller holds a lock on sized_segs_mutex_.
+  if (slab_num < slab_max_free_pages_.size()) {
+    slab_max_free_pages_[slab_num] = std::max(slab_max_free_pages_[slab_num], num_pages);
+  }
+}
+
+std::optional<BufferList::iterator> BufferMgr::findFreeBufferInSlabs(
+    const bool fast,
+    const size_t num_pages_requested) {
+  // It is assumed that caller holds a lock on sized_segs_mutex_.
+  for (size_t slab_num = 0; slab_num < slab_segments_.size(); ++slab_num) {
+    if (isFastSlab(slab_num) != fast) {
+      continue;
+    }
+    auto seg_it = findFreeBufferInSlab(slab_num, num_pages_requested);
+    if (seg_it != slab_segments_[slab_num].end()) {
+      return seg_it;
+    }
+  }
+  return std::nullopt;
+}
+
+void BufferMgr::moveBuffer(BufferList::iterator& seg_it,
+                           BufferList::iterator new_seg_it) {
+  // It is assumed that caller holds locks on sized_segs_mutex_ and chunk_index_mutex_
+  // and the buffer is not pinned.
+  CHECK_EQ(seg_it->num_pages, new_seg_it->num_pages);
+  auto buffer = seg_it->buffer;
+  new_seg_it->buffer = buffer;
+  new_seg_it->chunk_key = seg_it->chunk_key;
+  new_seg_it->last_touched = seg_it->last_touched;
+  new_seg_it->prev_touched = seg_it->prev_touched;
+  int8_t* old_mem = buffer->mem_;
+  buffer->mem_ = slabs_[new_seg_it->slab_num] + new_seg_it->start_page * page_size_;
+  if (buffer->size()) {
+    buffer->writeData(old_mem, buffer->size(), 0, buffer->getType(), device_id_);
+  }
+  buffer->seg_it_ = new_seg_it;
+  chunk_index_[new_seg_it->chunk_key] = new_seg_it;
+  removeSegment(seg_it);
+}
+
+size_t BufferMgr::migrateBuffers(const unsigned hot_epochs, const size_t max_bytes) {
+  std::lock_guard<std::mutex> sized_segs_lock(sized_segs_mutex_);
+  std::lock_guard<std::mutex> chunk_index_lock(chunk_index_mutex_);
+  // Buffers are pinned only under both locks, so unpinned buffers can't be accessed
+  // while we move them.
+  auto is_movable = [this](const BufferSeg& seg) {
+    return seg.mem_status == USED && seg.buffer && !seg.chunk_key.empty() &&
+           seg.buffer->getPinCount() == 0 &&
+           !in_progress_buffer_cvs_.count(seg.chunk_key);
+  };
+  auto is_hot = [this, hot_epochs](const BufferSeg& seg) {
+    return seg.prev_touched > 0 && buffer_epoch_ - seg.prev_touched <= hot_epochs;
+  };
+
+  std::vector<BufferList::iterator> hot_segs;
+  for (size_t slab_num = 0; slab_num < slab_segments_.size(); ++slab_num) {
+    if (isFastSlab(slab_num)) {
+      continue;
+    }
+    for (auto seg_it = slab_segments_[slab_num].begin();
+         seg_it != slab_segments_[slab_num].end();
+         ++seg_it) {
+      if (is_movable(*seg_it) && is_hot(*seg_it)) {
+        hot_segs.push_back(seg_it);
+      }
+    }
+  }
+  // Promote the most frequently accessed buffers first.
+  std::sort(hot_segs.begin(), hot_segs.end(), [this](auto& lhs, auto& rhs) {
+    return getEvictionScore(*lhs) > getEvictionScore(*rhs);
+  });
+
+  size_t moved_bytes = 0;
+  for (auto& hot_seg_it : hot_segs) {
+    const size_t num_bytes = hot_seg_it->num_pages * page_size_;
+    if (moved_bytes + num_bytes > max_bytes) {
+      break;
+    }
+    auto fast_seg_it = findFreeBufferInSlabs(true, hot_seg_it->num_pages);
+    if (!fast_seg_it) {
+      // Look for the coldest buffer big enough to give its place.
+      auto hot_score = getEvictionScore(*hot_seg_it);
+      std::optional<BufferList::iterator> cold_seg_it;
+      for (size_t slab_num = 0; slab_num < slab_segments_.size(); ++slab_num) {
+        if (!isFastSlab(slab_num)) {
+          continue;
+        }
+        for (auto seg_it = slab_segments_[slab_num].begin();
+             seg_it != slab_segments_[slab_num].end();
+             ++seg_it) {
+          if (is_movable(*seg_it) && !is_hot(*seg_it) &&
+              seg_it->num_pages >= hot_seg_it->num_pages &&
+              getEvictionScore(*seg_it) < hot_score &&
+              (!cold_seg_it ||
+               getEvictionScore(*seg_it) < getEvictionScore(**cold_seg_it))) {
+            cold_seg_it = seg_it;
+          }
+        }
+      }
+      if (!cold_seg_it) {
+        continue;
+      }
+      const size_t cold_num_bytes = (*cold_seg_it)->num_pages * page_size_;
+      if (moved_bytes + num_bytes + cold_num_bytes > max_bytes) {
+        continue;
+      }
+      auto slow_seg_it = findFreeBufferInSlabs(false, (*cold_seg_it)->num_pages);
+      if (!slow_seg_it) {
+        continue;
+      }
+      const auto fast_slab_num = (*cold_seg_it)->slab_num;
+      moveBuffer(*cold_seg_it, *slow_seg_it);
+      moved_bytes += cold_num_bytes;
+      fast_seg_it = findFreeBufferInSlab(fast_slab_num, hot_seg_it->num_pages);
+      CHECK(*fast_seg_it != slab_segments_[fast_slab_num].end());
+    }
+    moveBuffer(hot_seg_it, *fast_seg_it);
+    moved_bytes += num_bytes;
+  }
+  if (moved_bytes) {
+    VLOG(1) << "Migrated " << moved_bytes << " bytes between slabs of "
+            << getStringMgrType() << ":" << device_id_;
+  }
+  return moved_bytes;
+}
+
 BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
   // It is assumed that caller holds a lock on sized_segs_mutex_.
   size_t num_pages_requested = (num_bytes + page_size_ - 1) / page_size_;
@@ -370,7 +554,8 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
 
   // If here then we can't add a slab - so we need to evict
 
-  size_t min_score = std::numeric_limits<size_t>::max();
+  uint64_t min_score = std::numeric_limits<uint64_t>::max();
+  size_t min_score_used_pages = std::numeric_limits<size_t>::max();
   // We're going for lowest score here, like golf
   // This is because score is the sum of the lastTouched score for all pages evicted.
   // Evicting fewer pages and older pages will lower the score
@@ -389,7 +574,8 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
 
       // if (buffer_it->mem_status == FREE || buffer_it->buffer->getPinCount() == 0) {
       size_t page_count = 0;
-      size_t score = 0;
+      size_t used_page_count = 0;
+      uint64_t score = 0;
       bool solution_found = false;
       auto evict_it = buffer_it;
       for (; evict_it != slab_segments_[slab_num].end(); ++evict_it) {
@@ -409,15 +595,23 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
           // large chunk so under memory pressure a query would evict its own current
           // chunks and cause reloads rather than evict several smaller unused older
           // chunks.
-          score = std::max(score, static_cast<size_t>(evict_it->last_touched));
+          score = std::max(score, getEvictionScore(*evict_it));
+          used_page_count += evict_it->num_pages;
         }
         if (page_count >= num_pages_requested) {
           solution_found = true;
           break;
         }
       }
-      if (solution_found && score < min_score) {
+      // The cost-aware policy prefers evicting less data between candidates with
+      // equal scores, since evicted data has to be transferred back on the next use.
+      bool better_solution =
+          score < min_score ||
+          (eviction_policy_ == EvictionPolicy::kCostAware && score == min_score &&
+           used_page_count < min_score_used_pages);
+      if (solution_found && better_solution) {
         min_score = score;
+        min_score_used_pages = used_page_count;
         best_eviction_start = buffer_it;
         best_eviction_start_slab = slab_num;
       } else if (evict_it == slab_segments_[slab_num].end()) {
@@ -490,6 +684,30 @@ std::string BufferMgr::printSlabs() {
   return tss.str();
 }
 
+void BufferMgr::preallocateSlabs(const size_t num_bytes) {
+  std::lock_guard<std::mutex> sized_segs_lock(sized_segs_mutex_);
+  const size_t num_pages = std::min((num_bytes + page_size_ - 1) / page_size_,
+                                    max_buffer_pool_num_pages_);
+  while (num_pages_allocated_ < num_pages) {
+    const size_t slab_num_pages = std::min(
+        current_max_slab_page_size_, max_buffer_pool_num_pages_ - num_pages_allocated_);
+    if (slab_num_pages < min_num_pages_per_slab_) {
+      break;
+    }
+    try {
+      addSlab(slab_num_pages * page_size_);
+    } catch (std::runtime_error& error) {
+      LOG(WARNING) << "Failed to preallocate slab of " << slab_num_pages * page_size_
+                   << "B for " << getStringMgrType() << ":" << device_id_;
+      break;
+    }
+    num_pages_allocated_ += slab_num_pages;
+  }
+  LOG(INFO) << "Preallocated " << num_pages_allocated_ * page_size_ << "B in "
+            << slabs_.size() << " slabs for " << getStringMgrType() << ":"
+            << device_id_;
+}
+
 void BufferMgr::clearSlabs() {
   bool pinned_exists = false;
   for (auto& segment_list : slab_segments_) {
@@ -694,6 +912,7 @@ void BufferMgr::removeSegment(BufferList::iterator& seg_it) {
     seg_it->mem_status = FREE;
     // seg_it->pinCount = 0;
     seg_it->buffer = 0;
+    addFreePages(slab_num, seg_it->num_pages);
   }
 }
 
@@ -721,6 +940,7 @@ AbstractBuffer* BufferMgr::getBuffer(const ChunkKey& key, const size_t num_bytes
         buffer_it->second->buffer->pin();
         sized_segs_lock.unlock();
 
+        buffer_it->second->prev_touched = buffer_it->second->last_touched;
         buffer_it->second->last_touched = buffer_epoch_++;  // race
 
         // If we need to fetch a missing part of buffer, then lock it by
@@ -772,6 +992,34 @@ AbstractBuffer* BufferMgr::getBuffer(const ChunkKey& key, const size_t num_bytes
   return res;
 }
 
+AbstractBuffer* BufferMgr::getCachedBuffer(const ChunkKey& key) {
+  std::lock_guard<std::mutex> sized_segs_lock(sized_segs_mutex_);
+  std::lock_guard<std::mutex> chunk_index_lock(chunk_index_mutex_);
+  auto buffer_it = chunk_index_.find(key);
+  if (buffer_it == chunk_index_.end() || in_progress_buffer_cvs_.count(key)) {
+    return nullptr;
+  }
+  CHECK(buffer_it->second->buffer);
+  buffer_it->second->buffer->pin();
+  buffer_it->second->prev_touched = buffer_it->second->last_touched;
+  buffer_it->second->last_touched = buffer_epoch_++;
+  return buffer_it->second->buffer;
+}
+
+bool BufferMgr::registerBuffer(AbstractBuffer* buffer, const ChunkKey& key) {
+  Buffer* casted_buffer = dynamic_cast<Buffer*>(buffer);
+  CHECK(casted_buffer);
+  std::lock_guard<std::mutex> chunk_index_lock(chunk_index_mutex_);
+  if (chunk_index_.count(key)) {
+    return false;
+  }
+  auto seg_it = casted_buffer->seg_it_;
+  chunk_index_.erase(seg_it->chunk_key);
+  seg_it->chunk_key = key;
+  chunk_index_[key] = seg_it;
+  return true;
+}
+
 void BufferMgr::fetchBuffer(const ChunkKey& key,
                             AbstractBuffer* dest_buffer,
                             const size_t num_bytes) {
@@ -31,6 +31,8 @@
 #include <list>
 #include <map>
 #include <mutex>
+#include <optional>
+#include <set>
 
 #include "DataMgr/AbstractBuffer.h"
 #include "DataMgr/AbstractBufferMgr.h"
@@ -38,6 +40,10 @@
 #include "Shared/boost_stacktrace.hpp"
 #include "Shared/types.h"
 
+namespace metrics {
+class Counter;
+}
+
 class OutOfMemory : public std::runtime_error {
  public:
   OutOfMemory(size_t num_bytes)
@@ -96,6 +102,17 @@ struct MemoryData {
   MemStatus memStatus;
 };
 
+/**
+ * Policy to choose buffers to evict when the buffer pool is full.
+ *
+ * kLru evicts buffers with the oldest last access. kCostAware evicts buffers by the
+ * access preceding the last one (LRU-2), so buffers accessed once by big one-off scans
+ * are evicted before frequently accessed ones. Between equally cold candidates it
+ * chooses the one with less data to be transferred back to the device, and buffers of
+ * resident tables are evicted only if there is no other choice.
+ */
+enum class EvictionPolicy { kLru, kCostAware };
+
 struct MemoryInfo {
   size_t pageSize;
   size_t maxNumPages;
@@ -130,6 +147,8 @@ class BufferMgr : public AbstractBufferMgr {  // implements
   std::string printSlabs() override;
 
   void clearSlabs();
+  /// Adds slabs until the pool has at least num_bytes allocated or can't grow anymore.
+  void preallocateSlabs(const size_t num_bytes);
   std::string printMap();
   void printSegs();
   std::string printSeg(BufferList::iterator& seg_it);
@@ -162,6 +181,14 @@ class BufferMgr : public AbstractBufferMgr {  // implements
   std::unique_ptr<AbstractDataToken> getZeroCopyBufferMemory(const ChunkKey& key,
                                                              size_t numBytes) override;
 
+  /// Returns the pinned chunk with the specified key if it is in the pool. Unlike
+  /// getBuffer(), never fetches the chunk from the parent manager.
+  AbstractBuffer* getCachedBuffer(const ChunkKey& key);
+
+  /// Makes a buffer from alloc() accessible by the key. Once unpinned, the buffer
+  /// stays in the pool until evicted. Returns false if the key is already in use.
+  bool registerBuffer(AbstractBuffer* buffer, const ChunkKey& key);
+
   /**
    * @brief Puts the contents of d into the Buffer with ChunkKey key.
    * @param key - Unique identifier for a Chunk.
@@ -197,6 +224,13 @@ class BufferMgr : public AbstractBufferMgr {  // implements
 
   MemoryInfo getMemoryInfo();
 
+  void setEvictionPolicy(EvictionPolicy policy) { eviction_policy_ = policy; }
+  EvictionPolicy getEvictionPolicy() const { return eviction_policy_; }
+
+  // Buffers of resident tables are evicted last by the cost-aware eviction policy.
+  void addResidentTable(int db_id, int table_id);
+  bool isResidentTable(int db_id, int table_id);
+
  protected:
   const size_t
       max_buffer_pool_size_;    /// max number of bytes allocated for the buffer pool
@@ -209,13 +243,29 @@ class BufferMgr : public AbstractBufferMgr {  // implements
                                 /// allocation of the buffer pool
   std::vector<BufferList> slab_segments_;
 
+  /**
+   * Moves unpinned chunk buffers from slow slabs to fast ones. Buffers accessed at
+   * least twice within the last hot_epochs buffer epochs are promoted. If fast slabs
+   * have no room, colder buffers are demoted to slow slabs to make it. Returns the
+   * number of moved bytes, stops after max_bytes.
+   */
+  size_t migrateBuffers(const unsigned hot_epochs, const size_t max_bytes);
+
  private:
   BufferMgr(const BufferMgr&);             // private copy constructor
   BufferMgr& operator=(const BufferMgr&);  // private assignment
   void removeSegment(BufferList::iterator& seg_it);
   BufferList::iterator findFreeBufferInSlab(const size_t slab_num,
                                             const size_t num_pages_requested);
+  // Update the free pages bound of the slab after a free segment was created or grown.
+  void addFreePages(const size_t slab_num, const size_t num_pages);
   int getBufferId();
+  // Slabs in the fastest memory available to the manager. Used by buffers migration.
+  virtual bool isFastSlab(const size_t slab_num) const { return true; }
+  std::optional<BufferList::iterator> findFreeBufferInSlabs(
+      const bool fast,
+      const size_t num_pages_requested);
+  void moveBuffer(BufferList::iterator& seg_it, BufferList::iterator new_seg_it);
   virtual void addSlab(const size_t slab_size) = 0;
   virtual void freeAllMem() = 0;
   virtual void allocateBuffer(BufferList::iterator seg_it,
@@ -239,6 +289,10 @@ class BufferMgr : public AbstractBufferMgr {  // implements
   std::map<ChunkKey, std::shared_ptr<std::condition_variable>> in_progress_buffer_cvs_;
 
   std::map<ChunkKey, BufferList::iterator> chunk_index_;
+  // Upper bound of the largest free segment size in pages for each slab. Slabs which
+  // can't fit a request are skipped without walking their segment lists. Slabs not
+  // scanned yet have no bound.
+  std::vector<size_t> slab_max_free_pages_;
   size_t max_buffer_pool_num_pages_;  // max number of pages for buffer pool
   size_t num_pages_allocated_;
   size_t min_num_pages_per_slab_;
@@ -248,9 +302,19 @@ class BufferMgr : public AbstractBufferMgr {  // implements
   AbstractBufferMgr* parent_mgr_;
   int max_buffer_id_;
   unsigned int buffer_epoch_;
+  EvictionPolicy eviction_policy_{EvictionPolicy::kLru};
+  std::mutex resident_tables_mutex_;
+  std::set<std::pair<int, int>> resident_tables_;
+  // Registered on the first eviction because the device label depends on the manager
+  // type.
+  metrics::Counter* evictions_metric_{nullptr};
+  metrics::Counter* evicted_bytes_metric_{nullptr};
 
   BufferList unsized_segs_;
 
+  // Eviction score of a used segment. Segments with lower score are evicted first.
+  uint64_t getEvictionScore(const BufferSeg& seg);
+
   BufferList::iterator evict(BufferList::iterator& evict_start,
                              const size_t num_pages_requested,
                              const int slab_num);
@@ -36,6 +36,8 @@ struct BufferSeg {
   unsigned int pin_count;
   int slab_num;
   unsigned int last_touched;
+  // Epoch of the access preceding the last one. Zero for segments accessed once.
+  unsigned int prev_touched = 0;
 
   BufferSeg()
       : mem_status(FREE), buffer(0), pin_count(0), slab_num(-1), last_touched(0) {}
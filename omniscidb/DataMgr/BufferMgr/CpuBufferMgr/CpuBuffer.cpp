@@ -49,6 +49,7 @@ void CpuBuffer::readData(int8_t* const dst,
   } else if (dst_memory_level == GPU_LEVEL) {
     CHECK_GE(dst_device_id, 0);
     gpu_mgr_->copyHostToDevice(dst, mem_ + offset, num_bytes, dst_device_id);
+    addTransferMetric("h2d", dst_device_id, num_bytes);
   } else {
     LOG(FATAL) << "Unsupported buffer type";
   }
@@ -66,6 +67,7 @@ void CpuBuffer::writeData(int8_t* const src,
     // std::cout << "Writing to CPU from source GPU" << std::endl;
     CHECK_GE(src_device_id, 0);
     gpu_mgr_->copyDeviceToHost(mem_ + offset, src, num_bytes, src_device_id);
+    addTransferMetric("d2h", src_device_id, num_bytes);
   } else {
     LOG(FATAL) << "Unsupported buffer type";
   }
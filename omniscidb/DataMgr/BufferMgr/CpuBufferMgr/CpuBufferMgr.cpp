@@ -18,25 +18,184 @@
 
 #include "DataMgr/Allocators/ArenaAllocator.h"
 #include "DataMgr/BufferMgr/CpuBufferMgr/CpuBuffer.h"
+#include "Shared/measure.h"
+
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <filesystem>
+#include <regex>
+
+namespace {
+
+// Bind memory pages of the specified range to a NUMA node. The binding is applied
+// to pages which are not touched yet, so it should be done right after allocation.
+bool bind_to_numa_node(int8_t* ptr, size_t size, int node) {
+#ifdef __linux__
+  const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  const auto addr = reinterpret_cast<uintptr_t>(ptr);
+  const auto begin = (addr + page_size - 1) & ~(page_size - 1);
+  const auto end = (addr + size) & ~(page_size - 1);
+  if (end <= begin || node >= static_cast<int>(sizeof(unsigned long) * 8)) {
+    return false;
+  }
+  const unsigned long node_mask = 1UL << node;
+  return syscall(SYS_mbind,
+                 reinterpret_cast<void*>(begin),
+                 end - begin,
+                 MPOL_PREFERRED,
+                 &node_mask,
+                 sizeof(node_mask) * 8,
+                 0) == 0;
+#else
+  return false;
+#endif
+}
+
+// Mark pages of the specified range as eligible for transparent huge pages. Only
+// the part of the range aligned to the huge page size can be backed by huge pages.
+bool advise_huge_pages(int8_t* ptr, size_t size) {
+#ifdef __linux__
+  constexpr size_t huge_page_size = 2ULL << 20;
+  const auto addr = reinterpret_cast<uintptr_t>(ptr);
+  const auto begin = (addr + huge_page_size - 1) & ~(huge_page_size - 1);
+  const auto end = (addr + size) & ~(huge_page_size - 1);
+  if (end <= begin) {
+    return false;
+  }
+  return madvise(reinterpret_cast<void*>(begin), end - begin, MADV_HUGEPAGE) == 0;
+#else
+  return false;
+#endif
+}
+
+// Write to each page of the range to make the kernel back it with physical memory.
+void touch_pages(int8_t* ptr, size_t size) {
+#ifdef __linux__
+  const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+  const size_t page_size = 4096;
+#endif
+  volatile int8_t* data = ptr;
+  for (size_t offs = 0; offs < size; offs += page_size) {
+    data[offs] = 0;
+  }
+}
+
+}  // namespace
 
 namespace Buffer_Namespace {
 
+int CpuBufferMgr::getNumaNodeCount() {
+  static const int node_count = []() {
+    int res = 0;
+    std::error_code ec;
+    const std::regex node_regex("node[0-9]+");
+    for (const auto& entry :
+         std::filesystem::directory_iterator("/sys/devices/system/node", ec)) {
+      if (std::regex_match(entry.path().filename().string(), node_regex)) {
+        ++res;
+      }
+    }
+    return std::max(res, 1);
+  }();
+  return node_count;
+}
+
+int CpuBufferMgr::getSlabNumaNode(int32_t slab_num) const {
+  CHECK_LT(static_cast<size_t>(slab_num), slab_numa_nodes_.size());
+  return slab_numa_nodes_[slab_num];
+}
+
+bool CpuBufferMgr::isPinnedSlab(int32_t slab_num) const {
+  CHECK_LT(static_cast<size_t>(slab_num), slabs_.size());
+  return pinned_slabs_.count(slabs_[slab_num]);
+}
+
+int8_t* CpuBufferMgr::allocatePinnedSlab(const size_t slab_size) {
+  if (pinned_slabs_used_ + slab_size > pinned_slabs_size_) {
+    return nullptr;
+  }
+  CHECK(gpu_mgr_);
+  int8_t* slab = nullptr;
+  try {
+    slab = gpu_mgr_->allocatePinnedHostMem(slab_size);
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Failed to allocate pinned CPU slab of " << slab_size
+                 << " bytes, falling back to pageable memory: " << e.what();
+    return nullptr;
+  }
+  CHECK(slab);
+  pinned_slabs_.insert(slab);
+  pinned_slabs_used_ += slab_size;
+  VLOG(1) << "Allocated pinned CPU slab of " << slab_size << " bytes ("
+          << pinned_slabs_used_ << " out of " << pinned_slabs_size_ << " bytes used).";
+  return slab;
+}
+
+void CpuBufferMgr::freePinnedSlabs() {
+  for (auto slab : pinned_slabs_) {
+    gpu_mgr_->freePinnedHostMem(slab);
+  }
+  pinned_slabs_.clear();
+  pinned_slabs_used_ = 0;
+}
+
 void CpuBufferMgr::addSlab(const size_t slab_size) {
   CHECK(allocator_);
   slabs_.resize(slabs_.size() + 1);
-  try {
-    slabs_.back() = reinterpret_cast<int8_t*>(allocator_->allocate(slab_size));
-  } catch (std::bad_alloc&) {
-    slabs_.resize(slabs_.size() - 1);
-    throw FailedToCreateSlab(slab_size);
+  slabs_.back() = allocatePinnedSlab(slab_size);
+  if (!slabs_.back()) {
+    try {
+      slabs_.back() = reinterpret_cast<int8_t*>(allocator_->allocate(slab_size));
+    } catch (std::bad_alloc&) {
+      slabs_.resize(slabs_.size() - 1);
+      throw FailedToCreateSlab(slab_size);
+    }
+  }
+  if (huge_page_slabs_ && !isPinnedSlab(slabs_.size() - 1) &&
+      !advise_huge_pages(slabs_.back(), slab_size)) {
+    LOG(WARNING) << "Failed to enable huge pages for CPU slab " << slabs_.size() - 1;
+  }
+  slab_numa_nodes_.resize(slabs_.size());
+  slab_numa_nodes_.back() = -1;
+  if (numa_node_count_ > 1 && !isPinnedSlab(slabs_.size() - 1)) {
+    const int node = static_cast<int>((slabs_.size() - 1) % numa_node_count_);
+    if (bind_to_numa_node(slabs_.back(), slab_size, node)) {
+      slab_numa_nodes_.back() = node;
+      VLOG(1) << "Bound CPU slab " << slabs_.size() - 1 << " to NUMA node " << node;
+    } else {
+      LOG(WARNING) << "Failed to bind CPU slab " << slabs_.size() - 1
+                   << " to NUMA node " << node;
+    }
   }
   slab_segments_.resize(slab_segments_.size() + 1);
   slab_segments_[slab_segments_.size() - 1].push_back(
       BufferSeg(0, slab_size / page_size_));
 }
 
+void CpuBufferMgr::prefault(const size_t num_bytes) {
+  preallocateSlabs(num_bytes);
+  auto prefault_ms = measure<>::execution([&]() {
+    for (size_t slab_num = 0; slab_num < slabs_.size(); ++slab_num) {
+      size_t num_pages = 0;
+      for (auto& seg : slab_segments_[slab_num]) {
+        num_pages += seg.num_pages;
+      }
+      touch_pages(slabs_[slab_num], num_pages * page_size_);
+    }
+  });
+  LOG(INFO) << "Prefaulted " << slabs_.size() << " CPU slabs in " << prefault_ms
+            << " ms";
+}
+
 void CpuBufferMgr::freeAllMem() {
   CHECK(allocator_);
+  freePinnedSlabs();
   initializeMem();
 }
 
@@ -62,6 +221,7 @@ AbstractBuffer* CpuBufferMgr::allocateZeroCopyBuffer(
 
 void CpuBufferMgr::initializeMem() {
   allocator_.reset(new Arena(max_slab_size_ + kArenaBlockOverhead));
+  slab_numa_nodes_.clear();
 }
 
 }  // namespace Buffer_Namespace
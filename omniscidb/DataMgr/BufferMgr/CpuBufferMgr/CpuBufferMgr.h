@@ -20,6 +20,8 @@
 
 #include "DataMgr/Allocators/ArenaAllocator.h"
 
+#include <unordered_set>
+
 namespace Buffer_Namespace {
 
 class CpuBufferMgr : public BufferMgr {
@@ -30,19 +32,26 @@ class CpuBufferMgr : public BufferMgr {
                const size_t min_slab_size,
                const size_t max_slab_size,
                const size_t page_size,
-               AbstractBufferMgr* parent_mgr = nullptr)
+               AbstractBufferMgr* parent_mgr = nullptr,
+               const bool numa_aware_slabs = false,
+               const size_t pinned_slabs_size = 0,
+               const bool huge_page_slabs = false)
       : BufferMgr(device_id,
                   max_buffer_pool_size,
                   min_slab_size,
                   max_slab_size,
                   page_size,
                   parent_mgr)
-      , gpu_mgr_(gpu_mgr) {
+      , gpu_mgr_(gpu_mgr)
+      , numa_node_count_(numa_aware_slabs ? getNumaNodeCount() : 1)
+      , pinned_slabs_size_(gpu_mgr ? pinned_slabs_size : 0)
+      , huge_page_slabs_(huge_page_slabs) {
     initializeMem();
   }
 
   ~CpuBufferMgr() override {
     /* the destruction of the allocator automatically frees all memory */
+    freePinnedSlabs();
   }
 
   inline MgrType getMgrType() override { return CPU_MGR; }
@@ -52,6 +61,19 @@ class CpuBufferMgr : public BufferMgr {
       const size_t page_size,
       std::unique_ptr<AbstractDataToken> token) override;
 
+  // NUMA node the slab memory is bound to, -1 if the slab is not bound.
+  int getSlabNumaNode(int32_t slab_num) const;
+
+  static int getNumaNodeCount();
+
+  bool isPinnedSlab(int32_t slab_num) const;
+
+  size_t getPinnedSlabsSize() const { return pinned_slabs_used_; }
+
+  // Allocate slabs for num_bytes of the pool and touch their pages to avoid page
+  // faults on first use.
+  void prefault(const size_t num_bytes);
+
  protected:
   void addSlab(const size_t slab_size) override;
   void freeAllMem() override;
@@ -60,10 +82,26 @@ class CpuBufferMgr : public BufferMgr {
                       const size_t initial_size) override;
   virtual void initializeMem();
 
+  // Allocate a slab in page-locked memory if it fits the pinned memory budget.
+  // Return nullptr if the slab should be allocated in pageable memory instead.
+  int8_t* allocatePinnedSlab(const size_t slab_size);
+  void freePinnedSlabs();
+
   GpuMgr* gpu_mgr_;
 
  private:
   std::unique_ptr<Arena> allocator_;
+  // Slabs are bound to NUMA nodes in a round-robin fashion when there are multiple
+  // nodes.
+  const int numa_node_count_;
+  std::vector<int> slab_numa_nodes_;
+  // Slabs are allocated in page-locked memory until their total size reaches
+  // pinned_slabs_size_. GPU transfers from these slabs skip driver staging.
+  const size_t pinned_slabs_size_;
+  size_t pinned_slabs_used_{0};
+  std::unordered_set<int8_t*> pinned_slabs_;
+  // Ask the kernel to back pageable slabs with transparent huge pages.
+  const bool huge_page_slabs_;
 };
 
 }  // namespace Buffer_Namespace
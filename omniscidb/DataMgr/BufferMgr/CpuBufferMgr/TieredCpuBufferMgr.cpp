@@ -44,14 +44,17 @@ TieredCpuBufferMgr::TieredCpuBufferMgr(const int device_id,
                                        const size_t max_slab_size,
                                        const size_t page_size,
                                        const CpuTierSizeVector& cpu_tier_sizes,
-                                       AbstractBufferMgr* parent_mgr)
+                                       AbstractBufferMgr* parent_mgr,
+                                       const size_t pinned_slabs_size)
     : CpuBufferMgr(device_id,
                    total_size,
                    gpu_mgr,
                    min_slab_size,
                    max_slab_size,
                    page_size,
-                   parent_mgr) {
+                   parent_mgr,
+                   false,
+                   pinned_slabs_size) {
   CHECK(cpu_tier_sizes.size() == numCpuTiers);
   for (auto tier_size : cpu_tier_sizes) {
     allocators_.emplace_back(std::unique_ptr<Arena>{}, tier_size);
@@ -59,14 +62,70 @@ TieredCpuBufferMgr::TieredCpuBufferMgr(const int device_id,
   initializeMem();
 }
 
+TieredCpuBufferMgr::~TieredCpuBufferMgr() {
+  stopChunkMigration();
+  // The destruction of the allocators automatically frees all memory
+}
+
 Arena* TieredCpuBufferMgr::getAllocatorForSlab(int32_t slab_num) const {
   return shared::get_from_map(slab_to_allocator_map_, slab_num);
 }
 
+bool TieredCpuBufferMgr::isFastSlab(const size_t slab_num) const {
+  if (isPinnedSlab(slab_num)) {
+    return true;
+  }
+  auto it = slab_to_allocator_map_.find(slab_num);
+  return it != slab_to_allocator_map_.end() &&
+         it->second == allocators_.at(CpuTier::DRAM).first.get();
+}
+
+size_t TieredCpuBufferMgr::migrateChunks(const size_t max_bytes) {
+  return migrateBuffers(kHotChunkEpochs, max_bytes);
+}
+
+void TieredCpuBufferMgr::startChunkMigration(const size_t interval_ms,
+                                             const size_t max_bytes) {
+  CHECK(!migration_thread_.joinable());
+  CHECK_GT(interval_ms, (size_t)0);
+  stop_migration_ = false;
+  migration_thread_ = std::thread([this, interval_ms, max_bytes]() {
+    std::unique_lock<std::mutex> lock(migration_mutex_);
+    while (!migration_cv_.wait_for(lock,
+                                   std::chrono::milliseconds(interval_ms),
+                                   [this]() { return stop_migration_; })) {
+      lock.unlock();
+      migrateChunks(max_bytes);
+      lock.lock();
+    }
+  });
+}
+
+void TieredCpuBufferMgr::stopChunkMigration() {
+  if (!migration_thread_.joinable()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(migration_mutex_);
+    stop_migration_ = true;
+  }
+  migration_cv_.notify_all();
+  migration_thread_.join();
+}
+
 void TieredCpuBufferMgr::addSlab(const size_t slab_size) {
   CHECK(!allocators_.empty());
   CHECK(allocators_.begin()->first.get() != nullptr);
   slabs_.resize(slabs_.size() + 1);
+  // Pinned DRAM is used as a transfer tier with the highest priority.
+  slabs_.back() = allocatePinnedSlab(slab_size);
+  if (slabs_.back()) {
+    slab_segments_.resize(slab_segments_.size() + 1);
+    slab_segments_[slab_segments_.size() - 1].push_back(
+        BufferSeg(0, slab_size / page_size_));
+    LOG(INFO) << "Allocated slab using pinned DRAM.";
+    return;
+  }
   auto allocated_slab = false;
   CpuTier last_tier;
   for (auto allocator_type : {CpuTier::DRAM, CpuTier::PMEM}) {
@@ -103,6 +162,7 @@ void TieredCpuBufferMgr::addSlab(const size_t slab_size) {
 void TieredCpuBufferMgr::freeAllMem() {
   CHECK(!allocators_.empty());
   CHECK(allocators_.begin()->first.get() != nullptr);
+  freePinnedSlabs();
   initializeMem();
 }
 
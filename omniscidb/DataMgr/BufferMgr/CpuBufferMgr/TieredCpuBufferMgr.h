@@ -19,6 +19,10 @@
 #include "DataMgr/BufferMgr/CpuBufferMgr/CpuBufferMgr.h"
 #include "DataMgr/GpuMgr.h"
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 namespace Data_Namespace {
 constexpr size_t numCpuTiers = 2;
 enum CpuTier { DRAM = 0, PMEM = 1 };
@@ -36,11 +40,10 @@ class TieredCpuBufferMgr : public CpuBufferMgr {
                      const size_t max_slab_size,
                      const size_t page_size,
                      const CpuTierSizeVector& cpu_tier_sizes,
-                     AbstractBufferMgr* parent_mgr = nullptr);
+                     AbstractBufferMgr* parent_mgr = nullptr,
+                     const size_t pinned_slabs_size = 0);
 
-  ~TieredCpuBufferMgr() override {
-    // The destruction of the allocators automatically frees all memory
-  }
+  ~TieredCpuBufferMgr() override;
 
   // Needed for testing to replace allocators with Mocks.
   std::vector<std::pair<std::unique_ptr<Arena>, const size_t>>& getAllocators() {
@@ -52,7 +55,20 @@ class TieredCpuBufferMgr : public CpuBufferMgr {
   Arena* getAllocatorForSlab(int32_t slab_num) const;
   std::string dump() const;
 
+  /**
+   * Promotes recently and frequently accessed chunks from PMEM to DRAM, demoting cold
+   * DRAM chunks to PMEM when DRAM is full. Returns the number of moved bytes.
+   */
+  size_t migrateChunks(const size_t max_bytes);
+  // Run chunk migration in a background thread every interval_ms milliseconds.
+  void startChunkMigration(const size_t interval_ms, const size_t max_bytes);
+  void stopChunkMigration();
+
+  // Chunks accessed twice within this number of buffer pool accesses are hot.
+  static constexpr unsigned kHotChunkEpochs = 1024;
+
  private:
+  bool isFastSlab(const size_t slab_num) const override;
   void addSlab(const size_t slab_size) override;
   void freeAllMem() override;
   void initializeMem() override;
@@ -64,6 +80,11 @@ class TieredCpuBufferMgr : public CpuBufferMgr {
   // Map to track which slabs were created by which allocator (may not be necessary
   // later).
   std::map<int32_t, Arena*> slab_to_allocator_map_;
+
+  std::thread migration_thread_;
+  std::mutex migration_mutex_;
+  std::condition_variable migration_cv_;
+  bool stop_migration_ = false;
 };
 
 }  // namespace Buffer_Namespace
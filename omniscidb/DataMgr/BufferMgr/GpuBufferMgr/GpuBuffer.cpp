@@ -17,6 +17,7 @@
 #include "DataMgr/BufferMgr/GpuBufferMgr/GpuBuffer.h"
 
 #include <cassert>
+#include <cstring>
 #include "Logger/Logger.h"
 
 namespace Buffer_Namespace {
@@ -29,18 +30,37 @@ GpuBuffer::GpuBuffer(BufferMgr* bm,
                      const size_t num_bytes)
     : Buffer(bm, seg_it, device_id, page_size, num_bytes), gpu_mgr_(gpu_mgr) {}
 
+GpuBuffer::GpuBuffer(BufferMgr* bm,
+                     int device_id,
+                     const size_t page_size,
+                     std::unique_ptr<AbstractDataToken> token,
+                     GpuMgr* gpu_mgr)
+    : Buffer(bm, device_id, page_size, std::move(token))
+    , gpu_mgr_(gpu_mgr)
+    , host_mem_(true) {}
+
 void GpuBuffer::readData(int8_t* const dst,
                          const size_t num_bytes,
                          const size_t offset,
                          const MemoryLevel dst_buffer_type,
                          const int dst_device_id) {
-  if (dst_buffer_type == CPU_LEVEL) {
+  if (host_mem_) {
+    if (dst_buffer_type == CPU_LEVEL) {
+      memcpy(dst, mem_ + offset, num_bytes);
+    } else if (dst_buffer_type == GPU_LEVEL) {
+      gpu_mgr_->copyHostToDevice(dst, mem_ + offset, num_bytes, dst_device_id);
+      addTransferMetric("h2d", dst_device_id, num_bytes);
+    } else {
+      LOG(FATAL) << "Unsupported buffer type";
+    }
+  } else if (dst_buffer_type == CPU_LEVEL) {
     gpu_mgr_->copyDeviceToHost(
         dst, mem_ + offset, num_bytes, device_id_);  // need to replace 0 with gpu num
+    addTransferMetric("d2h", device_id_, num_bytes);
   } else if (dst_buffer_type == GPU_LEVEL) {
     gpu_mgr_->copyDeviceToDevice(
         dst, mem_ + offset, num_bytes, dst_device_id, device_id_);
-
+    addTransferMetric("d2d", dst_device_id, num_bytes);
   } else {
     LOG(FATAL) << "Unsupported buffer type";
   }
@@ -56,12 +76,13 @@ void GpuBuffer::writeData(int8_t* const src,
 
     gpu_mgr_->copyHostToDevice(
         mem_ + offset, src, num_bytes, device_id_);  // need to replace 0 with gpu num
-
+    addTransferMetric("h2d", device_id_, num_bytes);
   } else if (src_buffer_type == GPU_LEVEL) {
     // std::cout << "Writing to GPU from source GPU" << std::endl;
     CHECK_GE(src_device_id, 0);
     gpu_mgr_->copyDeviceToDevice(
         mem_ + offset, src, num_bytes, device_id_, src_device_id);
+    addTransferMetric("d2d", device_id_, num_bytes);
   } else {
     LOG(FATAL) << "Unsupported buffer type";
   }
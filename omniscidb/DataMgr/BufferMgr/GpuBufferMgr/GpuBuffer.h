@@ -29,6 +29,14 @@ class GpuBuffer : public Buffer {
             GpuMgr* gpu_mgr,
             const size_t page_size = 512,
             const size_t num_bytes = 0);
+
+  // Zero-copy buffer referencing host memory directly accessible by the device.
+  GpuBuffer(BufferMgr* bm,
+            int device_id,
+            const size_t page_size,
+            std::unique_ptr<AbstractDataToken> token,
+            GpuMgr* gpu_mgr);
+
   inline Data_Namespace::MemoryLevel getType() const override { return GPU_LEVEL; }
 
  private:
@@ -44,5 +52,6 @@ class GpuBuffer : public Buffer {
                  const int src_device_id = -1) override;
 
   GpuMgr* gpu_mgr_;
+  const bool host_mem_ = false;
 };
 }  // namespace Buffer_Namespace
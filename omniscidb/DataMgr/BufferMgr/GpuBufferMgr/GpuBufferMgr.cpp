@@ -88,4 +88,19 @@ void GpuBufferMgr::allocateBuffer(BufferList::iterator seg_it,
                                 // Buffer in its buffer member
 }
 
+std::unique_ptr<AbstractDataToken> GpuBufferMgr::getZeroCopyBufferMemory(
+    const ChunkKey& key,
+    size_t numBytes) {
+  if (!zero_copy_from_host_) {
+    return nullptr;
+  }
+  return BufferMgr::getZeroCopyBufferMemory(key, numBytes);
+}
+
+AbstractBuffer* GpuBufferMgr::allocateZeroCopyBuffer(
+    const size_t page_size,
+    std::unique_ptr<AbstractDataToken> token) {
+  return new GpuBuffer(this, device_id_, page_size, std::move(token), gpu_mgr_);
+}
+
 }  // namespace Buffer_Namespace
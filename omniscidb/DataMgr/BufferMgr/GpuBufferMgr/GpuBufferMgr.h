@@ -33,18 +33,25 @@ class GpuBufferMgr : public BufferMgr {
   inline MgrType getMgrType() override { return GPU_MGR; }
   inline std::string getStringMgrType() override { return ToString(GPU_MGR); }
   std::unique_ptr<AbstractDataToken> getZeroCopyBufferMemory(const ChunkKey& key,
-                                                             size_t numBytes) override {
-    return nullptr;
-  }
+                                                             size_t numBytes) override;
   ~GpuBufferMgr() override;
 
+  // Map host buffers of the storage into kernels instead of copying them. Requires
+  // devices with unified memory.
+  void setZeroCopyFromHost(bool enable) { zero_copy_from_host_ = enable; }
+  bool isZeroCopyFromHost() const { return zero_copy_from_host_; }
+
  private:
   void addSlab(const size_t slab_size) override;
   void freeAllMem() override;
   void allocateBuffer(BufferList::iterator seg_it,
                       const size_t page_size,
                       const size_t initial_size) override;
+  AbstractBuffer* allocateZeroCopyBuffer(
+      const size_t page_size,
+      std::unique_ptr<AbstractDataToken> token) override;
   GpuMgr* gpu_mgr_;
+  bool zero_copy_from_host_ = false;
 };
 
 }  // namespace Buffer_Namespace
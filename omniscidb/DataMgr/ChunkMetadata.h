@@ -21,6 +21,7 @@
 #include "IR/Type.h"
 #include "Shared/types.h"
 
+#include <array>
 #include <functional>
 #include <map>
 
@@ -155,6 +156,55 @@ inline void mergeStats(ChunkStats& lhs,
   }
 }
 
+// A small Bloom filter of dictionary ids stored in a chunk of a dictionary encoded
+// column. It complements the min/max ids in ChunkStats when the chunk's ids are spread
+// over a wide range.
+class DictIdFilter {
+ public:
+  static constexpr size_t kNumBits = 1024;
+
+  void add(const int32_t id) {
+    setBit(hash1(id));
+    setBit(hash2(id));
+  }
+
+  bool mayContain(const int32_t id) const {
+    return testBit(hash1(id)) && testBit(hash2(id));
+  }
+
+  void merge(const DictIdFilter& other) {
+    for (size_t i = 0; i < bits_.size(); ++i) {
+      bits_[i] |= other.bits_[i];
+    }
+  }
+
+  // A filter with most bits set passes almost any id and is not worth keeping.
+  bool isSaturated() const {
+    size_t num_set = 0;
+    for (auto word : bits_) {
+      num_set += __builtin_popcountll(word);
+    }
+    return num_set * 4 > kNumBits * 3;
+  }
+
+ private:
+  static size_t hash1(const int32_t id) {
+    return (static_cast<uint32_t>(id) * 0x9E3779B1U) >> 22;
+  }
+
+  static size_t hash2(const int32_t id) {
+    return (static_cast<uint32_t>(id) * 0x85EBCA6BU + 0xC2B2AE35U) >> 22;
+  }
+
+  void setBit(const size_t bit) { bits_[bit / 64] |= uint64_t(1) << (bit % 64); }
+
+  bool testBit(const size_t bit) const {
+    return bits_[bit / 64] & (uint64_t(1) << (bit % 64));
+  }
+
+  std::array<uint64_t, kNumBits / 64> bits_{};
+};
+
 class ChunkMetadata {
  public:
   using StatsMaterializeFn = std::function<void(ChunkStats&)>;
@@ -190,6 +240,13 @@ class ChunkMetadata {
     return chunk_stats_;
   }
 
+  // Not every storage provides the dictionary id filter, nullptr means any id may be
+  // in the chunk.
+  const DictIdFilter* dictIdFilter() const { return dict_id_filter_.get(); }
+  void setDictIdFilter(std::shared_ptr<const DictIdFilter> filter) {
+    dict_id_filter_ = std::move(filter);
+  }
+
 #ifndef __CUDACC__
   std::string dump() const {
     std::string res = "type: " + type_->toString() +
@@ -283,6 +340,7 @@ class ChunkMetadata {
   size_t num_elements_;
   mutable ChunkStats chunk_stats_;
   mutable StatsMaterializeFn stats_materialize_fn_;
+  std::shared_ptr<const DictIdFilter> dict_id_filter_;
 };
 
 inline int64_t extract_min_stat_int_type(const ChunkStats& stats,
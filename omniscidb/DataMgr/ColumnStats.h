@@ -0,0 +1,99 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+// Table level statistics of a column maintained by a storage on import and append.
+// The number of distinct values is estimated with a HyperLogLog sketch, so statistics
+// of appended rows are merged without scanning the whole column.
+class ColumnStats {
+ public:
+  // 2^11 registers give ~2.3% standard error.
+  static constexpr uint32_t kSketchBits = 11;
+  static constexpr size_t kNumRegisters = size_t(1) << kSketchBits;
+
+  void addValue(const int64_t val) {
+    const uint64_t hash = mix(static_cast<uint64_t>(val));
+    const auto idx = hash >> (64 - kSketchBits);
+    const auto rest = hash << kSketchBits;
+    const uint8_t rank =
+        rest ? std::min(64 - kSketchBits, uint32_t(__builtin_clzll(rest))) + 1
+             : 64 - kSketchBits + 1;
+    registers_[idx] = std::max(registers_[idx], rank);
+    ++row_count_;
+  }
+
+  void addNulls(const size_t count) {
+    null_count_ += count;
+    row_count_ += count;
+  }
+
+  void merge(const ColumnStats& other) {
+    for (size_t i = 0; i < kNumRegisters; ++i) {
+      registers_[i] = std::max(registers_[i], other.registers_[i]);
+    }
+    row_count_ += other.row_count_;
+    null_count_ += other.null_count_;
+  }
+
+  size_t rowCount() const { return row_count_; }
+  size_t nullCount() const { return null_count_; }
+
+  double nullFraction() const {
+    return row_count_ ? static_cast<double>(null_count_) / row_count_ : 0.0;
+  }
+
+  // Estimated number of distinct non-null values.
+  size_t distinctCount() const {
+    const size_t non_null_count = row_count_ - null_count_;
+    if (!non_null_count) {
+      return 0;
+    }
+    double sum = 0.0;
+    size_t zeros = 0;
+    for (auto reg : registers_) {
+      sum += std::ldexp(1.0, -static_cast<int>(reg));
+      zeros += reg == 0;
+    }
+    constexpr double m = kNumRegisters;
+    double estimate = 0.7213 / (1 + 1.079 / m) * m * m / sum;
+    if (estimate <= 2.5 * m && zeros) {
+      // Linear counting is more precise for small cardinalities.
+      estimate = m * std::log(m / zeros);
+    }
+    return std::clamp(
+        static_cast<size_t>(std::llround(estimate)), size_t(1), non_null_count);
+  }
+
+ private:
+  // Consecutive keys must spread over registers, so values are mixed before use.
+  static uint64_t mix(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+  }
+
+  std::array<uint8_t, kNumRegisters> registers_{};
+  size_t row_count_{0};
+  size_t null_count_{0};
+};
@@ -60,9 +60,16 @@ DataMgr::DataMgr(const Config& config, const size_t numReaderThreads)
     , data_provider_(std::make_unique<DataMgrDataProvider>(this)) {
   populateDeviceMgrs(config);
   populateMgrs(config, numReaderThreads);
+  if (has_gpus_ && config.mem.gpu.thrust_scratch_pool_size) {
+    thrust_scratch_pool_ = std::make_unique<ThrustScratchPool>(
+        buffer_provider_.get(), config.mem.gpu.thrust_scratch_pool_size);
+  }
 }
 
 DataMgr::~DataMgr() {
+  // Cached scratch buffers have to go back to the buffer managers before they are
+  // destroyed.
+  thrust_scratch_pool_.reset();
   for (auto& [p, ctx] : device_contexts_) {
     for (size_t device = 0; device < ctx->buffer_mgrs.size(); device++) {
       delete ctx->buffer_mgrs[device];
@@ -160,6 +167,9 @@ size_t DataMgr::getTotalSystemMemory() {
 
 void DataMgr::allocateCpuBufferMgr(int32_t device_id,
                                    bool enable_tiered_cpu_mem,
+                                   bool enable_numa_aware_slabs,
+                                   size_t pinned_slabs_size,
+                                   bool enable_huge_pages,
                                    size_t total_cpu_size,
                                    size_t minCpuSlabSize,
                                    size_t maxCpuSlabSize,
@@ -177,7 +187,8 @@ void DataMgr::allocateCpuBufferMgr(int32_t device_id,
             maxCpuSlabSize,
             page_size,
             cpu_tier_sizes,
-            bufferMgrs_[MemoryLevel::DISK_LEVEL][0]));
+            bufferMgrs_[MemoryLevel::DISK_LEVEL][0],
+            pinned_slabs_size));
   } else {
     bufferMgrs_[MemoryLevel::CPU_LEVEL].push_back(
         new Buffer_Namespace::CpuBufferMgr(0,
@@ -186,7 +197,10 @@ void DataMgr::allocateCpuBufferMgr(int32_t device_id,
                                            minCpuSlabSize,
                                            maxCpuSlabSize,
                                            page_size,
-                                           bufferMgrs_[MemoryLevel::DISK_LEVEL][0]));
+                                           bufferMgrs_[MemoryLevel::DISK_LEVEL][0],
+                                           enable_numa_aware_slabs,
+                                           pinned_slabs_size,
+                                           enable_huge_pages));
   }
 }
 
@@ -197,7 +211,8 @@ void DataMgr::populateDeviceMgrs(const Config& config) {
 #ifdef HAVE_CUDA
   try {
     device_mgrs_[GpuMgrPlatform::CUDA] =
-        std::make_unique<CudaMgr_Namespace::CudaMgr>(-1, 0);
+        std::make_unique<CudaMgr_Namespace::CudaMgr>(
+            -1, 0, config.exec.enable_gpu_transfer_overlap);
   } catch (const std::exception& e) {
     LOG(ERROR) << "Failed to initialize CUDA GPU: " << e.what();
     device_mgrs_.erase(GpuMgrPlatform::CUDA);
@@ -205,7 +220,9 @@ void DataMgr::populateDeviceMgrs(const Config& config) {
 #endif
 #ifdef HAVE_L0
   try {
-    device_mgrs_[GpuMgrPlatform::L0] = std::make_unique<l0::L0Manager>();
+    device_mgrs_[GpuMgrPlatform::L0] =
+        std::make_unique<l0::L0Manager>(config.exec.enable_gpu_transfer_overlap,
+                                        config.exec.enable_l0_sub_devices);
   } catch (const std::exception& e) {
     LOG(ERROR) << "Failed to initialize L0 GPU: " << e.what();
     device_mgrs_.erase(GpuMgrPlatform::L0);
@@ -267,6 +284,9 @@ void DataMgr::populateMgrs(const Config& config,
     levelSizes_.resize(3);
     allocateCpuBufferMgr(0,
                          config.mem.cpu.enable_tiered_cpu_mem,
+                         config.mem.cpu.enable_numa_aware_slabs,
+                         config.mem.cpu.pinned_slabs_size,
+                         config.mem.cpu.enable_huge_pages,
                          total_cpu_size,
                          minCpuSlabSize,
                          maxCpuSlabSize,
@@ -281,6 +301,12 @@ void DataMgr::populateMgrs(const Config& config,
       device_context->gpu_mgr = mgr.get();
       int num_gpus = mgr->getDeviceCount();
       device_context->gpu_count = num_gpus;
+      const bool zero_copy_from_host =
+          config.mem.gpu.enable_unified_memory_zero_copy && mgr->hasUnifiedMemory();
+      if (zero_copy_from_host) {
+        LOG(INFO) << "GPU devices share memory with the host, input buffers won't be "
+                     "copied to GPU memory when possible.";
+      }
       for (int gpu_num = 0; gpu_num < num_gpus; ++gpu_num) {
         size_t device_mem_size = 0;
         // TODO: get rid of manager-specific branches by introducing some kind of device
@@ -314,14 +340,19 @@ void DataMgr::populateMgrs(const Config& config,
         LOG(INFO) << "Max memory pool size for GPU " << gpu_num << " is "
                   << (float)gpu_max_mem_size / (1024 * 1024) << "MB";
 
-        device_context->buffer_mgrs.push_back(
+        auto gpu_buffer_mgr =
             new Buffer_Namespace::GpuBufferMgr(gpu_num,
                                                gpu_max_mem_size,
                                                mgr.get(),
                                                minGpuSlabSize,
                                                maxGpuSlabSize,
                                                page_size,
-                                               bufferMgrs_[MemoryLevel::CPU_LEVEL][0]));
+                                               bufferMgrs_[MemoryLevel::CPU_LEVEL][0]);
+        if (config.mem.gpu.enable_cost_aware_eviction) {
+          gpu_buffer_mgr->setEvictionPolicy(Buffer_Namespace::EvictionPolicy::kCostAware);
+        }
+        gpu_buffer_mgr->setZeroCopyFromHost(zero_copy_from_host);
+        device_context->buffer_mgrs.push_back(gpu_buffer_mgr);
       }
     }
     if (auto platform = fromString(config.exec.initialize_with_gpu_vendor)) {
@@ -333,12 +364,27 @@ void DataMgr::populateMgrs(const Config& config,
   } else {
     allocateCpuBufferMgr(0,
                          config.mem.cpu.enable_tiered_cpu_mem,
+                         config.mem.cpu.enable_numa_aware_slabs,
+                         config.mem.cpu.pinned_slabs_size,
+                         config.mem.cpu.enable_huge_pages,
                          total_cpu_size,
                          minCpuSlabSize,
                          maxCpuSlabSize,
                          page_size,
                          cpu_tier_sizes);
   }
+
+  if (config.mem.cpu.prefault_size) {
+    getCpuBufferMgr()->prefault(config.mem.cpu.prefault_size);
+  }
+
+  if (config.mem.cpu.enable_tiered_cpu_mem && config.mem.cpu.tier_migration_interval_ms) {
+    auto tiered_mgr =
+        dynamic_cast<Buffer_Namespace::TieredCpuBufferMgr*>(getCpuBufferMgr());
+    CHECK(tiered_mgr);
+    tiered_mgr->startChunkMigration(config.mem.cpu.tier_migration_interval_ms,
+                                    config.mem.cpu.tier_migration_max_bytes);
+  }
 }
 
 std::vector<Buffer_Namespace::MemoryInfo> DataMgr::getMemoryInfo(
@@ -382,6 +428,10 @@ void DataMgr::clearMemory(const MemoryLevel memLevel) {
   // if gpu we need to iterate through all the buffermanagers for each card
   if (memLevel == MemoryLevel::GPU_LEVEL) {
     if (has_gpus_) {
+      // Cached scratch buffers are pinned and would keep slabs from being freed.
+      if (thrust_scratch_pool_) {
+        thrust_scratch_pool_->clear();
+      }
       int num_gpus = getGpuMgr()->getDeviceCount();
       for (int gpu_num = 0; gpu_num < num_gpus; ++gpu_num) {
         LOG(INFO) << "clear slabs on gpu " << gpu_num;
@@ -401,6 +451,16 @@ void DataMgr::clearMemory(const MemoryLevel memLevel) {
   }
 }
 
+void DataMgr::addGpuResidentTable(int db_id, int table_id) {
+  for (auto& [platform, ctx] : device_contexts_) {
+    for (auto buffer_mgr : ctx->buffer_mgrs) {
+      auto gpu_buffer_mgr = dynamic_cast<Buffer_Namespace::BufferMgr*>(buffer_mgr);
+      CHECK(gpu_buffer_mgr);
+      gpu_buffer_mgr->addResidentTable(db_id, table_id);
+    }
+  }
+}
+
 bool DataMgr::isBufferOnDevice(const ChunkKey& key,
                                const MemoryLevel memLevel,
                                const int deviceId) {
@@ -458,6 +518,26 @@ AbstractBuffer* DataMgr::getChunkBuffer(const ChunkKey& key,
   return bufferMgrs_[level][deviceId]->getBuffer(key, numBytes);
 }
 
+AbstractBuffer* DataMgr::getCachedChunkBuffer(const ChunkKey& key,
+                                              const MemoryLevel memoryLevel,
+                                              const int deviceId) {
+  const auto level = static_cast<size_t>(memoryLevel);
+  CHECK_LT(level, levelSizes_.size());
+  CHECK_LT(deviceId, levelSizes_[level]);
+  auto buffer_mgr = dynamic_cast<Buffer_Namespace::BufferMgr*>(
+      bufferMgrs_[level][deviceId]);
+  CHECK(buffer_mgr);
+  return buffer_mgr->getCachedBuffer(key);
+}
+
+bool DataMgr::registerChunkBuffer(AbstractBuffer* buffer, const ChunkKey& key) {
+  int level = static_cast<int>(buffer->getType());
+  auto buffer_mgr = dynamic_cast<Buffer_Namespace::BufferMgr*>(
+      bufferMgrs_[level][buffer->getDeviceId()]);
+  CHECK(buffer_mgr);
+  return buffer_mgr->registerBuffer(buffer, key);
+}
+
 void DataMgr::deleteChunksWithPrefix(const ChunkKey& keyPrefix) {
   int numLevels = bufferMgrs_.size();
   for (int level = numLevels - 1; level >= 0; --level) {
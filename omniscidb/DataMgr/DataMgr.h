@@ -23,12 +23,14 @@
 
 #include "AbstractBuffer.h"
 #include "AbstractBufferMgr.h"
+#include "Allocators/ThrustScratchPool.h"
 #include "BufferMgr/Buffer.h"
 #include "BufferMgr/BufferMgr.h"
 #include "DataMgr/DataMgrBufferProvider.h"
 #include "DataMgr/DataMgrDataProvider.h"
 #include "GpuMgrContext.h"
 #include "L0Mgr/L0Mgr.h"
+#include "MemoryAccounting.h"
 #include "MemoryLevel.h"
 #include "OSDependent/omnisci_fs.h"
 #include "PersistentStorageMgr/PersistentStorageMgr.h"
@@ -177,6 +179,14 @@ class DataMgr {
                                  const MemoryLevel memoryLevel,
                                  const int deviceId = 0,
                                  const size_t numBytes = 0);
+  // Returns the pinned chunk buffer if it is in the pool of the memory level. Never
+  // fetches the chunk from storage.
+  AbstractBuffer* getCachedChunkBuffer(const ChunkKey& key,
+                                       const MemoryLevel memoryLevel,
+                                       const int deviceId = 0);
+  // Makes a buffer from alloc() a chunk buffer with the key, so it stays in the pool
+  // after unpinning until evicted. Returns false if the key is already in use.
+  bool registerChunkBuffer(AbstractBuffer* buffer, const ChunkKey& key);
   void deleteChunksWithPrefix(const ChunkKey& keyPrefix);
   void deleteChunksWithPrefix(const ChunkKey& keyPrefix, const MemoryLevel memLevel);
   AbstractBuffer* alloc(const MemoryLevel memoryLevel,
@@ -191,6 +201,9 @@ class DataMgr {
   std::vector<Buffer_Namespace::MemoryInfo> getMemoryInfo(const MemoryLevel memLevel);
   std::string dumpLevel(const MemoryLevel memLevel);
   void clearMemory(const MemoryLevel memLevel);
+  // Keep buffers of the table in GPU memory as long as possible. Used by the
+  // cost-aware GPU eviction policy only.
+  void addGpuResidentTable(int db_id, int table_id);
 
   const std::map<ChunkKey, File_Namespace::FileBuffer*>& getChunkMap();
   void getChunkMetadataVecForKeyPrefix(ChunkMetadataVector& chunkMetadataVec,
@@ -233,11 +246,18 @@ class DataMgr {
 
   DataProvider* getDataProvider() const { return data_provider_.get(); }
 
+  MemoryAccounting* getMemoryAccounting() { return &memory_accounting_; }
+
+  ThrustScratchPool* getThrustScratchPool() const { return thrust_scratch_pool_.get(); }
+
  private:
   void populateDeviceMgrs(const Config& config);
   void populateMgrs(const Config& config, const size_t userSpecifiedNumReaderThreads);
   void allocateCpuBufferMgr(int32_t device_id,
                             bool enable_tiered_cpu_mem,
+                            bool enable_numa_aware_slabs,
+                            size_t pinned_slabs_size,
+                            bool enable_huge_pages,
                             size_t total_cpu_size,
                             size_t minCpuSlabSize,
                             size_t maxCpuSlabSize,
@@ -253,6 +273,8 @@ class DataMgr {
   size_t reservedGpuMem_;
   std::unique_ptr<DataMgrBufferProvider> buffer_provider_;
   std::unique_ptr<DataMgrDataProvider> data_provider_;
+  MemoryAccounting memory_accounting_;
+  std::unique_ptr<ThrustScratchPool> thrust_scratch_pool_;
 };
 
 std::ostream& operator<<(std::ostream& os, const DataMgr::SystemMemoryUsage&);
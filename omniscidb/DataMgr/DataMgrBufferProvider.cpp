@@ -74,3 +74,8 @@ void DataMgrBufferProvider::setContext(const int device_id) {
   CHECK(gpu_mgr);
   gpu_mgr->setContext(device_id);
 }
+
+ThrustScratchPool* DataMgrBufferProvider::getThrustScratchPool() const {
+  CHECK(data_mgr_);
+  return data_mgr_->getThrustScratchPool();
+}
@@ -47,6 +47,7 @@ class DataMgrBufferProvider : public BufferProvider {
                     const size_t num_bytes,
                     const int device_id) const override;
   void setContext(const int device_id) override;
+  ThrustScratchPool* getThrustScratchPool() const override;
 
  private:
   DataMgr* data_mgr_;
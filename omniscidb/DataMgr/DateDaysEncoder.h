@@ -101,18 +101,16 @@ class DateDaysEncoder : public Encoder {
         std::tuple(dataMin, dataMax, has_nulls),
         [&](const auto& range, auto init) {
           auto [min, max, nulls] = init;
-          for (size_t i = range.begin(); i < range.end(); i++) {
-            if (data[i] != inline_null_value<V>()) {
-              if (!fixlen_array || data[i] != inline_null_array_value<V>()) {
-                const T val = DateConverters::get_epoch_seconds_from_days(data[i]);
-                min = std::min(min, val);
-                max = std::max(max, val);
-              }
-            } else {
-              nulls = true;
-            }
+          const auto [range_min, range_max, range_nulls] = compute_min_max_nulls(
+              data + range.begin(), range.size(), fixlen_array);
+          if (range_min <= range_max) {
+            // The conversion is monotonic, so only the bounds are converted.
+            const T min_val = DateConverters::get_epoch_seconds_from_days(range_min);
+            const T max_val = DateConverters::get_epoch_seconds_from_days(range_max);
+            min = std::min(min, min_val);
+            max = std::max(max, max_val);
           }
-          return std::tuple(min, max, nulls);
+          return std::tuple(min, max, nulls || range_nulls);
         },
         [&](auto lhs, auto rhs) {
           const auto [lhs_min, lhs_max, lhs_nulls] = lhs;
@@ -21,6 +21,8 @@
 #include <iostream>
 #include <limits>
 #include <stdexcept>
+#include <tuple>
+#include <type_traits>
 #include <vector>
 
 #include "ChunkMetadata.h"
@@ -91,6 +93,46 @@ class DecimalOverflowValidator {
   int pow10_;
 };
 
+// Min and max of non-null values and presence of nulls in a single pass. For integers
+// the loop is branch-free with skipped values replaced by the neutral ones using bit
+// masks, so compilers vectorize it. Min is greater than max if there are no non-null
+// values.
+template <typename T>
+std::tuple<T, T, bool> compute_min_max_nulls(const T* data,
+                                             const size_t num_elements,
+                                             const bool fixlen_array) {
+  const T null_val = inline_null_value<T>();
+  const T null_array_val = fixlen_array ? inline_null_array_value<T>() : null_val;
+  const T min_init = std::numeric_limits<T>::max();
+  const T max_init = std::numeric_limits<T>::lowest();
+  T min = min_init;
+  T max = max_init;
+  if constexpr (std::is_integral_v<T>) {
+    T nulls = 0;
+    for (size_t i = 0; i < num_elements; ++i) {
+      const T val = data[i];
+      const T is_null = val == null_val;
+      const T skip_mask = -(is_null | static_cast<T>(val == null_array_val));
+      nulls |= is_null;
+      min = std::min(min, static_cast<T>((val & ~skip_mask) | (min_init & skip_mask)));
+      max = std::max(max, static_cast<T>((val & ~skip_mask) | (max_init & skip_mask)));
+    }
+    return {min, max, nulls != 0};
+  } else {
+    bool nulls = false;
+    for (size_t i = 0; i < num_elements; ++i) {
+      const T val = data[i];
+      if (val == null_val) {
+        nulls = true;
+      } else if (val != null_array_val) {
+        min = std::min(min, val);
+        max = std::max(max, val);
+      }
+    }
+    return {min, max, nulls};
+  }
+}
+
 template <typename INNER_VALIDATOR>
 class NullAwareValidator {
  public:
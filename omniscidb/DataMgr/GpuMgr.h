@@ -50,6 +50,9 @@ struct GpuMgr {
                             const int device_num) = 0;
   virtual int8_t* allocateDeviceMem(const size_t num_bytes, const int device_num) = 0;
   virtual void freeDeviceMem(int8_t* device_ptr) = 0;
+  // Page-locked host memory which can be used for DMA transfers without staging.
+  virtual int8_t* allocatePinnedHostMem(const size_t num_bytes) = 0;
+  virtual void freePinnedHostMem(int8_t* host_ptr) = 0;
   // `setContext()` method seems redundant as we already pass an actual context via
   // parameter `device_num` into every manager's method, maybe we should remove
   // `setContext()`?
@@ -63,4 +66,7 @@ struct GpuMgr {
   virtual uint32_t getMinEUNumForAllDevices() const = 0;
   virtual bool hasSharedMemoryAtomicsSupport() const = 0;
   virtual size_t getMinSharedMemoryPerBlockForAllDevices() const = 0;
+  // True if all devices share physical memory with the host and can access pageable
+  // host memory directly, so kernels can read host buffers without copies.
+  virtual bool hasUnifiedMemory() const = 0;
 };
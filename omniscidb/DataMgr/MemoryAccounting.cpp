@@ -0,0 +1,116 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DataMgr/MemoryAccounting.h"
+#include "Logger/Logger.h"
+
+#include <sstream>
+
+namespace Data_Namespace {
+
+uint64_t MemoryAccounting::beginQuery() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto query_id = next_query_id_++;
+  running_[query_id].query_id = query_id;
+  return query_id;
+}
+
+void MemoryAccounting::endQuery(uint64_t query_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = running_.find(query_id);
+  CHECK(it != running_.end());
+  auto& stats = it->second;
+  // Memory still accounted to the query is released together with its owner.
+  for (size_t level = 0; level < levels_.size(); ++level) {
+    CHECK_GE(levels_[level].current, stats.levels[level].current);
+    levels_[level].current -= stats.levels[level].current;
+    stats.levels[level].current = 0;
+  }
+  stats.finished = true;
+  finished_.push_back(stats);
+  running_.erase(it);
+  while (finished_.size() > max_finished_queries_) {
+    finished_.pop_front();
+  }
+}
+
+void MemoryAccounting::allocated(uint64_t query_id, MemoryLevel level, size_t bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = running_.find(query_id);
+  CHECK(it != running_.end());
+  auto& usage = it->second.levels[level];
+  usage.current += bytes;
+  usage.peak = std::max(usage.peak, usage.current);
+  levels_[level].current += bytes;
+  levels_[level].peak = std::max(levels_[level].peak, levels_[level].current);
+}
+
+void MemoryAccounting::freed(uint64_t query_id, MemoryLevel level, size_t bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = running_.find(query_id);
+  CHECK(it != running_.end());
+  auto& usage = it->second.levels[level];
+  CHECK_GE(usage.current, bytes);
+  usage.current -= bytes;
+  levels_[level].current -= bytes;
+}
+
+std::optional<QueryMemoryStats> MemoryAccounting::getQueryStats(
+    uint64_t query_id) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = running_.find(query_id);
+  if (it != running_.end()) {
+    return it->second;
+  }
+  for (auto& stats : finished_) {
+    if (stats.query_id == query_id) {
+      return stats;
+    }
+  }
+  return std::nullopt;
+}
+
+std::vector<QueryMemoryStats> MemoryAccounting::getQueryStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<QueryMemoryStats> res;
+  res.reserve(running_.size() + finished_.size());
+  for (auto& [query_id, stats] : running_) {
+    res.push_back(stats);
+  }
+  res.insert(res.end(), finished_.begin(), finished_.end());
+  return res;
+}
+
+MemoryUsage MemoryAccounting::getLevelUsage(MemoryLevel level) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return levels_[level];
+}
+
+std::string MemoryAccounting::toString() const {
+  std::stringstream ss;
+  ss << "MemoryAccounting:\n";
+  for (auto level : {CPU_LEVEL, GPU_LEVEL}) {
+    auto usage = getLevelUsage(level);
+    ss << "  " << (level == CPU_LEVEL ? "CPU" : "GPU") << ": current=" << usage.current
+       << " peak=" << usage.peak << "\n";
+  }
+  for (auto& stats : getQueryStats()) {
+    ss << "  query " << stats.query_id << (stats.finished ? " (finished)" : "")
+       << ": CPU peak=" << stats.get(CPU_LEVEL).peak
+       << " GPU peak=" << stats.get(GPU_LEVEL).peak << "\n";
+  }
+  return ss.str();
+}
+
+}  // namespace Data_Namespace
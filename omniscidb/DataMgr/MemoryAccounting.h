@@ -0,0 +1,104 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "DataMgr/MemoryLevel.h"
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Data_Namespace {
+
+struct MemoryUsage {
+  size_t current = 0;
+  size_t peak = 0;
+};
+
+struct QueryMemoryStats {
+  uint64_t query_id;
+  bool finished = false;
+  // Indexed by MemoryLevel.
+  std::array<MemoryUsage, 3> levels;
+
+  const MemoryUsage& get(MemoryLevel level) const { return levels[level]; }
+};
+
+/**
+ * Accounts memory allocated on behalf of queries, e.g. result set buffers and
+ * temporary GPU buffers. Usage is tracked per query and per memory level. Chunks
+ * cached by buffer managers are shared between queries and are not accounted here.
+ *
+ * Stats of finished queries are kept for a limited number of recent queries.
+ */
+class MemoryAccounting {
+ public:
+  MemoryAccounting(size_t max_finished_queries = 64)
+      : max_finished_queries_(max_finished_queries) {}
+
+  uint64_t beginQuery();
+  void endQuery(uint64_t query_id);
+
+  void allocated(uint64_t query_id, MemoryLevel level, size_t bytes);
+  void freed(uint64_t query_id, MemoryLevel level, size_t bytes);
+
+  std::optional<QueryMemoryStats> getQueryStats(uint64_t query_id) const;
+  // Stats of running queries followed by recently finished ones.
+  std::vector<QueryMemoryStats> getQueryStats() const;
+  // Usage of memory allocated by all queries.
+  MemoryUsage getLevelUsage(MemoryLevel level) const;
+
+  std::string toString() const;
+
+ private:
+  const size_t max_finished_queries_;
+  mutable std::mutex mutex_;
+  uint64_t next_query_id_ = 1;
+  std::map<uint64_t, QueryMemoryStats> running_;
+  std::deque<QueryMemoryStats> finished_;
+  std::array<MemoryUsage, 3> levels_;
+};
+
+/**
+ * Accounts allocations of a single query, ends the query on destruction.
+ */
+class QueryMemoryTracker {
+ public:
+  QueryMemoryTracker(MemoryAccounting* accounting)
+      : accounting_(accounting), query_id_(accounting->beginQuery()) {}
+
+  ~QueryMemoryTracker() { accounting_->endQuery(query_id_); }
+
+  uint64_t queryId() const { return query_id_; }
+
+  void allocated(MemoryLevel level, size_t bytes) {
+    accounting_->allocated(query_id_, level, bytes);
+  }
+
+  void freed(MemoryLevel level, size_t bytes) {
+    accounting_->freed(query_id_, level, bytes);
+  }
+
+ private:
+  MemoryAccounting* accounting_;
+  const uint64_t query_id_;
+};
+
+}  // namespace Data_Namespace
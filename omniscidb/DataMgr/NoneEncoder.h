@@ -91,18 +91,16 @@ class NoneEncoder : public Encoder {
         std::tuple(dataMin, dataMax, has_nulls),
         [&](const auto& range, auto init) {
           auto [min, max, nulls] = init;
-          for (size_t i = range.begin(); i < range.end(); i++) {
-            if (data[i] != inline_null_value<T>()) {
-              if (!fixlen_array || data[i] != inline_null_array_value<T>()) {
-                decimal_overflow_validator_.validate(data[i]);
-                min = std::min(min, data[i]);
-                max = std::max(max, data[i]);
-              }
-            } else {
-              nulls = true;
-            }
+          const auto [range_min, range_max, range_nulls] = compute_min_max_nulls(
+              data + range.begin(), range.size(), fixlen_array);
+          if (range_min <= range_max) {
+            // Checking the bounds is enough for the range check of decimals.
+            decimal_overflow_validator_.validate(range_min);
+            decimal_overflow_validator_.validate(range_max);
+            min = std::min(min, range_min);
+            max = std::max(max, range_max);
           }
-          return std::tuple(min, max, nulls);
+          return std::tuple(min, max, nulls || range_nulls);
         },
         [&](auto lhs, auto rhs) {
           const auto [lhs_min, lhs_max, lhs_nulls] = lhs;
@@ -17,13 +17,16 @@
 #pragma once
 
 #include "DataMgr/ChunkMetadata.h"
+#include "DataMgr/ColumnStats.h"
 #include "Shared/mapd_shared_mutex.h"
 #include "Shared/types.h"
 
 #include <deque>
 #include <list>
 #include <map>
+#include <memory>
 #include <mutex>
+#include <unordered_map>
 
 /**
  * @class FragmentInfo
@@ -37,16 +40,18 @@ class FragmentInfo {
   FragmentInfo() : fragmentId(-1), physicalTableId(-1), numTuples(0) {}
 
   void setChunkMetadataMap(const ChunkMetadataMap& chunk_metadata_map) {
-    this->chunkMetadataMap = chunk_metadata_map;
+    this->chunkMetadataMap = std::make_shared<ChunkMetadataMap>(chunk_metadata_map);
   }
 
   void setChunkMetadata(const int col, std::shared_ptr<ChunkMetadata> chunkMetadata) {
-    chunkMetadataMap[col] = chunkMetadata;
+    getMutableChunkMetadataMap()[col] = chunkMetadata;
   }
 
   const ChunkMetadataMap& getChunkMetadataMap() const;
 
-  const ChunkMetadataMap& getChunkMetadataMapPhysical() const { return chunkMetadataMap; }
+  const ChunkMetadataMap& getChunkMetadataMapPhysical() const {
+    return getChunkMetadataMap();
+  }
 
   ChunkMetadataMap getChunkMetadataMapPhysicalCopy() const;
 
@@ -63,8 +68,12 @@ class FragmentInfo {
   int physicalTableId;
 
  private:
+  ChunkMetadataMap& getMutableChunkMetadataMap();
+
   mutable size_t numTuples;
-  mutable ChunkMetadataMap chunkMetadataMap;
+  // Copies of fragment infos share the metadata map until one of them modifies it, so
+  // copying table metadata doesn't copy metadata maps of all fragments.
+  std::shared_ptr<ChunkMetadataMap> chunkMetadataMap;
 };
 
 class TableFragmentsInfo {
@@ -83,6 +92,8 @@ class TableFragmentsInfo {
 
   std::vector<int> chunkKeyPrefix;
   std::vector<FragmentInfo> fragments;
+  // Column id to statistics of the whole table. Not every storage provides them.
+  std::unordered_map<int, std::shared_ptr<const ColumnStats>> columnStats;
 
  private:
   mutable size_t numTuples;
@@ -141,7 +141,10 @@ void Node::print() const {
 }
 
 Project::Project(Project const& rhs)
-    : Node(rhs), exprs_(rhs.exprs_), fields_(rhs.fields_) {}
+    : Node(rhs)
+    , exprs_(rhs.exprs_)
+    , fields_(rhs.fields_)
+    , window_func_limits_(rhs.window_func_limits_) {}
 
 void Project::rewriteExprs(hdk::ir::ExprRewriter& rewriter) {
   for (size_t i = 0; i < exprs_.size(); ++i) {
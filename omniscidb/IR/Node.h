@@ -14,6 +14,8 @@
 #include "SchemaMgr/TableInfo.h"
 #include "Shared/Config.h"
 
+#include <map>
+
 class RaExecutionDesc;
 class ExecutionResult;
 
@@ -181,8 +183,16 @@ class Node {
 
   std::shared_ptr<const ExecutionResult> getResult() const { return result_; }
 
-  void setResult(std::shared_ptr<const ExecutionResult> result) const {
+  // Input tables state is a fingerprint of the physical input tables the result
+  // was computed for. Results with no state can't be reused by other queries.
+  void setResult(std::shared_ptr<const ExecutionResult> result,
+                 std::optional<size_t> input_tables_state = std::nullopt) const {
     result_ = result;
+    result_input_tables_state_ = input_tables_state;
+  }
+
+  const std::optional<size_t>& getResultInputTablesState() const {
+    return result_input_tables_state_;
   }
 
  protected:
@@ -197,6 +207,7 @@ class Node {
   static std::atomic<unsigned> crt_id_;
   mutable size_t dag_node_id_;
   mutable std::shared_ptr<const ExecutionResult> result_;
+  mutable std::optional<size_t> result_input_tables_state_;
 };
 
 inline std::string inputsToString(const NodeInputs& inputs) {
@@ -333,6 +344,18 @@ class Project : public Node {
 
   void appendInput(std::string new_field_name, ExprPtr expr);
 
+  // Per-partition limits of ROW_NUMBER and RANK window functions, keyed by the
+  // expression index. The only user of the node filters out rows ranked beyond the
+  // limit, so only rows within it need exact values. The other rows get limit + 1.
+  const std::map<size_t, size_t>& getWindowFunctionLimits() const {
+    return window_func_limits_;
+  }
+  void setWindowFunctionLimit(size_t idx, size_t limit) {
+    CHECK_LT(idx, exprs_.size());
+    window_func_limits_[idx] = limit;
+    hash_.reset();
+  }
+
   std::string toString() const override {
     return cat(::typeName(this),
                getIdString(),
@@ -340,6 +363,9 @@ class Project : public Node {
                ::toString(exprs_),
                ", ",
                ::toString(fields_),
+               window_func_limits_.empty()
+                   ? std::string()
+                   : ", window_func_limits=" + ::toString(window_func_limits_),
                ")");
   }
 
@@ -350,6 +376,10 @@ class Project : public Node {
         boost::hash_combine(*hash_, expr->hash());
       }
       boost::hash_combine(*hash_, ::toString(fields_));
+      for (auto& [idx, limit] : window_func_limits_) {
+        boost::hash_combine(*hash_, idx);
+        boost::hash_combine(*hash_, limit);
+      }
     }
     return *hash_;
   }
@@ -361,6 +391,7 @@ class Project : public Node {
  private:
   mutable ExprPtrVector exprs_;
   mutable std::vector<std::string> fields_;
+  std::map<size_t, size_t> window_func_limits_;
 };
 
 class Aggregate : public Node {
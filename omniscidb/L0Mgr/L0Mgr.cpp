@@ -26,7 +26,7 @@
 
 namespace l0 {
 
-L0Driver::L0Driver(ze_driver_handle_t handle) : driver_(handle) {
+L0Driver::L0Driver(ze_driver_handle_t handle, bool use_sub_devices) : driver_(handle) {
   ze_context_desc_t ctx_desc = {ZE_STRUCTURE_TYPE_CONTEXT_DESC, nullptr, 0};
   L0_SAFE_CALL(zeContextCreate(driver_, &ctx_desc, &context_));
 
@@ -39,7 +39,25 @@ L0Driver::L0Driver(ze_driver_handle_t handle) : driver_(handle) {
   for (auto device : devices) {
     ze_device_properties_t device_properties;
     L0_SAFE_CALL(zeDeviceGetProperties(device, &device_properties));
-    if (ZE_DEVICE_TYPE_GPU == device_properties.type) {
+    if (ZE_DEVICE_TYPE_GPU != device_properties.type) {
+      continue;
+    }
+
+    uint32_t sub_device_count = 0;
+    if (use_sub_devices) {
+      L0_SAFE_CALL(zeDeviceGetSubDevices(device, &sub_device_count, nullptr));
+    }
+    // Drivers with flat device hierarchy already report tiles as root devices
+    // without sub-devices.
+    if (sub_device_count > 1) {
+      std::vector<ze_device_handle_t> sub_devices(sub_device_count);
+      L0_SAFE_CALL(zeDeviceGetSubDevices(device, &sub_device_count, sub_devices.data()));
+      LOG(INFO) << "Using " << sub_device_count << " tiles of L0 device "
+                << device_properties.name << " as separate devices.";
+      for (auto sub_device : sub_devices) {
+        devices_.push_back(std::make_shared<L0Device>(*this, sub_device));
+      }
+    } else {
       devices_.push_back(std::make_shared<L0Device>(*this, device));
     }
   }
@@ -64,7 +82,7 @@ const std::vector<std::shared_ptr<L0Device>>& L0Driver::devices() const {
   return devices_;
 }
 
-std::vector<std::shared_ptr<L0Driver>> get_drivers() {
+std::vector<std::shared_ptr<L0Driver>> get_drivers(bool use_sub_devices) {
   L0_SAFE_CALL(zeInit(0));
   uint32_t driver_count = 0;
   L0_SAFE_CALL(zeDriverGet(&driver_count, nullptr));
@@ -76,7 +94,7 @@ std::vector<std::shared_ptr<L0Driver>> get_drivers() {
 
   std::vector<std::shared_ptr<L0Driver>> result(driver_count);
   for (uint32_t i = 0; i < driver_count; i++) {
-    result[i] = std::make_shared<L0Driver>(handles[i]);
+    result[i] = std::make_shared<L0Driver>(handles[i], use_sub_devices);
   }
   return result;
 }
@@ -146,11 +164,15 @@ L0Device::L0Device(const L0Driver& driver, ze_device_handle_t device)
                                                 ZE_COMMAND_QUEUE_PRIORITY_NORMAL};
   L0_SAFE_CALL(
       zeCommandQueueCreate(driver_.ctx(), device_, &command_queue_desc, &queue_handle));
+  ze_command_queue_handle_t copy_queue_handle;
+  L0_SAFE_CALL(zeCommandQueueCreate(
+      driver_.ctx(), device_, &command_queue_desc, &copy_queue_handle));
   L0_SAFE_CALL(zeDeviceGetProperties(device_, &props_));
   CHECK_EQ(ZE_DEVICE_TYPE_GPU, props_.type);
   L0_SAFE_CALL(zeDeviceGetComputeProperties(device_, &compute_props_));
 
   command_queue_ = std::make_shared<L0CommandQueue>(queue_handle);
+  copy_command_queue_ = std::make_shared<L0CommandQueue>(copy_queue_handle);
 }
 
 L0Device::~L0Device() {}
@@ -165,6 +187,10 @@ std::shared_ptr<L0CommandQueue> L0Device::command_queue() const {
   return command_queue_;
 }
 
+std::shared_ptr<L0CommandQueue> L0Device::copy_command_queue() const {
+  return copy_command_queue_;
+}
+
 std::unique_ptr<L0CommandList> L0Device::create_command_list() const {
   ze_command_list_desc_t desc = {
       ZE_STRUCTURE_TYPE_COMMAND_LIST_DESC,
@@ -184,6 +210,16 @@ uint32_t L0Device::maxGroupSize() const {
   return compute_props_.maxGroupSizeX;
 }
 
+bool L0Device::hasUnifiedMemory() const {
+  if (!(props_.flags & ZE_DEVICE_PROPERTY_FLAG_INTEGRATED)) {
+    return false;
+  }
+  ze_device_memory_access_properties_t mem_access_props{
+      ZE_STRUCTURE_TYPE_DEVICE_MEMORY_ACCESS_PROPERTIES};
+  L0_SAFE_CALL(zeDeviceGetMemoryAccessProperties(device_, &mem_access_props));
+  return mem_access_props.sharedSystemAllocCapabilities & ZE_MEMORY_ACCESS_CAP_FLAG_RW;
+}
+
 L0CommandQueue::L0CommandQueue(ze_command_queue_handle_t handle) : handle_(handle) {}
 
 ze_command_queue_handle_t L0CommandQueue::handle() const {
@@ -197,13 +233,18 @@ L0CommandQueue::~L0CommandQueue() {
   }
 }
 
-std::shared_ptr<L0Module> L0Device::create_module(uint8_t* code,
-                                                  size_t len,
-                                                  bool log) const {
+namespace {
+
+std::shared_ptr<L0Module> create_module_impl(ze_context_handle_t ctx,
+                                             ze_device_handle_t device,
+                                             ze_module_format_t format,
+                                             const uint8_t* code,
+                                             size_t len,
+                                             bool log) {
   ze_module_desc_t desc{
       .stype = ZE_STRUCTURE_TYPE_MODULE_DESC,
       .pNext = nullptr,
-      .format = ZE_MODULE_FORMAT_IL_SPIRV,
+      .format = format,
       .inputSize = len,
       .pInputModule = code,
       .pBuildFlags = "",
@@ -212,7 +253,7 @@ std::shared_ptr<L0Module> L0Device::create_module(uint8_t* code,
   ze_module_handle_t handle;
   ze_module_build_log_handle_t buildlog = nullptr;
 
-  auto status = zeModuleCreate(ctx(), device_, &desc, &handle, &buildlog);
+  auto status = zeModuleCreate(ctx, device, &desc, &handle, &buildlog);
   if (log) {
     size_t logSize = 0;
     L0_SAFE_CALL(zeModuleBuildLogGetString(buildlog, &logSize, nullptr));
@@ -227,7 +268,30 @@ std::shared_ptr<L0Module> L0Device::create_module(uint8_t* code,
   return L0Module::make(handle);
 }
 
-L0Manager::L0Manager() : drivers_(get_drivers()) {}
+}  // namespace
+
+std::shared_ptr<L0Module> L0Device::create_module(uint8_t* code,
+                                                  size_t len,
+                                                  bool log) const {
+  return create_module_impl(ctx(), device_, ZE_MODULE_FORMAT_IL_SPIRV, code, len, log);
+}
+
+std::shared_ptr<L0Module> L0Device::create_native_module(const uint8_t* binary,
+                                                         size_t len) const {
+  return create_module_impl(
+      ctx(), device_, ZE_MODULE_FORMAT_NATIVE, binary, len, /*log=*/false);
+}
+
+std::string L0Device::native_binary_tag() const {
+  ze_driver_properties_t driver_props{ZE_STRUCTURE_TYPE_DRIVER_PROPERTIES};
+  L0_SAFE_CALL(zeDriverGetProperties(driver_.driver(), &driver_props));
+  return std::string(props_.name) + ";vendor:" + std::to_string(props_.vendorId) +
+         ";device:" + std::to_string(props_.deviceId) +
+         ";driver:" + std::to_string(driver_props.driverVersion);
+}
+
+L0Manager::L0Manager(bool use_copy_queues, bool use_sub_devices)
+    : drivers_(get_drivers(use_sub_devices)), use_copy_queues_(use_copy_queues) {}
 
 const std::vector<std::shared_ptr<L0Driver>>& L0Manager::drivers() const {
   return drivers_;
@@ -242,6 +306,14 @@ ze_module_handle_t L0Module::handle() const {
   return handle_;
 }
 
+std::vector<uint8_t> L0Module::native_binary() const {
+  size_t size = 0;
+  L0_SAFE_CALL(zeModuleGetNativeBinary(handle_, &size, nullptr));
+  std::vector<uint8_t> binary(size);
+  L0_SAFE_CALL(zeModuleGetNativeBinary(handle_, &size, binary.data()));
+  return binary;
+}
+
 L0Module::~L0Module() {
   auto status = zeModuleDestroy(handle_);
   if (status) {
@@ -315,7 +387,7 @@ void L0Manager::copyHostToDevice(int8_t* device_ptr,
 
   auto& device = drivers()[0]->devices()[device_num];
   auto cl = device->create_command_list();
-  auto queue = device->command_queue();
+  auto queue = use_copy_queues_ ? device->copy_command_queue() : device->command_queue();
 
   cl->copy(device_ptr, host_ptr, num_bytes);
   cl->submit(*queue);
@@ -350,12 +422,20 @@ void L0Manager::copyDeviceToDevice(int8_t* dest_ptr,
 }
 
 int8_t* L0Manager::allocatePinnedHostMem(const size_t num_bytes) {
-  CHECK(false);
-  return nullptr;
+  ze_host_mem_alloc_desc_t alloc_desc;
+  alloc_desc.stype = ZE_STRUCTURE_TYPE_HOST_MEM_ALLOC_DESC;
+  alloc_desc.pNext = nullptr;
+  alloc_desc.flags = 0;
+
+  void* mem;
+  L0_SAFE_CALL(
+      zeMemAllocHost(drivers_[0]->ctx(), &alloc_desc, num_bytes, 0 /*align*/, &mem));
+  return reinterpret_cast<int8_t*>(mem);
 }
 
 void L0Manager::freePinnedHostMem(int8_t* host_ptr) {
-  CHECK(false);
+  CHECK(host_ptr);
+  L0_SAFE_CALL(zeMemFree(drivers_[0]->ctx(), host_ptr));
 }
 
 void L0Manager::freeDeviceMem(int8_t* device_ptr) {
@@ -447,4 +527,16 @@ size_t L0Manager::getMinSharedMemoryPerBlockForAllDevices() const {
   return 0;
 };
 
+bool L0Manager::hasUnifiedMemory() const {
+  if (drivers_.empty() || drivers_[0]->devices().empty()) {
+    return false;
+  }
+  for (auto& device : drivers_[0]->devices()) {
+    if (!device->hasUnifiedMemory()) {
+      return false;
+    }
+  }
+  return true;
+}
+
 }  // namespace l0
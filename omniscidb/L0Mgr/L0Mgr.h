@@ -17,6 +17,7 @@
 
 #include <iostream>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "DataMgr/GpuMgr.h"
@@ -42,7 +43,9 @@ class L0Driver {
 
  public:
 #ifdef HAVE_L0
-  explicit L0Driver(ze_driver_handle_t handle);
+  // With use_sub_devices, each sub-device (tile) of a multi-tile GPU is exposed as a
+  // separate device, so fragments are distributed across tiles as across GPUs.
+  L0Driver(ze_driver_handle_t handle, bool use_sub_devices);
   ze_context_handle_t ctx() const;
   ze_driver_handle_t driver() const;
   ~L0Driver();
@@ -66,19 +69,30 @@ class L0Device {
 
   const L0Driver& driver_;
   std::shared_ptr<L0CommandQueue> command_queue_;
+  // Queue for host-to-device copies which shouldn't wait for running kernels.
+  std::shared_ptr<L0CommandQueue> copy_command_queue_;
 
  public:
   std::shared_ptr<L0CommandQueue> command_queue() const;
+  std::shared_ptr<L0CommandQueue> copy_command_queue() const;
   std::unique_ptr<L0CommandList> create_command_list() const;
 
   std::shared_ptr<L0Module> create_module(uint8_t* code,
                                           size_t len,
                                           bool log = false) const;
+  // Create a module from a device binary previously obtained through
+  // L0Module::native_binary() for the same device and driver.
+  std::shared_ptr<L0Module> create_native_module(const uint8_t* binary,
+                                                 size_t len) const;
+  // Identifies device and driver for which native binaries are valid.
+  std::string native_binary_tag() const;
 
 #ifdef HAVE_L0
   L0Device(const L0Driver& driver, ze_device_handle_t device);
   uint32_t maxGroupCount() const;
   uint32_t maxGroupSize() const;
+  // Device is integrated and can access memory from system allocators.
+  bool hasUnifiedMemory() const;
   ze_device_handle_t device() const;
   ze_context_handle_t ctx() const;
   ~L0Device();
@@ -93,6 +107,7 @@ class L0Module : public std::enable_shared_from_this<L0Module> {
                                           uint32_t x,
                                           uint32_t y,
                                           uint32_t z) const;
+  std::vector<uint8_t> native_binary() const;
 #ifdef HAVE_L0
   static std::shared_ptr<L0Module> make(ze_module_handle_t handle) {
     return std::shared_ptr<L0Module>(new L0Module(handle));
@@ -197,7 +212,10 @@ void* allocate_device_mem(const size_t num_bytes, L0Device& device);
 
 class L0Manager : public GpuMgr {
  public:
-  L0Manager();
+  // If use_copy_queues is set, host-to-device copies are executed on dedicated
+  // command queues and don't wait for kernels running on the device. If
+  // use_sub_devices is set, tiles of multi-tile GPUs are used as separate devices.
+  L0Manager(bool use_copy_queues = false, bool use_sub_devices = false);
 
   void copyHostToDevice(int8_t* device_ptr,
                         const int8_t* host_ptr,
@@ -213,9 +231,9 @@ class L0Manager : public GpuMgr {
                           const int dest_device_num,
                           const int src_device_num) override;
 
-  int8_t* allocatePinnedHostMem(const size_t num_bytes);
+  int8_t* allocatePinnedHostMem(const size_t num_bytes) override;
   int8_t* allocateDeviceMem(const size_t num_bytes, const int device_num) override;
-  void freePinnedHostMem(int8_t* host_ptr);
+  void freePinnedHostMem(int8_t* host_ptr) override;
   void freeDeviceMem(int8_t* device_ptr) override;
   void zeroDeviceMem(int8_t* device_ptr,
                      const size_t num_bytes,
@@ -244,11 +262,13 @@ class L0Manager : public GpuMgr {
   virtual uint32_t getMinEUNumForAllDevices() const override;
   virtual bool hasSharedMemoryAtomicsSupport() const override;
   virtual size_t getMinSharedMemoryPerBlockForAllDevices() const override;
+  virtual bool hasUnifiedMemory() const override;
 
   const std::vector<std::shared_ptr<L0Driver>>& drivers() const;
 
  private:
   std::vector<std::shared_ptr<L0Driver>> drivers_;
+  bool use_copy_queues_ = false;
 };
 
 }  // namespace l0
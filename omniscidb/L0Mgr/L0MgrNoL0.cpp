@@ -28,6 +28,10 @@ std::shared_ptr<L0CommandQueue> L0Device::command_queue() const {
   CHECK(false);
   return nullptr;
 }
+std::shared_ptr<L0CommandQueue> L0Device::copy_command_queue() const {
+  CHECK(false);
+  return nullptr;
+}
 std::unique_ptr<L0CommandList> L0Device::create_command_list() const {
   CHECK(false);
   return nullptr;
@@ -40,6 +44,22 @@ std::shared_ptr<L0Module> L0Device::create_module(uint8_t* code,
   return nullptr;
 }
 
+std::shared_ptr<L0Module> L0Device::create_native_module(const uint8_t* binary,
+                                                         size_t len) const {
+  CHECK(false);
+  return nullptr;
+}
+
+std::string L0Device::native_binary_tag() const {
+  CHECK(false);
+  return "";
+}
+
+std::vector<uint8_t> L0Module::native_binary() const {
+  CHECK(false);
+  return {};
+}
+
 std::shared_ptr<L0Kernel> L0Module::create_kernel(const char* name,
                                                   uint32_t x,
                                                   uint32_t y,
@@ -61,7 +81,7 @@ void* allocate_device_mem(const size_t num_bytes, L0Device& device) {
   return nullptr;
 }
 
-L0Manager::L0Manager() {}
+L0Manager::L0Manager(bool, bool) {}
 
 void L0Manager::copyHostToDevice(int8_t* device_ptr,
                                  const int8_t* host_ptr,
@@ -148,6 +168,11 @@ size_t L0Manager::getMinSharedMemoryPerBlockForAllDevices() const {
   return 0u;
 };
 
+bool L0Manager::hasUnifiedMemory() const {
+  CHECK(false);
+  return false;
+}
+
 const std::vector<std::shared_ptr<L0Driver>>& L0Manager::drivers() const {
   return drivers_;
 }
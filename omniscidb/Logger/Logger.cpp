@@ -22,6 +22,7 @@ LOGGER_EXPORT bool g_enable_debug_timer{false};
 #ifndef __CUDACC__
 
 #include "Logger.h"
+#include "Trace.h"
 
 #include <rapidjson/document.h>
 #include <rapidjson/stringbuffer.h>
@@ -762,11 +763,13 @@ void logAndEraseDurationTree(std::string* json_str) {
 DebugTimer::DebugTimer(Severity severity, char const* file, int line, char const* name)
     : duration_(newDuration(severity, file, line, name)) {
   nvtx_helpers::omnisci_range_push(nvtx_helpers::Category::kDebugTimer, name, file);
+  trace::pushRange(name);
 }
 
 DebugTimer::~DebugTimer() {
   stop();
   nvtx_helpers::omnisci_range_pop();
+  trace::popRange();
 }
 
 void DebugTimer::stop() {
@@ -0,0 +1,172 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Logger/Trace.h"
+#include "Logger/Logger.h"
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <chrono>
+#include <mutex>
+#include <set>
+
+namespace trace {
+
+std::atomic<bool> g_enabled{false};
+
+namespace {
+
+struct Event {
+  std::string name;
+  const char* category;
+  int64_t begin;
+  int64_t end;
+  int track;
+  logger::ThreadId thread_id;
+  Args args;
+};
+
+std::mutex g_events_mutex;
+std::vector<Event> g_events;
+
+struct Range {
+  const char* name;
+  // Negative for ranges started while tracing was off.
+  int64_t begin;
+};
+
+thread_local std::vector<Range> g_ranges;
+
+void writeMetadata(rapidjson::Writer<rapidjson::StringBuffer>& writer,
+                   int track,
+                   const std::string& name) {
+  writer.StartObject();
+  writer.Key("name");
+  writer.String("process_name");
+  writer.Key("ph");
+  writer.String("M");
+  writer.Key("pid");
+  writer.Int(track);
+  writer.Key("args");
+  writer.StartObject();
+  writer.Key("name");
+  writer.String(name.c_str());
+  writer.EndObject();
+  writer.EndObject();
+}
+
+}  // namespace
+
+void start() {
+  std::lock_guard<std::mutex> lock(g_events_mutex);
+  g_events.clear();
+  g_enabled.store(true, std::memory_order_relaxed);
+}
+
+std::string stop() {
+  std::vector<Event> events;
+  {
+    std::lock_guard<std::mutex> lock(g_events_mutex);
+    g_enabled.store(false, std::memory_order_relaxed);
+    events.swap(g_events);
+  }
+
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  writer.StartObject();
+  writer.Key("displayTimeUnit");
+  writer.String("ms");
+  writer.Key("traceEvents");
+  writer.StartArray();
+  std::set<int> tracks;
+  for (auto& event : events) {
+    tracks.insert(event.track);
+    writer.StartObject();
+    writer.Key("name");
+    writer.String(event.name.c_str());
+    writer.Key("cat");
+    writer.String(event.category);
+    writer.Key("ph");
+    writer.String("X");
+    writer.Key("ts");
+    writer.Int64(event.begin);
+    writer.Key("dur");
+    writer.Int64(event.end - event.begin);
+    writer.Key("pid");
+    writer.Int(event.track);
+    writer.Key("tid");
+    writer.Uint64(event.thread_id);
+    if (!event.args.empty()) {
+      writer.Key("args");
+      writer.StartObject();
+      for (auto& [key, val] : event.args) {
+        writer.Key(key.c_str());
+        writer.String(val.c_str());
+      }
+      writer.EndObject();
+    }
+    writer.EndObject();
+  }
+  for (auto track : tracks) {
+    writeMetadata(
+        writer, track, track == kHostTrack ? "Host" : "GPU " + std::to_string(track - 1));
+  }
+  writer.EndArray();
+  writer.EndObject();
+  return buffer.GetString();
+}
+
+int64_t now() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void addEvent(std::string name,
+              const char* category,
+              int64_t begin,
+              int64_t end,
+              int track,
+              Args args) {
+  Event event{std::move(name),
+              category,
+              begin,
+              end,
+              track,
+              logger::thread_id(),
+              std::move(args)};
+  std::lock_guard<std::mutex> lock(g_events_mutex);
+  // Events finished after stop() are dropped.
+  if (enabled()) {
+    g_events.emplace_back(std::move(event));
+  }
+}
+
+void pushRange(const char* name) {
+  g_ranges.push_back({name, enabled() ? now() : -1});
+}
+
+void popRange() {
+  if (g_ranges.empty()) {
+    return;
+  }
+  auto range = g_ranges.back();
+  g_ranges.pop_back();
+  if (range.begin >= 0 && enabled()) {
+    addEvent(range.name, "timer", range.begin, now());
+  }
+}
+
+}  // namespace trace
@@ -0,0 +1,111 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    Trace.h
+ * @brief   Timeline tracing into the Chrome trace event format.
+ *
+ * Tracing is off by default and is switched on by trace::start(). While it is off,
+ * trace points cost an atomic load. trace::stop() returns the recorded events as
+ * Chrome trace JSON, which is opened by chrome://tracing and Perfetto UI. Events
+ * carry the logger thread id, events executed on a GPU are put on a separate
+ * process track of the device.
+ **/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace trace {
+
+using Args = std::vector<std::pair<std::string, std::string>>;
+
+// Track of host events. Events of GPU N go to the track N + 1.
+constexpr int kHostTrack = 0;
+
+inline int gpuTrack(int device_id) {
+  return device_id + 1;
+}
+
+extern std::atomic<bool> g_enabled;
+
+inline bool enabled() {
+  return g_enabled.load(std::memory_order_relaxed);
+}
+
+// Drop previously recorded events and start recording.
+void start();
+
+// Stop recording and return the recorded events as Chrome trace JSON.
+std::string stop();
+
+// Microseconds since an arbitrary point, used as event timestamps.
+int64_t now();
+
+void addEvent(std::string name,
+              const char* category,
+              int64_t begin,
+              int64_t end,
+              int track = kHostTrack,
+              Args args = {});
+
+// Nested ranges of the current thread, used to mirror DEBUG_TIMER ranges.
+void pushRange(const char* name);
+void popRange();
+
+// Records an event for the lifetime of the scope.
+class Scope {
+ public:
+  Scope(const char* name, const char* category, int track = kHostTrack)
+      : active_(enabled())
+      , name_(name)
+      , category_(category)
+      , track_(track)
+      , begin_(active_ ? now() : 0) {}
+
+  Scope(const Scope&) = delete;
+  Scope& operator=(const Scope&) = delete;
+
+  ~Scope() { finish(); }
+
+  bool active() const { return active_; }
+
+  // Record the event now instead of at the end of the scope.
+  void finish() {
+    if (active_) {
+      addEvent(name_, category_, begin_, now(), track_, std::move(args_));
+      active_ = false;
+    }
+  }
+
+  void addArg(std::string key, std::string val) {
+    if (active_) {
+      args_.emplace_back(std::move(key), std::move(val));
+    }
+  }
+
+ private:
+  bool active_;
+  const char* name_;
+  const char* category_;
+  const int track_;
+  const int64_t begin_;
+  Args args_;
+};
+
+}  // namespace trace
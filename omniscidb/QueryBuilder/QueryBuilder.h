@@ -550,6 +550,11 @@ class QueryBuilder {
                          const BuilderExpr& if_val,
                          const BuilderExpr& else_val);
 
+  // Build a node for a simple single table SELECT query. Returns an empty node
+  // for queries outside of the supported SQL subset (see SqlParser.cpp), so the
+  // caller can fall back to Calcite.
+  BuilderNode parseSql(const std::string& sql) const;
+
  protected:
   friend class BuilderExpr;
   friend class BuilderNode;
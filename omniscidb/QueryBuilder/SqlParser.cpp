@@ -0,0 +1,818 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    SqlParser.cpp
+ * @brief   Native front end for a simple subset of SQL.
+ *
+ * Single table SELECT queries with optional WHERE, GROUP BY, HAVING, ORDER BY and
+ * LIMIT/OFFSET clauses are lowered directly to QueryBuilder nodes. Expressions are
+ * limited to column references, literals, arithmetic, comparison and logical
+ * operators, IS [NOT] NULL and COUNT/SUM/AVG/MIN/MAX aggregates. Anything else
+ * makes the parser give up, so the caller can use Calcite instead.
+ **/
+
+#include "QueryBuilder.h"
+
+#include <boost/algorithm/string.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <unordered_set>
+
+namespace hdk::ir {
+
+namespace {
+
+// Thrown for queries outside of the supported subset.
+class UnsupportedSql : public std::runtime_error {
+ public:
+  UnsupportedSql(const std::string& what) : std::runtime_error(what) {}
+};
+
+struct Token {
+  enum Kind { kIdent, kQuotedIdent, kInt, kDecimal, kString, kSymbol, kEnd };
+
+  Kind kind;
+  std::string text;
+};
+
+std::vector<Token> tokenize(const std::string& sql) {
+  std::vector<Token> res;
+  size_t pos = 0;
+  auto is_ident_char = [&sql](size_t pos) {
+    return pos < sql.size() &&
+           (std::isalnum(static_cast<unsigned char>(sql[pos])) || sql[pos] == '_');
+  };
+  auto is_digit = [&sql](size_t pos) {
+    return pos < sql.size() && std::isdigit(static_cast<unsigned char>(sql[pos]));
+  };
+  while (pos < sql.size()) {
+    const char ch = sql[pos];
+    if (std::isspace(static_cast<unsigned char>(ch))) {
+      ++pos;
+    } else if (std::isalpha(static_cast<unsigned char>(ch)) || ch == '_') {
+      size_t end = pos + 1;
+      while (is_ident_char(end)) {
+        ++end;
+      }
+      res.push_back({Token::kIdent, sql.substr(pos, end - pos)});
+      pos = end;
+    } else if (is_digit(pos) || (ch == '.' && is_digit(pos + 1))) {
+      size_t end = pos;
+      while (is_digit(end)) {
+        ++end;
+      }
+      bool is_decimal = end < sql.size() && sql[end] == '.';
+      if (is_decimal) {
+        ++end;
+        while (is_digit(end)) {
+          ++end;
+        }
+      }
+      if (is_ident_char(end)) {
+        throw UnsupportedSql("Unsupported numeric literal.");
+      }
+      res.push_back(
+          {is_decimal ? Token::kDecimal : Token::kInt, sql.substr(pos, end - pos)});
+      pos = end;
+    } else if (ch == '\'' || ch == '"') {
+      std::string text;
+      size_t end = pos + 1;
+      while (true) {
+        if (end >= sql.size()) {
+          throw UnsupportedSql("Unterminated quoted string.");
+        }
+        if (sql[end] == ch) {
+          if (end + 1 < sql.size() && sql[end + 1] == ch) {
+            text.push_back(ch);
+            end += 2;
+            continue;
+          }
+          break;
+        }
+        text.push_back(sql[end++]);
+      }
+      res.push_back({ch == '\'' ? Token::kString : Token::kQuotedIdent, text});
+      pos = end + 1;
+    } else {
+      auto two_chars = sql.substr(pos, 2);
+      if (two_chars == "--" || two_chars == "/*") {
+        throw UnsupportedSql("Comments are not supported.");
+      }
+      if (two_chars == "<>" || two_chars == "!=" || two_chars == "<=" ||
+          two_chars == ">=") {
+        res.push_back({Token::kSymbol, two_chars == "!=" ? "<>" : two_chars});
+        pos += 2;
+      } else if (std::string("(),*+-/%=<>.;").find(ch) != std::string::npos) {
+        res.push_back({Token::kSymbol, std::string(1, ch)});
+        ++pos;
+      } else {
+        throw UnsupportedSql(std::string("Unsupported character: ") + ch);
+      }
+    }
+  }
+  res.push_back({Token::kEnd, ""});
+  return res;
+}
+
+// Words which cannot be used as unquoted column names or aliases. Besides keywords
+// of the supported subset, it has keywords of unsupported constructs to make sure
+// they are not parsed as aliases.
+const std::unordered_set<std::string>& reserved_words() {
+  static const std::unordered_set<std::string> words{
+      "ALL", "AND", "ANY", "AS", "ASC", "BETWEEN", "BY", "CASE", "CAST", "CROSS", "DATE",
+      "DESC", "DISTINCT", "ELSE", "END", "EXCEPT", "EXISTS", "FALSE", "FETCH", "FILTER",
+      "FIRST", "FROM", "FULL", "GROUP", "HAVING", "ILIKE", "IN", "INNER", "INTERSECT",
+      "INTERVAL", "IS", "JOIN", "LAST", "LATERAL", "LEFT", "LIKE", "LIMIT", "NATURAL",
+      "NOT", "NULL", "NULLS", "OFFSET", "ON", "OR", "ORDER", "OUTER", "OVER", "RIGHT",
+      "SELECT", "SIMILAR", "SOME", "THEN", "TIME", "TIMESTAMP", "TRUE", "UNION", "UNNEST",
+      "USING", "VALUES", "WHEN", "WHERE", "WINDOW", "WITH"};
+  return words;
+}
+
+struct SqlExpr;
+using SqlExprPtr = std::shared_ptr<const SqlExpr>;
+
+struct SqlExpr {
+  enum Kind {
+    kColumn,
+    kInt,
+    kDecimal,
+    kString,
+    kBool,
+    kNull,
+    kUnary,
+    kBinary,
+    kIsNull,
+    kAgg,
+  };
+
+  Kind kind;
+  // Column name, literal text, operator or upper case aggregate name.
+  std::string text;
+  // Table name or alias for qualified column references.
+  std::string qualifier;
+  // NOT for IS NULL, DISTINCT for aggregates.
+  bool flag = false;
+  // Operands. COUNT(*) has no operands.
+  std::vector<SqlExprPtr> args;
+
+  bool operator==(const SqlExpr& other) const {
+    if (kind != other.kind || text != other.text || qualifier != other.qualifier ||
+        flag != other.flag || args.size() != other.args.size()) {
+      return false;
+    }
+    for (size_t i = 0; i < args.size(); ++i) {
+      if (!(*args[i] == *other.args[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool hasAgg() const {
+    return kind == kAgg ||
+           std::any_of(args.begin(), args.end(), [](auto& arg) { return arg->hasAgg(); });
+  }
+};
+
+SqlExprPtr makeSqlExpr(SqlExpr::Kind kind,
+                       std::string text,
+                       std::vector<SqlExprPtr> args = {},
+                       bool flag = false) {
+  auto res = std::make_shared<SqlExpr>();
+  res->kind = kind;
+  res->text = std::move(text);
+  res->args = std::move(args);
+  res->flag = flag;
+  return res;
+}
+
+struct SelectItem {
+  SqlExprPtr expr;
+  std::string alias;
+};
+
+struct OrderItem {
+  SqlExprPtr expr;
+  SortDirection dir;
+  NullSortedPosition null_pos;
+};
+
+struct SelectStmt {
+  bool select_all = false;
+  std::vector<SelectItem> items;
+  std::string table_name;
+  std::string table_alias;
+  SqlExprPtr where;
+  std::vector<SqlExprPtr> group_by;
+  SqlExprPtr having;
+  std::vector<OrderItem> order_by;
+  size_t limit = 0;
+  size_t offset = 0;
+};
+
+class SqlParser {
+ public:
+  SqlParser(std::vector<Token> tokens) : tokens_(std::move(tokens)) {}
+
+  SelectStmt parse() {
+    SelectStmt stmt;
+    expectKeyword("SELECT");
+    if (acceptSymbol("*")) {
+      stmt.select_all = true;
+    } else {
+      do {
+        SelectItem item;
+        item.expr = parseExpr();
+        if (acceptKeyword("AS")) {
+          item.alias = parseName();
+        } else if (isName()) {
+          item.alias = parseName();
+        }
+        stmt.items.emplace_back(std::move(item));
+      } while (acceptSymbol(","));
+    }
+
+    expectKeyword("FROM");
+    stmt.table_name = parseName();
+    if (acceptKeyword("AS") || isName()) {
+      stmt.table_alias = parseName();
+    }
+
+    if (acceptKeyword("WHERE")) {
+      stmt.where = parseExpr();
+    }
+    if (acceptKeyword("GROUP")) {
+      expectKeyword("BY");
+      do {
+        stmt.group_by.push_back(parseExpr());
+      } while (acceptSymbol(","));
+    }
+    if (acceptKeyword("HAVING")) {
+      stmt.having = parseExpr();
+    }
+    if (acceptKeyword("ORDER")) {
+      expectKeyword("BY");
+      do {
+        OrderItem item;
+        item.expr = parseExpr();
+        item.dir = SortDirection::Ascending;
+        if (acceptKeyword("DESC")) {
+          item.dir = SortDirection::Descending;
+        } else {
+          acceptKeyword("ASC");
+        }
+        // Nulls are considered greater than other values by default.
+        item.null_pos = item.dir == SortDirection::Ascending ? NullSortedPosition::Last
+                                                             : NullSortedPosition::First;
+        if (acceptKeyword("NULLS")) {
+          if (acceptKeyword("FIRST")) {
+            item.null_pos = NullSortedPosition::First;
+          } else {
+            expectKeyword("LAST");
+            item.null_pos = NullSortedPosition::Last;
+          }
+        }
+        stmt.order_by.emplace_back(std::move(item));
+      } while (acceptSymbol(","));
+    }
+    if (acceptKeyword("LIMIT")) {
+      stmt.limit = parseCount();
+      // Zero limit means no limit for sort nodes, leave empty results to Calcite.
+      if (!stmt.limit) {
+        throw UnsupportedSql("LIMIT 0 is not supported.");
+      }
+    }
+    if (acceptKeyword("OFFSET")) {
+      stmt.offset = parseCount();
+    }
+
+    acceptSymbol(";");
+    if (peek().kind != Token::kEnd) {
+      throw UnsupportedSql("Unexpected token: " + peek().text);
+    }
+    return stmt;
+  }
+
+ private:
+  const Token& peek() const { return tokens_[pos_]; }
+
+  Token next() { return tokens_[peek().kind == Token::kEnd ? pos_ : pos_++]; }
+
+  bool isKeyword(const char* keyword) const {
+    return peek().kind == Token::kIdent && boost::iequals(peek().text, keyword);
+  }
+
+  bool acceptKeyword(const char* keyword) {
+    if (isKeyword(keyword)) {
+      ++pos_;
+      return true;
+    }
+    return false;
+  }
+
+  void expectKeyword(const char* keyword) {
+    if (!acceptKeyword(keyword)) {
+      throw UnsupportedSql(std::string("Expected ") + keyword);
+    }
+  }
+
+  bool acceptSymbol(const char* symbol) {
+    if (peek().kind == Token::kSymbol && peek().text == symbol) {
+      ++pos_;
+      return true;
+    }
+    return false;
+  }
+
+  void expectSymbol(const char* symbol) {
+    if (!acceptSymbol(symbol)) {
+      throw UnsupportedSql(std::string("Expected ") + symbol);
+    }
+  }
+
+  bool isReserved(const Token& token) const {
+    return token.kind == Token::kIdent &&
+           reserved_words().count(boost::to_upper_copy(token.text));
+  }
+
+  bool isName() const {
+    return peek().kind == Token::kQuotedIdent ||
+           (peek().kind == Token::kIdent && !isReserved(peek()));
+  }
+
+  std::string parseName() {
+    if (!isName()) {
+      throw UnsupportedSql("Expected a name: " + peek().text);
+    }
+    return next().text;
+  }
+
+  size_t parseCount() {
+    if (peek().kind != Token::kInt) {
+      throw UnsupportedSql("Expected an integer literal: " + peek().text);
+    }
+    return std::stoull(next().text);
+  }
+
+  SqlExprPtr parseExpr() { return parseOr(); }
+
+  SqlExprPtr parseOr() {
+    auto res = parseAnd();
+    while (acceptKeyword("OR")) {
+      res = makeSqlExpr(SqlExpr::kBinary, "OR", {res, parseAnd()});
+    }
+    return res;
+  }
+
+  SqlExprPtr parseAnd() {
+    auto res = parseNot();
+    while (acceptKeyword("AND")) {
+      res = makeSqlExpr(SqlExpr::kBinary, "AND", {res, parseNot()});
+    }
+    return res;
+  }
+
+  SqlExprPtr parseNot() {
+    if (acceptKeyword("NOT")) {
+      return makeSqlExpr(SqlExpr::kUnary, "NOT", {parseNot()});
+    }
+    return parseComparison();
+  }
+
+  SqlExprPtr parseComparison() {
+    auto res = parseAdditive();
+    if (acceptKeyword("IS")) {
+      bool is_not = acceptKeyword("NOT");
+      expectKeyword("NULL");
+      return makeSqlExpr(SqlExpr::kIsNull, "IS NULL", {res}, is_not);
+    }
+    for (auto op : {"=", "<>", "<", "<=", ">", ">="}) {
+      if (acceptSymbol(op)) {
+        return makeSqlExpr(SqlExpr::kBinary, op, {res, parseAdditive()});
+      }
+    }
+    return res;
+  }
+
+  SqlExprPtr parseAdditive() {
+    auto res = parseMultiplicative();
+    while (true) {
+      if (acceptSymbol("+")) {
+        res = makeSqlExpr(SqlExpr::kBinary, "+", {res, parseMultiplicative()});
+      } else if (acceptSymbol("-")) {
+        res = makeSqlExpr(SqlExpr::kBinary, "-", {res, parseMultiplicative()});
+      } else {
+        return res;
+      }
+    }
+  }
+
+  SqlExprPtr parseMultiplicative() {
+    auto res = parseUnary();
+    while (true) {
+      if (acceptSymbol("*")) {
+        res = makeSqlExpr(SqlExpr::kBinary, "*", {res, parseUnary()});
+      } else if (acceptSymbol("/")) {
+        res = makeSqlExpr(SqlExpr::kBinary, "/", {res, parseUnary()});
+      } else if (acceptSymbol("%")) {
+        res = makeSqlExpr(SqlExpr::kBinary, "%", {res, parseUnary()});
+      } else {
+        return res;
+      }
+    }
+  }
+
+  SqlExprPtr parseUnary() {
+    if (acceptSymbol("-")) {
+      return makeSqlExpr(SqlExpr::kUnary, "-", {parseUnary()});
+    }
+    if (acceptSymbol("+")) {
+      return parseUnary();
+    }
+    return parsePrimary();
+  }
+
+  SqlExprPtr parsePrimary() {
+    if (acceptSymbol("(")) {
+      auto res = parseExpr();
+      expectSymbol(")");
+      return res;
+    }
+    switch (peek().kind) {
+      case Token::kInt:
+        return makeSqlExpr(SqlExpr::kInt, next().text);
+      case Token::kDecimal:
+        return makeSqlExpr(SqlExpr::kDecimal, next().text);
+      case Token::kString:
+        return makeSqlExpr(SqlExpr::kString, next().text);
+      default:
+        break;
+    }
+    if (acceptKeyword("NULL")) {
+      return makeSqlExpr(SqlExpr::kNull, "NULL");
+    }
+    if (isKeyword("TRUE") || isKeyword("FALSE")) {
+      return makeSqlExpr(SqlExpr::kBool, boost::to_upper_copy(next().text));
+    }
+    if (peek().kind == Token::kIdent && tokens_[pos_ + 1].kind == Token::kSymbol &&
+        tokens_[pos_ + 1].text == "(") {
+      return parseAggregate();
+    }
+    auto name = parseName();
+    if (acceptSymbol(".")) {
+      auto res = std::make_shared<SqlExpr>();
+      res->kind = SqlExpr::kColumn;
+      res->qualifier = std::move(name);
+      res->text = parseName();
+      return res;
+    }
+    return makeSqlExpr(SqlExpr::kColumn, std::move(name));
+  }
+
+  SqlExprPtr parseAggregate() {
+    auto name = boost::to_upper_copy(next().text);
+    if (name != "COUNT" && name != "SUM" && name != "AVG" && name != "MIN" &&
+        name != "MAX") {
+      throw UnsupportedSql("Unsupported function: " + name);
+    }
+    expectSymbol("(");
+    if (name == "COUNT" && acceptSymbol("*")) {
+      expectSymbol(")");
+      return makeSqlExpr(SqlExpr::kAgg, name);
+    }
+    bool is_distinct = acceptKeyword("DISTINCT");
+    if (is_distinct && name != "COUNT") {
+      throw UnsupportedSql("Unsupported DISTINCT aggregate: " + name);
+    }
+    auto arg = parseExpr();
+    expectSymbol(")");
+    if (arg->hasAgg()) {
+      throw UnsupportedSql("Nested aggregates are not allowed.");
+    }
+    return makeSqlExpr(SqlExpr::kAgg, name, {arg}, is_distinct);
+  }
+
+  std::vector<Token> tokens_;
+  size_t pos_ = 0;
+};
+
+// Returns a replacement for a leaf of the lowered expression or nullopt if the
+// expression should be lowered as usual.
+using LeafResolver = std::function<std::optional<BuilderExpr>(const SqlExpr&)>;
+
+BuilderExpr lowerExpr(const QueryBuilder& builder,
+                      Context& ctx,
+                      const SqlExpr& expr,
+                      const LeafResolver& resolve) {
+  if (auto resolved = resolve(expr)) {
+    return *resolved;
+  }
+  switch (expr.kind) {
+    case SqlExpr::kInt: {
+      int64_t val = std::stoll(expr.text);
+      if (val <= std::numeric_limits<int32_t>::max()) {
+        return builder.cst(val, ctx.int32(false));
+      }
+      return builder.cst(val, ctx.int64(false));
+    }
+    case SqlExpr::kDecimal: {
+      auto point_pos = expr.text.find('.');
+      auto digits = expr.text.substr(0, point_pos) + expr.text.substr(point_pos + 1);
+      int scale = static_cast<int>(expr.text.size() - point_pos - 1);
+      int precision = std::max(static_cast<int>(digits.size()), 1);
+      if (precision > 18) {
+        throw UnsupportedSql("Too long decimal literal: " + expr.text);
+      }
+      return builder.cstNoScale(int64_t(std::stoll(digits.empty() ? "0" : digits)),
+                                ctx.decimal64(precision, scale, false));
+    }
+    case SqlExpr::kString:
+      return builder.cst(expr.text);
+    case SqlExpr::kBool:
+      return expr.text == "TRUE" ? builder.trueCst() : builder.falseCst();
+    case SqlExpr::kNull:
+      return builder.nullCst();
+    case SqlExpr::kUnary: {
+      auto arg = lowerExpr(builder, ctx, *expr.args[0], resolve);
+      return expr.text == "NOT" ? arg.logicalNot() : arg.uminus();
+    }
+    case SqlExpr::kIsNull: {
+      auto res = lowerExpr(builder, ctx, *expr.args[0], resolve).isNull();
+      return expr.flag ? res.logicalNot() : res;
+    }
+    case SqlExpr::kBinary: {
+      auto lhs = lowerExpr(builder, ctx, *expr.args[0], resolve);
+      auto rhs = lowerExpr(builder, ctx, *expr.args[1], resolve);
+      const auto& op = expr.text;
+      if (op == "+") {
+        return lhs.add(rhs);
+      } else if (op == "-") {
+        return lhs.sub(rhs);
+      } else if (op == "*") {
+        return lhs.mul(rhs);
+      } else if (op == "/") {
+        return lhs.div(rhs);
+      } else if (op == "%") {
+        return lhs.mod(rhs);
+      } else if (op == "=") {
+        return lhs.eq(rhs);
+      } else if (op == "<>") {
+        return lhs.ne(rhs);
+      } else if (op == "<") {
+        return lhs.lt(rhs);
+      } else if (op == "<=") {
+        return lhs.le(rhs);
+      } else if (op == ">") {
+        return lhs.gt(rhs);
+      } else if (op == ">=") {
+        return lhs.ge(rhs);
+      } else if (op == "AND") {
+        return lhs.logicalAnd(rhs);
+      }
+      CHECK_EQ(op, "OR");
+      return lhs.logicalOr(rhs);
+    }
+    default:
+      break;
+  }
+  throw UnsupportedSql("Unexpected expression: " + expr.text);
+}
+
+template <typename T>
+int findExpr(const std::vector<T>& exprs,
+             const SqlExpr& expr,
+             std::function<const SqlExpr&(const T&)> get = [](auto& val) -> auto& {
+               return *val;
+             }) {
+  for (size_t i = 0; i < exprs.size(); ++i) {
+    if (get(exprs[i]) == expr) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+void collectAggs(const SqlExprPtr& expr, std::vector<SqlExprPtr>& aggs) {
+  if (expr->kind == SqlExpr::kAgg) {
+    if (findExpr(aggs, *expr) < 0) {
+      aggs.push_back(expr);
+    }
+    return;
+  }
+  for (auto& arg : expr->args) {
+    collectAggs(arg, aggs);
+  }
+}
+
+}  // namespace
+
+BuilderNode QueryBuilder::parseSql(const std::string& sql) const {
+  try {
+    auto stmt = SqlParser(tokenize(sql)).parse();
+
+    auto scan = this->scan(stmt.table_name);
+    std::unordered_set<std::string> scan_cols;
+    for (int i = 0; i < scan.size(); ++i) {
+      auto col_info = scan.columnInfo(i);
+      if (!col_info->is_rowid) {
+        scan_cols.insert(col_info->name);
+        if (stmt.select_all) {
+          stmt.items.push_back({makeSqlExpr(SqlExpr::kColumn, col_info->name), ""});
+        }
+      }
+    }
+
+    std::vector<std::string> names;
+    for (size_t i = 0; i < stmt.items.size(); ++i) {
+      auto& item = stmt.items[i];
+      if (!item.alias.empty()) {
+        names.push_back(item.alias);
+      } else if (item.expr->kind == SqlExpr::kColumn) {
+        names.push_back(item.expr->text);
+      } else {
+        // Calcite's naming of unnamed expressions.
+        names.push_back("EXPR$" + std::to_string(i));
+      }
+    }
+
+    auto resolve_columns = [&stmt](const BuilderNode& node) -> LeafResolver {
+      return [&stmt, node](const SqlExpr& expr) -> std::optional<BuilderExpr> {
+        if (expr.kind == SqlExpr::kAgg) {
+          throw UnsupportedSql("Unexpected aggregate.");
+        }
+        if (expr.kind != SqlExpr::kColumn) {
+          return std::nullopt;
+        }
+        if (!expr.qualifier.empty() && expr.qualifier != stmt.table_name &&
+            expr.qualifier != stmt.table_alias) {
+          throw UnsupportedSql("Unknown table: " + expr.qualifier);
+        }
+        return node.ref(expr.text);
+      };
+    };
+
+    BuilderNode node = scan;
+    if (stmt.where) {
+      node = scan.filter(lowerExpr(*this, ctx_, *stmt.where, resolve_columns(scan)));
+    }
+
+    // GROUP BY may refer select list items by their ordinals and aliases.
+    for (auto& key : stmt.group_by) {
+      if (key->kind == SqlExpr::kInt) {
+        auto idx = std::stoull(key->text);
+        if (!idx || idx > stmt.items.size()) {
+          throw UnsupportedSql("Invalid GROUP BY ordinal: " + key->text);
+        }
+        key = stmt.items[idx - 1].expr;
+      } else if (key->kind == SqlExpr::kColumn && key->qualifier.empty() &&
+                 !scan_cols.count(key->text)) {
+        auto it = std::find_if(stmt.items.begin(), stmt.items.end(), [&](auto& item) {
+          return item.alias == key->text;
+        });
+        if (it != stmt.items.end()) {
+          key = it->expr;
+        }
+      }
+      if (key->hasAgg()) {
+        throw UnsupportedSql("Aggregate in GROUP BY.");
+      }
+    }
+
+    std::vector<SqlExprPtr> aggs;
+    for (auto& item : stmt.items) {
+      collectAggs(item.expr, aggs);
+    }
+    if (stmt.having) {
+      collectAggs(stmt.having, aggs);
+    }
+
+    std::vector<BuilderExpr> exprs;
+    if (!stmt.group_by.empty() || !aggs.empty()) {
+      // Project group keys and aggregate arguments first, so the aggregation only
+      // refers input columns.
+      std::vector<SqlExprPtr> pre_agg = stmt.group_by;
+      for (auto& agg : aggs) {
+        if (!agg->args.empty() && findExpr(pre_agg, *agg->args[0]) < 0) {
+          pre_agg.push_back(agg->args[0]);
+        }
+      }
+      if (!pre_agg.empty()) {
+        std::vector<BuilderExpr> pre_agg_exprs;
+        std::vector<std::string> pre_agg_names;
+        for (size_t i = 0; i < pre_agg.size(); ++i) {
+          pre_agg_exprs.push_back(
+              lowerExpr(*this, ctx_, *pre_agg[i], resolve_columns(node)));
+          pre_agg_names.push_back("expr_" + std::to_string(i));
+        }
+        node = node.proj(pre_agg_exprs, pre_agg_names);
+      }
+
+      std::vector<BuilderExpr> keys;
+      for (int i = 0; i < static_cast<int>(stmt.group_by.size()); ++i) {
+        keys.push_back(node.ref(i));
+      }
+      std::vector<BuilderExpr> agg_exprs;
+      for (auto& agg : aggs) {
+        if (agg->args.empty()) {
+          agg_exprs.push_back(node.count());
+          continue;
+        }
+        auto arg = node.ref(findExpr(pre_agg, *agg->args[0]));
+        if (agg->text == "COUNT") {
+          agg_exprs.push_back(arg.count(agg->flag));
+        } else if (agg->text == "SUM") {
+          agg_exprs.push_back(arg.sum());
+        } else if (agg->text == "AVG") {
+          agg_exprs.push_back(arg.avg());
+        } else if (agg->text == "MIN") {
+          agg_exprs.push_back(arg.min());
+        } else {
+          CHECK_EQ(agg->text, "MAX");
+          agg_exprs.push_back(arg.max());
+        }
+      }
+      node = node.agg(keys, agg_exprs);
+
+      auto resolve_aggregated = [&stmt, &aggs](const BuilderNode& node) -> LeafResolver {
+        return [&stmt, &aggs, node](const SqlExpr& expr) -> std::optional<BuilderExpr> {
+          auto key_idx = findExpr(stmt.group_by, expr);
+          if (key_idx >= 0) {
+            return node.ref(key_idx);
+          }
+          if (expr.kind == SqlExpr::kAgg) {
+            return node.ref(static_cast<int>(stmt.group_by.size()) +
+                            findExpr(aggs, expr));
+          }
+          if (expr.kind == SqlExpr::kColumn) {
+            throw UnsupportedSql("Column is not grouped: " + expr.text);
+          }
+          return std::nullopt;
+        };
+      };
+      if (stmt.having) {
+        node = node.filter(
+            lowerExpr(*this, ctx_, *stmt.having, resolve_aggregated(node)));
+      }
+      for (auto& item : stmt.items) {
+        exprs.push_back(lowerExpr(*this, ctx_, *item.expr, resolve_aggregated(node)));
+      }
+    } else {
+      for (auto& item : stmt.items) {
+        exprs.push_back(lowerExpr(*this, ctx_, *item.expr, resolve_columns(node)));
+      }
+    }
+    node = node.proj(exprs, names);
+
+    // ORDER BY may refer select list items by their ordinals, names and expressions.
+    std::vector<BuilderSortField> sort_fields;
+    for (auto& item : stmt.order_by) {
+      int col_idx = -1;
+      if (item.expr->kind == SqlExpr::kInt) {
+        col_idx = std::stoi(item.expr->text) - 1;
+      } else if (item.expr->kind == SqlExpr::kColumn && item.expr->qualifier.empty()) {
+        auto it = std::find(names.begin(), names.end(), item.expr->text);
+        col_idx = it == names.end() ? -1 : static_cast<int>(it - names.begin());
+      }
+      if (col_idx < 0) {
+        col_idx = findExpr<SelectItem>(
+            stmt.items, *item.expr, [](auto& item) -> auto& { return *item.expr; });
+      }
+      if (col_idx < 0 || col_idx >= node.size()) {
+        throw UnsupportedSql("ORDER BY expression is not in the select list.");
+      }
+      sort_fields.emplace_back(col_idx, item.dir, item.null_pos);
+    }
+    if (!sort_fields.empty() || stmt.limit || stmt.offset) {
+      node = node.sort(sort_fields, stmt.limit, stmt.offset);
+    }
+
+    return node;
+  } catch (const UnsupportedSql& e) {
+    VLOG(1) << "Native SQL parser cannot handle the query: " << e.what();
+  } catch (const InvalidQueryError& e) {
+    VLOG(1) << "Native SQL parser failed to build the query: " << e.what();
+  } catch (const std::logic_error& e) {
+    // Numeric literals out of range.
+    VLOG(1) << "Native SQL parser failed to parse the query: " << e.what();
+  }
+  return BuilderNode();
+}
+
+}  // namespace hdk::ir
@@ -16,6 +16,59 @@
 
 #include "AggregatedColRange.h"
 
+namespace {
+
+bool is_empty_range(const ExpressionRange& range) {
+  switch (range.getType()) {
+    case ExpressionRangeType::Integer:
+      return range.getIntMin() > range.getIntMax();
+    case ExpressionRangeType::Float:
+    case ExpressionRangeType::Double:
+      return range.getFpMin() > range.getFpMax();
+    default:
+      return false;
+  }
+}
+
+// Union of ranges of two disjoint parts of a column. Empty ranges are synthesized as
+// [0, -1] and have to be skipped rather than united.
+ExpressionRange merge_ranges(const ExpressionRange& lhs, const ExpressionRange& rhs) {
+  if (lhs.getType() == ExpressionRangeType::Invalid ||
+      rhs.getType() == ExpressionRangeType::Invalid) {
+    return ExpressionRange::makeInvalidRange();
+  }
+  if (is_empty_range(lhs) || is_empty_range(rhs)) {
+    auto res = is_empty_range(lhs) ? rhs : lhs;
+    if (lhs.hasNulls() || rhs.hasNulls()) {
+      res.setHasNulls();
+    }
+    return res;
+  }
+  return lhs || rhs;
+}
+
+std::shared_ptr<ChunkMetadata> get_chunk_metadata(const FragmentInfo& fragment,
+                                                  int col_id) {
+  const auto& meta_map = fragment.getChunkMetadataMap();
+  auto it = meta_map.find(col_id);
+  return it == meta_map.end() ? nullptr : it->second;
+}
+
+TableFragmentsInfo get_fragments_slice(const TableFragmentsInfo& table_info,
+                                       size_t begin,
+                                       size_t end) {
+  TableFragmentsInfo res;
+  size_t num_tuples = 0;
+  for (size_t frag_idx = begin; frag_idx < end; ++frag_idx) {
+    res.fragments.push_back(table_info.fragments[frag_idx]);
+    num_tuples += table_info.fragments[frag_idx].getPhysicalNumTuples();
+  }
+  res.setPhysicalNumTuples(num_tuples);
+  return res;
+}
+
+}  // namespace
+
 ExpressionRange AggregatedColRange::getColRange(const PhysicalInput& phys_input) const {
   const auto it = cache_.find(phys_input);
   CHECK(it != cache_.end());
@@ -36,3 +89,68 @@ const std::unordered_map<PhysicalInput, ExpressionRange>& AggregatedColRange::as
 void AggregatedColRange::clear() {
   decltype(cache_)().swap(cache_);
 }
+
+ExpressionRange ColumnRangeCache::getColRange(const PhysicalInput& phys_input,
+                                              const TableFragmentsInfo& table_info,
+                                              const ComputeRangeFn& compute) {
+  const size_t frag_count = table_info.fragments.size();
+  if (!frag_count) {
+    return compute(table_info);
+  }
+  auto last_meta = get_chunk_metadata(table_info.fragments.back(), phys_input.col_id);
+  auto prefix_last_meta =
+      frag_count > 1
+          ? get_chunk_metadata(table_info.fragments[frag_count - 2], phys_input.col_id)
+          : nullptr;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = cache_.find(phys_input);
+  if (it != cache_.end()) {
+    const auto& entry = it->second;
+    if (entry.fragment_count == frag_count &&
+        entry.num_tuples == table_info.getPhysicalNumTuples() && last_meta &&
+        entry.last_meta == last_meta && entry.prefix_last_meta == prefix_last_meta) {
+      return entry.range;
+    }
+  }
+
+  // Fragments before prefix_end are covered by the cached prefix range.
+  size_t prefix_end = 0;
+  std::optional<ExpressionRange> prefix_range;
+  if (it != cache_.end()) {
+    const auto& entry = it->second;
+    bool same_prefix =
+        entry.fragment_count <= frag_count &&
+        (entry.fragment_count < 2 ||
+         (entry.prefix_last_meta &&
+          entry.prefix_last_meta ==
+              get_chunk_metadata(table_info.fragments[entry.fragment_count - 2],
+                                 phys_input.col_id)));
+    if (same_prefix && entry.prefix_range) {
+      prefix_end = entry.fragment_count - 1;
+      prefix_range = entry.prefix_range;
+    }
+  }
+  if (prefix_end < frag_count - 1) {
+    auto range = compute(get_fragments_slice(table_info, prefix_end, frag_count - 1));
+    prefix_range = prefix_range ? merge_ranges(*prefix_range, range) : range;
+  }
+  auto range = compute(get_fragments_slice(table_info, frag_count - 1, frag_count));
+  if (prefix_range) {
+    range = merge_ranges(*prefix_range, range);
+  }
+
+  cache_.insert_or_assign(phys_input,
+                          Entry{frag_count,
+                                table_info.getPhysicalNumTuples(),
+                                std::move(last_meta),
+                                std::move(prefix_last_meta),
+                                prefix_range,
+                                range});
+  return range;
+}
+
+void ColumnRangeCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  decltype(cache_)().swap(cache_);
+}
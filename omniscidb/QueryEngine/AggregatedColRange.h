@@ -25,9 +25,13 @@
 #ifndef QUERYENGINE_AGGREGATEDCOLRANGECACHE_H
 #define QUERYENGINE_AGGREGATEDCOLRANGECACHE_H
 
+#include "DataProvider/TableFragmentsInfo.h"
 #include "ExpressionRange.h"
 #include "QueryPhysicalInputsCollector.h"
 
+#include <functional>
+#include <mutex>
+#include <optional>
 #include <unordered_map>
 
 class AggregatedColRange {
@@ -44,4 +48,40 @@ class AggregatedColRange {
   std::unordered_map<PhysicalInput, ExpressionRange> cache_;
 };
 
+/**
+ * Physical column ranges computed by previous queries. A cached range is reused while
+ * the table has the same fragments and is extended with ranges of new fragments when
+ * data is appended, so metadata of the whole table isn't scanned for every query.
+ *
+ * Appends can only add fragments or replace metadata of the last fragment. Metadata of
+ * the last two fragments is held by an entry to check whether the table changed. The
+ * range of all fragments but the last one is kept separately to update the entry when
+ * the last fragment is extended.
+ */
+class ColumnRangeCache {
+ public:
+  using ComputeRangeFn = std::function<ExpressionRange(const TableFragmentsInfo&)>;
+
+  // Get the range of the column in the table described by table_info. compute is
+  // called for parts of the table whose range isn't cached.
+  ExpressionRange getColRange(const PhysicalInput& phys_input,
+                              const TableFragmentsInfo& table_info,
+                              const ComputeRangeFn& compute);
+
+  void clear();
+
+ private:
+  struct Entry {
+    size_t fragment_count;
+    size_t num_tuples;
+    std::shared_ptr<ChunkMetadata> last_meta;
+    std::shared_ptr<ChunkMetadata> prefix_last_meta;
+    std::optional<ExpressionRange> prefix_range;
+    ExpressionRange range;
+  };
+
+  std::mutex mutex_;
+  std::unordered_map<PhysicalInput, Entry> cache_;
+};
+
 #endif  // QUERYENGINE_AGGREGATEDCOLRANGECACHE_H
@@ -189,9 +189,9 @@ bool CodeGenerator::checkExpressionRanges(const hdk::ir::BinOper* bin_oper,
     // check.
     return false;
   }
-  if (bin_oper->type()->isDecimal()) {
-    return false;
-  }
+  // Decimal operands are cast to the result scale for addition and subtraction and
+  // keep their scales for multiplication, so ranges of unscaled values computed for
+  // operands apply to the result as is.
 
   CHECK(plan_state_);
   if (executor_) {
@@ -676,10 +676,6 @@ llvm::Value* CodeGenerator::codegenMod(llvm::Value* lhs_lv,
 bool CodeGenerator::checkExpressionRanges(const hdk::ir::UOper* uoper,
                                           int64_t min,
                                           int64_t max) {
-  if (uoper->type()->isDecimal()) {
-    return false;
-  }
-
   CHECK(plan_state_);
   if (executor_) {
     auto expr_range_info =
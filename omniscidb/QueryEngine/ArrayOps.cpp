@@ -118,6 +118,16 @@ VARLEN_NOTNULL_ARRAY_AT(double)
 
 #undef VARLEN_NOTNULL_ARRAY_AT
 
+// ANY and ALL check elements in blocks with no branches inside a block, so the checks
+// are vectorized. The result is still returned after the first decisive block. Block
+// results are accumulated in int rather than bool, bool reductions aren't vectorized.
+#define ARRAY_BLOCK_SIZE 16
+
+DEVICE ALWAYS_INLINE size_t array_check_block_end(const size_t start,
+                                                  const size_t elem_count) {
+  return start + ARRAY_BLOCK_SIZE < elem_count ? start + ARRAY_BLOCK_SIZE : elem_count;
+}
+
 #define ARRAY_ANY(type, needle_type, oper_name, oper)                                   \
   extern "C" DEVICE RUNTIME_EXPORT bool array_any_##oper_name##_##type##_##needle_type( \
       int8_t* chunk_iter_,                                                              \
@@ -129,9 +139,15 @@ VARLEN_NOTNULL_ARRAY_AT(double)
     bool is_end;                                                                        \
     ChunkIter_get_nth(chunk_iter, row_pos, &ad, &is_end);                               \
     const size_t elem_count = ad.length / sizeof(type);                                 \
-    for (size_t i = 0; i < elem_count; ++i) {                                           \
-      const needle_type val = reinterpret_cast<type*>(ad.pointer)[i];                   \
-      if (val != null_val && val oper needle) {                                         \
+    const type* elems = reinterpret_cast<type*>(ad.pointer);                            \
+    for (size_t start = 0; start < elem_count; start += ARRAY_BLOCK_SIZE) {             \
+      const size_t end = array_check_block_end(start, elem_count);                      \
+      int res = 0;                                                                      \
+      for (size_t i = start; i < end; ++i) {                                            \
+        const needle_type val = elems[i];                                               \
+        res |= (val != null_val) & (val oper needle);                                   \
+      }                                                                                 \
+      if (res) {                                                                        \
         return true;                                                                    \
       }                                                                                 \
     }                                                                                   \
@@ -149,9 +165,15 @@ VARLEN_NOTNULL_ARRAY_AT(double)
     bool is_end;                                                                        \
     ChunkIter_get_nth(chunk_iter, row_pos, &ad, &is_end);                               \
     const size_t elem_count = ad.length / sizeof(type);                                 \
-    for (size_t i = 0; i < elem_count; ++i) {                                           \
-      const needle_type val = reinterpret_cast<type*>(ad.pointer)[i];                   \
-      if (!(val != null_val && val oper needle)) {                                      \
+    const type* elems = reinterpret_cast<type*>(ad.pointer);                            \
+    for (size_t start = 0; start < elem_count; start += ARRAY_BLOCK_SIZE) {             \
+      const size_t end = array_check_block_end(start, elem_count);                      \
+      int res = 1;                                                                      \
+      for (size_t i = start; i < end; ++i) {                                            \
+        const needle_type val = elems[i];                                               \
+        res &= (val != null_val) & (val oper needle);                                   \
+      }                                                                                 \
+      if (!res) {                                                                       \
         return false;                                                                   \
       }                                                                                 \
     }                                                                                   \
@@ -217,6 +239,7 @@ ARRAY_ALL_ANY_ALL_TYPES(ge, >=, double)
 #undef ARRAY_ALL_ANY_ALL_TYPES
 #undef ARRAY_ALL
 #undef ARRAY_ANY
+#undef ARRAY_BLOCK_SIZE
 
 #define ARRAY_AT_CHECKED(type)                                                    \
   extern "C" DEVICE RUNTIME_EXPORT type array_at_##type##_checked(                \
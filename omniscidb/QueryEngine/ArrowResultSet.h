@@ -23,6 +23,7 @@
 #include "DataMgr/DataMgr.h"
 #include "ResultSet/ResultSet.h"
 
+#include <functional>
 #include <type_traits>
 
 #include "arrow/api.h"
@@ -302,10 +303,34 @@ class ArrowResultSetConverter {
 
   std::shared_ptr<arrow::RecordBatch> convertToArrow() const;
   std::shared_ptr<arrow::Table> convertToArrowTable() const;
+  // Returns a reader producing record batches of up to max_batch_entries result set
+  // entries each. Batches are converted on demand, so the first rows are available
+  // before the whole result is converted and converted batches can be released by
+  // the consumer early.
+  std::shared_ptr<arrow::RecordBatchReader> convertToArrowBatchReader(
+      const size_t max_batch_entries) const;
+  // Write the result to a file by batches of up to max_batch_entries result set
+  // entries. The next batch is converted while the previous one is written, so at
+  // most two batches are held in memory. Parquet files get a row group per batch.
+  void exportToParquet(const std::string& file_name,
+                       const size_t max_batch_entries) const;
+  void exportToArrowIpc(const std::string& file_name,
+                        const size_t max_batch_entries) const;
 
  private:
+  class BatchReader;
+
+  void exportBatches(
+      const size_t max_batch_entries,
+      const std::function<void(std::shared_ptr<arrow::RecordBatch>)>& write) const;
+
   std::shared_ptr<arrow::RecordBatch> getArrowBatch(
       const std::shared_ptr<arrow::Schema>& schema) const;
+  // Convert entries [start_entry, end_entry) of the result set.
+  std::shared_ptr<arrow::RecordBatch> getArrowBatch(
+      const std::shared_ptr<arrow::Schema>& schema,
+      const size_t start_entry,
+      const size_t end_entry) const;
   std::shared_ptr<arrow::Table> getArrowTable(
       const std::shared_ptr<arrow::Schema>& schema) const;
 
@@ -25,10 +25,13 @@
 
 //  arrow headers
 #include "arrow/api.h"
+#include "arrow/compute/api.h"
+#include "arrow/io/file.h"
 #include "arrow/io/memory.h"
 #include "arrow/ipc/api.h"
 #include "arrow/ipc/dictionary.h"
 #include "arrow/ipc/options.h"
+#include "parquet/arrow/writer.h"
 
 // std headers
 #include <algorithm>
@@ -197,95 +200,6 @@ struct null_type<TYPE, std::enable_if_t<std::is_floating_point<TYPE>::value>> {
 template <typename TYPE>
 using null_type_t = typename null_type<TYPE>::type;
 
-template <typename C_TYPE,
-          typename ARROW_TYPE = typename arrow::CTypeTraits<C_TYPE>::ArrowType>
-void convert_column(ResultSetPtr result,
-                    size_t col,
-                    size_t entry_count,
-                    std::shared_ptr<arrow::Array>& out) {
-  CHECK(sizeof(C_TYPE) == result->colType(col)->size());
-
-  std::shared_ptr<arrow::Buffer> values;
-  std::shared_ptr<arrow::Buffer> is_valid;
-  const int64_t buf_size = entry_count * sizeof(C_TYPE);
-  if (result->isZeroCopyColumnarConversionPossible(col)) {
-    values.reset(new ResultSetBuffer(
-        reinterpret_cast<const uint8_t*>(result->getColumnarBuffer(col)),
-        buf_size,
-        result));
-  } else {
-    auto res = arrow::AllocateBuffer(buf_size);
-    CHECK(res.ok());
-    values = std::move(res).ValueOrDie();
-    result->copyColumnIntoBuffer(
-        col, reinterpret_cast<int8_t*>(values->mutable_data()), buf_size);
-  }
-
-  int64_t null_count = 0;
-  auto res = arrow::AllocateBuffer((entry_count + 7) / 8);
-  CHECK(res.ok());
-  is_valid = std::move(res).ValueOrDie();
-
-  auto is_valid_data = is_valid->mutable_data();
-
-  const null_type_t<C_TYPE>* vals =
-      reinterpret_cast<const null_type_t<C_TYPE>*>(values->data());
-  null_type_t<C_TYPE> null_val = null_type<C_TYPE>::value;
-
-  size_t unroll_count = entry_count & 0xFFFFFFFFFFFFFFF8ULL;
-  for (size_t i = 0; i < unroll_count; i += 8) {
-    uint8_t valid_byte = 0;
-    uint8_t valid;
-    valid = vals[i + 0] != null_val;
-    valid_byte |= valid << 0;
-    null_count += !valid;
-    valid = vals[i + 1] != null_val;
-    valid_byte |= valid << 1;
-    null_count += !valid;
-    valid = vals[i + 2] != null_val;
-    valid_byte |= valid << 2;
-    null_count += !valid;
-    valid = vals[i + 3] != null_val;
-    valid_byte |= valid << 3;
-    null_count += !valid;
-    valid = vals[i + 4] != null_val;
-    valid_byte |= valid << 4;
-    null_count += !valid;
-    valid = vals[i + 5] != null_val;
-    valid_byte |= valid << 5;
-    null_count += !valid;
-    valid = vals[i + 6] != null_val;
-    valid_byte |= valid << 6;
-    null_count += !valid;
-    valid = vals[i + 7] != null_val;
-    valid_byte |= valid << 7;
-    null_count += !valid;
-    is_valid_data[i >> 3] = valid_byte;
-  }
-  if (unroll_count != entry_count) {
-    uint8_t valid_byte = 0;
-    for (size_t i = unroll_count; i < entry_count; ++i) {
-      bool valid = vals[i] != null_val;
-      valid_byte |= valid << (i & 7);
-      null_count += !valid;
-    }
-    is_valid_data[unroll_count >> 3] = valid_byte;
-  }
-
-  if (!null_count) {
-    is_valid.reset();
-  }
-
-  // TODO: support date/time + scaling
-  // TODO: support booleans
-  if (null_count) {
-    out.reset(
-        new arrow::NumericArray<ARROW_TYPE>(entry_count, values, is_valid, null_count));
-  } else {
-    out.reset(new arrow::NumericArray<ARROW_TYPE>(entry_count, values));
-  }
-}
-
 template <typename TYPE>
 size_t gen_bitmap(uint8_t* bitmap, const TYPE* data, size_t size) {
   static_assert(
@@ -368,6 +282,54 @@ int64_t create_bitmap_parallel_for_avx512(uint8_t* bitmap_data,
   return null_count.load();
 }
 
+// convert_column() specialization for arrow::Array output
+template <typename C_TYPE,
+          typename ARROW_TYPE = typename arrow::CTypeTraits<C_TYPE>::ArrowType>
+void convert_column(ResultSetPtr result,
+                    size_t col,
+                    size_t entry_count,
+                    std::shared_ptr<arrow::Array>& out) {
+  CHECK(sizeof(C_TYPE) == result->colType(col)->size());
+
+  std::shared_ptr<arrow::Buffer> values;
+  std::shared_ptr<arrow::Buffer> is_valid;
+  const int64_t buf_size = entry_count * sizeof(C_TYPE);
+  if (result->isZeroCopyColumnarConversionPossible(col)) {
+    values.reset(new ResultSetBuffer(
+        reinterpret_cast<const uint8_t*>(result->getColumnarBuffer(col)),
+        buf_size,
+        result));
+  } else {
+    auto res = arrow::AllocateBuffer(buf_size);
+    CHECK(res.ok());
+    values = std::move(res).ValueOrDie();
+    result->copyColumnIntoBuffer(
+        col, reinterpret_cast<int8_t*>(values->mutable_data()), buf_size);
+  }
+
+  auto res = arrow::AllocateBuffer((entry_count + 7) / 8);
+  CHECK(res.ok());
+  is_valid = std::move(res).ValueOrDie();
+
+  const null_type_t<C_TYPE>* vals =
+      reinterpret_cast<const null_type_t<C_TYPE>*>(values->data());
+  int64_t null_count = create_bitmap_parallel_for_avx512<null_type_t<C_TYPE>>(
+      is_valid->mutable_data(), vals, entry_count);
+
+  if (!null_count) {
+    is_valid.reset();
+  }
+
+  // TODO: support date/time + scaling
+  // TODO: support booleans
+  if (null_count) {
+    out.reset(
+        new arrow::NumericArray<ARROW_TYPE>(entry_count, values, is_valid, null_count));
+  } else {
+    out.reset(new arrow::NumericArray<ARROW_TYPE>(entry_count, values));
+  }
+}
+
 // convert_column() specialization for arrow::ChunkedArray output
 template <typename C_TYPE,
           typename ARROW_TYPE = typename arrow::CTypeTraits<C_TYPE>::ArrowType>
@@ -471,6 +433,84 @@ void convert_column(const hdk::ir::Type* physical_type,
   }
 }
 
+// Group-by results are decoded for non-empty entries only.
+template <typename C_TYPE,
+          typename ARROW_TYPE = typename arrow::CTypeTraits<C_TYPE>::ArrowType>
+void convert_group_by_column(ResultSetPtr result,
+                             size_t col,
+                             const std::vector<size_t>& entries,
+                             std::shared_ptr<arrow::Array>& out) {
+  CHECK(sizeof(C_TYPE) == result->colType(col)->size());
+
+  const size_t row_count = entries.size();
+  const int64_t buf_size = row_count * sizeof(C_TYPE);
+  auto res = arrow::AllocateBuffer(buf_size);
+  CHECK(res.ok());
+  std::shared_ptr<arrow::Buffer> values = std::move(res).ValueOrDie();
+  result->copyGroupByColumnIntoBuffer(
+      col, entries, reinterpret_cast<int8_t*>(values->mutable_data()), buf_size);
+
+  res = arrow::AllocateBuffer((row_count + 7) / 8);
+  CHECK(res.ok());
+  std::shared_ptr<arrow::Buffer> is_valid = std::move(res).ValueOrDie();
+
+  const null_type_t<C_TYPE>* vals =
+      reinterpret_cast<const null_type_t<C_TYPE>*>(values->data());
+  int64_t null_count = create_bitmap_parallel_for_avx512<null_type_t<C_TYPE>>(
+      is_valid->mutable_data(), vals, row_count);
+
+  if (null_count) {
+    out.reset(
+        new arrow::NumericArray<ARROW_TYPE>(row_count, values, is_valid, null_count));
+  } else {
+    out.reset(new arrow::NumericArray<ARROW_TYPE>(row_count, values));
+  }
+}
+
+void convert_group_by_column(const hdk::ir::Type* physical_type,
+                             ResultSetPtr results,
+                             size_t col_idx,
+                             const std::vector<size_t>& entries,
+                             std::shared_ptr<arrow::Array>& out) {
+  switch (physical_type->id()) {
+    case hdk::ir::Type::kInteger:
+      switch (physical_type->size()) {
+        case 1:
+          convert_group_by_column<int8_t>(results, col_idx, entries, out);
+          break;
+        case 2:
+          convert_group_by_column<int16_t>(results, col_idx, entries, out);
+          break;
+        case 4:
+          convert_group_by_column<int32_t>(results, col_idx, entries, out);
+          break;
+        case 8:
+          convert_group_by_column<int64_t>(results, col_idx, entries, out);
+          break;
+        default:
+          throw std::runtime_error(physical_type->toString() +
+                                   " is not supported in Arrow group-by converter.");
+      }
+      break;
+    case hdk::ir::Type::kFloatingPoint:
+      switch (physical_type->as<hdk::ir::FloatingPointType>()->precision()) {
+        case hdk::ir::FloatingPointType::kFloat:
+          convert_group_by_column<float>(results, col_idx, entries, out);
+          break;
+        case hdk::ir::FloatingPointType::kDouble:
+          convert_group_by_column<double>(results, col_idx, entries, out);
+          break;
+        default:
+          throw std::runtime_error(physical_type->toString() +
+                                   " is not supported in Arrow group-by converter.");
+      }
+      break;
+    default:
+      throw std::runtime_error(physical_type->toString() +
+                               " is not supported in Arrow group-by converter.");
+  }
+}
+
 #ifndef _MSC_VER
 std::pair<key_t, void*> get_shm(size_t shmsz) {
   if (!shmsz) {
@@ -826,6 +866,56 @@ std::shared_ptr<arrow::Table> ArrowResultSetConverter::convertToArrowTable() con
   return getArrowTable(makeSchema());
 }
 
+class ArrowResultSetConverter::BatchReader : public arrow::RecordBatchReader {
+ public:
+  BatchReader(const ArrowResultSetConverter& converter, const size_t max_batch_entries)
+      : converter_(converter)
+      , schema_(converter.makeSchema())
+      , max_batch_entries_(max_batch_entries) {
+    CHECK_GT(max_batch_entries_, (size_t)0);
+    const auto& results = converter_.results_;
+    if (!results->isEmpty()) {
+      entry_count_ = converter_.top_n_ < 0
+                         ? results->entryCount()
+                         : std::min(size_t(converter_.top_n_), results->entryCount());
+      // Offset and limit of truncated results are applied while iterating over the
+      // whole entry range, so such results are converted as a single batch.
+      if (results->isTruncated()) {
+        max_batch_entries_ = std::max(entry_count_, (size_t)1);
+      }
+    }
+  }
+
+  std::shared_ptr<arrow::Schema> schema() const override { return schema_; }
+
+  arrow::Status ReadNext(std::shared_ptr<arrow::RecordBatch>* batch) override {
+    if (next_entry_ >= entry_count_) {
+      batch->reset();
+      return arrow::Status::OK();
+    }
+    const auto end_entry = std::min(entry_count_, next_entry_ + max_batch_entries_);
+    try {
+      *batch = converter_.getArrowBatch(schema_, next_entry_, end_entry);
+    } catch (const std::exception& e) {
+      return arrow::Status::ExecutionError(e.what());
+    }
+    next_entry_ = end_entry;
+    return arrow::Status::OK();
+  }
+
+ private:
+  const ArrowResultSetConverter converter_;
+  const std::shared_ptr<arrow::Schema> schema_;
+  size_t max_batch_entries_;
+  size_t entry_count_ = 0;
+  size_t next_entry_ = 0;
+};
+
+std::shared_ptr<arrow::RecordBatchReader>
+ArrowResultSetConverter::convertToArrowBatchReader(const size_t max_batch_entries) const {
+  return std::make_shared<BatchReader>(*this, max_batch_entries);
+}
+
 namespace {
 
 template <typename T>
@@ -988,6 +1078,9 @@ void append_scalar_value_and_validity(const ScalarTargetValue& value,
   }
 }
 
+// Number of rows fetched from the result set at once by the row converter.
+constexpr size_t kRowFetchBatchSize = 1024;
+
 }  // namespace
 
 size_t convert_rowwise(
@@ -1009,12 +1102,23 @@ size_t convert_rowwise(
   size_t seg_row_count = 0;
   size_t limit = results->getLimit() ? results->getLimit() : results->entryCount();
   size_t offset = results->getOffset();
+  // Rows are fetched in batches, so lazily fetched columns are resolved in bulk.
+  std::vector<std::vector<TargetValue>> row_batch;
+  size_t batch_start = start_entry;
   for (size_t i = start_entry; i < end_entry; ++i) {
     if (is_truncated && seg_row_count >= offset + limit) {
       break;
     }
 
-    auto row = results->getRowAtNoTranslations(i, non_lazy_cols);
+    if (i - batch_start >= row_batch.size()) {
+      auto batch_size = std::min(kRowFetchBatchSize, end_entry - i);
+      if (is_truncated) {
+        batch_size = std::min(batch_size, offset + limit - seg_row_count);
+      }
+      batch_start = i;
+      row_batch = results->getRowsAtNoTranslations(i, i + batch_size, non_lazy_cols);
+    }
+    auto row = std::move(row_batch[i - batch_start]);
     if (row.empty()) {
       continue;
     }
@@ -1112,20 +1216,142 @@ size_t convert_rowwise(
   return seg_row_count;
 }
 
+void ArrowResultSetConverter::exportBatches(
+    const size_t max_batch_entries,
+    const std::function<void(std::shared_ptr<arrow::RecordBatch>)>& write) const {
+  BatchReader reader(*this, max_batch_entries);
+  auto read_next = [&reader]() {
+    std::shared_ptr<arrow::RecordBatch> batch;
+    ARROW_THROW_NOT_OK(reader.ReadNext(&batch));
+    return batch;
+  };
+
+  auto batch = read_next();
+  while (batch) {
+    // Conversion is parallel by itself, the writer runs concurrently with it on
+    // the batch converted before.
+    auto next_batch = std::async(std::launch::async, read_next);
+    try {
+      if (batch->num_rows()) {
+        write(batch);
+      }
+    } catch (...) {
+      next_batch.wait();
+      throw;
+    }
+    batch = next_batch.get();
+  }
+}
+
+void ArrowResultSetConverter::exportToParquet(const std::string& file_name,
+                                              const size_t max_batch_entries) const {
+  auto timer = DEBUG_TIMER(__func__);
+  std::shared_ptr<arrow::io::FileOutputStream> file;
+  ARROW_ASSIGN_OR_THROW(file, arrow::io::FileOutputStream::Open(file_name));
+  // Columns of a row group are encoded and compressed in parallel. The stored schema
+  // restores dictionary encoded columns on read.
+  auto arrow_props = parquet::ArrowWriterProperties::Builder()
+                         .set_use_threads(true)
+                         ->store_schema()
+                         ->build();
+  std::unique_ptr<parquet::arrow::FileWriter> writer;
+  ARROW_ASSIGN_OR_THROW(
+      writer,
+      parquet::arrow::FileWriter::Open(*makeSchema(),
+                                       arrow::default_memory_pool(),
+                                       file,
+                                       parquet::default_writer_properties(),
+                                       arrow_props));
+  exportBatches(max_batch_entries,
+                [&writer](std::shared_ptr<arrow::RecordBatch> batch) {
+                  std::shared_ptr<arrow::Table> table;
+                  ARROW_ASSIGN_OR_THROW(table,
+                                        arrow::Table::FromRecordBatches({batch}));
+                  ARROW_THROW_NOT_OK(writer->WriteTable(*table, batch->num_rows()));
+                });
+  ARROW_THROW_NOT_OK(writer->Close());
+  ARROW_THROW_NOT_OK(file->Close());
+}
+
+namespace {
+
+// Each batch gets a dictionary of the strings it references, while IPC files don't
+// allow to replace dictionaries between batches. Such columns are written as
+// plain strings.
+std::shared_ptr<arrow::Schema> decodeDictionaries(
+    const std::shared_ptr<arrow::Schema>& schema) {
+  arrow::FieldVector fields;
+  for (auto& field : schema->fields()) {
+    if (field->type()->id() == arrow::Type::DICTIONARY) {
+      auto& dict_type = static_cast<const arrow::DictionaryType&>(*field->type());
+      fields.push_back(field->WithType(dict_type.value_type()));
+    } else {
+      fields.push_back(field);
+    }
+  }
+  return arrow::schema(std::move(fields));
+}
+
+std::shared_ptr<arrow::RecordBatch> decodeDictionaries(
+    const std::shared_ptr<arrow::RecordBatch>& batch,
+    const std::shared_ptr<arrow::Schema>& schema) {
+  std::vector<std::shared_ptr<arrow::Array>> columns;
+  for (auto& column : batch->columns()) {
+    if (column->type_id() == arrow::Type::DICTIONARY) {
+      auto& dict_arr = static_cast<const arrow::DictionaryArray&>(*column);
+      arrow::Datum decoded;
+      ARROW_ASSIGN_OR_THROW(
+          decoded, arrow::compute::Take(dict_arr.dictionary(), dict_arr.indices()));
+      columns.push_back(decoded.make_array());
+    } else {
+      columns.push_back(column);
+    }
+  }
+  return arrow::RecordBatch::Make(schema, batch->num_rows(), std::move(columns));
+}
+
+}  // namespace
+
+void ArrowResultSetConverter::exportToArrowIpc(const std::string& file_name,
+                                               const size_t max_batch_entries) const {
+  auto timer = DEBUG_TIMER(__func__);
+  std::shared_ptr<arrow::io::FileOutputStream> file;
+  ARROW_ASSIGN_OR_THROW(file, arrow::io::FileOutputStream::Open(file_name));
+  auto schema = decodeDictionaries(makeSchema());
+  std::shared_ptr<arrow::ipc::RecordBatchWriter> writer;
+  ARROW_ASSIGN_OR_THROW(writer, arrow::ipc::MakeFileWriter(file, schema));
+  exportBatches(max_batch_entries,
+                [&writer, &schema](std::shared_ptr<arrow::RecordBatch> batch) {
+                  ARROW_THROW_NOT_OK(
+                      writer->WriteRecordBatch(*decodeDictionaries(batch, schema)));
+                });
+  ARROW_THROW_NOT_OK(writer->Close());
+  ARROW_THROW_NOT_OK(file->Close());
+}
+
 std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::getArrowBatch(
     const std::shared_ptr<arrow::Schema>& schema) const {
-  std::vector<std::shared_ptr<arrow::Array>> result_columns;
-
   // First, check if the result set is empty.
   // If so, we return an arrow result set that only
   // contains the schema (no record batch will be serialized).
   if (results_->isEmpty()) {
-    return ARROW_RECORDBATCH_MAKE(schema, 0, result_columns);
+    return ARROW_RECORDBATCH_MAKE(
+        schema, 0, std::vector<std::shared_ptr<arrow::Array>>());
   }
 
   const size_t entry_count = top_n_ < 0
                                  ? results_->entryCount()
                                  : std::min(size_t(top_n_), results_->entryCount());
+  return getArrowBatch(schema, 0, entry_count);
+}
+
+std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::getArrowBatch(
+    const std::shared_ptr<arrow::Schema>& schema,
+    const size_t start_entry,
+    const size_t end_entry) const {
+  CHECK_LE(start_entry, end_entry);
+  std::vector<std::shared_ptr<arrow::Array>> result_columns;
+  const size_t entry_count = end_entry - start_entry;
 
   const auto col_count = results_->colCount();
   size_t row_count = 0;
@@ -1145,8 +1371,8 @@ std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::getArrowBatch(
           std::vector<std::shared_ptr<std::vector<bool>>>& null_bitmap_seg,
           std::vector<std::shared_ptr<std::vector<uint8_t>>>& null_bitmap_offset_seg,
           const std::vector<bool>& non_lazy_cols,
-          const size_t start_entry,
-          const size_t end_entry) -> size_t {
+          const size_t seg_start,
+          const size_t seg_end) -> size_t {
     return convert_rowwise(results_,
                            builders,
                            device_type_,
@@ -1155,8 +1381,8 @@ std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::getArrowBatch(
                            null_bitmap_seg,
                            null_bitmap_offset_seg,
                            non_lazy_cols,
-                           start_entry,
-                           end_entry);
+                           seg_start,
+                           seg_end);
   };
 
   auto convert_columns = [&](std::vector<std::shared_ptr<arrow::Array>>& result,
@@ -1182,8 +1408,55 @@ std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::getArrowBatch(
   bool use_columnar_converter = results_->isDirectColumnarConversionPossible() &&
                                 results_->getQueryMemDesc().getQueryDescriptionType() ==
                                     QueryDescriptionType::Projection &&
+                                start_entry == 0 &&
                                 entry_count == results_->entryCount();
+  // Group-by results with simple numeric targets are decoded column by column and
+  // only the remaining columns go through the row converter.
+  bool use_group_by_converter =
+      !use_columnar_converter && results_->isDirectColumnarConversionPossible() &&
+      !results_->isTruncated() && start_entry == 0 &&
+      entry_count == results_->entryCount();
   std::vector<bool> non_lazy_cols;
+  if (use_group_by_converter) {
+    size_t direct_col_count = 0;
+    non_lazy_cols.reserve(col_count);
+    for (size_t i = 0; i < col_count; ++i) {
+      const bool is_direct = results_->isDirectGroupByColumnCopyPossible(i) &&
+                             builders[i].field->type()->id() != arrow::Type::DICTIONARY;
+      non_lazy_cols.emplace_back(is_direct);
+      direct_col_count += is_direct;
+    }
+    if (direct_col_count) {
+      auto timer = DEBUG_TIMER("group-by converter");
+      const auto entries = results_->getNonEmptyEntries();
+      auto convert_range = [&](const size_t start_col, const size_t end_col) {
+        for (size_t col = start_col; col < end_col; ++col) {
+          if (non_lazy_cols[col]) {
+            convert_group_by_column(builders[col].physical_type,
+                                    results_,
+                                    col,
+                                    entries,
+                                    result_columns[col]);
+          }
+        }
+      };
+      if (multithreaded) {
+        threading::parallel_for(tbb::blocked_range<size_t>(0, col_count, 1),
+                                [&](const tbb::blocked_range<size_t>& r) {
+                                  convert_range(r.begin(), r.end());
+                                });
+      } else {
+        convert_range(0, col_count);
+      }
+      row_count = entries.size();
+      if (direct_col_count == col_count) {
+        non_lazy_cols.clear();
+      }
+    } else {
+      use_group_by_converter = false;
+      non_lazy_cols.clear();
+    }
+  }
   if (use_columnar_converter) {
     auto timer = DEBUG_TIMER("columnar converter");
     std::vector<size_t> non_lazy_col_pos;
@@ -1195,6 +1468,11 @@ std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::getArrowBatch(
     for (size_t i = 0; i < col_count; ++i) {
       bool is_lazy =
           lazy_fetch_info.empty() ? false : lazy_fetch_info[i].is_lazily_fetched;
+      // Lazily fetched numeric columns are gathered from fragments by their row ids.
+      if (is_lazy && (builders[i].physical_type->isInteger() ||
+                      builders[i].physical_type->isFloatingPoint())) {
+        is_lazy = false;
+      }
       // Currently column converter cannot handle some data types.
       // Treat them as lazy.
       switch (builders[i].physical_type->id()) {
@@ -1224,32 +1502,27 @@ std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::getArrowBatch(
       non_lazy_col_pos.emplace_back(col_count);
     }
 
-    std::vector<std::future<void>> child_threads;
-    size_t num_threads =
-        std::min(multithreaded ? (size_t)cpu_threads() : (size_t)1, non_lazy_col_count);
-
-    size_t start_col = 0;
-    size_t end_col = 0;
-    for (size_t i = 0; i < num_threads; ++i) {
-      start_col = end_col;
-      end_col = (i + 1) * non_lazy_col_count / num_threads;
+    auto convert_range = [&](const size_t start_col, const size_t end_col) {
       size_t phys_start_col =
           non_lazy_col_pos.empty() ? start_col : non_lazy_col_pos[start_col];
       size_t phys_end_col =
           non_lazy_col_pos.empty() ? end_col : non_lazy_col_pos[end_col];
-      child_threads.push_back(std::async(std::launch::async,
-                                         convert_columns,
-                                         std::ref(result_columns),
-                                         non_lazy_cols,
-                                         phys_start_col,
-                                         phys_end_col));
-    }
-    for (auto& child : child_threads) {
-      child.get();
+      convert_columns(result_columns, non_lazy_cols, phys_start_col, phys_end_col);
+    };
+    // Columns are converted as separate tasks, so that null bitmap generation
+    // within each column can share the same thread pool and wide result sets
+    // don't have to wait for the slowest group of columns.
+    if (multithreaded) {
+      threading::parallel_for(tbb::blocked_range<size_t>(0, non_lazy_col_count, 1),
+                              [&](const tbb::blocked_range<size_t>& r) {
+                                convert_range(r.begin(), r.end());
+                              });
+    } else {
+      convert_range(0, non_lazy_col_count);
     }
     row_count = entry_count;
   }
-  if (!use_columnar_converter || !non_lazy_cols.empty()) {
+  if (!(use_columnar_converter || use_group_by_converter) || !non_lazy_cols.empty()) {
     auto timer = DEBUG_TIMER("row converter");
     row_count = 0;
     if (multithreaded) {
@@ -1266,9 +1539,9 @@ std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::getArrowBatch(
               cpu_count,
               std::vector<std::shared_ptr<std::vector<uint8_t>>>(col_count, nullptr));
       const auto stride = (entry_count + cpu_count - 1) / cpu_count;
-      for (size_t i = 0, start_entry = 0; start_entry < entry_count;
-           ++i, start_entry += stride) {
-        const auto end_entry = std::min(entry_count, start_entry + stride);
+      for (size_t i = 0, seg_start = start_entry; seg_start < end_entry;
+           ++i, seg_start += stride) {
+        const auto seg_end = std::min(end_entry, seg_start + stride);
         child_threads.push_back(std::async(std::launch::async,
                                            fetch,
                                            std::ref(column_value_segs[i]),
@@ -1276,8 +1549,8 @@ std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::getArrowBatch(
                                            std::ref(null_bitmap_segs[i]),
                                            std::ref(offset_null_bitmap_segs[i]),
                                            non_lazy_cols,
-                                           start_entry,
-                                           end_entry));
+                                           seg_start,
+                                           seg_end));
       }
       for (auto& child : child_threads) {
         row_count += child.get();
@@ -1307,8 +1580,8 @@ std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::getArrowBatch(
                         null_bitmaps,
                         offset_null_bitmaps,
                         non_lazy_cols,
-                        size_t(0),
-                        entry_count);
+                        start_entry,
+                        end_entry);
       {
         auto timer = DEBUG_TIMER("append rows to arrow single thread");
         for (int i = 0; i < schema->num_fields(); ++i) {
@@ -97,6 +97,49 @@ RelAlgExecutionUnit create_ndv_execution_unit(const RelAlgExecutionUnit& ra_exe_
       ra_exe_unit.union_all};
 }
 
+std::optional<size_t> get_column_ndv_from_stats(
+    const hdk::ir::ColumnVar* col_var,
+    const std::vector<InputTableInfo>& table_infos) {
+  const auto table_info_it = std::find_if(
+      table_infos.begin(), table_infos.end(), [col_var](const InputTableInfo& info) {
+        return info.db_id == col_var->dbId() && info.table_id == col_var->tableId();
+      });
+  if (table_info_it == table_infos.end()) {
+    return std::nullopt;
+  }
+  const auto& column_stats = table_info_it->info.columnStats;
+  const auto stats_it = column_stats.find(col_var->columnId());
+  if (stats_it == column_stats.end()) {
+    return std::nullopt;
+  }
+  // NULL values form one more group.
+  return stats_it->second->distinctCount() + (stats_it->second->nullCount() ? 1 : 0);
+}
+
+std::optional<size_t> get_ndv_estimation_from_column_stats(
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const std::vector<InputTableInfo>& table_infos,
+    const size_t max_groups) {
+  size_t groups = 1;
+  for (const auto& groupby_expr : ra_exe_unit.groupby_exprs) {
+    const auto col_var =
+        groupby_expr ? groupby_expr->as<hdk::ir::ColumnVar>() : nullptr;
+    if (!col_var) {
+      return std::nullopt;
+    }
+    const auto col_groups = get_column_ndv_from_stats(col_var, table_infos);
+    if (!col_groups) {
+      return std::nullopt;
+    }
+    if (*col_groups && groups > max_groups / *col_groups) {
+      return std::nullopt;
+    }
+    groups = std::max(groups * *col_groups, size_t(1));
+  }
+  VLOG(1) << "Estimated " << groups << " groups from column statistics.";
+  return groups;
+}
+
 RelAlgExecutionUnit create_count_all_execution_unit(
     const RelAlgExecutionUnit& ra_exe_unit,
     hdk::ir::ExprPtr replacement_target) {
@@ -25,6 +25,7 @@
 #ifndef QUERYENGINE_CARDINALITYESTIMATOR_H
 #define QUERYENGINE_CARDINALITYESTIMATOR_H
 
+#include "InputMetadata.h"
 #include "RelAlgExecutionUnit.h"
 
 #include "Analyzer/Analyzer.h"
@@ -48,6 +49,20 @@ RelAlgExecutionUnit create_ndv_execution_unit(const RelAlgExecutionUnit& ra_exe_
                                               const Config& config,
                                               const int64_t range);
 
+// Returns the number of distinct values of the column, counting NULL as one more value,
+// from statistics provided by storage, or std::nullopt if there are no statistics.
+std::optional<size_t> get_column_ndv_from_stats(
+    const hdk::ir::ColumnVar* col_var,
+    const std::vector<InputTableInfo>& table_infos);
+
+// Estimates the number of groups using statistics of the group by columns provided by
+// storage. Returns std::nullopt if some column has no statistics or the estimation
+// exceeds max_groups.
+std::optional<size_t> get_ndv_estimation_from_column_stats(
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const std::vector<InputTableInfo>& table_infos,
+    const size_t max_groups);
+
 RelAlgExecutionUnit create_count_all_execution_unit(
     const RelAlgExecutionUnit& ra_exe_unit,
     hdk::ir::ExprPtr replacement_target);
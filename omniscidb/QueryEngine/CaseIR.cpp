@@ -17,6 +17,69 @@
 #include "CodeGenerator.h"
 #include "Execute.h"
 
+#include <unordered_set>
+
+namespace {
+
+// Returns true for expressions which can be evaluated for rows not selected by their
+// CASE branch: they have no side effects, can't fail and are cheap to compute.
+bool is_cheap_and_safe(const hdk::ir::Expr* expr) {
+  const auto type = expr->type();
+  if (type->isString() || type->isArray()) {
+    return false;
+  }
+  if (expr->is<hdk::ir::Constant>()) {
+    return true;
+  }
+  if (auto col_var = expr->as<hdk::ir::ColumnVar>()) {
+    return !col_var->isVirtual();
+  }
+  if (auto uoper = expr->as<hdk::ir::UOper>()) {
+    return (uoper->isNot() || uoper->isIsNull()) && is_cheap_and_safe(uoper->operand());
+  }
+  if (auto bin_oper = expr->as<hdk::ir::BinOper>()) {
+    if (bin_oper->qualifier() != hdk::ir::Qualifier::kOne) {
+      return false;
+    }
+    // Integer arithmetic can overflow and division can fail, so only floating point
+    // addition, subtraction and multiplication are allowed.
+    const bool safe_op =
+        bin_oper->isComparison() || bin_oper->isLogic() ||
+        ((bin_oper->isPlus() || bin_oper->isMinus() || bin_oper->isMul()) &&
+         type->isFloatingPoint());
+    return safe_op && is_cheap_and_safe(bin_oper->leftOperand()) &&
+           is_cheap_and_safe(bin_oper->rightOperand());
+  }
+  return false;
+}
+
+// Returns the column compared by all branches for equality with distinct integer
+// constants, as in CASE x WHEN 1 THEN ... WHEN 2 THEN ..., and nullptr otherwise.
+const hdk::ir::ColumnVar* get_switch_column(const hdk::ir::CaseExpr* case_expr) {
+  const hdk::ir::ColumnVar* res = nullptr;
+  for (const auto& [when_expr, then_expr] : case_expr->exprPairs()) {
+    auto bin_oper = when_expr->as<hdk::ir::BinOper>();
+    if (!bin_oper || !bin_oper->isEq() ||
+        bin_oper->qualifier() != hdk::ir::Qualifier::kOne ||
+        !then_expr->is<hdk::ir::Constant>()) {
+      return nullptr;
+    }
+    auto col_var = bin_oper->leftOperand()->as<hdk::ir::ColumnVar>();
+    auto constant = bin_oper->rightOperand()->as<hdk::ir::Constant>();
+    if (!col_var || !constant || constant->isNull() || col_var->isVirtual() ||
+        !col_var->type()->isInteger() ||
+        !col_var->type()->withNullable(false)->equal(
+            constant->type()->withNullable(false)) ||
+        (res && !(*res == *col_var))) {
+      return nullptr;
+    }
+    res = col_var;
+  }
+  return res;
+}
+
+}  // namespace
+
 std::vector<llvm::Value*> CodeGenerator::codegen(const hdk::ir::CaseExpr* case_expr,
                                                  const CompilationOptions& co) {
   AUTOMATIC_IR_METADATA(cgen_state_);
@@ -39,7 +102,16 @@ std::vector<llvm::Value*> CodeGenerator::codegen(const hdk::ir::CaseExpr* case_e
   CHECK(case_llvm_type);
   const auto& else_type = case_expr->elseExpr()->type();
   CHECK_EQ(else_type->id(), case_type->id());
-  llvm::Value* case_val = codegenCase(case_expr, case_llvm_type, is_real_str, co);
+  llvm::Value* case_val = nullptr;
+  if (!is_real_str && config_.exec.codegen.enable_branchless_case) {
+    case_val = codegenCaseSwitch(case_expr, case_llvm_type, co);
+    if (!case_val) {
+      case_val = codegenCaseSelect(case_expr, co);
+    }
+  }
+  if (!case_val) {
+    case_val = codegenCase(case_expr, case_llvm_type, is_real_str, co);
+  }
   std::vector<llvm::Value*> ret_vals{case_val};
   if (is_real_str) {
     ret_vals.push_back(cgen_state_->emitCall("extract_str_ptr", {case_val}));
@@ -114,3 +186,102 @@ llvm::Value* CodeGenerator::codegenCase(const hdk::ir::CaseExpr* case_expr,
   then_phi->addIncoming(else_lv, else_bb);
   return then_phi;
 }
+
+llvm::Value* CodeGenerator::codegenCaseSelect(const hdk::ir::CaseExpr* case_expr,
+                                              const CompilationOptions& co) {
+  AUTOMATIC_IR_METADATA(cgen_state_);
+  if (!is_cheap_and_safe(case_expr->elseExpr())) {
+    return nullptr;
+  }
+  for (const auto& [when_expr, then_expr] : case_expr->exprPairs()) {
+    if (!is_cheap_and_safe(when_expr.get()) || !is_cheap_and_safe(then_expr.get())) {
+      return nullptr;
+    }
+  }
+  // All branches are computed in a straight line and the first matching one is picked
+  // by a chain of selects, which is vectorizable and doesn't mispredict.
+  std::vector<std::pair<llvm::Value*, llvm::Value*>> branch_lvs;
+  for (const auto& [when_expr, then_expr] : case_expr->exprPairs()) {
+    const auto when_lv = toBool(codegen(when_expr.get(), true, co).front());
+    const auto then_lvs = codegen(then_expr.get(), true, co);
+    CHECK_EQ(size_t(1), then_lvs.size());
+    branch_lvs.emplace_back(when_lv, then_lvs.front());
+  }
+  const auto else_lvs = codegen(case_expr->elseExpr(), true, co);
+  CHECK_EQ(size_t(1), else_lvs.size());
+  llvm::Value* res = else_lvs.front();
+  for (auto it = branch_lvs.rbegin(); it != branch_lvs.rend(); ++it) {
+    CHECK_EQ(it->second->getType(), res->getType());
+    res = cgen_state_->ir_builder_.CreateSelect(it->first, it->second, res);
+  }
+  return res;
+}
+
+llvm::Value* CodeGenerator::codegenCaseSwitch(const hdk::ir::CaseExpr* case_expr,
+                                              llvm::Type* case_llvm_type,
+                                              const CompilationOptions& co) {
+  AUTOMATIC_IR_METADATA(cgen_state_);
+  const auto col_var = get_switch_column(case_expr);
+  if (!col_var || case_expr->exprPairs().size() < 2) {
+    return nullptr;
+  }
+  const auto col_lv = codegen(col_var, true, co).front();
+  if (!col_lv->getType()->isIntegerTy()) {
+    return nullptr;
+  }
+  // Constant results of a switch are turned into a lookup table by LLVM. A null value
+  // of the column doesn't match any case and gets the ELSE result, so a constant equal
+  // to the null sentinel can't be used as a case.
+  const int64_t null_val = inline_int_null_value(col_var->type());
+  for (const auto& expr_pair : case_expr->exprPairs()) {
+    auto constant = expr_pair.first->as<hdk::ir::BinOper>()
+                        ->rightOperand()
+                        ->as<hdk::ir::Constant>();
+    if (col_var->type()->nullable() && constant->intVal() == null_val) {
+      return nullptr;
+    }
+  }
+  Executor::FetchCacheAnchor anchor(cgen_state_);
+  auto& ir_builder = cgen_state_->ir_builder_;
+  const auto end_bb = llvm::BasicBlock::Create(
+      cgen_state_->context_, "end_case", cgen_state_->current_func_);
+  const auto else_bb = llvm::BasicBlock::Create(
+      cgen_state_->context_, "else_case", cgen_state_->current_func_, end_bb);
+  auto switch_inst =
+      ir_builder.CreateSwitch(col_lv, else_bb, case_expr->exprPairs().size());
+  std::vector<std::pair<llvm::Value*, llvm::BasicBlock*>> incoming;
+  std::unordered_set<int64_t> case_vals;
+  for (const auto& [when_expr, then_expr] : case_expr->exprPairs()) {
+    const auto case_val = when_expr->as<hdk::ir::BinOper>()
+                              ->rightOperand()
+                              ->as<hdk::ir::Constant>()
+                              ->intVal();
+    // The first branch wins for repeated values.
+    if (!case_vals.insert(case_val).second) {
+      continue;
+    }
+    const auto then_bb = llvm::BasicBlock::Create(
+        cgen_state_->context_, "then_case", cgen_state_->current_func_, end_bb);
+    switch_inst->addCase(
+        llvm::cast<llvm::ConstantInt>(llvm::ConstantInt::get(col_lv->getType(),
+                                                             case_val,
+                                                             /*isSigned=*/true)),
+        then_bb);
+    ir_builder.SetInsertPoint(then_bb);
+    const auto then_lvs = codegen(then_expr.get(), true, co);
+    CHECK_EQ(size_t(1), then_lvs.size());
+    incoming.emplace_back(then_lvs.front(), ir_builder.GetInsertBlock());
+    ir_builder.CreateBr(end_bb);
+  }
+  ir_builder.SetInsertPoint(else_bb);
+  const auto else_lvs = codegen(case_expr->elseExpr(), true, co);
+  CHECK_EQ(size_t(1), else_lvs.size());
+  incoming.emplace_back(else_lvs.front(), ir_builder.GetInsertBlock());
+  ir_builder.CreateBr(end_bb);
+  ir_builder.SetInsertPoint(end_bb);
+  auto phi = ir_builder.CreatePHI(case_llvm_type, incoming.size());
+  for (auto& [lv, bb] : incoming) {
+    phi->addIncoming(lv, bb);
+  }
+  return phi;
+}
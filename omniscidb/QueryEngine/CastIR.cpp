@@ -43,6 +43,23 @@ llvm::Value* CodeGenerator::codegenCast(const hdk::ir::UOper* uoper,
     operand_lv = codegen(operand, true, co).front();
   }
   const auto& operand_type = operand->type();
+  const auto operand_col = dynamic_cast<const hdk::ir::ColumnVar*>(operand);
+  if ((operand_type->isInteger() || operand_type->isDecimal()) &&
+      (type->isInteger() || type->isDecimal()) && !operand_as_const &&
+      !(operand_col && operand_col->tableId() < 0)) {
+    // Skip overflow checks of upscaling and narrowing casts if the result range fits
+    // the target type. Ranges of temporary columns are too expensive to compute.
+    llvm::Value* chosen_max{nullptr};
+    llvm::Value* chosen_min{nullptr};
+    std::tie(chosen_max, chosen_min) =
+        cgen_state_->inlineIntMaxMin(type->canonicalSize(), true);
+    if (checkExpressionRanges(
+            uoper,
+            static_cast<llvm::ConstantInt*>(chosen_min)->getSExtValue(),
+            static_cast<llvm::ConstantInt*>(chosen_max)->getSExtValue())) {
+      return codegenCastBetweenIntTypes(operand_lv, operand_type, type, true, false);
+    }
+  }
   return codegenCast(
       operand_lv, operand_type, type, operand_as_const, uoper->isDictIntersection(), co);
 }
@@ -288,7 +305,8 @@ llvm::Value* CodeGenerator::codegenCastFromString(llvm::Value* operand_lv,
 llvm::Value* CodeGenerator::codegenCastBetweenIntTypes(llvm::Value* operand_lv,
                                                        const hdk::ir::Type* operand_type,
                                                        const hdk::ir::Type* type,
-                                                       bool upscale) {
+                                                       bool upscale,
+                                                       bool check_overflow) {
   AUTOMATIC_IR_METADATA(cgen_state_);
   auto target_scale = type->isDecimal() ? type->as<hdk::ir::DecimalType>()->scale() : 0;
   auto op_scale =
@@ -302,7 +320,10 @@ llvm::Value* CodeGenerator::codegenCastBetweenIntTypes(llvm::Value* operand_lv,
         operand_lv = cgen_state_->ir_builder_.CreateSExt(
             operand_lv, get_int_type(64, cgen_state_->context_));
 
-        codegenCastBetweenIntTypesOverflowChecks(operand_lv, operand_type, type, scale);
+        if (check_overflow) {
+          codegenCastBetweenIntTypesOverflowChecks(
+              operand_lv, operand_type, type, scale);
+        }
 
         if (operand_type->nullable()) {
           operand_lv = cgen_state_->emitCall(
@@ -335,7 +356,7 @@ llvm::Value* CodeGenerator::codegenCastBetweenIntTypes(llvm::Value* operand_lv,
         method_name,
         {operand_lv, scale_lv, cgen_state_->llInt(inline_int_null_value(operand_type))});
   }
-  if (type->isInteger() && operand_type->isInteger() &&
+  if (check_overflow && type->isInteger() && operand_type->isInteger() &&
       operand_type->size() > type->size()) {
     codegenCastBetweenIntTypesOverflowChecks(operand_lv, operand_type, type, 1);
   }
@@ -233,6 +233,44 @@ void CgenState::emitErrorCheck(llvm::Value* condition,
   ir_builder_.SetInsertPoint(check_ok);
 }
 
+void CgenState::addCommonSubexpr(const hdk::ir::Expr* expr) {
+  common_subexpr_cache_.push_back({expr, nullptr, {}});
+}
+
+const std::vector<llvm::Value*>* CgenState::getCommonSubexprValues(
+    const hdk::ir::Expr* expr) {
+  for (auto& entry : common_subexpr_cache_) {
+    if (entry.expr != expr && !(*entry.expr == *expr)) {
+      continue;
+    }
+    if (!entry.bb) {
+      return nullptr;
+    }
+    // Only chains of single predecessors are followed, which is enough to find the
+    // values computed by previous expressions of the same row.
+    for (auto bb = ir_builder_.GetInsertBlock(); bb;) {
+      if (bb == entry.bb) {
+        return &entry.lvs;
+      }
+      auto pred = bb->getSinglePredecessor();
+      bb = pred != bb ? pred : nullptr;
+    }
+    return nullptr;
+  }
+  return nullptr;
+}
+
+void CgenState::setCommonSubexprValues(const hdk::ir::Expr* expr,
+                                       const std::vector<llvm::Value*>& lvs) {
+  for (auto& entry : common_subexpr_cache_) {
+    if (entry.expr == expr || *entry.expr == *expr) {
+      entry.bb = ir_builder_.GetInsertBlock();
+      entry.lvs = lvs;
+      return;
+    }
+  }
+}
+
 namespace {
 
 // clang-format off
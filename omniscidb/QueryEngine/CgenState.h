@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "DateLookupTable.h"
 #include "IRCodegenUtils.h"
 #include "InValuesBitmap.h"
 #include "InputMetadata.h"
@@ -204,6 +205,12 @@ struct CgenState {
     in_values_bitmaps_.emplace_back(std::move(in_values_bitmap));
     return in_values_bitmaps_.back().get();
   }
+  const DateLookupTable* moveDateLookupTable(
+      std::unique_ptr<const DateLookupTable>&& date_lookup_table) {
+    date_lookup_tables_.emplace_back(std::move(date_lookup_table));
+    return date_lookup_tables_.back().get();
+  }
+
   void moveInValuesBitmap(std::unique_ptr<const InValuesBitmap>& in_values_bitmap) {
     if (!in_values_bitmap->isEmpty()) {
       in_values_bitmaps_.emplace_back(std::move(in_values_bitmap));
@@ -320,6 +327,14 @@ struct CgenState {
 
   void emitErrorCheck(llvm::Value* condition, llvm::Value* errorCode, std::string label);
 
+  // Common subexpressions of the execution unit are registered before codegen. The
+  // values of the first occurrence are reused by the following ones as long as the
+  // block where they were computed dominates the insertion point.
+  void addCommonSubexpr(const hdk::ir::Expr* expr);
+  const std::vector<llvm::Value*>* getCommonSubexprValues(const hdk::ir::Expr* expr);
+  void setCommonSubexprValues(const hdk::ir::Expr* expr,
+                              const std::vector<llvm::Value*>& lvs);
+
   std::vector<std::string> gpuFunctionsToReplace(llvm::Function* fn);
 
   void replaceFunctionForGpu(const std::string& fcn_to_replace, llvm::Function* fn);
@@ -374,6 +389,13 @@ struct CgenState {
     llvm::Value* lv;
   };
   std::vector<FunctionOperValue> ext_call_cache_;
+
+  struct CommonSubexprValues {
+    const hdk::ir::Expr* expr;
+    llvm::BasicBlock* bb;
+    std::vector<llvm::Value*> lvs;
+  };
+  std::vector<CommonSubexprValues> common_subexpr_cache_;
   std::vector<llvm::Value*> group_by_expr_cache_;
   std::vector<llvm::Value*> str_constants_;
   std::vector<llvm::Value*> frag_offsets_;
@@ -384,6 +406,7 @@ struct CgenState {
   std::vector<std::unique_ptr<const InValuesBitmap>> in_values_bitmaps_;
   std::vector<std::unique_ptr<const StringDictionaryTranslationMgr>>
       str_dict_translation_mgrs_;
+  std::vector<std::unique_ptr<const DateLookupTable>> date_lookup_tables_;
   std::map<std::pair<llvm::Value*, llvm::Value*>, ArrayLoadCodegen>
       array_load_cache_;  // byte stream to array info
   bool needs_error_check_;
@@ -17,9 +17,12 @@
 #ifndef QUERYENGINE_CODECACHEACCESSOR_HPP
 #define QUERYENGINE_CODECACHEACCESSOR_HPP
 
+#include <algorithm>
 #include <mutex>
 #include <string>
+#include <vector>
 #include "QueryEngine/CodeCache.h"
+#include "Shared/Metrics.h"
 
 template <typename CompilationContext>
 class CodeCacheAccessor {
@@ -33,6 +36,13 @@ class CodeCacheAccessor {
       , overwrite_count_(0)
       , evict_count_(0)
       , name_(std::move(name))
+      , hits_metric_(metrics::Registry::get().counter("hdk_code_cache_hits_total",
+                                                      "Code cache lookups found code.",
+                                                      {{"cache", name_}}))
+      , misses_metric_(
+            metrics::Registry::get().counter("hdk_code_cache_misses_total",
+                                             "Code cache lookups missed code.",
+                                             {{"cache", name_}}))
       , compiling_key_(nullptr) {}
 
   // TODO: replace get_value/put with get_or_wait/put workflow.
@@ -42,8 +52,10 @@ class CodeCacheAccessor {
     auto it = code_cache_.find(key);
     if (it != code_cache_.cend()) {
       found_count_++;
+      hits_metric_.inc();
       return it->second;
     }
+    misses_metric_.inc();
     return {};
   }
 
@@ -56,6 +68,9 @@ class CodeCacheAccessor {
       put_count_++;
       if (it == code_cache_.cend()) {
         code_cache_.put(key, value);
+        if (max_bytes_) {
+          evictToFitBytesImpl(max_bytes_);
+        }
       } else {
         ignore_count_++;
         warn = true;
@@ -66,6 +81,17 @@ class CodeCacheAccessor {
     }
   }
 
+  // Replace code for the key, e.g. with a better optimized version.
+  void replace(const CodeCacheKey& key, CodeCacheVal<CompilationContext>& value) {
+    std::lock_guard<std::mutex> lock(code_cache_mutex_);
+    auto it = code_cache_.find(key);
+    put_count_++;
+    if (it != code_cache_.cend()) {
+      overwrite_count_++;
+    }
+    code_cache_.put(key, value);
+  }
+
   // get_or_wait and put should be used in pair.
   CodeCacheVal<CompilationContext>* get_or_wait(const CodeCacheKey& key) {
     std::unique_lock<std::mutex> lk(code_cache_mutex_);
@@ -74,6 +100,7 @@ class CodeCacheAccessor {
     auto result = code_cache_.get(key);
     if (result) {
       found_count_++;
+      hits_metric_.inc();
       return result;
     }
 
@@ -83,8 +110,10 @@ class CodeCacheAccessor {
     result = code_cache_.get(key);
     if (result) {
       found_count_++;
+      hits_metric_.inc();
       return result;
     }
+    misses_metric_.inc();
 
     if (compiling_key_) {
       CHECK(false);
@@ -99,6 +128,9 @@ class CodeCacheAccessor {
     CHECK(it == code_cache_.cend());
     put_count_++;
     code_cache_.put(key, value);
+    if (max_bytes_) {
+      evictToFitBytesImpl(max_bytes_);
+    }
 
     compiling_key_ = nullptr;
     compilation_cv_.notify_all();
@@ -115,6 +147,25 @@ class CodeCacheAccessor {
     code_cache_.evictFractionEntries(fraction);
   }
 
+  // Limit the total code size of cached entries, zero means no limit. Requires
+  // CompilationContext::codeSize() to be set for cached values.
+  void setMaxBytes(const size_t max_bytes) {
+    std::lock_guard<std::mutex> lock(code_cache_mutex_);
+    max_bytes_ = max_bytes;
+  }
+
+  // Free at least the given fraction of the total cached code size.
+  void evictFractionBytes(const float fraction) {
+    std::lock_guard<std::mutex> lock(code_cache_mutex_);
+    evict_count_++;
+    evictToFitBytesImpl(static_cast<size_t>(totalBytesImpl() * (1.0 - fraction)));
+  }
+
+  size_t totalBytes() {
+    std::lock_guard<std::mutex> lock(code_cache_mutex_);
+    return totalBytesImpl();
+  }
+
   friend std::ostream& operator<<(std::ostream& os, CodeCacheAccessor& c) {
     std::lock_guard<std::mutex> lock(c.code_cache_mutex_);
     os << "CodeCacheAccessor<" << c.name_ << ">[current size=" << c.code_cache_.size()
@@ -137,18 +188,66 @@ class CodeCacheAccessor {
   }
 
  private:
+  size_t totalBytesImpl() const {
+    size_t total = 0;
+    for (auto it = code_cache_.crbegin(); it != code_cache_.crend(); ++it) {
+      total += it->second ? it->second->codeSize() : 0;
+    }
+    return total;
+  }
+
+  // Evict entries until the remaining code fits max_bytes. Candidates are the least
+  // recently used half of entries. Among them, code which was cheap to compile
+  // relative to its size goes first, so expensive kernels survive bursts of large
+  // but simple ones. The most recently used entry is never evicted.
+  void evictToFitBytesImpl(const size_t max_bytes) {
+    auto total = totalBytesImpl();
+    if (total <= max_bytes || code_cache_.size() < 2) {
+      return;
+    }
+    std::vector<std::pair<double, CodeCacheKey>> candidates;
+    const size_t num_candidates = std::max(code_cache_.size() / 2, size_t(1));
+    for (auto it = code_cache_.crbegin();
+         it != code_cache_.crend() && candidates.size() < num_candidates;
+         ++it) {
+      const auto code_size = it->second ? it->second->codeSize() : 0;
+      const auto time_ms = it->second ? it->second->compilationTimeMs() : 0;
+      candidates.emplace_back(
+          static_cast<double>(time_ms) / std::max(code_size, size_t(1)), it->first);
+    }
+    std::stable_sort(
+        candidates.begin(), candidates.end(), [](const auto& lhs, const auto& rhs) {
+          return lhs.first < rhs.first;
+        });
+    for (auto& candidate : candidates) {
+      if (total <= max_bytes) {
+        break;
+      }
+      auto it = code_cache_.find(candidate.second);
+      CHECK(it != code_cache_.cend());
+      const auto code_size = it->second ? it->second->codeSize() : 0;
+      code_cache_.erase(candidate.second);
+      total -= code_size;
+    }
+  }
+
   CodeCache<CompilationContext> code_cache_;
   // cumulative statistics of code cache usage
   int64_t get_count_, found_count_, put_count_, ignore_count_, overwrite_count_,
       evict_count_;
   // name of the code cache
   const std::string name_;
+  // process-wide metrics shared by caches with the same name
+  metrics::Counter& hits_metric_;
+  metrics::Counter& misses_metric_;
   // used to lock any access to the code cache:
   std::mutex code_cache_mutex_;
   // releases locks when compulation has completed succesfully:
   std::condition_variable compilation_cv_;
   // holds pointer to key for which compilation is in progress
   const CodeCacheKey* compiling_key_;
+  // limit for the total code size of entries, disabled if zero
+  size_t max_bytes_{0};
 };
 
 #endif
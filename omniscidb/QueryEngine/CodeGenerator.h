@@ -63,7 +63,8 @@ class CodeGenerator {
   llvm::Value* codegenCastBetweenIntTypes(llvm::Value* operand_lv,
                                           const hdk::ir::Type* operand_type,
                                           const hdk::ir::Type* type,
-                                          bool upscale = true);
+                                          bool upscale = true,
+                                          bool check_overflow = true);
 
   void codegenCastBetweenIntTypesOverflowChecks(llvm::Value* operand_lv,
                                                 const hdk::ir::Type* operand_type,
@@ -73,8 +74,19 @@ class CodeGenerator {
   // Generates the index of the current row in the context of query execution.
   llvm::Value* posArg(const hdk::ir::Expr*) const;
 
+  // Returns the buffer of the given column fetched for the current fragment.
+  llvm::Value* colByteStream(const hdk::ir::ColumnVar* col_var,
+                             const bool fetch_column,
+                             const bool hoist_literals);
+
   llvm::Value* toBool(llvm::Value*);
 
+  // Generates an increment of the evaluation counter of the expression when
+  // expression counters are enabled. Only CPU code is counted.
+  void codegenExpressionCounter(const char* kind,
+                                const hdk::ir::Expr* expr,
+                                const CompilationOptions& co);
+
   llvm::Value* castArrayPointer(llvm::Value* ptr, const hdk::ir::Type* elem_type);
 
   static std::unordered_set<llvm::Function*> markDeadRuntimeFuncs(
@@ -92,7 +104,8 @@ class CodeGenerator {
   static bool prioritizeQuals(const RelAlgExecutionUnit& ra_exe_unit,
                               std::vector<const hdk::ir::Expr*>& primary_quals,
                               std::vector<const hdk::ir::Expr*>& deferred_quals,
-                              const PlanState::HoistedFiltersSet& hoisted_quals);
+                              const PlanState::HoistedFiltersSet& hoisted_quals,
+                              const bool reorder_quals = false);
 
   struct ExecutorRequired : public std::runtime_error {
     ExecutorRequired()
@@ -116,6 +129,10 @@ class CodeGenerator {
   };
 
  private:
+  std::vector<llvm::Value*> codegenExpr(const hdk::ir::Expr*,
+                                        const bool fetch_columns,
+                                        const CompilationOptions&);
+
   std::vector<llvm::Value*> codegen(const hdk::ir::Constant*,
                                     bool use_dict_encoding,
                                     int dict_id,
@@ -335,10 +352,27 @@ class CodeGenerator {
                            const bool is_real_str,
                            const CompilationOptions&);
 
+  // Branch-free CASE for cheap side-effect free branches. Returns nullptr if the CASE
+  // doesn't qualify.
+  llvm::Value* codegenCaseSelect(const hdk::ir::CaseExpr*, const CompilationOptions&);
+
+  // CASE over equality of a column with integer constants as a switch, which LLVM
+  // turns into a lookup table. Returns nullptr if the CASE doesn't qualify.
+  llvm::Value* codegenCaseSwitch(const hdk::ir::CaseExpr*,
+                                 llvm::Type* case_llvm_type,
+                                 const CompilationOptions&);
+
   llvm::Value* codegenExtractHighPrecisionTimestamps(llvm::Value*,
                                                      const hdk::ir::Type*,
                                                      const hdk::ir::DateExtractField&);
 
+  // Returns nullptr if the range of date_expr is unknown or too wide for a table.
+  llvm::Value* codegenDateLookup(const hdk::ir::Expr* date_expr,
+                                 llvm::Value* date_lv,
+                                 const std::function<int64_t(int64_t)>& fn,
+                                 llvm::Value* null_lv,
+                                 const CompilationOptions&);
+
   llvm::Value* codegenDateTruncHighPrecisionTimestamps(llvm::Value*,
                                                        const hdk::ir::Type*,
                                                        const hdk::ir::DateTruncField&);
@@ -377,21 +411,32 @@ class CodeGenerator {
                                  hdk::ir::OpType,
                                  const CompilationOptions& co);
 
+  llvm::Value* codegenDictCharLength(const hdk::ir::CharLengthExpr*,
+                                     llvm::Value* str_id_lv,
+                                     const CompilationOptions&);
+
   llvm::Value* codegenDictRegexp(const hdk::ir::ExprPtr arg,
                                  const hdk::ir::Constant* pattern,
                                  const char escape_char,
                                  const CompilationOptions&);
 
+  // Matches OR'ed REGEXP filters on the same none-encoded string in one pass, null if
+  // the expression has other operands.
+  llvm::Value* codegenRegexpDisjunction(const hdk::ir::BinOper*,
+                                        const CompilationOptions&);
+
+  // Matches a none-encoded string against patterns compiled once per query.
+  llvm::Value* codegenRegexpMatch(const hdk::ir::Expr* arg,
+                                  const std::vector<std::string>& patterns,
+                                  const hdk::ir::Type* type,
+                                  const CompilationOptions&);
+
   // Returns the IR value which holds true iff at least one match has been found for outer
   // join, null if there's no outer join condition on the given nesting level.
   llvm::Value* foundOuterJoinMatch(const size_t nesting_level) const;
 
   llvm::Value* resolveGroupedColumnReference(const hdk::ir::ColumnVar*);
 
-  llvm::Value* colByteStream(const hdk::ir::ColumnVar* col_var,
-                             const bool fetch_column,
-                             const bool hoist_literals);
-
   hdk::ir::ExprPtr hashJoinLhs(const hdk::ir::ColumnVar* rhs) const;
 
   std::shared_ptr<const hdk::ir::ColumnVar> hashJoinLhsTuple(
@@ -431,6 +476,14 @@ class CodeGenerator {
                          llvm::Value* buffer_is_null,
                          std::vector<llvm::Value*>& output_args);
 
+  // Generates a call of the batch implementation of the extension function, when one
+  // is registered and all arguments are plain columns of the outer table. Returns
+  // nullptr when the row-wise function has to be called instead.
+  llvm::Value* codegenBatchFunctionOper(const hdk::ir::FunctionOper* function_oper,
+                                        const ExtensionFunction& ext_func_sig,
+                                        llvm::Type* ret_ty,
+                                        const CompilationOptions& co);
+
   std::vector<llvm::Value*> codegenFunctionOperCastArgs(
       const hdk::ir::FunctionOper*,
       const ExtensionFunction*,
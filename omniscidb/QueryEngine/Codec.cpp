@@ -71,6 +71,26 @@ llvm::Instruction* DiffFixedWidthInt::codegenDecode(llvm::Value* byte_stream,
   return llvm::CallInst::Create(f, args);
 }
 
+FrameOfReferenceInt::FrameOfReferenceInt(const size_t byte_width,
+                                         const int64_t baseline,
+                                         const int64_t null_val)
+    : byte_width_{byte_width}, baseline_{baseline}, null_val_{null_val} {}
+
+llvm::Instruction* FrameOfReferenceInt::codegenDecode(llvm::Value* byte_stream,
+                                                      llvm::Value* pos,
+                                                      llvm::Module* llvm_module) const {
+  auto& context = llvm_module->getContext();
+  auto f = llvm_module->getFunction("frame_of_reference_int_decode");
+  CHECK(f);
+  llvm::Value* args[] = {
+      byte_stream,
+      llvm::ConstantInt::get(llvm::Type::getInt32Ty(context), byte_width_),
+      llvm::ConstantInt::get(llvm::Type::getInt64Ty(context), baseline_),
+      llvm::ConstantInt::get(llvm::Type::getInt64Ty(context), null_val_),
+      pos};
+  return llvm::CallInst::Create(f, args);
+}
+
 FixedWidthReal::FixedWidthReal(const bool is_double) : is_double_(is_double) {}
 
 llvm::Instruction* FixedWidthReal::codegenDecode(llvm::Value* byte_stream,
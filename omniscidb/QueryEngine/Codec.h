@@ -65,6 +65,23 @@ class DiffFixedWidthInt : public Decoder {
   const int64_t baseline_;
 };
 
+// Unsigned offsets from the baseline with the all-ones value reserved for nulls,
+// see FrameOfReferenceEncoding.h.
+class FrameOfReferenceInt : public Decoder {
+ public:
+  FrameOfReferenceInt(const size_t byte_width,
+                      const int64_t baseline,
+                      const int64_t null_val);
+  llvm::Instruction* codegenDecode(llvm::Value* byte_stream,
+                                   llvm::Value* pos,
+                                   llvm::Module* llvm_module) const override;
+
+ private:
+  const size_t byte_width_;
+  const int64_t baseline_;
+  const int64_t null_val_;
+};
+
 class FixedWidthReal : public Decoder {
  public:
   FixedWidthReal(const bool is_double);
@@ -21,6 +21,7 @@
 #include "DataMgr/ArrayNoneEncoder.h"
 #include "QueryEngine/ErrorHandling.h"
 #include "QueryEngine/Execute.h"
+#include "ResultSetRegistry/ResultSetRegistry.h"
 #include "Shared/Intervals.h"
 #include "Shared/likely.h"
 #include "Shared/sqltypes.h"
@@ -231,6 +232,90 @@ const int8_t* ColumnFetcher::getOneTableColumnFragment(
   }
 }
 
+const int8_t* ColumnFetcher::getOneTableEncodedColumnFragment(
+    ColumnInfoPtr col_info,
+    const int frag_id,
+    const std::map<TableRef, const TableFragments*>& all_tables_fragments,
+    std::list<std::shared_ptr<Chunk_NS::Chunk>>& chunk_holder,
+    std::list<ChunkIter>& chunk_iter_holder,
+    const FrameOfReferenceEncoding& encoding,
+    const Data_Namespace::MemoryLevel memory_level,
+    const int device_id,
+    DeviceAllocator* allocator) const {
+  const auto fragments_it =
+      all_tables_fragments.find({col_info->db_id, col_info->table_id});
+  CHECK(fragments_it != all_tables_fragments.end());
+  const auto& fragment = (*fragments_it->second)[frag_id];
+  if (fragment.isEmptyPhysicalFragment()) {
+    return nullptr;
+  }
+  auto chunk_meta_it = fragment.getChunkMetadataMap().find(col_info->column_id);
+  CHECK(chunk_meta_it != fragment.getChunkMetadataMap().end());
+  const auto elem_count = chunk_meta_it->second->numElements();
+  if (!elem_count) {
+    return nullptr;
+  }
+  ChunkKey chunk_key{col_info->db_id,
+                     fragment.physicalTableId,
+                     col_info->column_id,
+                     fragment.fragmentId};
+  const auto key = get_encoded_chunk_key(chunk_key, elem_count, encoding);
+  auto data_mgr = executor_->getDataMgr();
+  auto buf = data_mgr->getCachedChunkBuffer(key, memory_level, device_id);
+  if (!buf) {
+    // Device buffers are copied from the encoded fragment in the CPU pool, so it is
+    // encoded once for all devices.
+    const bool on_gpu = memory_level == Data_Namespace::GPU_LEVEL;
+    auto src = on_gpu ? getOneTableEncodedColumnFragment(col_info,
+                                                         frag_id,
+                                                         all_tables_fragments,
+                                                         chunk_holder,
+                                                         chunk_iter_holder,
+                                                         encoding,
+                                                         Data_Namespace::CPU_LEVEL,
+                                                         0,
+                                                         allocator)
+                      : getOneTableColumnFragment(col_info,
+                                                  frag_id,
+                                                  all_tables_fragments,
+                                                  chunk_holder,
+                                                  chunk_iter_holder,
+                                                  Data_Namespace::CPU_LEVEL,
+                                                  0,
+                                                  allocator);
+    CHECK(src);
+    const auto num_bytes = elem_count * encoding.byte_width;
+    buf = data_mgr->alloc(memory_level, device_id, num_bytes);
+    if (on_gpu) {
+      CHECK(allocator);
+      allocator->copyToDevice(buf->getMemoryPtr(), src, num_bytes);
+    } else {
+      encode_frame_of_reference(
+          src, buf->getMemoryPtr(), elem_count, col_info->type, encoding);
+    }
+    if (!data_mgr->registerChunkBuffer(buf, key)) {
+      // Another kernel has encoded the same fragment meanwhile, use its buffer.
+      data_mgr->free(buf);
+      return getOneTableEncodedColumnFragment(col_info,
+                                              frag_id,
+                                              all_tables_fragments,
+                                              chunk_holder,
+                                              chunk_iter_holder,
+                                              encoding,
+                                              memory_level,
+                                              device_id,
+                                              allocator);
+    }
+  }
+  // The chunk unpins the buffer when the kernel releases its inputs, the buffer stays
+  // in the pool until evicted.
+  {
+    std::lock_guard<std::mutex> chunk_list_lock(chunk_list_mutex_);
+    chunk_holder.push_back(std::make_shared<Chunk_NS::Chunk>(buf, nullptr, col_info));
+  }
+  return buf->getMemoryPtr();
+}
+
 const int8_t* ColumnFetcher::getAllTableColumnFragments(
     ColumnInfoPtr col_info,
     const std::map<TableRef, const TableFragments*>& all_tables_fragments,
@@ -245,27 +330,27 @@ const int8_t* ColumnFetcher::getAllTableColumnFragments(
   CHECK(fragments_it != all_tables_fragments.end());
   const auto fragments = fragments_it->second;
   const auto frag_count = fragments->size();
-  std::vector<std::unique_ptr<ColumnarResults>> column_frags;
   const ColumnarResults* table_column = nullptr;
-  const InputDescriptor table_desc(db_id, table_id, int(0));
   {
     std::lock_guard<std::mutex> columnar_conversion_guard(columnar_fetch_mutex_);
     auto column_it = columnarized_scan_table_cache_.find({table_id, col_id});
     if (column_it == columnarized_scan_table_cache_.end()) {
+      // Fetched chunks are kept with the merged column, which refers to their data
+      // when fragments are adjacent in memory.
+      std::list<std::shared_ptr<Chunk_NS::Chunk>> chunk_holder;
+      std::list<ChunkIter> chunk_iter_holder;
+      std::vector<std::pair<const int8_t*, size_t>> column_frags;
+      column_frags.reserve(frag_count);
       for (size_t frag_id = 0; frag_id < frag_count; ++frag_id) {
         if (executor_->getConfig()
                 .exec.interrupt.enable_non_kernel_time_query_interrupt &&
             executor_->checkNonKernelTimeInterrupted()) {
           throw QueryExecutionError(Executor::ERR_INTERRUPTED);
         }
-        std::list<std::shared_ptr<Chunk_NS::Chunk>> chunk_holder;
-        std::list<ChunkIter> chunk_iter_holder;
         const auto& fragment = (*fragments)[frag_id];
         if (fragment.isEmptyPhysicalFragment()) {
           continue;
         }
-        auto chunk_meta_it = fragment.getChunkMetadataMap().find(col_id);
-        CHECK(chunk_meta_it != fragment.getChunkMetadataMap().end());
         auto col_buffer = getOneTableColumnFragment(col_info,
                                                     static_cast<int>(frag_id),
                                                     all_tables_fragments,
@@ -274,16 +359,12 @@ const int8_t* ColumnFetcher::getAllTableColumnFragments(
                                                     Data_Namespace::CPU_LEVEL,
                                                     int(0),
                                                     device_allocator);
-        column_frags.push_back(
-            std::make_unique<ColumnarResults>(executor_->row_set_mem_owner_,
-                                              col_buffer,
-                                              fragment.getNumTuples(),
-                                              chunk_meta_it->second->type(),
-                                              thread_idx));
+        column_frags.emplace_back(col_buffer, fragment.getNumTuples());
       }
-      auto merged_results =
-          ColumnarResults::mergeResults(executor_->row_set_mem_owner_, column_frags);
+      auto merged_results = ColumnarResults::mergeColumnFragments(
+          executor_->row_set_mem_owner_, column_frags, col_info->type, thread_idx);
       table_column = merged_results.get();
+      scan_table_chunks_.splice(scan_table_chunks_.end(), chunk_holder);
       columnarized_scan_table_cache_.emplace(std::make_pair(table_id, col_id),
                                              std::move(merged_results));
     } else {
@@ -526,6 +607,10 @@ MergedChunk ColumnFetcher::linearizeVarLenArrayColFrags(
   bool has_cached_merged_idx_buf = false;
   bool has_cached_merged_data_buf = false;
   CHECK(!col_info->is_rowid);
+  const auto data_key = getLinearizedChunkKey(
+      col_info, local_chunk_holder.size(), total_num_tuples, /*index_buf=*/false);
+  const auto idx_key = getLinearizedChunkKey(
+      col_info, local_chunk_holder.size(), total_num_tuples, /*index_buf=*/true);
   // check linearized buffer's cache first
   // if not exists, alloc necessary buffer space to prepare linearization
   int64_t linearization_time_ms = 0;
@@ -544,22 +629,20 @@ MergedChunk ColumnFetcher::linearizeVarLenArrayColFrags(
                 << getMemoryLevelString(memory_level) << ", device_id: " << device_id
                 << ")";
       } else {
-        merged_data_buffer =
-            executor_->getDataMgr()->alloc(memory_level, device_id, total_data_buf_size);
-        VLOG(2) << "Allocate " << total_data_buf_size
-                << " bytes of data buffer space for linearized chunks (memory_level: "
-                << getMemoryLevelString(memory_level) << ", device_id: " << device_id
-                << ")";
+        merged_data_buffer = allocLinearizedBuf(data_key,
+                                                memory_level,
+                                                device_id,
+                                                total_data_buf_size,
+                                                has_cached_merged_data_buf);
         cd_cache.insert(std::make_pair(device_id, merged_data_buffer));
       }
     } else {
       DeviceMergedChunkMap m;
-      merged_data_buffer =
-          executor_->getDataMgr()->alloc(memory_level, device_id, total_data_buf_size);
-      VLOG(2) << "Allocate " << total_data_buf_size
-              << " bytes of data buffer space for linearized chunks (memory_level: "
-              << getMemoryLevelString(memory_level) << ", device_id: " << device_id
-              << ")";
+      merged_data_buffer = allocLinearizedBuf(data_key,
+                                              memory_level,
+                                              device_id,
+                                              total_data_buf_size,
+                                              has_cached_merged_data_buf);
       m.insert(std::make_pair(device_id, merged_data_buffer));
       linearized_data_buf_cache_.insert(
           std::make_pair(std::make_pair(col_info->table_id, col_info->column_id), m));
@@ -575,10 +658,11 @@ MergedChunk ColumnFetcher::linearizeVarLenArrayColFrags(
           << getMemoryLevelString(memory_level) << ", device_id: " << device_id << ")";
     } else {
       auto idx_buf_size = total_idx_buf_size + sizeof(ArrayOffsetT);
-      merged_index_buffer_in_cpu =
-          executor_->getDataMgr()->alloc(Data_Namespace::CPU_LEVEL, 0, idx_buf_size);
-      VLOG(2) << "Allocate " << idx_buf_size
-              << " bytes of temporary idx buffer space on CPU for linearized chunks";
+      merged_index_buffer_in_cpu = allocLinearizedBuf(idx_key,
+                                                      Data_Namespace::CPU_LEVEL,
+                                                      0,
+                                                      idx_buf_size,
+                                                      has_cached_merged_idx_buf);
       // just copy the buf addr since we access it via the pointer itself
       linearlized_temporary_cpu_index_buf_cache_.insert(
           std::make_pair(col_info->column_id, merged_index_buffer_in_cpu));
@@ -769,6 +853,16 @@ MergedChunk ColumnFetcher::linearizeVarLenArrayColFrags(
     }
   }
 
+  {
+    std::lock_guard<std::mutex> linearized_col_cache_guard(linearized_col_cache_mutex_);
+    if (!has_cached_merged_data_buf) {
+      registerLinearizedBuf(merged_data_buffer, data_key);
+    }
+    if (!has_cached_merged_idx_buf) {
+      registerLinearizedBuf(merged_index_buffer_in_cpu, idx_key);
+    }
+  }
+
   // put linearized index buffer to per-device cache
   AbstractBuffer* merged_index_buffer = nullptr;
   size_t buf_size = total_idx_buf_size + sizeof(ArrayOffsetT);
@@ -782,6 +876,18 @@ MergedChunk ColumnFetcher::linearizeVarLenArrayColFrags(
           device_allocator->copyToDevice(dest, src, buf_size);
         }
       };
+  auto allocDeviceLinearizedIdxBuf = [&]() {
+    bool is_cached = false;
+    auto buf = allocLinearizedBuf(idx_key, memory_level, device_id, buf_size, is_cached);
+    if (!is_cached) {
+      copyBuf(merged_index_buffer_in_cpu->getMemoryPtr(),
+              buf->getMemoryPtr(),
+              buf_size,
+              memory_level);
+      registerLinearizedBuf(buf, idx_key);
+    }
+    return buf;
+  };
   {
     std::lock_guard<std::mutex> linearized_col_cache_guard(linearized_col_cache_mutex_);
     auto merged_idx_buf_cache_it =
@@ -795,21 +901,11 @@ MergedChunk ColumnFetcher::linearizeVarLenArrayColFrags(
         if (merged_idx_buf_it != merged_idx_buf_cache.end()) {
           merged_index_buffer = merged_idx_buf_it->second;
         } else {
-          merged_index_buffer =
-              executor_->getDataMgr()->alloc(memory_level, device_id, buf_size);
-          copyBuf(merged_index_buffer_in_cpu->getMemoryPtr(),
-                  merged_index_buffer->getMemoryPtr(),
-                  buf_size,
-                  memory_level);
+          merged_index_buffer = allocDeviceLinearizedIdxBuf();
           merged_idx_buf_cache.insert(std::make_pair(device_id, merged_index_buffer));
         }
       } else {
-        merged_index_buffer =
-            executor_->getDataMgr()->alloc(memory_level, device_id, buf_size);
-        copyBuf(merged_index_buffer_in_cpu->getMemoryPtr(),
-                merged_index_buffer->getMemoryPtr(),
-                buf_size,
-                memory_level);
+        merged_index_buffer = allocDeviceLinearizedIdxBuf();
         DeviceMergedChunkMap m;
         m.insert(std::make_pair(device_id, merged_index_buffer));
         linearized_idx_buf_cache_.insert(
@@ -847,6 +943,8 @@ MergedChunk ColumnFetcher::linearizeFixedLenArrayColFrags(
   AbstractBuffer* merged_data_buffer = nullptr;
   bool has_cached_merged_data_buf = false;
   CHECK(!col_info->is_rowid);
+  const auto data_key = getLinearizedChunkKey(
+      col_info, local_chunk_holder.size(), total_num_tuples, /*index_buf=*/false);
   {
     std::lock_guard<std::mutex> linearized_col_cache_guard(linearized_col_cache_mutex_);
     auto cached_data_buf_cache_it =
@@ -861,22 +959,20 @@ MergedChunk ColumnFetcher::linearizeFixedLenArrayColFrags(
                 << getMemoryLevelString(memory_level) << ", device_id: " << device_id
                 << ")";
       } else {
-        merged_data_buffer =
-            executor_->getDataMgr()->alloc(memory_level, device_id, total_data_buf_size);
-        VLOG(2) << "Allocate " << total_data_buf_size
-                << " bytes of data buffer space for linearized chunks (memory_level: "
-                << getMemoryLevelString(memory_level) << ", device_id: " << device_id
-                << ")";
+        merged_data_buffer = allocLinearizedBuf(data_key,
+                                                memory_level,
+                                                device_id,
+                                                total_data_buf_size,
+                                                has_cached_merged_data_buf);
         cd_cache.insert(std::make_pair(device_id, merged_data_buffer));
       }
     } else {
       DeviceMergedChunkMap m;
-      merged_data_buffer =
-          executor_->getDataMgr()->alloc(memory_level, device_id, total_data_buf_size);
-      VLOG(2) << "Allocate " << total_data_buf_size
-              << " bytes of data buffer space for linearized chunks (memory_level: "
-              << getMemoryLevelString(memory_level) << ", device_id: " << device_id
-              << ")";
+      merged_data_buffer = allocLinearizedBuf(data_key,
+                                              memory_level,
+                                              device_id,
+                                              total_data_buf_size,
+                                              has_cached_merged_data_buf);
       m.insert(std::make_pair(device_id, merged_data_buffer));
       linearized_data_buf_cache_.insert(
           std::make_pair(std::make_pair(col_info->table_id, col_info->column_id), m));
@@ -902,6 +998,8 @@ MergedChunk ColumnFetcher::linearizeFixedLenArrayColFrags(
     }
     // check whether each chunk's data buffer is clean under chunk merging
     CHECK_EQ(total_data_buf_size, sum_data_buf_size);
+    std::lock_guard<std::mutex> linearized_col_cache_guard(linearized_col_cache_mutex_);
+    registerLinearizedBuf(merged_data_buffer, data_key);
   }
   linearization_time_ms += timer_stop(clock_begin);
   VLOG(2) << "Linearization has been successfully done, elapsed time: "
@@ -1001,12 +1099,11 @@ ChunkIter ColumnFetcher::prepareChunkIter(AbstractBuffer* merged_data_buf,
 
 void ColumnFetcher::freeLinearizedBuf() {
   std::lock_guard<std::mutex> linearized_col_cache_guard(linearized_col_cache_mutex_);
-  auto buffer_provider = executor_->getBufferProvider();
 
   if (!linearized_data_buf_cache_.empty()) {
     for (auto& kv : linearized_data_buf_cache_) {
       for (auto& kv2 : kv.second) {
-        buffer_provider->free(kv2.second);
+        releaseLinearizedBuf(kv2.second);
       }
     }
   }
@@ -1014,7 +1111,7 @@ void ColumnFetcher::freeLinearizedBuf() {
   if (!linearized_idx_buf_cache_.empty()) {
     for (auto& kv : linearized_idx_buf_cache_) {
       for (auto& kv2 : kv.second) {
-        buffer_provider->free(kv2.second);
+        releaseLinearizedBuf(kv2.second);
       }
     }
   }
@@ -1022,10 +1119,69 @@ void ColumnFetcher::freeLinearizedBuf() {
 
 void ColumnFetcher::freeTemporaryCpuLinearizedIdxBuf() {
   std::lock_guard<std::mutex> linearized_col_cache_guard(linearized_col_cache_mutex_);
-  auto buffer_provider = executor_->getBufferProvider();
   if (!linearlized_temporary_cpu_index_buf_cache_.empty()) {
     for (auto& kv : linearlized_temporary_cpu_index_buf_cache_) {
-      buffer_provider->free(kv.second);
+      releaseLinearizedBuf(kv.second);
     }
   }
 }
+
+ChunkKey ColumnFetcher::getLinearizedChunkKey(ColumnInfoPtr col_info,
+                                              const size_t num_chunks,
+                                              const size_t num_tuples,
+                                              const bool index_buf) const {
+  // Results of previous steps are temporary tables and may reuse table ids.
+  if (!executor_->getConfig().exec.enable_linearized_column_cache ||
+      col_info->db_id == hdk::ResultSetRegistry::DB_ID) {
+    return {};
+  }
+  // Tables are append-only, so the number of chunks and rows identify the merged data.
+  // Keys share the table prefix with regular chunks and use a fragment id never
+  // assigned to a fragment.
+  return {col_info->db_id,
+          col_info->table_id,
+          col_info->column_id,
+          -1,
+          static_cast<int>(num_chunks),
+          static_cast<int>(num_tuples >> 32),
+          static_cast<int>(num_tuples & 0xFFFFFFFF),
+          index_buf ? 2 : 1};
+}
+
+AbstractBuffer* ColumnFetcher::allocLinearizedBuf(const ChunkKey& key,
+                                                  const MemoryLevel memory_level,
+                                                  const int device_id,
+                                                  const size_t num_bytes,
+                                                  bool& is_cached) const {
+  auto data_mgr = executor_->getDataMgr();
+  if (!key.empty()) {
+    if (auto buf = data_mgr->getCachedChunkBuffer(key, memory_level, device_id)) {
+      VLOG(2) << "Reuse cached buffer for linearized chunks (memory_level: "
+              << getMemoryLevelString(memory_level) << ", device_id: " << device_id
+              << ")";
+      pooled_linearized_bufs_.insert(buf);
+      is_cached = true;
+      return buf;
+    }
+  }
+  VLOG(2) << "Allocate " << num_bytes
+          << " bytes of buffer space for linearized chunks (memory_level: "
+          << getMemoryLevelString(memory_level) << ", device_id: " << device_id << ")";
+  is_cached = false;
+  return data_mgr->alloc(memory_level, device_id, num_bytes);
+}
+
+void ColumnFetcher::registerLinearizedBuf(AbstractBuffer* buf,
+                                          const ChunkKey& key) const {
+  if (!key.empty() && executor_->getDataMgr()->registerChunkBuffer(buf, key)) {
+    pooled_linearized_bufs_.insert(buf);
+  }
+}
+
+void ColumnFetcher::releaseLinearizedBuf(AbstractBuffer* buf) const {
+  if (pooled_linearized_bufs_.erase(buf)) {
+    buf->unPin();
+  } else {
+    executor_->getBufferProvider()->free(buf);
+  }
+}
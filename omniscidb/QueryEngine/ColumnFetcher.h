@@ -20,10 +20,13 @@
 #include "DataProvider/DataProvider.h"
 #include "IR/Expr.h"
 #include "QueryEngine/Descriptors/QueryFragmentDescriptor.h"
+#include "QueryEngine/FrameOfReferenceEncoding.h"
 #include "QueryEngine/JoinHashTable/Runtime/HashJoinRuntime.h"
 #include "ResultSetRegistry/ColumnarResults.h"
 #include "Shared/hash.h"
 
+#include <unordered_set>
+
 struct FetchResult {
   std::vector<std::vector<const int8_t*>> col_buffers;
   std::vector<std::vector<int64_t>> num_rows;
@@ -75,6 +78,20 @@ class ColumnFetcher {
       const int device_id,
       DeviceAllocator* device_allocator) const;
 
+  //! Fetch a chunk in a compressed form. Encoded fragments are kept in the buffer pool
+  //! of the memory level under a key including the encoding, so following queries
+  //! with the same column range reuse them.
+  const int8_t* getOneTableEncodedColumnFragment(
+      ColumnInfoPtr col_info,
+      const int frag_id,
+      const std::map<TableRef, const TableFragments*>& all_tables_fragments,
+      std::list<std::shared_ptr<Chunk_NS::Chunk>>& chunk_holder,
+      std::list<ChunkIter>& chunk_iter_holder,
+      const FrameOfReferenceEncoding& encoding,
+      const Data_Namespace::MemoryLevel memory_level,
+      const int device_id,
+      DeviceAllocator* device_allocator) const;
+
   const int8_t* getAllTableColumnFragments(
       ColumnInfoPtr col_info,
       const std::map<TableRef, const TableFragments*>& all_tables_fragments,
@@ -151,6 +168,23 @@ class ColumnFetcher {
                              bool is_true_varlen_type,
                              const size_t total_num_tuples) const;
 
+  // Linearized buffers stay in the buffer pool under a synthetic chunk key after the
+  // query, so following queries reuse them. Returns an empty key if they are not kept.
+  ChunkKey getLinearizedChunkKey(ColumnInfoPtr col_info,
+                                 const size_t num_chunks,
+                                 const size_t num_tuples,
+                                 const bool index_buf) const;
+
+  // Returns the cached buffer of the key if present, allocates a new one otherwise.
+  AbstractBuffer* allocLinearizedBuf(const ChunkKey& key,
+                                     const MemoryLevel memory_level,
+                                     const int device_id,
+                                     const size_t num_bytes,
+                                     bool& is_cached) const;
+  void registerLinearizedBuf(AbstractBuffer* buf, const ChunkKey& key) const;
+  // Unpins buffers owned by the pool and frees the rest.
+  void releaseLinearizedBuf(AbstractBuffer* buf) const;
+
   Executor* executor_;
   DataProvider* data_provider_;
   mutable std::mutex columnar_fetch_mutex_;
@@ -162,6 +196,8 @@ class ColumnFetcher {
   // All caches map [table_id, col_id] to cached data
   mutable std::unordered_map<std::pair<int, int>, std::unique_ptr<const ColumnarResults>>
       columnarized_scan_table_cache_;
+  // Chunks backing columns of columnarized_scan_table_cache_.
+  mutable std::list<std::shared_ptr<Chunk_NS::Chunk>> scan_table_chunks_;
   using DeviceMergedChunkIterMap = std::unordered_map<int, int8_t*>;
   using DeviceMergedChunkMap = std::unordered_map<int, AbstractBuffer*>;
   mutable std::unordered_map<std::pair<int, int>, DeviceMergedChunkIterMap>
@@ -172,6 +208,8 @@ class ColumnFetcher {
       linearized_data_buf_cache_;
   mutable std::unordered_map<std::pair<int, int>, DeviceMergedChunkMap>
       linearized_idx_buf_cache_;
+  // Linearized buffers registered in or taken from the buffer pool.
+  mutable std::unordered_set<AbstractBuffer*> pooled_linearized_bufs_;
 
   friend class QueryCompilationDescriptor;
 };
@@ -53,6 +53,23 @@ std::shared_ptr<Decoder> get_col_decoder(const hdk::ir::ColumnVar* col_var) {
   }
 }
 
+// Return the decoder for a column transferred to GPU in a compressed form.
+std::shared_ptr<Decoder> get_col_decoder(const hdk::ir::ColumnVar* col_var,
+                                         const ColumnEncodings& column_encodings) {
+  if (!column_encodings.empty()) {
+    auto nest_level = col_var->rteIdx() == -1 ? 0 : col_var->rteIdx();
+    auto it =
+        column_encodings.find(InputColDescriptor(col_var->columnInfo(), nest_level));
+    if (it != column_encodings.end()) {
+      return std::make_shared<FrameOfReferenceInt>(
+          it->second.byte_width,
+          it->second.baseline,
+          inline_int_null_value(col_var->type()));
+    }
+  }
+  return get_col_decoder(col_var);
+}
+
 size_t get_col_bit_width(const hdk::ir::ColumnVar* col_var) {
   return get_bit_width(col_var->type());
 }
@@ -172,7 +189,7 @@ llvm::Value* CodeGenerator::codegenFixedLengthColVar(const hdk::ir::ColumnVar* c
                                                      llvm::Value* col_byte_stream,
                                                      llvm::Value* pos_arg) {
   AUTOMATIC_IR_METADATA(cgen_state_);
-  const auto decoder = get_col_decoder(col_var);
+  const auto decoder = get_col_decoder(col_var, plan_state_->column_encodings_);
   auto dec_val = decoder->codegenDecode(col_byte_stream, pos_arg, cgen_state_->module_);
   cgen_state_->ir_builder_.Insert(dec_val);
   auto dec_type = dec_val->getType();
@@ -460,8 +477,16 @@ const hdk::ir::Expr* remove_cast_to_int(const hdk::ir::Expr* expr) {
 }
 
 hdk::ir::ExprPtr CodeGenerator::hashJoinLhs(const hdk::ir::ColumnVar* rhs) const {
-  for (const auto& tautological_eq : plan_state_->join_info_.equi_join_tautologies_) {
-    CHECK(tautological_eq->isEquivalence());
+  const auto& join_info = plan_state_->join_info_;
+  CHECK_EQ(join_info.equi_join_tautologies_.size(), join_info.join_hash_tables_.size());
+  for (size_t i = 0; i < join_info.equi_join_tautologies_.size(); ++i) {
+    const auto& tautological_eq = join_info.equi_join_tautologies_[i];
+    // Range join conditions and matches of key hashes don't make inner and outer
+    // values equal.
+    if (!tautological_eq->isEquivalence() ||
+        join_info.join_hash_tables_[i]->matchesKeyHashes()) {
+      continue;
+    }
     if (dynamic_cast<const hdk::ir::ExpressionTuple*>(tautological_eq->leftOperand())) {
       auto lhs_col = hashJoinLhsTuple(rhs, tautological_eq.get());
       if (lhs_col) {
@@ -16,13 +16,30 @@
 
 #pragma once
 
+#include "QueryEngine/CompilationOptions.h"
 #include "QueryEngine/ExecutionEngineWrapper.h"
+#include "QueryEngine/GpuLaunchTuner.h"
 
+#include <atomic>
 #include <memory>
 
 class CompilationContext {
  public:
   virtual ~CompilationContext() {}
+
+  GpuLaunchTuner& gpuLaunchTuner() { return gpu_launch_tuner_; }
+
+  // Size of the device code and time spent to generate it. Used by the GPU code
+  // cache to choose entries to evict.
+  size_t codeSize() const { return code_size_; }
+  void setCodeSize(size_t code_size) { code_size_ = code_size; }
+  int64_t compilationTimeMs() const { return compilation_time_ms_; }
+  void setCompilationTimeMs(int64_t time_ms) { compilation_time_ms_ = time_ms; }
+
+ private:
+  GpuLaunchTuner gpu_launch_tuner_;
+  size_t code_size_{0};
+  int64_t compilation_time_ms_{0};
 };
 
 class CpuCompilationContext : public CompilationContext {
@@ -41,7 +58,19 @@ class CpuCompilationContext : public CompilationContext {
 
   void* func() const { return func_; }
 
+  void setOptLevel(ExecutorOptLevel opt_level) { opt_level_ = opt_level; }
+  ExecutorOptLevel optLevel() const { return opt_level_; }
+
+  // Register a code cache hit and return the total number of hits.
+  size_t registerUse() { return ++use_count_; }
+
+  // Return true for the first caller only, used to recompile hot code once.
+  bool markRecompilation() { return !recompilation_marked_.exchange(true); }
+
  private:
   void* func_{nullptr};
+  ExecutorOptLevel opt_level_{ExecutorOptLevel::Default};
+  std::atomic<size_t> use_count_{0};
+  std::atomic<bool> recompilation_marked_{false};
   std::unique_ptr<ExecutionEngineWrapper> execution_engine_;
 };
@@ -34,7 +34,8 @@ std::ostream& operator<<(std::ostream& os, const ExecutionOptions& eo) {
      << "running_query_interrupt_freq=" << eo.running_query_interrupt_freq << "\n"
      << "pending_query_interrupt_freq=" << eo.pending_query_interrupt_freq << "\n"
      << "multifrag_result=" << eo.multifrag_result << "\n"
-     << "preserve_order=" << eo.preserve_order << "\n";
+     << "preserve_order=" << eo.preserve_order << "\n"
+     << "intermediate_result=" << eo.intermediate_result << "\n";
   return os;
 }
 #endif
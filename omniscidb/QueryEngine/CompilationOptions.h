@@ -29,7 +29,9 @@
 #include "Shared/Config.h"
 #include "Shared/DeviceType.h"
 
-enum class ExecutorOptLevel { Default, ReductionJIT };
+// Fast is used for the first compilation of a query template when tiered compilation
+// is enabled. It runs a minimal IR pipeline and disables backend optimizations.
+enum class ExecutorOptLevel { Default, ReductionJIT, Fast };
 
 enum class ExecutorExplainType { Default, Optimized };
 
@@ -47,6 +49,8 @@ struct CompilationOptions {
   bool register_intel_jit_listener{false};
   bool use_groupby_buffer_desc{false};
   compiler::CodegenTraitsDescriptor codegen_traits_desc{};
+  // Run loop vectorization passes over CPU code compiled with full optimizations.
+  bool vectorize_loops{false};
 
   static CompilationOptions makeCpuOnly(const CompilationOptions& in) {
     return CompilationOptions{ExecutorDeviceType::CPU,
@@ -58,7 +62,8 @@ struct CompilationOptions {
                               in.explain_type,
                               in.register_intel_jit_listener,
                               in.use_groupby_buffer_desc,
-                              compiler::cpu_cgen_traits_desc};
+                              compiler::cpu_cgen_traits_desc,
+                              in.vectorize_loops};
   }
 
   static compiler::CodegenTraitsDescriptor getCgenTraitsDesc(
@@ -112,6 +117,18 @@ struct ExecutionOptions {
   std::vector<size_t> outer_fragment_indices{};
   bool multifrag_result = false;
   bool preserve_order = false;
+  // The result is consumed by the following query steps only.
+  bool intermediate_result = false;
+  // Queries with higher priority are admitted for execution first.
+  int query_priority = 0;
+  // Max number of CPU threads used by the query, zero means no limit.
+  unsigned cpu_threads_budget = 0;
+  // Collect the execution profile returned with the query result.
+  bool with_profile = false;
+  // Fraction of the outer table fragments processed by the query. SUM and COUNT
+  // aggregates of a sampled query are scaled to estimate the whole table.
+  double sample_rate = 1.0;
+  uint64_t sample_seed = 0;
 
   static ExecutionOptions fromConfig(const Config& config) {
     auto eo = ExecutionOptions();
@@ -132,8 +149,10 @@ struct ExecutionOptions {
     eo.running_query_interrupt_freq = config.exec.interrupt.running_query_interrupt_freq;
     eo.pending_query_interrupt_freq = 0;
 
-    eo.multifrag_result = config.exec.enable_multifrag_rs;
+    eo.multifrag_result = false;
     eo.preserve_order = false;
+    eo.cpu_threads_budget = config.exec.cpu_threads_per_query;
+    eo.with_profile = config.exec.enable_query_profile;
 
     return eo;
   }
@@ -156,6 +175,12 @@ struct ExecutionOptions {
     return eo;
   }
 
+  ExecutionOptions with_just_explain(bool enable = true) const {
+    ExecutionOptions eo = *this;
+    eo.just_explain = enable;
+    return eo;
+  }
+
  private:
   ExecutionOptions() {}
 };
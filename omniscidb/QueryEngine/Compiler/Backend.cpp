@@ -20,7 +20,9 @@
 #include "QueryEngine/ExecutionEngineWrapper.h"
 #include "QueryEngine/ExtensionFunctionsWhitelist.h"
 #include "QueryEngine/NvidiaKernel.h"
+#include "QueryEngine/PersistentCodeCache.h"
 
+#include <llvm/Analysis/TargetTransformInfo.h>
 #include <llvm/IR/DebugInfo.h>
 #include <llvm/IR/InstIterator.h>
 #include <llvm/IR/IntrinsicInst.h>
@@ -28,6 +30,7 @@
 #include <llvm/IR/Verifier.h>
 #include <llvm/IRReader/IRReader.h>
 #include <llvm/Support/TargetSelect.h>
+#include <llvm/Target/TargetMachine.h>
 #include <llvm/Transforms/IPO/PassManagerBuilder.h>
 #include <llvm/Transforms/Utils/BasicBlockUtils.h>
 #include <llvm/Transforms/Utils/Cloning.h>
@@ -43,6 +46,9 @@
 #else
 #include <llvm/Support/TargetRegistry.h>
 #endif
+
+#include <future>
+
 namespace compiler {
 
 static llvm::sys::Mutex g_ee_create_mutex;
@@ -87,28 +93,53 @@ std::shared_ptr<CompilationContext> CPUBackend::generateNativeCode(
     const std::unordered_set<llvm::Function*>& live_funcs,
     const CompilationOptions& co) {
   return std::dynamic_pointer_cast<CpuCompilationContext>(
-      CPUBackend::generateNativeCPUCode(func, live_funcs, co));
+      CPUBackend::generateNativeCPUCode(func, live_funcs, co, persistent_code_cache_));
 }
 
 std::shared_ptr<CpuCompilationContext> CPUBackend::generateNativeCPUCode(
     llvm::Function* func,
     const std::unordered_set<llvm::Function*>& live_funcs,
-    const CompilationOptions& co) {
+    const CompilationOptions& co,
+    PersistentCodeCache* persistent_code_cache) {
   auto timer = DEBUG_TIMER(__func__);
   llvm::Module* llvm_module = func->getParent();
-  // run optimizations
-#ifndef WITH_JIT_DEBUG
-  llvm::legacy::PassManager pass_manager;
-  compiler::optimize_ir(
-      func, llvm_module, pass_manager, live_funcs, /*is_gpu_smem_used=*/false, co);
-#endif  // WITH_JIT_DEBUG
-
+  // Object code found in the persistent cache replaces the whole module, so there
+  // is no need to optimize IR which is not going to be compiled.
+  const bool use_cached_object =
+      persistent_code_cache && persistent_code_cache->hasObject(llvm_module);
   auto init_err = llvm::InitializeNativeTarget();
   CHECK(!init_err);
 
   llvm::InitializeNativeTargetAsmPrinter();
   llvm::InitializeNativeTargetAsmParser();
 
+  // run optimizations
+#ifndef WITH_JIT_DEBUG
+  if (!use_cached_object) {
+    llvm::legacy::PassManager pass_manager;
+    // The loop vectorizer picks vector widths by the host target info. Without it
+    // the cost model sees no vector registers and keeps loops scalar.
+    std::unique_ptr<llvm::TargetMachine> host_target_machine;
+    if (co.vectorize_loops) {
+      auto host_tm_builder = llvm::orc::JITTargetMachineBuilder::detectHost();
+      if (host_tm_builder) {
+        auto host_tm = host_tm_builder->createTargetMachine();
+        if (host_tm) {
+          host_target_machine = std::move(*host_tm);
+          pass_manager.add(llvm::createTargetTransformInfoWrapperPass(
+              host_target_machine->getTargetIRAnalysis()));
+        } else {
+          llvm::consumeError(host_tm.takeError());
+        }
+      } else {
+        llvm::consumeError(host_tm_builder.takeError());
+      }
+    }
+    compiler::optimize_ir(
+        func, llvm_module, pass_manager, live_funcs, /*is_gpu_smem_used=*/false, co);
+  }
+#endif  // WITH_JIT_DEBUG
+
   std::string err_str;
   std::unique_ptr<llvm::Module> owner(llvm_module);
 
@@ -139,7 +170,8 @@ std::shared_ptr<CpuCompilationContext> CPUBackend::generateNativeCPUCode(
       std::move(*target_machine_builder_or_error);
   target_machine_builder.getOptions().EnableFastISel = true;
 
-  if (co.opt_level == ExecutorOptLevel::ReductionJIT) {
+  if (co.opt_level == ExecutorOptLevel::ReductionJIT ||
+      co.opt_level == ExecutorOptLevel::Fast) {
     target_machine_builder.setCodeGenOptLevel(llvm::CodeGenOpt::None);
   }
 
@@ -154,7 +186,9 @@ std::shared_ptr<CpuCompilationContext> CPUBackend::generateNativeCPUCode(
   auto execution_engine =
       std::make_unique<ExecutionEngineWrapper>(std::move(execution_session),
                                                std::move(target_machine_builder),
-                                               std::move(data_layout));
+                                               std::move(data_layout),
+                                               persistent_code_cache,
+                                               co.register_intel_jit_listener);
   execution_engine->addModule(std::move(owner));
   return std::make_shared<CpuCompilationContext>(std::move(execution_engine));
 }
@@ -407,6 +441,7 @@ declare void @llvm.lifetime.start.p0i8(i64, i8* nocapture) nounwind
 declare void @llvm.lifetime.end.p0i8(i64, i8* nocapture) nounwind
 declare i64 @get_thread_index();
 declare i64 @get_block_index();
+declare i64 @get_block_dim();
 declare i32 @pos_start_impl(i32*);
 declare i32 @group_buff_idx_impl();
 declare i32 @pos_step_impl();
@@ -421,6 +456,14 @@ declare i64* @get_group_value(i64*, i32, i64*, i32, i32, i32);
 declare i64* @get_group_value_with_watchdog(i64*, i32, i64*, i32, i32, i32);
 declare i32 @get_group_value_columnar_slot(i64*, i32, i64*, i32, i32);
 declare i32 @get_group_value_columnar_slot_with_watchdog(i64*, i32, i64*, i32, i32);
+declare i64* @get_group_value_key4(i64*, i32, i64*, i32, i32);
+declare i64* @get_group_value_key4_with_watchdog(i64*, i32, i64*, i32, i32);
+declare i64* @get_group_value_key8(i64*, i32, i64*, i32, i32);
+declare i64* @get_group_value_key8_with_watchdog(i64*, i32, i64*, i32, i32);
+declare i32 @get_group_value_columnar_slot_key4(i64*, i32, i64*, i32);
+declare i32 @get_group_value_columnar_slot_key4_with_watchdog(i64*, i32, i64*, i32);
+declare i32 @get_group_value_columnar_slot_key8(i64*, i32, i64*, i32);
+declare i32 @get_group_value_columnar_slot_key8_with_watchdog(i64*, i32, i64*, i32);
 declare i64* @get_group_value_fast(i64*, i64, i64, i64, i32);
 declare i64* @get_group_value_fast_with_original_key(i64*, i64, i64, i64, i64, i32);
 declare i32 @get_columnar_group_bin_offset(i64*, i64, i64, i64);
@@ -433,6 +476,8 @@ declare i64 @get_bucket_key_for_range_double(i8*, i64, double);
 declare i64 @agg_count_shared(i64*, i64);
 declare i64 @agg_count_skip_val_shared(i64*, i64, i64);
 declare i32 @agg_count_int32_shared(i32*, i32);
+declare void @agg_count_warp_shared(i64*, i64);
+declare void @agg_count_int32_warp_shared(i32*, i32);
 declare i32 @agg_count_int32_skip_val_shared(i32*, i32, i32);
 declare i64 @agg_count_double_shared(i64*, double);
 declare i64 @agg_count_double_skip_val_shared(i64*, double, double);
@@ -850,16 +895,34 @@ std::shared_ptr<CudaCompilationContext> CUDABackend::generateNativeGPUCode(
 
   auto func_name = wrapper_func->getName().str();
   auto gpu_compilation_context = std::make_shared<CudaCompilationContext>();
-  for (int device_id = 0; device_id < gpu_target.gpu_mgr->getDeviceCount(); ++device_id) {
+  const auto device_count = gpu_target.gpu_mgr->getDeviceCount();
+  if (device_count > 1) {
+    // Load modules to all devices concurrently. The cubin is already linked, so JIT
+    // options are not needed and their output slots are not shared between threads.
+    std::vector<std::future<std::unique_ptr<CudaDeviceCompilationContext>>> loads;
+    for (int device_id = 0; device_id < device_count; ++device_id) {
+      loads.push_back(std::async(std::launch::async, [&, device_id] {
+        return std::make_unique<CudaDeviceCompilationContext>(
+            cubin, func_name, device_id, cuda_mgr, 0, nullptr, nullptr);
+      }));
+    }
+    for (auto& load : loads) {
+      load.wait();
+    }
+    for (auto& load : loads) {
+      gpu_compilation_context->addDeviceCode(load.get());
+    }
+  } else {
     gpu_compilation_context->addDeviceCode(
         std::make_unique<CudaDeviceCompilationContext>(cubin,
                                                        func_name,
-                                                       device_id,
+                                                       0,
                                                        cuda_mgr,
                                                        num_options,
                                                        &option_keys[0],
                                                        &option_values[0]));
   }
+  gpu_compilation_context->setCodeSize(cubin_result.cubin_size);
 
   checkCudaErrors(cuLinkDestroy(link_state));
   return gpu_compilation_context;
@@ -873,7 +936,8 @@ std::shared_ptr<CompilationContext> L0Backend::generateNativeCode(
     llvm::Function* wrapper_func,
     const std::unordered_set<llvm::Function*>& live_funcs,
     const CompilationOptions& co) {
-  return generateNativeGPUCode(exts_, func, wrapper_func, live_funcs, co, gpu_target_);
+  return generateNativeGPUCode(
+      exts_, func, wrapper_func, live_funcs, co, gpu_target_, binary_cache_);
 }
 
 void insert_declaration(llvm::Module* from, llvm::Module* to, const std::string& fname) {
@@ -932,7 +996,8 @@ std::shared_ptr<L0CompilationContext> L0Backend::generateNativeGPUCode(
     llvm::Function* wrapper_func,
     const std::unordered_set<llvm::Function*>& live_funcs,
     const CompilationOptions& co,
-    const GPUTarget& gpu_target) {
+    const GPUTarget& gpu_target,
+    L0BinaryCache* binary_cache) {
 #ifdef HAVE_L0
   auto module = func->getParent();
 
@@ -1035,20 +1100,31 @@ std::shared_ptr<L0CompilationContext> L0Backend::generateNativeGPUCode(
 #endif
 
   const auto func_name = wrapper_func->getName().str();
-  L0BinResult bin_result;
+  std::vector<L0BinResult> bin_results;
   const auto l0_mgr = dynamic_cast<const l0::L0Manager*>(gpu_target.gpu_mgr);
   try {
-    bin_result = spv_to_bin(ss.str(), func_name, gpu_target.block_size, l0_mgr);
+    bin_results = spv_to_bin(
+        ss.str(), func_name, gpu_target.block_size, l0_mgr, binary_cache);
   } catch (l0::L0Exception& e) {
     LOG(WARNING) << "Failed to generate native GPU code: " << e.what()
                  << ". Switching to CPU execution target.";
     throw QueryMustRunOnCpu();
   }
 
+  // Kernels are launched by device id, so contexts are added in device order.
   auto compilation_ctx = std::make_shared<L0CompilationContext>();
-  auto device_compilation_ctx = std::make_unique<L0DeviceCompilationContext>(
-      bin_result.device, bin_result.kernel, bin_result.module, l0_mgr, 0, 1);
-  compilation_ctx->addDeviceCode(move(device_compilation_ctx));
+  for (size_t device_id = 0; device_id < bin_results.size(); ++device_id) {
+    auto& bin_result = bin_results[device_id];
+    auto device_compilation_ctx =
+        std::make_unique<L0DeviceCompilationContext>(bin_result.device,
+                                                     bin_result.kernel,
+                                                     bin_result.module,
+                                                     l0_mgr,
+                                                     static_cast<int>(device_id),
+                                                     1);
+    compilation_ctx->addDeviceCode(move(device_compilation_ctx));
+  }
+  compilation_ctx->setCodeSize(ss.str().size());
   return compilation_ctx;
 #else
   return {};
@@ -1059,18 +1135,20 @@ std::shared_ptr<Backend> getBackend(
     ExecutorDeviceType dt,
     const std::map<ExtModuleKinds, std::unique_ptr<llvm::Module>>& exts,
     bool is_gpu_smem_used_,
-    GPUTarget& gpu_target) {
+    GPUTarget& gpu_target,
+    PersistentCodeCache* persistent_code_cache,
+    L0BinaryCache* l0_binary_cache) {
   is_gpu_smem_used_ = false;
 
   switch (dt) {
     case ExecutorDeviceType::CPU:
-      return std::make_shared<CPUBackend>();
+      return std::make_shared<CPUBackend>(persistent_code_cache);
     case ExecutorDeviceType::GPU:
       if (gpu_target.gpu_mgr->getPlatform() == GpuMgrPlatform::CUDA)
         return std::make_shared<CUDABackend>(exts, is_gpu_smem_used_, gpu_target);
       if (gpu_target.gpu_mgr->getPlatform() == GpuMgrPlatform::L0) {
         CHECK(!is_gpu_smem_used_);
-        return std::make_shared<L0Backend>(exts, gpu_target);
+        return std::make_shared<L0Backend>(exts, gpu_target, l0_binary_cache);
       }
     default:
       CHECK(false);
@@ -29,6 +29,7 @@ enum class NvidiaDeviceArch;
 }
 
 class CudaCompilationContext;
+class PersistentCodeCache;
 
 namespace compiler {
 
@@ -122,7 +123,8 @@ class Backend {
 
 class CPUBackend : public Backend {
  public:
-  CPUBackend() = default;
+  CPUBackend(PersistentCodeCache* persistent_code_cache = nullptr)
+      : persistent_code_cache_(persistent_code_cache) {}
   std::shared_ptr<CompilationContext> generateNativeCode(
       llvm::Function* func,
       llvm::Function* wrapper_func /*ignored*/,
@@ -138,9 +140,11 @@ class CPUBackend : public Backend {
   static std::shared_ptr<CpuCompilationContext> generateNativeCPUCode(
       llvm::Function* func,
       const std::unordered_set<llvm::Function*>& live_funcs,
-      const CompilationOptions& co);
+      const CompilationOptions& co,
+      PersistentCodeCache* persistent_code_cache = nullptr);
 
  private:
+  PersistentCodeCache* persistent_code_cache_;
   inline const static CodegenTraitsDescriptor traitsDescriptor{cpu_cgen_traits_desc};
 };
 
@@ -195,8 +199,9 @@ class CUDABackend : public Backend {
 class L0Backend : public Backend {
  public:
   L0Backend(const std::map<ExtModuleKinds, std::unique_ptr<llvm::Module>>& exts,
-            GPUTarget& gpu_target)
-      : gpu_target_(gpu_target), exts_(exts) {}
+            GPUTarget& gpu_target,
+            L0BinaryCache* binary_cache = nullptr)
+      : gpu_target_(gpu_target), exts_(exts), binary_cache_(binary_cache) {}
 
   std::shared_ptr<CompilationContext> generateNativeCode(
       llvm::Function* func,
@@ -214,12 +219,14 @@ class L0Backend : public Backend {
       llvm::Function* wrapper_func,
       const std::unordered_set<llvm::Function*>& live_funcs,
       const CompilationOptions& co,
-      const GPUTarget& gpu_target);
+      const GPUTarget& gpu_target,
+      L0BinaryCache* binary_cache = nullptr);
 
  private:
   GPUTarget& gpu_target_;
   bool is_gpu_smem_used_;
   const std::map<ExtModuleKinds, std::unique_ptr<llvm::Module>>& exts_;
+  L0BinaryCache* binary_cache_;
   inline const static CodegenTraitsDescriptor traitsDescriptor{l0_cgen_traits_desc};
 };
 
@@ -227,7 +234,9 @@ std::shared_ptr<Backend> getBackend(
     ExecutorDeviceType dt,
     const std::map<ExtModuleKinds, std::unique_ptr<llvm::Module>>& exts,
     bool is_gpu_smem_used_,
-    GPUTarget& gpu_target);
+    GPUTarget& gpu_target,
+    PersistentCodeCache* persistent_code_cache = nullptr,
+    L0BinaryCache* l0_binary_cache = nullptr);
 
 void setSharedMemory(ExecutorDeviceType dt,
                      bool is_gpu_smem_used_,
@@ -21,6 +21,7 @@
 #include <llvm/Transforms/InstCombine/InstCombine.h>
 #include <llvm/Transforms/Scalar.h>
 #include <llvm/Transforms/Utils.h>
+#include <llvm/Transforms/Vectorize.h>
 
 #include "QueryEngine/Compiler/Exceptions.h"
 #include "QueryEngine/Optimization/AnnotateInternalFunctionsPass.h"
@@ -100,34 +101,53 @@ void optimize_ir(llvm::Function* query_func,
 
   pass_manager.add(new AnnotateInternalFunctionsPass());
 
-  pass_manager.add(llvm::createSROAPass());
-  // mem ssa drops unused load and store instructions, e.g. passing variables directly
-  // where possible
-  pass_manager.add(
-      llvm::createEarlyCSEPass(/*enable_mem_ssa=*/true));  // Catch trivial redundancies
-
-  if (!is_gpu_smem_used) {
-    // thread jumps can change the execution order around SMEM sections guarded by
-    // `__syncthreads()`, which results in race conditions. For now, disable jump
-    // threading for shared memory queries. In the future, consider handling shared memory
-    // aggregations with a separate kernel launch
-    pass_manager.add(llvm::createJumpThreadingPass());  // Thread jumps.
-  }
-  pass_manager.add(llvm::createCFGSimplificationPass());
-
-  // remove load/stores in PHIs if instructions can be accessed directly post thread jumps
-  pass_manager.add(llvm::createNewGVNPass());
-
-  pass_manager.add(llvm::createDeadStoreEliminationPass());
-  pass_manager.add(llvm::createLICMPass());
-
-  pass_manager.add(llvm::createInstructionCombiningPass());
-
-  // module passes
-  pass_manager.add(llvm::createPromoteMemoryToRegisterPass());
-  pass_manager.add(llvm::createGlobalOptimizerPass());
+  if (co.opt_level == ExecutorOptLevel::Fast) {
+    // Keep only cheap passes which give the most benefit for the generated code. The
+    // full pipeline is used when hot code is recompiled.
+    pass_manager.add(llvm::createPromoteMemoryToRegisterPass());
+    pass_manager.add(llvm::createCFGSimplificationPass());
+  } else {
+    pass_manager.add(llvm::createSROAPass());
+    // mem ssa drops unused load and store instructions, e.g. passing variables directly
+    // where possible
+    pass_manager.add(
+        llvm::createEarlyCSEPass(/*enable_mem_ssa=*/true));  // Catch trivial redundancies
+
+    if (!is_gpu_smem_used) {
+      // thread jumps can change the execution order around SMEM sections guarded by
+      // `__syncthreads()`, which results in race conditions. For now, disable jump
+      // threading for shared memory queries. In the future, consider handling shared
+      // memory aggregations with a separate kernel launch
+      pass_manager.add(llvm::createJumpThreadingPass());  // Thread jumps.
+    }
+    pass_manager.add(llvm::createCFGSimplificationPass());
+
+    // remove load/stores in PHIs if instructions can be accessed directly post thread
+    // jumps
+    pass_manager.add(llvm::createNewGVNPass());
+
+    pass_manager.add(llvm::createDeadStoreEliminationPass());
+    pass_manager.add(llvm::createLICMPass());
+
+    pass_manager.add(llvm::createInstructionCombiningPass());
+
+    // module passes
+    pass_manager.add(llvm::createPromoteMemoryToRegisterPass());
+    pass_manager.add(llvm::createGlobalOptimizerPass());
+
+    if (co.vectorize_loops && co.device_type == ExecutorDeviceType::CPU) {
+      // The row function is inlined into the fragment loop at this point. Rotate the
+      // loop and let the vectorizer if-convert filter branches into masked operations
+      // on batches of rows where the cost model finds it profitable.
+      pass_manager.add(llvm::createLoopRotatePass());
+      pass_manager.add(llvm::createLICMPass());
+      pass_manager.add(llvm::createLoopVectorizePass());
+      pass_manager.add(llvm::createSLPVectorizerPass());
+      pass_manager.add(llvm::createInstructionCombiningPass());
+    }
 
-  pass_manager.add(llvm::createCFGSimplificationPass());  // cleanup after everything
+    pass_manager.add(llvm::createCFGSimplificationPass());  // cleanup after everything
+  }
 
   pass_manager.run(*llvm_module);
 
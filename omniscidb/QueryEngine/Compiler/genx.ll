@@ -40,6 +40,11 @@ define i64 @get_block_index() {
     ret i64 %gid
 }
 
+define i64 @get_block_dim() {
+    %dim = call i64 @__spirv_BuiltInWorkgroupSize(i32 0)
+    ret i64 %dim
+}
+
 define i8 @thread_warp_idx(i8 noundef %warp_sz) {
     ret i8 0
 }
@@ -18,9 +18,107 @@
 #include "ExtrapolationModels/LinearRegression.h"
 #endif
 
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
 namespace costmodel {
 
-CostModel::CostModel(CostModelConfig config) : config_(std::move(config)) {
+namespace {
+
+constexpr const char* kCalibrationCacheHeader = "hdk-cost-model-calibration-v1";
+
+// Identifies the data source and the hardware measurements were collected on.
+std::string get_calibration_fingerprint(const std::string& data_source_name,
+                                        const std::vector<ExecutorDeviceType>& devices) {
+  std::string cpu_model = "unknown";
+  std::ifstream cpuinfo("/proc/cpuinfo");
+  std::string line;
+  while (std::getline(cpuinfo, line)) {
+    if (line.rfind("model name", 0) == 0) {
+      auto pos = line.find(':');
+      if (pos != std::string::npos) {
+        cpu_model = line.substr(pos + 1);
+      }
+      break;
+    }
+  }
+
+  std::stringstream ss;
+  ss << data_source_name << ";" << cpu_model << ";"
+     << std::thread::hardware_concurrency();
+  for (auto device : devices) {
+    ss << ";" << deviceToString(device);
+  }
+  return ss.str();
+}
+
+bool load_calibration(const std::string& path,
+                      const std::string& fingerprint,
+                      Detail::DeviceMeasurements& dm) {
+  std::ifstream in(path);
+  if (!in) {
+    return false;
+  }
+  std::string header, stored_fingerprint;
+  if (!std::getline(in, header) || header != kCalibrationCacheHeader ||
+      !std::getline(in, stored_fingerprint) || stored_fingerprint != fingerprint) {
+    return false;
+  }
+
+  Detail::DeviceMeasurements res;
+  int device, templ;
+  Detail::Measurement measurement;
+  while (in >> device >> templ >> measurement.bytes >> measurement.milliseconds) {
+    if (device < 0 || device > static_cast<int>(ExecutorDeviceType::GPU) || templ < 0 ||
+        templ >= static_cast<int>(AnalyticalTemplate::Unknown)) {
+      return false;
+    }
+    res[static_cast<ExecutorDeviceType>(device)][static_cast<AnalyticalTemplate>(templ)]
+        .push_back(measurement);
+  }
+  if (!in.eof() || res.empty()) {
+    return false;
+  }
+  dm = std::move(res);
+  return true;
+}
+
+void save_calibration(const std::string& path,
+                      const std::string& fingerprint,
+                      const Detail::DeviceMeasurements& dm) {
+  // Write to a temporary file first to never leave a partially written cache.
+  const std::string tmp_path = path + ".tmp";
+  {
+    std::ofstream out(tmp_path, std::ios::trunc);
+    out << kCalibrationCacheHeader << "\n" << fingerprint << "\n";
+    for (const auto& [device, template_measurements] : dm) {
+      for (const auto& [templ, measurements] : template_measurements) {
+        for (const auto& measurement : measurements) {
+          out << static_cast<int>(device) << " " << static_cast<int>(templ) << " "
+              << measurement.bytes << " " << measurement.milliseconds << "\n";
+        }
+      }
+    }
+    if (!out) {
+      LOG(WARNING) << "Cannot write cost model calibration cache to " << tmp_path;
+      return;
+    }
+  }
+  std::error_code ec;
+  std::filesystem::rename(tmp_path, path, ec);
+  if (ec) {
+    LOG(WARNING) << "Cannot write cost model calibration cache to " << path << ": "
+                 << ec.message();
+  }
+}
+
+}  // namespace
+
+CostModel::CostModel(CostModelConfig config)
+    : config_(std::move(config))
+    , runtime_data_source_(dynamic_cast<RuntimeDataSource*>(config_.data_source.get())) {
   for (AnalyticalTemplate templ : templates_) {
     if (!config_.data_source->isTemplateSupported(templ))
       throw CostModelException("template " + toString(templ) + " not supported in " +
@@ -39,11 +137,28 @@ void CostModel::calibrate(const CaibrationConfig& conf) {
 
   Detail::DeviceMeasurements dm;
 
-  try {
-    dm = config_.data_source->getMeasurements(conf.devices, templates_);
-  } catch (const std::exception& e) {
-    LOG(ERROR) << "Cost model calibration failure: " << e.what();
-    return;
+  const auto& cache_file = config_.calibration_cache_file;
+  std::string fingerprint;
+  bool loaded = false;
+  if (!cache_file.empty()) {
+    fingerprint =
+        get_calibration_fingerprint(config_.data_source->getName(), conf.devices);
+    loaded = load_calibration(cache_file, fingerprint, dm);
+    if (loaded) {
+      LOG(INFO) << "Loaded cost model calibration from " << cache_file;
+    }
+  }
+
+  if (!loaded) {
+    try {
+      dm = config_.data_source->getMeasurements(conf.devices, templates_);
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Cost model calibration failure: " << e.what();
+      return;
+    }
+    if (!cache_file.empty() && !dm.empty()) {
+      save_calibration(cache_file, fingerprint, dm);
+    }
   }
 
   for (const auto& dm_entry : dm) {
@@ -57,19 +172,96 @@ void CostModel::calibrate(const CaibrationConfig& conf) {
   }
 }
 
+bool CostModel::collectsRuntimeMeasurements() const {
+  return runtime_data_source_ != nullptr;
+}
+
+void CostModel::addRuntimeMeasurement(ExecutorDeviceType device,
+                                      const std::vector<AnalyticalTemplate>& templs,
+                                      size_t bytes,
+                                      size_t milliseconds,
+                                      const std::optional<QueryFeatures>& features) {
+  if (!runtime_data_source_ || templs.empty()) {
+    return;
+  }
+
+  std::optional<uint64_t> feature_class;
+  if (features) {
+    feature_class = features->getClass();
+  }
+
+  using Updates =
+      std::vector<std::pair<AnalyticalTemplate, std::vector<Detail::Measurement>>>;
+  Updates updates;
+  Updates feature_updates;
+  try {
+    for (AnalyticalTemplate templ : templs) {
+      runtime_data_source_->addMeasurement(
+          device, templ, {bytes, milliseconds / templs.size()}, feature_class);
+      updates.emplace_back(templ,
+                           runtime_data_source_->getTemplateMeasurements(device, templ));
+      if (feature_class) {
+        feature_updates.emplace_back(
+            templ,
+            runtime_data_source_->getTemplateMeasurements(device, templ, feature_class));
+      }
+    }
+  } catch (const DataSourceException& e) {
+    LOG(DEBUG1) << "Cannot add runtime measurement: " << e.what();
+    return;
+  }
+
+  std::unique_lock<std::shared_mutex> l(latch_);
+  for (auto& [templ, measurements] : updates) {
+    if (!measurements.empty()) {
+      dp_[device][templ] = extrapolation_provider_.provide(std::move(measurements));
+    }
+  }
+  for (auto& [templ, measurements] : feature_updates) {
+    if (!measurements.empty()) {
+      feature_dp_[device][*feature_class][templ] =
+          extrapolation_provider_.provide(std::move(measurements));
+    }
+  }
+}
+
 std::vector<CostModel::DeviceExtrapolations> CostModel::getExtrapolations(
     const std::vector<ExecutorDeviceType>& devices,
-    const std::vector<AnalyticalTemplate>& templs) const {
+    const std::vector<AnalyticalTemplate>& templs,
+    const std::optional<QueryFeatures>& features) const {
   std::vector<DeviceExtrapolations> devices_extrapolations;
   for (ExecutorDeviceType device : devices) {
+    const TemplatePredictions* feature_models = nullptr;
+    if (features) {
+      auto feature_device_it = feature_dp_.find(device);
+      if (feature_device_it != feature_dp_.end()) {
+        auto class_it = feature_device_it->second.find(features->getClass());
+        if (class_it != feature_device_it->second.end()) {
+          feature_models = &class_it->second;
+        }
+      }
+    }
+
     auto device_measurements_it = dp_.find(device);
-    if (device_measurements_it == dp_.end()) {
+    if (device_measurements_it == dp_.end() && !feature_models) {
       throw CostModelException("there is no " + deviceToString(device) +
                                " in measured data");
     }
     std::vector<std::shared_ptr<ExtrapolationModel>> extrapolations;
 
     for (AnalyticalTemplate templ : templs) {
+      if (feature_models) {
+        auto feature_model_it = feature_models->find(templ);
+        if (feature_model_it != feature_models->end()) {
+          extrapolations.push_back(feature_model_it->second);
+          continue;
+        }
+      }
+
+      if (device_measurements_it == dp_.end()) {
+        throw CostModelException("there is no " + deviceToString(device) +
+                                 " in measured data");
+      }
       auto model_it = device_measurements_it->second.find(templ);
       if (model_it == device_measurements_it->second.end()) {
         throw CostModelException("there is no " + toString(templ) +
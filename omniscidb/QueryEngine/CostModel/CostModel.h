@@ -14,9 +14,11 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <shared_mutex>
 
 #include "DataSources/DataSource.h"
+#include "DataSources/RuntimeDataSource.h"
 #include "ExtrapolationModels/ExtrapolationModelProvider.h"
 #include "Measurements.h"
 
@@ -32,15 +34,24 @@ struct CaibrationConfig {
 struct QueryInfo {
   std::vector<AnalyticalTemplate> templs;
   size_t bytes_size;
+  // Used to choose models of the query feature class when available.
+  std::optional<QueryFeatures> features = std::nullopt;
 };
 
 struct CostModelConfig {
   std::unique_ptr<DataSource> data_source;
+  // File to store calibration measurements across process restarts. Stored
+  // measurements are used instead of the data source if they were collected by the
+  // same data source on the same hardware.
+  std::string calibration_cache_file = "";
 };
 
 using TemplatePredictions =
     std::unordered_map<AnalyticalTemplate, std::shared_ptr<ExtrapolationModel>>;
 using DevicePredictions = std::unordered_map<ExecutorDeviceType, TemplatePredictions>;
+using FeatureClassPredictions =
+    std::unordered_map<ExecutorDeviceType,
+                       std::unordered_map<uint64_t, TemplatePredictions>>;
 
 class CostModel {
  public:
@@ -51,22 +62,44 @@ class CostModel {
   virtual std::unique_ptr<policy::ExecutionPolicy> predict(
       QueryInfo query_info) const = 0;
 
+  // True if the data source collects measurements of executed kernels.
+  bool collectsRuntimeMeasurements() const;
+
+  // Add a measurement of an executed kernel and rebuild extrapolation models of its
+  // templates. Kernel time is split evenly between templates. If query features are
+  // provided, models of the feature class are rebuilt too. No-op if the data source
+  // doesn't collect runtime measurements.
+  void addRuntimeMeasurement(
+      ExecutorDeviceType device,
+      const std::vector<AnalyticalTemplate>& templs,
+      size_t bytes,
+      size_t milliseconds,
+      const std::optional<QueryFeatures>& features = std::nullopt);
+
  protected:
   struct DeviceExtrapolations {
     ExecutorDeviceType device;
     std::vector<std::shared_ptr<ExtrapolationModel>> extrapolations;
   };
 
+  // Models of the query feature class are preferred over template-level models.
   std::vector<DeviceExtrapolations> getExtrapolations(
       const std::vector<ExecutorDeviceType>& devices,
-      const std::vector<AnalyticalTemplate>& templs) const;
+      const std::vector<AnalyticalTemplate>& templs,
+      const std::optional<QueryFeatures>& features = std::nullopt) const;
 
   CostModelConfig config_;
 
+  // Set if config_.data_source is a runtime data source.
+  RuntimeDataSource* runtime_data_source_;
+
   ExtrapolationModelProvider extrapolation_provider_;
 
   DevicePredictions dp_;
 
+  // Models built from runtime measurements of each query feature class.
+  FeatureClassPredictions feature_dp_;
+
   static const std::vector<AnalyticalTemplate> templates_;
 
   std::vector<ExecutorDeviceType> devices_ = {ExecutorDeviceType::CPU,
@@ -0,0 +1,109 @@
+/*
+    Copyright (c) 2023 Intel Corporation
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+        http://www.apache.org/licenses/LICENSE-2.0
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "RuntimeDataSource.h"
+
+#include <map>
+
+namespace costmodel {
+
+RuntimeDataSource::RuntimeDataSource(size_t max_measurements)
+    : DataSource(DataSourceConfig{"RuntimeDataSource",
+                                  {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU},
+                                  {AnalyticalTemplate::GroupBy,
+                                   AnalyticalTemplate::Join,
+                                   AnalyticalTemplate::Reduce,
+                                   AnalyticalTemplate::Scan,
+                                   AnalyticalTemplate::Sort}})
+    , max_measurements_(std::max(max_measurements, size_t(2))) {}
+
+Detail::DeviceMeasurements RuntimeDataSource::getMeasurements(
+    const std::vector<ExecutorDeviceType>& devices,
+    const std::vector<AnalyticalTemplate>& templates) {
+  Detail::DeviceMeasurements dm;
+  for (auto device : devices) {
+    for (auto templ : templates) {
+      auto measurements = getTemplateMeasurements(device, templ);
+      if (!measurements.empty()) {
+        dm[device][templ] = std::move(measurements);
+      }
+    }
+  }
+  return dm;
+}
+
+void RuntimeDataSource::addMeasurement(ExecutorDeviceType device,
+                                       AnalyticalTemplate templ,
+                                       Detail::Measurement measurement,
+                                       std::optional<uint64_t> feature_class) {
+  if (!isDeviceSupported(device)) {
+    throw UnsupportedDevice(device);
+  }
+  if (!isTemplateSupported(templ)) {
+    throw UnsupportedAnalyticalTemplate(templ);
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  addMeasurementImpl(device, templ, measurement, std::nullopt);
+  if (feature_class) {
+    addMeasurementImpl(device, templ, measurement, feature_class);
+  }
+}
+
+void RuntimeDataSource::addMeasurementImpl(ExecutorDeviceType device,
+                                           AnalyticalTemplate templ,
+                                           Detail::Measurement measurement,
+                                           std::optional<uint64_t> feature_class) {
+  auto& measurements = measurements_[device][{templ, feature_class}];
+  measurements.push_back(measurement);
+  if (measurements.size() > max_measurements_) {
+    measurements.pop_front();
+  }
+}
+
+std::vector<Detail::Measurement> RuntimeDataSource::getTemplateMeasurements(
+    ExecutorDeviceType device,
+    AnalyticalTemplate templ,
+    std::optional<uint64_t> feature_class) {
+  // Sum and count of times per size.
+  std::map<size_t, std::pair<size_t, size_t>> times;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto device_it = measurements_.find(device);
+    if (device_it == measurements_.end()) {
+      return {};
+    }
+    auto templ_it = device_it->second.find({templ, feature_class});
+    if (templ_it == device_it->second.end()) {
+      return {};
+    }
+    for (const auto& measurement : templ_it->second) {
+      auto& [sum, count] = times[measurement.bytes];
+      sum += measurement.milliseconds;
+      ++count;
+    }
+  }
+
+  if (times.size() < 2) {
+    return {};
+  }
+
+  std::vector<Detail::Measurement> res;
+  res.reserve(times.size());
+  for (const auto& [bytes, time] : times) {
+    res.push_back({bytes, time.first / time.second});
+  }
+  return res;
+}
+
+}  // namespace costmodel
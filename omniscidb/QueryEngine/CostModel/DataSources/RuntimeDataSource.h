@@ -0,0 +1,72 @@
+/*
+    Copyright (c) 2023 Intel Corporation
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+        http://www.apache.org/licenses/LICENSE-2.0
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include "DataSource.h"
+
+#include <deque>
+#include <map>
+#include <mutex>
+#include <optional>
+
+namespace costmodel {
+
+/**
+ * Data source collecting measurements of kernels executed by queries. Only the most
+ * recent measurements of each device and template are kept, so models built from
+ * them follow the actual hardware and data.
+ *
+ * Measurements can be tagged with a query feature class (see QueryFeatures). Tagged
+ * measurements are kept both per feature class and per template, so models of
+ * feature classes and template-level models are built from the same data.
+ */
+class RuntimeDataSource : public DataSource {
+ public:
+  RuntimeDataSource(size_t max_measurements = 256);
+
+  Detail::DeviceMeasurements getMeasurements(
+      const std::vector<ExecutorDeviceType>& devices,
+      const std::vector<AnalyticalTemplate>& templates) override;
+
+  void addMeasurement(ExecutorDeviceType device,
+                      AnalyticalTemplate templ,
+                      Detail::Measurement measurement,
+                      std::optional<uint64_t> feature_class = std::nullopt);
+
+  // Returns measurements sorted by size with the time of equal sizes averaged.
+  // Returns an empty vector if there are less than two distinct sizes, which is
+  // not enough to build an extrapolation model.
+  // If feature_class is set, only measurements of this class are used.
+  std::vector<Detail::Measurement> getTemplateMeasurements(
+      ExecutorDeviceType device,
+      AnalyticalTemplate templ,
+      std::optional<uint64_t> feature_class = std::nullopt);
+
+ private:
+  const size_t max_measurements_;
+  std::mutex mutex_;
+  void addMeasurementImpl(ExecutorDeviceType device,
+                          AnalyticalTemplate templ,
+                          Detail::Measurement measurement,
+                          std::optional<uint64_t> feature_class);
+
+  // Measurements are keyed by template and optional feature class. Template-level
+  // measurements use an empty feature class.
+  using TemplateMeasurements =
+      std::map<std::pair<AnalyticalTemplate, std::optional<uint64_t>>,
+               std::deque<Detail::Measurement>>;
+  std::unordered_map<ExecutorDeviceType, TemplateMeasurements> measurements_;
+};
+
+}  // namespace costmodel
@@ -23,11 +23,13 @@
 namespace costmodel {
 
 #ifdef HAVE_DWARF_BENCH
-IterativeCostModel::IterativeCostModel()
-    : CostModel({std::make_unique<DwarfBenchDataSource>()}) {}
+IterativeCostModel::IterativeCostModel(std::string calibration_cache_file)
+    : CostModel({std::make_unique<DwarfBenchDataSource>(),
+                 std::move(calibration_cache_file)}) {}
 #else
-IterativeCostModel::IterativeCostModel()
-    : CostModel({std::make_unique<EmptyDataSource>()}) {}
+IterativeCostModel::IterativeCostModel(std::string calibration_cache_file)
+    : CostModel(
+          {std::make_unique<EmptyDataSource>(), std::move(calibration_cache_file)}) {}
 #endif
 
 std::unique_ptr<policy::ExecutionPolicy> IterativeCostModel::predict(
@@ -40,7 +42,9 @@ std::unique_ptr<policy::ExecutionPolicy> IterativeCostModel::predict(
   size_t runtime_prediction = std::numeric_limits<size_t>::max();
 
   std::vector<DeviceExtrapolations> devices_extrapolations = getExtrapolations(
-      {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}, query_info.templs);
+      {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU},
+      query_info.templs,
+      query_info.features);
 
   for (size_t cur_size = 0; cur_size < query_info.bytes_size; cur_size += opt_step) {
     size_t cpu_size = cur_size;
@@ -21,7 +21,7 @@ namespace costmodel {
 
 class IterativeCostModel : public CostModel {
  public:
-  IterativeCostModel();
+  IterativeCostModel(std::string calibration_cache_file = "");
   IterativeCostModel(CostModelConfig config) : CostModel(std::move(config)) {}
 
   virtual std::unique_ptr<policy::ExecutionPolicy> predict(QueryInfo query_info) const;
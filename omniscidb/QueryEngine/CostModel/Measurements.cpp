@@ -1,5 +1,8 @@
 #include "Measurements.h"
 
+#include <algorithm>
+#include <sstream>
+
 namespace costmodel {
 
 std::string toString(AnalyticalTemplate templ) {
@@ -19,4 +22,28 @@ std::string toString(AnalyticalTemplate templ) {
   }
 }
 
+uint64_t QueryFeatures::getClass() const {
+  // 0, 1, 2 and 3+ join levels.
+  uint64_t join_bucket = std::min(join_levels, size_t(3));
+  // No keys, up to 8 bytes, up to 16 bytes and wider keys.
+  uint64_t key_bucket = group_key_width == 0 ? 0
+                        : group_key_width <= 8  ? 1
+                        : group_key_width <= 16 ? 2
+                                                : 3;
+  return join_bucket | (key_bucket << 2) | (uint64_t(has_loop_join) << 4) |
+         (uint64_t(has_count_distinct) << 5) | (uint64_t(has_string_ops) << 6) |
+         (uint64_t(columnar_output) << 7);
+}
+
+std::string toString(const QueryFeatures& features) {
+  std::stringstream ss;
+  ss << "QueryFeatures(join_levels=" << features.join_levels
+     << ", has_loop_join=" << features.has_loop_join
+     << ", group_key_width=" << features.group_key_width
+     << ", has_count_distinct=" << features.has_count_distinct
+     << ", has_string_ops=" << features.has_string_ops
+     << ", columnar_output=" << features.columnar_output << ")";
+  return ss.str();
+}
+
 }  // namespace costmodel
@@ -27,6 +27,29 @@ enum AnalyticalTemplate { GroupBy, Scan, Join, Reduce, Sort, Unknown };
 
 std::string toString(AnalyticalTemplate templ);
 
+/**
+ * Features of a query which affect its execution time in addition to the analytical
+ * templates and the input size. Queries with equal feature classes are expected to
+ * scale similarly, so extrapolation models are built per feature class.
+ */
+struct QueryFeatures {
+  // Number of join nesting levels.
+  size_t join_levels = 0;
+  // True if some join level has no equi-join condition and is executed as a loop join.
+  bool has_loop_join = false;
+  // Total size of group by keys in bytes.
+  size_t group_key_width = 0;
+  bool has_count_distinct = false;
+  bool has_string_ops = false;
+  bool columnar_output = false;
+
+  // Bucketized features packed into a single value. Join levels and key width are
+  // bucketized to keep the number of classes and models small.
+  uint64_t getClass() const;
+};
+
+std::string toString(const QueryFeatures& features);
+
 namespace Detail {
 
 struct Measurement {
@@ -0,0 +1,69 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    Crc32cHashInl.h
+ * @brief   Key hashing with hardware CRC32C instructions.
+ *
+ * Available for CPU code on x86-64 only. The hash function is compiled for SSE4.2
+ * regardless of the build flags, so callers must check crc32_key_hash_supported()
+ * before using it.
+ **/
+
+#ifndef QUERYENGINE_CRC32CHASHINL_H
+#define QUERYENGINE_CRC32CHASHINL_H
+
+#if defined(__x86_64__) && !defined(__CUDACC__)
+#define HAVE_CRC32_KEY_HASH
+#define CRC32_KEY_HASH_TARGET __attribute__((target("sse4.2")))
+
+#include <nmmintrin.h>
+#include <cstdint>
+#include <cstring>
+
+CRC32_KEY_HASH_TARGET inline uint32_t Crc32cHashImpl(const void* key,
+                                                     int len,
+                                                     const uint32_t seed) {
+  const auto data = reinterpret_cast<const uint8_t*>(key);
+  uint64_t h = seed;
+  int pos = 0;
+  for (; pos + 8 <= len; pos += 8) {
+    uint64_t k;
+    std::memcpy(&k, data + pos, sizeof(k));
+    h = _mm_crc32_u64(h, k);
+  }
+  uint32_t h32 = static_cast<uint32_t>(h);
+  if (pos + 4 <= len) {
+    uint32_t k;
+    std::memcpy(&k, data + pos, sizeof(k));
+    h32 = _mm_crc32_u32(h32, k);
+    pos += 4;
+  }
+  for (; pos < len; ++pos) {
+    h32 = _mm_crc32_u8(h32, data[pos]);
+  }
+  // CRC is linear, mix the bits to get a good distribution modulo the entry count.
+  h32 ^= h32 >> 16;
+  h32 *= 0x85ebca6b;
+  h32 ^= h32 >> 13;
+  return h32;
+}
+
+inline bool crc32_key_hash_supported() {
+  return __builtin_cpu_supports("sse4.2");
+}
+
+#endif  // __x86_64__ && !__CUDACC__
+
+#endif  // QUERYENGINE_CRC32CHASHINL_H
@@ -38,8 +38,8 @@ enum CacheItemType {
   BASELINE_HT,              // Baseline hashtable
   HT_HASHING_SCHEME,        // Hashtable layout
   BASELINE_HT_APPROX_CARD,  // Approximated cardinality for baseline hashtable
+  QUERY_RESULT_SET,         // Result of a query step
   // TODO (yoonmin): support the following items for recycling
-  // ROW_RS,             Row-wise resultset
   // COUNTALL_CARD_EST,  Cardinality of query result
   // NDV_CARD_EST,       # Non-distinct value
   // FILTER_SEL          Selectivity of (push-downed) filter node
@@ -113,13 +113,14 @@ using CacheMetricInfoMap =
 
 class DataRecyclerUtil {
  public:
-  // need to add more constants if necessary: ROW_RS, COUNTALL_CARD_EST, NDV_CARD_EST,
+  // need to add more constants if necessary: COUNTALL_CARD_EST, NDV_CARD_EST,
   // FILTER_SEL, ...
   static constexpr auto cache_item_type_str =
       shared::string_view_array("Perfect Join Hashtable",
                                 "Baseline Join Hashtable",
                                 "Hashing Scheme for Join Hashtable",
-                                "Baseline Join Hashtable's Approximated Cardinality");
+                                "Baseline Join Hashtable's Approximated Cardinality",
+                                "Query Result Set");
   static std::string_view toStringCacheItemType(CacheItemType item_type) {
     static_assert(cache_item_type_str.size() == NUM_CACHE_ITEM_TYPE);
     return cache_item_type_str[item_type];
@@ -253,7 +254,7 @@ class CacheMetricTracker {
   }
 
   void removeMetricFromBeginning(DeviceIdentifier device_identifier, int offset) {
-    auto metrics = getCacheItemMetrics(device_identifier);
+    auto& metrics = getCacheItemMetrics(device_identifier);
     metrics.erase(metrics.begin(), metrics.begin() + offset);
   }
 
@@ -16,10 +16,26 @@
 
 #include "HashtableRecycler.h"
 #include "QueryEngine/Execute.h"
+#include "Shared/Metrics.h"
 #include "Shared/funcannotations.h"
 
 EXTERN extern bool g_is_test_env;
 
+namespace {
+
+// a cached hashtable is stale when it was built for older generations of its inner
+// tables, lookups without meta info skip the check
+bool is_stale(const std::optional<HashtableCacheMetaInfo>& cached_meta_info,
+              const std::optional<HashtableCacheMetaInfo>& meta_info) {
+  if (!meta_info || !cached_meta_info) {
+    return false;
+  }
+  return !(cached_meta_info->inner_table_generations ==
+           meta_info->inner_table_generations);
+}
+
+}  // namespace
+
 bool HashtableRecycler::hasItemInCache(
     QueryPlanHash key,
     CacheItemType item_type,
@@ -34,7 +50,7 @@ bool HashtableRecycler::hasItemInCache(
   // hashtable cache of the *any* device type should be properly initialized
   CHECK(hashtable_cache);
   auto candidate_ht = getCachedItem(key, *hashtable_cache);
-  if (candidate_ht) {
+  if (candidate_ht && !is_stale(candidate_ht->meta_info, meta_info)) {
     return true;
   }
   return false;
@@ -49,16 +65,23 @@ std::shared_ptr<HashTable> HashtableRecycler::getItemFromCache(
       key == EMPTY_HASHED_PLAN_DAG_KEY) {
     return nullptr;
   }
+  static auto& hits_metric = metrics::Registry::get().counter(
+      "hdk_hashtable_cache_hits_total", "Hash table lookups recycled a cached table.");
+  static auto& misses_metric = metrics::Registry::get().counter(
+      "hdk_hashtable_cache_misses_total", "Hash table lookups found no fresh table.");
   std::lock_guard<std::mutex> lock(getCacheLock());
   auto hashtable_cache = getCachedItemContainer(item_type, device_identifier);
   auto candidate_ht = getCachedItem(key, *hashtable_cache);
-  if (candidate_ht) {
+  // a stale hashtable is kept until the next put with the same key replaces it
+  if (candidate_ht && !is_stale(candidate_ht->meta_info, meta_info)) {
+    hits_metric.inc();
     candidate_ht->item_metric->incRefCount();
     VLOG(1) << "[" << DataRecyclerUtil::toStringCacheItemType(item_type) << ", "
             << DataRecyclerUtil::getDeviceIdentifierString(device_identifier)
             << "] Recycle item in a cache";
     return candidate_ht->cached_item;
   }
+  misses_metric.inc();
   return nullptr;
 }
 
@@ -75,8 +98,12 @@ void HashtableRecycler::putItemToCache(QueryPlanHash key,
   }
   std::lock_guard<std::mutex> lock(getCacheLock());
   if (!hasItemInCache(key, item_type, device_identifier, lock, meta_info)) {
-    // check cache's space availability
     auto& metric_tracker = getMetricTracker(item_type);
+    if (metric_tracker.getCacheItemMetric(key, device_identifier)) {
+      // the cached hashtable was built for older inner tables
+      removeItemFromCache(key, item_type, device_identifier, lock, meta_info);
+    }
+    // check cache's space availability
     auto cache_status = metric_tracker.canAddItem(device_identifier, item_size);
     if (cache_status == CacheAvailability::UNAVAILABLE) {
       // hashtable is too large
@@ -313,11 +340,21 @@ std::pair<QueryPlan, HashtableCacheMetaInfo> HashtableRecycler::getHashtableKeyS
     QueryPlanMetaInfo query_plan_meta_info;
     query_plan_meta_info.query_plan_dag = it->second.inner_cols_access_path;
     query_plan_meta_info.inner_col_info_string = inner_join_cols_info;
-    HashtableCacheMetaInfo meta_info;
     meta_info.query_plan_meta_info = query_plan_meta_info;
     VLOG(2) << "Find hashtable access path for the hashjoin qual: " << join_cols_info
             << " -> " << hashtable_access_path;
   }
+  for (auto inner_col : inner_cols_vec) {
+    const auto table_id = inner_col->tableId();
+    // temporary tables are identified by their query plan DAG
+    if (table_id < 0 || meta_info.inner_table_generations.asMap().count(table_id)) {
+      continue;
+    }
+    const auto table_info = executor->getTableInfo(inner_col->dbId(), table_id);
+    meta_info.inner_table_generations.setGeneration(
+        table_id,
+        TableGeneration{static_cast<int64_t>(table_info.getPhysicalNumTuples()), 0});
+  }
   return std::make_pair(hashtable_access_path, meta_info);
 }
 
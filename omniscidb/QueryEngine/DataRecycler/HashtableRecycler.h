@@ -18,6 +18,7 @@
 
 #include "DataRecycler.h"
 #include "QueryEngine/JoinHashTable/HashJoin.h"
+#include "QueryEngine/TableGenerations.h"
 #include "Shared/Config.h"
 
 struct QueryPlanMetaInfo {
@@ -27,6 +28,10 @@ struct QueryPlanMetaInfo {
 
 struct HashtableCacheMetaInfo {
   std::optional<QueryPlanMetaInfo> query_plan_meta_info;
+  // generations of the physical inner tables at the time the hashtable was built;
+  // the cache is shared by all executors, so a hashtable built before an append to
+  // its inner table must not be reused
+  TableGenerations inner_table_generations;
 };
 
 class HashtableRecycler
@@ -0,0 +1,260 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ResultSetRecycler.h"
+#include "QueryEngine/Execute.h"
+#include "Shared/funcannotations.h"
+
+#include <set>
+
+EXTERN extern bool g_is_test_env;
+
+namespace {
+
+bool same_meta_info(const std::optional<ResultSetCacheMetaInfo>& lhs,
+                    const std::optional<ResultSetCacheMetaInfo>& rhs) {
+  if (!lhs || !rhs) {
+    return false;
+  }
+  return lhs->query_plan_dag == rhs->query_plan_dag &&
+         lhs->table_generations == rhs->table_generations;
+}
+
+}  // namespace
+
+bool ResultSetRecycler::hasItemInCache(
+    QueryPlanHash key,
+    CacheItemType item_type,
+    DeviceIdentifier device_identifier,
+    std::lock_guard<std::mutex>& lock,
+    std::optional<ResultSetCacheMetaInfo> meta_info) const {
+  if (!isEnabled() || key == EMPTY_HASHED_PLAN_DAG_KEY) {
+    return false;
+  }
+  auto result_set_cache = getCachedItemContainer(item_type, device_identifier);
+  CHECK(result_set_cache);
+  auto candidate_rs = getCachedItem(key, *result_set_cache);
+  return candidate_rs && same_meta_info(candidate_rs->meta_info, meta_info);
+}
+
+std::shared_ptr<const ExecutionResult> ResultSetRecycler::getItemFromCache(
+    QueryPlanHash key,
+    CacheItemType item_type,
+    DeviceIdentifier device_identifier,
+    std::optional<ResultSetCacheMetaInfo> meta_info) const {
+  if (!isEnabled() || key == EMPTY_HASHED_PLAN_DAG_KEY) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(getCacheLock());
+  auto result_set_cache = getCachedItemContainer(item_type, device_identifier);
+  CHECK(result_set_cache);
+  auto candidate_rs = getCachedItem(key, *result_set_cache);
+  // a stale result is kept until the next put with the same key replaces it
+  if (candidate_rs && same_meta_info(candidate_rs->meta_info, meta_info)) {
+    candidate_rs->item_metric->incRefCount();
+    VLOG(1) << "[" << DataRecyclerUtil::toStringCacheItemType(item_type) << ", "
+            << DataRecyclerUtil::getDeviceIdentifierString(device_identifier)
+            << "] Recycle item in a cache";
+    return candidate_rs->cached_item;
+  }
+  return nullptr;
+}
+
+std::optional<std::pair<std::shared_ptr<const ExecutionResult>, ResultSetCacheMetaInfo>>
+ResultSetRecycler::getOutdatedItemFromCache(
+    QueryPlanHash key,
+    CacheItemType item_type,
+    DeviceIdentifier device_identifier,
+    const ResultSetCacheMetaInfo& meta_info) const {
+  if (!isEnabled() || key == EMPTY_HASHED_PLAN_DAG_KEY) {
+    return std::nullopt;
+  }
+  std::lock_guard<std::mutex> lock(getCacheLock());
+  auto result_set_cache = getCachedItemContainer(item_type, device_identifier);
+  CHECK(result_set_cache);
+  auto candidate_rs = getCachedItem(key, *result_set_cache);
+  if (candidate_rs && candidate_rs->meta_info &&
+      candidate_rs->meta_info->query_plan_dag == meta_info.query_plan_dag) {
+    return std::make_pair(candidate_rs->cached_item, *candidate_rs->meta_info);
+  }
+  return std::nullopt;
+}
+
+void ResultSetRecycler::putItemToCache(QueryPlanHash key,
+                                       std::shared_ptr<const ExecutionResult> item_ptr,
+                                       CacheItemType item_type,
+                                       DeviceIdentifier device_identifier,
+                                       size_t item_size,
+                                       size_t compute_time,
+                                       std::optional<ResultSetCacheMetaInfo> meta_info) {
+  if (!isEnabled() || key == EMPTY_HASHED_PLAN_DAG_KEY) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(getCacheLock());
+  if (hasItemInCache(key, item_type, device_identifier, lock, meta_info)) {
+    // this result is already cached
+    return;
+  }
+  auto& metric_tracker = getMetricTracker(item_type);
+  if (metric_tracker.getCacheItemMetric(key, device_identifier)) {
+    // the cached result was computed for older input tables
+    removeItemFromCache(key, item_type, device_identifier, lock, meta_info);
+  }
+  auto cache_status = metric_tracker.canAddItem(device_identifier, item_size);
+  if (cache_status == CacheAvailability::UNAVAILABLE) {
+    return;
+  } else if (cache_status == CacheAvailability::AVAILABLE_AFTER_CLEANUP) {
+    auto required_size = metric_tracker.calculateRequiredSpaceForItemAddition(
+        device_identifier, item_size);
+    cleanupCacheForInsertion(item_type, device_identifier, required_size, lock);
+  }
+  auto new_cache_metric_ptr = metric_tracker.putNewCacheItemMetric(
+      key, device_identifier, item_size, compute_time);
+  CHECK_EQ(item_size, new_cache_metric_ptr->getMemSize());
+  metric_tracker.updateCurrentCacheSize(
+      device_identifier, CacheUpdateAction::ADD, item_size);
+  VLOG(1) << "[" << DataRecyclerUtil::toStringCacheItemType(item_type) << ", "
+          << DataRecyclerUtil::getDeviceIdentifierString(device_identifier)
+          << "] Put item to cache";
+  auto result_set_cache = getCachedItemContainer(item_type, device_identifier);
+  result_set_cache->emplace_back(key, item_ptr, new_cache_metric_ptr, meta_info);
+}
+
+void ResultSetRecycler::removeItemFromCache(
+    QueryPlanHash key,
+    CacheItemType item_type,
+    DeviceIdentifier device_identifier,
+    std::lock_guard<std::mutex>& lock,
+    std::optional<ResultSetCacheMetaInfo> meta_info) {
+  auto& cache_metrics = getMetricTracker(item_type);
+  auto cache_metric = cache_metrics.getCacheItemMetric(key, device_identifier);
+  CHECK(cache_metric);
+  auto result_set_size = cache_metric->getMemSize();
+  auto result_set_container = getCachedItemContainer(item_type, device_identifier);
+  auto filter = [key](auto const& item) { return item.key == key; };
+  auto itr =
+      std::find_if(result_set_container->cbegin(), result_set_container->cend(), filter);
+  if (itr == result_set_container->cend()) {
+    return;
+  }
+  result_set_container->erase(itr);
+  cache_metrics.removeCacheItemMetric(key, device_identifier);
+  cache_metrics.updateCurrentCacheSize(
+      device_identifier, CacheUpdateAction::REMOVE, result_set_size);
+}
+
+void ResultSetRecycler::cleanupCacheForInsertion(
+    CacheItemType item_type,
+    DeviceIdentifier device_identifier,
+    size_t required_size,
+    std::lock_guard<std::mutex>& lock,
+    std::optional<ResultSetCacheMetaInfo> meta_info) {
+  // remove the least useful results first, see HashtableRecycler for details
+  int elimination_target_offset = 0;
+  size_t removed_size = 0;
+  auto& metric_tracker = getMetricTracker(item_type);
+  auto actual_space_to_free = metric_tracker.getTotalCacheSize() / 2;
+  if (!g_is_test_env && required_size < actual_space_to_free) {
+    required_size = actual_space_to_free;
+  }
+  metric_tracker.sortCacheInfoByQueryMetric(device_identifier);
+  auto cached_item_metrics = metric_tracker.getCacheItemMetrics(device_identifier);
+  sortCacheContainerByQueryMetric(item_type, device_identifier);
+
+  for (auto& metric : cached_item_metrics) {
+    auto target_size = metric->getMemSize();
+    ++elimination_target_offset;
+    removed_size += target_size;
+    if (removed_size > required_size) {
+      break;
+    }
+  }
+
+  removeCachedItemFromBeginning(item_type, device_identifier, elimination_target_offset);
+  metric_tracker.removeMetricFromBeginning(device_identifier, elimination_target_offset);
+
+  metric_tracker.updateCurrentCacheSize(
+      device_identifier, CacheUpdateAction::REMOVE, removed_size);
+}
+
+void ResultSetRecycler::clearCache() {
+  std::lock_guard<std::mutex> lock(getCacheLock());
+  for (auto& item_type : getCacheItemType()) {
+    getMetricTracker(item_type).clearCacheMetricTracker();
+    auto item_cache = getItemCache().find(item_type)->second;
+    for (auto& kv : *item_cache) {
+      kv.second->clear();
+    }
+  }
+}
+
+std::string ResultSetRecycler::toString() const {
+  std::ostringstream oss;
+  oss << "A current status of the Result Set Recycler:\n";
+  for (auto& item_type : getCacheItemType()) {
+    oss << "\t" << DataRecyclerUtil::toStringCacheItemType(item_type);
+    auto& metric_tracker = getMetricTracker(item_type);
+    oss << "\n\t# cached result sets:\n";
+    auto item_cache = getItemCache().find(item_type)->second;
+    for (auto& cache_container : *item_cache) {
+      oss << "\t\tDevice"
+          << DataRecyclerUtil::getDeviceIdentifierString(cache_container.first)
+          << ", # result sets: " << cache_container.second->size() << "\n";
+      for (auto& rs : *cache_container.second) {
+        oss << "\t\t\tRS] " << rs.item_metric->toString() << "\n";
+      }
+    }
+    oss << "\t" << metric_tracker.toString() << "\n";
+  }
+  return oss.str();
+}
+
+std::pair<QueryPlanHash, ResultSetCacheMetaInfo> ResultSetRecycler::getResultSetCacheKey(
+    const QueryPlan& query_plan_dag,
+    const std::unordered_set<std::pair<int, int>>& phys_table_ids,
+    Executor* executor) {
+  if (query_plan_dag.empty() || query_plan_dag == EMPTY_QUERY_PLAN) {
+    return {EMPTY_HASHED_PLAN_DAG_KEY, {}};
+  }
+  std::set<std::pair<int, int>> sorted_table_ids(phys_table_ids.begin(),
+                                                  phys_table_ids.end());
+  ResultSetCacheMetaInfo meta_info;
+  meta_info.query_plan_dag = query_plan_dag;
+  for (auto& [db_id, table_id] : sorted_table_ids) {
+    meta_info.query_plan_dag +=
+        "|" + std::to_string(db_id) + ":" + std::to_string(table_id);
+    const auto table_info = executor->getTableInfo(db_id, table_id);
+    meta_info.table_generations.setGeneration(
+        table_id,
+        TableGeneration{static_cast<int64_t>(table_info.getPhysicalNumTuples()), 0});
+    meta_info.fragment_counts.emplace(table_id, table_info.fragments.size());
+  }
+  auto key = boost::hash_value(meta_info.query_plan_dag);
+  return {key, std::move(meta_info)};
+}
+
+size_t ResultSetRecycler::getResultSetSize(const ExecutionResult& result) {
+  size_t res = 0;
+  auto token = result.getToken();
+  if (!token) {
+    return res;
+  }
+  for (size_t i = 0; i < token->resultSetCount(); ++i) {
+    auto rs = token->resultSet(i);
+    if (rs->getStorage()) {
+      res += rs->getBufferSizeBytes(ExecutorDeviceType::CPU);
+    }
+  }
+  return res;
+}
@@ -0,0 +1,117 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "DataRecycler.h"
+#include "QueryEngine/TableGenerations.h"
+#include "Shared/Config.h"
+
+class Executor;
+
+constexpr DeviceIdentifier RESULT_SET_CACHE_DEVICE_IDENTIFIER =
+    DataRecyclerUtil::CPU_DEVICE_IDENTIFIER;
+
+struct ResultSetCacheMetaInfo {
+  // the key string of the cached item, compared on lookup to guard against
+  // collisions of the hashed key
+  QueryPlan query_plan_dag;
+  // generations of the physical input tables at the time the result was computed;
+  // any append to an input table makes the cached result stale
+  TableGenerations table_generations;
+  // numbers of fragments of the physical input tables, used to detect fragments
+  // appended after the result was computed
+  std::unordered_map<uint32_t, size_t> fragment_counts;
+};
+
+// Caches results of query steps (both intermediate and final ones) by their query
+// plan DAG. Results live in host memory, so we only maintain a CPU cache.
+class ResultSetRecycler
+    : public DataRecycler<std::shared_ptr<const ExecutionResult>,
+                          ResultSetCacheMetaInfo> {
+ public:
+  ResultSetRecycler(ConfigPtr config)
+      : DataRecycler({CacheItemType::QUERY_RESULT_SET},
+                     config->cache.result_set_cache_total_bytes,
+                     config->cache.max_cacheable_result_set_size_bytes,
+                     0)
+      , config_(config) {}
+
+  std::shared_ptr<const ExecutionResult> getItemFromCache(
+      QueryPlanHash key,
+      CacheItemType item_type,
+      DeviceIdentifier device_identifier,
+      std::optional<ResultSetCacheMetaInfo> meta_info = std::nullopt) const override;
+
+  // returns a result cached for the same query plan DAG but for older generations of
+  // the input tables along with its meta info
+  std::optional<std::pair<std::shared_ptr<const ExecutionResult>, ResultSetCacheMetaInfo>>
+  getOutdatedItemFromCache(QueryPlanHash key,
+                           CacheItemType item_type,
+                           DeviceIdentifier device_identifier,
+                           const ResultSetCacheMetaInfo& meta_info) const;
+
+  void putItemToCache(
+      QueryPlanHash key,
+      std::shared_ptr<const ExecutionResult> item_ptr,
+      CacheItemType item_type,
+      DeviceIdentifier device_identifier,
+      size_t item_size,
+      size_t compute_time,
+      std::optional<ResultSetCacheMetaInfo> meta_info = std::nullopt) override;
+
+  // nothing to do with result set recycler
+  void initCache() override {}
+
+  void clearCache() override;
+
+  std::string toString() const override;
+
+  bool isEnabled() const {
+    return config_->cache.enable_data_recycler && config_->cache.use_result_set_cache;
+  }
+
+  // the key includes ids of databases the input tables belong to because the query plan
+  // DAG identifies tables by table ids only
+  static std::pair<QueryPlanHash, ResultSetCacheMetaInfo> getResultSetCacheKey(
+      const QueryPlan& query_plan_dag,
+      const std::unordered_set<std::pair<int, int>>& phys_table_ids,
+      Executor* executor);
+
+  static size_t getResultSetSize(const ExecutionResult& result);
+
+ private:
+  bool hasItemInCache(
+      QueryPlanHash key,
+      CacheItemType item_type,
+      DeviceIdentifier device_identifier,
+      std::lock_guard<std::mutex>& lock,
+      std::optional<ResultSetCacheMetaInfo> meta_info = std::nullopt) const override;
+
+  void removeItemFromCache(
+      QueryPlanHash key,
+      CacheItemType item_type,
+      DeviceIdentifier device_identifier,
+      std::lock_guard<std::mutex>& lock,
+      std::optional<ResultSetCacheMetaInfo> meta_info = std::nullopt) override;
+
+  void cleanupCacheForInsertion(
+      CacheItemType item_type,
+      DeviceIdentifier device_identifier,
+      size_t required_size,
+      std::lock_guard<std::mutex>& lock,
+      std::optional<ResultSetCacheMetaInfo> meta_info = std::nullopt) override;
+
+  ConfigPtr config_;
+};
@@ -0,0 +1,126 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DateLookupTable.h"
+#include "CodeGenerator.h"
+#include "Execute.h"
+#include "Logger/Logger.h"
+#include "Shared/funcannotations.h"
+#include "Utils/ExtractFromTime.h"
+
+DateLookupTable::DateLookupTable(const int64_t min_val,
+                                 const int64_t max_val,
+                                 const std::function<int64_t(int64_t)>& fn,
+                                 const Data_Namespace::MemoryLevel memory_level,
+                                 const int device_count,
+                                 BufferProvider* buffer_provider)
+    : buffer_provider_(buffer_provider) {
+#if defined(HAVE_CUDA) || defined(HAVE_L0)
+  CHECK(memory_level == Data_Namespace::CPU_LEVEL ||
+        memory_level == Data_Namespace::GPU_LEVEL);
+#else
+  CHECK_EQ(Data_Namespace::CPU_LEVEL, memory_level);
+#endif  // HAVE_CUDA
+  CHECK_LE(min_val, max_val);
+  const auto min_day = floor_div(min_val, kSecsPerDay);
+  const auto max_day = floor_div(max_val, kSecsPerDay);
+  min_day_start_ = min_day * kSecsPerDay;
+  host_table_.resize(max_day - min_day + 1);
+  for (size_t i = 0; i < host_table_.size(); ++i) {
+    host_table_[i] = fn(min_day_start_ + static_cast<int64_t>(i) * kSecsPerDay);
+  }
+  const auto table_size_bytes = host_table_.size() * sizeof(int64_t);
+#if defined(HAVE_CUDA) || defined(HAVE_L0)
+  if (memory_level == Data_Namespace::GPU_LEVEL) {
+    for (int device_id = 0; device_id < device_count; ++device_id) {
+      gpu_buffers_.emplace_back(GpuAllocator::allocGpuAbstractBuffer(
+          buffer_provider, table_size_bytes, device_id));
+      auto gpu_table = gpu_buffers_.back()->getMemoryPtr();
+      buffer_provider->copyToDevice(gpu_table,
+                                    reinterpret_cast<const int8_t*>(host_table_.data()),
+                                    table_size_bytes,
+                                    device_id);
+      tables_.push_back(gpu_table);
+    }
+    return;
+  }
+#else
+  CHECK_EQ(1, device_count);
+#endif  // HAVE_CUDA
+  tables_.push_back(reinterpret_cast<const int8_t*>(host_table_.data()));
+}
+
+DateLookupTable::~DateLookupTable() {
+  for (auto& gpu_buffer : gpu_buffers_) {
+    buffer_provider_->free(gpu_buffer);
+  }
+}
+
+llvm::Value* DateLookupTable::codegen(
+    llvm::Value* date_lv,
+    Executor* executor,
+    compiler::CodegenTraitsDescriptor codegen_traits_desc) const {
+  auto cgen_state = executor->cgen_state_.get();
+  AUTOMATIC_IR_METADATA(cgen_state);
+  std::vector<std::shared_ptr<const hdk::ir::Constant>> constants_owned;
+  std::vector<const hdk::ir::Constant*> constants;
+  for (const auto table : tables_) {
+    const int64_t table_handle = reinterpret_cast<int64_t>(table);
+    const auto table_handle_literal = std::dynamic_pointer_cast<const hdk::ir::Constant>(
+        Analyzer::analyzeIntValue(table_handle));
+    CHECK(table_handle_literal);
+    constants_owned.push_back(table_handle_literal);
+    constants.push_back(table_handle_literal.get());
+  }
+  CodeGenerator code_generator(executor, codegen_traits_desc);
+  const auto table_handle_lvs =
+      code_generator.codegenHoistedConstants(constants, false, 0);
+  CHECK_EQ(size_t(1), table_handle_lvs.size());
+  return cgen_state->emitCall(
+      "date_lookup_table_get",
+      {cgen_state->castToTypeIn(date_lv, 64),
+       cgen_state->castToTypeIn(table_handle_lvs.front(), 64),
+       cgen_state->llInt(min_day_start_)});
+}
+
+bool DateLookupTable::isSupported(hdk::ir::DateExtractField field) {
+  // Fields which are a simple function of the day number are cheaper to compute.
+  switch (field) {
+    case hdk::ir::DateExtractField::kYear:
+    case hdk::ir::DateExtractField::kQuarter:
+    case hdk::ir::DateExtractField::kMonth:
+    case hdk::ir::DateExtractField::kDay:
+    case hdk::ir::DateExtractField::kDayOfYear:
+    case hdk::ir::DateExtractField::kWeek:
+    case hdk::ir::DateExtractField::kWeekSunday:
+    case hdk::ir::DateExtractField::kWeekSaturday:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool DateLookupTable::isSupported(hdk::ir::DateTruncField field) {
+  switch (field) {
+    case hdk::ir::DateTruncField::kMillennium:
+    case hdk::ir::DateTruncField::kCentury:
+    case hdk::ir::DateTruncField::kDecade:
+    case hdk::ir::DateTruncField::kYear:
+    case hdk::ir::DateTruncField::kQuarter:
+    case hdk::ir::DateTruncField::kMonth:
+      return true;
+    default:
+      return false;
+  }
+}
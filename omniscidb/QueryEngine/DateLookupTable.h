@@ -0,0 +1,63 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    DateLookupTable.h
+ * @brief   Per-query table of calendar EXTRACT / DATE_TRUNC results for dates.
+ *
+ * Calendar fields of a date depend on the day only, so for a date expression with a
+ * narrow value range the results are computed on the host once per day of the range
+ * and the kernel replaces the calendar arithmetic with a single gather.
+ **/
+
+#pragma once
+
+#include "Compiler/CodegenTraitsDescriptor.h"
+#include "DataMgr/DataMgr.h"
+#include "IR/DateTimeEnums.h"
+
+#include <llvm/IR/Value.h>
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+class Executor;
+
+class DateLookupTable {
+ public:
+  // Table of fn(day start in seconds) for days covering [min_val, max_val] seconds.
+  DateLookupTable(const int64_t min_val,
+                  const int64_t max_val,
+                  const std::function<int64_t(int64_t)>& fn,
+                  const Data_Namespace::MemoryLevel memory_level,
+                  const int device_count,
+                  BufferProvider* buffer_provider);
+  ~DateLookupTable();
+
+  // Returns the table entry for a non-null date in seconds.
+  llvm::Value* codegen(llvm::Value* date_lv,
+                       Executor* executor,
+                       compiler::CodegenTraitsDescriptor codegen_traits_desc) const;
+
+  static bool isSupported(hdk::ir::DateExtractField field);
+  static bool isSupported(hdk::ir::DateTruncField field);
+
+ private:
+  std::vector<int64_t> host_table_;
+  std::vector<Data_Namespace::AbstractBuffer*> gpu_buffers_;
+  std::vector<const int8_t*> tables_;
+  int64_t min_day_start_;
+  BufferProvider* buffer_provider_;
+};
@@ -19,7 +19,10 @@
 #include "DateTimeUtils.h"
 #include "Execute.h"
 
+#include "DateLookupTable.h"
+#include "DateTruncate.h"
 #include "DateTruncateLookupTable.h"
+#include "Utils/ExtractFromTime.h"
 
 using namespace DateTimeUtils;
 
@@ -96,6 +99,17 @@ llvm::Value* CodeGenerator::codegen(const hdk::ir::ExtractExpr* extract_expr,
     from_expr = codegenExtractHighPrecisionTimestamps(
         from_expr, extract_expr_type, extract_expr->field());
   }
+  if (DateLookupTable::isSupported(extract_field)) {
+    auto lookup_lv = codegenDateLookup(
+        extract_expr->from(),
+        from_expr,
+        [extract_field](int64_t date) { return ExtractFromTime(extract_field, date); },
+        cgen_state_->inlineIntNull(extract_expr_type),
+        co);
+    if (lookup_lv) {
+      return lookup_lv;
+    }
+  }
   if (!is_hpt && is_subsecond_extract_field(extract_expr->field())) {
     from_expr =
         !extract_expr_type->nullable()
@@ -264,6 +278,17 @@ llvm::Value* CodeGenerator::codegen(const hdk::ir::DateTruncExpr* datetrunc_expr
                                                from_expr,
                                                get_int_type(64, cgen_state_->context_));
   }
+  if (DateLookupTable::isSupported(field)) {
+    auto lookup_lv =
+        codegenDateLookup(datetrunc_expr->from(),
+                          from_expr,
+                          [field](int64_t date) { return DateTruncate(field, date); },
+                          ll_int(NULL_BIGINT, cgen_state_->context_),
+                          co);
+    if (lookup_lv) {
+      return lookup_lv;
+    }
+  }
   std::unique_ptr<CodeGenerator::NullCheckCodegen> nullcheck_codegen;
   const bool is_nullable = datetrunc_expr_type->nullable();
   if (is_nullable) {
@@ -278,6 +303,51 @@ llvm::Value* CodeGenerator::codegen(const hdk::ir::DateTruncExpr* datetrunc_expr
   return ret;
 }
 
+llvm::Value* CodeGenerator::codegenDateLookup(const hdk::ir::Expr* date_expr,
+                                              llvm::Value* date_lv,
+                                              const std::function<int64_t(int64_t)>& fn,
+                                              llvm::Value* null_lv,
+                                              const CompilationOptions& co) {
+  AUTOMATIC_IR_METADATA(cgen_state_);
+  const auto max_days = config_.exec.codegen.date_lookup_table_max_days;
+  const auto date_type = date_expr->type();
+  if (!max_days || !date_type->isDate() || !plan_state_ ||
+      plan_state_->query_infos_.empty()) {
+    return nullptr;
+  }
+  const auto date_range =
+      getExpressionRange(date_expr, plan_state_->query_infos_, executor());
+  if (date_range.getType() != ExpressionRangeType::Integer ||
+      date_range.getIntMax() < date_range.getIntMin()) {
+    return nullptr;
+  }
+  const auto min_day = floor_div(date_range.getIntMin(), kSecsPerDay);
+  const auto max_day = floor_div(date_range.getIntMax(), kSecsPerDay);
+  if (static_cast<uint64_t>(max_day - min_day) >= max_days) {
+    return nullptr;
+  }
+  auto date_lookup_table = std::make_unique<DateLookupTable>(
+      date_range.getIntMin(),
+      date_range.getIntMax(),
+      fn,
+      co.device_type == ExecutorDeviceType::GPU ? Data_Namespace::GPU_LEVEL
+                                                : Data_Namespace::CPU_LEVEL,
+      executor()->deviceCount(co.device_type),
+      executor()->getBufferProvider());
+
+  std::unique_ptr<CodeGenerator::NullCheckCodegen> nullcheck_codegen;
+  if (date_type->nullable()) {
+    nullcheck_codegen = std::make_unique<NullCheckCodegen>(
+        cgen_state_, executor(), date_lv, date_type, "date_lookup_nullcheck");
+  }
+  auto ret = cgen_state_->moveDateLookupTable(std::move(date_lookup_table))
+                 ->codegen(date_lv, executor(), co.codegen_traits_desc);
+  if (nullcheck_codegen) {
+    ret = nullcheck_codegen->finalize(null_lv, ret);
+  }
+  return ret;
+}
+
 llvm::Value* CodeGenerator::codegenExtractHighPrecisionTimestamps(
     llvm::Value* ts_lv,
     const hdk::ir::Type* type,
@@ -116,6 +116,19 @@ SUFFIX(diff_fixed_width_int_decode)(GENERIC_ADDR_SPACE const int8_t* byte_stream
   return SUFFIX(fixed_width_int_decode)(byte_stream, byte_width, pos) + baseline;
 }
 
+// Frame-of-reference encoded integers are stored as unsigned offsets from the
+// baseline. The all-ones value of the given width is reserved for nulls.
+extern "C" DEVICE ALWAYS_INLINE int64_t
+SUFFIX(frame_of_reference_int_decode)(GENERIC_ADDR_SPACE const int8_t* byte_stream,
+                                      const int32_t byte_width,
+                                      const int64_t baseline,
+                                      const int64_t null_val,
+                                      const int64_t pos) {
+  const auto val = SUFFIX(fixed_width_unsigned_decode)(byte_stream, byte_width, pos);
+  const int64_t null_code = (int64_t(1) << (byte_width * 8)) - 1;
+  return val == null_code ? null_val : val + baseline;
+}
+
 extern "C" DEVICE ALWAYS_INLINE float SUFFIX(fixed_width_float_decode)(
     GENERIC_ADDR_SPACE const int8_t* byte_stream,
     const int64_t pos) {
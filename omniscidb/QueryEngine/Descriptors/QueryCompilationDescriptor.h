@@ -35,6 +35,7 @@ struct CompilationResult {
   bool output_columnar;
   std::string llvm_ir;
   GpuSharedMemoryContext gpu_smem_context;
+  ColumnEncodings column_encodings;
 
  public:
   std::string toString() const {
@@ -69,6 +70,10 @@ class QueryCompilationDescriptor {
 
   auto getCompilationResult() const { return compilation_result_; }
 
+  const ColumnEncodings& getColumnEncodings() const {
+    return compilation_result_.column_encodings;
+  }
+
   std::string getIR() const {
     switch (compilation_device_type_) {
       case ExecutorDeviceType::CPU: {
@@ -135,7 +135,9 @@ void QueryFragmentDescriptor::buildFragmentPerKernelForTable(
                                                   frag_offsets,
                                                   i,
                                                   cgen_traits_desc);
-    if (skip_frag.first) {
+    if (skip_frag.first ||
+        (skip_frag.second == -1 && executor->skipFragmentByDictStringQuals(
+                                       table_desc, fragment, ra_exe_unit.quals))) {
       continue;
     }
     rowid_lookup_key_ = std::max(rowid_lookup_key_, skip_frag.second);
@@ -314,6 +316,11 @@ void QueryFragmentDescriptor::buildMultifragKernelMap(
                                             frag_offsets,
                                             outer_frag_id,
                                             cgen_traits_desc);
+    if (skip_frag == std::pair<bool, int64_t>(false, -1) &&
+        executor->skipFragmentByDictStringQuals(
+            outer_table_desc, fragment, ra_exe_unit.quals)) {
+      skip_frag.first = true;
+    }
     if (skip_frag == std::pair<bool, int64_t>(false, -1)) {
       skip_frag = executor->skipFragmentInnerJoins(outer_table_desc,
                                                    ra_exe_unit,
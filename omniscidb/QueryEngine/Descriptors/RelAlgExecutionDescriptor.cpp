@@ -38,7 +38,8 @@ ExecutionResult::ExecutionResult(const ExecutionResult& that)
     , filter_push_down_enabled_(that.filter_push_down_enabled_)
     , success_(true)
     , execution_time_ms_(0)
-    , type_(QueryResult) {
+    , type_(QueryResult)
+    , profile_(that.profile_) {
   if (!pushed_down_filter_info_.empty() ||
       (filter_push_down_enabled_ && pushed_down_filter_info_.empty())) {
     return;
@@ -52,7 +53,8 @@ ExecutionResult::ExecutionResult(ExecutionResult&& that)
     , filter_push_down_enabled_(std::move(that.filter_push_down_enabled_))
     , success_(true)
     , execution_time_ms_(0)
-    , type_(QueryResult) {
+    , type_(QueryResult)
+    , profile_(std::move(that.profile_)) {
   if (!pushed_down_filter_info_.empty() ||
       (filter_push_down_enabled_ && pushed_down_filter_info_.empty())) {
     return;
@@ -81,6 +83,7 @@ ExecutionResult& ExecutionResult::operator=(const ExecutionResult& that) {
   success_ = that.success_;
   execution_time_ms_ = that.execution_time_ms_;
   type_ = that.type_;
+  profile_ = that.profile_;
   return *this;
 }
 
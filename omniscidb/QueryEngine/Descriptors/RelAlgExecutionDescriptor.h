@@ -17,6 +17,7 @@
 #pragma once
 
 #include "QueryEngine/JoinFilterPushDown.h"
+#include "QueryEngine/QueryProfile.h"
 #include "ResultSet/QueryMemoryDescriptor.h"
 #include "ResultSet/ResultSet.h"
 #include "ResultSetRegistry/ResultSetRegistry.h"
@@ -66,6 +67,11 @@ class ExecutionResult {
     return {result_token_->tail(n), targets_meta_};
   }
 
+  ExecutionResult sample(size_t n, uint64_t seed) {
+    CHECK(result_token_);
+    return {result_token_->sample(n, seed), targets_meta_};
+  }
+
   const std::vector<TargetMetaInfo>& getTargetsMeta() const { return targets_meta_; }
 
   const std::vector<PushedDownFilterInfo>& getPushedDownFilterInfo() const;
@@ -95,6 +101,9 @@ class ExecutionResult {
   void addExecutionTime(int64_t execution_time_ms) {
     execution_time_ms_ += execution_time_ms;
   }
+  // Null unless the query was executed with ExecutionOptions::with_profile.
+  QueryProfilePtr getProfile() const { return profile_; }
+  void setProfile(QueryProfilePtr profile) { profile_ = std::move(profile); }
 
  private:
   hdk::ResultSetTableTokenPtr result_token_;
@@ -107,6 +116,7 @@ class ExecutionResult {
   bool success_;
   uint64_t execution_time_ms_;
   RType type_;
+  QueryProfilePtr profile_;
 };
 
 namespace hdk::ir {
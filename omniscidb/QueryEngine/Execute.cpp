@@ -27,10 +27,12 @@
 #ifdef HAVE_CUDA
 #include <cuda.h>
 #endif  // HAVE_CUDA
+#include <algorithm>
 #include <chrono>
 #include <ctime>
 #include <future>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <numeric>
@@ -39,6 +41,8 @@
 #include "CudaMgr/CudaMgr.h"
 #include "DataMgr/BufferMgr/BufferMgr.h"
 #include "DataProvider/DictDescriptor.h"
+#include "IR/ExprRewriter.h"
+#include "Logger/Trace.h"
 #include "OSDependent/omnisci_path.h"
 #include "QueryEngine/AggregateUtils.h"
 #include "QueryEngine/AggregatedColRange.h"
@@ -47,6 +51,7 @@
 #include "QueryEngine/CostModel/Dispatchers/DefaultExecutionPolicy.h"
 #include "QueryEngine/CostModel/Dispatchers/ProportionBasedExecutionPolicy.h"
 #include "QueryEngine/CostModel/Dispatchers/RRExecutionPolicy.h"
+#include "QueryEngine/DataRecycler/ResultSetRecycler.h"
 #include "QueryEngine/Descriptors/QueryCompilationDescriptor.h"
 #include "QueryEngine/Descriptors/QueryFragmentDescriptor.h"
 #include "QueryEngine/DynamicWatchdog.h"
@@ -62,13 +67,16 @@
 #include "QueryEngine/JsonAccessors.h"
 #include "QueryEngine/OutputBufferInitialization.h"
 #include "QueryEngine/QueryRewrite.h"
+#include "QueryEngine/QueryScheduler.h"
 #include "QueryEngine/QueryTemplateGenerator.h"
 #include "QueryEngine/ResultSetReduction.h"
 #include "QueryEngine/ResultSetReductionJIT.h"
 #include "QueryEngine/RuntimeFunctions.h"
+#include "QueryEngine/SharedScans.h"
 #include "QueryEngine/SpeculativeTopN.h"
 #include "QueryEngine/StringDictionaryGenerations.h"
 #include "QueryEngine/Visitors/TransientStringLiteralsVisitor.h"
+#include "ResultSetRegistry/ResultSetRegistry.h"
 #include "Shared/checked_alloc.h"
 #include "Shared/funcannotations.h"
 #include "Shared/measure.h"
@@ -110,6 +118,9 @@ std::unique_ptr<CodeCacheAccessor<CpuCompilationContext>> Executor::s_code_acces
 std::unique_ptr<CodeCacheAccessor<CpuCompilationContext>> Executor::cpu_code_accessor;
 std::unique_ptr<CodeCacheAccessor<CompilationContext>> Executor::gpu_code_accessor;
 size_t Executor::code_cache_size;
+size_t Executor::gpu_code_cache_max_bytes;
+std::unique_ptr<PersistentCodeCache> Executor::persistent_code_cache;
+std::unique_ptr<L0BinaryCache> Executor::l0_binary_cache;
 namespace {
 
 void init_code_caches() {
@@ -122,6 +133,7 @@ void init_code_caches() {
           Executor::code_cache_size, "cpu_code_cache");
   Executor::gpu_code_accessor = std::make_unique<CodeCacheAccessor<CompilationContext>>(
       Executor::code_cache_size, "gpu_code_cache");
+  Executor::gpu_code_accessor->setMaxBytes(Executor::gpu_code_cache_max_bytes);
 }
 
 }  // namespace
@@ -163,19 +175,40 @@ Executor::Executor(const ExecutorId executor_id,
   extension_module_context_ = std::make_unique<ExtensionModuleContext>();
   cgen_state_ = std::make_unique<CgenState>(
       0, false, false, extension_module_context_.get(), getContext());
+  result_set_recycler_ = std::make_unique<ResultSetRecycler>(config_);
 
   std::call_once(first_init_flag_, [this]() {
     query_plan_dag_cache_ =
         std::make_unique<QueryPlanDagCache>(config_->cache.dag_cache_size);
     code_cache_size = config_->cache.code_cache_size;
+    gpu_code_cache_max_bytes = config_->cache.gpu_code_cache_max_bytes;
     init_code_caches();
+    if (!config_->cache.persistent_code_cache_dir.empty()) {
+      persistent_code_cache = std::make_unique<PersistentCodeCache>(
+          config_->cache.persistent_code_cache_dir);
+    }
+#ifdef HAVE_L0
+    std::string l0_cache_dir;
+    if (!config_->cache.persistent_code_cache_dir.empty()) {
+      l0_cache_dir =
+          (boost::filesystem::path(config_->cache.persistent_code_cache_dir) / "l0")
+              .string();
+    }
+    l0_binary_cache = std::make_unique<L0BinaryCache>(l0_cache_dir);
+#endif
   });
   Executor::initialize_extension_module_sources();
   update_extension_modules();
 
   if (config_->exec.enable_cost_model) {
     try {
-      cost_model = std::make_shared<costmodel::IterativeCostModel>();
+      if (config_->exec.enable_cost_model_runtime_measurements) {
+        cost_model = std::make_shared<costmodel::IterativeCostModel>(
+            costmodel::CostModelConfig{std::make_unique<costmodel::RuntimeDataSource>()});
+      } else {
+        cost_model = std::make_shared<costmodel::IterativeCostModel>(
+            config_->cache.cost_model_calibration_file);
+      }
       cost_model->calibrate({{ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}});
     } catch (costmodel::CostModelException& e) {
       LOG(DEBUG1) << "Cost model will be disabled due to creation error: " << e.what();
@@ -183,6 +216,31 @@ Executor::Executor(const ExecutorId executor_id,
   }
 }
 
+Executor::~Executor() {
+  // Background compilations refer to the executor's LLVM context and configuration.
+  async_compilation_tasks_.wait();
+}
+
+bool Executor::scheduleAsyncCompilation(const CodeCacheKey& key,
+                                        std::function<void()> compile) {
+  {
+    std::lock_guard<std::mutex> lock(async_compilation_mutex_);
+    if (!async_compilation_keys_.insert(key).second) {
+      return false;
+    }
+  }
+  async_compilation_tasks_.run([this, key, compile = std::move(compile)]() {
+    try {
+      compile();
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Background compilation failed: " << e.what();
+    }
+    std::lock_guard<std::mutex> lock(async_compilation_mutex_);
+    async_compilation_keys_.erase(key);
+  });
+  return true;
+}
+
 std::shared_ptr<costmodel::CostModel> Executor::getCostModel() {
   return cost_model;
 }
@@ -374,9 +432,9 @@ Executor::CgenStateManager::~CgenStateManager() {
   }
   executor_.cgen_state_->row_func_hoisted_literals_.clear();
 
-  // move generated StringDictionaryTranslationMgrs and InValueBitmaps
-  // to the old CgenState instance as the execution of the generated
-  // code uses these bitmaps
+  // move generated StringDictionaryTranslationMgrs, InValueBitmaps and
+  // DateLookupTables to the old CgenState instance as the execution of the
+  // generated code uses these bitmaps
 
   for (auto& str_dict_translation_mgr :
        executor_.cgen_state_->str_dict_translation_mgrs_) {
@@ -389,6 +447,11 @@ Executor::CgenStateManager::~CgenStateManager() {
   }
   executor_.cgen_state_->in_values_bitmaps_.clear();
 
+  for (auto& date_lookup_table : executor_.cgen_state_->date_lookup_tables_) {
+    cgen_state_->moveDateLookupTable(std::move(date_lookup_table));
+  }
+  executor_.cgen_state_->date_lookup_tables_.clear();
+
   // restore the old CgenState instance
   executor_.cgen_state_.reset(cgen_state_.release());
 }
@@ -1110,8 +1173,14 @@ hdk::ResultSetTable get_separate_results(
     std::vector<std::pair<ResultSetPtr, std::vector<size_t>>>& results_per_device) {
   std::vector<ResultSetPtr> results;
   results.reserve(results_per_device.size());
+  // Empty kernel results would only add fragments for the following steps to skip.
   for (auto& r : results_per_device) {
-    results.emplace_back(r.first);
+    if (!r.first->definitelyHasNoRows()) {
+      results.emplace_back(r.first);
+    }
+  }
+  if (results.empty()) {
+    results.emplace_back(results_per_device.front().first);
   }
   return hdk::ResultSetTable(std::move(results));
 }
@@ -1124,6 +1193,8 @@ hdk::ResultSetTable Executor::resultsUnion(SharedKernelContext& shared_context,
                                            bool sort_by_table_id,
                                            const std::map<int, size_t>& order_map) {
   auto timer = DEBUG_TIMER(__func__);
+  QueryProfileTimer profile_timer(query_profile_, &QueryProfile::addReductionTime);
+  trace::Scope reduction_trace("reduction", "reduction");
   auto& results_per_device = shared_context.getFragmentResults();
   if (results_per_device.empty()) {
     std::vector<TargetInfo> targets;
@@ -1289,7 +1360,43 @@ ResultSetPtr Executor::reduceMultiDeviceResultSets(
   const auto reduction_code = get_reduction_code(
       getConfig(), results_per_device, &compilation_queue_time, this, co);
 
-  if (couldUseParallelReduce(query_mem_desc)) {
+  // Results initialized on the first touch are reduced by their occupancy bitmaps,
+  // which cannot be shared by partitions.
+  const bool has_first_touch_init =
+      std::any_of(results_per_device.begin(),
+                  results_per_device.end(),
+                  [](const std::pair<ResultSetPtr, std::vector<size_t>>& rs) {
+                    return rs.first->getStorage() &&
+                           rs.first->getStorage()->hasFirstTouchInit();
+                  });
+  const auto& group_by_config = getConfig().exec.group_by;
+  if (query_mem_desc.getQueryDescriptionType() ==
+          QueryDescriptionType::GroupByPerfectHash &&
+      !has_first_touch_init && group_by_config.enable_partitioned_reduction &&
+      query_mem_desc.getEntryCount() >= group_by_config.partitioned_reduction_threshold &&
+      results_per_device.size() > 1) {
+    // Perfect hash buffers have no collisions, so the entry range is split into
+    // partitions and each partition is reduced over all the results by a single
+    // task. Tasks never touch the same entries and each entry is written once
+    // per input result, unlike in the pairwise tree reduction.
+    const auto result_storage = reduced_results->getStorage();
+    CHECK(result_storage);
+    threading::parallel_for(
+        threading::blocked_range<size_t>(
+            0, result_storage->getQueryMemDesc().getEntryCount()),
+        [&](auto r) {
+          for (size_t i = 1; i < results_per_device.size(); ++i) {
+            const auto that_storage = results_per_device[i].first->getStorage();
+            ResultSetReduction::reduceEntries(*result_storage,
+                                              *that_storage,
+                                              r.begin(),
+                                              r.end(),
+                                              {},
+                                              reduction_code,
+                                              this);
+          }
+        });
+  } else if (couldUseParallelReduce(query_mem_desc)) {
     std::vector<ResultSetStorage*> storages;
     for (auto& rs : results_per_device) {
       storages.push_back(const_cast<ResultSetStorage*>(rs.first->getStorage()));
@@ -1329,6 +1436,9 @@ ResultSetPtr Executor::reduceMultiDeviceResultSets(
                                  this);
     }
   }
+  if (reduced_results->getStorage()) {
+    reduced_results->getStorage()->finalizeFirstTouchInit();
+  }
   reduced_results->addCompilationQueueTime(compilation_queue_time);
   return reduced_results;
 }
@@ -1338,6 +1448,11 @@ ResultSetPtr Executor::reduceSpeculativeTopN(
     std::vector<std::pair<ResultSetPtr, std::vector<size_t>>>& results_per_device,
     std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner,
     const QueryMemoryDescriptor& query_mem_desc) const {
+  for (const auto& result : results_per_device) {
+    if (result.first && result.first->getStorage()) {
+      result.first->getStorage()->finalizeFirstTouchInit();
+    }
+  }
   if (results_per_device.size() == 1) {
     return std::move(results_per_device.front().first);
   }
@@ -1408,6 +1523,23 @@ size_t compute_buffer_entry_guess(const std::vector<InputTableInfo>& query_infos
   }
 }
 
+// Returns the group-by buffer entry guess to re-run a GPU baseline hash group by which
+// ran out of slots with, or zero if the buffer can't grow any more. The number of
+// groups is bounded by the number of rows in the biggest input table, unless joins
+// multiply rows, in which case the regular out-of-slots handling takes over.
+size_t grown_gpu_groupby_entry_guess(const size_t entry_guess,
+                                     const std::vector<InputTableInfo>& query_infos) {
+  size_t max_num_groups = 1;
+  for (const auto& query_info : query_infos) {
+    max_num_groups = std::max(max_num_groups, query_info.info.getNumTuplesUpperBound());
+  }
+  // Entry count is passed to the hash table probing as a 32-bit value.
+  max_num_groups = std::min(
+      max_num_groups, static_cast<size_t>(std::numeric_limits<int32_t>::max()));
+  const auto grown_guess = std::min(entry_guess * 2, max_num_groups);
+  return grown_guess > entry_guess ? grown_guess : 0;
+}
+
 std::string get_table_name(const InputDescriptor& input_desc,
                            const SchemaProvider& schema_provider) {
   const auto tinfo =
@@ -1644,7 +1776,150 @@ RelAlgExecutionUnit replace_scan_limit(const RelAlgExecutionUnit& ra_exe_unit_in
           ra_exe_unit_in.table_id_to_node_map,
           ra_exe_unit_in.union_all,
           ra_exe_unit_in.cost_model,
-          ra_exe_unit_in.templs};
+          ra_exe_unit_in.templs,
+          ra_exe_unit_in.features};
+}
+
+// Makes columns of the outer table, which have no nulls in any fragment, non-nullable,
+// so operations over them are generated without null checks.
+class NonNullColumnRewriter : public hdk::ir::ExprRewriter {
+ public:
+  NonNullColumnRewriter(const InputDescriptor& outer_desc,
+                        const InputTableInfo& outer_info)
+      : outer_desc_(outer_desc), outer_info_(outer_info) {}
+
+ protected:
+  hdk::ir::ExprPtr visitColumnVar(const hdk::ir::ColumnVar* col_var) override {
+    const auto type = col_var->type();
+    if (col_var->rteIdx() || col_var->tableId() != outer_desc_.getTableId() ||
+        !type->nullable() ||
+        !(type->isNumber() || type->isBoolean() || type->isDateTime())) {
+      return defaultResult(col_var);
+    }
+    auto it = has_nulls_.find(col_var->columnId());
+    if (it == has_nulls_.end()) {
+      it = has_nulls_.emplace(col_var->columnId(), hasNulls(col_var->columnId())).first;
+    }
+    return it->second ? defaultResult(col_var)
+                      : col_var->withType(type->withNullable(false));
+  }
+
+ private:
+  bool hasNulls(int col_id) const {
+    for (const auto& fragment : outer_info_.info.fragments) {
+      const auto& chunk_metadata = fragment.getChunkMetadataMap();
+      auto chunk_meta_it = chunk_metadata.find(col_id);
+      if (chunk_meta_it == chunk_metadata.end() ||
+          chunk_meta_it->second->chunkStats().has_nulls) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  const InputDescriptor& outer_desc_;
+  const InputTableInfo& outer_info_;
+  std::unordered_map<int, bool> has_nulls_;
+};
+
+// Drop null checks for columns without nulls from filters. Nullability of group keys
+// and targets defines the output, e.g. SUM of no rows is NULL only for a nullable
+// argument, so they are not rewritten.
+RelAlgExecutionUnit drop_null_checks_in_quals(const RelAlgExecutionUnit& ra_exe_unit_in,
+                                              const std::vector<InputTableInfo>& infos) {
+  if (ra_exe_unit_in.input_descs.empty() || infos.empty() || ra_exe_unit_in.union_all) {
+    return ra_exe_unit_in;
+  }
+  NonNullColumnRewriter rewriter(ra_exe_unit_in.input_descs.front(), infos.front());
+  auto rewrite_quals = [&rewriter](const std::list<hdk::ir::ExprPtr>& quals) {
+    std::list<hdk::ir::ExprPtr> res;
+    for (const auto& qual : quals) {
+      res.push_back(rewriter.visit(qual.get()));
+    }
+    return res;
+  };
+  return {ra_exe_unit_in.input_descs,
+          ra_exe_unit_in.input_col_descs,
+          rewrite_quals(ra_exe_unit_in.simple_quals),
+          rewrite_quals(ra_exe_unit_in.quals),
+          ra_exe_unit_in.join_quals,
+          ra_exe_unit_in.groupby_exprs,
+          ra_exe_unit_in.target_exprs,
+          ra_exe_unit_in.estimator,
+          ra_exe_unit_in.sort_info,
+          ra_exe_unit_in.scan_limit,
+          ra_exe_unit_in.query_plan_dag,
+          ra_exe_unit_in.hash_table_build_plan_dag,
+          ra_exe_unit_in.table_id_to_node_map,
+          ra_exe_unit_in.union_all,
+          ra_exe_unit_in.cost_model,
+          ra_exe_unit_in.templs,
+          ra_exe_unit_in.features};
+}
+
+// Uniform value in [0, 1) of a fragment, the same for the same seed.
+double fragment_sample_point(const uint64_t seed,
+                             const int table_id,
+                             const size_t frag_idx) {
+  // splitmix64 finalizer
+  uint64_t x = seed ^ (static_cast<uint64_t>(table_id) << 32) ^ frag_idx;
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return static_cast<double>(x >> 11) / static_cast<double>(uint64_t(1) << 53);
+}
+
+// Picks outer fragments of a sampled query with the probability of the sample rate
+// and restricts the execution to them. Returns the ratio of all outer rows to the
+// sampled ones, which SUM and COUNT aggregates are scaled with, or nothing if the
+// query is not sampled. Results of previous steps are not sampled again.
+std::optional<double> sample_outer_fragments(const RelAlgExecutionUnit& ra_exe_unit,
+                                             const std::vector<InputTableInfo>& infos,
+                                             ExecutionOptions& eo) {
+  if (eo.sample_rate >= 1.0 || ra_exe_unit.input_descs.empty() || infos.empty() ||
+      ra_exe_unit.union_all || ra_exe_unit.estimator ||
+      infos.front().db_id == hdk::ResultSetRegistry::DB_ID) {
+    return std::nullopt;
+  }
+  const auto& fragments = infos.front().info.fragments;
+  auto candidates = eo.outer_fragment_indices;
+  if (candidates.empty()) {
+    candidates.resize(fragments.size());
+    std::iota(candidates.begin(), candidates.end(), size_t(0));
+  }
+  if (candidates.size() < 2) {
+    return std::nullopt;
+  }
+  std::vector<size_t> sampled;
+  size_t total_rows = 0;
+  size_t sampled_rows = 0;
+  size_t first_frag_idx = candidates.front();
+  double first_point = 1.0;
+  for (const auto frag_idx : candidates) {
+    CHECK_LT(frag_idx, fragments.size());
+    const auto rows = fragments[frag_idx].getNumTuples();
+    const auto point =
+        fragment_sample_point(eo.sample_seed, infos.front().table_id, frag_idx);
+    total_rows += rows;
+    if (point < eo.sample_rate) {
+      sampled.push_back(frag_idx);
+      sampled_rows += rows;
+    }
+    if (point < first_point) {
+      first_point = point;
+      first_frag_idx = frag_idx;
+    }
+  }
+  // Keep at least one fragment, an empty sample estimates nothing.
+  if (sampled.empty()) {
+    sampled.push_back(first_frag_idx);
+    sampled_rows = fragments[first_frag_idx].getNumTuples();
+  }
+  VLOG(1) << "Sampled " << sampled.size() << " of " << candidates.size()
+          << " outer fragments, " << sampled_rows << " of " << total_rows << " rows.";
+  eo.outer_fragment_indices = std::move(sampled);
+  return sampled_rows ? static_cast<double>(total_rows) / sampled_rows : 1.0;
 }
 
 }  // namespace
@@ -1653,13 +1928,29 @@ hdk::ResultSetTable Executor::executeWorkUnit(
     size_t& max_groups_buffer_entry_guess,
     const bool is_agg,
     const std::vector<InputTableInfo>& query_infos,
-    const RelAlgExecutionUnit& ra_exe_unit_in,
+    const RelAlgExecutionUnit& ra_exe_unit_orig,
     const CompilationOptions& co,
-    const ExecutionOptions& eo,
+    const ExecutionOptions& eo_in,
     const bool has_cardinality_estimation,
     DataProvider* data_provider,
     ColumnCacheMap& column_cache) {
+  std::optional<RelAlgExecutionUnit> ra_exe_unit_rewritten;
+  if (config_->exec.codegen.enable_stats_null_check_elimination) {
+    ra_exe_unit_rewritten.emplace(
+        drop_null_checks_in_quals(ra_exe_unit_orig, query_infos));
+  }
+  const auto& ra_exe_unit_in =
+      ra_exe_unit_rewritten ? *ra_exe_unit_rewritten : ra_exe_unit_orig;
   VLOG(1) << "Executor " << executor_id_ << " is executing work unit:" << ra_exe_unit_in;
+  auto eo = eo_in;
+  const auto sample_scale = sample_outer_fragments(ra_exe_unit_in, query_infos, eo);
+  auto scale_sampled_aggregates = [&sample_scale](hdk::ResultSetTable& result) {
+    if (sample_scale) {
+      for (const auto& rs : result.results()) {
+        rs->scaleAggregates(*sample_scale);
+      }
+    }
+  };
 
   ScopeGuard cleanup_post_execution = [this] {
     // cleanup/unpin GPU buffer allocations
@@ -1667,6 +1958,7 @@ hdk::ResultSetTable Executor::executeWorkUnit(
     plan_state_.reset(nullptr);
     if (cgen_state_) {
       cgen_state_->in_values_bitmaps_.clear();
+      cgen_state_->date_lookup_tables_.clear();
     }
   };
 
@@ -1687,6 +1979,7 @@ hdk::ResultSetTable Executor::executeWorkUnit(
     if (eo.just_validate) {
       result.setValidationOnlyRes();
     }
+    scale_sampled_aggregates(result);
     return result;
   } catch (const CompilationRetryNewScanLimit& e) {
     auto result =
@@ -1706,6 +1999,7 @@ hdk::ResultSetTable Executor::executeWorkUnit(
     if (eo.just_validate) {
       result.setValidationOnlyRes();
     }
+    scale_sampled_aggregates(result);
     return result;
   }
 }
@@ -1715,6 +2009,7 @@ std::shared_ptr<StreamExecutionContext> Executor::prepareStreamingExecution(
     const CompilationOptions& co,
     const ExecutionOptions& eo,
     const std::vector<InputTableInfo>& query_infos,
+    const size_t max_groups_buffer_entry_guess,
     DataProvider* data_provider,
     ColumnCacheMap& column_cache) {
   const auto device_type = getDeviceTypeForTargets(ra_exe_unit, co.device_type);
@@ -1728,7 +2023,7 @@ std::shared_ptr<StreamExecutionContext> Executor::prepareStreamingExecution(
   auto column_fetcher =
       std::make_unique<ColumnFetcher>(this, data_provider, column_cache);
 
-  query_mem_desc_owned = query_comp_desc_owned->compile(-1,
+  query_mem_desc_owned = query_comp_desc_owned->compile(max_groups_buffer_entry_guess,
                                                         crt_min_byte_width,
                                                         false,
                                                         ra_exe_unit,
@@ -1758,14 +2053,29 @@ std::shared_ptr<StreamExecutionContext> Executor::prepareStreamingExecution(
   ctx->shared_context = std::make_unique<SharedKernelContext>(query_infos);
 
   ctx->co.device_type = device_type;
+  ctx->plan_state = std::move(plan_state_);
+  ctx->cgen_state = std::move(cgen_state_);
+  ctx->row_set_mem_owner = row_set_mem_owner_;
 
   return ctx;
 }
 
+ScopeGuard Executor::installStreamExecutionState(StreamExecutionContext& ctx) {
+  std::swap(plan_state_, ctx.plan_state);
+  std::swap(cgen_state_, ctx.cgen_state);
+  std::swap(row_set_mem_owner_, ctx.row_set_mem_owner);
+  return [this, &ctx] {
+    std::swap(plan_state_, ctx.plan_state);
+    std::swap(cgen_state_, ctx.cgen_state);
+    std::swap(row_set_mem_owner_, ctx.row_set_mem_owner);
+  };
+}
+
 ResultSetPtr Executor::runOnBatch(std::shared_ptr<StreamExecutionContext> ctx,
                                   const FragmentsList& fragments) {
   // TODO: get rid of multifragment case
   CHECK(fragments.size() == 1);
+  auto state_guard = installStreamExecutionState(*ctx);
   auto query_mem_desc = *ctx->query_mem_desc;
 
   if (query_mem_desc.getQueryDescriptionType() == QueryDescriptionType::Projection) {
@@ -1799,25 +2109,25 @@ ResultSetPtr Executor::runOnBatch(std::shared_ptr<StreamExecutionContext> ctx,
   return nullptr;
 }
 
-hdk::ResultSetTable Executor::finishStreamExecution(
+hdk::ResultSetTable Executor::pollStreamExecution(
     std::shared_ptr<StreamExecutionContext> ctx) {
-  for (auto& exec_ctx : ctx->shared_context->getTlsExecutionContext()) {
-    if (exec_ctx) {
-      CHECK(!ctx->ra_exe_unit.estimator);
-      auto results =
-          exec_ctx->getRowSet(ctx->ra_exe_unit, exec_ctx->query_mem_desc_, ctx->co);
-      ctx->shared_context->addDeviceResults(std::move(results), 0, {});
-    }
-  }
-
+  auto state_guard = installStreamExecutionState(*ctx);
+  auto& results = ctx->shared_context->getFragmentResults();
   if (ctx->is_agg) {
+    const bool has_new_batches = !results.empty();
+    // Results of new batches go first and are reduced into, so the aggregate
+    // returned by the previous poll is not modified.
+    if (ctx->running_result) {
+      results.emplace_back(ctx->running_result, std::vector<size_t>{});
+    }
+    ResultSetPtr reduced;
     try {
-      return collectAllDeviceResults(*ctx->shared_context,
-                                     ctx->ra_exe_unit,
-                                     *ctx->query_mem_desc,
-                                     ctx->query_comp_desc->getDeviceType(),
-                                     row_set_mem_owner_,
-                                     ctx->co);
+      reduced = collectAllDeviceResults(*ctx->shared_context,
+                                        ctx->ra_exe_unit,
+                                        *ctx->query_mem_desc,
+                                        ctx->query_comp_desc->getDeviceType(),
+                                        row_set_mem_owner_,
+                                        ctx->co);
     } catch (ReductionRanOutOfSlots&) {
       throw QueryExecutionError(ERR_OUT_OF_SLOTS);
     } catch (QueryExecutionError& e) {
@@ -1825,6 +2135,13 @@ hdk::ResultSetTable Executor::finishStreamExecution(
               << ", what(): " << e.what();
       throw QueryExecutionError(e.getErrorCode());
     }
+    results.clear();
+    if (has_new_batches) {
+      ctx->running_result = reduced;
+    }
+    // The aggregate might have been iterated by the consumer of the previous poll.
+    reduced->moveToBegin();
+    return reduced;
   }
 
   std::map<int, size_t> order_map;
@@ -1838,9 +2155,26 @@ hdk::ResultSetTable Executor::finishStreamExecution(
                              true,  // always merge for now
                              ctx->eo.preserve_order,
                              order_map);
+  results.clear();
   return result;
 }
 
+hdk::ResultSetTable Executor::finishStreamExecution(
+    std::shared_ptr<StreamExecutionContext> ctx) {
+  {
+    auto state_guard = installStreamExecutionState(*ctx);
+    for (auto& exec_ctx : ctx->shared_context->getTlsExecutionContext()) {
+      if (exec_ctx) {
+        CHECK(!ctx->ra_exe_unit.estimator);
+        auto results =
+            exec_ctx->getRowSet(ctx->ra_exe_unit, exec_ctx->query_mem_desc_, ctx->co);
+        ctx->shared_context->addDeviceResults(std::move(results), 0, {});
+      }
+    }
+  }
+  return pollStreamExecution(ctx);
+}
+
 std::pair<std::unique_ptr<policy::ExecutionPolicy>, ExecutorDeviceType>
 Executor::getExecutionPolicyForTargets(const RelAlgExecutionUnit& ra_exe_unit,
                                        const ExecutorDeviceType requested_device_type,
@@ -1884,7 +2218,7 @@ Executor::getExecutionPolicyForTargets(const RelAlgExecutionUnit& ra_exe_unit,
     LOG(DEBUG1) << "Cost Model enabled, making prediction for templates "
                 << toString(ra_exe_unit.templs) << " for size " << bytes;
 
-    costmodel::QueryInfo qi = {ra_exe_unit.templs, bytes};
+    costmodel::QueryInfo qi = {ra_exe_unit.templs, bytes, ra_exe_unit.features};
 
     try {
       exe_policy = ra_exe_unit.cost_model->predict(qi);
@@ -1936,6 +2270,7 @@ hdk::ResultSetTable Executor::executeWorkUnitImpl(
       ra_exe_unit, co.device_type, query_infos, max_groups_buffer_entry_guess);
 
   int8_t crt_min_byte_width{MAX_BYTE_WIDTH_SUPPORTED};
+  size_t gpu_groupby_buffer_growths{0};
   do {
     SharedKernelContext shared_context(query_infos);
     ColumnFetcher column_fetcher(this, data_provider, column_cache);
@@ -1954,6 +2289,9 @@ hdk::ResultSetTable Executor::executeWorkUnitImpl(
       if (eo.executor_type == ExecutorType::Native) {
         try {
           INJECT_TIMER(query_step_compilation);
+          QueryProfileTimer profile_timer(query_profile_,
+                                          &QueryProfile::addCompilationTime);
+          trace::Scope compilation_trace("compilation", "compilation");
           query_mem_desc_owned =
               query_comp_desc_owned->compile(max_groups_buffer_entry_guess,
                                              crt_min_byte_width,
@@ -1993,15 +2331,35 @@ hdk::ResultSetTable Executor::executeWorkUnitImpl(
       return {executeExplain(*query_comp_descs_owned.at(fallback_device))};
     }
 
+    if (is_agg && config_->exec.group_by.enable_streaming_reduction &&
+        !config_->exec.heterogeneous.enable_heterogeneous_execution &&
+        !ra_exe_unit.estimator &&
+        query_mem_descs_owned.at(fallback_device)->getQueryDescriptionType() ==
+            QueryDescriptionType::GroupByPerfectHash) {
+      shared_context.enableStreamingReduction(this);
+    }
+
+    if (config_->exec.enable_limit_early_termination && !is_agg &&
+        ra_exe_unit.sort_info.limit && ra_exe_unit.sort_info.order_entries.empty() &&
+        !ra_exe_unit.union_all && !ra_exe_unit.estimator &&
+        query_mem_descs_owned.at(fallback_device)->getQueryDescriptionType() ==
+            QueryDescriptionType::Projection) {
+      shared_context.setRowLimit(ra_exe_unit.sort_info.limit +
+                                 ra_exe_unit.sort_info.offset);
+    }
+
     for (const auto target_expr : ra_exe_unit.target_exprs) {
       plan_state_->target_exprs_.push_back(target_expr);
     }
 
+    bool kernels_retried_on_cpu = false;
     if (!eo.just_validate) {
       int available_cpus = cpu_threads();
       auto available_gpus = get_available_gpus(data_mgr_);
 
       try {
+        // Declared before kernels, which refer to them.
+        std::vector<std::unique_ptr<QueryCompilationDescriptor>> filter_variants;
         std::vector<std::unique_ptr<ExecutionKernel>> kernels;
         if (config_->exec.heterogeneous.enable_heterogeneous_execution) {
           kernels = createHeterogeneousKernels(shared_context,
@@ -2031,8 +2389,83 @@ hdk::ResultSetTable Executor::executeWorkUnitImpl(
                                   exe_policy.get(),
                                   available_gpus,
                                   available_cpus);
+          if (config_->exec.enable_fragment_qual_elimination &&
+              eo.executor_type == ExecutorType::Native) {
+            specializeKernelsByFragmentStats(kernels,
+                                             ra_exe_unit,
+                                             query_infos,
+                                             column_fetcher,
+                                             co,
+                                             eo,
+                                             *query_comp_descs_owned.at(fallback_device),
+                                             *query_mem_descs_owned.at(fallback_device),
+                                             max_groups_buffer_entry_guess,
+                                             crt_min_byte_width,
+                                             has_cardinality_estimation,
+                                             filter_variants);
+          }
+        }
+        SharedScanPtr shared_scan;
+        if (config_->exec.scheduler.enable_shared_scans &&
+            !shared_context.hasRowLimit()) {
+          shared_scan = join_shared_scan(
+              kernels, ra_exe_unit, config_->exec.scheduler.shared_scan_window_ms);
+          shared_context.setSharedScan(shared_scan.get());
+        }
+        ScopeGuard reset_shared_scan = [&shared_context] {
+          shared_context.setSharedScan(nullptr);
+        };
+        // Reserve output buffers of concurrently running kernels.
+        const size_t concurrent_kernels =
+            std::min(kernels.size(),
+                     fallback_device == ExecutorDeviceType::GPU
+                         ? std::max(available_gpus.size(), size_t(1))
+                         : static_cast<size_t>(std::max(available_cpus, 1)));
+        const auto& query_mem_desc = *query_mem_descs_owned.at(fallback_device);
+        const size_t memory_reservation =
+            concurrent_kernels * query_mem_desc.getBufferSizeBytes(fallback_device);
+        if (config_->exec.heterogeneous.enable_heterogeneous_execution &&
+            config_->exec.heterogeneous.enable_work_stealing) {
+          launchHeterogeneousKernels(shared_context,
+                                     std::move(kernels),
+                                     fallback_device,
+                                     eo,
+                                     memory_reservation,
+                                     query_comp_descs_owned,
+                                     query_mem_descs_owned);
+        } else {
+          if (fallback_device == ExecutorDeviceType::GPU &&
+              config_->exec.heterogeneous.allow_cpu_retry &&
+              config_->exec.heterogeneous.allow_kernel_cpu_retry &&
+              eo.executor_type == ExecutorType::Native && !ra_exe_unit.estimator &&
+              !shared_context.hasStreamingReduction()) {
+            shared_context.enableCpuRetry();
+          }
+          launchKernels(shared_context,
+                        std::move(kernels),
+                        fallback_device,
+                        co,
+                        eo,
+                        memory_reservation);
+          // The kernels are still owned by `kernels`, so retried kernels can refer to
+          // them.
+          auto retry_kernels = shared_context.takeCpuRetryKernels();
+          if (!retry_kernels.empty()) {
+            retryKernelsOnCpu(shared_context,
+                              retry_kernels,
+                              ra_exe_unit,
+                              query_infos,
+                              column_fetcher,
+                              co,
+                              eo,
+                              max_groups_buffer_entry_guess,
+                              crt_min_byte_width,
+                              has_cardinality_estimation,
+                              query_comp_descs_owned,
+                              query_mem_descs_owned);
+            kernels_retried_on_cpu = true;
+          }
         }
-        launchKernels(shared_context, std::move(kernels), fallback_device, co);
       } catch (QueryExecutionError& e) {
         if (eo.with_dynamic_watchdog && interrupted_.load() &&
             e.getErrorCode() == ERR_OUT_OF_TIME) {
@@ -2046,13 +2479,34 @@ hdk::ResultSetTable Executor::executeWorkUnitImpl(
           crt_min_byte_width <<= 1;
           continue;
         }
+        // A GPU baseline hash group by ran out of slots because the number of groups
+        // was underestimated. Grow the buffer and run the step on GPU again instead of
+        // falling back to the estimator and CPU execution.
+        if (e.getErrorCode() < 0 && fallback_device == ExecutorDeviceType::GPU &&
+            query_mem_descs_owned.at(fallback_device)->getQueryDescriptionType() ==
+                QueryDescriptionType::GroupByBaselineHash &&
+            !config_->exec.watchdog.enable &&
+            gpu_groupby_buffer_growths <
+                config_->exec.group_by.gpu_groupby_buffer_max_growths) {
+          const auto grown_guess =
+              grown_gpu_groupby_entry_guess(max_groups_buffer_entry_guess, query_infos);
+          if (grown_guess) {
+            LOG(INFO) << "GPU group by ran out of slots, retrying on GPU with "
+                      << grown_guess << " entries instead of "
+                      << max_groups_buffer_entry_guess;
+            max_groups_buffer_entry_guess = grown_guess;
+            ++gpu_groupby_buffer_growths;
+            continue;
+          }
+        }
         throw;
       }
     }
     if (is_agg) {
       try {
         ExecutorDeviceType reduction_device_type = ExecutorDeviceType::CPU;
-        if (!config_->exec.heterogeneous.enable_heterogeneous_execution) {
+        if (!config_->exec.heterogeneous.enable_heterogeneous_execution &&
+            !kernels_retried_on_cpu) {
           reduction_device_type = fallback_device;
         }
         return collectAllDeviceResults(shared_context,
@@ -2140,7 +2594,11 @@ void Executor::executeWorkUnitPerFragment(
 
   {
     auto clock_begin = timer_start();
-    std::lock_guard<std::mutex> kernel_lock(kernel_mutex_);
+    auto admission_ticket = QueryScheduler::get().admit(
+        config_->exec.scheduler,
+        {{co.device_type, 0}},
+        query_mem_desc_owned->getBufferSizeBytes(co.device_type),
+        eo.query_priority);
     kernel_queue_time_ms_ += timer_stop(clock_begin);
 
     for (auto fragment_index : fragment_indexes) {
@@ -2166,6 +2624,9 @@ void Executor::executeWorkUnitPerFragment(
 
   for (const auto& [result_set_ptr, result_fragment_indexes] : all_fragment_results) {
     CHECK_EQ(result_fragment_indexes.size(), 1);
+    if (result_set_ptr->getStorage()) {
+      result_set_ptr->getStorage()->finalizeFirstTouchInit();
+    }
     cb(result_set_ptr, outer_fragments[result_fragment_indexes[0]]);
   }
 }
@@ -2363,6 +2824,8 @@ ResultSetPtr Executor::collectAllDeviceResults(
     std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner,
     const CompilationOptions& co) {
   auto timer = DEBUG_TIMER(__func__);
+  QueryProfileTimer profile_timer(query_profile_, &QueryProfile::addReductionTime);
+  trace::Scope reduction_trace("reduction", "reduction");
   auto& result_per_device = shared_context.getFragmentResults();
   if (result_per_device.empty() && query_mem_desc.getQueryDescriptionType() ==
                                        QueryDescriptionType::NonGroupedAggregate) {
@@ -2405,6 +2868,98 @@ bool has_lazy_fetched_columns(const std::vector<ColumnLazyFetchInfo>& fetched_co
   return false;
 }
 
+// Pick the sub-task (morsel) size so that each CPU thread gets several sub-tasks to
+// pull. This keeps all threads busy when the outer table has few or skewed fragments.
+size_t get_sub_task_size(const CpuSubTasksConfig& config,
+                         const std::vector<InputTableInfo>& query_infos) {
+  constexpr size_t kSubTasksPerThread = 4;
+  size_t max_size = std::max(config.sub_task_size, size_t(1));
+  if (query_infos.empty()) {
+    return max_size;
+  }
+  size_t min_size = std::min(std::max(config.min_sub_task_size, size_t(1)), max_size);
+  size_t total_rows = query_infos.front().info.getNumTuples();
+  size_t num_subtasks = static_cast<size_t>(cpu_threads()) * kSubTasksPerThread;
+  size_t size = (total_rows + num_subtasks - 1) / num_subtasks;
+  return std::clamp(size, min_size, max_size);
+}
+
+// Devices the kernels are launched on. Queries without kernels still take a slot of
+// the first device of the type.
+std::set<QueryScheduler::Device> get_kernel_devices(
+    const std::vector<std::unique_ptr<ExecutionKernel>>& kernels,
+    const ExecutorDeviceType device_type) {
+  std::set<QueryScheduler::Device> res;
+  for (auto& kernel : kernels) {
+    CHECK(kernel);
+    res.emplace(kernel->getDeviceType(),
+                kernel->getDeviceType() == ExecutorDeviceType::CPU
+                    ? 0
+                    : kernel->getDeviceId());
+  }
+  if (res.empty()) {
+    res.emplace(device_type, 0);
+  }
+  return res;
+}
+
+void run_preemptible(SharedKernelContext& shared_context, std::function<void()> task) {
+  if (!shared_context.deferIfPreempted(task)) {
+    task();
+  }
+}
+
+// Resumes the query preempted while its kernels were running and executes the kernels
+// and sub-tasks it deferred. They continue from the results and group by buffers left
+// by the already executed ones. Returns the time spent waiting for the resumption.
+int64_t run_deferred_tasks(SharedKernelContext& shared_context,
+                           threading::task_group& tg) {
+  int64_t wait_time_ms = 0;
+  for (auto deferred = shared_context.takeDeferredTasks(); !deferred.empty();
+       deferred = shared_context.takeDeferredTasks()) {
+    VLOG(1) << "Resuming " << deferred.size() << " preempted tasks.";
+    auto clock_begin = timer_start();
+    shared_context.resumePreempted();
+    wait_time_ms += timer_stop(clock_begin);
+    for (auto& task : deferred) {
+      tg.run([task = std::move(task), &shared_context] {
+        run_preemptible(shared_context, task);
+      });
+    }
+    tg.wait();
+  }
+  return wait_time_ms;
+}
+
+// Join the scan of the outer table shared with concurrent queries and reorder kernels
+// to start from the fragment the other queries are processing. Only kernels
+// processing a single outer fragment each are reordered.
+SharedScanPtr join_shared_scan(std::vector<std::unique_ptr<ExecutionKernel>>& kernels,
+                               const RelAlgExecutionUnit& ra_exe_unit,
+                               const size_t window_ms) {
+  if (kernels.size() < 2 || ra_exe_unit.union_all || ra_exe_unit.input_descs.empty()) {
+    return nullptr;
+  }
+  for (auto& kernel : kernels) {
+    const auto& frag_list = kernel->getFragments();
+    if (frag_list.empty() || frag_list[0].fragment_ids.size() != 1) {
+      return nullptr;
+    }
+  }
+  const auto& outer_desc = ra_exe_unit.input_descs[0];
+  auto scan = SharedScans::get().join(
+      outer_desc.getDatabaseId(), outer_desc.getTableId(), window_ms);
+  const size_t start = scan->startFragment();
+  auto order_key = [start](const std::unique_ptr<ExecutionKernel>& kernel) {
+    const size_t frag_id = kernel->getFragments()[0].fragment_ids[0];
+    return std::make_pair(frag_id < start, frag_id);
+  };
+  std::stable_sort(kernels.begin(), kernels.end(), [&](auto& lhs, auto& rhs) {
+    return order_key(lhs) < order_key(rhs);
+  });
+  return scan;
+}
+
 }  // namespace
 
 std::vector<std::unique_ptr<ExecutionKernel>> Executor::createKernels(
@@ -2542,6 +3097,186 @@ std::vector<std::unique_ptr<ExecutionKernel>> Executor::createKernels(
   return execution_kernels;
 }
 
+namespace {
+
+// Return true if chunk statistics of the fragment prove the simple qual true for all
+// rows of the fragment. Comparisons with nulls are never true, so the column must have
+// no nulls in the fragment.
+bool is_qual_always_true(const hdk::ir::Expr* qual, const FragmentInfo& fragment) {
+  const auto comp_expr = dynamic_cast<const hdk::ir::BinOper*>(qual);
+  if (!comp_expr) {
+    return false;
+  }
+  const auto lhs_col = dynamic_cast<const hdk::ir::ColumnVar*>(comp_expr->leftOperand());
+  const auto rhs_const =
+      dynamic_cast<const hdk::ir::Constant*>(comp_expr->rightOperand());
+  if (!lhs_col || !lhs_col->tableId() || lhs_col->rteIdx() || !rhs_const ||
+      rhs_const->isNull()) {
+    return false;
+  }
+  const auto lhs_type = lhs_col->type();
+  const auto rhs_type = rhs_const->type();
+  const bool comparable =
+      (lhs_type->isInteger() && rhs_type->isInteger()) ||
+      (lhs_type->isTimestamp() && rhs_type->isTimestamp() &&
+       lhs_type->as<hdk::ir::TimestampType>()->unit() ==
+           rhs_type->as<hdk::ir::TimestampType>()->unit());
+  if (!comparable) {
+    return false;
+  }
+  auto chunk_meta_it = fragment.getChunkMetadataMap().find(lhs_col->columnId());
+  if (chunk_meta_it == fragment.getChunkMetadataMap().end()) {
+    return false;
+  }
+  const auto& stats = chunk_meta_it->second->chunkStats();
+  if (stats.has_nulls) {
+    return false;
+  }
+  const auto chunk_min = extract_min_stat_int_type(stats, lhs_type);
+  const auto chunk_max = extract_max_stat_int_type(stats, lhs_type);
+  if (chunk_min > chunk_max) {
+    return false;
+  }
+  const auto val = rhs_const->intVal();
+  switch (comp_expr->opType()) {
+    case hdk::ir::OpType::kGe:
+      return chunk_min >= val;
+    case hdk::ir::OpType::kGt:
+      return chunk_min > val;
+    case hdk::ir::OpType::kLe:
+      return chunk_max <= val;
+    case hdk::ir::OpType::kLt:
+      return chunk_max < val;
+    case hdk::ir::OpType::kEq:
+      return chunk_min == val && chunk_max == val;
+    case hdk::ir::OpType::kNe:
+      return val < chunk_min || val > chunk_max;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+void Executor::specializeKernelsByFragmentStats(
+    std::vector<std::unique_ptr<ExecutionKernel>>& kernels,
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const std::vector<InputTableInfo>& table_infos,
+    const ColumnFetcher& column_fetcher,
+    const CompilationOptions& co,
+    const ExecutionOptions& eo,
+    const QueryCompilationDescriptor& query_comp_desc,
+    const QueryMemoryDescriptor& query_mem_desc,
+    const size_t max_groups_buffer_entry_guess,
+    const int8_t crt_min_byte_width,
+    const bool has_cardinality_estimation,
+    std::vector<std::unique_ptr<QueryCompilationDescriptor>>& filter_variants) {
+  // Each variant is a separate compilation, so only a few of them are made per query.
+  constexpr size_t kMaxFilterVariants = 4;
+  if (ra_exe_unit.simple_quals.empty() || ra_exe_unit.input_descs.size() != 1 ||
+      !ra_exe_unit.join_quals.empty() || ra_exe_unit.union_all ||
+      ra_exe_unit.estimator || table_infos.empty()) {
+    return;
+  }
+  // Kernels fetch columns as the plan state of the original query prescribes. Lazy
+  // fetch and encoded columns depend on the quals, so such queries are not specialized.
+  CHECK(plan_state_);
+  if (!plan_state_->columns_to_not_fetch_.empty() ||
+      !query_comp_desc.getColumnEncodings().empty()) {
+    return;
+  }
+
+  const std::vector<hdk::ir::ExprPtr> simple_quals(ra_exe_unit.simple_quals.begin(),
+                                                   ra_exe_unit.simple_quals.end());
+  const auto& fragments = table_infos.front().info.fragments;
+  // Compiled variants by always true quals, null for variants which can't be used.
+  std::map<std::vector<bool>, const QueryCompilationDescriptor*> variants;
+  // Compilation resets the plan state, the original one is used by kernels.
+  std::unique_ptr<PlanState> query_plan_state;
+  ScopeGuard restore_plan_state = [this, &query_plan_state] {
+    if (query_plan_state) {
+      plan_state_ = std::move(query_plan_state);
+    }
+  };
+  size_t specialized_kernels = 0;
+  for (auto& kernel : kernels) {
+    const auto& frag_list = kernel->getFragments();
+    if (frag_list.empty() || frag_list.front().fragment_ids.empty()) {
+      continue;
+    }
+    std::vector<bool> always_true(simple_quals.size(), true);
+    for (auto frag_id : frag_list.front().fragment_ids) {
+      CHECK_LT(frag_id, fragments.size());
+      for (size_t i = 0; i < simple_quals.size(); ++i) {
+        always_true[i] = always_true[i] &&
+                         is_qual_always_true(simple_quals[i].get(), fragments[frag_id]);
+      }
+    }
+    if (std::none_of(always_true.begin(), always_true.end(), [](bool v) { return v; })) {
+      continue;
+    }
+    auto variant_it = variants.find(always_true);
+    if (variant_it == variants.end()) {
+      if (variants.size() >= kMaxFilterVariants) {
+        continue;
+      }
+      RelAlgExecutionUnit variant_exe_unit(ra_exe_unit);
+      variant_exe_unit.simple_quals.clear();
+      for (size_t i = 0; i < simple_quals.size(); ++i) {
+        if (!always_true[i]) {
+          variant_exe_unit.simple_quals.push_back(simple_quals[i]);
+        }
+      }
+      if (!query_plan_state) {
+        query_plan_state = std::move(plan_state_);
+      }
+      auto variant = std::make_unique<QueryCompilationDescriptor>();
+      variant->setUseGroupByBufferDesc(query_comp_desc.useGroupByBufferDesc());
+      std::unique_ptr<QueryMemoryDescriptor> variant_mem_desc;
+      try {
+        QueryProfileTimer profile_timer(query_profile_,
+                                        &QueryProfile::addCompilationTime);
+        variant_mem_desc = variant->compile(max_groups_buffer_entry_guess,
+                                            crt_min_byte_width,
+                                            has_cardinality_estimation,
+                                            variant_exe_unit,
+                                            table_infos,
+                                            column_fetcher,
+                                            {query_comp_desc.getDeviceType(),
+                                             co.hoist_literals,
+                                             co.opt_level,
+                                             co.with_dynamic_watchdog,
+                                             co.allow_lazy_fetch,
+                                             co.filter_on_deleted_column,
+                                             co.explain_type,
+                                             co.register_intel_jit_listener},
+                                            eo,
+                                            this);
+      } catch (CompilationRetryNoCompaction&) {
+      }
+      // Kernels of the variant share output buffers and reduction with the original
+      // kernels, so the memory layout must be the same.
+      const QueryCompilationDescriptor* compiled = nullptr;
+      if (variant_mem_desc && *variant_mem_desc == query_mem_desc &&
+          variant->getColumnEncodings().empty() &&
+          plan_state_->columns_to_not_fetch_.empty()) {
+        filter_variants.push_back(std::move(variant));
+        compiled = filter_variants.back().get();
+      }
+      variant_it = variants.emplace(always_true, compiled).first;
+    }
+    if (variant_it->second) {
+      kernel = kernel->retarget(kernel->getDeviceType(),
+                                kernel->getDeviceId(),
+                                *variant_it->second,
+                                query_mem_desc);
+      ++specialized_kernels;
+    }
+  }
+  VLOG(1) << specialized_kernels << " of " << kernels.size()
+          << " kernels run without quals proven true by fragment statistics.";
+}
+
 // TODO: unify with createKernels.
 std::vector<std::unique_ptr<ExecutionKernel>> Executor::createHeterogeneousKernels(
     SharedKernelContext& shared_context,
@@ -2633,13 +3368,196 @@ std::vector<std::unique_ptr<ExecutionKernel>> Executor::createHeterogeneousKerne
   return execution_kernels;
 }
 
+void Executor::launchHeterogeneousKernels(
+    SharedKernelContext& shared_context,
+    std::vector<std::unique_ptr<ExecutionKernel>>&& kernels,
+    const ExecutorDeviceType device_type,
+    const ExecutionOptions& eo,
+    const size_t memory_reservation,
+    const std::map<ExecutorDeviceType, std::unique_ptr<QueryCompilationDescriptor>>&
+        query_comp_descs,
+    const std::map<ExecutorDeviceType, std::unique_ptr<QueryMemoryDescriptor>>&
+        query_mem_descs) {
+  // Kernel queue of a single device. Kernels are executed from the front of the queue
+  // by its own workers and stolen from the back by other workers. Initially assigned
+  // kernels are preferred by their devices, e.g. because their data is already
+  // resident in the GPU memory.
+  struct DeviceQueue {
+    ExecutorDeviceType device_type;
+    int device_id;
+    std::deque<std::unique_ptr<ExecutionKernel>> kernels;
+  };
+  // Deque keeps references to queues valid while adding new ones.
+  std::deque<DeviceQueue> queues;
+  auto get_queue = [&queues](ExecutorDeviceType device_type,
+                             int device_id) -> DeviceQueue& {
+    for (auto& queue : queues) {
+      if (queue.device_type == device_type && queue.device_id == device_id) {
+        return queue;
+      }
+    }
+    queues.push_back({device_type, device_id, {}});
+    return queues.back();
+  };
+  if (query_comp_descs.count(ExecutorDeviceType::CPU)) {
+    get_queue(ExecutorDeviceType::CPU, 0);
+  }
+  for (auto& kernel : kernels) {
+    CHECK(kernel);
+    auto& queue = get_queue(kernel->getDeviceType(), kernel->getDeviceId());
+    queue.kernels.push_back(std::move(kernel));
+  }
+  VLOG(1) << "Launching " << kernels.size() << " heterogeneous kernels for query.";
+
+  // Kernels can be stolen by any queue, so the query is admitted on all their devices.
+  std::set<QueryScheduler::Device> devices;
+  for (auto& queue : queues) {
+    devices.emplace(queue.device_type, queue.device_id);
+  }
+  if (devices.empty()) {
+    devices.emplace(device_type, 0);
+  }
+  auto clock_begin = timer_start();
+  auto admission_ticket = QueryScheduler::get().admit(
+      config_->exec.scheduler, std::move(devices), memory_reservation, eo.query_priority);
+  kernel_queue_time_ms_ += timer_stop(clock_begin);
+  shared_context.setAdmissionTicket(&config_->exec.scheduler, admission_ticket.get());
+  ScopeGuard ticket_guard(
+      [&shared_context]() { shared_context.setAdmissionTicket(nullptr, nullptr); });
+
+  std::mutex queue_mutex;
+  // Stolen kernels are kept alive until all workers are done.
+  std::vector<std::unique_ptr<ExecutionKernel>> done_kernels;
+  size_t stolen_kernels = 0;
+  auto next_kernel = [&](size_t queue_idx) -> ExecutionKernel* {
+    std::lock_guard<std::mutex> lock(queue_mutex);
+    auto& own_queue = queues[queue_idx];
+    std::unique_ptr<ExecutionKernel> kernel;
+    if (!own_queue.kernels.empty()) {
+      kernel = std::move(own_queue.kernels.front());
+      own_queue.kernels.pop_front();
+    } else {
+      DeviceQueue* victim = nullptr;
+      for (auto& queue : queues) {
+        if (!queue.kernels.empty() &&
+            (!victim || queue.kernels.size() > victim->kernels.size())) {
+          victim = &queue;
+        }
+      }
+      if (!victim) {
+        return nullptr;
+      }
+      const auto dt = own_queue.device_type;
+      kernel = victim->kernels.back()->retarget(dt,
+                                                own_queue.device_id,
+                                                *query_comp_descs.at(dt),
+                                                *query_mem_descs.at(dt));
+      victim->kernels.pop_back();
+      ++stolen_kernels;
+    }
+    done_kernels.push_back(std::move(kernel));
+    return done_kernels.back().get();
+  };
+
+  threading::task_group tg;
+  for (size_t queue_idx = 0; queue_idx < queues.size(); ++queue_idx) {
+    // GPU kernels are serialized per device, so a single worker is enough.
+    const size_t num_workers = queues[queue_idx].device_type == ExecutorDeviceType::CPU
+                                   ? static_cast<size_t>(cpu_threads())
+                                   : 1;
+    for (size_t worker_idx = 0; worker_idx < num_workers; ++worker_idx) {
+      tg.run([this,
+              &next_kernel,
+              &shared_context,
+              queue_idx,
+              thread_idx = worker_idx,
+              parent_thread_id = logger::thread_id()] {
+        DEBUG_TIMER_NEW_THREAD(parent_thread_id);
+        while (auto kernel = next_kernel(queue_idx)) {
+          run_preemptible(shared_context, [this, kernel, thread_idx, &shared_context] {
+            kernel->run(this, thread_idx, shared_context);
+          });
+        }
+      });
+    }
+  }
+  tg.wait();
+  kernel_queue_time_ms_ += run_deferred_tasks(shared_context, tg);
+  VLOG(1) << stolen_kernels << " kernels were stolen by other devices.";
+}
+
+void Executor::retryKernelsOnCpu(
+    SharedKernelContext& shared_context,
+    const std::vector<const ExecutionKernel*>& kernels,
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const std::vector<InputTableInfo>& table_infos,
+    const ColumnFetcher& column_fetcher,
+    const CompilationOptions& co,
+    const ExecutionOptions& eo,
+    const size_t max_groups_buffer_entry_guess,
+    const int8_t crt_min_byte_width,
+    const bool has_cardinality_estimation,
+    std::map<ExecutorDeviceType, std::unique_ptr<QueryCompilationDescriptor>>&
+        query_comp_descs,
+    std::map<ExecutorDeviceType, std::unique_ptr<QueryMemoryDescriptor>>&
+        query_mem_descs) {
+  LOG(INFO) << "Retrying " << kernels.size()
+            << " kernel(s) which ran out of GPU memory on CPU";
+  const auto co_cpu = CompilationOptions::makeCpuOnly(co);
+  if (!query_comp_descs.count(ExecutorDeviceType::CPU)) {
+    auto query_comp_desc_owned = std::make_unique<QueryCompilationDescriptor>();
+    query_comp_desc_owned->setUseGroupByBufferDesc(co.use_groupby_buffer_desc);
+    std::unique_ptr<QueryMemoryDescriptor> query_mem_desc_owned;
+    try {
+      QueryProfileTimer profile_timer(query_profile_, &QueryProfile::addCompilationTime);
+      query_mem_desc_owned = query_comp_desc_owned->compile(max_groups_buffer_entry_guess,
+                                                            crt_min_byte_width,
+                                                            has_cardinality_estimation,
+                                                            ra_exe_unit,
+                                                            table_infos,
+                                                            column_fetcher,
+                                                            co_cpu,
+                                                            eo,
+                                                            this);
+    } catch (CompilationRetryNoCompaction&) {
+      // Fall back to the retry of the whole step on CPU.
+      throw QueryExecutionError(ERR_OUT_OF_GPU_MEM);
+    }
+    query_comp_descs.emplace(ExecutorDeviceType::CPU, std::move(query_comp_desc_owned));
+    query_mem_descs.emplace(ExecutorDeviceType::CPU, std::move(query_mem_desc_owned));
+  }
+  const auto& cpu_comp_desc = *query_comp_descs.at(ExecutorDeviceType::CPU);
+  const auto& cpu_mem_desc = *query_mem_descs.at(ExecutorDeviceType::CPU);
+
+  std::vector<std::unique_ptr<ExecutionKernel>> cpu_kernels;
+  for (auto kernel : kernels) {
+    cpu_kernels.push_back(
+        kernel->retarget(ExecutorDeviceType::CPU, 0, cpu_comp_desc, cpu_mem_desc));
+  }
+  const size_t memory_reservation =
+      std::min(cpu_kernels.size(), static_cast<size_t>(std::max(cpu_threads(), 1))) *
+      cpu_mem_desc.getBufferSizeBytes(ExecutorDeviceType::CPU);
+  launchKernels(shared_context,
+                std::move(cpu_kernels),
+                ExecutorDeviceType::CPU,
+                co_cpu,
+                eo,
+                memory_reservation);
+}
+
 // TODO(Petr): remove device_type from function signature
 void Executor::launchKernels(SharedKernelContext& shared_context,
                              std::vector<std::unique_ptr<ExecutionKernel>>&& kernels,
                              const ExecutorDeviceType device_type,
-                             const CompilationOptions& co) {
+                             const CompilationOptions& co,
+                             const ExecutionOptions& eo,
+                             const size_t memory_reservation) {
   auto clock_begin = timer_start();
-  std::lock_guard<std::mutex> kernel_lock(kernel_mutex_);
+  auto admission_ticket =
+      QueryScheduler::get().admit(config_->exec.scheduler,
+                                  get_kernel_devices(kernels, device_type),
+                                  memory_reservation,
+                                  eo.query_priority);
   kernel_queue_time_ms_ += timer_stop(clock_begin);
 
   threading::task_group tg;
@@ -2650,6 +3568,8 @@ void Executor::launchKernels(SharedKernelContext& shared_context,
 #ifdef HAVE_TBB
   if (config_->exec.sub_tasks.enable && device_type == ExecutorDeviceType::CPU) {
     shared_context.setThreadPool(&tg);
+    shared_context.setSubTaskSize(
+        get_sub_task_size(config_->exec.sub_tasks, shared_context.getQueryInfos()));
   }
   ScopeGuard pool_guard([&shared_context]() { shared_context.setThreadPool(nullptr); });
 #endif  // HAVE_TBB
@@ -2659,6 +3579,10 @@ void Executor::launchKernels(SharedKernelContext& shared_context,
     VLOG(1) << "\t" << i << ' ' << (toString(kernels[i])) << ".";
   }
 
+  shared_context.setAdmissionTicket(&config_->exec.scheduler, admission_ticket.get());
+  ScopeGuard ticket_guard(
+      [&shared_context]() { shared_context.setAdmissionTicket(nullptr, nullptr); });
+
   size_t kernel_idx = 1;
   for (auto& kernel : kernels) {
     CHECK(kernel.get());
@@ -2669,10 +3593,22 @@ void Executor::launchKernels(SharedKernelContext& shared_context,
             crt_kernel_idx = kernel_idx++] {
       DEBUG_TIMER_NEW_THREAD(parent_thread_id);
       const size_t thread_i = crt_kernel_idx % cpu_threads();
-      kernel->run(this, thread_i, shared_context);
+      run_preemptible(shared_context, [this, &kernel, &shared_context, thread_i] {
+        try {
+          kernel->run(this, thread_i, shared_context);
+        } catch (const QueryExecutionError& e) {
+          if (e.getErrorCode() != ERR_OUT_OF_GPU_MEM ||
+              !shared_context.addCpuRetryKernel(kernel.get())) {
+            throw;
+          }
+          VLOG(1) << "Kernel ran out of GPU memory, it will be retried on CPU: "
+                  << kernel->toString();
+        }
+      });
     });
   }
   tg.wait();
+  kernel_queue_time_ms_ += run_deferred_tasks(shared_context, tg);
 
   for (auto& exec_ctx : shared_context.getTlsExecutionContext()) {
     // The first arg is used for GPU only, it's not our case.
@@ -2859,7 +3795,8 @@ FetchResult Executor::fetchChunks(
     std::list<std::shared_ptr<Chunk_NS::Chunk>>& chunks,
     DeviceAllocator* device_allocator,
     const size_t thread_idx,
-    const bool allow_runtime_interrupt) {
+    const bool allow_runtime_interrupt,
+    const ColumnEncodings* column_encodings) {
   auto timer = DEBUG_TIMER(__func__);
   INJECT_TIMER(fetchChunks);
   const auto& col_global_ids = ra_exe_unit.input_col_descs;
@@ -2934,6 +3871,19 @@ FetchResult Executor::fetchChunks(
                                                         device_allocator,
                                                         thread_idx);
         }
+      } else if (column_encodings && column_encodings->count(*col_id) &&
+                 plan_state_->columns_to_fetch_.count(*col_id)) {
+        // Lazily fetched columns are read by result sets, which expect plain values.
+        frag_col_buffers[it->second] = column_fetcher.getOneTableEncodedColumnFragment(
+            col_id->getColInfo(),
+            frag_id,
+            all_tables_fragments,
+            chunks,
+            chunk_iterators,
+            column_encodings->at(*col_id),
+            memory_level_for_column,
+            device_id,
+            device_allocator);
       } else {
         frag_col_buffers[it->second] =
             column_fetcher.getOneTableColumnFragment(col_id->getColInfo(),
@@ -3245,9 +4195,15 @@ int32_t Executor::executePlan(const RelAlgExecutionUnit& ra_exe_unit,
   auto hoist_buf = serializeLiterals(compilation_result.literal_values, device_id);
   int32_t error_code = device_type == ExecutorDeviceType::GPU ? 0 : start_rowid;
   const auto join_hash_table_ptrs = getJoinHashTablePtrs(device_type, device_id);
+  // Generated CPU code checks for interrupts and timeouts only once in a while, so
+  // check before each kernel or sub-task launch as well.
   if (interrupted_.load()) {
     throw QueryExecutionError(ERR_INTERRUPTED);
   }
+  if (co.with_dynamic_watchdog && device_type == ExecutorDeviceType::CPU &&
+      dynamic_watchdog()) {
+    throw QueryExecutionError(ERR_OUT_OF_TIME);
+  }
 
   VLOG(2) << "bool(ra_exe_unit.union_all)=" << bool(ra_exe_unit.union_all)
           << " ra_exe_unit.input_descs="
@@ -3268,6 +4224,7 @@ int32_t Executor::executePlan(const RelAlgExecutionUnit& ra_exe_unit,
   if (!is_groupby) {
     std::unique_ptr<OutVecOwner> output_memory_scope;
     std::vector<int64_t*> out_vec;
+    unsigned grid_size = gridSize();
     if (device_type == ExecutorDeviceType::CPU) {
       CpuCompilationContext* cpu_generated_code =
           dynamic_cast<CpuCompilationContext*>(compilation_result.generated_code.get());
@@ -3288,7 +4245,19 @@ int32_t Executor::executePlan(const RelAlgExecutionUnit& ra_exe_unit,
     } else {
       CompilationContext* gpu_generated_code = compilation_result.generated_code.get();
       CHECK(gpu_generated_code);
+      // Each thread produces its own partial aggregates which are copied to the host
+      // and reduced there, so the grid size is tuned per kernel. The runtime interrupt
+      // check bakes the grid size into the code and shared memory reduction produces
+      // a single result, so the default is kept for them.
+      const bool tune_grid_size =
+          config_->exec.enable_gpu_launch_autotuning && !grid_size_x_ &&
+          !allow_runtime_interrupt && !ra_exe_unit.estimator &&
+          !compilation_result.gpu_smem_context.isSharedMemoryUsed();
+      if (tune_grid_size) {
+        grid_size = gpu_generated_code->gpuLaunchTuner().gridSize(grid_size);
+      }
       try {
+        auto launch_clock = timer_start();
         out_vec = query_exe_context->launchGpuCode(
             ra_exe_unit,
             gpu_generated_code,
@@ -3301,7 +4270,7 @@ int32_t Executor::executePlan(const RelAlgExecutionUnit& ra_exe_unit,
             data_mgr,
             getBufferProvider(),
             blockSize(),
-            gridSize(),
+            grid_size,
             device_id,
             compilation_result.gpu_smem_context.getSharedMemorySize(),
             &error_code,
@@ -3309,6 +4278,16 @@ int32_t Executor::executePlan(const RelAlgExecutionUnit& ra_exe_unit,
             allow_runtime_interrupt,
             join_hash_table_ptrs);
         output_memory_scope.reset(new OutVecOwner(out_vec));
+        if (tune_grid_size && !error_code) {
+          size_t row_count = 0;
+          for (const auto& frag_num_rows : num_rows) {
+            row_count += frag_num_rows.empty() ? 0 : frag_num_rows.front();
+          }
+          const auto launch_time_us =
+              timer_stop<decltype(launch_clock), std::chrono::microseconds>(launch_clock);
+          gpu_generated_code->gpuLaunchTuner().registerLaunch(
+              grid_size, row_count, launch_time_us);
+        }
       } catch (const OutOfMemory&) {
         return ERR_OUT_OF_GPU_MEM;
       } catch (const std::exception& e) {
@@ -3339,7 +4318,7 @@ int32_t Executor::executePlan(const RelAlgExecutionUnit& ra_exe_unit,
         device_type == ExecutorDeviceType::GPU
             ? (compilation_result.gpu_smem_context.isSharedMemoryUsed()
                    ? 1
-                   : blockSize() * gridSize() * num_frags)
+                   : blockSize() * grid_size * num_frags)
             : num_frags;
     if (size_t(1) == entry_count) {
       for (auto out : out_vec) {
@@ -3588,6 +4567,8 @@ Executor::JoinHashTableOrError Executor::buildHashTableForQualifier(
   if (config_->exec.watchdog.enable_dynamic && interrupted_.load()) {
     throw QueryExecutionError(ERR_INTERRUPTED);
   }
+  QueryProfileTimer profile_timer(query_profile_, &QueryProfile::addHashTableBuildTime);
+  trace::Scope hash_table_trace("hash table build", "hash_table");
   try {
     auto tbl = HashJoin::getInstance(qual_bin_oper,
                                      query_infos,
@@ -3983,6 +4964,189 @@ std::pair<bool, int64_t> Executor::skipFragment(
   return {false, -1};
 }
 
+bool Executor::skipFragmentByJoinKeyRange(const InputDescriptor& table_desc,
+                                          const FragmentInfo& fragment,
+                                          const hdk::ir::Expr* join_qual) const {
+  const auto bin_oper = dynamic_cast<const hdk::ir::BinOper*>(join_qual);
+  if (!bin_oper || bin_oper->opType() != hdk::ir::OpType::kEq) {
+    return false;
+  }
+  auto outer_col = dynamic_cast<const hdk::ir::ColumnVar*>(bin_oper->leftOperand());
+  auto inner_col = dynamic_cast<const hdk::ir::ColumnVar*>(bin_oper->rightOperand());
+  if (!outer_col || !inner_col) {
+    return false;
+  }
+  if (outer_col->rteIdx() > inner_col->rteIdx()) {
+    std::swap(outer_col, inner_col);
+  }
+  if (outer_col->rteIdx() != 0 || inner_col->rteIdx() == 0 ||
+      outer_col->tableId() != table_desc.getTableId() || outer_col->isVirtual() ||
+      !outer_col->type()->isInteger() || !inner_col->type()->isInteger()) {
+    return false;
+  }
+
+  const auto& col_ranges = agg_col_range_cache_.asMap();
+  const auto inner_range_it = col_ranges.find(
+      {inner_col->columnId(), inner_col->tableId(), inner_col->dbId()});
+  if (inner_range_it == col_ranges.end() ||
+      inner_range_it->second.getType() != ExpressionRangeType::Integer) {
+    return false;
+  }
+  const auto& inner_range = inner_range_it->second;
+
+  auto chunk_meta_it = fragment.getChunkMetadataMap().find(outer_col->columnId());
+  if (chunk_meta_it == fragment.getChunkMetadataMap().end()) {
+    return false;
+  }
+  const auto chunk_min =
+      extract_min_stat_int_type(chunk_meta_it->second->chunkStats(), outer_col->type());
+  const auto chunk_max =
+      extract_max_stat_int_type(chunk_meta_it->second->chunkStats(), outer_col->type());
+  if (chunk_min > chunk_max) {
+    // invalid metadata range, do not skip fragment
+    return false;
+  }
+  return chunk_max < inner_range.getIntMin() || chunk_min > inner_range.getIntMax();
+}
+
+namespace {
+
+// Dictionaries with more matching ids are not worth checking for each fragment.
+constexpr size_t kMaxDictIdsToCheckForSkipping = 10000;
+
+const hdk::ir::ColumnVar* get_outer_dict_column(const hdk::ir::Expr* expr,
+                                                const int table_id) {
+  auto col_var = dynamic_cast<const hdk::ir::ColumnVar*>(expr);
+  if (!col_var || col_var->is<hdk::ir::Var>() || col_var->rteIdx() ||
+      col_var->tableId() != table_id || col_var->isVirtual() ||
+      !col_var->type()->isExtDictionary()) {
+    return nullptr;
+  }
+  return col_var;
+}
+
+const hdk::ir::Constant* get_string_literal(const hdk::ir::Expr* expr) {
+  auto u_oper = dynamic_cast<const hdk::ir::UOper*>(expr);
+  if (u_oper && u_oper->isCast()) {
+    expr = u_oper->operand();
+  }
+  auto literal = dynamic_cast<const hdk::ir::Constant*>(expr);
+  if (!literal || literal->isNull() || !literal->type()->isString()) {
+    return nullptr;
+  }
+  return literal;
+}
+
+// Return the dictionary encoded column of the table filtered by the qual and ids of
+// all strings which may pass the filter. Only equality with a string literal and LIKE
+// with a literal pattern are supported.
+std::optional<std::pair<const hdk::ir::ColumnVar*, std::vector<int32_t>>>
+get_dict_string_qual_ids(const hdk::ir::Expr* qual,
+                         const int table_id,
+                         const Executor* executor) {
+  if (auto bin_oper = dynamic_cast<const hdk::ir::BinOper*>(qual)) {
+    if (bin_oper->opType() != hdk::ir::OpType::kEq ||
+        bin_oper->qualifier() != hdk::ir::Qualifier::kOne) {
+      return std::nullopt;
+    }
+    auto col_var = get_outer_dict_column(bin_oper->leftOperand(), table_id);
+    auto literal = get_string_literal(bin_oper->rightOperand());
+    if (!col_var || !literal) {
+      col_var = get_outer_dict_column(bin_oper->rightOperand(), table_id);
+      literal = get_string_literal(bin_oper->leftOperand());
+    }
+    if (!col_var || !literal) {
+      return std::nullopt;
+    }
+    auto sdp = executor->getStringDictionaryProxy(
+        col_var->type()->as<hdk::ir::ExtDictionaryType>()->dictId(), true);
+    return std::make_pair(col_var,
+                          std::vector<int32_t>{sdp->getIdOfString(
+                              *literal->value().stringval)});
+  }
+
+  auto like_expr = dynamic_cast<const hdk::ir::LikeExpr*>(qual);
+  if (!like_expr) {
+    return std::nullopt;
+  }
+  auto cast_oper = dynamic_cast<const hdk::ir::UOper*>(like_expr->arg());
+  if (!cast_oper || !cast_oper->isCast()) {
+    return std::nullopt;
+  }
+  auto col_var = get_outer_dict_column(cast_oper->operand(), table_id);
+  auto pattern = dynamic_cast<const hdk::ir::Constant*>(like_expr->likeExpr());
+  if (!col_var || !pattern || pattern->isNull() || !pattern->type()->isString()) {
+    return std::nullopt;
+  }
+  char escape_char{'\\'};
+  if (like_expr->escapeExpr()) {
+    auto escape_char_expr =
+        dynamic_cast<const hdk::ir::Constant*>(like_expr->escapeExpr());
+    if (!escape_char_expr || escape_char_expr->value().stringval->size() != 1) {
+      return std::nullopt;
+    }
+    escape_char = (*escape_char_expr->value().stringval)[0];
+  }
+  auto sdp = executor->getStringDictionaryProxy(
+      col_var->type()->as<hdk::ir::ExtDictionaryType>()->dictId(), true);
+  // Follow the LIKE codegen which doesn't scan very big dictionaries.
+  if (sdp->storageEntryCount() > 200000000) {
+    return std::nullopt;
+  }
+  auto ids = sdp->getLike(*pattern->value().stringval,
+                          like_expr->isIlike(),
+                          like_expr->isSimple(),
+                          escape_char);
+  if (ids.size() > kMaxDictIdsToCheckForSkipping) {
+    return std::nullopt;
+  }
+  return std::make_pair(col_var, std::move(ids));
+}
+
+bool chunk_may_contain_dict_ids(const ChunkMetadata& chunk_meta,
+                                const std::vector<int32_t>& ids) {
+  const auto& stats = chunk_meta.chunkStats();
+  if (stats.min.intval > stats.max.intval) {
+    // invalid metadata range
+    return true;
+  }
+  auto filter = chunk_meta.dictIdFilter();
+  for (auto id : ids) {
+    if (id >= stats.min.intval && id <= stats.max.intval &&
+        (!filter || filter->mayContain(id))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+bool Executor::skipFragmentByDictStringQuals(
+    const InputDescriptor& table_desc,
+    const FragmentInfo& fragment,
+    const std::list<hdk::ir::ExprPtr>& quals) const {
+  if (!getConfig().opts.skip_fragments_by_dict_string_stats || !row_set_mem_owner_) {
+    return false;
+  }
+  for (const auto& qual : quals) {
+    auto col_and_ids =
+        get_dict_string_qual_ids(qual.get(), table_desc.getTableId(), this);
+    if (!col_and_ids) {
+      continue;
+    }
+    auto chunk_meta_it =
+        fragment.getChunkMetadataMap().find(col_and_ids->first->columnId());
+    if (chunk_meta_it == fragment.getChunkMetadataMap().end()) {
+      continue;
+    }
+    if (!chunk_may_contain_dict_ids(*chunk_meta_it->second, col_and_ids->second)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 /*
  *   The skipFragmentInnerJoins process all quals stored in the execution unit's
  * join_quals and gather all the ones that meet the "simple_qual" characteristics
@@ -4023,11 +5187,15 @@ std::pair<bool, int64_t> Executor::skipFragmentInnerJoins(
     // extracting all the conjunctive simple_quals from the quals stored for the inner
     // join
     std::list<hdk::ir::ExprPtr> inner_join_simple_quals;
+    std::list<hdk::ir::ExprPtr> inner_join_other_quals;
     for (auto& qual : inner_join.quals) {
       auto temp_qual = qual_to_conjunctive_form(qual);
       inner_join_simple_quals.insert(inner_join_simple_quals.begin(),
                                      temp_qual.simple_quals.begin(),
                                      temp_qual.simple_quals.end());
+      inner_join_other_quals.insert(inner_join_other_quals.end(),
+                                    temp_qual.quals.begin(),
+                                    temp_qual.quals.end());
     }
     auto temp_skip_frag = skipFragment(table_desc,
                                        fragment,
@@ -4041,6 +5209,18 @@ std::pair<bool, int64_t> Executor::skipFragmentInnerJoins(
     } else {
       skip_frag.first = skip_frag.first || temp_skip_frag.first;
     }
+    if (!skip_frag.first &&
+        skipFragmentByDictStringQuals(table_desc, fragment, inner_join_other_quals)) {
+      skip_frag.first = true;
+    }
+    if (!skip_frag.first && getConfig().opts.skip_fragments_by_join_key_range) {
+      for (auto& qual : inner_join_other_quals) {
+        if (skipFragmentByJoinKeyRange(table_desc, fragment, qual.get())) {
+          skip_frag.first = true;
+          break;
+        }
+      }
+    }
   }
   return skip_frag;
 }
@@ -4060,10 +5240,28 @@ AggregatedColRange Executor::computeColRangesCache(
   for (const auto& col_desc : col_descs) {
     if (ExpressionRange::typeSupportsRange(col_desc.type())) {
       const auto col_var = std::make_unique<hdk::ir::ColumnVar>(col_desc.getColInfo(), 0);
-      const auto col_range = getLeafColumnRange(col_var.get(), query_infos, this, false);
-      agg_col_range_cache.setColRange(
-          {col_desc.getColId(), col_desc.getTableId(), col_desc.getDatabaseId()},
-          col_range);
+      const PhysicalInput phys_input{
+          col_desc.getColId(), col_desc.getTableId(), col_desc.getDatabaseId()};
+      // Ranges of virtual columns depend on the total number of rows and can't be
+      // united over fragments.
+      if (config_->cache.reuse_col_ranges && !col_var->isVirtual()) {
+        auto info_it =
+            std::find_if(query_infos.begin(), query_infos.end(), [&](const auto& info) {
+              return info.db_id == col_desc.getDatabaseId() &&
+                     info.table_id == col_desc.getTableId();
+            });
+        CHECK(info_it != query_infos.end());
+        auto compute = [&](const TableFragmentsInfo& fragments) {
+          std::vector<InputTableInfo> infos{InputTableInfo{
+              col_desc.getDatabaseId(), col_desc.getTableId(), fragments}};
+          return getLeafColumnRange(col_var.get(), infos, this, false);
+        };
+        agg_col_range_cache.setColRange(
+            phys_input, col_range_cache_.getColRange(phys_input, info_it->info, compute));
+      } else {
+        agg_col_range_cache.setColRange(
+            phys_input, getLeafColumnRange(col_var.get(), query_infos, this, false));
+      }
     }
   }
   return agg_col_range_cache;
@@ -4165,7 +5363,6 @@ uint32_t Executor::gpu_active_modules_device_mask_{0x0};
 void* Executor::gpu_active_modules_[max_gpu_count];
 
 std::shared_mutex Executor::register_runtime_extension_functions_mutex_;
-std::mutex Executor::kernel_mutex_;
 std::atomic<size_t> Executor::executor_id_ctr_{0};
 
 std::unique_ptr<QueryPlanDagCache> Executor::query_plan_dag_cache_;
@@ -55,8 +55,10 @@
 #include "QueryEngine/GpuSharedMemoryContext.h"
 #include "QueryEngine/JoinHashTable/HashJoin.h"
 #include "QueryEngine/LoopControlFlow/JoinLoop.h"
+#include "QueryEngine/PersistentCodeCache.h"
 #include "QueryEngine/PlanState.h"
 #include "QueryEngine/QueryPlanDagCache.h"
+#include "QueryEngine/QueryProfile.h"
 #include "QueryEngine/RelAlgExecutionUnit.h"
 #include "QueryEngine/RelAlgTranslator.h"
 #include "QueryEngine/RowFuncBuilder.h"
@@ -74,7 +76,9 @@
 #include "Shared/funcannotations.h"
 #include "Shared/mapd_shared_mutex.h"
 #include "Shared/measure.h"
+#include "Shared/scope.h"
 #include "Shared/thread_count.h"
+#include "Shared/threading.h"
 #include "Shared/toString.h"
 #include "StringDictionary/LruCache.hpp"
 #include "StringDictionary/StringDictionary.h"
@@ -87,6 +91,7 @@ class QueryMemoryDescriptor;
 using QueryMemoryDescriptorOwned = std::unique_ptr<QueryMemoryDescriptor>;
 
 class ColumnFetcher;
+class ResultSetRecycler;
 
 class WatchdogException : public std::runtime_error {
  public:
@@ -221,6 +226,13 @@ struct StreamExecutionContext {
   ExecutionOptions eo;
   std::unique_ptr<SharedKernelContext> shared_context;
   bool is_agg;
+  // Executor state of the compiled query. Other queries can run on the executor
+  // between batches, so it is installed into the executor for each batch.
+  std::unique_ptr<PlanState> plan_state;
+  std::unique_ptr<CgenState> cgen_state;
+  std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner;
+  // Aggregate of batches reduced by previous polls.
+  ResultSetPtr running_result;
 
   StreamExecutionContext(RelAlgExecutionUnit ra_exe_unit,
                          const CompilationOptions& co,
@@ -246,6 +258,8 @@ class Executor : public StringDictionaryProxyProvider {
            const std::string& debug_dir,
            const std::string& debug_file);
 
+  ~Executor();
+
   void clearCaches(bool runtime_only = false);
 
   void reset(const bool discard_runtime_modules_only = false);
@@ -263,6 +277,12 @@ class Executor : public StringDictionaryProxyProvider {
 
   static void addUdfIrToModule(const std::string& udf_ir_filename, const bool is_cuda_ir);
 
+  // Replaces the runtime UDF modules with the given LLVM IR sources, several sources
+  // of the same device are linked into a single module. Empty lists drop the module.
+  // Code cached by this executor is discarded.
+  void registerRuntimeUdfModules(const std::vector<std::string>& cpu_irs,
+                                 const std::vector<std::string>& gpu_irs);
+
   // Globally available mapping of extension module sources. Not thread-safe.
   static std::map<ExtModuleKinds, std::string> extension_module_sources;
   static void initialize_extension_module_sources();
@@ -483,6 +503,9 @@ class Executor : public StringDictionaryProxyProvider {
       std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner,
       const CompilationOptions& co);
 
+  // Install the executor state of the stream query for the lifetime of the guard.
+  ScopeGuard installStreamExecutionState(StreamExecutionContext& ctx);
+
   std::unordered_map<int, const hdk::ir::BinOper*> getInnerTabIdToJoinCond() const;
 
   /**
@@ -525,6 +548,64 @@ class Executor : public StringDictionaryProxyProvider {
       std::unordered_set<int>& available_gpus,
       int& available_cpus);
 
+  /**
+   * Replaces kernels of fragments, for which chunk statistics prove some simple quals
+   * true for all rows, with kernels of the query compiled without those quals. New
+   * compilation descriptors are added to filter_variants, which should outlive the
+   * kernels.
+   */
+  void specializeKernelsByFragmentStats(
+      std::vector<std::unique_ptr<ExecutionKernel>>& kernels,
+      const RelAlgExecutionUnit& ra_exe_unit,
+      const std::vector<InputTableInfo>& table_infos,
+      const ColumnFetcher& column_fetcher,
+      const CompilationOptions& co,
+      const ExecutionOptions& eo,
+      const QueryCompilationDescriptor& query_comp_desc,
+      const QueryMemoryDescriptor& query_mem_desc,
+      const size_t max_groups_buffer_entry_guess,
+      const int8_t crt_min_byte_width,
+      const bool has_cardinality_estimation,
+      std::vector<std::unique_ptr<QueryCompilationDescriptor>>& filter_variants);
+
+  /**
+   * Launches heterogeneous execution kernels using a worker per GPU and CPU workers.
+   * Workers execute kernels assigned to their devices first and then steal kernels of
+   * other devices, so all devices finish at about the same time even if the initial
+   * kernel distribution is unbalanced.
+   */
+  void launchHeterogeneousKernels(
+      SharedKernelContext& shared_context,
+      std::vector<std::unique_ptr<ExecutionKernel>>&& kernels,
+      const ExecutorDeviceType device_type,
+      const ExecutionOptions& eo,
+      const size_t memory_reservation,
+      const std::map<ExecutorDeviceType, std::unique_ptr<QueryCompilationDescriptor>>&
+          query_comp_descs,
+      const std::map<ExecutorDeviceType, std::unique_ptr<QueryMemoryDescriptor>>&
+          query_mem_descs);
+
+  /**
+   * Executes on CPU the GPU kernels which ran out of GPU memory. Their results are added
+   * to the results of the other kernels in the shared context, so they should be
+   * reduced on CPU. The query is compiled for CPU if it wasn't yet.
+   */
+  void retryKernelsOnCpu(
+      SharedKernelContext& shared_context,
+      const std::vector<const ExecutionKernel*>& kernels,
+      const RelAlgExecutionUnit& ra_exe_unit,
+      const std::vector<InputTableInfo>& table_infos,
+      const ColumnFetcher& column_fetcher,
+      const CompilationOptions& co,
+      const ExecutionOptions& eo,
+      const size_t max_groups_buffer_entry_guess,
+      const int8_t crt_min_byte_width,
+      const bool has_cardinality_estimation,
+      std::map<ExecutorDeviceType, std::unique_ptr<QueryCompilationDescriptor>>&
+          query_comp_descs,
+      std::map<ExecutorDeviceType, std::unique_ptr<QueryMemoryDescriptor>>&
+          query_mem_descs);
+
   /**
    * Launches execution kernels created by `createKernels` asynchronously using a thread
    * pool.
@@ -532,7 +613,9 @@ class Executor : public StringDictionaryProxyProvider {
   void launchKernels(SharedKernelContext& shared_context,
                      std::vector<std::unique_ptr<ExecutionKernel>>&& kernels,
                      const ExecutorDeviceType device_type,
-                     const CompilationOptions& co);
+                     const CompilationOptions& co,
+                     const ExecutionOptions& eo,
+                     const size_t memory_reservation);
 
   std::vector<size_t> getTableFragmentIndices(
       const RelAlgExecutionUnit& ra_exe_unit,
@@ -561,7 +644,8 @@ class Executor : public StringDictionaryProxyProvider {
                           std::list<std::shared_ptr<Chunk_NS::Chunk>>&,
                           DeviceAllocator* device_allocator,
                           const size_t thread_idx,
-                          const bool allow_runtime_interrupt);
+                          const bool allow_runtime_interrupt,
+                          const ColumnEncodings* column_encodings = nullptr);
 
   FetchResult fetchUnionChunks(const ColumnFetcher&,
                                const RelAlgExecutionUnit& ra_exe_unit,
@@ -686,12 +770,18 @@ class Executor : public StringDictionaryProxyProvider {
       const CompilationOptions& co,
       const ExecutionOptions& eo,
       const std::vector<InputTableInfo>& table_infos,
+      const size_t max_groups_buffer_entry_guess,
       DataProvider* data_provider,
       ColumnCacheMap& column_cache);
 
   ResultSetPtr runOnBatch(std::shared_ptr<StreamExecutionContext> ctx,
                           const FragmentsList& fragments);
 
+  // Return the aggregate of all processed batches for aggregations and rows of
+  // batches processed since the previous poll for projections. The aggregate shares
+  // storage with the state of the stream and is valid until the next poll.
+  hdk::ResultSetTable pollStreamExecution(std::shared_ptr<StreamExecutionContext> ctx);
+
   hdk::ResultSetTable finishStreamExecution(std::shared_ptr<StreamExecutionContext> ctx);
 
   std::vector<llvm::Value*> inlineHoistedLiterals();
@@ -736,6 +826,14 @@ class Executor : public StringDictionaryProxyProvider {
       DataProvider* data_provider,
       ColumnCacheMap& column_cache,
       std::vector<std::string>& fail_reasons);
+  // Generates a call selecting rows of the inner loop join level for which
+  // `inner_col op outer_expr` holds. Returns a buffer with the number of selected rows
+  // followed by their positions.
+  llvm::Value* codegenLoopJoinScan(const hdk::ir::ColumnVar* inner_col,
+                                   const hdk::ir::Expr* outer_expr,
+                                   const hdk::ir::OpType op,
+                                   const size_t level_idx,
+                                   const CompilationOptions& co);
   void redeclareFilterFunction();
   llvm::Value* addJoinLoopIterator(const std::vector<llvm::Value*>& prev_iters,
                                    const size_t level_idx);
@@ -791,6 +889,14 @@ class Executor : public StringDictionaryProxyProvider {
       std::shared_ptr<compiler::Backend>,
       const std::unordered_set<llvm::Function*>&,
       const CompilationOptions&);
+  // Compile a copy of the query IR in background and replace the cached code for the
+  // key with the result.
+  void recompileHotCodeAsync(const CodeCacheKey& key,
+                             llvm::Function* query_func,
+                             llvm::Function* multifrag_query_func,
+                             std::shared_ptr<compiler::Backend> backend,
+                             const std::unordered_set<llvm::Function*>& live_funcs,
+                             const CompilationOptions& co);
   std::shared_ptr<CompilationContext> optimizeAndCodegenGPU(
       llvm::Function*,
       llvm::Function*,
@@ -832,6 +938,18 @@ class Executor : public StringDictionaryProxyProvider {
       const size_t frag_idx,
       compiler::CodegenTraitsDescriptor codegen_traits_desc);
 
+  // Return true if an inner join qual requires keys from the outer fragment to be
+  // within the inner column range and the fragment has no such keys.
+  bool skipFragmentByJoinKeyRange(const InputDescriptor& table_desc,
+                                  const FragmentInfo& fragment,
+                                  const hdk::ir::Expr* join_qual) const;
+
+  // Return true if a string equality or LIKE qual on a dictionary encoded column of the
+  // table matches no dictionary ids stored in the fragment.
+  bool skipFragmentByDictStringQuals(const InputDescriptor& table_desc,
+                                     const FragmentInfo& fragment,
+                                     const std::list<hdk::ir::ExprPtr>& quals) const;
+
   std::pair<bool, int64_t> skipFragmentInnerJoins(
       const InputDescriptor& table_desc,
       const RelAlgExecutionUnit& ra_exe_unit,
@@ -868,7 +986,14 @@ class Executor : public StringDictionaryProxyProvider {
   CachedCardinality getCachedCardinality(const std::string& cache_key);
 
   mapd_shared_mutex& getDataRecyclerLock();
+  // Executor keeps per-query state, so queries sharing an executor are run one at a
+  // time. Use separate executors to run queries concurrently.
+  std::mutex& getQueryExecutionMutex() { return query_execution_mutex_; }
+  // Profile of the running query, null when the query is not profiled.
+  QueryProfile* getQueryProfile() const { return query_profile_; }
+  void setQueryProfile(QueryProfile* profile) { query_profile_ = profile; }
   QueryPlanDagCache& getQueryPlanDagCache();
+  ResultSetRecycler* getResultSetRecycler() const { return result_set_recycler_.get(); }
   JoinColumnsInfo getJoinColumnsInfo(const hdk::ir::Expr* join_expr,
                                      JoinColumnSide target_side,
                                      bool extract_only_col_id);
@@ -936,12 +1061,18 @@ class Executor : public StringDictionaryProxyProvider {
   class FetchCacheAnchor {
    public:
     FetchCacheAnchor(CgenState* cgen_state)
-        : cgen_state_(cgen_state), saved_fetch_cache(cgen_state_->fetch_cache_) {}
-    ~FetchCacheAnchor() { cgen_state_->fetch_cache_.swap(saved_fetch_cache); }
+        : cgen_state_(cgen_state)
+        , saved_fetch_cache(cgen_state_->fetch_cache_)
+        , saved_common_subexpr_cache(cgen_state_->common_subexpr_cache_) {}
+    ~FetchCacheAnchor() {
+      cgen_state_->fetch_cache_.swap(saved_fetch_cache);
+      cgen_state_->common_subexpr_cache_.swap(saved_common_subexpr_cache);
+    }
 
    private:
     CgenState* cgen_state_;
     std::unordered_map<int, std::vector<llvm::Value*>> saved_fetch_cache;
+    std::vector<CgenState::CommonSubexprValues> saved_common_subexpr_cache;
   };
 
   llvm::Value* spillDoubleElement(llvm::Value* elem_val, llvm::Type* elem_ty);
@@ -967,6 +1098,11 @@ class Executor : public StringDictionaryProxyProvider {
   static std::unique_ptr<CodeCacheAccessor<CpuCompilationContext>> cpu_code_accessor;
   static std::unique_ptr<CodeCacheAccessor<CompilationContext>> gpu_code_accessor;
   static size_t code_cache_size;  // for re-initializing code caches
+  static size_t gpu_code_cache_max_bytes;
+  // on-disk tier for CPU code, enabled by cache.persistent_code_cache_dir
+  static std::unique_ptr<PersistentCodeCache> persistent_code_cache;
+  // native binaries built from SPIR-V for L0 devices, persisted next to CPU code
+  static std::unique_ptr<L0BinaryCache> l0_binary_cache;
 
   static void
   resetCodeCache();  // ensure code cache is destroyed before tearing down data mgr
@@ -993,9 +1129,17 @@ class Executor : public StringDictionaryProxyProvider {
   // The active window function.
   WindowFunctionContext* active_window_function_{nullptr};
 
+  std::mutex async_compilation_mutex_;
+  std::unordered_set<CodeCacheKey, boost::hash<CodeCacheKey>> async_compilation_keys_;
+  threading::task_group async_compilation_tasks_;
+
   mutable InputTableInfoCache input_table_info_cache_;
   AggregatedColRange agg_col_range_cache_;
+  // column ranges computed by previous queries
+  ColumnRangeCache col_range_cache_;
   TableGenerations table_generations_;
+  // results of query steps executed by this executor
+  std::unique_ptr<ResultSetRecycler> result_set_recycler_;
 
   // for blocking executors for clear memory, etc
   static mapd_shared_mutex execute_mutex_;
@@ -1033,16 +1177,21 @@ class Executor : public StringDictionaryProxyProvider {
   //
   // to ensure thread safety.
   std::mutex compilation_mutex_;
+  std::mutex query_execution_mutex_;
+  QueryProfile* query_profile_{nullptr};
   const logger::ThreadId thread_id_;
 
+  // Run code compilation in background. Compilation results are expected to be
+  // published through code caches. Returns false if compilation for the key is
+  // already scheduled. Executor destruction waits for all scheduled compilations.
+  bool scheduleAsyncCompilation(const CodeCacheKey& key, std::function<void()> compile);
+
   // Runtime extension function registration updates
   // extension_modules_ that needs to be kept blocked from codegen
   // until the update is complete.
   // TODO(adb): move to ExtensionModuleContext?
   static std::shared_mutex register_runtime_extension_functions_mutex_;
 
-  static std::mutex kernel_mutex_;  // TODO: should this be executor-local mutex?
-
   static std::atomic<size_t> executor_id_ctr_;
 
   friend class BaselineJoinHashTable;
@@ -1062,6 +1211,7 @@ class Executor : public StringDictionaryProxyProvider {
   friend class StringDictionaryTranslationMgr;
   friend class LeafAggregator;
   friend class PerfectJoinHashTable;
+  friend class SortedJoinTable;
   friend class QueryRewriter;
   friend class PendingExecutionClosure;
   friend class RelAlgExecutor;
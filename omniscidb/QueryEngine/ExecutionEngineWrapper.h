@@ -21,6 +21,7 @@
 
 #include <llvm/ExecutionEngine/ExecutionEngine.h>
 #include <llvm/ExecutionEngine/JITEventListener.h>
+#include <llvm/ExecutionEngine/ObjectCache.h>
 #include <llvm/IR/Module.h>
 
 struct CompilationOptions;
@@ -46,7 +47,9 @@ class ORCJITExecutionEngineWrapper {
   ORCJITExecutionEngineWrapper(
       std::unique_ptr<llvm::orc::ExecutionSession>&& execution_session,
       llvm::orc::JITTargetMachineBuilder target_machine_builder,
-      std::unique_ptr<llvm::DataLayout> data_layout)
+      std::unique_ptr<llvm::DataLayout> data_layout,
+      llvm::ObjectCache* object_cache = nullptr,
+      bool register_jit_listeners = false)
       : execution_session_(std::move(execution_session))
       , data_layout_(std::move(data_layout))
       , mangle_(std::make_unique<llvm::orc::MangleAndInterner>(*this->execution_session_,
@@ -58,7 +61,8 @@ class ORCJITExecutionEngineWrapper {
             *execution_session_,
             *object_layer_,
             std::make_unique<llvm::orc::ConcurrentIRCompiler>(
-                std::move(target_machine_builder)))) {
+                std::move(target_machine_builder),
+                object_cache))) {
 #ifdef _WIN32
     object_layer_->setOverrideObjectFlagsWithResponsibilityFlags(true);
     object_layer_->setAutoClaimResponsibilityForObjectSymbols(true);
@@ -69,6 +73,9 @@ class ORCJITExecutionEngineWrapper {
                  << llvmErrorToString(dylib_or_error.takeError());
     }
     main_dylib_ = &(*dylib_or_error);
+    if (register_jit_listeners) {
+      registerJITEventListeners();
+    }
     dylib_or_error->addGenerator(
         llvm::cantFail(llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(
             data_layout_->getGlobalPrefix())));
@@ -115,12 +122,26 @@ class ORCJITExecutionEngineWrapper {
   ORCJITExecutionEngineWrapper& operator=(ORCJITExecutionEngineWrapper&& other) = delete;
 
  private:
+  // Listeners are null when LLVM is built without perf or VTune support.
+  void registerJITEventListeners() {
+    // The perf listener is a static instance which writes jit-<pid>.dump files for
+    // `perf inject --jit`.
+    if (auto perf_listener = llvm::JITEventListener::createPerfJITEventListener()) {
+      object_layer_->registerJITEventListener(*perf_listener);
+    }
+    intel_jit_listener_.reset(llvm::JITEventListener::createIntelJITEventListener());
+    if (intel_jit_listener_) {
+      object_layer_->registerJITEventListener(*intel_jit_listener_);
+    }
+  }
+
   std::unique_ptr<llvm::orc::ExecutionSession> execution_session_;
   std::unique_ptr<llvm::DataLayout> data_layout_;
   std::unique_ptr<llvm::orc::MangleAndInterner> mangle_;
+  // Notified when the object layer frees code, so it has to outlive the layer.
+  std::unique_ptr<llvm::JITEventListener> intel_jit_listener_;
   std::unique_ptr<llvm::orc::RTDyldObjectLinkingLayer> object_layer_;
   std::unique_ptr<llvm::orc::IRCompileLayer> compiler_layer_;
-  std::unique_ptr<llvm::JITEventListener> intel_jit_listener_;
 
   llvm::orc::JITDylib* main_dylib_;
 };
@@ -15,6 +15,7 @@
  */
 
 #include "QueryEngine/ExecutionKernel.h"
+#include "Logger/Trace.h"
 
 #include <mutex>
 #include <vector>
@@ -24,8 +25,12 @@
 #include "QueryEngine/Execute.h"
 #include "QueryEngine/ExternalExecutor.h"
 #include "QueryEngine/MemoryLayoutBuilder.h"
+#include "QueryEngine/ResultSetReduction.h"
+#include "QueryEngine/ResultSetReductionJIT.h"
 #include "QueryEngine/SerializeToSql.h"
+#include "QueryEngine/SharedScans.h"
 #include "ResultSet/RowSetMemoryOwner.h"
+#include "Shared/scope.h"
 
 namespace {
 
@@ -33,6 +38,31 @@ bool needs_skip_result(const ResultSetPtr& res) {
   return !res || res->definitelyHasNoRows();
 }
 
+// Size of input fragments processed by a kernel, used by the cost model.
+size_t get_fragments_bytes(const FragmentsList& frag_list,
+                           const std::vector<InputTableInfo>& query_infos) {
+  size_t bytes = 0;
+  for (const auto& frags : frag_list) {
+    auto info_it = std::find_if(
+        query_infos.begin(), query_infos.end(), [&frags](const InputTableInfo& info) {
+          return info.db_id == frags.db_id && info.table_id == frags.table_id;
+        });
+    if (info_it == query_infos.end()) {
+      continue;
+    }
+    const auto& fragments = info_it->info.fragments;
+    for (auto frag_id : frags.fragment_ids) {
+      if (frag_id < fragments.size()) {
+        for (const auto& [col_id, meta] :
+             fragments[frag_id].getChunkMetadataMapPhysical()) {
+          bytes += meta->numBytes();
+        }
+      }
+    }
+  }
+  return bytes;
+}
+
 inline bool query_has_inner_join(const RelAlgExecutionUnit& ra_exe_unit) {
   return (std::count_if(ra_exe_unit.join_quals.begin(),
                         ra_exe_unit.join_quals.end(),
@@ -107,6 +137,14 @@ const std::vector<uint64_t>& SharedKernelContext::getFragOffsets() {
 void SharedKernelContext::addDeviceResults(ResultSetPtr&& device_results,
                                            int outer_table_id,
                                            std::vector<size_t> outer_table_fragment_ids) {
+  if (streaming_reduction_executor_ && !needs_skip_result(device_results) &&
+      device_results->getStorage() &&
+      device_results->getQueryMemDesc().getQueryDescriptionType() ==
+          QueryDescriptionType::GroupByPerfectHash) {
+    device_results->setOuterTableId(outer_table_id);
+    streamReduce(std::move(device_results), std::move(outer_table_fragment_ids));
+    return;
+  }
   std::lock_guard<std::mutex> lock(reduce_mutex_);
   if (!needs_skip_result(device_results)) {
     device_results->setOuterTableId(outer_table_id);
@@ -115,8 +153,111 @@ void SharedKernelContext::addDeviceResults(ResultSetPtr&& device_results,
   }
 }
 
+// Reduces the result of a finished kernel with the result accumulated so far. The
+// accumulated result is taken out of the context for the reduction, so other kernels
+// finishing meanwhile start a new accumulated result and reductions run in parallel
+// in the kernel threads. The final pair of results is reduced by the last kernel.
+void SharedKernelContext::streamReduce(ResultSetPtr device_results,
+                                       std::vector<size_t> fragment_ids) {
+  auto timer = DEBUG_TIMER(__func__);
+  while (true) {
+    std::pair<ResultSetPtr, std::vector<size_t>> other;
+    {
+      std::lock_guard<std::mutex> lock(reduce_mutex_);
+      if (!streaming_result_.first) {
+        streaming_result_ = {std::move(device_results), std::move(fragment_ids)};
+        return;
+      }
+      std::swap(other, streaming_result_);
+    }
+    ResultSetReduction::reduce(*device_results->getStorage(),
+                               *other.first->getStorage(),
+                               {},
+                               getStreamingReductionCode(*device_results),
+                               streaming_reduction_executor_->getConfig(),
+                               streaming_reduction_executor_);
+    fragment_ids.insert(fragment_ids.end(), other.second.begin(), other.second.end());
+  }
+}
+
+const ReductionCode& SharedKernelContext::getStreamingReductionCode(
+    const ResultSet& result) {
+  std::call_once(streaming_reduction_code_flag_, [this, &result]() {
+    ResultSetReductionJIT reduction_jit(result.getQueryMemDesc(),
+                                        result.getTargetInfos(),
+                                        result.getTargetInitVals(),
+                                        streaming_reduction_executor_->getConfig(),
+                                        streaming_reduction_executor_);
+    streaming_reduction_code_ = std::make_shared<ReductionCode>(reduction_jit.codegen());
+  });
+  CHECK(streaming_reduction_code_);
+  return *streaming_reduction_code_;
+}
+
+void SharedKernelContext::setRowLimit(size_t row_limit) {
+  CHECK(!query_infos_.empty());
+  row_limit_ = row_limit;
+  fragment_rows_.assign(query_infos_.front().info.fragments.size(), -1);
+}
+
+void SharedKernelContext::addFragmentRows(size_t outer_frag_id, size_t row_count) {
+  std::lock_guard<std::mutex> lock(fragment_rows_mutex_);
+  CHECK_LT(outer_frag_id, fragment_rows_.size());
+  fragment_rows_[outer_frag_id] = static_cast<int64_t>(row_count);
+  while (known_rows_ < row_limit_ && known_fragments_ < fragment_rows_.size() &&
+         fragment_rows_[known_fragments_] >= 0) {
+    known_rows_ += fragment_rows_[known_fragments_++];
+  }
+  if (known_rows_ >= row_limit_) {
+    row_limit_frag_count_.store(known_fragments_, std::memory_order_release);
+  }
+}
+
+bool SharedKernelContext::addCpuRetryKernel(const ExecutionKernel* kernel) {
+  if (!cpu_retry_enabled_ || kernel->getDeviceType() != ExecutorDeviceType::GPU) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(cpu_retry_kernels_mutex_);
+  cpu_retry_kernels_.push_back(kernel);
+  return true;
+}
+
+std::vector<const ExecutionKernel*> SharedKernelContext::takeCpuRetryKernels() {
+  std::lock_guard<std::mutex> lock(cpu_retry_kernels_mutex_);
+  std::vector<const ExecutionKernel*> res;
+  res.swap(cpu_retry_kernels_);
+  return res;
+}
+
+bool SharedKernelContext::deferIfPreempted(std::function<void()> task) {
+  if (!admission_ticket_ ||
+      !QueryScheduler::get().preempt(*scheduler_config_, *admission_ticket_)) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(deferred_tasks_mutex_);
+  deferred_tasks_.emplace_back(std::move(task));
+  return true;
+}
+
+std::vector<std::function<void()>> SharedKernelContext::takeDeferredTasks() {
+  std::lock_guard<std::mutex> lock(deferred_tasks_mutex_);
+  std::vector<std::function<void()>> res;
+  res.swap(deferred_tasks_);
+  return res;
+}
+
+void SharedKernelContext::resumePreempted() {
+  CHECK(admission_ticket_);
+  QueryScheduler::get().resume(*scheduler_config_, *admission_ticket_);
+}
+
 std::vector<std::pair<ResultSetPtr, std::vector<size_t>>>&
 SharedKernelContext::getFragmentResults() {
+  std::lock_guard<std::mutex> lock(reduce_mutex_);
+  if (streaming_result_.first) {
+    all_fragment_results_.emplace_back(std::move(streaming_result_));
+    streaming_result_ = {};
+  }
   return all_fragment_results_;
 }
 
@@ -158,6 +299,7 @@ void ExecutionKernel::runImpl(Executor* executor,
                               const size_t thread_idx,
                               SharedKernelContext& shared_context) {
   CHECK(executor);
+  auto clock_begin = timer_start();
   const auto memory_level = chosen_device_type == ExecutorDeviceType::GPU
                                 ? Data_Namespace::GPU_LEVEL
                                 : Data_Namespace::CPU_LEVEL;
@@ -168,6 +310,36 @@ void ExecutionKernel::runImpl(Executor* executor,
                                  : ra_exe_unit_.input_descs[0].getTableId();
   CHECK_EQ(frag_list[0].table_id, outer_table_id);
   const auto& outer_tab_frag_ids = frag_list[0].fragment_ids;
+  if (auto shared_scan = shared_context.getSharedScan()) {
+    CHECK(!outer_tab_frag_ids.empty());
+    shared_scan->advance(outer_tab_frag_ids.front());
+  }
+
+  const bool track_row_limit =
+      shared_context.hasRowLimit() &&
+      kernel_dispatch_mode == ExecutorDispatchMode::KernelPerFragment &&
+      outer_tab_frag_ids.size() == 1;
+  if (track_row_limit && shared_context.isRowLimitReached(outer_tab_frag_ids.front())) {
+    VLOG(1) << "Skip fragment " << outer_tab_frag_ids.front()
+            << ", preceding fragments produced enough rows for LIMIT.";
+    return;
+  }
+  const int trace_track = chosen_device_type == ExecutorDeviceType::GPU
+                              ? trace::gpuTrack(chosen_device_id)
+                              : trace::kHostTrack;
+  trace::Scope kernel_trace("kernel", "kernel", trace_track);
+  if (kernel_trace.active()) {
+    kernel_trace.addArg("device", toString() + std::to_string(chosen_device_id));
+    kernel_trace.addArg("fragments", ::toString(outer_tab_frag_ids));
+  }
+  // Kernels which produce no result report zero rows. Rows of an external executor
+  // are not counted, which only makes skipping more conservative.
+  size_t produced_rows = 0;
+  ScopeGuard row_limit_guard = [&]() {
+    if (track_row_limit) {
+      shared_context.addFragmentRows(outer_tab_frag_ids.front(), produced_rows);
+    }
+  };
 
   CHECK_GE(chosen_device_id, 0);
   CHECK_LT(chosen_device_id, Executor::max_gpu_count);
@@ -180,13 +352,24 @@ void ExecutionKernel::runImpl(Executor* executor,
   std::list<std::shared_ptr<Chunk_NS::Chunk>> chunks;
   std::unique_ptr<std::lock_guard<std::mutex>> gpu_lock;
   std::unique_ptr<GpuAllocator> device_allocator;
+  const bool overlap_gpu_transfers =
+      executor->getConfig().exec.enable_gpu_transfer_overlap;
   if (chosen_device_type == ExecutorDeviceType::GPU) {
-    gpu_lock.reset(
-        new std::lock_guard<std::mutex>(executor->gpu_exec_mutex_[chosen_device_id]));
+    if (!overlap_gpu_transfers) {
+      gpu_lock.reset(
+          new std::lock_guard<std::mutex>(executor->gpu_exec_mutex_[chosen_device_id]));
+    }
     device_allocator = std::make_unique<GpuAllocator>(buffer_provider, chosen_device_id);
+    if (auto row_set_mem_owner = executor->getRowSetMemoryOwner()) {
+      device_allocator->setMemoryTracker(row_set_mem_owner->getMemoryTracker());
+    }
   }
   std::shared_ptr<FetchResult> fetch_result(new FetchResult);
+  auto query_profile = executor->getQueryProfile();
+  KernelProfile kernel_profile;
   try {
+    auto fetch_clock = timer_start();
+    trace::Scope fetch_trace("fetch", "fetch", trace_track);
     std::map<TableRef, const TableFragments*> all_tables_fragments;
     TableFragments streaming_table_fragment;
     QueryFragmentDescriptor::computeAllTablesFragments(
@@ -225,7 +408,11 @@ void ExecutionKernel::runImpl(Executor* executor,
                                                 chunks,
                                                 device_allocator.get(),
                                                 thread_idx,
-                                                eo.allow_runtime_query_interrupt);
+                                                eo.allow_runtime_query_interrupt,
+                                                &query_comp_desc.getColumnEncodings());
+    kernel_profile.fetch_time =
+        timer_stop<decltype(fetch_clock), std::chrono::microseconds>(fetch_clock);
+    fetch_trace.finish();
     if (fetch_result->num_rows.empty()) {
       return;
     }
@@ -247,6 +434,13 @@ void ExecutionKernel::runImpl(Executor* executor,
     return;
   }
 
+  if (chosen_device_type == ExecutorDeviceType::GPU && overlap_gpu_transfers) {
+    // Inputs are fetched without holding the device lock, so copying them to the
+    // device overlaps with a kernel executed on the device by another thread.
+    gpu_lock.reset(
+        new std::lock_guard<std::mutex>(executor->gpu_exec_mutex_[chosen_device_id]));
+  }
+
   if (eo.executor_type == ExecutorType::Extern) {
     if (ra_exe_unit_.input_descs.size() > 1) {
       throw std::runtime_error("Joins not supported through external execution");
@@ -341,7 +535,8 @@ void ExecutionKernel::runImpl(Executor* executor,
   // result sets. Can we simply do it once and holdin an outer structure?
   if (can_run_subkernels) {
     size_t total_rows = fetch_result->num_rows[0][0];
-    size_t sub_size = executor->getConfig().exec.sub_tasks.sub_task_size;
+    size_t sub_size = shared_context.getSubTaskSize();
+    CHECK_GT(sub_size, size_t(0));
     for (size_t sub_start = start_rowid; sub_start < total_rows; sub_start += sub_size) {
       sub_size = (sub_start + sub_size > total_rows) ? total_rows - sub_start : sub_size;
       auto subtask = std::make_shared<KernelSubtask>(*this,
@@ -352,8 +547,12 @@ void ExecutionKernel::runImpl(Executor* executor,
                                                      sub_start,
                                                      sub_size,
                                                      thread_idx);
-      shared_context.getThreadPool()->run(
-          [subtask, executor] { subtask->run(executor); });
+      shared_context.getThreadPool()->run([subtask, executor, &shared_context] {
+        auto task = [subtask, executor] { subtask->run(executor); };
+        if (!shared_context.deferIfPreempted(task)) {
+          task();
+        }
+      });
     }
 
     return;
@@ -384,6 +583,8 @@ void ExecutionKernel::runImpl(Executor* executor,
   CHECK(query_exe_context);
   int32_t err{0};
 
+  auto execution_clock = timer_start();
+  trace::Scope execution_trace("execute", "kernel", trace_track);
   if (ra_exe_unit_.groupby_exprs.empty()) {
     err = executor->executePlan(ra_exe_unit_,
                                 compilation_result,
@@ -427,6 +628,7 @@ void ExecutionKernel::runImpl(Executor* executor,
                                 ra_exe_unit_.input_descs.size(),
                                 eo.allow_runtime_query_interrupt);
   }
+  execution_trace.finish();
   if (device_results_) {
     std::list<std::shared_ptr<Chunk_NS::Chunk>> chunks_to_hold;
     for (const auto& chunk : chunks) {
@@ -445,8 +647,37 @@ void ExecutionKernel::runImpl(Executor* executor,
   if (err) {
     throw QueryExecutionError(err);
   }
+  if (track_row_limit && device_results_) {
+    produced_rows = device_results_->rowCount();
+  }
+  if (query_profile) {
+    kernel_profile.device_type = chosen_device_type;
+    kernel_profile.device_id = chosen_device_id;
+    kernel_profile.fragment_ids = outer_tab_frag_ids;
+    kernel_profile.execution_time =
+        timer_stop<decltype(execution_clock), std::chrono::microseconds>(
+            execution_clock);
+    for (const auto& frag_num_rows : fetch_result->num_rows) {
+      kernel_profile.input_rows += frag_num_rows.empty() ? 0 : frag_num_rows.front();
+    }
+    kernel_profile.output_rows = device_results_ ? device_results_->rowCount() : 0;
+    query_profile->addKernel(std::move(kernel_profile));
+  }
   shared_context.addDeviceResults(
       std::move(device_results_), outer_table_id, outer_tab_frag_ids);
+
+  if (ra_exe_unit_.cost_model && ra_exe_unit_.cost_model->collectsRuntimeMeasurements()) {
+    // Measurements shorter than a millisecond carry no information for the model.
+    const auto ms = timer_stop(clock_begin);
+    if (ms > 0) {
+      ra_exe_unit_.cost_model->addRuntimeMeasurement(
+          chosen_device_type,
+          ra_exe_unit_.templs,
+          get_fragments_bytes(frag_list, shared_context.getQueryInfos()),
+          ms,
+          ra_exe_unit_.features);
+    }
+  }
 }
 
 #ifdef HAVE_TBB
@@ -522,6 +753,18 @@ void KernelSubtask::runImpl(Executor* executor) {
   CHECK(query_exe_context);
   int32_t err{0};
 
+  auto execution_clock = timer_start();
+  trace::Scope subtask_trace("subtask",
+                             "kernel",
+                             kernel_.chosen_device_type == ExecutorDeviceType::GPU
+                                 ? trace::gpuTrack(kernel_.chosen_device_id)
+                                 : trace::kHostTrack);
+  if (subtask_trace.active()) {
+    subtask_trace.addArg("fragments", ::toString(outer_tab_frag_ids));
+    subtask_trace.addArg("rows",
+                         std::to_string(start_rowid_) + "-" +
+                             std::to_string(start_rowid_ + num_rows_to_process_));
+  }
   if (kernel_.ra_exe_unit_.groupby_exprs.empty()) {
     err = executor->executePlan(kernel_.ra_exe_unit_,
                                 compilation_result,
@@ -567,6 +810,18 @@ void KernelSubtask::runImpl(Executor* executor) {
   if (err) {
     throw QueryExecutionError(err);
   }
+  // Sub-tasks write to shared output buffers, so only their input rows are known.
+  if (auto query_profile = executor->getQueryProfile()) {
+    KernelProfile kernel_profile;
+    kernel_profile.device_type = kernel_.chosen_device_type;
+    kernel_profile.device_id = kernel_.chosen_device_id;
+    kernel_profile.fragment_ids = outer_tab_frag_ids;
+    kernel_profile.execution_time =
+        timer_stop<decltype(execution_clock), std::chrono::microseconds>(
+            execution_clock);
+    kernel_profile.input_rows = num_rows_to_process_;
+    query_profile->addKernel(std::move(kernel_profile));
+  }
 }
 
 #endif  // HAVE_TBB
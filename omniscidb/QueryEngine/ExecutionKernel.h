@@ -19,6 +19,7 @@
 #include "Logger/Logger.h"
 #include "QueryEngine/ColumnFetcher.h"
 #include "QueryEngine/Descriptors/QueryCompilationDescriptor.h"
+#include "QueryEngine/QueryScheduler.h"
 
 #include "Compiler/Backend.h"
 #include "Shared/threading.h"
@@ -27,6 +28,14 @@
 #include "tbb/enumerable_thread_specific.h"
 #endif
 
+#include <atomic>
+#include <functional>
+#include <limits>
+
+struct ReductionCode;
+class ExecutionKernel;
+class SharedScan;
+
 class SharedKernelContext {
  public:
   SharedKernelContext(const std::vector<InputTableInfo>& query_infos)
@@ -45,10 +54,54 @@ class SharedKernelContext {
 
   std::vector<std::pair<ResultSetPtr, std::vector<size_t>>>& getFragmentResults();
 
+  // Makes kernels reduce their results into a single result as soon as they
+  // finish, overlapping the reduction with the execution of other kernels. Only
+  // results with no collisions (perfect hash group by) are reduced this way.
+  void enableStreamingReduction(Executor* executor) {
+    streaming_reduction_executor_ = executor;
+  }
+  bool hasStreamingReduction() const { return streaming_reduction_executor_; }
+
   const std::vector<InputTableInfo>& getQueryInfos() const {
     return query_infos_;
   }
 
+  // Makes kernels skip outer fragments following a prefix of fragments which has
+  // already produced row_limit rows. Used for projections with LIMIT and no ORDER BY:
+  // their results are ordered by fragment ids, so rows of the skipped fragments would
+  // be cut by LIMIT anyway.
+  void setRowLimit(size_t row_limit);
+  bool hasRowLimit() const { return row_limit_ != 0; }
+  bool isRowLimitReached(size_t outer_frag_id) const {
+    return outer_frag_id >= row_limit_frag_count_.load(std::memory_order_acquire);
+  }
+  void addFragmentRows(size_t outer_frag_id, size_t row_count);
+
+  // Scan shared with concurrent queries over the outer table. Kernels report their
+  // outer fragments to it when started.
+  void setSharedScan(SharedScan* scan) { shared_scan_ = scan; }
+  SharedScan* getSharedScan() const { return shared_scan_; }
+
+  // Makes GPU kernels which run out of memory be recorded for re-execution on CPU
+  // instead of failing the step. Results of other kernels are kept.
+  void enableCpuRetry() { cpu_retry_enabled_ = true; }
+  // Returns false if the kernel can't be retried on CPU.
+  bool addCpuRetryKernel(const ExecutionKernel* kernel);
+  std::vector<const ExecutionKernel*> takeCpuRetryKernels();
+
+  // Admission ticket of the query. When the scheduler preempts the query, kernels and
+  // sub-tasks not started yet are deferred until the launching thread resumes it.
+  void setAdmissionTicket(const QuerySchedulerConfig* config,
+                          QueryScheduler::Ticket* ticket) {
+    scheduler_config_ = config;
+    admission_ticket_ = ticket;
+  }
+  // Returns true if the task was deferred because the query is preempted.
+  bool deferIfPreempted(std::function<void()> task);
+  std::vector<std::function<void()>> takeDeferredTasks();
+  // Blocks until the preempted query is resumed.
+  void resumePreempted();
+
   std::atomic_flag dynamic_watchdog_set = ATOMIC_FLAG_INIT;
 
 #ifdef HAVE_TBB
@@ -61,18 +114,55 @@ class SharedKernelContext {
   auto& getTlsExecutionContext() {
     return tls_execution_context_;
   }
+  size_t getSubTaskSize() const {
+    return sub_task_size_;
+  }
+  void setSubTaskSize(size_t size) {
+    sub_task_size_ = size;
+  }
 #endif  // HAVE_TBB
 
  private:
   std::mutex reduce_mutex_;
   std::vector<std::pair<ResultSetPtr, std::vector<size_t>>> all_fragment_results_;
 
+  void streamReduce(ResultSetPtr device_results, std::vector<size_t> fragment_ids);
+  const ReductionCode& getStreamingReductionCode(const ResultSet& result);
+
+  Executor* streaming_reduction_executor_{nullptr};
+  SharedScan* shared_scan_{nullptr};
+  // Result of the streaming reduction, moved to all_fragment_results_ when all
+  // kernels are done.
+  std::pair<ResultSetPtr, std::vector<size_t>> streaming_result_;
+  std::shared_ptr<ReductionCode> streaming_reduction_code_;
+  std::once_flag streaming_reduction_code_flag_;
+
   std::vector<uint64_t> all_frag_row_offsets_;
   std::mutex all_frag_row_offsets_mutex_;
+
+  size_t row_limit_{0};
+  // Row counts of executed outer fragments, -1 for fragments not executed yet.
+  std::vector<int64_t> fragment_rows_;
+  // Number of leading fragments with known row counts and their total row count.
+  size_t known_fragments_{0};
+  size_t known_rows_{0};
+  std::atomic<size_t> row_limit_frag_count_{std::numeric_limits<size_t>::max()};
+  std::mutex fragment_rows_mutex_;
+
+  bool cpu_retry_enabled_{false};
+  std::vector<const ExecutionKernel*> cpu_retry_kernels_;
+  std::mutex cpu_retry_kernels_mutex_;
+
+  const QuerySchedulerConfig* scheduler_config_{nullptr};
+  QueryScheduler::Ticket* admission_ticket_{nullptr};
+  std::vector<std::function<void()>> deferred_tasks_;
+  std::mutex deferred_tasks_mutex_;
   std::vector<InputTableInfo> query_infos_;
 
 #ifdef HAVE_TBB
   threading::task_group* task_group_;
+  // Number of rows processed by a single sub-task (morsel).
+  size_t sub_task_size_{0};
   tbb::enumerable_thread_specific<std::unique_ptr<QueryExecutionContext>>
       tls_execution_context_;
 #endif  // HAVE_TBB
@@ -107,6 +197,29 @@ class ExecutionKernel {
            const size_t thread_idx,
            SharedKernelContext& shared_context);
 
+  ExecutorDeviceType getDeviceType() const { return chosen_device_type; }
+  int getDeviceId() const { return chosen_device_id; }
+  const FragmentsList& getFragments() const { return frag_list; }
+
+  // Make a kernel processing the same fragments on another device.
+  std::unique_ptr<ExecutionKernel> retarget(
+      const ExecutorDeviceType device_type,
+      const int device_id,
+      const QueryCompilationDescriptor& query_comp_desc,
+      const QueryMemoryDescriptor& query_mem_desc) const {
+    return std::make_unique<ExecutionKernel>(ra_exe_unit_,
+                                             device_type,
+                                             device_id,
+                                             co,
+                                             eo,
+                                             column_fetcher,
+                                             query_comp_desc,
+                                             query_mem_desc,
+                                             frag_list,
+                                             kernel_dispatch_mode,
+                                             rowid_lookup_key);
+  }
+
   const RelAlgExecutionUnit& ra_exe_unit_;
 
   std::string toString() const;
@@ -536,6 +536,13 @@ ExpressionRange getLeafColumnRange(const hdk::ir::ColumnVar* col_expr,
     case hdk::ir::Type::kDate:
     case hdk::ir::Type::kExtDictionary:
     case hdk::ir::Type::kFloatingPoint: {
+      // Stream tables get new data after the query is compiled, the current metadata
+      // doesn't bound its values.
+      auto table_info = executor->getSchemaProvider()->getTableInfo(
+          col_expr->dbId(), col_expr->tableId());
+      if (table_info && table_info->is_stream) {
+        return ExpressionRange::makeInvalidRange();
+      }
       std::optional<size_t> ti_idx;
       for (size_t i = 0; i < query_infos.size(); ++i) {
         if (col_expr->tableId() == query_infos[i].table_id &&
@@ -809,11 +816,26 @@ ExpressionRange getExpressionRange(
         auto type_scale = type->as<hdk::ir::DecimalType>()->scale();
         auto arg_scale =
             arg_type->isDecimal() ? arg_type->as<hdk::ir::DecimalType>()->scale() : 0;
+        if (type_scale < arg_scale) {
+          // Rounded scale down, extend the range by a half to stay conservative.
+          const int64_t scale = exp_to_scale(arg_scale - type_scale);
+          const int64_t scale_half = scale / 2;
+          return ExpressionRange::makeIntRange(
+              (arg_range.getIntMin() - scale_half) / scale,
+              (arg_range.getIntMax() + scale_half) / scale,
+              0,
+              arg_range.hasNulls());
+        }
         const int64_t scale = exp_to_scale(type_scale - arg_scale);
-        return ExpressionRange::makeIntRange(arg_range.getIntMin() * scale,
-                                             arg_range.getIntMax() * scale,
-                                             0,
-                                             arg_range.hasNulls());
+        try {
+          return ExpressionRange::makeIntRange(
+              int64_t(checked_int64_t(arg_range.getIntMin()) * scale),
+              int64_t(checked_int64_t(arg_range.getIntMax()) * scale),
+              0,
+              arg_range.hasNulls());
+        } catch (...) {
+          return ExpressionRange::makeInvalidRange();
+        }
       }
       if (arg_type->isDecimal()) {
         CHECK_EQ(int64_t(0), arg_range.getBucket());
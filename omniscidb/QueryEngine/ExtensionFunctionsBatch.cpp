@@ -0,0 +1,102 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/ExtensionFunctionsBatch.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "Logger/Logger.h"
+
+namespace {
+
+constexpr int64_t kMinBatchRows = 16;
+constexpr int64_t kMaxBatchRows = 1024;
+constexpr size_t kMaxCachedBatches = 64;
+
+struct BatchResults {
+  int8_t* func;
+  std::vector<const int8_t*> cols;
+  std::vector<const int8_t*> batch_cols;
+  std::vector<int8_t> out;
+  int64_t start{0};
+  int64_t end{0};
+  // Number of calls served from the current batch and the size of the next batch.
+  int64_t used_rows{0};
+  int64_t batch_rows{kMinBatchRows};
+};
+
+thread_local std::vector<BatchResults> batch_results_cache;
+
+BatchResults& get_batch_results(int8_t* func,
+                                const int8_t** cols,
+                                const int32_t num_cols,
+                                const int32_t ret_width) {
+  for (auto& results : batch_results_cache) {
+    if (results.func == func &&
+        std::equal(results.cols.begin(), results.cols.end(), cols, cols + num_cols)) {
+      return results;
+    }
+  }
+  if (batch_results_cache.size() >= kMaxCachedBatches) {
+    batch_results_cache.clear();
+  }
+  auto& results = batch_results_cache.emplace_back();
+  results.func = func;
+  results.cols.assign(cols, cols + num_cols);
+  results.batch_cols.resize(num_cols);
+  results.out.resize(kMaxBatchRows * ret_width);
+  return results;
+}
+
+}  // namespace
+
+extern "C" RUNTIME_EXPORT int8_t* batch_ext_func_result(int8_t* func,
+                                                        const int8_t** cols,
+                                                        const int32_t* col_widths,
+                                                        const int32_t num_cols,
+                                                        const int32_t ret_width,
+                                                        const int64_t pos,
+                                                        const int64_t num_rows) {
+  auto& results = get_batch_results(func, cols, num_cols, ret_width);
+  if (pos >= results.start && pos < results.end) {
+    ++results.used_rows;
+    return results.out.data() + (pos - results.start) * ret_width;
+  }
+  if (results.end > results.start) {
+    // Keep growing batches while most of their rows reach the call, and shrink them
+    // when a filter drops most rows before it, so that the function isn't computed
+    // for rows which don't need it.
+    if (results.used_rows * 2 >= results.end - results.start) {
+      results.batch_rows = std::min(results.batch_rows * 2, kMaxBatchRows);
+    } else {
+      results.batch_rows = std::max(results.batch_rows / 2, int64_t(1));
+    }
+  }
+  CHECK_LT(pos, num_rows);
+  const auto batch_rows = std::min(results.batch_rows, num_rows - pos);
+  for (int32_t i = 0; i < num_cols; ++i) {
+    results.batch_cols[i] = cols[i] + pos * col_widths[i];
+  }
+  reinterpret_cast<BatchExtFunc>(func)(
+      results.batch_cols.data(), batch_rows, results.out.data());
+  results.start = pos;
+  results.end = pos + batch_rows;
+  results.used_rows = 1;
+  return results.out.data();
+}
+
+void reset_batch_ext_func_cache() {
+  batch_results_cache.clear();
+}
@@ -0,0 +1,57 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file    ExtensionFunctionsBatch.h
+ * @brief   Runtime support for calling batch implementations of extension functions
+ * from CPU kernels.
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "Shared/funcannotations.h"
+
+/**
+ * Batch implementations of extension functions use a fixed calling convention:
+ *
+ *   void name(const int8_t* const* cols, const int64_t num_rows, int8_t* out);
+ *
+ * `cols` holds a pointer to the first row of the batch for each argument column,
+ * `num_rows` is the number of rows in the batch, and the result for row i is written
+ * to out[i] as a value of the function return type. Arguments are passed as stored
+ * in the column, including NULL sentinels; results for rows with NULL arguments are
+ * ignored.
+ *
+ * Generated code asks for the result of the current row, and the batch implementation
+ * runs once for a batch of rows starting at it. Results are cached per thread, the
+ * cache is dropped when a CPU kernel starts.
+ */
+using BatchExtFunc = void (*)(const int8_t* const* cols,
+                              const int64_t num_rows,
+                              int8_t* out);
+
+// Returns a pointer to the result of `func` for row `pos` of the fragment with
+// `num_rows` rows, computing the results for a batch of rows if they aren't cached.
+extern "C" RUNTIME_EXPORT int8_t* batch_ext_func_result(int8_t* func,
+                                                        const int8_t** cols,
+                                                        const int32_t* col_widths,
+                                                        const int32_t num_cols,
+                                                        const int32_t ret_width,
+                                                        const int64_t pos,
+                                                        const int64_t num_rows);
+
+void reset_batch_ext_func_cache();
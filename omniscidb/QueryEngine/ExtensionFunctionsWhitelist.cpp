@@ -56,7 +56,9 @@ std::vector<ExtensionFunction> ExtensionFunctionsWhitelist::get_ext_funcs(
     std::copy_if(ext_func_sigs.begin(),
                  ext_func_sigs.end(),
                  std::back_inserter(ext_funcs),
-                 [is_gpu](auto sig) { return (is_gpu ? sig.isGPU() : sig.isCPU()); });
+                 [is_gpu](auto sig) {
+                   return !sig.isBatch() && (is_gpu ? sig.isGPU() : sig.isCPU());
+                 });
   }
   return ext_funcs;
 }
@@ -76,7 +78,9 @@ std::vector<ExtensionFunction> ExtensionFunctionsWhitelist::get_ext_funcs(
     std::copy_if(ext_func_sigs.begin(),
                  ext_func_sigs.end(),
                  std::back_inserter(ext_funcs),
-                 [arity](auto sig) { return arity == sig.getArgs().size(); });
+                 [arity](auto sig) {
+                   return !sig.isBatch() && arity == sig.getArgs().size();
+                 });
   }
   return ext_funcs;
 }
@@ -105,7 +109,7 @@ std::vector<ExtensionFunction> ExtensionFunctionsWhitelist::get_ext_funcs(
           // with multiple arguments, for instance, array
           // argument is translated to data pointer and array
           // size arguments.
-          if (arity > sig.getArgs().size()) {
+          if (sig.isBatch() || arity > sig.getArgs().size()) {
             return false;
           }
           auto stype = ext_arg_type_to_type(rtype->ctx(), sig.getRet());
@@ -115,6 +119,25 @@ std::vector<ExtensionFunction> ExtensionFunctionsWhitelist::get_ext_funcs(
   return ext_funcs;
 }
 
+std::optional<ExtensionFunction> ExtensionFunctionsWhitelist::get_batch_ext_func(
+    const ExtensionFunction& ext_func) {
+  const auto collections = {&functions_, &udf_functions_, &rt_udf_functions_};
+  const auto uname = to_upper(ext_func.getName(/*keep_suffix=*/false));
+  for (auto funcs : collections) {
+    const auto it = funcs->find(uname);
+    if (it == funcs->end()) {
+      continue;
+    }
+    for (const auto& sig : it->second) {
+      if (sig.isBatch() && sig.getRet() == ext_func.getRet() &&
+          sig.getArgs() == ext_func.getArgs()) {
+        return sig;
+      }
+    }
+  }
+  return std::nullopt;
+}
+
 namespace {
 
 // Returns the LLVM name for `type`.
@@ -460,6 +483,12 @@ std::vector<std::string> ExtensionFunctionsWhitelist::getLLVMDeclarations(
         continue;
       }
 
+      if (signature.isBatch()) {
+        declarations.push_back("declare void @" + signature.getName() +
+                               "(i8**, i64, i8*);");
+        continue;
+      }
+
       std::string decl_prefix;
       std::vector<std::string> arg_strs;
       if (is_ext_arg_type_array(signature.getRet())) {
@@ -632,8 +661,10 @@ void ExtensionFunctionsWhitelist::addCommon(SignatureMap& signatures,
          ++args_serialized_it) {
       args.push_back(deserialize_type(json_str(*args_serialized_it)));
     }
+    const bool is_batch =
+        func_sigs_it->HasMember("batch") && json_bool(field(*func_sigs_it, "batch"));
     signatures[to_upper(ExtensionFunction::drop_suffix(name))].emplace_back(
-        name, args, ret);
+        name, args, ret, is_batch);
   }
 }
 
@@ -653,6 +684,9 @@ void ExtensionFunctionsWhitelist::add(const std::string& json_func_sigs) {
   //       ]
   //    }
   // ]
+  //
+  // An optional "batch": true marks a batch implementation of the row-wise function
+  // with the same name prefix, arguments and return type.
 
   addCommon(functions_, json_func_sigs);
 }
@@ -673,6 +707,17 @@ void ExtensionFunctionsWhitelist::addRTUdfs(const std::string& json_func_sigs) {
   }
 }
 
+std::vector<ExtensionFunction> ExtensionFunctionsWhitelist::getRTUdfs() {
+  std::vector<ExtensionFunction> res;
+  for (const auto& [name, sigs] : rt_udf_functions_) {
+    std::copy_if(sigs.begin(),
+                 sigs.end(),
+                 std::back_inserter(res),
+                 [](const auto& sig) { return !sig.isBatch(); });
+  }
+  return res;
+}
+
 std::unordered_map<std::string, std::vector<ExtensionFunction>>
     ExtensionFunctionsWhitelist::functions_;
 
@@ -25,6 +25,7 @@
 #ifndef QUERYENGINE_EXTENSIONFUNCTIONSWHITELIST_H
 #define QUERYENGINE_EXTENSIONFUNCTIONSWHITELIST_H
 
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -86,8 +87,9 @@ class ExtensionFunction {
  public:
   ExtensionFunction(const std::string& name,
                     const std::vector<ExtArgumentType>& args,
-                    const ExtArgumentType ret)
-      : name_(name), args_(args), ret_(ret) {}
+                    const ExtArgumentType ret,
+                    const bool is_batch = false)
+      : name_(name), args_(args), ret_(ret), is_batch_(is_batch) {}
 
   const std::string getName(bool keep_suffix = true) const {
     return (keep_suffix ? name_ : drop_suffix(name_));
@@ -101,11 +103,15 @@ class ExtensionFunction {
   std::string toStringSQL() const;
 
   inline bool isGPU() const {
-    return (name_.find("_cpu_", name_.find("__")) == std::string::npos);
+    return !is_batch_ && (name_.find("_cpu_", name_.find("__")) == std::string::npos);
   }
   inline bool isCPU() const {
     return (name_.find("_gpu_", name_.find("__")) == std::string::npos);
   }
+  // Batch implementations take the arguments of a whole batch of rows at once, see
+  // ExtensionFunctionsBatch.h. They are never bound to a call directly, but replace
+  // the row-wise function with the same arguments and return type in CPU code.
+  inline bool isBatch() const { return is_batch_; }
 
   static std::string drop_suffix(const std::string& str) {
     const auto idx = str.find("__");
@@ -120,6 +126,7 @@ class ExtensionFunction {
   const std::string name_;
   const std::vector<ExtArgumentType> args_;
   const ExtArgumentType ret_;
+  const bool is_batch_;
 };
 
 class ExtensionFunctionsWhitelist {
@@ -130,6 +137,8 @@ class ExtensionFunctionsWhitelist {
 
   static void clearRTUdfs();
   static void addRTUdfs(const std::string& json_func_sigs);
+  // Returns the row-wise runtime UDFs, the ones which can be bound to calls in queries.
+  static std::vector<ExtensionFunction> getRTUdfs();
 
   static std::vector<ExtensionFunction>* get(const std::string& name);
 
@@ -145,6 +154,11 @@ class ExtensionFunctionsWhitelist {
                                                       size_t arity,
                                                       const hdk::ir::Type* rtype);
 
+  // Returns the batch implementation of the given row-wise extension function, if one
+  // is registered.
+  static std::optional<ExtensionFunction> get_batch_ext_func(
+      const ExtensionFunction& ext_func);
+
   static std::string toString(const std::vector<ExtensionFunction>& ext_funcs,
                               std::string tab = "");
   static std::string toString(const std::vector<const hdk::ir::Type*>& arg_types);
@@ -353,8 +353,14 @@ llvm::Value* CodeGenerator::codegenFunctionOper(
     args.insert(args.begin(), buffer_ret);
   }
 
-  const auto ext_call = cgen_state_->emitExternalCall(
-      ext_func_sig.getName(), ret_ty, args, {}, ret_type->isBuffer());
+  llvm::Value* ext_call =
+      ret_type->isBuffer()
+          ? nullptr
+          : codegenBatchFunctionOper(function_oper, ext_func_sig, ret_ty, co);
+  if (!ext_call) {
+    ext_call = cgen_state_->emitExternalCall(
+        ext_func_sig.getName(), ret_ty, args, {}, ret_type->isBuffer());
+  }
   auto ext_call_nullcheck = endArgsNullcheck(bbs,
                                              ret_type->isBuffer() ? buffer_ret : ext_call,
                                              null_buffer_ptr,
@@ -386,6 +392,96 @@ llvm::Value* CodeGenerator::codegenFunctionOper(
   return ext_call_nullcheck;
 }
 
+llvm::Value* CodeGenerator::codegenBatchFunctionOper(
+    const hdk::ir::FunctionOper* function_oper,
+    const ExtensionFunction& ext_func_sig,
+    llvm::Type* ret_ty,
+    const CompilationOptions& co) {
+  AUTOMATIC_IR_METADATA(cgen_state_);
+  if (co.device_type != ExecutorDeviceType::CPU ||
+      !config_.exec.codegen.enable_batch_ext_funcs || !executor_ || !plan_state_ ||
+      ret_ty->isVoidTy() || ext_func_sig.getArgs().size() != function_oper->arity()) {
+    return nullptr;
+  }
+  if (WindowProjectNodeContext::getActiveWindowFunctionContext(executor())) {
+    return nullptr;
+  }
+  const auto batch_func_sig =
+      ExtensionFunctionsWhitelist::get_batch_ext_func(ext_func_sig);
+  if (!batch_func_sig) {
+    return nullptr;
+  }
+  // The implementation comes from the runtime or a UDF module, which are already
+  // linked into the query module.
+  auto batch_func = cgen_state_->module_->getFunction(batch_func_sig->getName());
+  if (!batch_func || batch_func->arg_size() != 3 ||
+      !batch_func->getReturnType()->isVoidTy()) {
+    return nullptr;
+  }
+  // Batches are read directly from the column buffers, so every argument must be a
+  // column of the outer table stored with its logical width and taken as is.
+  std::vector<const hdk::ir::ColumnVar*> col_vars;
+  for (size_t i = 0; i < function_oper->arity(); ++i) {
+    const auto col_var = dynamic_cast<const hdk::ir::ColumnVar*>(function_oper->arg(i));
+    if (!col_var || col_var->rteIdx() != 0 || col_var->isVirtual() ||
+        plan_state_->isLazyFetchColumn(col_var) || hashJoinLhs(col_var)) {
+      return nullptr;
+    }
+    const auto col_type = col_var->type();
+    if (!(col_type->isInteger() || col_type->isFloatingPoint() ||
+          col_type->isBoolean()) ||
+        col_type->size() != col_type->canonicalSize()) {
+      return nullptr;
+    }
+    const auto arg_type =
+        ext_arg_type_to_type(col_type->ctx(), ext_func_sig.getArgs()[i]);
+    if (arg_type->id() != col_type->id() || arg_type->size() != col_type->size()) {
+      return nullptr;
+    }
+    col_vars.push_back(col_var);
+  }
+
+  auto& ir_builder = cgen_state_->ir_builder_;
+  auto i8_ptr_ty = llvm::Type::getInt8PtrTy(cgen_state_->context_);
+  auto i32_ty = get_int_type(32, cgen_state_->context_);
+  auto cols_ty = llvm::ArrayType::get(i8_ptr_ty, col_vars.size());
+  auto widths_ty = llvm::ArrayType::get(i32_ty, col_vars.size());
+  auto cols_lv = ir_builder.CreateAlloca(cols_ty);
+  auto widths_lv = ir_builder.CreateAlloca(widths_ty);
+  for (size_t i = 0; i < col_vars.size(); ++i) {
+    const auto col_byte_stream =
+        colByteStream(col_vars[i], /*fetch_column=*/true, co.hoist_literals);
+    ir_builder.CreateStore(
+        col_byte_stream,
+        ir_builder.CreateGEP(
+            cols_ty,
+            cols_lv,
+            std::vector<llvm::Value*>{cgen_state_->llInt(0), cgen_state_->llInt(i)}));
+    ir_builder.CreateStore(
+        cgen_state_->llInt(static_cast<int32_t>(col_vars[i]->type()->size())),
+        ir_builder.CreateGEP(
+            widths_ty,
+            widths_lv,
+            std::vector<llvm::Value*>{cgen_state_->llInt(0), cgen_state_->llInt(i)}));
+  }
+  auto num_rows_ptr = get_arg_by_name(cgen_state_->row_func_, "num_rows_per_scan");
+  auto num_rows_lv = ir_builder.CreateLoad(
+      num_rows_ptr->getType()->getPointerElementType(), num_rows_ptr);
+  const auto ret_width = static_cast<int32_t>(ret_ty->getPrimitiveSizeInBits() / 8);
+  auto result_ptr = cgen_state_->emitExternalCall(
+      "batch_ext_func_result",
+      i8_ptr_ty,
+      {ir_builder.CreatePointerCast(batch_func, i8_ptr_ty),
+       ir_builder.CreatePointerCast(cols_lv, i8_ptr_ty->getPointerTo()),
+       ir_builder.CreatePointerCast(widths_lv, i32_ty->getPointerTo()),
+       cgen_state_->llInt(static_cast<int32_t>(col_vars.size())),
+       cgen_state_->llInt(ret_width),
+       posArg(nullptr),
+       num_rows_lv});
+  return ir_builder.CreateLoad(
+      ret_ty, ir_builder.CreatePointerCast(result_ptr, ret_ty->getPointerTo()));
+}
+
 // Start the control flow needed for a call site check of NULL arguments.
 std::tuple<CodeGenerator::ArgNullcheckBBs, llvm::Value*>
 CodeGenerator::beginArgsNullcheck(const hdk::ir::FunctionOper* function_oper,
@@ -0,0 +1,155 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/ExternalSort.h"
+#include "Logger/Logger.h"
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <fstream>
+
+namespace {
+
+struct SortRecord {
+  uint64_t key;
+  PermutationIdx idx;
+};
+
+constexpr size_t kWriteBufferSize = 1 << 16;
+constexpr size_t kMinReadBufferSize = 1 << 10;
+
+// Buffered sequential reader of a single run.
+class RunReader {
+ public:
+  RunReader(const std::string& path, const size_t size, const size_t buffer_size)
+      : in_(path, std::ios::binary), remaining_(size), buffer_(buffer_size) {
+    if (!in_) {
+      throw std::runtime_error("Cannot open sort run file " + path);
+    }
+    fill();
+  }
+
+  bool empty() const { return pos_ == buffer_.size() && !remaining_; }
+  const SortRecord& current() const { return buffer_[pos_]; }
+
+  void next() {
+    if (++pos_ == buffer_.size() && remaining_) {
+      fill();
+    }
+  }
+
+ private:
+  void fill() {
+    const auto count = std::min(remaining_, buffer_.capacity());
+    buffer_.resize(count);
+    in_.read(reinterpret_cast<char*>(buffer_.data()), count * sizeof(SortRecord));
+    if (!in_) {
+      throw std::runtime_error("Cannot read sort run file");
+    }
+    remaining_ -= count;
+    pos_ = 0;
+  }
+
+  std::ifstream in_;
+  size_t remaining_;
+  std::vector<SortRecord> buffer_;
+  size_t pos_ = 0;
+};
+
+}  // namespace
+
+SpilledSortRuns::SpilledSortRuns(const std::string& dir, const size_t merge_buffer_bytes)
+    : dir_(dir.empty() ? boost::filesystem::temp_directory_path().string() : dir)
+    , merge_buffer_bytes_(merge_buffer_bytes) {}
+
+SpilledSortRuns::~SpilledSortRuns() {
+  for (auto& run : runs_) {
+    boost::system::error_code ec;
+    boost::filesystem::remove(run.path, ec);
+    if (ec) {
+      LOG(WARNING) << "Cannot remove sort run file " << run.path << ": " << ec.message();
+    }
+  }
+}
+
+void SpilledSortRuns::addRun(const uint64_t* keys,
+                             const PermutationIdx* indices,
+                             const size_t size) {
+  auto path = (boost::filesystem::path(dir_) /
+               boost::filesystem::unique_path("hdk-sort-%%%%-%%%%-%%%%.run"))
+                  .string();
+  std::ofstream out(path, std::ios::binary);
+  if (!out) {
+    throw std::runtime_error("Cannot create sort run file " + path);
+  }
+  runs_.push_back({path, size});
+  std::vector<SortRecord> buffer(std::min(size, kWriteBufferSize));
+  for (size_t start = 0; start < size; start += buffer.size()) {
+    const auto count = std::min(buffer.size(), size - start);
+    for (size_t i = 0; i < count; ++i) {
+      buffer[i] = {keys[start + i], indices[start + i]};
+    }
+    out.write(reinterpret_cast<const char*>(buffer.data()), count * sizeof(SortRecord));
+  }
+  out.close();
+  if (!out) {
+    throw std::runtime_error("Cannot write sort run file " + path);
+  }
+  VLOG(1) << "Spilled sort run of " << size << " entries to " << path;
+}
+
+size_t SpilledSortRuns::size() const {
+  size_t res = 0;
+  for (auto& run : runs_) {
+    res += run.size;
+  }
+  return res;
+}
+
+void SpilledSortRuns::merge(PermutationIdx* output) const {
+  auto timer = DEBUG_TIMER(__func__);
+  const size_t buffer_size = std::max(
+      kMinReadBufferSize, merge_buffer_bytes_ / std::max<size_t>(runs_.size(), 1) /
+                              sizeof(SortRecord));
+  std::vector<RunReader> readers;
+  readers.reserve(runs_.size());
+  for (auto& run : runs_) {
+    readers.emplace_back(run.path, run.size, buffer_size);
+  }
+  // Min-heap of readers by current key, ties are resolved by run index.
+  std::vector<size_t> heap;
+  for (size_t i = 0; i < readers.size(); ++i) {
+    if (!readers[i].empty()) {
+      heap.push_back(i);
+    }
+  }
+  const auto heap_compare = [&readers](const size_t lhs, const size_t rhs) {
+    const auto lhs_key = readers[lhs].current().key;
+    const auto rhs_key = readers[rhs].current().key;
+    return lhs_key == rhs_key ? lhs > rhs : lhs_key > rhs_key;
+  };
+  std::make_heap(heap.begin(), heap.end(), heap_compare);
+  while (!heap.empty()) {
+    std::pop_heap(heap.begin(), heap.end(), heap_compare);
+    auto& reader = readers[heap.back()];
+    *output++ = reader.current().idx;
+    reader.next();
+    if (reader.empty()) {
+      heap.pop_back();
+    } else {
+      std::push_heap(heap.begin(), heap.end(), heap_compare);
+    }
+  }
+}
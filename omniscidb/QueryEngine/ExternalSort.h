@@ -0,0 +1,52 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "ResultSet/ResultSet.h"
+
+#include <string>
+#include <vector>
+
+/**
+ * Sorted runs of (key, permutation index) pairs spilled to local storage and merged
+ * into a single sorted permutation. Used to sort large results in bounded memory:
+ * runs are sorted in memory one at a time and only the read buffers of the merge
+ * have to fit memory at once. Run files are removed on destruction.
+ */
+class SpilledSortRuns {
+ public:
+  // Empty dir means the system temporary directory.
+  SpilledSortRuns(const std::string& dir, const size_t merge_buffer_bytes);
+  ~SpilledSortRuns();
+
+  void addRun(const uint64_t* keys, const PermutationIdx* indices, const size_t size);
+
+  // Write indices of all runs to output in key order. Equal keys keep the order of
+  // runs, so the merge is stable if runs are stable and added in input order.
+  void merge(PermutationIdx* output) const;
+
+  size_t runCount() const { return runs_.size(); }
+  size_t size() const;
+
+ private:
+  struct Run {
+    std::string path;
+    size_t size;
+  };
+
+  std::string dir_;
+  const size_t merge_buffer_bytes_;
+  std::vector<Run> runs_;
+};
@@ -0,0 +1,157 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/FrameOfReferenceEncoding.h"
+#include "QueryEngine/ExpressionRange.h"
+#include "QueryEngine/RelAlgExecutionUnit.h"
+#include "ResultSetRegistry/ResultSetRegistry.h"
+#include "Shared/InlineNullValues.h"
+
+namespace {
+
+bool is_encodable_type(const hdk::ir::Type* type) {
+  switch (type->id()) {
+    case hdk::ir::Type::kInteger:
+    case hdk::ir::Type::kDecimal:
+    case hdk::ir::Type::kTime:
+    case hdk::ir::Type::kTimestamp:
+      return type->size() > 1 && type->size() == type->canonicalSize();
+    default:
+      return false;
+  }
+}
+
+bool has_window_functions(const RelAlgExecutionUnit& ra_exe_unit) {
+  for (auto target_expr : ra_exe_unit.target_exprs) {
+    if (target_expr->is<hdk::ir::WindowFunction>()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+uint64_t null_code(const size_t byte_width) {
+  return (uint64_t(1) << (byte_width * 8)) - 1;
+}
+
+template <typename SRC, typename DST>
+void encode_impl(const int8_t* data,
+                 int8_t* res,
+                 const size_t elem_count,
+                 const int64_t baseline) {
+  auto src = reinterpret_cast<const SRC*>(data);
+  auto dst = reinterpret_cast<DST*>(res);
+  const auto null_val = inline_int_null_value<SRC>();
+  const auto max_offset = null_code(sizeof(DST)) - 1;
+  for (size_t i = 0; i < elem_count; ++i) {
+    if (src[i] == null_val) {
+      dst[i] = static_cast<DST>(null_code(sizeof(DST)));
+    } else {
+      const auto offset = static_cast<uint64_t>(src[i]) - static_cast<uint64_t>(baseline);
+      CHECK_LE(offset, max_offset);
+      dst[i] = static_cast<DST>(offset);
+    }
+  }
+}
+
+template <typename SRC>
+void encode_impl(const int8_t* data,
+                 int8_t* res,
+                 const size_t elem_count,
+                 const FrameOfReferenceEncoding& encoding) {
+  switch (encoding.byte_width) {
+    case 1:
+      encode_impl<SRC, uint8_t>(data, res, elem_count, encoding.baseline);
+      break;
+    case 2:
+      encode_impl<SRC, uint16_t>(data, res, elem_count, encoding.baseline);
+      break;
+    case 4:
+      encode_impl<SRC, uint32_t>(data, res, elem_count, encoding.baseline);
+      break;
+    default:
+      CHECK(false) << "Unsupported encoding width: " << encoding.byte_width;
+  }
+}
+
+}  // namespace
+
+ColumnEncodings choose_column_encodings(const RelAlgExecutionUnit& ra_exe_unit,
+                                        const std::vector<InputTableInfo>& query_infos,
+                                        const Executor* executor) {
+  ColumnEncodings res;
+  // Window functions fetch columns with their own decoders, skip them for simplicity.
+  if (ra_exe_unit.union_all || has_window_functions(ra_exe_unit)) {
+    return res;
+  }
+  for (auto& col_desc : ra_exe_unit.input_col_descs) {
+    // Inner tables might be fetched as a whole or used to build hash tables, so only
+    // columns of the outer table are considered.
+    if (col_desc->getNestLevel() != 0 || col_desc->isVirtual() ||
+        col_desc->getTableId() <= 0 ||
+        col_desc->getDatabaseId() == hdk::ResultSetRegistry::DB_ID ||
+        !is_encodable_type(col_desc->type())) {
+      continue;
+    }
+    hdk::ir::ColumnVar col_var(col_desc->getColInfo(), col_desc->getNestLevel());
+    auto range = getLeafColumnRange(&col_var, query_infos, executor, false);
+    if (range.getType() != ExpressionRangeType::Integer ||
+        range.getIntMax() < range.getIntMin()) {
+      continue;
+    }
+    const auto max_offset = static_cast<uint64_t>(range.getIntMax()) -
+                            static_cast<uint64_t>(range.getIntMin());
+    for (size_t byte_width = 1; byte_width < col_desc->type()->size(); byte_width *= 2) {
+      if (max_offset < null_code(byte_width)) {
+        res.emplace(*col_desc, FrameOfReferenceEncoding{byte_width, range.getIntMin()});
+        VLOG(1) << "Use " << byte_width << "-byte frame-of-reference encoding for "
+                << col_desc->getColInfo()->toString();
+        break;
+      }
+    }
+  }
+  return res;
+}
+
+void encode_frame_of_reference(const int8_t* data,
+                               int8_t* res,
+                               const size_t elem_count,
+                               const hdk::ir::Type* type,
+                               const FrameOfReferenceEncoding& encoding) {
+  switch (type->size()) {
+    case 2:
+      encode_impl<int16_t>(data, res, elem_count, encoding);
+      break;
+    case 4:
+      encode_impl<int32_t>(data, res, elem_count, encoding);
+      break;
+    case 8:
+      encode_impl<int64_t>(data, res, elem_count, encoding);
+      break;
+    default:
+      CHECK(false) << "Unsupported column type: " << type->toString();
+  }
+}
+
+ChunkKey get_encoded_chunk_key(const ChunkKey& chunk_key,
+                               const size_t elem_count,
+                               const FrameOfReferenceEncoding& encoding) {
+  CHECK_EQ(chunk_key.size(), (size_t)4);
+  auto res = chunk_key;
+  res.push_back(static_cast<int>(encoding.byte_width));
+  res.push_back(static_cast<int>(static_cast<uint64_t>(encoding.baseline) >> 32));
+  res.push_back(static_cast<int>(encoding.baseline & 0xFFFFFFFF));
+  res.push_back(static_cast<int>(elem_count));
+  return res;
+}
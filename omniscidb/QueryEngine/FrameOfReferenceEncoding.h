@@ -0,0 +1,60 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "IR/Type.h"
+#include "QueryEngine/Descriptors/InputDescriptors.h"
+#include "QueryEngine/InputMetadata.h"
+#include "Shared/types.h"
+
+#include <unordered_map>
+#include <vector>
+
+class Executor;
+struct RelAlgExecutionUnit;
+
+/**
+ * Frame-of-reference encoding of an integer column read by kernels. Values are
+ * stored as unsigned offsets from the baseline using byte_width bytes, the all-ones
+ * value of that width is reserved for nulls. The encoding is chosen per query from
+ * table-level column ranges, so all fragments of the column share it.
+ */
+struct FrameOfReferenceEncoding {
+  size_t byte_width;
+  int64_t baseline;
+};
+
+using ColumnEncodings = std::unordered_map<InputColDescriptor, FrameOfReferenceEncoding>;
+
+//! Choose columns of the outer table which are worth reading in a compressed form,
+//! i.e. their value range fits a narrower integer type.
+ColumnEncodings choose_column_encodings(const RelAlgExecutionUnit& ra_exe_unit,
+                                        const std::vector<InputTableInfo>& query_infos,
+                                        const Executor* executor);
+
+//! Encode elem_count values of the given column type into elem_count *
+//! encoding.byte_width bytes of res.
+void encode_frame_of_reference(const int8_t* data,
+                               int8_t* res,
+                               const size_t elem_count,
+                               const hdk::ir::Type* type,
+                               const FrameOfReferenceEncoding& encoding);
+
+//! Key of the encoded fragment in the buffer pool. It extends the key of the plain
+//! chunk with the encoding and the number of rows, which changes on appends to the
+//! last fragment.
+ChunkKey get_encoded_chunk_key(const ChunkKey& chunk_key,
+                               const size_t elem_count,
+                               const FrameOfReferenceEncoding& encoding);
@@ -16,6 +16,7 @@
 
 #include "FromTableReordering.h"
 #include "Execute.h"
+#include "ExpressionRange.h"
 #include "IR/Expr.h"
 #include "RangeTableIndexVisitor.h"
 
@@ -50,13 +51,55 @@ std::pair<cost_t, cost_t> get_join_qual_cost(const hdk::ir::Expr* qual,
   return {100, 100};
 }
 
-// Builds a graph with nesting levels as nodes and join condition costs as edges.
+// Returns fractions of lhs and rhs rows which can find a match on the other side of the
+// given equi-join qualifier. The estimation is based on the overlap of key ranges taken
+// from the fragment metadata, 1.0 is returned when the ranges are not known.
+std::pair<double, double> get_join_qual_match_rates(
+    const hdk::ir::Expr* qual,
+    const std::vector<InputTableInfo>& table_infos,
+    const Executor* executor) {
+  const auto bin_oper = dynamic_cast<const hdk::ir::BinOper*>(qual);
+  if (!bin_oper || !bin_oper->isEquivalence()) {
+    return {1.0, 1.0};
+  }
+  const auto lhs_col = bin_oper->leftOperand()->as<hdk::ir::ColumnVar>();
+  const auto rhs_col = bin_oper->rightOperand()->as<hdk::ir::ColumnVar>();
+  if (!lhs_col || !rhs_col || !lhs_col->type()->isInteger() ||
+      !rhs_col->type()->isInteger()) {
+    return {1.0, 1.0};
+  }
+  const auto lhs_range = getLeafColumnRange(lhs_col, table_infos, executor, false);
+  const auto rhs_range = getLeafColumnRange(rhs_col, table_infos, executor, false);
+  if (lhs_range.getType() != ExpressionRangeType::Integer ||
+      rhs_range.getType() != ExpressionRangeType::Integer ||
+      lhs_range.getIntMax() < lhs_range.getIntMin() ||
+      rhs_range.getIntMax() < rhs_range.getIntMin()) {
+    return {1.0, 1.0};
+  }
+  const auto overlap_min = std::max(lhs_range.getIntMin(), rhs_range.getIntMin());
+  const auto overlap_max = std::min(lhs_range.getIntMax(), rhs_range.getIntMax());
+  const double overlap =
+      overlap_max < overlap_min ? 0.0 : double(overlap_max) - double(overlap_min) + 1;
+  const double lhs_width =
+      double(lhs_range.getIntMax()) - double(lhs_range.getIntMin()) + 1;
+  const double rhs_width =
+      double(rhs_range.getIntMax()) - double(rhs_range.getIntMin()) + 1;
+  return {overlap / lhs_width, overlap / rhs_width};
+}
+
+// Builds a graph with nesting levels as nodes and join condition costs as edges. If
+// join_match_rate_graph is provided, it gets the same edges with estimated fractions of
+// source level rows matched by the destination level.
 std::vector<std::map<node_t, cost_t>> build_join_cost_graph(
     const JoinQualsPerNestingLevel& left_deep_join_quals,
     const std::vector<InputTableInfo>& table_infos,
-    const Executor* executor) {
+    const Executor* executor,
+    std::vector<std::map<node_t, double>>* join_match_rate_graph) {
   CHECK_EQ(left_deep_join_quals.size() + 1, table_infos.size());
   std::vector<std::map<node_t, cost_t>> join_cost_graph(table_infos.size());
+  if (join_match_rate_graph) {
+    join_match_rate_graph->assign(table_infos.size(), {});
+  }
   // Build the constraints graph: nodes are nest levels, edges are the existence of
   // qualifiers between levels.
   for (const auto& current_level_join_conditions : left_deep_join_quals) {
@@ -79,6 +122,27 @@ std::vector<std::map<node_t, cost_t>> build_join_cost_graph(
         join_cost_graph[lhs_nest_level][rhs_nest_level] = cost_pair.second;
         join_cost_graph[rhs_nest_level][lhs_nest_level] = cost_pair.first;
       }
+      if (join_match_rate_graph) {
+        // Operands may come in any order, orient the rates by nest levels.
+        auto match_rates = get_join_qual_match_rates(qual.get(), table_infos, executor);
+        const auto bin_oper = dynamic_cast<const hdk::ir::BinOper*>(qual.get());
+        if (bin_oper) {
+          const auto lhs_levels =
+              AllRangeTableIndexCollector::collect(bin_oper->leftOperand());
+          if (lhs_levels.size() == 1 && *lhs_levels.begin() != lhs_nest_level) {
+            std::swap(match_rates.first, match_rates.second);
+          }
+        }
+        // Keep the most selective qualifier between two levels.
+        auto& lhs_rate = (*join_match_rate_graph)[lhs_nest_level]
+                             .emplace(rhs_nest_level, 1.0)
+                             .first->second;
+        auto& rhs_rate = (*join_match_rate_graph)[rhs_nest_level]
+                             .emplace(lhs_nest_level, 1.0)
+                             .first->second;
+        lhs_rate = std::min(lhs_rate, match_rates.first);
+        rhs_rate = std::min(rhs_rate, match_rates.second);
+      }
     }
   }
   return join_cost_graph;
@@ -118,6 +182,8 @@ class SchedulingDependencyTracking {
 struct TraversalEdge {
   node_t nest_level;
   cost_t join_cost;
+  // Estimated fraction of rows matched when joining this nest level.
+  double match_rate{1.0};
 };
 
 // Builds dependency tracking based on left joins
@@ -146,7 +212,8 @@ std::vector<node_t> traverse_join_cost_graph(
     const std::function<bool(const node_t lhs_nest_level, const node_t rhs_nest_level)>&
         compare_node,
     const std::function<bool(const TraversalEdge&, const TraversalEdge&)>& compare_edge,
-    const JoinQualsPerNestingLevel& left_deep_join_quals) {
+    const JoinQualsPerNestingLevel& left_deep_join_quals,
+    const std::vector<std::map<node_t, double>>& join_match_rate_graph) {
   std::vector<node_t> all_nest_levels(table_infos.size());
   std::iota(all_nest_levels.begin(), all_nest_levels.end(), 0);
   std::vector<node_t> input_permutation;
@@ -215,7 +282,17 @@ std::vector<node_t> traverse_join_cost_graph(
         if (!schedulable_node(succ)) {
           continue;
         }
-        worklist.push(TraversalEdge{succ, graph_edge.second});
+        // Prefer joins which filter out more rows so that fewer rows reach the
+        // following join loops.
+        double match_rate = 1.0;
+        if (!join_match_rate_graph.empty()) {
+          const auto& match_rates = join_match_rate_graph[crt.nest_level];
+          const auto match_rate_it = match_rates.find(succ);
+          if (match_rate_it != match_rates.end()) {
+            match_rate = match_rate_it->second;
+          }
+        }
+        worklist.push(TraversalEdge{succ, graph_edge.second, match_rate});
         const auto it_ok = visited.insert(succ);
         CHECK(it_ok.second);
       }
@@ -230,8 +307,14 @@ std::vector<node_t> get_node_input_permutation(
     const JoinQualsPerNestingLevel& left_deep_join_quals,
     const std::vector<InputTableInfo>& table_infos,
     const Executor* executor) {
+  std::vector<std::map<node_t, double>> join_match_rate_graph;
+  const bool use_match_rates =
+      executor && executor->getConfig().opts.enable_join_selectivity_reordering;
   const auto join_cost_graph =
-      build_join_cost_graph(left_deep_join_quals, table_infos, executor);
+      build_join_cost_graph(left_deep_join_quals,
+                            table_infos,
+                            executor,
+                            use_match_rates ? &join_match_rate_graph : nullptr);
   // Use the number of tuples in each table to break ties in BFS.
   const auto compare_node = [&table_infos](const node_t lhs_nest_level,
                                            const node_t rhs_nest_level) {
@@ -240,12 +323,20 @@ std::vector<node_t> get_node_input_permutation(
   };
   const auto compare_edge = [&compare_node](const TraversalEdge& lhs_edge,
                                             const TraversalEdge& rhs_edge) {
-    // Only use the number of tuples as a tie-breaker, if costs are equal.
+    // Only use match rates and the number of tuples as tie-breakers, if costs are
+    // equal.
     if (lhs_edge.join_cost == rhs_edge.join_cost) {
+      if (lhs_edge.match_rate != rhs_edge.match_rate) {
+        return lhs_edge.match_rate > rhs_edge.match_rate;
+      }
       return compare_node(lhs_edge.nest_level, rhs_edge.nest_level);
     }
     return lhs_edge.join_cost > rhs_edge.join_cost;
   };
-  return traverse_join_cost_graph(
-      join_cost_graph, table_infos, compare_node, compare_edge, left_deep_join_quals);
+  return traverse_join_cost_graph(join_cost_graph,
+                                  table_infos,
+                                  compare_node,
+                                  compare_edge,
+                                  left_deep_join_quals,
+                                  join_match_rate_graph);
 }
@@ -0,0 +1,87 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    GpuLaunchTuner.h
+ * @brief   Per-kernel choice of the GPU grid size based on measured launches.
+ *
+ * The tuner lives next to the cached GPU code. First launches of the kernel try
+ * candidate grid sizes, then the one with the lowest time per input row is used.
+ * Candidates never exceed the default grid size because output buffers and the
+ * generated code are sized for it.
+ **/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+class GpuLaunchTuner {
+ public:
+  // Grid size for the next launch of the kernel.
+  unsigned gridSize(const unsigned default_grid_size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (candidates_.empty()) {
+      for (auto divisor : {1u, 2u, 4u}) {
+        const auto grid_size = std::max(default_grid_size / divisor, 1u);
+        if (candidates_.empty() || candidates_.back().grid_size != grid_size) {
+          candidates_.push_back({grid_size});
+        }
+      }
+    }
+    for (auto& candidate : candidates_) {
+      if (!candidate.launches) {
+        return candidate.grid_size;
+      }
+    }
+    return bestGridSize();
+  }
+
+  void registerLaunch(const unsigned grid_size,
+                      const size_t row_count,
+                      const int64_t time_us) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& candidate : candidates_) {
+      if (candidate.grid_size == grid_size) {
+        ++candidate.launches;
+        candidate.time_per_row += (static_cast<double>(time_us) /
+                                       std::max(row_count, size_t(1)) -
+                                   candidate.time_per_row) /
+                                  candidate.launches;
+        return;
+      }
+    }
+  }
+
+ private:
+  unsigned bestGridSize() const {
+    auto best = std::min_element(
+        candidates_.begin(), candidates_.end(), [](const auto& lhs, const auto& rhs) {
+          return lhs.time_per_row < rhs.time_per_row;
+        });
+    return best->grid_size;
+  }
+
+  struct Candidate {
+    unsigned grid_size;
+    size_t launches{0};
+    // Running mean of the launch time per input row in microseconds.
+    double time_per_row{0.0};
+  };
+
+  std::mutex mutex_;
+  std::vector<Candidate> candidates_;
+};
@@ -84,15 +84,11 @@ void GpuSharedMemCodeBuilder::codegen(const CompilationOptions& co) {
  * group by buffer (what existed before), 2) src_buffer_ptr which points to the shared
  * memory group by buffer, exclusively accessed by each specific GPU thread-block, 3)
  * total buffer size.
- * 2. We assign each thread to a specific entry (all targets within that entry), so any
- * thread with an index larger than max entries, will have an early return from this
- * function
- * 3. It is assumed here that there are at least as many threads in the GPU as there are
- * entries in the group by buffer. In practice, given the buffer sizes that we deal with,
- * this is a reasonable asumption, but can be easily relaxed in the future if needed to:
- * threads can form a loop and process all entries until all are finished. It should be
- * noted that we currently don't use shared memory if there are more entries than number
- * of threads.
+ * 2. Entries (all targets within an entry) are assigned to threads in a block-stride
+ * loop: a thread reduces entries thread_idx, thread_idx + blockDim, and so on. Threads
+ * with an index larger than max entries have an early return from this function.
+ * 3. Therefore, the buffer may have more entries than there are threads in a block,
+ * and its size is only limited by the available shared memory.
  * 4. We loop over all slots corresponding to a specific entry, and use
  * ResultSetReductionJIT's reduce_one_entry_idx to reduce one slot from the destination
  * buffer into source buffer. The only difference is that we should replace all agg_*
@@ -126,16 +122,8 @@ void GpuSharedMemCodeBuilder::codegenReduction(const CompilationOptions& co) {
 
   const auto func_thread_index = getFunction("get_thread_index");
   const auto thread_idx = ir_builder.CreateCall(func_thread_index, {}, "thread_index");
-
-  // branching out of out of bound:
-  const auto entry_count = ll_int(query_mem_desc_.getEntryCount(), context_);
-  const auto entry_count_i32 =
-      ll_int(static_cast<int32_t>(query_mem_desc_.getEntryCount()), context_);
-  const auto is_thread_inbound =
-      ir_builder.CreateICmpSLT(thread_idx, entry_count, "is_thread_inbound");
-  ir_builder.CreateCondBr(is_thread_inbound, bb_body, bb_exit);
-
-  ir_builder.SetInsertPoint(bb_body);
+  const auto func_block_dim = getFunction("get_block_dim");
+  const auto block_dim = ir_builder.CreateCall(func_block_dim, {}, "block_dim");
 
   // cast src/dest buffers into byte streams:
   auto src_byte_stream = ir_builder.CreatePointerCast(
@@ -149,6 +137,18 @@ void GpuSharedMemCodeBuilder::codegenReduction(const CompilationOptions& co) {
                                dest_buffer_ptr->getType()->getPointerAddressSpace()),
       "dest_byte_stream");
 
+  // branching out of out of bound:
+  const auto entry_count = ll_int(query_mem_desc_.getEntryCount(), context_);
+  const auto entry_count_i32 =
+      ll_int(static_cast<int32_t>(query_mem_desc_.getEntryCount()), context_);
+  const auto is_thread_inbound =
+      ir_builder.CreateICmpSLT(thread_idx, entry_count, "is_thread_inbound");
+  ir_builder.CreateCondBr(is_thread_inbound, bb_body, bb_exit);
+
+  ir_builder.SetInsertPoint(bb_body);
+  auto entry_idx = ir_builder.CreatePHI(thread_idx->getType(), 2, "entry_idx");
+  entry_idx->addIncoming(thread_idx, bb_entry);
+
   // running the result set reduction JIT code to get reduce_one_entry_idx function
   auto fixup_query_mem_desc = ResultSet::fixupQueryMemoryDescriptor(query_mem_desc_);
   auto rs_reduction_jit = std::make_unique<GpuReductionHelperJIT>(
@@ -214,18 +214,22 @@ void GpuSharedMemCodeBuilder::codegenReduction(const CompilationOptions& co) {
   // disable for current shared memory support.
   const auto null_ptr_ll = llvm::ConstantPointerNull::get(
       cgen_traits.localPointerType(llvm::Type::getInt8Ty(context_)));
-  const auto thread_idx_i32 = ir_builder.CreateCast(
-      llvm::Instruction::CastOps::Trunc, thread_idx, get_int_type(32, context_));
+  const auto entry_idx_i32 = ir_builder.CreateCast(
+      llvm::Instruction::CastOps::Trunc, entry_idx, get_int_type(32, context_));
   ir_builder.CreateCall(reduce_one_entry_idx_func,
                         {dest_byte_stream,
                          src_byte_stream,
-                         thread_idx_i32,
+                         entry_idx_i32,
                          entry_count_i32,
                          null_ptr_ll,
                          null_ptr_ll,
                          null_ptr_ll},
                         "");
-  ir_builder.CreateBr(bb_exit);
+  const auto next_entry_idx = ir_builder.CreateAdd(entry_idx, block_dim);
+  entry_idx->addIncoming(next_entry_idx, ir_builder.GetInsertBlock());
+  ir_builder.CreateCondBr(ir_builder.CreateICmpSLT(next_entry_idx, entry_count),
+                          bb_body,
+                          bb_exit);
   llvm::ReturnInst::Create(context_, bb_exit);
 }
 
@@ -269,9 +273,8 @@ llvm::Value* codegen_smem_dest_slot_ptr(llvm::LLVMContext& context,
 /**
  * This function generates code to initialize the shared memory buffer, the way we
  * initialize the group by output buffer on the host. Similar to the reduction function,
- * it is assumed that there are at least as many threads as there are entries in the
- * buffer. Each entry is assigned to a single thread, and then all slots corresponding to
- * that entry are initialized with aggregate init values.
+ * entries are assigned to threads in a block-stride loop, and all slots corresponding to
+ * an entry are initialized with aggregate init values by its thread.
  */
 void GpuSharedMemCodeBuilder::codegenInitialization() {
   CHECK(init_func_);
@@ -289,6 +292,8 @@ void GpuSharedMemCodeBuilder::codegenInitialization() {
   llvm::IRBuilder<> ir_builder(bb_entry);
   const auto func_thread_index = getFunction("get_thread_index");
   const auto thread_idx = ir_builder.CreateCall(func_thread_index, {}, "thread_index");
+  const auto func_block_dim = getFunction("get_block_dim");
+  const auto block_dim = ir_builder.CreateCall(func_block_dim, {}, "block_dim");
 
   // declare dynamic shared memory:
   const auto declare_smem_func = getFunction("declare_dynamic_shared_memory");
@@ -301,9 +306,11 @@ void GpuSharedMemCodeBuilder::codegenInitialization() {
   ir_builder.CreateCondBr(is_thread_inbound, bb_body, bb_exit);
 
   ir_builder.SetInsertPoint(bb_body);
-  // compute byte offset assigned to this thread:
+  auto entry_idx = ir_builder.CreatePHI(thread_idx->getType(), 2, "entry_idx");
+  entry_idx->addIncoming(thread_idx, bb_entry);
+  // compute byte offset of the current entry:
   const auto row_size_bytes = ll_int(fixup_query_mem_desc.getRowWidth(), context_);
-  auto byte_offset_ll = ir_builder.CreateMul(row_size_bytes, thread_idx, "byte_offset");
+  auto byte_offset_ll = ir_builder.CreateMul(row_size_bytes, entry_idx, "byte_offset");
 
   const auto dest_byte_stream = ir_builder.CreatePointerCast(
       shared_mem_buffer,
@@ -311,7 +318,7 @@ void GpuSharedMemCodeBuilder::codegenInitialization() {
                                shared_mem_buffer->getType()->getPointerAddressSpace()),
       "dest_byte_stream");
 
-  // each thread will be responsible for one
+  // each thread initializes all slots of its entries
   const auto& col_slot_context = fixup_query_mem_desc.getColSlotContext();
   size_t init_agg_idx = 0;
   for (size_t target_logical_idx = 0; target_logical_idx < targets_.size();
@@ -351,7 +358,11 @@ void GpuSharedMemCodeBuilder::codegenInitialization() {
     }
   }
 
-  ir_builder.CreateBr(bb_exit);
+  const auto next_entry_idx = ir_builder.CreateAdd(entry_idx, block_dim);
+  entry_idx->addIncoming(next_entry_idx, ir_builder.GetInsertBlock());
+  ir_builder.CreateCondBr(ir_builder.CreateICmpSLT(next_entry_idx, entry_count),
+                          bb_body,
+                          bb_exit);
 
   ir_builder.SetInsertPoint(bb_exit);
   // synchronize all threads within a threadblock:
@@ -24,7 +24,10 @@ key_hash(GENERIC_ADDR_SPACE const int64_t* key,
   return MurmurHash3(key, key_byte_width * key_count, 0);
 }
 
-extern "C" RUNTIME_EXPORT NEVER_INLINE DEVICE GENERIC_ADDR_SPACE int64_t* get_group_value(
+extern "C" RUNTIME_EXPORT NEVER_INLINE DEVICE bool dynamic_watchdog();
+
+template <bool WITH_WATCHDOG>
+ALWAYS_INLINE DEVICE GENERIC_ADDR_SPACE int64_t* get_group_value_impl(
     GENERIC_ADDR_SPACE int64_t* groups_buffer,
     const uint32_t groups_buffer_entry_count,
     GENERIC_ADDR_SPACE const int64_t* key,
@@ -37,33 +40,6 @@ extern "C" RUNTIME_EXPORT NEVER_INLINE DEVICE GENERIC_ADDR_SPACE int64_t* get_gr
   if (matching_group) {
     return matching_group;
   }
-  uint32_t h_probe = (h + 1) % groups_buffer_entry_count;
-  while (h_probe != h) {
-    matching_group = get_matching_group_value(
-        groups_buffer, h_probe, key, key_count, key_width, row_size_quad);
-    if (matching_group) {
-      return matching_group;
-    }
-    h_probe = (h_probe + 1) % groups_buffer_entry_count;
-  }
-  return NULL;
-}
-
-extern "C" RUNTIME_EXPORT NEVER_INLINE DEVICE bool dynamic_watchdog();
-
-extern "C" RUNTIME_EXPORT NEVER_INLINE DEVICE GENERIC_ADDR_SPACE int64_t*
-get_group_value_with_watchdog(GENERIC_ADDR_SPACE int64_t* groups_buffer,
-                              const uint32_t groups_buffer_entry_count,
-                              GENERIC_ADDR_SPACE const int64_t* key,
-                              const uint32_t key_count,
-                              const uint32_t key_width,
-                              const uint32_t row_size_quad) {
-  uint32_t h = key_hash(key, key_count, key_width) % groups_buffer_entry_count;
-  GENERIC_ADDR_SPACE int64_t* matching_group = get_matching_group_value(
-      groups_buffer, h, key, key_count, key_width, row_size_quad);
-  if (matching_group) {
-    return matching_group;
-  }
   uint32_t watchdog_countdown = 100;
   uint32_t h_probe = (h + 1) % groups_buffer_entry_count;
   while (h_probe != h) {
@@ -73,7 +49,7 @@ get_group_value_with_watchdog(GENERIC_ADDR_SPACE int64_t* groups_buffer,
       return matching_group;
     }
     h_probe = (h_probe + 1) % groups_buffer_entry_count;
-    if (--watchdog_countdown == 0) {
+    if (WITH_WATCHDOG && --watchdog_countdown == 0) {
       if (dynamic_watchdog()) {
         return NULL;
       }
@@ -83,18 +59,20 @@ get_group_value_with_watchdog(GENERIC_ADDR_SPACE int64_t* groups_buffer,
   return NULL;
 }
 
-extern "C" RUNTIME_EXPORT NEVER_INLINE DEVICE int32_t
-get_group_value_columnar_slot(GENERIC_ADDR_SPACE int64_t* groups_buffer,
-                              const uint32_t groups_buffer_entry_count,
-                              GENERIC_ADDR_SPACE const int64_t* key,
-                              const uint32_t key_count,
-                              const uint32_t key_width) {
+template <bool WITH_WATCHDOG>
+ALWAYS_INLINE DEVICE int32_t
+get_group_value_columnar_slot_impl(GENERIC_ADDR_SPACE int64_t* groups_buffer,
+                                   const uint32_t groups_buffer_entry_count,
+                                   GENERIC_ADDR_SPACE const int64_t* key,
+                                   const uint32_t key_count,
+                                   const uint32_t key_width) {
   uint32_t h = key_hash(key, key_count, key_width) % groups_buffer_entry_count;
   int32_t matching_slot = get_matching_group_value_columnar_slot(
       groups_buffer, groups_buffer_entry_count, h, key, key_count, key_width);
   if (matching_slot != -1) {
     return h;
   }
+  uint32_t watchdog_countdown = 100;
   uint32_t h_probe = (h + 1) % groups_buffer_entry_count;
   while (h_probe != h) {
     matching_slot = get_matching_group_value_columnar_slot(
@@ -103,41 +81,115 @@ get_group_value_columnar_slot(GENERIC_ADDR_SPACE int64_t* groups_buffer,
       return h_probe;
     }
     h_probe = (h_probe + 1) % groups_buffer_entry_count;
+    if (WITH_WATCHDOG && --watchdog_countdown == 0) {
+      if (dynamic_watchdog()) {
+        return -1;
+      }
+      watchdog_countdown = 100;
+    }
   }
   return -1;
 }
 
+extern "C" RUNTIME_EXPORT NEVER_INLINE DEVICE GENERIC_ADDR_SPACE int64_t* get_group_value(
+    GENERIC_ADDR_SPACE int64_t* groups_buffer,
+    const uint32_t groups_buffer_entry_count,
+    GENERIC_ADDR_SPACE const int64_t* key,
+    const uint32_t key_count,
+    const uint32_t key_width,
+    const uint32_t row_size_quad) {
+  return get_group_value_impl<false>(
+      groups_buffer, groups_buffer_entry_count, key, key_count, key_width, row_size_quad);
+}
+
+extern "C" RUNTIME_EXPORT NEVER_INLINE DEVICE GENERIC_ADDR_SPACE int64_t*
+get_group_value_with_watchdog(GENERIC_ADDR_SPACE int64_t* groups_buffer,
+                              const uint32_t groups_buffer_entry_count,
+                              GENERIC_ADDR_SPACE const int64_t* key,
+                              const uint32_t key_count,
+                              const uint32_t key_width,
+                              const uint32_t row_size_quad) {
+  return get_group_value_impl<true>(
+      groups_buffer, groups_buffer_entry_count, key, key_count, key_width, row_size_quad);
+}
+
+extern "C" RUNTIME_EXPORT NEVER_INLINE DEVICE int32_t
+get_group_value_columnar_slot(GENERIC_ADDR_SPACE int64_t* groups_buffer,
+                              const uint32_t groups_buffer_entry_count,
+                              GENERIC_ADDR_SPACE const int64_t* key,
+                              const uint32_t key_count,
+                              const uint32_t key_width) {
+  return get_group_value_columnar_slot_impl<false>(
+      groups_buffer, groups_buffer_entry_count, key, key_count, key_width);
+}
+
 extern "C" RUNTIME_EXPORT NEVER_INLINE DEVICE int32_t
 get_group_value_columnar_slot_with_watchdog(GENERIC_ADDR_SPACE int64_t* groups_buffer,
                                             const uint32_t groups_buffer_entry_count,
                                             GENERIC_ADDR_SPACE const int64_t* key,
                                             const uint32_t key_count,
                                             const uint32_t key_width) {
-  uint32_t h = key_hash(key, key_count, key_width) % groups_buffer_entry_count;
-  int32_t matching_slot = get_matching_group_value_columnar_slot(
-      groups_buffer, groups_buffer_entry_count, h, key, key_count, key_width);
-  if (matching_slot != -1) {
-    return h;
-  }
-  uint32_t watchdog_countdown = 100;
-  uint32_t h_probe = (h + 1) % groups_buffer_entry_count;
-  while (h_probe != h) {
-    matching_slot = get_matching_group_value_columnar_slot(
-        groups_buffer, groups_buffer_entry_count, h_probe, key, key_count, key_width);
-    if (matching_slot != -1) {
-      return h_probe;
-    }
-    h_probe = (h_probe + 1) % groups_buffer_entry_count;
-    if (--watchdog_countdown == 0) {
-      if (dynamic_watchdog()) {
-        return -1;
-      }
-      watchdog_countdown = 100;
-    }
-  }
-  return -1;
+  return get_group_value_columnar_slot_impl<true>(
+      groups_buffer, groups_buffer_entry_count, key, key_count, key_width);
 }
 
+// Probes specialized for the key width. The functions above are not inlined into the
+// generated code, so a key width passed as an argument is resolved on every probe.
+#define DEF_GET_GROUP_VALUE_WITH_KEY_WIDTH(key_width)                                  \
+  extern "C" RUNTIME_EXPORT NEVER_INLINE DEVICE GENERIC_ADDR_SPACE int64_t*            \
+      get_group_value_key##key_width(GENERIC_ADDR_SPACE int64_t* groups_buffer,        \
+                                     const uint32_t groups_buffer_entry_count,         \
+                                     GENERIC_ADDR_SPACE const int64_t* key,            \
+                                     const uint32_t key_count,                         \
+                                     const uint32_t row_size_quad) {                   \
+    return get_group_value_impl<false>(groups_buffer,                                  \
+                                       groups_buffer_entry_count,                      \
+                                       key,                                            \
+                                       key_count,                                      \
+                                       key_width,                                      \
+                                       row_size_quad);                                 \
+  }                                                                                    \
+                                                                                       \
+  extern "C" RUNTIME_EXPORT NEVER_INLINE DEVICE GENERIC_ADDR_SPACE int64_t*            \
+      get_group_value_key##key_width##_with_watchdog(                                  \
+          GENERIC_ADDR_SPACE int64_t* groups_buffer,                                   \
+          const uint32_t groups_buffer_entry_count,                                    \
+          GENERIC_ADDR_SPACE const int64_t* key,                                       \
+          const uint32_t key_count,                                                    \
+          const uint32_t row_size_quad) {                                              \
+    return get_group_value_impl<true>(groups_buffer,                                   \
+                                      groups_buffer_entry_count,                       \
+                                      key,                                             \
+                                      key_count,                                       \
+                                      key_width,                                       \
+                                      row_size_quad);                                  \
+  }                                                                                    \
+                                                                                       \
+  extern "C" RUNTIME_EXPORT NEVER_INLINE DEVICE int32_t                                \
+      get_group_value_columnar_slot_key##key_width(                                    \
+          GENERIC_ADDR_SPACE int64_t* groups_buffer,                                   \
+          const uint32_t groups_buffer_entry_count,                                    \
+          GENERIC_ADDR_SPACE const int64_t* key,                                       \
+          const uint32_t key_count) {                                                  \
+    return get_group_value_columnar_slot_impl<false>(                                  \
+        groups_buffer, groups_buffer_entry_count, key, key_count, key_width);          \
+  }                                                                                    \
+                                                                                       \
+  extern "C" RUNTIME_EXPORT NEVER_INLINE DEVICE int32_t                                \
+      get_group_value_columnar_slot_key##key_width##_with_watchdog(                    \
+          GENERIC_ADDR_SPACE int64_t* groups_buffer,                                   \
+          const uint32_t groups_buffer_entry_count,                                    \
+          GENERIC_ADDR_SPACE const int64_t* key,                                       \
+          const uint32_t key_count) {                                                  \
+    return get_group_value_columnar_slot_impl<true>(                                   \
+        groups_buffer, groups_buffer_entry_count, key, key_count, key_width);          \
+  }
+
+DEF_GET_GROUP_VALUE_WITH_KEY_WIDTH(4)
+DEF_GET_GROUP_VALUE_WITH_KEY_WIDTH(8)
+
+#undef DEF_GET_GROUP_VALUE_WITH_KEY_WIDTH
+
 extern "C" RUNTIME_EXPORT NEVER_INLINE DEVICE GENERIC_ADDR_SPACE int64_t*
 get_group_value_columnar(GENERIC_ADDR_SPACE int64_t* groups_buffer,
                          const uint32_t groups_buffer_entry_count,
@@ -208,6 +260,36 @@ get_group_value_fast(GENERIC_ADDR_SPACE int64_t* groups_buffer,
   return groups_buffer + off + 1;
 }
 
+// The buffer isn't initialized before the kernel run. The initial row and the
+// occupancy bitmap of entries follow the last entry, a row is copied from the initial
+// one on the first touch.
+extern "C" RUNTIME_EXPORT ALWAYS_INLINE DEVICE GENERIC_ADDR_SPACE int64_t*
+get_group_value_fast_first_touch(GENERIC_ADDR_SPACE int64_t* groups_buffer,
+                                 const int64_t key,
+                                 const int64_t min_key,
+                                 const int64_t bucket,
+                                 const uint32_t row_size_quad,
+                                 const int64_t entry_count) {
+  int64_t key_diff = key - min_key;
+  if (bucket) {
+    key_diff /= bucket;
+  }
+  int64_t off = key_diff * row_size_quad;
+  GENERIC_ADDR_SPACE const int64_t* init_row =
+      groups_buffer + entry_count * row_size_quad;
+  GENERIC_ADDR_SPACE uint64_t* occupancy =
+      reinterpret_cast<GENERIC_ADDR_SPACE uint64_t*>(init_row + row_size_quad);
+  const uint64_t mask = 1ULL << (key_diff & 63);
+  if (!(occupancy[key_diff >> 6] & mask)) {
+    occupancy[key_diff >> 6] |= mask;
+    groups_buffer[off] = key;
+    for (uint32_t i = 1; i < row_size_quad; ++i) {
+      groups_buffer[off + i] = init_row[i];
+    }
+  }
+  return groups_buffer + off + 1;
+}
+
 extern "C" RUNTIME_EXPORT ALWAYS_INLINE DEVICE GENERIC_ADDR_SPACE int64_t*
 get_group_value_fast_with_original_key(GENERIC_ADDR_SPACE int64_t* groups_buffer,
                                        const int64_t key,
@@ -361,6 +443,72 @@ hash_join_idx_bitwise(int64_t hash_buff,
              : hash_join_idx(hash_buff, translated_val, min_key, translated_val);
 }
 
+// Sorted join table layout: [int64 key count][sorted int64 keys][int32 row ids].
+extern "C" RUNTIME_EXPORT ALWAYS_INLINE DEVICE int64_t
+sorted_join_key_count(int64_t sorted_buff) {
+  return *reinterpret_cast<GENERIC_ADDR_SPACE const int64_t*>(sorted_buff);
+}
+
+extern "C" RUNTIME_EXPORT ALWAYS_INLINE DEVICE int64_t
+sorted_join_lower_bound(int64_t sorted_buff, const int64_t key) {
+  const auto buff = reinterpret_cast<GENERIC_ADDR_SPACE const int64_t*>(sorted_buff);
+  const auto keys = buff + 1;
+  int64_t lo = 0;
+  int64_t hi = buff[0];
+  while (lo < hi) {
+    const int64_t mid = lo + (hi - lo) / 2;
+    if (keys[mid] < key) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+extern "C" RUNTIME_EXPORT ALWAYS_INLINE DEVICE int64_t
+sorted_join_upper_bound(int64_t sorted_buff, const int64_t key) {
+  const auto buff = reinterpret_cast<GENERIC_ADDR_SPACE const int64_t*>(sorted_buff);
+  const auto keys = buff + 1;
+  int64_t lo = 0;
+  int64_t hi = buff[0];
+  while (lo < hi) {
+    const int64_t mid = lo + (hi - lo) / 2;
+    if (keys[mid] <= key) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+// Start of the keys range for intervals containing the key. Keys are interval
+// starts and no interval is longer than max_length.
+extern "C" RUNTIME_EXPORT ALWAYS_INLINE DEVICE int64_t
+sorted_join_interval_start(int64_t sorted_buff,
+                           const int64_t key,
+                           const int64_t max_length) {
+  if (max_length > 0 && key < INT64_MIN + max_length) {
+    return 0;
+  }
+  if (max_length < 0 && key > INT64_MAX + max_length) {
+    return sorted_join_key_count(sorted_buff);
+  }
+  return sorted_join_lower_bound(sorted_buff, key - max_length);
+}
+
+extern "C" RUNTIME_EXPORT ALWAYS_INLINE DEVICE int64_t
+sorted_join_rowids(int64_t sorted_buff) {
+  return sorted_buff + (sorted_join_key_count(sorted_buff) + 1) * sizeof(int64_t);
+}
+
+// Key of a none-encoded string in sorted join tables on strings.
+extern "C" RUNTIME_EXPORT ALWAYS_INLINE DEVICE int64_t
+sorted_join_string_key(GENERIC_ADDR_SPACE const int8_t* str, const int32_t len) {
+  return MurmurHash64A(str, len, 0);
+}
+
 #define DEF_TRANSLATE_NULL_KEY(key_type)                                               \
   extern "C" RUNTIME_EXPORT NEVER_INLINE DEVICE int64_t translate_null_key_##key_type( \
       const key_type key, const key_type null_val, const int64_t translated_val) {     \
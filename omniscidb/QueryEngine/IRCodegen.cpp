@@ -18,14 +18,56 @@
 #include "Execute.h"
 #include "ExternalExecutor.h"
 #include "IR/ExprCollector.h"
+#include "JoinHashTable/SortedJoinTable.h"
 #include "MaxwellCodegenPatch.h"
 #include "RelAlgTranslator.h"
+#include "Shared/Metrics.h"
 
 // Driver methods for the IR generation.
 
 std::vector<llvm::Value*> CodeGenerator::codegen(const hdk::ir::Expr* expr,
                                                  const bool fetch_columns,
                                                  const CompilationOptions& co) {
+  if (!expr || !fetch_columns || cgen_state_->common_subexpr_cache_.empty()) {
+    return codegenExpr(expr, fetch_columns, co);
+  }
+  if (auto cached_lvs = cgen_state_->getCommonSubexprValues(expr)) {
+    return *cached_lvs;
+  }
+  auto lvs = codegenExpr(expr, fetch_columns, co);
+  cgen_state_->setCommonSubexprValues(expr, lvs);
+  return lvs;
+}
+
+void CodeGenerator::codegenExpressionCounter(const char* kind,
+                                             const hdk::ir::Expr* expr,
+                                             const CompilationOptions& co) {
+  if (!config_.exec.codegen.enable_expression_counters ||
+      co.device_type != ExecutorDeviceType::CPU) {
+    return;
+  }
+  // The counter address is embedded in the code. Counters are never freed and the
+  // address is the same for the same expression, so cached code stays valid.
+  auto& counter = metrics::Registry::get().counter(
+      "hdk_expression_evaluations_total",
+      "Rows evaluated by expressions of generated code.",
+      {{"kind", kind}, {"expr", expr->toString()}});
+  static_assert(sizeof(std::atomic<uint64_t>) == sizeof(int64_t));
+  auto counter_ptr = cgen_state_->ir_builder_.CreateIntToPtr(
+      cgen_state_->llInt(reinterpret_cast<int64_t>(counter.data())),
+      llvm::Type::getInt64PtrTy(cgen_state_->context_));
+  cgen_state_->ir_builder_.CreateAtomicRMW(llvm::AtomicRMWInst::Add,
+                                           counter_ptr,
+                                           cgen_state_->llInt(int64_t(1)),
+#if LLVM_VERSION_MAJOR > 12
+                                           LLVM_ALIGN(8),
+#endif
+                                           llvm::AtomicOrdering::Monotonic);
+}
+
+std::vector<llvm::Value*> CodeGenerator::codegenExpr(const hdk::ir::Expr* expr,
+                                                     const bool fetch_columns,
+                                                     const CompilationOptions& co) {
   AUTOMATIC_IR_METADATA(cgen_state_);
   if (!expr) {
     return {posArg(expr)};
@@ -486,6 +528,66 @@ void check_if_loop_join_is_allowed(RelAlgExecutionUnit& ra_exe_unit,
   }
 }
 
+// Comparison of an inner column with an expression over outer tables, used to scan the
+// inner column for matching rows in loop joins. Normalized to `inner_col op outer_expr`.
+struct LoopJoinScanQual {
+  const hdk::ir::ColumnVar* inner_col;
+  const hdk::ir::Expr* outer_expr;
+  hdk::ir::OpType op;
+};
+
+class RteIdxCollector : public hdk::ir::ExprCollector<std::set<int>, RteIdxCollector> {
+ protected:
+  void visitColumnVar(const hdk::ir::ColumnVar* col_var) final {
+    result_.insert(col_var->rteIdx());
+  }
+};
+
+bool loop_join_scan_types_match(const hdk::ir::Type* inner_type,
+                                const hdk::ir::Type* outer_type) {
+  if (inner_type->isInteger() || inner_type->isFloatingPoint()) {
+    return inner_type->id() == outer_type->id();
+  }
+  if (inner_type->isDecimal() && outer_type->isDecimal()) {
+    return inner_type->size() == 8 && outer_type->size() == 8 &&
+           inner_type->as<hdk::ir::DecimalType>()->scale() ==
+               outer_type->as<hdk::ir::DecimalType>()->scale();
+  }
+  return false;
+}
+
+std::optional<LoopJoinScanQual> get_loop_join_scan_qual(
+    const std::list<hdk::ir::ExprPtr>& quals,
+    const size_t level_idx) {
+  for (const auto& qual : quals) {
+    const auto bin_oper = dynamic_cast<const hdk::ir::BinOper*>(qual.get());
+    if (!bin_oper || !hdk::ir::isComparison(bin_oper->opType()) ||
+        bin_oper->opType() == hdk::ir::OpType::kBwEq ||
+        bin_oper->qualifier() != hdk::ir::Qualifier::kOne) {
+      continue;
+    }
+    auto inner_col = dynamic_cast<const hdk::ir::ColumnVar*>(bin_oper->rightOperand());
+    auto outer_expr = bin_oper->leftOperand();
+    auto op = hdk::ir::commuteComparison(bin_oper->opType());
+    if (!inner_col || inner_col->rteIdx() != static_cast<int>(level_idx + 1)) {
+      inner_col = dynamic_cast<const hdk::ir::ColumnVar*>(bin_oper->leftOperand());
+      outer_expr = bin_oper->rightOperand();
+      op = bin_oper->opType();
+    }
+    if (!inner_col || inner_col->rteIdx() != static_cast<int>(level_idx + 1) ||
+        !loop_join_scan_types_match(inner_col->type(), outer_expr->type())) {
+      continue;
+    }
+    const auto outer_rte_idxs = RteIdxCollector::collect(outer_expr);
+    if (!outer_rte_idxs.empty() &&
+        *outer_rte_idxs.rbegin() > static_cast<int>(level_idx)) {
+      continue;
+    }
+    return LoopJoinScanQual{inner_col, outer_expr, op};
+  }
+  return std::nullopt;
+}
+
 void check_valid_join_qual(std::shared_ptr<const hdk::ir::BinOper>& bin_oper) {
   // check whether a join qual is valid before entering the hashtable build and codegen
 
@@ -645,6 +747,52 @@ std::vector<JoinLoop> Executor::buildJoinLoops(
             }
             return left_join_cond;
           };
+      const auto scan_qual =
+          co.device_type == ExecutorDeviceType::CPU &&
+                  config_->exec.join.enable_loop_join_scan
+              ? get_loop_join_scan_qual(current_level_join_conditions.quals, level_idx)
+              : std::nullopt;
+      if (scan_qual && !plan_state_->isLazyFetchColumn(scan_qual->inner_col)) {
+        // Select the inner rows matching the comparison by a scan of the inner column
+        // and iterate over them only. All join quals are still checked for the selected
+        // rows.
+        VLOG(1) << "Scanning " << scan_qual->inner_col->toString()
+                << " for inner rows of the loop join";
+        join_loops.emplace_back(
+            /*kind=*/JoinLoopKind::Set,
+            /*type=*/current_level_join_conditions.type,
+            /*iteration_domain_codegen=*/
+            [this, level_idx, scan_qual = *scan_qual, &co](
+                const std::vector<llvm::Value*>& prev_iters) {
+              addJoinLoopIterator(prev_iters, level_idx);
+              JoinLoopDomain domain{{0}};
+              const auto matches = codegenLoopJoinScan(scan_qual.inner_col,
+                                                       scan_qual.outer_expr,
+                                                       scan_qual.op,
+                                                       level_idx,
+                                                       co);
+              domain.element_count = cgen_state_->ir_builder_.CreateSExt(
+                  cgen_state_->ir_builder_.CreateLoad(
+                      matches->getType()->getPointerElementType(), matches),
+                  get_int_type(64, cgen_state_->context_));
+              domain.values_buffer = cgen_state_->ir_builder_.CreateGEP(
+                  matches->getType()->getPointerElementType(),
+                  matches,
+                  cgen_state_->llInt(int64_t(1)));
+              return domain;
+            },
+            /*outer_condition_match=*/
+            current_level_join_conditions.type == JoinType::LEFT
+                ? std::function<llvm::Value*(const std::vector<llvm::Value*>&)>(
+                      outer_join_condition_cb)
+                : nullptr,
+            /*found_outer_matches=*/
+            current_level_join_conditions.type == JoinType::LEFT
+                ? std::function<void(llvm::Value*)>(found_outer_join_matches_cb)
+                : nullptr,
+            /*hoisted_filters=*/nullptr);
+        continue;
+      }
       join_loops.emplace_back(
           /*kind=*/JoinLoopKind::UpperBound,
           /*type=*/current_level_join_conditions.type,
@@ -678,6 +826,248 @@ std::vector<JoinLoop> Executor::buildJoinLoops(
   return join_loops;
 }
 
+llvm::Value* Executor::codegenLoopJoinScan(const hdk::ir::ColumnVar* inner_col,
+                                           const hdk::ir::Expr* outer_expr,
+                                           const hdk::ir::OpType op,
+                                           const size_t level_idx,
+                                           const CompilationOptions& co) {
+  AUTOMATIC_IR_METADATA(cgen_state_.get());
+  CHECK(co.device_type == ExecutorDeviceType::CPU);
+  CodeGenerator code_generator(this, co.codegen_traits_desc);
+  auto outer_lv = code_generator.codegen(outer_expr, true, co).front();
+  auto* arg = get_arg_by_name(cgen_state_->row_func_, "num_rows_per_scan");
+  const auto rows_per_scan_ptr = cgen_state_->ir_builder_.CreateGEP(
+      arg->getType()->getScalarType()->getPointerElementType(),
+      arg,
+      cgen_state_->llInt(int32_t(level_idx + 1)));
+  const auto num_rows = cgen_state_->ir_builder_.CreateLoad(
+      rows_per_scan_ptr->getType()->getPointerElementType(),
+      rows_per_scan_ptr,
+      "num_rows_per_scan");
+  const auto inner_type = inner_col->type();
+  const auto outer_type = outer_expr->type();
+  const bool is_fp = inner_type->isFloatingPoint();
+  llvm::Value* outer_is_null = cgen_state_->llBool(false);
+  std::vector<llvm::Value*> args{
+      code_generator.colByteStream(inner_col, true, co.hoist_literals),
+      cgen_state_->llInt(int32_t(inner_type->size())),
+      num_rows,
+      cgen_state_->llInt(static_cast<int32_t>(op))};
+  if (is_fp) {
+    if (outer_type->nullable()) {
+      outer_is_null = cgen_state_->ir_builder_.CreateFCmpOEQ(
+          outer_lv, cgen_state_->inlineFpNull(outer_type));
+    }
+    args.push_back(cgen_state_->castToTypeIn(outer_lv, 64));
+    args.push_back(cgen_state_->llFp(inline_fp_null_value(inner_type)));
+  } else {
+    if (outer_type->nullable()) {
+      outer_is_null = cgen_state_->ir_builder_.CreateICmpEQ(
+          outer_lv, cgen_state_->inlineIntNull(outer_type));
+    }
+    args.push_back(cgen_state_->castToTypeIn(outer_lv, 64));
+    args.push_back(cgen_state_->llInt(inline_fixed_encoding_null_value(inner_type)));
+  }
+  args.push_back(cgen_state_->llInt(int8_t(inner_type->nullable())));
+  args.push_back(cgen_state_->ir_builder_.CreateZExt(
+      outer_is_null, get_int_type(8, cgen_state_->context_)));
+  args.push_back(cgen_state_->llInt(int32_t(level_idx)));
+  return cgen_state_->emitExternalCall(
+      is_fp ? "loop_join_scan_fp" : "loop_join_scan_int",
+      llvm::Type::getInt32PtrTy(cgen_state_->context_),
+      args);
+}
+
+namespace {
+
+// Inner rows are compared in blocks which fit into L1 cache. The comparison results of a
+// block are computed into a mask by a loop without branches, which the compiler
+// vectorizes, and then the matching rows are appended to the output.
+constexpr int64_t kLoopJoinScanBlockSize = 1024;
+
+template <typename T, typename V, typename Cmp>
+int32_t loop_join_scan_impl(const T* col,
+                            const int64_t num_rows,
+                            const V val,
+                            const T null_val,
+                            const bool nullable,
+                            const Cmp& cmp,
+                            int32_t* out) {
+  int32_t count = 0;
+  uint8_t mask[kLoopJoinScanBlockSize];
+  for (int64_t block_start = 0; block_start < num_rows;
+       block_start += kLoopJoinScanBlockSize) {
+    const auto block = col + block_start;
+    const auto block_size = std::min(kLoopJoinScanBlockSize, num_rows - block_start);
+    if (nullable) {
+      for (int64_t i = 0; i < block_size; ++i) {
+        mask[i] = cmp(static_cast<V>(block[i]), val) & (block[i] != null_val);
+      }
+    } else {
+      for (int64_t i = 0; i < block_size; ++i) {
+        mask[i] = cmp(static_cast<V>(block[i]), val);
+      }
+    }
+    for (int64_t i = 0; i < block_size; ++i) {
+      out[count] = static_cast<int32_t>(block_start + i);
+      count += mask[i];
+    }
+  }
+  return count;
+}
+
+template <typename T, typename V>
+int32_t loop_join_scan_op(const T* col,
+                          const int64_t num_rows,
+                          const hdk::ir::OpType op,
+                          const V val,
+                          const T null_val,
+                          const bool nullable,
+                          int32_t* out) {
+  switch (op) {
+    case hdk::ir::OpType::kEq:
+      return loop_join_scan_impl(
+          col, num_rows, val, null_val, nullable, std::equal_to<V>(), out);
+    case hdk::ir::OpType::kNe:
+      return loop_join_scan_impl(
+          col, num_rows, val, null_val, nullable, std::not_equal_to<V>(), out);
+    case hdk::ir::OpType::kLt:
+      return loop_join_scan_impl(
+          col, num_rows, val, null_val, nullable, std::less<V>(), out);
+    case hdk::ir::OpType::kLe:
+      return loop_join_scan_impl(
+          col, num_rows, val, null_val, nullable, std::less_equal<V>(), out);
+    case hdk::ir::OpType::kGt:
+      return loop_join_scan_impl(
+          col, num_rows, val, null_val, nullable, std::greater<V>(), out);
+    case hdk::ir::OpType::kGe:
+      return loop_join_scan_impl(
+          col, num_rows, val, null_val, nullable, std::greater_equal<V>(), out);
+    default:
+      CHECK(false);
+  }
+  return 0;
+}
+
+// Returns the buffer for matching rows of the given loop join level, the first element
+// is reserved for the number of matches. Buffers are kept per thread and reused by the
+// following scans on the same level.
+int32_t* loop_join_scan_buffer(const int32_t level_idx, const int64_t num_rows) {
+  thread_local std::vector<std::vector<int32_t>> buffers;
+  if (buffers.size() <= static_cast<size_t>(level_idx)) {
+    buffers.resize(level_idx + 1);
+  }
+  auto& buffer = buffers[level_idx];
+  if (buffer.size() < static_cast<size_t>(num_rows + 1)) {
+    buffer.resize(num_rows + 1);
+  }
+  return buffer.data();
+}
+
+}  // namespace
+
+// Selects the inner rows for which `inner_col op val` holds. Returns the number of
+// selected rows followed by their positions.
+extern "C" RUNTIME_EXPORT const int32_t* loop_join_scan_int(const int8_t* col_buf,
+                                                            const int32_t elem_size,
+                                                            const int64_t num_rows,
+                                                            const int32_t op,
+                                                            const int64_t val,
+                                                            const int64_t null_val,
+                                                            const int8_t nullable,
+                                                            const int8_t val_is_null,
+                                                            const int32_t level_idx) {
+  auto buffer = loop_join_scan_buffer(level_idx, num_rows);
+  auto out = buffer + 1;
+  const auto op_type = static_cast<hdk::ir::OpType>(op);
+  if (val_is_null) {
+    buffer[0] = 0;
+    return buffer;
+  }
+  switch (elem_size) {
+    case 1:
+      buffer[0] = loop_join_scan_op(col_buf,
+                                    num_rows,
+                                    op_type,
+                                    val,
+                                    static_cast<int8_t>(null_val),
+                                    nullable,
+                                    out);
+      break;
+    case 2:
+      buffer[0] = loop_join_scan_op(reinterpret_cast<const int16_t*>(col_buf),
+                                    num_rows,
+                                    op_type,
+                                    val,
+                                    static_cast<int16_t>(null_val),
+                                    nullable,
+                                    out);
+      break;
+    case 4:
+      buffer[0] = loop_join_scan_op(reinterpret_cast<const int32_t*>(col_buf),
+                                    num_rows,
+                                    op_type,
+                                    val,
+                                    static_cast<int32_t>(null_val),
+                                    nullable,
+                                    out);
+      break;
+    case 8:
+      buffer[0] = loop_join_scan_op(reinterpret_cast<const int64_t*>(col_buf),
+                                    num_rows,
+                                    op_type,
+                                    val,
+                                    null_val,
+                                    nullable,
+                                    out);
+      break;
+    default:
+      CHECK(false);
+  }
+  return buffer;
+}
+
+extern "C" RUNTIME_EXPORT const int32_t* loop_join_scan_fp(const int8_t* col_buf,
+                                                           const int32_t elem_size,
+                                                           const int64_t num_rows,
+                                                           const int32_t op,
+                                                           const double val,
+                                                           const double null_val,
+                                                           const int8_t nullable,
+                                                           const int8_t val_is_null,
+                                                           const int32_t level_idx) {
+  auto buffer = loop_join_scan_buffer(level_idx, num_rows);
+  auto out = buffer + 1;
+  const auto op_type = static_cast<hdk::ir::OpType>(op);
+  if (val_is_null) {
+    buffer[0] = 0;
+    return buffer;
+  }
+  switch (elem_size) {
+    case 4:
+      buffer[0] = loop_join_scan_op(reinterpret_cast<const float*>(col_buf),
+                                    num_rows,
+                                    op_type,
+                                    val,
+                                    static_cast<float>(null_val),
+                                    nullable,
+                                    out);
+      break;
+    case 8:
+      buffer[0] = loop_join_scan_op(reinterpret_cast<const double*>(col_buf),
+                                    num_rows,
+                                    op_type,
+                                    val,
+                                    null_val,
+                                    nullable,
+                                    out);
+      break;
+    default:
+      CHECK(false);
+  }
+  return buffer;
+}
+
 namespace {
 
 class ExprTableIdCollector
@@ -813,6 +1203,54 @@ std::shared_ptr<HashJoin> Executor::buildCurrentLevelHashTable(
       add_qualifier_to_execution_unit(ra_exe_unit, qual);
     }
   };
+  const bool has_equi_join_qual =
+      std::any_of(current_level_join_conditions.quals.begin(),
+                  current_level_join_conditions.quals.end(),
+                  [](const hdk::ir::ExprPtr& qual) {
+                    auto bin_oper = dynamic_cast<const hdk::ir::BinOper*>(qual.get());
+                    return bin_oper && bin_oper->isEquivalence();
+                  });
+  // Join levels without equi-join conditions would otherwise require a loop join.
+  if (config_->exec.join.enable_range_join && co.device_type == ExecutorDeviceType::CPU &&
+      !has_equi_join_qual) {
+    std::vector<std::shared_ptr<const hdk::ir::BinOper>> range_quals;
+    try {
+      current_level_hash_table = SortedJoinTable::getRangeInstance(
+          current_level_join_conditions.quals,
+          query_infos,
+          MemoryLevel::CPU_LEVEL,
+          deviceCountForMemoryLevel(MemoryLevel::CPU_LEVEL),
+          data_provider,
+          column_cache,
+          this,
+          range_quals);
+    } catch (const HashJoinFail& e) {
+      VLOG(2) << "Building a range join table fails: " << e.what();
+      fail_reasons.emplace_back(e.what());
+    } catch (const TooManyHashEntries& e) {
+      fail_reasons.emplace_back(e.what());
+    }
+    if (current_level_hash_table) {
+      CHECK(!range_quals.empty());
+      plan_state_->join_info_.join_hash_tables_.push_back(current_level_hash_table);
+      plan_state_->join_info_.equi_join_tautologies_.push_back(range_quals.front());
+      for (const auto& join_qual : current_level_join_conditions.quals) {
+        if (std::find(range_quals.begin(), range_quals.end(), join_qual) ==
+            range_quals.end()) {
+          handleNonHashtableQual(current_level_join_conditions.type, join_qual);
+        }
+      }
+      return current_level_hash_table;
+    }
+  }
+  // Semi and anti join hash tables keep a single inner row per key. Other conditions of
+  // the level are checked against the matched inner row, so they need all inner rows of
+  // a key and the table is built as for an inner join then.
+  auto hash_table_join_type = current_level_join_conditions.type;
+  if (HashJoin::isSemiOrAntiJoin(hash_table_join_type) &&
+      current_level_join_conditions.quals.size() > 1) {
+    hash_table_join_type = JoinType::INNER;
+  }
   for (const auto& join_qual : current_level_join_conditions.quals) {
     auto qual_bin_oper = std::dynamic_pointer_cast<const hdk::ir::BinOper>(join_qual);
     if (current_level_hash_table || !qual_bin_oper || !qual_bin_oper->isEquivalence()) {
@@ -830,7 +1268,7 @@ std::shared_ptr<HashJoin> Executor::buildCurrentLevelHashTable(
           query_infos,
           co.device_type == ExecutorDeviceType::GPU ? MemoryLevel::GPU_LEVEL
                                                     : MemoryLevel::CPU_LEVEL,
-          current_level_join_conditions.type,
+          hash_table_join_type,
           HashType::OneToOne,
           data_provider,
           column_cache,
@@ -841,6 +1279,9 @@ std::shared_ptr<HashJoin> Executor::buildCurrentLevelHashTable(
     if (hash_table_or_error.hash_table) {
       plan_state_->join_info_.join_hash_tables_.push_back(hash_table_or_error.hash_table);
       plan_state_->join_info_.equi_join_tautologies_.push_back(qual_bin_oper);
+      if (hash_table_or_error.hash_table->matchesKeyHashes()) {
+        handleNonHashtableQual(current_level_join_conditions.type, qual_bin_oper);
+      }
     } else {
       fail_reasons.push_back(hash_table_or_error.fail_reason);
       if (!current_level_hash_table) {
@@ -1196,6 +1637,24 @@ Executor::GroupColLLVMValue Executor::groupByColumnCodegen(
                   {group_key,
                    code_generator.posArg(arr_expr),
                    cgen_state_->llInt(log2_bytes(elem_type->canonicalSize()))});
+    const auto ar_ret_ty =
+        elem_type->isFloatingPoint()
+            ? (elem_type->isFp64() ? llvm::Type::getDoubleTy(cgen_state_->context_)
+                                   : llvm::Type::getFloatTy(cgen_state_->context_))
+            : get_int_type(elem_type->canonicalSize() * 8, cgen_state_->context_);
+    // Look up the array of the row once, elements are loaded from its buffer in the
+    // loop rather than through a runtime call per element, which lets LLVM optimize
+    // the loop.
+    compiler::CodegenTraits cgen_traits =
+        compiler::CodegenTraits::get(co.codegen_traits_desc);
+    auto array_buff = cgen_state_->emitExternalCall(
+        "array_buff",
+        cgen_traits.localPointerType(get_int_type(8, cgen_state_->context_)),
+        {group_key, code_generator.posArg(arr_expr)});
+    auto array_elems = cgen_state_->ir_builder_.CreatePointerCast(
+        array_buff,
+        llvm::PointerType::get(ar_ret_ty,
+                               array_buff->getType()->getPointerAddressSpace()));
     cgen_state_->ir_builder_.CreateBr(array_loop_head);
     cgen_state_->ir_builder_.SetInsertPoint(array_loop_head);
     CHECK(array_len);
@@ -1213,22 +1672,9 @@ Executor::GroupColLLVMValue Executor::groupByColumnCodegen(
     cgen_state_->ir_builder_.CreateStore(
         cgen_state_->ir_builder_.CreateAdd(array_idx, cgen_state_->llInt(int32_t(1))),
         array_idx_ptr);
-    auto array_at_fname = "array_at_" + numeric_type_name(elem_type);
-    if (array_type->size() < 0) {
-      if (!array_type->nullable()) {
-        array_at_fname = "notnull_" + array_at_fname;
-      }
-      array_at_fname = "varlen_" + array_at_fname;
-    }
-    const auto ar_ret_ty =
-        elem_type->isFloatingPoint()
-            ? (elem_type->isFp64() ? llvm::Type::getDoubleTy(cgen_state_->context_)
-                                   : llvm::Type::getFloatTy(cgen_state_->context_))
-            : get_int_type(elem_type->canonicalSize() * 8, cgen_state_->context_);
-    group_key = cgen_state_->emitExternalCall(
-        array_at_fname,
+    group_key = cgen_state_->ir_builder_.CreateLoad(
         ar_ret_ty,
-        {group_key, code_generator.posArg(arr_expr), array_idx});
+        cgen_state_->ir_builder_.CreateGEP(ar_ret_ty, array_elems, array_idx));
     if (need_patch_unnest_double(
             elem_type, isArchMaxwell(co.device_type), thread_mem_shared)) {
       key_to_cache = spillDoubleElement(group_key, ar_ret_ty);
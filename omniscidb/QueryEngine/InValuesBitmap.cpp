@@ -24,16 +24,10 @@
 #include "RuntimeFunctions.h"
 #include "Shared/checked_alloc.h"
 
-#include <boost/multiprecision/cpp_int.hpp>
+#include <algorithm>
+#include <cstring>
 #include <limits>
 
-using checked_int64_t = boost::multiprecision::number<
-    boost::multiprecision::cpp_int_backend<64,
-                                           64,
-                                           boost::multiprecision::signed_magnitude,
-                                           boost::multiprecision::checked,
-                                           void>>;
-
 InValuesBitmap::InValuesBitmap(const std::vector<int64_t>& values,
                                const int64_t null_val,
                                const Data_Namespace::MemoryLevel memory_level,
@@ -74,26 +68,45 @@ InValuesBitmap::InValuesBitmap(const std::vector<int64_t>& values,
     return;
   }
   const int64_t MAX_BITMAP_BITS{8 * 1000 * 1000 * 1000LL};
-  const auto bitmap_sz_bits =
-      static_cast<int64_t>(checked_int64_t(max_val_) - min_val_ + 1);
-  if (bitmap_sz_bits > MAX_BITMAP_BITS) {
-    throw FailedToCreateBitmap();
-  }
-  const auto bitmap_sz_bytes = bitmap_bits_to_bytes(bitmap_sz_bits);
-  auto cpu_bitset = static_cast<int8_t*>(checked_calloc(bitmap_sz_bytes, 1));
-  for (const auto value : values) {
-    if (value == null_val) {
-      continue;
+  // A bitmap probe is a single load, so the bitmap is preferred while it is not much
+  // bigger than a hash table would be.
+  const int64_t MAX_BITMAP_TO_HASH_SET_RATIO{8};
+  const int64_t MIN_BITMAP_LIMIT_BYTES{1 << 20};
+  // The difference fits uint64_t even when the range doesn't fit int64_t.
+  const uint64_t max_bitmap_idx =
+      static_cast<uint64_t>(max_val_) - static_cast<uint64_t>(min_val_);
+  const auto hash_set_sz_bytes =
+      static_cast<int64_t>(sizeof(int64_t) * 2 * values.size());
+  const auto bitmap_limit_bytes =
+      std::max(MIN_BITMAP_LIMIT_BYTES, hash_set_sz_bytes * MAX_BITMAP_TO_HASH_SET_RATIO);
+  is_hash_set_ = max_bitmap_idx >= static_cast<uint64_t>(MAX_BITMAP_BITS) ||
+                 static_cast<int64_t>(max_bitmap_idx / 8) > bitmap_limit_bytes;
+
+  size_t buffer_sz_bytes;
+  int8_t* cpu_bitset;
+  if (is_hash_set_) {
+    auto hash_set = buildHashSet(values);
+    buffer_sz_bytes = hash_set.size() * sizeof(int64_t);
+    cpu_bitset = static_cast<int8_t*>(checked_malloc(buffer_sz_bytes));
+    memcpy(cpu_bitset, hash_set.data(), buffer_sz_bytes);
+  } else {
+    const auto bitmap_sz_bits = static_cast<int64_t>(max_bitmap_idx + 1);
+    buffer_sz_bytes = bitmap_bits_to_bytes(bitmap_sz_bits);
+    cpu_bitset = static_cast<int8_t*>(checked_calloc(buffer_sz_bytes, 1));
+    for (const auto value : values) {
+      if (value == null_val) {
+        continue;
+      }
+      agg_count_distinct_bitmap(reinterpret_cast<int64_t*>(&cpu_bitset), value, min_val_);
     }
-    agg_count_distinct_bitmap(reinterpret_cast<int64_t*>(&cpu_bitset), value, min_val_);
   }
 #if defined(HAVE_CUDA) || defined(HAVE_L0)
   if (memory_level_ == Data_Namespace::GPU_LEVEL) {
     for (int device_id = 0; device_id < device_count_; ++device_id) {
       gpu_buffers_.emplace_back(GpuAllocator::allocGpuAbstractBuffer(
-          buffer_provider, bitmap_sz_bytes, device_id));
+          buffer_provider, buffer_sz_bytes, device_id));
       auto gpu_bitset = gpu_buffers_.back()->getMemoryPtr();
-      buffer_provider->copyToDevice(gpu_bitset, cpu_bitset, bitmap_sz_bytes, device_id);
+      buffer_provider->copyToDevice(gpu_bitset, cpu_bitset, buffer_sz_bytes, device_id);
       bitsets_.push_back(gpu_bitset);
     }
     free(cpu_bitset);
@@ -106,6 +119,36 @@ InValuesBitmap::InValuesBitmap(const std::vector<int64_t>& values,
 #endif  // HAVE_CUDA
 }
 
+std::vector<int64_t> InValuesBitmap::buildHashSet(const std::vector<int64_t>& values) {
+  // Keep the load factor under 1/2, so each probe sequence is short and ends with
+  // a bucket having an empty slot.
+  size_t bucket_count = 1;
+  while (bucket_count * kInValuesHashBucketSlots < 2 * values.size()) {
+    bucket_count *= 2;
+  }
+  bucket_mask_ = static_cast<int64_t>(bucket_count - 1);
+  std::vector<int64_t> slots(bucket_count * kInValuesHashBucketSlots, null_val_);
+  for (const auto value : values) {
+    if (value == null_val_) {
+      continue;
+    }
+    for (auto bucket = in_values_hash_bucket(value, bucket_mask_);;
+         bucket = (bucket + 1) & bucket_mask_) {
+      auto bucket_slots = slots.begin() + bucket * kInValuesHashBucketSlots;
+      auto bucket_end = bucket_slots + kInValuesHashBucketSlots;
+      if (std::find(bucket_slots, bucket_end, value) != bucket_end) {
+        break;
+      }
+      auto empty_slot = std::find(bucket_slots, bucket_end, null_val_);
+      if (empty_slot != bucket_end) {
+        *empty_slot = value;
+        break;
+      }
+    }
+  }
+  return slots;
+}
+
 InValuesBitmap::~InValuesBitmap() {
   if (bitsets_.empty()) {
     return;
@@ -151,6 +194,17 @@ llvm::Value* InValuesBitmap::codegen(
   const auto bitset_handle_lvs =
       code_generator.codegenHoistedConstants(constants, false, 0);
   CHECK_EQ(size_t(1), bitset_handle_lvs.size());
+  if (is_hash_set_) {
+    return executor->cgen_state_->emitCall(
+        "hash_set_contains",
+        {executor->cgen_state_->castToTypeIn(bitset_handle_lvs.front(), 64),
+         needle_i64,
+         executor->cgen_state_->llInt(min_val_),
+         executor->cgen_state_->llInt(max_val_),
+         executor->cgen_state_->llInt(bucket_mask_),
+         executor->cgen_state_->llInt(null_val_),
+         executor->cgen_state_->llInt(null_bool_val)});
+  }
   return executor->cgen_state_->emitCall(
       "bit_is_set",
       {executor->cgen_state_->castToTypeIn(bitset_handle_lvs.front(), 64),
@@ -39,6 +39,8 @@ class FailedToCreateBitmap : public std::runtime_error {
   FailedToCreateBitmap() : std::runtime_error("FailedToCreateBitmap") {}
 };
 
+// Set of integer values for IN expressions. Dense values are stored in a bitmap.
+// Sparse values, for which a bitmap would be too big, are stored in a hash table.
 class InValuesBitmap {
  public:
   InValuesBitmap(const std::vector<int64_t>& values,
@@ -58,10 +60,16 @@ class InValuesBitmap {
 
   size_t gpuBuffers() const { return gpu_buffers_.size(); }
 
+  bool isHashSet() const { return is_hash_set_; }
+
  private:
+  std::vector<int64_t> buildHashSet(const std::vector<int64_t>& values);
+
   std::vector<Data_Namespace::AbstractBuffer*> gpu_buffers_;
   std::vector<int8_t*> bitsets_;
   bool rhs_has_null_;
+  bool is_hash_set_{false};
+  int64_t bucket_mask_{0};
   int64_t min_val_;
   int64_t max_val_;
   const int64_t null_val_;
@@ -17,6 +17,8 @@
 #include "InputMetadata.h"
 #include "Execute.h"
 
+#include <cstdlib>
+
 InputTableInfoCache::InputTableInfoCache(Executor* executor) : executor_(executor) {}
 
 namespace {
@@ -25,10 +27,30 @@ TableFragmentsInfo copy_table_info(const TableFragmentsInfo& table_info) {
   TableFragmentsInfo table_info_copy;
   table_info_copy.chunkKeyPrefix = table_info.chunkKeyPrefix;
   table_info_copy.fragments = table_info.fragments;
+  table_info_copy.columnStats = table_info.columnStats;
   table_info_copy.setPhysicalNumTuples(table_info.getPhysicalNumTuples());
   return table_info_copy;
 }
 
+// Storages place all fragments on the first GPU. Spread them over all GPUs by their
+// ids so the same fragment is always fetched to the same device, and buffer pools of
+// different GPUs hold different data instead of copies of the same chunks.
+void assign_gpu_fragment_affinity(TableFragmentsInfo& table_info,
+                                  const int table_id,
+                                  const int gpu_count) {
+  if (gpu_count < 2) {
+    return;
+  }
+  for (auto& fragment : table_info.fragments) {
+    if (fragment.deviceIds.size() > Data_Namespace::GPU_LEVEL) {
+      // The table id offsets the first device, so first fragments of different
+      // tables don't all go to the same GPU.
+      const auto key = static_cast<int64_t>(fragment.fragmentId) + std::abs(table_id);
+      fragment.deviceIds[Data_Namespace::GPU_LEVEL] = key % gpu_count;
+    }
+  }
+}
+
 }  // namespace
 
 TableFragmentsInfo InputTableInfoCache::getTableInfo(int db_id, int table_id) {
@@ -40,6 +62,11 @@ TableFragmentsInfo InputTableInfoCache::getTableInfo(int db_id, int table_id) {
   const auto data_mgr = executor_->getDataMgr();
   CHECK(data_mgr);
   auto table_info = data_mgr->getTableMetadata(db_id, table_id);
+  if (executor_->getConfig().exec.enable_gpu_fragment_affinity &&
+      data_mgr->gpusPresent()) {
+    assign_gpu_fragment_affinity(
+        table_info, table_id, data_mgr->getGpuMgr()->getDeviceCount());
+  }
   auto it_ok =
       cache_.emplace(std::make_pair(db_id, table_id), copy_table_info(table_info));
   CHECK(it_ok.second);
@@ -100,12 +127,22 @@ std::vector<InputTableInfo> get_table_infos(const RelAlgExecutionUnit& ra_exe_un
 }
 
 const ChunkMetadataMap& FragmentInfo::getChunkMetadataMap() const {
-  return chunkMetadataMap;
+  static const ChunkMetadataMap empty_map;
+  return chunkMetadataMap ? *chunkMetadataMap : empty_map;
+}
+
+ChunkMetadataMap& FragmentInfo::getMutableChunkMetadataMap() {
+  if (!chunkMetadataMap) {
+    chunkMetadataMap = std::make_shared<ChunkMetadataMap>();
+  } else if (chunkMetadataMap.use_count() > 1) {
+    chunkMetadataMap = std::make_shared<ChunkMetadataMap>(*chunkMetadataMap);
+  }
+  return *chunkMetadataMap;
 }
 
 ChunkMetadataMap FragmentInfo::getChunkMetadataMapPhysicalCopy() const {
   ChunkMetadataMap metadata_map;
-  for (const auto& [column_id, chunk_metadata] : chunkMetadataMap) {
+  for (const auto& [column_id, chunk_metadata] : getChunkMetadataMap()) {
     metadata_map[column_id] = std::make_shared<ChunkMetadata>(*chunk_metadata);
   }
   return metadata_map;
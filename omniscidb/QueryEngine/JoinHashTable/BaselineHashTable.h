@@ -30,7 +30,8 @@ class BaselineHashTable : public HashTable {
   BaselineHashTable(HashType layout,
                     const size_t entry_count,
                     const size_t emitted_keys_count,
-                    const size_t hash_table_size)
+                    const size_t hash_table_size,
+                    const bool use_crc32_key_hash = false)
       : cpu_hash_table_buff_size_(hash_table_size)
       , gpu_hash_table_buff_(nullptr)
 #ifdef HAVE_CUDA
@@ -39,7 +40,8 @@ class BaselineHashTable : public HashTable {
 #endif
       , layout_(layout)
       , entry_count_(entry_count)
-      , emitted_keys_count_(emitted_keys_count) {
+      , emitted_keys_count_(emitted_keys_count)
+      , use_crc32_key_hash_(use_crc32_key_hash) {
     cpu_hash_table_buff_.reset(new int8_t[cpu_hash_table_buff_size_]);
   }
 
@@ -102,6 +104,8 @@ class BaselineHashTable : public HashTable {
   size_t getEmittedKeysCount() const override {
     return emitted_keys_count_;
   }
+  // Keys are hashed with CRC32C instead of MurmurHash, CPU tables only.
+  bool useCrc32KeyHash() const { return use_crc32_key_hash_; }
 
  private:
   std::unique_ptr<int8_t[]> cpu_hash_table_buff_;
@@ -116,4 +120,5 @@ class BaselineHashTable : public HashTable {
   HashType layout_;
   size_t entry_count_;         // number of keys in the hash table
   size_t emitted_keys_count_;  // number of keys emitted across all rows
+  bool use_crc32_key_hash_{false};
 };
@@ -24,7 +24,9 @@
 #include "DataMgr/Allocators/GpuAllocator.h"
 #include "QueryEngine/CodeGenerator.h"
 #include "QueryEngine/ColumnFetcher.h"
+#include "QueryEngine/Crc32cHashInl.h"
 #include "QueryEngine/Execute.h"
+#include "QueryEngine/ExpressionRange.h"
 #include "QueryEngine/ExpressionRewrite.h"
 #include "QueryEngine/JoinHashTable/BaselineHashTable.h"
 #include "QueryEngine/JoinHashTable/Builders/BaselineHashTableBuilder.h"
@@ -41,6 +43,45 @@ QUERYENGINE_EXPORT std::unique_ptr<HashingSchemeRecycler>
     BaselineJoinHashTable::hash_table_layout_cache_;
 std::once_flag BaselineJoinHashTable::init_caches_flag_;
 
+namespace {
+
+bool uses_crc32_key_hash(const HashTable* hash_table) {
+  auto baseline_hash_table = dynamic_cast<const BaselineHashTable*>(hash_table);
+  CHECK(baseline_hash_table);
+  return baseline_hash_table->useCrc32KeyHash();
+}
+
+// Returns the infix of runtime probe functions matching the hash function the table
+// was built with.
+std::string key_hash_func_infix(const HashTable* hash_table) {
+  return uses_crc32_key_hash(hash_table) ? "crc32_" : "";
+}
+
+// Keys of 64-bit inner columns can be stored in 32-bit components when all inner
+// values fit. INT32_MAX is kept out of the ranges to stand for outer values which
+// don't fit and can't match.
+bool can_use_compact_key_components(const std::vector<InnerOuter>& inner_outer_pairs,
+                                    const std::vector<InputTableInfo>& query_infos,
+                                    Executor* executor) {
+  bool has_wide_components = false;
+  for (const auto& inner_outer_pair : inner_outer_pairs) {
+    const auto inner_col = inner_outer_pair.first;
+    if (inner_col->type()->canonicalSize() <= 4) {
+      continue;
+    }
+    const auto col_range = getExpressionRange(inner_col, query_infos, executor);
+    if (col_range.getType() != ExpressionRangeType::Integer ||
+        col_range.getIntMin() < std::numeric_limits<int32_t>::min() ||
+        col_range.getIntMax() >= std::numeric_limits<int32_t>::max()) {
+      return false;
+    }
+    has_wide_components = true;
+  }
+  return has_wide_components;
+}
+
+}  // namespace
+
 //! Make hash table from an in-flight SQL query's parse tree etc.
 std::shared_ptr<BaselineJoinHashTable> BaselineJoinHashTable::getInstance(
     const std::shared_ptr<const hdk::ir::BinOper> condition,
@@ -155,6 +196,15 @@ BaselineJoinHashTable::BaselineJoinHashTable(
     , hashtable_cache_meta_info_(hashtable_cache_meta_info) {
   CHECK_GT(device_count_, 0);
   hash_tables_for_device_.resize(std::max(device_count_, 1));
+  // Null keys of bitwise equality joins are stored as 64-bit null sentinels.
+  compact_key_components_ = executor_->getConfig().exec.join.enable_compact_join_keys &&
+                            !condition_->isBwEq() &&
+                            can_use_compact_key_components(
+                                inner_outer_pairs_, query_infos_, executor_);
+  if (compact_key_components_ && hashtable_cache_key_ != EMPTY_HASHED_PLAN_DAG_KEY) {
+    // Don't share cached tables with tables of full width keys.
+    boost::hash_combine(hashtable_cache_key_, std::string("compact_key_components"));
+  }
 }
 
 std::string BaselineJoinHashTable::toString(const ExecutorDeviceType device_type,
@@ -241,6 +291,11 @@ void BaselineJoinHashTable::reify(const HashType preferred_layout) {
     reifyWithLayout(preferred_layout);
   } catch (const std::exception& e) {
     VLOG(1) << "Caught exception while building baseline hash table: " << e.what();
+    if (isSemiOrAntiJoin(join_type_)) {
+      // semi and anti joins are probed as one-to-one, a one-to-many table would
+      // produce duplicate (semi) or wrong (anti) results
+      throw;
+    }
     freeHashBufferMemory();
     reifyWithLayout(HashType::OneToMany);
   }
@@ -501,6 +556,9 @@ void BaselineJoinHashTable::reifyForDevice(const ColumnsForDevice& columns_for_d
 }
 
 size_t BaselineJoinHashTable::getKeyComponentWidth() const {
+  if (compact_key_components_) {
+    return 4;
+  }
   for (const auto& inner_outer_pair : inner_outer_pairs_) {
     const auto inner_col = inner_outer_pair.first;
     auto inner_col_type = inner_col->type();
@@ -525,6 +583,10 @@ Data_Namespace::MemoryLevel BaselineJoinHashTable::getEffectiveMemoryLevel(
       return Data_Namespace::CPU_LEVEL;
     }
   }
+  if (memory_level_ == Data_Namespace::GPU_LEVEL &&
+      inner_join_columns_exceed_gpu_budget(inner_outer_pairs, query_infos_, executor_)) {
+    return Data_Namespace::CPU_LEVEL;
+  }
   return memory_level_;
 }
 
@@ -581,6 +643,18 @@ int BaselineJoinHashTable::initHashTableForDevice(
       CHECK_EQ(device_id, size_t(0));
     }
     CHECK_LT(static_cast<size_t>(device_id), hash_tables_for_device_.size());
+    auto get_cached_hash_table = [this]() -> std::shared_ptr<HashTable> {
+      auto cached_hash_table =
+          initHashTableOnCpuFromCache(hashtable_cache_key_,
+                                      CacheItemType::BASELINE_HT,
+                                      DataRecyclerUtil::CPU_DEVICE_IDENTIFIER);
+      // GPU code probes tables with MurmurHash, CRC32C hashed tables can't be reused.
+      if (cached_hash_table && memory_level_ == Data_Namespace::GPU_LEVEL &&
+          uses_crc32_key_hash(cached_hash_table.get())) {
+        return nullptr;
+      }
+      return cached_hash_table;
+    };
     std::shared_ptr<HashTable> hash_table{nullptr};
     if (allow_hashtable_recycling) {
       auto cached_hashtable_layout_type = hash_table_layout_cache_->getItemFromCache(
@@ -592,9 +666,7 @@ int BaselineJoinHashTable::initHashTableForDevice(
         hashtable_layout = *cached_hashtable_layout_type;
         VLOG(1) << "Recycle hashtable layout: " << getHashTypeString(hashtable_layout);
       }
-      hash_table = initHashTableOnCpuFromCache(hashtable_cache_key_,
-                                               CacheItemType::BASELINE_HT,
-                                               DataRecyclerUtil::CPU_DEVICE_IDENTIFIER);
+      hash_table = get_cached_hash_table();
     }
 
     if (!hash_table) {
@@ -623,13 +695,21 @@ int BaselineJoinHashTable::initHashTableForDevice(
       // for multiple devices, all devices except the first to take
       // cpu_hash_table_buff_lock should find their hash table cached now
       // from the first device to run
-      hash_table = initHashTableOnCpuFromCache(hashtable_cache_key_,
-                                               CacheItemType::BASELINE_HT,
-                                               DataRecyclerUtil::CPU_DEVICE_IDENTIFIER);
+      hash_table = get_cached_hash_table();
       if (!hash_table) {
         // Hash table was not in cache
         BaselineJoinHashTableBuilder builder;
 
+        // The table is probed with the same hash function in the generated code, so
+        // hardware hashing is only used for tables which never move to GPU.
+        bool use_crc32_key_hash = false;
+#ifdef HAVE_CRC32_KEY_HASH
+        use_crc32_key_hash = executor_->getConfig().exec.join.enable_crc32_key_hash &&
+                             memory_level_ == Data_Namespace::CPU_LEVEL &&
+                             crc32_key_hash_supported();
+#endif
+        const auto& join_config = executor_->getConfig().exec.join;
+
         const auto key_handler =
             GenericKeyHandler(key_component_count,
                               true,
@@ -647,7 +727,10 @@ int BaselineJoinHashTable::initHashTableForDevice(
                                          hashtable_layout,
                                          join_type_,
                                          getKeyComponentWidth(),
-                                         getKeyComponentCount());
+                                         getKeyComponentCount(),
+                                         use_crc32_key_hash,
+                                         join_config.hash_table_prefetch_threshold,
+                                         join_config.partitioned_hash_build_threshold);
         hash_tables_for_device_[device_id] = builder.getHashTable();
         ts2 = std::chrono::steady_clock::now();
         auto hashtable_build_time =
@@ -772,7 +855,8 @@ llvm::Value* BaselineJoinHashTable::codegenSlot(const CompilationOptions& co,
   const auto key_size_lv = LL_INT(getKeyComponentCount() * key_component_width);
   const auto hash_table = getHashTableForDevice(size_t(0));
   return executor_->cgen_state_->emitExternalCall(
-      "baseline_hash_join_idx_" + std::to_string(key_component_width * 8),
+      "baseline_hash_join_idx_" + key_hash_func_infix(hash_table) +
+          std::to_string(key_component_width * 8),
       get_int_type(64, LL_CONTEXT),
       {hash_ptr, key_ptr_lv, key_size_lv, LL_INT(hash_table->getEntryCount())});
 }
@@ -798,7 +882,8 @@ HashJoinMatchingSet BaselineJoinHashTable::codegenMatchingSet(
           : LL_BUILDER.CreateIntToPtr(hash_ptr, composite_dict_ptr_type);
   const auto key_component_count = getKeyComponentCount();
   const auto key = executor_->cgen_state_->emitExternalCall(
-      "get_composite_key_index_" + std::to_string(key_component_width * 8),
+      "get_composite_key_index_" + key_hash_func_infix(hash_table) +
+          std::to_string(key_component_width * 8),
       get_int_type(64, LL_CONTEXT),
       {key_buff_lv,
        LL_INT(key_component_count),
@@ -913,8 +998,19 @@ llvm::Value* BaselineJoinHashTable::codegenKey(const CompilationOptions& co) {
     }
     const auto col_lvs = code_generator.codegen(outer_col, true, co);
     CHECK_EQ(size_t(1), col_lvs.size());
-    const auto col_lv = LL_BUILDER.CreateSExt(
-        col_lvs.front(), get_int_type(key_component_width * 8, LL_CONTEXT));
+    auto col_lv = col_lvs.front();
+    if (compact_key_components_ && col_lv->getType()->isIntegerTy(64)) {
+      // Outer values which don't fit into 32 bits are replaced with a value above
+      // the inner ranges instead of being truncated to a matching one.
+      const auto narrow_col_lv =
+          LL_BUILDER.CreateTrunc(col_lv, get_int_type(32, LL_CONTEXT));
+      const auto fits_lv = LL_BUILDER.CreateICmpEQ(
+          LL_BUILDER.CreateSExt(narrow_col_lv, col_lv->getType()), col_lv);
+      col_lv = LL_BUILDER.CreateSelect(
+          fits_lv, narrow_col_lv, LL_INT(std::numeric_limits<int32_t>::max()));
+    }
+    col_lv =
+        LL_BUILDER.CreateSExt(col_lv, get_int_type(key_component_width * 8, LL_CONTEXT));
     LL_BUILDER.CreateStore(col_lv, key_comp_dest_lv);
   }
   return key_buff_lv;
@@ -980,7 +1076,8 @@ std::shared_ptr<HashTable> BaselineJoinHashTable::initHashTableOnCpuFromCache(
   auto timer = DEBUG_TIMER(__func__);
   VLOG(1) << "Checking CPU hash table cache.";
   CHECK(hash_table_cache_);
-  return hash_table_cache_->getItemFromCache(key, item_type, device_identifier);
+  return hash_table_cache_->getItemFromCache(
+      key, item_type, device_identifier, hashtable_cache_meta_info_);
 }
 
 void BaselineJoinHashTable::putHashTableOnCpuToCache(
@@ -997,7 +1094,8 @@ void BaselineJoinHashTable::putHashTableOnCpuToCache(
       item_type,
       device_identifier,
       hashtable_ptr->getHashTableBufferSize(ExecutorDeviceType::CPU),
-      hashtable_building_time);
+      hashtable_building_time,
+      hashtable_cache_meta_info_);
 }
 
 std::pair<std::optional<size_t>, size_t>
@@ -1010,7 +1108,8 @@ BaselineJoinHashTable::getApproximateTupleCountFromCache(
                                                 needs_dict_translation_,
                                                 getInnerTableId(inner_outer_pairs_))) {
     auto hash_table_ptr =
-        hash_table_cache_->getItemFromCache(key, item_type, device_identifier);
+        hash_table_cache_->getItemFromCache(
+            key, item_type, device_identifier, hashtable_cache_meta_info_);
     if (hash_table_ptr) {
       return std::make_pair(hash_table_ptr->getEntryCount() / 2,
                             hash_table_ptr->getEmittedKeysCount());
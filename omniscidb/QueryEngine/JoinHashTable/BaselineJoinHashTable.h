@@ -244,6 +244,8 @@ class BaselineJoinHashTable : public HashJoin {
   std::vector<InnerOuter> inner_outer_pairs_;
   const int device_count_;
   mutable bool needs_dict_translation_;
+  // 64-bit key components are stored in 32 bits, see getKeyComponentWidth
+  bool compact_key_components_{false};
   std::optional<HashType>
       layout_override_;  // allows us to use a 1:many hash table for many:many
 
@@ -35,7 +35,9 @@ int fill_baseline_hash_join_buff(int8_t* hash_buff,
                                  const KEY_HANDLER* key_handler,
                                  const size_t num_elems,
                                  const int32_t cpu_thread_idx,
-                                 const int32_t cpu_thread_count) {
+                                 const int32_t cpu_thread_count,
+                                 const bool use_crc32_key_hash,
+                                 const bool prefetch_slots) {
   auto timer = DEBUG_TIMER(__func__);
   static_assert(std::is_same<KEY_HANDLER, GenericKeyHandler>::value,
                 "Only Generic Key Handlers are supported.");
@@ -48,7 +50,9 @@ int fill_baseline_hash_join_buff(int8_t* hash_buff,
                                          key_handler,
                                          num_elems,
                                          cpu_thread_idx,
-                                         cpu_thread_count);
+                                         cpu_thread_count,
+                                         use_crc32_key_hash,
+                                         prefetch_slots);
 }
 
 template <typename SIZE,
@@ -63,7 +67,9 @@ int fill_baseline_hash_join_buff(int8_t* hash_buff,
                                  const KEY_HANDLER* key_handler,
                                  const size_t num_elems,
                                  const int32_t cpu_thread_idx,
-                                 const int32_t cpu_thread_count) {
+                                 const int32_t cpu_thread_count,
+                                 const bool use_crc32_key_hash,
+                                 const bool prefetch_slots) {
   auto timer = DEBUG_TIMER(__func__);
   static_assert(std::is_same<KEY_HANDLER, GenericKeyHandler>::value,
                 "Only Generic Key Handlers are supported.");
@@ -76,7 +82,9 @@ int fill_baseline_hash_join_buff(int8_t* hash_buff,
                                          key_handler,
                                          num_elems,
                                          cpu_thread_idx,
-                                         cpu_thread_count);
+                                         cpu_thread_count,
+                                         use_crc32_key_hash,
+                                         prefetch_slots);
 }
 
 template <typename SIZE,
@@ -189,7 +197,10 @@ class BaselineJoinHashTableBuilder {
                          const HashType layout,
                          const JoinType join_type,
                          const size_t key_component_width,
-                         const size_t key_component_count) {
+                         const size_t key_component_count,
+                         const bool use_crc32_key_hash,
+                         const size_t prefetch_threshold,
+                         const size_t partitioned_build_threshold) {
     auto timer = DEBUG_TIMER(__func__);
     const auto entry_size =
         (key_component_count + (layout == HashType::OneToOne ? 1 : 0)) *
@@ -215,9 +226,14 @@ class BaselineJoinHashTableBuilder {
             << " hash entries and " << one_to_many_hash_entries
             << " entries in the one to many buffer";
     VLOG(1) << "Total hash table size: " << hash_table_size << " Bytes";
+    // Slots of tables which don't fit into CPU caches are prefetched a few keys ahead.
+    const bool prefetch_slots = hash_table_size > prefetch_threshold;
 
-    hash_table_ = std::make_unique<BaselineHashTable>(
-        layout, keyspace_entry_count, keys_for_all_rows, hash_table_size);
+    hash_table_ = std::make_unique<BaselineHashTable>(layout,
+                                                      keyspace_entry_count,
+                                                      keys_for_all_rows,
+                                                      hash_table_size,
+                                                      use_crc32_key_hash);
     auto cpu_hash_table_ptr = hash_table_->getCpuBuffer();
     int thread_count = cpu_threads();
     std::vector<std::future<void>> init_cpu_buff_threads;
@@ -296,7 +312,9 @@ class BaselineJoinHashTableBuilder {
            thread_idx,
            cpu_hash_table_ptr,
            thread_count,
-           for_semi_join] {
+           for_semi_join,
+           use_crc32_key_hash,
+           prefetch_slots] {
             switch (key_component_width) {
               case 4: {
                 return fill_baseline_hash_join_buff<int32_t>(cpu_hash_table_ptr,
@@ -308,7 +326,9 @@ class BaselineJoinHashTableBuilder {
                                                              key_handler,
                                                              join_columns[0].num_elems,
                                                              thread_idx,
-                                                             thread_count);
+                                                             thread_count,
+                                                             use_crc32_key_hash,
+                                                             prefetch_slots);
                 break;
               }
               case 8: {
@@ -321,7 +341,9 @@ class BaselineJoinHashTableBuilder {
                                                              key_handler,
                                                              join_columns[0].num_elems,
                                                              thread_idx,
-                                                             thread_count);
+                                                             thread_count,
+                                                             use_crc32_key_hash,
+                                                             prefetch_slots);
                 break;
               }
               default:
@@ -349,6 +371,8 @@ class BaselineJoinHashTableBuilder {
         init_hash_join_buff(one_to_many_buff, keyspace_entry_count, -1, 0, 1);
       }
       setHashLayout(layout);
+      // Large tables are filled by partitions of slot ranges without atomics.
+      const bool partitioned_build = keys_for_all_rows >= partitioned_build_threshold;
       switch (key_component_width) {
         case 4: {
           const auto composite_key_dict = reinterpret_cast<int32_t*>(cpu_hash_table_ptr);
@@ -362,7 +386,10 @@ class BaselineJoinHashTableBuilder {
               join_column_types,
               str_proxy_translation_maps_ptrs_and_offsets.first,
               str_proxy_translation_maps_ptrs_and_offsets.second,
-              thread_count);
+              thread_count,
+              use_crc32_key_hash,
+              prefetch_slots,
+              partitioned_build);
           break;
         }
         case 8: {
@@ -377,7 +404,10 @@ class BaselineJoinHashTableBuilder {
               join_column_types,
               str_proxy_translation_maps_ptrs_and_offsets.first,
               str_proxy_translation_maps_ptrs_and_offsets.second,
-              thread_count);
+              thread_count,
+              use_crc32_key_hash,
+              prefetch_slots,
+              partitioned_build);
           break;
         }
         default:
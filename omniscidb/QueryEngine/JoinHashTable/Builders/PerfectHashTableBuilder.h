@@ -300,7 +300,25 @@ class PerfectJoinHashTableBuilder {
     {
       auto timer_fill = DEBUG_TIMER(
           "CPU One-To-Many Perfect Hash Table Builder: fill_hash_join_buff_bucketized");
-      if (type->isDate()) {
+      if (join_column.num_elems >=
+          executor->getConfig().exec.join.partitioned_hash_build_threshold) {
+        fill_one_to_many_hash_table_partitioned(
+            cpu_hash_table_buff,
+            hash_entry_info,
+            hash_join_invalid_val,
+            join_column,
+            {static_cast<size_t>(type->size()),
+             col_range.getIntMin(),
+             col_range.getIntMax(),
+             inline_fixed_encoding_null_value(type),
+             is_bitwise_eq,
+             col_range.getIntMax() + 1,
+             get_join_column_type_kind(type)},
+            str_proxy_translation_map ? str_proxy_translation_map->data() : nullptr,
+            str_proxy_translation_map ? str_proxy_translation_map->domainStart()
+                                      : 0 /*dummy*/,
+            thread_count);
+      } else if (type->isDate()) {
         fill_one_to_many_hash_table_bucketized(
             cpu_hash_table_buff,
             hash_entry_info,
@@ -22,6 +22,7 @@
 #include "QueryEngine/Execute.h"
 #include "QueryEngine/JoinHashTable/BaselineJoinHashTable.h"
 #include "QueryEngine/JoinHashTable/PerfectJoinHashTable.h"
+#include "QueryEngine/JoinHashTable/SortedJoinTable.h"
 #include "QueryEngine/RangeTableIndexVisitor.h"
 #include "QueryEngine/RuntimeFunctions.h"
 
@@ -254,6 +255,19 @@ std::shared_ptr<HashJoin> HashJoin::getInstance(
                                                          executor,
                                                          hashtable_build_dag_map,
                                                          table_id_to_node_map);
+  } else if (qual_bin_oper->leftOperand()->type()->isString() &&
+             executor->getConfig().exec.join.enable_string_join &&
+             memory_level == Data_Namespace::CPU_LEVEL) {
+    // Hash tables need dictionary-encoded strings, none-encoded strings are joined
+    // through their hashes.
+    VLOG(1) << "Trying to build sorted join table on string hashes:";
+    join_hash_table = SortedJoinTable::getInstance(qual_bin_oper,
+                                                   query_infos,
+                                                   memory_level,
+                                                   device_count,
+                                                   data_provider,
+                                                   column_cache,
+                                                   executor);
   } else {
     try {
       VLOG(1) << "Trying to build perfect hash table:";
@@ -273,18 +287,37 @@ std::shared_ptr<HashJoin> HashJoin::getInstance(
       CHECK_EQ(join_quals.size(), size_t(1));
       const auto join_qual =
           std::dynamic_pointer_cast<const hdk::ir::BinOper>(join_quals.front());
-      VLOG(1) << "Trying to build keyed hash table after perfect hash table:";
-      join_hash_table = BaselineJoinHashTable::getInstance(join_qual,
-                                                           query_infos,
-                                                           memory_level,
-                                                           join_type,
-                                                           preferred_hash_type,
-                                                           device_count,
-                                                           data_provider,
-                                                           column_cache,
-                                                           executor,
-                                                           hashtable_build_dag_map,
-                                                           table_id_to_node_map);
+      if (executor->getConfig().exec.join.enable_sort_join &&
+          memory_level == Data_Namespace::CPU_LEVEL) {
+        try {
+          VLOG(1) << "Trying to build sorted join table after perfect hash table:";
+          join_hash_table = SortedJoinTable::getInstance(join_qual,
+                                                         query_infos,
+                                                         memory_level,
+                                                         device_count,
+                                                         data_provider,
+                                                         column_cache,
+                                                         executor);
+        } catch (const HashJoinFail& e) {
+          VLOG(1) << "Failed to build sorted join table: " << e.what();
+        } catch (const TooManyHashEntries& e) {
+          VLOG(1) << "Failed to build sorted join table: " << e.what();
+        }
+      }
+      if (!join_hash_table) {
+        VLOG(1) << "Trying to build keyed hash table after perfect hash table:";
+        join_hash_table = BaselineJoinHashTable::getInstance(join_qual,
+                                                             query_infos,
+                                                             memory_level,
+                                                             join_type,
+                                                             preferred_hash_type,
+                                                             device_count,
+                                                             data_provider,
+                                                             column_cache,
+                                                             executor,
+                                                             hashtable_build_dag_map,
+                                                             table_id_to_node_map);
+      }
     }
   }
   CHECK(join_hash_table);
@@ -122,8 +122,15 @@ class HashJoin {
     return (layout == HashType::ManyToMany || layout == HashType::OneToMany);
   }
 
+  // Semi and anti joins only check whether a matching key exists, so their hash tables
+  // keep a single entry per key and are always probed as one-to-one. Joins with other
+  // conditions than the key equality build their tables as inner joins.
+  static bool isSemiOrAntiJoin(JoinType join_type) noexcept {
+    return join_type == JoinType::SEMI || join_type == JoinType::ANTI;
+  }
+
   static std::string getHashTypeString(HashType ht) noexcept {
-    const char* HashTypeStrings[3] = {"OneToOne", "OneToMany", "ManyToMany"};
+    const char* HashTypeStrings[4] = {"OneToOne", "OneToMany", "ManyToMany", "Range"};
     return HashTypeStrings[static_cast<int>(ht)];
   };
 
@@ -152,6 +159,10 @@ class HashJoin {
 
   virtual bool isBitwiseEq() const = 0;
 
+  // Tables keyed on hashes of join keys can match rows with different keys, the join
+  // condition is checked again for such matches.
+  virtual bool matchesKeyHashes() const { return false; }
+
   JoinColumn fetchJoinColumn(const hdk::ir::ColumnVar* hash_col,
                              const std::vector<FragmentInfo>& fragment_info,
                              const Data_Namespace::MemoryLevel effective_memory_level,
@@ -22,7 +22,7 @@
 
 #include "QueryEngine/CompilationOptions.h"
 
-enum class HashType : int { OneToOne, OneToMany, ManyToMany };
+enum class HashType : int { OneToOne, OneToMany, ManyToMany, Range };
 
 struct DecodedJoinHashBufferEntry {
   std::vector<int64_t> key;
@@ -21,10 +21,12 @@
 
 #include <atomic>
 #include <future>
+#include <limits>
 #include <numeric>
 #include <thread>
 
 #include "Logger/Logger.h"
+#include "QueryEngine/CardinalityEstimator.h"
 #include "QueryEngine/CodeGenerator.h"
 #include "QueryEngine/ColumnFetcher.h"
 #include "QueryEngine/Execute.h"
@@ -155,7 +157,14 @@ std::shared_ptr<PerfectJoinHashTable> PerfectJoinHashTable::getInstance(
   if (bucketized_entry_count > executor->getConfig().exec.join.huge_join_hash_threshold) {
     const auto& query_info =
         get_inner_query_info(inner_col->dbId(), inner_col->tableId(), query_infos).info;
-    if (query_info.getNumTuplesUpperBound() * 100 <
+    // Duplicate keys don't fill more entries, so the number of distinct keys predicts
+    // the load better than the number of rows.
+    std::optional<size_t> inner_ndv;
+    if (executor->getConfig().exec.join.enable_join_hash_ndv_load) {
+      inner_ndv = get_column_ndv_from_stats(inner_col, query_infos);
+    }
+    const size_t num_keys = inner_ndv ? *inner_ndv : query_info.getNumTuplesUpperBound();
+    if (num_keys * 100 <
         executor->getConfig().exec.join.huge_join_hash_min_load *
             bucketized_entry_count) {
       throw TooManyHashEntries();
@@ -238,6 +247,47 @@ void PerfectJoinHashTable::initCaches(ConfigPtr config) {
   });
 }
 
+bool inner_join_columns_exceed_gpu_budget(
+    const std::vector<InnerOuter>& inner_outer_pairs,
+    const std::vector<InputTableInfo>& query_infos,
+    const Executor* executor) {
+  const auto data_mgr = executor->getDataMgr();
+  if (!data_mgr || !data_mgr->gpusPresent()) {
+    return false;
+  }
+  size_t inner_cols_bytes = 0;
+  for (const auto& [inner_col, outer_col] : inner_outer_pairs) {
+    if (inner_col->isVirtual() || inner_col->type()->size() <= 0) {
+      continue;
+    }
+    const auto& query_info =
+        get_inner_query_info(inner_col->dbId(), inner_col->tableId(), query_infos).info;
+    inner_cols_bytes += query_info.getNumTuplesUpperBound() * inner_col->type()->size();
+  }
+  if (!inner_cols_bytes) {
+    return false;
+  }
+  // All devices get a copy of the inner columns, so the smallest device decides.
+  const auto gpu_mem_infos = data_mgr->getMemoryInfo(Data_Namespace::GPU_LEVEL);
+  if (gpu_mem_infos.empty()) {
+    return false;
+  }
+  size_t min_gpu_mem_bytes = std::numeric_limits<size_t>::max();
+  for (const auto& gpu_mem_info : gpu_mem_infos) {
+    min_gpu_mem_bytes =
+        std::min(min_gpu_mem_bytes, gpu_mem_info.maxNumPages * gpu_mem_info.pageSize);
+  }
+  const auto budget_bytes =
+      min_gpu_mem_bytes * executor->getConfig().mem.gpu.input_mem_limit_percent;
+  if (inner_cols_bytes > budget_bytes) {
+    VLOG(1) << "Inner join columns take " << inner_cols_bytes
+            << " bytes which exceeds GPU input memory budget of " << budget_bytes
+            << " bytes, building the hash table on CPU.";
+    return true;
+  }
+  return false;
+}
+
 bool needs_dictionary_translation(const hdk::ir::ColumnVar* inner_col,
                                   const hdk::ir::Expr* outer_col_expr,
                                   const Executor* executor) {
@@ -339,8 +389,9 @@ void PerfectJoinHashTable::reify() {
                                   : nullptr));
   }
   // Now check if on the number of entries per column exceeds the rhs join hash table
-  // range, and skip trying to build a One-to-One hash table if so
-  if (!isOneToOneHashPossible(columns_per_device)) {
+  // range, and skip trying to build a One-to-One hash table if so. Semi and anti joins
+  // drop duplicate keys while building, so they can always use a One-to-One table.
+  if (!isSemiOrAntiJoin(join_type_) && !isOneToOneHashPossible(columns_per_device)) {
     hash_type_ = HashType::OneToMany;
   }
 
@@ -425,6 +476,10 @@ Data_Namespace::MemoryLevel PerfectJoinHashTable::getEffectiveMemoryLevel(
       return Data_Namespace::CPU_LEVEL;
     }
   }
+  if (memory_level_ == Data_Namespace::GPU_LEVEL &&
+      inner_join_columns_exceed_gpu_budget(inner_outer_pairs, query_infos_, executor_)) {
+    return Data_Namespace::CPU_LEVEL;
+  }
   return memory_level_;
 }
 
@@ -634,12 +689,11 @@ int PerfectJoinHashTable::initHashTableForDevice(
       }
     }
     // Transfer the hash table on the GPU if we've only built it on CPU
-    // but the query runs on GPU (join on dictionary encoded columns).
+    // but the query runs on GPU (join on dictionary encoded columns or inner
+    // columns too big for the GPU).
     if (memory_level_ == Data_Namespace::GPU_LEVEL) {
 #ifdef HAVE_CUDA
       auto buffer_provider = executor_->getBufferProvider();
-      auto type = inner_col->type();
-      CHECK(type->isString() || type->isExtDictionary());
       std::lock_guard<std::mutex> cpu_hash_table_buff_lock(cpu_hash_table_buff_mutex_);
 
       PerfectJoinHashTableBuilder gpu_builder;
@@ -742,8 +796,8 @@ std::shared_ptr<PerfectHashTable> PerfectJoinHashTable::initHashTableOnCpuFromCa
     DeviceIdentifier device_identifier) {
   CHECK(hash_table_cache_);
   auto timer = DEBUG_TIMER(__func__);
-  auto hashtable_ptr =
-      hash_table_cache_->getItemFromCache(key, item_type, device_identifier);
+  auto hashtable_ptr = hash_table_cache_->getItemFromCache(
+      key, item_type, device_identifier, hashtable_cache_meta_info_);
   if (hashtable_ptr) {
     return std::dynamic_pointer_cast<PerfectHashTable>(hashtable_ptr);
   }
@@ -764,7 +818,8 @@ void PerfectJoinHashTable::putHashTableOnCpuToCache(
       item_type,
       device_identifier,
       hashtable_ptr->getHashTableBufferSize(ExecutorDeviceType::CPU),
-      hashtable_building_time);
+      hashtable_building_time,
+      hashtable_cache_meta_info_);
 }
 
 llvm::Value* PerfectJoinHashTable::codegenHashTableLoad(const size_t table_idx) {
@@ -273,6 +273,13 @@ bool needs_dictionary_translation(const hdk::ir::ColumnVar* inner_col,
                                   const hdk::ir::Expr* outer_col,
                                   const Executor* executor);
 
+// Returns true if inner join columns don't fit the input memory budget of a GPU. Hash
+// tables for such joins are built on CPU and only the hash table is copied to GPUs.
+bool inner_join_columns_exceed_gpu_budget(
+    const std::vector<InnerOuter>& inner_outer_pairs,
+    const std::vector<InputTableInfo>& query_infos,
+    const Executor* executor);
+
 const InputTableInfo& get_inner_query_info(
     const int inner_db_id,
     const int inner_table_id,
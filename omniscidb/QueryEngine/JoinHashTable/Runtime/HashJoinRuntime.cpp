@@ -17,6 +17,7 @@
 #include "HashJoinRuntime.h"
 
 #include "QueryEngine/CompareKeysInl.h"
+#include "QueryEngine/Crc32cHashInl.h"
 #include "QueryEngine/HyperLogLogRank.h"
 #include "QueryEngine/JoinHashTable/Runtime/HashJoinKeyHandlers.h"
 #include "QueryEngine/JoinHashTable/Runtime/JoinColumnIterator.h"
@@ -41,6 +42,8 @@
 #include <tbb/parallel_for.h>
 #endif
 
+#include <algorithm>
+#include <atomic>
 #include <future>
 #endif
 
@@ -510,6 +513,19 @@ T* get_matching_baseline_hash_slot_at(int8_t* hash_buff,
 
 #endif  // __CUDACC__
 
+// Baseline join hash tables built on CPU can use hardware CRC32C hashing. Tables built
+// on GPU or transferred to GPU always use MurmurHash.
+FORCE_INLINE DEVICE uint32_t baseline_key_hash(const void* key,
+                                               const size_t key_size_in_bytes,
+                                               const bool use_crc32_key_hash) {
+#ifdef HAVE_CRC32_KEY_HASH
+  if (use_crc32_key_hash) {
+    return Crc32cHashImpl(key, key_size_in_bytes, 0);
+  }
+#endif
+  return MurmurHash1Impl(key, key_size_in_bytes, 0);
+}
+
 template <typename T>
 DEVICE int write_baseline_hash_slot(const int32_t val,
                                     int8_t* hash_buff,
@@ -518,9 +534,8 @@ DEVICE int write_baseline_hash_slot(const int32_t val,
                                     const size_t key_component_count,
                                     const bool with_val_slot,
                                     const int32_t invalid_slot_val,
-                                    const size_t key_size_in_bytes,
-                                    const size_t hash_entry_size) {
-  const uint32_t h = MurmurHash1Impl(key, key_size_in_bytes, 0) % entry_count;
+                                    const size_t hash_entry_size,
+                                    const uint32_t h) {
   T* matching_group = get_matching_baseline_hash_slot_at(
       hash_buff, h, key, key_component_count, hash_entry_size);
   if (!matching_group) {
@@ -555,9 +570,8 @@ DEVICE int write_baseline_hash_slot_for_semi_join(const int32_t val,
                                                   const size_t key_component_count,
                                                   const bool with_val_slot,
                                                   const int32_t invalid_slot_val,
-                                                  const size_t key_size_in_bytes,
-                                                  const size_t hash_entry_size) {
-  const uint32_t h = MurmurHash1Impl(key, key_size_in_bytes, 0) % entry_count;
+                                                  const size_t hash_entry_size,
+                                                  const uint32_t h) {
   T* matching_group = get_matching_baseline_hash_slot_at(
       hash_buff, h, key, key_component_count, hash_entry_size);
   if (!matching_group) {
@@ -582,6 +596,70 @@ DEVICE int write_baseline_hash_slot_for_semi_join(const int32_t val,
   return 0;
 }
 
+#ifndef __CUDACC__
+// Software pipeline for accesses to hash tables which don't fit into CPU caches. The
+// slot of a key is prefetched when the key is pushed, and the key is processed
+// kPrefetchDistance keys later, when its slot is likely to be in cache already.
+template <typename T, typename PROCESS_KEY>
+class SlotPrefetchPipeline {
+ public:
+  SlotPrefetchPipeline(const size_t key_component_count,
+                       const bool for_write,
+                       PROCESS_KEY process_key)
+      : key_component_count_(key_component_count)
+      , for_write_(for_write)
+      , process_key_(process_key) {
+    CHECK_LE(key_component_count_, size_t(g_maximum_conditions_to_coalesce));
+  }
+
+  int push(const int64_t row_idx, const T* key, const uint32_t h, const void* slot) {
+    if (for_write_) {
+      __builtin_prefetch(slot, 1);
+    } else {
+      __builtin_prefetch(slot, 0);
+    }
+    auto& entry = entries_[pushed_ % kPrefetchDistance];
+    int err = 0;
+    if (pushed_ >= kPrefetchDistance) {
+      err = process_key_(entry.row_idx, entry.key, entry.h);
+    }
+    entry.row_idx = row_idx;
+    entry.h = h;
+    memcpy(entry.key, key, key_component_count_ * sizeof(T));
+    ++pushed_;
+    return err;
+  }
+
+  // Processes keys which are still in flight.
+  int flush() {
+    const size_t first = pushed_ > kPrefetchDistance ? pushed_ - kPrefetchDistance : 0;
+    for (size_t i = first; i < pushed_; ++i) {
+      const auto& entry = entries_[i % kPrefetchDistance];
+      if (const auto err = process_key_(entry.row_idx, entry.key, entry.h)) {
+        return err;
+      }
+    }
+    pushed_ = 0;
+    return 0;
+  }
+
+ private:
+  static constexpr size_t kPrefetchDistance = 16;
+
+  struct Entry {
+    int64_t row_idx;
+    uint32_t h;
+    T key[g_maximum_conditions_to_coalesce];
+  };
+
+  const size_t key_component_count_;
+  const bool for_write_;
+  PROCESS_KEY process_key_;
+  Entry entries_[kPrefetchDistance];
+  size_t pushed_{0};
+};
+#endif  // __CUDACC__
+
 template <typename T, typename FILL_HANDLER>
 DEVICE int SUFFIX(fill_baseline_hash_join_buff)(int8_t* hash_buff,
                                                 const int64_t entry_count,
@@ -592,7 +670,9 @@ DEVICE int SUFFIX(fill_baseline_hash_join_buff)(int8_t* hash_buff,
                                                 const FILL_HANDLER* f,
                                                 const int64_t num_elems,
                                                 const int32_t cpu_thread_idx,
-                                                const int32_t cpu_thread_count) {
+                                                const int32_t cpu_thread_count,
+                                                const bool use_crc32_key_hash = false,
+                                                const bool prefetch_slots = false) {
 #ifdef __CUDACC__
   int32_t start = threadIdx.x + blockDim.x * blockIdx.x;
   int32_t step = blockDim.x * gridDim.x;
@@ -605,40 +685,78 @@ DEVICE int SUFFIX(fill_baseline_hash_join_buff)(int8_t* hash_buff,
   const size_t key_size_in_bytes = key_component_count * sizeof(T);
   const size_t hash_entry_size =
       (key_component_count + (with_val_slot ? 1 : 0)) * sizeof(T);
-  auto key_buff_handler = [hash_buff,
-                           entry_count,
-                           with_val_slot,
-                           invalid_slot_val,
-                           key_size_in_bytes,
-                           hash_entry_size,
-                           &for_semi_join](const int64_t entry_idx,
-                                           const T* key_scratch_buffer,
-                                           const size_t key_component_count) {
+  auto write_slot = [hash_buff,
+                     entry_count,
+                     key_component_count,
+                     with_val_slot,
+                     invalid_slot_val,
+                     hash_entry_size,
+                     for_semi_join](
+                        const int64_t entry_idx, const T* key, const uint32_t h) {
     if (for_semi_join) {
       return write_baseline_hash_slot_for_semi_join<T>(entry_idx,
                                                        hash_buff,
                                                        entry_count,
-                                                       key_scratch_buffer,
+                                                       key,
                                                        key_component_count,
                                                        with_val_slot,
                                                        invalid_slot_val,
-                                                       key_size_in_bytes,
-                                                       hash_entry_size);
+                                                       hash_entry_size,
+                                                       h);
     } else {
       return write_baseline_hash_slot<T>(entry_idx,
                                          hash_buff,
                                          entry_count,
-                                         key_scratch_buffer,
+                                         key,
                                          key_component_count,
                                          with_val_slot,
                                          invalid_slot_val,
-                                         key_size_in_bytes,
-                                         hash_entry_size);
+                                         hash_entry_size,
+                                         h);
     }
   };
 
   JoinColumnTuple cols(
       f->get_number_of_columns(), f->get_join_columns(), f->get_join_column_type_infos());
+#ifndef __CUDACC__
+  if (prefetch_slots) {
+    SlotPrefetchPipeline<T, decltype(write_slot)> pipeline(
+        key_component_count, true, write_slot);
+    auto key_buff_handler = [&pipeline,
+                             hash_buff,
+                             entry_count,
+                             key_size_in_bytes,
+                             hash_entry_size,
+                             use_crc32_key_hash](const int64_t entry_idx,
+                                                 const T* key_scratch_buffer,
+                                                 const size_t key_component_count) {
+      const uint32_t h =
+          baseline_key_hash(key_scratch_buffer, key_size_in_bytes, use_crc32_key_hash) %
+          entry_count;
+      return pipeline.push(
+          entry_idx, key_scratch_buffer, h, hash_buff + h * hash_entry_size);
+    };
+    for (auto& it : cols.slice(start, step)) {
+      const auto err =
+          (*f)(it.join_column_iterators, key_scratch_buff, key_buff_handler);
+      if (err) {
+        return err;
+      }
+    }
+    return pipeline.flush();
+  }
+#endif
+  auto key_buff_handler = [write_slot,
+                           entry_count,
+                           key_size_in_bytes,
+                           use_crc32_key_hash](const int64_t entry_idx,
+                                               const T* key_scratch_buffer,
+                                               const size_t key_component_count) {
+    const uint32_t h =
+        baseline_key_hash(key_scratch_buffer, key_size_in_bytes, use_crc32_key_hash) %
+        entry_count;
+    return write_slot(entry_idx, key_scratch_buffer, h);
+  };
   for (auto& it : cols.slice(start, step)) {
     const auto err = (*f)(it.join_column_iterators, key_scratch_buff, key_buff_handler);
     if (err) {
@@ -781,8 +899,7 @@ DEVICE NEVER_INLINE const T* SUFFIX(get_matching_baseline_hash_slot_readonly)(
     const size_t key_component_count,
     const T* composite_key_dict,
     const int64_t entry_count,
-    const size_t key_size_in_bytes) {
-  const uint32_t h = MurmurHash1Impl(key, key_size_in_bytes, 0) % entry_count;
+    const uint32_t h) {
   uint32_t off = h * key_component_count;
   if (keys_are_equal(&composite_key_dict[off], key, key_component_count)) {
     return &composite_key_dict[off];
@@ -812,7 +929,9 @@ GLOBAL void SUFFIX(count_matches_baseline)(int32_t* count_buff,
 #ifndef __CUDACC__
                                            ,
                                            const int32_t cpu_thread_idx,
-                                           const int32_t cpu_thread_count
+                                           const int32_t cpu_thread_count,
+                                           const bool use_crc32_key_hash,
+                                           const bool prefetch_slots
 #endif
 ) {
 #ifdef __CUDACC__
@@ -826,19 +945,15 @@ GLOBAL void SUFFIX(count_matches_baseline)(int32_t* count_buff,
   assert(composite_key_dict);
 #endif
   T key_scratch_buff[g_maximum_conditions_to_coalesce];
-  const size_t key_size_in_bytes = f->get_key_component_count() * sizeof(T);
-  auto key_buff_handler = [composite_key_dict,
-                           entry_count,
-                           count_buff,
-                           key_size_in_bytes](const int64_t row_entry_idx,
-                                              const T* key_scratch_buff,
-                                              const size_t key_component_count) {
-    const auto matching_group =
-        SUFFIX(get_matching_baseline_hash_slot_readonly)(key_scratch_buff,
-                                                         key_component_count,
-                                                         composite_key_dict,
-                                                         entry_count,
-                                                         key_size_in_bytes);
+  const size_t key_component_count = f->get_key_component_count();
+  const size_t key_size_in_bytes = key_component_count * sizeof(T);
+#ifdef __CUDACC__
+  const bool use_crc32_key_hash = false;
+#endif
+  auto count_match = [composite_key_dict, entry_count, count_buff, key_component_count](
+                         const int64_t row_entry_idx, const T* key, const uint32_t h) {
+    const auto matching_group = SUFFIX(get_matching_baseline_hash_slot_readonly)(
+        key, key_component_count, composite_key_dict, entry_count, h);
     const auto entry_idx = (matching_group - composite_key_dict) / key_component_count;
     mapd_add(&count_buff[entry_idx], int32_t(1));
     return 0;
@@ -846,6 +961,43 @@ GLOBAL void SUFFIX(count_matches_baseline)(int32_t* count_buff,
 
   JoinColumnTuple cols(
       f->get_number_of_columns(), f->get_join_columns(), f->get_join_column_type_infos());
+#ifndef __CUDACC__
+  if (prefetch_slots) {
+    SlotPrefetchPipeline<T, decltype(count_match)> pipeline(
+        key_component_count, false, count_match);
+    auto key_buff_handler = [&pipeline,
+                             composite_key_dict,
+                             entry_count,
+                             key_size_in_bytes,
+                             use_crc32_key_hash](const int64_t row_entry_idx,
+                                                 const T* key_scratch_buff,
+                                                 const size_t key_component_count) {
+      const uint32_t h =
+          baseline_key_hash(key_scratch_buff, key_size_in_bytes, use_crc32_key_hash) %
+          entry_count;
+      return pipeline.push(row_entry_idx,
+                           key_scratch_buff,
+                           h,
+                           composite_key_dict + h * key_component_count);
+    };
+    for (auto& it : cols.slice(start, step)) {
+      (*f)(it.join_column_iterators, key_scratch_buff, key_buff_handler);
+    }
+    pipeline.flush();
+    return;
+  }
+#endif
+  auto key_buff_handler = [count_match,
+                           entry_count,
+                           key_size_in_bytes,
+                           use_crc32_key_hash](const int64_t row_entry_idx,
+                                               const T* key_scratch_buff,
+                                               const size_t key_component_count) {
+    const uint32_t h =
+        baseline_key_hash(key_scratch_buff, key_size_in_bytes, use_crc32_key_hash) %
+        entry_count;
+    return count_match(row_entry_idx, key_scratch_buff, h);
+  };
   for (auto& it : cols.slice(start, step)) {
     (*f)(it.join_column_iterators, key_scratch_buff, key_buff_handler);
   }
@@ -987,7 +1139,9 @@ GLOBAL void SUFFIX(fill_row_ids_baseline)(int32_t* buff,
 #ifndef __CUDACC__
                                           ,
                                           const int32_t cpu_thread_idx,
-                                          const int32_t cpu_thread_count
+                                          const int32_t cpu_thread_count,
+                                          const bool use_crc32_key_hash,
+                                          const bool prefetch_slots
 #endif
 ) {
   int32_t* pos_buff = buff;
@@ -1005,21 +1159,20 @@ GLOBAL void SUFFIX(fill_row_ids_baseline)(int32_t* buff,
 #ifdef __CUDACC__
   assert(composite_key_dict);
 #endif
-  const size_t key_size_in_bytes = f->get_key_component_count() * sizeof(T);
-  auto key_buff_handler = [composite_key_dict,
-                           hash_entry_count,
-                           pos_buff,
-                           count_buff,
-                           id_buff,
-                           key_size_in_bytes](const int64_t row_index,
-                                              const T* key_scratch_buff,
-                                              const size_t key_component_count) {
-    const T* matching_group =
-        SUFFIX(get_matching_baseline_hash_slot_readonly)(key_scratch_buff,
-                                                         key_component_count,
-                                                         composite_key_dict,
-                                                         hash_entry_count,
-                                                         key_size_in_bytes);
+  const size_t key_component_count = f->get_key_component_count();
+  const size_t key_size_in_bytes = key_component_count * sizeof(T);
+#ifdef __CUDACC__
+  const bool use_crc32_key_hash = false;
+#endif
+  auto fill_row_id = [composite_key_dict,
+                      hash_entry_count,
+                      pos_buff,
+                      count_buff,
+                      id_buff,
+                      key_component_count](
+                         const int64_t row_index, const T* key, const uint32_t h) {
+    const T* matching_group = SUFFIX(get_matching_baseline_hash_slot_readonly)(
+        key, key_component_count, composite_key_dict, hash_entry_count, h);
     const auto entry_idx = (matching_group - composite_key_dict) / key_component_count;
     int32_t* pos_ptr = pos_buff + entry_idx;
     const auto bin_idx = pos_ptr - pos_buff;
@@ -1030,6 +1183,41 @@ GLOBAL void SUFFIX(fill_row_ids_baseline)(int32_t* buff,
 
   JoinColumnTuple cols(
       f->get_number_of_columns(), f->get_join_columns(), f->get_join_column_type_infos());
+#ifndef __CUDACC__
+  if (prefetch_slots) {
+    SlotPrefetchPipeline<T, decltype(fill_row_id)> pipeline(
+        key_component_count, false, fill_row_id);
+    auto key_buff_handler = [&pipeline,
+                             composite_key_dict,
+                             hash_entry_count,
+                             key_size_in_bytes,
+                             use_crc32_key_hash](const int64_t row_index,
+                                                 const T* key_scratch_buff,
+                                                 const size_t key_component_count) {
+      const uint32_t h =
+          baseline_key_hash(key_scratch_buff, key_size_in_bytes, use_crc32_key_hash) %
+          hash_entry_count;
+      return pipeline.push(
+          row_index, key_scratch_buff, h, composite_key_dict + h * key_component_count);
+    };
+    for (auto& it : cols.slice(start, step)) {
+      (*f)(it.join_column_iterators, key_scratch_buff, key_buff_handler);
+    }
+    pipeline.flush();
+    return;
+  }
+#endif
+  auto key_buff_handler = [fill_row_id,
+                           hash_entry_count,
+                           key_size_in_bytes,
+                           use_crc32_key_hash](const int64_t row_index,
+                                               const T* key_scratch_buff,
+                                               const size_t key_component_count) {
+    const uint32_t h =
+        baseline_key_hash(key_scratch_buff, key_size_in_bytes, use_crc32_key_hash) %
+        hash_entry_count;
+    return fill_row_id(row_index, key_scratch_buff, h);
+  };
   for (auto& it : cols.slice(start, step)) {
     (*f)(it.join_column_iterators, key_scratch_buff, key_buff_handler);
   }
@@ -1409,6 +1597,167 @@ void fill_one_to_many_hash_table_bucketized(
                                    launch_fill_row_ids);
 }
 
+// Fills one-to-many buffers of a hash table with hash_entry_count slots by
+// partitions of slot ranges. for_each_slot(thread_idx, func) calls func(slot, row_id)
+// for rows assigned to the thread and has to visit them in the same order each time.
+template <typename FOR_EACH_SLOT>
+void fill_one_to_many_hash_table_by_partitions(int32_t* buff,
+                                               const int64_t hash_entry_count,
+                                               const int64_t max_entry_count,
+                                               const unsigned cpu_thread_count,
+                                               FOR_EACH_SLOT for_each_slot) {
+  // Partitions cover contiguous ranges of slots small enough for their positions and
+  // counts to stay in cache. The partition count is limited to keep the scatter pass
+  // TLB-friendly.
+  constexpr int64_t min_partition_slots_log2{15};
+  constexpr int64_t max_partitions{1024};
+  CHECK_GT(hash_entry_count, int64_t(0));
+  int64_t partition_slots_log2 = min_partition_slots_log2;
+  while ((hash_entry_count >> partition_slots_log2) >= max_partitions) {
+    ++partition_slots_log2;
+  }
+  const int64_t partition_count = ((hash_entry_count - 1) >> partition_slots_log2) + 1;
+  const int64_t partition_slot_mask = (int64_t(1) << partition_slots_log2) - 1;
+
+  int32_t* pos_buff = buff;
+  int32_t* count_buff = buff + hash_entry_count;
+  int32_t* id_buff = count_buff + hash_entry_count;
+
+  std::vector<int64_t> offsets(cpu_thread_count * partition_count, 0);
+  {
+    std::vector<std::future<void>> histogram_threads;
+    for (unsigned thread_idx = 0; thread_idx < cpu_thread_count; ++thread_idx) {
+      histogram_threads.push_back(std::async(std::launch::async, [&, thread_idx] {
+        auto histogram = offsets.data() + thread_idx * partition_count;
+        for_each_slot(thread_idx, [&](const int64_t slot, const int32_t) {
+          ++histogram[slot >> partition_slots_log2];
+        });
+      }));
+    }
+    for (auto& child : histogram_threads) {
+      child.get();
+    }
+  }
+
+  // Turn histograms into scatter offsets ordered by partition first and by thread
+  // next, so each thread owns a contiguous range within every partition.
+  std::vector<int64_t> partition_start(partition_count + 1, 0);
+  int64_t total_entries = 0;
+  for (int64_t partition_idx = 0; partition_idx < partition_count; ++partition_idx) {
+    partition_start[partition_idx] = total_entries;
+    for (unsigned thread_idx = 0; thread_idx < cpu_thread_count; ++thread_idx) {
+      auto& offset = offsets[thread_idx * partition_count + partition_idx];
+      const auto count = offset;
+      offset = total_entries;
+      total_entries += count;
+    }
+  }
+  partition_start[partition_count] = total_entries;
+  CHECK_LE(total_entries, max_entry_count);
+
+  // Entries hold a slot index within a partition and a row id.
+  std::vector<std::pair<int32_t, int32_t>> entries(total_entries);
+  {
+    std::vector<std::future<void>> scatter_threads;
+    for (unsigned thread_idx = 0; thread_idx < cpu_thread_count; ++thread_idx) {
+      scatter_threads.push_back(std::async(std::launch::async, [&, thread_idx] {
+        auto thread_offsets = offsets.data() + thread_idx * partition_count;
+        for_each_slot(thread_idx, [&](const int64_t slot, const int32_t row_id) {
+          auto& offset = thread_offsets[slot >> partition_slots_log2];
+          entries[offset++] = {static_cast<int32_t>(slot & partition_slot_mask), row_id};
+        });
+      }));
+    }
+    for (auto& child : scatter_threads) {
+      child.get();
+    }
+  }
+
+  // Partitions are independent now, fill their parts of the table without atomics.
+  std::atomic<int64_t> next_partition{0};
+  std::vector<std::future<void>> fill_threads;
+  for (unsigned thread_idx = 0; thread_idx < cpu_thread_count; ++thread_idx) {
+    fill_threads.push_back(std::async(std::launch::async, [&] {
+      for (auto partition_idx = next_partition++; partition_idx < partition_count;
+           partition_idx = next_partition++) {
+        const int64_t slot_start = partition_idx << partition_slots_log2;
+        const int64_t slot_end =
+            std::min(slot_start + partition_slot_mask + 1, hash_entry_count);
+        auto partition_pos = pos_buff + slot_start;
+        auto partition_count_buff = count_buff + slot_start;
+        const auto entries_begin = entries.begin() + partition_start[partition_idx];
+        const auto entries_end = entries.begin() + partition_start[partition_idx + 1];
+
+        std::fill(partition_count_buff, count_buff + slot_end, 0);
+        for (auto it = entries_begin; it != entries_end; ++it) {
+          ++partition_count_buff[it->first];
+        }
+        int64_t pos = partition_start[partition_idx];
+        for (int64_t i = 0; i < slot_end - slot_start; ++i) {
+          if (partition_count_buff[i]) {
+            partition_pos[i] = static_cast<int32_t>(pos);
+            pos += partition_count_buff[i];
+          }
+        }
+        std::fill(partition_count_buff, count_buff + slot_end, 0);
+        for (auto it = entries_begin; it != entries_end; ++it) {
+          id_buff[partition_pos[it->first] + partition_count_buff[it->first]++] =
+              it->second;
+        }
+      }
+    }));
+  }
+  for (auto& child : fill_threads) {
+    child.get();
+  }
+}
+
+void fill_one_to_many_hash_table_partitioned(
+    int32_t* buff,
+    const HashEntryInfo hash_entry_info,
+    const int32_t invalid_slot_val,
+    const JoinColumn& join_column,
+    const JoinColumnTypeInfo& type_info,
+    const int32_t* sd_inner_to_outer_translation_map,
+    const int32_t min_inner_elem,
+    const unsigned cpu_thread_count) {
+  auto timer = DEBUG_TIMER(__func__);
+  const auto bucket_normalization = hash_entry_info.bucket_normalization;
+  const int64_t hash_entry_count = hash_entry_info.getNormalizedHashEntryCount();
+
+  // Visit slots of rows assigned to the thread.
+  auto for_each_slot = [&](const unsigned thread_idx, auto func) {
+    JoinColumnTyped col{&join_column, &type_info};
+    for (auto item : col.slice(thread_idx, cpu_thread_count)) {
+      int64_t elem = item.element;
+      if (elem == type_info.null_val) {
+        if (type_info.uses_bw_eq) {
+          elem = type_info.translated_null_val;
+        } else {
+          continue;
+        }
+      }
+      if (sd_inner_to_outer_translation_map &&
+          (!type_info.uses_bw_eq || elem != type_info.translated_null_val)) {
+        const auto outer_id = map_str_id_to_outer_dict(elem,
+                                                       min_inner_elem,
+                                                       type_info.min_val,
+                                                       type_info.max_val,
+                                                       sd_inner_to_outer_translation_map);
+        if (outer_id == StringDictionary::INVALID_STR_ID) {
+          continue;
+        }
+        elem = outer_id;
+      }
+      func((elem - type_info.min_val) / bucket_normalization,
+           static_cast<int32_t>(item.index));
+    }
+  };
+
+  fill_one_to_many_hash_table_by_partitions(
+      buff, hash_entry_count, join_column.num_elems, cpu_thread_count, for_each_slot);
+}
+
 void init_baseline_hash_join_buff_32(int8_t* hash_join_buff,
                                      const int64_t entry_count,
                                      const size_t key_component_count,
@@ -1474,7 +1823,9 @@ int fill_baseline_hash_join_buff_32(int8_t* hash_buff,
                                     const GenericKeyHandler* key_handler,
                                     const int64_t num_elems,
                                     const int32_t cpu_thread_idx,
-                                    const int32_t cpu_thread_count) {
+                                    const int32_t cpu_thread_count,
+                                    const bool use_crc32_key_hash,
+                                    const bool prefetch_slots) {
   return fill_baseline_hash_join_buff<int32_t>(hash_buff,
                                                entry_count,
                                                invalid_slot_val,
@@ -1484,7 +1835,9 @@ int fill_baseline_hash_join_buff_32(int8_t* hash_buff,
                                                key_handler,
                                                num_elems,
                                                cpu_thread_idx,
-                                               cpu_thread_count);
+                                               cpu_thread_count,
+                                               use_crc32_key_hash,
+                                               prefetch_slots);
 }
 
 int fill_baseline_hash_join_buff_64(int8_t* hash_buff,
@@ -1496,7 +1849,9 @@ int fill_baseline_hash_join_buff_64(int8_t* hash_buff,
                                     const GenericKeyHandler* key_handler,
                                     const int64_t num_elems,
                                     const int32_t cpu_thread_idx,
-                                    const int32_t cpu_thread_count) {
+                                    const int32_t cpu_thread_count,
+                                    const bool use_crc32_key_hash,
+                                    const bool prefetch_slots) {
   return fill_baseline_hash_join_buff<int64_t>(hash_buff,
                                                entry_count,
                                                invalid_slot_val,
@@ -1506,7 +1861,107 @@ int fill_baseline_hash_join_buff_64(int8_t* hash_buff,
                                                key_handler,
                                                num_elems,
                                                cpu_thread_idx,
-                                               cpu_thread_count);
+                                               cpu_thread_count,
+                                               use_crc32_key_hash,
+                                               prefetch_slots);
+}
+
+// Looks up slots of the keys assigned to the thread and collects them along with the
+// row ids in the order of rows.
+template <typename T, typename KEY_HANDLER>
+void collect_baseline_slots(std::vector<std::pair<int64_t, int32_t>>& slots,
+                            const T* composite_key_dict,
+                            const int64_t entry_count,
+                            const KEY_HANDLER* f,
+                            const int32_t cpu_thread_idx,
+                            const int32_t cpu_thread_count,
+                            const bool use_crc32_key_hash,
+                            const bool prefetch_slots) {
+  T key_scratch_buff[g_maximum_conditions_to_coalesce];
+  const size_t key_component_count = f->get_key_component_count();
+  const size_t key_size_in_bytes = key_component_count * sizeof(T);
+  auto collect_slot = [&slots, composite_key_dict, entry_count, key_component_count](
+                          const int64_t row_index, const T* key, const uint32_t h) {
+    const T* matching_group = SUFFIX(get_matching_baseline_hash_slot_readonly)(
+        key, key_component_count, composite_key_dict, entry_count, h);
+    slots.emplace_back((matching_group - composite_key_dict) / key_component_count,
+                       static_cast<int32_t>(row_index));
+    return 0;
+  };
+  SlotPrefetchPipeline<T, decltype(collect_slot)> pipeline(
+      key_component_count, false, collect_slot);
+  auto key_buff_handler = [&](const int64_t row_index,
+                              const T* key_scratch_buff,
+                              const size_t key_component_count) {
+    const uint32_t h =
+        baseline_key_hash(key_scratch_buff, key_size_in_bytes, use_crc32_key_hash) %
+        entry_count;
+    if (prefetch_slots) {
+      return pipeline.push(
+          row_index, key_scratch_buff, h, composite_key_dict + h * key_component_count);
+    }
+    return collect_slot(row_index, key_scratch_buff, h);
+  };
+
+  JoinColumnTuple cols(
+      f->get_number_of_columns(), f->get_join_columns(), f->get_join_column_type_infos());
+  for (auto& it : cols.slice(cpu_thread_idx, cpu_thread_count)) {
+    (*f)(it.join_column_iterators, key_scratch_buff, key_buff_handler);
+  }
+  pipeline.flush();
+}
+
+// Builds the same buffers as fill_one_to_many_baseline_hash_table without atomics.
+// Slots of the keys are looked up once into per-thread lists, which are then
+// partitioned by slot ranges to fill each range with a single thread.
+template <typename T>
+void fill_one_to_many_baseline_hash_table_partitioned(
+    int32_t* buff,
+    const T* composite_key_dict,
+    const int64_t hash_entry_count,
+    const size_t key_component_count,
+    const std::vector<JoinColumn>& join_column_per_key,
+    const std::vector<JoinColumnTypeInfo>& type_info_per_key,
+    const std::vector<const int32_t*>& sd_inner_to_outer_translation_maps,
+    const std::vector<int32_t>& sd_min_inner_elems,
+    const size_t cpu_thread_count,
+    const bool use_crc32_key_hash,
+    const bool prefetch_slots) {
+  auto timer = DEBUG_TIMER(__func__);
+  std::vector<std::vector<std::pair<int64_t, int32_t>>> thread_slots(cpu_thread_count);
+  std::vector<std::future<void>> lookup_threads;
+  for (size_t cpu_thread_idx = 0; cpu_thread_idx < cpu_thread_count; ++cpu_thread_idx) {
+    lookup_threads.push_back(std::async(std::launch::async, [&, cpu_thread_idx] {
+      const auto key_handler = GenericKeyHandler(key_component_count,
+                                                 true,
+                                                 &join_column_per_key[0],
+                                                 &type_info_per_key[0],
+                                                 &sd_inner_to_outer_translation_maps[0],
+                                                 &sd_min_inner_elems[0]);
+      collect_baseline_slots(thread_slots[cpu_thread_idx],
+                             composite_key_dict,
+                             hash_entry_count,
+                             &key_handler,
+                             cpu_thread_idx,
+                             cpu_thread_count,
+                             use_crc32_key_hash,
+                             prefetch_slots);
+    }));
+  }
+  for (auto& child : lookup_threads) {
+    child.get();
+  }
+
+  fill_one_to_many_hash_table_by_partitions(
+      buff,
+      hash_entry_count,
+      join_column_per_key[0].num_elems,
+      cpu_thread_count,
+      [&thread_slots](const unsigned thread_idx, auto func) {
+        for (const auto& [slot, row_id] : thread_slots[thread_idx]) {
+          func(slot, row_id);
+        }
+      });
 }
 
 template <typename T>
@@ -1520,7 +1975,24 @@ void fill_one_to_many_baseline_hash_table(
     const std::vector<JoinColumnTypeInfo>& type_info_per_key,
     const std::vector<const int32_t*>& sd_inner_to_outer_translation_maps,
     const std::vector<int32_t>& sd_min_inner_elems,
-    const size_t cpu_thread_count) {
+    const size_t cpu_thread_count,
+    const bool use_crc32_key_hash,
+    const bool prefetch_slots,
+    const bool partitioned) {
+  if (partitioned) {
+    fill_one_to_many_baseline_hash_table_partitioned(buff,
+                                                     composite_key_dict,
+                                                     hash_entry_count,
+                                                     key_component_count,
+                                                     join_column_per_key,
+                                                     type_info_per_key,
+                                                     sd_inner_to_outer_translation_maps,
+                                                     sd_min_inner_elems,
+                                                     cpu_thread_count,
+                                                     use_crc32_key_hash,
+                                                     prefetch_slots);
+    return;
+  }
   int32_t* pos_buff = buff;
   int32_t* count_buff = buff + hash_entry_count;
   memset(count_buff, 0, hash_entry_count * sizeof(int32_t));
@@ -1537,7 +2009,9 @@ void fill_one_to_many_baseline_hash_table(
                     &sd_inner_to_outer_translation_maps,
                     &sd_min_inner_elems,
                     cpu_thread_idx,
-                    cpu_thread_count] {
+                    cpu_thread_count,
+                    use_crc32_key_hash,
+                    prefetch_slots] {
                      const auto key_handler =
                          GenericKeyHandler(key_component_count,
                                            true,
@@ -1551,7 +2025,9 @@ void fill_one_to_many_baseline_hash_table(
                                             &key_handler,
                                             join_column_per_key[0].num_elems,
                                             cpu_thread_idx,
-                                            cpu_thread_count);
+                                            cpu_thread_count,
+                                            use_crc32_key_hash,
+                                            prefetch_slots);
                    }));
   }
 
@@ -1595,7 +2071,9 @@ void fill_one_to_many_baseline_hash_table(
                                         &sd_inner_to_outer_translation_maps,
                                         &sd_min_inner_elems,
                                         cpu_thread_idx,
-                                        cpu_thread_count] {
+                                        cpu_thread_count,
+                                        use_crc32_key_hash,
+                                        prefetch_slots] {
                                          const auto key_handler = GenericKeyHandler(
                                              key_component_count,
                                              true,
@@ -1611,7 +2089,9 @@ void fill_one_to_many_baseline_hash_table(
                                           &key_handler,
                                           join_column_per_key[0].num_elems,
                                           cpu_thread_idx,
-                                          cpu_thread_count);
+                                          cpu_thread_count,
+                                          use_crc32_key_hash,
+                                          prefetch_slots);
                                        }));
   }
 
@@ -1630,7 +2110,10 @@ void fill_one_to_many_baseline_hash_table_32(
     const std::vector<JoinColumnTypeInfo>& type_info_per_key,
     const std::vector<const int32_t*>& sd_inner_to_outer_translation_maps,
     const std::vector<int32_t>& sd_min_inner_elems,
-    const int32_t cpu_thread_count) {
+    const int32_t cpu_thread_count,
+    const bool use_crc32_key_hash,
+    const bool prefetch_slots,
+    const bool partitioned) {
   fill_one_to_many_baseline_hash_table<int32_t>(buff,
                                                 composite_key_dict,
                                                 hash_entry_count,
@@ -1640,7 +2123,10 @@ void fill_one_to_many_baseline_hash_table_32(
                                                 type_info_per_key,
                                                 sd_inner_to_outer_translation_maps,
                                                 sd_min_inner_elems,
-                                                cpu_thread_count);
+                                                cpu_thread_count,
+                                                use_crc32_key_hash,
+                                                prefetch_slots,
+                                                partitioned);
 }
 
 void fill_one_to_many_baseline_hash_table_64(
@@ -1653,7 +2139,10 @@ void fill_one_to_many_baseline_hash_table_64(
     const std::vector<JoinColumnTypeInfo>& type_info_per_key,
     const std::vector<const int32_t*>& sd_inner_to_outer_translation_maps,
     const std::vector<int32_t>& sd_min_inner_elems,
-    const int32_t cpu_thread_count) {
+    const int32_t cpu_thread_count,
+    const bool use_crc32_key_hash,
+    const bool prefetch_slots,
+    const bool partitioned) {
   fill_one_to_many_baseline_hash_table<int64_t>(buff,
                                                 composite_key_dict,
                                                 hash_entry_count,
@@ -1663,7 +2152,10 @@ void fill_one_to_many_baseline_hash_table_64(
                                                 type_info_per_key,
                                                 sd_inner_to_outer_translation_maps,
                                                 sd_min_inner_elems,
-                                                cpu_thread_count);
+                                                cpu_thread_count,
+                                                use_crc32_key_hash,
+                                                prefetch_slots,
+                                                partitioned);
 }
 
 void approximate_distinct_tuples(uint8_t* hll_buffer_all_cpus,
@@ -219,6 +219,18 @@ void fill_one_to_many_hash_table_bucketized(
     const int32_t min_inner_elem,
     const unsigned cpu_thread_count);
 
+// Builds the same table as fill_one_to_many_hash_table, bucketized or not, but
+// partitions rows by slot ranges first to fill each range with a single thread.
+void fill_one_to_many_hash_table_partitioned(
+    int32_t* buff,
+    const HashEntryInfo hash_entry_info,
+    const int32_t invalid_slot_val,
+    const JoinColumn& join_column,
+    const JoinColumnTypeInfo& type_info,
+    const int32_t* sd_inner_to_outer_translation_map,
+    const int32_t min_inner_elem,
+    const unsigned cpu_thread_count);
+
 void fill_one_to_many_hash_table_on_device(int32_t* buff,
                                            const HashEntryInfo hash_entry_info,
                                            const int32_t invalid_slot_val,
@@ -241,7 +253,9 @@ int fill_baseline_hash_join_buff_32(int8_t* hash_buff,
                                     const GenericKeyHandler* key_handler,
                                     const int64_t num_elems,
                                     const int32_t cpu_thread_idx,
-                                    const int32_t cpu_thread_count);
+                                    const int32_t cpu_thread_count,
+                                    const bool use_crc32_key_hash = false,
+                                    const bool prefetch_slots = false);
 
 int fill_baseline_hash_join_buff_64(int8_t* hash_buff,
                                     const int64_t entry_count,
@@ -252,7 +266,9 @@ int fill_baseline_hash_join_buff_64(int8_t* hash_buff,
                                     const GenericKeyHandler* key_handler,
                                     const int64_t num_elems,
                                     const int32_t cpu_thread_idx,
-                                    const int32_t cpu_thread_count);
+                                    const int32_t cpu_thread_count,
+                                    const bool use_crc32_key_hash = false,
+                                    const bool prefetch_slots = false);
 
 void fill_baseline_hash_join_buff_on_device_32(int8_t* hash_buff,
                                                const int64_t entry_count,
@@ -284,7 +300,10 @@ void fill_one_to_many_baseline_hash_table_32(
     const std::vector<JoinColumnTypeInfo>& type_info_per_key,
     const std::vector<const int32_t*>& sd_inner_to_outer_translation_maps,
     const std::vector<int32_t>& sd_min_inner_elems,
-    const int32_t cpu_thread_count);
+    const int32_t cpu_thread_count,
+    const bool use_crc32_key_hash = false,
+    const bool prefetch_slots = false,
+    const bool partitioned = false);
 
 void fill_one_to_many_baseline_hash_table_64(
     int32_t* buff,
@@ -296,7 +315,10 @@ void fill_one_to_many_baseline_hash_table_64(
     const std::vector<JoinColumnTypeInfo>& type_info_per_key,
     const std::vector<const int32_t*>& sd_inner_to_outer_translation_maps,
     const std::vector<int32_t>& sd_min_inner_elems,
-    const int32_t cpu_thread_count);
+    const int32_t cpu_thread_count,
+    const bool use_crc32_key_hash = false,
+    const bool prefetch_slots = false,
+    const bool partitioned = false);
 
 void fill_one_to_many_baseline_hash_table_on_device_32(
     int32_t* buff,
@@ -19,6 +19,7 @@
 #include <cstdlib>
 
 #include "QueryEngine/CompareKeysInl.h"
+#include "QueryEngine/Crc32cHashInl.h"
 #include "QueryEngine/MurmurHash.h"
 
 DEVICE bool compare_to_key(GENERIC_ADDR_SPACE const int8_t* entry,
@@ -57,14 +58,11 @@ DEVICE int64_t get_matching_slot(GENERIC_ADDR_SPACE const int8_t* hash_buff,
 
 template <class T>
 FORCE_INLINE DEVICE int64_t
-baseline_hash_join_idx_impl(GENERIC_ADDR_SPACE const int8_t* hash_buff,
-                            GENERIC_ADDR_SPACE const int8_t* key,
-                            const size_t key_bytes,
-                            const size_t entry_count) {
-  if (!entry_count) {
-    return kNoMatch;
-  }
-  const uint32_t h = MurmurHash1(key, key_bytes, 0) % entry_count;
+probe_baseline_hash_join_slot(GENERIC_ADDR_SPACE const int8_t* hash_buff,
+                              GENERIC_ADDR_SPACE const int8_t* key,
+                              const size_t key_bytes,
+                              const size_t entry_count,
+                              const uint32_t h) {
   int64_t matching_slot = get_matching_slot<T>(hash_buff, h, key, key_bytes);
   if (matching_slot != kNoMatch) {
     return matching_slot;
@@ -80,6 +78,19 @@ baseline_hash_join_idx_impl(GENERIC_ADDR_SPACE const int8_t* hash_buff,
   return kNoMatch;
 }
 
+template <class T>
+FORCE_INLINE DEVICE int64_t
+baseline_hash_join_idx_impl(GENERIC_ADDR_SPACE const int8_t* hash_buff,
+                            GENERIC_ADDR_SPACE const int8_t* key,
+                            const size_t key_bytes,
+                            const size_t entry_count) {
+  if (!entry_count) {
+    return kNoMatch;
+  }
+  const uint32_t h = MurmurHash1(key, key_bytes, 0) % entry_count;
+  return probe_baseline_hash_join_slot<T>(hash_buff, key, key_bytes, entry_count, h);
+}
+
 extern "C" RUNTIME_EXPORT NEVER_INLINE DEVICE int64_t
 baseline_hash_join_idx_32(GENERIC_ADDR_SPACE const int8_t* hash_buff,
                           GENERIC_ADDR_SPACE const int8_t* key,
@@ -96,6 +107,40 @@ baseline_hash_join_idx_64(GENERIC_ADDR_SPACE const int8_t* hash_buff,
   return baseline_hash_join_idx_impl<int64_t>(hash_buff, key, key_bytes, entry_count);
 }
 
+#ifdef HAVE_CRC32_KEY_HASH
+// Probes baseline hash tables built on CPU with CRC32C key hashing.
+template <class T>
+CRC32_KEY_HASH_TARGET FORCE_INLINE int64_t
+baseline_hash_join_idx_crc32_impl(const int8_t* hash_buff,
+                                  const int8_t* key,
+                                  const size_t key_bytes,
+                                  const size_t entry_count) {
+  if (!entry_count) {
+    return kNoMatch;
+  }
+  const uint32_t h = Crc32cHashImpl(key, key_bytes, 0) % entry_count;
+  return probe_baseline_hash_join_slot<T>(hash_buff, key, key_bytes, entry_count, h);
+}
+
+extern "C" RUNTIME_EXPORT NEVER_INLINE CRC32_KEY_HASH_TARGET int64_t
+baseline_hash_join_idx_crc32_32(const int8_t* hash_buff,
+                                const int8_t* key,
+                                const size_t key_bytes,
+                                const size_t entry_count) {
+  return baseline_hash_join_idx_crc32_impl<int32_t>(
+      hash_buff, key, key_bytes, entry_count);
+}
+
+extern "C" RUNTIME_EXPORT NEVER_INLINE CRC32_KEY_HASH_TARGET int64_t
+baseline_hash_join_idx_crc32_64(const int8_t* hash_buff,
+                                const int8_t* key,
+                                const size_t key_bytes,
+                                const size_t entry_count) {
+  return baseline_hash_join_idx_crc32_impl<int64_t>(
+      hash_buff, key, key_bytes, entry_count);
+}
+#endif  // HAVE_CRC32_KEY_HASH
+
 template <typename T>
 FORCE_INLINE DEVICE int64_t get_bucket_key_for_value_impl(const T value,
                                                           const double bucket_size) {
@@ -127,11 +172,11 @@ get_bucket_key_for_range_compressed(GENERIC_ADDR_SPACE const int8_t* range,
 }
 
 template <typename T>
-FORCE_INLINE DEVICE int64_t get_composite_key_index_impl(const T* key,
-                                                         const size_t key_component_count,
-                                                         const T* composite_key_dict,
-                                                         const size_t entry_count) {
-  const uint32_t h = MurmurHash1(key, key_component_count * sizeof(T), 0) % entry_count;
+FORCE_INLINE DEVICE int64_t probe_composite_key_index(const T* key,
+                                                      const size_t key_component_count,
+                                                      const T* composite_key_dict,
+                                                      const size_t entry_count,
+                                                      const uint32_t h) {
   uint32_t off = h * key_component_count;
   if (keys_are_equal(&composite_key_dict[off], key, key_component_count)) {
     return h;
@@ -150,6 +195,16 @@ FORCE_INLINE DEVICE int64_t get_composite_key_index_impl(const T* key,
   return -1;
 }
 
+template <typename T>
+FORCE_INLINE DEVICE int64_t get_composite_key_index_impl(const T* key,
+                                                         const size_t key_component_count,
+                                                         const T* composite_key_dict,
+                                                         const size_t entry_count) {
+  const uint32_t h = MurmurHash1(key, key_component_count * sizeof(T), 0) % entry_count;
+  return probe_composite_key_index(
+      key, key_component_count, composite_key_dict, entry_count, h);
+}
+
 extern "C" RUNTIME_EXPORT NEVER_INLINE DEVICE int64_t
 get_composite_key_index_32(GENERIC_ADDR_SPACE const int32_t* key,
                            const size_t key_component_count,
@@ -167,3 +222,35 @@ get_composite_key_index_64(GENERIC_ADDR_SPACE const int64_t* key,
   return get_composite_key_index_impl(
       key, key_component_count, composite_key_dict, entry_count);
 }
+
+#ifdef HAVE_CRC32_KEY_HASH
+template <typename T>
+CRC32_KEY_HASH_TARGET FORCE_INLINE int64_t
+get_composite_key_index_crc32_impl(const T* key,
+                                   const size_t key_component_count,
+                                   const T* composite_key_dict,
+                                   const size_t entry_count) {
+  const uint32_t h =
+      Crc32cHashImpl(key, key_component_count * sizeof(T), 0) % entry_count;
+  return probe_composite_key_index(
+      key, key_component_count, composite_key_dict, entry_count, h);
+}
+
+extern "C" RUNTIME_EXPORT NEVER_INLINE CRC32_KEY_HASH_TARGET int64_t
+get_composite_key_index_crc32_32(const int32_t* key,
+                                 const size_t key_component_count,
+                                 const int32_t* composite_key_dict,
+                                 const size_t entry_count) {
+  return get_composite_key_index_crc32_impl(
+      key, key_component_count, composite_key_dict, entry_count);
+}
+
+extern "C" RUNTIME_EXPORT NEVER_INLINE CRC32_KEY_HASH_TARGET int64_t
+get_composite_key_index_crc32_64(const int64_t* key,
+                                 const size_t key_component_count,
+                                 const int64_t* composite_key_dict,
+                                 const size_t entry_count) {
+  return get_composite_key_index_crc32_impl(
+      key, key_component_count, composite_key_dict, entry_count);
+}
+#endif  // HAVE_CRC32_KEY_HASH
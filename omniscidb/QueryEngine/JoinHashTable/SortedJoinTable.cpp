@@ -0,0 +1,496 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/JoinHashTable/SortedJoinTable.h"
+
+#include "Logger/Logger.h"
+#include "QueryEngine/CodeGenerator.h"
+#include "QueryEngine/Execute.h"
+#include "QueryEngine/ExpressionRewrite.h"
+#include "QueryEngine/JoinHashTable/PerfectJoinHashTable.h"
+#include "QueryEngine/JoinHashTable/Runtime/HashJoinRuntime.h"
+#include "QueryEngine/JoinHashTable/Runtime/JoinColumnIterator.h"
+#include "QueryEngine/MurmurHash.h"
+#include "QueryEngine/RuntimeFunctions.h"
+#include "Shared/parallel_sort.h"
+#include "Utils/ChunkIter.h"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <unordered_map>
+
+namespace {
+
+bool is_range_join_type(const hdk::ir::Type* inner_type,
+                        const hdk::ir::Type* outer_type) {
+  if (inner_type->isInteger()) {
+    return outer_type->isInteger();
+  }
+  // Keys are compared as stored, so the encoding must be the same on both sides.
+  if (inner_type->isDecimal() || inner_type->isTimestamp() || inner_type->isTime()) {
+    return inner_type->withNullable(false)->equal(outer_type->withNullable(false));
+  }
+  return false;
+}
+
+// Inequality join condition in the form of a bound of an inner column.
+struct RangeQual {
+  std::shared_ptr<const hdk::ir::BinOper> qual;
+  const hdk::ir::ColumnVar* inner_col;
+  const hdk::ir::Expr* outer_expr;
+  bool is_lower_bound;
+  bool inclusive;
+};
+
+std::optional<RangeQual> get_range_qual(const hdk::ir::ExprPtr& qual,
+                                        SchemaProviderPtr schema_provider,
+                                        const TemporaryTables* temporary_tables) {
+  auto qual_bin_oper = std::dynamic_pointer_cast<const hdk::ir::BinOper>(qual);
+  if (!qual_bin_oper || !(qual_bin_oper->isLt() || qual_bin_oper->isLe() ||
+                          qual_bin_oper->isGt() || qual_bin_oper->isGe())) {
+    return std::nullopt;
+  }
+  InnerOuter cols;
+  try {
+    cols = HashJoin::normalizeColumnPair(qual_bin_oper->leftOperand(),
+                                         qual_bin_oper->rightOperand(),
+                                         schema_provider,
+                                         temporary_tables);
+  } catch (const HashJoinFail&) {
+    return std::nullopt;
+  }
+  // Casts of the inner column would change the order of keys.
+  const bool inner_is_lhs = cols.first == qual_bin_oper->leftOperand();
+  if (!inner_is_lhs && cols.first != qual_bin_oper->rightOperand()) {
+    return std::nullopt;
+  }
+  if (!is_range_join_type(cols.first->type(), cols.second->type())) {
+    return std::nullopt;
+  }
+  const bool is_less = qual_bin_oper->isLt() || qual_bin_oper->isLe();
+  return RangeQual{qual_bin_oper,
+                   cols.first,
+                   cols.second,
+                   inner_is_lhs != is_less,
+                   qual_bin_oper->isLe() || qual_bin_oper->isGe()};
+}
+
+JoinColumnTypeInfo get_join_column_type_info(const hdk::ir::Type* type) {
+  return {static_cast<size_t>(type->size()),
+          0,
+          0,
+          inline_fixed_encoding_null_value(type),
+          false,
+          0,
+          get_join_column_type_kind(type)};
+}
+
+}  // namespace
+
+std::shared_ptr<SortedJoinTable> SortedJoinTable::getInstance(
+    const std::shared_ptr<const hdk::ir::BinOper> qual_bin_oper,
+    const std::vector<InputTableInfo>& query_infos,
+    const Data_Namespace::MemoryLevel memory_level,
+    const int device_count,
+    DataProvider* data_provider,
+    ColumnCacheMap& column_cache,
+    Executor* executor) {
+  CHECK(qual_bin_oper->isEquivalence());
+  if (memory_level != Data_Namespace::CPU_LEVEL) {
+    throw HashJoinFail("Sorted join tables are supported on CPU only");
+  }
+  if (qual_bin_oper->isBwEq()) {
+    throw HashJoinFail("Sorted join tables don't support bitwise equality");
+  }
+  const auto cols =
+      HashJoin::normalizeColumnPair(qual_bin_oper->leftOperand(),
+                                    qual_bin_oper->rightOperand(),
+                                    executor->getSchemaProvider(),
+                                    executor->temporary_tables_);
+  const auto inner_col = cols.first;
+  CHECK(inner_col);
+  const bool string_keys =
+      inner_col->type()->isString() && cols.second->type()->isString();
+  if (!string_keys &&
+      (!inner_col->type()->isInteger() || !cols.second->type()->isInteger())) {
+    throw HashJoinFail(
+        "Sorted join tables support integer and none-encoded string join keys only");
+  }
+  KeyBound key{cols.second->shared(), true};
+  return build(std::shared_ptr<SortedJoinTable>(new SortedJoinTable(inner_col,
+                                                                    key,
+                                                                    key,
+                                                                    nullptr,
+                                                                    HashType::OneToMany,
+                                                                    query_infos,
+                                                                    device_count,
+                                                                    data_provider,
+                                                                    column_cache,
+                                                                    executor)));
+}
+
+std::shared_ptr<SortedJoinTable> SortedJoinTable::getRangeInstance(
+    const std::list<hdk::ir::ExprPtr>& quals,
+    const std::vector<InputTableInfo>& query_infos,
+    const Data_Namespace::MemoryLevel memory_level,
+    const int device_count,
+    DataProvider* data_provider,
+    ColumnCacheMap& column_cache,
+    Executor* executor,
+    std::vector<std::shared_ptr<const hdk::ir::BinOper>>& consumed_quals) {
+  if (memory_level != Data_Namespace::CPU_LEVEL) {
+    throw HashJoinFail("Range join tables are supported on CPU only");
+  }
+  std::vector<RangeQual> range_quals;
+  int inner_rte_idx = 0;
+  for (const auto& qual : quals) {
+    if (auto range_qual = get_range_qual(
+            qual, executor->getSchemaProvider(), executor->temporary_tables_)) {
+      inner_rte_idx = std::max(inner_rte_idx, range_qual->inner_col->rteIdx());
+      range_quals.push_back(*range_qual);
+    }
+  }
+  range_quals.erase(std::remove_if(range_quals.begin(),
+                                   range_quals.end(),
+                                   [inner_rte_idx](const RangeQual& range_qual) {
+                                     return range_qual.inner_col->rteIdx() !=
+                                            inner_rte_idx;
+                                   }),
+                    range_quals.end());
+  if (range_quals.empty()) {
+    throw HashJoinFail("No range join condition found");
+  }
+
+  auto make_table = [&](const RangeQual& key_qual,
+                        const RangeQual* other_qual,
+                        bool is_interval) {
+    std::optional<KeyBound> lower_bound;
+    std::optional<KeyBound> upper_bound;
+    auto add_bound = [&](const RangeQual& range_qual) {
+      auto& bound = range_qual.is_lower_bound ? lower_bound : upper_bound;
+      bound = KeyBound{range_qual.outer_expr->shared(), range_qual.inclusive};
+      consumed_quals.push_back(range_qual.qual);
+    };
+    add_bound(key_qual);
+    // The condition on interval ends is only used to limit the search range.
+    if (other_qual && !is_interval) {
+      add_bound(*other_qual);
+    }
+    return build(std::shared_ptr<SortedJoinTable>(
+        new SortedJoinTable(key_qual.inner_col,
+                            lower_bound,
+                            upper_bound,
+                            is_interval ? other_qual->inner_col : nullptr,
+                            HashType::Range,
+                            query_infos,
+                            device_count,
+                            data_provider,
+                            column_cache,
+                            executor)));
+  };
+
+  // Both bounds of the same column, e.g. b.x BETWEEN a.lo AND a.hi.
+  for (auto& lower : range_quals) {
+    for (auto& upper : range_quals) {
+      if (lower.is_lower_bound && !upper.is_lower_bound &&
+          *lower.inner_col == *upper.inner_col) {
+        return make_table(lower, &upper, false);
+      }
+    }
+  }
+  // Interval containing the outer value, e.g. a.ts BETWEEN b.start AND b.end.
+  for (auto& start : range_quals) {
+    for (auto& end : range_quals) {
+      if (!start.is_lower_bound && end.is_lower_bound &&
+          *start.outer_expr == *end.outer_expr &&
+          !(*start.inner_col == *end.inner_col)) {
+        return make_table(start, &end, true);
+      }
+    }
+  }
+  return make_table(range_quals.front(), nullptr, false);
+}
+
+std::shared_ptr<SortedJoinTable> SortedJoinTable::build(
+    std::shared_ptr<SortedJoinTable> join_hash_table) {
+  const auto& query_info = get_inner_query_info(join_hash_table->getInnerDbId(),
+                                                join_hash_table->getInnerTableId(),
+                                                join_hash_table->query_infos_)
+                               .info;
+  if (query_info.getNumTuplesUpperBound() >
+      static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+    throw TooManyHashEntries();
+  }
+  try {
+    join_hash_table->reify();
+  } catch (const HashJoinFail& e) {
+    join_hash_table->freeHashBufferMemory();
+    throw HashJoinFail(std::string("Could not build a sorted join table for columns "
+                                   "involved in join | ") +
+                       e.what());
+  } catch (const std::bad_alloc& e) {
+    join_hash_table->freeHashBufferMemory();
+    throw HashJoinFail(std::string("Could not allocate a sorted join table | ") +
+                       e.what());
+  }
+  return join_hash_table;
+}
+
+void SortedJoinTable::reify() {
+  auto timer = DEBUG_TIMER(__func__);
+  const auto& query_info =
+      get_inner_query_info(getInnerDbId(), getInnerTableId(), query_infos_).info;
+  std::vector<std::shared_ptr<Chunk_NS::Chunk>> chunks_owner;
+  std::vector<std::shared_ptr<void>> malloc_owner;
+  auto fetch_column = [&](const hdk::ir::ColumnVar* col) {
+    return fetchJoinColumn(col,
+                           query_info.fragments,
+                           Data_Namespace::CPU_LEVEL,
+                           0,
+                           chunks_owner,
+                           nullptr,
+                           malloc_owner,
+                           executor_,
+                           &column_cache_);
+  };
+
+  // Null keys never match and are not included into the table.
+  std::vector<int64_t> keys;
+  std::vector<int32_t> row_ids;
+  if (inner_col_->type()->isString()) {
+    CHECK(!interval_end_col_);
+    fetchStringKeys(query_info, keys, row_ids);
+  } else {
+    auto join_column = fetch_column(inner_col_.get());
+    auto type_info = get_join_column_type_info(inner_col_->type());
+    keys.reserve(join_column.num_elems);
+    row_ids.reserve(join_column.num_elems);
+    for (auto item : JoinColumnTyped{&join_column, &type_info}) {
+      if (item.element != type_info.null_val) {
+        keys.push_back(item.element);
+        row_ids.push_back(static_cast<int32_t>(item.index));
+      }
+    }
+
+    if (interval_end_col_) {
+      // Rows with null interval ends never match and don't limit the interval length.
+      auto end_column = fetch_column(interval_end_col_.get());
+      auto end_type_info = get_join_column_type_info(interval_end_col_->type());
+      CHECK_EQ(end_column.num_elems, join_column.num_elems);
+      max_interval_length_ = std::numeric_limits<int64_t>::min();
+      auto end_it = JoinColumnTyped{&end_column, &end_type_info}.begin();
+      for (auto item : JoinColumnTyped{&join_column, &type_info}) {
+        CHECK(end_it);
+        const auto end = (*end_it).element;
+        int64_t length;
+        if (item.element != type_info.null_val && end != end_type_info.null_val) {
+          if (__builtin_sub_overflow(end, item.element, &length)) {
+            max_interval_length_ = std::numeric_limits<int64_t>::max();
+            break;
+          }
+          max_interval_length_ = std::max(max_interval_length_, length);
+        }
+        ++end_it;
+      }
+      if (max_interval_length_ == std::numeric_limits<int64_t>::min()) {
+        max_interval_length_ = 0;
+      }
+    }
+  }
+
+  parallel_sort_by_key(keys.data(), row_ids.data(), keys.size(), std::less<int64_t>());
+
+  auto hash_table = std::make_shared<SortedHashTable>(keys.size());
+  std::copy(keys.begin(), keys.end(), hash_table->keys());
+  std::copy(row_ids.begin(), row_ids.end(), hash_table->rowIds());
+  VLOG(1) << "Built sorted join table with " << keys.size() << " keys";
+  // All devices are CPU threads sharing the same table.
+  for (auto& table : hash_tables_for_device_) {
+    table = hash_table;
+  }
+}
+
+void SortedJoinTable::fetchStringKeys(const TableFragmentsInfo& query_info,
+                                      std::vector<int64_t>& keys,
+                                      std::vector<int32_t>& row_ids) {
+  auto col_info = inner_col_->columnInfo();
+  keys.reserve(query_info.getNumTuples());
+  row_ids.reserve(query_info.getNumTuples());
+  int32_t row_id_base = 0;
+  for (const auto& fragment : query_info.fragments) {
+    if (fragment.isEmptyPhysicalFragment()) {
+      continue;
+    }
+    auto chunk_meta_it = fragment.getChunkMetadataMap().find(inner_col_->columnId());
+    CHECK(chunk_meta_it != fragment.getChunkMetadataMap().end());
+    ChunkKey chunk_key{col_info->db_id,
+                       fragment.physicalTableId,
+                       col_info->column_id,
+                       fragment.fragmentId};
+    auto chunk = data_provider_->getChunk(col_info,
+                                          chunk_key,
+                                          Data_Namespace::CPU_LEVEL,
+                                          0,
+                                          chunk_meta_it->second->numBytes(),
+                                          chunk_meta_it->second->numElements());
+    CHECK(chunk);
+    auto chunk_iter = chunk->begin_iterator(chunk_meta_it->second);
+    const auto num_rows = static_cast<int32_t>(fragment.getNumTuples());
+    for (int32_t row = 0; row < num_rows; ++row) {
+      VarlenDatum vd;
+      bool is_end;
+      ChunkIter_get_nth(&chunk_iter, row, false, &vd, &is_end);
+      CHECK(!is_end);
+      // Empty strings are nulls.
+      if (!vd.is_null && vd.length) {
+        keys.push_back(static_cast<int64_t>(
+            MurmurHash64A(vd.pointer, static_cast<int>(vd.length), 0)));
+        row_ids.push_back(row_id_base + row);
+      }
+    }
+    row_id_base += num_rows;
+  }
+}
+
+std::string SortedJoinTable::toString(const ExecutorDeviceType device_type,
+                                      const int device_id,
+                                      bool raw) const {
+  CHECK(device_type == ExecutorDeviceType::CPU);
+  std::ostringstream oss;
+  oss << "| sorted " << toSet(device_type, device_id);
+  return oss.str();
+}
+
+DecodedJoinHashBufferSet SortedJoinTable::toSet(const ExecutorDeviceType device_type,
+                                                const int device_id) const {
+  CHECK(device_type == ExecutorDeviceType::CPU);
+  auto hash_table = dynamic_cast<SortedHashTable*>(getHashTableForDevice(device_id));
+  if (!hash_table) {
+    return {};
+  }
+  std::map<int64_t, std::set<int32_t>> payloads;
+  for (size_t i = 0; i < hash_table->getEntryCount(); ++i) {
+    payloads[hash_table->keys()[i]].insert(hash_table->rowIds()[i]);
+  }
+  DecodedJoinHashBufferSet s;
+  for (auto& [key, row_ids] : payloads) {
+    s.insert({{key}, row_ids});
+  }
+  return s;
+}
+
+llvm::Value* SortedJoinTable::codegenSlot(const CompilationOptions&, const size_t) {
+  UNREACHABLE() << "Sorted join tables never have one-to-one layout";
+  return nullptr;
+}
+
+llvm::Value* SortedJoinTable::codegenKey(const hdk::ir::Expr* outer_expr,
+                                         const CompilationOptions& co,
+                                         std::vector<llvm::Value*>& not_null_lvs) {
+  AUTOMATIC_IR_METADATA(executor_->cgen_state_.get());
+  const auto outer_col_var = dynamic_cast<const hdk::ir::ColumnVar*>(outer_expr);
+  if (outer_col_var &&
+      self_join_not_covered_by_left_deep_tree(
+          outer_col_var,
+          inner_col_.get(),
+          get_max_rte_scan_table(executor_->cgen_state_->scan_idx_to_hash_pos_))) {
+    throw std::runtime_error(
+        "Query execution fails because the query contains not supported self-join "
+        "pattern. Please consider rewriting table order in FROM clause.");
+  }
+  auto cgen_state = executor_->cgen_state_.get();
+  CodeGenerator code_generator(executor_, co.codegen_traits_desc);
+  auto key_lvs = code_generator.codegen(outer_expr, true, co);
+  auto type = outer_expr->type();
+  if (type->isString()) {
+    // Unpack pointer and length, see CodeGenerator::codegenCmp.
+    if (key_lvs.size() != 3) {
+      CHECK_EQ(size_t(1), key_lvs.size());
+      key_lvs.push_back(cgen_state->emitCall("extract_str_ptr", {key_lvs.front()}));
+      key_lvs.push_back(cgen_state->emitCall("extract_str_len", {key_lvs.front()}));
+    }
+    // Empty strings are nulls.
+    not_null_lvs.push_back(
+        cgen_state->ir_builder_.CreateICmpNE(key_lvs[2], cgen_state->llInt(int32_t(0))));
+    return cgen_state->emitCall("sorted_join_string_key", {key_lvs[1], key_lvs[2]});
+  }
+  CHECK_EQ(size_t(1), key_lvs.size());
+  auto key_lv = cgen_state->castToTypeIn(key_lvs.front(), 64);
+  if (type->nullable()) {
+    not_null_lvs.push_back(cgen_state->ir_builder_.CreateICmpNE(
+        key_lv, cgen_state->llInt(inline_fixed_encoding_null_value(type))));
+  }
+  return key_lv;
+}
+
+HashJoinMatchingSet SortedJoinTable::codegenMatchingSet(const CompilationOptions& co,
+                                                        const size_t index) {
+  AUTOMATIC_IR_METADATA(executor_->cgen_state_.get());
+  auto cgen_state = executor_->cgen_state_.get();
+  auto& ir_builder = cgen_state->ir_builder_;
+  auto buff_lv = codegenHashTableLoad(index, executor_);
+
+  // Outer rows with null bounds have no matches.
+  std::vector<llvm::Value*> not_null_lvs;
+  std::unordered_map<const hdk::ir::Expr*, llvm::Value*> key_lvs;
+  auto codegen_bound_key = [&](const KeyBound& bound) {
+    auto& key_lv = key_lvs[bound.outer_expr.get()];
+    if (!key_lv) {
+      key_lv = codegenKey(bound.outer_expr.get(), co, not_null_lvs);
+    }
+    return key_lv;
+  };
+
+  llvm::Value* start_lv = cgen_state->llInt(int64_t(0));
+  llvm::Value* end_lv = cgen_state->emitCall("sorted_join_key_count", {buff_lv});
+  if (lower_bound_) {
+    start_lv = cgen_state->emitCall(
+        lower_bound_->inclusive ? "sorted_join_lower_bound" : "sorted_join_upper_bound",
+        {buff_lv, codegen_bound_key(*lower_bound_)});
+  }
+  if (upper_bound_) {
+    auto key_lv = codegen_bound_key(*upper_bound_);
+    end_lv = cgen_state->emitCall(
+        upper_bound_->inclusive ? "sorted_join_upper_bound" : "sorted_join_lower_bound",
+        {buff_lv, key_lv});
+    if (interval_end_col_) {
+      CHECK(!lower_bound_);
+      start_lv = cgen_state->emitCall(
+          "sorted_join_interval_start",
+          {buff_lv, key_lv, cgen_state->llInt(max_interval_length_)});
+    }
+  }
+  llvm::Value* count_lv =
+      ir_builder.CreateSelect(ir_builder.CreateICmpSGT(end_lv, start_lv),
+                              ir_builder.CreateSub(end_lv, start_lv),
+                              cgen_state->llInt(int64_t(0)));
+  for (auto not_null_lv : not_null_lvs) {
+    count_lv =
+        ir_builder.CreateSelect(not_null_lv, count_lv, cgen_state->llInt(int64_t(0)));
+  }
+
+  compiler::CodegenTraits cgen_traits =
+      compiler::CodegenTraits::get(co.codegen_traits_desc);
+  auto rowid_base_i32 = ir_builder.CreateIntToPtr(
+      cgen_state->emitCall("sorted_join_rowids", {buff_lv}),
+      llvm::Type::getInt32PtrTy(cgen_state->context_, cgen_traits.getLocalAddrSpace()));
+  auto rowid_ptr_i32 = ir_builder.CreateGEP(
+      rowid_base_i32->getType()->getScalarType()->getPointerElementType(),
+      rowid_base_i32,
+      start_lv);
+  return {rowid_ptr_i32, count_lv, start_lv};
+}
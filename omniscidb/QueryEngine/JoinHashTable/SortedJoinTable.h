@@ -0,0 +1,207 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "IR/Expr.h"
+#include "QueryEngine/InputMetadata.h"
+#include "QueryEngine/JoinHashTable/HashJoin.h"
+
+#include <list>
+#include <memory>
+#include <optional>
+#include <vector>
+
+/**
+ * CPU buffer of a sorted join table: inner join keys sorted in ascending order
+ * together with their row ids. The buffer layout is
+ * [int64 key count][sorted int64 keys][int32 row ids].
+ */
+class SortedHashTable : public HashTable {
+ public:
+  SortedHashTable(const size_t entry_count)
+      : entry_count_(entry_count)
+      , cpu_buff_size_(sizeof(int64_t) * (entry_count + 1) +
+                       sizeof(int32_t) * entry_count)
+      , cpu_buff_(new int8_t[cpu_buff_size_]) {
+    *reinterpret_cast<int64_t*>(cpu_buff_.get()) = entry_count_;
+  }
+
+  size_t getHashTableBufferSize(const ExecutorDeviceType device_type) const override {
+    return device_type == ExecutorDeviceType::CPU ? cpu_buff_size_ : 0;
+  }
+
+  int8_t* getCpuBuffer() override { return cpu_buff_.get(); }
+
+  int8_t* getGpuBuffer() const override { return nullptr; }
+
+  HashType getLayout() const override { return HashType::OneToMany; }
+
+  size_t getEntryCount() const override { return entry_count_; }
+
+  size_t getEmittedKeysCount() const override { return entry_count_; }
+
+  int64_t* keys() { return reinterpret_cast<int64_t*>(cpu_buff_.get()) + 1; }
+
+  int32_t* rowIds() { return reinterpret_cast<int32_t*>(keys() + entry_count_); }
+
+ private:
+  size_t entry_count_;
+  size_t cpu_buff_size_;
+  std::unique_ptr<int8_t[]> cpu_buff_;
+};
+
+/**
+ * Join on a single integer-like inner column which is executed as a binary search
+ * over the sorted inner keys instead of a hash table lookup. Matches of an outer
+ * row form a contiguous range of the sorted keys, so the join loop is the same as
+ * for one-to-many hash tables. CPU only.
+ *
+ * For equi-joins the table has no limitations on the inner key range and its memory
+ * footprint depends on the inner table size only, which makes it a replacement for
+ * huge and sparse perfect hash tables. For range joins the key range is bounded by
+ * inequality join conditions, e.g. b.x BETWEEN a.lo AND a.hi. For interval joins,
+ * e.g. a.ts BETWEEN b.start AND b.end, keys are interval starts and the lower bound
+ * is derived from the maximum interval length, while the condition on interval ends
+ * is still checked by the join loop.
+ *
+ * For equi-joins on none-encoded strings, keys are hashes of strings. Strings don't
+ * need to be dictionary-encoded or translated, and the join condition filters out
+ * matches of different strings with equal hashes.
+ */
+class SortedJoinTable : public HashJoin {
+ public:
+  static std::shared_ptr<SortedJoinTable> getInstance(
+      const std::shared_ptr<const hdk::ir::BinOper> qual_bin_oper,
+      const std::vector<InputTableInfo>& query_infos,
+      const Data_Namespace::MemoryLevel memory_level,
+      const int device_count,
+      DataProvider* data_provider,
+      ColumnCacheMap& column_cache,
+      Executor* executor);
+
+  //! Make a range join table from the join conditions of a single nesting level.
+  //! Conditions exactly implemented by the table are returned in consumed_quals.
+  static std::shared_ptr<SortedJoinTable> getRangeInstance(
+      const std::list<hdk::ir::ExprPtr>& quals,
+      const std::vector<InputTableInfo>& query_infos,
+      const Data_Namespace::MemoryLevel memory_level,
+      const int device_count,
+      DataProvider* data_provider,
+      ColumnCacheMap& column_cache,
+      Executor* executor,
+      std::vector<std::shared_ptr<const hdk::ir::BinOper>>& consumed_quals);
+
+  std::string toString(const ExecutorDeviceType device_type,
+                       const int device_id = 0,
+                       bool raw = false) const override;
+
+  DecodedJoinHashBufferSet toSet(const ExecutorDeviceType device_type,
+                                 const int device_id) const override;
+
+  llvm::Value* codegenSlot(const CompilationOptions&, const size_t) override;
+
+  HashJoinMatchingSet codegenMatchingSet(const CompilationOptions&,
+                                         const size_t) override;
+
+  int getInnerDbId() const noexcept override { return inner_col_->dbId(); }
+
+  int getInnerTableId() const noexcept override { return inner_col_->tableId(); }
+
+  int getInnerTableRteIdx() const noexcept override { return inner_col_->rteIdx(); }
+
+  HashType getHashType() const noexcept override { return hash_type_; }
+
+  Data_Namespace::MemoryLevel getMemoryLevel() const noexcept override {
+    return Data_Namespace::CPU_LEVEL;
+  }
+
+  int getDeviceCount() const noexcept override { return device_count_; }
+
+  size_t offsetBufferOff() const noexcept override { return 0; }
+
+  size_t countBufferOff() const noexcept override { return 0; }
+
+  size_t payloadBufferOff() const noexcept override { return 0; }
+
+  std::string getHashJoinType() const final { return "Sorted"; }
+
+  bool isBitwiseEq() const override { return false; }
+
+  bool matchesKeyHashes() const override { return inner_col_->type()->isString(); }
+
+ private:
+  // Bound of the inner key computed for an outer row.
+  struct KeyBound {
+    hdk::ir::ExprPtr outer_expr;
+    bool inclusive;
+  };
+
+  SortedJoinTable(const hdk::ir::ColumnVar* inner_col,
+                  std::optional<KeyBound> lower_bound,
+                  std::optional<KeyBound> upper_bound,
+                  const hdk::ir::ColumnVar* interval_end_col,
+                  const HashType hash_type,
+                  const std::vector<InputTableInfo>& query_infos,
+                  const int device_count,
+                  DataProvider* data_provider,
+                  ColumnCacheMap& column_cache,
+                  Executor* executor)
+      : HashJoin(data_provider)
+      , inner_col_(
+            std::dynamic_pointer_cast<const hdk::ir::ColumnVar>(inner_col->shared()))
+      , lower_bound_(std::move(lower_bound))
+      , upper_bound_(std::move(upper_bound))
+      , interval_end_col_(interval_end_col
+                              ? std::dynamic_pointer_cast<const hdk::ir::ColumnVar>(
+                                    interval_end_col->shared())
+                              : nullptr)
+      , hash_type_(hash_type)
+      , query_infos_(query_infos)
+      , device_count_(device_count)
+      , column_cache_(column_cache)
+      , executor_(executor) {
+    hash_tables_for_device_.resize(device_count_);
+  }
+
+  static std::shared_ptr<SortedJoinTable> build(
+      std::shared_ptr<SortedJoinTable> join_hash_table);
+
+  void reify();
+
+  void fetchStringKeys(const TableFragmentsInfo& query_info,
+                       std::vector<int64_t>& keys,
+                       std::vector<int32_t>& row_ids);
+
+  // Generate the key for an outer expression. Conditions of the key being not null
+  // are added to not_null_lvs.
+  llvm::Value* codegenKey(const hdk::ir::Expr* outer_expr,
+                          const CompilationOptions& co,
+                          std::vector<llvm::Value*>& not_null_lvs);
+
+  size_t getComponentBufferSize() const noexcept override { return 0; }
+
+  std::shared_ptr<const hdk::ir::ColumnVar> inner_col_;
+  std::optional<KeyBound> lower_bound_;
+  std::optional<KeyBound> upper_bound_;
+  // Interval end column for interval joins. Keys are interval starts in this case.
+  std::shared_ptr<const hdk::ir::ColumnVar> interval_end_col_;
+  // Maximum interval length, used to compute the lower bound for interval joins.
+  int64_t max_interval_length_{0};
+  const HashType hash_type_;
+  const std::vector<InputTableInfo>& query_infos_;
+  const int device_count_;
+  ColumnCacheMap& column_cache_;
+  Executor* executor_;
+};
@@ -16,26 +16,149 @@
 #include "L0Mgr/L0Exception.h"
 #include "L0Mgr/Utils.h"
 #include "Logger/Logger.h"  // CHECK
+#include "QueryEngine/MurmurHash.h"
 
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <iterator>
+#include <sstream>
+
+L0BinaryCache::L0BinaryCache(std::string cache_dir) : cache_dir_(std::move(cache_dir)) {
+  if (cache_dir_.empty()) {
+    return;
+  }
+  boost::system::error_code ec;
+  boost::filesystem::create_directories(cache_dir_, ec);
+  if (ec) {
+    throw std::runtime_error("Cannot create L0 binary cache directory " + cache_dir_ +
+                             ": " + ec.message());
+  }
+  LOG(INFO) << "Using L0 binary cache in " << cache_dir_;
+}
+
+std::string L0BinaryCache::key(const std::string& spv,
+                               const std::string& device_tag) const {
+  std::string buf = std::to_string(device_tag.size()) + ":" + device_tag + spv;
+  auto h1 = MurmurHash64A(buf.data(), static_cast<int>(buf.size()), 0x9E3779B97F4A7C15);
+  auto h2 = MurmurHash64A(buf.data(), static_cast<int>(buf.size()), 0xC2B2AE3D27D4EB4F);
+  std::stringstream ss;
+  ss << std::hex << std::setfill('0') << std::setw(16) << h1 << std::setw(16) << h2;
+  return ss.str();
+}
+
+std::string L0BinaryCache::binaryPath(const std::string& key) const {
+  return (boost::filesystem::path(cache_dir_) / ("l0_" + key + ".bin")).string();
+}
 
-L0BinResult spv_to_bin(const std::string& spv,
-                       const std::string& name,
-                       const unsigned block_size,
-                       const l0::L0Manager* mgr) {
+std::optional<std::vector<uint8_t>> L0BinaryCache::get(const std::string& key) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = binaries_.find(key);
+    if (it != binaries_.end()) {
+      ++hit_count_;
+      return it->second;
+    }
+  }
+  if (!cache_dir_.empty()) {
+    std::ifstream in(binaryPath(key), std::ios::binary);
+    if (in) {
+      std::vector<uint8_t> binary((std::istreambuf_iterator<char>(in)),
+                                  std::istreambuf_iterator<char>());
+      if (!binary.empty()) {
+        ++hit_count_;
+        VLOG(1) << "Loaded L0 binary from disk cache: " << binaryPath(key);
+        std::lock_guard<std::mutex> lock(mutex_);
+        binaries_.emplace(key, binary);
+        return binary;
+      }
+    }
+  }
+  ++miss_count_;
+  return std::nullopt;
+}
+
+void L0BinaryCache::put(const std::string& key, std::vector<uint8_t> binary) {
+  if (binary.empty()) {
+    return;
+  }
+  if (!cache_dir_.empty()) {
+    // Write into a temporary file and rename it, so concurrent readers never see
+    // a partially written binary.
+    auto path = binaryPath(key);
+    auto tmp_path =
+        path + "." + boost::filesystem::unique_path("%%%%-%%%%-%%%%").string() + ".tmp";
+    std::ofstream out(tmp_path, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(binary.data()), binary.size());
+    out.close();
+    boost::system::error_code ec;
+    if (out) {
+      boost::filesystem::rename(tmp_path, path, ec);
+    }
+    if (!out || ec) {
+      LOG(WARNING) << "Cannot store L0 binary cache entry " << path;
+      boost::filesystem::remove(tmp_path, ec);
+    }
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  binaries_.emplace(key, std::move(binary));
+}
+
+std::vector<L0BinResult> spv_to_bin(const std::string& spv,
+                                    const std::string& name,
+                                    const unsigned block_size,
+                                    const l0::L0Manager* mgr,
+                                    L0BinaryCache* binary_cache) {
   CHECK(!spv.empty());
   CHECK(mgr);
 
   auto driver = mgr->drivers()[0];
-  auto device = driver->devices()[0];
-
   CHECK(driver);
-  CHECK(device);
+  CHECK(!driver->devices().empty());
+
+  std::vector<L0BinResult> res;
+  // Native binaries built for this call by device tag.
+  std::unordered_map<std::string, std::vector<uint8_t>> built_binaries;
+  for (auto& device : driver->devices()) {
+    CHECK(device);
+    auto tag = device->native_binary_tag();
+
+    std::shared_ptr<l0::L0Module> module;
+    auto built_it = built_binaries.find(tag);
+    if (built_it != built_binaries.end()) {
+      module = device->create_native_module(built_it->second.data(),
+                                            built_it->second.size());
+    }
+
+    std::string cache_key;
+    if (!module && binary_cache) {
+      cache_key = binary_cache->key(spv, tag);
+      if (auto binary = binary_cache->get(cache_key)) {
+        try {
+          module = device->create_native_module(binary->data(), binary->size());
+        } catch (l0::L0Exception& e) {
+          LOG(WARNING) << "Cannot load cached L0 binary, rebuilding from SPIR-V: "
+                       << e.what();
+        }
+      }
+    }
+    if (!module) {
+      module = device->create_module((uint8_t*)spv.data(), spv.size(), true);
+      if (binary_cache) {
+        binary_cache->put(cache_key, module->native_binary());
+      }
+    }
+    if (!built_binaries.count(tag) && driver->devices().size() > 1) {
+      built_binaries.emplace(tag, module->native_binary());
+    }
 
-  auto module = device->create_module((uint8_t*)spv.data(), spv.size(), true);
-  auto kernel = module->create_kernel(name.c_str(), block_size, 1, 1);
+    auto kernel = module->create_kernel(name.c_str(), block_size, 1, 1);
+    res.push_back({device, module, kernel});
+  }
 
-  return {device, module, kernel};
+  return res;
 }
 
 L0DeviceCompilationContext::L0DeviceCompilationContext(
@@ -17,16 +17,52 @@
 #include "Logger/Logger.h"  // CHECK
 #include "QueryEngine/CompilationContext.h"
 
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+/**
+ * Cache of device binaries built by the driver from SPIR-V. Building a module from
+ * SPIR-V runs the whole device compiler, while creating it from a native binary
+ * only loads the code. Binaries are keyed by a hash of the SPIR-V and the device
+ * and driver tag. They are kept in memory and, if a directory is given, on disk.
+ */
+class L0BinaryCache {
+ public:
+  L0BinaryCache(std::string cache_dir = "");
+
+  std::string key(const std::string& spv, const std::string& device_tag) const;
+
+  std::optional<std::vector<uint8_t>> get(const std::string& key);
+  void put(const std::string& key, std::vector<uint8_t> binary);
+
+  size_t hitCount() const { return hit_count_; }
+  size_t missCount() const { return miss_count_; }
+
+ private:
+  std::string binaryPath(const std::string& key) const;
+
+  const std::string cache_dir_;
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::vector<uint8_t>> binaries_;
+  std::atomic<size_t> hit_count_{0};
+  std::atomic<size_t> miss_count_{0};
+};
+
 struct L0BinResult {
   std::shared_ptr<l0::L0Device> device;
   std::shared_ptr<l0::L0Module> module;
   std::shared_ptr<l0::L0Kernel> kernel;
 };
 
-L0BinResult spv_to_bin(const std::string& spv,
-                       const std::string& name,
-                       const unsigned block_size,
-                       const l0::L0Manager* mgr);
+// Builds the kernel for every device of the manager, in order of device ids. Devices
+// of the same kind (e.g. tiles of one GPU) reuse the native binary of the first one.
+std::vector<L0BinResult> spv_to_bin(const std::string& spv,
+                                    const std::string& name,
+                                    const unsigned block_size,
+                                    const l0::L0Manager* mgr,
+                                    L0BinaryCache* binary_cache = nullptr);
 
 class L0DeviceCompilationContext {
  public:
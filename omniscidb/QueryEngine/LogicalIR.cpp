@@ -21,6 +21,9 @@
 
 #include <llvm/IR/MDBuilder.h>
 
+#include <algorithm>
+#include <limits>
+
 namespace {
 
 bool contains_unsafe_division(const hdk::ir::Expr* expr) {
@@ -123,6 +126,11 @@ Weight get_weight(const hdk::ir::Expr* expr, int depth = 0) {
     // heavy weight expr, start valid weight propagation
     return Weight(2000);
   }
+  auto function_oper = dynamic_cast<const hdk::ir::FunctionOper*>(expr);
+  if (function_oper) {
+    // heavy weight expr, start valid weight propagation
+    return Weight(500);
+  }
   auto u_oper = dynamic_cast<const hdk::ir::UOper*>(expr);
   if (u_oper) {
     auto weight = get_weight(u_oper->operand(), depth + 1);
@@ -149,12 +157,80 @@ Weight get_weight(const hdk::ir::Expr* expr, int depth = 0) {
   return Weight();
 }
 
+// Rough fraction of rows passing a qual when no likelihood is given.
+float get_selectivity(const hdk::ir::Expr* expr) {
+  auto likelihood = get_likelihood(expr);
+  if (!likelihood.isInvalid()) {
+    return likelihood.getValue();
+  }
+  if (expr->is<hdk::ir::LikeExpr>() || expr->is<hdk::ir::RegexpExpr>()) {
+    return 0.25;
+  }
+  if (auto in_values = expr->as<hdk::ir::InValues>()) {
+    return std::min(1.0f, 0.1f * in_values->valueList().size());
+  }
+  if (auto u_oper = expr->as<hdk::ir::UOper>()) {
+    if (u_oper->isNot()) {
+      return 1.0f - get_selectivity(u_oper->operand());
+    }
+    if (u_oper->isIsNull()) {
+      return 0.05;
+    }
+    return 0.5;
+  }
+  if (auto bin_oper = expr->as<hdk::ir::BinOper>()) {
+    if (bin_oper->isAnd()) {
+      return get_selectivity(bin_oper->leftOperand()) *
+             get_selectivity(bin_oper->rightOperand());
+    }
+    if (bin_oper->isOr()) {
+      return 1.0f - (1.0f - get_selectivity(bin_oper->leftOperand())) *
+                        (1.0f - get_selectivity(bin_oper->rightOperand()));
+    }
+    if (bin_oper->isEq()) {
+      return 0.1;
+    }
+    if (bin_oper->isNe()) {
+      return 0.9;
+    }
+    if (bin_oper->isComparison()) {
+      return 0.33;
+    }
+  }
+  return 0.5;
+}
+
+// Quals are evaluated in the ascending order of their cost per filtered out row, so
+// cheap selective quals short-circuit expensive ones. Quals with a possible division
+// by zero keep their relative order at the end to stay guarded by the others.
+void reorder_deferred_quals(std::vector<const hdk::ir::Expr*>& quals) {
+  auto rank = [](const hdk::ir::Expr* expr) {
+    auto weight = get_weight(expr);
+    float cost = weight.isInvalid() ? 1.0f : std::max<float>(weight.getValue(), 1.0f);
+    return cost / std::max(1.0f - get_selectivity(expr), 0.001f);
+  };
+  std::vector<std::pair<float, const hdk::ir::Expr*>> ranked_quals;
+  for (auto expr : quals) {
+    ranked_quals.emplace_back(
+        contains_unsafe_division(expr) ? std::numeric_limits<float>::max() : rank(expr),
+        expr);
+  }
+  std::stable_sort(
+      ranked_quals.begin(), ranked_quals.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first < rhs.first;
+      });
+  for (size_t i = 0; i < quals.size(); ++i) {
+    quals[i] = ranked_quals[i].second;
+  }
+}
+
 }  // namespace
 
 bool CodeGenerator::prioritizeQuals(const RelAlgExecutionUnit& ra_exe_unit,
                                     std::vector<const hdk::ir::Expr*>& primary_quals,
                                     std::vector<const hdk::ir::Expr*>& deferred_quals,
-                                    const PlanState::HoistedFiltersSet& hoisted_quals) {
+                                    const PlanState::HoistedFiltersSet& hoisted_quals,
+                                    const bool reorder_quals) {
   for (auto expr : ra_exe_unit.simple_quals) {
     if (hoisted_quals.find(expr) != hoisted_quals.end()) {
       continue;
@@ -187,6 +263,10 @@ bool CodeGenerator::prioritizeQuals(const RelAlgExecutionUnit& ra_exe_unit,
     primary_quals.push_back(expr.get());
   }
 
+  if (reorder_quals) {
+    reorder_deferred_quals(deferred_quals);
+  }
+
   return short_circuit;
 }
 
@@ -299,6 +379,12 @@ llvm::Value* CodeGenerator::codegenLogical(const hdk::ir::BinOper* bin_oper,
   const auto optype = bin_oper->opType();
   CHECK(bin_oper->isLogic());
 
+  if (optype == hdk::ir::OpType::kOr) {
+    if (llvm::Value* regexp_lv = codegenRegexpDisjunction(bin_oper, co)) {
+      return regexp_lv;
+    }
+  }
+
   if (llvm::Value* short_circuit = codegenLogicalShortCircuit(bin_oper, co)) {
     return short_circuit;
   }
@@ -22,6 +22,7 @@
 #include "QueryEngine/OutputBufferInitialization.h"
 #include "QueryEngine/UsedColumnsCollector.h"
 #include "ResultSet/HyperLogLog.h"
+#include "Shared/thread_count.h"
 
 #include <boost/algorithm/cxx11/any_of.hpp>
 
@@ -80,6 +81,44 @@ bool cardinality_estimate_less_than_column_range(const int64_t cardinality_estim
   }
 }
 
+/**
+ * Compares costs of perfect and baseline hash group by when statistics provide the
+ * number of distinct values of the group by columns. Every kernel initializes and
+ * reduces a whole buffer, which is sized by the column range for perfect hash and by
+ * the number of groups for baseline hash, while aggregating an input row is more
+ * expensive with baseline hash. A huge range with few groups makes baseline hash
+ * cheaper.
+ */
+bool baseline_hash_is_cheaper(const RelAlgExecutionUnit& ra_exe_unit,
+                              const std::vector<InputTableInfo>& query_infos,
+                              const int64_t perfect_hash_entries,
+                              const Config& config) {
+  if (!config.exec.group_by.enable_cost_based_hash_layout || query_infos.empty() ||
+      perfect_hash_entries <= 0) {
+    return false;
+  }
+  const auto ndv = get_ndv_estimation_from_column_stats(
+      ra_exe_unit, query_infos, static_cast<size_t>(perfect_hash_entries));
+  if (!ndv) {
+    return false;
+  }
+  const auto& outer_info = query_infos.front().info;
+  const double rows = outer_info.getNumTuplesUpperBound();
+  const double buffers = std::max<size_t>(
+      std::min<size_t>(outer_info.fragments.size(), cpu_threads()), 1);
+  // Baseline hash tables are kept at most half full.
+  const double baseline_entries = 2.0 * *ndv;
+  const double perfect_cost = buffers * perfect_hash_entries + rows;
+  const double baseline_cost =
+      buffers * baseline_entries + rows * config.exec.group_by.baseline_hash_row_cost;
+  if (baseline_cost < perfect_cost) {
+    VLOG(1) << "Use baseline hash for " << *ndv << " estimated groups instead of "
+            << perfect_hash_entries << " perfect hash entries.";
+    return true;
+  }
+  return false;
+}
+
 bool expr_is_rowid(const hdk::ir::Expr* expr) {
   const auto col = dynamic_cast<const hdk::ir::ColumnVar*>(expr);
   if (!col) {
@@ -123,7 +162,9 @@ ColRangeInfo get_col_range_info(const RelAlgExecutionUnit& ra_exe_unit,
         }
       }
       // For zero or high cardinalities, use baseline layout.
-      if (!cardinality || cardinality > baseline_threshold) {
+      if (!cardinality || cardinality > baseline_threshold ||
+          baseline_hash_is_cheaper(
+              ra_exe_unit, query_infos, int64_t(cardinality), config)) {
         return {QueryDescriptionType::GroupByBaselineHash,
                 0,
                 int64_t(cardinality),
@@ -220,6 +261,16 @@ ColRangeInfo get_col_range_info(const RelAlgExecutionUnit& ra_exe_unit,
             0,
             col_range_info.has_nulls};
   }
+  if (col_range_info.hash_type_ == QueryDescriptionType::GroupByPerfectHash &&
+      !col_range_info.bucket && !expr_is_rowid(ra_exe_unit.groupby_exprs.front().get()) &&
+      baseline_hash_is_cheaper(
+          ra_exe_unit, query_infos, col_range_info.getBucketedCardinality(), config)) {
+    return {QueryDescriptionType::GroupByBaselineHash,
+            col_range_info.min,
+            col_range_info.max,
+            0,
+            col_range_info.has_nulls};
+  }
   return col_range_info;
 }
 
@@ -476,6 +527,27 @@ CountDistinctDescriptors init_count_distinct_descriptors(
           !arg_type->isArray()) {
         count_distinct_impl_type = CountDistinctImplType::Bitmap;
       }
+      // Use a compressed bitmap for exact count of integer values when a dense bitmap
+      // is too big. Float values are counted by their bit patterns which are too
+      // scattered for it.
+      const auto& group_by_config = executor->getConfig().exec.group_by;
+      const bool big_bitmap =
+          bitmap_sz_bits > group_by_config.roaring_count_distinct_bitmap_bits_threshold;
+      if (agg_info.agg_kind == hdk::ir::AggType::kCount &&
+          group_by_config.enable_roaring_count_distinct && !arg_type->isBuffer() &&
+          !arg_type->isFloatingPoint() &&
+          (count_distinct_impl_type == CountDistinctImplType::HashSet || big_bitmap)) {
+        count_distinct_impl_type = CountDistinctImplType::RoaringBitmap;
+        bitmap_sz_bits = 0;
+      }
+      // Most groups of a group by query see a few distinct values only, sparse
+      // registers save memory for them. They are not supported on GPU.
+      if (agg_info.agg_kind == hdk::ir::AggType::kApproxCountDistinct &&
+          group_by_config.enable_sparse_hll && device_type == ExecutorDeviceType::CPU &&
+          (group_by_hash_type == QueryDescriptionType::GroupByPerfectHash ||
+           group_by_hash_type == QueryDescriptionType::GroupByBaselineHash)) {
+        count_distinct_impl_type = CountDistinctImplType::SparseHyperLogLog;
+      }
 
       if (executor->getConfig().exec.watchdog.enable && !(arg_range_info.isEmpty()) &&
           count_distinct_impl_type == CountDistinctImplType::HashSet) {
@@ -537,10 +609,32 @@ bool is_int_and_no_bigger_than(const hdk::ir::Type* type, const size_t byte_widt
   return get_bit_width(type) <= (byte_width * 8);
 }
 
+// MIN and MAX results stay within the range of their argument, so a 4-byte slot
+// can't overflow when the argument is a small integer with a range known to fit.
+bool is_compactable_min_max(const hdk::ir::AggExpr* agg,
+                            const std::vector<InputTableInfo>& query_infos,
+                            const Executor* executor) {
+  if (!executor->getConfig().exec.group_by.enable_range_based_slot_compaction) {
+    return false;
+  }
+  if (agg->isDistinct() || (agg->aggType() != hdk::ir::AggType::kMin &&
+                            agg->aggType() != hdk::ir::AggType::kMax)) {
+    return false;
+  }
+  if (!is_int_and_no_bigger_than(agg->arg()->type(), 4)) {
+    return false;
+  }
+  const auto arg_range = getExpressionRange(agg->arg(), query_infos, executor);
+  return arg_range.getType() == ExpressionRangeType::Integer &&
+         arg_range.getIntMin() > std::numeric_limits<int32_t>::min() &&
+         arg_range.getIntMax() <= std::numeric_limits<int32_t>::max();
+}
+
 int8_t pick_target_compact_width(const RelAlgExecutionUnit& ra_exe_unit,
                                  const std::vector<InputTableInfo>& query_infos,
                                  const int8_t crt_min_byte_width,
-                                 bool bigint_count) {
+                                 const Executor* executor) {
+  const bool bigint_count = executor->getConfig().exec.group_by.bigint_count;
   if (bigint_count) {
     return sizeof(int64_t);
   }
@@ -576,6 +670,12 @@ int8_t pick_target_compact_width(const RelAlgExecutionUnit& ra_exe_unit,
       auto type = target->type();
       const auto agg = target->as<hdk::ir::AggExpr>();
       if (agg && agg->arg()) {
+        if (is_compactable_min_max(agg, query_infos, executor)) {
+          if (col_it != end) {
+            ++col_it;
+          }
+          continue;
+        }
         compact_width = crt_min_byte_width;
         break;
       }
@@ -671,7 +771,7 @@ int8_t pick_baseline_key_width(const RelAlgExecutionUnit& ra_exe_unit,
 
 bool use_streaming_top_n(const RelAlgExecutionUnit& ra_exe_unit,
                          const bool output_columnar,
-                         bool streaming_topn_max) {
+                         const size_t streaming_topn_max) {
   for (const auto target_expr : ra_exe_unit.target_exprs) {
     if (dynamic_cast<const hdk::ir::AggExpr*>(target_expr)) {
       return false;
@@ -795,10 +895,7 @@ std::unique_ptr<QueryMemoryDescriptor> build_query_memory_descriptor(
       ra_exe_unit.target_exprs, {}, executor->getConfig().exec.group_by.bigint_count);
 
   const auto min_slot_size =
-      pick_target_compact_width(ra_exe_unit,
-                                query_infos,
-                                crt_min_byte_width,
-                                executor->getConfig().exec.group_by.bigint_count);
+      pick_target_compact_width(ra_exe_unit, query_infos, crt_min_byte_width, executor);
 
   col_slot_context.setAllSlotsPaddedSize(min_slot_size);
   col_slot_context.validate();
@@ -920,10 +1017,14 @@ std::unique_ptr<QueryMemoryDescriptor> build_query_memory_descriptor(
           device_type == ExecutorDeviceType::CPU ||
           (executor->getDataMgr() && executor->getDataMgr()->getGpuMgr() &&
            executor->getDataMgr()->getGpuMgr()->getPlatform() != GpuMgrPlatform::L0);
+      // GPU kernels keep a heap per thread, while a CPU kernel keeps a single heap,
+      // so much larger heaps fit into memory on CPU.
+      const auto streaming_topn_max =
+          device_type == ExecutorDeviceType::CPU
+              ? executor->getConfig().exec.cpu_streaming_topn_max
+              : executor->getConfig().exec.streaming_topn_max;
       if (streaming_top_n_hint &&
-          use_streaming_top_n(ra_exe_unit,
-                              output_columnar,
-                              executor->getConfig().exec.streaming_topn_max) &&
+          use_streaming_top_n(ra_exe_unit, output_columnar, streaming_topn_max) &&
           streaming_top_n_supported_by_platform) {
         streaming_top_n = true;
         entry_count = ra_exe_unit.sort_info.offset + ra_exe_unit.sort_info.limit;
@@ -1167,21 +1268,11 @@ size_t MemoryLayoutBuilder::gpuSharedMemorySize(
     return 0;
   }
 
-  const auto gpu_blocksize = executor->blockSize();
   const auto num_blocks_per_mp = executor->numBlocksPerMP();
 
-  /**
-   * To simplify the implementation for practical purposes, we
-   * initially provide shared memory support for cases where there are at most as many
-   * entries in the output buffer as there are threads within each GPU device. In
-   * order to relax this assumption later, we need to add a for loop in generated
-   * codes such that each thread loops over multiple entries.
-   * TODO: relax this if necessary
-   */
-  if (gpu_blocksize < query_mem_desc->getEntryCount()) {
-    return 0;
-  }
-
+  // Shared memory buffers are initialized and reduced into global memory by threads
+  // looping over entries with the block size stride, so the number of entries is only
+  // limited by the size of the shared memory.
   CHECK(query_mem_desc);
   if (query_mem_desc->didOutputColumnar()) {
     return 0;
@@ -31,6 +31,7 @@ static_assert(false, "LLVM Version >= 12 is required.");
 #include <llvm/IR/IntrinsicInst.h>
 #include <llvm/IR/Intrinsics.h>
 #include <llvm/IR/LegacyPassManager.h>
+#include <llvm/IR/MDBuilder.h>
 #include <llvm/IR/Verifier.h>
 #include <llvm/IRReader/IRReader.h>
 #include <llvm/Linker/Linker.h>
@@ -54,6 +55,7 @@ static_assert(false, "LLVM Version >= 12 is required.");
 #include <llvm/Transforms/Utils/Cloning.h>
 
 #include "CudaMgr/CudaMgr.h"
+#include "IR/ExprCollector.h"
 #include "QueryEngine/CodeGenerator.h"
 #include "QueryEngine/Compiler/Backend.h"
 #include "QueryEngine/Compiler/HelperFunctions.h"
@@ -63,9 +65,11 @@ static_assert(false, "LLVM Version >= 12 is required.");
 #include "QueryEngine/MemoryLayoutBuilder.h"
 #include "QueryEngine/NvidiaKernel.h"
 #include "QueryEngine/OutputBufferInitialization.h"
+#include "QueryEngine/PersistentCodeCache.h"
 #include "QueryEngine/QueryTemplateGenerator.h"
 #include "Shared/InlineNullValues.h"
 #include "Shared/MathUtils.h"
+#include "Shared/Metrics.h"
 #include "StreamingTopN.h"
 
 #include <boost/filesystem.hpp>
@@ -194,6 +198,14 @@ scan_function_calls(llvm::Module& llvm_module,
   return std::make_tuple(defined, undefined);
 }
 
+// Copy of query IR recompiled in background with full optimizations.
+struct HotCodeRecompilation {
+  std::unique_ptr<llvm::Module> module;
+  llvm::Function* query_func;
+  llvm::Function* multifrag_query_func;
+  std::unordered_set<llvm::Function*> live_funcs;
+};
+
 CodeCacheKey get_code_cache_key(llvm::Function* query_func, CgenState* cgen_state) {
   CodeCacheKey key{serialize_llvm_object(query_func),
                    serialize_llvm_object(cgen_state->row_func_)};
@@ -217,17 +229,94 @@ std::shared_ptr<CompilationContext> Executor::optimizeAndCodegenCPU(
   auto key = get_code_cache_key(query_func, cgen_state_.get());
   auto cached_code = cpu_code_accessor->get_value(key);
   if (cached_code) {
+    auto cached_cpu_code = std::dynamic_pointer_cast<CpuCompilationContext>(cached_code);
+    CHECK(cached_cpu_code);
+    // Code compiled at the fast tier is recompiled with the full optimization pipeline
+    // in background once it is hot. The cached code is used until the optimized code
+    // replaces it in the cache.
+    if (cached_cpu_code->optLevel() == ExecutorOptLevel::Fast &&
+        cached_cpu_code->registerUse() >=
+            config_->exec.codegen.tiered_compilation_hot_threshold &&
+        cached_cpu_code->markRecompilation()) {
+      auto co_cpu = co;
+      co_cpu.vectorize_loops = config_->exec.codegen.enable_loop_vectorization;
+      co_cpu.register_intel_jit_listener =
+          co.register_intel_jit_listener || config_->exec.codegen.enable_jit_profiling;
+      recompileHotCodeAsync(
+          key, query_func, multifrag_query_func, backend, live_funcs, co_cpu);
+    }
     return cached_code;
   }
 
+  auto co_cpu = co;
+  if (config_->exec.codegen.enable_tiered_compilation &&
+      co.opt_level == ExecutorOptLevel::Default) {
+    co_cpu.opt_level = ExecutorOptLevel::Fast;
+  }
+  co_cpu.vectorize_loops = config_->exec.codegen.enable_loop_vectorization &&
+                           co_cpu.opt_level == ExecutorOptLevel::Default;
+  co_cpu.register_intel_jit_listener =
+      co.register_intel_jit_listener || config_->exec.codegen.enable_jit_profiling;
+
+  // Fast tier code is short-living and is not worth persisting. Code with expression
+  // counters refers to counters of this process.
+  if (persistent_code_cache && co_cpu.opt_level != ExecutorOptLevel::Fast &&
+      !config_->exec.codegen.enable_expression_counters) {
+    // Module identifier is used by the persistent cache to locate object code.
+    query_func->getParent()->setModuleIdentifier(persistent_code_cache->moduleId(key));
+  }
+
   std::shared_ptr<CpuCompilationContext> cpu_compilation_context =
       std::dynamic_pointer_cast<CpuCompilationContext>(
-          backend->generateNativeCode(query_func, nullptr, live_funcs, co));
+          backend->generateNativeCode(query_func, nullptr, live_funcs, co_cpu));
   cpu_compilation_context->setFunctionPointer(multifrag_query_func);
+  cpu_compilation_context->setOptLevel(co_cpu.opt_level);
   cpu_code_accessor->put(key, cpu_compilation_context);
   return std::dynamic_pointer_cast<CompilationContext>(cpu_compilation_context);
 }
 
+void Executor::recompileHotCodeAsync(
+    const CodeCacheKey& key,
+    llvm::Function* query_func,
+    llvm::Function* multifrag_query_func,
+    std::shared_ptr<compiler::Backend> backend,
+    const std::unordered_set<llvm::Function*>& live_funcs,
+    const CompilationOptions& co) {
+  // IR of the query goes away with its CgenState, so a copy of the module is compiled.
+  // The caller holds the compilation mutex, which protects the shared LLVM context.
+  llvm::ValueToValueMapTy vmap;
+  auto recompilation = std::make_shared<HotCodeRecompilation>();
+  recompilation->module = llvm::CloneModule(*query_func->getParent(), vmap);
+  recompilation->query_func = llvm::cast<llvm::Function>(vmap[query_func]);
+  recompilation->multifrag_query_func =
+      llvm::cast<llvm::Function>(vmap[multifrag_query_func]);
+  for (auto live_func : live_funcs) {
+    recompilation->live_funcs.insert(llvm::cast<llvm::Function>(vmap[live_func]));
+  }
+
+  scheduleAsyncCompilation(key, [this, key, recompilation, backend, co]() {
+    std::lock_guard<std::mutex> compilation_lock(compilation_mutex_);
+    // The module has to be destroyed under the lock if compilation fails.
+    auto module = std::move(recompilation->module);
+    if (persistent_code_cache && !config_->exec.codegen.enable_expression_counters) {
+      module->setModuleIdentifier(persistent_code_cache->moduleId(key));
+    }
+    // The backend takes ownership of the module.
+    module.release();
+    std::shared_ptr<CpuCompilationContext> cpu_compilation_context =
+        std::dynamic_pointer_cast<CpuCompilationContext>(backend->generateNativeCode(
+            recompilation->query_func, nullptr, recompilation->live_funcs, co));
+    cpu_compilation_context->setFunctionPointer(recompilation->multifrag_query_func);
+    cpu_compilation_context->setOptLevel(co.opt_level);
+    cpu_code_accessor->replace(key, cpu_compilation_context);
+    static auto& recompilations_metric = metrics::Registry::get().counter(
+        "hdk_hot_code_recompilations_total",
+        "Kernels compiled at the fast tier and recompiled with full optimizations.");
+    recompilations_metric.inc();
+    VLOG(1) << "Recompiled hot CPU code with full optimizations.";
+  });
+}
+
 void CodeGenerator::link_udf_module(const std::unique_ptr<llvm::Module>& udf_module,
                                     llvm::Module& llvm_module,
                                     CgenState* cgen_state,
@@ -391,6 +480,7 @@ std::shared_ptr<CompilationContext> Executor::optimizeAndCodegenGPU(
 
   std::shared_ptr<CompilationContext> compilation_context;
 
+  auto compilation_clock_begin = timer_start();
   try {
     compilation_context =
         backend->generateNativeCode(query_func, multifrag_query_func, live_funcs, co);
@@ -402,7 +492,7 @@ std::shared_ptr<CompilationContext> Executor::optimizeAndCodegenGPU(
       LOG(WARNING) << "Failed to allocate GPU memory for generated code. Evicting "
                    << config_->cache.gpu_fraction_code_cache_to_evict * 100.
                    << "% of GPU code cache and re-trying.";
-      Executor::gpu_code_accessor->evictFractionEntries(
+      Executor::gpu_code_accessor->evictFractionBytes(
           config_->cache.gpu_fraction_code_cache_to_evict);
 
       compilation_context =
@@ -412,6 +502,7 @@ std::shared_ptr<CompilationContext> Executor::optimizeAndCodegenGPU(
       throw;
     }
   }
+  compilation_context->setCompilationTimeMs(timer_stop(compilation_clock_begin));
   Executor::gpu_code_accessor->put(key, compilation_context);
 
   return compilation_context;
@@ -429,6 +520,7 @@ bool CodeGenerator::alwaysCloneRuntimeFunction(const llvm::Function* func) {
          func->getName() == "fixed_width_int_decode" ||
          func->getName() == "fixed_width_unsigned_decode" ||
          func->getName() == "diff_fixed_width_int_decode" ||
+         func->getName() == "frame_of_reference_int_decode" ||
          func->getName() == "fixed_width_double_decode" ||
          func->getName() == "fixed_width_float_decode" ||
          func->getName() == "fixed_width_small_date_decode" ||
@@ -794,6 +886,50 @@ void Executor::addUdfIrToModule(const std::string& udf_ir_filename,
       udf_ir_filename;
 }
 
+void Executor::registerRuntimeUdfModules(const std::vector<std::string>& cpu_irs,
+                                         const std::vector<std::string>& gpu_irs) {
+  auto set_source = [](ExtModuleKinds module_kind,
+                       const std::vector<std::string>& irs,
+                       bool is_gpu) {
+    if (irs.empty()) {
+      Executor::extension_module_sources.erase(module_kind);
+      return;
+    }
+    if (irs.size() == 1) {
+      Executor::extension_module_sources[module_kind] = irs.front();
+      return;
+    }
+    // Sources are kept as a string, so link them here and print the result back.
+    llvm::LLVMContext ctx;
+    std::unique_ptr<llvm::Module> linked_module;
+    for (const auto& ir : irs) {
+      auto llvm_module = read_llvm_module_from_ir_string(ir, ctx, is_gpu);
+      if (!llvm_module) {
+        Executor::extension_module_sources.erase(module_kind);
+        return;
+      }
+      if (!linked_module) {
+        linked_module = std::move(llvm_module);
+      } else if (llvm::Linker::linkModules(*linked_module, std::move(llvm_module))) {
+        throw std::runtime_error("Failed to link " + ::toString(module_kind) +
+                                 " LLVM modules.");
+      }
+    }
+    std::string linked_ir;
+    llvm::raw_string_ostream os(linked_ir);
+    linked_module->print(os, nullptr);
+    os.flush();
+    Executor::extension_module_sources[module_kind] = linked_ir;
+  };
+
+  std::lock_guard<std::mutex> compilation_lock(compilation_mutex_);
+  std::unique_lock lock(register_runtime_extension_functions_mutex_);
+  set_source(ExtModuleKinds::rt_udf_cpu_module, cpu_irs, /*is_gpu=*/false);
+  set_source(ExtModuleKinds::rt_udf_gpu_module, gpu_irs, /*is_gpu=*/true);
+  reset(/*discard_runtime_modules_only=*/true);
+  update_extension_modules(/*update_runtime_modules_only=*/true);
+}
+
 std::unordered_set<llvm::Function*> CodeGenerator::markDeadRuntimeFuncs(
     llvm::Module& llvm_module,
     const std::vector<llvm::Function*>& roots,
@@ -883,6 +1019,17 @@ void Executor::createErrorCheckControlFlow(
         find_variable_in_basic_block<llvm::LoadInst>(query_func, ".entry", "row_count");
   }
 
+  // CPU kernels check for interrupts and timeouts once per cpu_check_interval rows
+  // (rounded down to a power of two), the checks are also done on every kernel and
+  // sub-task launch. Mark the check branch as cold so it stays out of the loop body.
+  const auto cpu_check_interval = std::min<size_t>(
+      std::max<size_t>(config_->exec.interrupt.cpu_check_interval, 1), 1u << 30);
+  const uint64_t cpu_check_mask =
+      (uint64_t(1) << shared::getExpOfTwo(static_cast<unsigned>(cpu_check_interval))) -
+      1;
+  auto cpu_check_weights = llvm::MDBuilder(cgen_state_->context_).createBranchWeights(
+      1, std::max<uint32_t>(cpu_check_mask, 1));
+
   bool done_splitting = false;
   for (auto bb_it = query_func->begin(); bb_it != query_func->end() && !done_splitting;
        ++bb_it) {
@@ -931,8 +1078,8 @@ void Executor::createErrorCheckControlFlow(
             call_watchdog_lv =
                 ir_builder.CreateICmp(llvm::ICmpInst::ICMP_SLT, pos, crit_edge_threshold);
           } else {
-            // CPU path: run watchdog for every 64th row
-            auto dw_predicate = ir_builder.CreateAnd(pos, uint64_t(0x3f));
+            // CPU path: run watchdog for every cpu_check_interval-th row
+            auto dw_predicate = ir_builder.CreateAnd(pos, cpu_check_mask);
             call_watchdog_lv = ir_builder.CreateICmp(
                 llvm::ICmpInst::ICMP_EQ, dw_predicate, cgen_state_->llInt(int64_t(0LL)));
           }
@@ -950,10 +1097,12 @@ void Executor::createErrorCheckControlFlow(
               detected_timeout, cgen_state_->llInt(Executor::ERR_OUT_OF_TIME), err_lv);
           watchdog_ir_builder.CreateBr(error_check_bb);
 
-          llvm::ReplaceInstWithInst(
-              &watchdog_br_instr,
-              llvm::BranchInst::Create(
-                  watchdog_check_bb, error_check_bb, call_watchdog_lv));
+          auto watchdog_br = llvm::BranchInst::Create(
+              watchdog_check_bb, error_check_bb, call_watchdog_lv);
+          if (device_type == ExecutorDeviceType::CPU) {
+            watchdog_br->setMetadata(llvm::LLVMContext::MD_prof, cpu_check_weights);
+          }
+          llvm::ReplaceInstWithInst(&watchdog_br_instr, watchdog_br);
           ir_builder.SetInsertPoint(&br_instr);
           auto unified_err_lv = ir_builder.CreatePHI(err_lv->getType(), 2);
 
@@ -1031,8 +1180,8 @@ void Executor::createErrorCheckControlFlow(
                                       interrupt_predicate,
                                       cgen_state_->llInt(int64_t(0LL)));
           } else {
-            // CPU path: run interrupt checker for every 64th row
-            auto interrupt_predicate = ir_builder.CreateAnd(pos, uint64_t(0x3f));
+            // CPU path: run interrupt checker for every cpu_check_interval-th row
+            auto interrupt_predicate = ir_builder.CreateAnd(pos, cpu_check_mask);
             call_check_interrupt_lv =
                 ir_builder.CreateICmp(llvm::ICmpInst::ICMP_EQ,
                                       interrupt_predicate,
@@ -1052,10 +1201,13 @@ void Executor::createErrorCheckControlFlow(
               detected_interrupt, cgen_state_->llInt(Executor::ERR_INTERRUPTED), err_lv);
           interrupt_checker_ir_builder.CreateBr(error_check_bb);
 
-          llvm::ReplaceInstWithInst(
-              &check_interrupt_br_instr,
-              llvm::BranchInst::Create(
-                  interrupt_check_bb, error_check_bb, call_check_interrupt_lv));
+          auto check_interrupt_br = llvm::BranchInst::Create(
+              interrupt_check_bb, error_check_bb, call_check_interrupt_lv);
+          if (device_type == ExecutorDeviceType::CPU) {
+            check_interrupt_br->setMetadata(llvm::LLVMContext::MD_prof,
+                                            cpu_check_weights);
+          }
+          llvm::ReplaceInstWithInst(&check_interrupt_br_instr, check_interrupt_br);
           ir_builder.SetInsertPoint(&br_instr);
           auto unified_err_lv = ir_builder.CreatePHI(err_lv->getType(), 2);
 
@@ -1385,6 +1537,99 @@ std::string serialize_llvm_metadata_footnotes(llvm::Function* query_func,
 }
 #endif  // NDEBUG
 
+// Collects expressions which are costly to evaluate and occur more than once in an
+// execution unit, e.g. the same EXTRACT in a filter and in a target.
+class CommonSubexprCollector
+    : public hdk::ir::ExprCollector<std::vector<const hdk::ir::Expr*>,
+                                    CommonSubexprCollector> {
+ public:
+  void visitExecutionUnit(const RelAlgExecutionUnit& ra_exe_unit) {
+    for (auto& qual : ra_exe_unit.simple_quals) {
+      visit(qual.get());
+    }
+    for (auto& qual : ra_exe_unit.quals) {
+      visit(qual.get());
+    }
+    for (auto& join_condition : ra_exe_unit.join_quals) {
+      for (auto& qual : join_condition.quals) {
+        visit(qual.get());
+      }
+    }
+    for (auto& groupby_expr : ra_exe_unit.groupby_exprs) {
+      if (groupby_expr) {
+        visit(groupby_expr.get());
+      }
+    }
+    for (auto target_expr : ra_exe_unit.target_exprs) {
+      visit(target_expr);
+    }
+    for (auto& [expr, count] : candidates_) {
+      if (count > 1) {
+        result_.push_back(expr);
+      }
+    }
+  }
+
+ protected:
+  void visitCharLength(const hdk::ir::CharLengthExpr* char_length) override {
+    addCandidate(char_length);
+    ExprCollector::visitCharLength(char_length);
+  }
+
+  void visitLikeExpr(const hdk::ir::LikeExpr* like) override {
+    addCandidate(like);
+    ExprCollector::visitLikeExpr(like);
+  }
+
+  void visitRegexpExpr(const hdk::ir::RegexpExpr* regexp) override {
+    addCandidate(regexp);
+    ExprCollector::visitRegexpExpr(regexp);
+  }
+
+  void visitWidthBucket(const hdk::ir::WidthBucketExpr* width_bucket_expr) override {
+    addCandidate(width_bucket_expr);
+    ExprCollector::visitWidthBucket(width_bucket_expr);
+  }
+
+  void visitCaseExpr(const hdk::ir::CaseExpr* case_expr) override {
+    addCandidate(case_expr);
+    ExprCollector::visitCaseExpr(case_expr);
+  }
+
+  void visitDateTruncExpr(const hdk::ir::DateTruncExpr* datetrunc) override {
+    addCandidate(datetrunc);
+    ExprCollector::visitDateTruncExpr(datetrunc);
+  }
+
+  void visitExtractExpr(const hdk::ir::ExtractExpr* extract) override {
+    addCandidate(extract);
+    ExprCollector::visitExtractExpr(extract);
+  }
+
+  void visitDateDiffExpr(const hdk::ir::DateDiffExpr* datediff) override {
+    addCandidate(datediff);
+    ExprCollector::visitDateDiffExpr(datediff);
+  }
+
+  void visitDateAddExpr(const hdk::ir::DateAddExpr* dateadd) override {
+    addCandidate(dateadd);
+    ExprCollector::visitDateAddExpr(dateadd);
+  }
+
+ private:
+  void addCandidate(const hdk::ir::Expr* expr) {
+    for (auto& [candidate, count] : candidates_) {
+      if (*candidate == *expr) {
+        ++count;
+        return;
+      }
+    }
+    candidates_.emplace_back(expr, 1);
+  }
+
+  std::vector<std::pair<const hdk::ir::Expr*, size_t>> candidates_;
+};
+
 }  // namespace
 
 std::tuple<CompilationResult, std::unique_ptr<QueryMemoryDescriptor>>
@@ -1424,6 +1669,13 @@ Executor::compileWorkUnit(const std::vector<InputTableInfo>& query_infos,
 
   addTransientStringLiterals(ra_exe_unit, row_set_mem_owner);
 
+  if (co.device_type == ExecutorDeviceType::GPU
+          ? config_->exec.enable_gpu_compressed_transfer
+          : config_->exec.enable_cpu_compressed_columns) {
+    plan_state_->column_encodings_ =
+        choose_column_encodings(ra_exe_unit, query_infos, this);
+  }
+
   bool row_func_not_inlined = false;
   bool is_gpu_smem_used = false;
 
@@ -1431,7 +1683,9 @@ Executor::compileWorkUnit(const std::vector<InputTableInfo>& query_infos,
   auto backend = compiler::getBackend(co.device_type,
                                       getExtensionModuleContext()->getExtensionModules(),
                                       is_gpu_smem_used,
-                                      target);
+                                      target,
+                                      persistent_code_cache.get(),
+                                      l0_binary_cache.get());
   auto traits = backend->traits();
 
   MemoryLayoutBuilder mem_layout_builder(ra_exe_unit);
@@ -1476,6 +1730,9 @@ Executor::compileWorkUnit(const std::vector<InputTableInfo>& query_infos,
       const auto& count_distinct_descriptor =
           query_mem_desc->getCountDistinctDescriptor(i);
       if (count_distinct_descriptor.impl_type_ == CountDistinctImplType::HashSet ||
+          count_distinct_descriptor.impl_type_ == CountDistinctImplType::RoaringBitmap ||
+          count_distinct_descriptor.impl_type_ ==
+              CountDistinctImplType::SparseHyperLogLog ||
           (count_distinct_descriptor.impl_type_ != CountDistinctImplType::Invalid &&
            !co.hoist_literals)) {
         throw QueryMustRunOnCpu();
@@ -1588,6 +1845,17 @@ Executor::compileWorkUnit(const std::vector<InputTableInfo>& query_infos,
   for (auto& simple_qual : ra_exe_unit.simple_quals) {
     plan_state_->addSimpleQual(simple_qual);
   }
+  if (config_->exec.codegen.enable_common_subexpr_elimination) {
+    CommonSubexprCollector cse_collector;
+    cse_collector.visitExecutionUnit(body_execution_unit);
+    for (auto expr : cse_collector.result()) {
+      cgen_state_->addCommonSubexpr(expr);
+    }
+    if (!cse_collector.result().empty()) {
+      VLOG(1) << "Found " << cse_collector.result().size()
+              << " common subexpression(s) in the execution unit.";
+    }
+  }
   if (!join_loops.empty()) {
     codegenJoinLoops(join_loops,
                      body_execution_unit,
@@ -1811,7 +2079,8 @@ Executor::compileWorkUnit(const std::vector<InputTableInfo>& query_infos,
                         cgen_state_->getLiterals(),
                         output_columnar,
                         llvm_ir,
-                        std::move(gpu_smem_context)},
+                        std::move(gpu_smem_context),
+                        plan_state_->column_encodings_},
       std::move(query_mem_desc));
 }
 
@@ -1939,8 +2208,12 @@ bool Executor::compileBody(const RelAlgExecutionUnit& ra_exe_unit,
   // generate the code for the filter
   std::vector<const hdk::ir::Expr*> primary_quals;
   std::vector<const hdk::ir::Expr*> deferred_quals;
-  bool short_circuited = CodeGenerator::prioritizeQuals(
-      ra_exe_unit, primary_quals, deferred_quals, plan_state_->hoisted_filters_);
+  const bool reorder_quals = config_->opts.enable_filter_reordering;
+  bool short_circuited = CodeGenerator::prioritizeQuals(ra_exe_unit,
+                                                        primary_quals,
+                                                        deferred_quals,
+                                                        plan_state_->hoisted_filters_,
+                                                        reorder_quals);
   if (short_circuited) {
     VLOG(1) << "Prioritized " << std::to_string(primary_quals.size()) << " quals, "
             << "short-circuited and deferred " << std::to_string(deferred_quals.size())
@@ -1950,6 +2223,7 @@ bool Executor::compileBody(const RelAlgExecutionUnit& ra_exe_unit,
   CodeGenerator code_generator(this, co.codegen_traits_desc);
   for (auto expr : primary_quals) {
     // Generate the filter for primary quals
+    code_generator.codegenExpressionCounter("filter", expr, co);
     auto cond = code_generator.toBool(code_generator.codegen(expr, true, co).front());
     filter_lv = cgen_state_->ir_builder_.CreateAnd(filter_lv, cond);
   }
@@ -1969,6 +2243,16 @@ bool Executor::compileBody(const RelAlgExecutionUnit& ra_exe_unit,
     filter_lv = cgen_state_->llBool(true);
   }
   for (auto expr : deferred_quals) {
+    if (reorder_quals && filter_lv != cgen_state_->llBool(true)) {
+      // Each of the ordered deferred quals is skipped for rows filtered out by the
+      // previous ones.
+      auto sc_next = llvm::BasicBlock::Create(
+          cgen_state_->context_, "sc_true", cgen_state_->current_func_);
+      cgen_state_->ir_builder_.CreateCondBr(filter_lv, sc_next, sc_false);
+      cgen_state_->ir_builder_.SetInsertPoint(sc_next);
+      filter_lv = cgen_state_->llBool(true);
+    }
+    code_generator.codegenExpressionCounter("filter", expr, co);
     filter_lv = cgen_state_->ir_builder_.CreateAnd(
         filter_lv, code_generator.toBool(code_generator.codegen(expr, true, co).front()));
   }
@@ -152,7 +152,7 @@ CubinResult ptx_to_cubin(const std::string& ptx,
   CHECK(cubin);
   CHECK_GT(cubinSize, size_t(0));
   VLOG(1) << "Generated GPU binary code size: " << cubinSize << " bytes";
-  return {cubin, option_keys, option_values, link_state};
+  return {cubin, option_keys, option_values, link_state, cubinSize};
 }
 #endif
 
@@ -35,6 +35,7 @@ struct CubinResult {
   std::vector<CUjit_option> option_keys;
   std::vector<void*> option_values;
   CUlinkState link_state;
+  size_t cubin_size;
 };
 
 /**
@@ -0,0 +1,158 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/PersistentCodeCache.h"
+
+#include "Logger/Logger.h"
+#include "QueryEngine/MurmurHash.h"
+
+#include <llvm/ADT/StringMap.h>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/Host.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+
+const std::string kModuleIdPrefix = "hdk_code_";
+const std::string kObjectFileExt = ".o";
+
+// Code produced by the JIT is specific to the LLVM version and host CPU features,
+// so all of them go into the key.
+std::string build_salt() {
+  std::string salt = "llvm:" + std::to_string(LLVM_VERSION_MAJOR) + "." +
+                     std::to_string(LLVM_VERSION_MINOR) + "." +
+                     std::to_string(LLVM_VERSION_PATCH) + ";";
+  salt += "triple:" + llvm::sys::getProcessTriple() + ";";
+  salt += "cpu:" + llvm::sys::getHostCPUName().str() + ";";
+  llvm::StringMap<bool> cpu_features;
+  if (llvm::sys::getHostCPUFeatures(cpu_features)) {
+    std::vector<std::string> enabled;
+    for (auto& feature : cpu_features) {
+      if (feature.getValue()) {
+        enabled.push_back(feature.getKey().str());
+      }
+    }
+    std::sort(enabled.begin(), enabled.end());
+    for (auto& name : enabled) {
+      salt += "+" + name;
+    }
+  }
+  return salt;
+}
+
+std::string hash_key(const std::string& salt, const CodeCacheKey& key) {
+  // Serialize the key with explicit lengths to avoid ambiguity between different
+  // splits of the same concatenated string.
+  std::string buf = std::to_string(salt.size()) + ":" + salt;
+  for (auto& part : key) {
+    buf += std::to_string(part.size()) + ":" + part;
+  }
+  auto h1 = MurmurHash64A(buf.data(), static_cast<int>(buf.size()), 0x9E3779B97F4A7C15);
+  auto h2 = MurmurHash64A(buf.data(), static_cast<int>(buf.size()), 0xC2B2AE3D27D4EB4F);
+  std::stringstream ss;
+  ss << std::hex << std::setfill('0') << std::setw(16) << h1 << std::setw(16) << h2;
+  return ss.str();
+}
+
+}  // namespace
+
+PersistentCodeCache::PersistentCodeCache(std::string cache_dir)
+    : cache_dir_(std::move(cache_dir)), salt_(build_salt()) {
+  boost::system::error_code ec;
+  boost::filesystem::create_directories(cache_dir_, ec);
+  if (ec) {
+    throw std::runtime_error("Cannot create persistent code cache directory " +
+                             cache_dir_ + ": " + ec.message());
+  }
+  LOG(INFO) << "Using persistent code cache in " << cache_dir_;
+}
+
+std::string PersistentCodeCache::moduleId(const CodeCacheKey& key) const {
+  return kModuleIdPrefix + hash_key(salt_, key);
+}
+
+std::string PersistentCodeCache::objectPath(const llvm::Module* module) const {
+  auto& id = module->getModuleIdentifier();
+  if (id.rfind(kModuleIdPrefix, 0) != 0) {
+    return "";
+  }
+  return (boost::filesystem::path(cache_dir_) / (id + kObjectFileExt)).string();
+}
+
+bool PersistentCodeCache::hasObject(const llvm::Module* module) const {
+  auto path = objectPath(module);
+  return !path.empty() && boost::filesystem::exists(path);
+}
+
+void PersistentCodeCache::notifyObjectCompiled(const llvm::Module* module,
+                                               llvm::MemoryBufferRef obj) {
+  auto path = objectPath(module);
+  if (path.empty()) {
+    return;
+  }
+  // Write into a temporary file and then rename it to make the update atomic for
+  // concurrent readers, including other processes sharing the same directory.
+  auto tmp_path =
+      path + "." + boost::filesystem::unique_path("%%%%-%%%%-%%%%").string() + ".tmp";
+  {
+    std::ofstream out(tmp_path, std::ios::binary);
+    if (!out) {
+      LOG(WARNING) << "Cannot write persistent code cache entry " << tmp_path;
+      return;
+    }
+    out.write(obj.getBufferStart(), obj.getBufferSize());
+    if (!out) {
+      LOG(WARNING) << "Failed to write persistent code cache entry " << tmp_path;
+      out.close();
+      boost::filesystem::remove(tmp_path);
+      return;
+    }
+  }
+  boost::system::error_code ec;
+  boost::filesystem::rename(tmp_path, path, ec);
+  if (ec) {
+    LOG(WARNING) << "Cannot store persistent code cache entry " << path << ": "
+                 << ec.message();
+    boost::filesystem::remove(tmp_path, ec);
+    return;
+  }
+  ++store_count_;
+  VLOG(1) << "Stored object code to persistent code cache: " << path;
+}
+
+std::unique_ptr<llvm::MemoryBuffer> PersistentCodeCache::getObject(
+    const llvm::Module* module) {
+  auto path = objectPath(module);
+  if (path.empty()) {
+    return nullptr;
+  }
+  auto buf_or_err = llvm::MemoryBuffer::getFile(path);
+  if (!buf_or_err) {
+    ++miss_count_;
+    return nullptr;
+  }
+  ++hit_count_;
+  VLOG(1) << "Loaded object code from persistent code cache: " << path;
+  // ORC expects a buffer it can own independently of the cache.
+  return llvm::MemoryBuffer::getMemBufferCopy((*buf_or_err)->getBuffer(),
+                                              (*buf_or_err)->getBufferIdentifier());
+}
@@ -0,0 +1,68 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "QueryEngine/CodeCache.h"
+
+#include <llvm/ExecutionEngine/ObjectCache.h>
+
+#include <atomic>
+#include <string>
+
+namespace llvm {
+class Module;
+}
+
+/**
+ * On-disk tier for the CPU code cache. Object files produced by the ORC JIT are
+ * stored in a directory and named after a stable hash of the CodeCacheKey salted
+ * with LLVM version and host CPU description. The cache is plugged into the JIT
+ * compiler as an llvm::ObjectCache. A module participates in caching only when
+ * its identifier was produced by moduleId().
+ */
+class PersistentCodeCache : public llvm::ObjectCache {
+ public:
+  PersistentCodeCache(std::string cache_dir);
+
+  // Module identifier to use for a module compiled for the given key.
+  std::string moduleId(const CodeCacheKey& key) const;
+
+  // Return true if object code for the module is available on disk. Used to skip
+  // IR optimization for modules which are not going to be compiled.
+  bool hasObject(const llvm::Module* module) const;
+
+  void notifyObjectCompiled(const llvm::Module* module,
+                            llvm::MemoryBufferRef obj) override;
+
+  std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module* module) override;
+
+  const std::string& cacheDir() const { return cache_dir_; }
+
+  size_t hitCount() const { return hit_count_; }
+  size_t missCount() const { return miss_count_; }
+  size_t storeCount() const { return store_count_; }
+
+ private:
+  // Return an empty string for modules not managed by this cache.
+  std::string objectPath(const llvm::Module* module) const;
+
+  const std::string cache_dir_;
+  // Part of the hash covering everything that invalidates generated code other than
+  // the IR itself.
+  const std::string salt_;
+  std::atomic<size_t> hit_count_{0};
+  std::atomic<size_t> miss_count_{0};
+  std::atomic<size_t> store_count_{0};
+};
@@ -20,6 +20,7 @@
 
 #include "IR/Expr.h"
 #include "QueryEngine/Descriptors/InputDescriptors.h"
+#include "QueryEngine/FrameOfReferenceEncoding.h"
 #include "QueryEngine/JoinHashTable/HashJoin.h"
 
 class Executor;
@@ -74,6 +75,8 @@ struct PlanState {
   const std::vector<InputTableInfo>& query_infos_;
   std::list<hdk::ir::ExprPtr> simple_quals_;
   const Executor* executor_;
+  // Columns transferred to GPU in a compressed form.
+  ColumnEncodings column_encodings_;
 
   void allocateLocalColumnIds(
       const std::list<std::shared_ptr<const InputColDescriptor>>& global_col_ids);
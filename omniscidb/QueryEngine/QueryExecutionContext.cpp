@@ -19,6 +19,7 @@
 #include "CompilationOptions.h"
 #include "DeviceKernel.h"
 #include "Execute.h"
+#include "ExtensionFunctionsBatch.h"
 #include "GpuInitGroups.h"
 #include "GpuMemUtils.h"
 #include "InPlaceSort.h"
@@ -393,6 +394,14 @@ std::vector<int64_t*> QueryExecutionContext::launchGpuCode(
       }
       if (query_mem_desc_.getQueryDescriptionType() == QueryDescriptionType::Projection) {
         if (query_mem_desc_.didOutputColumnar()) {
+          if (executor_->getConfig().rs.keep_gpu_results &&
+              !query_mem_desc_.hasVarlenOutput()) {
+            query_buffers_->keepProjectionBuffersOnGpu(
+                query_mem_desc_,
+                buffer_provider,
+                gpu_allocator_->releaseBuffer(gpu_group_by_buffers.data),
+                gpu_group_by_buffers);
+          }
           query_buffers_->compactProjectionBuffersGpu(
               query_mem_desc_,
               buffer_provider,
@@ -566,6 +575,9 @@ std::vector<int64_t*> QueryExecutionContext::launchCpuCode(
 
   CHECK(query_buffers_);
   const auto& init_agg_vals = query_buffers_->init_agg_vals_;
+  // Cached results of batch extension functions may point to buffers of another
+  // kernel, which ran on this thread before.
+  reset_batch_ext_func_cache();
 
   std::vector<const int8_t**> multifrag_col_buffers;
   for (auto& col_buffer : col_buffers) {
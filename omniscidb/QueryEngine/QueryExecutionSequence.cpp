@@ -53,7 +53,8 @@ class QueryExecutionSequenceImpl {
   }
 
  protected:
-  QueryExecutionSequenceImpl(const ir::Node* root, ConfigPtr config) : config_(config) {
+  QueryExecutionSequenceImpl(const ir::Node* root, ConfigPtr config)
+      : root_(root), config_(config) {
     buildDagEdges(root);
     for (auto& pr : node_to_vertex_) {
       graph_[pr.second] = pr.first;
@@ -69,6 +70,12 @@ class QueryExecutionSequenceImpl {
     buildSteps();
   }
 
+  // Nodes holding results of previous executions are used as materialized inputs,
+  // so their inputs are not executed. The root is always executed.
+  bool hasResult(const ir::Node* node) const {
+    return node != root_ && node->getResult();
+  }
+
   void buildDagEdges(const ir::Node* node) {
     // Already visited node
     if (node_to_vertex_.count(node)) {
@@ -78,6 +85,10 @@ class QueryExecutionSequenceImpl {
     auto vertex = boost::add_vertex(graph_);
     node_to_vertex_.emplace(node, vertex);
 
+    if (hasResult(node)) {
+      return;
+    }
+
     for (size_t i = 0; i < node->inputCount(); ++i) {
       const auto input = node->getInput(i);
       buildDagEdges(input);
@@ -90,7 +101,7 @@ class QueryExecutionSequenceImpl {
   }
 
   void findExecutionPoints(const ir::Node* node, bool execute_join = false) {
-    if (node->is<ir::Scan>()) {
+    if (node->is<ir::Scan>() || hasResult(node)) {
       return;
     }
 
@@ -217,7 +228,7 @@ class QueryExecutionSequenceImpl {
   void removeScanExecutionPoints() {
     std::vector<const ir::Node*> to_remove;
     for (auto node : execution_points_) {
-      if (node->is<ir::Scan>()) {
+      if (node->is<ir::Scan>() || hasResult(node)) {
         to_remove.push_back(node);
       }
     }
@@ -231,7 +242,7 @@ class QueryExecutionSequenceImpl {
       auto input = intermediate->getInput(i);
       if (execution_points_.count(input)) {
         boost::add_edge(node_to_vertex_[orig_source], node_to_vertex_[input], graph_);
-      } else {
+      } else if (!hasResult(input)) {
         buildExecutionEdges(orig_source, input);
       }
     }
@@ -261,6 +272,7 @@ class QueryExecutionSequenceImpl {
     }
   }
 
+  const ir::Node* root_;
   DAG graph_;
   std::unordered_map<const hdk::ir::Node*, size_t> node_to_vertex_;
   std::unordered_set<const ir::Node*> execution_points_;
@@ -43,6 +43,11 @@ int64_t g_bitmap_memory_limit{8LL * 1000 * 1000 * 1000};
 
 namespace {
 
+// Deferred allocation sizes of count distinct buffers which are not dense bitmaps.
+constexpr int64_t kCountDistinctSetAllocSize{-1};
+constexpr int64_t kCountDistinctRoaringBitmapAllocSize{-2};
+constexpr int64_t kCountDistinctSparseHllAllocSize{-3};
+
 inline void check_total_bitmap_memory(const QueryMemoryDescriptor& query_mem_desc) {
   const int32_t groups_buffer_entry_count = query_mem_desc.getEntryCount();
   checked_int64_t total_bytes_per_group = 0;
@@ -323,8 +328,16 @@ QueryMemoryInitializer::QueryMemoryInitializer(
                                        query_mem_desc.hasKeylessHash()
                                    ? query_mem_desc.getEntryCount()
                                    : size_t(0);
+  const bool first_touch_init = query_mem_desc.firstTouchInitGroups(device_type);
+  if (first_touch_init) {
+    CHECK_EQ(index_buffer_qw, size_t(0));
+    CHECK_EQ(group_buffer_size, query_mem_desc.getFirstTouchInitRowOffset());
+  }
   const auto actual_group_buffer_size =
-      group_buffer_size + index_buffer_qw * sizeof(int64_t);
+      group_buffer_size + index_buffer_qw * sizeof(int64_t) +
+      (first_touch_init
+           ? query_mem_desc.getRowSize() + query_mem_desc.getOccupancyBitmapSize()
+           : 0);
   CHECK_GE(actual_group_buffer_size, group_buffer_size);
 
   if (query_mem_desc.hasVarlenOutput()) {
@@ -341,7 +354,9 @@ QueryMemoryInitializer::QueryMemoryInitializer(
     auto group_by_buffer = alloc_group_by_buffer(
         actual_group_buffer_size, thread_idx_, row_set_mem_owner_.get());
 
-    if (!query_mem_desc.lazyInitGroups(device_type)) {
+    if (first_touch_init) {
+      initFirstTouchGroupByBuffer(group_by_buffer, query_mem_desc, executor);
+    } else if (!query_mem_desc.lazyInitGroups(device_type)) {
       if (group_by_buffer_template) {
         memcpy(group_by_buffer + index_buffer_qw,
                group_by_buffer_template,
@@ -393,9 +408,13 @@ QueryMemoryInitializer::QueryMemoryInitializer(
         executor->getDataMgr(),
         executor->blockSize(),
         executor->gridSize()));
-    result_sets_.back()->allocateStorage(reinterpret_cast<int8_t*>(group_by_buffer),
-                                         executor->plan_state_->init_agg_vals_,
-                                         getVarlenOutputInfo());
+    auto storage =
+        result_sets_.back()->allocateStorage(reinterpret_cast<int8_t*>(group_by_buffer),
+                                             executor->plan_state_->init_agg_vals_,
+                                             getVarlenOutputInfo());
+    if (first_touch_init) {
+      storage->setFirstTouchInit();
+    }
     for (size_t j = 1; j < step; ++j) {
       result_sets_.emplace_back(nullptr);
     }
@@ -444,6 +463,23 @@ void QueryMemoryInitializer::initGroupByBuffer(
   }
 }
 
+void QueryMemoryInitializer::initFirstTouchGroupByBuffer(
+    int64_t* buffer,
+    const QueryMemoryDescriptor& query_mem_desc,
+    const Executor* executor) {
+  auto buffer_ptr = reinterpret_cast<int8_t*>(buffer);
+  initRowGroups(query_mem_desc,
+                reinterpret_cast<int64_t*>(buffer_ptr +
+                                           query_mem_desc.getFirstTouchInitRowOffset()),
+                init_agg_vals_,
+                /*groups_buffer_entry_count=*/1,
+                /*warp_size=*/1,
+                executor);
+  memset(buffer_ptr + query_mem_desc.getOccupancyBitmapOffset(),
+         0,
+         query_mem_desc.getOccupancyBitmapSize());
+}
+
 bool QueryMemoryInitializer::useVectorRowGroupsInit(const size_t row_size,
                                                     const size_t entries) const {
   // Assume 512-bit vector size. Don't bother if
@@ -635,8 +671,16 @@ void QueryMemoryInitializer::initColumnsPerRow(
       // COUNT DISTINCT / APPROX_COUNT_DISTINCT
       CHECK_EQ(static_cast<size_t>(query_mem_desc.getPaddedSlotWidthBytes(col_idx)),
                sizeof(int64_t));
-      init_val =
-          bm_sz > 0 ? allocateCountDistinctBitmap(bm_sz) : allocateCountDistinctSet();
+      if (bm_sz > 0) {
+        init_val = allocateCountDistinctBitmap(bm_sz);
+      } else if (bm_sz == kCountDistinctRoaringBitmapAllocSize) {
+        init_val = allocateCountDistinctRoaringBitmap();
+      } else if (bm_sz == kCountDistinctSparseHllAllocSize) {
+        init_val = allocateCountDistinctSparseHll();
+      } else {
+        CHECK_EQ(bm_sz, kCountDistinctSetAllocSize);
+        init_val = allocateCountDistinctSet();
+      }
       ++init_vec_idx;
     } else if (query_mem_desc.isGroupBy() && quantile_params[col_idx]) {
       auto const q = *quantile_params[col_idx];
@@ -736,10 +780,24 @@ std::vector<int64_t> QueryMemoryInitializer::allocateCountDistinctBuffers(
         } else {
           init_agg_vals_[agg_col_idx] = allocateCountDistinctBitmap(bitmap_byte_sz);
         }
+      } else if (count_distinct_desc.impl_type_ ==
+                 CountDistinctImplType::RoaringBitmap) {
+        if (deferred) {
+          agg_bitmap_size[agg_col_idx] = kCountDistinctRoaringBitmapAllocSize;
+        } else {
+          init_agg_vals_[agg_col_idx] = allocateCountDistinctRoaringBitmap();
+        }
+      } else if (count_distinct_desc.impl_type_ ==
+                 CountDistinctImplType::SparseHyperLogLog) {
+        if (deferred) {
+          agg_bitmap_size[agg_col_idx] = kCountDistinctSparseHllAllocSize;
+        } else {
+          init_agg_vals_[agg_col_idx] = allocateCountDistinctSparseHll();
+        }
       } else {
         CHECK(count_distinct_desc.impl_type_ == CountDistinctImplType::HashSet);
         if (deferred) {
-          agg_bitmap_size[agg_col_idx] = -1;
+          agg_bitmap_size[agg_col_idx] = kCountDistinctSetAllocSize;
         } else {
           init_agg_vals_[agg_col_idx] = allocateCountDistinctSet();
         }
@@ -769,6 +827,18 @@ int64_t QueryMemoryInitializer::allocateCountDistinctSet() {
   return reinterpret_cast<int64_t>(count_distinct_set);
 }
 
+int64_t QueryMemoryInitializer::allocateCountDistinctRoaringBitmap() {
+  auto count_distinct_bitmap = new RoaringBitmap();
+  row_set_mem_owner_->addCountDistinctRoaringBitmap(count_distinct_bitmap);
+  return reinterpret_cast<int64_t>(count_distinct_bitmap);
+}
+
+int64_t QueryMemoryInitializer::allocateCountDistinctSparseHll() {
+  auto count_distinct_hll = new SparseHyperLogLog();
+  row_set_mem_owner_->addCountDistinctSparseHll(count_distinct_hll);
+  return reinterpret_cast<int64_t>(count_distinct_hll);
+}
+
 std::vector<QueryMemoryInitializer::QuantileParam>
 QueryMemoryInitializer::allocateTDigests(const QueryMemoryDescriptor& query_mem_desc,
                                          const bool deferred,
@@ -1053,6 +1123,24 @@ void QueryMemoryInitializer::compactProjectionBuffersGpu(
   result_sets_.front()->updateStorageEntryCount(num_allocated_rows);
 }
 
+void QueryMemoryInitializer::keepProjectionBuffersOnGpu(
+    const QueryMemoryDescriptor& query_mem_desc,
+    BufferProvider* buffer_provider,
+    Data_Namespace::AbstractBuffer* device_buffer,
+    const GpuGroupByBuffers& gpu_group_by_buffers) {
+  CHECK(query_mem_desc.didOutputColumnar());
+  CHECK(!result_sets_.empty());
+  row_set_mem_owner_->addDeviceBuffer(buffer_provider, device_buffer);
+  // Offsets of device columns are computed for the original entry count.
+  std::vector<const int8_t*> slot_buffers(query_mem_desc.getSlotCount(), nullptr);
+  for (size_t i = 0; i < slot_buffers.size(); ++i) {
+    if (query_mem_desc.getPaddedSlotWidthBytes(i) > 0) {
+      slot_buffers[i] = gpu_group_by_buffers.data + query_mem_desc.getColOffInBytes(i);
+    }
+  }
+  result_sets_.front()->setDeviceColumnarBuffers(std::move(slot_buffers));
+}
+
 void QueryMemoryInitializer::copyGroupByBuffersFromGpu(
     BufferProvider* buffer_provider,
     const QueryMemoryDescriptor& query_mem_desc,
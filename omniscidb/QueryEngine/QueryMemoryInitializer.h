@@ -107,6 +107,12 @@ class QueryMemoryInitializer {
                          const bool output_columnar,
                          const Executor* executor);
 
+  // Only writes the initial row and clears the occupancy bitmap, rows are initialized
+  // by the kernel on the first touch.
+  void initFirstTouchGroupByBuffer(int64_t* buffer,
+                                   const QueryMemoryDescriptor& query_mem_desc,
+                                   const Executor* executor);
+
   bool useVectorRowGroupsInit(const size_t row_size, const size_t entries) const;
 
   void initRowGroups(const QueryMemoryDescriptor& query_mem_desc,
@@ -139,6 +145,10 @@ class QueryMemoryInitializer {
 
   int64_t allocateCountDistinctSet();
 
+  int64_t allocateCountDistinctRoaringBitmap();
+
+  int64_t allocateCountDistinctSparseHll();
+
   std::vector<QuantileParam> allocateTDigests(const QueryMemoryDescriptor& query_mem_desc,
                                               const bool deferred,
                                               const Executor* executor);
@@ -174,6 +184,12 @@ class QueryMemoryInitializer {
                                    const GpuGroupByBuffers& gpu_group_by_buffers,
                                    const size_t projection_count,
                                    const int device_id);
+  // Pass the GPU projection buffer to the result set as its device memory. Must be
+  // called before compaction of the host buffer changes the result set entry count.
+  void keepProjectionBuffersOnGpu(const QueryMemoryDescriptor& query_mem_desc,
+                                  BufferProvider* buffer_provider,
+                                  Data_Namespace::AbstractBuffer* device_buffer,
+                                  const GpuGroupByBuffers& gpu_group_by_buffers);
 
   void applyStreamingTopNOffsetCpu(const QueryMemoryDescriptor& query_mem_desc,
                                    const RelAlgExecutionUnit& ra_exe_unit);
@@ -0,0 +1,121 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/QueryProfile.h"
+
+#include <iomanip>
+#include <sstream>
+
+void QueryProfile::beginStep(unsigned node_id, std::string node_name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  steps_.emplace_back();
+  steps_.back().node_id = node_id;
+  steps_.back().node_name = std::move(node_name);
+  in_step_ = true;
+}
+
+void QueryProfile::endStep(int64_t total_time, size_t output_rows) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (auto step = currentStep()) {
+    step->total_time = total_time;
+    step->output_rows = output_rows;
+  }
+  in_step_ = false;
+}
+
+void QueryProfile::addCompilationTime(int64_t time) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (auto step = currentStep()) {
+    step->compilation_time += time;
+  }
+}
+
+void QueryProfile::addHashTableBuildTime(int64_t time) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (auto step = currentStep()) {
+    step->hash_table_build_time += time;
+  }
+}
+
+void QueryProfile::addReductionTime(int64_t time) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (auto step = currentStep()) {
+    step->reduction_time += time;
+  }
+}
+
+void QueryProfile::addKernel(KernelProfile kernel) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (auto step = currentStep()) {
+    step->input_rows += kernel.input_rows;
+    step->kernels.emplace_back(std::move(kernel));
+  }
+}
+
+std::vector<StepProfile> QueryProfile::steps() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return steps_;
+}
+
+int64_t QueryProfile::totalTime() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  int64_t res = 0;
+  for (auto& step : steps_) {
+    res += step.total_time;
+  }
+  return res;
+}
+
+StepProfile* QueryProfile::currentStep() {
+  return in_step_ ? &steps_.back() : nullptr;
+}
+
+namespace {
+
+std::string formatTime(int64_t time_us) {
+  std::ostringstream ss;
+  ss << std::fixed << std::setprecision(3) << time_us / 1000.0 << " ms";
+  return ss.str();
+}
+
+}  // namespace
+
+std::string QueryProfile::toString() const {
+  auto steps_copy = steps();
+  std::ostringstream ss;
+  int64_t total_time = 0;
+  for (size_t i = 0; i < steps_copy.size(); ++i) {
+    const auto& step = steps_copy[i];
+    total_time += step.total_time;
+    ss << "Step " << i << ": " << step.node_name << " (id=" << step.node_id << ")\n"
+       << "  total: " << formatTime(step.total_time)
+       << ", compilation: " << formatTime(step.compilation_time)
+       << ", hash table build: " << formatTime(step.hash_table_build_time)
+       << ", reduction: " << formatTime(step.reduction_time) << "\n"
+       << "  rows in: " << step.input_rows << ", rows out: " << step.output_rows
+       << ", kernels: " << step.kernels.size() << "\n";
+    for (const auto& kernel : step.kernels) {
+      ss << "    " << (kernel.device_type == ExecutorDeviceType::GPU ? "GPU" : "CPU")
+         << kernel.device_id << " fragments [";
+      for (size_t j = 0; j < kernel.fragment_ids.size(); ++j) {
+        ss << (j ? ", " : "") << kernel.fragment_ids[j];
+      }
+      ss << "]: fetch " << formatTime(kernel.fetch_time) << ", execution "
+         << formatTime(kernel.execution_time) << ", rows in " << kernel.input_rows
+         << ", rows out " << kernel.output_rows << "\n";
+    }
+  }
+  ss << "Total: " << formatTime(total_time) << "\n";
+  return ss.str();
+}
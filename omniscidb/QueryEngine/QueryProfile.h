@@ -0,0 +1,110 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    QueryProfile.h
+ * @brief   Per-query execution profile with timings of query steps and kernels.
+ *
+ * The profile is collected when ExecutionOptions::with_profile is set and is
+ * returned with ExecutionResult. The executor holds the profile of the running query
+ * and execution stages report to the current step. Kernels report from worker
+ * threads, so all updates are synchronized. All times are in microseconds.
+ **/
+
+#pragma once
+
+#include "Shared/DeviceType.h"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct KernelProfile {
+  ExecutorDeviceType device_type{ExecutorDeviceType::CPU};
+  int device_id{0};
+  // Fragments of the outer table processed by the kernel.
+  std::vector<size_t> fragment_ids;
+  // Input fetch including transfers to the device.
+  int64_t fetch_time{0};
+  int64_t execution_time{0};
+  size_t input_rows{0};
+  size_t output_rows{0};
+};
+
+struct StepProfile {
+  unsigned node_id{0};
+  std::string node_name;
+  int64_t total_time{0};
+  // Code generation and compilation, hash table builds included.
+  int64_t compilation_time{0};
+  int64_t hash_table_build_time{0};
+  int64_t reduction_time{0};
+  size_t input_rows{0};
+  size_t output_rows{0};
+  std::vector<KernelProfile> kernels;
+};
+
+class QueryProfile {
+ public:
+  void beginStep(unsigned node_id, std::string node_name);
+  void endStep(int64_t total_time, size_t output_rows);
+
+  void addCompilationTime(int64_t time);
+  void addHashTableBuildTime(int64_t time);
+  void addReductionTime(int64_t time);
+  void addKernel(KernelProfile kernel);
+
+  // Copies are safe to read while the query runs.
+  std::vector<StepProfile> steps() const;
+  int64_t totalTime() const;
+
+  // EXPLAIN ANALYZE style text with one block per step.
+  std::string toString() const;
+
+ private:
+  StepProfile* currentStep();
+
+  mutable std::mutex mutex_;
+  std::vector<StepProfile> steps_;
+  // Stages reported outside of a step are dropped.
+  bool in_step_{false};
+};
+
+using QueryProfilePtr = std::shared_ptr<QueryProfile>;
+
+// Adds the lifetime of the timer to a step counter of the profile. Does nothing for
+// a null profile.
+class QueryProfileTimer {
+ public:
+  using Counter = void (QueryProfile::*)(int64_t);
+
+  QueryProfileTimer(QueryProfile* profile, Counter counter)
+      : profile_(profile), counter_(counter), start_(std::chrono::steady_clock::now()) {}
+
+  ~QueryProfileTimer() {
+    if (profile_) {
+      (profile_->*counter_)(std::chrono::duration_cast<std::chrono::microseconds>(
+                                std::chrono::steady_clock::now() - start_)
+                                .count());
+    }
+  }
+
+ private:
+  QueryProfile* profile_;
+  Counter counter_;
+  std::chrono::steady_clock::time_point start_;
+};
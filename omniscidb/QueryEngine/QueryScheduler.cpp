@@ -0,0 +1,206 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/QueryScheduler.h"
+
+#include "Logger/Logger.h"
+
+#include <limits>
+
+QueryScheduler::Ticket::~Ticket() {
+  scheduler_->release(*this);
+}
+
+QueryScheduler& QueryScheduler::get() {
+  static QueryScheduler scheduler;
+  return scheduler;
+}
+
+QueryScheduler::TicketPtr QueryScheduler::admit(const QuerySchedulerConfig& config,
+                                                std::set<Device> devices,
+                                                size_t memory_reservation,
+                                                int priority) {
+  CHECK(!devices.empty());
+  std::unique_lock<std::mutex> lock(mutex_);
+  acquire(lock, config, devices, memory_reservation, priority);
+  lock.unlock();
+  // The next waiting query might be admitted too.
+  cv_.notify_all();
+
+  VLOG(1) << "Admitted query on " << devices.size() << " device(s) with priority "
+          << priority << " and " << memory_reservation
+          << " bytes of reserved memory per device.";
+  return TicketPtr(new Ticket(this, std::move(devices), memory_reservation, priority));
+}
+
+bool QueryScheduler::preempt(const QuerySchedulerConfig& config, Ticket& ticket) {
+  if (!config.enable_preemption) {
+    return false;
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (ticket.preempted_) {
+    return true;
+  }
+  // Only a query waiting for a slot can be helped by preemption.
+  const int64_t own_priority_key = -static_cast<int64_t>(ticket.priority_);
+  bool has_preemptor = false;
+  for (auto& device : ticket.devices_) {
+    auto& state = states_.at(device);
+    if (!state.waiting.empty() && state.waiting.begin()->first < own_priority_key &&
+        state.running_queries >= maxQueries(config, device)) {
+      has_preemptor = true;
+      break;
+    }
+  }
+  if (!has_preemptor) {
+    return false;
+  }
+  for (auto& device : ticket.devices_) {
+    auto& state = states_.at(device);
+    CHECK_GT(state.running_queries, size_t(0));
+    --state.running_queries;
+  }
+  ticket.preempted_ = true;
+  ++preempted_queries_;
+  lock.unlock();
+  cv_.notify_all();
+
+  VLOG(1) << "Preempted query with priority " << ticket.priority_ << ".";
+  return true;
+}
+
+void QueryScheduler::resume(const QuerySchedulerConfig& config, Ticket& ticket) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (!ticket.preempted_) {
+    return;
+  }
+  // The memory stays reserved while the query is preempted.
+  acquire(lock, config, ticket.devices_, /*memory_reservation=*/0, ticket.priority_);
+  ticket.preempted_ = false;
+  --preempted_queries_;
+  lock.unlock();
+  cv_.notify_all();
+
+  VLOG(1) << "Resumed query with priority " << ticket.priority_ << ".";
+}
+
+void QueryScheduler::acquire(std::unique_lock<std::mutex>& lock,
+                             const QuerySchedulerConfig& config,
+                             const std::set<Device>& devices,
+                             size_t memory_reservation,
+                             int priority) {
+  const WaitKey key{-static_cast<int64_t>(priority), next_arrival_++};
+  for (auto& device : devices) {
+    states_[device].waiting.insert(key);
+  }
+  cv_.wait(lock, [&]() { return canAdmit(config, devices, memory_reservation, key); });
+  for (auto& device : devices) {
+    auto& state = states_.at(device);
+    state.waiting.erase(key);
+    ++state.running_queries;
+    state.reserved_memory += memory_reservation;
+  }
+}
+
+size_t QueryScheduler::maxQueries(const QuerySchedulerConfig& config,
+                                  const Device& device) {
+  const size_t max_queries = device.first == ExecutorDeviceType::GPU
+                                 ? config.max_gpu_queries
+                                 : config.max_cpu_queries;
+  return max_queries ? max_queries : std::numeric_limits<size_t>::max();
+}
+
+bool QueryScheduler::canAdmit(const QuerySchedulerConfig& config,
+                              const std::set<Device>& devices,
+                              size_t memory_reservation,
+                              const WaitKey& key) const {
+  for (auto& device : devices) {
+    const size_t memory_budget = device.first == ExecutorDeviceType::GPU
+                                     ? config.gpu_memory_budget
+                                     : config.cpu_memory_budget;
+    auto& state = states_.at(device);
+    // A single query is always admitted, even if it doesn't fit the memory budget.
+    if (*state.waiting.begin() != key ||
+        state.running_queries >= maxQueries(config, device) ||
+        (memory_budget && state.running_queries &&
+         state.reserved_memory + memory_reservation > memory_budget)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+size_t QueryScheduler::sumOverDevices(ExecutorDeviceType device_type, T getter) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t res = 0;
+  for (auto& [device, state] : states_) {
+    if (device.first == device_type) {
+      res += getter(state);
+    }
+  }
+  return res;
+}
+
+size_t QueryScheduler::getRunningQueries(ExecutorDeviceType device_type) const {
+  return sumOverDevices(device_type,
+                        [](const DeviceState& state) { return state.running_queries; });
+}
+
+size_t QueryScheduler::getWaitingQueries(ExecutorDeviceType device_type) const {
+  return sumOverDevices(device_type,
+                        [](const DeviceState& state) { return state.waiting.size(); });
+}
+
+size_t QueryScheduler::getReservedMemory(ExecutorDeviceType device_type) const {
+  return sumOverDevices(device_type,
+                        [](const DeviceState& state) { return state.reserved_memory; });
+}
+
+size_t QueryScheduler::getRunningQueries(const Device& device) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = states_.find(device);
+  return it == states_.end() ? 0 : it->second.running_queries;
+}
+
+size_t QueryScheduler::getReservedMemory(const Device& device) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = states_.find(device);
+  return it == states_.end() ? 0 : it->second.reserved_memory;
+}
+
+size_t QueryScheduler::getPreemptedQueries() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return preempted_queries_;
+}
+
+void QueryScheduler::release(const Ticket& ticket) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& device : ticket.devices_) {
+      auto& state = states_.at(device);
+      CHECK_GE(state.reserved_memory, ticket.memory_reservation_);
+      state.reserved_memory -= ticket.memory_reservation_;
+      if (!ticket.preempted_) {
+        CHECK_GT(state.running_queries, size_t(0));
+        --state.running_queries;
+      }
+    }
+    if (ticket.preempted_) {
+      CHECK_GT(preempted_queries_, size_t(0));
+      --preempted_queries_;
+    }
+  }
+  cv_.notify_all();
+}
@@ -0,0 +1,135 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Shared/Config.h"
+#include "Shared/DeviceType.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <utility>
+
+/**
+ * Process-wide admission control for kernel launches of concurrent queries. Before
+ * launching kernels, a query is admitted on the devices its kernels run on and holds
+ * a ticket until its kernels are done. Devices are arbitrated independently: a query
+ * waits while the number of running queries on any of its devices reaches the
+ * configured limit or while its reserved output buffer memory doesn't fit the
+ * configured budget of the device. Waiting queries of a device are admitted in the
+ * order of priority (higher first) and then arrival. The order is the same on all
+ * devices, so queries waiting on several devices can't block each other, and
+ * queries on other devices are not delayed.
+ *
+ * With preemption enabled, a running query checks its ticket before starting each
+ * kernel or sub-task. When a query of higher priority waits for a query slot on one of
+ * its devices, the running query gives up its slots (but keeps its memory reservation,
+ * its partial results stay allocated) and defers its remaining work until it's
+ * resumed. Kernels and sub-tasks already running are not interrupted.
+ */
+class QueryScheduler {
+ public:
+  // Device type and id. All CPU kernels run on the device 0.
+  using Device = std::pair<ExecutorDeviceType, int>;
+
+  class Ticket {
+   public:
+    Ticket(const Ticket&) = delete;
+    Ticket& operator=(const Ticket&) = delete;
+    ~Ticket();
+
+   private:
+    Ticket(QueryScheduler* scheduler,
+           std::set<Device> devices,
+           size_t memory_reservation,
+           int priority)
+        : scheduler_(scheduler)
+        , devices_(std::move(devices))
+        , memory_reservation_(memory_reservation)
+        , priority_(priority) {}
+
+    QueryScheduler* scheduler_;
+    std::set<Device> devices_;
+    size_t memory_reservation_;
+    int priority_;
+    // Set when the query gave up its slots to a query of higher priority.
+    bool preempted_ = false;
+
+    friend class QueryScheduler;
+  };
+
+  using TicketPtr = std::unique_ptr<Ticket>;
+
+  static QueryScheduler& get();
+
+  // Blocks until the query can be executed on all specified devices. The memory
+  // reservation is made on each of the devices.
+  TicketPtr admit(const QuerySchedulerConfig& config,
+                  std::set<Device> devices,
+                  size_t memory_reservation,
+                  int priority);
+
+  // Returns true if the query should defer the work it didn't start yet. Releases
+  // the slots of the ticket if a query of higher priority waits for them.
+  bool preempt(const QuerySchedulerConfig& config, Ticket& ticket);
+  // Blocks until a preempted query can continue and takes its slots back.
+  void resume(const QuerySchedulerConfig& config, Ticket& ticket);
+
+  // Totals over all devices of the type.
+  size_t getRunningQueries(ExecutorDeviceType device_type) const;
+  size_t getWaitingQueries(ExecutorDeviceType device_type) const;
+  size_t getReservedMemory(ExecutorDeviceType device_type) const;
+
+  size_t getRunningQueries(const Device& device) const;
+  size_t getReservedMemory(const Device& device) const;
+  size_t getPreemptedQueries() const;
+
+ private:
+  // Waiting queries are ordered by negated priority and arrival number.
+  using WaitKey = std::pair<int64_t, uint64_t>;
+
+  struct DeviceState {
+    size_t running_queries = 0;
+    size_t reserved_memory = 0;
+    std::set<WaitKey> waiting;
+  };
+
+  bool canAdmit(const QuerySchedulerConfig& config,
+                const std::set<Device>& devices,
+                size_t memory_reservation,
+                const WaitKey& key) const;
+  // Waits for the query slots on all devices and takes them.
+  void acquire(std::unique_lock<std::mutex>& lock,
+               const QuerySchedulerConfig& config,
+               const std::set<Device>& devices,
+               size_t memory_reservation,
+               int priority);
+  void release(const Ticket& ticket);
+
+  // Zero limit in config means no limit.
+  static size_t maxQueries(const QuerySchedulerConfig& config, const Device& device);
+
+  template <typename T>
+  size_t sumOverDevices(ExecutorDeviceType device_type, T getter) const;
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  std::map<Device, DeviceState> states_;
+  uint64_t next_arrival_ = 0;
+  size_t preempted_queries_ = 0;
+};
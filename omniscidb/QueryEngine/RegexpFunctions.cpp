@@ -15,3 +15,28 @@
  */
 
 #include "../Utils/Regexp.cpp"
+#include "../Utils/RegexpMatcher.h"
+
+/*
+ * @brief regexp_matches performs the SQL REGEXP operation with patterns compiled
+ * before the query runs, see RowSetMemoryOwner::getOrAddRegexpMatcher().
+ * @param str string argument to be matched against patterns.
+ * @param str_len length of str
+ * @param matcher_handle address of the RegexpMatcher
+ * @return true if str matches one of the patterns, false otherwise.
+ */
+extern "C" RUNTIME_EXPORT bool regexp_matches(const char* str,
+                                              const int32_t str_len,
+                                              const int64_t matcher_handle) {
+  return reinterpret_cast<const RegexpMatcher*>(matcher_handle)->matches(str, str_len);
+}
+
+extern "C" RUNTIME_EXPORT int8_t regexp_matches_nullable(const char* str,
+                                                         const int32_t str_len,
+                                                         const int64_t matcher_handle,
+                                                         const int8_t bool_null) {
+  if (!str) {
+    return bool_null;
+  }
+  return regexp_matches(str, str_len, matcher_handle);
+}
@@ -30,6 +30,7 @@
 #include "ResultSetRegistry/ResultSetRegistry.h"
 #include "ScalarExprVisitor.h"
 #include "Shared/sqldefs.h"
+#include "Shared/sqltypes.h"
 
 #include <rapidjson/error/en.h>
 #include <rapidjson/error/error.h>
@@ -421,6 +422,22 @@ hdk::ir::ExprPtr parseLiteral(const rapidjson::Value& expr) {
   return nullptr;
 }
 
+hdk::ir::ExprPtr parseDynamicParam(const rapidjson::Value& expr,
+                                   const RelAlgDagBuilder& root_dag_builder) {
+  const auto idx = json_i64(field(expr, "dynamic_param"));
+  auto type = parseType(field(expr, "type"));
+  const auto& params = root_dag_builder.queryParams();
+  if (idx < 0 || static_cast<size_t>(idx) >= params.size()) {
+    throw std::runtime_error("No value is bound to query parameter #" +
+                             std::to_string(idx + 1) + ".");
+  }
+  if (type->isString()) {
+    return Analyzer::analyzeStringValue(params[idx]);
+  }
+  return hdk::ir::makeExpr<hdk::ir::Constant>(
+      type->withNullable(false), false, StringToDatum(params[idx], type));
+}
+
 hdk::ir::ExprPtr parse_case_expr(const rapidjson::Value& expr,
                                  int db_id,
                                  SchemaProviderPtr schema_provider,
@@ -1436,6 +1453,9 @@ hdk::ir::ExprPtr parse_expr(const rapidjson::Value& expr,
   if (expr.IsObject() && expr.HasMember("literal")) {
     return parseLiteral(expr);
   }
+  if (expr.IsObject() && expr.HasMember("dynamic_param")) {
+    return parseDynamicParam(expr, root_dag_builder);
+  }
   if (expr.IsObject() && expr.HasMember("op")) {
     hdk::ir::ExprPtr res;
     const auto op_str = json_str(field(expr, "op"));
@@ -2409,18 +2429,31 @@ RelAlgDagBuilder::RelAlgDagBuilder(RelAlgDagBuilder& root_dag_builder,
 RelAlgDagBuilder::RelAlgDagBuilder(const rapidjson::Value& query_ast,
                                    int db_id,
                                    SchemaProviderPtr schema_provider,
-                                   ConfigPtr config)
-    : hdk::ir::QueryDag(config), db_id_(db_id), schema_provider_(schema_provider) {
+                                   ConfigPtr config,
+                                   std::vector<std::string> query_params)
+    : hdk::ir::QueryDag(config)
+    , db_id_(db_id)
+    , schema_provider_(schema_provider)
+    , query_params_(std::move(query_params)) {
   build(query_ast, *this);
 }
 
 RelAlgDagBuilder::RelAlgDagBuilder(const std::string& query_ra,
                                    int db_id,
                                    SchemaProviderPtr schema_provider,
-                                   ConfigPtr config)
-    : hdk::ir::QueryDag(config), db_id_(db_id), schema_provider_(schema_provider) {
+                                   ConfigPtr config,
+                                   std::vector<std::string> query_params)
+    : hdk::ir::QueryDag(config)
+    , db_id_(db_id)
+    , schema_provider_(schema_provider)
+    , query_params_(std::move(query_params)) {
+  // Parse a copy of the plan in place. Strings of the parsed document point into the
+  // buffer instead of being allocated one by one, which matters for plans with
+  // thousands of literals. The buffer has to outlive the document.
+  std::vector<char> query_ra_buf(query_ra.begin(), query_ra.end());
+  query_ra_buf.push_back('\0');
   rapidjson::Document query_ast;
-  query_ast.Parse(query_ra.c_str());
+  query_ast.ParseInsitu(query_ra_buf.data());
   VLOG(2) << "Parsing query RA JSON: " << query_ra;
   if (query_ast.HasParseError()) {
     query_ast.GetParseError();
@@ -2473,6 +2506,7 @@ void RelAlgDagBuilder::build(const rapidjson::Value& query_ast,
   separate_window_function_expressions(nodes_);
   add_window_function_pre_project(
       nodes_, false /* always_add_project_if_first_project_is_window_expr */);
+  add_window_function_limits(nodes_);
   CHECK(nodes_.size());
   CHECK(nodes_.back().use_count() == 1);
   root_ = nodes_.back();
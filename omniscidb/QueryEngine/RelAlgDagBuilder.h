@@ -57,16 +57,20 @@ class RelAlgDagBuilder : public hdk::ir::QueryDag, public boost::noncopyable {
    * @param query_ra A JSON string representation of an RA tree from Calcite.
    * @param db_id ID of the current database.
    * @param schema_provider The source of schema information.
+   * @param query_params Values bound to dynamic parameters of the query in their
+   * textual form.
    */
   RelAlgDagBuilder(const std::string& query_ra,
                    int db_id,
                    SchemaProviderPtr schema_provider,
-                   ConfigPtr config);
+                   ConfigPtr config,
+                   std::vector<std::string> query_params = {});
 
   RelAlgDagBuilder(const rapidjson::Value& query_ast,
                    int db_id,
                    SchemaProviderPtr schema_provider,
-                   ConfigPtr config);
+                   ConfigPtr config,
+                   std::vector<std::string> query_params = {});
 
   /**
    * Constructs a sub-DAG for any subqueries. Should only be called during DAG
@@ -84,6 +88,8 @@ class RelAlgDagBuilder : public hdk::ir::QueryDag, public boost::noncopyable {
 
   const Config& config() const { return *config_; }
 
+  const std::vector<std::string>& queryParams() const { return query_params_; }
+
   std::unique_ptr<RelAlgDagBuilder> not_coalesced;
 
  private:
@@ -91,6 +97,7 @@ class RelAlgDagBuilder : public hdk::ir::QueryDag, public boost::noncopyable {
 
   int db_id_;
   SchemaProviderPtr schema_provider_;
+  std::vector<std::string> query_params_;
 };
 
 std::string tree_string(const hdk::ir::Node*, const size_t depth = 0);
@@ -146,6 +146,7 @@ struct RelAlgExecutionUnit {
 
   std::shared_ptr<costmodel::CostModel> cost_model;
   std::vector<costmodel::AnalyticalTemplate> templs;
+  std::optional<costmodel::QueryFeatures> features{std::nullopt};
 };
 
 std::ostream& operator<<(std::ostream& os, const RelAlgExecutionUnit& ra_exe_unit);
@@ -16,10 +16,12 @@
 
 #include "RelAlgExecutor.h"
 #include "DataMgr/DataMgr.h"
+#include "IR/ExprVisitor.h"
 #include "IR/TypeUtils.h"
 #include "QueryEngine/CalciteDeserializerUtils.h"
 #include "QueryEngine/CardinalityEstimator.h"
 #include "QueryEngine/ColumnFetcher.h"
+#include "QueryEngine/DataRecycler/ResultSetRecycler.h"
 #include "QueryEngine/EquiJoinCondition.h"
 #include "QueryEngine/ErrorHandling.h"
 #include "QueryEngine/ExpressionRewrite.h"
@@ -34,6 +36,7 @@
 #include "QueryEngine/RelAlgTranslator.h"
 #include "QueryEngine/RelAlgVisitor.h"
 #include "QueryEngine/ResultSetBuilder.h"
+#include "QueryEngine/ResultSetReduction.h"
 #include "QueryEngine/ResultSetSort.h"
 #include "QueryEngine/WindowContext.h"
 #include "QueryEngine/WorkUnitBuilder.h"
@@ -44,15 +47,19 @@
 #include "SessionInfo.h"
 #include "Shared/funcannotations.h"
 #include "Shared/measure.h"
+#include "Shared/Metrics.h"
 #include "Shared/misc.h"
 
 #include <boost/algorithm/cxx11/any_of.hpp>
+#include <boost/algorithm/string.hpp>
+#include <boost/functional/hash.hpp>
 #include <boost/make_unique.hpp>
 #include <boost/range/adaptor/reversed.hpp>
 
 #include <algorithm>
 #include <functional>
 #include <numeric>
+#include <set>
 
 using namespace std::string_literals;
 
@@ -68,7 +75,7 @@ bool is_projection(const RelAlgExecutionUnit& ra_exe_unit) {
   return ra_exe_unit.groupby_exprs.size() == 1 && !ra_exe_unit.groupby_exprs.front();
 }
 
-bool should_output_columnar(const RelAlgExecutionUnit& ra_exe_unit) {
+bool can_output_columnar(const RelAlgExecutionUnit& ra_exe_unit) {
   if (!is_projection(ra_exe_unit)) {
     return false;
   }
@@ -83,8 +90,12 @@ bool should_output_columnar(const RelAlgExecutionUnit& ra_exe_unit) {
       return false;
     }
   }
+  return true;
+}
 
-  return ra_exe_unit.scan_limit >= g_columnar_large_projections_threshold;
+bool should_output_columnar(const RelAlgExecutionUnit& ra_exe_unit) {
+  return can_output_columnar(ra_exe_unit) &&
+         ra_exe_unit.scan_limit >= g_columnar_large_projections_threshold;
 }
 
 bool is_extracted_dag_valid(ExtractedPlanDag& dag) {
@@ -92,6 +103,32 @@ bool is_extracted_dag_valid(ExtractedPlanDag& dag) {
          dag.extracted_dag.compare(EMPTY_QUERY_PLAN) != 0;
 }
 
+// Mark tables listed in the config as GPU resident. Tables are resolved by name in
+// all databases of the schema provider, so tables created after the previous query
+// are marked too.
+void add_gpu_resident_tables(const Config& config,
+                             const SchemaProvider& schema_provider,
+                             Data_Namespace::DataMgr* data_mgr) {
+  if (!config.mem.gpu.enable_cost_aware_eviction ||
+      config.mem.gpu.resident_tables.empty()) {
+    return;
+  }
+  std::vector<std::string> table_names;
+  boost::split(table_names, config.mem.gpu.resident_tables, boost::is_any_of(","));
+  for (auto& table_name : table_names) {
+    boost::trim(table_name);
+    if (table_name.empty()) {
+      continue;
+    }
+    for (auto db_id : schema_provider.listDatabases()) {
+      auto table_info = schema_provider.getTableInfo(db_id, table_name);
+      if (table_info) {
+        data_mgr->addGpuResidentTable(table_info->db_id, table_info->table_id);
+      }
+    }
+  }
+}
+
 }  // namespace
 
 RelAlgExecutor::RelAlgExecutor(Executor* executor, SchemaProviderPtr schema_provider)
@@ -157,15 +194,54 @@ ExecutionResult RelAlgExecutor::executeRelAlgQuery(const CompilationOptions& co,
   CHECK(query_dag_);
   auto timer = DEBUG_TIMER(__func__);
   INJECT_TIMER(executeRelAlgQuery);
+  static auto& latency_metric = metrics::Registry::get().histogram(
+      "hdk_query_duration_seconds", "Query latency including the wait for the executor.");
+  auto latency_clock = timer_start();
+  ScopeGuard observe_latency = [&latency_clock] {
+    latency_metric.observe(
+        timer_stop<decltype(latency_clock), std::chrono::microseconds>(latency_clock) /
+        1e6);
+  };
+  std::lock_guard<std::mutex> execution_lock(executor_->getQueryExecutionMutex());
+  {
+    std::lock_guard<std::mutex> interrupt_lock(interrupt_mutex_);
+    if (interrupt_requested_) {
+      throw std::runtime_error(getErrorMessageFromCode(Executor::ERR_INTERRUPTED));
+    }
+    running_ = true;
+  }
+  ScopeGuard reset_running = [this] {
+    std::lock_guard<std::mutex> interrupt_lock(interrupt_mutex_);
+    running_ = false;
+    if (interrupt_requested_) {
+      // The query might finish before the interrupt check, don't let the flag
+      // interrupt the next query of the executor.
+      executor_->resetInterrupt();
+    }
+  };
+
+  if (co.device_type == ExecutorDeviceType::GPU) {
+    add_gpu_resident_tables(config_, *schema_provider_, executor_->getDataMgr());
+  }
 
   auto run_query = [&](const CompilationOptions& co_in) {
-    auto execution_result = executeRelAlgQueryNoRetry(co_in, eo, just_explain_plan);
+    // A retried query gets a new profile.
+    QueryProfilePtr query_profile =
+        eo.with_profile ? std::make_shared<QueryProfile>() : nullptr;
+    executor_->setQueryProfile(query_profile.get());
+    ScopeGuard reset_profile = [this] { executor_->setQueryProfile(nullptr); };
+    // Limit the number of CPU threads used by parallel loops of the query.
+    auto execution_result =
+        threading::execute_with_concurrency_limit(eo.cpu_threads_budget, [&]() {
+          return executeRelAlgQueryNoRetry(co_in, eo, just_explain_plan);
+        });
 
     constexpr bool vlog_result_set_summary{false};
     if constexpr (vlog_result_set_summary) {
       VLOG(1) << execution_result.getRows()->summaryToString();
     }
     execution_result.getRows()->moveToBegin();
+    execution_result.setProfile(query_profile);
 
     if (post_execution_callback_) {
       VLOG(1) << "Running post execution callback.";
@@ -187,6 +263,14 @@ ExecutionResult RelAlgExecutor::executeRelAlgQuery(const CompilationOptions& co,
   return run_query(co_cpu);
 }
 
+void RelAlgExecutor::interrupt() {
+  std::lock_guard<std::mutex> interrupt_lock(interrupt_mutex_);
+  interrupt_requested_ = true;
+  if (running_) {
+    executor_->interrupt();
+  }
+}
+
 void printTree(const hdk::ir::Node* node, std::string prefix = "|") {
   std::cout << prefix << node->toString() << std::endl;
   for (size_t i = 0; i < node->inputCount(); ++i) {
@@ -194,6 +278,50 @@ void printTree(const hdk::ir::Node* node, std::string prefix = "|") {
   }
 }
 
+namespace {
+
+// Tables are only appended to, so their row and fragment counts tell whether a
+// result computed for them is outdated.
+size_t get_input_tables_state(const hdk::ir::Node* node,
+                              const SchemaProvider& schema_provider) {
+  const auto table_ids = get_physical_table_inputs(node);
+  std::set<std::pair<int, int>> sorted_table_ids(table_ids.begin(), table_ids.end());
+  size_t res = 0;
+  for (auto& [db_id, table_id] : sorted_table_ids) {
+    boost::hash_combine(res, db_id);
+    boost::hash_combine(res, table_id);
+    if (auto table_info = schema_provider.getTableInfo(db_id, table_id)) {
+      boost::hash_combine(res, table_info->row_count);
+      boost::hash_combine(res, table_info->fragments);
+    }
+  }
+  return res;
+}
+
+// Nodes of DAGs built by QueryBuilder are shared by queries and keep results of
+// previous executions. Nodes holding results are used as materialized inputs, so
+// drop the results which are not valid for the current query.
+void drop_outdated_node_results(const hdk::ir::Node* node,
+                                const SchemaProvider& schema_provider,
+                                bool allow_reuse,
+                                std::unordered_set<const hdk::ir::Node*>& visited) {
+  if (!visited.insert(node).second) {
+    return;
+  }
+  if (node->getResult()) {
+    const auto& state = node->getResultInputTablesState();
+    if (allow_reuse && state && *state == get_input_tables_state(node, schema_provider)) {
+      return;
+    }
+    node->setResult(nullptr);
+  }
+  for (size_t i = 0; i < node->inputCount(); ++i) {
+    drop_outdated_node_results(node->getInput(i), schema_provider, allow_reuse, visited);
+  }
+}
+
+}  // namespace
+
 ExecutionResult RelAlgExecutor::executeRelAlgQueryNoRetry(const CompilationOptions& co,
                                                           const ExecutionOptions& eo,
                                                           const bool just_explain_plan) {
@@ -218,6 +346,9 @@ ExecutionResult RelAlgExecutor::executeRelAlgQueryNoRetry(const CompilationOptio
   executor_->setupCaching(data_provider_, col_descs, phys_table_ids);
 
   ScopeGuard restore_metainfo_cache = [this] { executor_->clearMetaInfoCache(); };
+  std::unordered_set<const hdk::ir::Node*> visited_nodes;
+  drop_outdated_node_results(
+      ra, *schema_provider_, config_.cache.reuse_node_results, visited_nodes);
   hdk::QueryExecutionSequence query_seq(ra, executor_->getConfigPtr());
   if (just_explain_plan) {
     std::stringstream ss;
@@ -333,11 +464,39 @@ void RelAlgExecutor::prepareLeafExecution(
   queue_time_ms_ = timer_stop(clock_begin);
   executor_->row_set_mem_owner_ = std::make_shared<RowSetMemoryOwner>(
       data_provider_, Executor::getArenaBlockSize(), cpu_threads());
+  executor_->row_set_mem_owner_->setMemoryTracker(
+      std::make_shared<Data_Namespace::QueryMemoryTracker>(
+          executor_->getDataMgr()->getMemoryAccounting()));
   executor_->string_dictionary_generations_ = string_dictionary_generations;
   executor_->table_generations_ = table_generations;
   executor_->agg_col_range_cache_ = agg_col_range;
 }
 
+namespace {
+
+std::string step_node_name(const hdk::ir::Node* node) {
+  if (node->is<hdk::ir::Scan>()) {
+    return "Scan";
+  } else if (node->is<hdk::ir::Project>()) {
+    return "Project";
+  } else if (node->is<hdk::ir::Aggregate>()) {
+    return "Aggregate";
+  } else if (node->is<hdk::ir::Join>() || node->is<hdk::ir::TranslatedJoin>()) {
+    return "Join";
+  } else if (node->is<hdk::ir::Filter>()) {
+    return "Filter";
+  } else if (node->is<hdk::ir::Sort>()) {
+    return "Sort";
+  } else if (node->is<hdk::ir::LogicalValues>()) {
+    return "LogicalValues";
+  } else if (node->is<hdk::ir::LogicalUnion>()) {
+    return "Union";
+  }
+  return "Node";
+}
+
+}  // namespace
+
 std::shared_ptr<const ExecutionResult> RelAlgExecutor::execute(
     const hdk::QueryExecutionSequence& seq,
     const CompilationOptions& co,
@@ -373,11 +532,33 @@ std::shared_ptr<const ExecutionResult> RelAlgExecutor::execute(
   };
 
   const auto exec_desc_count = get_descriptor_count();
+  std::unordered_map<size_t, std::future<void>> step_compilations;
+  // Background compilation can't be attributed to steps of a profile.
+  if (config_.exec.codegen.enable_parallel_step_compilation && !eo.just_explain &&
+      !executor_->getQueryProfile() && co.device_type == ExecutorDeviceType::CPU &&
+      exec_desc_count > 1) {
+    step_compilations = precompileIndependentSteps(seq, co, eo);
+  }
   // this join info needs to be maintained throughout an entire query runtime
   for (size_t i = 0; i < exec_desc_count; i++) {
+    auto compilation_it = step_compilations.find(i);
+    if (compilation_it != step_compilations.end()) {
+      // Background compilation uses the step node, so it has to be finished
+      // before the step is executed.
+      compilation_it->second.wait();
+    }
     VLOG(1) << "Executing query step " << i;
+    auto step_eo = eo;
+    step_eo.intermediate_result = i + 1 < exec_desc_count;
+    step_eo.multifrag_result |=
+        step_eo.intermediate_result && config_.exec.enable_multifrag_rs;
+    auto query_profile = executor_->getQueryProfile();
+    auto step_clock = timer_start();
+    if (query_profile) {
+      query_profile->beginStep(seq.step(i)->getId(), step_node_name(seq.step(i)));
+    }
     try {
-      executeStep(seq.step(i), co, eo, queue_time_ms);
+      executeStep(seq.step(i), co, step_eo, queue_time_ms);
     } catch (const QueryMustRunOnCpu&) {
       CHECK(co.device_type == ExecutorDeviceType::GPU);
       if (!config_.exec.heterogeneous.allow_query_step_cpu_retry) {
@@ -385,15 +566,24 @@ std::shared_ptr<const ExecutionResult> RelAlgExecutor::execute(
       }
       LOG(INFO) << "Retrying current query step " << i << " on CPU";
       const auto co_cpu = CompilationOptions::makeCpuOnly(co);
-      executeStep(seq.step(i), co_cpu, eo, queue_time_ms);
+      executeStep(seq.step(i), co_cpu, step_eo, queue_time_ms);
     } catch (const NativeExecutionError&) {
       if (!config_.exec.enable_interop) {
         throw;
       }
-      auto eo_extern = eo;
+      auto eo_extern = step_eo;
       eo_extern.executor_type = ::ExecutorType::Extern;
       executeStep(seq.step(i), co, eo_extern, queue_time_ms);
     }
+    if (query_profile) {
+      auto step_res = seq.step(i)->getResult();
+      query_profile->endStep(
+          timer_stop<decltype(step_clock), std::chrono::microseconds>(step_clock),
+          step_res && !step_res->empty() ? step_res->getToken()->rowCount() : 0);
+    }
+    if (progress_callback_) {
+      progress_callback_(i + 1, exec_desc_count);
+    }
   }
 
   return seq.step(exec_desc_count - 1)->getResult();
@@ -592,6 +782,93 @@ bool is_agg_step(const hdk::ir::Node* node) {
   return false;
 }
 
+// Returns true iff the group-by result of the execution unit can be computed by
+// reducing results computed for disjoint sets of fragments of its input table.
+bool is_reducible_group_by(const RelAlgExecutionUnit& ra_exe_unit) {
+  if (ra_exe_unit.input_descs.size() != 1 || !ra_exe_unit.join_quals.empty() ||
+      ra_exe_unit.groupby_exprs.empty() || !ra_exe_unit.groupby_exprs.front() ||
+      !ra_exe_unit.sort_info.order_entries.empty() || ra_exe_unit.scan_limit ||
+      ra_exe_unit.estimator || ra_exe_unit.union_all) {
+    return false;
+  }
+  for (auto target_expr : ra_exe_unit.target_exprs) {
+    if (auto agg_expr = dynamic_cast<const hdk::ir::AggExpr*>(target_expr)) {
+      switch (agg_expr->aggType()) {
+        case hdk::ir::AggType::kAvg:
+        case hdk::ir::AggType::kMin:
+        case hdk::ir::AggType::kMax:
+        case hdk::ir::AggType::kSum:
+          break;
+        case hdk::ir::AggType::kCount:
+          if (agg_expr->isDistinct()) {
+            return false;
+          }
+          break;
+        default:
+          return false;
+      }
+      continue;
+    }
+    auto var = dynamic_cast<const hdk::ir::Var*>(target_expr);
+    if (!var || var->whichRow() != hdk::ir::Var::kGROUPBY) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns true iff the result sets have the same layout and can be reduced.
+bool can_reduce_result_sets(const ResultSet& lhs, const ResultSet& rhs) {
+  if (!lhs.getStorage() || !rhs.getStorage() ||
+      lhs.getRowSetMemOwner() != rhs.getRowSetMemOwner() ||
+      !lhs.getSerializedVarlenBuffer().empty() ||
+      !rhs.getSerializedVarlenBuffer().empty()) {
+    return false;
+  }
+  const auto& lhs_desc = lhs.getQueryMemDesc();
+  const auto& rhs_desc = rhs.getQueryMemDesc();
+  switch (lhs_desc.getQueryDescriptionType()) {
+    case QueryDescriptionType::GroupByPerfectHash:
+      // Perfect hash buffers are reduced entry by entry.
+      if (lhs_desc.getEntryCount() != rhs_desc.getEntryCount()) {
+        return false;
+      }
+      break;
+    case QueryDescriptionType::GroupByBaselineHash:
+      break;
+    default:
+      return false;
+  }
+  return lhs_desc == rhs_desc;
+}
+
+// Returns indices of fragments appended to the table after the cached result was
+// computed, or nothing if previously existing fragments were modified.
+std::optional<std::vector<size_t>> get_appended_fragment_indices(
+    const TableFragmentsInfo& table_info,
+    int table_id,
+    const ResultSetCacheMetaInfo& cached_meta_info) {
+  auto frag_count_it = cached_meta_info.fragment_counts.find(table_id);
+  const auto& cached_generations = cached_meta_info.table_generations.asMap();
+  auto generation_it = cached_generations.find(table_id);
+  if (frag_count_it == cached_meta_info.fragment_counts.end() ||
+      generation_it == cached_generations.end() ||
+      frag_count_it->second >= table_info.fragments.size()) {
+    return std::nullopt;
+  }
+  size_t cached_tuple_count = 0;
+  for (size_t frag_idx = 0; frag_idx < frag_count_it->second; ++frag_idx) {
+    cached_tuple_count += table_info.fragments[frag_idx].getPhysicalNumTuples();
+  }
+  // The last cached fragment could be filled up with appended rows.
+  if (cached_tuple_count != static_cast<size_t>(generation_it->second.tuple_count)) {
+    return std::nullopt;
+  }
+  std::vector<size_t> res(table_info.fragments.size() - frag_count_it->second);
+  std::iota(res.begin(), res.end(), frag_count_it->second);
+  return res;
+}
+
 }  // namespace
 
 hdk::ir::ExprPtr set_transient_dict(const hdk::ir::ExprPtr expr) {
@@ -642,7 +919,13 @@ void RelAlgExecutor::executeStep(const hdk::ir::Node* step_root,
   }
 
   auto shared_res = std::make_shared<ExecutionResult>(std::move(res));
-  step_root->setResult(shared_res);
+  // Results of partial executions can't be reused by other queries.
+  std::optional<size_t> input_tables_state;
+  if (!eo.just_explain && eo.outer_fragment_indices.empty() && eo.sample_rate == 1.0 &&
+      !shared_res->isFilterPushDownEnabled()) {
+    input_tables_state = get_input_tables_state(step_root, *schema_provider_);
+  }
+  step_root->setResult(shared_res, input_tables_state);
   // Logical values are always executed and ignore just_explain flag.
   if (!eo.just_explain || step_root->is<hdk::ir::LogicalValues>()) {
     addTemporaryTable(-step_root->getId(), shared_res->getToken());
@@ -664,9 +947,142 @@ ExecutionResult RelAlgExecutor::executeStep(const hdk::ir::Node* step_root,
 
   WorkUnit work_unit = createWorkUnit(step_root, co, eo, allow_speculative_sort);
 
+  // Reuse the result of the same step computed for unmodified input tables.
+  auto result_set_recycler = executor_->getResultSetRecycler();
+  std::optional<std::pair<QueryPlanHash, ResultSetCacheMetaInfo>> cache_key;
+  if (result_set_recycler->isEnabled() && !eo.just_explain && !eo.just_validate &&
+      work_unit.exe_unit.query_plan_dag != EMPTY_QUERY_PLAN) {
+    cache_key = ResultSetRecycler::getResultSetCacheKey(
+        work_unit.exe_unit.query_plan_dag,
+        get_physical_table_inputs(step_root),
+        executor_);
+    if (auto cached_res =
+            result_set_recycler->getItemFromCache(cache_key->first,
+                                                  CacheItemType::QUERY_RESULT_SET,
+                                                  RESULT_SET_CACHE_DEVICE_IDENTIFIER,
+                                                  cache_key->second)) {
+      // Cached result sets might have been iterated by previous consumers.
+      auto token = cached_res->getToken();
+      for (size_t i = 0; i < token->resultSetCount(); ++i) {
+        token->resultSet(i)->moveToBegin();
+      }
+      return *cached_res;
+    }
+  }
+
+  auto clock_begin = timer_start();
+  std::optional<ExecutionResult> incremental_res;
+  if (cache_key && config_.cache.use_incremental_result_set_cache) {
+    auto outdated = result_set_recycler->getOutdatedItemFromCache(
+        cache_key->first,
+        CacheItemType::QUERY_RESULT_SET,
+        RESULT_SET_CACHE_DEVICE_IDENTIFIER,
+        cache_key->second);
+    if (outdated) {
+      incremental_res = executeStepIncrementally(step_root,
+                                                 work_unit,
+                                                 co,
+                                                 eo,
+                                                 queue_time_ms,
+                                                 *outdated->first,
+                                                 outdated->second);
+    }
+  }
+  auto res = incremental_res
+                 ? std::move(*incremental_res)
+                 : executeStepWorkUnit(step_root, work_unit, co, eo, queue_time_ms);
+  if (cache_key && !res.empty() && !res.isFilterPushDownEnabled()) {
+    result_set_recycler->putItemToCache(cache_key->first,
+                                        std::make_shared<const ExecutionResult>(res),
+                                        CacheItemType::QUERY_RESULT_SET,
+                                        RESULT_SET_CACHE_DEVICE_IDENTIFIER,
+                                        ResultSetRecycler::getResultSetSize(res),
+                                        timer_stop(clock_begin),
+                                        cache_key->second);
+  }
+  return res;
+}
+
+std::optional<ExecutionResult> RelAlgExecutor::executeStepIncrementally(
+    const hdk::ir::Node* step_root,
+    WorkUnit& work_unit,
+    const CompilationOptions& co,
+    const ExecutionOptions& eo,
+    const int64_t queue_time_ms,
+    const ExecutionResult& cached_res,
+    const ResultSetCacheMetaInfo& cached_meta_info) {
+  if (step_root->is<hdk::ir::Sort>() || !is_agg_step(step_root) ||
+      !is_reducible_group_by(work_unit.exe_unit)) {
+    return std::nullopt;
+  }
+  auto cached_token = cached_res.getToken();
+  if (!cached_token || cached_token->resultSetCount() != 1) {
+    return std::nullopt;
+  }
+  auto cached_rows = cached_token->resultSet(0);
+  const auto& input_desc = work_unit.exe_unit.input_descs.front();
+  const auto table_info =
+      executor_->getTableInfo(input_desc.getDatabaseId(), input_desc.getTableId());
+  auto appended_fragments = get_appended_fragment_indices(
+      table_info, input_desc.getTableId(), cached_meta_info);
+  if (!appended_fragments) {
+    return std::nullopt;
+  }
+  VLOG(1) << "Aggregate " << appended_fragments->size()
+          << " appended fragment(s) to update the cached result of step "
+          << step_root->getIdString();
+
+  // Results can be reduced only when they share the row set memory owner.
+  auto row_set_mem_owner = executor_->row_set_mem_owner_;
+  executor_->row_set_mem_owner_ = cached_rows->getRowSetMemOwner();
+  ScopeGuard restore_row_set_mem_owner = [this, row_set_mem_owner] {
+    executor_->row_set_mem_owner_ = row_set_mem_owner;
+  };
+  auto eo_appended = eo;
+  eo_appended.outer_fragment_indices = *appended_fragments;
+  auto appended_res = executeWorkUnit(
+      work_unit, step_root->getOutputMetainfo(), true, co, eo_appended, queue_time_ms);
+  if (appended_res.empty() || appended_res.isFilterPushDownEnabled() ||
+      appended_res.getToken()->resultSetCount() != 1) {
+    return std::nullopt;
+  }
+  auto appended_rows = appended_res.getToken()->resultSet(0);
+  if (appended_rows->definitelyHasNoRows()) {
+    cached_rows->moveToBegin();
+    return cached_res;
+  }
+  if (cached_rows->definitelyHasNoRows()) {
+    return appended_res;
+  }
+  if (!can_reduce_result_sets(*appended_rows, *cached_rows)) {
+    return std::nullopt;
+  }
+
+  // The cached result set might be in use, so reduce it into the new one.
+  std::vector<ResultSet*> result_sets{appended_rows.get(), cached_rows.get()};
+  ResultSetManager rs_manager;
+  rs_manager.reduce(result_sets, config_, executor_);
+  auto reduced_rows = rs_manager.getOwnResultSet();
+  if (!reduced_rows) {
+    reduced_rows = appended_rows;
+    reduced_rows->invalidateCachedRowCount();
+  }
+  return registerResultSetTable(
+      {reduced_rows}, appended_res.getTargetsMeta(), eo.just_explain);
+}
+
+ExecutionResult RelAlgExecutor::executeStepWorkUnit(const hdk::ir::Node* step_root,
+                                                    WorkUnit& work_unit,
+                                                    const CompilationOptions& co,
+                                                    const ExecutionOptions& eo,
+                                                    const int64_t queue_time_ms) {
   auto sort = step_root->as<hdk::ir::Sort>();
   ExecutionOptions eo_with_limit =
       eo.with_just_validate(eo.just_validate || (sort && sort->isEmptyResult()));
+  // Sort, limit and offset are applied to a single result set.
+  if (sort) {
+    eo_with_limit = eo_with_limit.with_multifrag_result(false);
+  }
   // Use additional result fragments sort for UNION ALL case.
   // Detect it via a check for two outer tables in the input
   // descriptors vector.
@@ -760,9 +1176,34 @@ hdk::ir::ExprPtr transform_to_inner(const hdk::ir::Expr* expr) {
   return hdk::ir::makeExpr<hdk::ir::ColumnVar>(col->columnInfo(), 1);
 }
 
+// Returns true iff the window functions have the same partitions.
+bool same_window_partitions(const hdk::ir::WindowFunction* lhs,
+                            const hdk::ir::WindowFunction* rhs) {
+  return hdk::ir::exprsEqual(lhs->partitionKeys(), rhs->partitionKeys());
+}
+
+// Returns true iff the window functions order rows within partitions the same way.
+bool same_window_order(const hdk::ir::WindowFunction* lhs,
+                       const hdk::ir::WindowFunction* rhs) {
+  if (!hdk::ir::exprsEqual(lhs->orderKeys(), rhs->orderKeys())) {
+    return false;
+  }
+  const auto& lhs_collation = lhs->collation();
+  const auto& rhs_collation = rhs->collation();
+  CHECK_EQ(lhs_collation.size(), rhs_collation.size());
+  for (size_t i = 0; i < lhs_collation.size(); ++i) {
+    if (lhs_collation[i].is_desc != rhs_collation[i].is_desc ||
+        lhs_collation[i].nulls_first != rhs_collation[i].nulls_first) {
+      return false;
+    }
+  }
+  return true;
+}
+
 }  // namespace
 
 void RelAlgExecutor::computeWindow(const RelAlgExecutionUnit& ra_exe_unit,
+                                   const hdk::ir::Node* window_node,
                                    const CompilationOptions& co,
                                    const ExecutionOptions& eo,
                                    ColumnCacheMap& column_cache_map,
@@ -778,6 +1219,42 @@ void RelAlgExecutor::computeWindow(const RelAlgExecutionUnit& ra_exe_unit,
   }
   query_infos.push_back(query_infos.front());
   auto window_project_node_context = WindowProjectNodeContext::create(executor_);
+  std::vector<const hdk::ir::WindowFunction*> window_funcs;
+  for (const auto target_expr : ra_exe_unit.target_exprs) {
+    if (auto window_func = dynamic_cast<const hdk::ir::WindowFunction*>(target_expr)) {
+      window_funcs.push_back(window_func);
+    }
+  }
+  // Window functions with the same partition keys share the partitions hash table, and
+  // those also having the same order keys share the sorted partitions. Find the first
+  // window function to compute each of them.
+  std::vector<size_t> partitions_source(window_funcs.size());
+  std::vector<size_t> sort_source(window_funcs.size());
+  std::vector<bool> keep_sorted_partitions(window_funcs.size(), false);
+  for (size_t i = 0; i < window_funcs.size(); ++i) {
+    partitions_source[i] = i;
+    sort_source[i] = i;
+    for (size_t j = 0; j < i; ++j) {
+      if (same_window_partitions(window_funcs[i], window_funcs[j])) {
+        partitions_source[i] = partitions_source[j];
+        if (same_window_order(window_funcs[i], window_funcs[j])) {
+          sort_source[i] = sort_source[j];
+          keep_sorted_partitions[sort_source[i]] = true;
+          break;
+        }
+      }
+    }
+  }
+  // Per-partition limits of window functions set for top-N-per-group filters, keyed by
+  // the target index.
+  std::map<size_t, size_t> window_func_limits;
+  auto window_project = dynamic_cast<const hdk::ir::Project*>(window_node);
+  if (window_project && config_.exec.window_func.enable_partition_limits) {
+    window_func_limits = window_project->getWindowFunctionLimits();
+    CHECK(window_func_limits.empty() ||
+          window_project->size() == ra_exe_unit.target_exprs.size());
+  }
+  std::vector<const WindowFunctionContext*> computed_contexts;
   for (size_t target_index = 0; target_index < ra_exe_unit.target_exprs.size();
        ++target_index) {
     const auto& target_expr = ra_exe_unit.target_exprs[target_index];
@@ -785,6 +1262,8 @@ void RelAlgExecutor::computeWindow(const RelAlgExecutionUnit& ra_exe_unit,
     if (!window_func) {
       continue;
     }
+    const size_t window_func_idx = computed_contexts.size();
+    CHECK_EQ(window_funcs[window_func_idx], window_func);
     // Always use baseline layout hash tables for now, make the expression a tuple.
     const auto& partition_keys = window_func->partitionKeys();
     std::shared_ptr<const hdk::ir::BinOper> partition_key_cond;
@@ -804,23 +1283,221 @@ void RelAlgExecutor::computeWindow(const RelAlgExecutionUnit& ra_exe_unit,
           partition_key_tuple,
           transform_to_inner(partition_key_tuple.get()));
     }
+    std::shared_ptr<HashJoin> partitions;
+    if (partitions_source[window_func_idx] != window_func_idx) {
+      partitions = computed_contexts[partitions_source[window_func_idx]]->partitions();
+    }
     auto context =
         createWindowFunctionContext(window_func,
                                     partition_key_cond /*nullptr if no partition key*/,
+                                    partitions,
                                     ra_exe_unit,
                                     query_infos,
                                     co,
                                     column_cache_map,
                                     executor_->getRowSetMemoryOwner());
+    if (sort_source[window_func_idx] != window_func_idx) {
+      context->reuseSortedPartitions(*computed_contexts[sort_source[window_func_idx]]);
+    } else if (keep_sorted_partitions[window_func_idx]) {
+      context->keepSortedPartitions();
+    }
+    if (auto limit_it = window_func_limits.find(target_index);
+        limit_it != window_func_limits.end()) {
+      context->setPartitionLimit(limit_it->second);
+    }
     context->compute();
+    computed_contexts.push_back(context.get());
     window_project_node_context->addWindowFunctionContext(std::move(context),
                                                           target_index);
   }
 }
 
+namespace {
+
+bool depends_on_steps(const hdk::ir::Node* node,
+                      const std::unordered_set<const hdk::ir::Node*>& steps) {
+  for (size_t i = 0; i < node->inputCount(); ++i) {
+    auto input = node->getInput(i);
+    if (steps.count(input) || depends_on_steps(input, steps)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+std::unordered_map<size_t, std::future<void>> RelAlgExecutor::precompileIndependentSteps(
+    const hdk::QueryExecutionSequence& seq,
+    const CompilationOptions& co,
+    const ExecutionOptions& eo) {
+  std::unordered_set<const hdk::ir::Node*> steps(seq.steps().begin(),
+                                                 seq.steps().end());
+  std::unordered_map<size_t, std::future<void>> res;
+  // The first step is compiled right away, so there is nothing to overlap with.
+  for (size_t i = 1; i < seq.size(); ++i) {
+    auto step_root = seq.step(i);
+    if (step_root->is<hdk::ir::LogicalValues>() || depends_on_steps(step_root, steps)) {
+      continue;
+    }
+    VLOG(1) << "Scheduling background compilation for query step " << i;
+    auto step_eo = eo;
+    step_eo.intermediate_result = i + 1 < seq.size();
+    step_eo.multifrag_result |=
+        step_eo.intermediate_result && config_.exec.enable_multifrag_rs;
+    res.emplace(i, std::async(std::launch::async, [this, step_root, co, step_eo]() {
+      try {
+        // Codegen state is owned by executor, so use a separate executor to
+        // compile in parallel with the main one. Compiled code is shared through
+        // the code cache.
+        auto executor =
+            Executor::getExecutor(executor_->getDataMgr(), executor_->getConfigPtr());
+        RelAlgExecutor ra_executor(executor.get(), schema_provider_);
+        ra_executor.precompileStep(step_root, co, step_eo);
+      } catch (const std::exception& e) {
+        VLOG(1) << "Background compilation of query step failed: " << e.what();
+      }
+    }));
+  }
+  return res;
+}
+
+void RelAlgExecutor::precompileStep(const hdk::ir::Node* step_root,
+                                    const CompilationOptions& co,
+                                    const ExecutionOptions& eo) {
+  auto timer = DEBUG_TIMER(__func__);
+  executor_->setSchemaProvider(schema_provider_);
+  executor_->setupCaching(data_provider_,
+                          get_physical_inputs(step_root),
+                          get_physical_table_inputs(step_root));
+  executor_->temporary_tables_ = &temporary_tables_;
+  ScopeGuard row_set_holder = [this] { cleanupPostExecution(); };
+  time(&now_);
+
+  WindowProjectNodeContext::reset(executor_);
+  auto work_unit = createWorkUnit(step_root, co, eo, true);
+  // Window functions are computed prior to the kernel compilation which is not
+  // something to do in background.
+  if (is_window_execution_unit(work_unit.exe_unit)) {
+    return;
+  }
+  // Explain mode compiles the kernel and skips any execution including pre-flight
+  // count queries.
+  executeWorkUnit(work_unit,
+                  step_root->getOutputMetainfo(),
+                  is_agg_step(step_root),
+                  co,
+                  eo.with_just_explain(true),
+                  0);
+}
+
+TableInfoPtr RelAlgExecutor::prepareStreamExecution(const CompilationOptions& co,
+                                                    const ExecutionOptions& eo) {
+  CHECK(query_dag_);
+  auto timer = DEBUG_TIMER(__func__);
+  std::lock_guard<std::mutex> execution_lock(executor_->getQueryExecutionMutex());
+  query_dag_->resetQueryExecutionState();
+  const auto ra = query_dag_->getRootNode();
+  hdk::QueryExecutionSequence query_seq(ra, executor_->getConfigPtr());
+  if (query_seq.size() != 1 || !getSubqueries().empty()) {
+    throw std::runtime_error("Continuous query must be executed in a single step");
+  }
+  const auto step_root = query_seq.step(0);
+  if (step_root->is<hdk::ir::Sort>() || step_root->is<hdk::ir::LogicalValues>()) {
+    throw std::runtime_error("Sort and VALUES are not supported in continuous queries");
+  }
+  const auto phys_table_ids = get_physical_table_inputs(step_root);
+  TableInfoPtr table_info;
+  if (phys_table_ids.size() == 1) {
+    const auto& [db_id, table_id] = *phys_table_ids.begin();
+    table_info = schema_provider_->getTableInfo(db_id, table_id);
+  }
+  if (!table_info || !table_info->is_stream) {
+    throw std::runtime_error("Continuous query must read a single stream table");
+  }
+
+  executor_->setSchemaProvider(schema_provider_);
+  executor_->setupCaching(data_provider_, get_physical_inputs(step_root), phys_table_ids);
+  executor_->temporary_tables_ = &temporary_tables_;
+  ScopeGuard row_set_holder = [this] { cleanupPostExecution(); };
+  ScopeGuard restore_metainfo_cache = [this] { executor_->clearMetaInfoCache(); };
+  time(&now_);
+
+  WindowProjectNodeContext::reset(executor_);
+  // Results of batches are merged, so rows cannot reference columns of their
+  // fragments.
+  auto co_stream = co;
+  co_stream.allow_lazy_fetch = false;
+  auto work_unit = createWorkUnit(step_root, co_stream, eo, false);
+  if (is_window_execution_unit(work_unit.exe_unit)) {
+    throw std::runtime_error("Window functions are not supported in continuous queries");
+  }
+  const auto table_infos = get_table_infos(work_unit.exe_unit, executor_);
+  auto column_cache = std::make_unique<ColumnCacheMap>();
+  auto ctx = executor_->prepareStreamingExecution(work_unit.exe_unit,
+                                                  co_stream,
+                                                  eo,
+                                                  table_infos,
+                                                  work_unit.max_groups_buffer_entry_guess,
+                                                  data_provider_,
+                                                  *column_cache);
+  ctx->column_cache = std::move(column_cache);
+  ctx->is_agg = is_agg_step(step_root);
+  stream_execution_context_ = std::move(ctx);
+  stream_query_rewriter_ = std::move(work_unit.query_rewriter);
+  stream_processed_fragments_ = 0;
+  return table_info;
+}
+
+void RelAlgExecutor::runOnNewBatches() {
+  if (!stream_execution_context_) {
+    throw std::runtime_error("Continuous query is not prepared");
+  }
+  auto timer = DEBUG_TIMER(__func__);
+  std::lock_guard<std::mutex> execution_lock(executor_->getQueryExecutionMutex());
+  executor_->setSchemaProvider(schema_provider_);
+  const auto& input_desc = stream_execution_context_->ra_exe_unit.input_descs.front();
+  const int db_id = input_desc.getDatabaseId();
+  const int table_id = input_desc.getTableId();
+  // Stream tables never modify published fragments, so only new fragments are run.
+  const auto fragment_count =
+      data_provider_->getTableMetadata(db_id, table_id).fragments.size();
+  for (; stream_processed_fragments_ < fragment_count; ++stream_processed_fragments_) {
+    executor_->runOnBatch(stream_execution_context_,
+                          {{db_id, table_id, {stream_processed_fragments_}}});
+  }
+}
+
+ExecutionResult RelAlgExecutor::pollStreamExecution() {
+  if (!stream_execution_context_) {
+    throw std::runtime_error("Continuous query is not prepared");
+  }
+  auto timer = DEBUG_TIMER(__func__);
+  std::lock_guard<std::mutex> execution_lock(executor_->getQueryExecutionMutex());
+  executor_->setSchemaProvider(schema_provider_);
+  auto table = executor_->pollStreamExecution(stream_execution_context_);
+  return registerResultSetTable(
+      std::move(table), getRootNode()->getOutputMetainfo(), false);
+}
+
+ExecutionResult RelAlgExecutor::finishStreamExecution() {
+  if (!stream_execution_context_) {
+    throw std::runtime_error("Continuous query is not prepared");
+  }
+  auto timer = DEBUG_TIMER(__func__);
+  std::lock_guard<std::mutex> execution_lock(executor_->getQueryExecutionMutex());
+  executor_->setSchemaProvider(schema_provider_);
+  auto table = executor_->finishStreamExecution(stream_execution_context_);
+  stream_execution_context_.reset();
+  stream_query_rewriter_.reset();
+  return registerResultSetTable(
+      std::move(table), getRootNode()->getOutputMetainfo(), false);
+}
+
 std::unique_ptr<WindowFunctionContext> RelAlgExecutor::createWindowFunctionContext(
     const hdk::ir::WindowFunction* window_func,
     const std::shared_ptr<const hdk::ir::BinOper>& partition_key_cond,
+    const std::shared_ptr<HashJoin>& partitions,
     const RelAlgExecutionUnit& ra_exe_unit,
     const std::vector<InputTableInfo>& query_infos,
     const CompilationOptions& co,
@@ -831,7 +1508,11 @@ std::unique_ptr<WindowFunctionContext> RelAlgExecutor::createWindowFunctionConte
                                 ? MemoryLevel::GPU_LEVEL
                                 : MemoryLevel::CPU_LEVEL;
   std::unique_ptr<WindowFunctionContext> context;
-  if (partition_key_cond) {
+  if (partitions) {
+    CHECK(partition_key_cond);
+    context = std::make_unique<WindowFunctionContext>(
+        window_func, config_, partitions, elem_count, co.device_type, row_set_mem_owner);
+  } else if (partition_key_cond) {
     const auto join_table_or_err =
         executor_->buildHashTableForQualifier(partition_key_cond,
                                               query_infos,
@@ -880,6 +1561,11 @@ std::unique_ptr<WindowFunctionContext> RelAlgExecutor::createWindowFunctionConte
     CHECK_EQ(join_col_elem_count, elem_count);
     context->addOrderColumn(column, order_col.get(), chunks_owner);
   }
+  // Window steps run on CPU, but partitions of large inputs are sorted on GPU.
+  if (config_.exec.window_func.gpu_partition_sort && !executor_->isCPUOnly() &&
+      executor_->deviceCount(ExecutorDeviceType::GPU) > 0) {
+    context->enableGpuPartitionSort(executor_->getBufferProvider(), /*device_id=*/0);
+  }
   return context;
 }
 
@@ -934,6 +1620,10 @@ ExecutionResult RelAlgExecutor::executeLogicalValues(
 
 namespace {
 
+// Smallest group-by buffer seeded from the recorded group count of a previous
+// execution, initializing it is cheaper than any retry.
+constexpr size_t kMinGroupCountHistoryEntries = 1024;
+
 /**
  *  Upper bound estimation for the number of groups. Not strictly correct and not
  * tight, but if the tables involved are really small we shouldn't waste time doing
@@ -952,6 +1642,21 @@ size_t groups_approx_upper_bound(const std::vector<InputTableInfo>& table_infos)
   return std::max(max_num_groups, size_t(1));
 }
 
+/**
+ * Cache key for the estimated number of groups. Row counts of the input tables are
+ * included, so an estimation is not reused after rows are appended to an input table.
+ */
+std::string cardinality_cache_key(const RelAlgExecutionUnit& ra_exe_unit,
+                                  const std::vector<InputTableInfo>& table_infos) {
+  auto key = ra_exec_unit_desc_for_caching(ra_exe_unit);
+  for (const auto& table_info : table_infos) {
+    key += "|" + std::to_string(table_info.db_id) + ":" +
+           std::to_string(table_info.table_id) + ":" +
+           std::to_string(table_info.info.getPhysicalNumTuples());
+  }
+  return key;
+}
+
 /**
  * Determines whether a query needs to compute the size of its output buffer. Returns
  * true for projection queries with no LIMIT or a LIMIT that exceeds the high scan
@@ -1051,8 +1756,160 @@ RelAlgExecutionUnit decide_approx_count_distinct_implementation(
   return ra_exe_unit;
 }
 
+// Maximum number of passes used by the partitioned aggregation.
+constexpr size_t kMaxAggregationPartitions = 256;
+
+// Returns a group key used to split groups into disjoint partitions, or nullptr
+// if no group key is suitable. Integer keys are used as is and dictionary encoded
+// strings are partitioned by their string ids.
+hdk::ir::ExprPtr get_aggregation_partition_key(const RelAlgExecutionUnit& ra_exe_unit) {
+  for (const auto& groupby_expr : ra_exe_unit.groupby_exprs) {
+    if (!groupby_expr) {
+      continue;
+    }
+    const auto type = groupby_expr->type();
+    if (type->isInteger() && type->size() >= 4) {
+      return groupby_expr;
+    }
+    if (type->isExtDictionary() && groupby_expr->is<hdk::ir::ColumnVar>()) {
+      return hdk::ir::makeExpr<hdk::ir::KeyForStringExpr>(groupby_expr);
+    }
+  }
+  return nullptr;
+}
+
+// Builds a filter selecting rows of the partition `partition_idx`, i.e.
+// ((key % partition_count) + partition_count) % partition_count = partition_idx.
+// NULL keys go to the first partition.
+hdk::ir::ExprPtr make_aggregation_partition_qual(hdk::ir::ExprPtr key,
+                                                 const size_t partition_count,
+                                                 const size_t partition_idx) {
+  auto& ctx = key->ctx();
+  const auto type = key->type();
+  const auto const_type = type->withNullable(false);
+  const auto count = hdk::ir::Constant::make(const_type, partition_count);
+  auto make_mod = [&](hdk::ir::ExprPtr arg) {
+    return hdk::ir::makeExpr<hdk::ir::BinOper>(
+        type, hdk::ir::OpType::kMod, hdk::ir::Qualifier::kOne, arg, count);
+  };
+  auto partition = make_mod(hdk::ir::makeExpr<hdk::ir::BinOper>(
+      type, hdk::ir::OpType::kPlus, hdk::ir::Qualifier::kOne, make_mod(key), count));
+  hdk::ir::ExprPtr qual = hdk::ir::makeExpr<hdk::ir::BinOper>(
+      ctx.boolean(type->nullable()),
+      hdk::ir::OpType::kEq,
+      hdk::ir::Qualifier::kOne,
+      partition,
+      hdk::ir::Constant::make(const_type, partition_idx));
+  if (partition_idx == 0 && type->nullable()) {
+    auto is_null = hdk::ir::makeExpr<hdk::ir::UOper>(
+        ctx.boolean(false), hdk::ir::OpType::kIsNull, key);
+    qual = hdk::ir::makeExpr<hdk::ir::BinOper>(ctx.boolean(true),
+                                               hdk::ir::OpType::kOr,
+                                               hdk::ir::Qualifier::kOne,
+                                               qual,
+                                               is_null);
+  }
+  return qual;
+}
+
+bool have_same_layout(const QueryMemoryDescriptor& lhs,
+                      const QueryMemoryDescriptor& rhs) {
+  if (lhs.getQueryDescriptionType() != rhs.getQueryDescriptionType() ||
+      lhs.didOutputColumnar() != rhs.didOutputColumnar() ||
+      lhs.getEffectiveKeyWidth() != rhs.getEffectiveKeyWidth() ||
+      lhs.getSlotCount() != rhs.getSlotCount()) {
+    return false;
+  }
+  for (size_t i = 0; i < lhs.getSlotCount(); ++i) {
+    if (lhs.getPaddedSlotWidthBytes(i) != rhs.getPaddedSlotWidthBytes(i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 }  // namespace
 
+std::optional<hdk::ResultSetTable> RelAlgExecutor::executePartitionedAggregation(
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const std::vector<InputTableInfo>& table_infos,
+    const size_t max_groups_buffer_entry_guess,
+    const bool is_agg,
+    const CompilationOptions& co,
+    const ExecutionOptions& eo,
+    ColumnCacheMap& column_cache) {
+  const auto& group_by_config = config_.exec.group_by;
+  if (!group_by_config.enable_partitioned_aggregation || !is_agg || eo.just_explain ||
+      eo.just_validate || ra_exe_unit.groupby_exprs.empty() ||
+      !ra_exe_unit.groupby_exprs.front() || ra_exe_unit.estimator ||
+      !ra_exe_unit.sort_info.order_entries.empty() || ra_exe_unit.union_all) {
+    return std::nullopt;
+  }
+  const auto max_groups =
+      std::max(group_by_config.partitioned_aggregation_max_groups, size_t(1));
+  if (max_groups_buffer_entry_guess <= max_groups) {
+    return std::nullopt;
+  }
+  const auto key = get_aggregation_partition_key(ra_exe_unit);
+  if (!key) {
+    return std::nullopt;
+  }
+  const auto partition_count =
+      std::min((max_groups_buffer_entry_guess + max_groups - 1) / max_groups,
+               kMaxAggregationPartitions);
+  // The estimation already has a margin, so we don't add any extra space for a
+  // possible partitions skew. Passes which run out of slots make us fall back to
+  // the regular execution.
+  const auto partition_groups_guess =
+      (max_groups_buffer_entry_guess + partition_count - 1) / partition_count;
+  VLOG(1) << "Executing aggregation with " << max_groups_buffer_entry_guess
+          << " estimated groups in " << partition_count << " partitions.";
+
+  std::vector<ResultSetPtr> results;
+  for (size_t partition_idx = 0; partition_idx < partition_count; ++partition_idx) {
+    auto partition_exe_unit = ra_exe_unit;
+    partition_exe_unit.quals.push_back(
+        make_aggregation_partition_qual(key, partition_count, partition_idx));
+    auto groups_guess = partition_groups_guess;
+    try {
+      auto rs_table = executor_->executeWorkUnit(groups_guess,
+                                                 is_agg,
+                                                 table_infos,
+                                                 partition_exe_unit,
+                                                 co,
+                                                 eo,
+                                                 /*has_cardinality_estimation=*/true,
+                                                 data_provider_,
+                                                 column_cache);
+      for (auto& rs : rs_table.results()) {
+        results.push_back(rs);
+      }
+    } catch (const QueryExecutionError& e) {
+      LOG(WARNING) << "Partitioned aggregation failed with error "
+                   << getErrorMessageFromCode(e.getErrorCode())
+                   << ", falling back to the regular execution.";
+      return std::nullopt;
+    }
+  }
+
+  if (eo.multifrag_result) {
+    return hdk::ResultSetTable(std::move(results));
+  }
+  // Partitions hold disjoint sets of groups and are simply concatenated.
+  auto& first = results.front();
+  for (size_t i = 1; i < results.size(); ++i) {
+    if (!have_same_layout(first->getQueryMemDesc(), results[i]->getQueryMemDesc())) {
+      LOG(WARNING) << "Partitioned aggregation produced results with different "
+                      "layouts, falling back to the regular execution.";
+      return std::nullopt;
+    }
+  }
+  for (size_t i = 1; i < results.size(); ++i) {
+    first->append(*results[i]);
+  }
+  return hdk::ResultSetTable(std::move(first));
+}
+
 ExecutionResult RelAlgExecutor::executeWorkUnit(
     const RelAlgExecutor::WorkUnit& work_unit,
     const std::vector<TargetMetaInfo>& targets_meta,
@@ -1073,7 +1930,8 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
     }
     co.device_type = ExecutorDeviceType::CPU;
     co.allow_lazy_fetch = false;
-    computeWindow(work_unit.exe_unit, co, eo, column_cache, queue_time_ms);
+    computeWindow(
+        work_unit.exe_unit, work_unit.body, co, eo, column_cache, queue_time_ms);
   }
   if (!eo.just_explain && eo.find_push_down_candidates) {
     // find potential candidates:
@@ -1097,7 +1955,12 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
         table_infos.front().info.fragments.front().getNumTuples();
     ra_exe_unit.scan_limit = max_groups_buffer_entry_guess;
   } else if (compute_output_buffer_size(ra_exe_unit) && !isRowidLookup(work_unit)) {
-    if (previous_count && !exe_unit_has_quals(ra_exe_unit)) {
+    if (config_.exec.enable_limit_early_termination && ra_exe_unit.sort_info.limit &&
+        ra_exe_unit.sort_info.order_entries.empty() && !ra_exe_unit.union_all) {
+      // No kernel needs to output more than LIMIT + OFFSET rows, so don't run a count
+      // query over the whole input to size the output buffer.
+      ra_exe_unit.scan_limit = ra_exe_unit.sort_info.limit + ra_exe_unit.sort_info.offset;
+    } else if (previous_count && !exe_unit_has_quals(ra_exe_unit)) {
       ra_exe_unit.scan_limit = *previous_count;
     } else {
       if (eo.executor_type == ::ExecutorType::Extern) {
@@ -1120,8 +1983,27 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
       eo.output_columnar_hint = true;
     }
   }
+  // Columnar projections are fetched by the following steps with zero-copy.
+  if (eo.intermediate_result && config_.rs.enable_columnar_intermediate_results &&
+      !eo.output_columnar_hint && can_output_columnar(ra_exe_unit)) {
+    VLOG(1) << "Using columnar layout for intermediate projection.";
+    eo.output_columnar_hint = true;
+  }
 
   ExecutionResult result;
+  // Entry guess of the successful execution, which is bigger than the estimation if a
+  // GPU group by buffer had to grow.
+  size_t executed_groups_buffer_entry_guess{0};
+  // Group counts of executed steps are kept with the cardinality estimations, so the
+  // next execution of the step over the same input sizes gets a buffer of the right
+  // size without a retry or an estimator query.
+  const auto cache_key = cardinality_cache_key(ra_exe_unit, table_infos);
+  const bool record_group_count =
+      config_.exec.group_by.enable_group_count_history && is_agg &&
+      !ra_exe_unit.groupby_exprs.empty() && ra_exe_unit.groupby_exprs.front() &&
+      !ra_exe_unit.sort_info.limit && !ra_exe_unit.estimator &&
+      !(eo.just_validate || eo.just_explain);
+  bool group_count_recorded{false};
   auto execute_and_handle_errors = [&](const auto max_groups_buffer_entry_guess_in,
                                        const bool has_cardinality_estimation,
                                        const bool has_ndv_estimation) -> ExecutionResult {
@@ -1129,6 +2011,19 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
     // Create a local copy so we can track those changes if we need to attempt a retry
     // due to OOM
     auto local_groups_buffer_entry_guess = max_groups_buffer_entry_guess_in;
+    if (has_cardinality_estimation) {
+      auto rs_table = executePartitionedAggregation(ra_exe_unit,
+                                                    table_infos,
+                                                    local_groups_buffer_entry_guess,
+                                                    is_agg,
+                                                    co,
+                                                    eo,
+                                                    column_cache);
+      if (rs_table) {
+        rs_table->setQueueTime(queue_time_ms);
+        return registerResultSetTable(*rs_table, targets_meta, eo.just_explain);
+      }
+    }
     try {
       auto rs_table = executor_->executeWorkUnit(local_groups_buffer_entry_guess,
                                                  is_agg,
@@ -1139,6 +2034,17 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
                                                  has_cardinality_estimation,
                                                  data_provider_,
                                                  column_cache);
+      executed_groups_buffer_entry_guess = local_groups_buffer_entry_guess;
+      if (record_group_count) {
+        size_t group_count = 0;
+        for (const auto& rs : rs_table.results()) {
+          group_count += rs->rowCount();
+        }
+        // Keep the hash table load factor at one half, as for the NDV estimation.
+        executor_->addToCardinalityCache(
+            cache_key, std::max(2 * group_count, kMinGroupCountHistoryEntries));
+        group_count_recorded = true;
+      }
       rs_table.setQueueTime(queue_time_ms);
       return registerResultSetTable(rs_table, targets_meta, eo.just_explain);
     } catch (const QueryExecutionError& e) {
@@ -1157,7 +2063,6 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
     }
   };
 
-  auto cache_key = ra_exec_unit_desc_for_caching(ra_exe_unit);
   try {
     auto cached_cardinality = executor_->getCachedCardinality(cache_key);
     auto card = cached_cardinality.second;
@@ -1177,8 +2082,16 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
     if (cached_cardinality.first && card >= 0) {
       result = execute_and_handle_errors(card, true, /*has_ndv_estimation=*/true);
     } else {
+      // Statistics collected by storage save the estimator query.
+      std::optional<size_t> stats_groups_estimation;
+      if (config_.exec.group_by.enable_column_stats_ndv) {
+        stats_groups_estimation = get_ndv_estimation_from_column_stats(
+            ra_exe_unit, table_infos, groups_approx_upper_bound(table_infos));
+      }
       const auto ndv_groups_estimation =
-          getNDVEstimation(work_unit, e.range(), is_agg, co, eo);
+          stats_groups_estimation
+              ? *stats_groups_estimation
+              : getNDVEstimation(work_unit, e.range(), is_agg, co, eo);
       const auto estimated_groups_buffer_entry_guess =
           ndv_groups_estimation > 0 ? 2 * ndv_groups_estimation
                                     : std::min(groups_approx_upper_bound(table_infos),
@@ -1186,8 +2099,11 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
       CHECK_GT(estimated_groups_buffer_entry_guess, size_t(0));
       result = execute_and_handle_errors(
           estimated_groups_buffer_entry_guess, true, /*has_ndv_estimation=*/true);
-      if (!(eo.just_validate || eo.just_explain)) {
-        executor_->addToCardinalityCache(cache_key, estimated_groups_buffer_entry_guess);
+      if (!(eo.just_validate || eo.just_explain) && !group_count_recorded) {
+        executor_->addToCardinalityCache(
+            cache_key,
+            std::max(estimated_groups_buffer_entry_guess,
+                     executed_groups_buffer_entry_guess));
       }
     }
   }
@@ -1446,6 +2362,77 @@ ErrorInfo getErrorDescription(const int32_t error_code) {
   }
 }
 
+class StringOpsDetector : public hdk::ir::ExprVisitor<void> {
+ public:
+  bool hasStringOps() const { return has_string_ops_; }
+
+ protected:
+  void visitCharLength(const hdk::ir::CharLengthExpr*) override {
+    has_string_ops_ = true;
+  }
+
+  void visitLower(const hdk::ir::LowerExpr*) override { has_string_ops_ = true; }
+
+  void visitLikeExpr(const hdk::ir::LikeExpr*) override { has_string_ops_ = true; }
+
+  void visitRegexpExpr(const hdk::ir::RegexpExpr*) override { has_string_ops_ = true; }
+
+ private:
+  bool has_string_ops_{false};
+};
+
+// Features of the execution unit used by the cost model to choose extrapolation
+// models. Output layout is not known before compilation, so the columnar output
+// hint is used instead.
+costmodel::QueryFeatures get_query_features(const RelAlgExecutionUnit& ra_exe_unit,
+                                            const ExecutionOptions& eo) {
+  costmodel::QueryFeatures features;
+  features.join_levels = ra_exe_unit.join_quals.size();
+  for (const auto& join_condition : ra_exe_unit.join_quals) {
+    bool has_equi_join = false;
+    for (const auto& qual : join_condition.quals) {
+      auto bin_oper = qual->as<hdk::ir::BinOper>();
+      if (bin_oper && (bin_oper->isEq() || bin_oper->isBwEq())) {
+        has_equi_join = true;
+        break;
+      }
+    }
+    features.has_loop_join |= !has_equi_join;
+  }
+
+  for (const auto& groupby_expr : ra_exe_unit.groupby_exprs) {
+    if (groupby_expr) {
+      // Varlen keys are stored as 64-bit values.
+      auto size = groupby_expr->type()->size();
+      features.group_key_width += size > 0 ? size : 8;
+    }
+  }
+
+  StringOpsDetector string_ops_detector;
+  for (auto target_expr : ra_exe_unit.target_exprs) {
+    auto agg_expr = target_expr->as<hdk::ir::AggExpr>();
+    if (agg_expr && (agg_expr->isDistinct() ||
+                     agg_expr->aggType() == hdk::ir::AggType::kApproxCountDistinct)) {
+      features.has_count_distinct = true;
+    }
+    string_ops_detector.visit(target_expr);
+  }
+  for (const auto& qual : ra_exe_unit.simple_quals) {
+    string_ops_detector.visit(qual.get());
+  }
+  for (const auto& qual : ra_exe_unit.quals) {
+    string_ops_detector.visit(qual.get());
+  }
+  for (const auto& groupby_expr : ra_exe_unit.groupby_exprs) {
+    if (groupby_expr) {
+      string_ops_detector.visit(groupby_expr.get());
+    }
+  }
+  features.has_string_ops = string_ops_detector.hasStringOps();
+  features.columnar_output = eo.output_columnar_hint;
+  return features;
+}
+
 }  // namespace
 
 std::string RelAlgExecutor::getErrorMessageFromCode(const int32_t error_code) {
@@ -1514,6 +2501,7 @@ RelAlgExecutor::WorkUnit RelAlgExecutor::createWorkUnit(const hdk::ir::Node* nod
   templVisitor.visit(node);
   std::vector<costmodel::AnalyticalTemplate> templates = templVisitor.getTemplates();
   rewritten_exe_unit.templs = templates;
+  rewritten_exe_unit.features = get_query_features(rewritten_exe_unit, eo);
   rewritten_exe_unit.cost_model = executor_->getCostModel();
 
   return {rewritten_exe_unit,
@@ -32,6 +32,9 @@
 #include "Shared/scope.h"
 
 #include <ctime>
+#include <functional>
+#include <future>
+#include <mutex>
 #include <sstream>
 
 enum class MergeType { Union, Reduce };
@@ -47,6 +50,8 @@ namespace hdk {
 class ResultSetRegistry;
 }
 
+struct ResultSetCacheMetaInfo;
+
 class RelAlgExecutor {
  public:
   using TargetInfoList = std::vector<TargetInfo>;
@@ -111,6 +116,29 @@ class RelAlgExecutor {
 
   void executePostExecutionCallback();
 
+  // Interrupt this query from another thread. A running query stops at the next
+  // interrupt check of the executor, a query which didn't start yet doesn't start.
+  // Both fail with the interrupted query error.
+  void interrupt();
+
+  // Set a callback called after each executed query step with the numbers of
+  // executed and total steps.
+  void setProgressCallback(std::function<void(size_t, size_t)> callback) {
+    progress_callback_ = std::move(callback);
+  }
+
+  // Continuous query API. The query is a single step reading a stream table. It is
+  // compiled once by prepareStreamExecution(), which returns the stream table info.
+  // runOnNewBatches() executes the compiled code on fragments appended to the table
+  // since the previous call. Polls return the aggregate of all processed batches for
+  // aggregations and rows of batches processed since the previous poll for
+  // projections. finishStreamExecution() returns the same and releases the state.
+  TableInfoPtr prepareStreamExecution(const CompilationOptions& co,
+                                      const ExecutionOptions& eo);
+  void runOnNewBatches();
+  ExecutionResult pollStreamExecution();
+  ExecutionResult finishStreamExecution();
+
   static const SpeculativeTopNBlacklist& speculativeTopNBlacklist() {
     return speculative_topn_blacklist_;
   }
@@ -132,17 +160,34 @@ class RelAlgExecutor {
                               const int64_t queue_time_ms,
                               bool allow_speculative_sort);
 
-  // Computes the window function results to be used by the query.
+  // Start background compilation of kernels for steps which don't use results of
+  // other steps. Returned futures are indexed by step position in the sequence.
+  std::unordered_map<size_t, std::future<void>> precompileIndependentSteps(
+      const hdk::QueryExecutionSequence& seq,
+      const CompilationOptions& co,
+      const ExecutionOptions& eo);
+  // Build and compile the step's work unit to populate the code cache without
+  // executing it.
+  void precompileStep(const hdk::ir::Node* step_root,
+                      const CompilationOptions& co,
+                      const ExecutionOptions& eo);
+
+  // Computes the window function results to be used by the query. The window project
+  // node provides per-partition limits of window functions.
   void computeWindow(const RelAlgExecutionUnit& ra_exe_unit,
+                     const hdk::ir::Node* window_node,
                      const CompilationOptions& co,
                      const ExecutionOptions& eo,
                      ColumnCacheMap& column_cache_map,
                      const int64_t queue_time_ms);
 
-  // Creates the window context for the given window function.
+  // Creates the window context for the given window function. The partitions hash table
+  // is built from partition_key_cond unless partitions built for another window function
+  // with the same partition keys are given.
   std::unique_ptr<WindowFunctionContext> createWindowFunctionContext(
       const hdk::ir::WindowFunction* window_func,
       const std::shared_ptr<const hdk::ir::BinOper>& partition_key_cond,
+      const std::shared_ptr<HashJoin>& partitions,
       const RelAlgExecutionUnit& ra_exe_unit,
       const std::vector<InputTableInfo>& query_infos,
       const CompilationOptions& co,
@@ -163,6 +208,24 @@ class RelAlgExecutor {
     const std::vector<size_t> left_deep_join_input_sizes;
   };
 
+  // Updates the outdated cached result of a group-by step by aggregating fragments
+  // appended to its input table. Returns nothing if the result cannot be updated.
+  std::optional<ExecutionResult> executeStepIncrementally(
+      const hdk::ir::Node* step_root,
+      WorkUnit& work_unit,
+      const CompilationOptions& co,
+      const ExecutionOptions& eo,
+      const int64_t queue_time_ms,
+      const ExecutionResult& cached_res,
+      const ResultSetCacheMetaInfo& cached_meta_info);
+
+  // Executes the work unit of a step and applies the step's sort, limit and offset.
+  ExecutionResult executeStepWorkUnit(const hdk::ir::Node* step_root,
+                                      WorkUnit& work_unit,
+                                      const CompilationOptions& co,
+                                      const ExecutionOptions& eo,
+                                      const int64_t queue_time_ms);
+
   ExecutionResult executeWorkUnit(
       const WorkUnit& work_unit,
       const std::vector<TargetMetaInfo>& targets_meta,
@@ -195,6 +258,18 @@ class RelAlgExecutor {
 
   bool isRowidLookup(const WorkUnit& work_unit);
 
+  // Executes a high cardinality aggregation in multiple passes, each of them
+  // aggregating a disjoint partition of groups. Returns std::nullopt if the
+  // partitioned aggregation is not applicable.
+  std::optional<hdk::ResultSetTable> executePartitionedAggregation(
+      const RelAlgExecutionUnit& ra_exe_unit,
+      const std::vector<InputTableInfo>& table_infos,
+      const size_t max_groups_buffer_entry_guess,
+      const bool is_agg,
+      const CompilationOptions& co,
+      const ExecutionOptions& eo,
+      ColumnCacheMap& column_cache);
+
   ExecutionResult handleOutOfMemoryRetry(const RelAlgExecutor::WorkUnit& work_unit,
                                          const std::vector<TargetMetaInfo>& targets_meta,
                                          const bool is_agg,
@@ -246,8 +321,18 @@ class RelAlgExecutor {
   static SpeculativeTopNBlacklist speculative_topn_blacklist_;
 
   std::optional<std::function<void()>> post_execution_callback_;
+  std::function<void(size_t, size_t)> progress_callback_;
+
+  // Protects the interrupt state below. The executor is shared by queries, so it is
+  // interrupted only while this query holds its execution mutex.
+  std::mutex interrupt_mutex_;
+  bool interrupt_requested_{false};
+  bool running_{false};
 
   std::shared_ptr<StreamExecutionContext> stream_execution_context_;
+  // Owns expressions of the stream query execution unit.
+  std::unique_ptr<QueryRewriter> stream_query_rewriter_;
+  size_t stream_processed_fragments_{0};
 
   TemplateAggregationVisitor templVisitor;
 
@@ -23,6 +23,7 @@
 
 #include <boost/make_unique.hpp>
 #include <numeric>
+#include <optional>
 #include <string>
 #include <unordered_map>
 
@@ -1680,3 +1681,114 @@ void simplify_sort(std::vector<std::shared_ptr<hdk::ir::Node>>& nodes) noexcept
   }
   nodes.swap(new_nodes);
 }
+
+namespace {
+
+// Returns the per-partition limit implied by a filter conjunct comparing a ROW_NUMBER or
+// RANK output of the window project with an integer constant, e.g. rn <= 3.
+std::optional<std::pair<size_t, size_t>> get_window_function_limit(
+    const hdk::ir::Expr* conjunct,
+    const hdk::ir::Project* window_project) {
+  auto bin_oper = dynamic_cast<const hdk::ir::BinOper*>(conjunct);
+  if (!bin_oper) {
+    return std::nullopt;
+  }
+  auto op_type = bin_oper->opType();
+  auto lhs = bin_oper->leftOperand();
+  auto rhs = bin_oper->rightOperand();
+  if (!dynamic_cast<const hdk::ir::ColumnRef*>(lhs)) {
+    std::swap(lhs, rhs);
+    op_type = hdk::ir::commuteComparison(op_type);
+  }
+  auto col_ref = dynamic_cast<const hdk::ir::ColumnRef*>(lhs);
+  if (!col_ref || col_ref->node() != window_project) {
+    return std::nullopt;
+  }
+  auto window_func = dynamic_cast<const hdk::ir::WindowFunction*>(
+      window_project->getExpr(col_ref->index()).get());
+  if (!window_func || (window_func->kind() != hdk::ir::WindowFunctionKind::RowNumber &&
+                       window_func->kind() != hdk::ir::WindowFunctionKind::Rank)) {
+    return std::nullopt;
+  }
+  auto cast = dynamic_cast<const hdk::ir::UOper*>(rhs);
+  if (cast && cast->isCast()) {
+    rhs = cast->operand();
+  }
+  auto constant = dynamic_cast<const hdk::ir::Constant*>(rhs);
+  if (!constant || constant->isNull() || !constant->type()->isInteger()) {
+    return std::nullopt;
+  }
+  int64_t limit;
+  switch (op_type) {
+    case hdk::ir::OpType::kLe:
+    case hdk::ir::OpType::kEq:
+      limit = constant->intVal();
+      break;
+    case hdk::ir::OpType::kLt:
+      limit = constant->intVal() - 1;
+      break;
+    default:
+      return std::nullopt;
+  }
+  if (limit <= 0) {
+    return std::nullopt;
+  }
+  return std::make_pair(static_cast<size_t>(col_ref->index()),
+                        static_cast<size_t>(limit));
+}
+
+void collect_conjuncts(const hdk::ir::Expr* expr,
+                       std::vector<const hdk::ir::Expr*>& conjuncts) {
+  auto bin_oper = dynamic_cast<const hdk::ir::BinOper*>(expr);
+  if (bin_oper && bin_oper->isAnd()) {
+    collect_conjuncts(bin_oper->leftOperand(), conjuncts);
+    collect_conjuncts(bin_oper->rightOperand(), conjuncts);
+  } else {
+    conjuncts.push_back(expr);
+  }
+}
+
+}  // namespace
+
+// Detects top-N-per-group filters, e.g. rn <= 3 where rn is ROW_NUMBER() or RANK() of
+// the filtered window project, and sets the per-partition limits of those window
+// functions, so they don't have to order whole partitions.
+void add_window_function_limits(
+    std::vector<std::shared_ptr<hdk::ir::Node>>& nodes) noexcept {
+  auto web = build_du_web(nodes);
+  for (auto& node : nodes) {
+    auto filter = std::dynamic_pointer_cast<hdk::ir::Filter>(node);
+    if (!filter) {
+      continue;
+    }
+    auto window_project =
+        std::dynamic_pointer_cast<hdk::ir::Project>(filter->getAndOwnInput(0));
+    if (!window_project) {
+      continue;
+    }
+    // Rows beyond the limits would get inexact values, so the filter has to be the only
+    // user of the window project.
+    auto users_it = web.find(window_project.get());
+    if (users_it == web.end() || users_it->second.size() != 1) {
+      continue;
+    }
+    CHECK(users_it->second.count(filter.get()));
+    std::vector<const hdk::ir::Expr*> conjuncts;
+    collect_conjuncts(filter->getConditionExpr(), conjuncts);
+    for (auto conjunct : conjuncts) {
+      auto limit = get_window_function_limit(conjunct, window_project.get());
+      if (!limit) {
+        continue;
+      }
+      auto [idx, limit_value] = *limit;
+      const auto& limits = window_project->getWindowFunctionLimits();
+      auto limit_it = limits.find(idx);
+      if (limit_it == limits.end() || limit_it->second > limit_value) {
+        VLOG(1) << "Limit window function " << idx << " of "
+                << window_project->getIdString() << " to " << limit_value
+                << " rows per partition.";
+        window_project->setWindowFunctionLimit(idx, limit_value);
+      }
+    }
+  }
+}
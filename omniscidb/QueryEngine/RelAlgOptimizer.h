@@ -40,5 +40,7 @@ void hoist_filter_cond_to_cross_join(
 void simplify_sort(std::vector<std::shared_ptr<hdk::ir::Node>>& nodes) noexcept;
 void sink_projected_boolean_expr_to_join(
     std::vector<std::shared_ptr<hdk::ir::Node>>& nodes) noexcept;
+void add_window_function_limits(
+    std::vector<std::shared_ptr<hdk::ir::Node>>& nodes) noexcept;
 
 #endif  // QUERYENGINE_RELALGOPTIMIZER_H
@@ -39,6 +39,7 @@
 #include <llvm/ExecutionEngine/GenericValue.h>
 
 #include <algorithm>
+#include <cstring>
 #include <future>
 #include <numeric>
 
@@ -48,6 +49,18 @@ bool use_multithreaded_reduction(const size_t entry_count) {
   return entry_count > 100000;
 }
 
+// Merging t-digests costs much more than reducing plain slots, so results with
+// APPROX_QUANTILE targets are reduced in parallel starting from fewer entries.
+bool use_multithreaded_reduction(const size_t entry_count,
+                                 const ResultSetStorage& storage) {
+  const auto& targets = storage.getTargets();
+  const bool has_quantile =
+      std::any_of(targets.begin(), targets.end(), [](const TargetInfo& target) {
+        return target.is_agg && target.agg_kind == hdk::ir::AggType::kApproxQuantile;
+      });
+  return has_quantile ? entry_count > 1000 : use_multithreaded_reduction(entry_count);
+}
+
 size_t get_row_qw_count(const QueryMemoryDescriptor& query_mem_desc) {
   const auto row_bytes = get_row_bytes(query_mem_desc);
   CHECK_EQ(size_t(0), row_bytes % 8);
@@ -209,7 +222,7 @@ void ResultSetReduction::reduce(const ResultSetStorage& this_,
           "Projection of variable length targets with baseline hash group by is not yet "
           "supported in Distributed mode");
     }
-    if (use_multithreaded_reduction(that_entry_count)) {
+    if (use_multithreaded_reduction(that_entry_count, that)) {
       if (reduction_code.ir_reduce_loop) {
         threading::parallel_for(threading::blocked_range<size_t>(0, that_entry_count),
                                 [&this_query_mem_desc,
@@ -265,67 +278,146 @@ void ResultSetReduction::reduce(const ResultSetStorage& this_,
     }
     return;
   }
-  if (use_multithreaded_reduction(entry_count)) {
-    if (this_query_mem_desc.didOutputColumnar()) {
-      threading::parallel_for(
-          threading::blocked_range<size_t>(0, entry_count),
-          [&this_, &that, this_buff, that_buff, &serialized_varlen_buffer, executor](
-              auto r) {
-            reduceEntriesNoCollisionsColWise(this_,
-                                             that,
-                                             this_buff,
-                                             that_buff,
-                                             r.begin(),
-                                             r.end(),
-                                             serialized_varlen_buffer,
-                                             executor);
-          });
-    } else {
-      CHECK(reduction_code.ir_reduce_loop);
-      threading::parallel_for(threading::blocked_range<size_t>(0, entry_count),
-                              [&this_query_mem_desc,
-                               this_buff,
-                               that_buff,
-                               that_entry_count,
-                               &reduction_code,
-                               &that_query_mem_desc,
-                               &serialized_varlen_buffer,
-                               executor](auto r) {
-                                run_reduction_code(reduction_code,
-                                                   this_buff,
-                                                   that_buff,
-                                                   r.begin(),
-                                                   r.end(),
-                                                   that_entry_count,
-                                                   &this_query_mem_desc,
-                                                   &that_query_mem_desc,
-                                                   &serialized_varlen_buffer,
-                                                   executor);
-                              });
-    }
+  if (that.hasFirstTouchInit() && !this_query_mem_desc.didOutputColumnar() &&
+      serialized_varlen_buffer.empty()) {
+    reduceOccupiedEntries(this_, that, reduction_code, executor);
+    return;
+  }
+  this_.finalizeFirstTouchInit();
+  that.finalizeFirstTouchInit();
+  if (use_multithreaded_reduction(entry_count, this_)) {
+    threading::parallel_for(
+        threading::blocked_range<size_t>(0, entry_count),
+        [&this_, &that, &serialized_varlen_buffer, &reduction_code, executor](auto r) {
+          reduceEntries(this_,
+                        that,
+                        r.begin(),
+                        r.end(),
+                        serialized_varlen_buffer,
+                        reduction_code,
+                        executor);
+        });
   } else {
-    if (this_query_mem_desc.didOutputColumnar()) {
-      reduceEntriesNoCollisionsColWise(this_,
-                                       that,
-                                       this_buff,
-                                       that_buff,
-                                       0,
-                                       this_query_mem_desc.getEntryCount(),
-                                       serialized_varlen_buffer,
-                                       executor);
-    } else {
-      CHECK(reduction_code.ir_reduce_loop);
-      run_reduction_code(reduction_code,
-                         this_buff,
-                         that_buff,
-                         0,
-                         entry_count,
-                         that_entry_count,
-                         &this_query_mem_desc,
-                         &that_query_mem_desc,
-                         &serialized_varlen_buffer,
-                         executor);
+    reduceEntries(
+        this_, that, 0, entry_count, serialized_varlen_buffer, reduction_code, executor);
+  }
+}
+
+// Reduces entries in range [start_entry_index, end_entry_index) of `that` into the
+// same entries of `this_`. Only layouts without collisions are supported, so calls
+// for disjoint entry ranges can run concurrently.
+void ResultSetReduction::reduceEntries(
+    const ResultSetStorage& this_,
+    const ResultSetStorage& that,
+    const size_t start_entry_index,
+    const size_t end_entry_index,
+    const std::vector<std::string>& serialized_varlen_buffer,
+    const ReductionCode& reduction_code,
+    const Executor* executor) {
+  const auto& this_query_mem_desc = this_.getQueryMemDesc();
+  const auto& that_query_mem_desc = that.getQueryMemDesc();
+  CHECK(this_query_mem_desc.getQueryDescriptionType() !=
+        QueryDescriptionType::GroupByBaselineHash);
+  const auto that_entry_count = that_query_mem_desc.getEntryCount();
+  CHECK_EQ(this_query_mem_desc.getEntryCount(), that_entry_count);
+  CHECK_LE(end_entry_index, that_entry_count);
+  // Occupancy bitmaps are shared by entry ranges, so they are not updated here.
+  CHECK(!this_.hasFirstTouchInit() && !that.hasFirstTouchInit());
+  auto this_buff = this_.getUnderlyingBuffer();
+  CHECK(this_buff);
+  auto that_buff = that.getUnderlyingBuffer();
+  CHECK(that_buff);
+  if (this_query_mem_desc.didOutputColumnar()) {
+    reduceEntriesNoCollisionsColWise(this_,
+                                     that,
+                                     this_buff,
+                                     that_buff,
+                                     start_entry_index,
+                                     end_entry_index,
+                                     serialized_varlen_buffer,
+                                     executor);
+  } else {
+    CHECK(reduction_code.ir_reduce_loop);
+    run_reduction_code(reduction_code,
+                       this_buff,
+                       that_buff,
+                       start_entry_index,
+                       end_entry_index,
+                       that_entry_count,
+                       &this_query_mem_desc,
+                       &that_query_mem_desc,
+                       &serialized_varlen_buffer,
+                       executor);
+  }
+}
+
+void ResultSetReduction::reduceOccupiedEntries(const ResultSetStorage& this_,
+                                               const ResultSetStorage& that,
+                                               const ReductionCode& reduction_code,
+                                               const Executor* executor) {
+  const auto& this_query_mem_desc = this_.getQueryMemDesc();
+  const auto& that_query_mem_desc = that.getQueryMemDesc();
+  const auto entry_count = this_query_mem_desc.getEntryCount();
+  const auto row_size = this_query_mem_desc.getRowSize();
+  auto this_buff = this_.getUnderlyingBuffer();
+  const auto that_buff = that.getUnderlyingBuffer();
+  auto this_occupancy = this_.getOccupancyBitmap();
+  const auto that_occupancy = that.getOccupancyBitmap();
+  CHECK(that_occupancy);
+  // Words of occupancy bitmaps are processed by a single thread, so the bitmap of
+  // `this_` is updated with no synchronization.
+  auto reduce_words = [&](const size_t begin_word, const size_t end_word) {
+    // Entries occupied in both buffers are reduced by runs of consecutive entries.
+    size_t run_begin = 0;
+    size_t run_end = 0;
+    auto reduce_run = [&]() {
+      if (run_begin != run_end) {
+        run_reduction_code(reduction_code,
+                           this_buff,
+                           that_buff,
+                           run_begin,
+                           run_end,
+                           entry_count,
+                           &this_query_mem_desc,
+                           &that_query_mem_desc,
+                           nullptr,
+                           executor);
+      }
+    };
+    for (size_t word_idx = begin_word; word_idx < end_word; ++word_idx) {
+      const auto that_word = that_occupancy[word_idx];
+      if (!that_word) {
+        continue;
+      }
+      for (size_t bit = 0; bit < 64; ++bit) {
+        if (!((that_word >> bit) & 1)) {
+          continue;
+        }
+        const size_t entry_idx = word_idx * 64 + bit;
+        if (this_.isEmptyEntry(entry_idx)) {
+          memcpy(this_buff + entry_idx * row_size,
+                 that_buff + entry_idx * row_size,
+                 row_size);
+          if (this_occupancy) {
+            this_occupancy[word_idx] |= uint64_t(1) << bit;
+          }
+          continue;
+        }
+        if (entry_idx != run_end) {
+          reduce_run();
+          run_begin = entry_idx;
+        }
+        run_end = entry_idx + 1;
+      }
     }
+    reduce_run();
+  };
+  const size_t word_count = (entry_count + 63) / 64;
+  if (use_multithreaded_reduction(entry_count, this_)) {
+    threading::parallel_for(threading::blocked_range<size_t>(0, word_count),
+                            [&](auto r) { reduce_words(r.begin(), r.end()); });
+  } else {
+    reduce_words(0, word_count);
   }
 }
 
@@ -349,6 +441,103 @@ ALWAYS_INLINE void check_watchdog_with_seed(const size_t sample_seed) {
   }
 }
 
+// Reduces a column of values for the entries marked in `occupied` with a simple
+// loop suitable for auto-vectorization. Entries are independent, so the result
+// doesn't depend on the order of operations.
+template <typename T, typename BinOp>
+void reduce_columnar_slot(T* __restrict this_vals,
+                          const T* __restrict that_vals,
+                          const int8_t* __restrict occupied,
+                          const size_t entry_count,
+                          BinOp op) {
+  for (size_t i = 0; i < entry_count; ++i) {
+    const auto lhs = this_vals[i];
+    const auto res = op(lhs, that_vals[i]);
+    this_vals[i] = occupied[i] ? res : lhs;
+  }
+}
+
+template <typename T, typename BinOp>
+void reduce_columnar_slot_skip_val(T* __restrict this_vals,
+                                   const T* __restrict that_vals,
+                                   const int8_t* __restrict occupied,
+                                   const size_t entry_count,
+                                   const T skip_val,
+                                   BinOp op) {
+  reduce_columnar_slot(
+      this_vals, that_vals, occupied, entry_count, [skip_val, op](T lhs, T rhs) {
+        return rhs == skip_val ? lhs : (lhs == skip_val ? rhs : op(lhs, rhs));
+      });
+}
+
+// Fast path for COUNT, SUM, MIN and MAX slots of columnar buffers. Returns false
+// if the slot has to be reduced entry by entry.
+bool reduce_columnar_slot_vectorized(const TargetInfo& target_info,
+                                     int8_t* this_col,
+                                     const int8_t* that_col,
+                                     const int8_t* occupied,
+                                     const size_t start_index,
+                                     const size_t end_index,
+                                     const int8_t chosen_bytes,
+                                     const int8_t padded_bytes,
+                                     const int64_t init_val) {
+  if (!target_info.is_agg || is_distinct_target(target_info) ||
+      chosen_bytes != padded_bytes ||
+      (chosen_bytes != sizeof(int32_t) && chosen_bytes != sizeof(int64_t))) {
+    return false;
+  }
+  const auto agg_kind = target_info.agg_kind;
+  if (agg_kind != hdk::ir::AggType::kCount && agg_kind != hdk::ir::AggType::kSum &&
+      agg_kind != hdk::ir::AggType::kMin && agg_kind != hdk::ir::AggType::kMax) {
+    return false;
+  }
+  const bool is_count = agg_kind == hdk::ir::AggType::kCount;
+  const bool is_fp = !is_count && get_compact_type(target_info)->isFloatingPoint();
+  const bool skip_null = !is_count && target_info.skip_null_val;
+  const auto entry_count = end_index - start_index;
+
+  auto reduce = [&](auto type_tag) {
+    using T = decltype(type_tag);
+    auto this_vals = reinterpret_cast<T*>(this_col) + start_index;
+    auto that_vals = reinterpret_cast<const T*>(that_col) + start_index;
+    T skip_val;
+    if constexpr (std::is_floating_point_v<T>) {
+      std::memcpy(&skip_val, &init_val, sizeof(T));
+    } else {
+      skip_val = static_cast<T>(init_val);
+    }
+    auto run = [&](auto op) {
+      if (skip_null) {
+        reduce_columnar_slot_skip_val(
+            this_vals, that_vals, occupied, entry_count, skip_val, op);
+      } else {
+        reduce_columnar_slot(this_vals, that_vals, occupied, entry_count, op);
+      }
+    };
+    switch (agg_kind) {
+      case hdk::ir::AggType::kCount:
+      case hdk::ir::AggType::kSum:
+        run([](T lhs, T rhs) { return lhs + rhs; });
+        break;
+      case hdk::ir::AggType::kMin:
+        run([](T lhs, T rhs) { return std::min(lhs, rhs); });
+        break;
+      case hdk::ir::AggType::kMax:
+        run([](T lhs, T rhs) { return std::max(lhs, rhs); });
+        break;
+      default:
+        UNREACHABLE();
+    }
+  };
+
+  if (chosen_bytes == sizeof(int32_t)) {
+    is_fp ? reduce(float()) : reduce(int32_t());
+  } else {
+    is_fp ? reduce(double()) : reduce(int64_t());
+  }
+  return true;
+}
+
 }  // namespace
 
 void ResultSetReduction::reduceEntriesNoCollisionsColWise(
@@ -367,6 +556,20 @@ void ResultSetReduction::reduceEntriesNoCollisionsColWise(
   auto& query_mem_desc = this_.getQueryMemDesc();
   const auto& col_slot_context = query_mem_desc.getColSlotContext();
 
+  // Occupied entries of `that` are found and their keys are copied in a separate
+  // pass, so that simple aggregates are reduced by vectorized per-column loops.
+  std::vector<int8_t> occupied(end_index - start_index);
+  for (size_t entry_idx = start_index; entry_idx < end_index; ++entry_idx) {
+    if (this_.isEmptyEntryColumnar(entry_idx, that_buff)) {
+      continue;
+    }
+    occupied[entry_idx - start_index] = 1;
+    if (LIKELY(!query_mem_desc.hasKeylessHash())) {
+      // copy the key from right hand side
+      this_.copyKeyColWise(entry_idx, this_buff, that_buff);
+    }
+  }
+
   auto this_crt_col_ptr = get_cols_ptr(this_buff, query_mem_desc);
   auto that_crt_col_ptr = get_cols_ptr(that_buff, query_mem_desc);
   for (size_t target_idx = 0; target_idx < this_.getTargetsCount(); ++target_idx) {
@@ -398,14 +601,28 @@ void ResultSetReduction::reduceEntriesNoCollisionsColWise(
           this_crt_col_ptr, query_mem_desc, target_slot_idx);
       const auto that_next_col_ptr = advance_to_next_columnar_target_buff(
           that_crt_col_ptr, query_mem_desc, target_slot_idx);
-      for (size_t entry_idx = start_index; entry_idx < end_index; ++entry_idx) {
-        if (this_.isEmptyEntryColumnar(entry_idx, that_buff)) {
+      const bool is_groupby_target =
+          query_mem_desc.targetGroupbyIndicesSize() > 0 &&
+          query_mem_desc.getTargetGroupbyIndex(target_idx) >= 0;
+      const bool reduced =
+          is_groupby_target ||
+          (!two_slot_target &&
+           reduce_columnar_slot_vectorized(
+               agg_info,
+               this_crt_col_ptr,
+               that_crt_col_ptr,
+               occupied.data(),
+               start_index,
+               end_index,
+               result_set::get_width_for_slot(
+                   target_slot_idx, takes_float_argument(agg_info), query_mem_desc),
+               query_mem_desc.getPaddedSlotWidthBytes(target_slot_idx),
+               this_.getInitVal(target_slot_idx)));
+      for (size_t entry_idx = start_index; !reduced && entry_idx < end_index;
+           ++entry_idx) {
+        if (!occupied[entry_idx - start_index]) {
           continue;
         }
-        if (LIKELY(!query_mem_desc.hasKeylessHash())) {
-          // copy the key from right hand side
-          this_.copyKeyColWise(entry_idx, this_buff, that_buff);
-        }
         auto this_ptr1 =
             this_crt_col_ptr +
             entry_idx * query_mem_desc.getPaddedSlotWidthBytes(target_slot_idx);
@@ -20,6 +20,15 @@ class ResultSetReduction {
                      const Config& config,
                      const Executor* executor);
 
+  // Reduces a range of entries for layouts without collisions.
+  static void reduceEntries(const ResultSetStorage& this_,
+                            const ResultSetStorage& that,
+                            const size_t start_entry_index,
+                            const size_t end_entry_index,
+                            const std::vector<std::string>& serialized_varlen_buffer,
+                            const ReductionCode& reduction_code,
+                            const Executor* executor);
+
   // Reduces results for a single row when using interleaved bin layouts
   static bool reduceSingleRow(const int8_t* row_ptr,
                               const int8_t warp_count,
@@ -47,6 +56,12 @@ class ResultSetReduction {
                                    const size_t key_byte_width);
 
  private:
+  // Reduces only the entries touched in `that`, which is initialized on the first
+  // touch. Entries untouched in `this_` are copied from `that`.
+  static void reduceOccupiedEntries(const ResultSetStorage& this_,
+                                    const ResultSetStorage& that,
+                                    const ReductionCode& reduction_code,
+                                    const Executor* executor);
   static void reduceOneEntryBaseline(const ResultSetStorage& this_,
                                      const ResultSetStorage& that,
                                      int8_t* this_buff,
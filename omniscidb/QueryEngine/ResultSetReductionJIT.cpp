@@ -555,18 +555,50 @@ ResultSetReductionJIT::ResultSetReductionJIT(const QueryMemoryDescriptor& query_
 //     reduce_func_idx(this_buff, that_buff, that_entry_index)
 
 ReductionCode ResultSetReductionJIT::codegen() const {
-  const auto hash_type = query_mem_desc_.getQueryDescriptionType();
-  CompilationOptions co{
-      ExecutorDeviceType::CPU, false, ExecutorOptLevel::ReductionJIT, false};
-
-  co.codegen_traits_desc = co.getCgenTraitsDesc(ExecutorDeviceType::CPU);
-
-  if (query_mem_desc_.didOutputColumnar() || !is_aggregate_query(hash_type)) {
+  if (query_mem_desc_.didOutputColumnar() ||
+      !is_aggregate_query(query_mem_desc_.getQueryDescriptionType())) {
     return {};
   }
+  auto reduction_code = generateReductionIR();
+  // For small result sets, avoid native code generation and use the interpreter instead.
+  // Always compile for count distinct aggregation
+  if (query_mem_desc_.getCountDistinctDescriptorsSize() == 0 &&
+      query_mem_desc_.getEntryCount() < INTERP_THRESHOLD &&
+      (!query_mem_desc_.getDataMgr() || query_mem_desc_.blocksShareMemory())) {
+    return reduction_code;
+  }
+  CHECK(executor_);
+  CodeCacheKey key{cacheKey()};
+  if (config_.exec.codegen.enable_async_reduction_compilation &&
+      query_mem_desc_.getCountDistinctDescriptorsSize() == 0) {
+    // Interpret the reduction until native code compiled in background becomes
+    // available in the code cache.
+    const auto compilation_context = Executor::s_code_accessor->get_value(key);
+    if (compilation_context) {
+      reduction_code.func_ptr =
+          reinterpret_cast<ReductionCode::FuncPtr>(compilation_context->func());
+      return reduction_code;
+    }
+    auto jit = std::make_shared<ResultSetReductionJIT>(query_mem_desc_,
+                                                       targets_,
+                                                       target_init_vals_,
+                                                       executor_->getConfig(),
+                                                       executor_);
+    executor_->scheduleAsyncCompilation(key, [jit, key]() {
+      auto async_reduction_code = jit->generateReductionIR();
+      jit->compileReductionCode(async_reduction_code, key);
+    });
+    return reduction_code;
+  }
+  compileReductionCode(reduction_code, key);
+  return reduction_code;
+}
+
+ReductionCode ResultSetReductionJIT::generateReductionIR() const {
+  const auto hash_type = query_mem_desc_.getQueryDescriptionType();
   auto reduction_code = setup_functions_ir(hash_type);
   isEmpty(reduction_code);
-  switch (query_mem_desc_.getQueryDescriptionType()) {
+  switch (hash_type) {
     case QueryDescriptionType::GroupByPerfectHash:
     case QueryDescriptionType::NonGroupedAggregate: {
       reduceOneEntryNoCollisions(reduction_code);
@@ -583,21 +615,22 @@ ReductionCode ResultSetReductionJIT::codegen() const {
     }
   }
   reduceLoop(reduction_code);
-  // For small result sets, avoid native code generation and use the interpreter instead.
-  // Always compile for count distinct aggregation
-  if (query_mem_desc_.getCountDistinctDescriptorsSize() == 0 &&
-      query_mem_desc_.getEntryCount() < INTERP_THRESHOLD &&
-      (!query_mem_desc_.getDataMgr() || query_mem_desc_.blocksShareMemory())) {
-    return reduction_code;
-  }
-  CHECK(executor_);
-  CodeCacheKey key{cacheKey()};
+  return reduction_code;
+}
+
+void ResultSetReductionJIT::compileReductionCode(ReductionCode& reduction_code,
+                                                 const CodeCacheKey& key) const {
+  CompilationOptions co{
+      ExecutorDeviceType::CPU, false, ExecutorOptLevel::ReductionJIT, false};
+
+  co.codegen_traits_desc = co.getCgenTraitsDesc(ExecutorDeviceType::CPU);
+
   std::lock_guard<std::mutex> compilation_lock(executor_->compilation_mutex_);
   const auto compilation_context = Executor::s_code_accessor->get_or_wait(key);
   if (compilation_context) {
     reduction_code.func_ptr =
         reinterpret_cast<ReductionCode::FuncPtr>(compilation_context->get()->func());
-    return reduction_code;
+    return;
   }
   auto cgen_state_ = std::unique_ptr<CgenState>(
       new CgenState({},
@@ -643,7 +676,6 @@ ReductionCode ResultSetReductionJIT::codegen() const {
   reduction_code.cgen_state = nullptr;
   finalizeReductionCode(
       reduction_code, ir_is_empty, ir_reduce_one_entry, ir_reduce_one_entry_idx, key);
-  return reduction_code;
 }
 
 void ResultSetReductionJIT::isEmpty(const ReductionCode& reduction_code) const {
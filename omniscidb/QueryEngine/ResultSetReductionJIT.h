@@ -62,6 +62,12 @@ class ResultSetReductionJIT {
   virtual ReductionCode codegen() const;
 
  protected:
+  // Generate the interpretable IR for the reduction loop.
+  ReductionCode generateReductionIR() const;
+
+  // Translate the reduction IR into native code or take it from the code cache.
+  void compileReductionCode(ReductionCode& reduction_code, const CodeCacheKey& key) const;
+
   // Generate a function which checks whether a row is empty.
   void isEmpty(const ReductionCode& reduction_code) const;
 
@@ -26,6 +26,7 @@
 
 #include "CudaMgr/CudaMgr.h"
 #include "Execute.h"
+#include "ExternalSort.h"
 #include "InPlaceSort.h"
 #include "ResultSetSortImpl.h"
 
@@ -36,6 +37,8 @@
 #include "Shared/parallel_sort.h"
 #include "Shared/thread_count.h"
 
+#include <array>
+#include <atomic>
 #include <future>
 
 #ifdef HAVE_TBB
@@ -231,6 +234,22 @@ void baselineSort(ResultSet* rs,
 }  // namespace
 #endif  // HAVE_CUDA
 
+namespace {
+
+// Building ranks touches every string of the dictionary, which doesn't pay off when
+// only a few rows of a big dictionary are sorted. Up-to-date ranks are used anyway.
+std::shared_ptr<const std::vector<int32_t>> get_dict_sorted_ranks(
+    StringDictionary* string_dict,
+    const size_t num_rows) {
+  constexpr size_t kMaxDictStringsPerSortedRow{16};
+  CHECK(string_dict);
+  const bool build =
+      num_rows * kMaxDictStringsPerSortedRow >= string_dict->storageEntryCount();
+  return string_dict->getSortedRanks(build);
+}
+
+}  // namespace
+
 template <typename BUFFER_ITERATOR_TYPE>
 void ResultSetComparator<BUFFER_ITERATOR_TYPE>::materializeCountDistinctColumns() {
   for (const auto& order_entry : order_entries_) {
@@ -241,6 +260,26 @@ void ResultSetComparator<BUFFER_ITERATOR_TYPE>::materializeCountDistinctColumns(
   }
 }
 
+template <typename BUFFER_ITERATOR_TYPE>
+void ResultSetComparator<BUFFER_ITERATOR_TYPE>::materializeDictSortedRanks() {
+  for (const auto& order_entry : order_entries_) {
+    const auto& agg_info = result_set_->getTargetInfos()[order_entry.tle_no - 1];
+    if (is_distinct_target(agg_info) ||
+        agg_info.agg_kind == hdk::ir::AggType::kApproxQuantile ||
+        !get_compact_type(agg_info)->isExtDictionary()) {
+      dict_sorted_ranks_.emplace_back(nullptr);
+      continue;
+    }
+    CHECK(executor_);
+    const auto string_dict_proxy = executor_->getStringDictionaryProxy(
+        get_compact_type(agg_info)->as<hdk::ir::ExtDictionaryType>()->dictId(),
+        result_set_->getRowSetMemOwner(),
+        false);
+    dict_sorted_ranks_.emplace_back(
+        get_dict_sorted_ranks(string_dict_proxy->getDictionary(), permutation_.size()));
+  }
+}
+
 template <typename BUFFER_ITERATOR_TYPE>
 ApproxQuantileBuffers
 ResultSetComparator<BUFFER_ITERATOR_TYPE>::materializeApproxQuantileColumns() const {
@@ -346,8 +385,10 @@ bool ResultSetComparator<BUFFER_ITERATOR_TYPE>::operator()(
   const auto fixedup_rhs = rhs_storage_lookup_result.fixedup_entry_idx;
   size_t materialized_count_distinct_buffer_idx{0};
   size_t materialized_approx_quantile_buffer_idx{0};
+  size_t order_entry_idx{0};
 
   for (const auto& order_entry : order_entries_) {
+    const auto& dict_sorted_ranks = dict_sorted_ranks_[order_entry_idx++];
     CHECK_GE(order_entry.tle_no, 1);
     const auto& agg_info = result_set_->getTargetInfos()[order_entry.tle_no - 1];
     const auto entry_type = get_compact_type(agg_info);
@@ -427,6 +468,17 @@ bool ResultSetComparator<BUFFER_ITERATOR_TYPE>::operator()(
       CHECK(rhs_v.isInt());
       if (UNLIKELY(entry_type->isExtDictionary())) {
         CHECK_EQ(4, entry_type->canonicalSize());
+        // Transient strings are not in the dictionary and are compared as strings.
+        // So are all strings if ranks were not built.
+        if (dict_sorted_ranks && lhs_v.i1 >= 0 && rhs_v.i1 >= 0 &&
+            static_cast<size_t>(lhs_v.i1) < dict_sorted_ranks->size() &&
+            static_cast<size_t>(rhs_v.i1) < dict_sorted_ranks->size()) {
+          if (lhs_v.i1 == rhs_v.i1) {
+            continue;
+          }
+          const auto& ranks = *dict_sorted_ranks;
+          return (ranks[lhs_v.i1] < ranks[rhs_v.i1]) != order_entry.is_desc;
+        }
         CHECK(executor_);
         const auto string_dict_proxy = executor_->getStringDictionaryProxy(
             entry_type->as<hdk::ir::ExtDictionaryType>()->dictId(),
@@ -647,20 +699,42 @@ void parallelTop(ResultSet* rs,
 
   // Left-copy disjoint top-sorted subranges into one contiguous range.
   // ++++....+++.....+++++...  ->  ++++++++++++............
-  auto end = permutation.begin() + permutation_views.front().size();
-  for (size_t i = 1; i < nthreads; ++i) {
-    std::copy(permutation_views[i].begin(), permutation_views[i].end(), end);
+  std::vector<std::pair<size_t, size_t>> ranges;
+  ranges.reserve(nthreads);
+  auto end = permutation.begin();
+  for (size_t i = 0; i < nthreads; ++i) {
+    const size_t range_begin = end - permutation.begin();
+    if (i) {
+      std::copy(permutation_views[i].begin(), permutation_views[i].end(), end);
+    }
     end += permutation_views[i].size();
+    if (permutation_views[i].size()) {
+      ranges.emplace_back(range_begin, end - permutation.begin());
+    }
   }
 
-  // Top sort final range.
+  // Subranges are sorted, so the final top is a k-way merge of them.
   PermutationView pv(permutation.data(), end - permutation.begin());
   const auto compare = createComparator(rs, order_entries, pv, executor, false);
-  pv = topPermutation(pv, top_n, compare, false);
-  permutation.resize(pv.size());
-  permutation.shrink_to_fit();
+  const auto heap_compare = [&pv, &compare](const std::pair<size_t, size_t>& lhs,
+                                            const std::pair<size_t, size_t>& rhs) {
+    return compare(pv[rhs.first], pv[lhs.first]);
+  };
+  std::make_heap(ranges.begin(), ranges.end(), heap_compare);
+  Permutation top;
+  top.reserve(std::min(top_n, pv.size()));
+  while (!ranges.empty() && top.size() < top_n) {
+    std::pop_heap(ranges.begin(), ranges.end(), heap_compare);
+    auto& range = ranges.back();
+    top.push_back(pv[range.first++]);
+    if (range.first == range.second) {
+      ranges.pop_back();
+    } else {
+      std::push_heap(ranges.begin(), ranges.end(), heap_compare);
+    }
+  }
 
-  rs->setPermutationBuffer(std::move(permutation));
+  rs->setPermutationBuffer(std::move(top));
 }
 
 template <typename T>
@@ -751,6 +825,405 @@ void sort_onecol_cpu(int8_t* val_buff,
   }
 }
 
+// Run func(interval) for each of n_chunks subranges of [0, size).
+template <typename F>
+void run_on_intervals(const size_t size,
+                      const size_t n_chunks,
+                      const bool single_threaded,
+                      const F& func) {
+  if (single_threaded || n_chunks == 1) {
+    for (auto interval : makeIntervals<size_t>(0, size, n_chunks)) {
+      func(interval);
+    }
+    return;
+  }
+  threading::task_group thread_pool;
+  for (auto interval : makeIntervals<size_t>(0, size, n_chunks)) {
+    thread_pool.run([&func, query_id = logger::query_id(), interval] {
+      auto qid_scope_guard = logger::set_thread_local_query_id(query_id);
+      func(interval);
+    });
+  }
+  thread_pool.wait();
+}
+
+// Stable parallel LSD radix sort of (keys, permutation) pairs by the lower key_bytes
+// bytes of keys. Each pass builds per-chunk histograms of a key byte and scatters
+// chunks to precomputed offsets. Passes over bytes with a single value are skipped.
+void radix_sort_by_key(std::vector<uint64_t>& keys,
+                       PermutationView permutation,
+                       const size_t key_bytes,
+                       const bool single_threaded) {
+  constexpr size_t kRadix = 256;
+  constexpr size_t kMinChunkSize = 1 << 16;
+  const size_t size = keys.size();
+  CHECK_EQ(size, permutation.size());
+  const size_t n_chunks =
+      single_threaded ? 1 : std::clamp<size_t>(size / kMinChunkSize, 1, cpu_threads());
+  std::vector<uint64_t> tmp_keys(size);
+  Permutation tmp_permutation(size);
+  uint64_t* src_keys = keys.data();
+  uint64_t* dst_keys = tmp_keys.data();
+  PermutationIdx* src_idx = permutation.begin();
+  PermutationIdx* dst_idx = tmp_permutation.data();
+  std::vector<std::array<size_t, kRadix>> offsets(n_chunks);
+  for (size_t byte_idx = 0; byte_idx < key_bytes; ++byte_idx) {
+    const size_t shift = byte_idx * 8;
+    run_on_intervals(size, n_chunks, single_threaded, [&](const auto& interval) {
+      auto& hist = offsets[interval.index];
+      hist.fill(0);
+      for (size_t i = interval.begin; i < interval.end; ++i) {
+        ++hist[(src_keys[i] >> shift) & (kRadix - 1)];
+      }
+    });
+    // Turn histograms into scatter offsets ordered by digit, then by chunk.
+    bool single_digit = false;
+    size_t offset = 0;
+    for (size_t digit = 0; digit < kRadix; ++digit) {
+      size_t digit_count = 0;
+      for (auto& chunk_offsets : offsets) {
+        const auto count = chunk_offsets[digit];
+        chunk_offsets[digit] = offset;
+        offset += count;
+        digit_count += count;
+      }
+      single_digit |= digit_count == size;
+    }
+    if (single_digit) {
+      continue;
+    }
+    run_on_intervals(size, n_chunks, single_threaded, [&](const auto& interval) {
+      auto& chunk_offsets = offsets[interval.index];
+      for (size_t i = interval.begin; i < interval.end; ++i) {
+        const auto pos = chunk_offsets[(src_keys[i] >> shift) & (kRadix - 1)]++;
+        dst_keys[pos] = src_keys[i];
+        dst_idx[pos] = src_idx[i];
+      }
+    });
+    std::swap(src_keys, dst_keys);
+    std::swap(src_idx, dst_idx);
+  }
+  if (src_idx != permutation.begin()) {
+    std::copy(src_keys, src_keys + size, keys.begin());
+    std::copy(src_idx, src_idx + size, permutation.begin());
+  }
+}
+
+bool can_use_radix_sort(const ResultSet* rs,
+                        const std::list<hdk::ir::OrderEntry>& order_entries,
+                        const Executor* executor) {
+  for (const auto& order_entry : order_entries) {
+    const auto& agg_info = rs->getTargetInfos()[order_entry.tle_no - 1];
+    if (is_distinct_target(agg_info) || agg_info.agg_kind == hdk::ir::AggType::kAvg ||
+        agg_info.agg_kind == hdk::ir::AggType::kApproxQuantile) {
+      return false;
+    }
+    const auto entry_type = get_compact_type(agg_info);
+    if (entry_type->isExtDictionary()) {
+      if (!executor || entry_type->canonicalSize() != 4) {
+        return false;
+      }
+    } else if (!entry_type->isInteger() && !entry_type->isDecimal() &&
+               !entry_type->isBoolean() && !entry_type->isDateTime()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Order-preserving values of a single order entry. Dictionary-encoded strings are
+// replaced with their sorted ranks.
+struct RadixSortColumn {
+  std::vector<int64_t> values;
+  std::vector<int8_t> is_null;
+  int64_t min = std::numeric_limits<int64_t>::max();
+  int64_t max = std::numeric_limits<int64_t>::min();
+  bool has_nulls = false;
+};
+
+// Translation of order entry values to codes of the concatenated key.
+struct RadixSortKeyCode {
+  int64_t min;
+  int64_t max;
+  bool has_nulls;
+  size_t bits;
+  uint64_t null_code;
+};
+
+// Fetch sorted ranks of dictionary-encoded order entries, null for other entries.
+// Return false if ranks of some dictionary are not worth building.
+bool get_radix_sort_dict_ranks(
+    const ResultSet* rs,
+    const std::list<hdk::ir::OrderEntry>& order_entries,
+    const size_t num_rows,
+    const Executor* executor,
+    std::vector<std::shared_ptr<const std::vector<int32_t>>>& dict_sorted_ranks) {
+  for (const auto& order_entry : order_entries) {
+    const auto& target_info = rs->getTargetInfos()[order_entry.tle_no - 1];
+    const auto entry_type = get_compact_type(target_info);
+    if (!entry_type->isExtDictionary()) {
+      dict_sorted_ranks.emplace_back(nullptr);
+      continue;
+    }
+    const auto string_dict_proxy = executor->getStringDictionaryProxy(
+        entry_type->as<hdk::ir::ExtDictionaryType>()->dictId(),
+        rs->getRowSetMemOwner(),
+        false);
+    dict_sorted_ranks.emplace_back(
+        get_dict_sorted_ranks(string_dict_proxy->getDictionary(), num_rows));
+    if (!dict_sorted_ranks.back()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Collect stats of the order entry values and, if store_values is set, the values
+// themselves. Return false if values are not suitable for radix sort.
+template <typename BUFFER_ITERATOR_TYPE>
+bool materialize_radix_sort_column(
+    const ResultSet* rs,
+    const hdk::ir::OrderEntry& order_entry,
+    const std::shared_ptr<const std::vector<int32_t>>& dict_sorted_ranks,
+    const PermutationView permutation,
+    const bool single_threaded,
+    const bool store_values,
+    RadixSortColumn& column) {
+  const auto target_idx = order_entry.tle_no - 1;
+  const auto entry_type = get_compact_type(rs->getTargetInfos()[target_idx]);
+  const size_t size = permutation.size();
+  const size_t n_chunks = single_threaded ? 1 : cpu_threads();
+  if (store_values) {
+    column.values.resize(size);
+    column.is_null.resize(size);
+  }
+  std::vector<RadixSortColumn> chunk_stats(n_chunks);
+  std::atomic<bool> unsupported{false};
+  const BUFFER_ITERATOR_TYPE buffer_itr(rs);
+  run_on_intervals(size, n_chunks, single_threaded, [&](const auto& interval) {
+    auto& stats = chunk_stats[interval.index];
+    for (size_t i = interval.begin; i < interval.end; ++i) {
+      const auto storage_lookup_result = rs->findStorage(permutation[i]);
+      const auto value = buffer_itr.getColumnInternal(
+          storage_lookup_result.storage_ptr->getUnderlyingBuffer(),
+          storage_lookup_result.fixedup_entry_idx,
+          target_idx,
+          storage_lookup_result);
+      if (!value.isInt()) {
+        unsupported = true;
+        return;
+      }
+      if (ResultSet::isNull(entry_type, value, false)) {
+        if (store_values) {
+          column.is_null[i] = 1;
+        }
+        stats.has_nulls = true;
+        continue;
+      }
+      auto key = value.i1;
+      if (dict_sorted_ranks) {
+        // Transient strings have no rank and require string comparison.
+        if (key < 0 || static_cast<size_t>(key) >= dict_sorted_ranks->size()) {
+          unsupported = true;
+          return;
+        }
+        key = (*dict_sorted_ranks)[key];
+      }
+      if (store_values) {
+        column.values[i] = key;
+        column.is_null[i] = 0;
+      }
+      stats.min = std::min(stats.min, key);
+      stats.max = std::max(stats.max, key);
+    }
+  });
+  if (unsupported) {
+    return false;
+  }
+  for (auto& stats : chunk_stats) {
+    column.min = std::min(column.min, stats.min);
+    column.max = std::max(column.max, stats.max);
+    column.has_nulls |= stats.has_nulls;
+  }
+  return true;
+}
+
+bool materialize_radix_sort_columns(
+    const ResultSet* rs,
+    const std::list<hdk::ir::OrderEntry>& order_entries,
+    const std::vector<std::shared_ptr<const std::vector<int32_t>>>& dict_sorted_ranks,
+    const PermutationView permutation,
+    const bool single_threaded,
+    const bool store_values,
+    std::vector<RadixSortColumn>& columns) {
+  columns.resize(order_entries.size());
+  size_t col_idx = 0;
+  for (const auto& order_entry : order_entries) {
+    const bool materialized =
+        rs->getQueryMemDesc().didOutputColumnar()
+            ? materialize_radix_sort_column<ResultSet::ColumnWiseTargetAccessor>(
+                  rs,
+                  order_entry,
+                  dict_sorted_ranks[col_idx],
+                  permutation,
+                  single_threaded,
+                  store_values,
+                  columns[col_idx])
+            : materialize_radix_sort_column<ResultSet::RowWiseTargetAccessor>(
+                  rs,
+                  order_entry,
+                  dict_sorted_ranks[col_idx],
+                  permutation,
+                  single_threaded,
+                  store_values,
+                  columns[col_idx]);
+    if (!materialized) {
+      return false;
+    }
+    ++col_idx;
+  }
+  return true;
+}
+
+// Each key is translated to an unsigned offset from the min (or from the max for DESC
+// order) with a reserved code for nulls, so it takes only as many bits as its value
+// range needs. Return false if the concatenated key doesn't fit 64 bits.
+bool build_radix_sort_key_codes(const std::list<hdk::ir::OrderEntry>& order_entries,
+                                const std::vector<RadixSortColumn>& columns,
+                                std::vector<RadixSortKeyCode>& codes,
+                                size_t& total_bits) {
+  total_bits = 0;
+  size_t col_idx = 0;
+  for (const auto& order_entry : order_entries) {
+    const auto& column = columns[col_idx++];
+    RadixSortKeyCode code{column.min, column.max, column.has_nulls, 0, 0};
+    uint64_t max_code = 0;
+    if (column.min <= column.max) {
+      max_code = static_cast<uint64_t>(column.max) - static_cast<uint64_t>(column.min);
+      if (column.has_nulls && max_code == std::numeric_limits<uint64_t>::max()) {
+        return false;
+      }
+    }
+    // Nulls take the code right below or right above all values.
+    if (column.has_nulls && !order_entry.nulls_first) {
+      code.null_code = column.min <= column.max ? max_code + 1 : 0;
+    }
+    max_code += column.has_nulls ? 1 : 0;
+    code.bits = max_code ? 64 - __builtin_clzll(max_code) : 0;
+    total_bits += code.bits;
+    if (total_bits > 64) {
+      VLOG(1) << "Sort key doesn't fit 64 bits, fall back to comparison sort";
+      return false;
+    }
+    codes.push_back(code);
+  }
+  return true;
+}
+
+std::vector<uint64_t> build_radix_sort_keys(
+    const std::list<hdk::ir::OrderEntry>& order_entries,
+    const std::vector<RadixSortColumn>& columns,
+    const std::vector<RadixSortKeyCode>& codes,
+    const size_t size,
+    const bool single_threaded) {
+  std::vector<uint64_t> keys(size);
+  const size_t n_chunks = single_threaded ? 1 : cpu_threads();
+  run_on_intervals(size, n_chunks, single_threaded, [&](const auto& interval) {
+    for (size_t i = interval.begin; i < interval.end; ++i) {
+      uint64_t key = 0;
+      size_t col_idx = 0;
+      for (const auto& order_entry : order_entries) {
+        const auto& column = columns[col_idx];
+        const auto& key_code = codes[col_idx++];
+        uint64_t code = key_code.null_code;
+        if (!column.is_null[i]) {
+          const auto value = column.values[i];
+          code = order_entry.is_desc
+                     ? static_cast<uint64_t>(key_code.max) - static_cast<uint64_t>(value)
+                     : static_cast<uint64_t>(value) - static_cast<uint64_t>(key_code.min);
+          code += key_code.has_nulls && order_entry.nulls_first ? 1 : 0;
+        }
+        // Shift by 64 is undefined, so handle the case of a single full-width key.
+        key = key_code.bits == 64 ? code : (key << key_code.bits) | code;
+      }
+      keys[i] = key;
+    }
+  });
+  return keys;
+}
+
+// Sort the permutation with a radix sort over a key built by concatenation of
+// normalized keys of all order entries. Return false and leave the permutation
+// unchanged if keys are not integers or don't fit 64 bits.
+//
+// If the working memory of the sort exceeds the configured threshold, the
+// permutation is sorted by runs which are spilled to local storage and merged.
+// Values of order entries are then fetched twice: to collect stats for key
+// normalization and to build keys of each run.
+bool radix_sort_permutation(const ResultSet* rs,
+                            const std::list<hdk::ir::OrderEntry>& order_entries,
+                            PermutationView permutation,
+                            const Executor* executor,
+                            const ResultSetConfig& config,
+                            const bool single_threaded) {
+  auto timer = DEBUG_TIMER(__func__);
+  // Materialized values, the key with its copy and a permutation copy.
+  const size_t entry_bytes = order_entries.size() * (sizeof(int64_t) + sizeof(int8_t)) +
+                             2 * sizeof(uint64_t) + sizeof(PermutationIdx);
+  const size_t size = permutation.size();
+  const bool spill = config.external_sort_threshold &&
+                     size * entry_bytes > config.external_sort_threshold;
+  // Ranks are fetched once, so that keys of all runs are built from the same ranks.
+  std::vector<std::shared_ptr<const std::vector<int32_t>>> dict_sorted_ranks;
+  if (!get_radix_sort_dict_ranks(rs, order_entries, size, executor, dict_sorted_ranks)) {
+    return false;
+  }
+  std::vector<RadixSortColumn> columns;
+  if (!materialize_radix_sort_columns(rs,
+                                      order_entries,
+                                      dict_sorted_ranks,
+                                      permutation,
+                                      single_threaded,
+                                      !spill,
+                                      columns)) {
+    return false;
+  }
+  std::vector<RadixSortKeyCode> codes;
+  size_t total_bits;
+  if (!build_radix_sort_key_codes(order_entries, columns, codes, total_bits)) {
+    return false;
+  }
+  const size_t key_bytes = (total_bits + 7) / 8;
+
+  if (!spill) {
+    auto keys =
+        build_radix_sort_keys(order_entries, columns, codes, size, single_threaded);
+    columns.clear();
+    radix_sort_by_key(keys, permutation, key_bytes, single_threaded);
+    return true;
+  }
+
+  const size_t run_size =
+      std::max<size_t>(1, config.external_sort_threshold / entry_bytes);
+  VLOG(1) << "Sort " << size << " entries by runs of " << run_size
+          << " entries spilled to local storage";
+  SpilledSortRuns runs(config.external_sort_dir, config.external_sort_threshold);
+  for (size_t run_start = 0; run_start < size; run_start += run_size) {
+    PermutationView run(permutation.begin() + run_start,
+                        std::min(run_size, size - run_start));
+    std::vector<RadixSortColumn> run_columns;
+    CHECK(materialize_radix_sort_columns(
+        rs, order_entries, dict_sorted_ranks, run, single_threaded, true, run_columns));
+    auto keys = build_radix_sort_keys(
+        order_entries, run_columns, codes, run.size(), single_threaded);
+    run_columns.clear();
+    radix_sort_by_key(keys, run, key_bytes, single_threaded);
+    runs.addRun(keys.data(), run.begin(), run.size());
+  }
+  runs.merge(permutation.begin());
+  return true;
+}
+
 }  // namespace
 
 void sortResultSet(ResultSet* rs,
@@ -845,8 +1318,15 @@ void sortResultSet(ResultSet* rs,
     if (top_n == 0) {
       top_n = pv.size();  // top_n == 0 implies a full sort
     }
-    pv = topPermutation(
-        pv, top_n, createComparator(rs, order_entries, pv, executor, false), false);
+    const bool radix_sorted =
+        top_n >= pv.size() && executor && executor->getConfig().rs.enable_radix_sort &&
+        can_use_radix_sort(rs, order_entries, executor) &&
+        radix_sort_permutation(
+            rs, order_entries, pv, executor, executor->getConfig().rs, false);
+    if (!radix_sorted) {
+      pv = topPermutation(
+          pv, top_n, createComparator(rs, order_entries, pv, executor, false), false);
+    }
     if (pv.size() < permutation.size()) {
       permutation.resize(pv.size());
       permutation.shrink_to_fit();
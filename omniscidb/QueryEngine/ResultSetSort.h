@@ -31,9 +31,11 @@ struct ResultSetComparator {
       , single_threaded_(single_threaded)
       , approx_quantile_materialized_buffers_(materializeApproxQuantileColumns()) {
     materializeCountDistinctColumns();
+    materializeDictSortedRanks();
   }
 
   void materializeCountDistinctColumns();
+  void materializeDictSortedRanks();
   ApproxQuantileBuffers materializeApproxQuantileColumns() const;
 
   std::vector<int64_t> materializeCountDistinctColumn(
@@ -51,6 +53,9 @@ struct ResultSetComparator {
   const bool single_threaded_;
   std::vector<std::vector<int64_t>> count_distinct_materialized_buffers_;
   const ApproxQuantileBuffers approx_quantile_materialized_buffers_;
+  // Sorted ranks of dictionary strings for each order entry. Null for entries which
+  // are not dictionary-encoded.
+  std::vector<std::shared_ptr<const std::vector<int32_t>>> dict_sorted_ranks_;
 };
 
 template struct ResultSetComparator<ResultSet::RowWiseTargetAccessor>;
@@ -34,9 +34,11 @@
 #include "QueryEngine/ExpressionRewrite.h"
 #include "QueryEngine/GpuInitGroups.h"
 #include "QueryEngine/GpuMemUtils.h"
+#include "QueryEngine/HyperLogLogRank.h"
 #include "QueryEngine/InPlaceSort.h"
 #include "QueryEngine/LLVMFunctionAttributesUtil.h"
 #include "QueryEngine/MaxwellCodegenPatch.h"
+#include "QueryEngine/MurmurHash.h"
 #include "QueryEngine/OutputBufferInitialization.h"
 #include "QueryEngine/QueryTemplateGenerator.h"
 #include "QueryEngine/RuntimeFunctions.h"
@@ -44,7 +46,9 @@
 #include "QueryEngine/TargetExprBuilder.h"
 #include "QueryEngine/TopKSort.h"
 #include "QueryEngine/WindowContext.h"
+#include "ResultSet/HyperLogLog.h"
 #include "ResultSet/QueryMemoryDescriptor.h"
+#include "ResultSet/RoaringBitmap.h"
 #include "Shared/checked_alloc.h"
 #include "Shared/funcannotations.h"
 #include "ThirdParty/robin_hood.h"
@@ -496,6 +500,10 @@ std::tuple<llvm::Value*, llvm::Value*> RowFuncBuilder::codegenSingleColumnPerfec
   if (!query_mem_desc.didOutputColumnar() && query_mem_desc.hasKeylessHash()) {
     get_group_fn_name += "_keyless";
   }
+  const bool first_touch_init = query_mem_desc.firstTouchInitGroups(co.device_type);
+  if (first_touch_init) {
+    get_group_fn_name += "_first_touch";
+  }
   if (query_mem_desc.interleavedBins(co.device_type)) {
     CHECK(!query_mem_desc.didOutputColumnar());
     CHECK(query_mem_desc.hasKeylessHash());
@@ -514,10 +522,18 @@ std::tuple<llvm::Value*, llvm::Value*> RowFuncBuilder::codegenSingleColumnPerfec
     if (!query_mem_desc.didOutputColumnar()) {
       get_group_fn_args.push_back(LL_INT(row_size_quad));
     }
+    if (first_touch_init) {
+      get_group_fn_args.push_back(
+          LL_INT(static_cast<int64_t>(query_mem_desc.getEntryCount())));
+    }
   } else {
     if (!query_mem_desc.didOutputColumnar()) {
       get_group_fn_args.push_back(LL_INT(row_size_quad));
     }
+    if (first_touch_init) {
+      get_group_fn_args.push_back(
+          LL_INT(static_cast<int64_t>(query_mem_desc.getEntryCount())));
+    }
     if (query_mem_desc.interleavedBins(co.device_type)) {
       auto warp_idx = emitCall("thread_warp_idx", {LL_INT(executor_->warpSize())});
       get_group_fn_args.push_back(warp_idx);
@@ -601,24 +617,27 @@ std::tuple<llvm::Value*, llvm::Value*> RowFuncBuilder::codegenMultiColumnBaselin
           QueryDescriptionType::GroupByBaselineHash &&
       co.use_groupby_buffer_desc) {
     auto [hash_ptr, hash_size] = genLoadHashDesc(groups_buffer, co);
-    func_args = std::vector<llvm::Value*>{hash_ptr,
-                                          hash_size,
-                                          &*group_key,
-                                          &*key_size_lv,
-                                          LL_INT(static_cast<int32_t>(key_width))};
+    func_args =
+        std::vector<llvm::Value*>{hash_ptr, hash_size, &*group_key, &*key_size_lv};
   } else {
     func_args = std::vector<llvm::Value*>{
         groups_buffer,
         LL_INT(static_cast<int32_t>(query_mem_desc.getEntryCount())),
         &*group_key,
-        &*key_size_lv,
-        LL_INT(static_cast<int32_t>(key_width))};
+        &*key_size_lv};
   }
 
   std::string func_name{"get_group_value"};
   if (query_mem_desc.didOutputColumnar()) {
     func_name += "_columnar_slot";
+  }
+  // Use the probe specialized for the key width when there is one.
+  if (key_width == sizeof(int32_t) || key_width == sizeof(int64_t)) {
+    func_name += "_key" + std::to_string(key_width);
   } else {
+    func_args.push_back(LL_INT(static_cast<int32_t>(key_width)));
+  }
+  if (!query_mem_desc.didOutputColumnar()) {
     func_args.push_back(LL_INT(row_size_quad));
   }
   if (co.with_dynamic_watchdog) {
@@ -1001,6 +1020,29 @@ extern "C" RUNTIME_EXPORT void agg_count_distinct_skip_val(int64_t* agg,
   }
 }
 
+extern "C" RUNTIME_EXPORT void agg_count_distinct_roaring(int64_t* agg,
+                                                          const int64_t val) {
+  reinterpret_cast<RoaringBitmap*>(*agg)->add(val);
+}
+
+extern "C" RUNTIME_EXPORT void agg_count_distinct_roaring_skip_val(
+    int64_t* agg,
+    const int64_t val,
+    const int64_t skip_val) {
+  if (val != skip_val) {
+    agg_count_distinct_roaring(agg, val);
+  }
+}
+
+extern "C" RUNTIME_EXPORT void agg_approximate_count_distinct_sparse(int64_t* agg,
+                                                                     const int64_t key,
+                                                                     const uint32_t b) {
+  const uint64_t hash = MurmurHash64A(&key, sizeof(key), 0);
+  const uint32_t index = hash >> (64 - b);
+  const uint8_t rank = get_rank(hash << b, 64 - b);
+  reinterpret_cast<SparseHyperLogLog*>(*agg)->update(b, index, rank);
+}
+
 extern "C" RUNTIME_EXPORT void agg_approx_quantile(int64_t* agg, const double val) {
   auto* t_digest = reinterpret_cast<quantile::TDigest*>(*agg);
   t_digest->allocate();
@@ -1023,8 +1065,16 @@ void RowFuncBuilder::codegenCountDistinct(const size_t target_idx,
       query_mem_desc.getCountDistinctDescriptor(target_idx);
   CHECK(count_distinct_descriptor.impl_type_ != CountDistinctImplType::Invalid);
   if (agg_info.agg_kind == hdk::ir::AggType::kApproxCountDistinct) {
-    CHECK(count_distinct_descriptor.impl_type_ == CountDistinctImplType::Bitmap);
     agg_args.push_back(LL_INT(int32_t(count_distinct_descriptor.bitmap_sz_bits)));
+    if (count_distinct_descriptor.impl_type_ ==
+        CountDistinctImplType::SparseHyperLogLog) {
+      CHECK(device_type == ExecutorDeviceType::CPU);
+      executor_->cgen_state_->emitExternalCall("agg_approximate_count_distinct_sparse",
+                                               llvm::Type::getVoidTy(LL_CONTEXT),
+                                               agg_args);
+      return;
+    }
+    CHECK(count_distinct_descriptor.impl_type_ == CountDistinctImplType::Bitmap);
     if (device_type == ExecutorDeviceType::GPU) {
       const auto base_dev_addr = getAdditionalLiteral(-1);
       const auto base_host_addr = getAdditionalLiteral(-2);
@@ -1040,6 +1090,9 @@ void RowFuncBuilder::codegenCountDistinct(const size_t target_idx,
   if (count_distinct_descriptor.impl_type_ == CountDistinctImplType::Bitmap) {
     agg_fname += "_bitmap";
     agg_args.push_back(LL_INT(static_cast<int64_t>(count_distinct_descriptor.min_val)));
+  } else if (count_distinct_descriptor.impl_type_ ==
+             CountDistinctImplType::RoaringBitmap) {
+    agg_fname += "_roaring";
   }
   if (agg_info.skip_null_val) {
     auto null_lv = executor_->cgen_state_->castToTypeIn(
@@ -427,6 +427,48 @@ extern "C" RUNTIME_EXPORT ALWAYS_INLINE int8_t bit_is_set(const int64_t bitset,
              : 0;
 }
 
+extern "C" RUNTIME_EXPORT ALWAYS_INLINE int64_t
+in_values_hash_bucket(const int64_t val, const int64_t bucket_mask) {
+  return static_cast<int64_t>(
+      ((static_cast<uint64_t>(val) * 0x9E3779B97F4A7C15ULL) >> 32) & bucket_mask);
+}
+
+// Probe a hashed IN set built by InValuesBitmap. The set is an open addressing table
+// of buckets with kInValuesHashBucketSlots slots each, empty slots hold null_val.
+extern "C" RUNTIME_EXPORT ALWAYS_INLINE int8_t
+hash_set_contains(const int64_t hash_set,
+                  const int64_t val,
+                  const int64_t min_val,
+                  const int64_t max_val,
+                  const int64_t bucket_mask,
+                  const int64_t null_val,
+                  const int8_t null_bool_val) {
+  if (val == null_val) {
+    return null_bool_val;
+  }
+  if (val < min_val || val > max_val || !hash_set) {
+    return 0;
+  }
+  const auto slots = reinterpret_cast<GENERIC_ADDR_SPACE const int64_t*>(hash_set);
+  for (int64_t bucket = in_values_hash_bucket(val, bucket_mask);;
+       bucket = (bucket + 1) & bucket_mask) {
+    const auto bucket_slots = slots + bucket * kInValuesHashBucketSlots;
+    // No early exit, so the slot comparisons are vectorized.
+    bool found = false;
+    bool has_empty = false;
+    for (int64_t i = 0; i < kInValuesHashBucketSlots; ++i) {
+      found |= bucket_slots[i] == val;
+      has_empty |= bucket_slots[i] == null_val;
+    }
+    if (found) {
+      return 1;
+    }
+    if (has_empty) {
+      return 0;
+    }
+  }
+}
+
 extern "C" RUNTIME_EXPORT ALWAYS_INLINE int64_t agg_sum(GENERIC_ADDR_SPACE int64_t* agg,
                                                         const int64_t val) {
   const auto old = *agg;
@@ -1092,6 +1134,10 @@ extern "C" GPU_RT_STUB int64_t get_block_index() {
   return 0;
 }
 
+extern "C" GPU_RT_STUB int64_t get_block_dim() {
+  return 1;
+}
+
 #undef GPU_RT_STUB
 
 extern "C" RUNTIME_EXPORT ALWAYS_INLINE void record_error_code(
@@ -1367,6 +1413,29 @@ get_group_value_fast_keyless(GENERIC_ADDR_SPACE int64_t* groups_buffer,
   return groups_buffer + row_size_quad * (key - min_key);
 }
 
+extern "C" RUNTIME_EXPORT ALWAYS_INLINE GENERIC_ADDR_SPACE int64_t*
+get_group_value_fast_keyless_first_touch(GENERIC_ADDR_SPACE int64_t* groups_buffer,
+                                         const int64_t key,
+                                         const int64_t min_key,
+                                         const int64_t /* bucket */,
+                                         const uint32_t row_size_quad,
+                                         const int64_t entry_count) {
+  const int64_t key_diff = key - min_key;
+  GENERIC_ADDR_SPACE int64_t* row = groups_buffer + row_size_quad * key_diff;
+  GENERIC_ADDR_SPACE const int64_t* init_row =
+      groups_buffer + entry_count * row_size_quad;
+  GENERIC_ADDR_SPACE uint64_t* occupancy =
+      reinterpret_cast<GENERIC_ADDR_SPACE uint64_t*>(init_row + row_size_quad);
+  const uint64_t mask = 1ULL << (key_diff & 63);
+  if (!(occupancy[key_diff >> 6] & mask)) {
+    occupancy[key_diff >> 6] |= mask;
+    for (uint32_t i = 0; i < row_size_quad; ++i) {
+      row[i] = init_row[i];
+    }
+  }
+  return row;
+}
+
 extern "C" RUNTIME_EXPORT ALWAYS_INLINE GENERIC_ADDR_SPACE int64_t*
 get_group_value_fast_keyless_semiprivate(GENERIC_ADDR_SPACE int64_t* groups_buffer,
                                          const int64_t key,
@@ -1445,6 +1514,16 @@ map_string_dict_id(const int32_t string_id,
   return translation_map[string_id - min_source_id];
 }
 
+extern "C" ALWAYS_INLINE DEVICE int64_t
+date_lookup_table_get(const int64_t date,
+                      const int64_t table_handle,
+                      const int64_t min_day_start) {
+  GENERIC_ADDR_SPACE const int64_t* table =
+      reinterpret_cast<GENERIC_ADDR_SPACE const int64_t*>(table_handle);
+  // Dates are within the table range, so the offset is non-negative.
+  return table[(date - min_day_start) / 86400];
+}
+
 extern "C" RUNTIME_EXPORT ALWAYS_INLINE DEVICE bool sample_ratio(
     const double proportion,
     const int64_t row_offset) {
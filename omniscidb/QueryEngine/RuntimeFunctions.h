@@ -145,6 +145,12 @@ extern "C" RUNTIME_EXPORT void agg_count_distinct_bitmap(GENERIC_ADDR_SPACE int6
                                                          const int64_t val,
                                                          const int64_t min_val);
 
+// Number of slots in a bucket of a hashed IN set, a bucket fits a cache line.
+constexpr int64_t kInValuesHashBucketSlots = 8;
+
+extern "C" RUNTIME_EXPORT int64_t in_values_hash_bucket(const int64_t val,
+                                                        const int64_t bucket_mask);
+
 extern "C" RUNTIME_EXPORT uint32_t key_hash(GENERIC_ADDR_SPACE const int64_t* key,
                                             const uint32_t key_qw_count,
                                             const uint32_t key_byte_width);
@@ -190,6 +196,14 @@ extern "C" RUNTIME_EXPORT GENERIC_ADDR_SPACE int64_t* get_group_value_fast(
     const int64_t bucket,
     const uint32_t row_size_quad);
 
+extern "C" RUNTIME_EXPORT GENERIC_ADDR_SPACE int64_t*
+get_group_value_fast_first_touch(GENERIC_ADDR_SPACE int64_t* groups_buffer,
+                                 const int64_t key,
+                                 const int64_t min_key,
+                                 const int64_t bucket,
+                                 const uint32_t row_size_quad,
+                                 const int64_t entry_count);
+
 extern "C" RUNTIME_EXPORT GENERIC_ADDR_SPACE int64_t*
 get_group_value_fast_with_original_key(GENERIC_ADDR_SPACE int64_t* groups_buffer,
                                        const int64_t key,
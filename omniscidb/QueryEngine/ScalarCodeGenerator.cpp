@@ -204,7 +204,8 @@ std::vector<void*> ScalarCodeGenerator::generateNativeGPUCode(
           wrapper_func,
           {func, wrapper_func},
           co,
-          gpu_target);
+          gpu_target,
+          Executor::l0_binary_cache.get());
       gpu_compilation_context_ = l0_context;
       return l0_context->getNativeFunctionPointers();
     }
@@ -0,0 +1,72 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/SharedScans.h"
+
+#include "Logger/Logger.h"
+
+#include <chrono>
+
+SharedScan::~SharedScan() {
+  scans_->leave(table_);
+}
+
+void SharedScan::advance(size_t fragment_id) {
+  scans_->advance(table_, fragment_id);
+}
+
+SharedScans& SharedScans::get() {
+  static SharedScans scans;
+  return scans;
+}
+
+SharedScanPtr SharedScans::join(int db_id, int table_id, size_t window_ms) {
+  const SharedScan::TableKey table{db_id, table_id};
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto& state = states_[table];
+  if (!state.active_scans && window_ms) {
+    if (state.collecting_batch) {
+      const auto generation = state.batch_generation;
+      cv_.wait(lock, [&]() { return state.batch_generation != generation; });
+    } else {
+      state.collecting_batch = true;
+      cv_.wait_for(lock, std::chrono::milliseconds(window_ms), []() { return false; });
+      state.collecting_batch = false;
+      ++state.batch_generation;
+      cv_.notify_all();
+    }
+  }
+  ++state.active_scans;
+  VLOG(1) << "Query joined the scan of table " << table_id << " at fragment "
+          << state.position << ", " << state.active_scans << " active scan(s).";
+  return SharedScanPtr(new SharedScan(this, table, state.position));
+}
+
+size_t SharedScans::getActiveScans(int db_id, int table_id) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = states_.find({db_id, table_id});
+  return it == states_.end() ? 0 : it->second.active_scans;
+}
+
+void SharedScans::advance(const SharedScan::TableKey& table, size_t fragment_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  states_.at(table).position = fragment_id;
+}
+
+void SharedScans::leave(const SharedScan::TableKey& table) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& state = states_.at(table);
+  CHECK_GT(state.active_scans, size_t(0));
+  --state.active_scans;
+}
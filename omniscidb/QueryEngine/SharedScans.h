@@ -0,0 +1,94 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    SharedScans.h
+ * @brief   Coordination of concurrent scans of the same table by several queries.
+ **/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+class SharedScans;
+
+// Scan of a table by a single query. Kernels report the fragment they start
+// processing, so queries joining later start from the same fragment.
+class SharedScan {
+ public:
+  SharedScan(const SharedScan&) = delete;
+  SharedScan& operator=(const SharedScan&) = delete;
+  ~SharedScan();
+
+  // Fragment of the table the query should start processing from.
+  size_t startFragment() const { return start_fragment_; }
+
+  void advance(size_t fragment_id);
+
+ private:
+  using TableKey = std::pair<int, int>;
+
+  SharedScan(SharedScans* scans, TableKey table, size_t start_fragment)
+      : scans_(scans), table_(table), start_fragment_(start_fragment) {}
+
+  SharedScans* scans_;
+  TableKey table_;
+  size_t start_fragment_;
+
+  friend class SharedScans;
+};
+
+using SharedScanPtr = std::unique_ptr<SharedScan>;
+
+/**
+ * Process-wide coordination of concurrent scans of the same table. Queries over a
+ * table which is being scanned by other queries start from the fragment currently
+ * processed by those queries and wrap around, so all of them walk the table in the
+ * same order and process each fragment at about the same time. Chunks are then
+ * fetched and moved through the caches and to the devices once for all queries of
+ * the group. When no scan of the table is running, the first query can wait for a
+ * short window to collect other queries into a batch which starts together.
+ */
+class SharedScans {
+ public:
+  static SharedScans& get();
+
+  // Blocks for up to window_ms when a new batch is collected.
+  SharedScanPtr join(int db_id, int table_id, size_t window_ms);
+
+  size_t getActiveScans(int db_id, int table_id) const;
+
+ private:
+  struct TableState {
+    size_t active_scans = 0;
+    // Last fragment started by any query of the table.
+    size_t position = 0;
+    bool collecting_batch = false;
+    uint64_t batch_generation = 0;
+  };
+
+  void advance(const SharedScan::TableKey& table, size_t fragment_id);
+  void leave(const SharedScan::TableKey& table);
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  std::map<SharedScan::TableKey, TableState> states_;
+
+  friend class SharedScan;
+};
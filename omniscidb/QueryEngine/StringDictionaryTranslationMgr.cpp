@@ -61,6 +61,24 @@ StringDictionaryTranslationMgr::StringDictionaryTranslationMgr(
 #endif  // HAVE_CUDA
 }
 
+StringDictionaryTranslationMgr::StringDictionaryTranslationMgr(
+    StringDictionaryProxy::IdMap&& translation_map,
+    const Data_Namespace::MemoryLevel memory_level,
+    const int device_count,
+    Executor* executor,
+    Data_Namespace::DataMgr* data_mgr)
+    : StringDictionaryTranslationMgr(StringDictionary::INVALID_STR_ID,
+                                     StringDictionary::INVALID_STR_ID,
+                                     false,
+                                     memory_level,
+                                     device_count,
+                                     executor,
+                                     data_mgr) {
+  owned_translation_map_ =
+      std::make_unique<StringDictionaryProxy::IdMap>(std::move(translation_map));
+  host_translation_map_ = owned_translation_map_.get();
+}
+
 StringDictionaryTranslationMgr::~StringDictionaryTranslationMgr() {
   CHECK(data_mgr_);
   for (auto& device_buffer : device_buffers_) {
@@ -69,6 +87,9 @@ StringDictionaryTranslationMgr::~StringDictionaryTranslationMgr() {
 }
 
 void StringDictionaryTranslationMgr::buildTranslationMap() {
+  if (owned_translation_map_) {
+    return;
+  }
   host_translation_map_ = executor_->getStringProxyTranslationMap(
       source_string_dict_id_,
       dest_string_dict_id_,
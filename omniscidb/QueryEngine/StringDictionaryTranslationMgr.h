@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 #include "../DataMgr/MemoryLevel.h"
 #include "Compiler/CodegenTraitsDescriptor.h"
@@ -59,6 +60,14 @@ class StringDictionaryTranslationMgr {
                                  Executor* executor,
                                  Data_Namespace::DataMgr* data_mgr);
 
+  // Translation through a map built by the caller, e.g. the result of a string
+  // function applied to each entry of a dictionary. The map is owned by the manager.
+  StringDictionaryTranslationMgr(StringDictionaryProxy::IdMap&& translation_map,
+                                 const Data_Namespace::MemoryLevel memory_level,
+                                 const int device_count,
+                                 Executor* executor,
+                                 Data_Namespace::DataMgr* data_mgr);
+
   ~StringDictionaryTranslationMgr();
   void buildTranslationMap();
   void createKernelBuffers();
@@ -78,6 +87,7 @@ class StringDictionaryTranslationMgr {
   const int device_count_;
   Executor* executor_;
   Data_Namespace::DataMgr* data_mgr_;
+  std::unique_ptr<const StringDictionaryProxy::IdMap> owned_translation_map_;
   const StringDictionaryProxy::IdMap* host_translation_map_{nullptr};
   std::vector<const int32_t*> kernel_translation_maps_;
   std::vector<Data_Namespace::AbstractBuffer*> device_buffers_;
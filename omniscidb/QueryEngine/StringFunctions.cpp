@@ -15,21 +15,39 @@
  */
 
 #include <cstdint>
+#include <cstring>
 #include "../Shared/funcannotations.h"
 
 #ifdef EXECUTE_INCLUDE
 
+// Number of UTF-8 continuation bytes (10xxxxxx) in eight bytes of a string. Shifting
+// the word left moves bit 6 of each byte to bit 7 of the same byte.
+DEVICE ALWAYS_INLINE int32_t utf8_continuation_bytes(const uint64_t word) {
+  const uint64_t continuation_bits = word & ~(word << 1) & 0x8080808080808080ULL;
+#ifdef __CUDACC__
+  return __popcll(continuation_bits);
+#else
+  return __builtin_popcountll(continuation_bits);
+#endif
+}
+
 extern "C" RUNTIME_EXPORT NEVER_INLINE DEVICE int32_t
 char_length_encoded(const char* str, const int32_t str_len) {  // assumes utf8
-  int32_t i = 0, char_count = 0;
-  while (i < str_len) {
+  // Every byte but a continuation byte starts a character. Words are checked without
+  // a branch per byte, so ASCII and multi-byte text take the same path.
+  int32_t i = 0, continuation_count = 0;
+  for (; i + 8 <= str_len; i += 8) {
+    uint64_t word;
+    memcpy(&word, str + i, sizeof(word));
+    continuation_count += utf8_continuation_bytes(word);
+  }
+  for (; i < str_len; ++i) {
     const unsigned char ch_masked = str[i] & 0xc0;
-    if (ch_masked != 0x80) {
-      char_count++;
+    if (ch_masked == 0x80) {
+      continuation_count++;
     }
-    i++;
   }
-  return char_count;
+  return str_len - continuation_count;
 }
 
 extern "C" RUNTIME_EXPORT NEVER_INLINE DEVICE int32_t
@@ -63,12 +63,17 @@ extern "C" RUNTIME_EXPORT int32_t lower_encoded(int32_t string_id,
   return string_dict_proxy->getOrAddTransient(boost::locale::to_lower(str));
 }
 
+extern "C" int32_t char_length_encoded(const char* str, const int32_t str_len);
+
 llvm::Value* CodeGenerator::codegen(const hdk::ir::CharLengthExpr* expr,
                                     const CompilationOptions& co) {
   AUTOMATIC_IR_METADATA(cgen_state_);
   auto str_lv = codegen(expr->arg(), true, co);
   if (str_lv.size() != 3) {
     CHECK_EQ(size_t(1), str_lv.size());
+    if (expr->arg()->type()->isExtDictionary()) {
+      return codegenDictCharLength(expr, str_lv.front(), co);
+    }
     if (config_.exec.watchdog.enable) {
       throw WatchdogException(
           "LENGTH / CHAR_LENGTH on dictionary-encoded strings would be slow");
@@ -95,6 +100,39 @@ llvm::Value* CodeGenerator::codegen(const hdk::ir::CharLengthExpr* expr,
              : cgen_state_->emitCall(fn_name, charlength_args);
 }
 
+llvm::Value* CodeGenerator::codegenDictCharLength(const hdk::ir::CharLengthExpr* expr,
+                                                  llvm::Value* str_id_lv,
+                                                  const CompilationOptions& co) {
+  AUTOMATIC_IR_METADATA(cgen_state_);
+  const auto sdp = executor()->getStringDictionaryProxy(
+      expr->arg()->type()->as<hdk::ir::ExtDictionaryType>()->dictId(),
+      executor()->getRowSetMemoryOwner(),
+      true);
+  CHECK(sdp);
+
+  // Compute the length of each dictionary entry once and gather it by id instead of
+  // decoding strings per row. Null ids are handled by the translation null check,
+  // dictionary and int32 nulls share the same sentinel.
+  const bool encoded = expr->calcEncodedLength();
+  auto length_map = sdp->buildStringToIntMap([encoded](const std::string& str) {
+    return encoded ? char_length_encoded(str.data(), str.size())
+                   : static_cast<int32_t>(str.size());
+  });
+  auto string_dictionary_translation_mgr =
+      std::make_unique<StringDictionaryTranslationMgr>(
+          std::move(length_map),
+          co.device_type == ExecutorDeviceType::GPU ? Data_Namespace::GPU_LEVEL
+                                                    : Data_Namespace::CPU_LEVEL,
+          executor()->deviceCount(co.device_type),
+          executor(),
+          executor()->getDataMgr());
+  string_dictionary_translation_mgr->createKernelBuffers();
+
+  return cgen_state_
+      ->moveStringDictionaryTranslationMgr(std::move(string_dictionary_translation_mgr))
+      ->codegenCast(str_id_lv, expr->arg()->type(), true, co.codegen_traits_desc);
+}
+
 llvm::Value* CodeGenerator::codegen(const hdk::ir::KeyForStringExpr* expr,
                                     const CompilationOptions& co) {
   AUTOMATIC_IR_METADATA(cgen_state_);
@@ -106,10 +144,6 @@ llvm::Value* CodeGenerator::codegen(const hdk::ir::KeyForStringExpr* expr,
 llvm::Value* CodeGenerator::codegen(const hdk::ir::LowerExpr* expr,
                                     const CompilationOptions& co) {
   AUTOMATIC_IR_METADATA(cgen_state_);
-  if (co.device_type == ExecutorDeviceType::GPU) {
-    throw QueryMustRunOnCpu();
-  }
-
   auto str_id_lv = codegen(expr->arg(), true, co);
   CHECK_EQ(size_t(1), str_id_lv.size());
 
@@ -120,12 +154,36 @@ llvm::Value* CodeGenerator::codegen(const hdk::ir::LowerExpr* expr,
       true);
   CHECK(string_dictionary_proxy);
 
-  std::vector<llvm::Value*> args{
-      str_id_lv[0],
-      cgen_state_->llInt(reinterpret_cast<int64_t>(string_dictionary_proxy))};
+  // Lowering all entries of a big dictionary would cost more than lowering strings of
+  // the processed rows, so CPU kernels lower such strings per row.
+  if (co.device_type == ExecutorDeviceType::CPU &&
+      string_dictionary_proxy->entryCount() >
+          config_.exec.codegen.lower_translation_max_dict_size) {
+    std::vector<llvm::Value*> args{
+        str_id_lv[0],
+        cgen_state_->llInt(reinterpret_cast<int64_t>(string_dictionary_proxy))};
+    return cgen_state_->emitExternalCall(
+        "lower_encoded", get_int_type(32, cgen_state_->context_), args);
+  }
+
+  // Lower each dictionary entry once on the host and translate ids through the
+  // resulting map, which works for both CPU and GPU kernels. The map has to be built
+  // after the argument codegen to cover transients the argument might add.
+  auto translation_map = string_dictionary_proxy->buildStringOpTranslationMap(
+      [](const std::string& str) { return boost::locale::to_lower(str); });
+  auto string_dictionary_translation_mgr =
+      std::make_unique<StringDictionaryTranslationMgr>(
+          std::move(translation_map),
+          co.device_type == ExecutorDeviceType::GPU ? Data_Namespace::GPU_LEVEL
+                                                    : Data_Namespace::CPU_LEVEL,
+          executor()->deviceCount(co.device_type),
+          executor(),
+          executor()->getDataMgr());
+  string_dictionary_translation_mgr->createKernelBuffers();
 
-  return cgen_state_->emitExternalCall(
-      "lower_encoded", get_int_type(32, cgen_state_->context_), args);
+  return cgen_state_
+      ->moveStringDictionaryTranslationMgr(std::move(string_dictionary_translation_mgr))
+      ->codegenCast(str_id_lv[0], expr->arg()->type(), true, co.codegen_traits_desc);
 }
 
 llvm::Value* CodeGenerator::codegen(const hdk::ir::LikeExpr* expr,
@@ -373,6 +431,10 @@ llvm::Value* CodeGenerator::codegen(const hdk::ir::RegexpExpr* expr,
   if (co.device_type == ExecutorDeviceType::GPU) {
     throw QueryMustRunOnCpu();
   }
+  if (config_.exec.codegen.enable_precompiled_regexp) {
+    return codegenRegexpMatch(
+        expr->arg(), {*pattern->value().stringval}, expr->type(), co);
+  }
   auto str_lv = codegen(expr->arg(), true, co);
   if (str_lv.size() != 3) {
     CHECK_EQ(size_t(1), str_lv.size());
@@ -396,6 +458,85 @@ llvm::Value* CodeGenerator::codegen(const hdk::ir::RegexpExpr* expr,
       fn_name, get_int_type(1, cgen_state_->context_), regexp_args);
 }
 
+namespace {
+
+// Collects REGEXP operands of a tree of ORs, fails if there are other operands.
+bool collect_or_regexps(const hdk::ir::Expr* expr,
+                        std::vector<const hdk::ir::RegexpExpr*>& regexps) {
+  if (auto regexp = expr->as<hdk::ir::RegexpExpr>()) {
+    regexps.push_back(regexp);
+    return true;
+  }
+  auto bin_oper = expr->as<hdk::ir::BinOper>();
+  return bin_oper && bin_oper->opType() == hdk::ir::OpType::kOr &&
+         collect_or_regexps(bin_oper->leftOperand(), regexps) &&
+         collect_or_regexps(bin_oper->rightOperand(), regexps);
+}
+
+}  // namespace
+
+llvm::Value* CodeGenerator::codegenRegexpDisjunction(const hdk::ir::BinOper* bin_oper,
+                                                     const CompilationOptions& co) {
+  AUTOMATIC_IR_METADATA(cgen_state_);
+  if (!config_.exec.codegen.enable_precompiled_regexp ||
+      co.device_type == ExecutorDeviceType::GPU) {
+    return nullptr;
+  }
+  std::vector<const hdk::ir::RegexpExpr*> regexps;
+  if (!collect_or_regexps(bin_oper, regexps)) {
+    return nullptr;
+  }
+  CHECK_GE(regexps.size(), size_t(2));
+  // Dictionary-encoded strings are cast to none-encoded ones and are matched per
+  // dictionary entry instead.
+  const auto arg = regexps.front()->arg();
+  const auto cast_oper = arg->as<hdk::ir::UOper>();
+  if (!arg->type()->isString() || (cast_oper && cast_oper->isCast()) ||
+      is_unnest(extract_cast_arg(arg)) ||
+      arg->type()->nullable() != bin_oper->type()->nullable()) {
+    return nullptr;
+  }
+  std::vector<std::string> patterns;
+  for (const auto regexp : regexps) {
+    const auto pattern = dynamic_cast<const hdk::ir::Constant*>(regexp->patternExpr());
+    if (!pattern || !(*regexp->arg() == *arg)) {
+      return nullptr;
+    }
+    patterns.push_back(*pattern->value().stringval);
+  }
+  return codegenRegexpMatch(arg, patterns, bin_oper->type(), co);
+}
+
+llvm::Value* CodeGenerator::codegenRegexpMatch(const hdk::ir::Expr* arg,
+                                               const std::vector<std::string>& patterns,
+                                               const hdk::ir::Type* type,
+                                               const CompilationOptions& co) {
+  AUTOMATIC_IR_METADATA(cgen_state_);
+  auto str_lv = codegen(arg, true, co);
+  if (str_lv.size() != 3) {
+    CHECK_EQ(size_t(1), str_lv.size());
+    str_lv.push_back(cgen_state_->emitCall("extract_str_ptr", {str_lv.front()}));
+    str_lv.push_back(cgen_state_->emitCall("extract_str_len", {str_lv.front()}));
+  }
+  // The matcher lives as long as the query results. Its address is a literal, so
+  // cached code with hoisted literals is reused with matchers of later queries.
+  const auto matcher =
+      executor()->getRowSetMemoryOwner()->getOrAddRegexpMatcher(patterns);
+  const auto matcher_handle_literal = std::dynamic_pointer_cast<const hdk::ir::Constant>(
+      Analyzer::analyzeIntValue(reinterpret_cast<int64_t>(matcher)));
+  CHECK(matcher_handle_literal);
+  const auto matcher_handle_lv = cgen_state_->castToTypeIn(
+      codegen(matcher_handle_literal.get(), false, 0, co).front(), 64);
+  std::vector<llvm::Value*> regexp_args{str_lv[1], str_lv[2], matcher_handle_lv};
+  if (arg->type()->nullable()) {
+    regexp_args.push_back(cgen_state_->inlineIntNull(type));
+    return cgen_state_->emitExternalCall(
+        "regexp_matches_nullable", get_int_type(8, cgen_state_->context_), regexp_args);
+  }
+  return cgen_state_->emitExternalCall(
+      "regexp_matches", get_int_type(1, cgen_state_->context_), regexp_args);
+}
+
 llvm::Value* CodeGenerator::codegenDictRegexp(const hdk::ir::ExprPtr pattern_arg,
                                               const hdk::ir::Constant* pattern,
                                               const char escape_char,
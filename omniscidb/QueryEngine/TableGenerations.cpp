@@ -33,6 +33,21 @@ const std::unordered_map<uint32_t, TableGeneration>& TableGenerations::asMap() c
   return id_to_generation_;
 }
 
+bool TableGenerations::operator==(const TableGenerations& other) const {
+  if (id_to_generation_.size() != other.id_to_generation_.size()) {
+    return false;
+  }
+  for (auto& [table_id, generation] : id_to_generation_) {
+    auto it = other.id_to_generation_.find(table_id);
+    if (it == other.id_to_generation_.end() ||
+        it->second.tuple_count != generation.tuple_count ||
+        it->second.start_rowid != generation.start_rowid) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void TableGenerations::clear() {
   decltype(id_to_generation_)().swap(id_to_generation_);
 }
@@ -33,6 +33,10 @@ class TableGenerations {
 
   const std::unordered_map<uint32_t, TableGeneration>& asMap() const;
 
+  // Generations are equal when they have the same tables with the same tuple counts
+  // and start row ids.
+  bool operator==(const TableGenerations& other) const;
+
   void clear();
 
  private:
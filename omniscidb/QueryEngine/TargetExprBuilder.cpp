@@ -109,6 +109,8 @@ void TargetExprCodegen::codegen(
   const auto agg_fn_names = agg_fn_base_names(target_info);
   const auto window_func = dynamic_cast<const hdk::ir::WindowFunction*>(target_expr);
   WindowProjectNodeContext::resetWindowFunctionContext(executor);
+  CodeGenerator(executor, co.codegen_traits_desc)
+      .codegenExpressionCounter("target", target_expr, co);
   auto target_lvs =
       window_func
           ? std::vector<llvm::Value*>{executor->codegenWindowFunction(target_idx, co)}
@@ -187,6 +189,27 @@ void TargetExprCodegen::codegen(
       }
     }
 
+    if (!is_group_by && gpu_smem_context.isSharedMemoryUsed()) {
+      // All threads of a block count into the same shared memory slot, so active
+      // threads of a warp are counted first and added with a single atomic.
+      const bool is_bigint_count = chosen_bytes != sizeof(int32_t) &&
+                                   executor->getConfig().exec.group_by.bigint_count;
+      const auto acc_col = LL_BUILDER.CreateBitCast(
+          agg_out_vec[slot_index],
+          llvm::PointerType::get(
+              get_int_type(is_bigint_count ? 64 : 32, LL_CONTEXT),
+              agg_out_vec[slot_index]->getType()->getPointerAddressSpace()));
+      if (is_bigint_count) {
+        row_func_builder->emitCall(
+            "agg_count_warp_shared",
+            std::vector<llvm::Value*>{acc_col, LL_INT(int64_t(1))});
+      } else {
+        row_func_builder->emitCall("agg_count_int32_warp_shared",
+                                   std::vector<llvm::Value*>{acc_col, LL_INT(1)});
+      }
+      return;
+    }
+
     if (chosen_bytes != sizeof(int32_t)) {
       CHECK_EQ(8, chosen_bytes);
       llvm::Value* acc_col = is_group_by ? agg_col_ptr : agg_out_vec[slot_index];
@@ -16,6 +16,7 @@
 
 #include "QueryEngine/WindowContext.h"
 
+#include <algorithm>
 #include <numeric>
 
 #include "QueryEngine/Execute.h"
@@ -30,6 +31,13 @@
 #include "Shared/funcannotations.h"
 #include "Shared/threading.h"
 
+#ifdef HAVE_CUDA
+#include "DataMgr/Allocators/ThrustAllocator.h"
+#include "QueryEngine/WindowSortImpl.h"
+#endif
+
+#include <cstring>
+
 #ifdef HAVE_TBB
 //#include <tbb/parallel_for.h>
 #include <tbb/parallel_sort.h>
@@ -95,6 +103,38 @@ WindowFunctionContext::~WindowFunctionContext() {
   }
 }
 
+void WindowFunctionContext::keepSortedPartitions() {
+  CHECK(!output_);
+  if (!sorted_partitions_) {
+    sorted_partitions_ = std::make_shared<std::vector<int64_t>>(elem_count_);
+  }
+}
+
+void WindowFunctionContext::reuseSortedPartitions(const WindowFunctionContext& other) {
+  CHECK(!output_);
+  CHECK(other.output_);
+  CHECK(other.sorted_partitions_);
+  CHECK(partitions_ == other.partitions_);
+  CHECK_EQ(elem_count_, other.elem_count_);
+  sorted_partitions_ = other.sorted_partitions_;
+  reuse_sorted_partitions_ = true;
+}
+
+void WindowFunctionContext::enableGpuPartitionSort(BufferProvider* buffer_provider,
+                                                   const int device_id) {
+  CHECK(!output_);
+  gpu_sort_buffer_provider_ = buffer_provider;
+  gpu_sort_device_id_ = device_id;
+}
+
+void WindowFunctionContext::setPartitionLimit(const size_t limit) {
+  CHECK(!output_);
+  CHECK(window_func_->kind() == hdk::ir::WindowFunctionKind::RowNumber ||
+        window_func_->kind() == hdk::ir::WindowFunctionKind::Rank);
+  CHECK_GT(limit, size_t(0));
+  partition_limit_ = limit;
+}
+
 void WindowFunctionContext::addOrderColumn(
     const int8_t* column,
     const hdk::ir::ColumnVar* col_var,
@@ -105,12 +145,29 @@ void WindowFunctionContext::addOrderColumn(
 
 namespace {
 
+// Calls func on subranges covering [0, size), concurrently when parallel is set. Used
+// to split the work on a single large partition.
+template <typename Func>
+void for_each_range(const size_t size, const bool parallel, const Func& func) {
+  if (parallel) {
+    threading::parallel_for(
+        threading::blocked_range<size_t>(0, size),
+        [&func](const threading::blocked_range<size_t>& r) { func(r.begin(), r.end()); });
+  } else {
+    func(0, size);
+  }
+}
+
 // Converts the sorted indices to a mapping from row position to row number.
-std::vector<int64_t> index_to_row_number(const int64_t* index, const size_t index_size) {
+std::vector<int64_t> index_to_row_number(const int64_t* index,
+                                         const size_t index_size,
+                                         const bool parallel) {
   std::vector<int64_t> row_numbers(index_size);
-  for (size_t i = 0; i < index_size; ++i) {
-    row_numbers[index[i]] = i + 1;
-  }
+  for_each_range(index_size, parallel, [&](const size_t start, const size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      row_numbers[index[i]] = i + 1;
+    }
+  });
   return row_numbers;
 }
 
@@ -199,15 +256,18 @@ std::vector<double> index_to_cume_dist(
 // Computes the mapping from row position to the n-tile statistic.
 std::vector<int64_t> index_to_ntile(const int64_t* index,
                                     const size_t index_size,
-                                    const size_t n) {
+                                    const size_t n,
+                                    const bool parallel) {
   std::vector<int64_t> row_numbers(index_size);
   if (!n) {
     throw std::runtime_error("NTILE argument cannot be zero");
   }
   const size_t tile_size = (index_size + n - 1) / n;
-  for (size_t i = 0; i < index_size; ++i) {
-    row_numbers[index[i]] = i / tile_size + 1;
-  }
+  for_each_range(index_size, parallel, [&](const size_t start, const size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      row_numbers[index[i]] = i / tile_size + 1;
+    }
+  });
   return row_numbers;
 }
 
@@ -257,15 +317,19 @@ int64_t get_lag_or_lead_argument(const hdk::ir::WindowFunction* window_func) {
 // output_for_partition_buff, reusing it as an output buffer.
 void apply_permutation_to_partition(int64_t* output_for_partition_buff,
                                     const int32_t* original_indices,
-
-                                    const size_t partition_size) {
+                                    const size_t partition_size,
+                                    const bool parallel) {
   std::vector<int64_t> new_output_for_partition_buff(partition_size);
-  for (size_t i = 0; i < partition_size; ++i) {
-    new_output_for_partition_buff[i] = original_indices[output_for_partition_buff[i]];
-  }
-  std::copy(new_output_for_partition_buff.begin(),
-            new_output_for_partition_buff.end(),
-            output_for_partition_buff);
+  for_each_range(partition_size, parallel, [&](const size_t start, const size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      new_output_for_partition_buff[i] = original_indices[output_for_partition_buff[i]];
+    }
+  });
+  for_each_range(partition_size, parallel, [&](const size_t start, const size_t end) {
+    std::copy(new_output_for_partition_buff.begin() + start,
+              new_output_for_partition_buff.begin() + end,
+              output_for_partition_buff + start);
+  });
 }
 
 // Applies a lag to the given sorted_indices, reusing it as an output buffer.
@@ -310,20 +374,32 @@ void apply_last_value_to_partition(const int32_t* original_indices,
       original_indices, original_indices + partition_size, output_for_partition_buff);
 }
 
+// Marks the last row of every peer group in the partition end bitmap. When run in
+// parallel, the rows are split on byte boundaries of the bitmap so that no two tasks
+// update the same byte.
 void index_to_partition_end(
     const int8_t* partition_end,
     const size_t off,
     const int64_t* index,
     const size_t index_size,
-    const std::function<bool(const int64_t lhs, const int64_t rhs)>& comparator) {
+    const std::function<bool(const int64_t lhs, const int64_t rhs)>& comparator,
+    const bool parallel) {
+  CHECK(index_size);
   int64_t partition_end_handle = reinterpret_cast<int64_t>(partition_end);
-  for (size_t i = 0; i < index_size; ++i) {
-    if (advance_current_rank(comparator, index, i)) {
-      agg_count_distinct_bitmap(&partition_end_handle, off + i - 1, 0);
+  const auto mark_peer_group_ends = [&](const size_t start, const size_t end) {
+    auto handle = partition_end_handle;
+    for (size_t i = start; i < end; ++i) {
+      if (i + 1 == index_size || advance_current_rank(comparator, index, i + 1)) {
+        agg_count_distinct_bitmap(&handle, off + i, 0);
+      }
     }
-  }
-  CHECK(index_size);
-  agg_count_distinct_bitmap(&partition_end_handle, off + index_size - 1, 0);
+  };
+  const size_t head = std::min(index_size, (8 - off % 8) % 8);
+  mark_peer_group_ends(0, head);
+  const size_t byte_count = (index_size - head + 7) / 8;
+  for_each_range(byte_count, parallel, [&](const size_t start, const size_t end) {
+    mark_peer_group_ends(head + start * 8, std::min(index_size, head + end * 8));
+  });
 }
 
 bool pos_is_set(const int64_t bitset, const int64_t pos) {
@@ -453,8 +529,6 @@ void WindowFunctionContext::computePartition(const size_t partition_idx,
     return;
   }
   const auto offset = offsets()[partition_idx];
-  std::iota(
-      output_for_partition_buff, output_for_partition_buff + partition_size, int64_t(0));
   std::vector<Comparator> comparators;
   const auto& order_keys = window_func_->orderKeys();
   const auto& collation = window_func_->collation();
@@ -496,6 +570,24 @@ void WindowFunctionContext::computePartition(const size_t partition_idx,
     return false;
   };
 
+  if (reuse_sorted_partitions_) {
+    std::copy(sorted_partitions_->begin() + offset,
+              sorted_partitions_->begin() + offset + partition_size,
+              output_for_partition_buff);
+    computePartitionBuffer(output_for_partition_buff,
+                           partition_size,
+                           offset,
+                           window_func_,
+                           col_tuple_comparator);
+    return;
+  }
+
+  std::iota(
+      output_for_partition_buff, output_for_partition_buff + partition_size, int64_t(0));
+  if (partition_limit_ && partition_limit_ < partition_size && !sorted_partitions_) {
+    computePartitionTop(output_for_partition_buff, partition_size, col_tuple_comparator);
+    return;
+  }
   if (config_.exec.window_func.parallel_window_partition_sort &&
       partition_size >=
           config_.exec.window_func.parallel_window_partition_sort_threshold) {
@@ -513,6 +605,11 @@ void WindowFunctionContext::computePartition(const size_t partition_idx,
               output_for_partition_buff + partition_size,
               col_tuple_comparator);
   }
+  if (sorted_partitions_) {
+    std::copy(output_for_partition_buff,
+              output_for_partition_buff + partition_size,
+              sorted_partitions_->begin() + offset);
+  }
   computePartitionBuffer(output_for_partition_buff,
                          partition_size,
                          offset,
@@ -520,6 +617,186 @@ void WindowFunctionContext::computePartition(const size_t partition_idx,
                          col_tuple_comparator);
 }
 
+void WindowFunctionContext::computePartitionTop(
+    int64_t* output_for_partition_buff,
+    const size_t partition_size,
+    const std::function<bool(const int64_t lhs, const int64_t rhs)>& comparator) {
+  const auto begin = output_for_partition_buff;
+  const auto end = output_for_partition_buff + partition_size;
+  auto top_end = begin + partition_limit_;
+  // Partial sort selects the top rows with a bounded heap, the rest stays unordered.
+  std::partial_sort(begin, top_end, end, comparator);
+  const bool is_rank = window_func_->kind() == hdk::ir::WindowFunctionKind::Rank;
+  if (is_rank) {
+    // Peers of the last top row share its rank.
+    const auto last = *(top_end - 1);
+    top_end = std::partition(top_end, end, [&comparator, last](const int64_t idx) {
+      return !comparator(last, idx);
+    });
+  }
+  std::vector<int64_t> rank(partition_size, partition_limit_ + 1);
+  size_t crt_rank = 1;
+  for (size_t i = 0; i < static_cast<size_t>(top_end - begin); ++i) {
+    if (!is_rank || advance_current_rank(comparator, begin, i)) {
+      crt_rank = i + 1;
+    }
+    rank[begin[i]] = crt_rank;
+  }
+  std::copy(rank.begin(), rank.end(), output_for_partition_buff);
+}
+
+namespace {
+
+// Order preserving mappings of values to unsigned keys.
+template <typename T>
+uint64_t int_sort_key(const T val) {
+  return static_cast<uint64_t>(static_cast<int64_t>(val)) ^ (uint64_t(1) << 63);
+}
+
+uint64_t fp_sort_key(const double val) {
+  uint64_t bits;
+  std::memcpy(&bits, &val, sizeof(bits));
+  return (bits >> 63) ? ~bits : bits | (uint64_t(1) << 63);
+}
+
+// Fills the order keys and null flags of the rows in payload order.
+template <typename T, typename NullPatternType, typename ToKey>
+void fill_window_sort_keys(const int8_t* order_column_buffer,
+                           const int32_t* payload,
+                           const size_t elem_count,
+                           const NullPatternType null_pattern,
+                           const bool desc,
+                           const ToKey& to_key,
+                           uint64_t* order_keys,
+                           int8_t* nulls) {
+  const auto values = reinterpret_cast<const T*>(order_column_buffer);
+  threading::parallel_for(
+      threading::blocked_range<size_t>(0, elem_count),
+      [&](const threading::blocked_range<size_t>& r) {
+        for (size_t i = r.begin(); i != r.end(); ++i) {
+          const auto val = values[payload[i]];
+          NullPatternType pattern;
+          std::memcpy(&pattern, &val, sizeof(pattern));
+          nulls[i] = pattern == null_pattern;
+          const auto key = to_key(val);
+          order_keys[i] = desc ? ~key : key;
+        }
+      });
+}
+
+}  // namespace
+
+bool WindowFunctionContext::sortPartitionsOnGpu() {
+#ifdef HAVE_CUDA
+  if (!gpu_sort_buffer_provider_ || reuse_sorted_partitions_ ||
+      (partition_limit_ && !sorted_partitions_) || order_columns_.size() != 1 ||
+      elem_count_ < config_.exec.window_func.gpu_partition_sort_threshold) {
+    return false;
+  }
+  const auto order_col =
+      dynamic_cast<const hdk::ir::ColumnVar*>(window_func_->orderKeys().front().get());
+  CHECK(order_col);
+  const auto type = order_col->type();
+  const auto& collation = window_func_->collation().front();
+  const auto order_column_buffer = order_columns_.front();
+  std::vector<uint64_t> order_keys(elem_count_);
+  std::vector<int8_t> nulls(elem_count_);
+  if (type->isInteger() || type->isDecimal() || type->isDateTime() || type->isBoolean()) {
+    const auto null_val = inline_fixed_encoding_null_value(type);
+    auto fill = [&](auto typed_null_val) {
+      using T = decltype(typed_null_val);
+      fill_window_sort_keys<T>(order_column_buffer,
+                               payload(),
+                               elem_count_,
+                               typed_null_val,
+                               collation.is_desc,
+                               int_sort_key<T>,
+                               order_keys.data(),
+                               nulls.data());
+    };
+    switch (type->size()) {
+      case 8:
+        fill(static_cast<int64_t>(null_val));
+        break;
+      case 4:
+        fill(static_cast<int32_t>(null_val));
+        break;
+      case 2:
+        fill(static_cast<int16_t>(null_val));
+        break;
+      case 1:
+        fill(static_cast<int8_t>(null_val));
+        break;
+      default:
+        return false;
+    }
+  } else if (type->isFp32()) {
+    fill_window_sort_keys<float>(order_column_buffer,
+                                 payload(),
+                                 elem_count_,
+                                 static_cast<int32_t>(null_val_bit_pattern(type, true)),
+                                 collation.is_desc,
+                                 fp_sort_key,
+                                 order_keys.data(),
+                                 nulls.data());
+  } else if (type->isFp64()) {
+    fill_window_sort_keys<double>(order_column_buffer,
+                                  payload(),
+                                  elem_count_,
+                                  null_val_bit_pattern(type, false),
+                                  collation.is_desc,
+                                  fp_sort_key,
+                                  order_keys.data(),
+                                  nulls.data());
+  } else {
+    return false;
+  }
+
+  // Partition keys also place nulls. A descending sort reverses the ascending order,
+  // nulls included, the same way the CPU comparator does it.
+  const bool nulls_first = collation.nulls_first != collation.is_desc;
+  std::vector<uint64_t> partition_keys(elem_count_);
+  const size_t partition_count = partitionCount();
+  for (size_t partition_idx = 0; partition_idx < partition_count; ++partition_idx) {
+    const size_t offset = offsets()[partition_idx];
+    const size_t count = counts()[partition_idx];
+    for (size_t i = offset; i < offset + count; ++i) {
+      const uint64_t null_rank = (nulls[i] != 0) == nulls_first ? 0 : 1;
+      partition_keys[i] = (static_cast<uint64_t>(partition_idx) << 1) | null_rank;
+    }
+  }
+
+  auto sorted = sorted_partitions_
+                    ? sorted_partitions_
+                    : std::make_shared<std::vector<int64_t>>(elem_count_);
+  try {
+    auto timer = DEBUG_TIMER("Window Function GPU Partition Sort");
+    ThrustAllocator alloc(gpu_sort_buffer_provider_, gpu_sort_device_id_);
+    sort_window_partitions_on_gpu(partition_keys.data(),
+                                  order_keys.data(),
+                                  elem_count_,
+                                  sorted->data(),
+                                  alloc);
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Window function partitions are sorted on CPU: " << e.what();
+    return false;
+  }
+  // Positions are partition-local in sorted partitions.
+  for (size_t partition_idx = 0; partition_idx < partition_count; ++partition_idx) {
+    const size_t offset = offsets()[partition_idx];
+    const size_t count = counts()[partition_idx];
+    for (size_t i = offset; i < offset + count; ++i) {
+      (*sorted)[i] -= offset;
+    }
+  }
+  sorted_partitions_ = std::move(sorted);
+  reuse_sorted_partitions_ = true;
+  return true;
+#else
+  return false;
+#endif
+}
+
 void WindowFunctionContext::compute() {
   auto timer = DEBUG_TIMER(__func__);
   CHECK(!output_);
@@ -545,6 +822,9 @@ void WindowFunctionContext::compute() {
   }
 
   const size_t partition_count{partitionCount()};
+  if (sortPartitionsOnGpu()) {
+    VLOG(1) << "Sorted " << partition_count << " window function partitions on GPU.";
+  }
 
   const auto compute_partitions = [&](const size_t start, const size_t end) {
     for (size_t partition_idx = start; partition_idx != end; ++partition_idx) {
@@ -559,9 +839,26 @@ void WindowFunctionContext::compute() {
           config_.exec.window_func.parallel_window_partition_compute_threshold};
   if (should_parallelize) {
     auto timer = DEBUG_TIMER("Window Function Partition Compute");
+    // Split partitions into tasks of about the same element count rather than the same
+    // partition count, so that a few large partitions don't end up in a single task.
+    // Partitions larger than the target size get a task of their own and are
+    // additionally split inside computePartition.
+    const size_t target_task_size =
+        std::max<size_t>(elem_count_ / cpu_threads(), size_t(1));
     threading::task_group thread_pool;
-    for (auto interval : makeIntervals<size_t>(0, partition_count, cpu_threads())) {
-      thread_pool.run([=] { compute_partitions(interval.begin, interval.end); });
+    size_t task_start = 0;
+    size_t task_size = 0;
+    for (size_t partition_idx = 0; partition_idx < partition_count; ++partition_idx) {
+      const size_t partition_size = counts()[partition_idx];
+      if (task_size && task_size + partition_size > target_task_size) {
+        thread_pool.run([=] { compute_partitions(task_start, partition_idx); });
+        task_start = partition_idx;
+        task_size = 0;
+      }
+      task_size += partition_size;
+    }
+    if (task_start < partition_count) {
+      thread_pool.run([=] { compute_partitions(task_start, partition_count); });
     }
     thread_pool.wait();
   } else {
@@ -632,6 +929,10 @@ size_t WindowFunctionContext::elementCount() const {
   return elem_count_;
 }
 
+const std::shared_ptr<HashJoin>& WindowFunctionContext::partitions() const {
+  return partitions_;
+}
+
 namespace {
 
 template <class T>
@@ -775,10 +1076,16 @@ void WindowFunctionContext::computePartitionBuffer(
     const size_t off,
     const hdk::ir::WindowFunction* window_func,
     const std::function<bool(const int64_t lhs, const int64_t rhs)>& comparator) {
+  // Large partitions are split between threads as well, otherwise a single skewed
+  // partition serializes the whole computation.
+  const bool parallel{
+      config_.exec.window_func.parallel_window_partition_compute &&
+      partition_size >=
+          config_.exec.window_func.parallel_window_partition_compute_threshold};
   switch (window_func->kind()) {
     case hdk::ir::WindowFunctionKind::RowNumber: {
       const auto row_numbers =
-          index_to_row_number(output_for_partition_buff, partition_size);
+          index_to_row_number(output_for_partition_buff, partition_size, parallel);
       std::copy(row_numbers.begin(), row_numbers.end(), output_for_partition_buff);
       break;
     }
@@ -814,7 +1121,8 @@ void WindowFunctionContext::computePartitionBuffer(
       const auto& args = window_func->args();
       CHECK_EQ(args.size(), size_t(1));
       const auto n = get_int_constant_from_expr(args.front().get());
-      const auto ntile = index_to_ntile(output_for_partition_buff, partition_size, n);
+      const auto ntile =
+          index_to_ntile(output_for_partition_buff, partition_size, n, parallel);
       std::copy(ntile.begin(), ntile.end(), output_for_partition_buff);
       break;
     }
@@ -845,11 +1153,15 @@ void WindowFunctionContext::computePartitionBuffer(
     case hdk::ir::WindowFunctionKind::Count: {
       const auto partition_row_offsets = payload() + off;
       if (window_function_requires_peer_handling(window_func)) {
-        index_to_partition_end(
-            partitionEnd(), off, output_for_partition_buff, partition_size, comparator);
+        index_to_partition_end(partitionEnd(),
+                               off,
+                               output_for_partition_buff,
+                               partition_size,
+                               comparator,
+                               parallel);
       }
       apply_permutation_to_partition(
-          output_for_partition_buff, partition_row_offsets, partition_size);
+          output_for_partition_buff, partition_row_offsets, partition_size, parallel);
       break;
     }
     default: {
@@ -56,6 +56,7 @@ inline bool window_function_is_aggregate(const hdk::ir::WindowFunctionKind kind)
   }
 }
 
+class BufferProvider;
 class Executor;
 
 // Per-window function context which encapsulates the logic for computing the various
@@ -92,6 +93,24 @@ class WindowFunctionContext {
                       const hdk::ir::ColumnVar* col_var,
                       const std::vector<std::shared_ptr<Chunk_NS::Chunk>>& chunks_owner);
 
+  // Makes compute() keep the sorted partitions, so that they can be reused by contexts
+  // of other window functions with the same partition and order keys.
+  void keepSortedPartitions();
+
+  // Makes compute() take the sorted partitions kept by the given, already computed
+  // context instead of sorting them again. Both window functions must have the same
+  // partition and order keys and the context must share partitions with this one.
+  void reuseSortedPartitions(const WindowFunctionContext& other);
+
+  // Lets compute() sort the partitions of large inputs on the given GPU. Only a single
+  // numeric order key is sorted there, other keys are still sorted on CPU.
+  void enableGpuPartitionSort(BufferProvider* buffer_provider, const int device_id);
+
+  // Lets compute() give exact values of ROW_NUMBER or RANK only to rows within the given
+  // limit in each partition, other rows get limit + 1. Only the top rows of partitions
+  // are ordered then. Ignored when the sorted partitions are kept or reused.
+  void setPartitionLimit(const size_t limit);
+
   // Computes the window function result to be used during the actual projection query.
   void compute();
 
@@ -119,6 +138,10 @@ class WindowFunctionContext {
   // Returns the element count in the columns used by the window function.
   size_t elementCount() const;
 
+  // Returns the hash table which contains the partitions, nullptr if the window function
+  // isn't partitioned.
+  const std::shared_ptr<HashJoin>& partitions() const;
+
   enum class WindowComparatorResult { LT, EQ, GT };
 
   using Comparator =
@@ -141,6 +164,16 @@ class WindowFunctionContext {
 
   void computePartition(const size_t partition_idx, int64_t* output_for_partition_buff);
 
+  // Computes ROW_NUMBER or RANK of a partition larger than the partition limit.
+  void computePartitionTop(
+      int64_t* output_for_partition_buff,
+      const size_t partition_size,
+      const std::function<bool(const int64_t lhs, const int64_t rhs)>& comparator);
+
+  // Sorts all partitions at once on GPU into sorted_partitions_. Returns false if the
+  // sort is left to computePartition.
+  bool sortPartitionsOnGpu();
+
   void computePartitionBuffer(
       int64_t* output_for_partition_buff,
       const size_t partition_size,
@@ -180,6 +213,15 @@ class WindowFunctionContext {
   int8_t* partition_end_;
   // State for aggregate function over a window.
   AggregateState aggregate_state_;
+  // Partition-local row indices of every partition sorted by the order keys, at the
+  // partition offsets. Only set when kept for or reused from another context.
+  std::shared_ptr<std::vector<int64_t>> sorted_partitions_;
+  bool reuse_sorted_partitions_{false};
+  // GPU used to sort partitions, if enabled.
+  BufferProvider* gpu_sort_buffer_provider_{nullptr};
+  int gpu_sort_device_id_{0};
+  // Max ROW_NUMBER or RANK which has to be exact, zero if there is no limit.
+  size_t partition_limit_{0};
   const ExecutorDeviceType device_type_;
   std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner_;
 
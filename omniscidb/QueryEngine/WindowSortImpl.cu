@@ -0,0 +1,59 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <thrust/copy.h>
+#include <thrust/device_ptr.h>
+#include <thrust/execution_policy.h>
+#include <thrust/gather.h>
+#include <thrust/sequence.h>
+#include <thrust/sort.h>
+
+#include "DataMgr/Allocators/ThrustAllocator.h"
+#include "WindowSortImpl.h"
+
+void sort_window_partitions_on_gpu(const uint64_t* partition_keys,
+                                   const uint64_t* order_keys,
+                                   const size_t elem_count,
+                                   int64_t* sorted_pos,
+                                   ThrustAllocator& alloc) {
+  if (!elem_count) {
+    return;
+  }
+  const size_t key_bytes = elem_count * sizeof(uint64_t);
+  thrust::device_ptr<uint64_t> dev_order_keys(
+      reinterpret_cast<uint64_t*>(alloc.allocateScopedBuffer(key_bytes)));
+  thrust::device_ptr<uint64_t> dev_partition_keys(
+      reinterpret_cast<uint64_t*>(alloc.allocateScopedBuffer(key_bytes)));
+  thrust::device_ptr<uint64_t> dev_sorted_partition_keys(
+      reinterpret_cast<uint64_t*>(alloc.allocateScopedBuffer(key_bytes)));
+  thrust::device_ptr<int64_t> dev_pos(reinterpret_cast<int64_t*>(
+      alloc.allocateScopedBuffer(elem_count * sizeof(int64_t))));
+  thrust::copy(order_keys, order_keys + elem_count, dev_order_keys);
+  thrust::copy(partition_keys, partition_keys + elem_count, dev_partition_keys);
+  thrust::sequence(thrust::device(alloc), dev_pos, dev_pos + elem_count);
+  // Segmented sort as two stable radix sorts: by the order key first, then by the
+  // partition key, which keeps the order key order within each partition.
+  thrust::stable_sort_by_key(
+      thrust::device(alloc), dev_order_keys, dev_order_keys + elem_count, dev_pos);
+  thrust::gather(thrust::device(alloc),
+                 dev_pos,
+                 dev_pos + elem_count,
+                 dev_partition_keys,
+                 dev_sorted_partition_keys);
+  thrust::stable_sort_by_key(thrust::device(alloc),
+                             dev_sorted_partition_keys,
+                             dev_sorted_partition_keys + elem_count,
+                             dev_pos);
+  thrust::copy(dev_pos, dev_pos + elem_count, sorted_pos);
+}
@@ -0,0 +1,34 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    WindowSortImpl.h
+ * @brief   Sort of window function partitions on the GPU.
+ **/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+class ThrustAllocator;
+
+// Sorts positions [0, elem_count) by the partition key and, within a partition, by the
+// order key, keeping the original order of equal keys. Both keys are compared as
+// unsigned integers. The sorted positions are written to the host sorted_pos buffer.
+void sort_window_partitions_on_gpu(const uint64_t* partition_keys,
+                                   const uint64_t* order_keys,
+                                   const size_t elem_count,
+                                   int64_t* sorted_pos,
+                                   ThrustAllocator& alloc);
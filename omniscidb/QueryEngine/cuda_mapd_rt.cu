@@ -24,6 +24,10 @@ extern "C" __device__ int64_t get_block_index() {
   return blockIdx.x;
 }
 
+extern "C" __device__ int64_t get_block_dim() {
+  return blockDim.x;
+}
+
 extern "C" __device__ int32_t pos_start_impl(const int32_t* row_index_resume) {
   return blockIdx.x * blockDim.x + threadIdx.x;
 }
@@ -435,6 +439,24 @@ extern "C" __device__ uint32_t agg_count_int32_shared(uint32_t* agg, const int32
   return atomicAdd(agg, 1UL);
 }
 
+// Counts of all active threads of a warp are added by its first active thread, which
+// replaces up to 32 atomics on the same address with one.
+extern "C" __device__ void agg_count_warp_shared(uint64_t* agg, const int64_t val) {
+  const unsigned active_mask = __activemask();
+  if ((threadIdx.x & 31) == __ffs(active_mask) - 1) {
+    atomicAdd(reinterpret_cast<unsigned long long*>(agg),
+              static_cast<unsigned long long>(__popc(active_mask)));
+  }
+}
+
+extern "C" __device__ void agg_count_int32_warp_shared(uint32_t* agg,
+                                                       const int32_t val) {
+  const unsigned active_mask = __activemask();
+  if ((threadIdx.x & 31) == __ffs(active_mask) - 1) {
+    atomicAdd(agg, static_cast<uint32_t>(__popc(active_mask)));
+  }
+}
+
 extern "C" __device__ uint64_t agg_count_double_shared(uint64_t* agg, const double val) {
   return agg_count_shared(agg, val);
 }
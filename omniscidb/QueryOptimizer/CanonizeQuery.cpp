@@ -306,8 +306,26 @@ void expandCompoundAggregates(std::shared_ptr<Aggregate> node,
   new_nodes.push_back(reduce_proj);
 }
 
+bool hasCompoundAggregates(const Node* node) {
+  auto agg_node = node->as<Aggregate>();
+  return agg_node &&
+         std::any_of(agg_node->getAggs().begin(),
+                     agg_node->getAggs().end(),
+                     [](const ExprPtr& expr) {
+                       CHECK(expr->is<AggExpr>());
+                       return isCompoundAggregate(expr->as<AggExpr>());
+                     });
+}
+
 void expandCompoundAggregates(QueryDag& dag) {
   auto& nodes = dag.getNodes();
+  // Most queries have nothing to expand, skip rebuilding the node list for them.
+  if (std::none_of(nodes.begin(), nodes.end(), [](const NodePtr& node) {
+        return hasCompoundAggregates(node.get());
+      })) {
+    return;
+  }
+
   std::vector<NodePtr> new_nodes;
   InputRewriter rewriter;
   std::unordered_map<const Node*, NodePtr> expanded_aggs;
@@ -320,24 +338,11 @@ void expandCompoundAggregates(QueryDag& dag) {
       }
     }
 
-    if (node->is<Aggregate>()) {
-      std::unordered_set<const AggExpr*> aggs;
+    if (hasCompoundAggregates(node.get())) {
       auto agg_node = std::dynamic_pointer_cast<Aggregate>(node);
-      bool has_compound_agg =
-          std::any_of(agg_node->getAggs().begin(),
-                      agg_node->getAggs().end(),
-                      [](const ExprPtr& expr) {
-                        CHECK(expr->is<AggExpr>());
-                        return isCompoundAggregate(expr->as<AggExpr>());
-                      });
-
-      if (has_compound_agg) {
-        expandCompoundAggregates(agg_node, dag.config(), new_nodes);
-        rewriter.addNodeMapping(agg_node.get(), new_nodes.back().get());
-        expanded_aggs.insert(std::make_pair(agg_node.get(), new_nodes.back()));
-      } else {
-        new_nodes.push_back(node);
-      }
+      expandCompoundAggregates(agg_node, dag.config(), new_nodes);
+      rewriter.addNodeMapping(agg_node.get(), new_nodes.back().get());
+      expanded_aggs.insert(std::make_pair(agg_node.get(), new_nodes.back()));
     } else {
       new_nodes.push_back(node);
     }
@@ -27,6 +27,7 @@
 
 #include "CountDistinctDescriptor.h"
 #include "HyperLogLog.h"
+#include "RoaringBitmap.h"
 
 #include "ThirdParty/robin_hood.h"
 
@@ -91,6 +92,12 @@ inline int64_t count_distinct_set_size(
     }
     return bitmap_set_size(set_vals, count_distinct_desc.bitmapSizeBytes());
   }
+  if (count_distinct_desc.impl_type_ == CountDistinctImplType::RoaringBitmap) {
+    return reinterpret_cast<RoaringBitmap*>(set_handle)->size();
+  }
+  if (count_distinct_desc.impl_type_ == CountDistinctImplType::SparseHyperLogLog) {
+    return reinterpret_cast<SparseHyperLogLog*>(set_handle)->size();
+  }
   CHECK(count_distinct_desc.impl_type_ == CountDistinctImplType::HashSet);
   return reinterpret_cast<robin_hood::unordered_set<int64_t>*>(set_handle)->size();
 }
@@ -139,6 +146,17 @@ inline void count_distinct_set_union(
                                       : old_count_distinct_desc.bitmapPaddedSizeBytes();
       bitmap_set_union(new_set, old_set, bitmap_byte_sz);
     }
+  } else if (new_count_distinct_desc.impl_type_ == CountDistinctImplType::RoaringBitmap) {
+    CHECK(old_count_distinct_desc.impl_type_ == CountDistinctImplType::RoaringBitmap);
+    auto old_set = reinterpret_cast<RoaringBitmap*>(old_set_handle);
+    auto new_set = reinterpret_cast<RoaringBitmap*>(new_set_handle);
+    new_set->unionWith(*old_set);
+  } else if (new_count_distinct_desc.impl_type_ ==
+             CountDistinctImplType::SparseHyperLogLog) {
+    CHECK(old_count_distinct_desc.impl_type_ == CountDistinctImplType::SparseHyperLogLog);
+    auto old_set = reinterpret_cast<SparseHyperLogLog*>(old_set_handle);
+    auto new_set = reinterpret_cast<SparseHyperLogLog*>(new_set_handle);
+    new_set->unionWith(*old_set);
   } else {
     CHECK(old_count_distinct_desc.impl_type_ == CountDistinctImplType::HashSet);
     auto old_set = reinterpret_cast<robin_hood::unordered_set<int64_t>*>(old_set_handle);
@@ -27,7 +27,10 @@
 
 #include "CountDistinctDescriptor.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <vector>
 
 inline double get_alpha(const size_t m) {
   switch (m) {
@@ -112,6 +115,26 @@ inline void hll_unify(T1* lhs, T2* rhs, const size_t m) {
   }
 }
 
+// Ranks never exceed 64, so registers of the same type are merged with a plain
+// element-wise max which the compiler vectorizes.
+template <class T>
+inline void hll_max_merge(T* __restrict__ lhs,
+                          const T* __restrict__ rhs,
+                          const size_t m) {
+  for (size_t r = 0; r < m; ++r) {
+    lhs[r] = std::max(lhs[r], rhs[r]);
+  }
+}
+
+template <class T>
+inline void hll_unify(T* lhs, T* rhs, const size_t m) {
+  if (lhs == rhs) {
+    return;
+  }
+  hll_max_merge(lhs, rhs, m);
+  std::copy(lhs, lhs + m, rhs);
+}
+
 inline int hll_size_for_rate(const int err_percent) {
   double err_rate{static_cast<double>(err_percent) / 100.0};
   double k = ceil(2 * log2(1.04 / err_rate));
@@ -120,4 +143,104 @@ inline int hll_size_for_rate(const int err_percent) {
   return std::min(16, std::max(static_cast<int>(k), 4));
 }
 
+// HyperLogLog registers which keep only non-zero registers in a sorted list until the
+// list takes as much memory as the dense registers. Used by APPROX_COUNT_DISTINCT in
+// group by queries where most groups see a few distinct values only. The precision is
+// taken from the first update, so an untouched sketch has no registers at all.
+class SparseHyperLogLog {
+ public:
+  void update(const uint32_t bitmap_sz_bits, const uint32_t index, const uint8_t rank) {
+    bitmap_sz_bits_ = bitmap_sz_bits;
+    if (!dense_.empty()) {
+      dense_[index] = std::max(dense_[index], rank);
+      return;
+    }
+    // Entries are (index << 8 | rank), so sorting them sorts by register index.
+    const uint32_t entry = (index << 8) | rank;
+    auto it = std::lower_bound(sparse_.begin(), sparse_.end(), index << 8);
+    if (it != sparse_.end() && (*it >> 8) == index) {
+      *it = std::max(*it, entry);
+      return;
+    }
+    sparse_.insert(it, entry);
+    if (sparse_.size() > maxSparseEntries()) {
+      convertToDense();
+    }
+  }
+
+  size_t size() const {
+    if (!bitmap_sz_bits_) {
+      return 0;
+    }
+    if (!dense_.empty()) {
+      return hll_size(dense_.data(), bitmap_sz_bits_);
+    }
+    // At most a quarter of the registers is set, so hll_size would use linear
+    // counting for the dense form of these registers.
+    const size_t m = registerCount();
+    return m * log(static_cast<double>(m) / (m - sparse_.size()));
+  }
+
+  void unionWith(const SparseHyperLogLog& other) {
+    if (!other.bitmap_sz_bits_) {
+      return;
+    }
+    bitmap_sz_bits_ = other.bitmap_sz_bits_;
+    if (!other.dense_.empty()) {
+      if (dense_.empty()) {
+        convertToDense();
+      }
+      hll_max_merge(dense_.data(), other.dense_.data(), registerCount());
+      return;
+    }
+    if (!dense_.empty()) {
+      setRegisters(other.sparse_);
+      return;
+    }
+    std::vector<uint32_t> merged;
+    merged.reserve(sparse_.size() + other.sparse_.size());
+    auto lhs = sparse_.begin();
+    auto rhs = other.sparse_.begin();
+    while (lhs != sparse_.end() && rhs != other.sparse_.end()) {
+      if ((*lhs >> 8) == (*rhs >> 8)) {
+        merged.push_back(std::max(*lhs++, *rhs++));
+      } else if (*lhs < *rhs) {
+        merged.push_back(*lhs++);
+      } else {
+        merged.push_back(*rhs++);
+      }
+    }
+    merged.insert(merged.end(), lhs, sparse_.end());
+    merged.insert(merged.end(), rhs, other.sparse_.end());
+    sparse_ = std::move(merged);
+    if (sparse_.size() > maxSparseEntries()) {
+      convertToDense();
+    }
+  }
+
+ private:
+  size_t registerCount() const { return size_t(1) << bitmap_sz_bits_; }
+
+  // A sparse entry takes four bytes while a dense register takes one.
+  size_t maxSparseEntries() const { return registerCount() / 4; }
+
+  void convertToDense() {
+    dense_.assign(registerCount(), 0);
+    setRegisters(sparse_);
+    sparse_.clear();
+    sparse_.shrink_to_fit();
+  }
+
+  void setRegisters(const std::vector<uint32_t>& entries) {
+    for (auto entry : entries) {
+      auto& reg = dense_[entry >> 8];
+      reg = std::max(reg, static_cast<uint8_t>(entry & 0xFF));
+    }
+  }
+
+  uint32_t bitmap_sz_bits_{0};
+  std::vector<uint32_t> sparse_;
+  std::vector<uint8_t> dense_;
+};
+
 #endif  // QUERYENGINE_HYPERLOGLOG_H
@@ -62,6 +62,7 @@ QueryMemoryDescriptor::QueryMemoryDescriptor(
     , must_use_baseline_sort_(must_use_baseline_sort)
     , is_table_function_(false)
     , use_streaming_top_n_(use_streaming_top_n)
+    , approx_quantile_(approx_quantile)
     , col_slot_context_(col_slot_context) {
   col_slot_context_.setAllUnsetSlotsPaddedSize(8);
   col_slot_context_.validate();
@@ -548,6 +549,18 @@ bool QueryMemoryDescriptor::lazyInitGroups(const ExecutorDeviceType device_type)
 #endif
 }
 
+bool QueryMemoryDescriptor::firstTouchInitGroups(
+    const ExecutorDeviceType device_type) const {
+  // Generated code initializes a row by a copy of the initial row, so targets with
+  // per-row buffers like COUNT DISTINCT and APPROX_QUANTILE are excluded.
+  return device_type == ExecutorDeviceType::CPU && config_ &&
+         config_->rs.enable_lazy_group_init && usesGetGroupValueFast() &&
+         !interleavedBins(device_type) && !output_columnar_ && !must_use_baseline_sort_ &&
+         !use_streaming_top_n_ && !approx_quantile_ && !hasVarlenOutput() &&
+         countDescriptorsLogicallyEmpty(count_distinct_descriptors_) &&
+         entry_count_ >= config_->rs.lazy_group_init_threshold;
+}
+
 bool QueryMemoryDescriptor::interleavedBins(const ExecutorDeviceType device_type) const {
   return interleaved_bins_on_gpu_ && device_type == ExecutorDeviceType::GPU;
 }
@@ -651,6 +664,8 @@ std::string QueryMemoryDescriptor::toString() const {
   str +=
       "\tLazy Init Groups (GPU): " + ::toString(lazyInitGroups(ExecutorDeviceType::GPU)) +
       "\n";
+  str += "\tFirst Touch Init Groups (CPU): " +
+         ::toString(firstTouchInitGroups(ExecutorDeviceType::CPU)) + "\n";
   str += "\tEntry Count: " + std::to_string(entry_count_) + "\n";
   str += "\tMin Val (perfect hash only): " + std::to_string(min_val_) + "\n";
   str += "\tMax Val (perfect hash only): " + std::to_string(max_val_) + "\n";
@@ -256,6 +256,18 @@ class QueryMemoryDescriptor {
 
   bool lazyInitGroups(const ExecutorDeviceType) const;
 
+  // Rows of sparse perfect hash buffers are initialized by the kernel on the first
+  // touch. Such buffers keep a row of initial values and an occupancy bitmap of
+  // entries after the last entry.
+  bool firstTouchInitGroups(const ExecutorDeviceType) const;
+  size_t getFirstTouchInitRowOffset() const { return entry_count_ * getRowSize(); }
+  size_t getOccupancyBitmapOffset() const {
+    return getFirstTouchInitRowOffset() + getRowSize();
+  }
+  size_t getOccupancyBitmapSize() const {
+    return (entry_count_ + 63) / 64 * sizeof(uint64_t);
+  }
+
   bool interleavedBins(const ExecutorDeviceType) const;
 
   size_t getColOffInBytes(const size_t col_idx) const;
@@ -338,6 +350,7 @@ class QueryMemoryDescriptor {
   bool must_use_baseline_sort_;
   bool is_table_function_;
   bool use_streaming_top_n_;
+  bool approx_quantile_{false};
 
   ColSlotContext col_slot_context_;
 
@@ -40,6 +40,7 @@
 #include <algorithm>
 #include <atomic>
 #include <bitset>
+#include <cmath>
 #include <future>
 #include <numeric>
 
@@ -388,6 +389,168 @@ const ResultSetStorage* ResultSet::allocateStorage(
   return storage_.get();
 }
 
+namespace {
+
+constexpr uint64_t serialized_storage_magic{0x48444b5253543031};  // "HDKRST01"
+
+struct SerializedStorageHeader {
+  uint64_t magic;
+  uint64_t entry_count;
+  uint64_t buffer_size;
+  uint64_t init_vals_count;
+};
+
+}  // namespace
+
+bool ResultSet::canSerializeStorage() const {
+  if (!storage_ || !appended_storage_.empty() || areAnyColumnsLazyFetched()) {
+    return false;
+  }
+  for (const auto& target : targets_) {
+    if (is_distinct_target(target) ||
+        target.agg_kind == hdk::ir::AggType::kApproxQuantile ||
+        target.type->isVarLen() || target.type->isExtDictionary()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::string ResultSet::serializeStorage() const {
+  CHECK(canSerializeStorage());
+  storage_->finalizeFirstTouchInit();
+  const auto& init_vals = storage_->getInitVals();
+  SerializedStorageHeader header{serialized_storage_magic,
+                                 query_mem_desc_.getEntryCount(),
+                                 query_mem_desc_.getBufferSizeBytes(device_type_),
+                                 init_vals.size()};
+  const size_t init_vals_size = init_vals.size() * sizeof(int64_t);
+  std::string serialized(sizeof(header) + init_vals_size + header.buffer_size, '\0');
+  auto out = serialized.data();
+  memcpy(out, &header, sizeof(header));
+  out += sizeof(header);
+  memcpy(out, init_vals.data(), init_vals_size);
+  out += init_vals_size;
+  memcpy(out, storage_->getUnderlyingBuffer(), header.buffer_size);
+  return serialized;
+}
+
+std::shared_ptr<ResultSet> ResultSet::deserializeStorage(
+    const std::string& serialized) const {
+  SerializedStorageHeader header;
+  if (serialized.size() < sizeof(header)) {
+    throw std::runtime_error("Truncated serialized result set storage.");
+  }
+  memcpy(&header, serialized.data(), sizeof(header));
+  const size_t init_vals_size = header.init_vals_count * sizeof(int64_t);
+  if (header.magic != serialized_storage_magic ||
+      header.entry_count != query_mem_desc_.getEntryCount() ||
+      header.buffer_size != query_mem_desc_.getBufferSizeBytes(device_type_) ||
+      serialized.size() != sizeof(header) + init_vals_size + header.buffer_size) {
+    throw std::runtime_error(
+        "Serialized result set storage doesn't match the query memory descriptor.");
+  }
+  auto in = serialized.data() + sizeof(header);
+  std::vector<int64_t> init_vals(header.init_vals_count);
+  memcpy(init_vals.data(), in, init_vals_size);
+  in += init_vals_size;
+
+  CHECK(row_set_mem_owner_);
+  auto rs = std::make_shared<ResultSet>(targets_,
+                                        device_type_,
+                                        query_mem_desc_,
+                                        row_set_mem_owner_,
+                                        data_mgr_,
+                                        block_size_,
+                                        grid_size_);
+  auto buff = row_set_mem_owner_->allocate(header.buffer_size, /*thread_idx=*/0);
+  memcpy(buff, in, header.buffer_size);
+  rs->allocateStorage(buff, init_vals);
+  return rs;
+}
+
+namespace {
+
+template <typename T>
+void write_int_to_buff(int8_t* ptr, const int64_t val) {
+  *reinterpret_cast<T*>(ptr) = static_cast<T>(val);
+}
+
+void scale_storage_aggregates(const ResultSetStorage& storage,
+                              const std::vector<TargetInfo>& targets,
+                              const double scale) {
+  const auto& query_mem_desc = storage.getQueryMemDesc();
+  const auto buff = storage.getUnderlyingBuffer();
+  for (size_t target_idx = 0; target_idx < targets.size(); ++target_idx) {
+    const auto& target = targets[target_idx];
+    if (!target.is_agg || target.is_distinct ||
+        (target.agg_kind != hdk::ir::AggType::kSum &&
+         target.agg_kind != hdk::ir::AggType::kCount)) {
+      continue;
+    }
+    const auto slot_idx = query_mem_desc.getSlotIndexForSingleSlotCol(target_idx);
+    const auto slot_width = query_mem_desc.getPaddedSlotWidthBytes(slot_idx);
+    const auto col_off = query_mem_desc.getColOffInBytes(slot_idx);
+    const auto int_null_val = inline_int_null_value(target.type);
+    for (size_t entry_idx = 0; entry_idx < storage.getEntryCount(); ++entry_idx) {
+      if (storage.isEmptyEntry(entry_idx)) {
+        continue;
+      }
+      auto slot_ptr = query_mem_desc.didOutputColumnar()
+                          ? buff + col_off + entry_idx * slot_width
+                          : row_ptr_rowwise(buff, query_mem_desc, entry_idx) + col_off;
+      if (target.type->isFloatingPoint()) {
+        if (slot_width == sizeof(float)) {
+          auto val_ptr = reinterpret_cast<float*>(slot_ptr);
+          if (*val_ptr != inline_fp_null_value<float>()) {
+            *val_ptr *= scale;
+          }
+        } else {
+          CHECK_EQ(slot_width, sizeof(double));
+          auto val_ptr = reinterpret_cast<double*>(slot_ptr);
+          if (*val_ptr != inline_fp_null_value<double>()) {
+            *val_ptr *= scale;
+          }
+        }
+        continue;
+      }
+      const auto val = read_int_from_buff(slot_ptr, slot_width);
+      if (target.agg_kind == hdk::ir::AggType::kSum && val == int_null_val) {
+        continue;
+      }
+      const auto scaled_val = std::llround(val * scale);
+      switch (slot_width) {
+        case 8:
+          write_int_to_buff<int64_t>(slot_ptr, scaled_val);
+          break;
+        case 4:
+          write_int_to_buff<int32_t>(slot_ptr, scaled_val);
+          break;
+        case 2:
+          write_int_to_buff<int16_t>(slot_ptr, scaled_val);
+          break;
+        case 1:
+          write_int_to_buff<int8_t>(slot_ptr, scaled_val);
+          break;
+        default:
+          UNREACHABLE() << "Unexpected slot width: " << static_cast<int>(slot_width);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+void ResultSet::scaleAggregates(const double scale) {
+  if (scale == 1.0 || !storage_) {
+    return;
+  }
+  scale_storage_aggregates(*storage_, targets_, scale);
+  for (const auto& storage : appended_storage_) {
+    scale_storage_aggregates(*storage, targets_, scale);
+  }
+}
+
 size_t ResultSet::getCurrentRowBufferIndex() const {
   if (crt_row_buff_idx_ == 0) {
     throw std::runtime_error("current row buffer iteration index is undefined");
@@ -957,12 +1120,51 @@ bool ResultSet::isChunkedZeroCopyColumnarConversionPossible(size_t column_idx) c
          (lazy_fetch_info_.empty() || !lazy_fetch_info_[column_idx].is_lazily_fetched);
 }
 
+// Group-by targets which are stored as a single fixed-width numeric slot and don't need
+// finalization can be decoded without going through getRowAt().
+bool ResultSet::isDirectGroupByColumnCopyPossible(size_t column_idx) const {
+  if (!isDirectColumnarConversionPossible() ||
+      query_mem_desc_.getQueryDescriptionType() == QueryDescriptionType::Projection ||
+      !appended_storage_.empty() || !storage_) {
+    return false;
+  }
+  const auto& target = targets_[column_idx];
+  if (target.is_agg) {
+    if (target.is_distinct) {
+      return false;
+    }
+    switch (target.agg_kind) {
+      case hdk::ir::AggType::kMin:
+      case hdk::ir::AggType::kMax:
+      case hdk::ir::AggType::kSum:
+      case hdk::ir::AggType::kCount:
+      case hdk::ir::AggType::kSample:
+      case hdk::ir::AggType::kSingleValue:
+        break;
+      default:
+        return false;
+    }
+  }
+  return target.type->isInteger() || target.type->isFloatingPoint();
+}
+
 const int8_t* ResultSet::getColumnarBuffer(size_t column_idx) const {
   CHECK(isZeroCopyColumnarConversionPossible(column_idx));
   size_t slot_idx = query_mem_desc_.getSlotIndexForSingleSlotCol(column_idx);
   return storage_->getUnderlyingBuffer() + query_mem_desc_.getColOffInBytes(slot_idx);
 }
 
+const int8_t* ResultSet::getDeviceColumnarBuffer(size_t column_idx) const {
+  // Device buffers are not permuted or truncated along with the host storage.
+  if (device_columnar_buffers_.empty() || !permutation_.empty() || isTruncated() ||
+      !isZeroCopyColumnarConversionPossible(column_idx)) {
+    return nullptr;
+  }
+  size_t slot_idx = query_mem_desc_.getSlotIndexForSingleSlotCol(column_idx);
+  CHECK_LT(slot_idx, device_columnar_buffers_.size());
+  return device_columnar_buffers_[slot_idx];
+}
+
 std::vector<std::pair<const int8_t*, size_t>> ResultSet::getChunkedColumnarBuffer(
     size_t column_idx) const {
   CHECK(isChunkedZeroCopyColumnarConversionPossible(column_idx));
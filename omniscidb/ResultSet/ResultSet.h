@@ -272,6 +272,13 @@ class ResultSet {
       const size_t index,
       const std::vector<bool>& targets_to_skip = {}) const;
 
+  // Same as getRowAtNoTranslations() for a range of indexes. Lazily fetched columns are
+  // resolved for the whole range at once, which avoids a cache miss per value.
+  std::vector<std::vector<TargetValue>> getRowsAtNoTranslations(
+      const size_t start_index,
+      const size_t end_index,
+      const std::vector<bool>& targets_to_skip = {}) const;
+
   bool isRowAtEmpty(const size_t index) const;
 
   void keepFirstN(const size_t n);
@@ -448,6 +455,20 @@ class ResultSet {
 
   void serialize(TSerializedRows& serialized_rows) const;
 
+  // Partial aggregates are exchanged between executors as a copy of the storage
+  // buffer, which is only self-contained for fixed width targets without pointers
+  // to other buffers (count distinct sets, quantile digests, varlen values) and
+  // without dictionary ids local to the producer.
+  bool canSerializeStorage() const;
+  std::string serializeStorage() const;
+  // Restores serialized storage into a new result set with the targets and memory
+  // descriptor of this one. The result can be reduced with ResultSetManager.
+  std::shared_ptr<ResultSet> deserializeStorage(const std::string& serialized) const;
+
+  // Multiplies SUM and COUNT aggregates by the scale, which estimates the result of
+  // an aggregation over a sample of its input for the whole input.
+  void scaleAggregates(const double scale);
+
   size_t getLimit() const;
 
   size_t getOffset() const;
@@ -456,12 +477,23 @@ class ResultSet {
                             int8_t* output_buffer,
                             const size_t output_buffer_size) const;
 
+  // Decodes a group-by target of the given entries into a dense buffer of the target
+  // type. Only valid for targets accepted by isDirectGroupByColumnCopyPossible().
+  void copyGroupByColumnIntoBuffer(const size_t column_idx,
+                                   const std::vector<size_t>& entries,
+                                   int8_t* output_buffer,
+                                   const size_t output_buffer_size) const;
+
+  // Indexes of non-empty entries of the result set, in the iteration order.
+  std::vector<size_t> getNonEmptyEntries() const;
+
   bool didOutputColumnar() const { return this->query_mem_desc_.didOutputColumnar(); }
 
   //  Columnar Conversion checker functions
   bool isDirectColumnarConversionPossible() const;
   bool isZeroCopyColumnarConversionPossible(size_t column_idx) const;
   bool isChunkedZeroCopyColumnarConversionPossible(size_t column_idx) const;
+  bool isDirectGroupByColumnCopyPossible(size_t column_idx) const;
 
   //  Buffer Accessors
   const int8_t* getColumnarBuffer(size_t column_idx) const;
@@ -470,6 +502,15 @@ class ResultSet {
   std::vector<std::pair<const int8_t*, size_t>> getChunkedColumnarBuffer(
       size_t column_idx) const;
 
+  // Device memory on device getDeviceId() holding the column of a GPU projection
+  // executed with rs.keep_gpu_results. Null if the column is not kept on the device.
+  const int8_t* getDeviceColumnarBuffer(size_t column_idx) const;
+
+  // Set device buffers of result slots. Buffers are owned by the row set memory owner.
+  void setDeviceColumnarBuffers(std::vector<const int8_t*> slot_buffers) {
+    device_columnar_buffers_ = std::move(slot_buffers);
+  }
+
   // For columns with varlen data writes element offsets to the output buffer.
   // It is 0 for the first element and cumulative length of all previous elements
   // for others. The total length is written at the end.
@@ -709,6 +750,18 @@ class ResultSet {
                               const bool decimal_to_double,
                               const size_t entry_buff_idx) const;
 
+  TargetValue makeLazyTargetValue(const int64_t ival,
+                                  const TargetInfo& target_info,
+                                  const size_t target_logical_idx,
+                                  const bool translate_strings,
+                                  const bool decimal_to_double) const;
+
+  TargetValue makeIntTargetValue(const int64_t ival,
+                                 const TargetInfo& target_info,
+                                 const size_t target_logical_idx,
+                                 const bool translate_strings,
+                                 const bool decimal_to_double) const;
+
   TargetValue makeVarlenTargetValue(const int8_t* ptr1,
                                     const int8_t compact_sz1,
                                     const int8_t* ptr2,
@@ -740,6 +793,16 @@ class ResultSet {
   /// entryIdx   : local index into the storage object.
   std::pair<size_t, size_t> getStorageIndex(const size_t entry_idx) const;
 
+  bool isBatchedLazyTarget(const size_t target_idx) const;
+
+  void fetchLazyTargetForRows(const size_t target_idx,
+                              const std::vector<size_t>& entries,
+                              std::vector<std::vector<TargetValue>>& rows) const;
+
+  void copyLazyColumnIntoBuffer(const size_t column_idx,
+                                int8_t* output_buffer,
+                                const size_t output_buffer_size) const;
+
   const std::vector<const int8_t*>& getColumnFrag(const size_t storge_idx,
                                                   const size_t col_logical_idx,
                                                   int64_t& global_idx) const;
@@ -771,6 +834,7 @@ class ResultSet {
   QueryMemoryDescriptor query_mem_desc_;
   mutable std::shared_ptr<ResultSetStorage> storage_;
   AppendedStorage appended_storage_;
+  std::vector<const int8_t*> device_columnar_buffers_;
   mutable size_t crt_row_buff_idx_;
   mutable size_t fetched_so_far_;
   size_t drop_first_;
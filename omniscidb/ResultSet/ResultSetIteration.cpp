@@ -30,8 +30,12 @@
 #include "Shared/TypePunning.h"
 #include "Shared/likely.h"
 #include "Shared/sqltypes.h"
+#include "Shared/threading.h"
 
+#include <algorithm>
 #include <memory>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 
 using VarlenDatumPtr = std::unique_ptr<VarlenDatum>;
@@ -254,6 +258,55 @@ std::vector<TargetValue> ResultSet::getRowAtNoTranslations(
   return getRowAt(entry_idx, false, false, false, targets_to_skip);
 }
 
+std::vector<std::vector<TargetValue>> ResultSet::getRowsAtNoTranslations(
+    const size_t start_index,
+    const size_t end_index,
+    const std::vector<bool>& targets_to_skip /* = {}*/) const {
+  std::vector<size_t> batched_targets;
+  if (query_mem_desc_.getQueryDescriptionType() == QueryDescriptionType::Projection) {
+    for (size_t target_idx = 0; target_idx < lazy_fetch_info_.size(); ++target_idx) {
+      if (!targets_to_skip.empty() && targets_to_skip[target_idx]) {
+        continue;
+      }
+      if (isBatchedLazyTarget(target_idx)) {
+        batched_targets.push_back(target_idx);
+      }
+    }
+  }
+
+  std::vector<std::vector<TargetValue>> rows;
+  rows.reserve(end_index > start_index ? end_index - start_index : 0);
+  if (batched_targets.empty()) {
+    for (size_t index = start_index; index < end_index; ++index) {
+      rows.emplace_back(getRowAtNoTranslations(index, targets_to_skip));
+    }
+    return rows;
+  }
+
+  // Batched columns are skipped while rows are built and filled in afterwards.
+  auto row_targets_to_skip = targets_to_skip;
+  row_targets_to_skip.resize(colCount(), false);
+  for (const auto target_idx : batched_targets) {
+    row_targets_to_skip[target_idx] = true;
+  }
+  std::vector<size_t> entries;
+  entries.reserve(rows.capacity());
+  for (size_t index = start_index; index < end_index; ++index) {
+    if (index >= entryCount()) {
+      rows.emplace_back();
+      entries.push_back(0);
+      continue;
+    }
+    const auto entry_idx = permutation_.empty() ? index : permutation_[index];
+    rows.emplace_back(getRowAt(entry_idx, false, false, false, row_targets_to_skip));
+    entries.push_back(entry_idx);
+  }
+  for (const auto target_idx : batched_targets) {
+    fetchLazyTargetForRows(target_idx, entries, rows);
+  }
+  return rows;
+}
+
 bool ResultSet::isRowAtEmpty(const size_t logical_index) const {
   if (logical_index >= entryCount()) {
     return true;
@@ -614,6 +667,86 @@ InternalTargetValue ResultSet::getVarlenOrderEntry(const int64_t str_ptr,
   return InternalTargetValue(row_set_mem_owner_->addString(str));
 }
 
+// Lazily fetched fixed-width columns of projections hold row ids in 8-byte slots and can
+// be resolved for a batch of rows at once.
+bool ResultSet::isBatchedLazyTarget(const size_t target_idx) const {
+  CHECK_LT(target_idx, lazy_fetch_info_.size());
+  if (!lazy_fetch_info_[target_idx].is_lazily_fetched) {
+    return false;
+  }
+  const auto type = targets_[target_idx].type;
+  if (type->isVarLen() || type->isArray() || type->isExtDictionary()) {
+    return false;
+  }
+  const size_t slot_idx = query_mem_desc_.getSlotIndexForSingleSlotCol(target_idx);
+  return query_mem_desc_.getPaddedSlotWidthBytes(slot_idx) == sizeof(int64_t);
+}
+
+/**
+ * Resolves a lazily fetched column for a batch of rows. Reading values in the order of
+ * rows causes a cache miss per value when rows are sorted or filtered. Instead, row ids
+ * are sorted by their fragment and position in it, values are decoded in that order
+ * with the following ones prefetched, and then scattered back to their rows.
+ */
+void ResultSet::fetchLazyTargetForRows(
+    const size_t target_idx,
+    const std::vector<size_t>& entries,
+    std::vector<std::vector<TargetValue>>& rows) const {
+  CHECK_EQ(entries.size(), rows.size());
+  const auto& col_lazy_fetch = lazy_fetch_info_[target_idx];
+  const auto& target_info = targets_[target_idx];
+  const size_t slot_idx = query_mem_desc_.getSlotIndexForSingleSlotCol(target_idx);
+
+  struct LazyRowRef {
+    const int8_t* frag_buffer;
+    int64_t local_row_id;
+    size_t row_pos;
+  };
+  std::vector<LazyRowRef> row_refs;
+  row_refs.reserve(rows.size());
+  for (size_t row_pos = 0; row_pos < rows.size(); ++row_pos) {
+    if (rows[row_pos].empty()) {
+      continue;
+    }
+    const auto storage_lookup_result = findStorage(entries[row_pos]);
+    const auto storage = storage_lookup_result.storage_ptr;
+    const auto local_entry_idx = storage_lookup_result.fixedup_entry_idx;
+    const int8_t* slot_ptr{nullptr};
+    if (query_mem_desc_.didOutputColumnar()) {
+      slot_ptr = storage->getUnderlyingBuffer() + storage->getColOffInBytes(slot_idx) +
+                 local_entry_idx * sizeof(int64_t);
+    } else {
+      slot_ptr = row_ptr_rowwise(storage->buff_, query_mem_desc_, local_entry_idx) +
+                 align_to_int64(get_key_bytes_rowwise(query_mem_desc_)) +
+                 result_set::get_byteoff_of_slot(slot_idx, query_mem_desc_);
+    }
+    int64_t row_id = *reinterpret_cast<const int64_t*>(slot_ptr);
+    CHECK_GE(row_id, 0);
+    const auto& frag_col_buffers =
+        getColumnFrag(storage_lookup_result.storage_idx, target_idx, row_id);
+    CHECK_LT(size_t(col_lazy_fetch.local_col_id), frag_col_buffers.size());
+    row_refs.push_back({frag_col_buffers[col_lazy_fetch.local_col_id], row_id, row_pos});
+  }
+
+  std::sort(row_refs.begin(), row_refs.end(), [](const auto& lhs, const auto& rhs) {
+    return std::tie(lhs.frag_buffer, lhs.local_row_id) <
+           std::tie(rhs.frag_buffer, rhs.local_row_id);
+  });
+  constexpr size_t kPrefetchDistance = 16;
+  const auto elem_size = col_lazy_fetch.type->size();
+  for (size_t i = 0; i < row_refs.size(); ++i) {
+    if (i + kPrefetchDistance < row_refs.size()) {
+      const auto& next = row_refs[i + kPrefetchDistance];
+      __builtin_prefetch(next.frag_buffer + next.local_row_id * elem_size, 0);
+    }
+    const auto& row_ref = row_refs[i];
+    const auto ival = result_set::lazy_decode(
+        col_lazy_fetch, row_ref.frag_buffer, row_ref.local_row_id);
+    rows[row_ref.row_pos][target_idx] =
+        makeLazyTargetValue(ival, target_info, target_idx, false, false);
+  }
+}
+
 int64_t ResultSet::lazyReadInt(const int64_t ival,
                                const size_t target_logical_idx,
                                const StorageLookupResult& storage_lookup_result) const {
@@ -858,6 +991,43 @@ inline std::pair<int64_t, int64_t> get_frag_id_and_local_idx(
   return {-1, -1};
 }
 
+// Gathers selected rows of a plain fixed-width fragment column. The loop has no
+// data-dependent branches, so it can be turned into a vector gather.
+template <typename T>
+void gather_rows(T* __restrict__ out,
+                 const T* __restrict__ src,
+                 const int64_t* __restrict__ row_ids,
+                 const size_t row_count) {
+  for (size_t i = 0; i < row_count; ++i) {
+    out[i] = src[row_ids[i]];
+  }
+}
+
+void write_lazy_value(int8_t* out, const hdk::ir::Type* type, int64_t val) {
+  if (type->isFp32()) {
+    // lazy_decode returns floating point values as doubles.
+    const auto dval = *reinterpret_cast<const double*>(may_alias_ptr(&val));
+    *reinterpret_cast<float*>(out) = static_cast<float>(dval);
+    return;
+  }
+  switch (type->size()) {
+    case 1:
+      *reinterpret_cast<int8_t*>(out) = static_cast<int8_t>(val);
+      break;
+    case 2:
+      *reinterpret_cast<int16_t*>(out) = static_cast<int16_t>(val);
+      break;
+    case 4:
+      *reinterpret_cast<int32_t*>(out) = static_cast<int32_t>(val);
+      break;
+    case 8:
+      *reinterpret_cast<int64_t*>(out) = val;
+      break;
+    default:
+      UNREACHABLE() << "Unexpected column width: " << type->size();
+  }
+}
+
 }  // namespace
 
 const std::vector<const int8_t*>& ResultSet::getColumnFrag(const size_t storage_idx,
@@ -898,6 +1068,10 @@ const VarlenOutputInfo* ResultSet::getVarlenOutputInfo(const size_t entry_idx) c
 void ResultSet::copyColumnIntoBuffer(const size_t column_idx,
                                      int8_t* output_buffer,
                                      const size_t output_buffer_size) const {
+  if (!lazy_fetch_info_.empty() && lazy_fetch_info_[column_idx].is_lazily_fetched) {
+    copyLazyColumnIntoBuffer(column_idx, output_buffer, output_buffer_size);
+    return;
+  }
   const size_t slot_idx = query_mem_desc_.getSlotIndexForSingleSlotCol(column_idx);
   const auto column_width_size = query_mem_desc_.getPaddedSlotWidthBytes(slot_idx);
   auto chunks = getChunkedColumnarBuffer(column_idx);
@@ -910,6 +1084,119 @@ void ResultSet::copyColumnIntoBuffer(const size_t column_idx,
   }
 }
 
+/**
+ * Materializes a lazily fetched fixed-width column of a columnar projection. Output
+ * slots of such a column hold row ids, which are used as a selection vector: row ids
+ * are translated into fragment-local ones and only the selected rows are gathered from
+ * the fragment buffers, one run of rows from the same fragment at a time.
+ */
+void ResultSet::copyLazyColumnIntoBuffer(const size_t column_idx,
+                                         int8_t* output_buffer,
+                                         const size_t output_buffer_size) const {
+  CHECK(query_mem_desc_.didOutputColumnar());
+  CHECK(query_mem_desc_.getQueryDescriptionType() == QueryDescriptionType::Projection);
+  const auto& col_lazy_fetch = lazy_fetch_info_[column_idx];
+  CHECK(col_lazy_fetch.is_lazily_fetched);
+  auto type = colType(column_idx);
+  CHECK(!type->isVarLen() && !type->isArray());
+  const size_t slot_idx = query_mem_desc_.getSlotIndexForSingleSlotCol(column_idx);
+  CHECK_EQ(query_mem_desc_.getPaddedSlotWidthBytes(slot_idx), sizeof(int64_t));
+  const size_t out_width = type->size();
+
+  // Fragment values can be copied as is when the fragment column has the same width
+  // and representation as the output column. Otherwise, each value is decoded.
+  auto frag_type = col_lazy_fetch.type;
+  const bool plain_copy =
+      frag_type->size() == type->size() &&
+      ((type->isInteger() && frag_type->isInteger() &&
+        frag_type->size() == frag_type->canonicalSize()) ||
+       (type->isFloatingPoint() && frag_type->isFloatingPoint()));
+
+  std::vector<int64_t> local_row_ids;
+  auto gather_run = [&](const int8_t* frag_buffer, int8_t* out) {
+    const auto* row_ids = local_row_ids.data();
+    const auto row_count = local_row_ids.size();
+    if (plain_copy) {
+      switch (out_width) {
+        case 1:
+          gather_rows(out, frag_buffer, row_ids, row_count);
+          break;
+        case 2:
+          gather_rows(reinterpret_cast<int16_t*>(out),
+                      reinterpret_cast<const int16_t*>(frag_buffer),
+                      row_ids,
+                      row_count);
+          break;
+        case 4:
+          gather_rows(reinterpret_cast<int32_t*>(out),
+                      reinterpret_cast<const int32_t*>(frag_buffer),
+                      row_ids,
+                      row_count);
+          break;
+        case 8:
+          gather_rows(reinterpret_cast<int64_t*>(out),
+                      reinterpret_cast<const int64_t*>(frag_buffer),
+                      row_ids,
+                      row_count);
+          break;
+        default:
+          UNREACHABLE() << "Unexpected column width: " << out_width;
+      }
+    } else {
+      for (size_t i = 0; i < row_count; ++i) {
+        const auto val = result_set::lazy_decode(col_lazy_fetch, frag_buffer, row_ids[i]);
+        write_lazy_value(out + i * out_width, type, val);
+      }
+    }
+  };
+
+  size_t rows_to_skip = drop_first_;
+  size_t rows_to_fetch = rowCount();
+  size_t out_buff_offset = 0;
+  for (size_t storage_idx = 0; storage_idx <= appended_storage_.size() && rows_to_fetch;
+       ++storage_idx) {
+    const auto storage =
+        storage_idx ? appended_storage_[storage_idx - 1].get() : storage_.get();
+    CHECK(storage);
+    const size_t storage_rows = storage->binSearchRowCount();
+    if (storage_rows <= rows_to_skip) {
+      rows_to_skip -= storage_rows;
+      continue;
+    }
+    const size_t rows = std::min(storage_rows - rows_to_skip, rows_to_fetch);
+    CHECK_LE(out_buff_offset + rows * out_width, output_buffer_size);
+    const auto global_row_ids =
+        reinterpret_cast<const int64_t*>(storage->getUnderlyingBuffer() +
+                                         storage->getColOffInBytes(slot_idx)) +
+        rows_to_skip;
+
+    // Split the selected rows into runs of rows from the same fragment.
+    local_row_ids.clear();
+    local_row_ids.reserve(rows);
+    const int8_t* run_frag_buffer = nullptr;
+    int8_t* run_out = output_buffer + out_buff_offset;
+    for (size_t i = 0; i < rows; ++i) {
+      int64_t row_id = global_row_ids[i];
+      const auto& frag_col_buffers = getColumnFrag(storage_idx, column_idx, row_id);
+      const auto frag_buffer = frag_col_buffers[col_lazy_fetch.local_col_id];
+      if (frag_buffer != run_frag_buffer && !local_row_ids.empty()) {
+        gather_run(run_frag_buffer, run_out);
+        run_out += local_row_ids.size() * out_width;
+        local_row_ids.clear();
+      }
+      run_frag_buffer = frag_buffer;
+      local_row_ids.push_back(row_id);
+    }
+    if (!local_row_ids.empty()) {
+      gather_run(run_frag_buffer, run_out);
+    }
+
+    out_buff_offset += rows * out_width;
+    rows_to_fetch -= rows;
+    rows_to_skip = 0;
+  }
+}
+
 template <typename ENTRY_TYPE, QueryDescriptionType QUERY_TYPE, bool COLUMNAR_FORMAT>
 ENTRY_TYPE ResultSet::getEntryAt(const size_t row_idx,
                                  const size_t target_idx,
@@ -1055,6 +1342,176 @@ ENTRY_TYPE ResultSet::getColumnarBaselineEntryAt(const size_t row_idx,
   return reinterpret_cast<const ENTRY_TYPE*>(column_buffer)[row_idx];
 }
 
+namespace {
+
+template <typename OUTPUT_TYPE,
+          typename ENTRY_TYPE,
+          QueryDescriptionType QUERY_TYPE,
+          bool COLUMNAR_FORMAT>
+void copy_group_by_entries(const ResultSet& rs,
+                           const std::vector<size_t>& entries,
+                           const size_t target_idx,
+                           const size_t slot_idx,
+                           OUTPUT_TYPE* output) {
+  threading::parallel_for(
+      threading::blocked_range<size_t>(0, entries.size()),
+      [&](const threading::blocked_range<size_t>& r) {
+        for (size_t i = r.begin(); i < r.end(); ++i) {
+          output[i] = static_cast<OUTPUT_TYPE>(
+              rs.getEntryAt<ENTRY_TYPE, QUERY_TYPE, COLUMNAR_FORMAT>(
+                  entries[i], target_idx, slot_idx));
+        }
+      });
+}
+
+// Slots are read with their own width and truncated or converted to the output type
+// the same way direct columnarization does it.
+template <typename OUTPUT_TYPE, QueryDescriptionType QUERY_TYPE, bool COLUMNAR_FORMAT>
+void copy_group_by_entries(const ResultSet& rs,
+                           const std::vector<size_t>& entries,
+                           const size_t target_idx,
+                           const size_t slot_idx,
+                           const size_t entry_width,
+                           OUTPUT_TYPE* output) {
+  if constexpr (std::is_floating_point_v<OUTPUT_TYPE>) {
+    switch (entry_width) {
+      case 8:
+        copy_group_by_entries<OUTPUT_TYPE, double, QUERY_TYPE, COLUMNAR_FORMAT>(
+            rs, entries, target_idx, slot_idx, output);
+        break;
+      case 4:
+        copy_group_by_entries<OUTPUT_TYPE, float, QUERY_TYPE, COLUMNAR_FORMAT>(
+            rs, entries, target_idx, slot_idx, output);
+        break;
+      default:
+        UNREACHABLE() << "Unexpected floating point slot width: " << entry_width;
+    }
+  } else {
+    switch (entry_width) {
+      case 8:
+        copy_group_by_entries<OUTPUT_TYPE, int64_t, QUERY_TYPE, COLUMNAR_FORMAT>(
+            rs, entries, target_idx, slot_idx, output);
+        break;
+      case 4:
+        copy_group_by_entries<OUTPUT_TYPE, int32_t, QUERY_TYPE, COLUMNAR_FORMAT>(
+            rs, entries, target_idx, slot_idx, output);
+        break;
+      case 2:
+        copy_group_by_entries<OUTPUT_TYPE, int16_t, QUERY_TYPE, COLUMNAR_FORMAT>(
+            rs, entries, target_idx, slot_idx, output);
+        break;
+      case 1:
+        copy_group_by_entries<OUTPUT_TYPE, int8_t, QUERY_TYPE, COLUMNAR_FORMAT>(
+            rs, entries, target_idx, slot_idx, output);
+        break;
+      default:
+        UNREACHABLE() << "Unexpected integer slot width: " << entry_width;
+    }
+  }
+}
+
+template <typename OUTPUT_TYPE>
+void copy_group_by_entries(const ResultSet& rs,
+                           const std::vector<size_t>& entries,
+                           const size_t target_idx,
+                           const size_t slot_idx,
+                           const size_t entry_width,
+                           int8_t* output_buffer) {
+  auto output = reinterpret_cast<OUTPUT_TYPE*>(output_buffer);
+  const bool columnar = rs.didOutputColumnar();
+  if (rs.getQueryDescriptionType() == QueryDescriptionType::GroupByPerfectHash) {
+    if (columnar) {
+      copy_group_by_entries<OUTPUT_TYPE, QueryDescriptionType::GroupByPerfectHash, true>(
+          rs, entries, target_idx, slot_idx, entry_width, output);
+    } else {
+      copy_group_by_entries<OUTPUT_TYPE, QueryDescriptionType::GroupByPerfectHash, false>(
+          rs, entries, target_idx, slot_idx, entry_width, output);
+    }
+  } else {
+    CHECK(rs.getQueryDescriptionType() == QueryDescriptionType::GroupByBaselineHash);
+    if (columnar) {
+      copy_group_by_entries<OUTPUT_TYPE, QueryDescriptionType::GroupByBaselineHash, true>(
+          rs, entries, target_idx, slot_idx, entry_width, output);
+    } else {
+      copy_group_by_entries<OUTPUT_TYPE,
+                            QueryDescriptionType::GroupByBaselineHash,
+                            false>(
+          rs, entries, target_idx, slot_idx, entry_width, output);
+    }
+  }
+}
+
+}  // namespace
+
+/**
+ * Decodes a group-by target straight into a dense output buffer. Unlike getRowAt(),
+ * which goes through TargetValue for each slot, the slot layout and the output type are
+ * resolved once per column and each entry is read with a specialized accessor.
+ */
+void ResultSet::copyGroupByColumnIntoBuffer(const size_t column_idx,
+                                            const std::vector<size_t>& entries,
+                                            int8_t* output_buffer,
+                                            const size_t output_buffer_size) const {
+  CHECK(isDirectGroupByColumnCopyPossible(column_idx));
+  auto type = targets_[column_idx].type;
+  CHECK_LE(entries.size() * type->size(), output_buffer_size);
+  const size_t slot_idx = query_mem_desc_.getSlotIndexForSingleSlotCol(column_idx);
+  size_t entry_width = query_mem_desc_.getPaddedSlotWidthBytes(slot_idx);
+  if (!entry_width) {
+    // Baseline hash key columns are read from the key.
+    CHECK(query_mem_desc_.getQueryDescriptionType() ==
+          QueryDescriptionType::GroupByBaselineHash);
+    CHECK_GE(query_mem_desc_.getTargetGroupbyIndex(column_idx), 0);
+    entry_width = query_mem_desc_.getEffectiveKeyWidth();
+  }
+  if (type->isFloatingPoint()) {
+    switch (type->as<hdk::ir::FloatingPointType>()->precision()) {
+      case hdk::ir::FloatingPointType::kFloat:
+        copy_group_by_entries<float>(
+            *this, entries, column_idx, slot_idx, entry_width, output_buffer);
+        break;
+      case hdk::ir::FloatingPointType::kDouble:
+        copy_group_by_entries<double>(
+            *this, entries, column_idx, slot_idx, entry_width, output_buffer);
+        break;
+      default:
+        UNREACHABLE() << "Unexpected type: " << type->toString();
+    }
+  } else {
+    switch (type->size()) {
+      case 8:
+        copy_group_by_entries<int64_t>(
+            *this, entries, column_idx, slot_idx, entry_width, output_buffer);
+        break;
+      case 4:
+        copy_group_by_entries<int32_t>(
+            *this, entries, column_idx, slot_idx, entry_width, output_buffer);
+        break;
+      case 2:
+        copy_group_by_entries<int16_t>(
+            *this, entries, column_idx, slot_idx, entry_width, output_buffer);
+        break;
+      case 1:
+        copy_group_by_entries<int8_t>(
+            *this, entries, column_idx, slot_idx, entry_width, output_buffer);
+        break;
+      default:
+        UNREACHABLE() << "Unexpected type: " << type->toString();
+    }
+  }
+}
+
+std::vector<size_t> ResultSet::getNonEmptyEntries() const {
+  std::vector<size_t> entries;
+  const auto entry_count = entryCount();
+  for (size_t entry_idx = 0; entry_idx < entry_count; ++entry_idx) {
+    if (!isRowAtEmpty(entry_idx)) {
+      entries.push_back(entry_idx);
+    }
+  }
+  return entries;
+}
+
 // Interprets ptr1, ptr2 as the ptr and len pair used for variable length data.
 TargetValue ResultSet::makeVarlenTargetValue(const int8_t* ptr1,
                                              const int8_t compact_sz1,
@@ -1226,14 +1683,8 @@ TargetValue ResultSet::makeTargetValue(const int8_t* ptr,
       CHECK_LT(size_t(col_lazy_fetch.local_col_id), frag_col_buffers.size());
       ival = result_set::lazy_decode(
           col_lazy_fetch, frag_col_buffers[col_lazy_fetch.local_col_id], ival);
-      if (chosen_type->isFloatingPoint()) {
-        const auto dval = *reinterpret_cast<const double*>(may_alias_ptr(&ival));
-        if (chosen_type->isFp32()) {
-          return ScalarTargetValue(static_cast<float>(dval));
-        } else {
-          return ScalarTargetValue(dval);
-        }
-      }
+      return makeLazyTargetValue(
+          ival, target_info, target_logical_idx, translate_strings, decimal_to_double);
     }
   }
   if (chosen_type->isFloatingPoint()) {
@@ -1256,6 +1707,38 @@ TargetValue ResultSet::makeTargetValue(const int8_t* ptr,
         CHECK(false);
     }
   }
+  return makeIntTargetValue(
+      ival, target_info, target_logical_idx, translate_strings, decimal_to_double);
+}
+
+// Makes a target value of a lazily fetched column from the value decoded from its
+// fragment.
+TargetValue ResultSet::makeLazyTargetValue(const int64_t ival,
+                                           const TargetInfo& target_info,
+                                           const size_t target_logical_idx,
+                                           const bool translate_strings,
+                                           const bool decimal_to_double) const {
+  auto chosen_type = get_compact_type(target_info);
+  if (chosen_type->isFloatingPoint()) {
+    // lazy_decode returns floating point values as doubles.
+    const auto dval = *reinterpret_cast<const double*>(may_alias_ptr(&ival));
+    if (chosen_type->isFp32()) {
+      return ScalarTargetValue(static_cast<float>(dval));
+    } else {
+      return ScalarTargetValue(dval);
+    }
+  }
+  return makeIntTargetValue(
+      ival, target_info, target_logical_idx, translate_strings, decimal_to_double);
+}
+
+TargetValue ResultSet::makeIntTargetValue(const int64_t ival,
+                                          const TargetInfo& target_info,
+                                          const size_t target_logical_idx,
+                                          const bool translate_strings,
+                                          const bool decimal_to_double) const {
+  auto type = target_info.type;
+  auto chosen_type = get_compact_type(target_info);
   if (chosen_type->isInteger() | chosen_type->isBoolean() || chosen_type->isDateTime() ||
       chosen_type->isInterval()) {
     if (is_distinct_target(target_info)) {
@@ -438,6 +438,9 @@ bool ResultSetStorage::isEmptyEntry(const size_t entry_idx, const int8_t* buff)
       query_mem_desc_.getQueryDescriptionType()) {
     return false;
   }
+  if (first_touch_init_ && buff == buff_) {
+    return !((getOccupancyBitmap()[entry_idx >> 6] >> (entry_idx & 63)) & 1);
+  }
   if (query_mem_desc_.didOutputColumnar()) {
     return isEmptyEntryColumnar(entry_idx, buff);
   }
@@ -544,3 +547,40 @@ size_t ResultSetStorage::binSearchRowCount() const {
 bool ResultSetStorage::isEmptyEntry(const size_t entry_idx) const {
   return isEmptyEntry(entry_idx, buff_);
 }
+
+uint64_t* ResultSetStorage::getOccupancyBitmap() const {
+  if (!first_touch_init_) {
+    return nullptr;
+  }
+  return reinterpret_cast<uint64_t*>(buff_ + query_mem_desc_.getOccupancyBitmapOffset());
+}
+
+void ResultSetStorage::finalizeFirstTouchInit() const {
+  if (!first_touch_init_) {
+    return;
+  }
+  CHECK(!query_mem_desc_.didOutputColumnar());
+  const auto occupancy = getOccupancyBitmap();
+  const auto init_row = buff_ + query_mem_desc_.getFirstTouchInitRowOffset();
+  const auto entry_count = query_mem_desc_.getEntryCount();
+  const auto row_size = query_mem_desc_.getRowSize();
+  const auto key_count = query_mem_desc_.getGroupbyColCount();
+  const auto key_width = query_mem_desc_.getEffectiveKeyWidth();
+  for (size_t word_idx = 0; word_idx * 64 < entry_count; ++word_idx) {
+    const auto word = occupancy[word_idx];
+    const auto end_idx = std::min(word_idx * 64 + 64, entry_count);
+    for (size_t entry_idx = word_idx * 64; entry_idx < end_idx; ++entry_idx) {
+      if ((word >> (entry_idx & 63)) & 1) {
+        continue;
+      }
+      auto row_ptr = row_ptr_rowwise(buff_, query_mem_desc_, entry_idx);
+      // Keyless entries are told empty by a target value, so the whole row is reset.
+      if (query_mem_desc_.hasKeylessHash()) {
+        memcpy(row_ptr, init_row, row_size);
+      } else {
+        result_set::fill_empty_key(row_ptr, key_count, key_width);
+      }
+    }
+  }
+  first_touch_init_ = false;
+}
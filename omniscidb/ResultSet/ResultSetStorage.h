@@ -134,6 +134,16 @@ class ResultSetStorage {
   bool isEmptyEntry(const size_t entry_idx) const;
   bool isEmptyEntryColumnar(const size_t entry_idx, const int8_t* buff) const;
 
+  // Marks the buffer as initialized by the kernel on the first touch, see
+  // QueryMemoryDescriptor::firstTouchInitGroups. Untouched entries hold garbage, so
+  // code reading keys directly has to call finalizeFirstTouchInit() first.
+  void setFirstTouchInit() const { first_touch_init_ = true; }
+  bool hasFirstTouchInit() const { return first_touch_init_; }
+  // Occupancy bitmap of entries, null if the buffer is fully initialized.
+  uint64_t* getOccupancyBitmap() const;
+  // Writes empty keys to untouched entries and drops the occupancy bitmap.
+  void finalizeFirstTouchInit() const;
+
  private:
   void fillOneEntryRowWise(const std::vector<int64_t>& entry);
 
@@ -168,6 +178,8 @@ class ResultSetStorage {
   // ptr to host varlen buffer and gpu address computation info
   std::shared_ptr<VarlenOutputInfo> varlen_output_info_;
 
+  mutable bool first_touch_init_{false};
+
   friend class ResultSet;
 };
 
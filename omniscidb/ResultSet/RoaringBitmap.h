@@ -0,0 +1,156 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    RoaringBitmap.h
+ * @brief   Compressed bitmap used for exact COUNT(DISTINCT) on integer values.
+ *
+ * Values are split into 2^16 wide chunks by their high bits. Each non-empty chunk is
+ * stored in a container which is a sorted array of low 16 bits for sparse chunks and
+ * a 8KB bitmap for dense chunks. Memory is proportional to the number of distinct
+ * values rather than to the value range, and unions of dense chunks are word-wise ORs.
+ **/
+
+#pragma once
+
+#include "ThirdParty/robin_hood.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+class RoaringBitmap {
+ public:
+  void add(const int64_t val) {
+    const int64_t high = val >> 16;
+    if (!last_container_ || last_high_ != high) {
+      last_container_ = &containers_[high];
+      last_high_ = high;
+    }
+    if (last_container_->add(static_cast<uint16_t>(val & 0xFFFF))) {
+      ++cardinality_;
+    }
+  }
+
+  size_t size() const { return cardinality_; }
+
+  void unionWith(const RoaringBitmap& other) {
+    for (auto& [high, other_container] : other.containers_) {
+      auto& container = containers_[high];
+      cardinality_ -= container.cardinality;
+      container.unionWith(other_container);
+      cardinality_ += container.cardinality;
+    }
+  }
+
+ private:
+  // An array container is converted to a bitmap when it gets bigger than a bitmap.
+  static constexpr size_t kMaxArrayContainerSize = 4096;
+  static constexpr size_t kBitmapContainerWords = 1024;
+
+  using BitmapContainer = std::array<uint64_t, kBitmapContainerWords>;
+
+  struct Container {
+    std::vector<uint16_t> array;
+    std::unique_ptr<BitmapContainer> bitmap;
+    size_t cardinality = 0;
+
+    bool add(const uint16_t low) {
+      if (bitmap) {
+        auto& word = (*bitmap)[low >> 6];
+        const uint64_t mask = uint64_t(1) << (low & 63);
+        if (word & mask) {
+          return false;
+        }
+        word |= mask;
+        ++cardinality;
+        return true;
+      }
+      auto it = std::lower_bound(array.begin(), array.end(), low);
+      if (it != array.end() && *it == low) {
+        return false;
+      }
+      array.insert(it, low);
+      ++cardinality;
+      if (array.size() > kMaxArrayContainerSize) {
+        convertToBitmap();
+      }
+      return true;
+    }
+
+    void unionWith(const Container& other) {
+      if (other.bitmap) {
+        if (!bitmap) {
+          auto own_values = std::move(array);
+          array.clear();
+          bitmap = std::make_unique<BitmapContainer>(*other.bitmap);
+          setBits(own_values);
+        } else {
+          auto& words = *bitmap;
+          const auto& other_words = *other.bitmap;
+          for (size_t i = 0; i < kBitmapContainerWords; ++i) {
+            words[i] |= other_words[i];
+          }
+        }
+        countBits();
+      } else if (bitmap) {
+        setBits(other.array);
+        countBits();
+      } else {
+        std::vector<uint16_t> merged;
+        merged.reserve(array.size() + other.array.size());
+        std::set_union(array.begin(),
+                       array.end(),
+                       other.array.begin(),
+                       other.array.end(),
+                       std::back_inserter(merged));
+        array = std::move(merged);
+        cardinality = array.size();
+        if (array.size() > kMaxArrayContainerSize) {
+          convertToBitmap();
+        }
+      }
+    }
+
+    void convertToBitmap() {
+      bitmap = std::make_unique<BitmapContainer>();
+      bitmap->fill(0);
+      setBits(array);
+      array.clear();
+      array.shrink_to_fit();
+    }
+
+    void setBits(const std::vector<uint16_t>& values) {
+      for (auto low : values) {
+        (*bitmap)[low >> 6] |= uint64_t(1) << (low & 63);
+      }
+    }
+
+    void countBits() {
+      cardinality = 0;
+      for (auto word : *bitmap) {
+        cardinality += __builtin_popcountll(word);
+      }
+    }
+  };
+
+  // Node map keeps cached container pointers valid on insertion.
+  robin_hood::unordered_node_map<int64_t, Container> containers_;
+  int64_t last_high_{0};
+  Container* last_container_{nullptr};
+  size_t cardinality_{0};
+};
@@ -7,6 +7,8 @@
 
 #include "RowSetMemoryOwner.h"
 
+#include <limits>
+
 EXTERN extern bool g_cache_string_hash;
 
 StringDictionaryProxy* RowSetMemoryOwner::getOrAddStringDictProxy(
@@ -30,3 +32,52 @@ StringDictionaryProxy* RowSetMemoryOwner::getOrAddStringDictProxy(
   }
   return lit_str_dict_proxy_.get();
 }
+
+const RegexpMatcher* RowSetMemoryOwner::getOrAddRegexpMatcher(
+    const std::vector<std::string>& patterns) {
+  std::lock_guard<std::mutex> lock(state_mutex_);
+  auto& matcher = regexp_matchers_[patterns];
+  if (!matcher) {
+    matcher = std::make_unique<RegexpMatcher>(patterns);
+  }
+  return matcher.get();
+}
+
+std::atomic<uint64_t> RowSetMemoryOwner::next_id_{0};
+
+RowSetMemoryOwner::ThreadObjects::~ThreadObjects() {
+  for (auto count_distinct_set : count_distinct_sets) {
+    delete count_distinct_set;
+  }
+  for (auto count_distinct_bitmap : count_distinct_roaring_bitmaps) {
+    delete count_distinct_bitmap;
+  }
+  for (auto count_distinct_hll : count_distinct_sparse_hlls) {
+    delete count_distinct_hll;
+  }
+  for (auto group_by_buffer : group_by_buffers) {
+    free(group_by_buffer);
+  }
+  for (auto varlen_buffer : varlen_buffers) {
+    free(varlen_buffer);
+  }
+}
+
+RowSetMemoryOwner::ThreadObjects& RowSetMemoryOwner::threadObjects() {
+  // The last used objects are cached per thread. Owner ids are never reused, so cached
+  // objects of a destroyed owner are never matched.
+  thread_local uint64_t cached_owner_id = std::numeric_limits<uint64_t>::max();
+  thread_local ThreadObjects* cached_objects = nullptr;
+  if (cached_owner_id == id_) {
+    return *cached_objects;
+  }
+
+  std::lock_guard<std::mutex> lock(state_mutex_);
+  auto& thread_objects = thread_objects_[std::this_thread::get_id()];
+  if (!thread_objects) {
+    thread_objects = std::make_unique<ThreadObjects>();
+  }
+  cached_owner_id = id_;
+  cached_objects = thread_objects.get();
+  return *thread_objects;
+}
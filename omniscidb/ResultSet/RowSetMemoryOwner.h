@@ -17,21 +17,27 @@
 #pragma once
 
 #include <boost/noncopyable.hpp>
-#include <list>
+#include <atomic>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
+#include "BufferProvider/BufferProvider.h"
 #include "DataMgr/AbstractBuffer.h"
 #include "DataMgr/Allocators/ArenaAllocator.h"
 #include "DataMgr/DataMgr.h"
 #include "DataProvider/DataProvider.h"
 #include "Logger/Logger.h"
+#include "ResultSet/HyperLogLog.h"
+#include "ResultSet/RoaringBitmap.h"
 #include "Shared/quantile.h"
 #include "StringDictionary/StringDictionaryProxy.h"
 #include "ThirdParty/robin_hood.h"
+#include "Utils/RegexpMatcher.h"
 
 class ResultSet;
 
@@ -44,7 +50,9 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
   RowSetMemoryOwner(DataProvider* data_provider,
                     const size_t arena_block_size,
                     const size_t num_kernel_threads = 0)
-      : data_provider_(data_provider), arena_block_size_(arena_block_size) {
+      : data_provider_(data_provider)
+      , arena_block_size_(arena_block_size)
+      , id_(next_id_.fetch_add(1)) {
     // We used to allocate an Arena per each kernel thread. This was done to avoid
     // small result set buffers allocated for different threads to be placed into
     // the same cache line. Now we use a single Arena and round-up allocated memory
@@ -62,8 +70,23 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
     // to allocate low-level objects like strings or varlen data buffers for each
     // result set row. The code should be revised if we want to use RowSetMemoryOwner
     // for such allocations.
-    return reinterpret_cast<int8_t*>(
-        allocator_->allocate(std::max(num_bytes, (size_t)256)));
+    const auto alloc_size = std::max(num_bytes, (size_t)256);
+    if (memory_tracker_) {
+      memory_tracker_->allocated(Data_Namespace::CPU_LEVEL, alloc_size);
+    }
+    return reinterpret_cast<int8_t*>(allocator_->allocate(alloc_size));
+  }
+
+  // Account allocated memory to the query. The query is considered finished when
+  // the tracker is released by all its owners.
+  void setMemoryTracker(std::shared_ptr<Data_Namespace::QueryMemoryTracker> tracker) {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    memory_tracker_ = std::move(tracker);
+  }
+
+  std::shared_ptr<Data_Namespace::QueryMemoryTracker> getMemoryTracker() const {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    return memory_tracker_;
   }
 
   int8_t* allocateCountDistinctBuffer(const size_t num_bytes,
@@ -77,24 +100,28 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
   void addCountDistinctBuffer(int8_t* count_distinct_buffer,
                               const size_t bytes,
                               const bool physical_buffer) {
-    std::lock_guard<std::mutex> lock(state_mutex_);
-    count_distinct_bitmaps_.emplace_back(
+    threadObjects().count_distinct_bitmaps.emplace_back(
         CountDistinctBitmapBuffer{count_distinct_buffer, bytes, physical_buffer});
   }
 
   void addCountDistinctSet(robin_hood::unordered_set<int64_t>* count_distinct_set) {
-    std::lock_guard<std::mutex> lock(state_mutex_);
-    count_distinct_sets_.push_back(count_distinct_set);
+    threadObjects().count_distinct_sets.push_back(count_distinct_set);
+  }
+
+  void addCountDistinctRoaringBitmap(RoaringBitmap* count_distinct_bitmap) {
+    threadObjects().count_distinct_roaring_bitmaps.push_back(count_distinct_bitmap);
+  }
+
+  void addCountDistinctSparseHll(SparseHyperLogLog* count_distinct_hll) {
+    threadObjects().count_distinct_sparse_hlls.push_back(count_distinct_hll);
   }
 
   void addGroupByBuffer(int64_t* group_by_buffer) {
-    std::lock_guard<std::mutex> lock(state_mutex_);
-    group_by_buffers_.push_back(group_by_buffer);
+    threadObjects().group_by_buffers.push_back(group_by_buffer);
   }
 
   void addVarlenBuffer(void* varlen_buffer) {
-    std::lock_guard<std::mutex> lock(state_mutex_);
-    varlen_buffers_.push_back(varlen_buffer);
+    threadObjects().varlen_buffers.push_back(varlen_buffer);
   }
 
   /**
@@ -110,15 +137,15 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
   }
 
   std::string* addString(const std::string& str) {
-    std::lock_guard<std::mutex> lock(state_mutex_);
-    strings_.emplace_back(str);
-    return &strings_.back();
+    auto& strings = threadObjects().strings;
+    strings.emplace_back(str);
+    return &strings.back();
   }
 
   std::vector<int64_t>* addArray(const std::vector<int64_t>& arr) {
-    std::lock_guard<std::mutex> lock(state_mutex_);
-    arrays_.emplace_back(arr);
-    return &arrays_.back();
+    auto& arrays = threadObjects().arrays;
+    arrays.emplace_back(arr);
+    return &arrays.back();
   }
 
   StringDictionaryProxy* addStringDict(std::shared_ptr<StringDictionary> str_dict,
@@ -200,21 +227,22 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
       const int64_t dest_generation,
       const StringTranslationType translation_map_type);
 
+  // REGEXP_LIKE patterns are compiled once per query and shared by its kernels.
+  const RegexpMatcher* getOrAddRegexpMatcher(const std::vector<std::string>& patterns);
+
   void addColBuffer(const void* col_buffer) {
     std::lock_guard<std::mutex> lock(state_mutex_);
     col_buffers_.push_back(const_cast<void*>(col_buffer));
   }
 
+  // Take ownership of a device buffer holding results kept in device memory.
+  void addDeviceBuffer(BufferProvider* buffer_provider,
+                       Data_Namespace::AbstractBuffer* buffer) {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    device_buffers_.emplace_back(buffer_provider, buffer);
+  }
+
   ~RowSetMemoryOwner() {
-    for (auto count_distinct_set : count_distinct_sets_) {
-      delete count_distinct_set;
-    }
-    for (auto group_by_buffer : group_by_buffers_) {
-      free(group_by_buffer);
-    }
-    for (auto varlen_buffer : varlen_buffers_) {
-      free(varlen_buffer);
-    }
     for (auto varlen_input_buffer : varlen_input_buffers_) {
       CHECK(varlen_input_buffer);
       varlen_input_buffer->unPin();
@@ -222,6 +250,9 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
     for (auto col_buffer : col_buffers_) {
       free(col_buffer);
     }
+    for (auto& [buffer_provider, buffer] : device_buffers_) {
+      buffer_provider->free(buffer);
+    }
   }
 
   std::shared_ptr<RowSetMemoryOwner> cloneStrDictDataOnly() {
@@ -241,25 +272,46 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
     const bool physical_buffer;
   };
 
-  std::vector<CountDistinctBitmapBuffer> count_distinct_bitmaps_;
-  std::vector<robin_hood::unordered_set<int64_t>*> count_distinct_sets_;
-  std::vector<int64_t*> group_by_buffers_;
-  std::vector<void*> varlen_buffers_;
-  std::list<std::string> strings_;
-  std::list<std::vector<int64_t>> arrays_;
+  // Result lifetime objects added by a single thread. Only that thread modifies it, so
+  // no locking is needed. Everything is released in bulk with the owner.
+  struct ThreadObjects {
+    ~ThreadObjects();
+
+    // Deques keep addresses of elements stable and allocate them in blocks.
+    std::deque<std::string> strings;
+    std::deque<std::vector<int64_t>> arrays;
+    std::vector<CountDistinctBitmapBuffer> count_distinct_bitmaps;
+    std::vector<robin_hood::unordered_set<int64_t>*> count_distinct_sets;
+    std::vector<RoaringBitmap*> count_distinct_roaring_bitmaps;
+    std::vector<SparseHyperLogLog*> count_distinct_sparse_hlls;
+    std::vector<int64_t*> group_by_buffers;
+    std::vector<void*> varlen_buffers;
+  };
+
+  ThreadObjects& threadObjects();
+
+  std::unordered_map<std::thread::id, std::unique_ptr<ThreadObjects>> thread_objects_;
   std::unordered_map<int, std::shared_ptr<StringDictionaryProxy>> str_dict_proxy_owned_;
   std::map<std::pair<int, int>, StringDictionaryProxy::IdMap>
       str_proxy_intersection_translation_maps_owned_;
   std::map<std::pair<int, int>, StringDictionaryProxy::IdMap>
       str_proxy_union_translation_maps_owned_;
   std::shared_ptr<StringDictionaryProxy> lit_str_dict_proxy_;
+  std::map<std::vector<std::string>, std::unique_ptr<RegexpMatcher>> regexp_matchers_;
   std::vector<void*> col_buffers_;
   std::vector<Data_Namespace::AbstractBuffer*> varlen_input_buffers_;
+  std::vector<std::pair<BufferProvider*, Data_Namespace::AbstractBuffer*>>
+      device_buffers_;
   std::vector<std::unique_ptr<quantile::TDigest>> t_digests_;
 
+  std::shared_ptr<Data_Namespace::QueryMemoryTracker> memory_tracker_;
+
   DataProvider* data_provider_;  // for metadata lookups
   size_t arena_block_size_;      // for cloning
   std::unique_ptr<Arena> allocator_;
+  // Identifies the owner in thread-local caches of thread objects, never reused.
+  const uint64_t id_;
+  static std::atomic<uint64_t> next_id_;
 
   mutable std::mutex state_mutex_;
 
@@ -69,19 +69,25 @@ ColumnarResults::ColumnarResults(std::shared_ptr<RowSetMemoryOwner> row_set_mem_
                                  const std::vector<const hdk::ir::Type*>& target_types,
                                  const size_t thread_idx,
                                  const Config& config,
-                                 const bool is_parallel_execution_enforced)
+                                 const bool is_parallel_execution_enforced,
+                                 const std::vector<bool>& columns_to_fetch)
     : column_buffers_(num_columns)
     , num_rows_(useParallelFetch(rows) || rows.isDirectColumnarConversionPossible()
                     ? rows.entryCount()
                     : rows.rowCount())
     , target_types_(target_types)
+    , columns_to_fetch_(columns_to_fetch)
     , parallel_conversion_(is_parallel_execution_enforced ? true : useParallelFetch(rows))
     , direct_columnar_conversion_(config.rs.enable_direct_columnarization &&
                                   rows.isDirectColumnarConversionPossible())
     , thread_idx_(thread_idx) {
   auto timer = DEBUG_TIMER(__func__);
   column_buffers_.resize(num_columns);
+  CHECK(columns_to_fetch_.empty() || columns_to_fetch_.size() == num_columns);
   for (size_t i = 0; i < num_columns; ++i) {
+    if (!isColumnFetched(i)) {
+      continue;
+    }
     if (target_types[i]->isVarLen()) {
       // Allocate and fill offsets buffer.
       offset_buffers_.resize(num_columns, nullptr);
@@ -132,6 +138,29 @@ ColumnarResults::ColumnarResults(std::shared_ptr<RowSetMemoryOwner> row_set_mem_
   memcpy(((void*)column_buffers_[0]), one_col_buffer, buf_size);
 }
 
+bool ColumnarResults::isPerColumnConversionPossible(const ResultSet& rows,
+                                                    const Config& config) {
+  // Serial conversion uses the result set iterator and parallel conversion of
+  // group-by results through iteration doesn't preserve rows order.
+  if (config.rs.enable_direct_columnarization &&
+      rows.isDirectColumnarConversionPossible() && rows.entryCount() > 0) {
+    return true;
+  }
+  return useParallelFetch(rows) &&
+         rows.getQueryDescriptionType() == QueryDescriptionType::Projection;
+}
+
+std::vector<bool> ColumnarResults::getTargetsToSkip() const {
+  std::vector<bool> res;
+  if (!columns_to_fetch_.empty()) {
+    res.reserve(columns_to_fetch_.size());
+    for (auto fetch : columns_to_fetch_) {
+      res.push_back(!fetch);
+    }
+  }
+  return res;
+}
+
 std::unique_ptr<ColumnarResults> ColumnarResults::mergeResults(
     std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner,
     const std::vector<std::unique_ptr<ColumnarResults>>& sub_results) {
@@ -172,6 +201,53 @@ std::unique_ptr<ColumnarResults> ColumnarResults::mergeResults(
   return merged_results;
 }
 
+std::unique_ptr<ColumnarResults> ColumnarResults::mergeColumnFragments(
+    std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner,
+    const std::vector<std::pair<const int8_t*, size_t>>& fragments,
+    const hdk::ir::Type* target_type,
+    const size_t thread_idx) {
+  if (target_type->isArray() || target_type->isString()) {
+    throw ColumnarConversionNotSupported();
+  }
+  const size_t byte_width = target_type->size();
+  size_t total_row_count = 0;
+  const int8_t* contiguous_end = nullptr;
+  bool is_contiguous = true;
+  for (auto& [data, row_count] : fragments) {
+    if (!row_count) {
+      continue;
+    }
+    if (contiguous_end && data != contiguous_end) {
+      is_contiguous = false;
+    }
+    contiguous_end = data + row_count * byte_width;
+    total_row_count += row_count;
+  }
+  if (!total_row_count) {
+    return nullptr;
+  }
+  std::unique_ptr<ColumnarResults> merged_results(
+      new ColumnarResults(total_row_count, {target_type}));
+  merged_results->thread_idx_ = thread_idx;
+  const auto first_it = std::find_if(
+      fragments.begin(), fragments.end(), [](auto& frag) { return frag.second; });
+  if (is_contiguous) {
+    merged_results->column_buffers_.push_back(const_cast<int8_t*>(first_it->first));
+    return merged_results;
+  }
+  auto write_ptr = reinterpret_cast<int8_t*>(
+      row_set_mem_owner->allocate(byte_width * total_row_count, thread_idx));
+  merged_results->column_buffers_.push_back(write_ptr);
+  for (auto& [data, row_count] : fragments) {
+    if (!row_count) {
+      continue;
+    }
+    memcpy(write_ptr, data, row_count * byte_width);
+    write_ptr += row_count * byte_width;
+  }
+  return merged_results;
+}
+
 void ColumnarResults::materializeAllGroupbyColumnsThroughIteration(
     const ResultSet& rows,
     const size_t num_columns) {
@@ -180,12 +256,16 @@ void ColumnarResults::materializeAllGroupbyColumnsThroughIteration(
   CHECK(rows.isPermutationBufferEmpty());
   const size_t worker_count = cpu_threads();
   std::vector<std::future<void>> conversion_threads;
-  const auto do_work = [num_columns, &rows, &row_idx, this](const size_t i) {
-    const auto crt_row = rows.getRowAtNoTranslations(i);
+  const auto targets_to_skip = getTargetsToSkip();
+  const auto do_work = [num_columns, &rows, &row_idx, &targets_to_skip, this](
+                           const size_t i) {
+    const auto crt_row = rows.getRowAtNoTranslations(i, targets_to_skip);
     if (!crt_row.empty()) {
       auto cur_row_idx = row_idx.fetch_add(1);
       for (size_t col_idx = 0; col_idx < num_columns; ++col_idx) {
-        writeBackCell(crt_row[col_idx], cur_row_idx, col_idx);
+        if (isColumnFetched(col_idx)) {
+          writeBackCell(crt_row[col_idx], cur_row_idx, col_idx);
+        }
       }
     }
   };
@@ -256,6 +336,7 @@ void ColumnarResults::materializeAllProjectionColumnsThroughIteration(
     size_t seg_end = limit ? std::min(offset + limit, row_count) : row_count;
     chunks.push_back(std::make_tuple(seg_begin, seg_end, (size_t)0));
   }
+  const auto targets_to_skip = getTargetsToSkip();
   auto process_chunk = [&](std::tuple<size_t, size_t, size_t> chunk) {
     // Diff between global entry index and fetched row index for this chunk.
     size_t row_offs = std::get<0>(chunk) - std::get<2>(chunk);
@@ -264,11 +345,14 @@ void ColumnarResults::materializeAllProjectionColumnsThroughIteration(
                       [&](const tbb::blocked_range<size_t>& r) {
                         for (size_t entry_idx = r.begin(); entry_idx != r.end();
                              ++entry_idx) {
-                          const auto crt_row = rows.getRowAtNoTranslations(entry_idx);
+                          const auto crt_row =
+                              rows.getRowAtNoTranslations(entry_idx, targets_to_skip);
                           CHECK(!crt_row.empty());
                           size_t row_idx = entry_idx - row_offs;
                           for (size_t col_idx = 0; col_idx < num_columns; ++col_idx) {
-                            writeBackCell(crt_row[col_idx], row_idx, col_idx);
+                            if (isColumnFetched(col_idx)) {
+                              writeBackCell(crt_row[col_idx], row_idx, col_idx);
+                            }
                           }
                         }
                       });
@@ -298,7 +382,8 @@ void ColumnarResults::materializeAllColumnsThroughIteration(const ResultSet& row
     // Parallel fetch for GroupBy buffer doesn't respect rows order, so don't use
     // it for sorted results and varlen data (offsets are pre-computed for the
     // original rows order in the groupby buffer).
-    if (rows.isPermutationBufferEmpty() && offset_buffers_.empty()) {
+    if (rows.isPermutationBufferEmpty() && offset_buffers_.empty() &&
+        columns_to_fetch_.empty()) {
       materializeAllGroupbyColumnsThroughIteration(rows, num_columns);
       return;
     }
@@ -309,7 +394,9 @@ void ColumnarResults::materializeAllColumnsThroughIteration(const ResultSet& row
   auto crt_row = rows.getNextRow(false, false);
   while (!crt_row.empty()) {
     for (size_t i = 0; i < num_columns; ++i) {
-      writeBackCell(crt_row[i], row_idx, i);
+      if (isColumnFetched(i)) {
+        writeBackCell(crt_row[i], row_idx, i);
+      }
     }
     ++row_idx;
     crt_row = rows.getNextRow(false, false);
@@ -579,6 +666,9 @@ void ColumnarResults::copyAllNonLazyColumns(
   // parallelized by assigning each column to a thread
   std::vector<std::future<void>> direct_copy_threads;
   for (size_t col_idx = 0; col_idx < num_columns; col_idx++) {
+    if (!isColumnFetched(col_idx)) {
+      continue;
+    }
     if (rows.isZeroCopyColumnarConversionPossible(col_idx)) {
       CHECK(!column_buffers_[col_idx]);
       column_buffers_[col_idx] = const_cast<int8_t*>(rows.getColumnarBuffer(col_idx));
@@ -631,6 +721,17 @@ void ColumnarResults::materializeAllLazyColumns(
                                target_types_.end(),
                                [](const hdk::ir::Type* type) { return type->isArray(); });
   if (rows.areAnyColumnsLazyFetched() || !offset_buffers_.empty() || has_array) {
+    bool has_columns_to_iterate = false;
+    for (size_t i = 0; i < num_columns; i++) {
+      has_columns_to_iterate =
+          has_columns_to_iterate ||
+          (isColumnFetched(i) &&
+           ((!lazy_fetch_info.empty() && lazy_fetch_info[i].is_lazily_fetched) ||
+            target_types_[i]->isVarLen() || target_types_[i]->isArray()));
+    }
+    if (!has_columns_to_iterate) {
+      return;
+    }
     const size_t worker_count =
         result_set::use_parallel_algorithms(rows) ? cpu_threads() : 1;
     std::vector<std::future<void>> conversion_threads;
@@ -641,8 +742,9 @@ void ColumnarResults::materializeAllLazyColumns(
       for (size_t i = 0; i < num_columns; i++) {
         // we process lazy and varlen columns (i.e., skip non-lazy and non-varlen columns)
         targets_to_skip.push_back(
-            (lazy_fetch_info.empty() || !lazy_fetch_info[i].is_lazily_fetched) &&
-            !target_types_[i]->isVarLen() && !target_types_[i]->isArray());
+            !isColumnFetched(i) ||
+            ((lazy_fetch_info.empty() || !lazy_fetch_info[i].is_lazily_fetched) &&
+             !target_types_[i]->isVarLen() && !target_types_[i]->isArray()));
       }
     }
     size_t first = rows.getOffset();
@@ -795,8 +897,15 @@ void ColumnarResults::compactAndCopyEntries(
                    std::next(global_offsets.begin()));
 
   const auto slot_idx_per_target_idx = rows.getSlotIndicesForTargetIndices();
-  const auto [single_slot_targets_to_skip, num_single_slot_targets] =
+  auto [single_slot_targets_to_skip, num_single_slot_targets] =
       rows.getSupportedSingleSlotTargetBitmap();
+  // Columns which are not fetched are excluded from iteration.
+  for (size_t column_idx = 0; column_idx < num_columns; ++column_idx) {
+    if (!isColumnFetched(column_idx) && !single_slot_targets_to_skip[column_idx]) {
+      single_slot_targets_to_skip[column_idx] = true;
+      ++num_single_slot_targets;
+    }
+  }
 
   // We skip multi-slot targets (e.g., AVG). These skipped targets are treated
   // differently and accessed through result set's iterator
@@ -879,7 +988,8 @@ void ColumnarResults::compactAndCopyEntriesWithTargetSkipping(
       // targets that are copied directly without any translation/decoding from
       // result set
       for (size_t column_idx = 0; column_idx < num_columns; column_idx++) {
-        if (!targets_to_skip.empty() && !targets_to_skip[column_idx]) {
+        if ((!targets_to_skip.empty() && !targets_to_skip[column_idx]) ||
+            !isColumnFetched(column_idx)) {
           continue;
         }
         write_functions[column_idx](rows,
@@ -948,7 +1058,8 @@ void ColumnarResults::compactAndCopyEntriesWithoutTargetSkipping(
       initAllConversionFunctions(rows, slot_idx_per_target_idx);
   CHECK_EQ(write_functions.size(), num_columns);
   CHECK_EQ(read_functions.size(), num_columns);
-  auto do_work = [&rows,
+  auto do_work = [this,
+                  &rows,
                   &bitmap,
                   &global_offsets,
                   &num_columns,
@@ -968,6 +1079,9 @@ void ColumnarResults::compactAndCopyEntriesWithoutTargetSkipping(
     const size_t output_buffer_row_idx = global_offsets[thread_idx] + non_empty_idx;
     if (bitmap.get(local_idx, thread_idx)) {
       for (size_t column_idx = 0; column_idx < num_columns; column_idx++) {
+        if (!isColumnFetched(column_idx)) {
+          continue;
+        }
         write_functions[column_idx](rows,
                                     entry_idx,
                                     output_buffer_row_idx,
@@ -65,7 +65,8 @@ class ColumnarResults {
                   const std::vector<const hdk::ir::Type*>& target_types,
                   const size_t thread_idx,
                   const Config& config,
-                  const bool is_parallel_execution_enforced = false);
+                  const bool is_parallel_execution_enforced = false,
+                  const std::vector<bool>& columns_to_fetch = {});
 
   ColumnarResults(const std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner,
                   const int8_t* one_col_buffer,
@@ -77,6 +78,16 @@ class ColumnarResults {
       const std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner,
       const std::vector<std::unique_ptr<ColumnarResults>>& sub_results);
 
+  // Merges fragments of a fixed length column given by data pointers and row counts.
+  // When all fragments lie back to back in memory, e.g. zero-copy slices of a single
+  // Arrow chunk, the result refers to the fragments data instead of copying it and the
+  // caller has to keep the fragments alive.
+  static std::unique_ptr<ColumnarResults> mergeColumnFragments(
+      const std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner,
+      const std::vector<std::pair<const int8_t*, size_t>>& fragments,
+      const hdk::ir::Type* target_type,
+      const size_t thread_idx);
+
   const std::vector<int8_t*>& getColumnBuffers() const { return column_buffers_; }
   const std::vector<int8_t*>& getOffsetBuffers() const { return offset_buffers_; }
 
@@ -88,6 +99,10 @@ class ColumnarResults {
     return target_types_[col_id];
   }
 
+  // Whether columns of the result set can be converted by separate ColumnarResults
+  // objects concurrently and in the same rows order.
+  static bool isPerColumnConversionPossible(const ResultSet& rows, const Config& config);
+
   bool isParallelConversion() const { return parallel_conversion_; }
   bool isDirectColumnarConversionPossible() const { return direct_columnar_conversion_; }
 
@@ -182,6 +197,13 @@ class ColumnarResults {
                            const size_t slot_idx,
                            const ReadFunction& read_function);
 
+  // Columns not fetched have no buffers.
+  bool isColumnFetched(const size_t col_idx) const {
+    return columns_to_fetch_.empty() || columns_to_fetch_[col_idx];
+  }
+  // Targets to skip on rows iteration, empty if all columns are fetched.
+  std::vector<bool> getTargetsToSkip() const;
+
   std::vector<WriteFunction> initWriteFunctions(
       const ResultSet& rows,
       const std::vector<bool>& targets_to_skip = {});
@@ -198,6 +220,7 @@ class ColumnarResults {
                              const std::vector<bool>& targets_to_skip = {});
 
   const std::vector<const hdk::ir::Type*> target_types_;
+  const std::vector<bool> columns_to_fetch_;
   bool parallel_conversion_;         // multi-threaded execution of columnar conversion
   bool direct_columnar_conversion_;  // whether columnar conversion might happen directly
   // with minimal ussage of result set's iterator access
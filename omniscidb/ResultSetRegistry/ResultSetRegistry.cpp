@@ -9,7 +9,14 @@
 
 #include "DataMgr/DataMgr.h"
 
+#include <boost/filesystem.hpp>
+#include <zlib.h>
+
+#include <fstream>
 #include <iomanip>
+#include <map>
+#include <numeric>
+#include <random>
 
 namespace hdk {
 
@@ -59,6 +66,72 @@ size_t columnIndex(int col_id) {
   return ResultSetTableToken::columnIndex(col_id);
 }
 
+// Results are spilled by copying their storage buffer, so only results held in a
+// single buffer with no references to other memory can be spilled. Tables of such
+// results don't use ColumnarResults.
+bool isSpillable(const ResultSet& rs) {
+  return rs.getDeviceType() == ExecutorDeviceType::CPU && rs.getStorageCount() == 1 &&
+         rs.isDirectColumnarConversionPossible() && !rs.areAnyColumnsLazyFetched();
+}
+
+// Spill files are made of zlib compressed blocks, each prefixed with its raw and
+// compressed sizes.
+constexpr size_t kSpillBlockSize = 1 << 24;
+
+void writeCompressed(const std::string& path, const int8_t* buf, size_t size) {
+  std::ofstream out(path, std::ios::binary);
+  if (!out) {
+    throw std::runtime_error("Cannot create spill file " + path);
+  }
+  std::vector<Bytef> block(compressBound(kSpillBlockSize));
+  for (size_t start = 0; start < size; start += kSpillBlockSize) {
+    uint64_t raw_size = std::min(kSpillBlockSize, size - start);
+    uLongf block_size = block.size();
+    if (compress2(block.data(),
+                  &block_size,
+                  reinterpret_cast<const Bytef*>(buf + start),
+                  raw_size,
+                  Z_BEST_SPEED) != Z_OK) {
+      throw std::runtime_error("Cannot compress spilled data");
+    }
+    uint64_t comp_size = block_size;
+    out.write(reinterpret_cast<const char*>(&raw_size), sizeof(raw_size));
+    out.write(reinterpret_cast<const char*>(&comp_size), sizeof(comp_size));
+    out.write(reinterpret_cast<const char*>(block.data()), comp_size);
+  }
+  out.close();
+  if (!out) {
+    throw std::runtime_error("Cannot write spill file " + path);
+  }
+}
+
+void readCompressed(const std::string& path, int8_t* buf, size_t size) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    throw std::runtime_error("Cannot open spill file " + path);
+  }
+  std::vector<Bytef> block(compressBound(kSpillBlockSize));
+  for (size_t start = 0; start < size;) {
+    uint64_t raw_size;
+    uint64_t comp_size;
+    in.read(reinterpret_cast<char*>(&raw_size), sizeof(raw_size));
+    in.read(reinterpret_cast<char*>(&comp_size), sizeof(comp_size));
+    if (!in || raw_size > size - start || comp_size > block.size()) {
+      throw std::runtime_error("Corrupted spill file " + path);
+    }
+    in.read(reinterpret_cast<char*>(block.data()), comp_size);
+    uLongf res_size = raw_size;
+    if (!in ||
+        uncompress(
+            reinterpret_cast<Bytef*>(buf + start), &res_size, block.data(), comp_size) !=
+            Z_OK ||
+        res_size != raw_size) {
+      throw std::runtime_error("Corrupted spill file " + path);
+    }
+    start += raw_size;
+  }
+}
+
 }  // namespace
 
 ResultSetRegistry::ResultSetRegistry(ConfigPtr config)
@@ -109,9 +182,11 @@ ResultSetTableTokenPtr ResultSetRegistry::put(ResultSetTable table) {
   // Add schema information for the ResultSet.
   auto tinfo = addTableInfo(db_id_, table_id, table_name, false, table.size(), 0);
   auto& first_rs = table.result(0);
+  auto table_data = std::make_unique<TableData>();
   bool has_varlen = false;
   bool has_array = false;
   for (size_t col_idx = 0; col_idx < first_rs->colCount(); ++col_idx) {
+    table_data->col_types.push_back(first_rs->colType(col_idx));
     addColumnInfo(db_id_,
                   table_id,
                   columnId(col_idx),
@@ -125,7 +200,6 @@ ResultSetTableTokenPtr ResultSetRegistry::put(ResultSetTable table) {
 
   // TODO: lazily compute row count and try to avoid global write
   // locks for that
-  auto table_data = std::make_unique<TableData>();
   size_t row_count = 0;
   for (auto& rs : table.results()) {
     DataFragment frag;
@@ -149,9 +223,35 @@ ResultSetTableTokenPtr ResultSetRegistry::put(ResultSetTable table) {
       !first_rs->isDirectColumnarConversionPossible() ||
       first_rs->getQueryDescriptionType() != QueryDescriptionType::Projection ||
       first_rs->areAnyColumnsLazyFetched() || has_varlen || has_array;
+  if (table_data->use_columnar_res && config_->rs.enable_lazy_columnarization) {
+    for (auto& frag : table_data->fragments) {
+      if (ColumnarResults::isPerColumnConversionPossible(*frag.rs, *config_)) {
+        frag.lazy_columnarization = true;
+        frag.column_res.resize(frag.rs->colCount());
+        frag.column_res_once = std::make_unique<std::once_flag[]>(frag.rs->colCount());
+      }
+    }
+  }
+
+  if (config_->rs.registry_memory_limit && !table_data->use_columnar_res) {
+    std::lock_guard<std::mutex> spill_lock(spill_mutex_);
+    for (auto& frag : table_data->fragments) {
+      if (isSpillable(*frag.rs)) {
+        frag.mem_size =
+            frag.rs->getQueryMemDesc().getBufferSizeBytes(ExecutorDeviceType::CPU);
+        frag.lru_it = lru_.insert(lru_.begin(), &frag);
+        frag.in_lru = true;
+        used_bytes_ += frag.mem_size;
+      }
+    }
+  }
 
   tables_[table_id] = std::move(table_data);
 
+  data_lock.unlock();
+  schema_lock.unlock();
+  evictIfNeeded();
+
   return std::make_shared<ResultSetTableToken>(tinfo, row_count, shared_from_this());
 }
 
@@ -161,7 +261,7 @@ ResultSetPtr ResultSetRegistry::get(const ResultSetTableToken& token, size_t idx
   auto* table = tables_.at(token.tableId()).get();
   mapd_shared_lock<mapd_shared_mutex> table_lock(table->mutex);
   CHECK_LT(idx, table->fragments.size());
-  return table->fragments[idx].rs;
+  return fragmentResult(table->fragments[idx]);
 }
 
 void ResultSetRegistry::drop(const ResultSetTableToken& token) {
@@ -173,6 +273,16 @@ void ResultSetRegistry::drop(const ResultSetTableToken& token) {
   mapd_unique_lock<mapd_shared_mutex> table_lock(table->mutex);
   tables_.erase(token.tableId());
 
+  {
+    std::lock_guard<std::mutex> spill_lock(spill_mutex_);
+    for (auto& frag : table->fragments) {
+      if (frag.in_lru) {
+        lru_.erase(frag.lru_it);
+        used_bytes_ -= frag.mem_size;
+      }
+    }
+  }
+
   SimpleSchemaProvider::dropTable(token.dbId(), token.tableId());
 }
 
@@ -189,7 +299,7 @@ ResultSetTableTokenPtr ResultSetRegistry::head(const ResultSetTableToken& token,
 
   std::vector<ResultSetPtr> new_results;
   if (!n) {
-    auto* first_rs = table->fragments.front().rs.get();
+    auto first_rs = fragmentResult(table->fragments.front());
     new_results.emplace_back(new ResultSet(first_rs->getTargetInfos(),
                                            ExecutorDeviceType::CPU,
                                            first_rs->getQueryMemDesc(),
@@ -201,10 +311,10 @@ ResultSetTableTokenPtr ResultSetRegistry::head(const ResultSetTableToken& token,
     size_t remained_rows = n;
     for (auto& frag : table->fragments) {
       if (frag.row_count < remained_rows) {
-        new_results.push_back(frag.rs);
+        new_results.push_back(fragmentResult(frag));
         remained_rows -= frag.row_count;
       } else {
-        auto copy = frag.rs->shallowCopy();
+        auto copy = fragmentResult(frag)->shallowCopy();
         copy->keepFirstN(remained_rows);
         new_results.push_back(copy);
         break;
@@ -231,7 +341,7 @@ ResultSetTableTokenPtr ResultSetRegistry::tail(const ResultSetTableToken& token,
 
   std::vector<ResultSetPtr> new_results;
   if (!n) {
-    auto* first_rs = table->fragments.front().rs.get();
+    auto first_rs = fragmentResult(table->fragments.front());
     new_results.emplace_back(new ResultSet(first_rs->getTargetInfos(),
                                            ExecutorDeviceType::CPU,
                                            first_rs->getQueryMemDesc(),
@@ -244,10 +354,10 @@ ResultSetTableTokenPtr ResultSetRegistry::tail(const ResultSetTableToken& token,
     for (auto frag_it = table->fragments.rbegin(); frag_it != table->fragments.rend();
          ++frag_it) {
       if (frag_it->row_count < remained_rows) {
-        new_results.push_back(frag_it->rs);
+        new_results.push_back(fragmentResult(*frag_it));
         remained_rows -= frag_it->row_count;
       } else {
-        auto copy = frag_it->rs->shallowCopy();
+        auto copy = fragmentResult(*frag_it)->shallowCopy();
         copy->dropFirstN(frag_it->row_count - remained_rows + copy->getOffset());
         copy->keepFirstN(remained_rows);
         new_results.push_back(copy);
@@ -262,6 +372,71 @@ ResultSetTableTokenPtr ResultSetRegistry::tail(const ResultSetTableToken& token,
   return put({std::move(new_results)});
 }
 
+ResultSetTableTokenPtr ResultSetRegistry::sample(const ResultSetTableToken& token,
+                                                 size_t n,
+                                                 uint64_t seed) {
+  mapd_shared_lock<mapd_shared_mutex> data_lock(data_mutex_);
+  CHECK(tables_.count(token.tableId()));
+  auto* table = tables_.at(token.tableId()).get();
+  mapd_shared_lock<mapd_shared_mutex> table_lock(table->mutex);
+
+  if (table->row_count <= n) {
+    return token.shared_from_this();
+  }
+
+  std::vector<ResultSetPtr> new_results;
+  if (!n) {
+    auto first_rs = fragmentResult(table->fragments.front());
+    new_results.emplace_back(new ResultSet(first_rs->getTargetInfos(),
+                                           ExecutorDeviceType::CPU,
+                                           first_rs->getQueryMemDesc(),
+                                           first_rs->getRowSetMemOwner(),
+                                           first_rs->getDataManager(),
+                                           0,
+                                           0));
+  } else {
+    // Fragments are taken as a whole in a random order, so only a part of them is
+    // referenced by the sample. The last taken fragment contributes a random range
+    // of its rows. Taken fragments keep their original order.
+    std::vector<size_t> frag_ids(table->fragments.size());
+    std::iota(frag_ids.begin(), frag_ids.end(), 0);
+    std::mt19937_64 gen(seed);
+    std::shuffle(frag_ids.begin(), frag_ids.end(), gen);
+
+    std::map<size_t, ResultSetPtr> taken;
+    size_t remained_rows = n;
+    for (auto frag_id : frag_ids) {
+      auto& frag = table->fragments[frag_id];
+      if (!frag.row_count) {
+        continue;
+      }
+      if (frag.row_count <= remained_rows) {
+        taken.emplace(frag_id, fragmentResult(frag));
+        remained_rows -= frag.row_count;
+      } else {
+        std::uniform_int_distribution<size_t> start_dist(0,
+                                                         frag.row_count - remained_rows);
+        auto copy = fragmentResult(frag)->shallowCopy();
+        copy->dropFirstN(start_dist(gen) + copy->getOffset());
+        copy->keepFirstN(remained_rows);
+        taken.emplace(frag_id, copy);
+        remained_rows = 0;
+      }
+      if (!remained_rows) {
+        break;
+      }
+    }
+    for (auto& pr : taken) {
+      new_results.push_back(pr.second);
+    }
+  }
+
+  data_lock.unlock();
+  table_lock.unlock();
+
+  return put({std::move(new_results)});
+}
+
 ChunkStats ResultSetRegistry::getChunkStats(int table_id,
                                             size_t frag_idx,
                                             size_t col_idx) const {
@@ -275,9 +450,10 @@ ChunkStats ResultSetRegistry::getChunkStats(int table_id,
 
   if (frag.meta.empty()) {
     frag_read_lock.unlock();
+    auto rs = fragmentResult(frag);
     mapd_unique_lock<mapd_shared_mutex> frag_write_lock(*frag.mutex);
     if (frag.meta.empty()) {
-      frag.meta = synthesizeMetadata(frag.rs.get());
+      frag.meta = synthesizeMetadata(rs.get());
     }
   }
   CHECK(frag.meta.count(columnId(col_idx)));
@@ -297,7 +473,7 @@ void ResultSetRegistry::fetchBuffer(const ChunkKey& key,
   size_t col_idx = columnIndex(key[CHUNK_KEY_COLUMN_IDX]);
   size_t frag_idx = static_cast<size_t>(key[CHUNK_KEY_FRAGMENT_IDX] - 1);
   CHECK_LT(frag_idx, table.fragments.size());
-  auto& rs = table.fragments[frag_idx].rs;
+  auto rs = fragmentResult(table.fragments[frag_idx]);
   dest->reserve(num_bytes);
 
   CHECK(!table.use_columnar_res);
@@ -317,6 +493,7 @@ ResultSetRegistry::getZeroCopyBufferMemory(const ChunkKey& key, size_t num_bytes
   size_t frag_idx = static_cast<size_t>(key[CHUNK_KEY_FRAGMENT_IDX] - 1);
   CHECK_LT(frag_idx, table.fragments.size());
   auto& frag = table.fragments[frag_idx];
+  auto rs = fragmentResult(frag);
   const int8_t* buf = nullptr;
 
   // When ColumnarResults is used, we pretend it is a zero-copy fetch
@@ -325,45 +502,186 @@ ResultSetRegistry::getZeroCopyBufferMemory(const ChunkKey& key, size_t num_bytes
   // clean-up tokens we are not going to use in TemporaryTables of
   // RelAlgExecutor.
   if (table.use_columnar_res) {
-    mapd_shared_lock<mapd_shared_mutex> frag_read_lock(*frag.mutex);
-    if (frag.columnar_res) {
-      if (key.size() < 5 || key[CHUNK_KEY_VARLEN_IDX] == 1) {
-        buf = frag.columnar_res->getColumnBuffers()[col_idx];
-      } else {
-        buf = frag.columnar_res->getOffsetBuffers()[col_idx];
-      }
+    auto columnar_res = getColumnarResults(frag, col_idx);
+    if (key.size() < 5 || key[CHUNK_KEY_VARLEN_IDX] == 1) {
+      buf = columnar_res->getColumnBuffers()[col_idx];
     } else {
-      frag_read_lock.unlock();
-      mapd_unique_lock<mapd_shared_mutex> frag_write_lock(*frag.mutex);
-      if (!frag.columnar_res) {
-        std::vector<const hdk::ir::Type*> col_types;
-        for (size_t i = 0; i < frag.rs->colCount(); ++i) {
-          col_types.push_back(frag.rs->colType(i)->canonicalize());
-        }
-        frag.columnar_res =
-            std::make_unique<ColumnarResults>(frag.rs->getRowSetMemOwner(),
-                                              *frag.rs,
-                                              frag.rs->colCount(),
-                                              col_types,
-                                              0,
-                                              *config_);
-      }
-      if (key.size() < 5 || key[CHUNK_KEY_VARLEN_IDX] == 1) {
-        buf = frag.columnar_res->getColumnBuffers()[col_idx];
-      } else {
-        buf = frag.columnar_res->getOffsetBuffers()[col_idx];
-      }
+      buf = columnar_res->getOffsetBuffers()[col_idx];
     }
-  } else if (frag.rs->isZeroCopyColumnarConversionPossible(col_idx)) {
+  } else if (rs->isZeroCopyColumnarConversionPossible(col_idx)) {
     CHECK_EQ(key.size(), (size_t)4);
-    buf = frag.rs->getColumnarBuffer(col_idx);
+    buf = rs->getColumnarBuffer(col_idx);
   }
 
   return buf ? std::make_unique<ResultSetDataToken>(
-                   frag.rs, frag.rs->colType(col_idx), buf, num_bytes)
+                   rs, rs->colType(col_idx), buf, num_bytes)
              : nullptr;
 }
 
+const ColumnarResults* ResultSetRegistry::getColumnarResults(DataFragment& frag,
+                                                            size_t col_idx) const {
+  std::vector<const hdk::ir::Type*> col_types;
+  for (size_t i = 0; i < frag.rs->colCount(); ++i) {
+    col_types.push_back(frag.rs->colType(i)->canonicalize());
+  }
+
+  // Different columns are converted in parallel, each conversion is also
+  // parallelized over rows.
+  if (frag.lazy_columnarization) {
+    CHECK_LT(col_idx, frag.column_res.size());
+    std::call_once(frag.column_res_once[col_idx], [&]() {
+      std::vector<bool> columns_to_fetch(frag.rs->colCount(), false);
+      columns_to_fetch[col_idx] = true;
+      frag.column_res[col_idx] =
+          std::make_unique<ColumnarResults>(frag.rs->getRowSetMemOwner(),
+                                            *frag.rs,
+                                            frag.rs->colCount(),
+                                            col_types,
+                                            0,
+                                            *config_,
+                                            false,
+                                            columns_to_fetch);
+    });
+    return frag.column_res[col_idx].get();
+  }
+
+  mapd_shared_lock<mapd_shared_mutex> frag_read_lock(*frag.mutex);
+  if (frag.columnar_res) {
+    return frag.columnar_res.get();
+  }
+  frag_read_lock.unlock();
+  mapd_unique_lock<mapd_shared_mutex> frag_write_lock(*frag.mutex);
+  if (!frag.columnar_res) {
+    frag.columnar_res = std::make_unique<ColumnarResults>(frag.rs->getRowSetMemOwner(),
+                                                          *frag.rs,
+                                                          frag.rs->colCount(),
+                                                          col_types,
+                                                          0,
+                                                          *config_);
+  }
+  return frag.columnar_res.get();
+}
+
+ResultSetPtr ResultSetRegistry::fragmentResult(DataFragment& frag) const {
+  if (!frag.mem_size) {
+    return frag.rs;
+  }
+
+  {
+    mapd_shared_lock<mapd_shared_mutex> frag_read_lock(*frag.mutex);
+    if (frag.rs) {
+      std::lock_guard<std::mutex> spill_lock(spill_mutex_);
+      CHECK(frag.in_lru);
+      lru_.splice(lru_.begin(), lru_, frag.lru_it);
+      return frag.rs;
+    }
+  }
+
+  ResultSetPtr res;
+  {
+    mapd_unique_lock<mapd_shared_mutex> frag_write_lock(*frag.mutex);
+    if (!frag.rs) {
+      CHECK(frag.spilled);
+      frag.rs = loadSpilled(*frag.spilled);
+      std::lock_guard<std::mutex> spill_lock(spill_mutex_);
+      frag.lru_it = lru_.insert(lru_.begin(), &frag);
+      frag.in_lru = true;
+      used_bytes_ += frag.mem_size;
+    }
+    res = frag.rs;
+  }
+  evictIfNeeded();
+
+  return res;
+}
+
+void ResultSetRegistry::evictIfNeeded() const {
+  const auto limit = config_->rs.registry_memory_limit;
+  if (!limit) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> spill_lock(spill_mutex_);
+  auto it = lru_.end();
+  while (used_bytes_ > limit && it != lru_.begin()) {
+    auto* frag = *--it;
+    // Skip fragments being accessed. Try-lock also avoids a lock order inversion
+    // with fragmentResult() which locks the LRU list under the fragment lock.
+    mapd_unique_lock<mapd_shared_mutex> frag_lock(*frag->mutex, std::try_to_lock);
+    if (!frag_lock.owns_lock()) {
+      continue;
+    }
+    // Spill files are kept until the table is dropped, so a fragment evicted again
+    // is not written twice.
+    if (!frag->spilled) {
+      try {
+        frag->spilled = spill(*frag->rs);
+      } catch (const std::exception& e) {
+        LOG(WARNING) << "Cannot spill result set: " << e.what();
+        return;
+      }
+    }
+    frag->rs.reset();
+    frag->in_lru = false;
+    used_bytes_ -= frag->mem_size;
+    it = lru_.erase(it);
+  }
+}
+
+std::unique_ptr<ResultSetRegistry::SpilledResult> ResultSetRegistry::spill(
+    const ResultSet& rs) const {
+  auto timer = DEBUG_TIMER(__func__);
+  const auto& dir = config_->rs.registry_spill_dir;
+  auto res = std::make_unique<SpilledResult>();
+  res->path = ((dir.empty() ? boost::filesystem::temp_directory_path()
+                            : boost::filesystem::path(dir)) /
+               boost::filesystem::unique_path("hdk-rs-%%%%-%%%%-%%%%.spill"))
+                  .string();
+  res->buffer_size = rs.getQueryMemDesc().getBufferSizeBytes(ExecutorDeviceType::CPU);
+  writeCompressed(res->path, rs.getStorage()->getUnderlyingBuffer(), res->buffer_size);
+  res->targets = rs.getTargetInfos();
+  res->query_mem_desc = rs.getQueryMemDesc();
+  res->target_init_vals = rs.getTargetInitVals();
+  // Keep string dictionaries only, the memory of the result is released.
+  res->row_set_mem_owner = rs.getRowSetMemOwner()->cloneStrDictDataOnly();
+  res->data_mgr = rs.getDataManager();
+  for (size_t col_idx = 0; col_idx < rs.colCount(); ++col_idx) {
+    res->col_names.push_back(rs.colName(col_idx));
+  }
+  res->offset = rs.getOffset();
+  res->limit = rs.getLimit();
+  VLOG(1) << "Spilled result set of " << res->buffer_size << " bytes to " << res->path;
+  return res;
+}
+
+ResultSetPtr ResultSetRegistry::loadSpilled(SpilledResult& spilled) {
+  auto timer = DEBUG_TIMER(__func__);
+  // Memory of the restored result is owned by its own owner, so it is released
+  // on the next eviction.
+  auto row_set_mem_owner = spilled.row_set_mem_owner->cloneStrDictDataOnly();
+  auto res = std::make_shared<ResultSet>(spilled.targets,
+                                         ExecutorDeviceType::CPU,
+                                         spilled.query_mem_desc,
+                                         row_set_mem_owner,
+                                         spilled.data_mgr,
+                                         0,
+                                         0);
+  auto storage = res->allocateStorage(spilled.target_init_vals);
+  readCompressed(spilled.path, storage->getUnderlyingBuffer(), spilled.buffer_size);
+  res->setColNames(spilled.col_names);
+  res->dropFirstN(spilled.offset);
+  res->keepFirstN(spilled.limit);
+  return res;
+}
+
+ResultSetRegistry::SpilledResult::~SpilledResult() {
+  boost::system::error_code ec;
+  boost::filesystem::remove(path, ec);
+  if (ec) {
+    LOG(WARNING) << "Cannot remove spill file " << path << ": " << ec.message();
+  }
+}
+
 TableFragmentsInfo ResultSetRegistry::getTableMetadata(int db_id, int table_id) const {
   mapd_shared_lock<mapd_shared_mutex> data_lock(data_mutex_);
   CHECK_EQ(db_id, db_id_);
@@ -398,12 +716,12 @@ TableFragmentsInfo ResultSetRegistry::getTableMetadata(int db_id, int table_id)
         CHECK(!frag.meta.empty());
         frag_info.setChunkMetadataMap(frag.meta);
       } else {
-        for (size_t col_idx = 0; col_idx < (size_t)frag.rs->colCount(); ++col_idx) {
-          auto col_type = frag.rs->colType(col_idx);
+        for (size_t col_idx = 0; col_idx < table.col_types.size(); ++col_idx) {
+          auto col_type = table.col_types[col_idx];
           auto meta = std::make_shared<ChunkMetadata>(
               col_type,
-              frag.rs->rowCount() * col_type->size(),
-              frag.rs->rowCount(),
+              frag.row_count * col_type->size(),
+              frag.row_count,
               [this, table_id, frag_idx, col_idx](ChunkStats& stats) {
                 stats = this->getChunkStats(table_id, frag_idx, col_idx);
               });
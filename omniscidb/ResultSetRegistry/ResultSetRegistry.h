@@ -16,6 +16,9 @@
 #include "Shared/Config.h"
 #include "Shared/mapd_shared_mutex.h"
 
+#include <list>
+#include <mutex>
+
 namespace Data_Namespace {
 class DataMgr;
 }
@@ -41,6 +44,10 @@ class ResultSetRegistry : public SimpleSchemaProvider,
 
   ResultSetTableTokenPtr head(const ResultSetTableToken& token, size_t n);
   ResultSetTableTokenPtr tail(const ResultSetTableToken& token, size_t n);
+  // Random sample of n rows built from randomly chosen fragments.
+  ResultSetTableTokenPtr sample(const ResultSetTableToken& token,
+                                size_t n,
+                                uint64_t seed);
 
   void fetchBuffer(const ChunkKey& key,
                    Data_Namespace::AbstractBuffer* dest,
@@ -56,14 +63,47 @@ class ResultSetRegistry : public SimpleSchemaProvider,
 
   std::vector<int> listDatabases() const override { return {{DB_ID}}; }
 
+  // Result set tables get unique names which are never reused, so putting and
+  // dropping them cannot change the meaning of previously parsed queries.
+  uint64_t getVersion() const override { return fixed_version_; }
+
  private:
   ChunkStats getChunkStats(int table_id, size_t frag_idx, size_t col_idx) const;
 
+  // Result set evicted from memory. Its storage buffer is kept in a compressed file,
+  // the rest of the state required to restore it is kept here.
+  struct SpilledResult {
+    ~SpilledResult();
+
+    std::string path;
+    size_t buffer_size;
+    std::vector<TargetInfo> targets;
+    QueryMemoryDescriptor query_mem_desc;
+    std::vector<int64_t> target_init_vals;
+    std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner;
+    Data_Namespace::DataMgr* data_mgr;
+    std::vector<std::string> col_names;
+    size_t offset;
+    size_t limit;
+  };
+
   struct DataFragment {
     size_t offset = 0;
     size_t row_count = 0;
+    // Null while the fragment is spilled, use fragmentResult() to access it.
     ResultSetPtr rs;
+    // Memory accounted for the registry memory limit. Zero for fragments which
+    // cannot be spilled, they are never evicted.
+    size_t mem_size = 0;
+    std::unique_ptr<SpilledResult> spilled;
+    bool in_lru = false;
+    std::list<DataFragment*>::iterator lru_it;
     std::unique_ptr<ColumnarResults> columnar_res;
+    // Used instead of columnar_res when columns are converted on demand. Each column
+    // is converted once by a ColumnarResults holding this column only.
+    bool lazy_columnarization = false;
+    std::vector<std::unique_ptr<ColumnarResults>> column_res;
+    std::unique_ptr<std::once_flag[]> column_res_once;
     std::unique_ptr<mapd_shared_mutex> mutex;
     ChunkMetadataMap meta;
   };
@@ -72,16 +112,33 @@ class ResultSetRegistry : public SimpleSchemaProvider,
     mapd_shared_mutex mutex;
     std::vector<DataFragment> fragments;
     size_t row_count;
+    std::vector<const hdk::ir::Type*> col_types;
     bool use_columnar_res;
     bool has_varlen_col;
   };
 
+  // Converts and returns columnar data holding the column of the fragment.
+  const ColumnarResults* getColumnarResults(DataFragment& frag, size_t col_idx) const;
+
+  // Returns the fragment result set, reloads it if it was spilled.
+  ResultSetPtr fragmentResult(DataFragment& frag) const;
+  // Spills least recently used fragments until the memory limit is met.
+  void evictIfNeeded() const;
+  std::unique_ptr<SpilledResult> spill(const ResultSet& rs) const;
+  static ResultSetPtr loadSpilled(SpilledResult& spilled);
+
   const int db_id_;
   const int schema_id_;
   int next_table_id_ = 1;
   std::unordered_map<int, std::unique_ptr<TableData>> tables_;
   const ConfigPtr config_;
+  const uint64_t fixed_version_ = nextVersion();
   mutable mapd_shared_mutex data_mutex_;
+  // Spillable fragments held in memory, the most recently used first. Protected by
+  // spill_mutex_ along with the in_lru and lru_it fields of fragments.
+  mutable std::list<DataFragment*> lru_;
+  mutable size_t used_bytes_ = 0;
+  mutable std::mutex spill_mutex_;
 };
 
 }  // namespace hdk
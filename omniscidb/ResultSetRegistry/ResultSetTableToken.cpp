@@ -43,4 +43,8 @@ ResultSetTableTokenPtr ResultSetTableToken::tail(size_t n) const {
   return registry_->tail(*this, n);
 }
 
+ResultSetTableTokenPtr ResultSetTableToken::sample(size_t n, uint64_t seed) const {
+  return registry_->sample(*this, n, seed);
+}
+
 }  // namespace hdk
@@ -54,6 +54,7 @@ class ResultSetTableToken : public std::enable_shared_from_this<ResultSetTableTo
 
   ResultSetTableTokenPtr head(size_t n) const;
   ResultSetTableTokenPtr tail(size_t n) const;
+  ResultSetTableTokenPtr sample(size_t n, uint64_t seed) const;
 
   std::string toString() const {
     return "ResultSetTableToken(" + std::to_string(dbId()) + ":" +
@@ -63,6 +63,14 @@ ColumnInfoPtr SchemaMgr::getColumnInfo(int db_id,
   return nullptr;
 }
 
+uint64_t SchemaMgr::getVersion() const {
+  uint64_t res = 0;
+  for (auto& pr : mgr_by_schema_id_) {
+    res = std::max(res, pr.second->getVersion());
+  }
+  return res;
+}
+
 void SchemaMgr::registerProvider(int schema_id, SchemaProviderPtr schema_provider) {
   CHECK_GE(schema_id, MIN_SCHEMA_ID);
   CHECK_LE(schema_id, MAX_SCHEMA_ID);
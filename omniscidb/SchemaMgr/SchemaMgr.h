@@ -29,6 +29,8 @@ class SchemaMgr : public SchemaProvider {
                               int table_id,
                               const std::string& col_name) const override;
 
+  uint64_t getVersion() const override;
+
   void registerProvider(int schema_id, SchemaProviderPtr schema_provider);
 
  protected:
@@ -78,6 +78,11 @@ class SchemaProvider {
   ColumnInfoPtr getColumnInfo(const ColumnRef& cref) const {
     return getColumnInfo(cref.db_id, cref.table_id, cref.column_id);
   }
+
+  // Changes each time a table is created or dropped. Used to invalidate data
+  // derived from the schema, e.g. cached query plans. Zero means the provider
+  // doesn't track its changes and such data shouldn't be cached.
+  virtual uint64_t getVersion() const { return 0; }
 };
 
 using SchemaProviderPtr = std::shared_ptr<SchemaProvider>;
@@ -19,6 +19,8 @@
 
 #include "Shared/mapd_shared_mutex.h"
 
+#include <atomic>
+
 class SimpleSchemaProvider : public SchemaProvider {
  public:
   SimpleSchemaProvider(hdk::ir::Context& ctx, int id, const std::string& name)
@@ -96,7 +98,16 @@ class SimpleSchemaProvider : public SchemaProvider {
 
   using SchemaProvider::getColumnInfo;
 
+  uint64_t getVersion() const override { return version_; }
+
  protected:
+  // Versions are unique across all providers, so a version of a composite
+  // provider can be computed as a maximum of its components' versions.
+  static uint64_t nextVersion() {
+    static std::atomic<uint64_t> last_version{0};
+    return ++last_version;
+  }
+
   TableInfoPtr getTableInfoNoLock(int db_id, int table_id) const {
     auto it = table_infos_.find({db_id, table_id});
     if (it != table_infos_.end()) {
@@ -135,6 +146,7 @@ class SimpleSchemaProvider : public SchemaProvider {
   }
 
   TableInfoPtr addTableInfo(TableInfoPtr table_info) {
+    version_ = nextVersion();
     table_infos_[*table_info] = table_info;
     table_index_by_name_[table_info->db_id][table_info->name] = table_info;
     return table_info;
@@ -166,6 +178,7 @@ class SimpleSchemaProvider : public SchemaProvider {
     auto tinfo = getTableInfoNoLock(db_id, table_id);
     CHECK(tinfo);
     auto col_infos = listColumnsNoLock(*tinfo);
+    version_ = nextVersion();
     table_infos_.erase(*tinfo);
     table_index_by_name_.at(db_id).erase(tinfo->name);
     for (auto& col_info : col_infos) {
@@ -184,5 +197,6 @@ class SimpleSchemaProvider : public SchemaProvider {
   std::unordered_map<int, TableByNameMap> table_index_by_name_;
   ColumnInfoMap column_infos_;
   std::unordered_map<TableRef, ColumnByNameMap> column_index_by_name_;
+  std::atomic<uint64_t> version_{nextVersion()};
   mutable mapd_shared_mutex schema_mutex_;
 };
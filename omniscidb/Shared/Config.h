@@ -28,6 +28,9 @@ struct WatchdogConfig {
 struct CpuSubTasksConfig {
   bool enable = false;
   size_t sub_task_size = 500'000;
+  // Sub-task size is reduced down to this value when there are not enough
+  // sub-tasks to keep all CPU threads busy.
+  size_t min_sub_task_size = 16'384;
 };
 
 struct JoinConfig {
@@ -35,6 +38,20 @@ struct JoinConfig {
   unsigned trivial_loop_join_threshold = 1'000;
   size_t huge_join_hash_threshold = 1'000'000;
   size_t huge_join_hash_min_load = 10;
+  // Use the number of distinct inner keys from column statistics instead of the
+  // number of inner rows to check the load of huge perfect join hash tables.
+  bool enable_join_hash_ndv_load = true;
+  size_t partitioned_hash_build_threshold = 10'000'000;
+  bool enable_sort_join = false;
+  // Build sorted join tables keyed on string hashes for joins on none-encoded strings.
+  bool enable_string_join = true;
+  bool enable_range_join = false;
+  // Let CPU loop joins select inner rows matching a comparison with the outer row by a
+  // blocked scan of the inner column, and iterate over the selected rows only.
+  bool enable_loop_join_scan = true;
+  bool enable_crc32_key_hash = true;
+  size_t hash_table_prefetch_threshold = 32 * 1024 * 1024;
+  bool enable_compact_join_keys = true;
 };
 
 struct GroupByConfig {
@@ -45,11 +62,36 @@ struct GroupByConfig {
   bool enable_gpu_smem_group_by = true;
   bool enable_gpu_smem_non_grouped_agg = true;
   bool enable_gpu_smem_grouped_non_count_agg = true;
-  size_t gpu_smem_threshold = 4096;
+  size_t gpu_smem_threshold = 16384;
   unsigned hll_precision_bits = 11;
   size_t baseline_threshold = 1'000'000;
   int64_t large_ndv_threshold = 10'000'000;
   size_t large_ndv_multiplier = 256;
+  bool enable_column_stats_ndv = true;
+  bool enable_partitioned_reduction = true;
+  size_t partitioned_reduction_threshold = 100'000;
+  bool enable_streaming_reduction = false;
+  bool enable_partitioned_aggregation = false;
+  size_t partitioned_aggregation_max_groups = 50'000'000;
+  bool enable_roaring_count_distinct = true;
+  int64_t roaring_count_distinct_bitmap_bits_threshold = 1LL << 30;
+  bool enable_sparse_hll = true;
+  // Number of times a GPU baseline hash group by which ran out of slots is re-run on
+  // GPU with a doubled buffer before falling back to the regular retry. Zero disables
+  // the growth.
+  size_t gpu_groupby_buffer_max_growths = 4;
+  // Size group-by buffers by the number of groups produced by previous executions of
+  // the same step over the same input sizes. Uses the estimator result cache.
+  bool enable_group_count_history = true;
+  // Choose between perfect and baseline hash layouts by comparing their costs when
+  // column statistics provide the number of distinct values of group by columns.
+  bool enable_cost_based_hash_layout = true;
+  // Cost of aggregating an input row with baseline hash relative to perfect hash,
+  // which is also the cost of initializing and reducing one buffer entry.
+  double baseline_hash_row_cost = 3.0;
+  // Use 4-byte output slots for MIN and MAX over integers whose value range fits into
+  // 32 bits, so that they don't prevent compaction of COUNT and key slots.
+  bool enable_range_based_slot_compaction = true;
 };
 
 struct WindowFunctionsConfig {
@@ -58,6 +100,11 @@ struct WindowFunctionsConfig {
   size_t parallel_window_partition_compute_threshold = 4096;
   bool parallel_window_partition_sort = true;
   size_t parallel_window_partition_sort_threshold = 1024;
+  bool gpu_partition_sort = true;
+  size_t gpu_partition_sort_threshold = 1000000;
+  // Order only the top rows of partitions for ROW_NUMBER and RANK filtered by
+  // top-N-per-group conditions like rn <= N.
+  bool enable_partition_limits = true;
 };
 
 struct HeterogenousConfig {
@@ -68,12 +115,46 @@ struct HeterogenousConfig {
   unsigned forced_gpu_proportion = 0;
   bool allow_cpu_retry = true;
   bool allow_query_step_cpu_retry = true;
+  // When GPU kernels run out of memory, re-execute only them on CPU and merge their
+  // results with the results of successful GPU kernels instead of retrying the whole
+  // step on CPU. Requires allow_cpu_retry.
+  bool allow_kernel_cpu_retry = true;
+  // Let CPU and GPU workers steal kernels assigned to other devices when they run
+  // out of their own kernels.
+  bool enable_work_stealing = false;
 };
 
 struct InterruptConfig {
   bool enable_runtime_query_interrupt = false;
   bool enable_non_kernel_time_query_interrupt = true;
   double running_query_interrupt_freq = 0.5;
+  // Number of rows processed by a CPU kernel between interrupt and dynamic watchdog
+  // checks. Rounded down to a power of two. Kernels and sub-tasks are also checked
+  // before launch, so the interval bounds the reaction time within a fragment.
+  size_t cpu_check_interval = 65536;
+};
+
+struct QuerySchedulerConfig {
+  // Max number of queries running kernels on a single device at the same time. Zero
+  // means no limit. CPU kernels of concurrent queries share the thread pool, so CPU
+  // queries are not limited by default.
+  size_t max_cpu_queries = 0;
+  size_t max_gpu_queries = 1;
+  // Max total output buffer memory reserved by running queries on a single device.
+  // Zero means no limit.
+  size_t cpu_memory_budget = 0;
+  size_t gpu_memory_budget = 0;
+  // Make concurrent queries over the same table process its fragments in the same
+  // order, starting from the fragment processed by already running queries. When no
+  // query scans the table, the first one waits for shared_scan_window_ms to collect
+  // other queries into a batch.
+  bool enable_shared_scans = false;
+  size_t shared_scan_window_ms = 0;
+  // Let a query waiting for a slot on a device preempt a running query of lower
+  // priority. The preempted query finishes its running kernels and sub-tasks, gives its
+  // slot up and resumes the rest when admitted again. Only matters when the number of
+  // queries on the device is limited.
+  bool enable_preemption = false;
 };
 
 struct CodegenConfig {
@@ -82,6 +163,33 @@ struct CodegenConfig {
   bool null_mod_by_zero = false;
   bool hoist_literals = true;
   bool enable_filter_function = true;
+  bool enable_async_reduction_compilation = false;
+  bool enable_tiered_compilation = false;
+  size_t tiered_compilation_hot_threshold = 3;
+  bool enable_parallel_step_compilation = false;
+  bool enable_loop_vectorization = false;
+  bool enable_common_subexpr_elimination = true;
+  // Generate CASE with cheap side-effect free branches as a chain of selects, and CASE
+  // over a column compared with integer constants as a switch.
+  bool enable_branchless_case = true;
+  // Compile REGEXP patterns over none-encoded strings once per query, and match
+  // OR'ed patterns on the same string in one pass.
+  bool enable_precompiled_regexp = true;
+  // Generate filters over columns, which have no nulls in any fragment of the table
+  // according to chunk statistics, without null checks.
+  bool enable_stats_null_check_elimination = false;
+  bool enable_jit_profiling = false;
+  bool enable_expression_counters = false;
+  // Max number of days in the range of a date for which calendar EXTRACT and
+  // DATE_TRUNC are computed through a per-query lookup table. 0 disables tables.
+  size_t date_lookup_table_max_days = 16384;
+  // Max number of entries in a dictionary for which LOWER over dictionary-encoded
+  // strings is computed for all entries at once when a CPU kernel is compiled. Strings
+  // of bigger dictionaries are lowered per row. GPU kernels always lower all entries.
+  size_t lower_translation_max_dict_size = 1'000'000;
+  // Call extension functions, which have a registered batch implementation, once per
+  // batch of rows in CPU kernels instead of once per row.
+  bool enable_batch_ext_funcs = true;
 };
 
 struct ExecutionConfig {
@@ -92,23 +200,76 @@ struct ExecutionConfig {
   WindowFunctionsConfig window_func;
   HeterogenousConfig heterogeneous;
   InterruptConfig interrupt;
+  QuerySchedulerConfig scheduler;
   CodegenConfig codegen;
 
   size_t streaming_topn_max = 100'000;
+  // Max top-N for streaming sort in CPU kernels which use a single heap per kernel.
+  size_t cpu_streaming_topn_max = 1'000'000;
   size_t parallel_top_min = 100'000;
   bool enable_experimental_string_functions = false;
   bool enable_interop = false;
   size_t parallel_linearization_threshold = 10'000;
-  bool enable_multifrag_rs = false;
+  // Keep linearized multi-fragment columns in the buffer pool after the query, so
+  // following queries reuse them until they are evicted or the table changes.
+  bool enable_linearized_column_cache = true;
+  // Keep per-kernel results of intermediate steps as separate fragments of the result
+  // table, so the following steps process them in parallel and skip fragments by their
+  // stats.
+  bool enable_multifrag_rs = true;
 
   size_t override_gpu_block_size = 0;
   size_t override_gpu_grid_size = 0;
   bool cpu_only = false;
+  // Copy input chunks of a GPU kernel while a previous kernel is running on the
+  // same device. Host-to-device copies use dedicated streams (queues for L0).
+  bool enable_gpu_transfer_overlap = false;
+  // Use each tile of a multi-tile Intel GPU as a separate device with its own
+  // buffer pool and fragments.
+  bool enable_l0_sub_devices = true;
+  // Transfer integer columns of the outer table to GPU using frame-of-reference
+  // encoding with a narrower width and decode them in the kernel.
+  bool enable_gpu_compressed_transfer = false;
+  // Read integer columns of the outer table in CPU kernels from frame-of-reference
+  // encoded copies kept in the CPU buffer pool.
+  bool enable_cpu_compressed_columns = false;
+  // Always run a fragment on the same GPU, chosen by the fragment id, when several
+  // GPUs are present.
+  bool enable_gpu_fragment_affinity = true;
+  // Try a few grid sizes on first GPU launches of a non-grouped aggregate kernel
+  // and keep the fastest one next to the cached code.
+  bool enable_gpu_launch_autotuning = false;
+  // Run fragments, for which chunk statistics prove some simple quals true for all
+  // rows, with a kernel compiled without those quals.
+  bool enable_fragment_qual_elimination = false;
 
   bool materialize_inner_join_tables = true;
   std::string initialize_with_gpu_vendor = "";
 
   bool enable_cost_model = false;
+  // Calibrate the cost model using measurements of executed kernels instead of
+  // micro-benchmarks.
+  bool enable_cost_model_runtime_measurements = false;
+
+  // Max number of CPU threads used by a single query, zero means no limit.
+  unsigned cpu_threads_per_query = 0;
+
+  // Skip remaining fragments of a LIMIT query with no ORDER BY once preceding
+  // fragments have produced enough rows.
+  bool enable_limit_early_termination = true;
+
+  // Number of threads parsing SQL queries, each with its own Calcite planner.
+  size_t calcite_workers = 1;
+
+  // Lower simple single table queries to QueryBuilder nodes without Calcite.
+  bool enable_native_sql_parser = false;
+
+  // Allow starting Calcite for SQL queries. Otherwise, only QueryBuilder queries
+  // and SQL queries handled by the native parser are supported.
+  bool enable_calcite = true;
+
+  // Collect execution profiles of queries by default.
+  bool enable_query_profile = false;
 };
 
 struct FilterPushdownConfig {
@@ -121,15 +282,47 @@ struct FilterPushdownConfig {
 struct OptimizationsConfig {
   FilterPushdownConfig filter_pushdown;
   bool from_table_reordering = true;
+  bool enable_join_selectivity_reordering = true;
+  bool enable_filter_reordering = true;
   size_t constrained_by_in_threshold = 10;
   bool enable_left_join_filter_hoisting = true;
+  bool skip_fragments_by_join_key_range = true;
+  bool skip_fragments_by_dict_string_stats = true;
 };
 
 struct ResultSetConfig {
   bool enable_columnar_output = false;
+  // Use columnar output for projections consumed by the following query steps, so
+  // they can fetch it with no conversion.
+  bool enable_columnar_intermediate_results = true;
   bool optimize_row_initialization = true;
+  // Initialize rows of sparse single column perfect hash group by buffers on the
+  // first touch instead of before the kernel run. An occupancy bitmap tracks the
+  // touched rows, so reductions skip untouched ones. Applies to CPU buffers with at
+  // least lazy_group_init_threshold entries.
+  bool enable_lazy_group_init = true;
+  size_t lazy_group_init_threshold = 1000000;
   bool enable_direct_columnarization = true;
+  // Convert columns of intermediate results on the first fetch of each column rather
+  // than all columns at once.
+  bool enable_lazy_columnarization = true;
   bool enable_lazy_fetch = true;
+  // Sort results by integer and dictionary keys using a radix sort on concatenated
+  // normalized keys instead of a comparison sort.
+  bool enable_radix_sort = true;
+  // Max working memory in bytes of a radix sort of results. Larger sorts are done by
+  // sorted runs spilled to external_sort_dir (temporary directory if empty). Zero
+  // means no limit.
+  size_t external_sort_threshold = 0;
+  std::string external_sort_dir = "";
+  // Keep columnar projection results of GPU queries in device memory in addition to
+  // the host copy, so they can be passed to GPU libraries with no host round trip.
+  bool keep_gpu_results = false;
+  // Max memory in bytes of results held by the result set registry. Least recently
+  // used results above the limit are spilled to compressed files in registry_spill_dir
+  // (temporary directory if empty) and are reloaded on access. Zero means no limit.
+  size_t registry_memory_limit = 0;
+  std::string registry_spill_dir = "";
 };
 
 struct GpuMemoryConfig {
@@ -140,11 +333,37 @@ struct GpuMemoryConfig {
   size_t max_size = 0;
   size_t min_slab_size = 256ULL << 20;
   size_t max_slab_size = 4ULL << 30;
+  // Evict GPU buffers by access frequency and transfer cost instead of recency.
+  bool enable_cost_aware_eviction = false;
+  // Comma-separated names of tables which should stay in GPU memory. Used by the
+  // cost-aware eviction only.
+  std::string resident_tables = "";
+  // On devices sharing physical memory with the host, let kernels read storage
+  // buffers in place instead of copying them into the GPU buffer pool.
+  bool enable_unified_memory_zero_copy = false;
+  // Per-device amount of GPU scratch memory kept by Thrust allocators between sorts
+  // and queries. Zero disables caching.
+  size_t thrust_scratch_pool_size = 256ULL << 20;
 };
 
 struct CpuMemoryConfig {
   bool enable_tiered_cpu_mem = false;
+  // Spread CPU buffer pool slabs over NUMA nodes in a round-robin fashion.
+  bool enable_numa_aware_slabs = false;
+  // Amount of CPU buffer pool slabs allocated in page-locked memory to speed up
+  // transfers to GPU. Zero disables pinned slabs.
+  size_t pinned_slabs_size = 0;
+  // Back CPU buffer pool slabs with transparent huge pages.
+  bool enable_huge_pages = false;
+  // Amount of the CPU buffer pool to allocate and touch at startup to avoid page
+  // faults during the first queries.
+  size_t prefault_size = 0;
   size_t pmem_size = 0;
+  // Period of the background migration of hot chunks from PMEM to DRAM in tiered
+  // CPU memory. Zero disables migration.
+  size_t tier_migration_interval_ms = 0;
+  // Maximum amount of data moved between tiers by a single migration round.
+  size_t tier_migration_max_bytes = 256ULL << 20;
   size_t max_size = 0;
   size_t min_slab_size = 256ULL << 20;
   size_t max_slab_size = 4ULL << 30;
@@ -161,14 +380,31 @@ struct CacheConfig {
   bool use_hashtable_cache = true;
   size_t hashtable_cache_total_bytes = 1ULL << 32;
   size_t max_cacheable_hashtable_size_bytes = 1ULL << 31;
+  bool use_result_set_cache = false;
+  bool use_incremental_result_set_cache = false;
+  // Use results of query DAG nodes computed by previous queries as inputs, while
+  // their input tables are not modified.
+  bool reuse_node_results = true;
+  // Reuse column ranges computed by previous queries and update them incrementally
+  // when data is appended to tables.
+  bool reuse_col_ranges = true;
+  size_t result_set_cache_total_bytes = 1ULL << 32;
+  size_t max_cacheable_result_set_size_bytes = 1ULL << 31;
   double gpu_fraction_code_cache_to_evict = 0.2;
+  size_t gpu_code_cache_max_bytes = 256ULL << 20;
   size_t dag_cache_size = 1'000'000'000;
   size_t code_cache_size = 1'000;
+  bool enable_rel_alg_cache = true;
+  size_t rel_alg_cache_size = 1'000;
+  std::string persistent_code_cache_dir = "";
+  std::string cost_model_calibration_file = "";
 };
 
 struct DebugConfig {
   std::string build_ra_cache = "";
   std::string use_ra_cache = "";
+  // File to record executed SQL queries with their timings for later replay.
+  std::string workload_capture_file = "";
   bool enable_automatic_ir_metadata = true;
 };
 
@@ -179,6 +415,9 @@ struct Config {
   MemoryConfig mem;
   CacheConfig cache;
   DebugConfig debug;
+  // Derive hardware dependent options which are not set explicitly from the
+  // detected host hardware.
+  bool enable_auto_config = false;
 };
 
 using ConfigPtr = std::shared_ptr<Config>;
@@ -127,6 +127,85 @@ std::optional<int64_t> unixTime(std::string_view const str) {
   return is_valid ? std::make_optional(time) : std::nullopt;
 }
 
+// Number written by len digits at pos of str, nullopt if any of them is not a digit.
+std::optional<unsigned> fixedDigits(std::string_view const str,
+                                    size_t const pos,
+                                    size_t const len) {
+  unsigned val{0};
+  for (size_t i = pos; i < pos + len; ++i) {
+    unsigned const digit = static_cast<unsigned char>(str[i]) - '0';
+    if (digit > 9) {
+      return std::nullopt;
+    }
+    val = 10 * val + digit;
+  }
+  return val;
+}
+
+// Parse YYYY-MM-DD at the beginning of str into dt.
+bool parseIsoDate(std::string_view const str, DateTimeParser::DateTime& dt) {
+  if (str.size() < 10 || str[4] != '-' || str[7] != '-') {
+    return false;
+  }
+  auto const year = fixedDigits(str, 0, 4);
+  auto const month = fixedDigits(str, 5, 2);
+  auto const day = fixedDigits(str, 8, 2);
+  if (!year || !month || !day || *month < 1 || 12 < *month || *day < 1 || 31 < *day) {
+    return false;
+  }
+  dt.Y = *year;
+  dt.m = *month;
+  dt.d = *day;
+  return true;
+}
+
+// Fixed-format ISO-8601 timestamps, which are the bulk of input, are read by offsets
+// without trying formats one by one: YYYY-MM-DD[T ]HH:MM:SS[.f{1,9}][{+-}HH[:]MM].
+// Return std::nullopt for any other string, which is left to the generic parser.
+// Accepted strings are interpreted the same way by both.
+std::optional<int64_t> parseIsoTimestamp(std::string_view const str,
+                                         hdk::ir::TimeUnit unit) {
+  DateTimeParser::DateTime dt;
+  if (str.size() < 19 || !parseIsoDate(str, dt) || (str[10] != ' ' && str[10] != 'T') ||
+      str[13] != ':' || str[16] != ':') {
+    return std::nullopt;
+  }
+  auto const hour = fixedDigits(str, 11, 2);
+  auto const minute = fixedDigits(str, 14, 2);
+  auto const second = fixedDigits(str, 17, 2);
+  if (!hour || !minute || !second || 23 < *hour || 59 < *minute || 61 < *second) {
+    return std::nullopt;
+  }
+  dt.H = *hour;
+  dt.M = *minute;
+  dt.S = *second;
+  size_t pos = 19;
+  if (pos < str.size() && str[pos] == '.') {
+    size_t const begin = ++pos;
+    while (pos < str.size() && pos - begin < 9 && isdigit(str[pos])) {
+      ++pos;
+    }
+    if (pos == begin) {
+      return std::nullopt;
+    }
+    dt.n = *fixedDigits(str, begin, pos - begin) * pow_10[9 - (pos - begin)];
+  }
+  if (pos < str.size()) {
+    size_t const tz_len = str.size() - pos;
+    if ((str[pos] != '-' && str[pos] != '+') || (tz_len != 5 && tz_len != 6) ||
+        (tz_len == 6 && str[pos + 3] != ':')) {
+      return std::nullopt;
+    }
+    auto const tz_hours = fixedDigits(str, pos + 1, 2);
+    auto const tz_minutes = fixedDigits(str, str.size() - 2, 2);
+    if (!tz_hours || !tz_minutes) {
+      return std::nullopt;
+    }
+    dt.z = (str[pos] == '-' ? -60 : 60) * static_cast<int>(60 * *tz_hours + *tz_minutes);
+  }
+  return dt.getTime(unit);
+}
+
 }  // namespace
 
 // Interpret str according to DateTimeParser::FormatType::Time.
@@ -163,6 +242,9 @@ std::optional<int64_t> dateTimeParseOptional<hdk::ir::Type::kTimestamp>(
   if (!str.empty() && str.front() == 'T') {
     str.remove_prefix(1);
   }
+  if (auto const time = parseIsoTimestamp(str, unit)) {
+    return time;
+  }
   DateTimeParser parser;
   // Parse date
   parser.setFormatType(DateTimeParser::FormatType::Date);
@@ -192,6 +274,9 @@ template <>
 std::optional<int64_t> dateTimeParseOptional<hdk::ir::Type::kDate>(
     std::string_view str,
     hdk::ir::TimeUnit unit) {
+  if (DateTimeParser::DateTime dt; str.size() == 10 && parseIsoDate(str, dt)) {
+    return dt.getTime(unit);
+  }
   DateTimeParser parser;
   // Parse date
   parser.setFormatType(DateTimeParser::FormatType::Date);
@@ -0,0 +1,190 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Shared/Metrics.h"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+namespace metrics {
+
+Histogram::Histogram(std::vector<double> bounds)
+    : bounds_(std::move(bounds))
+    , buckets_(std::make_unique<std::atomic<uint64_t>[]>(bounds_.size() + 1)) {
+  std::sort(bounds_.begin(), bounds_.end());
+  for (size_t i = 0; i <= bounds_.size(); ++i) {
+    buckets_[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+void Histogram::observe(double val) {
+  const size_t bucket =
+      std::lower_bound(bounds_.begin(), bounds_.end(), val) - bounds_.begin();
+  buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  auto sum = sum_.load(std::memory_order_relaxed);
+  while (!sum_.compare_exchange_weak(sum, sum + val, std::memory_order_relaxed)) {
+  }
+}
+
+std::vector<uint64_t> Histogram::cumulativeCounts() const {
+  std::vector<uint64_t> res(bounds_.size() + 1);
+  uint64_t total = 0;
+  for (size_t i = 0; i <= bounds_.size(); ++i) {
+    total += buckets_[i].load(std::memory_order_relaxed);
+    res[i] = total;
+  }
+  return res;
+}
+
+const std::vector<double>& latencyBounds() {
+  static const std::vector<double> bounds{
+      0.0001, 0.0005, 0.001, 0.005, 0.01, 0.05, 0.1, 0.5, 1, 5, 10, 50, 100};
+  return bounds;
+}
+
+Registry& Registry::get() {
+  // Never destroyed, so metrics can be updated from static destructors.
+  static Registry* registry = new Registry();
+  return *registry;
+}
+
+Registry::Family& Registry::getFamily(const std::string& name,
+                                      const std::string& help,
+                                      MetricType type) {
+  auto it = families_.find(name);
+  if (it == families_.end()) {
+    it = families_.emplace(name, Family{type, help, {}, {}}).first;
+  } else if (it->second.type != type) {
+    throw std::runtime_error("Metric " + name + " is registered with another type.");
+  }
+  return it->second;
+}
+
+Counter& Registry::counter(const std::string& name,
+                           const std::string& help,
+                           const Labels& labels) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& family = getFamily(name, help, MetricType::kCounter);
+  auto& res = family.counters[labels];
+  if (!res) {
+    res = std::make_unique<Counter>();
+  }
+  return *res;
+}
+
+Histogram& Registry::histogram(const std::string& name,
+                               const std::string& help,
+                               const std::vector<double>& bounds,
+                               const Labels& labels) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& family = getFamily(name, help, MetricType::kHistogram);
+  auto& res = family.histograms[labels];
+  if (!res) {
+    res = std::make_unique<Histogram>(bounds);
+  }
+  return *res;
+}
+
+namespace {
+
+// Label values escape backslashes, quotes and line breaks.
+std::string escapeLabelValue(const std::string& val) {
+  std::string res;
+  res.reserve(val.size());
+  for (auto ch : val) {
+    if (ch == '\\' || ch == '"') {
+      res.push_back('\\');
+      res.push_back(ch);
+    } else if (ch == '\n') {
+      res += "\\n";
+    } else {
+      res.push_back(ch);
+    }
+  }
+  return res;
+}
+
+std::string formatLabels(const Labels& labels, const std::string& le = "") {
+  if (labels.empty() && le.empty()) {
+    return "";
+  }
+  std::string res = "{";
+  for (auto& [key, val] : labels) {
+    res += (res.size() > 1 ? "," : "") + key + "=\"" + escapeLabelValue(val) + "\"";
+  }
+  if (!le.empty()) {
+    res += (res.size() > 1 ? "," : "") + std::string("le=\"") + le + "\"";
+  }
+  return res + "}";
+}
+
+std::string formatBound(double bound) {
+  std::ostringstream ss;
+  ss << bound;
+  return ss.str();
+}
+
+}  // namespace
+
+std::vector<std::pair<std::string, double>> Registry::familySamples(
+    const std::string& name,
+    const Family& family) {
+  std::vector<std::pair<std::string, double>> res;
+  for (auto& [labels, counter] : family.counters) {
+    res.emplace_back(name + formatLabels(labels), static_cast<double>(counter->value()));
+  }
+  for (auto& [labels, histogram] : family.histograms) {
+    const auto counts = histogram->cumulativeCounts();
+    const auto& bounds = histogram->bounds();
+    for (size_t i = 0; i < bounds.size(); ++i) {
+      res.emplace_back(name + "_bucket" + formatLabels(labels, formatBound(bounds[i])),
+                       static_cast<double>(counts[i]));
+    }
+    res.emplace_back(name + "_bucket" + formatLabels(labels, "+Inf"),
+                     static_cast<double>(counts.back()));
+    res.emplace_back(name + "_sum" + formatLabels(labels), histogram->sum());
+    res.emplace_back(name + "_count" + formatLabels(labels),
+                     static_cast<double>(histogram->count()));
+  }
+  return res;
+}
+
+std::map<std::string, double> Registry::snapshot() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::map<std::string, double> res;
+  for (auto& [name, family] : families_) {
+    for (auto& sample : familySamples(name, family)) {
+      res.insert(std::move(sample));
+    }
+  }
+  return res;
+}
+
+std::string Registry::toPrometheusText() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::ostringstream ss;
+  for (auto& [name, family] : families_) {
+    ss << "# HELP " << name << " " << family.help << "\n";
+    ss << "# TYPE " << name << " "
+       << (family.type == MetricType::kCounter ? "counter" : "histogram") << "\n";
+    for (auto& [sample, val] : familySamples(name, family)) {
+      ss << sample << " " << val << "\n";
+    }
+  }
+  return ss.str();
+}
+
+}  // namespace metrics
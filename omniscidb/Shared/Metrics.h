@@ -0,0 +1,116 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    Metrics.h
+ * @brief   Process-wide registry of counters and histograms for monitoring.
+ *
+ * Metrics are always collected. Updates are relaxed atomic operations, so call sites
+ * keep references to their metrics, e.g. in function-local statics, and don't look
+ * them up on hot paths. The registry is read by pulling a snapshot or a text in the
+ * Prometheus exposition format, which also fits callback-based exporters like
+ * OpenTelemetry observable instruments.
+ **/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace metrics {
+
+using Labels = std::vector<std::pair<std::string, std::string>>;
+
+class Counter {
+ public:
+  void inc(uint64_t val = 1) { value_.fetch_add(val, std::memory_order_relaxed); }
+  uint64_t value() const { return value_.load(std::memory_order_relaxed); }
+  // Address for updates by atomic instructions of generated code.
+  std::atomic<uint64_t>* data() { return &value_; }
+
+ private:
+  std::atomic<uint64_t> value_{0};
+};
+
+// Distribution of observed values over buckets with fixed upper bounds.
+class Histogram {
+ public:
+  explicit Histogram(std::vector<double> bounds);
+
+  void observe(double val);
+
+  const std::vector<double>& bounds() const { return bounds_; }
+  // Cumulative counts of values less than or equal to each bound.
+  std::vector<uint64_t> cumulativeCounts() const;
+  uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+  double sum() const { return sum_.load(std::memory_order_relaxed); }
+
+ private:
+  std::vector<double> bounds_;
+  // One more bucket for values above the last bound.
+  std::unique_ptr<std::atomic<uint64_t>[]> buckets_;
+  std::atomic<uint64_t> count_{0};
+  std::atomic<double> sum_{0.0};
+};
+
+// Bounds in seconds for latencies from 100us to 100s.
+const std::vector<double>& latencyBounds();
+
+class Registry {
+ public:
+  static Registry& get();
+
+  // Return the metric with the name and labels, create it on the first call. Returned
+  // references stay valid for the lifetime of the process.
+  Counter& counter(const std::string& name,
+                   const std::string& help,
+                   const Labels& labels = {});
+  Histogram& histogram(const std::string& name,
+                       const std::string& help,
+                       const std::vector<double>& bounds = latencyBounds(),
+                       const Labels& labels = {});
+
+  // Current values keyed by the sample name in the exposition format, e.g.
+  // 'hdk_transfer_bytes_total{direction="h2d",device="0"}'. Histograms are
+  // reported by _bucket, _sum and _count samples.
+  std::map<std::string, double> snapshot() const;
+
+  std::string toPrometheusText() const;
+
+ private:
+  enum class MetricType { kCounter, kHistogram };
+
+  struct Family {
+    MetricType type;
+    std::string help;
+    std::map<Labels, std::unique_ptr<Counter>> counters;
+    std::map<Labels, std::unique_ptr<Histogram>> histograms;
+  };
+
+  Family& getFamily(const std::string& name, const std::string& help, MetricType type);
+  static std::vector<std::pair<std::string, double>> familySamples(
+      const std::string& name,
+      const Family& family);
+
+  mutable std::mutex mutex_;
+  std::map<std::string, Family> families_;
+};
+
+}  // namespace metrics
@@ -25,5 +25,6 @@ typedef void* CUfunction;
 typedef int CUjit_option;
 typedef int CUlinkState;
 typedef unsigned long long CUdeviceptr;
+typedef void* CUstream;
 
 #endif  // NOCUDA_H
@@ -588,19 +588,23 @@ DEVICE void TDigest<RealType, IndexType>::add(RealType value) {
 }
 
 // Assumes buf_ is allocated iff centroids_ is allocated.
+// All four arrays are carved out of a single pre-sized block, so allocating a digest
+// takes one call to the (synchronized) allocator instead of four.
 template <typename RealType, typename IndexType>
 DEVICE void TDigest<RealType, IndexType>::allocate() {
   if (buf_.capacity() == 0) {
-    auto* p0 = simple_allocator_->allocate(buf_allocate_ * sizeof(RealType));
-    auto* p1 = simple_allocator_->allocate(buf_allocate_ * sizeof(IndexType));
+    size_t const sums_count = buf_allocate_ + centroids_allocate_;
+    size_t const sums_bytes = (sums_count * sizeof(RealType) + alignof(IndexType) - 1) /
+                              alignof(IndexType) * alignof(IndexType);
+    auto* p = simple_allocator_->allocate(sums_bytes + sums_count * sizeof(IndexType));
+    auto* sums = reinterpret_cast<RealType*>(p);
+    auto* counts = reinterpret_cast<IndexType*>(p + sums_bytes);
     buf_ = Centroids<RealType, IndexType>(
-        VectorView<RealType>(reinterpret_cast<RealType*>(p0), 0, buf_allocate_),
-        VectorView<IndexType>(reinterpret_cast<IndexType*>(p1), 0, buf_allocate_));
-    p0 = simple_allocator_->allocate(centroids_allocate_ * sizeof(RealType));
-    p1 = simple_allocator_->allocate(centroids_allocate_ * sizeof(IndexType));
+        VectorView<RealType>(sums, 0, buf_allocate_),
+        VectorView<IndexType>(counts, 0, buf_allocate_));
     centroids_ = Centroids<RealType, IndexType>(
-        VectorView<RealType>(reinterpret_cast<RealType*>(p0), 0, centroids_allocate_),
-        VectorView<IndexType>(reinterpret_cast<IndexType*>(p1), 0, centroids_allocate_));
+        VectorView<RealType>(sums + buf_allocate_, 0, centroids_allocate_),
+        VectorView<IndexType>(counts + buf_allocate_, 0, centroids_allocate_));
   }
 }
 
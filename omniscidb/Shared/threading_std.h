@@ -91,6 +91,13 @@ class blocked_range {
     return middle;
   }
 };
+
+//! Execute a function with a limited number of worker threads. Used by backends
+//! with no support for concurrency limits, so the limit is ignored.
+template <typename Fn>
+auto execute_with_concurrency_limit(int /* max_concurrency */, Fn&& fn) {
+  return fn();
+}
 }  // namespace threading_common
 
 namespace threading_std {
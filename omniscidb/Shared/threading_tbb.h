@@ -32,6 +32,18 @@ auto parallel_reduce(X&&... x) -> decltype(tbb::parallel_reduce(std::forward<X>(
       [&] { return tbb::parallel_reduce(std::forward<X>(x)...); });
 }
 
+//! Execute a function in a separate task arena with at most max_concurrency threads.
+//! Parallel algorithms and task groups used by the function respect this limit.
+//! Non-positive limit means no limit.
+template <typename Fn>
+auto execute_with_concurrency_limit(int max_concurrency, Fn&& fn) {
+  if (max_concurrency <= 0 || max_concurrency >= g_tbb_arena.max_concurrency()) {
+    return fn();
+  }
+  tbb::task_arena arena(max_concurrency);
+  return arena.execute(std::forward<Fn>(fn));
+}
+
 template <typename T>
 struct tbb_packaged_task : tbb::task_group {
   T value_;
@@ -57,6 +57,19 @@ class LruCache {
 
   const_list_iterator_t cend() const { return (cache_items_list_.cend()); }
 
+  // Iteration from the least recently used entry to the most recently used one.
+  using const_reverse_list_iterator_t = typename cache_list_t::const_reverse_iterator;
+  const_reverse_list_iterator_t crbegin() const { return cache_items_list_.crbegin(); }
+  const_reverse_list_iterator_t crend() const { return cache_items_list_.crend(); }
+
+  void erase(const key_t& key) {
+    auto it = cache_items_map_.find(key);
+    if (it != cache_items_map_.end()) {
+      cache_items_list_.erase(it->second);
+      cache_items_map_.erase(it);
+    }
+  }
+
   void clear() {
     cache_items_list_.clear();
     cache_items_map_.clear();
@@ -24,6 +24,7 @@
 #include <boost/sort/spreadsort/string_sort.hpp>
 #include <functional>
 #include <future>
+#include <fstream>
 #include <iostream>
 #include <string_view>
 #include <thread>
@@ -35,13 +36,16 @@
 #include <io.h>
 #else
 #include <sys/fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #endif
 
 #include "Logger/Logger.h"
 #include "OSDependent/omnisci_fs.h"
 #include "Shared/sqltypes.h"
 #include "Shared/thread_count.h"
-#include "Utils/Regexp.h"
+#include "Utils/RegexpMatcher.h"
 #include "Utils/StringLike.h"
 
 bool g_cache_string_hash{true};
@@ -80,11 +84,13 @@ bool g_enable_stringdict_parallel{false};
 constexpr int32_t StringDictionary::INVALID_STR_ID;
 constexpr size_t StringDictionary::MAX_STRLEN;
 constexpr size_t StringDictionary::MAX_STRCOUNT;
+std::atomic<uint64_t> StringDictionary::next_uid_{0};
 
 StringDictionary::StringDictionary(const DictRef& dict_ref,
                                    const bool materializeHashes,
                                    size_t initial_capacity)
     : dict_ref_(dict_ref)
+    , uid_(next_uid_.fetch_add(1))
     , str_count_(0)
     , string_id_string_dict_hash_table_(initial_capacity, INVALID_STR_ID)
     , hash_cache_(initial_capacity)
@@ -136,13 +142,198 @@ int32_t StringDictionary::getDictId() const noexcept {
 
 StringDictionary::~StringDictionary() noexcept {
   free(CANARY_BUFFER);
-  if (payload_map_) {
+  if (mapped_file_addr_) {
+#ifndef _WIN32
+    munmap(mapped_file_addr_, mapped_file_size_);
+#endif
+  } else if (payload_map_) {
     CHECK(offset_map_);
     free(payload_map_);
     free(offset_map_);
   }
 }
 
+namespace {
+
+constexpr uint64_t kDictFileMagic = 0x5444434944484b44;  // "DKHDICDT"
+constexpr uint64_t kDictFileVersion = 1;
+// Header is followed by a FrontCodedBlock per kFrontCodingBlockSize strings and the
+// encoded strings.
+constexpr uint64_t kFrontCodedDictFileVersion = 2;
+constexpr size_t kFrontCodingBlockSize = 16;
+
+struct DictFileHeader {
+  uint64_t magic;
+  uint64_t version;
+  uint64_t str_count;
+  uint64_t payload_size;
+};
+
+struct FrontCodedBlock {
+  // Offset of the block in encoded data.
+  uint64_t data_off;
+  // Offset of the first string of the block in decoded payload.
+  uint64_t payload_off;
+};
+
+void put_varint(std::string& out, size_t val) {
+  while (val >= 0x80) {
+    out.push_back(static_cast<char>((val & 0x7f) | 0x80));
+    val >>= 7;
+  }
+  out.push_back(static_cast<char>(val));
+}
+
+size_t get_varint(const char*& ptr, const char* end) {
+  size_t res = 0;
+  for (int shift = 0; ptr < end && shift < 21; shift += 7) {
+    const auto byte = static_cast<uint8_t>(*ptr++);
+    res |= static_cast<size_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80)) {
+      return res;
+    }
+  }
+  throw std::runtime_error("Invalid front-coded dictionary data.");
+}
+
+}  // namespace
+
+void StringDictionary::saveToFile(const std::string& file_name,
+                                  const bool front_coded) const {
+  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+  std::ofstream out(file_name, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    throw std::runtime_error("Cannot open dictionary file for writing: " + file_name);
+  }
+  DictFileHeader header{kDictFileMagic,
+                        front_coded ? kFrontCodedDictFileVersion : kDictFileVersion,
+                        str_count_,
+                        payload_file_off_};
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  if (front_coded) {
+    std::vector<FrontCodedBlock> blocks;
+    blocks.reserve((str_count_ + kFrontCodingBlockSize - 1) / kFrontCodingBlockSize);
+    std::string data;
+    uint64_t payload_off = 0;
+    for (size_t id = 0; id < str_count_; ++id) {
+      const auto str = getStringFromStorageFast(id);
+      size_t prefix_len = 0;
+      if (id % kFrontCodingBlockSize == 0) {
+        blocks.push_back({data.size(), payload_off});
+      } else {
+        const auto prev = getStringFromStorageFast(id - 1);
+        const size_t max_prefix_len = std::min(prev.size(), str.size());
+        while (prefix_len < max_prefix_len && prev[prefix_len] == str[prefix_len]) {
+          ++prefix_len;
+        }
+        put_varint(data, prefix_len);
+      }
+      put_varint(data, str.size() - prefix_len);
+      data.append(str.substr(prefix_len));
+      payload_off += str.size();
+    }
+    out.write(reinterpret_cast<const char*>(blocks.data()),
+              blocks.size() * sizeof(FrontCodedBlock));
+    out.write(data.data(), data.size());
+  } else {
+    out.write(reinterpret_cast<const char*>(offset_map_),
+              str_count_ * sizeof(StringIdxEntry));
+    out.write(payload_map_, payload_file_off_);
+  }
+  if (!out) {
+    throw std::runtime_error("Cannot write dictionary file: " + file_name);
+  }
+}
+
+std::shared_ptr<StringDictionary> StringDictionary::loadFromFile(
+    const DictRef& dict_ref,
+    const std::string& file_name,
+    const bool materializeHashes) {
+#ifdef _WIN32
+  throw std::runtime_error("Memory-mapped dictionaries are not supported on Windows.");
+#else
+  int fd = open(file_name.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Cannot open dictionary file: " + file_name);
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(DictFileHeader)) {
+    close(fd);
+    throw std::runtime_error("Invalid dictionary file: " + file_name);
+  }
+  const size_t file_size = static_cast<size_t>(st.st_size);
+  void* addr = mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED) {
+    throw std::runtime_error("Cannot map dictionary file: " + file_name);
+  }
+
+  const auto* header = reinterpret_cast<const DictFileHeader*>(addr);
+  const size_t offsets_size = header->str_count * sizeof(StringIdxEntry);
+  const size_t blocks_size =
+      (header->str_count + kFrontCodingBlockSize - 1) / kFrontCodingBlockSize *
+      sizeof(FrontCodedBlock);
+  const bool front_coded = header->version == kFrontCodedDictFileVersion;
+  if (header->magic != kDictFileMagic || header->str_count > MAX_STRCOUNT ||
+      (front_coded ? sizeof(DictFileHeader) + blocks_size > file_size
+                   : header->version != kDictFileVersion ||
+                         sizeof(DictFileHeader) + offsets_size + header->payload_size !=
+                             file_size)) {
+    munmap(addr, file_size);
+    throw std::runtime_error("Invalid dictionary file: " + file_name);
+  }
+
+  const size_t str_count = header->str_count;
+  size_t capacity = 256;
+  while (capacity <= str_count * 2) {
+    capacity *= 2;
+  }
+  auto dict = std::make_shared<StringDictionary>(dict_ref, materializeHashes, capacity);
+  auto* base = static_cast<char*>(addr);
+  if (front_coded) {
+    const size_t data_off = sizeof(DictFileHeader) + blocks_size;
+    try {
+      dict->decodeFrontCoded(base + sizeof(DictFileHeader),
+                             file_size - data_off,
+                             str_count,
+                             header->payload_size);
+    } catch (const std::exception&) {
+      munmap(addr, file_size);
+      throw std::runtime_error("Invalid dictionary file: " + file_name);
+    }
+    munmap(addr, file_size);
+  } else {
+    dict->mapped_file_addr_ = addr;
+    dict->mapped_file_size_ = file_size;
+    dict->offset_map_ = reinterpret_cast<StringIdxEntry*>(base + sizeof(DictFileHeader));
+    dict->offset_file_size_ = offsets_size;
+    dict->payload_map_ = base + sizeof(DictFileHeader) + offsets_size;
+    dict->payload_file_size_ = header->payload_size;
+    dict->payload_file_off_ = header->payload_size;
+  }
+
+  // Hash table is not stored in the file and is built locally.
+  std::vector<string_dict_hash_t> hashes(str_count);
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, str_count),
+                    [&](const tbb::blocked_range<size_t>& r) {
+                      for (size_t id = r.begin(); id != r.end(); ++id) {
+                        hashes[id] = hash_string(dict->getStringFromStorageFast(id));
+                      }
+                    });
+  for (size_t id = 0; id < str_count; ++id) {
+    const uint32_t bucket = dict->computeUniqueBucketWithHash(
+        hashes[id], dict->string_id_string_dict_hash_table_);
+    dict->string_id_string_dict_hash_table_[bucket] = static_cast<int32_t>(id);
+    if (materializeHashes) {
+      dict->hash_cache_[id] = hashes[id];
+    }
+  }
+  dict->str_count_ = str_count;
+
+  return dict;
+#endif
+}
+
 int32_t StringDictionary::getOrAdd(const std::string_view& str) noexcept {
   // @TODO(wei) treat empty string as NULL for now
   if (str.size() == 0) {
@@ -369,6 +560,54 @@ template size_t StringDictionary::getBulk(const std::vector<std::string>& string
                                           int32_t* encoded_vec,
                                           const int64_t generation) const;
 
+template <class T, class String>
+std::vector<size_t> StringDictionary::getExistingBulk(
+    const std::vector<String>& input_strings,
+    const std::vector<string_dict_hash_t>& input_strings_hashes,
+    T* output_string_ids,
+    const bool parallel) const {
+  std::vector<uint8_t> is_missing(input_strings.size(), 0);
+  auto lookup = [&](const tbb::blocked_range<size_t>& r) {
+    for (size_t idx = r.begin(); idx != r.end(); ++idx) {
+      const auto& input_string = input_strings[idx];
+      if (input_string.empty()) {
+        output_string_ids[idx] = inline_int_null_value<T>();
+        continue;
+      }
+      if (input_string.size() > MAX_STRLEN) {
+        // Reported on insertion.
+        is_missing[idx] = 1;
+        continue;
+      }
+      const uint32_t hash_bucket = computeBucket(
+          input_strings_hashes[idx], input_string, string_id_string_dict_hash_table_);
+      const auto string_id = string_id_string_dict_hash_table_[hash_bucket];
+      if (string_id == INVALID_STR_ID) {
+        is_missing[idx] = 1;
+      } else {
+        output_string_ids[idx] = string_id;
+      }
+    }
+  };
+
+  {
+    mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+    if (parallel) {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, input_strings.size()), lookup);
+    } else {
+      lookup(tbb::blocked_range<size_t>(0, input_strings.size()));
+    }
+  }
+
+  std::vector<size_t> missing;
+  for (size_t idx = 0; idx < is_missing.size(); ++idx) {
+    if (is_missing[idx]) {
+      missing.push_back(idx);
+    }
+  }
+  return missing;
+}
+
 template <class T, class String>
 void StringDictionary::getOrAddBulk(const std::vector<String>& input_strings,
                                     T* output_string_ids) {
@@ -377,22 +616,33 @@ void StringDictionary::getOrAddBulk(const std::vector<String>& input_strings,
     return;
   }
   // Single-thread path.
+  std::vector<string_dict_hash_t> input_strings_hashes(input_strings.size());
+  for (size_t idx = 0; idx < input_strings.size(); ++idx) {
+    if (!input_strings[idx].empty()) {
+      input_strings_hashes[idx] = hash_string(input_strings[idx]);
+    }
+  }
+  // Strings which are already in the dictionary are resolved under the shared lock,
+  // so concurrent loads into the same dictionary serialize only on new strings.
+  auto missing = getExistingBulk(
+      input_strings, input_strings_hashes, output_string_ids, /*parallel=*/false);
+  if (missing.empty()) {
+    return;
+  }
+
   mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
 
   const size_t initial_str_count = str_count_;
-  size_t idx = 0;
-  for (const auto& input_string : input_strings) {
-    if (input_string.empty()) {
-      output_string_ids[idx++] = inline_int_null_value<T>();
-      continue;
-    }
+  for (auto idx : missing) {
+    const auto& input_string = input_strings[idx];
     CHECK(input_string.size() <= MAX_STRLEN);
 
-    const string_dict_hash_t input_string_hash = hash_string(input_string);
+    const string_dict_hash_t input_string_hash = input_strings_hashes[idx];
     uint32_t hash_bucket =
         computeBucket(input_string_hash, input_string, string_id_string_dict_hash_table_);
+    // The string might be added after the lookup.
     if (string_id_string_dict_hash_table_[hash_bucket] != INVALID_STR_ID) {
-      output_string_ids[idx++] = string_id_string_dict_hash_table_[hash_bucket];
+      output_string_ids[idx] = string_id_string_dict_hash_table_[hash_bucket];
       continue;
     }
     // need to add record to dictionary
@@ -416,7 +666,7 @@ void StringDictionary::getOrAddBulk(const std::vector<String>& input_strings,
     }
     const int32_t string_id = static_cast<int32_t>(str_count_);
     string_id_string_dict_hash_table_[hash_bucket] = string_id;
-    output_string_ids[idx++] = string_id;
+    output_string_ids[idx] = string_id;
     ++str_count_;
   }
   const size_t num_strings_added = str_count_ - initial_str_count;
@@ -432,6 +682,13 @@ void StringDictionary::getOrAddBulkParallel(const std::vector<String>& input_str
   // as the string hashing does not need to be behind the subsequent write_lock
   std::vector<string_dict_hash_t> input_strings_hashes(input_strings.size());
   hashStrings(input_strings, input_strings_hashes);
+  // Lookup of existing strings doesn't need the write lock either. Concurrent loads
+  // into the same dictionary serialize only on strings which are not there yet.
+  auto missing = getExistingBulk(
+      input_strings, input_strings_hashes, output_string_ids, /*parallel=*/true);
+  if (missing.empty()) {
+    return;
+  }
 
   mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
   size_t shadow_str_count =
@@ -439,14 +696,9 @@ void StringDictionary::getOrAddBulkParallel(const std::vector<String>& input_str
   const size_t storage_high_water_mark = shadow_str_count;
   std::vector<size_t> string_memory_ids;
   size_t sum_new_string_lengths = 0;
-  string_memory_ids.reserve(input_strings.size());
-  size_t input_string_idx{0};
-  for (const auto& input_string : input_strings) {
-    // Currently we make empty strings null
-    if (input_string.empty()) {
-      output_string_ids[input_string_idx++] = inline_int_null_value<T>();
-      continue;
-    }
+  string_memory_ids.reserve(missing.size());
+  for (auto input_string_idx : missing) {
+    const auto& input_string = input_strings[input_string_idx];
     // TODO: Recover gracefully if an input string is too long
     CHECK(input_string.size() <= MAX_STRLEN);
 
@@ -471,9 +723,10 @@ void StringDictionary::getOrAddBulkParallel(const std::vector<String>& input_str
 
     // If the hash bucket is not empty, that is our string id
     // (computeBucketFromStorageAndMemory) already checked to ensure the input string and
-    // bucket string are equal)
+    // bucket string are equal). It is either a duplicate in the input or a string
+    // added after the lookup.
     if (string_id_string_dict_hash_table_[hash_bucket] != INVALID_STR_ID) {
-      output_string_ids[input_string_idx++] =
+      output_string_ids[input_string_idx] =
           string_id_string_dict_hash_table_[hash_bucket];
       continue;
     }
@@ -492,7 +745,7 @@ void StringDictionary::getOrAddBulkParallel(const std::vector<String>& input_str
     if (materialize_hashes_) {
       hash_cache_[shadow_str_count] = input_string_hash;
     }
-    output_string_ids[input_string_idx++] = shadow_str_count++;
+    output_string_ids[input_string_idx] = shadow_str_count++;
   }
   appendToStorageBulk(input_strings, string_memory_ids, sum_new_string_lengths);
   const size_t num_strings_added = shadow_str_count - str_count_;
@@ -559,22 +812,22 @@ size_t StringDictionary::storageEntryCount() const {
 
 namespace {
 
-bool is_like(const std::string& str,
+bool is_like(const std::string_view str,
              const std::string& pattern,
              const bool icase,
              const bool is_simple,
              const char escape) {
   return icase
              ? (is_simple ? string_ilike_simple(
-                                str.c_str(), str.size(), pattern.c_str(), pattern.size())
-                          : string_ilike(str.c_str(),
+                                str.data(), str.size(), pattern.c_str(), pattern.size())
+                          : string_ilike(str.data(),
                                          str.size(),
                                          pattern.c_str(),
                                          pattern.size(),
                                          escape))
              : (is_simple ? string_like_simple(
-                                str.c_str(), str.size(), pattern.c_str(), pattern.size())
-                          : string_like(str.c_str(),
+                                str.data(), str.size(), pattern.c_str(), pattern.size())
+                          : string_like(str.data(),
                                         str.size(),
                                         pattern.c_str(),
                                         pattern.size(),
@@ -600,20 +853,34 @@ std::vector<int32_t> StringDictionary::getLike(const std::string& pattern,
   CHECK_GT(worker_count, 0);
   std::vector<std::vector<int32_t>> worker_results(worker_count);
   CHECK_LE(generation, str_count_);
+  // Simple case-sensitive patterns are a plain substring search. A searcher skips
+  // most of the string bytes instead of comparing the pattern at every position.
+  const bool use_searcher = is_simple && !icase && !pattern.empty();
+  const std::boyer_moore_horspool_searcher searcher(pattern.begin(), pattern.end());
+  // Each worker scans a contiguous range of ids, so it reads a contiguous part of the
+  // payload and the result is ordered.
+  const size_t strings_per_worker = (generation + worker_count - 1) / worker_count;
   for (int worker_idx = 0; worker_idx < worker_count; ++worker_idx) {
     workers.emplace_back([&worker_results,
                           &pattern,
+                          &searcher,
                           generation,
                           icase,
                           is_simple,
                           escape,
+                          use_searcher,
                           worker_idx,
-                          worker_count,
+                          strings_per_worker,
                           this]() {
-      for (size_t string_id = worker_idx; string_id < generation;
-           string_id += worker_count) {
-        const auto str = getStringUnlocked(string_id);
-        if (is_like(str, pattern, icase, is_simple, escape)) {
+      const size_t start_id = std::min(worker_idx * strings_per_worker, generation);
+      const size_t end_id = std::min(start_id + strings_per_worker, generation);
+      for (size_t string_id = start_id; string_id < end_id; ++string_id) {
+        const auto str = getStringFromStorageFast(string_id);
+        if (use_searcher) {
+          if (std::search(str.begin(), str.end(), searcher) != str.end()) {
+            worker_results[worker_idx].push_back(string_id);
+          }
+        } else if (is_like(str, pattern, icase, is_simple, escape)) {
           worker_results[worker_idx].push_back(string_id);
         }
       }
@@ -841,16 +1108,6 @@ std::vector<int32_t> StringDictionary::getCompare(const std::string& pattern,
   return ret;
 }
 
-namespace {
-
-bool is_regexp_like(const std::string& str,
-                    const std::string& pattern,
-                    const char escape) {
-  return regexp_like(str.c_str(), str.size(), pattern.c_str(), pattern.size(), escape);
-}
-
-}  // namespace
-
 std::vector<int32_t> StringDictionary::getRegexpLike(const std::string& pattern,
                                                      const char escape,
                                                      const size_t generation) const {
@@ -866,22 +1123,19 @@ std::vector<int32_t> StringDictionary::getRegexpLike(const std::string& pattern,
   CHECK_GT(worker_count, 0);
   std::vector<std::vector<int32_t>> worker_results(worker_count);
   CHECK_LE(generation, str_count_);
+  // The pattern is parsed once and shared by workers rather than per entry.
+  const RegexpMatcher matcher({pattern});
   for (int worker_idx = 0; worker_idx < worker_count; ++worker_idx) {
-    workers.emplace_back([&worker_results,
-                          &pattern,
-                          generation,
-                          escape,
-                          worker_idx,
-                          worker_count,
-                          this]() {
-      for (size_t string_id = worker_idx; string_id < generation;
-           string_id += worker_count) {
-        const auto str = getStringUnlocked(string_id);
-        if (is_regexp_like(str, pattern, escape)) {
-          worker_results[worker_idx].push_back(string_id);
-        }
-      }
-    });
+    workers.emplace_back(
+        [&worker_results, &matcher, generation, worker_idx, worker_count, this]() {
+          for (size_t string_id = worker_idx; string_id < generation;
+               string_id += worker_count) {
+            const auto str = getStringUnlocked(string_id);
+            if (matcher.matches(str)) {
+              worker_results[worker_idx].push_back(string_id);
+            }
+          }
+        });
   }
   for (auto& worker : workers) {
     worker.join();
@@ -895,6 +1149,31 @@ std::vector<int32_t> StringDictionary::getRegexpLike(const std::string& pattern,
   return result;
 }
 
+std::shared_ptr<const std::vector<int32_t>> StringDictionary::getSortedRanks(
+    const bool build) {
+  {
+    mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+    if (sorted_ranks_ && sorted_ranks_->size() == str_count_) {
+      return sorted_ranks_;
+    }
+    if (!build) {
+      return nullptr;
+    }
+  }
+  mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
+  if (sorted_cache.size() < str_count_) {
+    buildSortedCache();
+  }
+  if (!sorted_ranks_ || sorted_ranks_->size() != sorted_cache.size()) {
+    auto ranks = std::make_shared<std::vector<int32_t>>(sorted_cache.size());
+    for (size_t rank = 0; rank < sorted_cache.size(); ++rank) {
+      (*ranks)[sorted_cache[rank]] = static_cast<int32_t>(rank);
+    }
+    sorted_ranks_ = std::move(ranks);
+  }
+  return sorted_ranks_;
+}
+
 std::vector<std::string> StringDictionary::copyStrings() const {
   mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
 
@@ -1187,12 +1466,100 @@ StringDictionary::PayloadString StringDictionary::getStringFromStorage(
   return {payload_map_ + str_meta->off, str_meta->size, false};
 }
 
+void StringDictionary::detachMappedFile() noexcept {
+  if (!mapped_file_addr_) {
+    return;
+  }
+  auto payload = static_cast<char*>(malloc(std::max(payload_file_size_, size_t(1))));
+  auto offsets =
+      static_cast<StringIdxEntry*>(malloc(std::max(offset_file_size_, size_t(1))));
+  CHECK(payload && offsets);
+  memcpy(payload, payload_map_, payload_file_size_);
+  memcpy(offsets, offset_map_, offset_file_size_);
+  payload_map_ = payload;
+  offset_map_ = offsets;
+#ifndef _WIN32
+  munmap(mapped_file_addr_, mapped_file_size_);
+#endif
+  mapped_file_addr_ = nullptr;
+  mapped_file_size_ = 0;
+}
+
+void StringDictionary::decodeFrontCoded(const char* data,
+                                        const size_t data_size,
+                                        const size_t str_count,
+                                        const size_t payload_size) {
+  const auto* blocks = reinterpret_cast<const FrontCodedBlock*>(data);
+  const size_t num_blocks =
+      (str_count + kFrontCodingBlockSize - 1) / kFrontCodingBlockSize;
+  const char* strings = data + num_blocks * sizeof(FrontCodedBlock);
+  if (payload_size > str_count * MAX_STRLEN) {
+    throw std::runtime_error("Invalid front-coded dictionary data.");
+  }
+  for (size_t block_idx = 0; block_idx < num_blocks; ++block_idx) {
+    const auto& block = blocks[block_idx];
+    const auto& prev_block = blocks[block_idx ? block_idx - 1 : 0];
+    if (block.data_off > data_size || block.payload_off > payload_size ||
+        (!block_idx && block.payload_off) ||
+        block.data_off < prev_block.data_off ||
+        block.payload_off < prev_block.payload_off) {
+      throw std::runtime_error("Invalid front-coded dictionary data.");
+    }
+  }
+
+  payload_file_size_ = payload_size;
+  payload_file_off_ = payload_size;
+  payload_map_ = static_cast<char*>(malloc(std::max(payload_size, size_t(1))));
+  offset_file_size_ = str_count * sizeof(StringIdxEntry);
+  offset_map_ =
+      static_cast<StringIdxEntry*>(malloc(std::max(offset_file_size_, size_t(1))));
+  CHECK(payload_map_ && offset_map_);
+
+  // Blocks are independent, each of them is decoded into its own part of payload.
+  tbb::parallel_for(
+      tbb::blocked_range<size_t>(0, num_blocks),
+      [&](const tbb::blocked_range<size_t>& r) {
+        for (size_t block_idx = r.begin(); block_idx != r.end(); ++block_idx) {
+          const bool last_block = block_idx + 1 == num_blocks;
+          const char* ptr = strings + blocks[block_idx].data_off;
+          const char* end =
+              strings + (last_block ? data_size : blocks[block_idx + 1].data_off);
+          size_t payload_off = blocks[block_idx].payload_off;
+          const size_t payload_end =
+              last_block ? payload_size : blocks[block_idx + 1].payload_off;
+          const size_t first_id = block_idx * kFrontCodingBlockSize;
+          const size_t end_id = std::min(first_id + kFrontCodingBlockSize, str_count);
+          StringIdxEntry prev{0, 0};
+          for (size_t id = first_id; id < end_id; ++id) {
+            const size_t prefix_len = id == first_id ? 0 : get_varint(ptr, end);
+            const size_t suffix_len = get_varint(ptr, end);
+            if (prefix_len > prev.size || prefix_len + suffix_len > MAX_STRLEN ||
+                suffix_len > static_cast<size_t>(end - ptr) ||
+                payload_off + prefix_len + suffix_len > payload_end) {
+              throw std::runtime_error("Invalid front-coded dictionary data.");
+            }
+            memcpy(payload_map_ + payload_off, payload_map_ + prev.off, prefix_len);
+            memcpy(payload_map_ + payload_off + prefix_len, ptr, suffix_len);
+            ptr += suffix_len;
+            prev = StringIdxEntry{payload_off, prefix_len + suffix_len};
+            offset_map_[id] = prev;
+            payload_off += prefix_len + suffix_len;
+          }
+          if (payload_off != payload_end) {
+            throw std::runtime_error("Invalid front-coded dictionary data.");
+          }
+        }
+      });
+}
+
 void StringDictionary::addPayloadCapacity(const size_t min_capacity_requested) noexcept {
+  detachMappedFile();
   payload_map_ = static_cast<char*>(
       addMemoryCapacity(payload_map_, payload_file_size_, min_capacity_requested));
 }
 
 void StringDictionary::addOffsetCapacity(const size_t min_capacity_requested) noexcept {
+  detachMappedFile();
   offset_map_ = static_cast<StringIdxEntry*>(
       addMemoryCapacity(offset_map_, offset_file_size_, min_capacity_requested));
 }
@@ -1425,6 +1792,31 @@ size_t StringDictionary::buildDictionaryTranslationMap(
           tbb::simple_partitioner());
       num_strings_not_translated_per_thread[0] += num_source_strings;
     } else {
+      // Translation of persisted strings doesn't depend on a query, so it is cached
+      // per destination dictionary. Both dictionaries are append-only, so we only
+      // have to translate source strings added after the cached generation and
+      // re-check previously missing strings if the destination has grown.
+      const auto cache_key = std::make_pair(dest_dict->uid_, dest_dict->dict_ref_);
+      std::shared_ptr<const TranslationCacheEntry> cached;
+      {
+        std::lock_guard<std::mutex> cache_lock(translation_cache_mutex_);
+        auto it = translation_cache_.find(cache_key);
+        if (it != translation_cache_.end()) {
+          cached = it->second;
+        }
+      }
+      const int64_t num_cached_strings =
+          cached ? std::min(num_source_strings,
+                            static_cast<int64_t>(cached->translated_ids.size()))
+                 : 0L;
+      const bool recheck_missing =
+          cached && dest_dict->str_count_ > cached->dest_str_count;
+      const bool update_cache =
+          !cached ||
+          (num_source_strings >= static_cast<int64_t>(cached->translated_ids.size()) &&
+           (num_source_strings > num_cached_strings || recheck_missing));
+      std::vector<int32_t> persisted_ids(update_cache ? num_source_strings : 0);
+
       // The below logic, by executing low-level private variable accesses on both
       // dictionaries, is less clean than a previous variant that simply called
       // `getStringViews` from the source dictionary and then called `getBulk` on the
@@ -1444,19 +1836,30 @@ size_t StringDictionary::buildDictionaryTranslationMap(
                  ++source_string_id) {
               const std::string_view source_str =
                   getStringFromStorageFast(source_string_id);
-              // Get the hash from this/the source dictionary's cache, as the function
-              // will be the same for the dest_dict, sparing us having to recompute it
-
-              // Todo(todd): Remove option to turn string hash cache off or at least
-              // make a constexpr to avoid these branches when we expect it to be always
-              // on going forward
-              const string_dict_hash_t hash = materialize_hashes_
-                                                  ? hash_cache_[source_string_id]
-                                                  : hash_string(source_str);
-              uint32_t hash_bucket = dest_dict->computeBucket(
-                  hash, source_str, dest_dict->string_id_string_dict_hash_table_);
-              const auto translated_string_id =
-                  dest_dict->string_id_string_dict_hash_table_[hash_bucket];
+              int32_t translated_string_id = StringDictionary::INVALID_STR_ID;
+              if (source_string_id < num_cached_strings) {
+                translated_string_id = cached->translated_ids[source_string_id];
+              }
+              if (source_string_id >= num_cached_strings ||
+                  (translated_string_id == StringDictionary::INVALID_STR_ID &&
+                   recheck_missing)) {
+                // Get the hash from this/the source dictionary's cache, as the function
+                // will be the same for the dest_dict, sparing us having to recompute it
+
+                // Todo(todd): Remove option to turn string hash cache off or at least
+                // make a constexpr to avoid these branches when we expect it to be
+                // always on going forward
+                const string_dict_hash_t hash = materialize_hashes_
+                                                    ? hash_cache_[source_string_id]
+                                                    : hash_string(source_str);
+                uint32_t hash_bucket = dest_dict->computeBucket(
+                    hash, source_str, dest_dict->string_id_string_dict_hash_table_);
+                translated_string_id =
+                    dest_dict->string_id_string_dict_hash_table_[hash_bucket];
+              }
+              if (update_cache) {
+                persisted_ids[source_string_id] = translated_string_id;
+              }
               translated_ids[source_string_id] = translated_string_id;
 
               if (translated_string_id == StringDictionary::INVALID_STR_ID ||
@@ -1475,6 +1878,19 @@ size_t StringDictionary::buildDictionaryTranslationMap(
                 num_strings_not_translated;
           },
           tbb::simple_partitioner());
+
+      if (update_cache) {
+        auto entry = std::make_shared<TranslationCacheEntry>();
+        entry->dest_str_count = dest_dict->str_count_;
+        entry->translated_ids = std::move(persisted_ids);
+        std::lock_guard<std::mutex> cache_lock(translation_cache_mutex_);
+        if (!translation_cache_.count(cache_key) &&
+            translation_cache_.size() >= kMaxTranslationCacheEntries) {
+          // Uids grow monotonically, so the first entry is for the oldest destination.
+          translation_cache_.erase(translation_cache_.begin());
+        }
+        translation_cache_[cache_key] = std::move(entry);
+      }
     }
   });
   size_t total_num_strings_not_translated = 0;
@@ -21,12 +21,15 @@
 #include "DictRef.h"
 #include "DictionaryCache.hpp"
 
+#include <atomic>
 #include <functional>
 #include <future>
 #include <map>
+#include <mutex>
 #include <string>
 #include <string_view>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 extern bool g_enable_stringdict_parallel;
@@ -42,6 +45,22 @@ class StringDictionary {
                    size_t initial_capacity = 256);
   ~StringDictionary() noexcept;
 
+  // Create a dictionary from a file written by saveToFile. The file is memory-mapped
+  // read-only, so all dictionaries opened from the same file share one copy of strings
+  // in the page cache, including dictionaries in other processes. Adding a new string
+  // to such a dictionary switches it to a private copy of the data.
+  static std::shared_ptr<StringDictionary> loadFromFile(
+      const DictRef& dict_ref,
+      const std::string& file_name,
+      const bool materializeHashes = false);
+
+  // With front_coded set, strings are written front-coded in small blocks: each string
+  // but the first one in a block is stored as the length of the prefix it shares with
+  // the previous string and the rest of it. Files of dictionaries with long common
+  // prefixes (URLs, paths) get several times smaller, but such a file is decoded into
+  // private memory on load instead of being mapped.
+  void saveToFile(const std::string& file_name, const bool front_coded = false) const;
+
   int32_t getDbId() const noexcept;
   int32_t getDictId() const noexcept;
 
@@ -92,6 +111,12 @@ class StringDictionary {
                                      const char escape,
                                      const size_t generation) const;
 
+  // Return rank of each string id in lexicographical order of strings. Ranks are
+  // dense, so ids can be compared through ranks instead of strings. The sorted
+  // permutation is maintained incrementally and ranks are rebuilt only when new
+  // strings are added. If build is false, return null instead of rebuilding ranks.
+  std::shared_ptr<const std::vector<int32_t>> getSortedRanks(const bool build = true);
+
   std::vector<std::string> copyStrings() const;
 
   std::vector<std::string_view> getStringViews() const;
@@ -147,6 +172,14 @@ class StringDictionary {
   void hashStrings(const std::vector<String>& string_vec,
                    std::vector<string_dict_hash_t>& hashes) const noexcept;
 
+  // Fill ids of empty and already known strings and return indexes of strings which
+  // are not in the dictionary. Only takes the shared lock.
+  template <class T, class String>
+  std::vector<size_t> getExistingBulk(
+      const std::vector<String>& input_strings,
+      const std::vector<string_dict_hash_t>& input_strings_hashes,
+      T* output_string_ids,
+      const bool parallel) const;
   int32_t getUnlocked(const std::string_view sv) const noexcept;
   std::string getStringUnlocked(int32_t string_id) const noexcept;
   std::string getStringChecked(const int string_id) const noexcept;
@@ -178,6 +211,11 @@ class StringDictionary {
                            const size_t sum_new_strings_lengths) noexcept;
   PayloadString getStringFromStorage(const int string_id) const noexcept;
   std::string_view getStringFromStorageFast(const int string_id) const noexcept;
+  void detachMappedFile() noexcept;
+  void decodeFrontCoded(const char* data,
+                        const size_t data_size,
+                        const size_t str_count,
+                        const size_t payload_size);
   void addPayloadCapacity(const size_t min_capacity_requested = 0) noexcept;
   void addOffsetCapacity(const size_t min_capacity_requested = 0) noexcept;
   void* addMemoryCapacity(void* addr,
@@ -192,17 +230,25 @@ class StringDictionary {
   void mergeSortedCache(std::vector<int32_t>& temp_sorted_cache);
 
   const DictRef dict_ref_;
+  // Unique for each dictionary created in the process. Unlike addresses and refs, uids
+  // of dropped dictionaries are never reused by new ones.
+  const uint64_t uid_;
+  static std::atomic<uint64_t> next_uid_;
   size_t str_count_;
   size_t collisions_;
   std::vector<int32_t> string_id_string_dict_hash_table_;
   std::vector<string_dict_hash_t> hash_cache_;
   std::vector<int32_t> sorted_cache;
+  std::shared_ptr<const std::vector<int32_t>> sorted_ranks_;
   bool materialize_hashes_;
   StringIdxEntry* offset_map_;
   char* payload_map_;
   size_t offset_file_size_;
   size_t payload_file_size_;
   size_t payload_file_off_;
+  // Non-null when offsets and payload point to a read-only mapping of a file.
+  void* mapped_file_addr_{nullptr};
+  size_t mapped_file_size_{0};
   mutable mapd_shared_mutex rw_mutex_;
   mutable std::map<std::tuple<std::string, bool, bool, char>, std::vector<int32_t>>
       like_cache_;
@@ -211,6 +257,20 @@ class StringDictionary {
   mutable DictionaryCache<std::string, compare_cache_value_t> compare_cache_;
   mutable std::shared_ptr<std::vector<std::string>> strings_cache_;
 
+  // Translation of persisted strings to other dictionaries keyed by uid and ref of the
+  // destination dictionary. A translated id is INVALID_STR_ID if the string was missing
+  // in the first dest_str_count strings of the destination dictionary. Entries of the
+  // oldest destinations are evicted first, so those of dropped dictionaries go away.
+  struct TranslationCacheEntry {
+    size_t dest_str_count;
+    std::vector<int32_t> translated_ids;
+  };
+  static constexpr size_t kMaxTranslationCacheEntries{16};
+  mutable std::mutex translation_cache_mutex_;
+  mutable std::map<std::pair<uint64_t, DictRef>,
+                   std::shared_ptr<const TranslationCacheEntry>>
+      translation_cache_;
+
   char* CANARY_BUFFER{nullptr};
   size_t canary_buffer_size = 0;
 };
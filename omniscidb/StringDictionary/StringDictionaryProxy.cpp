@@ -25,7 +25,7 @@
 #include "Shared/sqltypes.h"
 #include "Shared/thread_count.h"
 #include "StringDictionary/StringDictionary.h"
-#include "Utils/Regexp.h"
+#include "Utils/RegexpMatcher.h"
 #include "Utils/StringLike.h"
 
 #include <tbb/parallel_for.h>
@@ -353,6 +353,72 @@ StringDictionaryProxy::IdMap StringDictionaryProxy::buildUnionTranslationMapToOt
   return id_map;
 }
 
+StringDictionaryProxy::IdMap StringDictionaryProxy::buildStringOpTranslationMap(
+    const std::function<std::string(const std::string&)>& string_op) {
+  auto timer = DEBUG_TIMER(__func__);
+  std::lock_guard<std::shared_mutex> write_lock(rw_mutex_);
+  auto id_map = initIdMap();
+  const int32_t map_domain_start = id_map.domainStart();
+  const int32_t map_domain_end = id_map.domainEnd();
+
+  std::vector<std::string> transient_results;
+  transient_results.reserve(id_map.numTransients());
+  for (int32_t source_string_id = map_domain_start; source_string_id < -1;
+       ++source_string_id) {
+    transient_results.push_back(string_op(getStringUnlocked(source_string_id)));
+  }
+  std::vector<std::string> stored_results(map_domain_end);
+  tbb::parallel_for(tbb::blocked_range<int32_t>(0, map_domain_end),
+                    [&](const tbb::blocked_range<int32_t>& r) {
+                      for (int32_t string_id = r.begin(); string_id < r.end();
+                           ++string_id) {
+                        stored_results[string_id] =
+                            string_op(string_dict_->getString(string_id));
+                      }
+                    });
+
+  // Resolve results against the dictionary first to keep ids produced by
+  // the string op persistent where possible.
+  string_dict_->getBulk(transient_results, id_map.data(), generation_);
+  string_dict_->getBulk(stored_results, id_map.storageData(), generation_);
+  for (int32_t source_string_id = map_domain_start; source_string_id < -1;
+       ++source_string_id) {
+    if (id_map[source_string_id] == StringDictionary::INVALID_STR_ID) {
+      id_map[source_string_id] = getOrAddTransientUnlocked(
+          transient_results[source_string_id - map_domain_start]);
+    }
+  }
+  for (int32_t source_string_id = 0; source_string_id < map_domain_end;
+       ++source_string_id) {
+    if (id_map[source_string_id] == StringDictionary::INVALID_STR_ID) {
+      id_map[source_string_id] =
+          getOrAddTransientUnlocked(stored_results[source_string_id]);
+    }
+  }
+  return id_map;
+}
+
+StringDictionaryProxy::IdMap StringDictionaryProxy::buildStringToIntMap(
+    const std::function<int32_t(const std::string&)>& int_op) const {
+  auto timer = DEBUG_TIMER(__func__);
+  std::shared_lock<std::shared_mutex> read_lock(rw_mutex_);
+  auto id_map = initIdMap();
+  for (int32_t source_string_id = id_map.domainStart(); source_string_id < -1;
+       ++source_string_id) {
+    id_map[source_string_id] = int_op(getStringUnlocked(source_string_id));
+  }
+  auto stored_results = id_map.storageData();
+  tbb::parallel_for(tbb::blocked_range<int32_t>(0, id_map.domainEnd()),
+                    [&](const tbb::blocked_range<int32_t>& r) {
+                      for (int32_t string_id = r.begin(); string_id < r.end();
+                           ++string_id) {
+                        stored_results[string_id] =
+                            int_op(string_dict_->getString(string_id));
+                      }
+                    });
+  return id_map;
+}
+
 namespace {
 
 bool is_like(const std::string& str,
@@ -430,22 +496,13 @@ std::vector<int32_t> StringDictionaryProxy::getCompare(
   return result;
 }
 
-namespace {
-
-bool is_regexp_like(const std::string& str,
-                    const std::string& pattern,
-                    const char escape) {
-  return regexp_like(str.c_str(), str.size(), pattern.c_str(), pattern.size(), escape);
-}
-
-}  // namespace
-
 std::vector<int32_t> StringDictionaryProxy::getRegexpLike(const std::string& pattern,
                                                           const char escape) const {
   CHECK_GE(generation_, 0);
   auto result = string_dict_->getRegexpLike(pattern, escape, generation_);
+  const RegexpMatcher matcher({pattern});
   for (unsigned index = 0; index < transient_string_vec_.size(); ++index) {
-    if (is_regexp_like(*transient_string_vec_[index], pattern, escape)) {
+    if (matcher.matches(*transient_string_vec_[index])) {
       result.push_back(transientIndexToId(index));
     }
   }
@@ -21,6 +21,7 @@
 #include "Shared/funcannotations.h"
 #include "StringDictionary.h"
 
+#include <functional>
 #include <map>
 #include <optional>
 #include <ostream>
@@ -152,6 +153,27 @@ class StringDictionaryProxy {
 
   IdMap buildUnionTranslationMapToOtherProxy(StringDictionaryProxy* dest_proxy) const;
 
+  /**
+   * @brief Builds a string_id translation map applying string_op to every string
+   * of this proxy (transient and non-transient), with the same layout as
+   * buildIntersectionTranslationMapToOtherProxy.
+   *
+   * Results which are not found in the underlying dictionary (at this proxy's
+   * generation) are added as transients. Such transients are not part of
+   * the returned map domain.
+   */
+  IdMap buildStringOpTranslationMap(
+      const std::function<std::string(const std::string&)>& string_op);
+
+  /**
+   * @brief Builds a map from every string_id of this proxy (transient and
+   * non-transient) to the result of int_op applied to the string, with the same
+   * layout as buildStringOpTranslationMap. Allows kernels to evaluate a
+   * deterministic string function with a single lookup per row.
+   */
+  IdMap buildStringToIntMap(
+      const std::function<int32_t(const std::string&)>& int_op) const;
+
   /**
    * @brief Returns the number of string entries in the underlying string dictionary,
    * at this proxy's generation_ if it is set/valid, otherwise just the current
@@ -951,6 +951,46 @@ TEST_F(MultiFragArrayParallelLinearizationTest, IndexedArrayJoin) {
   }
 }
 
+class MultiFragArrayLinearizationCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    createTable("lin_cache", {{"intv", ctx().arrayVarLen(ctx().int32())}}, {2});
+    insertJsonValues("lin_cache",
+                     R"___({"intv": [1, 2]}
+{"intv": [2]}
+{"intv": [3, 1]}
+{"intv": [1]}
+{"intv": [2, 2]}
+{"intv": [3]})___");
+  }
+
+  void TearDown() override {
+    dropTable("lin_cache");
+    config().exec.enable_linearized_column_cache = true;
+  }
+};
+
+TEST_F(MultiFragArrayLinearizationCacheTest, ReuseAndInvalidate) {
+  const std::string query =
+      "SELECT COUNT(1) FROM lin_cache r, lin_cache s WHERE r.intv[1] = s.intv[1];";
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    // The second run reuses linearized buffers kept by the first one.
+    ASSERT_EQ(v<int64_t>(run_simple_agg(query, dt)), 12);
+    ASSERT_EQ(v<int64_t>(run_simple_agg(query, dt)), 12);
+  }
+
+  // Appended rows make kept buffers stale.
+  insertJsonValues("lin_cache", "{\"intv\": [1]}\n{\"intv\": [4]}");
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    ASSERT_EQ(v<int64_t>(run_simple_agg(query, dt)), 18);
+    config().exec.enable_linearized_column_cache = false;
+    ASSERT_EQ(v<int64_t>(run_simple_agg(query, dt)), 18);
+    config().exec.enable_linearized_column_cache = true;
+  }
+}
+
 int main(int argc, char** argv) {
   g_is_test_env = true;
 
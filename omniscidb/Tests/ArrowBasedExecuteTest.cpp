@@ -18,9 +18,14 @@
 #include "ArrowSQLRunner/SQLiteComparator.h"
 #include "TestHelpers.h"
 
+#include "Logger/Trace.h"
 #include "QueryEngine/ArrowResultSet.h"
 #include "QueryEngine/Execute.h"
+#include "QueryEngine/QueryScheduler.h"
+#include "QueryEngine/RelAlgExecutor.h"
 #include "QueryEngine/ResultSetReductionJIT.h"
+#include "QueryEngine/SharedScans.h"
+#include "Shared/Metrics.h"
 #include "Shared/scope.h"
 
 #include <gtest/gtest.h>
@@ -31,10 +36,12 @@
 #include <boost/crc.hpp>
 #include <boost/program_options.hpp>
 
+#include <atomic>
 #include <cmath>
 #include <cstdio>
 #include <random>
 #include <regex>
+#include <thread>
 
 using namespace std;
 using namespace TestHelpers;
@@ -2320,6 +2327,496 @@ TEST_F(Select, FilterAndSimpleAggregation) {
   }
 }
 
+TEST_F(Select, NonGroupedCountInSharedMemory) {
+  const auto bigint_count = config().exec.group_by.bigint_count;
+  ScopeGuard reset_bigint_count = [bigint_count] {
+    config().exec.group_by.bigint_count = bigint_count;
+  };
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+
+    // Filters leave only some threads of a warp active for the count.
+    for (bool use_bigint_count : {false, true}) {
+      config().exec.group_by.bigint_count = use_bigint_count;
+      c("SELECT COUNT(*) FROM test;", dt);
+      c("SELECT COUNT(*) FROM test WHERE x = 7;", dt);
+      c("SELECT COUNT(*) FROM test WHERE y <> 43;", dt);
+      c("SELECT COUNT(*), COUNT(x) FROM test WHERE z > 100 OR x < 8;", dt);
+      c("SELECT COUNT(*) FROM test WHERE x > 1000;", dt);
+    }
+  }
+}
+
+TEST_F(Select, RuntimeInterruptChecks) {
+  const auto interrupt_state = config().exec.interrupt;
+  ScopeGuard reset_interrupt_state = [&interrupt_state] {
+    config().exec.interrupt = interrupt_state;
+  };
+  config().exec.interrupt.enable_runtime_query_interrupt = true;
+  // Not a power of two, rounded down to 4 rows.
+  config().exec.interrupt.cpu_check_interval = 5;
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    c("SELECT COUNT(*) FROM test WHERE x > 7;", dt);
+    c("SELECT SUM(x + y), MIN(z) FROM test;", dt);
+    c("SELECT x, COUNT(*) FROM test GROUP BY x ORDER BY x;", dt);
+    c("SELECT x, y FROM test WHERE z > 100 ORDER BY x, y;", dt);
+  }
+}
+
+TEST_F(Select, QueryProfile) {
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+
+    const char* query = "SELECT x, COUNT(*) FROM test GROUP BY x ORDER BY x;";
+    EXPECT_FALSE(runSqlQuery(query, dt, getExecutionOptions(true)).getProfile());
+
+    auto eo = getExecutionOptions(true);
+    eo.with_profile = true;
+    auto res = runSqlQuery(query, dt, eo);
+    auto profile = res.getProfile();
+    ASSERT_TRUE(profile);
+    auto steps = profile->steps();
+    ASSERT_FALSE(steps.empty());
+    EXPECT_FALSE(steps.front().kernels.empty());
+    EXPECT_EQ(steps.front().input_rows,
+              static_cast<size_t>(
+                  v<int64_t>(run_simple_agg("SELECT COUNT(*) FROM test;", dt))));
+    EXPECT_EQ(steps.back().output_rows, res.getRows()->rowCount());
+    EXPECT_NE(profile->toString().find("Step 0"), std::string::npos);
+  }
+}
+
+TEST_F(Select, Metrics) {
+  auto sum_samples = [](const std::string& prefix) {
+    double res = 0;
+    for (auto& [name, val] : metrics::Registry::get().snapshot()) {
+      if (name.rfind(prefix, 0) == 0) {
+        res += val;
+      }
+    }
+    return res;
+  };
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+
+    const char* query = "SELECT x, COUNT(*) FROM test GROUP BY x ORDER BY x;";
+    runSqlQuery(query, dt, getExecutionOptions(true));
+    const auto queries = sum_samples("hdk_query_duration_seconds_count");
+    const auto code_cache_hits = sum_samples("hdk_code_cache_hits_total");
+    runSqlQuery(query, dt, getExecutionOptions(true));
+    EXPECT_EQ(sum_samples("hdk_query_duration_seconds_count"), queries + 1);
+    EXPECT_GT(sum_samples("hdk_code_cache_hits_total"), code_cache_hits);
+    EXPECT_NE(metrics::Registry::get().toPrometheusText().find(
+                  "# TYPE hdk_query_duration_seconds histogram"),
+              std::string::npos);
+  }
+}
+
+TEST_F(Select, TieredCompilation) {
+  const auto enable_tiered = config().exec.codegen.enable_tiered_compilation;
+  const auto hot_threshold = config().exec.codegen.tiered_compilation_hot_threshold;
+  ScopeGuard reset_tiered = [enable_tiered, hot_threshold] {
+    config().exec.codegen.enable_tiered_compilation = enable_tiered;
+    config().exec.codegen.tiered_compilation_hot_threshold = hot_threshold;
+  };
+  config().exec.codegen.enable_tiered_compilation = true;
+  config().exec.codegen.tiered_compilation_hot_threshold = 2;
+  auto recompilations = [] {
+    double res = 0;
+    for (auto& [name, val] : metrics::Registry::get().snapshot()) {
+      if (name.rfind("hdk_hot_code_recompilations_total", 0) == 0) {
+        res += val;
+      }
+    }
+    return res;
+  };
+  const auto dt = ExecutorDeviceType::CPU;
+  const char* query = "SELECT SUM(x * 2 + y) FROM test WHERE z > 0;";
+  // Start with an empty code cache, so the kernel is compiled at the fast tier.
+  Executor::cpu_code_accessor->clear();
+  const auto expected = v<int64_t>(run_simple_agg(query, dt));
+  const auto initial_recompilations = recompilations();
+  // Optimized code is compiled in background once, when cached code hits the
+  // threshold. Results must not change when the cached code is replaced.
+  for (size_t i = 0; i < 2; ++i) {
+    EXPECT_EQ(expected, v<int64_t>(run_simple_agg(query, dt)));
+  }
+  for (size_t i = 0; i < 1000 && recompilations() == initial_recompilations; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_EQ(recompilations(), initial_recompilations + 1);
+  for (size_t i = 0; i < 3; ++i) {
+    EXPECT_EQ(expected, v<int64_t>(run_simple_agg(query, dt)));
+  }
+  EXPECT_EQ(recompilations(), initial_recompilations + 1);
+}
+
+TEST_F(Select, ExpressionCounters) {
+  const auto enable_counters = config().exec.codegen.enable_expression_counters;
+  ScopeGuard reset_counters = [enable_counters] {
+    config().exec.codegen.enable_expression_counters = enable_counters;
+  };
+  config().exec.codegen.enable_expression_counters = true;
+  auto sum_samples = [](const std::string& prefix) {
+    double res = 0;
+    for (auto& [name, val] : metrics::Registry::get().snapshot()) {
+      if (name.rfind(prefix, 0) == 0) {
+        res += val;
+      }
+    }
+    return res;
+  };
+  const auto dt = ExecutorDeviceType::CPU;
+  const std::string filter_prefix =
+      "hdk_expression_evaluations_total{kind=\"filter\"";
+  const std::string target_prefix =
+      "hdk_expression_evaluations_total{kind=\"target\"";
+  const auto passed_rows =
+      v<int64_t>(run_simple_agg("SELECT COUNT(*) FROM test WHERE x > 7;", dt));
+  const auto filter_evals = sum_samples(filter_prefix);
+  const auto target_evals = sum_samples(target_prefix);
+  runSqlQuery("SELECT SUM(y) FROM test WHERE x > 7;", dt, getExecutionOptions(true));
+  EXPECT_GT(sum_samples(filter_prefix), filter_evals);
+  EXPECT_EQ(sum_samples(target_prefix) - target_evals, passed_rows);
+}
+
+TEST_F(Select, Trace) {
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+
+    const char* query = "SELECT x, COUNT(*) FROM test GROUP BY x ORDER BY x;";
+    runSqlQuery(query, dt, getExecutionOptions(true));
+    EXPECT_EQ(trace::stop().find("\"kernel\""), std::string::npos);
+
+    trace::start();
+    runSqlQuery(query, dt, getExecutionOptions(true));
+    auto json = trace::stop();
+    EXPECT_NE(json.find("\"traceEvents\""), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"kernel\""), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"fetch\""), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"reduction\""), std::string::npos);
+    if (dt == ExecutorDeviceType::GPU) {
+      EXPECT_NE(json.find("\"GPU 0\""), std::string::npos);
+    }
+  }
+}
+
+TEST_F(Select, ColumnRangesOnAppend) {
+  createTable("col_range_test",
+              {{"x", ctx().int32()}, {"d", ctx().fp64()}},
+              ArrowStorage::TableOptions{3});
+  ScopeGuard drop_table = [] { dropTable("col_range_test"); };
+
+  auto check = [](int64_t min_x, int64_t max_x, int64_t distinct_x, double max_d) {
+    for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+      SKIP_NO_GPU();
+      EXPECT_EQ(min_x,
+                v<int64_t>(run_simple_agg("SELECT MIN(x) FROM col_range_test;", dt)));
+      EXPECT_EQ(max_x,
+                v<int64_t>(run_simple_agg("SELECT MAX(x) FROM col_range_test;", dt)));
+      EXPECT_EQ(distinct_x,
+                v<int64_t>(run_simple_agg(
+                    "SELECT COUNT(DISTINCT x) FROM col_range_test;", dt)));
+      EXPECT_EQ(max_d,
+                v<double>(run_simple_agg("SELECT MAX(d) FROM col_range_test;", dt)));
+      auto rows = run_multiple_agg(
+          "SELECT x, COUNT(*) FROM col_range_test GROUP BY x ORDER BY x;", dt);
+      EXPECT_EQ(rows->rowCount(), static_cast<size_t>(distinct_x));
+    }
+  };
+
+  insertCsvValues("col_range_test", "1,1.5\n2,2.5");
+  check(1, 2, 2, 2.5);
+  // The last fragment is extended.
+  insertCsvValues("col_range_test", "10,0.5");
+  check(1, 10, 3, 2.5);
+  // New fragments are added.
+  insertCsvValues("col_range_test", "-5,3.5\n7,1.0\n10,4.5\n100,0.0");
+  check(-5, 100, 6, 4.5);
+  // Repeated queries over unchanged data.
+  check(-5, 100, 6, 4.5);
+
+  config().cache.reuse_col_ranges = false;
+  ScopeGuard reset_config = [] { config().cache.reuse_col_ranges = true; };
+  check(-5, 100, 6, 4.5);
+}
+
+TEST_F(Select, ContinuousQuery) {
+  ArrowStorage::TableOptions opts;
+  opts.is_stream = true;
+  createTable("stream_test", {{"x", ctx().int32()}, {"y", ctx().int64()}}, opts);
+  ScopeGuard drop_table = [] { dropTable("stream_test"); };
+
+  const auto co = getCompilationOptions(ExecutorDeviceType::CPU);
+  const auto eo = getExecutionOptions(true);
+  auto agg_query =
+      makeRelAlgExecutor("SELECT x, COUNT(*), SUM(y) FROM stream_test GROUP BY x;");
+  auto proj_query = makeRelAlgExecutor("SELECT x, y FROM stream_test WHERE y > 1;");
+  EXPECT_EQ(agg_query->prepareStreamExecution(co, eo)->name, "stream_test");
+  proj_query->prepareStreamExecution(co, eo);
+  EXPECT_THROW(
+      makeRelAlgExecutor("SELECT COUNT(*) FROM test;")->prepareStreamExecution(co, eo),
+      std::runtime_error);
+
+  using AggValues = std::map<int64_t, std::pair<int64_t, int64_t>>;
+  auto get_agg_values = [](const ExecutionResult& res) {
+    AggValues vals;
+    auto rows = res.getRows();
+    for (auto row = rows->getNextRow(true, true); !row.empty();
+         row = rows->getNextRow(true, true)) {
+      vals[v<int64_t>(row[0])] = {v<int64_t>(row[1]), v<int64_t>(row[2])};
+    }
+    return vals;
+  };
+  auto push = [&](const std::string& values) {
+    insertCsvValues("stream_test", values);
+    agg_query->runOnNewBatches();
+    proj_query->runOnNewBatches();
+  };
+
+  push("1,1\n2,2\n1,3");
+  EXPECT_EQ(get_agg_values(agg_query->pollStreamExecution()),
+            (AggValues{{1, {2, 4}}, {2, {1, 2}}}));
+  EXPECT_EQ(proj_query->pollStreamExecution().getRows()->rowCount(), size_t(2));
+
+  push("2,4\n3,5");
+  const AggValues expected{{1, {2, 4}}, {2, {2, 6}}, {3, {1, 5}}};
+  EXPECT_EQ(get_agg_values(agg_query->pollStreamExecution()), expected);
+  // Polls without new batches don't aggregate processed batches again.
+  EXPECT_EQ(get_agg_values(agg_query->pollStreamExecution()), expected);
+  EXPECT_EQ(proj_query->pollStreamExecution().getRows()->rowCount(), size_t(2));
+
+  EXPECT_EQ(get_agg_values(agg_query->finishStreamExecution()), expected);
+  EXPECT_EQ(proj_query->finishStreamExecution().getRows()->rowCount(), size_t(0));
+  EXPECT_THROW(agg_query->pollStreamExecution(), std::runtime_error);
+}
+
+TEST_F(Select, JoinMultiFragmentInnerColumn) {
+  // A single insert makes fragments adjacent slices of one Arrow chunk, separate
+  // inserts make fragments in different buffers.
+  createTable("join_frag_outer", {{"k", ctx().int32()}});
+  createTable("join_frag_adjacent", {{"k", ctx().int32()}, {"v", ctx().int64()}}, {2});
+  createTable("join_frag_separate", {{"k", ctx().int32()}, {"v", ctx().int64()}}, {2});
+  ScopeGuard drop_tables = [] {
+    dropTable("join_frag_outer");
+    dropTable("join_frag_adjacent");
+    dropTable("join_frag_separate");
+  };
+  insertCsvValues("join_frag_outer", "1\n2\n3\n4\n5\n6\n7\n8\n3\n5");
+  insertCsvValues("join_frag_adjacent", "1,10\n2,20\n3,30\n4,40\n5,50");
+  insertCsvValues("join_frag_separate", "1,10\n2,20\n3,30");
+  insertCsvValues("join_frag_separate", "4,40");
+  insertCsvValues("join_frag_separate", "5,50");
+
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    for (auto inner : {"join_frag_adjacent", "join_frag_separate"}) {
+      const auto query = "SELECT COUNT(*), SUM(o.k * i.v) FROM join_frag_outer o JOIN "s +
+                         inner + " i ON o.k = i.k;";
+      const auto row = run_multiple_agg(query, dt)->getNextRow(true, true);
+      ASSERT_EQ(row.size(), size_t(2));
+      EXPECT_EQ(v<int64_t>(row[0]), 7);
+      EXPECT_EQ(v<int64_t>(row[1]), 890);
+    }
+  }
+}
+
+TEST_F(Select, GroupByFirstTouchInit) {
+  createTable("sparse_groups", {{"k", ctx().int32()}, {"v", ctx().int64()}}, {2});
+  ScopeGuard drop_table = [] { dropTable("sparse_groups"); };
+  insertCsvValues("sparse_groups",
+                  "1,10\n50000,20\n99999,30\n1,40\n50000,50\n7,60\n99999,70");
+  const auto enable_lazy_init = config().rs.enable_lazy_group_init;
+  const auto lazy_init_threshold = config().rs.lazy_group_init_threshold;
+  ScopeGuard reset_lazy_init = [enable_lazy_init, lazy_init_threshold] {
+    config().rs.enable_lazy_group_init = enable_lazy_init;
+    config().rs.lazy_group_init_threshold = lazy_init_threshold;
+  };
+  config().rs.lazy_group_init_threshold = 0;
+
+  const std::vector<std::vector<int64_t>> expected{{1, 2, 50, 10, 40},
+                                                   {7, 1, 60, 60, 60},
+                                                   {50000, 2, 70, 20, 50},
+                                                   {99999, 2, 100, 30, 70}};
+  for (auto enable : {true, false}) {
+    config().rs.enable_lazy_group_init = enable;
+    for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+      SKIP_NO_GPU();
+      const auto rows = run_multiple_agg(
+          "SELECT k, COUNT(*), SUM(v), MIN(v), MAX(v) FROM sparse_groups GROUP BY k "
+          "ORDER BY k;",
+          dt);
+      ASSERT_EQ(rows->rowCount(), expected.size());
+      for (const auto& expected_row : expected) {
+        const auto row = rows->getNextRow(true, true);
+        ASSERT_EQ(row.size(), expected_row.size());
+        for (size_t i = 0; i < row.size(); ++i) {
+          EXPECT_EQ(v<int64_t>(row[i]), expected_row[i]);
+        }
+      }
+    }
+  }
+}
+
+TEST_F(Select, FragmentQualElimination) {
+  createTable("qual_elim",
+              {{"x", ctx().int32()},
+               {"y", ctx().int32()},
+               {"m", ctx().timestamp(hdk::ir::TimeUnit::kSecond)}},
+              {3});
+  ScopeGuard drop_table = [] { dropTable("qual_elim"); };
+  insertCsvValues("qual_elim",
+                  "1,10,2020-01-01 00:00:01\n"
+                  "2,20,2020-01-01 00:00:02\n"
+                  "3,30,2020-01-01 00:00:03\n"
+                  "4,40,2020-01-01 00:00:04\n"
+                  "5,50,2020-01-01 00:00:05\n"
+                  "6,60,2020-01-01 00:00:06\n"
+                  "7,70,2020-01-01 00:00:07\n"
+                  "8,,2020-01-01 00:00:08\n"
+                  "9,90,2020-01-01 00:00:09");
+  const auto enable_elimination = config().exec.enable_fragment_qual_elimination;
+  ScopeGuard reset_elimination = [enable_elimination] {
+    config().exec.enable_fragment_qual_elimination = enable_elimination;
+  };
+
+  for (auto enable : {true, false}) {
+    config().exec.enable_fragment_qual_elimination = enable;
+    for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+      SKIP_NO_GPU();
+      EXPECT_EQ(6,
+                v<int64_t>(run_simple_agg(
+                    "SELECT COUNT(*) FROM qual_elim WHERE x >= 4;", dt)));
+      // The last fragment has a null in y, so y > 5 is kept there.
+      EXPECT_EQ(340,
+                v<int64_t>(run_simple_agg(
+                    "SELECT SUM(y) FROM qual_elim WHERE x > 2 AND y > 5;", dt)));
+      EXPECT_EQ(9,
+                v<int64_t>(run_simple_agg(
+                    "SELECT COUNT(*) FROM qual_elim WHERE x <> 100;", dt)));
+      EXPECT_EQ(8,
+                v<int64_t>(run_simple_agg(
+                    "SELECT COUNT(*) FROM qual_elim WHERE x <> 5;", dt)));
+      EXPECT_EQ(5,
+                v<int64_t>(run_simple_agg(
+                    "SELECT COUNT(*) FROM qual_elim WHERE m >= TIMESTAMP "
+                    "'2020-01-01 00:00:04' AND m < TIMESTAMP '2020-01-01 00:00:09';",
+                    dt)));
+      EXPECT_EQ(22,
+                v<int64_t>(run_simple_agg("SELECT SUM(x) FROM qual_elim WHERE x > 3 AND "
+                                          "y > 0 GROUP BY x / 4 ORDER BY 1 DESC "
+                                          "LIMIT 1;",
+                                          dt)));
+    }
+  }
+}
+
+TEST_F(Select, StatsNullCheckElimination) {
+  createTable("null_elim",
+              {{"x", ctx().int32()}, {"y", ctx().int32()}, {"d", ctx().fp64()}},
+              {2});
+  ScopeGuard drop_table = [] { dropTable("null_elim"); };
+  insertCsvValues("null_elim",
+                  "1,1,0.5\n"
+                  "2,,1.5\n"
+                  "3,3,2.5\n"
+                  "4,4,3.5\n"
+                  "5,5,4.5");
+  const auto enable_elimination =
+      config().exec.codegen.enable_stats_null_check_elimination;
+  ScopeGuard reset_elimination = [enable_elimination] {
+    config().exec.codegen.enable_stats_null_check_elimination = enable_elimination;
+  };
+
+  for (auto enable : {true, false}) {
+    config().exec.codegen.enable_stats_null_check_elimination = enable;
+    for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+      SKIP_NO_GPU();
+      EXPECT_EQ(3,
+                v<int64_t>(run_simple_agg(
+                    "SELECT COUNT(*) FROM null_elim WHERE x > 2;", dt)));
+      EXPECT_EQ(3,
+                v<int64_t>(run_simple_agg(
+                    "SELECT COUNT(*) FROM null_elim WHERE y > 2;", dt)));
+      EXPECT_EQ(3,
+                v<int64_t>(run_simple_agg(
+                    "SELECT COUNT(*) FROM null_elim WHERE x + d > 5;", dt)));
+      EXPECT_EQ(4,
+                v<int64_t>(run_simple_agg(
+                    "SELECT COUNT(*) FROM null_elim WHERE x = y;", dt)));
+      EXPECT_EQ(12,
+                v<int64_t>(run_simple_agg(
+                    "SELECT SUM(x) FROM null_elim WHERE x >= 3 OR x IS NULL;", dt)));
+    }
+  }
+}
+
+TEST_F(Select, CompressedColumns) {
+  createTable("narrow_range",
+              {{"i", ctx().int32()},
+               {"b", ctx().int64()},
+               {"t", ctx().timestamp(hdk::ir::TimeUnit::kSecond)}},
+              {2});
+  ScopeGuard drop_table = [] { dropTable("narrow_range"); };
+  insertCsvValues("narrow_range",
+                  "7,1000000,2020-01-01 00:00:00\n"
+                  "9,1000200,2020-01-01 00:01:00\n"
+                  ",1000100,\n"
+                  "8,,2020-01-01 00:02:00\n"
+                  "7,1000050,2020-01-01 00:03:00");
+  const auto enable_cpu_compression = config().exec.enable_cpu_compressed_columns;
+  const auto enable_gpu_compression = config().exec.enable_gpu_compressed_transfer;
+  ScopeGuard reset_compression = [enable_cpu_compression, enable_gpu_compression] {
+    config().exec.enable_cpu_compressed_columns = enable_cpu_compression;
+    config().exec.enable_gpu_compressed_transfer = enable_gpu_compression;
+  };
+
+  auto check = [](const std::vector<int64_t>& expected) {
+    for (auto enable : {true, false}) {
+      config().exec.enable_cpu_compressed_columns = enable;
+      config().exec.enable_gpu_compressed_transfer = enable;
+      for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+        SKIP_NO_GPU();
+        const auto rows = run_multiple_agg(
+            "SELECT COUNT(i), SUM(i), COUNT(b), SUM(b), MIN(b), MAX(b), "
+            "SUM(CASE WHEN b > 1000060 THEN 1 ELSE 0 END), "
+            "MAX(EXTRACT(MINUTE FROM t)) FROM narrow_range;",
+            dt);
+        ASSERT_EQ(rows->rowCount(), size_t(1));
+        const auto row = rows->getNextRow(true, true);
+        ASSERT_EQ(row.size(), expected.size());
+        for (size_t i = 0; i < row.size(); ++i) {
+          EXPECT_EQ(v<int64_t>(row[i]), expected[i]);
+        }
+      }
+    }
+  };
+  check({4, 31, 4, 4000350, 1000000, 1000200, 2, 3});
+  // Appended rows extend the range and the last fragment, previously encoded
+  // fragments must not be reused.
+  insertCsvValues("narrow_range", "-5,999000,2020-01-01 00:04:00");
+  check({5, 26, 5, 4999350, 999000, 1000200, 2, 4});
+}
+
+TEST_F(Select, GpuLaunchAutotuning) {
+  const auto enable_autotuning = config().exec.enable_gpu_launch_autotuning;
+  ScopeGuard reset_autotuning = [enable_autotuning] {
+    config().exec.enable_gpu_launch_autotuning = enable_autotuning;
+  };
+  config().exec.enable_gpu_launch_autotuning = true;
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+
+    // Repeated runs go through all candidate grid sizes and then reuse the best one.
+    for (int i = 0; i < 5; ++i) {
+      c("SELECT COUNT(*), SUM(x), MIN(y), MAX(z) FROM test;", dt);
+      c("SELECT AVG(x + y), SUM(f), MAX(d) FROM test WHERE z > 100;", dt);
+      c("SELECT COUNT(DISTINCT x), COUNT(DISTINCT y) FROM test;", dt);
+    }
+  }
+}
+
 TEST_F(Select, AggregateOnEmptyDecimalColumn) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -2585,6 +3082,29 @@ TEST_F(Select, FilterShortCircuit) {
   }
 }
 
+TEST_F(Select, FilterReordering) {
+  const auto enable_filter_reordering = config().opts.enable_filter_reordering;
+  ScopeGuard reset = [enable_filter_reordering] {
+    config().opts.enable_filter_reordering = enable_filter_reordering;
+  };
+
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    for (bool enable : {false, true}) {
+      config().opts.enable_filter_reordering = enable;
+      c("SELECT COUNT(*) FROM test WHERE UNLIKELY(t < 1005) AND (str LIKE 'f__%%') AND "
+        "(real_str LIKE '%real%') AND x > 7;",
+        dt);
+      c("SELECT COUNT(*) FROM test WHERE (real_str LIKE '%nope%') AND (str LIKE 'f%') "
+        "AND (str LIKE 'b%');",
+        dt);
+      c("SELECT x, COUNT(*) FROM test WHERE UNLIKELY(x < 8) AND (str LIKE '%o%') AND "
+        "y <> 42 AND z > 100 GROUP BY x ORDER BY x;",
+        dt);
+    }
+  }
+}
+
 TEST_F(Select, InValues) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -2598,6 +3118,19 @@ TEST_F(Select, InValues) {
       dt);
     c(R"(WITH dimensionValues AS (SELECT b FROM test GROUP BY b ORDER BY b) SELECT x FROM test WHERE b in (SELECT b FROM dimensionValues) GROUP BY x ORDER BY x;)",
       dt);
+    // Sparse values are stored in a hash set instead of a bitmap.
+    c("SELECT COUNT(*) FROM test WHERE x IN (7, 8, -2000000000, 1000000000, "
+      "2000000000);",
+      dt);
+    c("SELECT COUNT(*) FROM test WHERE t IN (1001, 1002, -9000000000000000000, "
+      "9000000000000000000, 5);",
+      dt);
+    c("SELECT t FROM test WHERE t NOT IN (1001, -9000000000000000000, "
+      "9000000000000000000, 5, NULL) GROUP BY t ORDER BY t;",
+      dt);
+    c("SELECT x, COUNT(*) FROM test WHERE x NOT IN (9, 10, 11, -1000000000, "
+      "1000000000) GROUP BY x ORDER BY x;",
+      dt);
   }
 }
 
@@ -2614,6 +3147,23 @@ TEST_F(Select, FilterAndMultipleAggregation) {
   }
 }
 
+TEST_F(Select, FilterAndAggregation_LoopVectorization) {
+  const auto enable_vectorization = config().exec.codegen.enable_loop_vectorization;
+  ScopeGuard reset = [enable_vectorization] {
+    config().exec.codegen.enable_loop_vectorization = enable_vectorization;
+  };
+  config().exec.codegen.enable_loop_vectorization = true;
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    c("SELECT SUM(x + y), MIN(z), MAX(t), COUNT(*) FROM test WHERE x > 7 OR y < 43;",
+      dt);
+    c("SELECT SUM(d * 3), AVG(f), COUNT(ofd) FROM test WHERE z <> 101 AND x < 8;", dt);
+    c("SELECT x * 3 + y AS v FROM test WHERE z - 1 > 100 ORDER BY v;", dt);
+    c("SELECT x, SUM(y * 2), COUNT(*) FROM test WHERE t > 1000 GROUP BY x ORDER BY x;",
+      dt);
+  }
+}
+
 TEST_F(Select, GroupBy) {
   {  // generate dataset to test count distinct rewrite
     createTable("count_distinct_rewrite", {{"v1", ctx().int32()}});
@@ -2741,6 +3291,84 @@ TEST_F(Select, GroupBy) {
       c("SELECT d, COUNT(*) FROM test GROUP BY d ORDER BY d DESC LIMIT 10;", dt);
     }
 
+    {
+      const auto partitioned_reduction_threshold =
+          config().exec.group_by.partitioned_reduction_threshold;
+      ScopeGuard reset_partitioned_reduction_threshold =
+          [&partitioned_reduction_threshold] {
+            config().exec.group_by.partitioned_reduction_threshold =
+                partitioned_reduction_threshold;
+          };
+      config().exec.group_by.partitioned_reduction_threshold = 0;
+      c("SELECT x, COUNT(*), SUM(y), MIN(d), MAX(f) FROM test GROUP BY x ORDER BY x;",
+        dt);
+      c("SELECT x, y, AVG(z) FROM test GROUP BY x, y ORDER BY x, y;", dt);
+      c("SELECT x, COUNT(DISTINCT y) FROM test GROUP BY x ORDER BY x;", dt);
+    }
+
+    {
+      const auto enable_streaming_reduction =
+          config().exec.group_by.enable_streaming_reduction;
+      ScopeGuard reset_streaming_reduction = [&enable_streaming_reduction] {
+        config().exec.group_by.enable_streaming_reduction = enable_streaming_reduction;
+      };
+      config().exec.group_by.enable_streaming_reduction = true;
+      c("SELECT x, COUNT(*), SUM(y), MIN(d), MAX(f) FROM test GROUP BY x ORDER BY x;",
+        dt);
+      c("SELECT x, COUNT(DISTINCT y) FROM test GROUP BY x ORDER BY x;", dt);
+    }
+
+    {
+      const auto sub_tasks = config().exec.sub_tasks;
+      ScopeGuard reset_sub_tasks = [&sub_tasks] { config().exec.sub_tasks = sub_tasks; };
+      config().exec.sub_tasks.enable = true;
+      config().exec.sub_tasks.min_sub_task_size = 1;
+      c("SELECT x, COUNT(*), SUM(y), MIN(d), MAX(f) FROM test GROUP BY x ORDER BY x;",
+        dt);
+      c("SELECT str, COUNT(*) FROM test GROUP BY str ORDER BY str;", dt);
+    }
+
+    {
+      const auto scheduler = config().exec.scheduler;
+      ScopeGuard reset_scheduler = [&scheduler] { config().exec.scheduler = scheduler; };
+      config().exec.scheduler.max_cpu_queries = 0;
+      config().exec.scheduler.max_gpu_queries = 0;
+      config().exec.scheduler.cpu_memory_budget = 1;
+      config().exec.scheduler.gpu_memory_budget = 1;
+      c("SELECT x, COUNT(*), SUM(y) FROM test GROUP BY x ORDER BY x;", dt);
+      EXPECT_EQ(QueryScheduler::get().getRunningQueries(dt), size_t(0));
+      EXPECT_EQ(QueryScheduler::get().getReservedMemory(dt), size_t(0));
+    }
+
+    {
+      const auto cpu_threads_per_query = config().exec.cpu_threads_per_query;
+      ScopeGuard reset_cpu_threads = [&cpu_threads_per_query] {
+        config().exec.cpu_threads_per_query = cpu_threads_per_query;
+      };
+      config().exec.cpu_threads_per_query = 2;
+      c("SELECT x, COUNT(*), SUM(y) FROM test GROUP BY x ORDER BY x;", dt);
+      c("SELECT y, AVG(x) FROM test GROUP BY y ORDER BY y;", dt);
+    }
+
+    {
+      const auto enable_partitioned_aggregation =
+          config().exec.group_by.enable_partitioned_aggregation;
+      const auto partitioned_aggregation_max_groups =
+          config().exec.group_by.partitioned_aggregation_max_groups;
+      ScopeGuard reset_partitioned_aggregation = [&] {
+        config().exec.group_by.enable_partitioned_aggregation =
+            enable_partitioned_aggregation;
+        config().exec.group_by.partitioned_aggregation_max_groups =
+            partitioned_aggregation_max_groups;
+      };
+      config().exec.group_by.enable_partitioned_aggregation = true;
+      config().exec.group_by.partitioned_aggregation_max_groups = 1000;
+      c("SELECT x, y, COUNT(*), SUM(z) FROM test GROUP BY x, y ORDER BY x, y;", dt);
+      c("SELECT str, MIN(x), MAX(y) FROM test GROUP BY str ORDER BY str;", dt);
+      c("SELECT ofd, COUNT(*) FROM test GROUP BY ofd ORDER BY ofd;", dt);
+      c("SELECT COUNT(*) FROM (SELECT x, COUNT(*) AS n FROM test GROUP BY x);", dt);
+    }
+
     if (config().rs.enable_columnar_output) {
       // TODO: Fixup the tests below when running with columnar output enabled
       continue;
@@ -2808,6 +3436,127 @@ TEST_F(Select, GroupBy) {
   dropTable("count_distinct_rewrite");
 }
 
+TEST_F(Select, PerDeviceQueryAdmission) {
+  auto& scheduler = QueryScheduler::get();
+  QuerySchedulerConfig scheduler_config;
+  scheduler_config.max_gpu_queries = 1;
+  const QueryScheduler::Device gpu0{ExecutorDeviceType::GPU, 0};
+  const QueryScheduler::Device gpu1{ExecutorDeviceType::GPU, 1};
+
+  auto ticket0 = scheduler.admit(scheduler_config, {gpu0}, 10, 0);
+  // Another device is not blocked by the running query.
+  auto ticket1 = scheduler.admit(scheduler_config, {gpu1}, 20, 0);
+  EXPECT_EQ(scheduler.getRunningQueries(ExecutorDeviceType::GPU), size_t(2));
+  EXPECT_EQ(scheduler.getRunningQueries(gpu0), size_t(1));
+  EXPECT_EQ(scheduler.getReservedMemory(gpu1), size_t(20));
+
+  // Queries on a busy device wait for it.
+  std::atomic<bool> admitted{false};
+  std::thread waiting_query([&]() {
+    auto ticket = scheduler.admit(scheduler_config, {gpu0, gpu1}, 30, 0);
+    admitted = true;
+  });
+  while (scheduler.getWaitingQueries(ExecutorDeviceType::GPU) != 2) {
+    std::this_thread::yield();
+  }
+  ticket0.reset();
+  EXPECT_FALSE(admitted);
+  ticket1.reset();
+  waiting_query.join();
+  EXPECT_TRUE(admitted);
+  EXPECT_EQ(scheduler.getRunningQueries(ExecutorDeviceType::GPU), size_t(0));
+  EXPECT_EQ(scheduler.getWaitingQueries(ExecutorDeviceType::GPU), size_t(0));
+  EXPECT_EQ(scheduler.getReservedMemory(ExecutorDeviceType::GPU), size_t(0));
+}
+
+TEST_F(Select, QueryPreemption) {
+  auto& scheduler = QueryScheduler::get();
+  QuerySchedulerConfig scheduler_config;
+  scheduler_config.max_gpu_queries = 1;
+  const QueryScheduler::Device gpu0{ExecutorDeviceType::GPU, 0};
+
+  auto batch_ticket = scheduler.admit(scheduler_config, {gpu0}, 10, 0);
+  // Preemption is disabled by default.
+  EXPECT_FALSE(scheduler.preempt(scheduler_config, *batch_ticket));
+  scheduler_config.enable_preemption = true;
+  // Nobody waits for the device.
+  EXPECT_FALSE(scheduler.preempt(scheduler_config, *batch_ticket));
+
+  std::atomic<bool> admitted{false};
+  std::thread interactive_query([&]() {
+    auto ticket = scheduler.admit(scheduler_config, {gpu0}, 20, 1);
+    admitted = true;
+  });
+  while (scheduler.getWaitingQueries(gpu0.first) != 1) {
+    std::this_thread::yield();
+  }
+  // The query of higher priority takes the slot, the memory stays reserved.
+  EXPECT_TRUE(scheduler.preempt(scheduler_config, *batch_ticket));
+  EXPECT_TRUE(scheduler.preempt(scheduler_config, *batch_ticket));
+  interactive_query.join();
+  EXPECT_TRUE(admitted);
+  EXPECT_EQ(scheduler.getPreemptedQueries(), size_t(1));
+  EXPECT_EQ(scheduler.getReservedMemory(gpu0), size_t(10));
+
+  scheduler.resume(scheduler_config, *batch_ticket);
+  EXPECT_EQ(scheduler.getPreemptedQueries(), size_t(0));
+  EXPECT_EQ(scheduler.getRunningQueries(gpu0), size_t(1));
+
+  // Queries of the same priority don't preempt each other.
+  std::thread same_priority_query(
+      [&]() { auto ticket = scheduler.admit(scheduler_config, {gpu0}, 0, 0); });
+  while (scheduler.getWaitingQueries(gpu0.first) != 1) {
+    std::this_thread::yield();
+  }
+  EXPECT_FALSE(scheduler.preempt(scheduler_config, *batch_ticket));
+  batch_ticket.reset();
+  same_priority_query.join();
+  EXPECT_EQ(scheduler.getRunningQueries(gpu0.first), size_t(0));
+  EXPECT_EQ(scheduler.getReservedMemory(gpu0.first), size_t(0));
+}
+
+TEST_F(Select, SharedScans) {
+  auto& shared_scans = SharedScans::get();
+  constexpr int kDbId = -1;
+  constexpr int kTableId = -1;
+  {
+    auto scan1 = shared_scans.join(kDbId, kTableId, 0);
+    EXPECT_EQ(shared_scans.getActiveScans(kDbId, kTableId), size_t(1));
+    scan1->advance(3);
+    // Joining query starts from the fragment processed by the running one.
+    auto scan2 = shared_scans.join(kDbId, kTableId, 0);
+    EXPECT_EQ(scan2->startFragment(), size_t(3));
+    EXPECT_EQ(shared_scans.getActiveScans(kDbId, kTableId), size_t(2));
+  }
+  EXPECT_EQ(shared_scans.getActiveScans(kDbId, kTableId), size_t(0));
+
+  // Queries collected into a batch start together.
+  std::vector<std::thread> batch;
+  std::atomic<size_t> started{0};
+  for (int i = 0; i < 2; ++i) {
+    batch.emplace_back([&]() {
+      auto scan = shared_scans.join(kDbId, kTableId, 50);
+      EXPECT_EQ(scan->startFragment(), size_t(3));
+      ++started;
+    });
+  }
+  for (auto& query : batch) {
+    query.join();
+  }
+  EXPECT_EQ(started, size_t(2));
+  EXPECT_EQ(shared_scans.getActiveScans(kDbId, kTableId), size_t(0));
+
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    const auto scheduler = config().exec.scheduler;
+    ScopeGuard reset_scheduler = [&scheduler] { config().exec.scheduler = scheduler; };
+    config().exec.scheduler.enable_shared_scans = true;
+    c("SELECT COUNT(*) FROM test WHERE x > 7;", dt);
+    c("SELECT x, SUM(y) FROM test GROUP BY x ORDER BY x;", dt);
+    c("SELECT x, y FROM test WHERE y > 41 ORDER BY x, y;", dt);
+  }
+}
+
 TEST_F(Select, ExecutePlanWithoutGroupBy) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -3486,6 +4235,16 @@ TEST_F(Select, WidthBucketNullability) {
   }
 }
 
+TEST_F(Select, LimitEarlyTermination) {
+  // Kernels of fragments following enough rows are skipped, the remaining rows
+  // should still come from the leading fragments.
+  auto dt = ExecutorDeviceType::CPU;
+  c("SELECT x, y FROM test LIMIT 3;", dt);
+  c("SELECT x, y FROM test WHERE y > 41 LIMIT 4 OFFSET 2;", dt);
+  c("SELECT x, y FROM test WHERE y > 41 LIMIT 100 OFFSET 3;", dt);
+  c("SELECT x, y FROM test WHERE x <> 8 LIMIT 5 OFFSET 9;", dt);
+}
+
 TEST_F(Select, CountWithLimitAndOffset) {
   createTable("count_test", {{"val", ctx().int32()}});
   insertCsvValues("count_test", "0\n1\n2\n3\n4\n5\n6\n7\n8\n9");
@@ -3711,6 +4470,33 @@ TEST_F(Select, CountDistinct) {
   }
 }
 
+TEST_F(Select, CountDistinct_RoaringBitmap) {
+  const auto enable_roaring = config().exec.group_by.enable_roaring_count_distinct;
+  const auto roaring_threshold =
+      config().exec.group_by.roaring_count_distinct_bitmap_bits_threshold;
+  ScopeGuard reset = [enable_roaring, roaring_threshold] {
+    config().exec.group_by.enable_roaring_count_distinct = enable_roaring;
+    config().exec.group_by.roaring_count_distinct_bitmap_bits_threshold =
+        roaring_threshold;
+  };
+  for (bool enable : {false, true}) {
+    config().exec.group_by.enable_roaring_count_distinct = enable;
+    // a tiny threshold forces roaring bitmaps for narrow value ranges too
+    config().exec.group_by.roaring_count_distinct_bitmap_bits_threshold = 1;
+    for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+      SKIP_NO_GPU();
+      c("SELECT COUNT(distinct x) FROM test;", dt);
+      c("SELECT COUNT(distinct y) FROM test;", dt);
+      c("SELECT COUNT(distinct str) FROM test;", dt);
+      c("SELECT COUNT(distinct ofq) FROM test;", dt);
+      c("SELECT COUNT(distinct x * (50000 - 1)) FROM test;", dt);
+      c("SELECT x, COUNT(distinct ufq) FROM test GROUP BY x ORDER BY x;", dt);
+      c("SELECT z, str, COUNT(distinct y) FROM test GROUP BY z, str ORDER BY z, str;",
+        dt);
+    }
+  }
+}
+
 TEST_F(Select, ApproxCountDistinct) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -3824,6 +4610,32 @@ TEST_F(Select, ApproxCountDistinct) {
   }
 }
 
+TEST_F(Select, ApproxCountDistinct_SparseHll) {
+  const auto enable_sparse_hll = config().exec.group_by.enable_sparse_hll;
+  ScopeGuard reset = [enable_sparse_hll] {
+    config().exec.group_by.enable_sparse_hll = enable_sparse_hll;
+  };
+  for (bool enable : {false, true}) {
+    config().exec.group_by.enable_sparse_hll = enable;
+    for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+      SKIP_NO_GPU();
+      c("SELECT x, APPROX_COUNT_DISTINCT(f) FROM test GROUP BY x ORDER BY x;",
+        "SELECT x, COUNT(distinct f) FROM test GROUP BY x ORDER BY x;",
+        dt);
+      c("SELECT y, APPROX_COUNT_DISTINCT(d, 1) FROM test GROUP BY y ORDER BY y;",
+        "SELECT y, COUNT(distinct d) FROM test GROUP BY y ORDER BY y;",
+        dt);
+      c("SELECT str, APPROX_COUNT_DISTINCT(x * 1000000007) FROM test GROUP BY str "
+        "ORDER BY str;",
+        "SELECT str, COUNT(distinct x * 1000000007) FROM test GROUP BY str ORDER BY str;",
+        dt);
+      c("SELECT APPROX_COUNT_DISTINCT(f) FROM test;",
+        "SELECT COUNT(distinct f) FROM test;",
+        dt);
+    }
+  }
+}
+
 TEST_F(Select, ApproxMedianSanity) {
   auto dt = ExecutorDeviceType::CPU;
   auto approx_median = [dt](std::string const col) {
@@ -4188,6 +5000,34 @@ TEST_F(Select, OrderBy) {
   }
 }
 
+TEST_F(Select, OrderByRadixSort) {
+  // Multiple integer and dictionary keys are concatenated into a single radix sort key.
+  auto dt = ExecutorDeviceType::CPU;
+  c("SELECT x, y, COUNT(*) FROM test GROUP BY x, y ORDER BY x DESC, y;", dt);
+  c("SELECT str, x, COUNT(*) FROM test GROUP BY str, x ORDER BY str, x DESC;", dt);
+  c("SELECT x, z, t FROM test ORDER BY t DESC, z, x;", dt);
+  for (std::string nulls : {" NULLS LAST", " NULLS FIRST"}) {
+    c("SELECT t2.x, t0.x FROM coalesce_cols_test_2 t2 LEFT JOIN coalesce_cols_test_0 t0 "
+      "ON t2.x=t0.x ORDER BY t0.x DESC" +
+          nulls + ", t2.x DESC;",
+      dt);
+  }
+}
+
+TEST_F(Select, OrderByExternalSort) {
+  ScopeGuard reset = [orig = config().rs.external_sort_threshold] {
+    config().rs.external_sort_threshold = orig;
+  };
+  // Allow a few entries per sorted run to get multiple spilled runs.
+  config().rs.external_sort_threshold = 100;
+  auto dt = ExecutorDeviceType::CPU;
+  c("SELECT x, y, z, t FROM test ORDER BY t DESC, z, x, y;", dt);
+  c("SELECT str, x, COUNT(*) FROM test GROUP BY str, x ORDER BY str DESC, x;", dt);
+  c("SELECT t2.x, t0.x FROM coalesce_cols_test_2 t2 LEFT JOIN coalesce_cols_test_0 t0 "
+    "ON t2.x=t0.x ORDER BY t0.x NULLS FIRST, t2.x;",
+    dt);
+}
+
 TEST_F(Select, VariableLengthOrderBy) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -4652,6 +5492,72 @@ TEST_F(Select, Case) {
   }
 }
 
+TEST_F(Select, CommonSubexprElimination) {
+  const auto enable_cse = config().exec.codegen.enable_common_subexpr_elimination;
+  ScopeGuard reset = [enable_cse] {
+    config().exec.codegen.enable_common_subexpr_elimination = enable_cse;
+  };
+
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    std::vector<int64_t> extract_results;
+    for (bool enable : {false, true}) {
+      config().exec.codegen.enable_common_subexpr_elimination = enable;
+      c("SELECT CASE WHEN x + y > 50 THEN 77 ELSE 88 END AS foo, COUNT(*) FROM test "
+        "WHERE CASE WHEN x + y > 50 THEN 77 ELSE 88 END > 0 GROUP BY foo ORDER BY foo;",
+        dt);
+      c("SELECT SUM(CASE WHEN x > 7 THEN y END), MAX(CASE WHEN x > 7 THEN y END) "
+        "FROM test WHERE CASE WHEN x > 7 THEN y END IS NOT NULL;",
+        dt);
+      c("SELECT CASE WHEN x > 7 THEN x END AS k, COUNT(CASE WHEN x > 7 THEN x END) "
+        "FROM test GROUP BY k ORDER BY k NULLS FIRST;",
+        dt);
+      extract_results.push_back(v<int64_t>(
+          run_simple_agg("SELECT SUM(EXTRACT(YEAR FROM m) + EXTRACT(YEAR FROM m)) FROM "
+                         "test WHERE EXTRACT(YEAR FROM m) > 1970;",
+                         dt)));
+    }
+    ASSERT_EQ(extract_results[0], extract_results[1]);
+  }
+}
+
+TEST_F(Select, BranchlessCase) {
+  const auto enable_branchless_case = config().exec.codegen.enable_branchless_case;
+  ScopeGuard reset_branchless_case = [enable_branchless_case] {
+    config().exec.codegen.enable_branchless_case = enable_branchless_case;
+  };
+  for (auto enable : {true, false}) {
+    config().exec.codegen.enable_branchless_case = enable;
+    for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+      SKIP_NO_GPU();
+      // Select chains.
+      c("SELECT CASE WHEN y < 42 THEN 1 WHEN y < 43 THEN 2 WHEN y < 44 THEN 3 ELSE 4 "
+        "END AS bucket, COUNT(*) FROM test GROUP BY bucket ORDER BY bucket;",
+        dt);
+      c("SELECT SUM(CASE WHEN z IS NULL THEN 0 WHEN z > 101 THEN z ELSE -z END) FROM "
+        "test;",
+        dt);
+      c("SELECT SUM(CASE WHEN d > 2 AND NOT (f < 1) THEN d * 2.0 ELSE f + d END) FROM "
+        "test;",
+        dt);
+      c("SELECT CASE WHEN x > 7 THEN 'big' WHEN x = 7 THEN 'seven' ELSE 'small' END AS "
+        "c, COUNT(*) FROM test GROUP BY c ORDER BY c;",
+        dt);
+      // Switches, including repeated and nullable keys.
+      c("SELECT CASE x WHEN 7 THEN 70 WHEN 8 THEN 80 WHEN 7 THEN 700 ELSE 0 END AS k, "
+        "COUNT(*) FROM test GROUP BY k ORDER BY k;",
+        dt);
+      c("SELECT SUM(CASE y WHEN 42 THEN 1 WHEN 43 THEN 2 WHEN 101 THEN 3 END) FROM test;",
+        dt);
+      c("SELECT CASE ofd WHEN 1 THEN 10 WHEN 2 THEN 20 ELSE 30 END AS k, COUNT(*) FROM "
+        "test GROUP BY k ORDER BY k;",
+        dt);
+      // Division can fail, so branches with it are not evaluated for all rows.
+      c("SELECT SUM(CASE WHEN x = 7 THEN 1 ELSE 100 / (x - 7) END) FROM test;", dt);
+    }
+  }
+}
+
 TEST_F(Select, CaseSubQuery) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -4796,6 +5702,31 @@ TEST_F(Select, Strings) {
   }
 }
 
+TEST_F(Select, DictStringLength) {
+  const auto watchdog_state = config().exec.watchdog.enable;
+  ScopeGuard reset_watchdog_state = [&watchdog_state] {
+    config().exec.watchdog.enable = watchdog_state;
+  };
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+
+    // Lengths of dictionary-encoded strings are looked up by id and don't require
+    // decoding, so the watchdog doesn't reject them.
+    config().exec.watchdog.enable = true;
+    c("SELECT COUNT(*) FROM test WHERE LENGTH(real_str) > 7;", dt);
+    c("SELECT LENGTH(str) AS len, COUNT(*) FROM test GROUP BY len ORDER BY len;", dt);
+    c("SELECT CHAR_LENGTH(null_str) AS len, COUNT(*) FROM test GROUP BY len ORDER BY "
+      "len NULLS FIRST;",
+      "SELECT LENGTH(null_str) AS len, COUNT(*) FROM test GROUP BY len ORDER BY len;",
+      dt);
+    c("SELECT COUNT(*) FROM test WHERE LENGTH(null_str) IS NULL;", dt);
+    c("SELECT SUM(LENGTH(shared_dict)) FROM test;", dt);
+    c("SELECT LENGTH(str) + LENGTH(real_str) AS len, COUNT(*) FROM test GROUP BY len "
+      "ORDER BY len;",
+      dt);
+  }
+}
+
 TEST_F(Select, SharedDictionary) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -5033,6 +5964,31 @@ TEST_F(Select, DictionaryStringEquality) {
   }
 }
 
+TEST_F(Select, Strings_SkipFragmentsByDictStringStats) {
+  const auto skip_state = config().opts.skip_fragments_by_dict_string_stats;
+  ScopeGuard reset = [skip_state] {
+    config().opts.skip_fragments_by_dict_string_stats = skip_state;
+  };
+  for (bool skip : {false, true}) {
+    config().opts.skip_fragments_by_dict_string_stats = skip;
+    for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+      SKIP_NO_GPU();
+      c("SELECT COUNT(*) FROM test WHERE str = 'foo';", dt);
+      c("SELECT COUNT(*) FROM test WHERE 'baz' = str;", dt);
+      c("SELECT COUNT(*) FROM test WHERE str = 'none';", dt);
+      c("SELECT COUNT(*) FROM test WHERE fixed_str = 'bar';", dt);
+      c("SELECT COUNT(*) FROM test WHERE str = 'foo' AND x = 7;", dt);
+      c("SELECT COUNT(*) FROM test WHERE str LIKE 'ba%';", dt);
+      c("SELECT COUNT(*) FROM test WHERE str LIKE 'none%';", dt);
+      c("SELECT COUNT(*) FROM test WHERE null_str = 'foo';", dt);
+      c("SELECT x, COUNT(*) FROM test WHERE ss = 'boat' GROUP BY x ORDER BY x;", dt);
+      c("SELECT COUNT(*) FROM test JOIN test_inner ON test.x = test_inner.x WHERE "
+        "test.str = 'bar';",
+        dt);
+    }
+  }
+}
+
 TEST_F(Select, StringsNoneEncoding) {
   createTestLotsColsTable();
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
@@ -5089,15 +6045,90 @@ TEST_F(Select, StringsNoneEncoding) {
                   "SELECT COUNT(*) FROM test WHERE real_str REGEXP 'real_f.*.*';", dt)));
     ASSERT_EQ(0,
               v<int64_t>(run_simple_agg(
-                  "SELECT COUNT(*) FROM test WHERE real_str REGEXP 'real_f.+\%';", dt)));
-    EXPECT_THROW(
-        run_multiple_agg("SELECT COUNT(*) FROM test WHERE real_str LIKE str;", dt),
-        std::runtime_error);
-    EXPECT_THROW(run_multiple_agg(
-                     "SELECT COUNT(*) FROM test WHERE REGEXP_LIKE(real_str, str);", dt),
-                 std::runtime_error);
+                  "SELECT COUNT(*) FROM test WHERE real_str REGEXP 'real_f.+\%';", dt)));
+    EXPECT_THROW(
+        run_multiple_agg("SELECT COUNT(*) FROM test WHERE real_str LIKE str;", dt),
+        std::runtime_error);
+    EXPECT_THROW(run_multiple_agg(
+                     "SELECT COUNT(*) FROM test WHERE REGEXP_LIKE(real_str, str);", dt),
+                 std::runtime_error);
+  }
+  dropTable("test_lots_cols");
+}
+
+TEST_F(Select, PrecompiledRegexp) {
+  const auto enable_precompiled_regexp =
+      config().exec.codegen.enable_precompiled_regexp;
+  ScopeGuard reset_precompiled_regexp = [enable_precompiled_regexp] {
+    config().exec.codegen.enable_precompiled_regexp = enable_precompiled_regexp;
+  };
+  for (auto enable : {true, false}) {
+    config().exec.codegen.enable_precompiled_regexp = enable;
+    for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+      SKIP_NO_GPU();
+      ASSERT_EQ(static_cast<int64_t>(g_num_rows),
+                v<int64_t>(run_simple_agg(
+                    "SELECT COUNT(*) FROM test WHERE real_str REGEXP 'real_ba.';", dt)));
+      ASSERT_EQ(
+          static_cast<int64_t>(g_num_rows / 2),
+          v<int64_t>(run_simple_agg(
+              "SELECT COUNT(*) FROM test WHERE REGEXP_LIKE(real_str, '.*z$');", dt)));
+      ASSERT_EQ(0,
+                v<int64_t>(run_simple_agg(
+                    "SELECT COUNT(*) FROM test WHERE real_str REGEXP '(';", dt)));
+      // OR'ed patterns on the same string are matched at once.
+      ASSERT_EQ(static_cast<int64_t>(g_num_rows + g_num_rows / 2),
+                v<int64_t>(run_simple_agg(
+                    "SELECT COUNT(*) FROM test WHERE real_str REGEXP 'real_f.+' OR "
+                    "real_str REGEXP '.*_baz';",
+                    dt)));
+      ASSERT_EQ(static_cast<int64_t>(2 * g_num_rows),
+                v<int64_t>(run_simple_agg(
+                    "SELECT COUNT(*) FROM test WHERE real_str REGEXP 'real_f.+' OR "
+                    "REGEXP_LIKE(real_str, 'real_.a.') OR real_str REGEXP '(';",
+                    dt)));
+      ASSERT_EQ(static_cast<int64_t>(g_num_rows + g_num_rows / 2),
+                v<int64_t>(run_simple_agg(
+                    "SELECT COUNT(*) FROM test WHERE real_str REGEXP 'real_f.+' OR "
+                    "(x > 7 AND real_str REGEXP '.*_ba.');",
+                    dt)));
+      ASSERT_EQ(static_cast<int64_t>(g_num_rows),
+                v<int64_t>(run_simple_agg(
+                    "SELECT COUNT(*) FROM test WHERE str REGEXP 'ba.' OR str REGEXP "
+                    "'.*z';",
+                    dt)));
+    }
+  }
+}
+
+TEST_F(Select, StringsNoneEncodingUtf8) {
+  createTable("utf8_str", {{"id", ctx().int32()}, {"s", ctx().text()}});
+  ScopeGuard drop_table = [] { dropTable("utf8_str"); };
+  insertCsvValues("utf8_str",
+                  "1,héllo wörld\n"
+                  "2,日本語のテキスト\n"
+                  "3,abcdefghijklmnopq\n"
+                  "4,é");
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    ASSERT_EQ(37,
+              v<int64_t>(
+                  run_simple_agg("SELECT SUM(CHAR_LENGTH(s)) FROM utf8_str;", dt)));
+    ASSERT_EQ(56, v<int64_t>(run_simple_agg("SELECT SUM(LENGTH(s)) FROM utf8_str;", dt)));
+    ASSERT_EQ(
+        2,
+        v<int64_t>(run_simple_agg(
+            "SELECT COUNT(*) FROM utf8_str WHERE CHAR_LENGTH(s) < LENGTH(s) - 1;", dt)));
+    ASSERT_EQ(1,
+              v<int64_t>(run_simple_agg(
+                  "SELECT COUNT(*) FROM utf8_str WHERE s LIKE '%ijk%';", dt)));
+    ASSERT_EQ(1,
+              v<int64_t>(run_simple_agg(
+                  "SELECT COUNT(*) FROM utf8_str WHERE s LIKE '%テキ%';", dt)));
+    ASSERT_EQ(2,
+              v<int64_t>(run_simple_agg(
+                  "SELECT COUNT(*) FROM utf8_str WHERE s LIKE '%é%';", dt)));
   }
-  dropTable("test_lots_cols");
 }
 
 TEST_F(Select, TimeSyntaxCheck) {
@@ -6899,6 +7930,42 @@ TEST_F(Select, ExtractEpoch) {
   }
 }
 
+TEST_F(Select, DateLookupTable) {
+  const auto max_days = config().exec.codegen.date_lookup_table_max_days;
+  ScopeGuard reset_max_days = [max_days] {
+    config().exec.codegen.date_lookup_table_max_days = max_days;
+  };
+  const std::vector<std::string> queries = {
+      "SELECT MAX(EXTRACT(YEAR FROM o)) FROM test;",
+      "SELECT MAX(EXTRACT(QUARTER FROM o1)) FROM test;",
+      "SELECT MAX(EXTRACT(MONTH FROM o2)) FROM test;",
+      "SELECT MIN(EXTRACT(DAY FROM o)) FROM test;",
+      "SELECT MAX(EXTRACT(DOY FROM o)) FROM test;",
+      "SELECT MAX(EXTRACT(WEEK FROM o)) FROM test;",
+      "SELECT MAX(EXTRACT(WEEK_SUNDAY FROM CAST(m AS DATE))) FROM test;",
+      "SELECT MIN(EXTRACT(WEEK_SATURDAY FROM CAST(m AS DATE))) FROM test;",
+      "SELECT COUNT(*) FROM test WHERE EXTRACT(MONTH FROM o) IS NULL;",
+      "SELECT COUNT(*) FROM test WHERE EXTRACT(YEAR FROM CAST(m AS DATE)) = 2014;",
+      "SELECT MAX(DATE_TRUNC(YEAR, o)) FROM test;",
+      "SELECT MAX(DATE_TRUNC(QUARTER, o1)) FROM test;",
+      "SELECT MIN(DATE_TRUNC(MONTH, CAST(m AS DATE))) FROM test;",
+      "SELECT MAX(DATE_TRUNC(DECADE, o2)) FROM test;",
+      "SELECT MAX(DATE_TRUNC(CENTURY, o)) FROM test;",
+      "SELECT MIN(DATE_TRUNC(MILLENNIUM, o)) FROM test;",
+      "SELECT COUNT(*) FROM test WHERE DATE_TRUNC(MONTH, o) IS NULL;"};
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+
+    for (const auto& query : queries) {
+      // Results computed with runtime functions are the reference.
+      config().exec.codegen.date_lookup_table_max_days = 0;
+      const auto expected = v<int64_t>(run_simple_agg(query, dt));
+      config().exec.codegen.date_lookup_table_max_days = max_days;
+      EXPECT_EQ(expected, v<int64_t>(run_simple_agg(query, dt))) << query;
+    }
+  }
+}
+
 TEST_F(Select, DateTruncate2) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -7436,6 +8503,22 @@ TEST_F(Select, OverflowAndUnderFlow) {
   }
 }
 
+TEST_F(Select, ArithmeticWithinRange) {
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    // Column ranges prove these expressions can't overflow, so runtime overflow
+    // checks are omitted.
+    c("SELECT dd * 3 + dd AS expr FROM test ORDER BY expr;", dt);
+    c("SELECT dd * dd - dd AS expr FROM test ORDER BY expr;", dt);
+    c("SELECT dd * 1.05 AS expr FROM test ORDER BY expr;", dt);
+    c("SELECT CAST(x AS DECIMAL(12, 2)) + dd AS expr FROM test ORDER BY expr;", dt);
+    c("SELECT CAST(dd AS DECIMAL(18, 6)) * 100 AS expr FROM test ORDER BY expr;", dt);
+    c("SELECT COUNT(*) FROM test WHERE dd * 2 - 1 > 100;", dt);
+    c("SELECT CAST(x + 1 AS SMALLINT) AS expr FROM test ORDER BY expr;", dt);
+    c("SELECT SUM(CAST(x AS DECIMAL(10, 2)) * 2) FROM test;", dt);
+  }
+}
+
 TEST_F(Select, DetectOverflowedLiteralBuf) {
   // constructing literal buf to trigger overflow takes too much time
   // so we mimic the literal buffer collection during codegen
@@ -8651,6 +9734,65 @@ TEST_F(Select, ArrayAnyAndAll) {
   }
 }
 
+TEST_F(Select, LongArrays) {
+  // Arrays longer than a block of ANY/ALL checks, decisive elements are put in
+  // different blocks.
+  createTable("long_arrays", {{"arr", ctx().arrayVarLen(ctx().int32())}});
+  ScopeGuard drop_table = [] { dropTable("long_arrays"); };
+  std::vector<std::string> elems(40);
+  for (size_t i = 0; i < elems.size(); ++i) {
+    elems[i] = std::to_string(i + 1);
+  }
+  auto to_json = [](const std::vector<std::string>& vals) {
+    std::string res = "{\"arr\": [";
+    for (size_t i = 0; i < vals.size(); ++i) {
+      res += (i ? ", " : "") + vals[i];
+    }
+    return res + "]}\n";
+  };
+  std::string json = to_json(elems);
+  elems[19] = "null";
+  json += to_json(elems);
+  std::vector<std::string> hundreds(35, "100");
+  hundreds[33] = "7";
+  json += to_json(hundreds);
+  insertJsonValues("long_arrays", json);
+
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    EXPECT_EQ(3,
+              v<int64_t>(run_simple_agg(
+                  "SELECT COUNT(*) FROM long_arrays WHERE 7 = ANY arr;", dt)));
+    EXPECT_EQ(1,
+              v<int64_t>(run_simple_agg(
+                  "SELECT COUNT(*) FROM long_arrays WHERE 40 = ANY arr AND 8 > ALL arr "
+                  "OR 99 < ANY arr;",
+                  dt)));
+    EXPECT_EQ(2,
+              v<int64_t>(run_simple_agg(
+                  "SELECT COUNT(*) FROM long_arrays WHERE 0 < ALL arr;", dt)));
+    EXPECT_EQ(1,
+              v<int64_t>(run_simple_agg(
+                  "SELECT COUNT(*) FROM long_arrays WHERE 41 > ALL arr;", dt)));
+
+    auto rows = run_multiple_agg(
+        "SELECT UNNEST(arr) AS a, COUNT(*) FROM long_arrays GROUP BY a ORDER BY a ASC "
+        "NULLS LAST;",
+        dt);
+    ASSERT_EQ(rows->rowCount(), size_t(42));
+    auto check_row = [&rows](size_t row_idx, int64_t val, int64_t count) {
+      EXPECT_EQ(val, v<int64_t>(rows->getRowAt(row_idx, 0, true, true)));
+      EXPECT_EQ(count, v<int64_t>(rows->getRowAt(row_idx, 1, true, true)));
+    };
+    check_row(0, 1, 2);
+    check_row(6, 7, 3);
+    check_row(19, 20, 1);
+    check_row(39, 40, 2);
+    check_row(40, 100, 34);
+    check_row(41, inline_null_value<int32_t>(), 1);
+  }
+}
+
 TEST_F(Select, ArrayUnsupported) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -8888,6 +10030,27 @@ TEST_F(Select, GroupByBaselineHash) {
   }
 }
 
+TEST_F(Select, GroupByBaselineHash_ColumnStats) {
+  const auto column_stats_ndv_state = config().exec.group_by.enable_column_stats_ndv;
+  ScopeGuard reset = [column_stats_ndv_state] {
+    config().exec.group_by.enable_column_stats_ndv = column_stats_ndv_state;
+  };
+
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    for (bool enable_column_stats_ndv : {false, true}) {
+      config().exec.group_by.enable_column_stats_ndv = enable_column_stats_ndv;
+      c("SELECT x4 as key, COUNT(*), AVG(x1), MAX(x2), MAX(x3) FROM random_test"
+        " GROUP BY key ORDER BY key;",
+        dt);
+      c("SELECT x1, x2, x3, x4, COUNT(*), MIN(x5) FROM random_test "
+        "GROUP BY x1, x2, x3, x4 ORDER BY x1, x2, x3, x4;",
+        dt);
+      c("SELECT ofq, ufq, COUNT(*) FROM test GROUP BY ofq, ufq ORDER BY ofq, ufq;", dt);
+    }
+  }
+}
+
 TEST_F(Select, GroupByConstrainedByInQueryRewrite) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -9024,6 +10187,159 @@ TEST_F(Select, BigintGroupByColCompactionTest) {
   dropTable("bigint_groupby_col_compaction_test");
 }
 
+TEST_F(Select, GroupByCardinalityCacheAfterAppend) {
+  const auto big_group_threshold = config().exec.group_by.big_group_threshold;
+  const auto use_estimator_result_cache = config().cache.use_estimator_result_cache;
+  ScopeGuard reset = [big_group_threshold, use_estimator_result_cache] {
+    config().exec.group_by.big_group_threshold = big_group_threshold;
+    config().cache.use_estimator_result_cache = use_estimator_result_cache;
+  };
+  config().exec.group_by.big_group_threshold = 1;
+  config().cache.use_estimator_result_cache = true;
+
+  createTable("card_cache_test", {{"x", ctx().int64()}, {"y", ctx().int64()}});
+  insertCsvValues("card_cache_test", "1,1000000000000\n2,2000000000000");
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    const auto result = run_multiple_agg(
+        "SELECT x, y, COUNT(*) FROM card_cache_test GROUP BY x, y ORDER BY x;", dt);
+    ASSERT_EQ(size_t(2), result->rowCount());
+  }
+  // The cached estimation was computed for fewer rows and must not be reused.
+  std::ostringstream oss;
+  for (int64_t i = 3; i < 1000; ++i) {
+    oss << i << "," << i * 1000000000000 << "\n";
+  }
+  insertCsvValues("card_cache_test", oss.str());
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    const auto result = run_multiple_agg(
+        "SELECT x, y, COUNT(*) FROM card_cache_test GROUP BY x, y ORDER BY x;", dt);
+    ASSERT_EQ(size_t(999), result->rowCount());
+  }
+  dropTable("card_cache_test");
+}
+
+TEST_F(Select, GroupByGroupCountHistory) {
+  const auto big_group_threshold = config().exec.group_by.big_group_threshold;
+  const auto use_estimator_result_cache = config().cache.use_estimator_result_cache;
+  const auto enable_group_count_history =
+      config().exec.group_by.enable_group_count_history;
+  ScopeGuard reset = [big_group_threshold,
+                      use_estimator_result_cache,
+                      enable_group_count_history] {
+    config().exec.group_by.big_group_threshold = big_group_threshold;
+    config().cache.use_estimator_result_cache = use_estimator_result_cache;
+    config().exec.group_by.enable_group_count_history = enable_group_count_history;
+  };
+  config().exec.group_by.big_group_threshold = 1;
+  config().cache.use_estimator_result_cache = true;
+  config().exec.group_by.enable_group_count_history = true;
+
+  createTable("group_count_history_test", {{"x", ctx().int64()}, {"y", ctx().int64()}});
+  std::ostringstream oss;
+  for (int64_t i = 0; i < 3000; ++i) {
+    oss << i % 1500 << "," << (i % 1500) * 1000000000000 << "\n";
+  }
+  insertCsvValues("group_count_history_test", oss.str());
+  // The second execution of each query sizes its buffer by the group count of the
+  // first one.
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    for (int i = 0; i < 2; ++i) {
+      const auto result = run_multiple_agg(
+          "SELECT x, y, COUNT(*) FROM group_count_history_test GROUP BY x, y;", dt);
+      ASSERT_EQ(size_t(1500), result->rowCount());
+      const auto small_result = run_multiple_agg(
+          "SELECT x, y, COUNT(*) FROM group_count_history_test WHERE x < 10 GROUP BY "
+          "x, y;",
+          dt);
+      ASSERT_EQ(size_t(10), small_result->rowCount());
+    }
+  }
+  dropTable("group_count_history_test");
+}
+
+TEST_F(Select, GroupByCostBasedHashLayout) {
+  const auto enable_cost_based_hash_layout =
+      config().exec.group_by.enable_cost_based_hash_layout;
+  ScopeGuard reset = [enable_cost_based_hash_layout] {
+    config().exec.group_by.enable_cost_based_hash_layout = enable_cost_based_hash_layout;
+  };
+
+  // A wide range of values with a few groups, which is cheaper to aggregate with
+  // baseline hash.
+  createTable("cost_based_layout_test", {{"x", ctx().int64()}, {"y", ctx().int32()}});
+  std::ostringstream oss;
+  for (int64_t i = 0; i < 100; ++i) {
+    oss << (i % 4) * 10000000 << "," << i << "\n";
+  }
+  insertCsvValues("cost_based_layout_test", oss.str());
+  for (bool enable : {false, true}) {
+    config().exec.group_by.enable_cost_based_hash_layout = enable;
+    for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+      SKIP_NO_GPU();
+      const auto result = run_multiple_agg(
+          "SELECT x, COUNT(*), SUM(y) FROM cost_based_layout_test GROUP BY x ORDER BY "
+          "x;",
+          dt);
+      ASSERT_EQ(size_t(4), result->rowCount());
+      for (int64_t k = 0; k < 4; ++k) {
+        const auto row = result->getNextRow(true, true);
+        ASSERT_EQ(k * 10000000, v<int64_t>(row[0]));
+        ASSERT_EQ(int64_t(25), v<int64_t>(row[1]));
+        ASSERT_EQ(1200 + 25 * k, v<int64_t>(row[2]));
+      }
+      const auto multi_col_result = run_multiple_agg(
+          "SELECT x, y / 50, COUNT(*) FROM cost_based_layout_test GROUP BY x, y / 50;",
+          dt);
+      ASSERT_EQ(size_t(8), multi_col_result->rowCount());
+    }
+  }
+  dropTable("cost_based_layout_test");
+}
+
+TEST_F(Select, GroupByRangeBasedSlotCompaction) {
+  const auto enable_range_based_slot_compaction =
+      config().exec.group_by.enable_range_based_slot_compaction;
+  ScopeGuard reset = [enable_range_based_slot_compaction] {
+    config().exec.group_by.enable_range_based_slot_compaction =
+        enable_range_based_slot_compaction;
+  };
+
+  createTable("slot_compaction_test",
+              {{"k", ctx().int32()}, {"x", ctx().int16()}, {"y", ctx().int32()}});
+  std::ostringstream oss;
+  for (int64_t i = 0; i < 100; ++i) {
+    oss << i % 5 << "," << (i % 2 ? -i : i) << "," << (i - 50) * 1000000 << "\n";
+  }
+  insertCsvValues("slot_compaction_test", oss.str());
+  for (bool enable : {false, true}) {
+    config().exec.group_by.enable_range_based_slot_compaction = enable;
+    for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+      SKIP_NO_GPU();
+      const auto result = run_multiple_agg(
+          "SELECT k, COUNT(*), MIN(x), MAX(x), MIN(y), MAX(y) FROM "
+          "slot_compaction_test GROUP BY k ORDER BY k;",
+          dt);
+      ASSERT_EQ(size_t(5), result->rowCount());
+      for (int64_t k = 0; k < 5; ++k) {
+        const auto row = result->getNextRow(true, true);
+        ASSERT_EQ(k, v<int64_t>(row[0]));
+        ASSERT_EQ(int64_t(20), v<int64_t>(row[1]));
+        // Odd values are negated, the biggest one of the group is k + 90 or k + 95.
+        const int64_t min_x = -(k + (k % 2 ? 90 : 95));
+        const int64_t max_x = k + (k % 2 ? 95 : 90);
+        ASSERT_EQ(min_x, v<int64_t>(row[2]));
+        ASSERT_EQ(max_x, v<int64_t>(row[3]));
+        ASSERT_EQ((k - 50) * 1000000, v<int64_t>(row[4]));
+        ASSERT_EQ((k + 45) * 1000000, v<int64_t>(row[5]));
+      }
+    }
+  }
+  dropTable("slot_compaction_test");
+}
+
 class Drop : public ExecuteTestBase, public ::testing::Test {};
 
 TEST_F(Drop, AfterDrop) {
@@ -9041,6 +10357,40 @@ TEST_F(Drop, AfterDrop) {
   dropTable("droptest");
 }
 
+TEST_F(Drop, SameQueryAfterRecreate) {
+  const auto enable_rel_alg_cache = config().cache.enable_rel_alg_cache;
+  ScopeGuard reset = [enable_rel_alg_cache] {
+    config().cache.enable_rel_alg_cache = enable_rel_alg_cache;
+  };
+  config().cache.enable_rel_alg_cache = true;
+
+  createTable("droptest", {{"i1", ctx().int32()}});
+  insertCsvValues("droptest", "1\n2");
+  ASSERT_EQ(int64_t(3),
+            v<int64_t>(run_simple_agg("SELECT SUM(i1) FROM droptest;",
+                                      ExecutorDeviceType::CPU)));
+  // Differently formatted query text is served from the same cache entry.
+  ASSERT_EQ(int64_t(3),
+            v<int64_t>(run_simple_agg("SELECT  SUM(i1)\n  FROM droptest",
+                                      ExecutorDeviceType::CPU)));
+  // Newlines ending line comments are significant.
+  ASSERT_EQ(int64_t(3),
+            v<int64_t>(run_simple_agg("SELECT SUM(i1) FROM droptest -- WHERE i1 > 1",
+                                      ExecutorDeviceType::CPU)));
+  ASSERT_EQ(int64_t(2),
+            v<int64_t>(run_simple_agg("SELECT SUM(i1) FROM droptest --\nWHERE i1 > 1",
+                                      ExecutorDeviceType::CPU)));
+  // Cached plan for the old schema must not be reused.
+  dropTable("droptest");
+  createTable("droptest", {{"i1", ctx().fp64()}});
+  insertCsvValues("droptest", "1.5\n2.75");
+  ASSERT_NEAR(double(4.25),
+              v<double>(run_simple_agg("SELECT SUM(i1) FROM droptest;",
+                                       ExecutorDeviceType::CPU)),
+              double(0.001));
+  dropTable("droptest");
+}
+
 TEST_F(Select, Empty) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -9681,6 +11031,25 @@ TEST_F(Select, Joins_InnerJoin_TwoTables) {
   }
 }
 
+TEST_F(Select, Joins_SkipFragmentsByJoinKeyRange) {
+  const auto skip_state = config().opts.skip_fragments_by_join_key_range;
+  ScopeGuard reset = [skip_state] {
+    config().opts.skip_fragments_by_join_key_range = skip_state;
+  };
+  for (bool skip : {false, true}) {
+    config().opts.skip_fragments_by_join_key_range = skip;
+    for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+      SKIP_NO_GPU();
+      c("SELECT COUNT(*) FROM test JOIN test_inner ON test.x = test_inner.x;", dt);
+      c("SELECT COUNT(*) FROM test JOIN test_inner ON test_inner.y = test.y;", dt);
+      c("SELECT a.y, z FROM test a JOIN test_inner b ON a.x = b.x order by a.y;", dt);
+      c("SELECT COUNT(*) FROM test a JOIN test_inner b ON a.x = b.x AND a.y = b.y;",
+        dt);
+      c("SELECT COUNT(*) FROM test a LEFT JOIN test_inner b ON a.x = b.x;", dt);
+    }
+  }
+}
+
 TEST_F(Select, Joins_InnerJoin_AtLeastThreeTables) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -10836,6 +12205,219 @@ TEST_F(Select, Joins_TimeAndDate) {
   }
 }
 
+TEST_F(Select, Joins_PartitionedHashBuild) {
+  const auto threshold_state = config().exec.join.partitioned_hash_build_threshold;
+  ScopeGuard reset = [threshold_state] {
+    config().exec.join.partitioned_hash_build_threshold = threshold_state;
+    // Drop hash tables built by partitions
+    clearCpuMemory();
+  };
+  config().exec.join.partitioned_hash_build_threshold = 0;
+  clearCpuMemory();
+
+  const auto dt = ExecutorDeviceType::CPU;
+  c("SELECT COUNT(*) FROM test a, test b WHERE a.x = b.x;", dt);
+  c("SELECT a.y, b.y FROM test a JOIN test b ON a.x = b.x ORDER BY a.y, b.y;", dt);
+  c("SELECT COUNT(*) FROM test a, test b WHERE a.o = b.o;", dt);
+  c("SELECT COUNT(*) FROM test a, test_inner b WHERE a.o = b.dt;", dt);
+  c("SELECT COUNT(*) FROM test a JOIN join_test b ON a.str = b.dup_str;", dt);
+  c("SELECT COUNT(*) FROM test, test_inner WHERE test.y = test_inner.y OR (test.y IS "
+    "NULL AND test_inner.y IS NULL);",
+    dt);
+  // One-to-many baseline hash tables.
+  c("SELECT a.x, b.str FROM test AS a JOIN join_test AS b ON a.str = b.str AND a.x = "
+    "b.x ORDER BY a.x, b.str;",
+    dt);
+  c("SELECT a.y, b.y FROM test a JOIN test b ON a.x = b.x AND a.z = b.z ORDER BY a.y, "
+    "b.y;",
+    dt);
+  c("SELECT COUNT(*) FROM test, join_test WHERE (test.x = join_test.x OR (test.x IS "
+    "NULL AND join_test.x IS NULL)) "
+    "AND (test.y = join_test.y OR (test.y IS NULL AND join_test.y IS NULL));",
+    dt);
+}
+
+TEST_F(Select, Joins_SortJoin) {
+  const auto join_config = config().exec.join;
+  ScopeGuard reset = [join_config] {
+    config().exec.join = join_config;
+    clearCpuMemory();
+  };
+  // Reject all perfect hash tables as too sparse to force the sorted join table.
+  config().exec.join.enable_sort_join = true;
+  config().exec.join.huge_join_hash_threshold = 0;
+  config().exec.join.huge_join_hash_min_load = 100;
+  clearCpuMemory();
+
+  const auto dt = ExecutorDeviceType::CPU;
+  c("SELECT COUNT(*) FROM test a, test b WHERE a.x = b.x;", dt);
+  c("SELECT a.y, b.y FROM test a JOIN test b ON a.x = b.x ORDER BY a.y, b.y;", dt);
+  c("SELECT COUNT(*) FROM test, test_inner WHERE test.x = test_inner.x;", dt);
+  c("SELECT COUNT(*) FROM test, test_inner WHERE test.y = test_inner.y;", dt);
+  c("SELECT COUNT(*) FROM test, test_inner WHERE test.x - 1 = test_inner.x;", dt);
+  c("SELECT COUNT(*) FROM test LEFT JOIN test_inner ON test.x = test_inner.x;", dt);
+}
+
+TEST_F(Select, Joins_NoneEncodedStrings) {
+  const auto string_join_state = config().exec.join.enable_string_join;
+  ScopeGuard reset = [string_join_state] {
+    config().exec.join.enable_string_join = string_join_state;
+    clearCpuMemory();
+  };
+
+  const auto dt = ExecutorDeviceType::CPU;
+  for (bool enable_string_join : {false, true}) {
+    config().exec.join.enable_string_join = enable_string_join;
+    clearCpuMemory();
+    c("SELECT COUNT(*) FROM test a, test b WHERE a.real_str = b.real_str;", dt);
+    c("SELECT a.x, b.y FROM test a JOIN test b ON a.real_str = b.real_str ORDER BY a.x, "
+      "b.y;",
+      dt);
+    c("SELECT COUNT(*) FROM test a LEFT JOIN test b ON a.real_str = b.real_str AND a.x "
+      "< b.y;",
+      dt);
+  }
+}
+
+TEST_F(Select, Joins_RangeJoin) {
+  const auto range_join_state = config().exec.join.enable_range_join;
+  ScopeGuard reset = [range_join_state] {
+    config().exec.join.enable_range_join = range_join_state;
+  };
+  config().exec.join.enable_range_join = true;
+
+  const auto dt = ExecutorDeviceType::CPU;
+  c("SELECT COUNT(*) FROM test, test_inner WHERE test.x < test_inner.y;", dt);
+  c("SELECT COUNT(*) FROM test, test_inner WHERE test_inner.x >= test.x - 10;", dt);
+  c("SELECT COUNT(*) FROM test, test_inner WHERE test_inner.y BETWEEN test.x AND "
+    "test.y;",
+    dt);
+  c("SELECT COUNT(*) FROM test, test_inner WHERE test.y BETWEEN test_inner.x AND "
+    "test_inner.y;",
+    dt);
+  c("SELECT test.y, test_inner.x FROM test, test_inner WHERE test.y > test_inner.x "
+    "AND test.y < test_inner.y ORDER BY test.y, test_inner.x;",
+    dt);
+  c("SELECT COUNT(*) FROM test LEFT JOIN test_inner ON test.y BETWEEN test_inner.x "
+    "AND test_inner.y;",
+    dt);
+}
+
+TEST_F(Select, Joins_LoopJoinScan) {
+  const auto join_config = config().exec.join;
+  ScopeGuard reset = [join_config] { config().exec.join = join_config; };
+  config().exec.join.enable_range_join = false;
+
+  const auto dt = ExecutorDeviceType::CPU;
+  for (bool enable_loop_join_scan : {false, true}) {
+    config().exec.join.enable_loop_join_scan = enable_loop_join_scan;
+    c("SELECT COUNT(*) FROM test, test_inner WHERE test.x < test_inner.y;", dt);
+    c("SELECT COUNT(*) FROM test, test_inner WHERE test_inner.y <> test.y;", dt);
+    c("SELECT COUNT(*) FROM test, test_inner WHERE test_inner.x >= test.x - 10;", dt);
+    c("SELECT test.y, test_inner.x FROM test, test_inner WHERE test.y > test_inner.x "
+      "AND test.y < test_inner.y ORDER BY test.y, test_inner.x;",
+      dt);
+    c("SELECT COUNT(*) FROM test LEFT JOIN test_inner ON test.y < test_inner.y;", dt);
+    c("SELECT COUNT(*) FROM test a, test b WHERE a.d > b.d;", dt);
+    c("SELECT COUNT(*) FROM test a, test b WHERE a.f <= b.f AND a.x <> b.x;", dt);
+  }
+}
+
+TEST_F(Select, Joins_Crc32KeyHash) {
+  const auto crc32_key_hash_state = config().exec.join.enable_crc32_key_hash;
+  ScopeGuard reset = [crc32_key_hash_state] {
+    config().exec.join.enable_crc32_key_hash = crc32_key_hash_state;
+  };
+
+  const auto dt = ExecutorDeviceType::CPU;
+  for (bool enable_crc32_key_hash : {false, true}) {
+    config().exec.join.enable_crc32_key_hash = enable_crc32_key_hash;
+    // One-to-one baseline hash table.
+    c("SELECT a.z, b.str FROM test a JOIN test_inner b ON a.y = b.y AND a.x = b.x "
+      "ORDER BY a.z, b.str;",
+      dt);
+    // One-to-many baseline hash table.
+    c("SELECT a.x, b.str FROM test AS a JOIN join_test AS b ON a.str = b.str AND a.x = "
+      "b.x ORDER BY a.x, b.str;",
+      dt);
+    c("SELECT COUNT(*) FROM test, join_test WHERE (test.x = join_test.x OR (test.x IS "
+      "NULL AND join_test.x IS NULL)) "
+      "AND (test.y = join_test.y OR (test.y IS NULL AND join_test.y IS NULL));",
+      dt);
+    // Drop cached hash tables built with the other hash function.
+    clearCpuMemory();
+  }
+}
+
+TEST_F(Select, Joins_HashTablePrefetch) {
+  const auto prefetch_threshold = config().exec.join.hash_table_prefetch_threshold;
+  ScopeGuard reset = [prefetch_threshold] {
+    config().exec.join.hash_table_prefetch_threshold = prefetch_threshold;
+  };
+  // Prefetch slots of all baseline hash tables built on CPU.
+  config().exec.join.hash_table_prefetch_threshold = 0;
+  clearCpuMemory();
+
+  const auto dt = ExecutorDeviceType::CPU;
+  c("SELECT a.z, b.str FROM test a JOIN test_inner b ON a.y = b.y AND a.x = b.x "
+    "ORDER BY a.z, b.str;",
+    dt);
+  c("SELECT a.x, b.str FROM test AS a JOIN join_test AS b ON a.str = b.str AND a.x = "
+    "b.x ORDER BY a.x, b.str;",
+    dt);
+  c("SELECT COUNT(*) FROM test, join_test WHERE test.x = join_test.x AND test.y = "
+    "join_test.y;",
+    dt);
+  clearCpuMemory();
+}
+
+TEST_F(Select, Joins_CompactKeys) {
+  const auto compact_join_keys_state = config().exec.join.enable_compact_join_keys;
+  ScopeGuard reset = [compact_join_keys_state] {
+    config().exec.join.enable_compact_join_keys = compact_join_keys_state;
+  };
+
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    for (bool enable_compact_join_keys : {false, true}) {
+      config().exec.join.enable_compact_join_keys = enable_compact_join_keys;
+      c("SELECT COUNT(*) FROM test a, test b WHERE a.t = b.t AND a.x = b.x;", dt);
+      c("SELECT a.y, b.y FROM test a JOIN test b ON a.t = b.t AND a.y = b.y ORDER BY "
+        "a.y, b.y;",
+        dt);
+      c("SELECT COUNT(*) FROM test a, test b WHERE a.m = b.m AND a.x = b.x;", dt);
+      // Outer values out of the 32-bit range must not match truncated inner keys.
+      c("SELECT COUNT(*) FROM test a, test b WHERE a.t + 4294967296 = b.t AND a.x = "
+        "b.x;",
+        dt);
+    }
+  }
+}
+
+TEST_F(Select, Joins_SelectivityReordering) {
+  const auto selectivity_reordering_state =
+      config().opts.enable_join_selectivity_reordering;
+  ScopeGuard reset = [selectivity_reordering_state] {
+    config().opts.enable_join_selectivity_reordering = selectivity_reordering_state;
+  };
+
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    for (bool enable_selectivity_reordering : {false, true}) {
+      config().opts.enable_join_selectivity_reordering = enable_selectivity_reordering;
+      c("SELECT COUNT(*) FROM test a, test_inner b, join_test c WHERE a.x = b.x AND "
+        "a.x = c.x;",
+        dt);
+      c("SELECT a.x, COUNT(*) FROM test a, test b, test_inner c WHERE a.y = b.y AND "
+        "a.x = c.x GROUP BY a.x ORDER BY a.x;",
+        dt);
+      c("SELECT COUNT(*) FROM test a, test_inner b, test c WHERE b.x = a.x AND "
+        "c.y = a.y AND c.x = b.x;",
+        dt);
+    }
+  }
+}
+
 TEST_F(Select, Joins_OneOuterExpression) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -10854,6 +12436,34 @@ TEST_F(Select, Joins_OneOuterExpression) {
   }
 }
 
+TEST_F(Select, MultiFragmentIntermediateResults) {
+  const auto multifrag_rs_state = config().exec.enable_multifrag_rs;
+  ScopeGuard reset = [multifrag_rs_state] {
+    config().exec.enable_multifrag_rs = multifrag_rs_state;
+  };
+
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    for (bool enable_multifrag_rs : {false, true}) {
+      config().exec.enable_multifrag_rs = enable_multifrag_rs;
+      c("SELECT MIN(yy), MAX(yy) FROM (SELECT AVG(y) as yy FROM test GROUP BY x);", dt);
+      c("SELECT COUNT(*), SUM(y) FROM (SELECT x, y FROM test WHERE x > 7 LIMIT 100) "
+        "WHERE y > 41;",
+        dt);
+      c("SELECT x, COUNT(*) FROM (SELECT x, y FROM test ORDER BY y, x LIMIT 10) GROUP "
+        "BY x ORDER BY x;",
+        dt);
+      c("SELECT COUNT(*) FROM test, (SELECT x FROM test_inner) AS inner_x WHERE "
+        "test.x = inner_x.x;",
+        dt);
+      c("SELECT a.x, a.n, b.y FROM (SELECT x, COUNT(*) AS n FROM test GROUP BY x) a "
+        "JOIN (SELECT x, MAX(y) AS y FROM test WHERE y > 41 GROUP BY x) b ON a.x = b.x "
+        "ORDER BY a.x;",
+        dt);
+    }
+  }
+}
+
 TEST_F(Select, Joins_Subqueries) {
   if (config().rs.enable_columnar_output) {
     // TODO(adb): fixup these tests under columnar
@@ -15640,6 +17250,34 @@ TEST_F(Select, Correlated_Exists) {
   }
 }
 
+TEST_F(Select, Correlated_Exists_DuplicateInnerKeys) {
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+
+    // test.x has more rows than distinct values, semi and anti joins should still use
+    // one-to-one hash sets and produce each outer row once
+    c("SELECT i.x FROM test_inner i WHERE EXISTS (SELECT * FROM test t WHERE "
+      "t.x = i.x) ORDER BY i.x;",
+      dt);
+    c("SELECT i.x FROM test_inner i WHERE NOT EXISTS (SELECT * FROM test t WHERE "
+      "t.x = i.x) ORDER BY i.x;",
+      dt);
+    c("SELECT i.x FROM test_inner i WHERE EXISTS (SELECT * FROM test t WHERE "
+      "t.x = i.x AND t.y = i.y) ORDER BY i.x;",
+      dt);
+    c("SELECT i.x FROM test_inner i WHERE NOT EXISTS (SELECT * FROM test t WHERE "
+      "t.x = i.x AND t.y = i.y) ORDER BY i.x;",
+      dt);
+    // the inequality has to be checked against every inner row with a matching key
+    c("SELECT i.x FROM test_inner i WHERE EXISTS (SELECT * FROM test t WHERE "
+      "t.x = i.x AND t.y > i.y) ORDER BY i.x;",
+      dt);
+    c("SELECT i.x FROM test_inner i WHERE NOT EXISTS (SELECT * FROM test t WHERE "
+      "t.x = i.x AND t.y > i.y) ORDER BY i.x;",
+      dt);
+  }
+}
+
 TEST_F(Select, Correlated_In) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -16824,6 +18462,101 @@ TEST_F(Select, WindowFunctionSum) {
   }
 }
 
+TEST_F(Select, WindowFunctionParallelPartitions) {
+  ScopeGuard reset = [orig = config().exec.window_func] {
+    config().exec.window_func = orig;
+  };
+  // Split every partition between threads, including single-row ones.
+  config().exec.window_func.parallel_window_partition_compute_threshold = 1;
+  config().exec.window_func.parallel_window_partition_sort_threshold = 1;
+  const ExecutorDeviceType dt = ExecutorDeviceType::CPU;
+  for (std::string table_name : {"test_window_func", "test_window_func_multi_frag"}) {
+    {
+      std::string query =
+          "SELECT x, y, ROW_NUMBER() OVER (PARTITION BY y ORDER BY x ASC) r, NTILE(2) "
+          "OVER (PARTITION BY y ORDER BY x ASC) n FROM " +
+          table_name + " ORDER BY x ASC NULLS FIRST, y ASC NULLS FIRST, r ASC;";
+      c(query, query, dt);
+    }
+    {
+      std::string part1 =
+          "SELECT x, y, AVG(x) OVER (PARTITION BY y ORDER BY x ASC) a, SUM(x) OVER "
+          "(ORDER BY x ASC) s, COUNT(*) OVER (PARTITION BY y) c FROM " +
+          table_name + " ORDER BY x ASC";
+      std::string part2 = "a ASC, s ASC, c ASC;";
+      c(part1 + " NULLS FIRST, y ASC NULLS FIRST, " + part2,
+        part1 + ", y ASC, " + part2,
+        dt);
+    }
+  }
+}
+
+TEST_F(Select, WindowFunctionSharedPartitions) {
+  const ExecutorDeviceType dt = ExecutorDeviceType::CPU;
+  for (std::string table_name : {"test_window_func", "test_window_func_multi_frag"}) {
+    std::string part1 =
+        "SELECT x, y, ROW_NUMBER() OVER (PARTITION BY y ORDER BY x ASC) r1, RANK() OVER "
+        "(PARTITION BY y ORDER BY x ASC) r2, DENSE_RANK() OVER (PARTITION BY y ORDER BY "
+        "x DESC) r3, SUM(x) OVER (PARTITION BY y ORDER BY x ASC) s, COUNT(*) OVER "
+        "(PARTITION BY y) c, ROW_NUMBER() OVER (ORDER BY x ASC) r4, MIN(x) OVER (ORDER "
+        "BY x ASC) m FROM " +
+        table_name + " ORDER BY x ASC";
+    std::string part2 = "r1 ASC, r2 ASC, r3 ASC, s ASC, c ASC, r4 ASC, m ASC;";
+    c(part1 + " NULLS FIRST, y ASC NULLS FIRST, " + part2,
+      part1 + ", y ASC, " + part2,
+      dt);
+  }
+}
+
+TEST_F(Select, WindowFunctionGpuPartitionSort) {
+  ScopeGuard reset = [orig = config().exec.window_func] {
+    config().exec.window_func = orig;
+  };
+  // Sort partitions of any size on GPU if there is one.
+  config().exec.window_func.gpu_partition_sort = true;
+  config().exec.window_func.gpu_partition_sort_threshold = 1;
+  const ExecutorDeviceType dt = ExecutorDeviceType::CPU;
+  for (std::string table_name : {"test_window_func", "test_window_func_multi_frag"}) {
+    std::string part1 =
+        "SELECT x, y, ROW_NUMBER() OVER (PARTITION BY y ORDER BY x ASC) r1, RANK() OVER "
+        "(PARTITION BY y ORDER BY x DESC) r2, SUM(x) OVER (PARTITION BY y ORDER BY x "
+        "ASC) s, ROW_NUMBER() OVER (ORDER BY y DESC, x ASC) r3 FROM " +
+        table_name + " ORDER BY x ASC";
+    std::string part2 = "r1 ASC, r2 ASC, s ASC, r3 ASC;";
+    c(part1 + " NULLS FIRST, y ASC NULLS FIRST, " + part2,
+      part1 + ", y ASC, " + part2,
+      dt);
+  }
+}
+
+TEST_F(Select, WindowFunctionPartitionLimits) {
+  ScopeGuard reset = [orig = config().exec.window_func] {
+    config().exec.window_func = orig;
+  };
+  const ExecutorDeviceType dt = ExecutorDeviceType::CPU;
+  for (bool enable_partition_limits : {false, true}) {
+    config().exec.window_func.enable_partition_limits = enable_partition_limits;
+    for (std::string table_name : {"test_window_func", "test_window_func_multi_frag"}) {
+      for (std::string window_and_filter :
+           {"ROW_NUMBER() OVER (PARTITION BY y ORDER BY x ASC) r FROM " + table_name +
+                ") WHERE r <= 2",
+            "RANK() OVER (PARTITION BY y ORDER BY x DESC) r FROM " + table_name +
+                ") WHERE r < 3",
+            "ROW_NUMBER() OVER (ORDER BY x ASC) r FROM " + table_name +
+                ") WHERE 3 >= r AND r > 1",
+            "RANK() OVER (PARTITION BY y ORDER BY x ASC) r FROM " + table_name +
+                ") WHERE r = 1"}) {
+        std::string part1 = "SELECT x, y, r FROM (SELECT x, y, " + window_and_filter +
+                            " ORDER BY x ASC";
+        std::string part2 = "r ASC;";
+        c(part1 + " NULLS FIRST, y ASC NULLS FIRST, " + part2,
+          part1 + ", y ASC, " + part2,
+          dt);
+      }
+    }
+  }
+}
+
 TEST_F(Select, WindowFunctionComplexExpressions) {
   const ExecutorDeviceType dt = ExecutorDeviceType::CPU;
   for (std::string table_name : {"test_window_func", "test_window_func_multi_frag"}) {
@@ -18018,6 +19751,12 @@ int main(int argc, char** argv) {
           ->default_value(config->exec.heterogeneous.enable_heterogeneous_execution)
           ->implicit_value(true),
       "Allow heterogeneous execution.");
+  desc.add_options()(
+      "enable-heterogeneous-work-stealing",
+      po::value<bool>(&config->exec.heterogeneous.enable_work_stealing)
+          ->default_value(config->exec.heterogeneous.enable_work_stealing)
+          ->implicit_value(true),
+      "Allow work stealing between devices in heterogeneous execution.");
   desc.add_options()(
       "force-heterogeneous-distribution",
       po::value<bool>(&config->exec.heterogeneous.forced_heterogeneous_distribution)
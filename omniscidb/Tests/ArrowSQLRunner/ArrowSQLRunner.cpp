@@ -14,6 +14,7 @@
 
 #include "ArrowSQLRunner.h"
 #include "RelAlgCache.h"
+#include "WorkloadCapture.h"
 
 #include "Calcite/CalciteJNI.h"
 #include "DataMgr/DataMgr.h"
@@ -26,6 +27,9 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <mutex>
+
 namespace TestHelpers::ArrowSQLRunner {
 
 namespace {
@@ -78,8 +82,12 @@ class ArrowSQLRunnerImpl {
   std::string getSqlQueryRelAlg(const std::string& sql) {
     std::string query_ra;
 
-    calcite_time_ += measure<std::chrono::microseconds>::execution(
-        [&]() { query_ra = rel_alg_cache_->process("test_db", sql, {}, true); });
+    calcite_time_ += measure<std::chrono::microseconds>::execution([&]() {
+      // RelAlgCache is not synchronized and queries can be issued concurrently
+      // by replayed workloads.
+      std::lock_guard<std::mutex> lock(parse_mutex_);
+      query_ra = rel_alg_cache_->process("test_db", sql, {}, true);
+    });
 
     return query_ra;
   }
@@ -97,6 +105,10 @@ class ArrowSQLRunnerImpl {
                               const CompilationOptions& co,
                               const ExecutionOptions& eo) {
     LOG(INFO) << "Executing sql: " << sql << " on: " << co.device_type;
+    if (workload_capture_) {
+      return runCapturedSqlQuery(sql, co, eo);
+    }
+
     auto ra_executor = makeRelAlgExecutor(sql);
     ExecutionResult res;
 
@@ -106,6 +118,41 @@ class ArrowSQLRunnerImpl {
     return res;
   }
 
+  // Runs the query with a profile to record its phase times in the workload capture.
+  // Failed queries are recorded too, so replay reproduces the same load.
+  ExecutionResult runCapturedSqlQuery(const std::string& sql,
+                                      const CompilationOptions& co,
+                                      const ExecutionOptions& eo) {
+    WorkloadQuery query;
+    query.sql = sql;
+    query.device_type = co.device_type == ExecutorDeviceType::GPU ? "GPU" : "CPU";
+    query.start_offset = workload_capture_->now();
+
+    auto profiled_eo = eo;
+    profiled_eo.with_profile = true;
+    ExecutionResult res;
+    try {
+      std::unique_ptr<RelAlgExecutor> ra_executor;
+      query.parse_time = measure<std::chrono::microseconds>::execution(
+          [&]() { ra_executor = makeRelAlgExecutor(sql); });
+      execution_time_ += measure<std::chrono::microseconds>::execution(
+          [&]() { res = ra_executor->executeRelAlgQuery(co, profiled_eo, false); });
+    } catch (...) {
+      query.succeeded = false;
+      query.total_time = workload_capture_->now() - query.start_offset;
+      workload_capture_->record(std::move(query), nullptr);
+      throw;
+    }
+    query.total_time = workload_capture_->now() - query.start_offset;
+    workload_capture_->record(std::move(query), res.getProfile().get());
+
+    // Keep results the same as without capture.
+    if (!eo.with_profile) {
+      res.setProfile(nullptr);
+    }
+    return res;
+  }
+
   ExecutionResult runSqlQuery(const std::string& sql,
                               ExecutorDeviceType device_type,
                               const ExecutionOptions& eo) {
@@ -301,6 +348,7 @@ class ArrowSQLRunnerImpl {
   CalciteMgr* getCalcite() { return calcite_; }
 
   ~ArrowSQLRunnerImpl() {
+    workload_capture_.reset();
     executor_.reset();
     storage_.reset();
     rs_registry_.reset();
@@ -333,7 +381,7 @@ class ArrowSQLRunnerImpl {
     executor_->setSchemaProvider(schema_mgr_);
 
     if (config_->debug.use_ra_cache.empty() || !config_->debug.build_ra_cache.empty()) {
-      calcite_ = CalciteMgr::get(udf_filename, 1024);
+      calcite_ = CalciteMgr::get(udf_filename, 1024, config_->exec.calcite_workers);
 
       if (config_->debug.use_ra_cache.empty()) {
         ExtensionFunctionsWhitelist::add(calcite_->getExtensionFunctionWhitelist());
@@ -347,6 +395,11 @@ class ArrowSQLRunnerImpl {
     }
 
     rel_alg_cache_ = std::make_shared<RelAlgCache>(calcite_, schema_mgr_, config_);
+
+    if (!config_->debug.workload_capture_file.empty()) {
+      workload_capture_ =
+          std::make_unique<WorkloadCapture>(config_->debug.workload_capture_file);
+    }
   }
 
   ConfigPtr config_;
@@ -357,10 +410,12 @@ class ArrowSQLRunnerImpl {
   std::shared_ptr<SchemaMgr> schema_mgr_;
   CalciteMgr* calcite_;
   std::shared_ptr<RelAlgCache> rel_alg_cache_;
+  std::unique_ptr<WorkloadCapture> workload_capture_;
+  std::mutex parse_mutex_;
 
   SQLiteComparator sqlite_comparator_;
-  int64_t calcite_time_ = 0;
-  int64_t execution_time_ = 0;
+  std::atomic<int64_t> calcite_time_ = 0;
+  std::atomic<int64_t> execution_time_ = 0;
 
   static std::unique_ptr<ArrowSQLRunnerImpl> instance_;
 };
@@ -0,0 +1,154 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "WorkloadCapture.h"
+
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+namespace {
+
+std::string toJsonLine(const WorkloadQuery& query) {
+  rapidjson::StringBuffer buf;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buf);
+  writer.StartObject();
+  writer.Key("sql");
+  writer.String(query.sql.c_str());
+  writer.Key("device_type");
+  writer.String(query.device_type.c_str());
+  writer.Key("thread");
+  writer.Uint64(query.thread_idx);
+  writer.Key("start_offset");
+  writer.Int64(query.start_offset);
+  writer.Key("total_time");
+  writer.Int64(query.total_time);
+  writer.Key("parse_time");
+  writer.Int64(query.parse_time);
+  writer.Key("compilation_time");
+  writer.Int64(query.compilation_time);
+  writer.Key("hash_table_build_time");
+  writer.Int64(query.hash_table_build_time);
+  writer.Key("reduction_time");
+  writer.Int64(query.reduction_time);
+  writer.Key("fetch_time");
+  writer.Int64(query.fetch_time);
+  writer.Key("kernel_time");
+  writer.Int64(query.kernel_time);
+  writer.Key("succeeded");
+  writer.Bool(query.succeeded);
+  writer.EndObject();
+  return buf.GetString();
+}
+
+int64_t getInt64(const rapidjson::Value& obj, const char* name) {
+  if (!obj.HasMember(name)) {
+    return 0;
+  }
+  if (!obj[name].IsInt64()) {
+    throw std::runtime_error(std::string("Malformed workload entry field: ") + name);
+  }
+  return obj[name].GetInt64();
+}
+
+}  // namespace
+
+WorkloadCapture::WorkloadCapture(const std::string& file_name)
+    : fs_(file_name, std::ios::out | std::ios::trunc)
+    , start_(std::chrono::steady_clock::now()) {
+  if (!fs_.is_open()) {
+    throw std::runtime_error("Cannot open file to write workload: " + file_name);
+  }
+}
+
+int64_t WorkloadCapture::now() const {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - start_)
+      .count();
+}
+
+void WorkloadCapture::record(WorkloadQuery query, const QueryProfile* profile) {
+  if (profile) {
+    addProfileTimes(query, *profile);
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto thread_it =
+      thread_ids_.emplace(std::this_thread::get_id(), thread_ids_.size()).first;
+  query.thread_idx = thread_it->second;
+  fs_ << toJsonLine(query) << std::endl;
+}
+
+void addProfileTimes(WorkloadQuery& query, const QueryProfile& profile) {
+  for (auto& step : profile.steps()) {
+    query.compilation_time += step.compilation_time;
+    query.hash_table_build_time += step.hash_table_build_time;
+    query.reduction_time += step.reduction_time;
+    for (auto& kernel : step.kernels) {
+      query.fetch_time += kernel.fetch_time;
+      query.kernel_time += kernel.execution_time;
+    }
+  }
+}
+
+std::vector<WorkloadQuery> loadWorkload(const std::string& file_name) {
+  std::ifstream fs(file_name);
+  if (!fs.is_open()) {
+    throw std::runtime_error("Cannot open file to read workload: " + file_name);
+  }
+
+  std::vector<WorkloadQuery> res;
+  std::string line;
+  while (std::getline(fs, line)) {
+    if (line.empty()) {
+      continue;
+    }
+    rapidjson::Document doc;
+    doc.Parse(line.c_str());
+    if (doc.HasParseError() || !doc.IsObject() || !doc.HasMember("sql") ||
+        !doc["sql"].IsString()) {
+      throw std::runtime_error("Malformed workload entry: " + line);
+    }
+
+    WorkloadQuery query;
+    query.sql = doc["sql"].GetString();
+    if (doc.HasMember("device_type") && doc["device_type"].IsString()) {
+      query.device_type = doc["device_type"].GetString();
+    }
+    query.thread_idx = static_cast<size_t>(getInt64(doc, "thread"));
+    query.start_offset = getInt64(doc, "start_offset");
+    query.total_time = getInt64(doc, "total_time");
+    query.parse_time = getInt64(doc, "parse_time");
+    query.compilation_time = getInt64(doc, "compilation_time");
+    query.hash_table_build_time = getInt64(doc, "hash_table_build_time");
+    query.reduction_time = getInt64(doc, "reduction_time");
+    query.fetch_time = getInt64(doc, "fetch_time");
+    query.kernel_time = getInt64(doc, "kernel_time");
+    query.succeeded = !doc.HasMember("succeeded") || !doc["succeeded"].IsBool() ||
+                      doc["succeeded"].GetBool();
+    res.push_back(std::move(query));
+  }
+  return res;
+}
+
+void storeWorkload(const std::string& file_name,
+                   const std::vector<WorkloadQuery>& queries) {
+  std::ofstream fs(file_name, std::ios::out | std::ios::trunc);
+  if (!fs.is_open()) {
+    throw std::runtime_error("Cannot open file to write workload: " + file_name);
+  }
+  for (auto& query : queries) {
+    fs << toJsonLine(query) << '\n';
+  }
+}
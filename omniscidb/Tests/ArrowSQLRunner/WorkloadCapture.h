@@ -0,0 +1,77 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    WorkloadCapture.h
+ * @brief   Recording of executed SQL queries with their timings for later replay.
+ *
+ * Each query is written as a JSON object on its own line, so a capture interrupted
+ * by a crash is still readable up to the last completed query. All times are in
+ * microseconds, start offsets are relative to the creation of the capture.
+ **/
+
+#pragma once
+
+#include "QueryEngine/QueryProfile.h"
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+struct WorkloadQuery {
+  std::string sql;
+  std::string device_type;
+  // Index of the issuing thread in order of the first query of each thread.
+  size_t thread_idx{0};
+  int64_t start_offset{0};
+  int64_t total_time{0};
+  int64_t parse_time{0};
+  int64_t compilation_time{0};
+  int64_t hash_table_build_time{0};
+  int64_t reduction_time{0};
+  int64_t fetch_time{0};
+  int64_t kernel_time{0};
+  bool succeeded{true};
+};
+
+class WorkloadCapture {
+ public:
+  WorkloadCapture(const std::string& file_name);
+
+  // Offset of the current moment from the start of the capture.
+  int64_t now() const;
+
+  // Phase times are taken from the profile when it is not null. Safe to call from
+  // multiple threads.
+  void record(WorkloadQuery query, const QueryProfile* profile);
+
+ private:
+  std::mutex mutex_;
+  std::ofstream fs_;
+  std::chrono::steady_clock::time_point start_;
+  std::unordered_map<std::thread::id, size_t> thread_ids_;
+};
+
+// Accumulates phase times of all steps and kernels of the profile into the query.
+void addProfileTimes(WorkloadQuery& query, const QueryProfile& profile);
+
+std::vector<WorkloadQuery> loadWorkload(const std::string& file_name);
+
+void storeWorkload(const std::string& file_name,
+                   const std::vector<WorkloadQuery>& queries);
@@ -16,6 +16,9 @@
 
 #include "TestHelpers.h"
 
+#include <arrow/io/api.h>
+#include <arrow/ipc/api.h>
+#include <boost/filesystem.hpp>
 #include <gtest/gtest.h>
 
 #define EXPECT_THROW_WITH_MESSAGE(stmt, etype, whatstring) \
@@ -743,6 +746,174 @@ TEST_F(ArrowStorageTest, ImportArrowTable) {
   storage.dropTable("test_empty");
 }
 
+namespace {
+
+std::shared_ptr<arrow::Table> makeChunkedInt64Table(
+    const std::vector<std::vector<int64_t>>& chunks) {
+  arrow::ArrayVector arrays;
+  for (auto& vals : chunks) {
+    std::shared_ptr<arrow::Array> arr;
+    arrow::NumericBuilder<arrow::Int64Type> builder;
+    builder.AppendValues(vals);
+    builder.Finish(&arr);
+    arrays.push_back(arr);
+  }
+  auto schema = arrow::schema({arrow::field("A", arrow::int64())});
+  return arrow::Table::Make(
+      schema, {arrow::ChunkedArray::Make(std::move(arrays)).ValueOrDie()});
+}
+
+std::vector<size_t> getFragmentSizes(ArrowStorage& storage, int table_id) {
+  std::vector<size_t> res;
+  for (auto& frag : storage.getTableMetadata(TEST_DB_ID, table_id).fragments) {
+    res.push_back(frag.getNumTuples());
+  }
+  return res;
+}
+
+}  // namespace
+
+TEST_F(ArrowStorageTest, ImportArrowTable_AlignFragmentsToChunks) {
+  ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID);
+  ArrowStorage::TableOptions options{3};
+  options.align_fragments_to_chunks = true;
+  options.min_fragment_size = 1;
+  auto tinfo = storage.importArrowTable(
+      makeChunkedInt64Table({{1, 2, 3, 4}, {5, 6, 7, 8}, {9, 10}}), "test1", options);
+  ASSERT_EQ(getFragmentSizes(storage, tinfo->table_id),
+            std::vector<size_t>({2, 2, 2, 2, 2}));
+  auto col_info = storage.getColumnInfo(*tinfo, "A");
+  for (int frag_id = 1; frag_id <= 5; ++frag_id) {
+    auto token = storage.getZeroCopyBufferMemory(
+        {TEST_DB_ID, tinfo->table_id, col_info->column_id, frag_id}, 0);
+    ASSERT_NE(token, nullptr);
+    auto vals = reinterpret_cast<const int64_t*>(token->getMemoryPtr());
+    ASSERT_EQ(token->getSize(), 2 * sizeof(int64_t));
+    ASSERT_EQ(vals[0], frag_id * 2 - 1);
+    ASSERT_EQ(vals[1], frag_id * 2);
+  }
+}
+
+TEST_F(ArrowStorageTest, ImportArrowTable_AlignFragmentsToChunks_MergeSmall) {
+  ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID);
+  ArrowStorage::TableOptions options{4};
+  options.align_fragments_to_chunks = true;
+  options.min_fragment_size = 2;
+  auto tinfo = storage.importArrowTable(
+      makeChunkedInt64Table({{1}, {2}, {3}, {4, 5, 6, 7, 8}}), "test1", options);
+  ASSERT_EQ(getFragmentSizes(storage, tinfo->table_id), std::vector<size_t>({2, 3, 3}));
+  storage.appendArrowTable(makeChunkedInt64Table({{9, 10}}), tinfo->table_id);
+  ASSERT_EQ(getFragmentSizes(storage, tinfo->table_id),
+            std::vector<size_t>({2, 3, 3, 2}));
+}
+
+TEST_F(ArrowStorageTest, ImportArrowIpc_ZeroCopy) {
+  auto at = makeChunkedInt64Table({{1, 2, 3}, {4, 5, 6}});
+  auto file_name = (boost::filesystem::temp_directory_path() /
+                    boost::filesystem::unique_path("%%%%-%%%%-%%%%.arrow"))
+                       .string();
+  {
+    auto out = arrow::io::FileOutputStream::Open(file_name).ValueOrDie();
+    auto writer = arrow::ipc::MakeFileWriter(out, at->schema()).ValueOrDie();
+    ASSERT_TRUE(writer->WriteTable(*at, 3).ok());
+    ASSERT_TRUE(writer->Close().ok());
+    ASSERT_TRUE(out->Close().ok());
+  }
+
+  ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID);
+  ArrowStorage::TableOptions options{3};
+  options.align_fragments_to_chunks = true;
+  auto tinfo = storage.importArrowIpcFile(file_name, "test1", options);
+  ASSERT_EQ(getFragmentSizes(storage, tinfo->table_id), std::vector<size_t>({3, 3}));
+  auto col_info = storage.getColumnInfo(*tinfo, "A");
+  for (int frag_id = 1; frag_id <= 2; ++frag_id) {
+    auto token = storage.getZeroCopyBufferMemory(
+        {TEST_DB_ID, tinfo->table_id, col_info->column_id, frag_id}, 0);
+    ASSERT_NE(token, nullptr);
+    auto vals = reinterpret_cast<const int64_t*>(token->getMemoryPtr());
+    ASSERT_EQ(vals[0], frag_id * 3 - 2);
+    ASSERT_EQ(vals[2], frag_id * 3);
+  }
+  storage.appendArrowIpcFile(file_name, tinfo->table_id);
+  ASSERT_EQ(getFragmentSizes(storage, tinfo->table_id),
+            std::vector<size_t>({3, 3, 3, 3}));
+
+  storage.dropTable("test1");
+  boost::filesystem::remove(file_name);
+}
+
+TEST_F(ArrowStorageTest, SharedTable) {
+  auto segment_dir = (boost::filesystem::temp_directory_path() /
+                      boost::filesystem::unique_path("%%%%-%%%%-%%%%"))
+                         .string();
+  ASSERT_EQ(ArrowStorage::publishSharedGeneration(
+                segment_dir, makeChunkedInt64Table({{1, 2, 3}, {4, 5, 6}})),
+            (size_t)0);
+  ASSERT_EQ(ArrowStorage::publishSharedGeneration(segment_dir,
+                                                  makeChunkedInt64Table({{7, 8, 9}})),
+            (size_t)1);
+
+  // Storages of different processes attach to the same segment.
+  ArrowStorage::TableOptions options{3};
+  options.align_fragments_to_chunks = true;
+  ArrowStorage storage1(TEST_SCHEMA_ID, "test", TEST_DB_ID);
+  ArrowStorage storage2(TEST_SCHEMA_ID, "test", TEST_DB_ID);
+  auto tinfo1 = storage1.attachSharedTable(segment_dir, "test1", options);
+  auto tinfo2 = storage2.attachSharedTable(segment_dir, "test1", options);
+  ASSERT_EQ(tinfo1->row_count, (size_t)9);
+  ASSERT_EQ(getFragmentSizes(storage2, tinfo2->table_id),
+            std::vector<size_t>({3, 3, 3}));
+  auto col_info = storage1.getColumnInfo(*tinfo1, "A");
+  for (int frag_id = 1; frag_id <= 3; ++frag_id) {
+    auto token = storage1.getZeroCopyBufferMemory(
+        {TEST_DB_ID, tinfo1->table_id, col_info->column_id, frag_id}, 0);
+    ASSERT_NE(token, nullptr);
+    auto vals = reinterpret_cast<const int64_t*>(token->getMemoryPtr());
+    ASSERT_EQ(vals[0], frag_id * 3 - 2);
+    ASSERT_EQ(vals[2], frag_id * 3);
+  }
+
+  ASSERT_EQ(storage1.refreshSharedTable("test1"), (size_t)0);
+  ArrowStorage::publishSharedGeneration(segment_dir, makeChunkedInt64Table({{10, 11}}));
+  ASSERT_EQ(storage1.refreshSharedTable("test1"), (size_t)1);
+  ASSERT_EQ(getFragmentSizes(storage1, tinfo1->table_id),
+            std::vector<size_t>({3, 3, 3, 2}));
+  ASSERT_EQ(getFragmentSizes(storage2, tinfo2->table_id),
+            std::vector<size_t>({3, 3, 3}));
+
+  storage1.dropTable("test1");
+  storage2.dropTable("test1");
+  boost::filesystem::remove_all(segment_dir);
+}
+
+TEST_F(ArrowStorageTest, AppendArrowTable_Streaming) {
+  ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID);
+  ArrowStorage::TableOptions options{3};
+  options.streaming_append = true;
+  auto tinfo = storage.importArrowTable(makeChunkedInt64Table({{1, 2}}), "test1", options);
+  // Snapshot taken before append should stay valid.
+  auto meta = storage.getTableMetadata(TEST_DB_ID, tinfo->table_id);
+  storage.appendArrowTable(makeChunkedInt64Table({{3, 4}}), tinfo->table_id);
+  ASSERT_EQ(getFragmentSizes(storage, tinfo->table_id), std::vector<size_t>({2, 2}));
+  ASSERT_EQ(meta.fragments.size(), (size_t)1);
+  ASSERT_EQ(meta.fragments[0].getNumTuples(), (size_t)2);
+  checkData(storage, tinfo->table_id, 4, 2, range(4, (int64_t)1));
+}
+
+TEST_F(ArrowStorageTest, AppendArrowTable_ClusterKeys) {
+  ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID);
+  ArrowStorage::TableOptions options{2};
+  options.cluster_keys = {"A"};
+  auto tinfo = storage.importArrowTable(
+      makeChunkedInt64Table({{4, 1, 3}, {2, 6, 5}}), "test1", options);
+  checkData(storage, tinfo->table_id, 6, 2, range(6, (int64_t)1));
+  // Rows are sorted within each appended batch only.
+  storage.appendArrowTable(makeChunkedInt64Table({{8, 7}}), tinfo->table_id);
+  checkData(storage, tinfo->table_id, 8, 2, range(8, (int64_t)1));
+  ASSERT_THROW(storage.createTable("test2", {{"col1", ctx.int32()}}, options),
+               std::runtime_error);
+}
+
 TEST_F(ArrowStorageTest, DropTable) {
   ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID);
   auto tinfo = storage.createTable("table1",
@@ -848,6 +1019,16 @@ TEST_F(ArrowStorageTest, ImportCsv_KnownSchema_Numbers_SmallBlock_Multifrag) {
   Test_ImportCsv_Numbers("numbers_header.csv", parse_options, true, 1);
 }
 
+TEST_F(ArrowStorageTest, ImportCsv_KnownSchema_Numbers_Streaming_Multifrag) {
+  ArrowStorage::CsvParseOptions parse_options;
+  parse_options.block_size = 20;
+  parse_options.streaming = true;
+  Test_ImportCsv_Numbers("numbers_header.csv", parse_options, true);
+  Test_ImportCsv_Numbers("numbers_header.csv", parse_options, true, 5);
+  Test_ImportCsv_Numbers("numbers_header.csv", parse_options, true, 2);
+  Test_ImportCsv_Numbers("numbers_header.csv", parse_options, true, 1);
+}
+
 TEST_F(ArrowStorageTest, ImportCsv_UnknownSchema_Numbers_Header) {
   ArrowStorage::CsvParseOptions parse_options;
   Test_ImportCsv_Numbers("numbers_header.csv", parse_options, false);
@@ -1317,6 +1498,38 @@ TEST_F(ArrowStorageTest, AppendCsv_SharedDict) {
   Test_ImportCsv_Dict(true, true, parse_options);
 }
 
+TEST_F(ArrowStorageTest, ImportArrowTable_DictionaryChunks) {
+  auto make_dict = [](const std::vector<std::string>& vals) {
+    arrow::StringBuilder builder;
+    builder.AppendValues(vals);
+    return builder.Finish().ValueOrDie();
+  };
+  auto make_chunk = [](std::shared_ptr<arrow::Array> dict,
+                       const std::vector<int8_t>& indices) {
+    arrow::Int8Builder builder;
+    builder.AppendValues(indices);
+    auto type = arrow::dictionary(arrow::int8(), arrow::utf8());
+    return arrow::DictionaryArray::FromArrays(type, builder.Finish().ValueOrDie(), dict)
+        .ValueOrDie();
+  };
+  auto dict1 = make_dict({"a", "b", "c"});
+  auto dict2 = make_dict({"c", "d"});
+  auto col = arrow::ChunkedArray::Make({make_chunk(dict1, {0, 1, 2}),
+                                        make_chunk(dict1, {2, 2, 0}),
+                                        make_chunk(dict2, {1, 0})})
+                 .ValueOrDie();
+  auto schema = arrow::schema({arrow::field("A", col->type())});
+  auto at = arrow::Table::Make(schema, {col});
+
+  ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID);
+  auto tinfo = storage.importArrowTable(at, "table1", ArrowStorage::TableOptions{3});
+  checkData(storage,
+            tinfo->table_id,
+            8,
+            3,
+            std::vector<std::string>({"a"s, "b"s, "c"s, "c"s, "c"s, "a"s, "d"s, "c"s}));
+}
+
 TEST_F(ArrowStorageTest, AppendJsonData) {
   ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID);
   TableInfoPtr tinfo = storage.createTable(
@@ -1334,6 +1547,71 @@ TEST_F(ArrowStorageTest, AppendJsonData) {
             std::vector<std::string>({"s1"s, "s2"s, "s3"s}));
 }
 
+void Test_ImportJson_Numbers(const ArrowStorage::JsonParseOptions parse_options,
+                             bool pass_schema,
+                             size_t fragment_size = 32'000'000) {
+  ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID);
+  ArrowStorage::TableOptions table_options;
+  table_options.fragment_size = fragment_size;
+  TableInfoPtr tinfo;
+  if (pass_schema) {
+    tinfo = storage.importJsonFile(getFilePath("numbers.json"),
+                                   "table1",
+                                   {{"col1", ctx.int32()}, {"col2", ctx.fp32()}},
+                                   table_options,
+                                   parse_options);
+    checkData(storage,
+              tinfo->table_id,
+              9,
+              fragment_size,
+              range(9, (int32_t)1),
+              range(9, 10.0f));
+  } else {
+    tinfo = storage.importJsonFile(
+        getFilePath("numbers.json"), "table1", table_options, parse_options);
+    checkData(
+        storage, tinfo->table_id, 9, fragment_size, range(9, (int64_t)1), range(9, 10.0));
+  }
+}
+
+TEST_F(ArrowStorageTest, ImportJson_KnownSchema_Numbers) {
+  ArrowStorage::JsonParseOptions parse_options;
+  Test_ImportJson_Numbers(parse_options, true);
+  Test_ImportJson_Numbers(parse_options, true, 2);
+}
+
+TEST_F(ArrowStorageTest, ImportJson_UnknownSchema_Numbers) {
+  ArrowStorage::JsonParseOptions parse_options;
+  Test_ImportJson_Numbers(parse_options, false);
+  Test_ImportJson_Numbers(parse_options, false, 2);
+}
+
+TEST_F(ArrowStorageTest, ImportJson_Numbers_SmallBlock_Multifrag) {
+  ArrowStorage::JsonParseOptions parse_options;
+  parse_options.block_size = 64;
+  Test_ImportJson_Numbers(parse_options, true);
+  Test_ImportJson_Numbers(parse_options, true, 5);
+  Test_ImportJson_Numbers(parse_options, false, 1);
+}
+
+TEST_F(ArrowStorageTest, AppendJsonFile) {
+  ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID);
+  ArrowStorage::TableOptions table_options;
+  table_options.fragment_size = 5;
+  TableInfoPtr tinfo = storage.createTable(
+      "table1", {{"col1", ctx.int32()}, {"col2", ctx.fp32()}}, table_options);
+  ArrowStorage::JsonParseOptions parse_options;
+  parse_options.block_size = 64;
+  storage.appendJsonFile(getFilePath("numbers.json"), "table1", parse_options);
+  storage.appendJsonFile(getFilePath("numbers.json"), tinfo->table_id, parse_options);
+  checkData(storage,
+            tinfo->table_id,
+            18,
+            5,
+            duplicate(range(9, (int32_t)1)),
+            duplicate(range(9, 10.0f)));
+}
+
 TEST_F(ArrowStorageTest, AppendJsonData_Arrays) {
   ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID);
   auto int_array = ctx.arrayVarLen(ctx.int32());
@@ -1474,6 +1752,25 @@ TEST_F(ArrowStorageTest, AppendJsonData_DateTime) {
             std::vector<int32_t>({10843, inline_null_value<int32_t>(), 10843}));
 }
 
+TEST_F(ArrowStorageTest, AppendCsvData_TimestampFormats) {
+  ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID);
+  TableInfoPtr tinfo = storage.createTable(
+      "table1", {{"ts_0", ctx.timestamp(hdk::ir::TimeUnit::kSecond)}});
+  ArrowStorage::CsvParseOptions parse_options;
+  parse_options.header = false;
+  parse_options.timestamp_formats = {"%d/%m/%Y %H:%M:%S", "%Y%m%d %H%M%S"};
+  storage.appendCsvData("2014-12-13 22:23:15\n"
+                        "13/12/2014 22:23:15\n"
+                        "20141214 222315",
+                        tinfo->table_id,
+                        parse_options);
+  checkData(storage,
+            tinfo->table_id,
+            3,
+            32'000'000,
+            std::vector<int64_t>({1418509395, 1418509395, 1418595795}));
+}
+
 TEST_F(ArrowStorageTest, AppendJsonData_DateTime_Multifrag) {
   ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID);
   ArrowStorage::TableOptions table_options;
@@ -1745,6 +2042,113 @@ TEST_F(ArrowStorageTest, ImportParquet) {
             std::vector<double>({1.1, 2.2, 3.3, 4.4, 5.5}));
 }
 
+TEST_F(ArrowStorageTest, RegisterParquet) {
+  ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID);
+  auto tinfo = storage.registerParquetFile(getFilePath("int_float.parquet"), "table1");
+
+  checkData(storage,
+            tinfo->table_id,
+            5,
+            32'000'000,
+            std::vector<int64_t>({1, 2, 3, 4, 5}),
+            std::vector<double>({1.1, 2.2, 3.3, 4.4, 5.5}));
+  ASSERT_THROW(storage.appendParquetFile(getFilePath("int_float.parquet"), "table1"),
+               std::runtime_error);
+}
+
+TEST_F(ArrowStorageTest, AppendCsvData_ColumnStats) {
+  ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID);
+  ArrowStorage::TableOptions table_options;
+  table_options.fragment_size = 2;
+  TableInfoPtr tinfo = storage.createTable(
+      "table1", {{"col1", ctx.int32()}, {"col2", ctx.fp64()}}, table_options);
+  ArrowStorage::CsvParseOptions parse_options;
+  parse_options.header = false;
+  storage.appendCsvData("1,1.0\n2,2.0\n2,3.0", tinfo->table_id, parse_options);
+  storage.appendCsvData("3,4.0\n,5.0\n1,6.0", tinfo->table_id, parse_options);
+
+  auto col_infos = storage.listColumns(TEST_DB_ID, tinfo->table_id);
+  auto meta = storage.getTableMetadata(TEST_DB_ID, tinfo->table_id);
+  // Floating point columns have no statistics.
+  ASSERT_EQ(meta.columnStats.size(), (size_t)1);
+  ASSERT_EQ(meta.columnStats.count(col_infos[1]->column_id), (size_t)0);
+  auto& stats = *meta.columnStats.at(col_infos[0]->column_id);
+  ASSERT_EQ(stats.rowCount(), (size_t)6);
+  ASSERT_EQ(stats.nullCount(), (size_t)1);
+  ASSERT_EQ(stats.distinctCount(), (size_t)3);
+}
+
+TEST_F(ArrowStorageTest, TableMetadataSnapshot) {
+  ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID);
+  ArrowStorage::TableOptions table_options;
+  table_options.fragment_size = 2;
+  TableInfoPtr tinfo = storage.createTable(
+      "table1", {{"col1", ctx.int32()}, {"col2", ctx.int64()}}, table_options);
+  ArrowStorage::CsvParseOptions parse_options;
+  parse_options.header = false;
+  storage.appendCsvData("1,10\n2,20\n3,30", tinfo->table_id, parse_options);
+
+  // Unchanged table returns copies of the same snapshot sharing metadata maps.
+  auto meta1 = storage.getTableMetadata(TEST_DB_ID, tinfo->table_id);
+  auto meta2 = storage.getTableMetadata(TEST_DB_ID, tinfo->table_id);
+  ASSERT_EQ(meta1.fragments.size(), (size_t)2);
+  ASSERT_EQ(meta2.fragments.size(), (size_t)2);
+  ASSERT_EQ(&meta1.fragments[0].getChunkMetadataMap(),
+            &meta2.fragments[0].getChunkMetadataMap());
+
+  // Modification of a copy doesn't affect other copies.
+  auto col_infos = storage.listColumns(TEST_DB_ID, tinfo->table_id);
+  const int col_id = col_infos[0]->column_id;
+  auto orig_meta = meta2.fragments[0].getChunkMetadataMap().at(col_id);
+  meta1.fragments[0].setChunkMetadata(
+      col_id, std::make_shared<ChunkMetadata>(ctx.int32(), 0, 0));
+  ASSERT_NE(&meta1.fragments[0].getChunkMetadataMap(),
+            &meta2.fragments[0].getChunkMetadataMap());
+  ASSERT_EQ(meta2.fragments[0].getChunkMetadataMap().at(col_id), orig_meta);
+  auto meta3 = storage.getTableMetadata(TEST_DB_ID, tinfo->table_id);
+  ASSERT_EQ(meta3.fragments[0].getChunkMetadataMap().at(col_id), orig_meta);
+
+  // Append creates a new snapshot.
+  storage.appendCsvData("4,40\n5,50", tinfo->table_id, parse_options);
+  auto meta4 = storage.getTableMetadata(TEST_DB_ID, tinfo->table_id);
+  ASSERT_EQ(meta4.fragments.size(), (size_t)3);
+  ASSERT_EQ(meta4.getPhysicalNumTuples(), (size_t)5);
+  ASSERT_EQ(meta3.fragments.size(), (size_t)2);
+}
+
+TEST_F(ArrowStorageTest, AppendCsvData_ChunkStats_Nulls) {
+  ArrowStorage storage(TEST_SCHEMA_ID, "test", TEST_DB_ID);
+  ArrowStorage::TableOptions table_options;
+  table_options.fragment_size = 2;
+  TableInfoPtr tinfo = storage.createTable("table1",
+                                           {{"col1", ctx.int8()},
+                                            {"col2", ctx.int16()},
+                                            {"col3", ctx.int32()},
+                                            {"col4", ctx.int64()},
+                                            {"col5", ctx.fp64()}},
+                                           table_options);
+  ArrowStorage::CsvParseOptions parse_options;
+  parse_options.header = false;
+  storage.appendCsvData("1,,30,,5.5\n,-20,,40,\n,,,,\n-1,20,-30,-40,\n7,8,9,10,11.5",
+                        tinfo->table_id,
+                        parse_options);
+
+  const auto null8 = inline_null_value<int8_t>();
+  const auto null16 = inline_null_value<int16_t>();
+  const auto null32 = inline_null_value<int32_t>();
+  const auto null64 = inline_null_value<int64_t>();
+  const auto null_fp = inline_null_value<double>();
+  checkData(storage,
+            tinfo->table_id,
+            5,
+            2,
+            std::vector<int8_t>{1, null8, null8, -1, 7},
+            std::vector<int16_t>{null16, -20, null16, 20, 8},
+            std::vector<int32_t>{30, null32, null32, -30, 9},
+            std::vector<int64_t>{null64, 40, null64, -40, 10},
+            std::vector<double>{5.5, null_fp, null_fp, null_fp, 11.5});
+}
+
 int main(int argc, char** argv) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   testing::InitGoogleTest(&argc, argv);
@@ -41,14 +41,16 @@ class ColumnarResultsTester : public ColumnarResults {
                         const size_t num_columns,
                         const std::vector<const hdk::ir::Type*> target_types,
                         Config& config,
-                        const bool is_parallel_execution_enforced = false)
+                        const bool is_parallel_execution_enforced = false,
+                        const std::vector<bool>& columns_to_fetch = {})
       : ColumnarResults(row_set_mem_owner,
                         rows,
                         num_columns,
                         target_types,
                         0,
                         config,
-                        is_parallel_execution_enforced) {}
+                        is_parallel_execution_enforced,
+                        columns_to_fetch) {}
 
   template <typename ENTRY_TYPE>
   ENTRY_TYPE getEntryAt(const size_t row_idx, const size_t column_idx) const {
@@ -190,6 +192,57 @@ void test_columnar_conversion(const std::vector<TargetInfo>& target_infos,
   }
 }
 
+// Check converting columns one by one gives the same data as converting all of them.
+void test_per_column_conversion(const std::vector<TargetInfo>& target_infos,
+                                const QueryMemoryDescriptor& query_mem_desc,
+                                const size_t non_empty_step_size) {
+  auto row_set_mem_owner = std::make_shared<RowSetMemoryOwner>(
+      nullptr, Executor::getArenaBlockSize(), /*num_threads=*/1);
+  ResultSet result_set(target_infos,
+                       ExecutorDeviceType::CPU,
+                       query_mem_desc,
+                       row_set_mem_owner,
+                       nullptr,
+                       0,
+                       0);
+  const auto storage = result_set.allocateStorage();
+  EvenNumberGenerator generator;
+  fill_storage_buffer(storage->getUnderlyingBuffer(),
+                      target_infos,
+                      query_mem_desc,
+                      generator,
+                      non_empty_step_size);
+
+  std::vector<const hdk::ir::Type*> col_types;
+  for (size_t i = 0; i < result_set.colCount(); ++i) {
+    col_types.push_back(result_set.colType(i)->canonicalize());
+  }
+  Config config;
+  ASSERT_TRUE(ColumnarResults::isPerColumnConversionPossible(result_set, config));
+  ColumnarResultsTester all_columns(
+      row_set_mem_owner, result_set, col_types.size(), col_types, config);
+  for (size_t col_idx = 0; col_idx < col_types.size(); ++col_idx) {
+    std::vector<bool> columns_to_fetch(col_types.size(), false);
+    columns_to_fetch[col_idx] = true;
+    ColumnarResultsTester one_column(row_set_mem_owner,
+                                     result_set,
+                                     col_types.size(),
+                                     col_types,
+                                     config,
+                                     false,
+                                     columns_to_fetch);
+    ASSERT_EQ(one_column.size(), all_columns.size());
+    for (size_t other_idx = 0; other_idx < col_types.size(); ++other_idx) {
+      ASSERT_EQ(one_column.getColumnBuffers()[other_idx] != nullptr,
+                other_idx == col_idx);
+    }
+    ASSERT_EQ(memcmp(one_column.getColumnBuffers()[col_idx],
+                     all_columns.getColumnBuffers()[col_idx],
+                     all_columns.size() * col_types[col_idx]->size()),
+              0);
+  }
+}
+
 TEST(Construct, Empty) {
   std::vector<TargetInfo> target_infos;
   std::vector<const hdk::ir::Type*> types;
@@ -1365,6 +1418,27 @@ TEST(BaselineHashColumnar, TwoCol_32_32_MixedAggs_w_avg) {
   }
 }
 
+TEST(PerColumn, PerfectHash_MixedAggs_w_avg) {
+  std::vector<int8_t> key_column_widths{8};
+  const int8_t suggested_agg_width = 8;
+  std::vector<TargetInfo> target_infos =
+      generate_custom_agg_target_infos(key_column_widths,
+                                       {hdk::ir::AggType::kMax,
+                                        hdk::ir::AggType::kAvg,
+                                        hdk::ir::AggType::kMax,
+                                        hdk::ir::AggType::kMax},
+                                       {int16_type, double_type, float_type, int64_type},
+                                       {int16_type, int32_type, float_type, int64_type});
+  for (auto output_columnar : {false, true}) {
+    auto query_mem_desc =
+        perfect_hash_one_col_desc(target_infos, suggested_agg_width, 0, 118);
+    query_mem_desc.setOutputColumnar(output_columnar);
+    for (auto step_size : {1, 2, 13, 67}) {
+      test_per_column_conversion(target_infos, query_mem_desc, step_size);
+    }
+  }
+}
+
 int main(int argc, char** argv) {
   g_is_test_env = true;
 
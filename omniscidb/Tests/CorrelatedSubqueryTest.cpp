@@ -827,6 +827,29 @@ TEST(Select, JoinCorrelation_InClause) {
   ASSERT_EQ(val, 4);
 }
 
+TEST(Select, JoinCorrelation_NotInClause) {
+  int factsCount = 13;
+  int lookupCount = 5;
+  setupTest(ctx().int32(), factsCount, lookupCount);
+
+  // Correlated NOT IN sub-queries are decorrelated into joins.
+  std::string sql =
+      "SELECT fact.id, fact.val FROM test_facts fact WHERE fact.val NOT IN (SELECT "
+      "l.val FROM test_lookup l WHERE fact.id = l.id);";
+  auto results1 = run_multiple_agg(sql, ExecutorDeviceType::CPU);
+  ASSERT_EQ(static_cast<uint32_t>(factsCount - lookupCount), results1->rowCount());
+  for (size_t i = 0; i < results1->rowCount(); ++i) {
+    const auto select_crt_row = results1->getNextRow(true, false);
+    ASSERT_GE(getIntValue(select_crt_row[0]), lookupCount);
+  }
+
+  sql =
+      "SELECT fact.id, fact.val FROM test_facts fact WHERE fact.val NOT IN (SELECT "
+      "l.val FROM test_lookup l WHERE fact.id <> l.id);";
+  auto results2 = run_multiple_agg(sql, ExecutorDeviceType::CPU);
+  ASSERT_EQ(static_cast<uint32_t>(factsCount), results2->rowCount());
+}
+
 TEST(Select, DISABLED_InExpr_As_Child_Operand_Of_OR_Operator) {
   int factsCount = 13;
   int lookupCount = 5;
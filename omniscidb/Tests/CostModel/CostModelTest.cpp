@@ -13,13 +13,17 @@
 
 #include <gtest/gtest.h>
 
+#include <filesystem>
+
 #ifdef HAVE_ARMADILLO
 #include <armadillo>
 #endif
 
 #include "QueryEngine/CostModel/DataSources/DataSource.h"
+#include "QueryEngine/CostModel/DataSources/RuntimeDataSource.h"
 #include "QueryEngine/CostModel/ExtrapolationModels/LinearExtrapolation.h"
 #include "QueryEngine/CostModel/ExtrapolationModels/LinearRegression.h"
+#include "QueryEngine/CostModel/IterativeCostModel.h"
 #include "QueryEngine/CostModel/Measurements.h"
 
 using namespace costmodel;
@@ -47,6 +51,168 @@ TEST(DataSourceTests, SupportCheckTest) {
   ASSERT_FALSE(ds.isTemplateSupported(AnalyticalTemplate::Join));
 }
 
+TEST(DataSourceTests, RuntimeDataSourceTest) {
+  RuntimeDataSource ds(4);
+  ASSERT_TRUE(ds.isDeviceSupported(ExecutorDeviceType::GPU));
+  ASSERT_TRUE(ds.isTemplateSupported(AnalyticalTemplate::Scan));
+
+  // A single size is not enough to build a model.
+  ds.addMeasurement(ExecutorDeviceType::CPU, AnalyticalTemplate::Scan, {10, 10});
+  ds.addMeasurement(ExecutorDeviceType::CPU, AnalyticalTemplate::Scan, {10, 20});
+  ASSERT_TRUE(
+      ds.getTemplateMeasurements(ExecutorDeviceType::CPU, AnalyticalTemplate::Scan)
+          .empty());
+
+  ds.addMeasurement(ExecutorDeviceType::CPU, AnalyticalTemplate::Scan, {30, 60});
+  auto ms = ds.getTemplateMeasurements(ExecutorDeviceType::CPU, AnalyticalTemplate::Scan);
+  ASSERT_EQ(ms.size(), (size_t)2);
+  ASSERT_EQ(ms[0].bytes, (size_t)10);
+  ASSERT_EQ(ms[0].milliseconds, (size_t)15);
+  ASSERT_EQ(ms[1].bytes, (size_t)30);
+  ASSERT_EQ(ms[1].milliseconds, (size_t)60);
+
+  // Old measurements are evicted.
+  ds.addMeasurement(ExecutorDeviceType::CPU, AnalyticalTemplate::Scan, {20, 40});
+  ds.addMeasurement(ExecutorDeviceType::CPU, AnalyticalTemplate::Scan, {40, 80});
+  ms = ds.getTemplateMeasurements(ExecutorDeviceType::CPU, AnalyticalTemplate::Scan);
+  ASSERT_EQ(ms.size(), (size_t)4);
+  ASSERT_EQ(ms[0].bytes, (size_t)10);
+  ASSERT_EQ(ms[0].milliseconds, (size_t)20);
+
+  auto dm = ds.getMeasurements({ExecutorDeviceType::CPU, ExecutorDeviceType::GPU},
+                               {AnalyticalTemplate::Scan, AnalyticalTemplate::Join});
+  ASSERT_EQ(dm.size(), (size_t)1);
+  ASSERT_EQ(dm[ExecutorDeviceType::CPU].size(), (size_t)1);
+}
+
+TEST(CostModelTests, RuntimeMeasurementsTest) {
+  IterativeCostModel cm({std::make_unique<RuntimeDataSource>()});
+  ASSERT_TRUE(cm.collectsRuntimeMeasurements());
+  cm.calibrate({{ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}});
+  ASSERT_THROW(cm.predict({{AnalyticalTemplate::Scan}, 1000}), CostModelException);
+
+  // GPU is three times faster than CPU.
+  for (size_t bytes : {100, 200, 300}) {
+    cm.addRuntimeMeasurement(
+        ExecutorDeviceType::CPU, {AnalyticalTemplate::Scan}, bytes, bytes * 3);
+    cm.addRuntimeMeasurement(
+        ExecutorDeviceType::GPU, {AnalyticalTemplate::Scan}, bytes, bytes);
+  }
+  ASSERT_NO_THROW(cm.predict({{AnalyticalTemplate::Scan}, 1000}));
+}
+
+class FeatureClassCostModel : public IterativeCostModel {
+ public:
+  FeatureClassCostModel() : IterativeCostModel({std::make_unique<RuntimeDataSource>()}) {}
+
+  using IterativeCostModel::getExtrapolations;
+};
+
+TEST(CostModelTests, FeatureClassMeasurementsTest) {
+  QueryFeatures simple;
+  QueryFeatures distinct;
+  distinct.group_key_width = 16;
+  distinct.has_count_distinct = true;
+  ASSERT_NE(simple.getClass(), distinct.getClass());
+  QueryFeatures wide_keys = distinct;
+  wide_keys.group_key_width = 12;
+  ASSERT_EQ(wide_keys.getClass(), distinct.getClass());
+
+  RuntimeDataSource ds;
+  for (size_t bytes : {100, 200}) {
+    ds.addMeasurement(
+        ExecutorDeviceType::CPU, AnalyticalTemplate::GroupBy, {bytes, bytes}, 1);
+  }
+  ASSERT_EQ(
+      ds.getTemplateMeasurements(ExecutorDeviceType::CPU, AnalyticalTemplate::GroupBy)
+          .size(),
+      size_t(2));
+  ASSERT_EQ(ds.getTemplateMeasurements(
+                  ExecutorDeviceType::CPU, AnalyticalTemplate::GroupBy, 1)
+                .size(),
+            size_t(2));
+  ASSERT_TRUE(ds.getTemplateMeasurements(
+                    ExecutorDeviceType::CPU, AnalyticalTemplate::GroupBy, 2)
+                  .empty());
+
+  FeatureClassCostModel cm;
+  cm.calibrate({{ExecutorDeviceType::CPU}});
+  for (size_t bytes : {1000, 2000, 3000}) {
+    cm.addRuntimeMeasurement(
+        ExecutorDeviceType::CPU, {AnalyticalTemplate::GroupBy}, bytes, bytes, simple);
+    cm.addRuntimeMeasurement(ExecutorDeviceType::CPU,
+                             {AnalyticalTemplate::GroupBy},
+                             bytes,
+                             bytes * 10,
+                             distinct);
+  }
+
+  auto get_prediction = [&cm](const std::optional<QueryFeatures>& features) {
+    auto extrapolations =
+        cm.getExtrapolations({ExecutorDeviceType::CPU}, {GroupBy}, features);
+    return extrapolations.at(0).extrapolations.at(0)->getExtrapolatedData(2000);
+  };
+  ASSERT_EQ(get_prediction(simple), size_t(2000));
+  ASSERT_EQ(get_prediction(distinct), size_t(20000));
+  // Template-level models are used for unknown feature classes.
+  auto prediction = get_prediction(std::nullopt);
+  ASSERT_GT(prediction, size_t(2000));
+  ASSERT_LT(prediction, size_t(20000));
+  ASSERT_EQ(get_prediction(wide_keys), size_t(20000));
+  QueryFeatures join;
+  join.join_levels = 1;
+  ASSERT_EQ(get_prediction(join), prediction);
+}
+
+class CountingDataSource : public DataSource {
+ public:
+  CountingDataSource()
+      : DataSource(DataSourceConfig{"CountingDataSource",
+                                    {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU},
+                                    {AnalyticalTemplate::GroupBy,
+                                     AnalyticalTemplate::Join,
+                                     AnalyticalTemplate::Scan,
+                                     AnalyticalTemplate::Sort}}) {}
+
+  Detail::DeviceMeasurements getMeasurements(
+      const std::vector<ExecutorDeviceType>& devices,
+      const std::vector<AnalyticalTemplate>& templates) override {
+    ++calls;
+    Detail::DeviceMeasurements dm;
+    for (auto device : devices) {
+      for (auto templ : templates) {
+        dm[device][templ] = {{10, 10}, {20, 20}};
+      }
+    }
+    return dm;
+  }
+
+  static inline int calls = 0;
+};
+
+TEST(CostModelTests, CalibrationCacheTest) {
+  auto cache_file =
+      (std::filesystem::temp_directory_path() / "hdk_cost_model_calibration_test")
+          .string();
+  std::filesystem::remove(cache_file);
+
+  CountingDataSource::calls = 0;
+  for (int i = 0; i < 2; ++i) {
+    IterativeCostModel cm({std::make_unique<CountingDataSource>(), cache_file});
+    cm.calibrate({{ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}});
+    ASSERT_NO_THROW(cm.predict({{AnalyticalTemplate::Scan}, 1000}));
+  }
+  // The second calibration is loaded from the cache file.
+  ASSERT_EQ(CountingDataSource::calls, 1);
+
+  // Calibration for another set of devices doesn't match the stored one.
+  IterativeCostModel cm({std::make_unique<CountingDataSource>(), cache_file});
+  cm.calibrate({{ExecutorDeviceType::CPU}});
+  ASSERT_EQ(CountingDataSource::calls, 2);
+
+  std::filesystem::remove(cache_file);
+}
+
 TEST(ExtrapolationModelsTests, LinearExtrapolationTest1) {
   LinearExtrapolation le{{
       {10, 100},
@@ -21,6 +21,7 @@
 #include "DataMgr/DataMgrBufferProvider.h"
 #include "Logger/Logger.h"
 #include "QueryEngine/CompilationOptions.h"
+#include "QueryEngine/DataRecycler/ResultSetRecycler.h"
 #include "QueryEngine/Execute.h"
 #include "QueryEngine/JoinHashTable/BaselineJoinHashTable.h"
 #include "QueryEngine/JoinHashTable/PerfectJoinHashTable.h"
@@ -1222,6 +1223,124 @@ TEST(DataRecycler, DISABLED_Hashtable_For_Dict_Encoded_Column) {
   execute_random_query_test(queries_case2, 1);
 }
 
+TEST(DataRecycler, Hashtable_Cache_Inner_Table_Append) {
+  createTable("ht_gen_inner", {{"x", ctx().int32()}});
+  createTable("ht_gen_outer", {{"x", ctx().int32()}});
+  insertCsvValues("ht_gen_inner", "1\n2\n3");
+  insertCsvValues("ht_gen_outer", "1\n2\n3\n4");
+  ScopeGuard reset = [] {
+    Executor::clearMemory(MemoryLevel::CPU_LEVEL, getDataMgr());
+    dropTable("ht_gen_inner");
+    dropTable("ht_gen_outer");
+  };
+  Executor::clearMemory(MemoryLevel::CPU_LEVEL, getDataMgr());
+
+  auto query = "SELECT COUNT(*) FROM ht_gen_outer o, ht_gen_inner i WHERE o.x = i.x;";
+  auto dt = ExecutorDeviceType::CPU;
+  ASSERT_EQ(static_cast<int64_t>(3), v<int64_t>(run_simple_agg(query, dt)));
+  ASSERT_EQ(static_cast<size_t>(1), getNumberOfCachedPerfectHashTables());
+
+  // the hashtable built before the append must not be reused
+  insertCsvValues("ht_gen_inner", "4");
+  ASSERT_EQ(static_cast<int64_t>(4), v<int64_t>(run_simple_agg(query, dt)));
+  ASSERT_EQ(static_cast<size_t>(1), getNumberOfCachedPerfectHashTables());
+  ASSERT_EQ(static_cast<int64_t>(4), v<int64_t>(run_simple_agg(query, dt)));
+}
+
+TEST(DataRecycler, Result_Set_Cache) {
+  createTable("rs_cache", {{"x", ctx().int32()}, {"y", ctx().int32()}});
+  insertCsvValues("rs_cache", "1,1\n2,1\n3,2");
+  auto executor = getExecutor();
+  auto result_set_cache = executor->getResultSetRecycler();
+  ScopeGuard reset = [orig = config().cache.use_result_set_cache, result_set_cache] {
+    config().cache.use_result_set_cache = orig;
+    result_set_cache->clearCache();
+    dropTable("rs_cache");
+  };
+  config().cache.use_result_set_cache = true;
+  result_set_cache->clearCache();
+
+  auto query = "SELECT COUNT(*), SUM(x) FROM rs_cache WHERE y = 1;";
+  auto dt = ExecutorDeviceType::CPU;
+  auto rows1 = run_multiple_agg(query, dt);
+  auto num_cached_items = result_set_cache->getCurrentNumCachedItems(
+      CacheItemType::QUERY_RESULT_SET, RESULT_SET_CACHE_DEVICE_IDENTIFIER);
+  ASSERT_GT(num_cached_items, static_cast<size_t>(0));
+  ASSERT_EQ(static_cast<int64_t>(2), v<int64_t>(rows1->getNextRow(true, true)[0]));
+
+  // the same query reuses the cached result
+  auto rows2 = run_multiple_agg(query, dt);
+  ASSERT_EQ(rows1.get(), rows2.get());
+  ASSERT_EQ(num_cached_items,
+            result_set_cache->getCurrentNumCachedItems(
+                CacheItemType::QUERY_RESULT_SET, RESULT_SET_CACHE_DEVICE_IDENTIFIER));
+  auto row = rows2->getNextRow(true, true);
+  ASSERT_EQ(static_cast<int64_t>(2), v<int64_t>(row[0]));
+  ASSERT_EQ(static_cast<int64_t>(3), v<int64_t>(row[1]));
+
+  // appended rows make the cached result stale
+  insertCsvValues("rs_cache", "4,1");
+  auto rows3 = run_multiple_agg(query, dt);
+  ASSERT_NE(rows1.get(), rows3.get());
+  ASSERT_EQ(num_cached_items,
+            result_set_cache->getCurrentNumCachedItems(
+                CacheItemType::QUERY_RESULT_SET, RESULT_SET_CACHE_DEVICE_IDENTIFIER));
+  row = rows3->getNextRow(true, true);
+  ASSERT_EQ(static_cast<int64_t>(3), v<int64_t>(row[0]));
+  ASSERT_EQ(static_cast<int64_t>(7), v<int64_t>(row[1]));
+
+  // disabled cache is neither used nor populated
+  config().cache.use_result_set_cache = false;
+  auto rows4 = run_multiple_agg(query, dt);
+  ASSERT_NE(rows3.get(), rows4.get());
+}
+
+TEST(DataRecycler, Incremental_Result_Set_Cache) {
+  createTable("rs_inc",
+              {{"x", ctx().int32()}, {"y", ctx().int32()}},
+              ArrowStorage::TableOptions(2));
+  insertCsvValues("rs_inc", "1,1\n2,2\n3,1");
+  auto executor = getExecutor();
+  auto result_set_cache = executor->getResultSetRecycler();
+  ScopeGuard reset = [orig = config().cache, result_set_cache] {
+    config().cache = orig;
+    result_set_cache->clearCache();
+    dropTable("rs_inc");
+  };
+  config().cache.use_result_set_cache = true;
+  config().cache.use_incremental_result_set_cache = true;
+  result_set_cache->clearCache();
+
+  auto query = "SELECT y, COUNT(*), SUM(x) FROM rs_inc GROUP BY y;";
+  auto dt = ExecutorDeviceType::CPU;
+  auto run_query = [&]() {
+    std::map<int64_t, std::pair<int64_t, int64_t>> res;
+    auto rows = run_multiple_agg(query, dt);
+    while (true) {
+      auto row = rows->getNextRow(true, true);
+      if (row.empty()) {
+        break;
+      }
+      res[v<int64_t>(row[0])] = {v<int64_t>(row[1]), v<int64_t>(row[2])};
+    }
+    return res;
+  };
+  using Groups = std::map<int64_t, std::pair<int64_t, int64_t>>;
+  ASSERT_EQ(run_query(), (Groups{{1, {2, 4}}, {2, {1, 2}}}));
+
+  // appended rows fill up the last fragment, so the result is fully recomputed
+  insertCsvValues("rs_inc", "4,2");
+  ASSERT_EQ(run_query(), (Groups{{1, {2, 4}}, {2, {2, 6}}}));
+
+  // only appended fragments are aggregated
+  insertCsvValues("rs_inc", "5,1\n6,2\n7,1");
+  ASSERT_EQ(run_query(), (Groups{{1, {4, 16}}, {2, {3, 12}}}));
+  ASSERT_EQ(run_query(), (Groups{{1, {4, 16}}, {2, {3, 12}}}));
+
+  insertCsvValues("rs_inc", "8,2");
+  ASSERT_EQ(run_query(), (Groups{{1, {4, 16}}, {2, {4, 20}}}));
+}
+
 int main(int argc, char* argv[]) {
   testing::InitGoogleTest(&argc, argv);
   TestHelpers::init_logger_stderr_only(argc, argv);
@@ -545,6 +545,24 @@ TEST(SingleColumn, VariableEntries_CountQuery_8B_Group) {
   }
 }
 
+TEST(SingleColumn, MoreEntriesThanThreads_CountQuery_4B_Group) {
+  // Reduction threads loop over entries when there are more entries than threads.
+  for (auto num_entries : {1025, 2048, 3001}) {
+    TestInputData input;
+    input.setDeviceId(0)
+        .setNumInputBuffers(4)
+        .setTargetInfos(generate_custom_agg_target_infos(
+            {4}, {hdk::ir::AggType::kCount}, {int32_type}, {int32_type}))
+        .setAggWidth(4)
+        .setMinEntry(0)
+        .setMaxEntry(num_entries)
+        .setStepSize(2)
+        .setKeylessHash(true)
+        .setTargetIndexForKey(0);
+    perform_test_and_verify_results(input);
+  }
+}
+
 TEST(SingleColumn, VariableSteps_FixedEntries_1) {
   TestInputData input;
   input.setDeviceId(0)
@@ -137,6 +137,83 @@ TEST_F(SPIRVExecuteTest, TranslateSimpleWithL0Manager) {
   mgr->freeDeviceMem((int8_t*)dB);
 }
 
+TEST_F(SPIRVExecuteTest, ExecuteOnAllSubDevices) {
+  auto root_mgr = std::make_shared<l0::L0Manager>();
+  auto mgr = std::make_shared<l0::L0Manager>(false, true);
+  ASSERT_GE(mgr->getDeviceCount(), root_mgr->getDeviceCount());
+
+  auto spv = generateSimpleSPIRV();
+  for (int device_num = 0; device_num < mgr->getDeviceCount(); ++device_num) {
+    auto device = mgr->drivers()[0]->devices()[device_num];
+    auto module = device->create_module((uint8_t*)spv.data(), spv.length());
+    auto kernel = module->create_kernel("plus1", 1, 1, 1);
+
+    constexpr int a_size = 32;
+    AlignedArray<float, a_size> a, b;
+    for (auto i = 0; i < a_size; ++i) {
+      a.data[i] = a_size - i;
+      b.data[i] = i;
+    }
+
+    const float copy_size = a_size * sizeof(float);
+    void* dA = mgr->allocateDeviceMem(copy_size, device_num);
+    void* dB = mgr->allocateDeviceMem(copy_size, device_num);
+    mgr->copyHostToDevice((int8_t*)dA, (const int8_t*)a.data, copy_size, device_num);
+    mgr->copyHostToDevice((int8_t*)dB, (const int8_t*)b.data, copy_size, device_num);
+
+    auto command_list = device->create_command_list();
+    command_list->launch(*kernel, {1, 1, 1}, &dA, &dB);
+    command_list->submit(*device->command_queue());
+
+    mgr->copyDeviceToHost((int8_t*)b.data, (const int8_t*)dB, copy_size, device_num);
+    ASSERT_EQ(b.data[0], 33) << "device " << device_num;
+    ASSERT_EQ(b.data[1], 1) << "device " << device_num;
+
+    mgr->freeDeviceMem((int8_t*)dA);
+    mgr->freeDeviceMem((int8_t*)dB);
+  }
+}
+
+TEST_F(SPIRVExecuteTest, NativeBinaryRoundTrip) {
+  auto mgr = std::make_shared<l0::L0Manager>();
+  auto driver = mgr->drivers()[0];
+  auto device = driver->devices()[0];
+
+  auto spv = generateSimpleSPIRV();
+  auto spv_module = device->create_module((uint8_t*)spv.data(), spv.length());
+  auto binary = spv_module->native_binary();
+  ASSERT_FALSE(binary.empty());
+  auto module = device->create_native_module(binary.data(), binary.size());
+
+  auto command_queue = device->command_queue();
+  auto command_list = device->create_command_list();
+
+  constexpr int a_size = 32;
+  AlignedArray<float, a_size> a, b;
+  for (auto i = 0; i < a_size; ++i) {
+    a.data[i] = a_size - i;
+    b.data[i] = i;
+  }
+
+  const float copy_size = a_size * sizeof(float);
+  void* dA = l0::allocate_device_mem(copy_size, *device);
+  void* dB = l0::allocate_device_mem(copy_size, *device);
+
+  command_list->copy(dA, a.data, copy_size);
+  command_list->copy(dB, b.data, copy_size);
+
+  auto kernel = module->create_kernel("plus1", 1, 1, 1);
+  command_list->launch(*kernel, {1, 1, 1}, &dA, &dB);
+  command_list->copy(b.data, dB, copy_size);
+  command_list->submit(*command_queue);
+
+  ASSERT_EQ(b.data[0], 33);
+  ASSERT_EQ(b.data[1], 1);
+
+  mgr->freeDeviceMem((int8_t*)dA);
+  mgr->freeDeviceMem((int8_t*)dB);
+}
+
 namespace {
 std::unique_ptr<llvm::Module> read_gen_module_from_bc(const std::string& bc_filename,
                                                       llvm::LLVMContext& context) {
@@ -126,7 +126,8 @@ class NoCatalogSqlTest : public ::testing::Test {
   }
 
   static void init_calcite(const std::string& udf_filename) {
-    calcite_ = CalciteMgr::get(udf_filename);
+    // Use several workers to cover concurrent parsing in multi-threaded tests.
+    calcite_ = CalciteMgr::get(udf_filename, 1024, 4);
   }
 
   static void TearDownTestSuite() {
@@ -412,6 +412,39 @@ TEST(Quantile, SmallDataSetsAndMemory) {
   }
 }
 
+namespace {
+
+class CountingAllocator : public SimpleAllocator {
+ public:
+  int8_t* allocate(const size_t num_bytes, const size_t thread_idx = 0) override {
+    ++allocations;
+    return buffers.emplace_back(std::make_unique<int8_t[]>(num_bytes)).get();
+  }
+
+  size_t allocations{0};
+  std::vector<std::unique_ptr<int8_t[]>> buffers;
+};
+
+}  // namespace
+
+TEST(Quantile, AllocatedDigests) {
+  CountingAllocator allocator;
+  TDigest t_digest0(0.5, &allocator, 6, 4);
+  TDigest t_digest1(0.5, &allocator, 6, 4);
+  t_digest0.allocate();
+  t_digest1.allocate();
+  t_digest0.allocate();
+  EXPECT_EQ(size_t(2), allocator.allocations);
+
+  for (int i = 1; i <= 9; ++i) {
+    (i % 2 ? t_digest0 : t_digest1).add(10 * i);
+  }
+  t_digest0.mergeTDigest(t_digest1);
+  EXPECT_EQ(size_t(9), t_digest0.totalWeight());
+  EXPECT_EQ(10, t_digest0.quantile(0.0));
+  EXPECT_EQ(90, t_digest0.quantile(1.0));
+}
+
 int main(int argc, char** argv) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   testing::InitGoogleTest(&argc, argv);
@@ -4905,6 +4905,52 @@ TEST_F(QueryBuilderTest, SqlOnResult) {
                    std::vector<int32_t>({10, 21, 32, 43, 54}));
 }
 
+TEST_F(QueryBuilderTest, ParseSql) {
+  QueryBuilder builder(ctx(), schema_mgr_, configPtr());
+
+  for (auto sql : {
+           "SELECT id1, val2, val1 + 1 AS v FROM test2 WHERE val2 > 22.5 ORDER BY val2;",
+           "SELECT id1, COUNT(*), SUM(val1) AS s, AVG(val2) FROM test2 GROUP BY id1 "
+           "ORDER BY id1;",
+           "SELECT id1, id2, MAX(val1 * 2) AS m FROM test2 WHERE val1 IS NOT NULL "
+           "GROUP BY id1, id2 HAVING COUNT(*) > 1 ORDER BY 1, 2 DESC;",
+           "SELECT COUNT(DISTINCT id2), MIN(val2) FROM test2;",
+           "SELECT * FROM test2 ORDER BY val2 DESC LIMIT 3 OFFSET 1;",
+           "select t.id1 + t.id2 as k, count(val1) from test2 t group by t.id1 + t.id2 "
+           "order by k",
+           "SELECT val1 FROM test2 WHERE NOT (val1 < 12 OR val1 = 14) "
+           "ORDER BY val1 NULLS FIRST;",
+       }) {
+    auto node = builder.parseSql(sql);
+    ASSERT_TRUE(node.node()) << sql;
+    auto expected_res = runSqlQuery(sql, ExecutorDeviceType::CPU, false);
+    auto actual_res = runQuery(node.finalize());
+    compareArrowTables(toArrow(expected_res), toArrow(actual_res));
+  }
+
+  auto res = runQuery(builder.parseSql("SELECT val1 + 1 AS v FROM test2;").finalize());
+  ASSERT_EQ(res.getTargetsMeta()[0].get_resname(), "v");
+
+  for (auto sql : {
+           "SELECT id1 FROM test2 WHERE id1 IN (1, 2);",
+           "SELECT a.id1 FROM test2 a JOIN test1 b ON a.id1 = b.col_i;",
+           "SELECT CAST(id1 AS DOUBLE) FROM test2;",
+           "SELECT id1, val1 FROM test2 GROUP BY id1;",
+           "SELECT id1 FROM test2 ORDER BY val1;",
+           "SELECT id1 FROM test2 WHERE id1 = ?;",
+           "SELECT id1 FROM unknown_table;",
+           "SELECT id1 FROM test2 LIMIT 0;",
+           "SELECT id1 FROM test2 ORDER BY id1 LIMIT 0 OFFSET 1;",
+       }) {
+    ASSERT_FALSE(builder.parseSql(sql).node()) << sql;
+  }
+
+  // LIMIT 0 falls back to Calcite and returns no rows.
+  auto empty_res =
+      runSqlQuery("SELECT id1 FROM test2 LIMIT 0;", ExecutorDeviceType::CPU, false);
+  ASSERT_EQ(empty_res.getRows()->rowCount(), size_t(0));
+}
+
 TEST_F(QueryBuilderTest, NoneEncodedStringInRes) {
   for (bool enable_columnar : {true, false}) {
     auto orig_enable_columnar = config().rs.enable_columnar_output;
@@ -5148,6 +5194,43 @@ TEST_F(QueryBuilderTest, Tail) {
   }
 }
 
+TEST_F(QueryBuilderTest, SpilledResults) {
+  auto orig_enable_columnar = config().rs.enable_columnar_output;
+  auto orig_memory_limit = config().rs.registry_memory_limit;
+  ScopeGuard guard([orig_enable_columnar, orig_memory_limit]() {
+    config().rs.enable_columnar_output = orig_enable_columnar;
+    config().rs.registry_memory_limit = orig_memory_limit;
+  });
+  config().rs.enable_columnar_output = true;
+  // Any result is above the limit, so it is spilled right after it is put and
+  // after each reload.
+  config().rs.registry_memory_limit = 1;
+
+  QueryBuilder builder(ctx(), schema_mgr_, configPtr());
+
+  auto dag1 = builder.scan("test1").proj({0, 1}).finalize();
+  auto res1 = runQuery(std::move(dag1));
+  compare_res_data(res1,
+                   std::vector<int64_t>({1, 2, 3, 4, 5}),
+                   std::vector<int32_t>({11, 22, 33, 44, 55}));
+
+  auto dag2 = builder.scan(res1.tableName()).proj({1, 0}).finalize();
+  auto res2 = runQuery(std::move(dag2));
+  compare_res_data(res2,
+                   std::vector<int32_t>({11, 22, 33, 44, 55}),
+                   std::vector<int64_t>({1, 2, 3, 4, 5}));
+
+  auto scan = builder.scan(res1.tableName());
+  auto dag3 = scan.filter(scan.ref(0) > 2).finalize();
+  auto res3 = runQuery(std::move(dag3));
+  compare_res_data(
+      res3, std::vector<int64_t>({3, 4, 5}), std::vector<int32_t>({33, 44, 55}));
+
+  auto res4 = res1.head(3);
+  compare_res_data(
+      res4, std::vector<int64_t>({1, 2, 3}), std::vector<int32_t>({11, 22, 33}));
+}
+
 class Taxi : public TestSuite {
  protected:
   static void SetUpTestSuite() {
@@ -38,6 +38,8 @@
 #include <arrow/api.h>
 #include <arrow/csv/reader.h>
 #include <arrow/io/file.h>
+#include <arrow/ipc/api.h>
+#include <parquet/arrow/reader.h>
 
 // Google Test
 #include <gtest/gtest.h>
@@ -394,6 +396,93 @@ TEST(ArrowRecordBatch, TextIntSelect) {
   ASSERT_EQ(rbatch->num_rows(), (int64_t)6);
 }
 
+//  Tests getArrowRecordBatch() for lazily fetched columns of a filtered projection
+TEST(ArrowRecordBatch, LazyFetchedColumnsSelect) {
+  bool prev_enable_columnar_output = config().rs.enable_columnar_output;
+  bool prev_enable_lazy_fetch = config().rs.enable_lazy_fetch;
+
+  ScopeGuard reset = [prev_enable_columnar_output, prev_enable_lazy_fetch] {
+    config().rs.enable_columnar_output = prev_enable_columnar_output;
+    config().rs.enable_lazy_fetch = prev_enable_lazy_fetch;
+  };
+
+  config().rs.enable_columnar_output = true;
+  config().rs.enable_lazy_fetch = true;
+  auto res = runSqlQuery("SELECT bi, d FROM test_chunked WHERE i = 1;",
+                         ExecutorDeviceType::CPU,
+                         true);
+  auto rbatch = getArrowRecordBatch(res);
+  ASSERT_NE(rbatch, nullptr);
+  ASSERT_EQ(rbatch->num_columns(), 2);
+  ASSERT_EQ(rbatch->num_rows(), (int64_t)3);
+
+  // Selected rows span two fragments.
+  auto bi = std::static_pointer_cast<arrow::Int64Array>(rbatch->column(0));
+  auto d = std::static_pointer_cast<arrow::DoubleArray>(rbatch->column(1));
+  for (int64_t i = 0; i < 3; ++i) {
+    ASSERT_EQ(bi->Value(i), table6x4_col_bi[i + 3]);
+    ASSERT_EQ(d->Value(i), table6x4_col_d[i + 3]);
+  }
+}
+
+TEST(ArrowRecordBatch, LazyFetchedColumnsSelectRowWise) {
+  bool prev_enable_columnar_output = config().rs.enable_columnar_output;
+  bool prev_enable_lazy_fetch = config().rs.enable_lazy_fetch;
+
+  ScopeGuard reset = [prev_enable_columnar_output, prev_enable_lazy_fetch] {
+    config().rs.enable_columnar_output = prev_enable_columnar_output;
+    config().rs.enable_lazy_fetch = prev_enable_lazy_fetch;
+  };
+
+  config().rs.enable_columnar_output = false;
+  config().rs.enable_lazy_fetch = true;
+  auto res = runSqlQuery("SELECT bi, d FROM test_chunked WHERE i = 1;",
+                         ExecutorDeviceType::CPU,
+                         true);
+  auto rbatch = getArrowRecordBatch(res);
+  ASSERT_NE(rbatch, nullptr);
+  ASSERT_EQ(rbatch->num_columns(), 2);
+  ASSERT_EQ(rbatch->num_rows(), (int64_t)3);
+
+  auto bi = std::static_pointer_cast<arrow::Int64Array>(rbatch->column(0));
+  auto d = std::static_pointer_cast<arrow::DoubleArray>(rbatch->column(1));
+  for (int64_t i = 0; i < 3; ++i) {
+    ASSERT_EQ(bi->Value(i), table6x4_col_bi[i + 3]);
+    ASSERT_EQ(d->Value(i), table6x4_col_d[i + 3]);
+  }
+}
+
+//  Tests getArrowRecordBatch() for a GROUP BY query mixing targets decoded directly
+//  (keys, COUNT, SUM, MAX) and through row iteration (AVG)
+TEST(ArrowRecordBatch, GroupBySelect) {
+  bool prev_enable_columnar_output = config().rs.enable_columnar_output;
+  ScopeGuard reset = [prev_enable_columnar_output] {
+    config().rs.enable_columnar_output = prev_enable_columnar_output;
+  };
+
+  for (bool enable_columnar_output : {false, true}) {
+    config().rs.enable_columnar_output = enable_columnar_output;
+    auto res = runSqlQuery(
+        "SELECT i, COUNT(*), SUM(bi), MAX(d), AVG(bi) FROM test_chunked GROUP BY i;",
+        ExecutorDeviceType::CPU,
+        true);
+    auto rbatch = getArrowRecordBatch(res);
+    ASSERT_NE(rbatch, nullptr);
+    ASSERT_EQ(rbatch->num_columns(), 5);
+    ASSERT_EQ(rbatch->num_rows(), (int64_t)2);
+
+    auto sum = std::static_pointer_cast<arrow::Int64Array>(rbatch->column(2));
+    auto max = std::static_pointer_cast<arrow::DoubleArray>(rbatch->column(3));
+    auto avg = std::static_pointer_cast<arrow::DoubleArray>(rbatch->column(4));
+    ASSERT_EQ(sum->Value(0), 6);
+    ASSERT_EQ(sum->Value(1), 15);
+    ASSERT_EQ(max->Value(0), 30.3);
+    ASSERT_EQ(max->Value(1), 60.6);
+    ASSERT_EQ(avg->Value(0), 2.0);
+    ASSERT_EQ(avg->Value(1), 5.0);
+  }
+}
+
 //  Tests getArrowTable() for three columns (TEXT "t", INT "i", BIGINT "bi") selection
 TEST(ArrowTable, TextIntBigintSelect) {
   auto res = runSqlQuery("select t, i, bi from test;", ExecutorDeviceType::CPU, true);
@@ -869,6 +958,25 @@ TEST(ArrowTable, LargeTablesRowWise) {
   test_single_column_table<double>(N, 150);
 }
 
+TEST(ArrowTable, LargeTablesRowWiseLazyFetch) {
+  bool prev_enable_columnar_output = config().rs.enable_columnar_output;
+  bool prev_enable_lazy_fetch = config().rs.enable_lazy_fetch;
+
+  ScopeGuard reset = [prev_enable_columnar_output, prev_enable_lazy_fetch] {
+    config().rs.enable_columnar_output = prev_enable_columnar_output;
+    config().rs.enable_lazy_fetch = prev_enable_lazy_fetch;
+  };
+
+  config().rs.enable_columnar_output = false;
+  config().rs.enable_lazy_fetch = true;
+  const size_t N = 500'000;
+  test_single_column_table<int8_t>(N, 150);
+  test_single_column_table<int32_t>(N, 150);
+  test_single_column_table<int64_t>(N, 150);
+  test_single_column_table<float>(N, 150);
+  test_single_column_table<double>(N, 150);
+}
+
 TEST(ArrowTable, NoneEncodedStrings) {
   bool prev_enable_columnar_output = config().rs.enable_columnar_output;
 
@@ -945,6 +1053,58 @@ TEST(ArrowTable, FixedLenArrays) {
   }
 }
 
+TEST(ArrowTable, ExportToParquet) {
+  auto res = runSqlQuery("select i, bi, d from test;", ExecutorDeviceType::CPU, true);
+  std::vector<std::string> col_names;
+  for (auto& target : res.getTargetsMeta()) {
+    col_names.push_back(target.get_resname());
+  }
+  ArrowResultSetConverter converter(res.getRows(), col_names, -1);
+  auto file_name =
+      (std::filesystem::temp_directory_path() / "hdk_export_test.parquet").string();
+  ScopeGuard remove_file = [&file_name] { std::filesystem::remove(file_name); };
+  converter.exportToParquet(file_name, 4);
+
+  std::shared_ptr<arrow::io::ReadableFile> file;
+  ARROW_ASSIGN_OR_THROW(file, arrow::io::ReadableFile::Open(file_name));
+  std::unique_ptr<parquet::arrow::FileReader> reader;
+  ARROW_THROW_NOT_OK(
+      parquet::arrow::OpenFile(file, arrow::default_memory_pool(), &reader));
+  // A row group per batch.
+  ASSERT_EQ(reader->num_row_groups(), 2);
+  std::shared_ptr<arrow::Table> table;
+  ARROW_THROW_NOT_OK(reader->ReadTable(&table));
+  compareArrowTables(getArrowTable(res), table);
+}
+
+TEST(ArrowTable, ExportToArrowIpc) {
+  auto res = runSqlQuery("select i, bi, d from test;", ExecutorDeviceType::CPU, true);
+  std::vector<std::string> col_names;
+  for (auto& target : res.getTargetsMeta()) {
+    col_names.push_back(target.get_resname());
+  }
+  ArrowResultSetConverter converter(res.getRows(), col_names, -1);
+  auto file_name =
+      (std::filesystem::temp_directory_path() / "hdk_export_test.arrow").string();
+  ScopeGuard remove_file = [&file_name] { std::filesystem::remove(file_name); };
+  converter.exportToArrowIpc(file_name, 4);
+
+  std::shared_ptr<arrow::io::ReadableFile> file;
+  ARROW_ASSIGN_OR_THROW(file, arrow::io::ReadableFile::Open(file_name));
+  std::shared_ptr<arrow::ipc::RecordBatchFileReader> reader;
+  ARROW_ASSIGN_OR_THROW(reader, arrow::ipc::RecordBatchFileReader::Open(file));
+  ASSERT_EQ(reader->num_record_batches(), 2);
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+  for (int i = 0; i < reader->num_record_batches(); ++i) {
+    std::shared_ptr<arrow::RecordBatch> batch;
+    ARROW_ASSIGN_OR_THROW(batch, reader->ReadRecordBatch(i));
+    batches.emplace_back(std::move(batch));
+  }
+  std::shared_ptr<arrow::Table> table;
+  ARROW_ASSIGN_OR_THROW(table, arrow::Table::FromRecordBatches(batches));
+  compareArrowTables(getArrowTable(res), table);
+}
+
 int main(int argc, char* argv[]) {
   testing::InitGoogleTest(&argc, argv);
 
@@ -33,6 +33,7 @@
 #include "QueryEngine/RuntimeFunctions.h"
 #include "ResultSet/ResultSet.h"
 #include "ResultSet/RowSetMemoryOwner.h"
+#include "Shared/measure.h"
 #include "StringDictionary/StringDictionary.h"
 
 #include <gtest/gtest.h>
@@ -960,6 +961,22 @@ std::vector<TargetInfo> generate_test_target_infos() {
   return target_infos;
 }
 
+std::vector<TargetInfo> generate_simple_agg_target_infos() {
+  std::vector<TargetInfo> target_infos;
+  auto& ctx = hdk::ir::Context::defaultCtx();
+  auto int_type = ctx.int64();
+  auto double_type = ctx.fp64();
+  target_infos.push_back(
+      TargetInfo{true, hdk::ir::AggType::kCount, int_type, nullptr, false, false});
+  target_infos.push_back(
+      TargetInfo{true, hdk::ir::AggType::kSum, int_type, int_type, true, false});
+  target_infos.push_back(
+      TargetInfo{true, hdk::ir::AggType::kMin, double_type, double_type, true, false});
+  target_infos.push_back(
+      TargetInfo{true, hdk::ir::AggType::kMax, int_type, int_type, false, false});
+  return target_infos;
+}
+
 std::vector<TargetInfo> generate_random_groups_target_infos() {
   std::vector<TargetInfo> target_infos;
   auto& ctx = hdk::ir::Context::defaultCtx();
@@ -1012,11 +1029,12 @@ std::vector<OneRow> get_rows_sorted_by_col(ResultSet& rs, const size_t col_idx)
   return result;
 }
 
-void run_reduction(const std::vector<TargetInfo>& target_infos,
-                   const QueryMemoryDescriptor& query_mem_desc,
-                   NumberGenerator& generator1,
-                   NumberGenerator& generator2,
-                   const int step) {
+// Returns the reduction time in milliseconds.
+int64_t run_reduction(const std::vector<TargetInfo>& target_infos,
+                      const QueryMemoryDescriptor& query_mem_desc,
+                      NumberGenerator& generator1,
+                      NumberGenerator& generator2,
+                      const int step) {
   const ResultSetStorage* storage1{nullptr};
   const ResultSetStorage* storage2{nullptr};
   // for codegen only
@@ -1046,7 +1064,9 @@ void run_reduction(const std::vector<TargetInfo>& target_infos,
       storage2->getUnderlyingBuffer(), target_infos, query_mem_desc, generator2, step);
   ResultSetManager rs_manager;
   std::vector<ResultSet*> storage_set{rs1.get(), rs2.get()};
+  auto clock_begin = timer_start();
   rs_manager.reduce(storage_set, config(), executor.get());
+  return timer_stop(clock_begin);
 }
 
 void test_reduce(const std::vector<TargetInfo>& target_infos,
@@ -1148,6 +1168,66 @@ void test_reduce(const std::vector<TargetInfo>& target_infos,
   }
 }
 
+// Reduction of partial results received from another executor as serialized
+// storage matches the reduction of the original result sets.
+void test_reduce_serialized(const std::vector<TargetInfo>& target_infos,
+                            const QueryMemoryDescriptor& query_mem_desc,
+                            const int step) {
+  auto executor = Executor::getExecutor(getDataMgr());
+  const auto row_set_mem_owner = std::make_shared<RowSetMemoryOwner>(
+      g_data_provider.get(), Executor::getArenaBlockSize());
+  auto make_rs = [&](bool odd) {
+    auto rs = std::make_shared<ResultSet>(target_infos,
+                                          ExecutorDeviceType::CPU,
+                                          query_mem_desc,
+                                          row_set_mem_owner,
+                                          nullptr,
+                                          0,
+                                          0);
+    auto storage = rs->allocateStorage();
+    EvenNumberGenerator even_generator;
+    ReverseOddOrEvenNumberGenerator odd_generator(2 * query_mem_desc.getEntryCount() -
+                                                  1);
+    fill_storage_buffer(storage->getUnderlyingBuffer(),
+                        target_infos,
+                        query_mem_desc,
+                        odd ? static_cast<NumberGenerator&>(odd_generator)
+                            : static_cast<NumberGenerator&>(even_generator),
+                        step);
+    return rs;
+  };
+
+  auto local_rs1 = make_rs(false);
+  auto local_rs2 = make_rs(true);
+  ResultSetManager local_manager;
+  std::vector<ResultSet*> local_set{local_rs1.get(), local_rs2.get()};
+  auto expected_rs = local_manager.reduce(local_set, config(), executor.get());
+
+  auto remote_rs1 = make_rs(false);
+  auto remote_rs2 = make_rs(true);
+  ASSERT_TRUE(remote_rs2->canSerializeStorage());
+  auto received_rs = remote_rs1->deserializeStorage(remote_rs2->serializeStorage());
+  ResultSetManager remote_manager;
+  std::vector<ResultSet*> remote_set{remote_rs1.get(), received_rs.get()};
+  auto actual_rs = remote_manager.reduce(remote_set, config(), executor.get());
+
+  ASSERT_EQ(expected_rs->rowCount(), actual_rs->rowCount());
+  for (size_t row_idx = 0; row_idx < expected_rs->rowCount(); ++row_idx) {
+    const auto expected_row = expected_rs->getRowAtNoTranslations(row_idx);
+    const auto actual_row = actual_rs->getRowAtNoTranslations(row_idx);
+    ASSERT_EQ(expected_row.size(), actual_row.size());
+    for (size_t i = 0; i < expected_row.size(); ++i) {
+      const auto& target_info = target_infos[i];
+      if (target_info.agg_kind == hdk::ir::AggType::kAvg ||
+          target_info.type->isFloatingPoint()) {
+        ASSERT_DOUBLE_EQ(v<double>(expected_row[i]), v<double>(actual_row[i]));
+      } else {
+        ASSERT_EQ(v<int64_t>(expected_row[i]), v<int64_t>(actual_row[i]));
+      }
+    }
+  }
+}
+
 void test_reduce_random_groups(const std::vector<TargetInfo>& target_infos,
                                const QueryMemoryDescriptor& query_mem_desc,
                                NumberGenerator& generator1,
@@ -1892,6 +1972,61 @@ TEST(Reduce, BaselineHash) {
   test_reduce(target_infos, query_mem_desc, generator1, generator2, 1, true);
 }
 
+TEST(Reduce, PerfectHashOneColSerializedStorage) {
+  const auto target_infos = generate_simple_agg_target_infos();
+  const auto query_mem_desc = perfect_hash_one_col_desc(target_infos, 8, 0, 99);
+  test_reduce_serialized(target_infos, query_mem_desc, 1);
+}
+
+TEST(Reduce, PerfectHashOneColColumnarSerializedStorage) {
+  const auto target_infos = generate_simple_agg_target_infos();
+  auto query_mem_desc = perfect_hash_one_col_desc(target_infos, 8, 0, 99);
+  query_mem_desc.setOutputColumnar(true);
+  test_reduce_serialized(target_infos, query_mem_desc, 1);
+}
+
+TEST(Reduce, BaselineHashSerializedStorage) {
+  const auto target_infos = generate_simple_agg_target_infos();
+  const auto query_mem_desc = baseline_hash_two_col_desc(target_infos, 8);
+  test_reduce_serialized(target_infos, query_mem_desc, 1);
+}
+
+TEST(Reduce, SerializedStorageMismatch) {
+  const auto target_infos = generate_simple_agg_target_infos();
+  const auto query_mem_desc = perfect_hash_one_col_desc(target_infos, 8, 0, 99);
+  const auto other_mem_desc = perfect_hash_one_col_desc(target_infos, 8, 0, 49);
+  const auto row_set_mem_owner = std::make_shared<RowSetMemoryOwner>(
+      g_data_provider.get(), Executor::getArenaBlockSize());
+  ResultSet rs(target_infos,
+               ExecutorDeviceType::CPU,
+               query_mem_desc,
+               row_set_mem_owner,
+               nullptr,
+               0,
+               0);
+  rs.allocateStorage();
+  ResultSet other_rs(target_infos,
+                     ExecutorDeviceType::CPU,
+                     other_mem_desc,
+                     row_set_mem_owner,
+                     nullptr,
+                     0,
+                     0);
+  const auto serialized = rs.serializeStorage();
+  EXPECT_THROW(other_rs.deserializeStorage(serialized), std::runtime_error);
+  EXPECT_THROW(rs.deserializeStorage(serialized.substr(0, serialized.size() / 2)),
+               std::runtime_error);
+}
+
+TEST(Reduce, PerfectHashOneColColumnarSimpleAggregates) {
+  const auto target_infos = generate_simple_agg_target_infos();
+  auto query_mem_desc = perfect_hash_one_col_desc(target_infos, 8, 0, 9999);
+  query_mem_desc.setOutputColumnar(true);
+  EvenNumberGenerator generator1;
+  EvenNumberGenerator generator2;
+  test_reduce(target_infos, query_mem_desc, generator1, generator2, 2, false);
+}
+
 TEST(Reduce, BaselineHashColumnar) {
   const auto target_infos = generate_test_target_infos();
   auto query_mem_desc = baseline_hash_two_col_desc(target_infos, 8);
@@ -1940,6 +2075,30 @@ TEST(ReduceLargeBuffers, PerfectHashColumnarOne_Overflow32) {
   }
 }
 
+TEST(ReduceLargeBuffers, PerfectHashColumnarSimpleAggregatesBenchmark) {
+  SKIP_LARGE_BUFFERS();
+
+  try {
+    const auto target_infos = generate_simple_agg_target_infos();
+    for (bool columnar : {false, true}) {
+      auto query_mem_desc =
+          perfect_hash_one_col_desc(target_infos, 8, 0, 50'000'000, {8});
+      query_mem_desc.setOutputColumnar(columnar);
+      EvenNumberGenerator gen1;
+      EvenNumberGenerator gen2;
+      const auto reduction_ms =
+          run_reduction(target_infos, query_mem_desc, gen1, gen2, 2);
+      LOG(INFO) << "Reduced " << query_mem_desc.getEntryCount() << " entries of "
+                << (columnar ? "columnar" : "row-wise") << " buffers in "
+                << reduction_ms << "ms";
+    }
+  } catch (const std::bad_alloc&) {
+    LOG(WARNING) << "Out-of-memory for "
+                    "ReduceLargeBuffers.PerfectHashColumnarSimpleAggregatesBenchmark";
+    GTEST_SKIP();
+  }
+}
+
 TEST(ReduceLargeBuffers, BaselineHash_Overflow32) {
   SKIP_LARGE_BUFFERS();
 
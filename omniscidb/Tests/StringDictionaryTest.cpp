@@ -18,6 +18,9 @@
 
 #include "StringDictionary/StringDictionaryProxy.h"
 
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <functional>
@@ -25,6 +28,7 @@
 #include <limits>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <unordered_set>
 
 using namespace std::string_literals;
@@ -205,6 +209,116 @@ TEST(StringDictionary, GetOrAddBulk) {
   }
 }
 
+TEST(StringDictionary, GetOrAddBulkConcurrent) {
+  const DictRef dict_ref(-1, 1);
+  StringDictionary string_dict(dict_ref, g_cache_string_hash);
+  constexpr int num_threads = 8;
+  constexpr int num_unique = 100;
+  std::vector<std::string> strings;
+  for (int i = 0; i < 10'000; ++i) {
+    strings.emplace_back("str"s + std::to_string(i % num_unique));
+  }
+  std::vector<std::vector<int32_t>> string_ids(num_threads,
+                                               std::vector<int32_t>(strings.size()));
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back(
+        [&, t]() { string_dict.getOrAddBulk(strings, string_ids[t].data()); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(string_dict.storageEntryCount(), static_cast<size_t>(num_unique));
+  for (int t = 0; t < num_threads; ++t) {
+    for (size_t i = 0; i < strings.size(); ++i) {
+      ASSERT_EQ(string_dict.getString(string_ids[t][i]), strings[i]);
+    }
+  }
+}
+
+TEST(StringDictionary, GetSortedRanks) {
+  const DictRef dict_ref(-1, 1);
+  StringDictionary string_dict(dict_ref, g_cache_string_hash);
+  for (auto& str : {"c"s, "a"s, "d"s}) {
+    string_dict.getOrAdd(str);
+  }
+  const auto ranks = string_dict.getSortedRanks();
+  ASSERT_EQ(*ranks, std::vector<int32_t>({1, 0, 2}));
+  // Ranks are built once per dictionary generation.
+  ASSERT_EQ(string_dict.getSortedRanks(), ranks);
+  ASSERT_EQ(string_dict.getSortedRanks(false), ranks);
+  // New strings are merged into the existing order.
+  string_dict.getOrAdd("b");
+  ASSERT_EQ(string_dict.getSortedRanks(false), nullptr);
+  ASSERT_EQ(*string_dict.getSortedRanks(), std::vector<int32_t>({2, 0, 3, 1}));
+}
+
+TEST(StringDictionary, SaveAndLoad) {
+  const DictRef dict_ref(-1, 1);
+  StringDictionary string_dict(dict_ref, g_cache_string_hash);
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_EQ(string_dict.getOrAdd(std::to_string(i)), i);
+  }
+  auto file_name = (boost::filesystem::temp_directory_path() /
+                    boost::filesystem::unique_path("%%%%-%%%%-%%%%.dict"))
+                       .string();
+  string_dict.saveToFile(file_name);
+
+  auto loaded_dict = StringDictionary::loadFromFile(dict_ref, file_name);
+  auto other_dict = StringDictionary::loadFromFile(dict_ref, file_name);
+  boost::filesystem::remove(file_name);
+  ASSERT_EQ(loaded_dict->storageEntryCount(), 1000UL);
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_EQ(loaded_dict->getIdOfString(std::to_string(i)), i);
+    ASSERT_EQ(loaded_dict->getString(i), std::to_string(i));
+  }
+  // Adding strings switches to a private copy and doesn't affect other users of
+  // the file.
+  ASSERT_EQ(loaded_dict->getOrAdd("new"), 1000);
+  ASSERT_EQ(loaded_dict->getString(999), "999");
+  ASSERT_EQ(other_dict->storageEntryCount(), 1000UL);
+  ASSERT_EQ(other_dict->getIdOfString("new"s), StringDictionary::INVALID_STR_ID);
+}
+
+TEST(StringDictionary, SaveAndLoadFrontCoded) {
+  const DictRef dict_ref(-1, 1);
+  StringDictionary string_dict(dict_ref, g_cache_string_hash);
+  std::vector<std::string> strings{""};
+  for (int i = 0; i < 1000; ++i) {
+    strings.push_back("https://www.example.com/path/to/page/" + std::to_string(i));
+  }
+  for (size_t i = 0; i < strings.size(); ++i) {
+    ASSERT_EQ(string_dict.getOrAdd(strings[i]), static_cast<int32_t>(i));
+  }
+  auto get_file_name = []() {
+    return (boost::filesystem::temp_directory_path() /
+            boost::filesystem::unique_path("%%%%-%%%%-%%%%.dict"))
+        .string();
+  };
+  auto plain_file_name = get_file_name();
+  auto file_name = get_file_name();
+  string_dict.saveToFile(plain_file_name);
+  string_dict.saveToFile(file_name, true);
+  ASSERT_LT(boost::filesystem::file_size(file_name) * 3,
+            boost::filesystem::file_size(plain_file_name));
+  boost::filesystem::remove(plain_file_name);
+
+  auto loaded_dict = StringDictionary::loadFromFile(dict_ref, file_name);
+  ASSERT_EQ(loaded_dict->storageEntryCount(), strings.size());
+  for (size_t i = 0; i < strings.size(); ++i) {
+    ASSERT_EQ(loaded_dict->getIdOfString(strings[i]), static_cast<int32_t>(i));
+    ASSERT_EQ(loaded_dict->getString(i), strings[i]);
+  }
+  ASSERT_EQ(loaded_dict->getOrAdd("new"), static_cast<int32_t>(strings.size()));
+  ASSERT_EQ(loaded_dict->getString(1000), strings[1000]);
+
+  // Truncated file is rejected.
+  boost::filesystem::resize_file(file_name, boost::filesystem::file_size(file_name) - 1);
+  ASSERT_THROW(StringDictionary::loadFromFile(dict_ref, file_name), std::runtime_error);
+  boost::filesystem::remove(file_name);
+}
+
 TEST(StringDictionary, BuildTranslationMap) {
   const DictRef dict_ref1(-1, 1);
   const DictRef dict_ref2(-1, 2);
@@ -265,6 +379,51 @@ TEST(StringDictionary, BuildTranslationMap) {
       }
     }
   }
+
+  {
+    // Add the missing strings to the destination and a new string to the source.
+    // Translation cached by the previous call has to be extended and previously
+    // missing strings have to be found.
+    ASSERT_EQ(dest_string_dict->getOrAdd("0"), g_op_count - 2);
+    ASSERT_EQ(dest_string_dict->getOrAdd("1"), g_op_count - 1);
+    ASSERT_EQ(dest_string_dict->getOrAdd("new"), g_op_count);
+    ASSERT_EQ(source_string_dict->getOrAdd("new"), g_op_count);
+    const auto translated_ids = source_string_dict->buildDictionaryTranslationMap(
+        dest_string_dict, dummy_callback);
+    ASSERT_EQ(translated_ids.size(), static_cast<size_t>(g_op_count + 1));
+    ASSERT_EQ(translated_ids[0], g_op_count - 2);
+    ASSERT_EQ(translated_ids[1], g_op_count - 1);
+    for (int32_t idx = 2; idx < g_op_count; ++idx) {
+      ASSERT_EQ(translated_ids[idx], g_op_count - idx - 1);
+    }
+    ASSERT_EQ(translated_ids[g_op_count], g_op_count);
+  }
+}
+
+TEST(StringDictionary, BuildTranslationMapRecreatedDest) {
+  const DictRef source_dict_ref(-1, 1);
+  const DictRef dest_dict_ref(-1, 2);
+  auto source_string_dict =
+      std::make_shared<StringDictionary>(source_dict_ref, g_cache_string_hash);
+  ASSERT_EQ(source_string_dict->getOrAdd("a"), 0);
+  ASSERT_EQ(source_string_dict->getOrAdd("b"), 1);
+  auto dummy_callback = [](const std::string_view& source_string,
+                           const int32_t source_string_id) { return false; };
+
+  for (int i = 0; i < 3; ++i) {
+    // Destination dictionary is dropped and created again with the same ref and the
+    // same strings in a different order. Translation cached for the dropped dictionary
+    // must not be used.
+    auto dest_string_dict =
+        std::make_shared<StringDictionary>(dest_dict_ref, g_cache_string_hash);
+    ASSERT_EQ(dest_string_dict->getOrAdd(i % 2 ? "a" : "b"), 0);
+    ASSERT_EQ(dest_string_dict->getOrAdd(i % 2 ? "b" : "a"), 1);
+    const auto translated_ids = source_string_dict->buildDictionaryTranslationMap(
+        dest_string_dict, dummy_callback);
+    ASSERT_EQ(translated_ids.size(), size_t(2));
+    ASSERT_EQ(translated_ids[0], i % 2 ? 0 : 1);
+    ASSERT_EQ(translated_ids[1], i % 2 ? 1 : 0);
+  }
 }
 
 TEST(StringDictionaryProxy, GetOrAddTransient) {
@@ -782,6 +941,38 @@ TEST(StringDictionaryProxy, BuildUnionTranslationMapToPartialOverlapProxy) {
                      true);
 }
 
+TEST(StringDictionaryProxy, BuildStringOpTranslationMap) {
+  const DictRef dict_ref(-1, 1);
+  std::shared_ptr<StringDictionary> sd =
+      std::make_shared<StringDictionary>(dict_ref, g_cache_string_hash);
+  const auto abc_id = sd->getOrAdd("ABC");
+  const auto lower_abc_id = sd->getOrAdd("abc");
+  const auto def_id = sd->getOrAdd("Def");
+
+  StringDictionaryProxy sdp(sd, 1 /* string_dict_id */, sd->storageEntryCount());
+  const auto ghi_id = sdp.getOrAddTransient("GHI");
+  ASSERT_EQ(sdp.transientEntryCount(), 1UL);
+
+  const auto id_map = sdp.buildStringOpTranslationMap([](const std::string& str) {
+    std::string res(str);
+    std::transform(res.begin(), res.end(), res.begin(), ::tolower);
+    return res;
+  });
+  ASSERT_EQ(id_map.numNonTransients(), 3UL);
+  ASSERT_EQ(id_map.numTransients(), 1UL);
+  ASSERT_EQ(id_map[StringDictionary::INVALID_STR_ID], StringDictionary::INVALID_STR_ID);
+  // Results already in the dictionary keep persistent ids.
+  ASSERT_EQ(id_map[abc_id], lower_abc_id);
+  ASSERT_EQ(id_map[lower_abc_id], lower_abc_id);
+  // Other results are added as transients.
+  ASSERT_LT(id_map[def_id], StringDictionary::INVALID_STR_ID);
+  ASSERT_EQ(sdp.getString(id_map[def_id]), "def");
+  ASSERT_LT(id_map[ghi_id], StringDictionary::INVALID_STR_ID);
+  ASSERT_EQ(sdp.getString(id_map[ghi_id]), "ghi");
+  ASSERT_EQ(sdp.transientEntryCount(), 3UL);
+  ASSERT_EQ(sd->storageEntryCount(), 3UL);
+}
+
 TEST(StringDictionary, TransientUnion) {
   dict_ref_t const dict_ref_lhs(100, 10);
   auto sd_lhs = std::make_shared<StringDictionary>(dict_ref_lhs, g_cache_string_hash);
@@ -204,6 +204,21 @@ TEST_F(LowerFunctionTest, SelectLowercaseLiteral) {
   compare_result_set(expected_result_set, result_set);
 }
 
+TEST_F(LowerFunctionTest, LowercasePerRow) {
+  // Dictionaries bigger than the limit are lowered per row.
+  const auto max_dict_size = config().exec.codegen.lower_translation_max_dict_size;
+  config().exec.codegen.lower_translation_max_dict_size = 0;
+  auto result_set = run_multiple_agg(
+      "select lower(first_name), count(*) from lower_function_test_people "
+      "where lower(country_code) = 'us' or lower(first_name) = 'sue' "
+      "group by lower(first_name) order by 2 desc;",
+      ExecutorDeviceType::CPU);
+  config().exec.codegen.lower_translation_max_dict_size = max_dict_size;
+  std::vector<std::vector<ScalarTargetValue>> expected_result_set{{"john", int64_t(2)},
+                                                                  {"sue", int64_t(1)}};
+  compare_result_set(expected_result_set, result_set);
+}
+
 // TODO: Re-enable after clear definition around handling non-ASCII characters
 TEST_F(LowerFunctionTest, DISABLED_LowercaseNonAscii) {
   insertCsvValues("lower_function_test_people", "Ħ,Ħ,25,GB");
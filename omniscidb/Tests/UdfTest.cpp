@@ -20,6 +20,7 @@
 #include "DataMgr/DataMgr.h"
 #include "Logger/Logger.h"
 #include "QueryEngine/Execute.h"
+#include "QueryEngine/ExtensionFunctionsBatch.h"
 #include "QueryEngine/ExtensionFunctionsWhitelist.h"
 #include "ResultSet/ResultSet.h"
 #include "UdfCompiler/UdfCompiler.h"
@@ -33,6 +34,7 @@
 #include <exception>
 #include <limits>
 #include <memory>
+#include <numeric>
 #include <vector>
 
 using namespace TestHelpers;
@@ -191,6 +193,34 @@ TEST_F(UDFCompilerTest, CompilerPathTest) {
   EXPECT_NO_THROW(compiler.compileUdf(getUdfFileName()));
 }
 
+TEST_F(UDFCompilerTest, CompileCache) {
+  const auto cache_dir = boost::filesystem::temp_directory_path() /
+                         boost::filesystem::unique_path("udf_cache_%%%%-%%%%");
+  ScopeGuard remove_cache_dir = [&cache_dir] {
+    boost::filesystem::remove_all(cache_dir);
+  };
+
+  UdfCompiler compiler(g_device_arch, "", {}, cache_dir.string());
+  auto [cpu_ir_file, cuda_ir_file] = compiler.compileUdf(getUdfFileName());
+  EXPECT_NE(cache_dir, boost::filesystem::path(cpu_ir_file).parent_path());
+
+  // The second compilation is served from the cache.
+  boost::filesystem::remove(UdfCompiler::getAstFileName(getUdfFileName()));
+  auto [cached_cpu_ir_file, cached_cuda_ir_file] =
+      compiler.compileUdf(getUdfFileName());
+  EXPECT_EQ(cache_dir, boost::filesystem::path(cached_cpu_ir_file).parent_path());
+  EXPECT_TRUE(boost::filesystem::exists(cached_cpu_ir_file));
+  EXPECT_EQ(cuda_ir_file.empty(), cached_cuda_ir_file.empty());
+  EXPECT_TRUE(boost::filesystem::exists(UdfCompiler::getAstFileName(getUdfFileName())));
+
+  // Different compiler options don't reuse the cached IR.
+  UdfCompiler other_compiler(
+      g_device_arch, "", {"-D UDF_COMPILER_OPTION"}, cache_dir.string());
+  auto [other_cpu_ir_file, other_cuda_ir_file] =
+      other_compiler.compileUdf(getUdfFileName());
+  EXPECT_NE(cache_dir, boost::filesystem::path(other_cpu_ir_file).parent_path());
+}
+
 TEST_F(UDFCompilerTest, BadClangPath) {
   UdfCompiler compiler(g_device_arch, /*clang_path_override=*/get_udf_filename());
   EXPECT_ANY_THROW(compiler.compileUdf(getUdfFileName()));
@@ -333,6 +363,70 @@ TEST_F(UDFCompilerTest, UdfQuery) {
   dropTable("sal_emp");
 }
 
+namespace {
+
+int64_t add_one_batch_calls{0};
+
+void add_one_batch(const int8_t* const* cols, const int64_t num_rows, int8_t* out) {
+  ++add_one_batch_calls;
+  const auto vals = reinterpret_cast<const int32_t*>(cols[0]);
+  auto res = reinterpret_cast<int32_t*>(out);
+  for (int64_t i = 0; i < num_rows; ++i) {
+    res[i] = vals[i] + 1;
+  }
+}
+
+}  // namespace
+
+TEST(BatchExtensionFunctions, Registration) {
+  ExtensionFunctionsWhitelist::addRTUdfs(
+      R"([{"name": "batch_test_add_one", "ret": "i32", "args": ["i32"]},)"
+      R"({"name": "batch_test_add_one__batch", "ret": "i32", "args": ["i32"],)"
+      R"("batch": true}])");
+  ScopeGuard reset = [] { ExtensionFunctionsWhitelist::clearRTUdfs(); };
+
+  // Batch implementations are never bound to calls directly.
+  for (bool is_gpu : {false, true}) {
+    auto ext_funcs =
+        ExtensionFunctionsWhitelist::get_ext_funcs("batch_test_add_one", is_gpu);
+    ASSERT_EQ(ext_funcs.size(), size_t(1));
+    EXPECT_FALSE(ext_funcs.front().isBatch());
+  }
+  auto ext_funcs =
+      ExtensionFunctionsWhitelist::get_ext_funcs("batch_test_add_one", size_t(1));
+  ASSERT_EQ(ext_funcs.size(), size_t(1));
+  auto batch_func = ExtensionFunctionsWhitelist::get_batch_ext_func(ext_funcs.front());
+  ASSERT_TRUE(batch_func);
+  EXPECT_TRUE(batch_func->isBatch());
+  EXPECT_EQ(batch_func->getName(), "batch_test_add_one__batch");
+}
+
+TEST(BatchExtensionFunctions, CachedResults) {
+  std::vector<int32_t> vals(5000);
+  std::iota(vals.begin(), vals.end(), -100);
+  const int8_t* cols[] = {reinterpret_cast<const int8_t*>(vals.data())};
+  const int32_t col_widths[] = {sizeof(int32_t)};
+  auto func = reinterpret_cast<int8_t*>(&add_one_batch);
+  const int64_t num_rows = vals.size();
+
+  auto check_results = [&](int64_t step) {
+    reset_batch_ext_func_cache();
+    add_one_batch_calls = 0;
+    for (int64_t pos = 0; pos < num_rows; pos += step) {
+      const auto res = batch_ext_func_result(
+          func, cols, col_widths, 1, sizeof(int32_t), pos, num_rows);
+      ASSERT_EQ(vals[pos] + 1, *reinterpret_cast<const int32_t*>(res));
+    }
+  };
+
+  // Batches grow while all their rows are used.
+  check_results(1);
+  EXPECT_LT(add_one_batch_calls, num_rows / 16);
+  // Sparse rows still get correct results.
+  check_results(100);
+  EXPECT_EQ(add_one_batch_calls, num_rows / 100);
+}
+
 int main(int argc, char** argv) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   ::testing::InitGoogleTest(&argc, argv);
@@ -41,9 +41,12 @@
 #pragma GCC diagnostic pop
 #endif
 
+#include <boost/filesystem.hpp>
 #include <boost/process/search_path.hpp>
+#include <fstream>
 #include <iterator>
 #include <memory>
+#include <sstream>
 
 #include "Logger/Logger.h"
 #include "OSDependent/omnisci_fs.h"
@@ -306,9 +309,11 @@ UdfCompiler::UdfCompiler(CudaMgr_Namespace::NvidiaDeviceArch target_arch,
 
 UdfCompiler::UdfCompiler(CudaMgr_Namespace::NvidiaDeviceArch target_arch,
                          const std::string& clang_path_override,
-                         const std::vector<std::string> clang_options)
+                         const std::vector<std::string> clang_options,
+                         const std::string& cache_dir)
     : clang_path_(get_clang_path(clang_path_override))
     , clang_options_(clang_options)
+    , cache_dir_(cache_dir)
 #ifdef HAVE_CUDA
     , target_arch_(target_arch)
 #endif
@@ -325,6 +330,16 @@ std::pair<std::string, std::string> UdfCompiler::compileUdf(
                              " does not exist.");
   }
 
+  std::string cache_key;
+  if (!cache_dir_.empty()) {
+    cache_key = getCacheKey(udf_file_name);
+    auto cached_ir_files = loadFromCache(udf_file_name, cache_key);
+    if (cached_ir_files) {
+      LOG(INFO) << "Using UDF IR cached in " << cache_dir_ << " for " << udf_file_name;
+      return *cached_ir_files;
+    }
+  }
+
   // create the AST file  for the input function
   generateAST(udf_file_name);
 
@@ -344,9 +359,103 @@ std::pair<std::string, std::string> UdfCompiler::compileUdf(
                e.what();
   }
 #endif
+  if (!cache_key.empty()) {
+    storeInCache(udf_file_name, cache_key, {cpu_file_name, cuda_file_name});
+  }
+  return std::make_pair(cpu_file_name, cuda_file_name);
+}
+
+namespace {
+
+// FNV-1a, which unlike std::hash is stable across processes and builds.
+uint64_t stable_hash(const std::string& str) {
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (const auto c : str) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+std::string cached_file_name(const std::string& cache_dir,
+                             const std::string& cache_key,
+                             const std::string& suffix) {
+  return (boost::filesystem::path(cache_dir) / (cache_key + suffix)).string();
+}
+
+// Copies through a temporary file, so that concurrent processes never see a partially
+// written file.
+void copy_file_atomically(const std::string& from, const std::string& to) {
+  const auto tmp = to + "." + boost::filesystem::unique_path().string();
+  boost::filesystem::copy_file(from, tmp);
+  boost::filesystem::rename(tmp, to);
+}
+
+}  // namespace
+
+std::string UdfCompiler::getCacheKey(const std::string& udf_file_name) const {
+  std::ifstream udf_file(udf_file_name, std::ios::binary);
+  std::stringstream key;
+  key << udf_file.rdbuf();
+  const auto [clang_major, clang_minor, clang_patchlevel] =
+      get_clang_version(clang_path_);
+  key << '\0' << clang_path_ << '\0' << clang_major << '.' << clang_minor << '.'
+      << clang_patchlevel << '\0' << CLANG_VERSION_STRING << '\0' << UDF_INCLUDE_PATH;
+  for (const auto& option : clang_options_) {
+    key << '\0' << option;
+  }
+#ifdef HAVE_CUDA
+  key << '\0' << CudaMgr_Namespace::CudaMgr::deviceArchToSM(target_arch_);
+#endif
+  std::stringstream hex_key;
+  hex_key << std::hex << stable_hash(key.str());
+  return hex_key.str();
+}
+
+std::optional<std::pair<std::string, std::string>> UdfCompiler::loadFromCache(
+    const std::string& udf_file_name,
+    const std::string& cache_key) const {
+  const auto ast_file_name = cached_file_name(cache_dir_, cache_key, ".ast");
+  const auto cpu_file_name = cached_file_name(cache_dir_, cache_key, "_cpu.bc");
+  auto cuda_file_name = cached_file_name(cache_dir_, cache_key, "_gpu.bc");
+  try {
+    if (!boost::filesystem::exists(ast_file_name) ||
+        !boost::filesystem::exists(cpu_file_name)) {
+      return std::nullopt;
+    }
+    // GPU IR is missing when it failed to compile, CPU IR is used for GPU then.
+    if (!boost::filesystem::exists(cuda_file_name)) {
+      cuda_file_name.clear();
+    }
+    // The AST is always looked up next to the UDF source.
+    copy_file_atomically(ast_file_name, getAstFileName(udf_file_name));
+  } catch (const boost::filesystem::filesystem_error& e) {
+    LOG(WARNING) << "Failed to use UDF IR cached in " << cache_dir_ << ": " << e.what();
+    return std::nullopt;
+  }
   return std::make_pair(cpu_file_name, cuda_file_name);
 }
 
+void UdfCompiler::storeInCache(
+    const std::string& udf_file_name,
+    const std::string& cache_key,
+    const std::pair<std::string, std::string>& ir_files) const {
+  try {
+    boost::filesystem::create_directories(cache_dir_);
+    if (!ir_files.second.empty()) {
+      copy_file_atomically(ir_files.second,
+                           cached_file_name(cache_dir_, cache_key, "_gpu.bc"));
+    }
+    copy_file_atomically(getAstFileName(udf_file_name),
+                         cached_file_name(cache_dir_, cache_key, ".ast"));
+    // The CPU IR goes last, its presence marks a complete cache entry.
+    copy_file_atomically(ir_files.first,
+                         cached_file_name(cache_dir_, cache_key, "_cpu.bc"));
+  } catch (const boost::filesystem::filesystem_error& e) {
+    LOG(WARNING) << "Failed to cache UDF IR in " << cache_dir_ << ": " << e.what();
+  }
+}
+
 namespace {
 
 std::string remove_file_extension(const std::string& path) {
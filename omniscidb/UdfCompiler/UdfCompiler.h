@@ -17,6 +17,7 @@
 #ifndef UDF_COMPILER_H
 #define UDF_COMPILER_H
 
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -27,6 +28,11 @@
  * Default initialization will find Clang using the clang library invocations. An optional
  * clang override and additional arguments to the clang binary can be added. Once
  * initialized the class holds the state for calling clang until destruction.
+ *
+ * When a cache directory is given, the generated AST and IR files are kept there under
+ * a hash of the UDF source, the clang options, the clang binary and its version, and
+ * reused by later compilations of the same UDF, including by other processes. Headers
+ * included by the UDF source are not part of the hash.
  */
 class UdfCompiler {
  public:
@@ -34,7 +40,8 @@ class UdfCompiler {
               const std::string& clang_path_override = "");
   UdfCompiler(CudaMgr_Namespace::NvidiaDeviceArch target_arch,
               const std::string& clang_path_override,
-              const std::vector<std::string> clang_options);
+              const std::vector<std::string> clang_options,
+              const std::string& cache_dir = "");
 
   /**
    * Compile a C++ file to LLVM IR, and generate an AST file. Both artifacts exist as
@@ -69,8 +76,21 @@ class UdfCompiler {
    */
   int compileFromCommandLine(const std::vector<std::string>& command_line) const;
 
+  std::string getCacheKey(const std::string& udf_file_name) const;
+  /**
+   * Return the cached CPU and GPU IR files for the key and put the cached AST file next
+   * to the UDF source, or return nothing if the key is not cached.
+   */
+  std::optional<std::pair<std::string, std::string>> loadFromCache(
+      const std::string& udf_file_name,
+      const std::string& cache_key) const;
+  void storeInCache(const std::string& udf_file_name,
+                    const std::string& cache_key,
+                    const std::pair<std::string, std::string>& ir_files) const;
+
   std::string clang_path_;
   std::vector<std::string> clang_options_;
+  std::string cache_dir_;
 #ifdef HAVE_CUDA
   CudaMgr_Namespace::NvidiaDeviceArch target_arch_;
 #endif
@@ -0,0 +1,85 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "RegexpMatcher.h"
+
+#include <boost/regex.hpp>
+
+#include <cctype>
+#include <stdexcept>
+
+namespace {
+
+// Wrapping a pattern into a group renumbers groups referenced by it.
+bool has_back_references(const std::string& pattern) {
+  for (size_t i = 0; i + 1 < pattern.size(); ++i) {
+    if (pattern[i] == '\\' && std::isdigit(static_cast<unsigned char>(pattern[i + 1]))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+struct RegexpMatcher::Impl {
+  std::vector<boost::regex> regexes;
+};
+
+RegexpMatcher::RegexpMatcher(const std::vector<std::string>& patterns)
+    : impl_(std::make_unique<Impl>()) {
+  std::vector<std::string> valid_patterns;
+  bool can_combine = true;
+  for (const auto& pattern : patterns) {
+    try {
+      impl_->regexes.emplace_back(pattern, boost::regex::extended);
+    } catch (std::runtime_error&) {
+      continue;
+    }
+    valid_patterns.push_back(pattern);
+    can_combine = can_combine && !has_back_references(pattern);
+  }
+  if (valid_patterns.size() < 2 || !can_combine) {
+    return;
+  }
+  // One alternation is matched in a single pass over the string instead of a pass
+  // per pattern.
+  std::string combined;
+  for (const auto& pattern : valid_patterns) {
+    combined += (combined.empty() ? "(" : "|(") + pattern + ")";
+  }
+  try {
+    boost::regex combined_regex(combined, boost::regex::extended);
+    impl_->regexes.clear();
+    impl_->regexes.push_back(std::move(combined_regex));
+  } catch (std::runtime_error&) {
+    // Keep the patterns apart.
+  }
+}
+
+RegexpMatcher::~RegexpMatcher() = default;
+
+bool RegexpMatcher::matches(const char* str, size_t str_len) const {
+  for (const auto& re : impl_->regexes) {
+    try {
+      if (boost::regex_match(str, str + str_len, re)) {
+        return true;
+      }
+    } catch (std::runtime_error&) {
+      // Matching may fail on too complex input, treated as no match like in
+      // regexp_like().
+    }
+  }
+  return false;
+}
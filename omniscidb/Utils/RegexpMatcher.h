@@ -0,0 +1,49 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    RegexpMatcher.h
+ * @brief   Precompiled patterns of the REGEXP operator and REGEXP_LIKE function.
+ *
+ * regexp_like() parses its pattern on every call. The matcher parses patterns once
+ * and is then shared by threads, which is used for dictionary scans and, through a
+ * handle, by generated code. A matcher of several patterns accepts a string matching
+ * any of them, which evaluates OR'ed REGEXP filters on the same string in one pass.
+ **/
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+class RegexpMatcher {
+ public:
+  // Patterns use the POSIX extended syntax. Invalid patterns match nothing, like
+  // in regexp_like().
+  explicit RegexpMatcher(const std::vector<std::string>& patterns);
+  ~RegexpMatcher();
+
+  RegexpMatcher(const RegexpMatcher&) = delete;
+  RegexpMatcher& operator=(const RegexpMatcher&) = delete;
+
+  // True if the whole string matches one of the patterns.
+  bool matches(const char* str, size_t str_len) const;
+  bool matches(const std::string& str) const { return matches(str.data(), str.size()); }
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
@@ -25,6 +25,10 @@
 
 #include "StringLike.h"
 
+#ifndef __CUDACC__
+#include <string_view>
+#endif
+
 enum LikeStatus {
   kLIKE_TRUE,
   kLIKE_FALSE,
@@ -44,6 +48,12 @@ extern "C" RUNTIME_EXPORT DEVICE bool string_like_simple(const char* str,
                                                          const int32_t str_len,
                                                          const char* pattern,
                                                          const int32_t pat_len) {
+#ifndef __CUDACC__
+  // The search for the first pattern byte and comparisons go through vectorized
+  // memchr and memcmp of the C library.
+  return std::string_view(str, str_len).find(std::string_view(pattern, pat_len)) !=
+         std::string_view::npos;
+#else
   int i, j;
   int search_len = str_len - pat_len + 1;
   for (i = 0; i < search_len; ++i) {
@@ -54,6 +64,7 @@ extern "C" RUNTIME_EXPORT DEVICE bool string_like_simple(const char* str,
     }
   }
   return false;
+#endif
 }
 
 extern "C" RUNTIME_EXPORT DEVICE bool string_ilike_simple(const char* str,
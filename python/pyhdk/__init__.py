@@ -20,7 +20,15 @@ elif sys.platform == "win32":
         )
     os.add_dll_directory(os.path.join(os.environ["JAVA_HOME"], "bin", "server"))
 
-from pyhdk._common import TypeInfo, buildConfig, initLogger
+from pyhdk._common import (
+    TypeInfo,
+    buildConfig,
+    initLogger,
+    metrics,
+    metricsPrometheus,
+    startTrace,
+    stopTrace,
+)
 from pyhdk._execute import Executor
 import pyhdk.sql as sql
 import pyhdk.storage as storage
@@ -109,6 +109,7 @@ cdef extern from "omniscidb/QueryBuilder/QueryBuilder.h":
 
     CBuilderNode scan(const string&) except +
     CBuilderNode proj(const vector[CBuilderExpr]&) except +
+    CBuilderNode parseSql(const string&) except +
 
     CBuilderExpr count() except +
 
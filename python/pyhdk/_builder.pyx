@@ -12,6 +12,7 @@ from pyhdk._ir cimport CNode, CScan, CExpr, CColumnRefExpr
 from pyhdk._sql cimport CExecutionResult, ExecutionResult, CQueryDag, QueryDag, RelAlgExecutor
 
 from collections.abc import Iterable
+import random
 
 cdef class QueryExpr:
   cdef CBuilderExpr c_expr
@@ -627,6 +628,28 @@ cdef class QueryNode:
     res.scan = self._hdk.scan(res.table_name)
     return res
 
+  def head(self, n, **kwargs):
+    # Execution of a limit without ordering stops fetching fragments when
+    # enough rows are collected.
+    return self.sort(limit=n).run(**kwargs)
+
+  def sample(self, n, seed=None, **kwargs):
+    if not self.is_scan:
+      return self.run(**kwargs).sample(n, seed)
+
+    if seed is None:
+      seed = random.getrandbits(64)
+    table_info = self.c_node.node().get().asNode[CScan]().getTableInfo().get()
+    frag_count = table_info.fragments
+    row_count = table_info.row_count
+    if frag_count > 1 and 0 < n < row_count:
+      # Read only randomly chosen fragments enough to hold n rows on average,
+      # plus one to mitigate unequal fragments.
+      take_frags = min(frag_count, -(-n * frag_count // row_count) + 1)
+      frags = random.Random(seed).sample(range(frag_count), take_frags)
+      kwargs["outer_fragment_indices"] = sorted(frags)
+    return self.run(**kwargs).sample(n, seed)
+
   def finalize(self):
     cdef CQueryDag* c_dag = self.c_node.finalize().release()
     dag = QueryDag()
@@ -654,6 +677,15 @@ cdef class QueryBuilder:
     res._hdk = self._hdk
     return res
 
+  def parse_sql(self, sql):
+    cdef CBuilderNode c_node = self.c_builder.get().parseSql(sql)
+    if c_node.node().get() == NULL:
+      return None
+    res = QueryNode()
+    res.c_node = c_node
+    res._hdk = self._hdk
+    return res
+
   def typeFromString(self, type_str):
     if not isinstance(type_str, str):
       raise TypeError(f"Only strings are supported for 'type_str' arg. Provided: {type_str}")
@@ -5,7 +5,9 @@
 
 from libcpp cimport bool
 from libcpp.string cimport string
+from libcpp.map cimport map
 from libcpp.memory cimport shared_ptr
+from libc.stdint cimport int64_t
 
 cdef extern from "omniscidb/IR/Type.h":
   enum CTypeId "hdk::ir::Type::Id":
@@ -116,6 +118,18 @@ cdef extern from "omniscidb/Logger/Logger.h" namespace "logger":
 
   cdef void CInitLogger "logger::init"(const CLogOptions &)
 
+cdef extern from "omniscidb/Logger/Trace.h" namespace "trace":
+  cdef void CStartTrace "trace::start"()
+  cdef string CStopTrace "trace::stop"()
+
+cdef extern from "omniscidb/Shared/Metrics.h" namespace "metrics":
+  cdef cppclass CMetricsRegistry "metrics::Registry":
+    @staticmethod
+    CMetricsRegistry& get()
+
+    map[string, double] snapshot()
+    string toPrometheusText()
+
 cdef extern from "omniscidb/Shared/Config.h":
   cdef cppclass CWatchdogConfig "WatchdogConfig":
     bool enable
@@ -127,12 +141,22 @@ cdef extern from "omniscidb/Shared/Config.h":
   cdef cppclass CCpuSubTasksConfig "CpuSubTasksConfig":
     bool enable
     size_t sub_task_size
+    size_t min_sub_task_size
 
   cdef cppclass CJoinConfig "JoinConfig":
     bool allow_loop_joins
     unsigned trivial_loop_join_threshold
     size_t huge_join_hash_threshold
     size_t huge_join_hash_min_load
+    bool enable_join_hash_ndv_load
+    size_t partitioned_hash_build_threshold
+    bool enable_sort_join
+    bool enable_string_join
+    bool enable_range_join
+    bool enable_loop_join_scan
+    bool enable_crc32_key_hash
+    size_t hash_table_prefetch_threshold
+    bool enable_compact_join_keys
 
   cdef cppclass CGroupByConfig "GroupByConfig":
     bool bigint_count
@@ -145,6 +169,20 @@ cdef extern from "omniscidb/Shared/Config.h":
     size_t gpu_smem_threshold
     unsigned hll_precision_bits
     size_t baseline_threshold
+    bool enable_partitioned_reduction
+    size_t partitioned_reduction_threshold
+    bool enable_streaming_reduction
+    bool enable_partitioned_aggregation
+    size_t partitioned_aggregation_max_groups
+    bool enable_roaring_count_distinct
+    int64_t roaring_count_distinct_bitmap_bits_threshold
+    bool enable_sparse_hll
+    bool enable_column_stats_ndv
+    size_t gpu_groupby_buffer_max_growths
+    bool enable_group_count_history
+    bool enable_cost_based_hash_layout
+    double baseline_hash_row_cost
+    bool enable_range_based_slot_compaction
 
   cdef cppclass CWindowFunctionsConfig "WindowFunctionsConfig":
     bool enable
@@ -152,6 +190,9 @@ cdef extern from "omniscidb/Shared/Config.h":
     size_t parallel_window_partition_compute_threshold
     bool parallel_window_partition_sort
     size_t parallel_window_partition_sort_threshold
+    bool gpu_partition_sort
+    size_t gpu_partition_sort_threshold
+    bool enable_partition_limits
 
   cdef cppclass CHeterogenousConfig "HeterogenousConfig":
     bool enable_heterogeneous_execution
@@ -161,17 +202,39 @@ cdef extern from "omniscidb/Shared/Config.h":
     unsigned forced_gpu_proportion
     bool allow_cpu_retry
     bool allow_query_step_cpu_retry
+    bool allow_kernel_cpu_retry
+    bool enable_work_stealing
 
   cdef cppclass CInterruptConfig "InterruptConfig":
     bool enable_runtime_query_interrupt
     bool enable_non_kernel_time_query_interrupt
     double running_query_interrupt_freq
+    size_t cpu_check_interval
 
   cdef cppclass CCodegenConfig "CodegenConfig":
     bool inf_div_by_zero
     bool null_div_by_zero
     bool hoist_literals
     bool enable_filter_function
+    bool enable_loop_vectorization
+    bool enable_common_subexpr_elimination
+    bool enable_branchless_case
+    bool enable_precompiled_regexp
+    bool enable_stats_null_check_elimination
+    bool enable_jit_profiling
+    bool enable_expression_counters
+    size_t date_lookup_table_max_days
+    size_t lower_translation_max_dict_size
+    bool enable_batch_ext_funcs
+
+  cdef cppclass CQuerySchedulerConfig "QuerySchedulerConfig":
+    size_t max_cpu_queries
+    size_t max_gpu_queries
+    size_t cpu_memory_budget
+    size_t gpu_memory_budget
+    bool enable_shared_scans
+    size_t shared_scan_window_ms
+    bool enable_preemption
 
   cdef cppclass CExecutionConfig "ExecutionConfig":
     CWatchdogConfig watchdog
@@ -181,17 +244,33 @@ cdef extern from "omniscidb/Shared/Config.h":
     CWindowFunctionsConfig window_func
     CHeterogenousConfig heterogeneous
     CInterruptConfig interrupt
+    CQuerySchedulerConfig scheduler
     CCodegenConfig codegen
     size_t streaming_topn_max
+    size_t cpu_streaming_topn_max
     size_t parallel_top_min
     bool enable_experimental_string_functions
     bool enable_interop
     size_t parallel_linearization_threshold
+    bool enable_linearized_column_cache
     bool enable_multifrag_rs
     size_t override_gpu_block_size
     size_t override_gpu_grid_size
     bool cpu_only
+    bool enable_gpu_transfer_overlap
+    bool enable_l0_sub_devices
+    bool enable_gpu_compressed_transfer
+    bool enable_cpu_compressed_columns
+    bool enable_gpu_fragment_affinity
+    bool enable_gpu_launch_autotuning
+    bool enable_fragment_qual_elimination
     string initialize_with_gpu_vendor;
+    unsigned cpu_threads_per_query
+    bool enable_limit_early_termination
+    size_t calcite_workers
+    bool enable_native_sql_parser
+    bool enable_calcite
+    bool enable_query_profile
 
   cdef cppclass CFilterPushdownConfig "FilterPushdownConfig":
     bool enable
@@ -202,24 +281,48 @@ cdef extern from "omniscidb/Shared/Config.h":
   cdef cppclass COptimizationsConfig "OptimizationsConfig":
     CFilterPushdownConfig filter_pushdown
     bool from_table_reordering
+    bool enable_join_selectivity_reordering
+    bool enable_filter_reordering
     size_t constrained_by_in_threshold
     bool enable_left_join_filter_hoisting
+    bool skip_fragments_by_join_key_range
+    bool skip_fragments_by_dict_string_stats
 
   cdef cppclass CResultSetConfig "ResultSetConfig":
     bool enable_columnar_output
+    bool enable_columnar_intermediate_results
     bool optimize_row_initialization
+    bool enable_lazy_group_init
+    size_t lazy_group_init_threshold
     bool enable_direct_columnarization
+    bool enable_lazy_columnarization
     bool enable_lazy_fetch
+    bool enable_radix_sort
+    size_t external_sort_threshold
+    string external_sort_dir
+    bool keep_gpu_results
+    size_t registry_memory_limit
+    string registry_spill_dir
 
   cdef cppclass CGpuMemoryConfig "GpuMemoryConfig":
     size_t min_memory_allocation_size
     size_t max_memory_allocation_size
     double input_mem_limit_percent
     size_t reserved_mem_bytes
+    bool enable_cost_aware_eviction
+    string resident_tables
+    bool enable_unified_memory_zero_copy
+    size_t thrust_scratch_pool_size
 
   cdef cppclass CCpuMemoryConfig "CpuMemoryConfig":
     bool enable_tiered_cpu_mem
+    bool enable_numa_aware_slabs
+    size_t pinned_slabs_size
+    bool enable_huge_pages
+    size_t prefault_size
     size_t pmem_size
+    size_t tier_migration_interval_ms
+    size_t tier_migration_max_bytes
 
   cdef cppclass CMemoryConfig "MemoryConfig":
     CCpuMemoryConfig cpu
@@ -231,13 +334,23 @@ cdef extern from "omniscidb/Shared/Config.h":
     bool use_hashtable_cache
     size_t hashtable_cache_total_bytes
     size_t max_cacheable_hashtable_size_bytes
+    bool use_result_set_cache
+    bool use_incremental_result_set_cache
+    bool reuse_node_results
+    bool reuse_col_ranges
+    size_t result_set_cache_total_bytes
+    size_t max_cacheable_result_set_size_bytes
     double gpu_fraction_code_cache_to_evict
+    size_t gpu_code_cache_max_bytes
     size_t dag_cache_size
     size_t code_cache_size
+    bool enable_rel_alg_cache
+    size_t rel_alg_cache_size
 
   cdef cppclass CDebugConfig "DebugConfig":
     string build_ra_cache
     string use_ra_cache
+    string workload_capture_file
     bool enable_automatic_ir_metadata
 
   cdef cppclass CConfig "Config":
@@ -247,6 +360,7 @@ cdef extern from "omniscidb/Shared/Config.h":
     CMemoryConfig mem
     CCacheConfig cache
     CDebugConfig debug
+    bool enable_auto_config
 
 ctypedef shared_ptr[CConfig] CConfigPtr
 
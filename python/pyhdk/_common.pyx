@@ -210,3 +210,20 @@ def initLogger(*, debug_logs=False, **kwargs):
   if debug_logs:
     opts.get().severity_ = CSeverity.DEBUG3
   CInitLogger(dereference(opts))
+
+def startTrace():
+  """Start recording a timeline of query execution."""
+  CStartTrace()
+
+def stopTrace():
+  """Stop recording and return the timeline as Chrome trace JSON."""
+  return CStopTrace().decode()
+
+def metrics():
+  """Current values of engine metrics keyed by Prometheus sample names."""
+  snapshot = CMetricsRegistry.get().snapshot()
+  return {name.decode(): val for name, val in snapshot.items()}
+
+def metricsPrometheus():
+  """Engine metrics in the Prometheus text exposition format."""
+  return CMetricsRegistry.get().toPrometheusText().decode()
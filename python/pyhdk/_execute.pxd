@@ -4,13 +4,14 @@
 # SPDX-License-Identifier: Apache-2.0
 
 from libcpp cimport bool
-from libc.stdint cimport int64_t
+from libc.stdint cimport int8_t, int64_t, uint64_t
 from libcpp.memory cimport shared_ptr, make_shared, unique_ptr, make_unique
 from libcpp.string cimport string
 from libcpp.vector cimport vector
 from libcpp.utility cimport move
 
 from pyarrow.lib cimport CTable as CArrowTable
+from pyarrow.lib cimport CRecordBatchReader
 
 from pyhdk._common cimport CType, CConfig
 from pyhdk._storage cimport CDataMgr, CBufferProvider, CSchemaProvider, CAbstractDataProvider
@@ -88,6 +89,9 @@ cdef extern from "omniscidb/QueryEngine/CompilationOptions.h":
     vector[size_t] outer_fragment_indices
     bool multifrag_result
     bool preserve_order
+    bool with_profile
+    double sample_rate
+    uint64_t sample_seed
 
     @staticmethod
     CExecutionOptions fromConfig(const CConfig)
@@ -119,6 +123,14 @@ cdef extern from "omniscidb/ResultSet/TargetValue.h":
 cdef extern from "omniscidb/ResultSet/ResultSet.h":
   cdef cppclass CResultSet "ResultSet":
     size_t rowCount()
+    size_t colCount()
+    const CType* colType(size_t)
+    bool isTruncated()
+
+    bool isZeroCopyColumnarConversionPossible(size_t)
+    const int8_t* getColumnarBuffer(size_t) except +
+    const int8_t* getDeviceColumnarBuffer(size_t)
+    int getDeviceId()
 
     string toString() const
     string contentToString(bool) const
@@ -141,7 +153,10 @@ cdef extern from "omniscidb/QueryEngine/ArrowResultSet.h":
   cdef cppclass CArrowResultSetConverter "ArrowResultSetConverter":
     CArrowResultSetConverter(const CResultSetPtr&, const vector[string]&, int)
 
-    shared_ptr[CArrowTable] convertToArrowTable()
+    shared_ptr[CArrowTable] convertToArrowTable() nogil
+    shared_ptr[CRecordBatchReader] convertToArrowBatchReader(size_t) except + nogil
+    void exportToParquet(const string&, size_t) except + nogil
+    void exportToArrowIpc(const string&, size_t) except + nogil
 
 cdef extern from "omniscidb/QueryEngine/Execute.h":
   cdef cppclass CExecutor "Executor":
@@ -151,5 +166,7 @@ cdef extern from "omniscidb/QueryEngine/Execute.h":
     const CConfig &getConfig()
     shared_ptr[CConfig] getConfigPtr()
 
+    void registerRuntimeUdfModules(const vector[string]&, const vector[string]&) except +
+
 cdef class Executor:
   cdef shared_ptr[CExecutor] c_executor
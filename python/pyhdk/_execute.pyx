@@ -14,6 +14,11 @@ cdef class Executor:
     cdef string debug_file = "".encode('UTF-8')
     self.c_executor = CExecutor.getExecutor(data_mgr.c_data_mgr.get(), config.c_config, debug_dir, debug_file)
 
+  def register_runtime_udf_modules(self, cpu_irs, gpu_irs=None):
+    cdef vector[string] c_cpu_irs = [ir.encode('UTF-8') for ir in cpu_irs]
+    cdef vector[string] c_gpu_irs = [ir.encode('UTF-8') for ir in (gpu_irs or [])]
+    self.c_executor.get().registerRuntimeUdfModules(c_cpu_irs, c_gpu_irs)
+
 cdef class ResultSetRegistry(Storage):
   cdef shared_ptr[CResultSetRegistry] c_registry
 
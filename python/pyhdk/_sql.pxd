@@ -4,13 +4,14 @@
 # SPDX-License-Identifier: Apache-2.0
 
 from libcpp cimport bool
+from libc.stdint cimport int64_t, uint64_t
 from libcpp.memory cimport shared_ptr, unique_ptr
 from libcpp.string cimport string
 from libcpp.vector cimport vector
 
 from pyhdk._common cimport CConfig, CType
-from pyhdk._storage cimport CSchemaProvider, CSchemaProviderPtr, CDataProvider, CDataMgr, CBufferProvider
-from pyhdk._execute cimport CExecutor, CResultSetPtr, CCompilationOptions, CExecutionOptions, CTargetMetaInfo
+from pyhdk._storage cimport CSchemaProvider, CSchemaProviderPtr, CDataProvider, CDataMgr, CBufferProvider, CTableInfoPtr
+from pyhdk._execute cimport CExecutor, CExecutorDeviceType, CResultSetPtr, CCompilationOptions, CExecutionOptions, CTargetMetaInfo
 
 cdef extern from "omniscidb/QueryEngine/ExtensionFunctionsWhitelist.h":
   cdef cppclass CExtensionFunction "ExtensionFunction":
@@ -23,6 +24,15 @@ cdef extern from "omniscidb/QueryEngine/ExtensionFunctionsWhitelist.h":
     @staticmethod
     void addUdfs(const string)
 
+    @staticmethod
+    void clearRTUdfs()
+
+    @staticmethod
+    void addRTUdfs(const string&)
+
+    @staticmethod
+    vector[CExtensionFunction] getRTUdfs()
+
 cdef extern from "omniscidb/Calcite/CalciteJNI.h":
   cdef cppclass FilterPushDownInfo:
     int input_prev;
@@ -31,13 +41,13 @@ cdef extern from "omniscidb/Calcite/CalciteJNI.h":
 
   cdef cppclass CalciteMgr:    
     @staticmethod
-    CalciteMgr* get(const string&, size_t);
+    CalciteMgr* get(const string&, size_t, size_t);
     
-    string process(const string&, const string&, CSchemaProvider*, CConfig*, const vector[FilterPushDownInfo]&, bool, bool, bool) except +
+    string process(const string&, const string&, CSchemaProvider*, CConfig*, const vector[FilterPushDownInfo]&, bool, bool, bool) except + nogil
 
     string getExtensionFunctionWhitelist()
     string getUserDefinedFunctionWhitelist()
-    void setRuntimeExtensionFunctions(const vector[CExtensionFunction]&, bool)
+    void setRuntimeExtensionFunctions(const vector[CExtensionFunction]&, bool) except +
 
 cdef extern from "omniscidb/IR/Node.h":
   cdef cppclass CQueryDag "hdk::ir::QueryDag":
@@ -49,6 +59,33 @@ cdef class QueryDag:
 cdef extern from "omniscidb/QueryEngine/RelAlgDagBuilder.h":
   cdef cppclass CRelAlgDagBuilder "RelAlgDagBuilder"(CQueryDag):
     CRelAlgDagBuilder(const string&, int, CSchemaProviderPtr, shared_ptr[CConfig]) except +
+    CRelAlgDagBuilder(const string&, int, CSchemaProviderPtr, shared_ptr[CConfig], vector[string]) except +
+
+cdef extern from "omniscidb/QueryEngine/QueryProfile.h":
+  cdef cppclass CKernelProfile "KernelProfile":
+    CExecutorDeviceType device_type
+    int device_id
+    vector[size_t] fragment_ids
+    int64_t fetch_time
+    int64_t execution_time
+    size_t input_rows
+    size_t output_rows
+
+  cdef cppclass CStepProfile "StepProfile":
+    unsigned node_id
+    string node_name
+    int64_t total_time
+    int64_t compilation_time
+    int64_t hash_table_build_time
+    int64_t reduction_time
+    size_t input_rows
+    size_t output_rows
+    vector[CKernelProfile] kernels
+
+  cdef cppclass CQueryProfile "QueryProfile":
+    vector[CStepProfile] steps()
+    int64_t totalTime()
+    string toString()
 
 cdef extern from "omniscidb/QueryEngine/Descriptors/RelAlgExecutionDescriptor.h":
   cdef cppclass CExecutionResult "ExecutionResult":
@@ -63,6 +100,9 @@ cdef extern from "omniscidb/QueryEngine/Descriptors/RelAlgExecutionDescriptor.h"
 
     CExecutionResult head(size_t) except +
     CExecutionResult tail(size_t) except +
+    CExecutionResult sample(size_t, uint64_t) except +
+
+    shared_ptr[CQueryProfile] getProfile()
 
 cdef class ExecutionResult:
   cdef CExecutionResult c_result
@@ -80,10 +120,20 @@ cdef extern from "omniscidb/QueryEngine/RelAlgExecutor.h":
   cdef cppclass CRelAlgExecutor "RelAlgExecutor":
     CRelAlgExecutor(CExecutor*, CSchemaProviderPtr, unique_ptr[CQueryDag])
 
-    CExecutionResult executeRelAlgQuery(const CCompilationOptions&, const CExecutionOptions&, const bool) except +
+    CExecutionResult executeRelAlgQuery(const CCompilationOptions&, const CExecutionOptions&, const bool) except + nogil
     CExecutor *getExecutor()
+    void interrupt() nogil
+
+    CTableInfoPtr prepareStreamExecution(const CCompilationOptions&, const CExecutionOptions&) except + nogil
+    void runOnNewBatches() except + nogil
+    CExecutionResult pollStreamExecution() except + nogil
+    CExecutionResult finishStreamExecution() except + nogil
 
 cdef class RelAlgExecutor:
   cdef shared_ptr[CRelAlgExecutor] c_rel_alg_executor
   # DataMgr is used only to pass it to each produced ExecutionResult
   cdef shared_ptr[CDataMgr] c_data_mgr
+
+  cdef CCompilationOptions _compilation_options(self, kwargs)
+  cdef unique_ptr[CExecutionOptions] _execution_options(self, kwargs)
+  cdef ExecutionResult _wrap_result(self, CExecutionResult c_res)
@@ -3,13 +3,20 @@
 #
 # SPDX-License-Identifier: Apache-2.0
 
-from libc.stdint cimport int64_t
+from libc.stdint cimport int8_t, int64_t, uintptr_t
+from cpython.buffer cimport PyBUF_WRITABLE
 from libcpp.memory cimport make_shared, make_unique
 from libcpp.utility cimport move
 from cython.operator cimport dereference, preincrement, address
 
-from pyarrow.lib cimport pyarrow_wrap_table
+import numpy
+import random
+import pyarrow
+
+from pyarrow.lib cimport pyarrow_wrap_table, pyarrow_wrap_batch, pyarrow_wrap_schema
+from pyarrow.lib cimport check_status, CStatus
 from pyarrow.lib cimport CTable as CArrowTable
+from pyarrow.lib cimport CRecordBatch, CRecordBatchReader
 
 from pyhdk._common cimport CConfig, Config, boost_get, CType, CArrayBaseType
 from pyhdk._storage cimport SchemaProvider, CDataMgr, DataMgr
@@ -25,8 +32,12 @@ cdef class Calcite:
   def __cinit__(self, SchemaProvider schema_provider, Config config, **kwargs):
     cdef string udf_filename = kwargs.get("udf_filename", "")
     cdef size_t calcite_max_mem_mb = kwargs.get("calcite_max_mem_mb", 1024)
+    cdef size_t calcite_workers = kwargs.get("calcite_workers", config.c_config.get().exec.calcite_workers)
+
+    if not config.c_config.get().exec.enable_calcite:
+      raise RuntimeError("Cannot parse SQL query: Calcite is disabled by enable_calcite option.")
 
-    self.calcite = CalciteMgr.get(udf_filename, calcite_max_mem_mb)
+    self.calcite = CalciteMgr.get(udf_filename, calcite_max_mem_mb, calcite_workers)
     self.schema_provider = schema_provider.c_schema_provider
     self.config = config.c_config
 
@@ -43,7 +54,20 @@ cdef class Calcite:
     cdef bool legacy_syntax = kwargs.get("legacy_syntax", False)
     cdef bool is_explain = kwargs.get("is_explain", False)
     cdef bool is_view_optimize = kwargs.get("is_view_optimize", False)
-    return self.calcite.process(db_name, sql, self.schema_provider.get(), self.config.get(), filter_push_down_info, legacy_syntax, is_explain, is_view_optimize)
+    cdef CalciteMgr* calcite = self.calcite
+    cdef CSchemaProvider* c_schema_provider = self.schema_provider.get()
+    cdef CConfig* c_config = self.config.get()
+    cdef string res
+    with nogil:
+      res = calcite.process(db_name, sql, c_schema_provider, c_config, filter_push_down_info, legacy_syntax, is_explain, is_view_optimize)
+    return res
+
+  def set_runtime_udfs(self, string json_sigs):
+    CExtensionFunctionsWhitelist.clearRTUdfs()
+    CExtensionFunctionsWhitelist.addRTUdfs(json_sigs)
+    # Calcite only needs the functions which can be called from queries.
+    cdef vector[CExtensionFunction] udfs = CExtensionFunctionsWhitelist.getRTUdfs()
+    self.calcite.setRuntimeExtensionFunctions(udfs, True)
 
 cdef extract_scalar_value(const CScalarTargetValue &scalar, const CType *c_type):
   if isNull(scalar, c_type):
@@ -72,12 +96,151 @@ cdef extract_array_value(const CArrayTargetValue *array, const CType *c_type):
 
   return None
 
+cdef class ArrowBatchIterator:
+  cdef shared_ptr[CRecordBatchReader] c_reader
+  # Source execution result is referenced to keep its DataMgr alive.
+  cdef object _result
+
+  def __iter__(self):
+    return self
+
+  def __next__(self):
+    cdef shared_ptr[CRecordBatch] batch
+    cdef CStatus status
+    with nogil:
+      status = self.c_reader.get().ReadNext(&batch)
+    check_status(status)
+    if batch.get() == NULL:
+      raise StopIteration
+    return pyarrow_wrap_batch(batch)
+
+# Read-only view of a result set column exposed through the buffer protocol.
+# The view holds the result set, so arrays built on top of it keep the result
+# alive.
+cdef class ResultSetColumnBuffer:
+  cdef shared_ptr[CResultSet] c_rows
+  cdef shared_ptr[CDataMgr] c_data_mgr
+  cdef const int8_t* data
+  cdef Py_ssize_t shape[1]
+  cdef Py_ssize_t strides[1]
+  cdef bytes format
+
+  def __getbuffer__(self, Py_buffer *buffer, int flags):
+    if flags & PyBUF_WRITABLE:
+      raise BufferError("Result set columns are read-only.")
+    buffer.buf = <void*>self.data
+    buffer.format = <char*>self.format
+    buffer.internal = NULL
+    buffer.itemsize = self.strides[0]
+    buffer.len = self.shape[0] * self.strides[0]
+    buffer.ndim = 1
+    buffer.obj = self
+    buffer.readonly = 1
+    buffer.shape = self.shape
+    buffer.strides = self.strides
+    buffer.suboffsets = NULL
+
+  def __releasebuffer__(self, Py_buffer *buffer):
+    pass
+
+# Result set column kept in GPU memory and exposed through the CUDA array
+# interface. The column holds the result set, so device arrays built on top of
+# it keep the result alive.
+cdef class ResultSetDeviceColumn:
+  cdef shared_ptr[CResultSet] c_rows
+  cdef shared_ptr[CDataMgr] c_data_mgr
+  cdef const int8_t* data
+  cdef size_t length
+  cdef str typestr
+  cdef int c_device_id
+
+  @property
+  def device_id(self):
+    return self.c_device_id
+
+  @property
+  def __cuda_array_interface__(self):
+    return {
+      "shape": (self.length,),
+      "typestr": self.typestr,
+      "data": (<uintptr_t>self.data, True),
+      "strides": None,
+      "version": 3,
+    }
+
+cdef zero_copy_numpy_dtype(const CType *c_type):
+  if c_type.isInteger() or c_type.isFloatingPoint():
+    if c_type.isInt8():
+      return numpy.int8
+    if c_type.isInt16():
+      return numpy.int16
+    if c_type.isInt32():
+      return numpy.int32
+    if c_type.isInt64():
+      return numpy.int64
+    if c_type.isFp32():
+      return numpy.float32
+    if c_type.isFp64():
+      return numpy.float64
+  return None
+
 cdef class ExecutionResult:
   def row_count(self):
     cdef shared_ptr[CResultSet] c_res
     c_res = self.c_result.getRows()
     return int(c_res.get().rowCount())
 
+  def profile(self):
+    """
+    Return the execution profile of the query or None if the query was run
+    without the `enable_profile` option.
+
+    The profile is a dictionary with the total time and a list of query
+    steps. Each step has its compilation, hash table build and reduction
+    times, input and output row counts and a list of kernels with the device,
+    processed fragments, fetch and execution times and row counts. Times
+    are in milliseconds. Compilation time includes hash table builds.
+    """
+    cdef shared_ptr[CQueryProfile] c_profile = self.c_result.getProfile()
+    if c_profile.get() == NULL:
+      return None
+    cdef vector[CStepProfile] c_steps = c_profile.get().steps()
+    steps = []
+    for c_step in c_steps:
+      kernels = []
+      for c_kernel in c_step.kernels:
+        kernels.append({
+          "device_type": "GPU" if c_kernel.device_type == CExecutorDeviceType.GPU else "CPU",
+          "device_id": c_kernel.device_id,
+          "fragment_ids": list(c_kernel.fragment_ids),
+          "fetch_time": c_kernel.fetch_time / 1000.0,
+          "execution_time": c_kernel.execution_time / 1000.0,
+          "input_rows": c_kernel.input_rows,
+          "output_rows": c_kernel.output_rows,
+        })
+      steps.append({
+        "node_id": c_step.node_id,
+        "node": c_step.node_name.decode("utf-8"),
+        "total_time": c_step.total_time / 1000.0,
+        "compilation_time": c_step.compilation_time / 1000.0,
+        "hash_table_build_time": c_step.hash_table_build_time / 1000.0,
+        "reduction_time": c_step.reduction_time / 1000.0,
+        "input_rows": c_step.input_rows,
+        "output_rows": c_step.output_rows,
+        "kernels": kernels,
+      })
+    return {"total_time": c_profile.get().totalTime() / 1000.0, "steps": steps}
+
+  def explain_analyze(self):
+    """
+    Return the execution profile of the query as text, one block per query
+    step, or None if the query was run without the `enable_profile` option.
+    """
+    cdef shared_ptr[CQueryProfile] c_profile = self.c_result.getProfile()
+    if c_profile.get() == NULL:
+      return None
+    return c_profile.get().toString().decode("utf-8")
+
   def to_arrow(self):
     cdef vector[string] col_names
     cdef vector[CTargetMetaInfo].const_iterator it = self.c_result.getTargetsMeta().const_begin()
@@ -87,9 +250,171 @@ cdef class ExecutionResult:
       preincrement(it)
 
     cdef unique_ptr[CArrowResultSetConverter] converter = make_unique[CArrowResultSetConverter](self.c_result.getRows(), col_names, -1)
-    cdef shared_ptr[CArrowTable] at = converter.get().convertToArrowTable()
+    cdef shared_ptr[CArrowTable] at
+    with nogil:
+      at = converter.get().convertToArrowTable()
     return pyarrow_wrap_table(at)
 
+  def to_arrow_batches(self, size_t batch_size=1000000):
+    cdef vector[string] col_names
+    cdef vector[CTargetMetaInfo].const_iterator it = self.c_result.getTargetsMeta().const_begin()
+
+    while it != self.c_result.getTargetsMeta().const_end():
+      col_names.push_back(dereference(it).get_resname())
+      preincrement(it)
+
+    cdef unique_ptr[CArrowResultSetConverter] converter = make_unique[CArrowResultSetConverter](self.c_result.getRows(), col_names, -1)
+    cdef shared_ptr[CRecordBatchReader] reader
+    with nogil:
+      reader = converter.get().convertToArrowBatchReader(batch_size)
+    batches = ArrowBatchIterator()
+    batches.c_reader = reader
+    batches._result = self
+    schema = pyarrow_wrap_schema(batches.c_reader.get().schema())
+    return pyarrow.RecordBatchReader.from_batches(schema, batches)
+
+  def to_parquet(self, file_name, size_t batch_size=1000000):
+    """
+    Write the result to a Parquet file with a row group per batch of
+    up to batch_size rows. Batches are converted while previous ones
+    are written, so the whole result is never converted at once.
+    """
+    cdef vector[string] col_names
+    cdef vector[CTargetMetaInfo].const_iterator it = self.c_result.getTargetsMeta().const_begin()
+
+    while it != self.c_result.getTargetsMeta().const_end():
+      col_names.push_back(dereference(it).get_resname())
+      preincrement(it)
+
+    cdef unique_ptr[CArrowResultSetConverter] converter = make_unique[CArrowResultSetConverter](self.c_result.getRows(), col_names, -1)
+    cdef string c_file_name = file_name
+    with nogil:
+      converter.get().exportToParquet(c_file_name, batch_size)
+
+  def to_arrow_ipc(self, file_name, size_t batch_size=1000000):
+    """
+    Write the result to an Arrow IPC file by batches of up to batch_size
+    rows.
+    """
+    cdef vector[string] col_names
+    cdef vector[CTargetMetaInfo].const_iterator it = self.c_result.getTargetsMeta().const_begin()
+
+    while it != self.c_result.getTargetsMeta().const_end():
+      col_names.push_back(dereference(it).get_resname())
+      preincrement(it)
+
+    cdef unique_ptr[CArrowResultSetConverter] converter = make_unique[CArrowResultSetConverter](self.c_result.getRows(), col_names, -1)
+    cdef string c_file_name = file_name
+    with nogil:
+      converter.get().exportToArrowIpc(c_file_name, batch_size)
+
+  def to_numpy(self):
+    """
+    Return a dictionary of NumPy arrays, one per column.
+
+    Numeric columns of columnar projections reference the result set
+    memory without copies and keep the result alive. Nulls in such
+    columns are masked. Other columns are converted through Arrow.
+    """
+    cdef shared_ptr[CResultSet] c_rows = self.c_result.getRows()
+    cdef const CType *c_type
+    cdef ResultSetColumnBuffer buffer
+    cdef size_t col_idx = 0
+    cdef size_t row_count = c_rows.get().rowCount()
+    res = {}
+    at = None
+
+    while col_idx < self.c_result.getTargetsMeta().size():
+      name = self.c_result.getTargetsMeta().at(col_idx).get_resname().decode("utf-8")
+      c_type = c_rows.get().colType(col_idx)
+      dtype = zero_copy_numpy_dtype(c_type)
+      if (
+        dtype is not None
+        and not c_rows.get().isTruncated()
+        and c_rows.get().isZeroCopyColumnarConversionPossible(col_idx)
+      ):
+        buffer = ResultSetColumnBuffer()
+        buffer.c_rows = c_rows
+        buffer.c_data_mgr = self.c_data_mgr
+        buffer.data = c_rows.get().getColumnarBuffer(col_idx)
+        buffer.shape[0] = row_count
+        buffer.strides[0] = c_type.size()
+        buffer.format = numpy.dtype(dtype).char.encode("ascii")
+        arr = numpy.asarray(buffer)
+        if c_type.nullable():
+          if numpy.issubdtype(dtype, numpy.integer):
+            null_val = numpy.iinfo(dtype).min
+          else:
+            null_val = numpy.finfo(dtype).tiny
+          mask = arr == null_val
+          if mask.any():
+            arr = numpy.ma.MaskedArray(arr, mask=mask)
+        res[name] = arr
+      else:
+        if at is None:
+          at = self.to_arrow()
+        col = at.column(col_idx)
+        if pyarrow.types.is_dictionary(col.type):
+          col = col.cast(col.type.value_type)
+        res[name] = col.to_numpy()
+      col_idx += 1
+
+    return res
+
+  def to_cuda_arrays(self):
+    """
+    Return a dictionary of columns exposing `__cuda_array_interface__`, one per
+    column, with no copies to host.
+
+    Only numeric columns of columnar projections executed on GPU with
+    the `keep_gpu_results` option are kept in device memory. Nulls are stored
+    as the minimal integer or the smallest positive float value. Columns hold
+    the result alive, e.g. `cupy.asarray(col)` or `torch.as_tensor(col)` can
+    be used to wrap them.
+    """
+    cdef shared_ptr[CResultSet] c_rows = self.c_result.getRows()
+    cdef const CType *c_type
+    cdef const int8_t *data
+    cdef ResultSetDeviceColumn col
+    cdef size_t col_idx = 0
+    res = {}
+
+    while col_idx < self.c_result.getTargetsMeta().size():
+      name = self.c_result.getTargetsMeta().at(col_idx).get_resname().decode("utf-8")
+      c_type = c_rows.get().colType(col_idx)
+      dtype = zero_copy_numpy_dtype(c_type)
+      data = c_rows.get().getDeviceColumnarBuffer(col_idx)
+      if dtype is None or data == NULL:
+        raise RuntimeError(
+          f"Column '{name}' is not kept in GPU memory. Use a columnar GPU "
+          "projection with enabled keep_gpu_results option."
+        )
+      col = ResultSetDeviceColumn()
+      col.c_rows = c_rows
+      col.c_data_mgr = self.c_data_mgr
+      col.data = data
+      col.length = c_rows.get().rowCount()
+      col.typestr = numpy.dtype(dtype).str
+      col.c_device_id = c_rows.get().getDeviceId()
+      res[name] = col
+      col_idx += 1
+
+    return res
+
+  def to_pandas(self):
+    """
+    Return the result as a pandas DataFrame.
+
+    Numeric columns without nulls are passed to pandas as views of the
+    result set memory, see `to_numpy`.
+    """
+    import pandas
+
+    return pandas.DataFrame(
+      {key: pandas.Series(val, copy=False) for key, val in self.to_numpy().items()},
+      copy=False,
+    )
+
   def to_explain_str(self):
     return self.c_result.getExplanation()
 
@@ -155,6 +480,16 @@ cdef class ExecutionResult:
       res._scan = self._scan.hdk.scan(res.table_name)
     return res
 
+  def sample(self, n, seed=None):
+    if seed is None:
+      seed = random.getrandbits(64)
+    res = ExecutionResult()
+    res.c_result = self.c_result.sample(n, seed)
+    res.c_data_mgr = self.c_data_mgr
+    if self._scan is not None:
+      res._scan = self._scan.hdk.scan(res.table_name)
+    return res
+
   def __str__(self):
     res = "Schema:\n"
     for key, type_str in self.schema.items():
@@ -173,11 +508,12 @@ cdef class ExecutionResult:
     return self._scan.__getitem__(col)
 
 cdef class RelAlgExecutor:
-  def __cinit__(self, Executor executor, SchemaProvider schema_provider, DataMgr data_mgr, ra_json=None, QueryDag dag=None):
+  def __cinit__(self, Executor executor, SchemaProvider schema_provider, DataMgr data_mgr, ra_json=None, QueryDag dag=None, params=None):
     cdef CExecutor* c_executor = executor.c_executor.get()
     cdef CSchemaProviderPtr c_schema_provider = schema_provider.c_schema_provider
     cdef unique_ptr[CQueryDag] c_dag
     cdef int db_id = 0
+    cdef vector[string] c_params = params if params is not None else []
 
     # Choose the default database ID. Ignore ResultSetRegistry.
     db_ids = schema_provider.listDatabases()
@@ -188,7 +524,7 @@ cdef class RelAlgExecutor:
       db_id = db_ids[1] if db_ids[0] == ((100 << 24) + 1) else db_ids[0]
 
     if ra_json is not None:
-      c_dag.reset(new CRelAlgDagBuilder(ra_json, db_id, c_schema_provider, c_executor.getConfigPtr()))
+      c_dag.reset(new CRelAlgDagBuilder(ra_json, db_id, c_schema_provider, c_executor.getConfigPtr(), c_params))
     else:
       assert dag is not None
       c_dag = move(dag.c_dag)
@@ -196,7 +532,7 @@ cdef class RelAlgExecutor:
     self.c_rel_alg_executor = make_shared[CRelAlgExecutor](c_executor, c_schema_provider, move(c_dag))
     self.c_data_mgr = data_mgr.c_data_mgr
 
-  def execute(self, **kwargs):
+  cdef CCompilationOptions _compilation_options(self, kwargs):
     cdef const CConfig *config = self.c_rel_alg_executor.get().getExecutor().getConfigPtr().get()
     cdef CCompilationOptions c_co
     if kwargs.get("device_type", "auto") == "GPU" and not config.exec.cpu_only:
@@ -205,13 +541,74 @@ cdef class RelAlgExecutor:
       c_co = CCompilationOptions.defaults(CExecutorDeviceType.CPU, False)
     c_co.allow_lazy_fetch = kwargs.get("enable_lazy_fetch", config.rs.enable_lazy_fetch)
     c_co.with_dynamic_watchdog = kwargs.get("enable_dynamic_watchdog", config.exec.watchdog.enable_dynamic)
+    return c_co
+
+  cdef unique_ptr[CExecutionOptions] _execution_options(self, kwargs):
+    cdef const CConfig *config = self.c_rel_alg_executor.get().getExecutor().getConfigPtr().get()
     cdef unique_ptr[CExecutionOptions] c_eo = make_unique[CExecutionOptions](CExecutionOptions.fromConfig(dereference(config)))
     c_eo.get().output_columnar_hint = kwargs.get("enable_columnar_output", config.rs.enable_columnar_output)
     c_eo.get().with_watchdog = kwargs.get("enable_watchdog", config.exec.watchdog.enable)
     c_eo.get().with_dynamic_watchdog = kwargs.get("enable_dynamic_watchdog", config.exec.watchdog.enable_dynamic)
     c_eo.get().just_explain = kwargs.get("just_explain", False)
-    cdef CExecutionResult c_res = self.c_rel_alg_executor.get().executeRelAlgQuery(c_co, dereference(c_eo.get()), False)
+    c_eo.get().with_profile = kwargs.get("enable_profile", config.exec.enable_query_profile)
+    c_eo.get().outer_fragment_indices = kwargs.get("outer_fragment_indices", [])
+    c_eo.get().sample_rate = kwargs.get("sample_rate", 1.0)
+    c_eo.get().sample_seed = kwargs.get("sample_seed", 0)
+    return move(c_eo)
+
+  cdef ExecutionResult _wrap_result(self, CExecutionResult c_res):
     cdef ExecutionResult res = ExecutionResult()
     res.c_result = move(c_res)
     res.c_data_mgr = self.c_data_mgr
     return res
+
+  def execute(self, **kwargs):
+    cdef CCompilationOptions c_co = self._compilation_options(kwargs)
+    cdef unique_ptr[CExecutionOptions] c_eo = self._execution_options(kwargs)
+    # Queries release the GIL. Queries sharing an executor are still serialized
+    # by the executor.
+    cdef CRelAlgExecutor* c_rel_alg_executor = self.c_rel_alg_executor.get()
+    cdef CExecutionResult c_res
+    with nogil:
+      c_res = c_rel_alg_executor.executeRelAlgQuery(c_co, dereference(c_eo.get()), False)
+    return self._wrap_result(move(c_res))
+
+  def prepare_stream(self, **kwargs):
+    """
+    Compile the query to run it continuously on batches appended to the stream
+    table it reads. Return the name of the stream table.
+    """
+    cdef CCompilationOptions c_co = self._compilation_options(kwargs)
+    cdef unique_ptr[CExecutionOptions] c_eo = self._execution_options(kwargs)
+    cdef CRelAlgExecutor* c_rel_alg_executor = self.c_rel_alg_executor.get()
+    cdef CTableInfoPtr c_table_info
+    with nogil:
+      c_table_info = c_rel_alg_executor.prepareStreamExecution(c_co, dereference(c_eo.get()))
+    return c_table_info.get().name
+
+  def run_on_new_batches(self):
+    cdef CRelAlgExecutor* c_rel_alg_executor = self.c_rel_alg_executor.get()
+    with nogil:
+      c_rel_alg_executor.runOnNewBatches()
+
+  def poll_stream(self):
+    cdef CRelAlgExecutor* c_rel_alg_executor = self.c_rel_alg_executor.get()
+    cdef CExecutionResult c_res
+    with nogil:
+      c_res = c_rel_alg_executor.pollStreamExecution()
+    return self._wrap_result(move(c_res))
+
+  def finish_stream(self):
+    cdef CRelAlgExecutor* c_rel_alg_executor = self.c_rel_alg_executor.get()
+    cdef CExecutionResult c_res
+    with nogil:
+      c_res = c_rel_alg_executor.finishStreamExecution()
+    return self._wrap_result(move(c_res))
+
+  def interrupt(self):
+    """
+    Interrupt the query from another thread. A running query stops at the next
+    interrupt check, a query which didn't start yet doesn't start. In both cases
+    `execute` raises an error.
+    """
+    self.c_rel_alg_executor.get().interrupt()
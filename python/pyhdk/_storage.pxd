@@ -8,6 +8,7 @@ from libcpp.memory cimport shared_ptr, unique_ptr
 from libcpp.string cimport string
 from libcpp.vector cimport vector
 from libcpp.map cimport map
+from libc.stdint cimport uint64_t
 
 from pyarrow.lib cimport CTable as CArrowTable
 
@@ -110,6 +111,11 @@ cdef extern from "omniscidb/ArrowStorage/ArrowStorage.h" namespace "ArrowStorage
 
   struct CTableOptions "ArrowStorage::TableOptions":
     size_t fragment_size;
+    bool align_fragments_to_chunks;
+    size_t min_fragment_size;
+    bool streaming_append;
+    vector[string] cluster_keys;
+    bool is_stream;
 
     CTableOptions()
 
@@ -118,6 +124,8 @@ cdef extern from "omniscidb/ArrowStorage/ArrowStorage.h" namespace "ArrowStorage
     bool header;
     size_t skip_rows;
     size_t block_size;
+    bool streaming;
+    vector[string] timestamp_formats;
 
   struct CJsonParseOptions "ArrowStorage::JsonParseOptions":
     size_t skip_rows;
@@ -132,13 +140,24 @@ cdef extern from "omniscidb/ArrowStorage/ArrowStorage.h":
 
     CTableInfoPtr createTable(const string&, const vector[CColumnDescription]&, const CTableOptions&) except +
 
-    CTableInfoPtr importArrowTable(shared_ptr[CArrowTable], string&, CTableOptions&) except +;
-    void appendArrowTable(shared_ptr[CArrowTable], const string&) except +
-    CTableInfoPtr importCsvFile(string&, string&, CTableOptions&, CCsvParseOptions) except +
-    CTableInfoPtr importCsvFileWithSchema "importCsvFile"(string&, string&, const vector[CColumnDescription]&, CTableOptions&, CCsvParseOptions) except +
-    CTableInfoPtr appendCsvFile(string&, string&, CCsvParseOptions) except +
-    CTableInfoPtr importParquetFile(string&, string&, CTableOptions&) except +
-    CTableInfoPtr appendParquetFile(string&, string&) except +
+    CTableInfoPtr importArrowTable(shared_ptr[CArrowTable], string&, CTableOptions&) except + nogil
+    void appendArrowTable(shared_ptr[CArrowTable], const string&) except + nogil
+    CTableInfoPtr importCsvFile(string&, string&, CTableOptions&, CCsvParseOptions) except + nogil
+    CTableInfoPtr importCsvFileWithSchema "importCsvFile"(string&, string&, const vector[CColumnDescription]&, CTableOptions&, CCsvParseOptions) except + nogil
+    CTableInfoPtr appendCsvFile(string&, string&, CCsvParseOptions) except + nogil
+    CTableInfoPtr importJsonFile(string&, string&, const vector[CColumnDescription]&, CTableOptions&, CJsonParseOptions) except + nogil
+    void appendJsonFile(string&, string&, CJsonParseOptions) except + nogil
+    CTableInfoPtr importParquetFile(string&, string&, CTableOptions&) except + nogil
+    CTableInfoPtr appendParquetFile(string&, string&) except + nogil
+    CTableInfoPtr importArrowIpcFile(string&, string&, CTableOptions&) except + nogil
+    void appendArrowIpcFile(string&, string&) except + nogil
+    @staticmethod
+    size_t publishSharedGeneration(const string&, shared_ptr[CArrowTable]) except + nogil
+    CTableInfoPtr attachSharedTable(const string&, const string&, CTableOptions&) except + nogil
+    size_t refreshSharedTable(const string&) except + nogil
+    CTableInfoPtr registerParquetFile(string&, string&) except +
+    int importDictionary(const string&, const string&) except +
+    void exportDictionary(int, const string&, bool) except +
     void dropTable(const string&, bool) except +;
 
     int dbId() const
@@ -163,6 +182,21 @@ cdef extern from "omniscidb/DataMgr/PersistentStorageMgr/PersistentStorageMgr.h"
   cdef cppclass CPersistentStorageMgr "PersistentStorageMgr"(CAbstractBufferMgr):
     void registerDataProvider(int, shared_ptr[CAbstractBufferMgr]);
 
+cdef extern from "omniscidb/DataMgr/MemoryAccounting.h" namespace "Data_Namespace":
+  cdef cppclass CMemoryUsage "Data_Namespace::MemoryUsage":
+    size_t current
+    size_t peak
+
+  cdef cppclass CQueryMemoryStats "Data_Namespace::QueryMemoryStats":
+    uint64_t query_id
+    bool finished
+
+    const CMemoryUsage& get(MemoryLevel)
+
+  cdef cppclass CMemoryAccounting "Data_Namespace::MemoryAccounting":
+    vector[CQueryMemoryStats] getQueryStats()
+    CMemoryUsage getLevelUsage(MemoryLevel)
+
 cdef extern from "omniscidb/DataMgr/DataMgr.h" namespace "Data_Namespace":
   cdef cppclass CDataMgr "DataMgr":
     CDataMgr(const CConfig&, map[CGpuMgrPlatform, unique_ptr[CGpuMgr]]&& gpuMgrs, size_t reservedGpuMem, size_t numReaderThreads) except +;
@@ -170,6 +204,7 @@ cdef extern from "omniscidb/DataMgr/DataMgr.h" namespace "Data_Namespace":
     CPersistentStorageMgr* getPersistentStorageMgr() except +;
     CBufferProvider* getBufferProvider() except +;
     CDataProvider* getDataProvider() except +;
+    CMemoryAccounting* getMemoryAccounting();
 
 cdef class DataMgr:
   cdef shared_ptr[CDataMgr] c_data_mgr
@@ -195,6 +195,48 @@ cdef class TableOptions:
       raise TypeError("Only integer values are allowed for fragment_size.")
     self.c_options.fragment_size = value
 
+  @property
+  def align_fragments_to_chunks(self):
+    return self.c_options.align_fragments_to_chunks
+
+  @align_fragments_to_chunks.setter
+  def align_fragments_to_chunks(self, value):
+    self.c_options.align_fragments_to_chunks = bool(value)
+
+  @property
+  def min_fragment_size(self):
+    return self.c_options.min_fragment_size
+
+  @min_fragment_size.setter
+  def min_fragment_size(self, value):
+    if not isinstance(value, int):
+      raise TypeError("Only integer values are allowed for min_fragment_size.")
+    self.c_options.min_fragment_size = value
+
+  @property
+  def streaming_append(self):
+    return self.c_options.streaming_append
+
+  @streaming_append.setter
+  def streaming_append(self, value):
+    self.c_options.streaming_append = bool(value)
+
+  @property
+  def cluster_keys(self):
+    return [key.decode('utf8') for key in self.c_options.cluster_keys]
+
+  @cluster_keys.setter
+  def cluster_keys(self, value):
+    self.c_options.cluster_keys = [str(key).encode('utf8') for key in value]
+
+  @property
+  def is_stream(self):
+    return self.c_options.is_stream
+
+  @is_stream.setter
+  def is_stream(self, value):
+    self.c_options.is_stream = bool(value)
+
 cdef class CsvParseOptions:
   cdef CCsvParseOptions c_options
 
@@ -235,6 +277,36 @@ cdef class CsvParseOptions:
   def block_size(self, value):
     self.c_options.block_size = value
 
+  @property
+  def streaming(self):
+    return self.c_options.streaming
+
+  @streaming.setter
+  def streaming(self, value):
+    self.c_options.streaming = value
+
+  @property
+  def timestamp_formats(self):
+    return [fmt.decode('utf8') for fmt in self.c_options.timestamp_formats]
+
+  @timestamp_formats.setter
+  def timestamp_formats(self, value):
+    self.c_options.timestamp_formats = [str(fmt).encode('utf8') for fmt in value]
+
+cdef class JsonParseOptions:
+  cdef CJsonParseOptions c_options
+
+  def __cinit__(self):
+    self.c_options = CJsonParseOptions()
+
+  @property
+  def block_size(self):
+    return self.c_options.block_size
+
+  @block_size.setter
+  def block_size(self, value):
+    self.c_options.block_size = value
+
 cdef class ArrowStorage(Storage):
   cdef shared_ptr[CArrowStorage] c_storage
 
@@ -284,20 +356,23 @@ cdef class ArrowStorage(Storage):
     else:
       raise TypeError(f"Expected TypeInfo or str for column type. Got: {type(val)}.")
 
+  # Long-running imports release the GIL, so tables can be imported from
+  # multiple Python threads concurrently.
   def importArrowTable(self, table, name, TableOptions options):
     cdef shared_ptr[CArrowTable] at = pyarrow_unwrap_table(table)
-    self.c_storage.get().importArrowTable(at, name, options.c_options)
+    cdef string c_name = name
+    cdef CArrowStorage* c_storage = self.c_storage.get()
+    with nogil:
+      c_storage.importArrowTable(at, c_name, options.c_options)
 
   def appendArrowTable(self, table, name):
     cdef shared_ptr[CArrowTable] at = pyarrow_unwrap_table(table)
-    self.c_storage.get().appendArrowTable(at, name)
-
-  def importCsvFile(self, file_name, table_name, schema = None, TableOptions table_opts = None, CsvParseOptions csv_opts = None):
-    if table_opts is None:
-      table_opts = TableOptions()
-    if csv_opts is None:
-      csv_opts = CsvParseOptions()
+    cdef string c_name = name
+    cdef CArrowStorage* c_storage = self.c_storage.get()
+    with nogil:
+      c_storage.appendArrowTable(at, c_name)
 
+  cdef vector[CColumnDescription] _process_import_schema(self, schema):
     cdef vector[CColumnDescription] c_schema
     cdef CColumnDescription col_desc
 
@@ -317,41 +392,147 @@ cdef class ArrowStorage(Storage):
 
       c_schema.push_back(col_desc)
 
-    if schema is None:
-      self.c_storage.get().importCsvFile(file_name, table_name, table_opts.c_options, csv_opts.c_options)
-    else:
-      if isinstance(schema, dict):
-        for col_name, col_type in schema.items():
-          process_col_type(col_name, col_type)
-      elif isinstance(schema, Iterable):
-        for col_info in schema:
-          if isinstance(col_info, str):
-            process_col_type(col_info, None)
-          elif isinstance(col_info, tuple):
-            if len(col_info) == 1:
-              process_col_type(col_info[0], None)
-            elif len(col_info) == 2:
-              process_col_type(col_info[0], col_info[1])
-            else:
-              raise TypeError(f"Expected tuple length for a column descriptor is 1 or 2. Got: {len(col_info)}.")
+    if isinstance(schema, dict):
+      for col_name, col_type in schema.items():
+        process_col_type(col_name, col_type)
+    elif isinstance(schema, Iterable):
+      for col_info in schema:
+        if isinstance(col_info, str):
+          process_col_type(col_info, None)
+        elif isinstance(col_info, tuple):
+          if len(col_info) == 1:
+            process_col_type(col_info[0], None)
+          elif len(col_info) == 2:
+            process_col_type(col_info[0], col_info[1])
           else:
-            raise TypeError(f"Expected str or tuple for a column descriptor. Got: {type(col_info)}.")
+            raise TypeError(f"Expected tuple length for a column descriptor is 1 or 2. Got: {len(col_info)}.")
+        else:
+          raise TypeError(f"Expected str or tuple for a column descriptor. Got: {type(col_info)}.")
+
+    return c_schema
 
-      self.c_storage.get().importCsvFileWithSchema(file_name, table_name, c_schema, table_opts.c_options, csv_opts.c_options)
+  def importCsvFile(self, file_name, table_name, schema = None, TableOptions table_opts = None, CsvParseOptions csv_opts = None):
+    if table_opts is None:
+      table_opts = TableOptions()
+    if csv_opts is None:
+      csv_opts = CsvParseOptions()
+
+    cdef vector[CColumnDescription] c_schema
+    cdef string c_file_name = file_name
+    cdef string c_table_name = table_name
+    cdef CArrowStorage* c_storage = self.c_storage.get()
+
+    if schema is None:
+      with nogil:
+        c_storage.importCsvFile(c_file_name, c_table_name, table_opts.c_options, csv_opts.c_options)
+    else:
+      c_schema = self._process_import_schema(schema)
+      with nogil:
+        c_storage.importCsvFileWithSchema(c_file_name, c_table_name, c_schema, table_opts.c_options, csv_opts.c_options)
 
   def appendCsvFile(self, file_name, table_name, CsvParseOptions csv_opts = None):
     if csv_opts is None:
       csv_opts = CsvParseOptions()
-    self.c_storage.get().appendCsvFile(file_name, table_name, csv_opts.c_options)
+    cdef string c_file_name = file_name
+    cdef string c_table_name = table_name
+    cdef CArrowStorage* c_storage = self.c_storage.get()
+    with nogil:
+      c_storage.appendCsvFile(c_file_name, c_table_name, csv_opts.c_options)
+
+  def importJsonFile(self, file_name, table_name, schema = None, TableOptions table_opts = None, JsonParseOptions json_opts = None):
+    if table_opts is None:
+      table_opts = TableOptions()
+    if json_opts is None:
+      json_opts = JsonParseOptions()
+
+    cdef vector[CColumnDescription] c_schema
+    cdef string c_file_name = file_name
+    cdef string c_table_name = table_name
+    cdef CArrowStorage* c_storage = self.c_storage.get()
+
+    if schema is not None:
+      c_schema = self._process_import_schema(schema)
+    with nogil:
+      c_storage.importJsonFile(c_file_name, c_table_name, c_schema, table_opts.c_options, json_opts.c_options)
+
+  def appendJsonFile(self, file_name, table_name, JsonParseOptions json_opts = None):
+    if json_opts is None:
+      json_opts = JsonParseOptions()
+    cdef string c_file_name = file_name
+    cdef string c_table_name = table_name
+    cdef CArrowStorage* c_storage = self.c_storage.get()
+    with nogil:
+      c_storage.appendJsonFile(c_file_name, c_table_name, json_opts.c_options)
 
   def importParquetFile(self, file_name, table_name, TableOptions table_opts = None):
     if table_opts is None:
       table_opts = TableOptions()
 
-    self.c_storage.get().importParquetFile(file_name, table_name, table_opts.c_options)
+    cdef string c_file_name = file_name
+    cdef string c_table_name = table_name
+    cdef CArrowStorage* c_storage = self.c_storage.get()
+    with nogil:
+      c_storage.importParquetFile(c_file_name, c_table_name, table_opts.c_options)
 
   def appendParquetFile(self, file_name, table_name):
-    self.c_storage.get().appendParquetFile(file_name, table_name)
+    cdef string c_file_name = file_name
+    cdef string c_table_name = table_name
+    cdef CArrowStorage* c_storage = self.c_storage.get()
+    with nogil:
+      c_storage.appendParquetFile(c_file_name, c_table_name)
+
+  def importArrowIpcFile(self, file_name, table_name, TableOptions table_opts = None):
+    if table_opts is None:
+      table_opts = TableOptions()
+
+    cdef string c_file_name = file_name
+    cdef string c_table_name = table_name
+    cdef CArrowStorage* c_storage = self.c_storage.get()
+    with nogil:
+      c_storage.importArrowIpcFile(c_file_name, c_table_name, table_opts.c_options)
+
+  def appendArrowIpcFile(self, file_name, table_name):
+    cdef string c_file_name = file_name
+    cdef string c_table_name = table_name
+    cdef CArrowStorage* c_storage = self.c_storage.get()
+    with nogil:
+      c_storage.appendArrowIpcFile(c_file_name, c_table_name)
+
+  @staticmethod
+  def publishSharedGeneration(segment_dir, table):
+    cdef shared_ptr[CArrowTable] at = pyarrow_unwrap_table(table)
+    cdef string c_segment_dir = segment_dir
+    cdef size_t res
+    with nogil:
+      res = CArrowStorage.publishSharedGeneration(c_segment_dir, at)
+    return res
+
+  def attachSharedTable(self, segment_dir, table_name, TableOptions table_opts = None):
+    if table_opts is None:
+      table_opts = TableOptions()
+
+    cdef string c_segment_dir = segment_dir
+    cdef string c_table_name = table_name
+    cdef CArrowStorage* c_storage = self.c_storage.get()
+    with nogil:
+      c_storage.attachSharedTable(c_segment_dir, c_table_name, table_opts.c_options)
+
+  def refreshSharedTable(self, table_name):
+    cdef string c_table_name = table_name
+    cdef CArrowStorage* c_storage = self.c_storage.get()
+    cdef size_t res
+    with nogil:
+      res = c_storage.refreshSharedTable(c_table_name)
+    return res
+
+  def registerParquetFile(self, file_name, table_name):
+    self.c_storage.get().registerParquetFile(file_name, table_name)
+
+  def importDictionary(self, string file_name, string name):
+    return self.c_storage.get().importDictionary(file_name, name)
+
+  def exportDictionary(self, int dict_id, string file_name, bool front_coded = False):
+    self.c_storage.get().exportDictionary(dict_id, file_name, front_coded)
 
   def dropTable(self, string name, bool throw_if_not_exist = False):
     self.c_storage.get().dropTable(name, throw_if_not_exist)
@@ -367,3 +548,24 @@ cdef class DataMgr:
     cdef schema_id = storage.getId()
     cdef shared_ptr[CAbstractBufferMgr] buffer_mgr = storage.c_abstract_buffer_mgr
     self.c_data_mgr.get().getPersistentStorageMgr().registerDataProvider(schema_id, buffer_mgr)
+
+  def memoryUsage(self):
+    cdef CMemoryAccounting* accounting = self.c_data_mgr.get().getMemoryAccounting()
+    cdef CMemoryUsage cpu_usage = accounting.getLevelUsage(CPU_LEVEL)
+    cdef CMemoryUsage gpu_usage = accounting.getLevelUsage(GPU_LEVEL)
+    return {
+      "cpu": {"current": cpu_usage.current, "peak": cpu_usage.peak},
+      "gpu": {"current": gpu_usage.current, "peak": gpu_usage.peak},
+    }
+
+  def queryMemoryStats(self):
+    cdef vector[CQueryMemoryStats] stats = self.c_data_mgr.get().getMemoryAccounting().getQueryStats()
+    res = []
+    for query_stats in stats:
+      res.append({
+        "query_id": query_stats.query_id,
+        "finished": query_stats.finished,
+        "cpu": {"current": query_stats.get(CPU_LEVEL).current, "peak": query_stats.get(CPU_LEVEL).peak},
+        "gpu": {"current": query_stats.get(GPU_LEVEL).current, "peak": query_stats.get(GPU_LEVEL).peak},
+      })
+    return res
@@ -15,6 +15,8 @@ from pyhdk._sql import Calcite, RelAlgExecutor, ExecutionResult
 from pyhdk._execute import Executor, ResultSetRegistry
 from pyhdk._builder import QueryBuilder, QueryExpr, QueryNode
 
+import asyncio
+import json
 import pyarrow
 import uuid
 from collections.abc import Iterable
@@ -1555,6 +1557,67 @@ class QueryNodeAPI:
         """
         pass
 
+    def head(self, n, **kwargs):
+        """
+        Run query with the current node as a query root node and return its first
+        rows. Execution stops reading input fragments once n rows are collected.
+
+        Parameters
+        ----------
+        n : int
+            Number of rows to return.
+        **kwargs : dict
+            Execution options passed to run.
+
+        Returns
+        -------
+        ExecutionResult
+            The first rows of the query result.
+
+        Examples
+        --------
+        >>> hdk = pyhdk.init()
+        >>> ht = hdk.import_pydict({"a": [1, 2, 3], "b": [3, 2, 1]})
+        >>> ht.head(2)
+        Schema:
+        a: INT64
+        b: INT64
+        Data:
+        1|3
+        2|2
+        """
+        pass
+
+    def sample(self, n, seed=None, **kwargs):
+        """
+        Run query with the current node as a query root node and return a random
+        sample of its rows. For scans, only randomly chosen fragments are read and
+        the sample is made of contiguous row ranges of them.
+
+        Parameters
+        ----------
+        n : int
+            Number of rows to return. Less rows are returned if chosen fragments hold
+            less than n rows.
+        seed : int, default: None
+            Seed for the random choice. A random seed is used if None.
+        **kwargs : dict
+            Execution options passed to run.
+
+        Returns
+        -------
+        ExecutionResult
+            Sampled rows.
+
+        Examples
+        --------
+        >>> hdk = pyhdk.init()
+        >>> ht = hdk.import_pydict({"a": [1, 2, 3, 4]}, fragment_size=2)
+        >>> ht.sample(2, seed=1).row_count()
+        2
+        """
+        pass
+
 
 class QueryOptions:
     def __init__(self, config):
@@ -1639,6 +1702,42 @@ class QueryOptions:
             )
         self._opts["just_explain"] = value
 
+    @property
+    def enable_profile(self):
+        return self._opts.get("enable_profile", self._config.exec.enable_query_profile)
+
+    @enable_profile.setter
+    def enable_profile(self, value):
+        if type(value) != type(True):
+            raise TypeError(
+                f"Expected bool value for 'enable_profile' option. Got: {type(value)}."
+            )
+        self._opts["enable_profile"] = value
+
+    @property
+    def sample_rate(self):
+        return self._opts.get("sample_rate", 1.0)
+
+    @sample_rate.setter
+    def sample_rate(self, value):
+        if not isinstance(value, (int, float)) or not 0 < value <= 1:
+            raise ValueError(
+                f"Expected a number in (0, 1] for 'sample_rate' option. Got: {value}."
+            )
+        self._opts["sample_rate"] = float(value)
+
+    @property
+    def sample_seed(self):
+        return self._opts.get("sample_seed", 0)
+
+    @sample_seed.setter
+    def sample_seed(self, value):
+        if type(value) != type(0) or value < 0:
+            raise ValueError(
+                f"Expected non-negative int for 'sample_seed' option. Got: {value}."
+            )
+        self._opts["sample_seed"] = value
+
     @property
     def device_type(self):
         return self._opts.get("device_type", "auto")
@@ -1652,10 +1751,195 @@ class QueryOptions:
         self._opts["device_type"] = value
 
 
+class PreparedQuery:
+    """
+    SQL query parsed and optimized once to be executed multiple times.
+
+    Created by `HDK.prepare`.
+    """
+
+    def __init__(self, hdk, ra):
+        self._hdk = hdk
+        self._ra = ra
+
+    def execute(self, *params, query_opts=None):
+        """
+        Execute the query with the given values of its parameters.
+
+        Parameters
+        ----------
+        *params : list
+            Values for '?' parameter markers of the query in their order.
+            Values are passed in their string representation, NULL values
+            are not supported.
+        query_opts : QueryOptions or dict, default: None
+            Query execution options.
+
+        Returns
+        -------
+        ExecutionResult
+            The result of query execution.
+        """
+        return self._hdk._execute_ra(
+            self._ra, query_opts, [_param_to_str(param) for param in params]
+        )
+
+
+class ContinuousQuery:
+    """
+    Query compiled once and run on batches appended to a stream table.
+
+    Created by `HDK.continuous_query`. Aggregations keep partial aggregates of
+    processed batches between polls, projections return rows of new batches.
+    """
+
+    def __init__(self, hdk, ra_executor, table_name):
+        self._hdk = hdk
+        self._ra_executor = ra_executor
+        self._table_name = table_name
+
+    @property
+    def table_name(self):
+        """
+        Name of the stream table read by the query.
+        """
+        return self._table_name
+
+    def push(self, batch):
+        """
+        Append a batch to the stream table and run the query on it.
+
+        Parameters
+        ----------
+        batch : pyarrow.Table or pyarrow.RecordBatch
+            Data to append. Its schema should match the stream table schema.
+        """
+        if isinstance(batch, pyarrow.RecordBatch):
+            batch = pyarrow.Table.from_batches([batch])
+        self._hdk._storage.appendArrowTable(batch, self._table_name)
+        self.update()
+
+    def update(self):
+        """
+        Run the query on batches appended to the stream table since the previous
+        update, e.g. by other queries reading the same table.
+        """
+        self._ra_executor.run_on_new_batches()
+
+    def poll(self):
+        """
+        Get the current result of the query.
+
+        Returns
+        -------
+        ExecutionResult
+            Aggregate of all pushed batches for aggregations, rows of batches
+            pushed since the previous poll for projections.
+        """
+        res = self._ra_executor.poll_stream()
+        res.scan = self._hdk.scan(res.table_name)
+        return res
+
+    def finish(self):
+        """
+        Get the final result of the query and release its state. The query
+        cannot be used after this call.
+
+        Returns
+        -------
+        ExecutionResult
+            Same as for `poll`.
+        """
+        res = self._ra_executor.finish_stream()
+        res.scan = self._hdk.scan(res.table_name)
+        return res
+
+
+def _param_to_str(param):
+    if param is None:
+        raise ValueError("NULL values of query parameters are not supported.")
+    if isinstance(param, bool):
+        return "true" if param else "false"
+    return str(param)
+
+
+# Numba types supported in runtime UDF signatures mapped to their names in the
+# extension functions whitelist, which are LLVM IR type names as well.
+_UDF_TYPES = {
+    "int8": "i8",
+    "int16": "i16",
+    "int32": "i32",
+    "int64": "i64",
+    "float32": "float",
+    "float64": "double",
+}
+
+
+def _udf_type(numba_type):
+    res = _UDF_TYPES.get(str(numba_type))
+    if res is None:
+        raise TypeError(f"Unsupported type in runtime UDF signature: {numba_type}.")
+    return res
+
+
+def _row_udf_ir(numba, func, args, ret, symbol):
+    # Numba names the C wrapper after the Python function, so add a function with
+    # the name registered in the whitelist forwarding to the wrapper.
+    cfunc = numba.cfunc(ret(*args), error_model="numpy")(func)
+    ret_type = _udf_type(ret)
+    params = ", ".join(f"{_udf_type(arg)} %a{i}" for i, arg in enumerate(args))
+    return (
+        f"{cfunc.inspect_llvm()}\n"
+        f'define {ret_type} @"{symbol}"({params}) {{\n'
+        f'  %res = call {ret_type} @"{cfunc.native_name}"({params})\n'
+        f"  ret {ret_type} %res\n"
+        "}\n"
+    )
+
+
+def _batch_udf_ir(numba, func, args, ret, symbol):
+    # Batch functions get an array of column pointers, the number of rows and
+    # the output buffer (see ExtensionFunctionsBatch.h). Generate a loop calling
+    # the row function over them.
+    names = [f"arg{i}" for i in range(len(args))]
+    lines = ["def batch_udf(cols, num_rows, out):"]
+    lines += [
+        f"    {name} = carray(cols[{i}], num_rows, dtype=arg_type{i})"
+        for i, name in enumerate(names)
+    ]
+    lines += [
+        "    res = carray(out, num_rows, dtype=ret_type)",
+        "    for row in range(num_rows):",
+        f"        res[row] = row_func({', '.join(f'{name}[row]' for name in names)})",
+    ]
+    scope = {
+        "carray": numba.carray,
+        "row_func": numba.njit(ret(*args), error_model="numpy")(func),
+        "ret_type": ret,
+    }
+    scope.update({f"arg_type{i}": arg for i, arg in enumerate(args)})
+    exec("\n".join(lines), scope)
+
+    types = numba.types
+    cfunc = numba.cfunc(
+        types.void(types.CPointer(types.voidptr), types.int64, types.voidptr),
+        error_model="numpy",
+    )(scope["batch_udf"])
+    params = "i8** %cols, i64 %num_rows, i8* %out"
+    return (
+        f"{cfunc.inspect_llvm()}\n"
+        f'define void @"{symbol}"({params}) {{\n'
+        f'  call void @"{cfunc.native_name}"({params})\n'
+        "  ret void\n"
+        "}\n"
+    )
+
+
 class HDK:
     def __init__(self, **kwargs):
         if "debug_logs" in kwargs:
             initLogger(debug_logs=kwargs.pop("debug_logs"))
+        self._enable_native_sql_parser = kwargs.get("enable_native_sql_parser", False)
         self._config = buildConfig(**kwargs)
         self._storage = ArrowStorage(1)
         rs_registry = ResultSetRegistry(self._config)
@@ -1665,11 +1949,14 @@ class HDK:
         self._schema_mgr = SchemaMgr()
         self._schema_mgr.registerProvider(self._storage)
         self._schema_mgr.registerProvider(rs_registry)
-        self._calcite = Calcite(self._schema_mgr, self._config)
+        # Calcite starts JVM, so it is created on the first SQL query.
+        self._calcite = None
         self._executor = Executor(self._data_mgr, self._config)
         self._builder = QueryBuilder(self._schema_mgr, self._config, self)
+        # Registered runtime UDFs: whitelist signatures and LLVM IR by SQL name.
+        self._udfs = {}
 
-    def create_table(self, table_name, schema, fragment_size=None):
+    def create_table(self, table_name, schema, fragment_size=None, stream=False):
         """
         Create an empty table in HDK in-memory storage. Data can be appended to
         existing tables using data import methods.
@@ -1686,6 +1973,9 @@ class HDK:
             Number of rows in each table fragment. Total fragments count in a
             table may affect table processing parallelism level and performance.
             If not set, then fragment size is chosen automatically.
+        stream : bool, default: False
+            Create a stream table to be read by continuous queries. Appended
+            data never modifies existing fragments of a stream table.
 
         Returns
         -------
@@ -1705,6 +1995,7 @@ class HDK:
         opts = TableOptions()
         if fragment_size is not None:
             opts.fragment_size = fragment_size
+        opts.is_stream = stream
         self._storage.createTable(table_name, schema, opts)
         return self.scan(table_name)
 
@@ -1992,6 +2283,43 @@ class HDK:
             fragment_size=fragment_size,
         )
 
+    def import_pandas(self, df, table_name=None, fragment_size=None):
+        """
+        Import pandas DataFrame into HDK in-memory storage.
+
+        Numeric columns without nulls are passed to the storage without
+        copies. The DataFrame index is not imported.
+
+        Parameters
+        ----------
+        df : pandas.DataFrame
+            DataFrame to import.
+        table_name : str, default: None
+            Destination table name. If not specified, then unique table name is
+            generated and used. If table with specified name already exists,
+            then imported data is appended to the existing table.
+        fragment_size : int, default: None
+            Number of rows in each table fragment. Total fragments count in a
+            table may affect table processing parallelism level and performance.
+            If not set, then fragment size is chosen automatically.
+
+        Returns
+        -------
+        QueryExpr
+            Scan expression referencing created table.
+
+        Examples
+        --------
+        >>> hdk = pyhdk.init()
+        >>> ht = hdk.import_pandas(pandas.DataFrame({"a": [1, 2, 3]}), "t1")
+        >>> res = ht.run().to_pandas()
+        """
+        return self.import_arrow(
+            pyarrow.Table.from_pandas(df, preserve_index=False),
+            table_name=table_name,
+            fragment_size=fragment_size,
+        )
+
     def query_opts(self):
         return QueryOptions(self._config)
 
@@ -2024,15 +2352,222 @@ class HDK:
         >>> test = hdk.import_csv("test.csv")
         >>> res = hdk.sql("SELCT type, count(*) FROM test GROUP BY type;", test=test)
         """
+        if self._enable_native_sql_parser and not kwargs:
+            node = self._builder.parse_sql(sql_query)
+            if node is not None:
+                return node.run(**self._normalize_query_opts(query_opts))
+        ra = self._get_calcite().process(self._add_sql_table_aliases(sql_query, **kwargs))
+        return self._execute_ra(ra, query_opts)
+
+    async def sql_async(self, sql_query, query_opts=None, **kwargs):
+        """
+        Execute SQL query without blocking the event loop.
+
+        The query is parsed and executed in the default executor of the running
+        event loop. Cancellation of the awaiting task interrupts the query.
+        Queries of the same HDK instance are still executed one at a time.
+
+        Parameters
+        ----------
+        sql_query : str
+            SQL query to execute.
+        query_opts : QueryOptions or dict, default: None
+            Query execution options.
+        **kwargs : dict
+            Table aliases for the query. Same as for the `sql` method.
+
+        Returns
+        -------
+        ExecutionResult
+            The result of query execution.
+
+        Examples
+        --------
+        >>> hdk = pyhdk.init()
+        >>>
+        >>> hdk.import_csv("test.csv", "test")
+        >>> res = await hdk.sql_async("SELECT type, count(*) FROM test GROUP BY type;")
+        """
+        loop = asyncio.get_running_loop()
+        ra_executor = await loop.run_in_executor(
+            None, lambda: self._create_sql_executor(sql_query, **kwargs)
+        )
+        opts = self._normalize_query_opts(query_opts)
+        try:
+            res = await loop.run_in_executor(None, lambda: ra_executor.execute(**opts))
+        except asyncio.CancelledError:
+            ra_executor.interrupt()
+            raise
+        res.scan = self.scan(res.table_name)
+        return res
+
+    def _create_sql_executor(self, sql_query, **kwargs):
+        if self._enable_native_sql_parser and not kwargs:
+            node = self._builder.parse_sql(sql_query)
+            if node is not None:
+                return RelAlgExecutor(
+                    self._executor, self._storage, self._data_mgr, dag=node.finalize()
+                )
+        ra = self._get_calcite().process(self._add_sql_table_aliases(sql_query, **kwargs))
+        return RelAlgExecutor(self._executor, self._schema_mgr, self._data_mgr, ra)
+
+    def prepare(self, sql_query, **kwargs):
+        """
+        Parse and optimize SQL query once to execute it multiple times.
+
+        The query may have '?' parameter markers. Their values are bound on
+        each execution, which skips parsing and reuses the generated code.
+        A prepared query is valid while the schemas of referenced tables
+        don't change.
+
+        Parameters
+        ----------
+        sql_query : str
+            SQL query to prepare.
+        **kwargs : dict
+            Table aliases for the query. Same as for the `sql` method.
+
+        Returns
+        -------
+        PreparedQuery
+            The prepared query.
+
+        Examples
+        --------
+        >>> hdk = pyhdk.init()
+        >>>
+        >>> hdk.import_csv("test.csv", "test")
+        >>> query = hdk.prepare("SELECT count(*) FROM test WHERE id = ?;")
+        >>> res1 = query.execute(1)
+        >>> res2 = query.execute(2)
+        """
+        ra = self._get_calcite().process(self._add_sql_table_aliases(sql_query, **kwargs))
+        return PreparedQuery(self, ra)
+
+    def continuous_query(self, sql_query, query_opts=None, **kwargs):
+        """
+        Compile SQL query to run it continuously on a stream table.
+
+        The query should read a single stream table and be executed in a single
+        step, i.e. a projection or an aggregation with no sort. Each batch pushed
+        to the query is processed by the once compiled code.
+
+        Parameters
+        ----------
+        sql_query : str
+            SQL query to compile.
+        query_opts : QueryOptions or dict, default: None
+            Query execution options.
+        **kwargs : dict
+            Table aliases for the query. Same as for the `sql` method.
+
+        Returns
+        -------
+        ContinuousQuery
+            The compiled query.
+
+        Examples
+        --------
+        >>> hdk = pyhdk.init()
+        >>>
+        >>> hdk.create_table("events", {"type": "text", "val": "int64"}, stream=True)
+        >>> query = hdk.continuous_query("SELECT type, sum(val) FROM events GROUP BY type;")
+        >>> query.push(pyarrow.table({"type": ["a", "b"], "val": [1, 2]}))
+        >>> res = query.poll()
+        """
+        ra_executor = self._create_sql_executor(sql_query, **kwargs)
+        table_name = ra_executor.prepare_stream(**self._normalize_query_opts(query_opts))
+        return ContinuousQuery(self, ra_executor, table_name)
+
+    def register_udf(self, func, signature, name=None, batch=False):
+        """
+        Register Python function as a runtime UDF callable from SQL queries.
+
+        The function is compiled by Numba in nopython mode and its LLVM IR is
+        linked into the generated query code. UDFs are executed on CPU, queries
+        using them on GPU fall back to CPU. Registering a function with the
+        name of a previously registered one replaces it.
+
+        Parameters
+        ----------
+        func : callable
+            Function to compile.
+        signature : str or numba.core.typing.templates.Signature
+            Numba signature of the function, e.g. "int64(int64, int64)".
+            Supported types are int8, int16, int32, int64, float32 and float64.
+        name : str, default: None
+            Name of the function in SQL. The name of `func` is used by default.
+        batch : bool, default: False
+            Also register a batch implementation which processes a batch of
+            rows per call. It replaces per-row calls when all function
+            arguments are table columns.
+
+        Examples
+        --------
+        >>> hdk = pyhdk.init()
+        >>> ht = hdk.import_pydict({"a": [1, 2, 3], "b": [4, 5, 6]})
+        >>> hdk.register_udf(lambda x, y: x * y + 1, "int64(int64, int64)", name="mul1")
+        >>> hdk.sql("SELECT mul1(a, b) AS r FROM t1;", t1=ht)
+        """
+        try:
+            import numba
+        except ImportError:
+            raise ImportError("Numba is required to register runtime UDFs.")
+
+        args, ret = numba.core.sigutils.normalize_signature(signature)
+        if ret is None:
+            raise TypeError("Runtime UDF signature should specify the return type.")
+        name = name or func.__name__
+        if not name.isidentifier() or "__" in name:
+            raise ValueError(f"Invalid runtime UDF name: {name}.")
+
+        row_sig = {
+            "name": f"{name}__cpu_",
+            "ret": _udf_type(ret),
+            "args": [_udf_type(arg) for arg in args],
+        }
+        sigs = [row_sig]
+        irs = [_row_udf_ir(numba, func, args, ret, row_sig["name"])]
+        if batch:
+            sigs.append({**row_sig, "name": f"{name}__batch", "batch": True})
+            irs.append(_batch_udf_ir(numba, func, args, ret, sigs[-1]["name"]))
+
+        calcite = self._get_calcite()
+        udfs = dict(self._udfs)
+        udfs[name.upper()] = (sigs, irs)
+        self._executor.register_runtime_udf_modules(
+            [ir for _, udf_irs in udfs.values() for ir in udf_irs]
+        )
+        calcite.set_runtime_udfs(
+            json.dumps([sig for udf_sigs, _ in udfs.values() for sig in udf_sigs])
+        )
+        self._udfs = udfs
+
+    def _get_calcite(self):
+        if self._calcite is None:
+            self._calcite = Calcite(self._schema_mgr, self._config)
+        return self._calcite
+
+    def _normalize_query_opts(self, query_opts):
         if query_opts is None:
-            query_opts = {}
-        elif isinstance(query_opts, QueryOptions):
-            query_opts = query_opts._opts
-        elif not isinstance(query_opts, dict):
+            return {}
+        if isinstance(query_opts, QueryOptions):
+            return query_opts._opts
+        if not isinstance(query_opts, dict):
             raise TypeError(
                 f"Expected dict or QueryOptions for 'query_opts' arg. Got: {type(query_opts)}."
             )
+        return query_opts
+
+    def _execute_ra(self, ra, query_opts, params=None):
+        ra_executor = RelAlgExecutor(
+            self._executor, self._schema_mgr, self._data_mgr, ra, params=params
+        )
+        res = ra_executor.execute(**self._normalize_query_opts(query_opts))
+        res.scan = self.scan(res.table_name)
+        return res
 
+    def _add_sql_table_aliases(self, sql_query, **kwargs):
         parts = []
         for name, orig_table in kwargs.items():
             if (
@@ -2051,14 +2586,7 @@ class HDK:
                 parts.append(", ")
             parts.append(f"{name} AS (SELECT * FROM {orig_table})\n")
 
-        sql_query = "".join(parts) + sql_query
-        ra = self._calcite.process(sql_query)
-        ra_executor = RelAlgExecutor(
-            self._executor, self._schema_mgr, self._data_mgr, ra
-        )
-        res = ra_executor.execute(**query_opts)
-        res.scan = self.scan(res.table_name)
-        return res
+        return "".join(parts) + sql_query
 
     def scan(self, table_name):
         """
@@ -6,7 +6,13 @@
 # SPDX-License-Identifier: Apache-2.0
 
 
+import asyncio
+import concurrent.futures
+import json
 import pandas
+import pyarrow
+import pyarrow.ipc
+import pyarrow.parquet
 import pytest
 import pyhdk
 import numpy as np
@@ -850,6 +856,98 @@ class TestBuilder(BaseTest):
 
         hdk.drop_table(ht)
 
+    def test_to_cuda_arrays_on_cpu(self):
+        hdk = pyhdk.init()
+        ht = hdk.import_pydict({"a": [1, 2, 3], "b": [1.5, 2.5, 3.5]})
+
+        # CPU results are never kept in device memory.
+        res = hdk.sql("SELECT a, b FROM t1;", t1=ht)
+        with pytest.raises(RuntimeError):
+            res.to_cuda_arrays()
+
+        hdk.drop_table(ht)
+
+    def test_profile(self):
+        hdk = pyhdk.init()
+        ht = hdk.import_pydict({"a": [1, 2, 3, 4, 5], "b": [1, 1, 2, 2, 3]})
+
+        res = hdk.sql("SELECT b, SUM(a) AS s FROM t1 GROUP BY b;", t1=ht)
+        assert res.profile() is None
+        assert res.explain_analyze() is None
+
+        res = hdk.sql(
+            "SELECT b, SUM(a) AS s FROM t1 GROUP BY b ORDER BY b;",
+            query_opts={"enable_profile": True},
+            t1=ht,
+        )
+        check_res(res, {"b": [1, 2, 3], "s": [3, 7, 5]})
+        profile = res.profile()
+        assert len(profile["steps"]) > 0
+        assert profile["total_time"] >= 0
+        assert sum(len(step["kernels"]) for step in profile["steps"]) > 0
+        assert profile["steps"][0]["input_rows"] == 5
+        assert profile["steps"][-1]["output_rows"] == 3
+        assert "Step 0" in res.explain_analyze()
+
+        hdk.drop_table(ht)
+
+    def test_metrics(self):
+        hdk = pyhdk.init()
+        ht = hdk.import_pydict({"a": [1, 2, 3, 4, 5], "b": [1, 1, 2, 2, 3]})
+
+        queries_before = pyhdk.metrics().get("hdk_query_duration_seconds_count", 0)
+        hdk.sql("SELECT b, SUM(a) AS s FROM t1 GROUP BY b;", t1=ht)
+        metrics = pyhdk.metrics()
+        assert metrics["hdk_query_duration_seconds_count"] > queries_before
+        assert any(name.startswith("hdk_code_cache_hits_total") for name in metrics)
+
+        text = pyhdk.metricsPrometheus()
+        assert "# TYPE hdk_query_duration_seconds histogram" in text
+        assert 'hdk_query_duration_seconds_bucket{le="+Inf"}' in text
+
+        hdk.drop_table(ht)
+
+    def test_trace(self):
+        hdk = pyhdk.init()
+        ht = hdk.import_pydict({"a": [1, 2, 3, 4, 5], "b": [1, 1, 2, 2, 3]})
+
+        pyhdk.startTrace()
+        hdk.sql("SELECT b, SUM(a) AS s FROM t1 GROUP BY b;", t1=ht)
+        trace = json.loads(pyhdk.stopTrace())
+        names = {event["name"] for event in trace["traceEvents"]}
+        assert "kernel" in names
+        assert "fetch" in names
+        assert all("tid" in event for event in trace["traceEvents"] if event["ph"] == "X")
+
+        hdk.drop_table(ht)
+
+    def test_sql_async(self):
+        hdk = pyhdk.init()
+        ht = hdk.import_pydict({"a": [1, 2, 3, 4, 5], "b": [5, 4, 3, 2, 1]})
+
+        async def run():
+            res = await asyncio.gather(
+                hdk.sql_async("SELECT SUM(a) AS s FROM t1;", t1=ht),
+                hdk.sql_async("SELECT SUM(b) AS s FROM t1 WHERE a > 2;", t1=ht),
+            )
+            check_res(res[0], {"s": [15]})
+            check_res(res[1], {"s": [6]})
+
+            task = asyncio.ensure_future(
+                hdk.sql_async("SELECT a FROM t1 WHERE b > 1;", t1=ht)
+            )
+            await asyncio.sleep(0)
+            task.cancel()
+            with pytest.raises(asyncio.CancelledError):
+                await task
+
+            # Interrupting a query doesn't affect the following ones.
+            res = await hdk.sql_async("SELECT COUNT(*) AS c FROM t1;", t1=ht)
+            check_res(res, {"c": [5]})
+
+        asyncio.run(run())
+        hdk.drop_table(ht)
+
     def test_run_on_res(self):
         hdk = pyhdk.init()
         ht = hdk.import_pydict({"a": [1, 2, 3, 4, 5], "b": [10, 20, 30, 40, 50]})
@@ -909,6 +1007,54 @@ class TestBuilder(BaseTest):
 
         hdk.drop_table(ht)
 
+    def test_to_numpy(self):
+        hdk = pyhdk.init()
+        df = pandas.DataFrame(
+            {"a": [1, 2, 3], "b": [1.5, None, 3.5], "c": ["x", "y", "z"]}
+        )
+        ht = hdk.import_pandas(df)
+
+        res = ht.proj("a", "b", "c").run()
+        arrs = res.to_numpy()
+        assert list(arrs.keys()) == ["a", "b", "c"]
+        assert arrs["a"].tolist() == [1, 2, 3]
+        assert arrs["b"][0] == 1.5 and arrs["b"][2] == 3.5
+        assert np.ma.is_masked(arrs["b"][1]) or np.isnan(arrs["b"][1])
+        assert arrs["c"].tolist() == ["x", "y", "z"]
+
+        df = res.to_pandas()
+        assert df["a"].tolist() == [1, 2, 3]
+        assert df["b"].isna().tolist() == [False, True, False]
+
+        hdk.drop_table(ht)
+
+    def test_export(self, tmp_path):
+        hdk = pyhdk.init()
+        df = pandas.DataFrame(
+            {"a": [1, 2, 3, 4, 5], "b": [1.5, None, 3.5, 4.5, 5.5], "c": list("vwxyz")}
+        )
+        ht = hdk.import_pandas(df)
+        res = ht.proj("a", "b", "c").run()
+
+        parquet_file = str(tmp_path / "res.parquet")
+        res.to_parquet(parquet_file, batch_size=2)
+        parquet = pyarrow.parquet.ParquetFile(parquet_file)
+        assert parquet.metadata.num_row_groups == 3
+        at = parquet.read()
+        assert at["a"].to_pylist() == [1, 2, 3, 4, 5]
+        assert at["b"].to_pylist() == [1.5, None, 3.5, 4.5, 5.5]
+        assert at["c"].to_pylist() == list("vwxyz")
+
+        ipc_file = str(tmp_path / "res.arrow")
+        res.to_arrow_ipc(ipc_file, batch_size=2)
+        with pyarrow.ipc.open_file(ipc_file) as reader:
+            assert reader.num_record_batches == 3
+            at = reader.read_all()
+        assert at["a"].to_pylist() == [1, 2, 3, 4, 5]
+        assert at["c"].to_pylist() == list("vwxyz")
+
+        hdk.drop_table(ht)
+
     def test_shape(self):
         hdk = pyhdk.init()
         ht = hdk.import_pydict({"a": [1, 2, 3, 4, 5], "b": [10, 20, 30, 40, 50]})
@@ -953,6 +1099,65 @@ class TestBuilder(BaseTest):
 
         hdk.drop_table(ht)
 
+    def test_sample(self):
+        hdk = pyhdk.init()
+        ht = hdk.import_pydict({"a": list(range(1, 21))}, fragment_size=4)
+
+        res = ht.run()
+        res1 = res.sample(30)
+        check_res(res1, {"a": list(range(1, 21))})
+        res2 = res.sample(0)
+        check_res(res2, {"a": []})
+        for seed in range(5):
+            vals = res.sample(6, seed).to_arrow()["a"].to_pylist()
+            assert len(vals) == 6
+            assert len(set(vals)) == 6
+            assert vals == sorted(vals)
+            assert res.sample(6, seed).to_arrow()["a"].to_pylist() == vals
+
+            vals = ht.sample(6, seed).to_arrow()["a"].to_pylist()
+            assert 0 < len(vals) <= 6
+            assert len(set(vals)) == len(vals)
+            assert all(1 <= val <= 20 for val in vals)
+
+        hdk.drop_table(ht)
+
+    def test_node_head(self):
+        hdk = pyhdk.init()
+        ht = hdk.import_pydict({"a": list(range(1, 21))}, fragment_size=4)
+
+        # Limit without ordering doesn't guarantee the order of fragments.
+        vals = ht.head(6).to_arrow()["a"].to_pylist()
+        assert len(vals) == 6
+        assert set(vals) <= set(range(1, 21))
+        vals = ht.proj(b=ht["a"] * 2).head(3).to_arrow()["b"].to_pylist()
+        assert len(vals) == 3
+        assert set(vals) <= set(range(2, 41, 2))
+        assert ht.head(30).row_count() == 20
+
+        hdk.drop_table(ht)
+
+    def test_reuse_node_results(self):
+        hdk = pyhdk.init()
+        ht = hdk.import_pydict({"a": [1, 2, 3, 4], "b": [10, 20, 30, 40]}, "reuse1")
+
+        filtered = ht.filter(ht["a"] > 1)
+        filtered = filtered.proj("a", b2=filtered["b"] * 2)
+        check_res(filtered.run(), {"a": [2, 3, 4], "b2": [40, 60, 80]})
+
+        # The aggregation reads the materialized result of its input.
+        res = filtered.agg([], "sum(b2)").run(enable_profile=True)
+        check_res(res, {"b2_sum": [180]})
+        assert res.profile()["steps"][0]["input_rows"] == 3
+
+        # Appended rows make the result outdated.
+        hdk.import_pydict({"a": [5], "b": [50]}, "reuse1")
+        res = filtered.agg([], "sum(b2)").run(enable_profile=True)
+        check_res(res, {"b2_sum": [280]})
+        assert res.profile()["steps"][0]["input_rows"] == 5
+
+        hdk.drop_table(ht)
+
 
 class TestSql(BaseTest):
     def test_no_alias(self):
@@ -996,6 +1201,73 @@ class TestSql(BaseTest):
             },
         )
 
+    def test_concurrent_queries(self):
+        hdk = pyhdk.init()
+        ht = hdk.import_pydict({"a": list(range(1000)), "b": [1] * 1000})
+
+        def run(i):
+            res = hdk.sql(f"SELECT SUM(b) AS s FROM t1 WHERE a >= {i};", t1=ht)
+            return res.to_arrow().to_pydict()["s"][0]
+
+        with concurrent.futures.ThreadPoolExecutor(max_workers=4) as pool:
+            results = list(pool.map(run, range(0, 1000, 100)))
+        assert results == list(range(1000, 0, -100))
+
+        hdk.drop_table(ht)
+
+    def test_sample_rate(self):
+        hdk = pyhdk.init()
+        ht = hdk.import_pydict(
+            {"a": list(range(100)), "b": [1] * 100}, fragment_size=10
+        )
+        query_opts = {"sample_rate": 0.3, "sample_seed": 7}
+
+        res = hdk.sql("SELECT a FROM t1;", query_opts=query_opts, t1=ht)
+        rows = res.to_arrow().num_rows
+        assert rows < 100 and rows % 10 == 0
+
+        # Equal fragments make the scaled counts exact.
+        res = hdk.sql(
+            "SELECT COUNT(*) AS c, SUM(b) AS s, MAX(b) AS m FROM t1;",
+            query_opts=query_opts,
+            t1=ht,
+        )
+        check_res(res, {"c": [100], "s": [100], "m": [1]})
+
+        res = hdk.sql("SELECT COUNT(*) AS c FROM t1 WHERE a < 50;", t1=ht)
+        check_res(res, {"c": [50]})
+
+        hdk.drop_table(ht)
+
+    def test_runtime_udf(self):
+        pytest.importorskip("numba")
+        hdk = pyhdk.init()
+        ht = hdk.import_pydict(
+            {"a": [1, 2, 3, 4], "b": [4, 3, 2, 1], "x": [1.5, 2.5, 3.5, 4.5]}
+        )
+
+        hdk.register_udf(lambda a, b: a * b + 1, "int64(int64, int64)", name="mul_inc")
+        hdk.register_udf(
+            lambda x: x * 2.0, "float64(float64)", name="twice", batch=True
+        )
+        res = hdk.sql(
+            "SELECT a, mul_inc(a, b) AS r, twice(x) AS t FROM t1 ORDER BY a;", t1=ht
+        )
+        check_res(
+            res,
+            {"a": [1, 2, 3, 4], "r": [5, 7, 7, 5], "t": [3.0, 5.0, 7.0, 9.0]},
+        )
+
+        # Re-registration replaces the function.
+        hdk.register_udf(lambda a, b: a - b, "int64(int64, int64)", name="mul_inc")
+        res = hdk.sql("SELECT a, mul_inc(a, b) AS r FROM t1 ORDER BY a;", t1=ht)
+        check_res(res, {"a": [1, 2, 3, 4], "r": [-3, -1, 1, 3]})
+
+        with pytest.raises(TypeError):
+            hdk.register_udf(lambda a: a, "boolean(boolean)", name="bad_udf")
+
+        hdk.drop_table(ht)
+
     def test_run_on_res(self):
         hdk = pyhdk.init()
         ht1 = hdk.import_pydict(
@@ -1011,6 +1283,50 @@ class TestSql(BaseTest):
         res3 = hdk.sql(f"SELECT b - 1 as b, a + 1 as a FROM {res1.table_name};")
         check_res(res3, {"b": [4, 3, 2, 1, 0], "a": [2, 3, 4, 5, 6]})
 
+    def test_prepared_query(self):
+        hdk = pyhdk.init()
+        ht = hdk.import_pydict(
+            {"a": [1, 2, 3, 4, 5], "b": [5, 4, 3, 2, 1], "s": ["a", "b", "a", "b", "a"]}
+        )
+
+        query = hdk.prepare("SELECT a, b FROM t1 WHERE a > ? ORDER BY a;", t1=ht)
+        check_res(query.execute(3), {"a": [4, 5], "b": [2, 1]})
+        check_res(query.execute(1), {"a": [2, 3, 4, 5], "b": [4, 3, 2, 1]})
+
+        query = hdk.prepare(
+            "SELECT COUNT(*) AS cnt FROM t1 WHERE s = ? AND b < ?;", t1=ht
+        )
+        check_res(query.execute("a", 4), {"cnt": [2]})
+        check_res(query.execute("b", 3), {"cnt": [1]})
+
+    def test_continuous_query(self):
+        hdk = pyhdk.init()
+        ht = hdk.create_table("stream1", {"a": "int64", "b": "int64"}, stream=True)
+
+        agg = hdk.continuous_query("SELECT a, SUM(b) AS s FROM stream1 GROUP BY a;")
+        proj = hdk.continuous_query("SELECT a, b FROM stream1 WHERE b > 1;")
+        assert agg.table_name == "stream1"
+
+        def sums(res):
+            data = res.to_arrow().to_pydict()
+            return dict(zip(data["a"], data["s"]))
+
+        agg.push(pyarrow.table({"a": [1, 2, 1], "b": [1, 2, 3]}))
+        proj.update()
+        assert sums(agg.poll()) == {1: 4, 2: 2}
+        check_res(proj.poll(), {"a": [2, 1], "b": [2, 3]})
+
+        agg.push(pyarrow.table({"a": [2, 3], "b": [4, 5]}))
+        proj.update()
+        assert sums(agg.poll()) == {1: 4, 2: 6, 3: 5}
+        assert sums(agg.poll()) == {1: 4, 2: 6, 3: 5}
+        check_res(proj.poll(), {"a": [2, 3], "b": [4, 5]})
+
+        assert sums(agg.finish()) == {1: 4, 2: 6, 3: 5}
+        assert proj.finish().to_arrow().num_rows == 0
+
+        hdk.drop_table(ht)
+
 
 class BaseTaxiTest:
     @staticmethod
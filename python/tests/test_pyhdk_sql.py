@@ -62,6 +62,14 @@ class TestSql:
         assert df["a"].tolist() == [1, 2, 3]
         assert df["b"].tolist() == [10, 20, 30]
 
+    def test_projection_batches(self):
+        res = self.execute_sql("SELECT * FROM test;")
+        batches = list(res.to_arrow_batches(batch_size=2))
+        assert sum(batch.num_rows for batch in batches) == 3
+        df = pyarrow.Table.from_batches(batches).to_pandas()
+        assert df["a"].tolist() == [1, 2, 3]
+        assert df["b"].tolist() == [10, 20, 30]
+
     def test_simple_filter(self):
         res = self.execute_sql("SELECT COUNT(*) FROM test WHERE a < 3;")
         df = res.to_arrow().to_pandas()
@@ -0,0 +1,84 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FlightServer.h"
+
+#include "Logger/Logger.h"
+
+#include <exception>
+
+namespace {
+
+// Uploaded stream as a reader of record batches, so that batches are appended to
+// the table while the rest of the upload is not received yet.
+class FlightBatchReader : public arrow::RecordBatchReader {
+ public:
+  FlightBatchReader(arrow::flight::FlightMessageReader& reader,
+                    std::shared_ptr<arrow::Schema> schema)
+      : reader_(reader), schema_(std::move(schema)) {}
+
+  std::shared_ptr<arrow::Schema> schema() const override { return schema_; }
+
+  arrow::Status ReadNext(std::shared_ptr<arrow::RecordBatch>* batch) override {
+    while (true) {
+      ARROW_ASSIGN_OR_RAISE(auto chunk, reader_.Next());
+      // Chunks may carry application metadata only.
+      if (!chunk.data && chunk.app_metadata) {
+        continue;
+      }
+      *batch = std::move(chunk.data);
+      return arrow::Status::OK();
+    }
+  }
+
+ private:
+  arrow::flight::FlightMessageReader& reader_;
+  std::shared_ptr<arrow::Schema> schema_;
+};
+
+}  // namespace
+
+arrow::Status HDKFlightServer::DoGet(
+    const arrow::flight::ServerCallContext& context,
+    const arrow::flight::Ticket& request,
+    std::unique_ptr<arrow::flight::FlightDataStream>* stream) {
+  try {
+    auto reader = hdk_.queryBatches(request.ticket, max_batch_rows_);
+    *stream = std::make_unique<arrow::flight::RecordBatchStream>(reader);
+  } catch (const std::exception& e) {
+    LOG(INFO) << "Flight query failed: " << e.what();
+    return arrow::Status::Invalid(e.what());
+  }
+  return arrow::Status::OK();
+}
+
+arrow::Status HDKFlightServer::DoPut(
+    const arrow::flight::ServerCallContext& context,
+    std::unique_ptr<arrow::flight::FlightMessageReader> reader,
+    std::unique_ptr<arrow::flight::FlightMetadataWriter> writer) {
+  const auto& descriptor = reader->descriptor();
+  if (descriptor.type != arrow::flight::FlightDescriptor::PATH ||
+      descriptor.path.size() != 1) {
+    return arrow::Status::Invalid("Expected a table name as the descriptor path.");
+  }
+  ARROW_ASSIGN_OR_RAISE(auto schema, reader->GetSchema());
+  try {
+    hdk_.readBatches(std::make_shared<FlightBatchReader>(*reader, schema),
+                     descriptor.path.front());
+  } catch (const std::exception& e) {
+    LOG(INFO) << "Flight upload failed: " << e.what();
+    return arrow::Status::Invalid(e.what());
+  }
+  return arrow::Status::OK();
+}
@@ -0,0 +1,49 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    FlightServer.h
+ * @brief   Arrow Flight service for remote SQL queries and data ingestion.
+ *
+ * DoGet takes an SQL query as the ticket and streams its result as record batches
+ * converted on demand. DoPut takes a table name as the descriptor path and appends
+ * the uploaded batches to the table, creating it on the first upload. Calls run on
+ * threads of the gRPC server, so sessions are served concurrently while query
+ * execution itself is serialized by the executor.
+ **/
+
+#pragma once
+
+#include "HDK.h"
+
+#include <arrow/flight/server.h>
+
+class HDKFlightServer : public arrow::flight::FlightServerBase {
+ public:
+  HDKFlightServer(HDK& hdk, const size_t max_batch_rows = size_t(1) << 20)
+      : hdk_(hdk), max_batch_rows_(max_batch_rows) {}
+
+  arrow::Status DoGet(const arrow::flight::ServerCallContext& context,
+                      const arrow::flight::Ticket& request,
+                      std::unique_ptr<arrow::flight::FlightDataStream>* stream) override;
+
+  arrow::Status DoPut(
+      const arrow::flight::ServerCallContext& context,
+      std::unique_ptr<arrow::flight::FlightMessageReader> reader,
+      std::unique_ptr<arrow::flight::FlightMetadataWriter> writer) override;
+
+ private:
+  HDK& hdk_;
+  const size_t max_batch_rows_;
+};
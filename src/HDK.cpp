@@ -6,15 +6,21 @@
 
 #include "HDK.h"
 
+#include <condition_variable>
 #include <memory>
+#include <thread>
 
 #include "ArrowStorage/ArrowStorage.h"
+#include "ArrowStorage/ArrowStorageUtils.h"
 #include "Calcite/CalciteJNI.h"
 #include "DataMgr/DataMgr.h"
 #include "Logger/Logger.h"
+#include "QueryBuilder/QueryBuilder.h"
+#include "QueryEngine/ArrowResultSet.h"
 #include "QueryEngine/Execute.h"
 #include "QueryEngine/RelAlgExecutor.h"
 #include "Shared/Config.h"
+#include "Shared/scope.h"
 
 // Stores objects needed for various endpoints. Allows us to avoid including all headers
 // in the externally available API header.
@@ -25,8 +31,30 @@ struct Internal {
   std::shared_ptr<Config> config;
   std::shared_ptr<ArrowStorage> storage;
   std::shared_ptr<Data_Namespace::DataMgr> data_mgr;
-  CalciteMgr* calcite;
+  CalciteMgr* calcite{nullptr};
   std::shared_ptr<Executor> executor;
+
+  // Number of running queries started by HDK::queryAsync().
+  std::mutex async_queries_mutex;
+  std::condition_variable async_queries_cv;
+  size_t async_queries{0};
+
+  std::mutex calcite_mutex;
+
+  // Calcite starts JVM, so it is initialized on the first SQL query only.
+  CalciteMgr* getCalcite() {
+    std::lock_guard<std::mutex> lock(calcite_mutex);
+    if (!calcite) {
+      if (!config->exec.enable_calcite) {
+        throw std::runtime_error(
+            "Cannot parse SQL query: Calcite is disabled by enable-calcite option.");
+      }
+      calcite = CalciteMgr::get(/*udf_filename=*/"",
+                                /*calcite_max_mem_mb=*/1024,
+                                config->exec.calcite_workers);
+    }
+    return calcite;
+  }
 };
 
 void HDK::read(std::shared_ptr<arrow::Table>& table, const std::string& table_name) {
@@ -35,29 +63,159 @@ void HDK::read(std::shared_ptr<arrow::Table>& table, const std::string& table_na
   internal_->storage->importArrowTable(table, table_name);
 }
 
+void HDK::readBatches(std::shared_ptr<arrow::RecordBatchReader> reader,
+                      const std::string& table_name) {
+  CHECK(internal_);
+  CHECK(internal_->storage);
+  auto& storage = *internal_->storage;
+  if (!storage.getTableInfo(internal_->db_id, table_name)) {
+    std::vector<ArrowStorage::ColumnDescription> columns;
+    for (auto& field : reader->schema()->fields()) {
+      columns.push_back(
+          {field->name(),
+           getTargetImportType(hdk::ir::Context::defaultCtx(), *field->type())});
+    }
+    storage.createTable(table_name, columns);
+  }
+  storage.appendRecordBatches(reader, table_name);
+}
+
 ExecutionResult HDK::query(const std::string& sql, const bool is_explain) {
+  return execute(prepare(sql));
+}
+
+PreparedQuery HDK::prepare(const std::string& sql) {
   CHECK(internal_);
-  CHECK(internal_->calcite);
-  auto ra = internal_->calcite->process(internal_->db_name,
-                                        sql,
-                                        internal_->storage.get(),
-                                        internal_->config.get(),
-                                        {},
-                                        /*legacy_syntax=*/true);
+  if (internal_->config->exec.enable_native_sql_parser) {
+    hdk::ir::QueryBuilder builder(
+        hdk::ir::Context::defaultCtx(), internal_->storage, internal_->config);
+    if (auto node = builder.parseSql(sql); node.node()) {
+      return {sql, "", node.finalize()->getRootNodeShPtr()};
+    }
+  }
+  auto ra = internal_->getCalcite()->process(internal_->db_name,
+                                             sql,
+                                             internal_->storage.get(),
+                                             internal_->config.get(),
+                                             {},
+                                             /*legacy_syntax=*/true);
+  return {sql, std::move(ra), nullptr};
+}
+
+namespace {
+
+std::unique_ptr<hdk::ir::QueryDag> build_query_dag(
+    Internal& internal,
+    const PreparedQuery& query,
+    const std::vector<std::string>& params) {
+  if (query.root) {
+    // Natively parsed queries have no parameter markers.
+    if (!params.empty()) {
+      throw std::runtime_error("Query has no parameters: " + query.sql);
+    }
+    return std::make_unique<hdk::ir::QueryDag>(internal.config, query.root);
+  }
+  return std::make_unique<RelAlgDagBuilder>(
+      query.query_ra, internal.db_id, internal.storage, internal.config, params);
+}
+
+ExecutionResult execute_query(Internal& internal, RelAlgExecutor& ra_executor) {
+  auto co = CompilationOptions::defaults(ExecutorDeviceType::CPU);
+  auto eo = ExecutionOptions::fromConfig(*internal.config.get());
+  return ra_executor.executeRelAlgQuery(co, eo, /*just_explain_plan=*/false);
+}
+
+}  // namespace
 
+ExecutionResult HDK::execute(const PreparedQuery& query,
+                             const std::vector<std::string>& params) {
+  CHECK(internal_);
   CHECK(internal_->storage);
   CHECK(internal_->config);
-  auto dag = std::make_unique<RelAlgDagBuilder>(
-      ra, internal_->db_id, internal_->storage, internal_->config);
+  auto dag = build_query_dag(*internal_, query, params);
 
   CHECK(internal_->executor);
   CHECK(internal_->data_mgr);
   RelAlgExecutor ra_executor(
       internal_->executor.get(), internal_->storage, std::move(dag));
+  return execute_query(*internal_, ra_executor);
+}
 
-  auto co = CompilationOptions::defaults(ExecutorDeviceType::CPU);
-  auto eo = ExecutionOptions::fromConfig(*internal_->config.get());
-  return ra_executor.executeRelAlgQuery(co, eo, /*just_explain_plan=*/false);
+void AsyncQuery::cancel() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  cancelled_ = true;
+  if (ra_executor_) {
+    ra_executor_->interrupt();
+  }
+}
+
+bool AsyncQuery::isCancelled() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return cancelled_;
+}
+
+std::pair<size_t, size_t> AsyncQuery::progress() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return {executed_steps_, total_steps_};
+}
+
+std::shared_ptr<AsyncQuery> HDK::queryAsync(const std::string& sql) {
+  CHECK(internal_);
+  CHECK(internal_->executor);
+  auto async_query = std::make_shared<AsyncQuery>();
+  std::promise<ExecutionResult> promise;
+  async_query->result_ = promise.get_future().share();
+  {
+    std::lock_guard<std::mutex> lock(internal_->async_queries_mutex);
+    ++internal_->async_queries;
+  }
+
+  auto run_query = [this, sql, async_query]() {
+    auto dag = build_query_dag(*internal_, prepare(sql), {});
+    RelAlgExecutor ra_executor(
+        internal_->executor.get(), internal_->storage, std::move(dag));
+    ra_executor.setProgressCallback([&async_query](size_t executed, size_t total) {
+      std::lock_guard<std::mutex> lock(async_query->mutex_);
+      async_query->executed_steps_ = executed;
+      async_query->total_steps_ = total;
+    });
+    {
+      std::lock_guard<std::mutex> lock(async_query->mutex_);
+      if (async_query->cancelled_) {
+        throw std::runtime_error(
+            RelAlgExecutor::getErrorMessageFromCode(Executor::ERR_INTERRUPTED));
+      }
+      async_query->ra_executor_ = &ra_executor;
+    }
+    ScopeGuard unregister_executor = [&async_query] {
+      std::lock_guard<std::mutex> lock(async_query->mutex_);
+      async_query->ra_executor_ = nullptr;
+    };
+    return execute_query(*internal_, ra_executor);
+  };
+
+  std::thread([this, run_query, promise = std::move(promise)]() mutable {
+    try {
+      promise.set_value(run_query());
+    } catch (...) {
+      promise.set_exception(std::current_exception());
+    }
+    std::lock_guard<std::mutex> lock(internal_->async_queries_mutex);
+    --internal_->async_queries;
+    internal_->async_queries_cv.notify_all();
+  }).detach();
+  return async_query;
+}
+
+std::shared_ptr<arrow::RecordBatchReader> HDK::queryBatches(const std::string& sql,
+                                                           const size_t max_batch_rows) {
+  auto res = query(sql);
+  std::vector<std::string> col_names;
+  for (auto& target : res.getTargetsMeta()) {
+    col_names.push_back(target.get_resname());
+  }
+  ArrowResultSetConverter converter(res.getRows(), col_names, -1);
+  return converter.convertToArrowBatchReader(max_batch_rows);
 }
 
 namespace {
@@ -89,14 +247,15 @@ HDK::HDK() : internal_(std::make_unique<Internal>()) {
   internal_->data_mgr->getPersistentStorageMgr()->registerDataProvider(
       internal_->schema_id, internal_->storage);
 
-  // Calcite
-  internal_->calcite = CalciteMgr::get(/*udf_filename=*/"",
-                                       /*calcite_max_mem_mb=*/1024);
-
   // Executor
   internal_->executor =
       Executor::getExecutor(internal_->data_mgr.get(), internal_->config, "", "");
   internal_->executor->setSchemaProvider(internal_->storage);
 }
 
-HDK::~HDK() {}
+HDK::~HDK() {
+  if (internal_) {
+    std::unique_lock<std::mutex> lock(internal_->async_queries_mutex);
+    internal_->async_queries_cv.wait(lock, [this] { return !internal_->async_queries; });
+  }
+}
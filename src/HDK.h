@@ -8,7 +8,55 @@
 
 #include <arrow/api.h>
 
+#include <future>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
 struct Internal;
+class RelAlgExecutor;
+
+namespace hdk::ir {
+class Node;
+}  // namespace hdk::ir
+
+// A query parsed and optimized by Calcite once. The query may have '?' parameter
+// markers, values for them are bound on each execution. Queries handled by the
+// native SQL parser have empty query_ra and keep the root of the built query instead.
+struct PreparedQuery {
+  std::string sql;
+  std::string query_ra;
+  std::shared_ptr<hdk::ir::Node> root;
+};
+
+// A query started by HDK::queryAsync(). The query runs on its own thread, its result
+// or error is delivered through the future.
+class AsyncQuery {
+ public:
+  std::shared_future<ExecutionResult> result() const { return result_; }
+
+  // Cancel the query. Unless the query has already finished, the future throws the
+  // interrupted query error.
+  void cancel();
+
+  bool isCancelled() const;
+
+  // Numbers of executed and total query steps. Total is zero until the execution
+  // starts.
+  std::pair<size_t, size_t> progress() const;
+
+ private:
+  friend class HDK;
+
+  std::shared_future<ExecutionResult> result_;
+  mutable std::mutex mutex_;
+  bool cancelled_{false};
+  // Set while the query is executed.
+  RelAlgExecutor* ra_executor_{nullptr};
+  size_t executed_steps_{0};
+  size_t total_steps_{0};
+};
 
 class HDK {
  public:
@@ -18,8 +66,34 @@ class HDK {
 
   void read(std::shared_ptr<arrow::Table>& table, const std::string& table_name);
 
+  // Append record batches to the table while they are read. The table is created
+  // from the reader schema if it doesn't exist.
+  void readBatches(std::shared_ptr<arrow::RecordBatchReader> reader,
+                   const std::string& table_name);
+
   ExecutionResult query(const std::string& sql, const bool is_explain = false);
 
+  // Execute the query and return a reader producing its result as record batches of
+  // up to max_batch_rows rows each, converted on demand.
+  std::shared_ptr<arrow::RecordBatchReader> queryBatches(
+      const std::string& sql,
+      const size_t max_batch_rows = size_t(1) << 20);
+
+  // Parse and optimize the query without executing it. The prepared query is valid
+  // while the schemas of the referenced tables don't change.
+  PreparedQuery prepare(const std::string& sql);
+
+  // Execute a prepared query with the given values of its parameters in their
+  // textual form. Calcite is not called, and the generated code is reused through
+  // the code cache because literals are hoisted.
+  ExecutionResult execute(const PreparedQuery& query,
+                          const std::vector<std::string>& params = {});
+
+  // Start the query on a separate thread and return immediately. Queries sharing the
+  // executor are still executed one at a time. Destruction of HDK waits for the
+  // started queries.
+  std::shared_ptr<AsyncQuery> queryAsync(const std::string& sql);
+
   static HDK init();
 
  private: